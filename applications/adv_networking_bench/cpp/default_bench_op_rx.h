@@ -17,8 +17,13 @@
 
 #include "advanced_network/common.h"
 #include "advanced_network/kernels.h"
+#include "advanced_network/rx_condition.h"
 #include "holoscan/holoscan.hpp"
+#include "kernels.cuh"
+#include <algorithm>
+#include <numeric>
 #include <queue>
+#include <vector>
 #include <arpa/inet.h>
 #include <assert.h>
 #include <sys/time.h>
@@ -59,6 +64,11 @@ class AdvNetworkingBenchDefaultRxOp : public Operator {
                       ttl_bytes_recv_,
                       ttl_pkts_recv_,
                       ttl_packets_dropped_);
+    if (seq_width_.get() > 0) {
+      HOLOSCAN_LOG_INFO("Sequence reorder: {} packets missing from their batch, {} outside it",
+                        ttl_seq_missing_,
+                        ttl_seq_outside_);
+    }
 
     HOLOSCAN_LOG_INFO("Advanced Networking Benchmark RX op shutting down");
     freeResources();
@@ -67,6 +77,9 @@ class AdvNetworkingBenchDefaultRxOp : public Operator {
   void initialize() override {
     cudaError_t cuda_error;
     HOLOSCAN_LOG_INFO("AdvNetworkingBenchDefaultRxOp::initialize()");
+    // Always added, it only waits for bursts once watched when event_driven is set
+    rx_condition_ = fragment()->make_condition<AdvNetworkRxCondition>(name() + "_rx_ready");
+    add_arg(rx_condition_);
     holoscan::Operator::initialize();
 
     port_id_ = get_port_id(interface_name_.get());
@@ -78,6 +91,20 @@ class AdvNetworkingBenchDefaultRxOp : public Operator {
     // For this example assume all packets are the same size, specified in the config
     nom_payload_size_ = max_packet_size_.get() - header_size_.get();
 
+    if (seq_width_.get() > 0) {
+      const auto width = seq_width_.get();
+      if (!gpu_direct_.get() || !(width == 1 || width == 2 || width == 4 || width == 8) ||
+          seq_offset_.get() + width > nom_payload_size_) {
+        HOLOSCAN_LOG_ERROR("Sequence reorder needs gpu_direct and a 1, 2, 4 or 8 byte field "
+                           "inside the payload");
+        exit(1);
+      }
+      if (!check_seq_packet_reorder(seq_offset_.get(), width, seq_big_endian_.get())) {
+        throw std::runtime_error("seq_packet_reorder does not match its host reference");
+      }
+      next_first_seq_ = first_seq_.get();
+    }
+
     for (int n = 0; n < num_concurrent; n++) {
       cuda_error =
           CUDA_TRY(cudaMalloc(&full_batch_data_d_[n], batch_size_.get() * nom_payload_size_));
@@ -98,6 +125,15 @@ class AdvNetworkingBenchDefaultRxOp : public Operator {
           throw std::runtime_error("Could not allocate cuda memory for h_dev_ptrs_");
         }
       }
+      if (seq_width_.get() > 0) {
+        const size_t bitmap_size = (batch_size_.get() + 31) / 32 * sizeof(uint32_t);
+        if (CUDA_TRY(cudaMalloc(&missing_d_[n], bitmap_size)) != cudaSuccess ||
+            CUDA_TRY(cudaMalloc(&outside_d_[n], sizeof(uint32_t))) != cudaSuccess ||
+            CUDA_TRY(cudaMallocHost(&missing_h_[n], bitmap_size)) != cudaSuccess ||
+            CUDA_TRY(cudaMallocHost(&outside_h_[n], sizeof(uint32_t))) != cudaSuccess) {
+          throw std::runtime_error("Could not allocate the sequence reorder counters");
+        }
+      }
       cudaStreamCreate(&streams_[n]);
       cudaEventCreate(&events_[n]);
       // Warmup streams and kernel
@@ -118,6 +154,10 @@ class AdvNetworkingBenchDefaultRxOp : public Operator {
       if (full_batch_data_d_[n]) { cudaFree(full_batch_data_d_[n]); }
       if (full_batch_data_h_[n]) { cudaFreeHost(full_batch_data_h_[n]); }
       if (h_dev_ptrs_[n]) { cudaFreeHost(h_dev_ptrs_[n]); }
+      if (missing_d_[n]) { cudaFree(missing_d_[n]); }
+      if (outside_d_[n]) { cudaFree(outside_d_[n]); }
+      if (missing_h_[n]) { cudaFreeHost(missing_h_[n]); }
+      if (outside_h_[n]) { cudaFreeHost(outside_h_[n]); }
       if (streams_[n]) { cudaStreamDestroy(streams_[n]); }
       if (events_[n]) { cudaEventDestroy(events_[n]); }
     }
@@ -155,8 +195,44 @@ class AdvNetworkingBenchDefaultRxOp : public Operator {
                          "Header size",
                          "Header size on each packet from L4 and below",
                          42);
+    spec.param<bool>(event_driven_,
+                     "event_driven",
+                     "Event-driven RX",
+                     "Run only when the manager signals ready bursts instead of polling the queues",
+                     false);
+    spec.param<uint16_t>(seq_width_,
+                         "seq_width",
+                         "Sequence number width",
+                         "Width in bytes of the sequence number placing each payload in its "
+                         "batch (1, 2, 4 or 8), 0 to keep the arrival order. GPUDirect only",
+                         0);
+    spec.param<uint16_t>(seq_offset_,
+                         "seq_offset",
+                         "Sequence number offset",
+                         "Offset in bytes of the sequence number field into the payload",
+                         0);
+    spec.param<bool>(seq_big_endian_,
+                     "seq_big_endian",
+                     "Sequence number big endian",
+                     "True if the sequence number field is in network order",
+                     true);
+    spec.param<uint64_t>(first_seq_,
+                         "first_seq",
+                         "First sequence number",
+                         "Sequence number of the first packet of the first batch",
+                         0);
   }
 
+  void start() override {
+    if (!event_driven_.get()) { return; }
+
+    std::vector<int> queues(get_num_rx_queues(port_id_));
+    std::iota(queues.begin(), queues.end(), 0);
+    rx_condition_->watch(port_id_, queues);
+  }
+
+  void stop() override { rx_condition_->unwatch(); }
+
   // Free buffers if CUDA processing/copy is complete
   void free_processed_packets() {
     // Iterate through the batches tracked for processing
@@ -164,6 +240,7 @@ class AdvNetworkingBenchDefaultRxOp : public Operator {
       const auto batch = batch_q_.front();
       // If CUDA processing/copy is complete, free the packets for all bursts in this batch
       if (cudaEventQuery(batch.evt) == cudaSuccess) {
+        if (seq_width_.get() > 0) { count_seq_gaps(batch.idx); }
         for (auto m = 0; m < batch.num_bursts; m++) {
           free_all_packets_and_burst_rx(batch.bursts[m]);
         }
@@ -175,7 +252,21 @@ class AdvNetworkingBenchDefaultRxOp : public Operator {
     }
   }
 
-  void compute(InputContext& op_input, OutputContext&, ExecutionContext& context) override {
+  void compute(InputContext&, OutputContext&, ExecutionContext&) override {
+    process_rx_bursts();
+
+    // Keep polling while batches are in flight, their packets must be freed for the NIC to
+    // receive more bursts
+    if (batch_q_.empty()) { rx_condition_->rearm(); }
+  }
+
+ private:
+  // TODO: make configurable?
+  static constexpr int num_concurrent = 10;  // Number of concurrent batches processing
+  // TODO: could infer with (batch_size / burst size)
+  static constexpr int MAX_BURSTS_PER_BATCH = 10;
+
+  void process_rx_bursts() {
     // If we processed a batch of packets in a previous compute call, that was done asynchronously,
     // and we'll need to free the packets eventually so the NIC can have space for the next bursts.
     // Ideally, we'd free the packets on a callback from CUDA, but that is slow. For that reason and
@@ -211,35 +302,35 @@ class AdvNetworkingBenchDefaultRxOp : public Operator {
           // Header-Data-Split: header to CPU, payload to GPU
           // NOTE: current App assumes only two memory region segments, one for header (CPU),
           //       and one for payload (GPU).
-          for (int p = 0; p < burst_size; p++) {
-            // Get pointers to payload data on GPU
-            // NOTE: It's (1) here since the GPU memory region is second in the list for this queue.
-            //       The first region (0) is for headers on CPU, ignored here.
-            // NOTE: currently ordering pointers in the order packets come in. If headers had
-            //       segment ID, the index in h_dev_ptrs_ should use that
-            //       (instead of aggr_pkts_recv_ + p).
+          // Get pointers to payload data on GPU
+          // NOTE: It's (1) here since the GPU memory region is second in the list for this queue.
+          //       The first region (0) is for headers on CPU, ignored here.
+          // NOTE: currently ordering pointers in the order packets come in. If headers had
+          //       segment ID, the index in h_dev_ptrs_ should use that
+          //       (instead of aggr_pkts_recv_ + p).
   #if (BURST_ACCESS_METHOD == BURST_ACCESS_METHOD_DIRECT_ACCESS)
+          for (int p = 0; p < burst_size; p++) {
             h_dev_ptrs_[cur_batch_idx_][aggr_pkts_recv_ + p] = burst->pkts[1][p];
             ttl_bytes_recv_ += burst->pkt_lens[0][p] + burst->pkt_lens[1][p];
+          }
   #else
-            h_dev_ptrs_[cur_batch_idx_][aggr_pkts_recv_ + p] = get_segment_packet_ptr(burst, 1, p);
-            ttl_bytes_recv_ +=
-                get_segment_packet_length(burst, 0, p) + get_segment_packet_length(burst, 1, p);
+          get_packet_ptrs(burst, 1, &h_dev_ptrs_[cur_batch_idx_][aggr_pkts_recv_]);
+          add_segment_bytes(burst, 0);
+          add_segment_bytes(burst, 1);
   #endif
-          }
         } else {
           // Batched: headers and payload to GPU (queue memory regions should be a single
           // GPU segment)
+          // NOTE: currently ordering pointers in the order packets come in. If headers had
+          //       segment ID, the index in h_dev_ptrs_ should use that (instead of
+          //       aggr_pkts_recv_ + p).
+          void** dev_ptrs = &h_dev_ptrs_[cur_batch_idx_][aggr_pkts_recv_];
+          get_packet_ptrs(burst, 0, dev_ptrs);
           for (int p = 0; p < burst_size; p++) {
-            // Get pointers to payload data on GPU (shifting by header size)
-            // NOTE: currently ordering pointers in the order packets come in. If headers had
-            //       segment ID, the index in h_dev_ptrs_ should use that (instead of
-            //       aggr_pkts_recv_ + p).
-            h_dev_ptrs_[cur_batch_idx_][aggr_pkts_recv_ + p] =
-                reinterpret_cast<uint8_t*>(get_segment_packet_ptr(burst, 0, p)) +
-                header_size_.get();
-            ttl_bytes_recv_ += get_segment_packet_length(burst, 0, p);
+            // Shift payload pointers on GPU by header size
+            dev_ptrs[p] = reinterpret_cast<uint8_t*>(dev_ptrs[p]) + header_size_.get();
           }
+          add_segment_bytes(burst, 0);
         }
       } else {
         /* CPU Mode (needs to match if the advanced_network queue uses no GPU memory regions)
@@ -323,13 +414,18 @@ class AdvNetworkingBenchDefaultRxOp : public Operator {
         if (gpu_direct_.get()) {
           // GPUDirect mode: we copy the payload (referenced in h_dev_ptrs_)
           // to a contiguous memory buffer (full_batch_data_d_)
-          // NOTE: there is no actual reordering since we use the same order as packets came in,
-          //   but they would be reordered if h_dev_ptrs_ was filled based on packet sequence id.
-          simple_packet_reorder(static_cast<uint8_t*>(full_batch_data_d_[cur_batch_idx_]),
-                                h_dev_ptrs_[cur_batch_idx_],
-                                nom_payload_size_,
-                                batch_size_.get(),
-                                streams_[cur_batch_idx_]);
+          if (seq_width_.get() > 0) {
+            // Each payload goes to the slot of its sequence number in the batch, wherever it
+            // arrived, and the slots left empty are counted once the batch is done
+            reorder_by_sequence(cur_batch_idx_);
+          } else {
+            // NOTE: there is no actual reordering since we use the same order as packets came in
+            simple_packet_reorder(static_cast<uint8_t*>(full_batch_data_d_[cur_batch_idx_]),
+                                  h_dev_ptrs_[cur_batch_idx_],
+                                  nom_payload_size_,
+                                  batch_size_.get(),
+                                  streams_[cur_batch_idx_]);
+          }
 
         } else {
           // Non GPUDirect mode: we copy the payload on host-pinned memory (in full_batch_data_h_)
@@ -355,6 +451,7 @@ class AdvNetworkingBenchDefaultRxOp : public Operator {
         */
         cudaEventRecord(events_[cur_batch_idx_], streams_[cur_batch_idx_]);
         cur_batch_.evt = events_[cur_batch_idx_];
+        cur_batch_.idx = cur_batch_idx_;
         batch_q_.push(cur_batch_);
 
         // CUDA Error checking
@@ -375,17 +472,58 @@ class AdvNetworkingBenchDefaultRxOp : public Operator {
     }
   }
 
- private:
-  // TODO: make configurable?
-  static constexpr int num_concurrent = 10;  // Number of concurrent batches processing
-  // TODO: could infer with (batch_size / burst size)
-  static constexpr int MAX_BURSTS_PER_BATCH = 10;
+  // Scatter the payloads of a batch by sequence number, batch n holding batch_size packets from
+  // first_seq + n * batch_size, then copy the batch's gap counters back to the host
+  void reorder_by_sequence(int idx) {
+    const uint32_t num_slots = batch_size_.get();
+    const cudaStream_t stream = streams_[idx];
+    seq_packet_reorder_reset(missing_d_[idx], num_slots, stream);
+    cudaMemsetAsync(outside_d_[idx], 0, sizeof(uint32_t), stream);
+    seq_packet_reorder(full_batch_data_d_[idx],
+                       missing_d_[idx],
+                       outside_d_[idx],
+                       h_dev_ptrs_[idx],
+                       0,
+                       nom_payload_size_,
+                       num_slots,
+                       seq_offset_.get(),
+                       seq_width_.get(),
+                       seq_big_endian_.get(),
+                       next_first_seq_,
+                       num_slots,
+                       stream);
+    cudaMemcpyAsync(missing_h_[idx],
+                    missing_d_[idx],
+                    (num_slots + 31) / 32 * sizeof(uint32_t),
+                    cudaMemcpyDefault,
+                    stream);
+    cudaMemcpyAsync(outside_h_[idx], outside_d_[idx], sizeof(uint32_t), cudaMemcpyDefault, stream);
+    next_first_seq_ += num_slots;
+  }
+
+  // Add the gap counters of a completed batch to the totals
+  void count_seq_gaps(int idx) {
+    const uint32_t num_words = (batch_size_.get() + 31) / 32;
+    for (uint32_t w = 0; w < num_words; w++) {
+      ttl_seq_missing_ += __builtin_popcount(missing_h_[idx][w]);
+    }
+    ttl_seq_outside_ += *outside_h_[idx];
+  }
+
+  // Add the bytes of one segment of all packets in a burst to the received bytes
+  void add_segment_bytes(BurstParams* burst, int seg) {
+    const auto burst_size = get_num_packets(burst);
+    pkt_lens_.resize(std::max(pkt_lens_.size(), static_cast<size_t>(burst_size)));
+    if (get_packet_lengths(burst, seg, pkt_lens_.data()) != Status::SUCCESS) { return; }
+    for (int p = 0; p < burst_size; p++) { ttl_bytes_recv_ += pkt_lens_[p]; }
+  }
 
   // Holds burst buffers that cannot be freed yet and CUDA event indicating when they can be freed
   struct BatchAggregationParams {
     std::array<BurstParams*, MAX_BURSTS_PER_BATCH> bursts;
     int num_bursts;
     cudaEvent_t evt;
+    int idx;  // Index of the batch buffers
   };
 
   int port_id_;                                    // Port ID to poll on
@@ -399,6 +537,7 @@ class AdvNetworkingBenchDefaultRxOp : public Operator {
   uint16_t nom_payload_size_;                      // Nominal payload size (no headers)
   std::array<void**, num_concurrent> h_dev_ptrs_;  // Host-pinned list of device pointers
   std::array<void*, num_concurrent> full_batch_data_d_;  // Device aggregated batch
+  std::vector<uint16_t> pkt_lens_;                       // Segment lengths of a burst
   std::array<void*, num_concurrent> full_batch_data_h_;  // Host aggregated batch
   Parameter<std::string> interface_name_;                // Port name from advanced_network config
   Parameter<bool> hds_;                                  // Header-data split enabled
@@ -406,6 +545,19 @@ class AdvNetworkingBenchDefaultRxOp : public Operator {
   Parameter<uint32_t> batch_size_;                       // Batch size for one processing block
   Parameter<uint16_t> max_packet_size_;                  // Maximum size of a single packet
   Parameter<uint16_t> header_size_;                      // Header size of packet
+  Parameter<bool> event_driven_;                         // Wait for ready RX bursts
+  std::shared_ptr<AdvNetworkRxCondition> rx_condition_;  // Scheduling condition of RX bursts
+  Parameter<uint16_t> seq_width_;                        // Sequence number width, 0 if unused
+  Parameter<uint16_t> seq_offset_;                       // Sequence number offset in payload
+  Parameter<bool> seq_big_endian_;                       // Sequence number in network order
+  Parameter<uint64_t> first_seq_;                        // Sequence number of the first batch
+  uint64_t next_first_seq_ = 0;                          // First sequence number of next batch
+  int64_t ttl_seq_missing_ = 0;                          // Slots never filled in their batch
+  int64_t ttl_seq_outside_ = 0;                          // Packets outside their batch
+  std::array<uint32_t*, num_concurrent> missing_d_{};    // Missing slot bitmap of each batch
+  std::array<uint32_t*, num_concurrent> outside_d_{};    // Packets outside each batch
+  std::array<uint32_t*, num_concurrent> missing_h_{};    // Host copies of the counters
+  std::array<uint32_t*, num_concurrent> outside_h_{};
 
   std::array<cudaStream_t, num_concurrent> streams_;
   std::array<cudaEvent_t, num_concurrent> events_;
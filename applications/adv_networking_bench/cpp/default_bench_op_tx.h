@@ -53,7 +53,7 @@ class AdvNetworkingBenchDefaultTxOp : public Operator {
     HOLOSCAN_LOG_INFO("Advanced Networking Benchmark TX op shutting down");
   }
 
-  void populate_dummy_headers(UDPIPV4Pkt& pkt) {
+  void populate_dummy_headers(UDPIPV4Pkt& pkt, uint16_t udp_src_port) {
     // get_mac_addr(port_id_, reinterpret_cast<char*>(&pkt.eth.h_source[0]));
     memcpy(pkt.eth.h_dest, eth_dst_, sizeof(pkt.eth.h_dest));
     pkt.eth.h_proto = htons(0x0800);
@@ -73,7 +73,7 @@ class AdvNetworkingBenchDefaultTxOp : public Operator {
 
     pkt.udp.check = 0;
     pkt.udp.dest = htons(udp_dst_port_.get());
-    pkt.udp.source = htons(udp_src_port_.get());
+    pkt.udp.source = htons(udp_src_port);
     pkt.udp.len = htons(ip_len - sizeof(pkt.ip));
   }
 
@@ -87,6 +87,22 @@ class AdvNetworkingBenchDefaultTxOp : public Operator {
       exit(1);
     }
 
+    if (num_flows_.get() == 0) {
+      HOLOSCAN_LOG_ERROR("num_flows must be at least 1");
+      exit(1);
+    }
+
+    if (seq_width_.get() > 0) {
+      const auto width = seq_width_.get();
+      if (!gpu_direct_.get() || !(width == 1 || width == 2 || width == 4 || width == 8) ||
+          seq_offset_.get() + width > payload_size_.get()) {
+        HOLOSCAN_LOG_ERROR("Sequence numbers need gpu_direct and a 1, 2, 4 or 8 byte field "
+                           "inside the payload");
+        exit(1);
+      }
+      next_seq_ = first_seq_.get();
+    }
+
     size_t buf_size = batch_size_.get() * payload_size_.get();
     if (!gpu_direct_.get()) {
       full_batch_data_h_ = malloc(buf_size);
@@ -119,16 +135,21 @@ class AdvNetworkingBenchDefaultTxOp : public Operator {
     // but this header will not be correct without modification of the IP and MAC. In a
     // real situation the header would likely be constructed on the GPU
     if (gpu_direct_.get() && hds_.get() == 0) {
-      cudaMalloc(&gds_header_, header_size_.get());
-      cudaMemset(gds_header_, 0, header_size_.get());
+      cudaMalloc(&gds_header_, header_size_.get() * num_flows_.get());
+      cudaMemset(gds_header_, 0, header_size_.get() * num_flows_.get());
+
+      // Copy one pre-made header per flow to GPU
+      for (int flow = 0; flow < num_flows_.get(); flow++) {
+        populate_dummy_headers(pkt, udp_src_port_.get() + flow);
+        cudaMemcpy(static_cast<uint8_t*>(gds_header_) + flow * header_size_.get(),
+                   reinterpret_cast<void*>(&pkt),
+                   sizeof(pkt),
+                   cudaMemcpyDefault);
+      }
 
-      populate_dummy_headers(pkt);
       // advanced_network expects host order when setting
       ip_src_ = ntohl(ip_src_);
       ip_dst_ = ntohl(ip_dst_);
-
-      // Copy the pre-made header to GPU
-      cudaMemcpy(gds_header_, reinterpret_cast<void*>(&pkt), sizeof(pkt), cudaMemcpyDefault);
     }
 
     HOLOSCAN_LOG_INFO("AdvNetworkingBenchDefaultTxOp::initialize() complete");
@@ -155,6 +176,12 @@ class AdvNetworkingBenchDefaultTxOp : public Operator {
     spec.param<uint16_t>(udp_src_port_, "udp_src_port", "UDP source port", "UDP source port");
     spec.param<uint16_t>(
         udp_dst_port_, "udp_dst_port", "UDP destination port", "UDP destination port");
+    spec.param<uint16_t>(num_flows_,
+                         "num_flows",
+                         "Number of flows",
+                         "Number of UDP source ports, starting at udp_src_port, used in turn "
+                         "by each burst",
+                         1);
     spec.param<std::string>(ip_src_addr_, "ip_src_addr", "IP source address", "IP source address");
     spec.param<std::string>(
         ip_dst_addr_, "ip_dst_addr", "IP destination address", "IP destination address");
@@ -171,6 +198,27 @@ class AdvNetworkingBenchDefaultTxOp : public Operator {
                             "interface_name",
                             "Name of NIC from advanced_network config",
                             "Name of NIC from advanced_network config");
+    spec.param<uint16_t>(seq_width_,
+                         "seq_width",
+                         "Sequence number width",
+                         "Width in bytes of a sequence number written into each payload (1, 2, "
+                         "4 or 8), 0 for none. GPUDirect only",
+                         0);
+    spec.param<uint16_t>(seq_offset_,
+                         "seq_offset",
+                         "Sequence number offset",
+                         "Offset in bytes of the sequence number field into the payload",
+                         0);
+    spec.param<bool>(seq_big_endian_,
+                     "seq_big_endian",
+                     "Sequence number big endian",
+                     "Write the sequence number field in network order",
+                     true);
+    spec.param<uint64_t>(first_seq_,
+                         "first_seq",
+                         "First sequence number",
+                         "Sequence number of the first packet sent",
+                         0);
   }
 
   void compute(InputContext&, OutputContext& op_output, ExecutionContext&) override {
@@ -233,7 +281,7 @@ class AdvNetworkingBenchDefaultTxOp : public Operator {
                                        num_pkt,
                                        // Remove Eth + IP + UDP headers
                                        payload_size_.get() + header_size_.get() - (14 + 20 + 8),
-                                       udp_src_port_.get(),
+                                       udp_src_port_.get() + cur_flow_,
                                        udp_dst_port_.get())) != Status::SUCCESS) {
           HOLOSCAN_LOG_ERROR("Failed to set UDP header for packet {}", 0);
           free_all_packets_and_burst_tx(msg);
@@ -283,7 +331,7 @@ class AdvNetworkingBenchDefaultTxOp : public Operator {
     // In GPU-only mode copy the header
     if (gpu_direct_.get() && hds_.get() == 0) {
       copy_headers(gpu_bufs[cur_idx],
-                   gds_header_,
+                   static_cast<uint8_t*>(gds_header_) + cur_flow_ * header_size_.get(),
                    header_size_.get(),
                    get_num_packets(msg),
                    streams_[cur_idx]);
@@ -297,11 +345,22 @@ class AdvNetworkingBenchDefaultTxOp : public Operator {
                        get_num_packets(msg),
                        offset,
                        streams_[cur_idx]);
+      if (seq_width_.get() > 0) {
+        write_sequence_numbers(gpu_bufs[cur_idx],
+                               offset + seq_offset_.get(),
+                               seq_width_.get(),
+                               seq_big_endian_.get(),
+                               next_seq_,
+                               get_num_packets(msg),
+                               streams_[cur_idx]);
+        next_seq_ += get_num_packets(msg);
+      }
       cudaEventRecord(events_[cur_idx], streams_[cur_idx]);
       out_q.push(TxMsg{msg, events_[cur_idx]});
     }
 
     cur_idx = (++cur_idx % num_concurrent);
+    cur_flow_ = (cur_flow_ + 1) % num_flows_.get();
 
     if (gpu_direct_.get()) {
       const auto first = out_q.front();
@@ -334,6 +393,7 @@ class AdvNetworkingBenchDefaultTxOp : public Operator {
   UDPIPV4Pkt pkt;
   void* gds_header_;
   int cur_idx = 0;
+  int cur_flow_ = 0;
   int port_id_;
   Parameter<int> hds_;          // Header-data split point
   Parameter<bool> gpu_direct_;  // GPUDirect enabled
@@ -343,9 +403,15 @@ class AdvNetworkingBenchDefaultTxOp : public Operator {
   Parameter<uint16_t> payload_size_;
   Parameter<uint16_t> udp_src_port_;
   Parameter<uint16_t> udp_dst_port_;
+  Parameter<uint16_t> num_flows_;  // UDP source ports to spread bursts over
   Parameter<std::string> ip_src_addr_;
   Parameter<std::string> ip_dst_addr_;
   Parameter<std::string> eth_dst_addr_;
+  Parameter<uint16_t> seq_width_;  // Sequence number width, 0 for none
+  Parameter<uint16_t> seq_offset_;  // Sequence number offset in payload
+  Parameter<bool> seq_big_endian_;
+  Parameter<uint64_t> first_seq_;
+  uint64_t next_seq_ = 0;  // Sequence number of the next packet
 };
 
 }  // namespace holoscan::ops
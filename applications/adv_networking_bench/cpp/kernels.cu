@@ -17,6 +17,10 @@
 
 #include <assert.h>
 #include <stdio.h>
+#include <algorithm>
+#include <random>
+#include <vector>
+#include "advanced_network/kernels.h"
 #include "kernels.cuh"
 #include "matx.h"
 
@@ -66,3 +70,149 @@ void copy_headers(uint8_t** gpu_bufs, void* header, uint16_t hdr_size, uint32_t
                   cudaStream_t stream) {
   copy_headers<<<num_pkts, 32, 0, stream>>>(gpu_bufs, header, hdr_size);
 }
+
+__global__ void write_sequence_numbers(uint8_t** gpu_bufs, uint16_t offset, uint8_t width,
+                                       bool big_endian, uint64_t first_seq, uint32_t num_pkts) {
+  const uint32_t pkt = blockIdx.x * blockDim.x + threadIdx.x;
+  if (pkt >= num_pkts) return;
+
+  const uint64_t seq = first_seq + pkt;
+  uint8_t* field = gpu_bufs[pkt] + offset;
+  for (int i = 0; i < width; i++) {
+    field[big_endian ? width - 1 - i : i] = static_cast<uint8_t>(seq >> (8 * i));
+  }
+}
+
+/**
+ * @brief Write consecutive sequence numbers into a field of each packet
+ *
+ * @param gpu_bufs GPU packet pointer list from advanced_network "gpu_pkts"
+ * @param offset Offset of the sequence number field into each packet
+ * @param width Width of the field in bytes, it wraps at its width
+ * @param big_endian True to write the field in network order
+ * @param first_seq Sequence number of the first packet
+ * @param num_pkts Number of packets
+ * @param stream CUDA stream
+ */
+void write_sequence_numbers(uint8_t** gpu_bufs, uint16_t offset, uint8_t width, bool big_endian,
+                            uint64_t first_seq, uint32_t num_pkts, cudaStream_t stream) {
+  const uint32_t threads = 128;
+  if (num_pkts == 0) return;
+  write_sequence_numbers<<<(num_pkts + threads - 1) / threads, threads, 0, stream>>>(
+      gpu_bufs, offset, width, big_endian, first_seq, num_pkts);
+}
+
+/**
+ * @brief Check seq_packet_reorder against a host reference
+ *
+ * Shuffled packets of a frame whose sequence numbers wrap at the field width, with a few slots
+ * never sent and a few packets before and after the frame, are scattered by seq_packet_reorder.
+ * Their start is misaligned so that the byte copy path runs. The frame, the missing bitmap and
+ * the dropped count are compared with what was sent.
+ *
+ * @param seq_offset Offset of the sequence number field into each packet
+ * @param seq_width Width of the sequence number field in bytes: 1, 2, 4 or 8
+ * @param seq_big_endian True if the sequence number field is big endian
+ * @return true if the kernel output matches the reference
+ */
+bool check_seq_packet_reorder(uint16_t seq_offset, uint8_t seq_width, bool seq_big_endian) {
+  constexpr uint32_t num_slots = 100;
+  constexpr uint32_t missing_every = 7;
+  constexpr uint32_t num_outside = 4;
+  const uint16_t pkt_len = seq_offset + seq_width + 61;
+  const uint32_t pkt_stride = pkt_len + 3;
+  const uint32_t num_words = (num_slots + 31) / 32;
+  const uint64_t seq_mask = seq_width >= 8 ? ~0ULL : ((1ULL << (seq_width * 8)) - 1);
+  // Wraps inside the frame
+  const uint64_t first_seq = seq_mask - num_slots / 2;
+
+  auto write_seq = [&](uint8_t* pkt, uint64_t seq) {
+    for (int i = 0; i < seq_width; i++) {
+      pkt[seq_offset + (seq_big_endian ? seq_width - 1 - i : i)] =
+          static_cast<uint8_t>(seq >> (8 * i));
+    }
+  };
+
+  // Sent packets, in sequence order: the frame minus the missing slots, then the ones outside
+  std::vector<uint8_t> expected_frame(num_slots * pkt_len, 0);
+  std::vector<uint32_t> expected_missing(num_words, 0);
+  std::vector<std::vector<uint8_t>> pkts;
+  for (uint32_t slot = 0; slot < num_slots; slot++) {
+    if (slot % missing_every == 3) {
+      expected_missing[slot / 32] |= 1U << (slot % 32);
+      continue;
+    }
+    std::vector<uint8_t> pkt(pkt_len);
+    for (uint32_t b = 0; b < pkt_len; b++) { pkt[b] = static_cast<uint8_t>(slot * 31 + b); }
+    write_seq(pkt.data(), (first_seq + slot) & seq_mask);
+    std::copy(pkt.begin(), pkt.end(), expected_frame.begin() + slot * pkt_len);
+    pkts.push_back(std::move(pkt));
+  }
+  for (uint32_t k = 0; k < num_outside; k++) {
+    std::vector<uint8_t> before(pkt_len, 0xA5);
+    std::vector<uint8_t> after(pkt_len, 0x5A);
+    write_seq(before.data(), (first_seq - 1 - k) & seq_mask);
+    write_seq(after.data(), (first_seq + num_slots + k) & seq_mask);
+    pkts.push_back(std::move(before));
+    pkts.push_back(std::move(after));
+  }
+  std::shuffle(pkts.begin(), pkts.end(), std::mt19937(1234));
+
+  const uint32_t num_pkts = pkts.size();
+  std::vector<uint8_t> staged(num_pkts * pkt_stride, 0);
+  for (uint32_t p = 0; p < num_pkts; p++) {
+    std::copy(pkts[p].begin(), pkts[p].end(), staged.begin() + p * pkt_stride + 1);
+  }
+
+  uint8_t* pkts_d = nullptr;
+  void** ptrs_d = nullptr;
+  uint8_t* frame_d = nullptr;
+  uint32_t* missing_d = nullptr;
+  uint32_t* dropped_d = nullptr;
+  bool ok = cudaMalloc(&pkts_d, staged.size()) == cudaSuccess &&
+            cudaMalloc(&ptrs_d, num_pkts * sizeof(void*)) == cudaSuccess &&
+            cudaMalloc(&frame_d, expected_frame.size()) == cudaSuccess &&
+            cudaMalloc(&missing_d, num_words * sizeof(uint32_t)) == cudaSuccess &&
+            cudaMalloc(&dropped_d, sizeof(uint32_t)) == cudaSuccess;
+
+  std::vector<uint8_t> frame(expected_frame.size());
+  std::vector<uint32_t> missing(num_words);
+  uint32_t dropped = 0;
+  if (ok) {
+    std::vector<void*> ptrs(num_pkts);
+    for (uint32_t p = 0; p < num_pkts; p++) { ptrs[p] = pkts_d + p * pkt_stride + 1; }
+    cudaMemcpy(pkts_d, staged.data(), staged.size(), cudaMemcpyDefault);
+    cudaMemcpy(ptrs_d, ptrs.data(), num_pkts * sizeof(void*), cudaMemcpyDefault);
+    cudaMemset(frame_d, 0, expected_frame.size());
+    cudaMemset(dropped_d, 0, sizeof(uint32_t));
+
+    seq_packet_reorder_reset(missing_d, num_slots, 0);
+    seq_packet_reorder(frame_d, missing_d, dropped_d, ptrs_d, 0, pkt_len, num_pkts, seq_offset,
+                       seq_width, seq_big_endian, first_seq, num_slots, 0);
+
+    ok = cudaMemcpy(frame.data(), frame_d, frame.size(), cudaMemcpyDefault) == cudaSuccess &&
+         cudaMemcpy(missing.data(), missing_d, num_words * sizeof(uint32_t),
+                    cudaMemcpyDefault) == cudaSuccess &&
+         cudaMemcpy(&dropped, dropped_d, sizeof(uint32_t), cudaMemcpyDefault) == cudaSuccess;
+  }
+
+  cudaFree(pkts_d);
+  cudaFree(ptrs_d);
+  cudaFree(frame_d);
+  cudaFree(missing_d);
+  cudaFree(dropped_d);
+
+  if (!ok) {
+    printf("seq_packet_reorder check failed to run\n");
+    return false;
+  }
+  if (frame != expected_frame || missing != expected_missing || dropped != 2 * num_outside) {
+    printf("seq_packet_reorder check mismatch: frame %s, missing bitmap %s, %u/%u dropped\n",
+           frame == expected_frame ? "ok" : "wrong",
+           missing == expected_missing ? "ok" : "wrong",
+           dropped,
+           2 * num_outside);
+    return false;
+  }
+  return true;
+}
@@ -15,6 +15,8 @@
  * limitations under the License.
  */
 
+#pragma once
+
 #include <cuda.h>
 #include <cuda_runtime.h>
 #include <cuda/std/complex>
@@ -24,3 +26,8 @@ void populate_packets(uint8_t** gpu_bufs, uint16_t pkt_len, uint32_t num_pkts, u
 
 void copy_headers(uint8_t** gpu_bufs, void* header, uint16_t hdr_size, uint32_t num_pkts,
                   cudaStream_t stream);
+
+void write_sequence_numbers(uint8_t** gpu_bufs, uint16_t offset, uint8_t width, bool big_endian,
+                            uint64_t first_seq, uint32_t num_pkts, cudaStream_t stream);
+
+bool check_seq_packet_reorder(uint16_t seq_offset, uint8_t seq_width, bool seq_big_endian);
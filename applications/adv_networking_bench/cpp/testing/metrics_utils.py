@@ -0,0 +1,140 @@
+#!/usr/bin/env python3
+# SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+# SPDX-License-Identifier: Apache-2.0
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+import logging
+import re
+import sys
+import time
+import urllib.request
+from typing import Dict, List, Optional, Tuple
+
+# Configure the logger
+logger = logging.getLogger(__name__)
+
+# One sample of the Prometheus text format: name{labels} value
+_SAMPLE_PATTERN = re.compile(r"^([a-zA-Z_:][a-zA-Z0-9_:]*)(?:\{([^}]*)\})?\s+(\S+)$")
+_LABEL_PATTERN = re.compile(r'(\w+)="([^"]*)"')
+
+
+class MetricsSnapshot:
+    """Samples of one scrape of the advanced_network metrics endpoint."""
+
+    def __init__(self, samples: List[Tuple[str, Dict[str, str], float]], timestamp: float):
+        """
+        Initialize a snapshot from parsed samples.
+
+        Args:
+            samples: List of (metric name, labels, value) tuples
+            timestamp: Time of the scrape in seconds (time.monotonic)
+        """
+        self.samples = samples
+        self.timestamp = timestamp
+
+    def sum(self, name: str, **labels) -> float:
+        """
+        Sum all samples of a metric matching the given labels.
+
+        Args:
+            name: Metric name
+            labels: Label values the samples must have
+
+        Returns:
+            float: Sum of the matching samples, 0 if there are none
+        """
+        return sum(
+            value
+            for sample_name, sample_labels, value in self.samples
+            if sample_name == name and all(sample_labels.get(k) == v for k, v in labels.items())
+        )
+
+    def has(self, name: str, **labels) -> bool:
+        """Whether the snapshot has at least one sample of a metric matching the given labels."""
+        return any(
+            sample_name == name and all(sample_labels.get(k) == v for k, v in labels.items())
+            for sample_name, sample_labels, _ in self.samples
+        )
+
+    def latency_quantiles(self, stage: str) -> Optional[Dict[str, float]]:
+        """
+        Get the p50/p99/p99.9 RX burst latency of a stage, using the worst queue.
+
+        Args:
+            stage: Latency stage label, e.g. "wire_to_dequeue"
+
+        Returns:
+            Dict mapping p50, p99 and p999 to nanoseconds, None if the stage was not measured
+        """
+        quantiles = {"0.5": "p50_ns", "0.99": "p99_ns", "0.999": "p999_ns"}
+        result = {}
+        for name, labels, value in self.samples:
+            if name != "advanced_network_rx_latency_nanoseconds" or labels.get("stage") != stage:
+                continue
+            key = quantiles.get(labels.get("quantile"))
+            if key is not None:
+                result[key] = max(result.get(key, 0.0), value)
+        return result or None
+
+
+def parse_prometheus(text: str) -> List[Tuple[str, Dict[str, str], float]]:
+    """
+    Parse the Prometheus text exposition format.
+
+    Args:
+        text: Body of a /metrics response
+
+    Returns:
+        List of (metric name, labels, value) tuples
+    """
+    samples = []
+    for line in text.splitlines():
+        if not line or line.startswith("#"):
+            continue
+        match = _SAMPLE_PATTERN.match(line.strip())
+        if not match:
+            logger.debug(f"Skipping unparsable metrics line: {line}")
+            continue
+        name, labels, value = match.groups()
+        samples.append((name, dict(_LABEL_PATTERN.findall(labels or "")), float(value)))
+    return samples
+
+
+def scrape_metrics(url: str, timeout: float = 1.0) -> Optional[MetricsSnapshot]:
+    """
+    Scrape the advanced_network metrics endpoint.
+
+    Args:
+        url: URL of the endpoint, e.g. http://127.0.0.1:9400/metrics
+        timeout: Request timeout in seconds
+
+    Returns:
+        MetricsSnapshot, or None if the endpoint could not be reached
+    """
+    try:
+        with urllib.request.urlopen(url, timeout=timeout) as response:
+            body = response.read().decode("utf-8")
+    except Exception as e:
+        logger.debug(f"Failed to scrape {url}: {e}")
+        return None
+    return MetricsSnapshot(parse_prometheus(body), time.monotonic())
+
+
+if __name__ == "__main__":
+    # Set up console logging if run directly
+    logging.basicConfig(
+        level=logging.INFO, format="%(asctime)s - %(name)s - %(levelname)s - %(message)s"
+    )
+    logger.info("This module is designed to be imported, not run directly.")
+    sys.exit(0)
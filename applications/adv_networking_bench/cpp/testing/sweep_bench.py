@@ -0,0 +1,499 @@
+#!/usr/bin/env python3
+# SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+# SPDX-License-Identifier: Apache-2.0
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+"""
+Sweep the Advanced Networking Benchmark over packet size, batch size, queue count and memory kind
+for each manager, and write the throughput, drop rate and burst latency of every point as JSON.
+
+Rates are computed from the advanced_network metrics endpoint between the end of the warmup and
+the last scrape before the application exits, so they exclude startup and shutdown. Runs that
+could not be scraped fall back to the totals printed at shutdown, over the whole execution time.
+
+Example:
+    python3 testing/sweep_bench.py --managers dpdk gpunetio --packet-sizes 64 1500 9000 \\
+        --batch-sizes 1024 10240 --num-queues 1 2 --memory-kinds huge device \\
+        --rx-cores 9 10 --output sweep.json --baseline sweep_previous_release.json
+"""
+
+import argparse
+import copy
+import datetime
+import itertools
+import json
+import logging
+import os
+import platform
+import subprocess
+import sys
+import threading
+import time
+from typing import Any, Dict, List, Optional
+
+from benchmark_utils import parse_benchmark_results
+from metrics_utils import MetricsSnapshot, scrape_metrics
+from nvidia_nic_utils import get_nvidia_nics, print_nvidia_nics
+from process_utils import monitor_process, start_process
+from yaml_config_utils import read_yaml_file, write_yaml_file
+
+# Configure the logger
+logger = logging.getLogger(__name__)
+
+MEMORY_KINDS = ["host", "host_pinned", "huge", "device"]
+UDP_PORT = 4096  # Matches the flows and bench_tx ports of the config files
+LATENCY_STAGES = ["wire_to_dequeue", "ring_to_dequeue", "dequeue_to_free"]
+
+# What each manager can sweep with the benchmark operators of this application:
+# - GPUNetIO receives with GPU kernels polling queue 0 only, so it needs device memory.
+# - Rivermax has no TX operator and receives from an external sender, which sets the packet size.
+MANAGERS = {
+    "dpdk": {
+        "config": "adv_networking_bench_default_tx_rx.yaml",
+        "loopback": True,
+        "memory_kinds": MEMORY_KINDS,
+        "max_queues": None,
+        "packet_size": True,
+    },
+    "gpunetio": {
+        "config": "adv_networking_bench_gpunetio_tx_rx.yaml",
+        "loopback": True,
+        "memory_kinds": ["device"],
+        "max_queues": 1,
+        "packet_size": True,
+    },
+    "rivermax": {
+        "config": "adv_networking_bench_rmax_rx.yaml",
+        "loopback": False,
+        "memory_kinds": None,
+        "max_queues": 1,
+        "packet_size": False,
+    },
+}
+
+
+def _point_key(point: Dict[str, Any]) -> str:
+    """Key identifying a sweep point across runs, used to compare against a baseline."""
+    return "{manager}/pkt{packet_size}/batch{batch_size}/q{num_queues}/{memory_kind}".format(
+        **point
+    )
+
+
+def build_points(args) -> List[Dict[str, Any]]:
+    """
+    Build the list of sweep points, skipping the ones a manager does not support.
+
+    Args:
+        args: Parsed command line arguments
+
+    Returns:
+        List of points, each a dict of manager, packet_size, batch_size, num_queues, memory_kind
+    """
+    points = {}
+    for manager, packet_size, batch_size, num_queues, memory_kind in itertools.product(
+        args.managers, args.packet_sizes, args.batch_sizes, args.num_queues, args.memory_kinds
+    ):
+        caps = MANAGERS[manager]
+        if caps["max_queues"] is not None and num_queues > caps["max_queues"]:
+            logger.info(f"Skipping {num_queues} queues for {manager}: not supported by the bench")
+            continue
+        if caps["memory_kinds"] is not None and memory_kind not in caps["memory_kinds"]:
+            logger.info(f"Skipping memory kind {memory_kind} for {manager}: not supported")
+            continue
+        if num_queues > 1 and len(args.rx_cores) < num_queues:
+            logger.warning(f"Skipping {num_queues} queues: only {len(args.rx_cores)} --rx-cores")
+            continue
+
+        # Axes a manager does not sweep are kept from its config file
+        point = {
+            "manager": manager,
+            "packet_size": packet_size if caps["packet_size"] else None,
+            "batch_size": batch_size,
+            "num_queues": num_queues,
+            "memory_kind": memory_kind if caps["memory_kinds"] is not None else None,
+        }
+        points.setdefault(_point_key(point), point)
+    return list(points.values())
+
+
+def build_config(base: Dict[str, Any], point: Dict[str, Any], args, tx_nic, rx_nic) -> Dict:
+    """
+    Derive the application config of a sweep point from the config file of its manager.
+
+    Args:
+        base: Parsed config file of the manager
+        point: Sweep point
+        args: Parsed command line arguments
+        tx_nic: NetworkInterface sending the packets
+        rx_nic: NetworkInterface receiving the packets
+
+    Returns:
+        Application config
+    """
+    config = copy.deepcopy(base)
+    cfg = config["advanced_network"]["cfg"]
+    config["scheduler"]["max_duration_ms"] = args.duration_ms
+    cfg["metrics"] = {"port": args.metrics_port, "address": "127.0.0.1"}
+
+    interfaces = cfg["interfaces"]
+    rx_if = next(i for i in interfaces if "rx" in i)
+    rx_if["rx"]["latency_stats"] = True
+
+    if point["manager"] == "rivermax":
+        rx_if["address"] = rx_nic.bus_id
+    elif point["manager"] == "gpunetio":
+        # Single port loopback, see test_gpunetio_single_if_loopback
+        interfaces[0]["address"] = tx_nic.bus_id
+        config["bench_tx"]["address"] = tx_nic.bus_id
+        config["bench_tx"]["eth_dst_addr"] = tx_nic.mac_address
+    else:
+        interfaces[0]["address"] = tx_nic.bus_id
+        interfaces[1]["address"] = rx_nic.bus_id
+        config["bench_tx"]["eth_dst_addr"] = rx_nic.mac_address
+
+    # Batch size of the queues and of the operators
+    for interface in interfaces:
+        for direction in ("rx", "tx"):
+            for q in interface.get(direction, {}).get("queues", []):
+                q["batch_size"] = point["batch_size"]
+    config["bench_rx"]["batch_size"] = point["batch_size"]
+    if "bench_tx" in config:
+        config["bench_tx"]["batch_size"] = point["batch_size"]
+
+    if point["packet_size"] is not None:
+        header_size = config["bench_tx"]["header_size"]
+        config["bench_tx"]["payload_size"] = point["packet_size"] - header_size
+        config["bench_rx"]["max_packet_size"] = point["packet_size"]
+        for region in cfg["memory_regions"]:
+            region["buf_size"] = point["packet_size"]
+
+    if point["memory_kind"] is not None:
+        for region in cfg["memory_regions"]:
+            region["kind"] = point["memory_kind"]
+        for op in ("bench_rx", "bench_tx"):
+            if "gpu_direct" in config.get(op, {}):
+                config[op]["gpu_direct"] = point["memory_kind"] == "device"
+
+    # One RX queue per flow, with bench_tx using the UDP source ports of all flows in turn
+    if point["num_queues"] > 1:
+        q_template = rx_if["rx"]["queues"][0]
+        rx_if["rx"]["queues"] = []
+        rx_if["rx"]["flows"] = []
+        for q in range(point["num_queues"]):
+            queue = copy.deepcopy(q_template)
+            queue["name"] = f"rx_q_{q}"
+            queue["id"] = q
+            queue["cpu_core"] = args.rx_cores[q]
+            rx_if["rx"]["queues"].append(queue)
+            rx_if["rx"]["flows"].append(
+                {
+                    "name": f"flow_{q}",
+                    "id": q,
+                    "action": {"type": "queue", "id": q},
+                    "match": {"udp_src": UDP_PORT + q, "udp_dst": UDP_PORT},
+                }
+            )
+        config["bench_tx"]["num_flows"] = point["num_queues"]
+
+    return config
+
+
+def _delta(first: MetricsSnapshot, last: MetricsSnapshot, name: str, **labels) -> float:
+    return last.sum(name, **labels) - first.sum(name, **labels)
+
+
+def compute_metrics_result(first: MetricsSnapshot, last: MetricsSnapshot, loopback: bool) -> Dict:
+    """
+    Compute the rates of a sweep point between two scrapes of the metrics endpoint.
+
+    Args:
+        first: Scrape at the end of the warmup
+        last: Last scrape before the application exits
+        loopback: Whether the packets were sent by the application, to count drops against them
+
+    Returns:
+        Dict of mpps, gbps, drop_rate and latency_ns
+    """
+    elapsed = last.timestamp - first.timestamp
+    rx_pkts = _delta(first, last, "advanced_network_queue_packets_total", dir="rx")
+    rx_bytes = _delta(first, last, "advanced_network_queue_bytes_total", dir="rx")
+    tx_pkts = _delta(first, last, "advanced_network_queue_packets_total", dir="tx")
+    drops = (
+        _delta(first, last, "advanced_network_queue_drops_total", dir="rx")
+        + _delta(first, last, "advanced_network_rx_dropped_total")
+        + _delta(first, last, "advanced_network_port_rx_missed_total")
+    )
+
+    if loopback and tx_pkts > 0:
+        offered = tx_pkts
+        lost = max(0.0, tx_pkts - rx_pkts)
+    else:
+        offered = rx_pkts + drops
+        lost = drops
+
+    # Latency histograms are kept from startup, they are not windowed like the rates
+    latency = {}
+    for stage in LATENCY_STAGES:
+        quantiles = last.latency_quantiles(stage)
+        if quantiles is not None:
+            latency[stage] = quantiles
+
+    return {
+        "source": "metrics",
+        "duration_s": elapsed,
+        "rx_packets": int(rx_pkts),
+        "rx_bytes": int(rx_bytes),
+        "mpps": rx_pkts / elapsed / 1e6,
+        "gbps": rx_bytes * 8 / elapsed / 1e9,
+        "drop_rate": lost / offered if offered > 0 else 0.0,
+        "latency_ns": latency or None,
+    }
+
+
+def compute_log_result(log: str, manager: str) -> Optional[Dict]:
+    """
+    Compute the rates of a sweep point from the totals printed at shutdown.
+
+    Args:
+        log: Output of the application
+        manager: Manager of the sweep point
+
+    Returns:
+        Dict of mpps, gbps, drop_rate and latency_ns, None if the log has no totals to parse
+    """
+    if manager == "rivermax":
+        return None
+
+    results = parse_benchmark_results(log, manager)
+    if results.exec_time == 0:
+        return None
+
+    rx_port = 1 if manager == "dpdk" else 0
+    elapsed = results.exec_time / 1000
+    rx_pkts = results.get_rx_packets(rx_port)
+    tx_pkts = results.get_tx_packets(0)
+    return {
+        "source": "log",
+        "duration_s": elapsed,
+        "rx_packets": rx_pkts,
+        "rx_bytes": results.get_rx_bytes(rx_port),
+        "mpps": rx_pkts / elapsed / 1e6,
+        "gbps": results.get_rx_throughput(rx_port),
+        "drop_rate": max(0, tx_pkts - rx_pkts) / tx_pkts if tx_pkts > 0 else 0.0,
+        "latency_ns": None,
+    }
+
+
+def run_point(executable: str, config_file: str, point: Dict[str, Any], args) -> Dict:
+    """
+    Run the application for one sweep point, scraping its metrics until it exits.
+
+    Args:
+        executable: Path to the adv_networking_bench executable
+        config_file: Config of the sweep point
+        point: Sweep point
+        args: Parsed command line arguments
+
+    Returns:
+        Result of the sweep point
+    """
+    url = f"http://127.0.0.1:{args.metrics_port}/metrics"
+    scrapes = {"first": None, "last": None, "start": None}
+    p = start_process(f"{executable} {config_file}")
+
+    def scrape_until_exit():
+        while p.poll() is None:
+            snapshot = scrape_metrics(url)
+            if snapshot is not None:
+                if scrapes["start"] is None:
+                    scrapes["start"] = snapshot.timestamp
+                if scrapes["first"] is None:
+                    if snapshot.timestamp - scrapes["start"] >= args.warmup_s:
+                        scrapes["first"] = snapshot
+                else:
+                    scrapes["last"] = snapshot
+            time.sleep(args.scrape_interval_s)
+
+    scraper = threading.Thread(target=scrape_until_exit)
+    scraper.start()
+
+    result = dict(point)
+    try:
+        completed = monitor_process(p)
+        log = completed.stdout + completed.stderr
+        result["error"] = None
+    except subprocess.CalledProcessError as e:
+        log = e.stdout + e.stderr
+        result["error"] = f"Application exited with code {e.returncode}"
+    scraper.join()
+
+    if scrapes["first"] is not None and scrapes["last"] is not None:
+        rates = compute_metrics_result(
+            scrapes["first"], scrapes["last"], MANAGERS[point["manager"]]["loopback"]
+        )
+    else:
+        logger.warning(f"Could not scrape {url} during the run, using the shutdown totals")
+        rates = compute_log_result(log, point["manager"])
+
+    if rates is None:
+        result["error"] = result["error"] or "No statistics collected"
+    else:
+        result.update(rates)
+    return result
+
+
+def find_regressions(results: List[Dict], baseline_file: str, tolerance: float) -> List[str]:
+    """
+    Compare results against a previous sweep.
+
+    A point regresses when its packet rate drops, or its p99 latency grows, by more than the
+    tolerance. Points missing from either sweep are ignored.
+
+    Args:
+        results: Results of this sweep
+        baseline_file: JSON output of a previous sweep
+        tolerance: Allowed relative change, e.g. 0.05 for 5%
+
+    Returns:
+        List of descriptions of the regressions
+    """
+    with open(baseline_file, "r") as f:
+        baseline = {_point_key(r): r for r in json.load(f)["results"] if r.get("error") is None}
+
+    regressions = []
+    for result in results:
+        key = _point_key(result)
+        base = baseline.get(key)
+        if base is None or result.get("error") is not None:
+            continue
+
+        if result["mpps"] < base["mpps"] * (1 - tolerance):
+            regressions.append(f"{key}: {result['mpps']:.2f} Mpps, was {base['mpps']:.2f}")
+
+        for stage, quantiles in (result.get("latency_ns") or {}).items():
+            base_quantiles = (base.get("latency_ns") or {}).get(stage)
+            if base_quantiles is None:
+                continue
+            if quantiles["p99_ns"] > base_quantiles["p99_ns"] * (1 + tolerance):
+                regressions.append(
+                    f"{key}: {stage} p99 {quantiles['p99_ns']:.0f} ns, "
+                    f"was {base_quantiles['p99_ns']:.0f} ns"
+                )
+    return regressions
+
+
+def _git_describe() -> Optional[str]:
+    """Describe the holohub checkout the sweep was run from, if any."""
+    result = subprocess.run(
+        "git describe --always --dirty --tags",
+        cwd=os.path.dirname(os.path.abspath(__file__)),
+        stdout=subprocess.PIPE,
+        stderr=subprocess.DEVNULL,
+        shell=True,
+        universal_newlines=True,
+        check=False,
+    )
+    return result.stdout.strip() if result.returncode == 0 else None
+
+
+def parse_args(argv):
+    parser = argparse.ArgumentParser(
+        description="Sweep adv_networking_bench across managers and write the results as JSON"
+    )
+    parser.add_argument(
+        "--workdir",
+        default=os.getcwd(),
+        help="Directory of the adv_networking_bench executable and config files",
+    )
+    parser.add_argument("--managers", nargs="+", choices=list(MANAGERS), default=["dpdk"])
+    parser.add_argument("--packet-sizes", nargs="+", type=int, default=[64, 1500, 9000])
+    parser.add_argument("--batch-sizes", nargs="+", type=int, default=[10240])
+    parser.add_argument("--num-queues", nargs="+", type=int, default=[1])
+    parser.add_argument("--memory-kinds", nargs="+", choices=MEMORY_KINDS, default=["device"])
+    parser.add_argument(
+        "--rx-cores", nargs="+", type=int, default=[], help="CPU cores of the RX queues, when >1"
+    )
+    parser.add_argument("--tx-nic", type=int, default=0, help="Index of the TX NVIDIA NIC")
+    parser.add_argument("--rx-nic", type=int, default=1, help="Index of the RX NVIDIA NIC")
+    parser.add_argument("--duration-ms", type=int, default=15000, help="Run time of each point")
+    parser.add_argument("--warmup-s", type=float, default=3.0, help="Time excluded from rates")
+    parser.add_argument("--scrape-interval-s", type=float, default=0.5)
+    parser.add_argument("--metrics-port", type=int, default=9400)
+    parser.add_argument("--output", default="adv_networking_bench_sweep.json")
+    parser.add_argument("--baseline", help="JSON output of a previous sweep to compare against")
+    parser.add_argument(
+        "--tolerance", type=float, default=5.0, help="Allowed regression vs baseline, in percent"
+    )
+    return parser.parse_args(argv)
+
+
+def main(argv) -> int:
+    args = parse_args(argv)
+    executable = os.path.join(args.workdir, "adv_networking_bench")
+    out_dir = os.path.join(args.workdir, "testing", "sweep")
+
+    nics = get_nvidia_nics()
+    if len(nics) <= max(args.tx_nic, args.rx_nic):
+        logger.error(f"Not enough NVIDIA NICs available (found {len(nics)})")
+        return 1
+    print_nvidia_nics(nics)
+    tx_nic, rx_nic = nics[args.tx_nic], nics[args.rx_nic]
+
+    results = []
+    for point in build_points(args):
+        key = _point_key(point)
+        logger.info(f"Running {key}")
+        base = read_yaml_file(os.path.join(args.workdir, MANAGERS[point["manager"]]["config"]))
+        if not base:
+            results.append(dict(point, error="Failed to read the config file"))
+            continue
+
+        config_file = os.path.join(out_dir, key.replace("/", "_") + ".yaml")
+        write_yaml_file(config_file, build_config(base, point, args, tx_nic, rx_nic))
+        result = run_point(executable, config_file, point, args)
+        if result["error"] is None:
+            logger.info(
+                f"{key}: {result['mpps']:.2f} Mpps, {result['gbps']:.2f} Gbps, "
+                f"drop rate {result['drop_rate']:.2e}"
+            )
+        else:
+            logger.error(f"{key}: {result['error']}")
+        results.append(result)
+
+    output = {
+        "version": 1,
+        "date": datetime.datetime.now(datetime.timezone.utc).isoformat(),
+        "host": platform.node(),
+        "holohub": _git_describe(),
+        "nics": {"tx": str(tx_nic), "rx": str(rx_nic)},
+        "results": results,
+    }
+    with open(args.output, "w") as f:
+        json.dump(output, f, indent=2)
+    logger.info(f"Wrote {len(results)} results to {args.output}")
+
+    if args.baseline:
+        regressions = find_regressions(results, args.baseline, args.tolerance / 100)
+        for regression in regressions:
+            logger.error(f"Regression: {regression}")
+        if regressions:
+            return 1
+    return 0
+
+
+if __name__ == "__main__":
+    logging.basicConfig(
+        level=logging.INFO, format="%(asctime)s - %(name)s - %(levelname)s - %(message)s"
+    )
+    sys.exit(main(sys.argv[1:]))
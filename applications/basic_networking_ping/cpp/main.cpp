@@ -18,6 +18,10 @@
 #include "basic_network_operator_rx.h"
 #include "basic_network_operator_tx.h"
 #include "holoscan/holoscan.hpp"
+#include "ping_pong.h"
+#if ANO_MGR_DPDK
+#include "ping_pong_adv_network.h"
+#endif
 
 static constexpr int NUM_MSGS = 10;
 
@@ -63,7 +67,8 @@ class BasicNetworkPingRxOp : public Operator {
     auto val = *reinterpret_cast<int*>(in->data);
     HOLOSCAN_LOG_INFO("Ping message received with value {}", val);
 
-    delete[] in->data;
+    // Batched bursts point into the RX buffer pool, which frees them
+    if (!in->pooled) { delete[] in->data; }
 
     if (val == NUM_MSGS - 1) { GxfGraphInterrupt(context.context()); }
   }
@@ -73,6 +78,8 @@ class BasicNetworkPingRxOp : public Operator {
 
 }  // namespace holoscan::ops
 
+using holoscan::ops::PingPongSession;
+
 class App : public holoscan::Application {
  public:
   void compose() override {
@@ -80,6 +87,7 @@ class App : public holoscan::Application {
     auto& yaml_nodes = config().yaml_nodes();
     bool rx_en = false;
     bool tx_en = false;
+    bool ping_pong_en = false;
 
     for (const auto& yaml_node : yaml_nodes) {
       try {
@@ -95,6 +103,17 @@ class App : public holoscan::Application {
         HOLOSCAN_LOG_INFO("Transmit enabled");
       }
       catch (YAML::InvalidNode &e) {}
+
+      try {
+        auto tmp = yaml_node["ping_pong"].IsMap();
+        ping_pong_en = true;
+      }
+      catch (YAML::InvalidNode &e) {}
+    }
+
+    if (ping_pong_en) {
+      compose_ping_pong();
+      return;
     }
 
     if (tx_en) {
@@ -112,6 +131,98 @@ class App : public holoscan::Application {
       add_flow(net_rx, rx, {{"burst_out", "burst_in"}});
     }
   }
+
+ private:
+  /**
+   * Round-trip latency benchmark: the initiator sends stamped packets which the echo peer sends
+   * back, over the basic_network sockets ("socket" or "uring" io_engine) or advanced_network.
+   */
+  void compose_ping_pong() {
+    using namespace holoscan;
+    const auto backend = from_config("ping_pong.backend").as<std::string>();
+    const auto role = from_config("ping_pong.role").as<std::string>();
+    const auto payload_size = from_config("ping_pong.payload_size").as<uint32_t>();
+    const auto burst_size = from_config("ping_pong.burst_size").as<uint32_t>();
+    const bool initiator = role == "initiator";
+    if (!initiator && role != "echo") {
+      throw std::runtime_error(fmt::format("Invalid ping_pong role {}", role));
+    }
+    HOLOSCAN_LOG_INFO("Ping-pong {} over {}", role, backend);
+
+    std::shared_ptr<PingPongSession> session;
+    if (initiator) {
+      session = std::make_shared<PingPongSession>(
+          from_config("ping_pong.count").as<uint64_t>(),
+          from_config("ping_pong.histogram_bucket_ns").as<uint64_t>(),
+          from_config("ping_pong.histogram_buckets").as<uint32_t>(),
+          from_config("ping_pong.timeout_ms").as<uint64_t>() * 1000000);
+    }
+
+    // A burst is sent every interval_ns, 0 sends them back to back
+    auto pacing = make_condition<PeriodicCondition>(
+        "pacing",
+        Arg("recess_period") =
+            std::chrono::nanoseconds(from_config("ping_pong.interval_ns").as<int64_t>()));
+
+    if (backend == "dpdk") {
+#if ANO_MGR_DPDK
+      auto adv_net_config = from_config("advanced_network").as<advanced_network::NetworkConfig>();
+      if (advanced_network::adv_net_init(adv_net_config) != advanced_network::Status::SUCCESS) {
+        throw std::runtime_error("Failed to configure the Advanced Network manager");
+      }
+      if (initiator) {
+        auto op = make_operator<ops::AdvPingPongInitiatorOp>("ping_pong",
+                                                            from_config("ping_pong_dpdk"),
+                                                            Arg("payload_size") = payload_size,
+                                                            Arg("burst_size") = burst_size,
+                                                            pacing);
+        op->set_session(session);
+        add_operator(op);
+      } else {
+        add_operator(make_operator<ops::AdvPingPongEchoOp>(
+            "ping_pong", from_config("ping_pong_dpdk"), Arg("payload_size") = payload_size));
+      }
+      return;
+#else
+      throw std::runtime_error("basic_networking_ping was built without advanced_network");
+#endif
+    }
+    if (backend != "socket" && backend != "uring") {
+      throw std::runtime_error(fmt::format("Invalid ping_pong backend {}", backend));
+    }
+
+    // The payload size is the datagram size of the sockets, so packets are sent and received one
+    // by one and the echo gets them back as they were sent
+    const auto max_payload_size = static_cast<uint16_t>(payload_size);
+    auto net_rx = make_operator<ops::BasicNetworkOpRx>(
+        "network_rx",
+        from_config("network_rx"),
+        Arg("io_engine") = backend,
+        Arg("max_payload_size") = max_payload_size,
+        make_condition<BooleanCondition>("is_alive"));
+    auto net_tx = make_operator<ops::BasicNetworkOpTx>("network_tx",
+                                                       from_config("network_tx"),
+                                                       Arg("io_engine") = backend,
+                                                       Arg("max_payload_size") = max_payload_size);
+
+    if (initiator) {
+      const uint64_t num_bursts = (session->count() + burst_size - 1) / std::max(burst_size, 1U);
+      auto tx = make_operator<ops::PingPongTxOp>("tx",
+                                                 Arg("payload_size") = payload_size,
+                                                 Arg("burst_size") = burst_size,
+                                                 make_condition<CountCondition>(num_bursts),
+                                                 pacing);
+      auto rx = make_operator<ops::PingPongRxOp>("rx", Arg("payload_size") = payload_size);
+      tx->set_session(session);
+      rx->set_session(session);
+      add_flow(tx, net_tx, {{"burst_out", "burst_in"}});
+      add_flow(net_rx, rx, {{"burst_out", "burst_in"}});
+    } else {
+      auto echo = make_operator<ops::PingPongEchoOp>("echo", Arg("payload_size") = payload_size);
+      add_flow(net_rx, echo, {{"burst_out", "burst_in"}});
+      add_flow(echo, net_tx, {{"burst_out", "burst_in"}});
+    }
+  }
 };
 
 int main(int argc, char** argv) {
@@ -121,7 +232,24 @@ int main(int argc, char** argv) {
   auto config_path = std::string(argv[1]);
   app->config(config_path);
 
+  // Ping-pong runs poll the sockets and the stats on their own threads so the RTT doesn't include
+  // the time other operators are scheduled
+  bool ping_pong_en = false;
+  for (const auto& yaml_node : app->config().yaml_nodes()) {
+    if (yaml_node["ping_pong"]) { ping_pong_en = true; }
+  }
+  if (ping_pong_en) {
+    app->scheduler(app->make_scheduler<holoscan::EventBasedScheduler>(
+        "event-based-scheduler", app->from_config("scheduler")));
+  }
+
   app->run();
 
+#if ANO_MGR_DPDK
+  if (ping_pong_en &&
+      app->from_config("ping_pong.backend").as<std::string>() == "dpdk") {
+    holoscan::advanced_network::shutdown();
+  }
+#endif
   return 0;
 }
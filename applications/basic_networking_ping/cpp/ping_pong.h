@@ -0,0 +1,333 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <time.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <vector>
+
+#include "basic_network_operator_common.h"
+#include "holoscan/holoscan.hpp"
+
+namespace holoscan::ops {
+
+/*
+  Round-trip latency benchmark. The initiator sends packets carrying a sequence number and the
+  time they were stamped at, the echo peer sends them back unchanged, and the initiator records
+  the round-trip time of each echoed packet in a histogram along with the lost, duplicated and
+  reordered packets. The times are only compared on the initiator, so the clocks of the two
+  hosts don't need to be synchronized.
+*/
+
+// Start of the payload of a ping-pong packet, the rest of the payload is padding
+struct PingPongHeader {
+  uint32_t magic;
+  uint32_t reserved;
+  uint64_t seq;
+  uint64_t tx_ns;
+} __attribute__((packed));
+
+static constexpr uint32_t kPingPongMagic = 0x504e4750;  // "PGNP"
+
+inline uint64_t ping_pong_now_ns() {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return static_cast<uint64_t>(ts.tv_sec) * 1000000000ULL + ts.tv_nsec;
+}
+
+/**
+ * @brief State of a benchmark run shared by the sending and the receiving operators of the
+ * initiator, whichever the network backend
+ */
+class PingPongSession {
+ public:
+  PingPongSession(uint64_t count, uint64_t bucket_ns, uint32_t num_buckets,
+                  uint64_t timeout_ns)
+      : count_(count),
+        bucket_ns_(std::max<uint64_t>(bucket_ns, 1)),
+        timeout_ns_(timeout_ns),
+        buckets_(num_buckets + 1, 0),
+        seen_(count, false) {}
+
+  uint64_t count() const { return count_; }
+
+  /// @brief Stamps the header of the next packet to send, returns false once all are sent
+  bool stamp(uint8_t* payload) {
+    if (sent_ >= count_) { return false; }
+    PingPongHeader header{kPingPongMagic, 0, sent_, ping_pong_now_ns()};
+    memcpy(payload, &header, sizeof(header));
+    if (++sent_ == count_) { last_sent_ns_ = header.tx_ns; }
+    return true;
+  }
+
+  /// @brief Records an echoed payload of `len` bytes
+  void record(const uint8_t* payload, uint32_t len) {
+    const uint64_t now = ping_pong_now_ns();
+    PingPongHeader header;
+    if (len < sizeof(header)) {
+      invalid_++;
+      return;
+    }
+    memcpy(&header, payload, sizeof(header));
+    if (header.magic != kPingPongMagic || header.seq >= count_ || header.tx_ns > now) {
+      invalid_++;
+      return;
+    }
+    if (seen_[header.seq]) {
+      duplicates_++;
+      return;
+    }
+    seen_[header.seq] = true;
+    if (received_ > 0 && header.seq < max_seq_) { reordered_++; }
+    max_seq_ = std::max(max_seq_, header.seq);
+    received_++;
+    last_received_ns_ = now;
+
+    const uint64_t rtt = now - header.tx_ns;
+    min_ns_ = std::min(min_ns_, rtt);
+    max_ns_ = std::max(max_ns_, rtt);
+    sum_ns_ += rtt;
+    buckets_[std::min<uint64_t>(rtt / bucket_ns_, buckets_.size() - 1)]++;
+  }
+
+  /// @brief All the packets were echoed, or no echo came for the timeout after the last send
+  bool done() const {
+    if (received_ == count_) { return true; }
+    if (sent_.load() < count_) { return false; }
+    const uint64_t last = std::max(last_sent_ns_.load(), last_received_ns_);
+    return ping_pong_now_ns() - last > timeout_ns_;
+  }
+
+  void report() const {
+    const uint64_t sent = sent_.load();
+    const uint64_t lost = sent - received_;
+    HOLOSCAN_LOG_INFO("Ping-pong: {} sent, {} received, {} lost ({:.3f}%), {} duplicated, "
+                      "{} reordered, {} invalid",
+                      sent,
+                      received_,
+                      lost,
+                      sent ? 100.0 * lost / sent : 0.0,
+                      duplicates_,
+                      reordered_,
+                      invalid_);
+    if (received_ == 0) { return; }
+    HOLOSCAN_LOG_INFO("RTT min {:.3f} us, avg {:.3f} us, max {:.3f} us",
+                      min_ns_ / 1e3,
+                      sum_ns_ / 1e3 / received_,
+                      max_ns_ / 1e3);
+    HOLOSCAN_LOG_INFO("RTT p50 {:.3f} us, p90 {:.3f} us, p99 {:.3f} us, p99.9 {:.3f} us",
+                      percentile_ns(0.5) / 1e3,
+                      percentile_ns(0.9) / 1e3,
+                      percentile_ns(0.99) / 1e3,
+                      percentile_ns(0.999) / 1e3);
+    HOLOSCAN_LOG_INFO("RTT histogram ({} ns buckets):", bucket_ns_);
+    for (size_t b = 0; b < buckets_.size(); b++) {
+      if (buckets_[b] == 0) { continue; }
+      if (b == buckets_.size() - 1) {
+        HOLOSCAN_LOG_INFO("  >= {:>10.3f} us: {}", b * bucket_ns_ / 1e3, buckets_[b]);
+      } else {
+        HOLOSCAN_LOG_INFO("  {:>10.3f} us: {}", b * bucket_ns_ / 1e3, buckets_[b]);
+      }
+    }
+  }
+
+ private:
+  // Upper bound of the bucket of the percentile, the maximum for the overflow bucket
+  uint64_t percentile_ns(double p) const {
+    const uint64_t rank = std::max<uint64_t>(1, static_cast<uint64_t>(p * received_ + 0.5));
+    uint64_t total = 0;
+    for (size_t b = 0; b + 1 < buckets_.size(); b++) {
+      total += buckets_[b];
+      if (total >= rank) { return std::min(max_ns_, (b + 1) * bucket_ns_); }
+    }
+    return max_ns_;
+  }
+
+  const uint64_t count_;
+  const uint64_t bucket_ns_;
+  const uint64_t timeout_ns_;
+
+  // Written by the sending operator
+  std::atomic<uint64_t> sent_ = 0;
+  std::atomic<uint64_t> last_sent_ns_ = 0;
+
+  // Written by the receiving operator
+  std::vector<uint64_t> buckets_;
+  std::vector<bool> seen_;
+  uint64_t received_ = 0;
+  uint64_t duplicates_ = 0;
+  uint64_t reordered_ = 0;
+  uint64_t invalid_ = 0;
+  uint64_t max_seq_ = 0;
+  uint64_t last_received_ns_ = 0;
+  uint64_t min_ns_ = std::numeric_limits<uint64_t>::max();
+  uint64_t max_ns_ = 0;
+  uint64_t sum_ns_ = 0;
+};
+
+/**
+ * @brief Calls `fn(payload, len)` on every packet of a burst from BasicNetworkOpRx
+ *
+ * Without a stride, packets are packed back to back and all of `payload_size` bytes.
+ */
+template <typename F>
+void for_each_packet(const NetworkOpBurstParams& burst, uint32_t payload_size, F&& fn) {
+  for (uint32_t p = 0; p < burst.num_pkts; p++) {
+    if (burst.stride > 0) {
+      fn(burst.data + static_cast<size_t>(p) * burst.stride, burst.pkt_lens[p]);
+    } else {
+      const size_t offset = static_cast<size_t>(p) * payload_size;
+      if (offset >= burst.len) { break; }
+      fn(burst.data + offset, std::min<uint32_t>(payload_size, burst.len - offset));
+    }
+  }
+}
+
+/**
+ * @brief Sends bursts of stamped ping-pong packets to BasicNetworkOpTx
+ */
+class PingPongTxOp : public Operator {
+ public:
+  HOLOSCAN_OPERATOR_FORWARD_ARGS(PingPongTxOp)
+
+  PingPongTxOp() = default;
+
+  void set_session(std::shared_ptr<PingPongSession> session) { session_ = session; }
+
+  void setup(OperatorSpec& spec) override {
+    spec.output<std::shared_ptr<NetworkOpBurstParams>>("burst_out");
+    spec.param<uint32_t>(payload_size_,
+                         "payload_size",
+                         "Payload size",
+                         "UDP payload size of each packet, at least the ping-pong header",
+                         64);
+    spec.param<uint32_t>(
+        burst_size_, "burst_size", "Burst size", "Packets sent on each tick", 1);
+  }
+
+  void compute(InputContext&, OutputContext& op_output, ExecutionContext&) override {
+    const uint32_t payload_size = std::max<uint32_t>(payload_size_.get(), sizeof(PingPongHeader));
+    auto mem = new uint8_t[static_cast<size_t>(payload_size) * burst_size_.get()]();
+    uint32_t pkts = 0;
+    while (pkts < burst_size_.get() && session_->stamp(mem + pkts * payload_size)) { pkts++; }
+    if (pkts == 0) {
+      delete[] mem;
+      return;
+    }
+    op_output.emit(std::make_shared<NetworkOpBurstParams>(mem, pkts * payload_size, pkts),
+                   "burst_out");
+  }
+
+ private:
+  Parameter<uint32_t> payload_size_;
+  Parameter<uint32_t> burst_size_;
+  std::shared_ptr<PingPongSession> session_;
+};
+
+/**
+ * @brief Records the echoed packets from BasicNetworkOpRx and reports once the run is done
+ */
+class PingPongRxOp : public Operator {
+ public:
+  HOLOSCAN_OPERATOR_FORWARD_ARGS(PingPongRxOp)
+
+  PingPongRxOp() = default;
+
+  void set_session(std::shared_ptr<PingPongSession> session) { session_ = session; }
+
+  void setup(OperatorSpec& spec) override {
+    // Ticks without a message too, to notice the end of the run
+    spec.input<std::shared_ptr<NetworkOpBurstParams>>("burst_in")
+        .condition(ConditionType::kNone);
+    spec.param<uint32_t>(payload_size_,
+                         "payload_size",
+                         "Payload size",
+                         "UDP payload size of each packet, at least the ping-pong header",
+                         64);
+  }
+
+  void compute(InputContext& op_input, OutputContext&, ExecutionContext& context) override {
+    auto in = op_input.receive<std::shared_ptr<NetworkOpBurstParams>>("burst_in");
+    if (in && in.value()) {
+      auto& burst = *in.value();
+      for_each_packet(burst, payload_size_.get(), [this](const uint8_t* payload, uint32_t len) {
+        session_->record(payload, len);
+      });
+      if (!burst.pooled) { delete[] burst.data; }
+    }
+
+    if (!reported_ && session_->done()) {
+      session_->report();
+      reported_ = true;
+      GxfGraphInterrupt(context.context());
+    }
+  }
+
+ private:
+  Parameter<uint32_t> payload_size_;
+  std::shared_ptr<PingPongSession> session_;
+  bool reported_ = false;
+};
+
+/**
+ * @brief Sends the packets received by BasicNetworkOpRx back through BasicNetworkOpTx
+ */
+class PingPongEchoOp : public Operator {
+ public:
+  HOLOSCAN_OPERATOR_FORWARD_ARGS(PingPongEchoOp)
+
+  PingPongEchoOp() = default;
+
+  void setup(OperatorSpec& spec) override {
+    spec.input<std::shared_ptr<NetworkOpBurstParams>>("burst_in");
+    spec.output<std::shared_ptr<NetworkOpBurstParams>>("burst_out");
+    spec.param<uint32_t>(payload_size_,
+                         "payload_size",
+                         "Payload size",
+                         "UDP payload size of each packet, at least the ping-pong header",
+                         64);
+  }
+
+  void compute(InputContext& op_input, OutputContext& op_output, ExecutionContext&) override {
+    auto in = op_input.receive<std::shared_ptr<NetworkOpBurstParams>>("burst_in").value();
+    if (!in->pooled && in->stride == 0) {
+      // The burst is handed over as is, BasicNetworkOpTx frees its data
+      op_output.emit(in, "burst_out");
+      return;
+    }
+
+    // Pooled bursts go back to the RX pool when released, so the packets are packed in a copy
+    auto mem = new uint8_t[in->len];
+    uint32_t len = 0;
+    for_each_packet(*in, payload_size_.get(), [&](const uint8_t* payload, uint32_t pkt_len) {
+      memcpy(mem + len, payload, pkt_len);
+      len += pkt_len;
+    });
+    op_output.emit(std::make_shared<NetworkOpBurstParams>(mem, len, in->num_pkts), "burst_out");
+  }
+
+ private:
+  Parameter<uint32_t> payload_size_;
+};
+
+}  // namespace holoscan::ops
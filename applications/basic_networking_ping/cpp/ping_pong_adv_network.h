@@ -0,0 +1,237 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <arpa/inet.h>
+
+#include <string>
+#include <vector>
+
+#include "advanced_network/common.h"
+#include "holoscan/holoscan.hpp"
+#include "ping_pong.h"
+
+namespace holoscan::ops {
+
+/*
+  Ping-pong operators for the advanced_network DPDK manager. They build and parse the Ethernet,
+  IPv4 and UDP headers themselves, so the interfaces' memory regions must be in host memory and
+  hold the whole packet in one segment.
+*/
+
+/**
+ * @brief Addressing and burst helpers shared by the ping-pong operators of advanced_network
+ */
+class AdvPingPongBase : public Operator {
+ public:
+  HOLOSCAN_OPERATOR_FORWARD_ARGS(AdvPingPongBase)
+
+  AdvPingPongBase() = default;
+
+  void setup(OperatorSpec& spec) override {
+    spec.param<std::string>(interface_name_,
+                            "interface_name",
+                            "Interface name",
+                            "Name of the advanced_network interface to send and receive on");
+    spec.param<uint16_t>(queue_id_, "queue_id", "TX queue", "TX queue of the interface", 0);
+    spec.param<uint32_t>(payload_size_,
+                         "payload_size",
+                         "Payload size",
+                         "UDP payload size of each packet, at least the ping-pong header",
+                         64);
+    spec.param<std::string>(eth_dst_addr_,
+                            "eth_dst_addr",
+                            "Ethernet destination",
+                            "MAC address of the peer");
+    spec.param<std::string>(ip_src_addr_, "ip_src_addr", "IP source", "IP address of this host");
+    spec.param<std::string>(ip_dst_addr_, "ip_dst_addr", "IP destination", "IP of the peer");
+    spec.param<uint16_t>(udp_src_port_, "udp_src_port", "UDP source port", "UDP source port");
+    spec.param<uint16_t>(udp_dst_port_, "udp_dst_port", "UDP destination port", "Peer UDP port");
+  }
+
+  void initialize() override {
+    Operator::initialize();
+
+    port_id_ = advanced_network::get_port_id(interface_name_.get());
+    if (port_id_ == -1) {
+      HOLOSCAN_LOG_ERROR("Invalid port {} specified in the config", interface_name_.get());
+      throw std::runtime_error("Invalid advanced_network interface");
+    }
+
+    advanced_network::format_eth_addr(eth_dst_, eth_dst_addr_.get());
+    inet_pton(AF_INET, ip_src_addr_.get().c_str(), &ip_src_);
+    inet_pton(AF_INET, ip_dst_addr_.get().c_str(), &ip_dst_);
+
+    // advanced_network expects host order when setting
+    ip_src_ = ntohl(ip_src_);
+    ip_dst_ = ntohl(ip_dst_);
+    payload_size_bytes_ = std::max<uint32_t>(payload_size_.get(), sizeof(PingPongHeader));
+  }
+
+ protected:
+  /**
+   * @brief Sends up to `max_pkts` packets filled by `fill(payload)`, which returns false once
+   * there is nothing more to send
+   *
+   * @return Number of packets sent, 0 when no TX buffers were free
+   */
+  template <typename F>
+  uint32_t send(uint32_t max_pkts, F&& fill) {
+    using namespace holoscan::advanced_network;
+
+    if (max_pkts == 0) { return 0; }
+    payload_.resize(static_cast<size_t>(payload_size_bytes_) * max_pkts);
+    uint32_t num_pkts = 0;
+    while (num_pkts < max_pkts && fill(payload_.data() + num_pkts * payload_size_bytes_)) {
+      num_pkts++;
+    }
+    if (num_pkts == 0) { return 0; }
+
+    auto msg = create_tx_burst_params();
+    set_header(msg, port_id_, queue_id_.get(), num_pkts, 1);
+    if (!is_tx_burst_available(msg) || get_tx_packet_burst(msg) != Status::SUCCESS) {
+      // Filled payloads are dropped and count as lost, like a full socket buffer would do
+      HOLOSCAN_LOG_ERROR("No TX burst available on port {}, dropping {} packets",
+                         port_id_,
+                         num_pkts);
+      free_tx_metadata(msg);
+      return 0;
+    }
+
+    const int udp_len = payload_size_bytes_ + sizeof(udphdr);
+    const int pkt_len = payload_size_bytes_ + sizeof(UDPIPV4Pkt);
+    for (uint32_t p = 0; p < num_pkts; p++) {
+      if (set_eth_header(msg, p, eth_dst_) != Status::SUCCESS ||
+          set_ipv4_header(msg, p, udp_len, IPPROTO_UDP, ip_src_, ip_dst_) != Status::SUCCESS ||
+          set_udp_header(msg, p, payload_size_bytes_, udp_src_port_.get(), udp_dst_port_.get()) !=
+              Status::SUCCESS ||
+          set_udp_payload(msg, p, payload_.data() + p * payload_size_bytes_, payload_size_bytes_) !=
+              Status::SUCCESS ||
+          set_packet_lengths(msg, p, {pkt_len}) != Status::SUCCESS) {
+        HOLOSCAN_LOG_ERROR("Failed to build ping-pong packet {}", p);
+        free_all_packets_and_burst_tx(msg);
+        return 0;
+      }
+    }
+    send_tx_burst(msg);
+    return num_pkts;
+  }
+
+  /// @brief Calls `fn(payload, len)` on every UDP payload received on the interface
+  template <typename F>
+  void receive(F&& fn) {
+    using namespace holoscan::advanced_network;
+
+    for (int q = 0; q < get_num_rx_queues(port_id_); q++) {
+      BurstParams* burst;
+      if (get_rx_burst(&burst, port_id_, q) != Status::SUCCESS) { continue; }
+      for (int p = 0; p < get_num_packets(burst); p++) {
+        auto pkt = static_cast<UDPIPV4Pkt*>(get_segment_packet_ptr(burst, 0, p));
+        const uint32_t len = ntohs(pkt->udp.len) - sizeof(udphdr);
+        fn(reinterpret_cast<const uint8_t*>(pkt + 1), len);
+      }
+      free_all_packets_and_burst_rx(burst);
+    }
+  }
+
+  Parameter<std::string> interface_name_;
+  Parameter<uint16_t> queue_id_;
+  Parameter<uint32_t> payload_size_;
+  Parameter<std::string> eth_dst_addr_;
+  Parameter<std::string> ip_src_addr_;
+  Parameter<std::string> ip_dst_addr_;
+  Parameter<uint16_t> udp_src_port_;
+  Parameter<uint16_t> udp_dst_port_;
+
+  int port_id_ = -1;
+  char eth_dst_[6];
+  uint32_t ip_src_;
+  uint32_t ip_dst_;
+  uint32_t payload_size_bytes_ = sizeof(PingPongHeader);
+  std::vector<uint8_t> payload_;
+};
+
+/**
+ * @brief Initiator of a ping-pong run over advanced_network, sends the stamped packets and
+ * records the echoed ones
+ *
+ * Sending and receiving share one operator so the receive side is polled between sends without
+ * a second thread spinning on the same interface.
+ */
+class AdvPingPongInitiatorOp : public AdvPingPongBase {
+ public:
+  HOLOSCAN_OPERATOR_FORWARD_ARGS_SUPER(AdvPingPongInitiatorOp, AdvPingPongBase)
+
+  AdvPingPongInitiatorOp() = default;
+
+  void set_session(std::shared_ptr<PingPongSession> session) { session_ = session; }
+
+  void setup(OperatorSpec& spec) override {
+    AdvPingPongBase::setup(spec);
+    spec.param<uint32_t>(
+        burst_size_, "burst_size", "Burst size", "Packets sent on each tick", 1);
+  }
+
+  void compute(InputContext&, OutputContext&, ExecutionContext& context) override {
+    send(burst_size_.get(), [this](uint8_t* payload) { return session_->stamp(payload); });
+    receive([this](const uint8_t* payload, uint32_t len) { session_->record(payload, len); });
+
+    if (!reported_ && session_->done()) {
+      session_->report();
+      reported_ = true;
+      GxfGraphInterrupt(context.context());
+    }
+  }
+
+ private:
+  Parameter<uint32_t> burst_size_;
+  std::shared_ptr<PingPongSession> session_;
+  bool reported_ = false;
+};
+
+/**
+ * @brief Echo peer of a ping-pong run over advanced_network, sends every received payload back
+ */
+class AdvPingPongEchoOp : public AdvPingPongBase {
+ public:
+  HOLOSCAN_OPERATOR_FORWARD_ARGS_SUPER(AdvPingPongEchoOp, AdvPingPongBase)
+
+  AdvPingPongEchoOp() = default;
+
+  void compute(InputContext&, OutputContext&, ExecutionContext&) override {
+    received_.clear();
+    receive([this](const uint8_t* payload, uint32_t len) {
+      // Short packets are padded, so every echo has the configured size
+      const size_t offset = received_.size();
+      received_.resize(offset + payload_size_bytes_, 0);
+      memcpy(received_.data() + offset, payload, std::min(len, payload_size_bytes_));
+    });
+
+    const uint32_t num_pkts = received_.size() / payload_size_bytes_;
+    uint32_t next = 0;
+    send(num_pkts, [&](uint8_t* payload) {
+      memcpy(payload, received_.data() + next++ * payload_size_bytes_, payload_size_bytes_);
+      return true;
+    });
+  }
+
+ private:
+  std::vector<uint8_t> received_;
+};
+
+}  // namespace holoscan::ops
@@ -74,8 +74,12 @@ class ImageProcessingOp : public holoscan::Operator {
 
     HOLOSCAN_LOG_DEBUG("cv_out_buffer created");
 
-    // output tensor is now properly formatted and allocated
-    nvcv::Tensor cv_out_tensor = nvcv::TensorWrapData(out_data);
+    // output tensor is now properly formatted and allocated, and frees its memory once the last
+    // reference to it is gone
+    nvcv::Tensor cv_out_tensor =
+        nvcv::TensorWrapData(out_data, [](const nvcv::TensorData& data) {
+          cudaFree(data.cast<nvcv::TensorDataStridedCuda>()->basePtr());
+        });
 
     // apply the Flip operator
     cvcuda::Flip flipOp;
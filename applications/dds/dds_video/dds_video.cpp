@@ -25,109 +25,13 @@
 
 #include <getopt.h>
 
-namespace holoscan::ops {
-
-/**
- * @brief Operator to consume the shapes output from a DDSShapesSubscriber and
- * render them to Holoviz.
- */
-class DDSShapesRenderer : public Operator {
- public:
-  HOLOSCAN_OPERATOR_FORWARD_ARGS(DDSShapesRenderer)
-
-  DDSShapesRenderer() = default;
-
-  void setup(OperatorSpec& spec) override {
-    // Inputs from DDSShapesSubscriber
-    spec.input<std::vector<holoscan::ops::DDSShapesSubscriberOp::Shape>>("input");
-
-    // Outputs to Holoviz
-    spec.output<gxf::Entity>("outputs");
-    spec.output<std::vector<HolovizOp::InputSpec>>("output_specs");
-
-    spec.param(allocator_, "allocator", "Allocator", "Allocator for output buffers.");
-  }
-
-  void initialize() override {
-    Operator::initialize();
-  }
-
-  /**
-   * @brief Helper function to add a tensor with data to an entity.
-   */
-  template <std::size_t N, std::size_t C>
-  void add_data(gxf::Entity& entity, const char* name,
-                const std::array<std::array<float, C>, N>& data, ExecutionContext& context) {
-    // Get Handle to underlying nvidia::gxf::Allocator from std::shared_ptr<holoscan::Allocator>
-    auto allocator = nvidia::gxf::Handle<nvidia::gxf::Allocator>::Create(context.context(),
-                                                                         allocator_->gxf_cid());
-    // Add a tensor
-    auto tensor = static_cast<nvidia::gxf::Entity&>(entity).add<nvidia::gxf::Tensor>(name).value();
-    // Reshape the tensor to the size of the data
-    tensor->reshape<float>(
-        nvidia::gxf::Shape({N, C}), nvidia::gxf::MemoryStorageType::kHost, allocator.value());
-    // Copy the data to the tensor
-    std::memcpy(tensor->pointer(), data.data(), N * C * sizeof(float));
-  }
-
-  void compute(InputContext& op_input, OutputContext& op_output,
-               ExecutionContext& context) override {
-    auto entity = gxf::Entity::New(&context);
-    auto specs = std::vector<HolovizOp::InputSpec>();
-
-    // Get the input shapes from the DDSShapesSubscriber.
-    auto shapes = op_input.receive<std::vector<
-        holoscan::ops::DDSShapesSubscriberOp::Shape>>("input").value();
-
-    // Generate the output Holoviz specs and primitives.
-    int32_t shape_id = 0;
-    for (const auto& shape : shapes) {
-      const auto shape_name = std::to_string(shape_id);
-      auto& spec = specs.emplace_back();
-      spec.tensor_name_ = shape_name;
-      spec.color_ = shape.color_;
-      spec.priority_ = shape_id++;
-      spec.line_width_ = shape_line_width_;
-      if (shape.type_ == DDSShapesSubscriberOp::Shape::Type::SQUARE) {
-        spec.type_ = HolovizOp::InputType::RECTANGLES;
-        add_data<2, 2>(entity, shape_name.c_str(),
-            {{{shape.x_ - shape.width_ / 2, shape.y_ - shape.height_ / 2},
-              {shape.x_ + shape.width_ / 2, shape.y_ + shape.height_ / 2}}}, context);
-      } else if (shape.type_ == DDSShapesSubscriberOp::Shape::Type::CIRCLE) {
-        spec.type_ = HolovizOp::InputType::OVALS;
-        add_data<1, 4>(entity, shape_name.c_str(),
-            {{{shape.x_, shape.y_, shape.width_, shape.height_}}}, context);
-      } else if (shape.type_ == DDSShapesSubscriberOp::Shape::Type::TRIANGLE) {
-        spec.type_ = HolovizOp::InputType::LINE_STRIP;
-        add_data<4, 2>(entity, shape_name.c_str(),
-            {{{shape.x_ - shape.width_ / 2, shape.y_ + shape.height_ / 2},
-              {shape.x_ + shape.width_ / 2, shape.y_ + shape.height_ / 2},
-              {shape.x_,                    shape.y_ - shape.height_ / 2},
-              {shape.x_ - shape.width_ / 2, shape.y_ + shape.height_ / 2}}}, context);
-      }
-    }
-
-    // Output to Holoviz.
-    op_output.emit(entity, "outputs");
-    op_output.emit(specs, "output_specs");
-  }
-
- private:
-  Parameter<std::shared_ptr<Allocator>> allocator_;
-
-  const float shape_line_width_ = 5.0f;
-};
-
-}  // namespace holoscan::ops
-
-
 /**
  * @brief Application to publish a V4L2 video stream to DDS.
  */
 class V4L2ToDDS : public holoscan::Application {
  public:
-  explicit V4L2ToDDS(uint32_t domain_id, uint32_t stream_id)
-      : domain_id_(domain_id), stream_id_(stream_id) {}
+  explicit V4L2ToDDS(uint32_t domain_id, uint32_t stream_id, bool zero_copy)
+      : domain_id_(domain_id), stream_id_(stream_id), zero_copy_(zero_copy) {}
 
   void compose() override {
     using namespace holoscan;
@@ -140,7 +44,8 @@ class V4L2ToDDS : public holoscan::Application {
         Arg("participant_qos", std::string("HoloscanDDSTransport::SHMEM+LAN")),
         Arg("writer_qos", std::string("HoloscanDDSDataFlow::Video")),
         Arg("domain_id", domain_id_),
-        Arg("stream_id", stream_id_));
+        Arg("stream_id", stream_id_),
+        Arg("zero_copy", zero_copy_));
 
     add_flow(v4l2, dds, {{"signal", "input"}});
   }
@@ -148,6 +53,7 @@ class V4L2ToDDS : public holoscan::Application {
  private:
   uint32_t domain_id_;
   uint32_t stream_id_;
+  bool zero_copy_;
 };
 
 /**
@@ -156,32 +62,31 @@ class V4L2ToDDS : public holoscan::Application {
  */
 class DDSToHoloviz : public holoscan::Application {
  public:
-  explicit DDSToHoloviz(uint32_t domain_id, uint32_t stream_id)
-      : domain_id_(domain_id), stream_id_(stream_id) {}
+  explicit DDSToHoloviz(uint32_t domain_id, uint32_t stream_id, bool zero_copy)
+      : domain_id_(domain_id), stream_id_(stream_id), zero_copy_(zero_copy) {}
 
   void compose() override {
     using namespace holoscan;
 
-    std::shared_ptr<UnboundedAllocator> allocator = make_resource<UnboundedAllocator>("pool");
-
-    //  DDS Video Subscriber
+    //  DDS Video Subscriber, uploading frames of the 640x480 publisher to a pool of device
+    //  buffers
     auto participant_qos = std::string("HoloscanDDSTransport::SHMEM+LAN");
     auto video_subscriber = make_operator<ops::DDSVideoSubscriberOp>("video_subscriber",
-        Arg("allocator", allocator),
+        Arg("allocator", make_resource<BlockMemoryPool>("video_pool", 1, 640 * 480 * 4, 4)),
         Arg("domain_id", domain_id_),
         Arg("stream_id", stream_id_),
         Arg("participant_qos", participant_qos),
-        Arg("reader_qos", std::string("HoloscanDDSDataFlow::Video")));
+        Arg("reader_qos", std::string("HoloscanDDSDataFlow::Video")),
+        Arg("zero_copy", zero_copy_));
 
-    // DDS Shapes Subscriber
+    // DDS Shapes Subscriber, outputting the shapes as Holoviz primitives. It reads the shapes
+    // on every tick instead of waiting for them, so that the video is rendered without shapes
+    // being published.
     auto shapes_subscriber = make_operator<ops::DDSShapesSubscriberOp>("shapes_subscriber",
         Arg("domain_id", domain_id_),
         Arg("participant_qos", participant_qos),
-        Arg("reader_qos", std::string("HoloscanDDSDataFlow::Shapes")));
-
-    // DDS Shapes Renderer
-    auto shapes_renderer = make_operator<ops::DDSShapesRenderer>("shapes_renderer",
-        Arg("allocator", allocator));
+        Arg("reader_qos", std::string("HoloscanDDSDataFlow::Shapes")),
+        Arg("wait_for_data", false));
 
     // Holoviz (initialize with the default input spec for the video stream)
     std::vector<ops::HolovizOp::InputSpec> input_spec;
@@ -191,13 +96,14 @@ class DDSToHoloviz : public holoscan::Application {
         Arg("width", 640u), Arg("height", 480u), Arg("tensors", input_spec));
 
     add_flow(video_subscriber, holoviz, {{"output", "receivers"}});
-    add_flow(shapes_subscriber, shapes_renderer, {{"output", "input"}});
-    add_flow(shapes_renderer, holoviz, {{"outputs", "receivers"}, {"output_specs", "input_specs"}});
+    add_flow(shapes_subscriber, holoviz,
+             {{"outputs", "receivers"}, {"output_specs", "input_specs"}});
   }
 
  private:
   uint32_t domain_id_;
   uint32_t stream_id_;
+  bool zero_copy_;
 };
 
 void usage() {
@@ -206,7 +112,9 @@ void usage() {
             << "  -p,    --publisher    Run as a publisher" << std::endl
             << "  -s,    --subscriber   Run as a subscriber" << std::endl
             << "  -d ID, --domain=ID    Use the specified DDS domain ID" << std::endl
-            << "  -i ID, --id=ID        Use the specified video stream ID" << std::endl;
+            << "  -i ID, --id=ID        Use the specified video stream ID" << std::endl
+            << "  -z,    --zero-copy    Transfer the video with zero copy over shared memory,"
+            << " between processes on the same host" << std::endl;
 }
 
 int main(int argc, char** argv) {
@@ -214,6 +122,7 @@ int main(int argc, char** argv) {
   bool subscriber = false;
   uint32_t stream_id = 0;
   uint32_t domain_id = 0;
+  bool zero_copy = false;
 
   struct option long_options[] = {
       {"help", no_argument, 0, 'h'},
@@ -221,12 +130,13 @@ int main(int argc, char** argv) {
       {"subscriber", no_argument, 0, 's'},
       {"id", required_argument, 0, 'i'},
       {"domain", required_argument, 0, 'd'},
+      {"zero-copy", no_argument, 0, 'z'},
       {0, 0, 0, 0}};
 
   while (true) {
     int option_index = 0;
 
-    const int c = getopt_long(argc, argv, "hpsi:d:", long_options, &option_index);
+    const int c = getopt_long(argc, argv, "hpsi:d:z", long_options, &option_index);
     if (c == -1) { break; }
 
     const std::string argument(optarg ? optarg : "");
@@ -246,6 +156,9 @@ int main(int argc, char** argv) {
       case 'd':
         domain_id = stoi(argument);
         break;
+      case 'z':
+        zero_copy = true;
+        break;
       default:
         HOLOSCAN_LOG_ERROR("Unhandled option '{}'", static_cast<char>(c));
     }
@@ -261,10 +174,10 @@ int main(int argc, char** argv) {
       publisher ? "publisher" : "subscriber", stream_id, domain_id);
 
   if (publisher) {
-    auto app = holoscan::make_application<V4L2ToDDS>(domain_id, stream_id);
+    auto app = holoscan::make_application<V4L2ToDDS>(domain_id, stream_id, zero_copy);
     app->run();
   } else if (subscriber) {
-    auto app = holoscan::make_application<DDSToHoloviz>(domain_id, stream_id);
+    auto app = holoscan::make_application<DDSToHoloviz>(domain_id, stream_id, zero_copy);
     app->run();
   }
 
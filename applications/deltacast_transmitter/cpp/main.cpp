@@ -17,7 +17,6 @@
 
 #include <holoscan/holoscan.hpp>
 #include <holoscan/operators/video_stream_replayer/video_stream_replayer.hpp>
-#include <holoscan/operators/format_converter/format_converter.hpp>
 #include <videomaster_transmitter.hpp>
 
 #include <getopt.h>
@@ -33,27 +32,16 @@ class App : public holoscan::Application {
   void compose() override {
     using namespace holoscan;
 
-    uint32_t width = from_config("deltacast.width").as<uint32_t>();
-    uint32_t height = from_config("deltacast.height").as<uint32_t>();
-    uint64_t source_block_size = width * height * 4 * 4;
-    uint64_t source_num_blocks = from_config("deltacast.rdma").as<bool>() ? 3 : 4;
-
     auto source = make_operator<ops::VideoStreamReplayerOp>("replayer", from_config("replayer"),
                                                             Arg("directory", datapath));
 
-    auto format_converter =
-        make_operator<ops::FormatConverterOp>("format_converter",
-                                              from_config("output_format_converter"),
-                                              Arg("pool") = make_resource<BlockMemoryPool>(
-                                                  "pool", 1, source_block_size, source_num_blocks));
-
+    // The transmitter resizes the RGB frames and packs them for the board on the GPU
     auto visualizer = make_operator<ops::VideoMasterTransmitterOp>(
         "deltacast",
         from_config("deltacast"),
         Arg("pool") = make_resource<UnboundedAllocator>("pool"));
 
-    add_flow(source, format_converter);
-    add_flow(format_converter, visualizer);
+    add_flow(source, visualizer);
   }
 
  private:
@@ -17,8 +17,8 @@ import os
 from argparse import ArgumentParser
 
 from holoscan.core import Application
-from holoscan.operators import FormatConverterOp, VideoStreamReplayerOp
-from holoscan.resources import BlockMemoryPool, MemoryStorageType, UnboundedAllocator
+from holoscan.operators import VideoStreamReplayerOp
+from holoscan.resources import UnboundedAllocator
 
 from holohub.videomaster import VideoMasterTransmitterOp
 
@@ -43,28 +43,12 @@ class DeltacastTransmitterApp(Application):
         width = videomaster_kwargs.get("width", 1920)
         height = videomaster_kwargs.get("height", 1080)
 
-        # Calculate source block size and count and define the source pool parameters
-        source_block_size = width * height * 4 * 4
-        source_block_count = 3 if videomaster_kwargs.get("rdma") else 4
-
-        source_pool_kwargs = dict(
-            storage_type=MemoryStorageType.DEVICE,
-            block_size=source_block_size,
-            num_blocks=source_block_count,
-        )
-
         # Initialize operators
         source = VideoStreamReplayerOp(
             self, name="replayer", directory=self.data_path, **self.kwargs("replayer")
         )
 
-        format_converter = FormatConverterOp(
-            self,
-            name="format_converter",
-            pool=BlockMemoryPool(self, name="pool", **source_pool_kwargs),
-            **self.kwargs("output_format_converter"),
-        )
-
+        # The transmitter resizes the RGB frames and packs them for the board on the GPU
         visualizer = VideoMasterTransmitterOp(
             self,
             name="videomaster",
@@ -80,8 +64,7 @@ class DeltacastTransmitterApp(Application):
         )
 
         # Define the data flow between operators
-        self.add_flow(source, format_converter)
-        self.add_flow(format_converter, visualizer)
+        self.add_flow(source, visualizer)
 
 
 def parse_config():
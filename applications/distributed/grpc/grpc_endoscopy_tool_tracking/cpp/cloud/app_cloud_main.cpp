@@ -72,7 +72,7 @@ void signal_handler(int signum) {
 
 /** Helper function to parse benchmarking setting from the configuration file */
 void parse_config(const std::string& config_path, bool& benchmarking,
-                  bool& enable_health_check_service) {
+                  bool& enable_health_check_service, uint32_t& grpc_sessions) {
   auto config = holoscan::Config(config_path);
   auto& yaml_nodes = config.yaml_nodes();
   for (const auto& yaml_node : yaml_nodes) {
@@ -81,6 +81,9 @@ void parse_config(const std::string& config_path, bool& benchmarking,
       if (application.IsMap()) {
         benchmarking = application["benchmarking"].as<bool>();
         enable_health_check_service = application["grpc_health_check"].as<bool>();
+        if (application["grpc_sessions"]) {
+          grpc_sessions = application["grpc_sessions"].as<uint32_t>();
+        }
       } else {
         HOLOSCAN_LOG_ERROR("Error parsing configuration file, 'application' is not a map");
       }
@@ -150,12 +153,13 @@ int main(int argc, char** argv) {
 
   bool benchmarking = false;
   bool enable_health_check_service = false;
-  parse_config(config_path, benchmarking, enable_health_check_service);
+  uint32_t grpc_sessions = 0;
+  parse_config(config_path, benchmarking, enable_health_check_service, grpc_sessions);
 
   // Register each gRPC service with a Holoscan application:
   // - the callback function (create_application_instance_func) is used to create a new instance
-  // of
-  //   the application when a new RPC call is received.
+  //   of the application when a new RPC call is received, or, with `grpc_sessions` set, to
+  //   create the pool of pre-warmed instances serving up to that many concurrent RPCs.
   ApplicationFactory::get_instance()->register_application(
       "EntityStream",
       [config_path, data_directory, benchmarking](
@@ -172,7 +176,8 @@ int main(int argc, char** argv) {
         }
         application_instance.future = application_instance.instance->run_async();
         return application_instance;
-      });
+      },
+      grpc_sessions);
 
   struct sigaction sa;
   memset(&sa, 0, sizeof(sa));
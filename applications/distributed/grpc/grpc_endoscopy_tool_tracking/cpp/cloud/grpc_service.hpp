@@ -86,6 +86,7 @@ class GrpcService {
   void stop() {
     HOLOSCAN_LOG_INFO("grpc: Server shutting down");
     server_->Shutdown();
+    application_factory_->destroy_all_application_instances();
   }
 
  private:
@@ -52,7 +52,10 @@ class VideoInputFragment : public holoscan::Fragment {
   void compose() override {
     condition_ = make_condition<AsynchronousCondition>("response_available_condition");
     request_queue_ =
-        make_resource<ConditionVariableQueue<std::shared_ptr<EntityRequest>>>("request_queue");
+        make_resource<ConditionVariableQueue<std::shared_ptr<EntityRequest>>>(
+            "request_queue",
+            size_t{from_config("grpc_client.request_queue_capacity").as<uint32_t>()},
+            QueueOverflowPolicy::kDropOldest);
     response_queue_ =
         make_resource<AsynchronousConditionQueue<std::shared_ptr<nvidia::gxf::Entity>>>(
             "response_queue", condition_);
@@ -82,13 +85,20 @@ class VideoInputFragment : public holoscan::Fragment {
     // server. The operator will convert the data to a GXF Entity and send it to the Holoviz.
     add_operator(incoming_responses);
 
+    EntityStreamOptions stream_options;
+    stream_options.compression = from_config("grpc_client.compression").as<std::string>();
+    stream_options.compression_threshold =
+        from_config("grpc_client.compression_threshold").as<uint32_t>();
+    stream_options.batch_latency = from_config("grpc_client.batch_latency").as<uint32_t>();
+
     entity_client_service_ = std::make_shared<EntityClientService>(
         from_config("grpc_client.server_address").as<std::string>(),
         from_config("grpc_client.rpc_timeout").as<uint32_t>(),
         from_config("grpc_client.interrupt").as<bool>(),
         request_queue_,
         response_queue_,
-        outgoing_requests);
+        outgoing_requests,
+        stream_options);
     entity_client_service_->start_entity_stream();
   }
 
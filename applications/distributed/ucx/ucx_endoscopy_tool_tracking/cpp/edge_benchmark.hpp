@@ -0,0 +1,221 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef UCX_ENDOSCOPY_TOOL_TRACKING_EDGE_BENCHMARK_HPP
+#define UCX_ENDOSCOPY_TOOL_TRACKING_EDGE_BENCHMARK_HPP
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <map>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <gxf/cuda/cuda_stream_id.hpp>
+#include <holoscan/holoscan.hpp>
+
+namespace holoscan::ops {
+
+// Tensor added to the messages crossing a fragment boundary, holding their send time
+constexpr const char* kEdgeSendTimeTensor = "edge_send_time_ns";
+
+/**
+ * @brief Time on the reference clock of the benchmark, in nanoseconds.
+ *
+ * The realtime clock of each host is disciplined by PTP or NTP; clock_offset_ns is the
+ * residual offset of this host from the reference (e.g. from `chronyc tracking` or `pmc`),
+ * subtracted so that send and receive times of different hosts are comparable.
+ */
+inline int64_t edge_clock_ns(int64_t clock_offset_ns) {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::system_clock::now().time_since_epoch())
+             .count() -
+         clock_offset_ns;
+}
+
+/**
+ * @brief Creates a message holding the tensors and CUDA streams of in, except the tensor named
+ * skip. The tensors reference the memory of in, which is kept alive until they are released, so
+ * in itself is left untouched for the other receivers of the same message.
+ */
+inline nvidia::gxf::Entity forward_tensors(ExecutionContext& context,
+                                           const nvidia::gxf::Entity& in, const char* skip,
+                                           uint64_t* bytes_size) {
+  auto out = nvidia::gxf::Entity::New(context.context());
+  if (!out) { throw std::runtime_error("Failed to allocate the forwarded message"); }
+  *bytes_size = 0;
+
+  auto tensors = in.findAll<nvidia::gxf::Tensor>();
+  if (!tensors) { throw std::runtime_error("Failed to list the tensors of the message"); }
+  for (const auto& tensor : tensors.value()) {
+    if (!tensor) { continue; }
+    const char* name = tensor.value().name();
+    if (skip != nullptr && std::string(name) == skip) { continue; }
+    auto forwarded = out.value().add<nvidia::gxf::Tensor>(name);
+    if (!forwarded) { throw std::runtime_error("Failed to add a forwarded tensor"); }
+    const auto& source = *tensor.value();
+    nvidia::gxf::Tensor::stride_array_t strides;
+    for (uint32_t i = 0; i < source.rank(); ++i) { strides[i] = source.stride(i); }
+    auto result = forwarded.value()->wrapMemory(
+        source.shape(), source.element_type(), source.bytes_per_element(), strides,
+        source.storage_type(), source.pointer(),
+        [keep_alive = in](void*) mutable { return nvidia::gxf::Success; });
+    if (!result) { throw std::runtime_error("Failed to wrap a forwarded tensor"); }
+    *bytes_size += source.size();
+  }
+
+  auto streams = in.findAll<nvidia::gxf::CudaStreamId>();
+  if (streams) {
+    for (const auto& stream : streams.value()) {
+      if (!stream) { continue; }
+      auto forwarded = out.value().add<nvidia::gxf::CudaStreamId>(stream.value().name());
+      if (forwarded) { forwarded.value()->stream_cid = stream.value()->stream_cid; }
+    }
+  }
+  return std::move(out.value());
+}
+
+/**
+ * @brief Stamps the messages sent across a fragment boundary with their send time.
+ *
+ * Placed in the sending fragment, as the last operator before the edge.
+ */
+class EdgeStampOp : public Operator {
+ public:
+  HOLOSCAN_OPERATOR_FORWARD_ARGS(EdgeStampOp)
+
+  EdgeStampOp() = default;
+
+  void setup(OperatorSpec& spec) override {
+    spec.input<gxf::Entity>("in");
+    spec.output<gxf::Entity>("out");
+    spec.param(clock_offset_ns_, "clock_offset_ns", "Clock offset",
+               "Offset of this host from the reference clock in ns", int64_t{0});
+    spec.param(allocator_, "allocator", "Allocator", "Allocator for the send time tensor");
+  }
+
+  void compute(InputContext& op_input, OutputContext& op_output,
+               ExecutionContext& context) override {
+    auto in = op_input.receive<gxf::Entity>("in").value();
+    auto allocator = nvidia::gxf::Handle<nvidia::gxf::Allocator>::Create(context.context(),
+                                                                         allocator_->gxf_cid());
+    uint64_t bytes_size = 0;
+    auto out = forward_tensors(context, in, nullptr, &bytes_size);
+
+    auto stamp = out.add<nvidia::gxf::Tensor>(kEdgeSendTimeTensor);
+    if (!stamp) { throw std::runtime_error("Failed to add the send time tensor"); }
+    if (!stamp.value()->reshape<int64_t>(
+            nvidia::gxf::Shape{1}, nvidia::gxf::MemoryStorageType::kSystem, allocator.value())) {
+      throw std::runtime_error("Failed to allocate the send time tensor");
+    }
+    // Stamped last, after the forwarded message is built
+    *stamp.value()->data<int64_t>().value() = edge_clock_ns(clock_offset_ns_.get());
+
+    op_output.emit(gxf::Entity(std::move(out)), "out");
+  }
+
+ private:
+  Parameter<int64_t> clock_offset_ns_;
+  Parameter<std::shared_ptr<Allocator>> allocator_;
+};
+
+/**
+ * @brief Measures the transfer latency of the messages stamped by an EdgeStampOp, and forwards
+ * them without the stamp.
+ *
+ * Placed in the receiving fragment, as the first operator after the edge. On stop, the latency
+ * percentiles and bandwidth are reported per power-of-two message size.
+ */
+class EdgeProbeOp : public Operator {
+ public:
+  HOLOSCAN_OPERATOR_FORWARD_ARGS(EdgeProbeOp)
+
+  EdgeProbeOp() = default;
+
+  void setup(OperatorSpec& spec) override {
+    spec.input<gxf::Entity>("in");
+    spec.output<gxf::Entity>("out");
+    spec.param(clock_offset_ns_, "clock_offset_ns", "Clock offset",
+               "Offset of this host from the reference clock in ns", int64_t{0});
+    spec.param(edge_, "edge", "Edge", "Name of the measured edge", std::string());
+  }
+
+  void compute(InputContext& op_input, OutputContext& op_output,
+               ExecutionContext& context) override {
+    auto in = op_input.receive<gxf::Entity>("in").value();
+    const int64_t receive_time = edge_clock_ns(clock_offset_ns_.get());
+
+    const nvidia::gxf::Entity& entity = in;
+    auto stamp = entity.get<nvidia::gxf::Tensor>(kEdgeSendTimeTensor);
+    uint64_t bytes_size = 0;
+    auto out = forward_tensors(context, entity, kEdgeSendTimeTensor, &bytes_size);
+    if (stamp && stamp.value()->storage_type() != nvidia::gxf::MemoryStorageType::kDevice) {
+      samples_.emplace_back(bytes_size, receive_time - *stamp.value()->data<int64_t>().value());
+    }
+
+    op_output.emit(gxf::Entity(std::move(out)), "out");
+  }
+
+  void stop() override {
+    if (samples_.empty()) { return; }
+
+    // Group by power-of-two message size
+    std::map<uint64_t, std::vector<int64_t>> latencies;
+    std::map<uint64_t, double> bytes;
+    for (const auto& [size, latency] : samples_) {
+      uint64_t bucket = 1;
+      while (bucket < size) { bucket <<= 1; }
+      latencies[bucket].push_back(latency);
+      bytes[bucket] += static_cast<double>(size);
+    }
+
+    const char* tls = std::getenv("UCX_TLS");
+    HOLOSCAN_LOG_INFO("Edge '{}' transfer latency (UCX_TLS={}):", edge_.get(),
+                      tls ? tls : "default");
+    HOLOSCAN_LOG_INFO("  {:>12} {:>8} {:>10} {:>10} {:>10} {:>10} {:>12}", "size <= B", "count",
+                      "min us", "p50 us", "p90 us", "p99 us", "MB/s");
+    for (auto& [bucket, values] : latencies) {
+      std::sort(values.begin(), values.end());
+      const auto percentile = [&values](double p) {
+        return values[std::min(values.size() - 1, static_cast<size_t>(p * values.size()))] /
+               1000.0;
+      };
+      double total_ns = 0.0;
+      for (int64_t value : values) {
+        total_ns += static_cast<double>(std::max<int64_t>(value, 1));
+      }
+      // Bytes per microsecond is MB/s
+      const double bandwidth = bytes[bucket] / (total_ns / 1000.0);
+      HOLOSCAN_LOG_INFO("  {:>12} {:>8} {:>10.1f} {:>10.1f} {:>10.1f} {:>10.1f} {:>12.1f}",
+                        bucket, values.size(), values.front() / 1000.0, percentile(0.5),
+                        percentile(0.9), percentile(0.99), bandwidth);
+    }
+    samples_.clear();
+  }
+
+ private:
+  Parameter<int64_t> clock_offset_ns_;
+  Parameter<std::string> edge_;
+  // Message size in bytes and transfer latency in ns
+  std::vector<std::pair<uint64_t, int64_t>> samples_;
+};
+
+}  // namespace holoscan::ops
+
+#endif /* UCX_ENDOSCOPY_TOOL_TRACKING_EDGE_BENCHMARK_HPP */
@@ -21,17 +21,33 @@
 #include <holoscan/operators/video_stream_replayer/video_stream_replayer.hpp>
 #include <iostream>
 #include <lstm_tensor_rt_inference.hpp>
+#include <map>
 #include <string>
 #include <tool_tracking_postprocessor.hpp>
+#include "edge_benchmark.hpp"
 #include "holoscan/holoscan.hpp"
 
 using namespace holoscan;
+
+/// Inter-fragment edge benchmark: enabled, and clock offset of the host of each fragment
+struct EdgeBenchmark {
+  bool enabled = false;
+  std::map<std::string, int64_t> clock_offsets_ns;
+
+  int64_t clock_offset_ns(const std::string& fragment) const {
+    auto it = clock_offsets_ns.find(fragment);
+    return it == clock_offsets_ns.end() ? 0 : it->second;
+  }
+};
+
 class VideoInputFragment : public holoscan::Fragment {
  private:
   std::string input_dir_;
+  EdgeBenchmark edge_benchmark_;
 
  public:
-  explicit VideoInputFragment(const std::string& input_dir) : input_dir_(input_dir) {}
+  VideoInputFragment(const std::string& input_dir, const EdgeBenchmark& edge_benchmark)
+      : input_dir_(input_dir), edge_benchmark_(edge_benchmark) {}
 
   void compose() override {
     ArgList args;
@@ -48,6 +64,17 @@ class VideoInputFragment : public holoscan::Fragment {
         args);
 
     add_operator(replayer);
+
+    if (edge_benchmark_.enabled) {
+      // Stamp the frames sent to each of the other fragments
+      const auto allocator = make_resource<UnboundedAllocator>("edge_stamp_allocator");
+      const int64_t clock_offset_ns = edge_benchmark_.clock_offset_ns(name());
+      for (const std::string& edge : {"stamp_inference", "stamp_viz"}) {
+        auto stamp = make_operator<ops::EdgeStampOp>(
+            edge, Arg("clock_offset_ns", clock_offset_ns), Arg("allocator", allocator));
+        add_flow(replayer, stamp, {{"output", "in"}});
+      }
+    }
   }
 };
 
@@ -58,15 +85,18 @@ class CloudInferenceFragment : public holoscan::Fragment {
   uint32_t height_ = 0;
   uint64_t source_block_size_ = 0;
   uint64_t source_num_blocks_ = 0;
+  EdgeBenchmark edge_benchmark_;
 
  public:
   CloudInferenceFragment(const std::string& model_dir, const uint32_t width, const uint32_t height,
-                         const uint64_t source_block_size, const uint64_t source_num_blocks)
+                         const uint64_t source_block_size, const uint64_t source_num_blocks,
+                         const EdgeBenchmark& edge_benchmark)
       : model_dir_(model_dir),
         width_(width),
         height_(height),
         source_block_size_(source_block_size),
-        source_num_blocks_(source_num_blocks) {}
+        source_num_blocks_(source_num_blocks),
+        edge_benchmark_(edge_benchmark) {}
 
   void compose() override {
     const std::shared_ptr<CudaStreamPool> cuda_stream_pool =
@@ -102,6 +132,20 @@ class CloudInferenceFragment : public holoscan::Fragment {
 
     add_flow(format_converter, lstm_inferer);
     add_flow(lstm_inferer, tool_tracking_postprocessor, {{"tensor", "in"}});
+
+    if (edge_benchmark_.enabled) {
+      const int64_t clock_offset_ns = edge_benchmark_.clock_offset_ns(name());
+      auto probe = make_operator<ops::EdgeProbeOp>(
+          "probe_video_in",
+          Arg("clock_offset_ns", clock_offset_ns),
+          Arg("edge", std::string("video_in -> inference")));
+      add_flow(probe, format_converter, {{"out", "source_video"}});
+      auto stamp = make_operator<ops::EdgeStampOp>(
+          "stamp_viz",
+          Arg("clock_offset_ns", clock_offset_ns),
+          Arg("allocator", make_resource<UnboundedAllocator>("edge_stamp_allocator")));
+      add_flow(tool_tracking_postprocessor, stamp, {{"out", "in"}});
+    }
   }
 };
 
@@ -109,9 +153,11 @@ class VizFragment : public holoscan::Fragment {
  private:
   uint32_t width_ = 0;
   uint32_t height_ = 0;
+  EdgeBenchmark edge_benchmark_;
 
  public:
-  VizFragment(const uint32_t width, const uint32_t height) : width_(width), height_(height) {}
+  VizFragment(const uint32_t width, const uint32_t height, const EdgeBenchmark& edge_benchmark)
+      : width_(width), height_(height), edge_benchmark_(edge_benchmark) {}
 
   void compose() override {
     std::shared_ptr<BlockMemoryPool> visualizer_allocator;
@@ -124,12 +170,24 @@ class VizFragment : public holoscan::Fragment {
         Arg("allocator") = visualizer_allocator,
         Arg("cuda_stream_pool") = make_resource<CudaStreamPool>("cuda_stream", 0, 0, 0, 1, 5));
     add_operator(visualizer_operator);
+
+    if (edge_benchmark_.enabled) {
+      const int64_t clock_offset_ns = edge_benchmark_.clock_offset_ns(name());
+      for (const std::string& source : {"video_in", "inference"}) {
+        auto probe = make_operator<ops::EdgeProbeOp>(
+            "probe_" + source,
+            Arg("clock_offset_ns", clock_offset_ns),
+            Arg("edge", source + " -> viz"));
+        add_flow(probe, visualizer_operator, {{"out", "receivers"}});
+      }
+    }
   }
 };
 
 class App : public holoscan::Application {
  public:
   void set_datapath(const std::string& path) { datapath_ = path; }
+  void set_edge_benchmark(const EdgeBenchmark& edge_benchmark) { edge_benchmark_ = edge_benchmark; }
   void compose() override {
     using namespace holoscan;
 
@@ -138,12 +196,25 @@ class App : public holoscan::Application {
     auto source_block_size = width * height * 3 * 4;
     auto source_num_blocks = 2;
 
-    auto video_in = make_fragment<VideoInputFragment>("video_in", datapath_);
-    auto cloud_inference = make_fragment<CloudInferenceFragment>(
-        "inference", datapath_, width, height, source_block_size, source_num_blocks);
-    auto viz = make_fragment<VizFragment>("viz", width, height);
+    auto video_in = make_fragment<VideoInputFragment>("video_in", datapath_, edge_benchmark_);
+    auto cloud_inference = make_fragment<CloudInferenceFragment>("inference",
+                                                                 datapath_,
+                                                                 width,
+                                                                 height,
+                                                                 source_block_size,
+                                                                 source_num_blocks,
+                                                                 edge_benchmark_);
+    auto viz = make_fragment<VizFragment>("viz", width, height, edge_benchmark_);
 
     // Flow definition
+    if (edge_benchmark_.enabled) {
+      // Each edge goes from a stamp in the sending fragment to a probe in the receiving one
+      add_flow(video_in, cloud_inference, {{"stamp_inference.out", "probe_video_in.in"}});
+      add_flow(cloud_inference, viz, {{"stamp_viz.out", "probe_inference.in"}});
+      add_flow(video_in, viz, {{"stamp_viz.out", "probe_video_in.in"}});
+      return;
+    }
+
     add_flow(video_in, cloud_inference, {{"replayer", "format_converter"}});
     add_flow(cloud_inference, viz, {{"tool_tracking_postprocessor.out", "holoviz.receivers"}});
 
@@ -152,6 +223,7 @@ class App : public holoscan::Application {
 
  private:
   std::string datapath_ = "data/endoscopy";
+  EdgeBenchmark edge_benchmark_;
 };
 
 /** Helper function to parse the command line arguments */
@@ -179,7 +251,8 @@ bool parse_arguments(int argc, char** argv, std::string& data_path, std::string&
 }
 
 /** Helper function to parse fragment mode and benchmarking settings from the configuration file */
-void parse_config(const std::string& config_path, bool& benchmarking) {
+void parse_config(const std::string& config_path, bool& benchmarking,
+                  EdgeBenchmark& edge_benchmark) {
   auto config = holoscan::Config(config_path);
   auto& yaml_nodes = config.yaml_nodes();
   for (const auto& yaml_node : yaml_nodes) {
@@ -187,10 +260,21 @@ void parse_config(const std::string& config_path, bool& benchmarking) {
       auto application = yaml_node["application"];
       if (application.IsMap()) {
         benchmarking = application["benchmarking"].as<bool>();
+        if (application["edge_benchmarking"]) {
+          edge_benchmark.enabled = application["edge_benchmarking"].as<bool>();
+        }
+      }
+      auto clock_offsets = yaml_node["edge_benchmark"]["clock_offset_ns"];
+      if (clock_offsets.IsMap()) {
+        for (const auto& offset : clock_offsets) {
+          edge_benchmark.clock_offsets_ns[offset.first.as<std::string>()] =
+              offset.second.as<int64_t>();
+        }
       }
     } catch (std::exception& e) {
       HOLOSCAN_LOG_ERROR("Error parsing configuration file: {}", e.what());
       benchmarking = false;
+      edge_benchmark.enabled = false;
     }
   }
 }
@@ -225,11 +309,13 @@ int main(int argc, char** argv) {
   }
 
   bool benchmarking = false;
-  parse_config(config_path, benchmarking);
+  EdgeBenchmark edge_benchmark;
+  parse_config(config_path, benchmarking, edge_benchmark);
 
   auto app = holoscan::make_application<App>();
   app->config(config_path);
   app->set_datapath(data_directory);
+  app->set_edge_benchmark(edge_benchmark);
 
   std::unordered_map<std::string, DataFlowTracker*> trackers;
   if (benchmarking) {
@@ -23,6 +23,8 @@
 #include <holoscan/operators/video_stream_recorder/video_stream_recorder.hpp>
 #include <holoscan/operators/video_stream_replayer/video_stream_replayer.hpp>
 #include <lstm_tensor_rt_inference.hpp>
+#include <mapped_entity_replayer.hpp>
+#include <multi_format_converter.hpp>
 #include <tool_tracking_postprocessor.hpp>
 #ifdef VTK_RENDERER
 #include <vtk_renderer.hpp>
@@ -41,11 +43,26 @@
 #include <qcap_source.hpp>
 #endif
 
+#ifdef VIDEO_ENCODER
+#include <holoscan/operators/gxf_codelet/gxf_codelet.hpp>
+#include <tensor_to_video_buffer.hpp>
+#include <video_encoder.hpp>
+#endif
+
 #include <holoscan/version_config.hpp>
 
+#include "recording_queue.hpp"
+
 #define HOLOSCAN_VERSION \
   (HOLOSCAN_VERSION_MAJOR * 10000 + HOLOSCAN_VERSION_MINOR * 100 + HOLOSCAN_VERSION_PATCH)
 
+#ifdef VIDEO_ENCODER
+// h.264 encoder GXF codelets and components, see the h264_endoscopy_tool_tracking application
+HOLOSCAN_WRAP_GXF_CODELET_AS_OPERATOR(VideoEncoderResponseOp, "nvidia::gxf::VideoEncoderResponse")
+HOLOSCAN_WRAP_GXF_CODELET_AS_OPERATOR(VideoWriteBitstreamOp, "nvidia::gxf::VideoWriteBitstream")
+HOLOSCAN_WRAP_GXF_COMPONENT_AS_RESOURCE(VideoEncoderContext, "nvidia::gxf::VideoEncoderContext")
+#endif
+
 class App : public holoscan::Application {
  public:
   void set_source(const std::string& source) { source_ = source; }
@@ -65,12 +82,16 @@ class App : public holoscan::Application {
 
   void set_datapath(const std::string& path) { datapath = path; }
 
+  /// @brief Records H.264 instead of GXF entities, with the encoder on the recording branch
+  void set_record_encoded(bool encoded) { record_encoded_ = encoded; }
+
   void compose() override {
     using namespace holoscan;
 
     std::shared_ptr<Operator> source;
     std::shared_ptr<Operator> recorder;
     std::shared_ptr<Operator> recorder_format_converter;
+    std::string recorder_input = "input";
     std::shared_ptr<Operator> visualizer_operator;
 
     const bool use_rdma = from_config("external_source.rdma").as<bool>();
@@ -122,37 +143,68 @@ class App : public holoscan::Application {
     } else {  // Replayer
       width = 854;
       height = 480;
-      source = make_operator<ops::VideoStreamReplayerOp>(
-          "replayer", from_config("replayer"), Arg("directory", datapath));
+      if (from_config("replayer_memory_mapped").as<bool>()) {
+        // reads the recording from memory mapped files with read-ahead and pinned uploads
+        source = make_operator<ops::MappedEntityReplayerOp>(
+            "replayer",
+            from_config("replayer"),
+            Arg("directory", datapath),
+            Arg("cuda_stream_pool") =
+                make_resource<CudaStreamPool>("video_replayer_cuda_stream", 0, 0, 0, 1, 1));
+      } else {
+        source = make_operator<ops::VideoStreamReplayerOp>(
+            "replayer", from_config("replayer"), Arg("directory", datapath));
+      }
 #if HOLOSCAN_VERSION >= 20600
       // the RMMAllocator supported since v2.6 is much faster than the default UnboundAllocator
       source->add_arg(Arg("allocator", make_resource<RMMAllocator>("video_replayer_allocator")));
+#else
+      if (from_config("replayer_memory_mapped").as<bool>()) {
+        source->add_arg(
+            Arg("allocator", make_resource<UnboundedAllocator>("video_replayer_allocator")));
+      }
 #endif
       source_block_size = width * height * 3 * 4;
       source_num_blocks = 2;
     }
 
+    // the format converter also outputs the RGB888 frames recorded from live sources and the
+    // RGBA8888 frames displayed from Deltacast, reading the source once
+    const bool record_converted_input = (record_type_ == Record::INPUT) && (source_ != "replayer");
+    bool display_converted_input = false;
+#ifdef DELTACAST_VIDEOMASTER
+    display_converted_input = (source_ == "deltacast") && !overlay_enabled;
+#endif
+
     if (record_type_ != Record::NONE) {
-      if (((record_type_ == Record::INPUT) && (source_ != "replayer")) ||
-          (record_type_ == Record::VISUALIZER)) {
+      if (record_type_ == Record::VISUALIZER) {
         recorder_format_converter = make_operator<ops::FormatConverterOp>(
             "recorder_format_converter",
             from_config("recorder_format_converter"),
             Arg("pool") =
                 make_resource<BlockMemoryPool>("pool", 1, source_block_size, source_num_blocks));
       }
-      recorder = make_operator<ops::VideoStreamRecorderOp>("recorder", from_config("recorder"));
+      if (record_encoded_) {
+        recorder = make_encoded_recorder(width, height);
+        recorder_input = "in";
+      } else {
+        recorder = make_operator<ops::VideoStreamRecorderOp>("recorder", from_config("recorder"));
+      }
     }
 
     const std::shared_ptr<CudaStreamPool> cuda_stream_pool =
         make_resource<CudaStreamPool>("cuda_stream", 0, 0, 0, 1, 5);
 
-    auto format_converter =
-        make_operator<ops::FormatConverterOp>("format_converter",
-                                              from_config("format_converter_" + source_),
-                                              Arg("pool") = make_resource<BlockMemoryPool>(
-                                                  "pool", 1, source_block_size, source_num_blocks),
-                                              Arg("cuda_stream_pool") = cuda_stream_pool);
+    const uint64_t format_converter_num_outputs =
+        1 + (record_converted_input ? 1 : 0) + (display_converted_input ? 1 : 0);
+    auto format_converter = make_operator<ops::MultiFormatConverterOp>(
+        "format_converter",
+        from_config("format_converter_" + source_),
+        Arg("enable_rgb_output") = record_converted_input,
+        Arg("enable_rgba_output") = display_converted_input,
+        Arg("pool") = make_resource<BlockMemoryPool>(
+            "pool", 1, source_block_size, source_num_blocks * format_converter_num_outputs),
+        Arg("cuda_stream_pool") = cuda_stream_pool);
 
     const std::string model_file_path = datapath + "/tool_loc_convlstm.onnx";
     const std::string engine_cache_dir = datapath + "/engines";
@@ -225,7 +277,7 @@ class App : public holoscan::Application {
 
     add_flow(source, format_converter, {{output_signal, "source_video"}});
 
-    add_flow(format_converter, lstm_inferer);
+    add_flow(format_converter, lstm_inferer, {{"tensor", "source_video"}});
 
     if (source_ == "deltacast") {
 #ifdef DELTACAST_VIDEOMASTER
@@ -242,29 +294,10 @@ class App : public holoscan::Application {
             Arg("framerate") = from_config("deltacast.framerate").as<uint32_t>(),
             Arg("pool") = make_resource<UnboundedAllocator>("pool"),
             Arg("enable_overlay") = overlay_enabled);
-        auto overlay_format_converter_videomaster = make_operator<ops::FormatConverterOp>(
-            "overlay_format_converter",
-            from_config("deltacast_overlay_format_converter"),
-            Arg("pool") =
-                make_resource<BlockMemoryPool>("pool", 1, source_block_size, source_num_blocks));
-        add_flow(visualizer_operator,
-                 overlay_format_converter_videomaster,
-                 {{"render_buffer_output", ""}});
-        add_flow(overlay_format_converter_videomaster, overlayer);
+        // The render buffer is resized and packed for the keyer by the transmitter itself
+        add_flow(visualizer_operator, overlayer, {{"render_buffer_output", "source"}});
       } else {
-        auto visualizer_format_converter_videomaster = make_operator<ops::FormatConverterOp>(
-            "visualizer_format_converter",
-            from_config("deltacast_visualizer_format_converter"),
-            Arg("pool") =
-                make_resource<BlockMemoryPool>("pool", 1, source_block_size, source_num_blocks));
-        auto drop_alpha_channel_converter = make_operator<ops::FormatConverterOp>(
-            "drop_alpha_channel_converter",
-            from_config("deltacast_drop_alpha_channel_converter"),
-            Arg("pool") =
-                make_resource<BlockMemoryPool>("pool", 1, source_block_size, source_num_blocks));
-        add_flow(source, drop_alpha_channel_converter);
-        add_flow(drop_alpha_channel_converter, visualizer_format_converter_videomaster);
-        add_flow(visualizer_format_converter_videomaster, visualizer_operator, {{"", "receivers"}});
+        add_flow(format_converter, visualizer_operator, {{"rgba", "receivers"}});
       }
 #endif
     } else {
@@ -279,8 +312,7 @@ class App : public holoscan::Application {
 
     if (record_type_ == Record::INPUT) {
       if (source_ != "replayer") {
-        add_flow(source, recorder_format_converter, {{output_signal, "source_video"}});
-        add_flow(recorder_format_converter, recorder);
+        add_flow(format_converter, recorder, {{"rgb", recorder_input}});
       } else {
         add_flow(source, recorder);
       }
@@ -293,6 +325,75 @@ class App : public holoscan::Application {
   }
 
  private:
+  /**
+   * @brief Recording branch encoding RGB888 frames of width x height to H.264
+   *
+   * The branch starts with a bounded queue dropping the oldest frame waiting when the encoder or
+   * the disk falls behind, and runs on its own CUDA stream. Returns the queue, which receives the
+   * frames on its "in" port.
+   */
+  std::shared_ptr<holoscan::Operator> make_encoded_recorder(uint32_t width, uint32_t height) {
+    using namespace holoscan;
+#ifdef VIDEO_ENCODER
+    auto extension_manager = executor().extension_manager();
+    extension_manager->load_extension("libgxf_videoencoder.so");
+    extension_manager->load_extension("libgxf_videoencoderio.so");
+
+    const uint64_t frame_size = static_cast<uint64_t>(width) * height * 3;
+    const uint64_t queue_capacity = from_config("recording_queue.capacity").as<uint64_t>();
+    auto recording_queue = make_operator<ops::RecordingQueueOp>(
+        "recording_queue",
+        from_config("recording_queue"),
+        Arg("allocator") =
+            make_resource<BlockMemoryPool>("pool", 1, frame_size, queue_capacity + 2),
+        Arg("cuda_stream_pool") =
+            make_resource<CudaStreamPool>("recording_cuda_stream", 0, 0, 0, 1, 1));
+
+    // RGB888 to YUV 4:2:0 in one kernel, on the stream of the queue
+    auto tensor_to_video_buffer = make_operator<ops::TensorToVideoBufferOp>(
+        "recording_tensor_to_video_buffer",
+        from_config("recording_tensor_to_video_buffer"),
+        Arg("allocator") = make_resource<BlockMemoryPool>("pool", 1, frame_size, 3));
+
+    auto encoder_async_condition = make_condition<AsynchronousCondition>("encoder_async_condition");
+    auto video_encoder_context =
+        make_resource<VideoEncoderContext>(Arg("scheduling_term") = encoder_async_condition);
+    auto video_encoder_request = make_operator<ops::VideoEncoderRequestOp>(
+        "video_encoder_request",
+        from_config("video_encoder_request"),
+        Arg("input_width") = width,
+        Arg("input_height") = height,
+        Arg("videoencoder_context") = video_encoder_context);
+    auto video_encoder_response = make_operator<VideoEncoderResponseOp>(
+        "video_encoder_response",
+        from_config("video_encoder_response"),
+        Arg("pool") = make_resource<BlockMemoryPool>("pool", 1, frame_size, 3),
+        Arg("videoencoder_context") = video_encoder_context);
+
+    const std::string output_video_path = from_config("recorder.directory").as<std::string>() +
+                                          "/" +
+                                          from_config("recorder.basename").as<std::string>() +
+                                          ".264";
+    auto bitstream_writer = make_operator<VideoWriteBitstreamOp>(
+        "bitstream_writer",
+        from_config("bitstream_writer"),
+        Arg("output_video_path", output_video_path),
+        Arg("frame_width") = static_cast<int>(width),
+        Arg("frame_height") = static_cast<int>(height),
+        Arg("pool") = make_resource<BlockMemoryPool>("pool", 0, frame_size, 3));
+
+    add_flow(recording_queue, tensor_to_video_buffer, {{"out", "in_tensor"}});
+    add_flow(tensor_to_video_buffer, video_encoder_request, {{"out_video_buffer", "input_frame"}});
+    add_flow(video_encoder_response, bitstream_writer, {{"output_transmitter", "data_receiver"}});
+    return recording_queue;
+#else
+    throw std::runtime_error(
+        "H.264 recording requires the video_encoder operator, build with Holoscan SDK 2.1 or "
+        "later");
+#endif
+  }
+
+  bool record_encoded_ = false;
   std::string source_ = "replayer";
   std::string visualizer_name = "holoviz";
   Record record_type_ = Record::NONE;
@@ -365,6 +466,17 @@ int main(int argc, char** argv) {
   auto record_type = app->from_config("record_type").as<std::string>();
   app->set_record(record_type);
 
+  // The recording branch runs on its own thread, so that the encoder and the disk never hold
+  // the live path
+  const bool record_encoded = app->from_config("record_encoding").as<std::string>() == "h264";
+  app->set_record_encoded(record_encoded);
+#ifdef VIDEO_ENCODER
+  if (record_encoded && record_type != "none") {
+    app->scheduler(app->make_scheduler<holoscan::EventBasedScheduler>(
+        "event-based-scheduler", holoscan::Arg("worker_thread_number", static_cast<int64_t>(2))));
+  }
+#endif
+
   auto visualizer_name = app->from_config("visualizer").as<std::string>();
   app->set_visualizer_name(visualizer_name);
 
@@ -0,0 +1,142 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "recording_queue.hpp"
+
+#include <algorithm>
+#include <string>
+
+#include <gxf/cuda/cuda_stream.hpp>
+#include <gxf/cuda/cuda_stream_id.hpp>
+#include <gxf/std/tensor.hpp>
+
+namespace holoscan::ops {
+
+void RecordingQueueOp::initialize() {
+  // The queue size is needed before Operator::initialize() creates the input connector
+  auto capacity_arg = std::find_if(args().rbegin(), args().rend(), [](const auto& arg) {
+    return (arg.name() == "capacity");
+  });
+  if (capacity_arg != args().rend()) {
+    auto& param_wrap = spec()->params()["capacity"];
+    ArgumentSetter::set_param(param_wrap, (*capacity_arg));
+  }
+  if (!capacity_.has_value()) { capacity_.set_default_value(); }
+  // a new frame pops the oldest one waiting (policy 0)
+  spec()->inputs()["in"]->connector(IOSpec::ConnectorType::kDoubleBuffer,
+                                    Arg("capacity", std::max<uint64_t>(capacity_.get(), 1)),
+                                    Arg("policy", static_cast<uint64_t>(0)));
+
+  Operator::initialize();
+}
+
+void RecordingQueueOp::setup(OperatorSpec& spec) {
+  spec.input<gxf::Entity>("in");
+  spec.output<gxf::Entity>("out");
+
+  spec.param(capacity_,
+             "capacity",
+             "Capacity",
+             "Number of frames waiting to be recorded, the oldest is dropped for a new one.",
+             static_cast<uint64_t>(4));
+  spec.param(allocator_, "allocator", "Allocator", "Allocator of the frame copies.");
+
+  cuda_stream_handler_.define_params(spec);
+}
+
+void RecordingQueueOp::start() {
+  if (cudaEventCreateWithFlags(&input_event_, cudaEventDisableTiming) != cudaSuccess) {
+    throw std::runtime_error("Failed to create the recording queue event");
+  }
+  recorded_frames_ = 0;
+}
+
+void RecordingQueueOp::stop() {
+  if (input_event_) {
+    cudaEventDestroy(input_event_);
+    input_event_ = nullptr;
+  }
+  HOLOSCAN_LOG_INFO("Recording queue: {} frames recorded", recorded_frames_);
+}
+
+void RecordingQueueOp::compute(InputContext& op_input, OutputContext& op_output,
+                               ExecutionContext& context) {
+  auto in_message = op_input.receive<gxf::Entity>("in").value();
+  nvidia::gxf::Entity& entity = in_message;
+
+  const auto maybe_tensor = entity.get<nvidia::gxf::Tensor>();
+  if (!maybe_tensor) { throw std::runtime_error("No tensor found in the recorded message"); }
+  const auto tensor = maybe_tensor.value();
+  if (tensor->storage_type() != nvidia::gxf::MemoryStorageType::kDevice) {
+    throw std::runtime_error("The recorded tensor must be in device memory");
+  }
+
+  // The message stream is not taken by the stream handler, which then uses its own stream from
+  // the pool for the copy and the rest of the recording branch
+  const cudaStream_t stream = cuda_stream_handler_.get_cuda_stream(context.context());
+  const auto stream_id = entity.get<nvidia::gxf::CudaStreamId>();
+  if (stream_id) {
+    const auto input_stream = nvidia::gxf::Handle<nvidia::gxf::CudaStream>::Create(
+        context.context(), stream_id.value()->stream_cid);
+    if (!input_stream) { throw std::runtime_error("Failed to get the input CUDA stream"); }
+    cudaEventRecord(input_event_, input_stream.value()->stream().value());
+    cudaStreamWaitEvent(stream, input_event_, 0);
+  }
+
+  auto allocator = nvidia::gxf::Handle<nvidia::gxf::Allocator>::Create(
+      fragment()->executor().context(), allocator_->gxf_cid());
+  const std::string name = tensor.name() ? tensor.name() : "";
+  // the copy is packed, the rows of the input may be padded
+  const auto strides = nvidia::gxf::ComputeTrivialStrides(tensor->shape(),
+                                                          tensor->bytes_per_element());
+  auto out_message = CreateTensorMap(context.context(),
+                                     allocator.value(),
+                                     {{name,
+                                       nvidia::gxf::MemoryStorageType::kDevice,
+                                       tensor->shape(),
+                                       tensor->element_type(),
+                                       0,
+                                       strides}},
+                                     false);
+  if (!out_message) { throw std::runtime_error("Failed to allocate the recorded frame"); }
+  const auto out_tensor = out_message.value().get<nvidia::gxf::Tensor>();
+  if (!out_tensor || !out_tensor.value()->pointer()) {
+    throw std::runtime_error("Failed to allocate the recorded frame");
+  }
+  const size_t rows = tensor->rank() > 0 ? tensor->shape().dimension(0) : 1;
+  const size_t row_size = tensor->rank() > 0 ? strides[0] : tensor->bytes_per_element();
+  const size_t in_pitch = tensor->rank() > 0 ? tensor->stride(0) : row_size;
+  if (cudaMemcpy2DAsync(out_tensor.value()->pointer(),
+                        row_size,
+                        tensor->pointer(),
+                        in_pitch,
+                        row_size,
+                        rows,
+                        cudaMemcpyDeviceToDevice,
+                        stream) != cudaSuccess) {
+    throw std::runtime_error("Failed to copy the recorded frame");
+  }
+
+  if (cuda_stream_handler_.to_message(out_message) != GXF_SUCCESS) {
+    throw std::runtime_error("Failed to add the CUDA stream to the recorded frame");
+  }
+  recorded_frames_++;
+  auto result = gxf::Entity(std::move(out_message.value()));
+  op_output.emit(result, "out");
+}
+
+}  // namespace holoscan::ops
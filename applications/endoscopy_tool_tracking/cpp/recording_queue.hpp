@@ -0,0 +1,82 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef ENDOSCOPY_TOOL_TRACKING_RECORDING_QUEUE_HPP
+#define ENDOSCOPY_TOOL_TRACKING_RECORDING_QUEUE_HPP
+
+#include <cuda_runtime.h>
+
+#include <cstdint>
+#include <memory>
+
+#include "holoscan/holoscan.hpp"
+#include "holoscan/utils/cuda_stream_handler.hpp"
+
+namespace holoscan::ops {
+
+/**
+ * @brief Bounded queue at the head of the recording branch.
+ *
+ * The input is a queue of `capacity` frames in which a new frame replaces the oldest one
+ * waiting, so that a slow encoder or disk drops recorded frames and never stalls the live path.
+ * Each frame is copied, on a CUDA stream of this branch that waits on the stream of the input
+ * message, to a tensor allocated from `allocator`: the live path buffers are released as soon as
+ * the copy is done and the recording work does not queue behind the live one.
+ *
+ * ==Named Inputs==
+ *
+ * - **in** : `nvidia::gxf::Entity`
+ *   - A frame, as a device `nvidia::gxf::Tensor`.
+ *
+ * ==Named Outputs==
+ *
+ * - **out** : `nvidia::gxf::Entity`
+ *   - The copy of the frame, with the CUDA stream of the recording branch.
+ *
+ * ==Parameters==
+ *
+ * - **capacity**: Number of frames waiting to be recorded. Optional (default: 4).
+ * - **allocator**: Allocator of the frame copies, at least `capacity` + 1 frames.
+ * - **cuda_stream_pool**: Pool of the recording branch CUDA stream.
+ */
+class RecordingQueueOp : public holoscan::Operator {
+ public:
+  HOLOSCAN_OPERATOR_FORWARD_ARGS(RecordingQueueOp)
+
+  RecordingQueueOp() = default;
+
+  void initialize() override;
+  void setup(OperatorSpec& spec) override;
+  void start() override;
+  void stop() override;
+  void compute(InputContext& op_input, OutputContext& op_output,
+               ExecutionContext& context) override;
+
+ private:
+  Parameter<uint64_t> capacity_;
+  Parameter<std::shared_ptr<Allocator>> allocator_;
+
+  // Recorded on the stream of the input message, waited on by the recording stream
+  cudaEvent_t input_event_ = nullptr;
+  uint64_t recorded_frames_ = 0;
+
+  CudaStreamHandler cuda_stream_handler_;
+};
+
+}  // namespace holoscan::ops
+
+#endif /* ENDOSCOPY_TOOL_TRACKING_RECORDING_QUEUE_HPP */
@@ -302,15 +302,10 @@ class EndoscopyApp(Application):
                 #     framerate=deltacast_kwargs.get("framerate", 60),
                 #     enable_overlay=deltacast_kwargs.get("enable_overlay", False),
                 # )
-                overlay_format_converter = FormatConverterOp(
-                    self,
-                    name="overlay_format_converter",
-                    pool=BlockMemoryPool(self, name="pool", **source_pool_kwargs),
-                    **self.kwargs("deltacast_overlay_format_converter"),
-                )
-                self.add_flow(visualizer, overlay_format_converter, {("render_buffer_output", "")})
+                # The render buffer is resized and packed for the keyer by the transmitter itself
                 # Uncomment to enable DELTACAST capture card (linter issue)
-                # self.add_flow(overlay_format_converter, overlayer)
+                # self.add_flow(visualizer, overlayer, {("render_buffer_output", "source")})
+                pass
             else:
                 visualizer_format_converter_videomaster = FormatConverterOp(
                     self,
@@ -16,6 +16,10 @@
  */
 #include <getopt.h>
 
+#include <cmath>
+#include <string>
+#include <vector>
+
 #include <gxf/core/gxf.h>
 #include <gxf/core/gxf_ext.h>
 #include <holoscan/holoscan.hpp>
@@ -97,43 +101,93 @@ class App : public holoscan::Application {
     int64_t source_block_size = width * height * 3 * 4;
     int64_t source_num_blocks = 2;
 
-    auto bitstream_reader = make_operator<VideoReadBitstreamOp>(
-        "bitstream_reader",
-        from_config("bitstream_reader"),
-        Arg("input_file_path", datapath + "/surgical_video.264"),
-        make_condition<CountCondition>(750),
-        make_condition<PeriodicCondition>("periodic-condition",
-                                          Arg("recess_period") = std::string("25hz")),
-        Arg("pool") =
-            make_resource<BlockMemoryPool>(
-                "pool", 0, source_block_size, source_num_blocks));
-
-    auto response_condition =
-        make_condition<AsynchronousCondition>("response_condition");
-    auto video_decoder_context = make_resource<VideoDecoderContext>(
-        "decoder-context", Arg("async_scheduling_term") = response_condition);
-
-    auto request_condition =
-        make_condition<AsynchronousCondition>("request_condition");
-    auto video_decoder_request = make_operator<VideoDecoderRequestOp>(
-        "video_decoder_request",
-        from_config("video_decoder_request"),
-        Arg("async_scheduling_term") = request_condition,
-        Arg("videodecoder_context") = video_decoder_context);
-
-    auto video_decoder_response = make_operator<VideoDecoderResponseOp>(
-        "video_decoder_response",
-        from_config("video_decoder_response"),
-        Arg("pool") =
-            make_resource<BlockMemoryPool>(
-                "pool", 1, source_block_size, source_num_blocks),
-        Arg("videodecoder_context") = video_decoder_context);
-
-    auto decoder_output_format_converter =
-        make_operator<ops::FormatConverterOp>("decoder_output_format_converter",
-            from_config("decoder_output_format_converter"),
-            Arg("pool") = make_resource<BlockMemoryPool>(
-                "pool", 1, source_block_size, source_num_blocks));
+    // Every stream has its own reader and decoder context, while the bitstream and decoded
+    // surface pools are shared, sized for surfaces_per_stream frames held by each stream.
+    auto bitstreams = from_config("decoder_pool.bitstreams").as<std::vector<std::string>>();
+    auto frames = from_config("decoder_pool.frames").as<int64_t>();
+    auto framerate = from_config("decoder_pool.framerate").as<uint32_t>();
+    auto pace_output = from_config("decoder_pool.pace_output").as<bool>();
+    const std::string recess_period = std::to_string(framerate) + "hz";
+    auto surfaces_per_stream = from_config("decoder_pool.surfaces_per_stream").as<int64_t>();
+    const int64_t num_streams = static_cast<int64_t>(bitstreams.size());
+    if (num_streams == 0) { throw std::runtime_error("No bitstream to decode"); }
+
+    auto bitstream_pool = make_resource<BlockMemoryPool>(
+        "bitstream_pool", 0, source_block_size, source_num_blocks * num_streams);
+    auto surface_pool = make_resource<BlockMemoryPool>(
+        "surface_pool", 1, source_block_size, surfaces_per_stream * num_streams);
+    auto converter_pool = make_resource<BlockMemoryPool>(
+        "converter_pool", 1, source_block_size, source_num_blocks * num_streams);
+
+    // Streams are tiled in a grid of the window, one color layer each
+    const int64_t columns = static_cast<int64_t>(std::ceil(std::sqrt(num_streams)));
+    const int64_t rows = (num_streams + columns - 1) / columns;
+    std::vector<ops::HolovizOp::InputSpec> tensors;
+
+    std::vector<std::shared_ptr<Operator>> converters;
+
+    for (int64_t i = 0; i < num_streams; ++i) {
+      const std::string suffix = "_" + std::to_string(i);
+
+      // Without output pacing, the reader runs at the frame rate of the source
+      auto bitstream_reader = make_operator<VideoReadBitstreamOp>(
+          "bitstream_reader" + suffix,
+          from_config("bitstream_reader"),
+          Arg("input_file_path", datapath + "/" + bitstreams[i]),
+          make_condition<CountCondition>("count" + suffix, frames),
+          Arg("pool") = bitstream_pool);
+      if (!pace_output) {
+        bitstream_reader->add_arg(make_condition<PeriodicCondition>(
+            "periodic-condition" + suffix, Arg("recess_period") = recess_period));
+      }
+
+      auto response_condition =
+          make_condition<AsynchronousCondition>("response_condition" + suffix);
+      auto video_decoder_context = make_resource<VideoDecoderContext>(
+          "decoder-context" + suffix, Arg("async_scheduling_term") = response_condition);
+
+      auto request_condition =
+          make_condition<AsynchronousCondition>("request_condition" + suffix);
+      auto video_decoder_request = make_operator<VideoDecoderRequestOp>(
+          "video_decoder_request" + suffix,
+          from_config("video_decoder_request"),
+          Arg("async_scheduling_term") = request_condition,
+          Arg("videodecoder_context") = video_decoder_context);
+
+      auto video_decoder_response = make_operator<VideoDecoderResponseOp>(
+          "video_decoder_response" + suffix,
+          from_config("video_decoder_response"),
+          Arg("pool") = surface_pool,
+          Arg("videodecoder_context") = video_decoder_context);
+
+      // With output pacing, the decoder runs ahead of the display up to the surfaces of the
+      // stream, and decoded frames are emitted at the frame rate
+      const std::string tensor_name = "stream" + suffix;
+      auto decoder_output_format_converter =
+          make_operator<ops::FormatConverterOp>("decoder_output_format_converter" + suffix,
+              from_config("decoder_output_format_converter"),
+              Arg("out_tensor_name") = tensor_name,
+              Arg("pool") = converter_pool);
+      if (pace_output) {
+        decoder_output_format_converter->add_arg(make_condition<PeriodicCondition>(
+            "pacing" + suffix, Arg("recess_period") = recess_period));
+      }
+
+      ops::HolovizOp::InputSpec spec(tensor_name, ops::HolovizOp::InputType::COLOR);
+      ops::HolovizOp::InputSpec::View view;
+      view.offset_x_ = static_cast<float>(i % columns) / columns;
+      view.offset_y_ = static_cast<float>(i / columns) / rows;
+      view.width_ = 1.f / columns;
+      view.height_ = 1.f / rows;
+      spec.views_.push_back(view);
+      tensors.push_back(spec);
+
+      add_flow(bitstream_reader, video_decoder_request,
+          {{"output_transmitter", "input_frame"}});
+      add_flow(video_decoder_response, decoder_output_format_converter,
+          {{"output_transmitter", "source_video"}});
+      converters.push_back(decoder_output_format_converter);
+    }
 
     std::shared_ptr<BlockMemoryPool> visualizer_allocator =
         make_resource<BlockMemoryPool>(
@@ -144,14 +198,11 @@ class App : public holoscan::Application {
         Arg("height") = height,
         Arg("enable_render_buffer_input") = false,
         Arg("enable_render_buffer_output") = false,
-        Arg("allocator") = visualizer_allocator);
-
-    add_flow(bitstream_reader, video_decoder_request,
-        {{"output_transmitter", "input_frame"}});
-    add_flow(video_decoder_response, decoder_output_format_converter,
-        {{"output_transmitter", "source_video"}});
-    add_flow(decoder_output_format_converter, visualizer,
-        {{"tensor", "receivers"}});
+        Arg("allocator") = visualizer_allocator,
+        Arg("tensors") = tensors);
+    for (auto& converter : converters) {
+      add_flow(converter, visualizer, {{"tensor", "receivers"}});
+    }
   }
 
  private:
@@ -206,6 +257,15 @@ int main(int argc, char** argv) {
   }
 
   if (data_path != "") app->set_datapath(data_path);
+
+  // Streams run concurrently on a thread pool, as each waits on its own decoder
+  auto num_streams = app->from_config("decoder_pool.bitstreams").as<std::vector<std::string>>()
+                         .size();
+  if (num_streams > 1) {
+    app->scheduler(app->make_scheduler<holoscan::EventBasedScheduler>(
+        "event-based-scheduler",
+        holoscan::Arg("worker_thread_number", static_cast<int64_t>(num_streams + 1))));
+  }
   app->run();
 
   return 0;
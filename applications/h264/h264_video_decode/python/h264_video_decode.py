@@ -13,6 +13,7 @@
 # See the License for the specific language governing permissions and
 # limitations under the License.
 
+import math
 import os
 from argparse import ArgumentParser
 
@@ -26,6 +27,7 @@ from holoscan.core import Application
 from holoscan.gxf import load_extensions
 from holoscan.operators import FormatConverterOp, GXFCodeletOp, HolovizOp
 from holoscan.resources import BlockMemoryPool, GXFComponentResource, MemoryStorageType
+from holoscan.schedulers import EventBasedScheduler
 
 # Import h.264 GXF codelets and components as Holoscan operators and resources
 # Starting with Holoscan SDK v2.1.0, importing GXF codelets/components as Holoscan operators/
@@ -100,60 +102,126 @@ class H264VideoDecodeApp(Application):
         source_block_size = width * height * 3 * 4
         source_num_blocks = 2
 
-        bitstream_reader = VideoReadBitstreamOp(
+        # Every stream has its own reader and decoder context, while the bitstream and decoded
+        # surface pools are shared, sized for surfaces_per_stream frames held by each stream.
+        decoder_pool = self.kwargs("decoder_pool")
+        bitstreams = decoder_pool["bitstreams"]
+        framerate = decoder_pool["framerate"]
+        pace_output = decoder_pool["pace_output"]
+        num_streams = len(bitstreams)
+        if num_streams == 0:
+            raise ValueError("No bitstream to decode")
+
+        bitstream_pool = BlockMemoryPool(
             self,
-            CountCondition(self, 750),
-            PeriodicCondition(self, name="periodic-condition", recess_period=0.04),
-            name="bitstream_reader",
-            input_file_path=f"{self.sample_data_path}/surgical_video.264",
-            pool=BlockMemoryPool(
-                self,
-                name="pool",
-                storage_type=MemoryStorageType.HOST,
-                block_size=source_block_size,
-                num_blocks=source_num_blocks,
-            ),
-            **self.kwargs("bitstream_reader"),
+            name="bitstream_pool",
+            storage_type=MemoryStorageType.HOST,
+            block_size=source_block_size,
+            num_blocks=source_num_blocks * num_streams,
         )
-
-        response_condition = AsynchronousCondition(self, "response_condition")
-        video_decoder_context = VideoDecoderContext(self, async_scheduling_term=response_condition)
-
-        request_condition = AsynchronousCondition(self, "request_condition")
-        video_decoder_request = VideoDecoderRequestOp(
+        surface_pool = BlockMemoryPool(
             self,
-            name="video_decoder_request",
-            async_scheduling_term=request_condition,
-            videodecoder_context=video_decoder_context,
-            **self.kwargs("video_decoder_request"),
+            name="surface_pool",
+            storage_type=MemoryStorageType.DEVICE,
+            block_size=source_block_size,
+            num_blocks=decoder_pool["surfaces_per_stream"] * num_streams,
         )
-
-        video_decoder_response = VideoDecoderResponseOp(
+        converter_pool = BlockMemoryPool(
             self,
-            name="video_decoder_response",
-            pool=BlockMemoryPool(
-                self,
-                name="pool",
-                storage_type=MemoryStorageType.DEVICE,
-                block_size=source_block_size,
-                num_blocks=source_num_blocks,
-            ),
-            videodecoder_context=video_decoder_context,
-            **self.kwargs("video_decoder_response"),
+            name="converter_pool",
+            storage_type=MemoryStorageType.DEVICE,
+            block_size=source_block_size,
+            num_blocks=source_num_blocks * num_streams,
         )
 
-        decoder_output_format_converter = FormatConverterOp(
-            self,
-            name="decoder_output_format_converter",
-            pool=BlockMemoryPool(
+        # Streams are tiled in a grid of the window, one color layer each
+        columns = math.ceil(math.sqrt(num_streams))
+        rows = math.ceil(num_streams / columns)
+        tensors = []
+
+        converters = []
+
+        for i, bitstream in enumerate(bitstreams):
+            # Without output pacing, the reader runs at the frame rate of the source
+            conditions = [CountCondition(self, decoder_pool["frames"], name=f"count_{i}")]
+            if not pace_output:
+                conditions.append(
+                    PeriodicCondition(
+                        self, name=f"periodic-condition_{i}", recess_period=1.0 / framerate
+                    )
+                )
+            bitstream_reader = VideoReadBitstreamOp(
                 self,
-                name="pool",
-                storage_type=MemoryStorageType.DEVICE,
-                block_size=source_block_size,
-                num_blocks=source_num_blocks,
-            ),
-            **self.kwargs("decoder_output_format_converter"),
-        )
+                *conditions,
+                name=f"bitstream_reader_{i}",
+                input_file_path=f"{self.sample_data_path}/{bitstream}",
+                pool=bitstream_pool,
+                **self.kwargs("bitstream_reader"),
+            )
+
+            response_condition = AsynchronousCondition(self, f"response_condition_{i}")
+            video_decoder_context = VideoDecoderContext(
+                self, name=f"decoder-context_{i}", async_scheduling_term=response_condition
+            )
+
+            request_condition = AsynchronousCondition(self, f"request_condition_{i}")
+            video_decoder_request = VideoDecoderRequestOp(
+                self,
+                name=f"video_decoder_request_{i}",
+                async_scheduling_term=request_condition,
+                videodecoder_context=video_decoder_context,
+                **self.kwargs("video_decoder_request"),
+            )
+
+            video_decoder_response = VideoDecoderResponseOp(
+                self,
+                name=f"video_decoder_response_{i}",
+                pool=surface_pool,
+                videodecoder_context=video_decoder_context,
+                **self.kwargs("video_decoder_response"),
+            )
+
+            # With output pacing, the decoder runs ahead of the display up to the surfaces of
+            # the stream, and decoded frames are emitted at the frame rate
+            tensor_name = f"stream_{i}"
+            pacing = []
+            if pace_output:
+                pacing.append(
+                    PeriodicCondition(self, name=f"pacing_{i}", recess_period=1.0 / framerate)
+                )
+            decoder_output_format_converter = FormatConverterOp(
+                self,
+                *pacing,
+                name=f"decoder_output_format_converter_{i}",
+                out_tensor_name=tensor_name,
+                pool=converter_pool,
+                **self.kwargs("decoder_output_format_converter"),
+            )
+
+            tensors.append(
+                dict(
+                    name=tensor_name,
+                    type="color",
+                    views=[
+                        dict(
+                            offset_x=(i % columns) / columns,
+                            offset_y=(i // columns) / rows,
+                            width=1.0 / columns,
+                            height=1.0 / rows,
+                        )
+                    ],
+                )
+            )
+
+            self.add_flow(
+                bitstream_reader, video_decoder_request, {("output_transmitter", "input_frame")}
+            )
+            self.add_flow(
+                video_decoder_response,
+                decoder_output_format_converter,
+                {("output_transmitter", "source_video")},
+            )
+            converters.append(decoder_output_format_converter)
 
         visualizer_allocator = BlockMemoryPool(
             self,
@@ -170,18 +238,11 @@ class H264VideoDecodeApp(Application):
             enable_render_buffer_input=False,
             enable_render_buffer_output=False,
             allocator=visualizer_allocator,
+            tensors=tensors,
             **self.kwargs("holoviz"),
         )
-
-        self.add_flow(
-            bitstream_reader, video_decoder_request, {("output_transmitter", "input_frame")}
-        )
-        self.add_flow(
-            video_decoder_response,
-            decoder_output_format_converter,
-            {("output_transmitter", "source_video")},
-        )
-        self.add_flow(decoder_output_format_converter, visualizer, {("tensor", "receivers")})
+        for converter in converters:
+            self.add_flow(converter, visualizer, {("tensor", "receivers")})
 
 
 if __name__ == "__main__":
@@ -217,4 +278,13 @@ if __name__ == "__main__":
     load_extensions(context, exts)
 
     app.config(config_file)
+
+    # Streams run concurrently on a thread pool, as each waits on its own decoder
+    num_streams = len(app.kwargs("decoder_pool")["bitstreams"])
+    if num_streams > 1:
+        app.scheduler(
+            EventBasedScheduler(
+                app, name="event-based-scheduler", worker_thread_number=num_streams + 1
+            )
+        )
     app.run()
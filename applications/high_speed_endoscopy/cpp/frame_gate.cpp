@@ -0,0 +1,102 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "frame_gate.hpp"
+
+#include <cmath>
+
+#include <gxf/std/timestamp.hpp>
+
+namespace holoscan::ops {
+
+void FrameGateOp::setup(OperatorSpec& spec) {
+  // one slot, where a new frame pops the one waiting (policy 0)
+  spec.input<gxf::Entity>("in").connector(IOSpec::ConnectorType::kDoubleBuffer,
+                                          Arg("capacity", static_cast<uint64_t>(1)),
+                                          Arg("policy", static_cast<uint64_t>(0)));
+  spec.output<gxf::Entity>("out");
+
+  spec.param(deadline_us_,
+             "deadline_us",
+             "Deadline",
+             "Frames acquired longer ago, in microseconds, are discarded. 0 keeps all of them.",
+             0U);
+  spec.param(framerate_,
+             "framerate",
+             "Frame Rate",
+             "Frame rate of the source, to count the frames replaced in the queue.",
+             0U);
+  spec.param(report_period_,
+             "report_period",
+             "Report Period",
+             "Period in seconds of the drop logs.",
+             10.f);
+}
+
+void FrameGateOp::start() {
+  last_acqtime_ = 0;
+  last_report_ = std::chrono::steady_clock::now();
+}
+
+void FrameGateOp::stop() {
+  report();
+}
+
+void FrameGateOp::compute(InputContext& op_input, OutputContext& op_output, ExecutionContext&) {
+  auto in_message = op_input.receive<gxf::Entity>("in").value();
+
+  const auto now = std::chrono::steady_clock::now();
+  if (std::chrono::duration<float>(now - last_report_).count() >= report_period_) { report(); }
+
+  // Frames without a timestamp are always forwarded
+  nvidia::gxf::Entity& entity = in_message;
+  auto timestamp = entity.get<nvidia::gxf::Timestamp>();
+  if (timestamp) {
+    const int64_t acqtime = timestamp.value()->acqtime;
+    if (last_acqtime_ != 0 && framerate_ > 0U) {
+      // the frames replaced in the queue are the periods missing between two acquisitions
+      const int64_t periods = std::llround((acqtime - last_acqtime_) * 1e-9 * framerate_);
+      if (periods > 1) { replaced_frames_ += periods - 1; }
+    }
+    last_acqtime_ = acqtime;
+
+    const int64_t age_ns =
+        std::chrono::duration_cast<std::chrono::nanoseconds>(now.time_since_epoch()).count() -
+        acqtime;
+    if (deadline_us_ > 0U && age_ns > static_cast<int64_t>(deadline_us_) * 1000) {
+      late_frames_++;
+      return;
+    }
+  }
+
+  forwarded_frames_++;
+  op_output.emit(in_message, "out");
+}
+
+void FrameGateOp::report() {
+  last_report_ = std::chrono::steady_clock::now();
+  if (forwarded_frames_ == 0 && replaced_frames_ == 0 && late_frames_ == 0) { return; }
+  HOLOSCAN_LOG_INFO("Frame gate: {} frames forwarded, {} replaced by newer frames, {} late",
+                    forwarded_frames_,
+                    replaced_frames_,
+                    late_frames_);
+  forwarded_frames_ = 0;
+  replaced_frames_ = 0;
+  late_frames_ = 0;
+}
+
+}  // namespace holoscan::ops
@@ -0,0 +1,83 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef HIGH_SPEED_ENDOSCOPY_FRAME_GATE_HPP
+#define HIGH_SPEED_ENDOSCOPY_FRAME_GATE_HPP
+
+#include <chrono>
+#include <cstdint>
+
+#include "holoscan/holoscan.hpp"
+
+namespace holoscan::ops {
+
+/**
+ * @brief Latest-frame-wins gate between a capture source and the GPU stages.
+ *
+ * The input is a one-slot queue in which a new frame replaces the one still waiting, so that a
+ * stall downstream never queues stale frames. The source output should not wait for this queue
+ * to be free, see `ConditionType::kNone`. Frames older than `deadline_us` since their
+ * acquisition, from their `nvidia::gxf::Timestamp`, are discarded before any GPU work. Forwarded,
+ * replaced and late frames are logged every `report_period`.
+ *
+ * ==Named Inputs==
+ *
+ * - **in** : `nvidia::gxf::Entity`
+ *   - A captured frame, with a `nvidia::gxf::Timestamp` for the deadline and drop counts.
+ *
+ * ==Named Outputs==
+ *
+ * - **out** : `nvidia::gxf::Entity`
+ *   - The input message, when it is fresh enough.
+ *
+ * ==Parameters==
+ *
+ * - **deadline_us**: Frames acquired longer ago are discarded, 0 keeps all of them. Optional
+ *   (default: 0).
+ * - **framerate**: Frame rate of the source, to count the frames replaced in the queue from the
+ *   gaps between acquisition times. 0 does not count them. Optional (default: 0).
+ * - **report_period**: Period in seconds of the drop logs. Optional (default: 10).
+ */
+class FrameGateOp : public holoscan::Operator {
+ public:
+  HOLOSCAN_OPERATOR_FORWARD_ARGS(FrameGateOp)
+
+  FrameGateOp() = default;
+
+  void setup(OperatorSpec& spec) override;
+  void start() override;
+  void stop() override;
+  void compute(InputContext& op_input, OutputContext& op_output,
+               ExecutionContext& context) override;
+
+ private:
+  void report();
+
+  Parameter<uint32_t> deadline_us_;
+  Parameter<uint32_t> framerate_;
+  Parameter<float> report_period_;
+
+  int64_t last_acqtime_ = 0;
+  uint64_t forwarded_frames_ = 0;
+  uint64_t replaced_frames_ = 0;
+  uint64_t late_frames_ = 0;
+  std::chrono::steady_clock::time_point last_report_;
+};
+
+}  // namespace holoscan::ops
+
+#endif /* HIGH_SPEED_ENDOSCOPY_FRAME_GATE_HPP */
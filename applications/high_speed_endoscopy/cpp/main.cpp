@@ -17,9 +17,13 @@
 
 #include <holoscan/holoscan.hpp>
 #include <emergent_source.hpp>
+#include <latency_probe_detector.hpp>
+#include <latency_probe_emitter.hpp>
 #include <holoscan/operators/bayer_demosaic/bayer_demosaic.hpp>
 #include <holoscan/operators/holoviz/holoviz.hpp>
 
+#include "frame_gate.hpp"
+
 class App : public holoscan::Application {
  public:
   void compose() override {
@@ -51,8 +55,36 @@ class App : public holoscan::Application {
     viz = make_operator<ops::HolovizOp>("holoviz", from_config("holoviz"));
 
     // Create the pipeline source->bayer_demosaic->viz
-    add_flow(source, bayer_demosaic, {{"signal", "receiver"}});
-    add_flow(bayer_demosaic, viz, {{"transmitter", "receivers"}});
+    if (from_config("frame_gate.enabled").as<bool>()) {
+      // Latest frame wins: the camera never waits for the pipeline, and the gate only keeps the
+      // newest frame for the GPU stages (source->frame_gate->bayer_demosaic)
+      source->spec()->outputs()["signal"]->condition(ConditionType::kNone);
+      auto frame_gate = make_operator<ops::FrameGateOp>(
+          "frame_gate",
+          from_config("frame_gate"),
+          Arg("framerate", from_config("emergent.framerate").as<uint32_t>()));
+      add_flow(source, frame_gate, {{"signal", "in"}});
+      add_flow(frame_gate, bayer_demosaic, {{"out", "receiver"}});
+    } else {
+      add_flow(source, bayer_demosaic, {{"signal", "receiver"}});
+    }
+    if (from_config("latency_probe.enabled").as<bool>()) {
+      // Measure the glass-to-glass latency with the camera looking at the display:
+      // bayer_demosaic->latency_probe_detector->latency_probe_emitter->viz
+      auto detector = make_operator<ops::LatencyProbeDetectorOp>(
+          "latency_probe_detector",
+          from_config("latency_probe.detector"),
+          Arg("cuda_stream_pool") = cuda_stream_pool);
+      auto emitter = make_operator<ops::LatencyProbeEmitterOp>(
+          "latency_probe_emitter",
+          from_config("latency_probe.emitter"),
+          Arg("cuda_stream_pool") = cuda_stream_pool);
+      add_flow(bayer_demosaic, detector, {{"transmitter", "in"}});
+      add_flow(detector, emitter, {{"out", "in"}});
+      add_flow(emitter, viz, {{"out", "receivers"}});
+    } else {
+      add_flow(bayer_demosaic, viz, {{"transmitter", "receivers"}});
+    }
   }
 
  private:
@@ -21,6 +21,7 @@
 #include <string>
 
 #include <getopt.h>
+#include <gxf/std/timestamp.hpp>
 
 namespace holoscan::ops {
 
@@ -62,11 +63,13 @@ class SourceOp : public Operator {
     Operator::initialize();
   }
 
-  void setup(OperatorSpec& spec) override { spec.output<holoscan::gxf::Entity>("output"); }
+  void setup(OperatorSpec& spec) override {
+    // don't wait for the display, frames which can't be displayed in time are replaced by newer
+    // ones in the queue of the latest frame operator
+    spec.output<holoscan::gxf::Entity>("output").condition(ConditionType::kNone);
+  }
 
   void compute(InputContext& input, OutputContext& output, ExecutionContext& context) override {
-    if (start_.time_since_epoch().count() == 0) { start_ = std::chrono::steady_clock::now(); }
-
     auto entity = holoscan::gxf::Entity::New(&context);
     auto tensor = static_cast<nvidia::gxf::Entity&>(entity).add<nvidia::gxf::Tensor>("image");
     tensor.value()->wrapMemory(shape_,
@@ -76,18 +79,13 @@ class SourceOp : public Operator {
                                nvidia::gxf::MemoryStorageType::kSystem,
                                data_.data(),
                                nullptr);
+    // stamp the frame with its acquisition time to measure the display latency
+    auto timestamp =
+        static_cast<nvidia::gxf::Entity&>(entity).add<nvidia::gxf::Timestamp>("timestamp");
+    timestamp.value()->acqtime = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                     std::chrono::steady_clock::now().time_since_epoch())
+                                     .count();
     output.emit(entity, "output");
-
-    iterations_++;
-    const std::chrono::milliseconds elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
-        std::chrono::steady_clock::now() - start_);
-    if (elapsed.count() > 1000) {
-      const float fps =
-          static_cast<float>(iterations_) / (static_cast<float>(elapsed.count()) / 1000.f);
-      HOLOSCAN_LOG_INFO("Frames per second {}", fps);
-      start_ = std::chrono::steady_clock::now();
-      iterations_ = 0;
-    }
   }
 
  private:
@@ -96,15 +94,34 @@ class SourceOp : public Operator {
   uint64_t element_size_;
   nvidia::gxf::Tensor::stride_array_t strides_;
   std::vector<uint8_t> data_;
-  std::chrono::steady_clock::time_point start_;
-  uint32_t iterations_ = 0;
+};
+
+// Forwards the most recent frame. The input queue has one slot and a new frame replaces the one
+// still waiting, the display never works through a backlog of stale frames.
+class LatestFrameOp : public Operator {
+ public:
+  HOLOSCAN_OPERATOR_FORWARD_ARGS(LatestFrameOp);
+
+  void setup(OperatorSpec& spec) override {
+    // one slot, where a new frame pops the one waiting (policy 0)
+    spec.input<holoscan::gxf::Entity>("input").connector(
+        IOSpec::ConnectorType::kDoubleBuffer,
+        Arg("capacity", static_cast<uint64_t>(1)),
+        Arg("policy", static_cast<uint64_t>(0)));
+    spec.output<holoscan::gxf::Entity>("output");
+  }
+
+  void compute(InputContext& input, OutputContext& output, ExecutionContext& context) override {
+    auto entity = input.receive<holoscan::gxf::Entity>("input").value();
+    output.emit(entity, "output");
+  }
 };
 
 }  // namespace holoscan::ops
 
 class App : public holoscan::Application {
  public:
-  explicit App(int count) : count_(count) {}
+  explicit App(int count, int rate) : count_(count), rate_(rate) {}
   App() = delete;
 
   void compose() override {
@@ -114,32 +131,87 @@ class App : public holoscan::Application {
         make_operator<ops::SourceOp>("source",
                                      // stop application count
                                      make_condition<CountCondition>("count-condition", count_));
+    if (rate_ > 0) {
+      // pace the source like a camera
+      source->add_arg(make_condition<PeriodicCondition>(
+          "periodic-condition", Arg("recess_period", std::to_string(rate_) + "Hz")));
+    }
+
+    auto latest_frame = make_operator<ops::LatestFrameOp>("latest_frame");
 
     auto holoviz = make_operator<ops::HolovizOp>(
         "holoviz",
         // enable synchronization to vertical blank
         Arg("vsync", true),
+        // set the layer callback to measure the displayed frame rate and latency
+        Arg("layer_callback",
+            ops::HolovizOp::LayerCallbackFunction(
+                std::bind(&App::layer_callback, this, std::placeholders::_1))),
         Arg("window_title", std::string("Holoviz vsync")),
         Arg("cuda_stream_pool", make_resource<CudaStreamPool>("cuda_stream_pool", 0, 0, 0, 1, 5)));
 
-    add_flow(source, holoviz, {{"output", "receivers"}});
+    add_flow(source, latest_frame, {{"output", "input"}});
+    add_flow(latest_frame, holoviz, {{"output", "receivers"}});
+  }
+
+  void layer_callback(const std::vector<holoscan::gxf::Entity>& inputs) {
+    const auto now = std::chrono::steady_clock::now();
+    if (start_.time_since_epoch().count() == 0) { start_ = now; }
+
+    // the latency is the age of the frame when Holoviz draws it
+    for (auto&& input : inputs) {
+      auto timestamp = static_cast<const nvidia::gxf::Entity&>(input).get<nvidia::gxf::Timestamp>();
+      if (timestamp) {
+        latency_ns_ +=
+            std::chrono::duration_cast<std::chrono::nanoseconds>(now.time_since_epoch()).count() -
+            timestamp.value()->acqtime;
+        latency_count_++;
+      }
+    }
+
+    iterations_++;
+    const std::chrono::milliseconds elapsed =
+        std::chrono::duration_cast<std::chrono::milliseconds>(now - start_);
+    if (elapsed.count() > 1000) {
+      const float fps =
+          static_cast<float>(iterations_) / (static_cast<float>(elapsed.count()) / 1000.f);
+      const float latency_ms =
+          latency_count_ ? static_cast<float>(latency_ns_) / latency_count_ / 1e6f : 0.f;
+      HOLOSCAN_LOG_INFO("Frames per second {}, latency {} ms ({} frames)",
+                        fps,
+                        latency_ms,
+                        latency_ms * fps / 1000.f);
+      start_ = now;
+      iterations_ = 0;
+      latency_ns_ = 0;
+      latency_count_ = 0;
+    }
   }
 
  private:
   const int count_;
+  const int rate_;
+
+  std::chrono::steady_clock::time_point start_;
+  uint32_t iterations_ = 0;
+  int64_t latency_ns_ = 0;
+  uint32_t latency_count_ = 0;
 };
 
 int main(int argc, char** argv) {
   int count = -1;
+  int rate = 0;
 
-  struct option long_options[] = {
-      {"help", no_argument, 0, 'h'}, {"count", optional_argument, 0, 'c'}, {0, 0, 0, 0}};
+  struct option long_options[] = {{"help", no_argument, 0, 'h'},
+                                  {"count", optional_argument, 0, 'c'},
+                                  {"rate", optional_argument, 0, 'r'},
+                                  {0, 0, 0, 0}};
 
   // parse options
   while (true) {
     int option_index = 0;
 
-    const int c = getopt_long(argc, argv, "hc:", long_options, &option_index);
+    const int c = getopt_long(argc, argv, "hc:r:", long_options, &option_index);
 
     if (c == -1) { break; }
 
@@ -152,6 +224,9 @@ int main(int argc, char** argv) {
                   << "  -h, --help                    Display this information" << std::endl
                   << "  -c <COUNT>, --count <COUNT>   execute operators <COUNT> times (default "
                      "'-1' for unlimited)"
+                  << std::endl
+                  << "  -r <RATE>, --rate <RATE>      source frame rate in Hz (default '0' for "
+                     "unlimited)"
                   << std::endl;
         return 0;
 
@@ -159,6 +234,10 @@ int main(int argc, char** argv) {
         count = stoi(argument);
         break;
 
+      case 'r':
+        rate = stoi(argument);
+        break;
+
       case '?':
         // unknown option, error already printed by getop_long
         break;
@@ -167,7 +246,7 @@ int main(int argc, char** argv) {
     }
   }
 
-  auto app = holoscan::make_application<App>(count);
+  auto app = holoscan::make_application<App>(count, rate);
   app->run();
 
   holoscan::log_info("Application has finished running.");
@@ -0,0 +1,280 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <holoscan/holoscan.hpp>
+#include <holoscan/operators/holoviz/holoviz.hpp>
+#include <cuda_runtime.h>
+
+#include <memory>
+#include <stdexcept>
+#include <string>
+
+#include <getopt.h>
+
+namespace holoscan::ops {
+
+class SourceOp : public Operator {
+ public:
+  HOLOSCAN_OPERATOR_FORWARD_ARGS(SourceOp);
+
+  void initialize() override {
+    const int32_t width = 64, height = 64;
+    shape_ = nvidia::gxf::Shape{width, height, 4};
+    element_type_ = nvidia::gxf::PrimitiveType::kFloat32;
+    element_size_ = nvidia::gxf::PrimitiveTypeSize(element_type_);
+    strides_ = nvidia::gxf::ComputeTrivialStrides(shape_, element_size_);
+
+    data_.resize(strides_[0] * shape_.dimension(0));
+
+    // create an RGB image with smooth color transitions
+    for (size_t y = 0; y < shape_.dimension(0); ++y) {
+      for (size_t x = 0; x < shape_.dimension(1); ++x) {
+        float rgb[3];
+        for (size_t component = 0; component < 3; ++component) {
+          switch (component) {
+            case 0:
+              rgb[component] = float(x) / shape_.dimension(1);
+              break;
+            case 1:
+              rgb[component] = float(y) / shape_.dimension(0);
+              break;
+            case 2:
+              rgb[component] = 1.f - (float(x) / shape_.dimension(1));
+              break;
+          }
+
+          // create two regions, the top region has 100 nits
+          // the bottom region starts at 100 nits and ends at 500 nits
+          constexpr float max_luminance = 10000.f;
+          if (y < height / 2) {
+            rgb[component] *= 100.f / max_luminance;
+          } else {
+            rgb[component] *= (100.f + (float(x) / shape_.dimension(1)) * 500.f) / max_luminance;
+          }
+        }
+
+        // use the RGB data to generate data in HDR10 (BT2020 color space) with SMPTE ST2084
+        // Perceptual Quantizer (PQ) EOTF
+
+        float rgb_2020[3];
+        // linear to BT2020 color space conversion
+        // https://registry.khronos.org/DataFormat/specs/1.3/dataformat.1.3.html#PRIMARIES_BT2020
+        rgb_2020[0] = std::clamp(
+            (0.636958f * rgb[0]) + (0.144617f * rgb[1]) + (0.168881f * rgb[2]), 0.f, 1.f);
+        rgb_2020[1] = std::clamp(
+            (0.262700f * rgb[0]) + (0.677998f * rgb[1]) + (0.059302f * rgb[2]), 0.f, 1.f);
+        rgb_2020[2] = std::clamp(
+            (0.000000f * rgb[0]) + (0.028073f * rgb[1]) + (1.060985f * rgb[2]), 0.f, 1.f);
+
+        // apply inverse SMPTE ST2084 Perceptual Quantizer (PQ) EOTF
+        constexpr float m1 = 2610.f / 16384.f;
+        constexpr float m2 = 2523.f / 4096.f * 128.f;
+        constexpr float c2 = 2413.f / 4096.f * 32.f;
+        constexpr float c3 = 2392.f / 4096.f * 32.f;
+        constexpr float c1 = c3 - c2 + 1.f;
+
+        for (size_t component = 0; component < 3; ++component) {
+          float lp = std::pow(rgb_2020[component], m1);
+          float value = std::pow((c1 + c2 * lp) / (1.f + c3 * lp), m2);
+
+          *reinterpret_cast<float*>(reinterpret_cast<uintptr_t>(data_.data()) + y * strides_[0] +
+                                    x * strides_[1] + component * strides_[2]) = value;
+        }
+        // alpha
+        *reinterpret_cast<float*>(reinterpret_cast<uintptr_t>(data_.data()) + y * strides_[0] +
+                                  x * strides_[1] + 3 * strides_[2]) = 1.f;
+      }
+    }
+
+    // use the HDR10 RGB data to generate YUV 420 BT.2020 narrow range data with 10 bit per
+    // component stored in the upper bits of 16 bit words (P010), the format 10-bit capture cards
+    // deliver
+
+    // setup the video buffer info with the Y and the interleaved UV color planes
+    video_buffer_info_.width = width;
+    video_buffer_info_.height = height;
+    video_buffer_info_.color_format = nvidia::gxf::VideoFormat::GXF_VIDEO_FORMAT_CUSTOM;
+    video_buffer_info_.surface_layout = nvidia::gxf::SurfaceLayout::GXF_SURFACE_LAYOUT_PITCH_LINEAR;
+
+    nvidia::gxf::ColorPlane y_color_plane("Y", 2, width * 2);
+    y_color_plane.width = width;
+    y_color_plane.height = height;
+    y_color_plane.offset = 0;
+    y_color_plane.size = y_color_plane.stride * height;
+    nvidia::gxf::ColorPlane uv_color_plane("UV", 4, (width / 2) * 4);
+    uv_color_plane.width = width / 2;
+    uv_color_plane.height = height / 2;
+    uv_color_plane.offset = y_color_plane.size;
+    uv_color_plane.size = uv_color_plane.stride * (height / 2);
+    video_buffer_info_.color_planes = {y_color_plane, uv_color_plane};
+
+    std::vector<uint16_t> yuv_data((y_color_plane.size + uv_color_plane.size) / sizeof(uint16_t));
+
+    // color model conversion from non-linear RGB to YUV as defined in BT.2020
+    const float Kr = 0.2627f;
+    const float Kb = 0.0593f;
+    const float Kg = 1.f - Kb - Kr;
+
+    // ITU "narrow range" quantization rule for 10 bit, shifted to the upper bits of the word
+    auto quantize = [](float value, float offset, float scale) {
+      return uint16_t(uint16_t(offset + value * scale + 0.5f) << 6);
+    };
+
+    for (size_t y = 0; y < height; ++y) {
+      for (size_t x = 0; x < width; ++x) {
+        const float* rgb = &data_[(y * strides_[0] + x * strides_[1]) / sizeof(float)];
+
+        const float luma = Kr * rgb[0] + Kg * rgb[1] + Kb * rgb[2];  // 0 ... 1
+        const float u = (rgb[2] - luma) / (2.f * (1.f - Kb));       // -0.5 ... 0.5
+        const float v = (rgb[0] - luma) / (2.f * (1.f - Kr));       // -0.5 ... 0.5
+
+        yuv_data[(y * y_color_plane.stride) / sizeof(uint16_t) + x] = quantize(luma, 64.f, 876.f);
+        if (((x & 1) == 0) && ((y & 1) == 0)) {
+          const size_t uv_index =
+              (uv_color_plane.offset + (y / 2) * uv_color_plane.stride) / sizeof(uint16_t) + x;
+          yuv_data[uv_index + 0] = quantize(u, 512.f, 896.f);
+          yuv_data[uv_index + 1] = quantize(v, 512.f, 896.f);
+        }
+      }
+    }
+
+    // upload once, the planes stay in device memory and Holoviz converts them to RGB when
+    // sampling, there is no intermediate RGBA conversion pass
+    yuv_data_size_ = yuv_data.size() * sizeof(uint16_t);
+    void* device_yuv_data = nullptr;
+    if (cudaMalloc(&device_yuv_data, yuv_data_size_) != cudaSuccess) {
+      throw std::runtime_error("Failed to allocate device memory for the YUV image");
+    }
+    device_yuv_data_.reset(device_yuv_data);
+    if (cudaMemcpy(device_yuv_data, yuv_data.data(), yuv_data_size_, cudaMemcpyHostToDevice) !=
+        cudaSuccess) {
+      throw std::runtime_error("Failed to copy the YUV image to device memory");
+    }
+
+    Operator::initialize();
+  }
+
+  void setup(OperatorSpec& spec) override { spec.output<holoscan::gxf::Entity>("output"); }
+
+  void compute(InputContext& input, OutputContext& output, ExecutionContext& context) override {
+    auto entity = holoscan::gxf::Entity::New(&context);
+    auto video_buffer =
+        static_cast<nvidia::gxf::Entity&>(entity).add<nvidia::gxf::VideoBuffer>("image");
+    video_buffer.value()->wrapMemory(video_buffer_info_,
+                                     yuv_data_size_,
+                                     nvidia::gxf::MemoryStorageType::kDevice,
+                                     device_yuv_data_.get(),
+                                     nullptr);
+    output.emit(entity, "output");
+  }
+
+ private:
+  nvidia::gxf::Shape shape_;
+  nvidia::gxf::PrimitiveType element_type_;
+  uint64_t element_size_;
+  nvidia::gxf::Tensor::stride_array_t strides_;
+  std::vector<float> data_;
+  struct CudaDeleter {
+    void operator()(void* ptr) const { cudaFree(ptr); }
+  };
+  std::unique_ptr<void, CudaDeleter> device_yuv_data_;
+  size_t yuv_data_size_ = 0;
+  nvidia::gxf::VideoBufferInfo video_buffer_info_{};
+};
+
+}  // namespace holoscan::ops
+
+class App : public holoscan::Application {
+ public:
+  explicit App(int count) : count_(count) {}
+  App() = delete;
+
+  void compose() override {
+    using namespace holoscan;
+
+    auto source =
+        make_operator<ops::SourceOp>("source",
+                                     // stop application count
+                                     make_condition<CountCondition>("count-condition", count_));
+
+    ops::HolovizOp::InputSpec input_spec("image", ops::HolovizOp::InputType::COLOR);
+
+    // The P010 planes are sampled as 16 bit, the 10 bit values are stored in the upper bits.
+    // Holoviz does the BT.2020 narrow range YUV to RGB conversion in the shader.
+    input_spec.image_format_ = ops::HolovizOp::ImageFormat::Y16_U16V16_2PLANE_420_UNORM;
+    input_spec.yuv_model_conversion_ = ops::HolovizOp::YuvModelConversion::YUV_2020;
+    input_spec.yuv_range_ = ops::HolovizOp::YuvRange::ITU_NARROW;
+
+    auto holoviz = make_operator<ops::HolovizOp>(
+        "holoviz",
+        Arg("tensors", std::vector<ops::HolovizOp::InputSpec>{input_spec}),
+        // select the HDR10 ST2084 display color space
+        Arg("display_color_space", ops::HolovizOp::ColorSpace::HDR10_ST2084),
+        Arg("window_title", std::string("Holoviz YUV HDR")),
+        Arg("cuda_stream_pool", make_resource<CudaStreamPool>("cuda_stream_pool", 0, 0, 0, 1, 5)));
+
+    add_flow(source, holoviz, {{"output", "receivers"}});
+  }
+
+ private:
+  const int count_;
+};
+
+int main(int argc, char** argv) {
+  int count = -1;
+
+  struct option long_options[] = {
+      {"help", no_argument, 0, 'h'}, {"count", optional_argument, 0, 'c'}, {0, 0, 0, 0}};
+
+  // parse options
+  while (true) {
+    int option_index = 0;
+
+    const int c = getopt_long(argc, argv, "hc:", long_options, &option_index);
+
+    if (c == -1) { break; }
+
+    const std::string argument(optarg ? optarg : "");
+    switch (c) {
+      case 'h':
+        std::cout << "Holoviz YUV HDR" << std::endl
+                  << "Usage: " << argv[0] << " [options]" << std::endl
+                  << "Options:" << std::endl
+                  << "  -h, --help                    Display this information" << std::endl
+                  << "  -c <COUNT>, --count <COUNT>   execute operators <COUNT> times (default "
+                     "'-1' for unlimited)"
+                  << std::endl;
+        return 0;
+
+      case 'c':
+        count = stoi(argument);
+        break;
+
+      case '?':
+        // unknown option, error already printed by getop_long
+        break;
+      default:
+        holoscan::log_error("Unhandled option '{}'", static_cast<char>(c));
+    }
+  }
+
+  auto app = holoscan::make_application<App>(count);
+  app->run();
+
+  holoscan::log_info("Application has finished running.");
+  return 0;
+}
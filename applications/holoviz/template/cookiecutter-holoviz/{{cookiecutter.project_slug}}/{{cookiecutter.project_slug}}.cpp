@@ -18,6 +18,10 @@
 {%- if cookiecutter.example == "HDR" %}
   {% set example.rgb_data_type = "float" %}
   {% set example.color_components = 4 %}
+{%- elif cookiecutter.example == "YUV HDR" %}
+  {% set example.rgb_data_type = "float" %}
+  {% set example.color_components = 4 %}
+  {% set example.input_spec = true %}
 {%- elif cookiecutter.example == "sRGB" %}
   {% set example.input_spec = true %}
 {%- elif cookiecutter.example == "vsync" %}
@@ -38,9 +42,18 @@
 {%- if example.print_fps %}
 #include <chrono>
 {%- endif %}
+{%- if cookiecutter.example == "YUV HDR" %}
+#include <cuda_runtime.h>
+
+#include <memory>
+#include <stdexcept>
+{%- endif %}
 #include <string>
 
 #include <getopt.h>
+{%- if example.print_fps %}
+#include <gxf/std/timestamp.hpp>
+{%- endif %}
 
 namespace holoscan::ops {
 
@@ -87,7 +100,7 @@ class SourceOp : public Operator {
             rgb[component] = std::pow(((rgb[component] + 0.055f) / 1.055f), 2.4f);
           }
 {%- endif %}
-{%- if cookiecutter.example == "HDR" %}
+{%- if cookiecutter.example in ["HDR", "YUV HDR"] %}
 
           // create two regions, the top region has 100 nits
           // the bottom region starts at 100 nits and ends at 500 nits
@@ -186,21 +199,91 @@ class SourceOp : public Operator {
       }
     }
 
+{%- endif %}
+
+{%- if cookiecutter.example == "YUV HDR" %}
+
+    // use the HDR10 RGB data to generate YUV 420 BT.2020 narrow range data with 10 bit per
+    // component stored in the upper bits of 16 bit words (P010), the format 10-bit capture cards
+    // deliver
+
+    // setup the video buffer info with the Y and the interleaved UV color planes
+    video_buffer_info_.width = width;
+    video_buffer_info_.height = height;
+    video_buffer_info_.color_format = nvidia::gxf::VideoFormat::GXF_VIDEO_FORMAT_CUSTOM;
+    video_buffer_info_.surface_layout = nvidia::gxf::SurfaceLayout::GXF_SURFACE_LAYOUT_PITCH_LINEAR;
+
+    nvidia::gxf::ColorPlane y_color_plane("Y", 2, width * 2);
+    y_color_plane.width = width;
+    y_color_plane.height = height;
+    y_color_plane.offset = 0;
+    y_color_plane.size = y_color_plane.stride * height;
+    nvidia::gxf::ColorPlane uv_color_plane("UV", 4, (width / 2) * 4);
+    uv_color_plane.width = width / 2;
+    uv_color_plane.height = height / 2;
+    uv_color_plane.offset = y_color_plane.size;
+    uv_color_plane.size = uv_color_plane.stride * (height / 2);
+    video_buffer_info_.color_planes = {y_color_plane, uv_color_plane};
+
+    std::vector<uint16_t> yuv_data((y_color_plane.size + uv_color_plane.size) / sizeof(uint16_t));
+
+    // color model conversion from non-linear RGB to YUV as defined in BT.2020
+    const float Kr = 0.2627f;
+    const float Kb = 0.0593f;
+    const float Kg = 1.f - Kb - Kr;
+
+    // ITU "narrow range" quantization rule for 10 bit, shifted to the upper bits of the word
+    auto quantize = [](float value, float offset, float scale) {
+      return uint16_t(uint16_t(offset + value * scale + 0.5f) << 6);
+    };
+
+    for (size_t y = 0; y < height; ++y) {
+      for (size_t x = 0; x < width; ++x) {
+        const float* rgb = &data_[(y * strides_[0] + x * strides_[1]) / sizeof(float)];
+
+        const float luma = Kr * rgb[0] + Kg * rgb[1] + Kb * rgb[2];  // 0 ... 1
+        const float u = (rgb[2] - luma) / (2.f * (1.f - Kb));       // -0.5 ... 0.5
+        const float v = (rgb[0] - luma) / (2.f * (1.f - Kr));       // -0.5 ... 0.5
+
+        yuv_data[(y * y_color_plane.stride) / sizeof(uint16_t) + x] = quantize(luma, 64.f, 876.f);
+        if (((x & 1) == 0) && ((y & 1) == 0)) {
+          const size_t uv_index =
+              (uv_color_plane.offset + (y / 2) * uv_color_plane.stride) / sizeof(uint16_t) + x;
+          yuv_data[uv_index + 0] = quantize(u, 512.f, 896.f);
+          yuv_data[uv_index + 1] = quantize(v, 512.f, 896.f);
+        }
+      }
+    }
+
+    // upload once, the planes stay in device memory and Holoviz converts them to RGB when
+    // sampling, there is no intermediate RGBA conversion pass
+    yuv_data_size_ = yuv_data.size() * sizeof(uint16_t);
+    void* device_yuv_data = nullptr;
+    if (cudaMalloc(&device_yuv_data, yuv_data_size_) != cudaSuccess) {
+      throw std::runtime_error("Failed to allocate device memory for the YUV image");
+    }
+    device_yuv_data_.reset(device_yuv_data);
+    if (cudaMemcpy(device_yuv_data, yuv_data.data(), yuv_data_size_, cudaMemcpyHostToDevice) !=
+        cudaSuccess) {
+      throw std::runtime_error("Failed to copy the YUV image to device memory");
+    }
+
 {%- endif %}
 
     Operator::initialize();
   }
 
+{%- if example.print_fps %}
+  void setup(OperatorSpec& spec) override {
+    // don't wait for the display, frames which can't be displayed in time are replaced by newer
+    // ones in the queue of the latest frame operator
+    spec.output<holoscan::gxf::Entity>("output").condition(ConditionType::kNone);
+  }
+{%- else %}
   void setup(OperatorSpec& spec) override { spec.output<holoscan::gxf::Entity>("output"); }
+{%- endif %}
 
   void compute(InputContext& input, OutputContext& output, ExecutionContext& context) override {
-{%- if example.print_fps %}
-    if (start_.time_since_epoch().count() == 0) {
-      start_ = std::chrono::steady_clock::now();
-    }
-
-{% endif -%}
-
     auto entity = holoscan::gxf::Entity::New(&context);
 {%- if cookiecutter.example == "YUV" %}
     auto video_buffer =
@@ -210,6 +293,14 @@ class SourceOp : public Operator {
                                     nvidia::gxf::MemoryStorageType::kSystem,
                                     yuv_data_.data(),
                                     nullptr);
+{%- elif cookiecutter.example == "YUV HDR" %}
+    auto video_buffer =
+        static_cast<nvidia::gxf::Entity&>(entity).add<nvidia::gxf::VideoBuffer>("image");
+    video_buffer.value()->wrapMemory(video_buffer_info_,
+                                    yuv_data_size_,
+                                    nvidia::gxf::MemoryStorageType::kDevice,
+                                    device_yuv_data_.get(),
+                                    nullptr);
 {% else -%}
     auto tensor = static_cast<nvidia::gxf::Entity&>(entity).add<nvidia::gxf::Tensor>("image");
     tensor.value()->wrapMemory(shape_,
@@ -220,20 +311,14 @@ class SourceOp : public Operator {
                                data_.data(),
                                nullptr);
 {% endif -%}
-    output.emit(entity, "output");
 {%- if example.print_fps %}
-
-    iterations_++;
-    const std::chrono::milliseconds elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
-        std::chrono::steady_clock::now() - start_);
-    if (elapsed.count() > 1000) {
-      const float fps =
-          static_cast<float>(iterations_) / (static_cast<float>(elapsed.count()) / 1000.f);
-      HOLOSCAN_LOG_INFO("Frames per second {}", fps);
-      start_ = std::chrono::steady_clock::now();
-      iterations_ = 0;
-    }
+    // stamp the frame with its acquisition time to measure the display latency
+    auto timestamp =
+        static_cast<nvidia::gxf::Entity&>(entity).add<nvidia::gxf::Timestamp>("timestamp");
+    timestamp.value()->acqtime = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
 {%- endif %}
+    output.emit(entity, "output");
   }
 
  private:
@@ -245,19 +330,50 @@ class SourceOp : public Operator {
 {%- if cookiecutter.example == "YUV" %}
   std::vector<uint8_t> yuv_data_;
   nvidia::gxf::VideoBufferInfo video_buffer_info_{};
+{%- elif cookiecutter.example == "YUV HDR" %}
+  struct CudaDeleter {
+    void operator()(void* ptr) const { cudaFree(ptr); }
+  };
+  std::unique_ptr<void, CudaDeleter> device_yuv_data_;
+  size_t yuv_data_size_ = 0;
+  nvidia::gxf::VideoBufferInfo video_buffer_info_{};
 {%- endif %}
 
+};
+
 {%- if example.print_fps %}
-  std::chrono::steady_clock::time_point start_;
-  uint32_t iterations_ = 0;
-{%- endif %}
+
+// Forwards the most recent frame. The input queue has one slot and a new frame replaces the one
+// still waiting, the display never works through a backlog of stale frames.
+class LatestFrameOp : public Operator {
+ public:
+  HOLOSCAN_OPERATOR_FORWARD_ARGS(LatestFrameOp);
+
+  void setup(OperatorSpec& spec) override {
+    // one slot, where a new frame pops the one waiting (policy 0)
+    spec.input<holoscan::gxf::Entity>("input").connector(
+        IOSpec::ConnectorType::kDoubleBuffer,
+        Arg("capacity", static_cast<uint64_t>(1)),
+        Arg("policy", static_cast<uint64_t>(0)));
+    spec.output<holoscan::gxf::Entity>("output");
+  }
+
+  void compute(InputContext& input, OutputContext& output, ExecutionContext& context) override {
+    auto entity = input.receive<holoscan::gxf::Entity>("input").value();
+    output.emit(entity, "output");
+  }
 };
+{%- endif %}
 
 }  // namespace holoscan::ops
 
 class App : public holoscan::Application {
  public:
+{%- if example.print_fps %}
+  explicit App(int count, int rate) : count_(count), rate_(rate) {}
+{%- else %}
   explicit App(int count) : count_(count) {}
+{%- endif %}
   App() = delete;
 
   void compose() override {
@@ -267,6 +383,15 @@ class App : public holoscan::Application {
         make_operator<ops::SourceOp>("source",
                                      // stop application count
                                      make_condition<CountCondition>("count-condition", count_));
+{%- if example.print_fps %}
+    if (rate_ > 0) {
+      // pace the source like a camera
+      source->add_arg(make_condition<PeriodicCondition>(
+          "periodic-condition", Arg("recess_period", std::to_string(rate_) + "Hz")));
+    }
+
+    auto latest_frame = make_operator<ops::LatestFrameOp>("latest_frame");
+{%- endif %}
 {%- if example.input_spec %}
 
     ops::HolovizOp::InputSpec input_spec("image", ops::HolovizOp::InputType::COLOR);
@@ -283,6 +408,13 @@ class App : public holoscan::Application {
     input_spec.image_format_ = ops::HolovizOp::ImageFormat::Y8_U8V8_2PLANE_420_UNORM;
     input_spec.yuv_model_conversion_ = ops::HolovizOp::YuvModelConversion::YUV_601;
     input_spec.yuv_range_ = ops::HolovizOp::YuvRange::ITU_FULL;
+{%- elif cookiecutter.example == "YUV HDR" %}
+
+    // The P010 planes are sampled as 16 bit, the 10 bit values are stored in the upper bits.
+    // Holoviz does the BT.2020 narrow range YUV to RGB conversion in the shader.
+    input_spec.image_format_ = ops::HolovizOp::ImageFormat::Y16_U16V16_2PLANE_420_UNORM;
+    input_spec.yuv_model_conversion_ = ops::HolovizOp::YuvModelConversion::YUV_2020;
+    input_spec.yuv_range_ = ops::HolovizOp::YuvRange::ITU_NARROW;
 
 {%- endif %}
 
@@ -291,7 +423,7 @@ class App : public holoscan::Application {
 {%- if example.input_spec %}
         Arg("tensors", std::vector<ops::HolovizOp::InputSpec>{input_spec}),
 {%- endif %}
-{%- if cookiecutter.example == "HDR" %}
+{%- if cookiecutter.example in ["HDR", "YUV HDR"] %}
         // select the HDR10 ST2084 display color space
         Arg("display_color_space", ops::HolovizOp::ColorSpace::HDR10_ST2084),
 {%- endif %}
@@ -302,6 +434,10 @@ class App : public holoscan::Application {
 {%- if cookiecutter.example == "vsync" %}
         // enable synchronization to vertical blank
         Arg("vsync", true),
+        // set the layer callback to measure the displayed frame rate and latency
+        Arg("layer_callback",
+            ops::HolovizOp::LayerCallbackFunction(
+                std::bind(&App::layer_callback, this, std::placeholders::_1))),
 {%- endif %}
 {%- if cookiecutter.example == "UI" %}
         // set the layer callback to execute a member function of the App class.
@@ -311,12 +447,59 @@ class App : public holoscan::Application {
 {%- endif %}
         Arg("window_title", std::string("{{ cookiecutter.project_name }}")),
         Arg("cuda_stream_pool", make_resource<CudaStreamPool>("cuda_stream_pool", 0, 0, 0, 1, 5)));
+{%- if example.print_fps %}
+{%- raw %}
+
+    add_flow(source, latest_frame, {{"output", "input"}});
+    add_flow(latest_frame, holoviz, {{"output", "receivers"}});
+{%- endraw %}
+{%- else %}
 {%- raw %}
 
     add_flow(source, holoviz, {{"output", "receivers"}});
 {%- endraw %}
+{%- endif %}
   }
 
+{%- if example.print_fps %}
+
+  void layer_callback(const std::vector<holoscan::gxf::Entity>& inputs) {
+    const auto now = std::chrono::steady_clock::now();
+    if (start_.time_since_epoch().count() == 0) {
+      start_ = now;
+    }
+
+    // the latency is the age of the frame when Holoviz draws it
+    for (auto&& input : inputs) {
+      auto timestamp = static_cast<const nvidia::gxf::Entity&>(input).get<nvidia::gxf::Timestamp>();
+      if (timestamp) {
+        latency_ns_ +=
+            std::chrono::duration_cast<std::chrono::nanoseconds>(now.time_since_epoch()).count() -
+            timestamp.value()->acqtime;
+        latency_count_++;
+      }
+    }
+
+    iterations_++;
+    const std::chrono::milliseconds elapsed =
+        std::chrono::duration_cast<std::chrono::milliseconds>(now - start_);
+    if (elapsed.count() > 1000) {
+      const float fps =
+          static_cast<float>(iterations_) / (static_cast<float>(elapsed.count()) / 1000.f);
+      const float latency_ms =
+          latency_count_ ? static_cast<float>(latency_ns_) / latency_count_ / 1e6f : 0.f;
+      HOLOSCAN_LOG_INFO("Frames per second {}, latency {} ms ({} frames)",
+                        fps,
+                        latency_ms,
+                        latency_ms * fps / 1000.f);
+      start_ = now;
+      iterations_ = 0;
+      latency_ns_ = 0;
+      latency_count_ = 0;
+    }
+  }
+{%- endif %}
+
 {%- if cookiecutter.example == "UI" %}
   void layer_callback(const std::vector<holoscan::gxf::Entity>& inputs) {
     using namespace holoscan;
@@ -358,6 +541,14 @@ class App : public holoscan::Application {
 
 private:
   const int count_;
+{%- if example.print_fps %}
+  const int rate_;
+
+  std::chrono::steady_clock::time_point start_;
+  uint32_t iterations_ = 0;
+  int64_t latency_ns_ = 0;
+  uint32_t latency_count_ = 0;
+{%- endif %}
 
 {%- if cookiecutter.example == "UI" %}
   bool checkbox_selected_ = false;
@@ -370,18 +561,32 @@ private:
 
 int main(int argc, char** argv) {
   int count = -1;
+{%- if example.print_fps %}
+  int rate = 0;
+{%- raw %}
 
+  struct option long_options[] = {{"help", no_argument, 0, 'h'},
+                                  {"count", optional_argument, 0, 'c'},
+                                  {"rate", optional_argument, 0, 'r'},
+                                  {0, 0, 0, 0}};
+{%- endraw %}
+{%- else %}
 {%- raw %}
 
   struct option long_options[] = {
       {"help", no_argument, 0, 'h'}, {"count", optional_argument, 0, 'c'}, {0, 0, 0, 0}};
 {%- endraw %}
+{%- endif %}
 
   // parse options
   while (true) {
     int option_index = 0;
 
+{%- if example.print_fps %}
+    const int c = getopt_long(argc, argv, "hc:r:", long_options, &option_index);
+{%- else %}
     const int c = getopt_long(argc, argv, "hc:", long_options, &option_index);
+{%- endif %}
 
     if (c == -1) { break; }
 
@@ -394,12 +599,23 @@ int main(int argc, char** argv) {
                   << "  -h, --help                    Display this information" << std::endl
                   << "  -c <COUNT>, --count <COUNT>   execute operators <COUNT> times (default "
                      "'-1' for unlimited)"
+{%- if example.print_fps %}
+                  << std::endl
+                  << "  -r <RATE>, --rate <RATE>      source frame rate in Hz (default '0' for "
+                     "unlimited)"
+{%- endif %}
                   << std::endl;
         return 0;
 
       case 'c':
         count = stoi(argument);
         break;
+{%- if example.print_fps %}
+
+      case 'r':
+        rate = stoi(argument);
+        break;
+{%- endif %}
 
       case '?':
         // unknown option, error already printed by getop_long
@@ -409,7 +625,11 @@ int main(int argc, char** argv) {
     }
   }
 
+{%- if example.print_fps %}
+  auto app = holoscan::make_application<App>(count, rate);
+{%- else %}
   auto app = holoscan::make_application<App>(count);
+{%- endif %}
   app->run();
 
   holoscan::log_info("Application has finished running.");
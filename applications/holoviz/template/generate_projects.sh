@@ -40,3 +40,4 @@ generate "holoviz_srgb" "sRGB" "Holoviz sRGB"
 generate "holoviz_ui" "UI" "Holoviz UI" "holoscan_version=2.5"
 generate "holoviz_vsync" "vsync" "Holoviz vsync"
 generate "holoviz_yuv" "YUV" "Holoviz YUV" "tags=,\"YCbCr\"" "holoscan_version=2.4"
+generate "holoviz_yuv_hdr" "YUV HDR" "Holoviz YUV HDR" "tags=,\"YCbCr\",\"P010\",\"BT.2020\",\"ST.2084\"" "holoscan_version=2.5"
@@ -24,9 +24,9 @@
 #include "matlab_beamform_types.h"
 
 namespace holoscan::ops {
-class MatlabBeamformOp : public Operator {
+class MatlabBeamformOp : public MatlabGpuCoderOp {
  public:
-  HOLOSCAN_OPERATOR_FORWARD_ARGS(MatlabBeamformOp)
+  HOLOSCAN_OPERATOR_FORWARD_ARGS_SUPER(MatlabBeamformOp, MatlabGpuCoderOp)
 
   MatlabBeamformOp() = default;
 
@@ -60,8 +60,7 @@ class MatlabBeamformOp : public Operator {
              std::string(""));
     spec.param(path_data_, "path_data", "PathData", "Path to binary data on disk.",
                std::string(""));
-    spec.param(allocator_, "allocator", "Allocator", "Output Allocator");
-    cuda_stream_handler_.define_params(spec);
+    define_gpu_coder_params(spec);
   }
 
   void start() {
@@ -77,19 +76,31 @@ class MatlabBeamformOp : public Operator {
     std::ifstream is_(path_data_.get(), std::ios::binary);
     if (!is_) { throw std::runtime_error("Error opening binary file"); }
 
-    // Read binary data to CUDA buffers
+    // Read binary data to CUDA buffers and populate the complex MATLAB struct, once
+    cudaStream_t load_stream;
+    cudaStreamCreate(&load_stream);
+    float* rdata_tmp;
+    float* idata_tmp;
     cudaMalloc(&fast_time_, sizeof(float) * depth);
-    disk2cuda_fbuffer(is_, fast_time_, depth);
+    disk2cuda_fbuffer(is_, fast_time_, depth, load_stream);
     cudaMalloc(&x_axis_, sizeof(float) * length);
-    disk2cuda_fbuffer(is_, x_axis_, length);
-    cudaMalloc(&rdata_tmp_, sizeof(float) * depth * length);
-    disk2cuda_fbuffer(is_, rdata_tmp_, depth * length);
-    cudaMalloc(&idata_tmp_, sizeof(float) * depth * length);
-    disk2cuda_fbuffer(is_, idata_tmp_, depth * length);
-
-    // Allocate window buffers
-    cudaMalloc(&x_axis_window_, sizeof(float) * length_window);
-    cudaMalloc(&data_window_, sizeof(creal32_T) * depth * length_window);
+    disk2cuda_fbuffer(is_, x_axis_, length, load_stream);
+    cudaMalloc(&rdata_tmp, sizeof(float) * depth * length);
+    disk2cuda_fbuffer(is_, rdata_tmp, static_cast<size_t>(depth) * length, load_stream);
+    cudaMalloc(&idata_tmp, sizeof(float) * depth * length);
+    disk2cuda_fbuffer(is_, idata_tmp, static_cast<size_t>(depth) * length, load_stream);
+    cudaMalloc(&data_, sizeof(creal32_T) * depth * length);
+    cuda_populate_complex(rdata_tmp, idata_tmp, (void*)data_, depth * length, load_stream);
+    cudaStreamSynchronize(load_stream);
+    cudaFree(rdata_tmp);
+    cudaFree(idata_tmp);
+    cudaStreamDestroy(load_stream);
+
+    // Double-buffered windows and beamformer output, so a frame's inputs are never overwritten
+    // while the previous frame still reads them
+    data_windows_.init(sizeof(creal32_T) * depth * length_window);
+    x_axis_windows_.init(sizeof(float) * length_window);
+    beamformed_.init(sizeof(uint8_t) * depth * length_window * 3);
 
     // Close file reader
     is_.close();
@@ -100,8 +111,9 @@ class MatlabBeamformOp : public Operator {
     cudaFree(fast_time_);
     cudaFree(x_axis_);
     cudaFree(data_);
-    cudaFree(x_axis_window_);
-    cudaFree(data_window_);
+    data_windows_.reset();
+    x_axis_windows_.reset();
+    beamformed_.reset();
 
     // Terminate MATLAB lib
     matlab_beamform_terminate();
@@ -110,106 +122,62 @@ class MatlabBeamformOp : public Operator {
   void compute(InputContext& op_input, OutputContext& op_output,
                ExecutionContext& context) override {
     // Get CUDA stream
-    auto cuda_stream = cuda_stream_handler_.get_cuda_stream(context.context());
-
-    if (complex_data_populated_ == false) {
-      // Once: Populate complex MATLAB struct and free temporary CUDA buffers
-      cudaMalloc(&data_, sizeof(creal32_T) * depth * length);
-      cuda_populate_complex(rdata_tmp_, idata_tmp_, (void*)data_, depth * length, cuda_stream);
-      cudaStreamSynchronize(cuda_stream);
-      cudaFree(rdata_tmp_);
-      cudaFree(idata_tmp_);
-      complex_data_populated_ = true;
-    }
-
-    // Create output message
-    auto out_message = nvidia::gxf::Entity::New(context.context());
-
-    // Get allocator
-    auto allocator =
-      nvidia::gxf::Handle<nvidia::gxf::Allocator>::Create(context.context(), allocator_->gxf_cid());
+    auto cuda_stream = get_cuda_stream(context);
 
     // Allocate output buffer on the device.
-    auto out_tensor = out_message.value().add<nvidia::gxf::Tensor>(out_tensor_name_.get().c_str());
-    if (!out_tensor) { throw std::runtime_error("Failed to allocate output tensor"); }
-    out_tensor.value()->reshape<uint8_t>(
-        nvidia::gxf::Shape{shape_}, nvidia::gxf::MemoryStorageType::kDevice, allocator.value());
-    if (!out_tensor.value()->pointer()) {
-      throw std::runtime_error("Failed to allocate output tensor buffer.");
-    }
-    // Get output data
-    nvidia::gxf::Expected<uint8_t*> out_tensor_data = out_tensor.value()->data<uint8_t>();
-    if (!out_tensor_data) { throw std::runtime_error("Failed to get out tensor data!"); }
+    auto out_message = nvidia::gxf::Entity::New(context.context());
+    if (!out_message) { throw std::runtime_error("Failed to create output message"); }
+    uint8_t* out_tensor_data =
+        add_output_tensor<uint8_t>(out_message.value(), out_tensor_name_.get(), shape_, context);
 
     // Get windows of data_ and x_axis_
-    cudaMemcpy(
-      data_window_,
+    auto data_window = static_cast<creal32_T*>(data_windows_.acquire(cuda_stream));
+    auto x_axis_window = static_cast<float*>(x_axis_windows_.acquire(cuda_stream));
+    cudaMemcpyAsync(
+      data_window,
       data_ + refresh_counter_ * step_window * depth,
       depth * length_window * sizeof(creal32_T),
-      cudaMemcpyDeviceToDevice);
+      cudaMemcpyDeviceToDevice,
+      cuda_stream);
 
-    cudaMemcpy(
-      x_axis_window_,
+    cudaMemcpyAsync(
+      x_axis_window,
       x_axis_ + refresh_counter_ * step_window,
       length_window * sizeof(float),
-      cudaMemcpyDeviceToDevice);
+      cudaMemcpyDeviceToDevice,
+      cuda_stream);
 
     refresh_counter_ += 1;
     if ((refresh_counter_ * step_window * depth) >= (length * depth - length_window * depth)) {
       refresh_counter_ = 0;}
 
-    // Allocate temp output buffer on device
-    auto tmp_tensor = make_tensor(shape_, nvidia::gxf::PrimitiveType::kUnsigned8, sizeof(uint8_t),
-                                  allocator.value());
-    // Get temp data
-    nvidia::gxf::Expected<uint8_t*> tmp_tensor_data = tmp_tensor->data<uint8_t>();
-    if (!tmp_tensor_data) { throw std::runtime_error("Failed to get temporary tensor data!"); }
-
-    // Call MATLAB CUDA function to do beamforming
-    matlab_beamform(data_window_, &params_, x_axis_window_, fast_time_, tmp_tensor_data.value());
-    cudaDeviceSynchronize();
+    // Call MATLAB CUDA function to do beamforming. It runs on the legacy default stream, which
+    // orders it after the copies above and before the transpose below.
+    auto beamformed = static_cast<uint8_t*>(beamformed_.acquire(cuda_stream));
+    matlab_beamform(data_window, &params_, x_axis_window, fast_time_, beamformed);
 
     // Convert output from column- to row-major ordering
-    cuda_hard_transpose<uint8_t>(tmp_tensor_data.value(), out_tensor_data.value(), shape_,
-                                 cuda_stream, Flip::Do);
-    cudaStreamSynchronize(cuda_stream);
-    delete tmp_tensor;
+    cuda_hard_transpose<uint8_t>(beamformed, out_tensor_data, shape_, cuda_stream, Flip::Do);
+    data_windows_.release(cuda_stream);
+    x_axis_windows_.release(cuda_stream);
+    beamformed_.release(cuda_stream);
 
     // Create output message
-    auto result = gxf::Entity(std::move(out_message.value()));
-    op_output.emit(result);
-  }
-
-  void disk2cuda_fbuffer(std::ifstream& is, float* dbuffer, int numel) {
-    // Read binary data from disk and copy to device buffer
-    float* temp = new float[numel];
-    is.read(reinterpret_cast<char*>(temp), sizeof(float) * numel);
-     if (is.fail()) {
-        throw std::runtime_error("Error reading binary file");
-    } else if (is.eof()) {
-      throw std::runtime_error("Reached end of file unexpectedly");
-    }
-    cudaMemcpy(dbuffer, temp, sizeof(float) * numel, cudaMemcpyHostToDevice);
-    delete[] temp;
+    emit_on_stream(out_message.value(), op_output);
   }
 
  private:
   Parameter<holoscan::IOSpec*> out_;
   Parameter<std::string> path_data_;
   Parameter<std::string> out_tensor_name_;
-  Parameter<std::shared_ptr<Allocator>> allocator_;
-  CudaStreamHandler cuda_stream_handler_;
   float* fast_time_;
   float* x_axis_;
   creal32_T* data_;
-  float* x_axis_window_;
-  creal32_T* data_window_;
+  DeviceBufferRing data_windows_;
+  DeviceBufferRing x_axis_windows_;
+  DeviceBufferRing beamformed_;
   struct0_T params_;
-  bool complex_data_populated_ = false;
   int refresh_counter_ = 0;
-  std::ifstream is_;
-  float* rdata_tmp_;
-  float* idata_tmp_;
   std::vector<int32_t> shape_;
 };
 
@@ -220,6 +188,8 @@ class MatlabBeamformApp : public holoscan::Application {
   void compose() override {
     using namespace holoscan;
 
+    // Blocking streams (flags 0), so the GPU Coder library's default stream work is ordered
+    // with them without synchronization
     const std::shared_ptr<CudaStreamPool> cuda_stream_pool =
       make_resource<CudaStreamPool>("cuda_stream", 0, 0, 0, 1, 5);
 
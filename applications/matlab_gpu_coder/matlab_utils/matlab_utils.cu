@@ -118,4 +118,128 @@ nvidia::gxf::Tensor* make_tensor(std::vector<int32_t>& shape, nvidia::gxf::Primi
   return tensor;
 }
 
+void disk2cuda_fbuffer(std::ifstream& is, float* dbuffer, size_t numel, cudaStream_t cuda_stream) {
+  constexpr size_t kChunkSize = 4 * 1024 * 1024;  // floats
+  float* staging[2] = {nullptr, nullptr};
+  cudaEvent_t uploaded[2] = {nullptr, nullptr};
+  for (int i = 0; i < 2; i++) {
+    cudaMallocHost(&staging[i], sizeof(float) * kChunkSize);
+    cudaEventCreateWithFlags(&uploaded[i], cudaEventDisableTiming);
+  }
+
+  bool ok = true;
+  for (size_t offset = 0, chunk = 0; offset < numel; offset += kChunkSize, chunk ^= 1) {
+    const size_t count = std::min(kChunkSize, numel - offset);
+    // The chunk is free once its previous upload completed
+    cudaEventSynchronize(uploaded[chunk]);
+    is.read(reinterpret_cast<char*>(staging[chunk]), sizeof(float) * count);
+    if (!is) {
+      ok = false;
+      break;
+    }
+    cudaMemcpyAsync(dbuffer + offset, staging[chunk], sizeof(float) * count,
+                    cudaMemcpyHostToDevice, cuda_stream);
+    cudaEventRecord(uploaded[chunk], cuda_stream);
+  }
+  cudaStreamSynchronize(cuda_stream);
+
+  for (int i = 0; i < 2; i++) {
+    cudaFreeHost(staging[i]);
+    cudaEventDestroy(uploaded[i]);
+  }
+  if (!ok) {
+    if (is.eof()) { throw std::runtime_error("Reached end of file unexpectedly"); }
+    throw std::runtime_error("Error reading binary file");
+  }
+}
+
+DeviceBufferRing::~DeviceBufferRing() {
+  reset();
+}
+
+void DeviceBufferRing::init(size_t bytes, size_t count) {
+  reset();
+  slots_.resize(count);
+  for (auto& slot : slots_) {
+    if (cudaMalloc(&slot.data, bytes) != cudaSuccess ||
+        cudaEventCreateWithFlags(&slot.released, cudaEventDisableTiming) != cudaSuccess) {
+      throw std::runtime_error("Failed to allocate device buffer ring");
+    }
+  }
+}
+
+void DeviceBufferRing::reset() {
+  // cudaFree synchronizes the device, so pending work on the slots completes first
+  for (auto& slot : slots_) {
+    if (slot.data) { cudaFree(slot.data); }
+    if (slot.released) { cudaEventDestroy(slot.released); }
+  }
+  slots_.clear();
+  current_ = 0;
+}
+
+void* DeviceBufferRing::acquire(cudaStream_t cuda_stream) {
+  Slot& slot = slots_[current_];
+  // Never recorded events are complete, so the first use of a slot does not wait
+  cudaStreamWaitEvent(cuda_stream, slot.released, 0);
+  return slot.data;
+}
+
+void DeviceBufferRing::release(cudaStream_t cuda_stream) {
+  cudaEventRecord(slots_[current_].released, cuda_stream);
+  current_ = (current_ + 1) % slots_.size();
+}
+
+namespace holoscan::ops {
+
+void MatlabGpuCoderOp::define_gpu_coder_params(OperatorSpec& spec) {
+  spec.param(allocator_, "allocator", "Allocator", "Output Allocator");
+  cuda_stream_handler_.define_params(spec);
+}
+
+cudaStream_t MatlabGpuCoderOp::get_cuda_stream(ExecutionContext& context,
+                                               gxf::Entity* in_message) {
+  if (in_message != nullptr &&
+      cuda_stream_handler_.from_message(context.context(), *in_message) != GXF_SUCCESS) {
+    throw std::runtime_error("Failed to get the CUDA stream from incoming messages");
+  }
+  return cuda_stream_handler_.get_cuda_stream(context.context());
+}
+
+template <typename T>
+T* MatlabGpuCoderOp::add_output_tensor(nvidia::gxf::Entity& message, const std::string& name,
+                                       const std::vector<int32_t>& shape,
+                                       ExecutionContext& context) {
+  auto allocator = nvidia::gxf::Handle<nvidia::gxf::Allocator>::Create(context.context(),
+                                                                         allocator_->gxf_cid());
+  auto tensor = message.add<nvidia::gxf::Tensor>(name.c_str());
+  if (!tensor) { throw std::runtime_error("Failed to allocate output tensor"); }
+  if (!tensor.value()->reshape<T>(
+          nvidia::gxf::Shape{shape}, nvidia::gxf::MemoryStorageType::kDevice, allocator.value())) {
+    throw std::runtime_error("Failed to allocate output tensor buffer.");
+  }
+  return tensor.value()->data<T>().value();
+}
+
+template uint8_t* MatlabGpuCoderOp::add_output_tensor(nvidia::gxf::Entity& message,
+                                                      const std::string& name,
+                                                      const std::vector<int32_t>& shape,
+                                                      ExecutionContext& context);
+template float* MatlabGpuCoderOp::add_output_tensor(nvidia::gxf::Entity& message,
+                                                    const std::string& name,
+                                                    const std::vector<int32_t>& shape,
+                                                    ExecutionContext& context);
+
+void MatlabGpuCoderOp::emit_on_stream(nvidia::gxf::Entity& message, OutputContext& op_output,
+                                      const char* name) {
+  nvidia::gxf::Expected<nvidia::gxf::Entity> out_message(message);
+  if (cuda_stream_handler_.to_message(out_message) != GXF_SUCCESS) {
+    throw std::runtime_error("Failed to add the CUDA stream to the outgoing messages");
+  }
+  auto result = gxf::Entity(std::move(message));
+  op_output.emit(result, name);
+}
+
+}  // namespace holoscan::ops
+
 #endif
@@ -24,6 +24,14 @@
  * -Currently supports input/output types: uint8/uint8 and float32/float32
  */
 
+#ifndef MATLAB_UTILS_H
+#define MATLAB_UTILS_H
+
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+
 #include <holoscan/holoscan.hpp>
 #include <holoscan/utils/cuda_stream_handler.hpp>
 
@@ -86,3 +94,80 @@ void cuda_populate_complex(const float* rdata, const float* idata, void* output,
 nvidia::gxf::Tensor* make_tensor(std::vector<int32_t>& shape, nvidia::gxf::PrimitiveType dtype_gxf,
                                  uint64_t bpp,
                                  nvidia::gxf::Handle<nvidia::gxf::Allocator> allocator);
+
+/**
+ * @brief Reads numel floats from a binary stream into device memory.
+ *
+ * The data is staged through two pinned chunks, so reading the next chunk from disk overlaps the
+ * upload of the previous one. Returns once the upload on cuda_stream has completed.
+ */
+void disk2cuda_fbuffer(std::ifstream& is, float* dbuffer, size_t numel, cudaStream_t cuda_stream);
+
+/**
+ * @brief A ring of device buffers for handing data to a GPU Coder entry point without syncing.
+ *
+ * acquire() makes the stream wait on the event recorded when the slot was last released, so a
+ * buffer is only overwritten once the work reading it has completed on the device. The host
+ * never blocks.
+ */
+class DeviceBufferRing {
+ public:
+  DeviceBufferRing() = default;
+  ~DeviceBufferRing();
+  DeviceBufferRing(const DeviceBufferRing&) = delete;
+  DeviceBufferRing& operator=(const DeviceBufferRing&) = delete;
+
+  void init(size_t bytes, size_t count = 2);
+  void reset();
+  void* acquire(cudaStream_t cuda_stream);
+  void release(cudaStream_t cuda_stream);
+
+ private:
+  struct Slot {
+    void* data = nullptr;
+    cudaEvent_t released = nullptr;
+  };
+  std::vector<Slot> slots_;
+  size_t current_ = 0;
+};
+
+namespace holoscan::ops {
+
+/**
+ * @brief Base class for operators that wrap a MATLAB GPU Coder entry point.
+ *
+ * The entry point reads and writes device pointers bound directly to Holoscan tensors, and all
+ * surrounding work is enqueued on the operator's CUDA stream. GPU Coder libraries launch on the
+ * legacy default stream, which is implicitly ordered with blocking streams, so the stream pool
+ * must create streams with flags 0 (not cudaStreamNonBlocking). No host or device wide
+ * synchronization is then needed between the entry point and the rest of the graph.
+ */
+class MatlabGpuCoderOp : public Operator {
+ public:
+  HOLOSCAN_OPERATOR_FORWARD_ARGS(MatlabGpuCoderOp)
+
+  MatlabGpuCoderOp() = default;
+
+ protected:
+  /// Defines the allocator and CUDA stream parameters shared by GPU Coder operators
+  void define_gpu_coder_params(OperatorSpec& spec);
+
+  /// Returns the operator's CUDA stream, synchronized with the streams of in_message if given
+  cudaStream_t get_cuda_stream(ExecutionContext& context, gxf::Entity* in_message = nullptr);
+
+  /// Adds a device tensor allocated from the allocator parameter and returns its data
+  template <typename T>
+  T* add_output_tensor(nvidia::gxf::Entity& message, const std::string& name,
+                       const std::vector<int32_t>& shape, ExecutionContext& context);
+
+  /// Attaches the operator's CUDA stream to message and emits it
+  void emit_on_stream(nvidia::gxf::Entity& message, OutputContext& op_output,
+                      const char* name = nullptr);
+
+  Parameter<std::shared_ptr<Allocator>> allocator_;
+  CudaStreamHandler cuda_stream_handler_;
+};
+
+}  // namespace holoscan::ops
+
+#endif  // MATLAB_UTILS_H
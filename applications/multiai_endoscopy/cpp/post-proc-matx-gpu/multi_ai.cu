@@ -23,8 +23,8 @@
 #include <holoscan/operators/inference/inference.hpp>
 #include <holoscan/operators/segmentation_postprocessor/segmentation_postprocessor.hpp>
 #include <holoscan/operators/holoviz/holoviz.hpp>
+#include <holoscan/utils/cuda_stream_handler.hpp>
 #include "gxf/std/tensor.hpp"
-#include "matx.h"
 
 #ifdef AJA_SOURCE
 #include <aja_source.hpp>
@@ -83,6 +83,103 @@ void print_tensor(const std::shared_ptr<holoscan::Tensor>& tensor, size_t n_prin
 
 namespace holoscan::ops {
 
+namespace {
+
+// Labels of the detection model, each with its own Holoviz tensors
+constexpr int kMaxLabels = 16;
+constexpr int kThreads = 256;
+
+struct LabelOutputs {
+  float2* rectangles[kMaxLabels];  // [1, 2 * capacity, 2], corners of the boxes
+  float2* labels[kMaxLabels];      // [1, capacity, 2], text positions
+};
+
+__device__ float box_iou(float4 a, float4 b) {
+  const float w = fmaxf(0.f, fminf(a.z, b.z) - fmaxf(a.x, b.x));
+  const float h = fmaxf(0.f, fminf(a.w, b.w) - fmaxf(a.y, b.y));
+  const float intersection = w * h;
+  const float area = (a.z - a.x) * (a.w - a.y) + (b.z - b.x) * (b.w - b.y) - intersection;
+  return area > 0.f ? intersection / area : 0.f;
+}
+
+// Single block: thresholds the scores, runs a greedy NMS per label in score order, and writes
+// the boxes of each label to its fixed-capacity outputs, padded with off-screen boxes
+__global__ void detection_postprocess_kernel(const int* num_detections, const float4* boxes,
+                                             const float* scores, const int* classes,
+                                             int max_boxes, int num_labels, int capacity,
+                                             float scores_threshold, float iou_threshold,
+                                             LabelOutputs outputs, int* counts) {
+  extern __shared__ float4 shared[];
+  float4* box = shared;
+  float* score = reinterpret_cast<float*>(box + max_boxes);
+  int* label = reinterpret_cast<int*>(score + max_boxes);  // -1 when filtered out
+  int* order = label + max_boxes;                           // box by rank of score
+  int* rank = order + max_boxes;
+
+  const int count = min(max(num_detections[0], 0), max_boxes);
+  for (int i = threadIdx.x; i < max_boxes; i += blockDim.x) {
+    const int k = i < count ? classes[i] - 1 : -1;
+    const bool kept = k >= 0 && k < num_labels && scores[i] >= scores_threshold;
+    box[i] = boxes[i];
+    score[i] = scores[i];
+    label[i] = kept ? k : -1;
+  }
+  for (int i = threadIdx.x; i < num_labels * capacity; i += blockDim.x) {
+    const int k = i / capacity;
+    const int slot = i % capacity;
+    outputs.rectangles[k][2 * slot] = make_float2(-1.f, -1.f);
+    outputs.rectangles[k][2 * slot + 1] = make_float2(-1.f, -1.f);
+    outputs.labels[k][slot] = make_float2(-1.f, -1.f);
+  }
+  __syncthreads();
+
+  // Ranks the boxes by descending score, ties by index
+  for (int i = threadIdx.x; i < count; i += blockDim.x) {
+    int r = 0;
+    for (int j = 0; j < count; ++j) {
+      r += (score[j] > score[i]) || (score[j] == score[i] && j < i);
+    }
+    rank[i] = r;
+    order[r] = i;
+  }
+  __syncthreads();
+
+  // A kept box suppresses the lower scored boxes of its label that overlap it
+  if (iou_threshold < 1.f) {
+    for (int r = 0; r < count; ++r) {
+      const int i = order[r];
+      if (label[i] >= 0) {
+        for (int j = threadIdx.x; j < count; j += blockDim.x) {
+          if (rank[j] > r && label[j] == label[i] && box_iou(box[i], box[j]) > iou_threshold) {
+            label[j] = -1;
+          }
+        }
+      }
+      __syncthreads();
+    }
+  }
+
+  // The slot of a box is the number of kept boxes of its label scored above it
+  for (int i = threadIdx.x; i < count; i += blockDim.x) {
+    const int k = label[i];
+    if (k < 0) { continue; }
+    int slot = 0;
+    for (int j = 0; j < count; ++j) { slot += (label[j] == k) && (rank[j] < rank[i]); }
+    if (slot < capacity) {
+      outputs.rectangles[k][2 * slot] = make_float2(box[i].x, box[i].y);
+      outputs.rectangles[k][2 * slot + 1] = make_float2(box[i].z, box[i].w);
+      outputs.labels[k][slot] = make_float2(box[i].x, box[i].y);
+    }
+  }
+  for (int k = threadIdx.x; k < num_labels; k += blockDim.x) {
+    int n = 0;
+    for (int j = 0; j < count; ++j) { n += label[j] == k; }
+    counts[k] = min(n, capacity);
+  }
+}
+
+}  // namespace
+
 // Operator for post-processesing inference output
 class DetectionPostprocessorOp : public Operator {
  public:
@@ -99,131 +196,110 @@ class DetectionPostprocessorOp : public Operator {
       "Scores Threshold",
       "Threshold NMS scores by this value",
       0.3f);
+    spec.param(
+      iou_threshold_,
+      "iou_threshold",
+      "IoU Threshold",
+      "Suppress boxes overlapping a higher scored box of the same label by more than this "
+      "intersection over union, 1 disables the suppression",
+      1.0f);
     spec.param(
       label_names_,
       "label_names",
       "Label Names",
       "List of label names",
       std::vector<std::string>());
+    spec.param(
+      max_boxes_per_label_,
+      "max_boxes_per_label",
+      "Max Boxes Per Label",
+      "Capacity of the output tensors of each label, padded with off-screen boxes",
+      8);
+    spec.param(allocator_, "allocator", "Allocator", "Allocator for the output tensors");
+    cuda_stream_handler_.define_params(spec);
   }
 
   void compute(InputContext& op_input, OutputContext& op_output,
                ExecutionContext& context) override {
     // Get input message and make output message
     auto in_message = op_input.receive<gxf::Entity>("in").value();
-    auto out_message = gxf::Entity::New(&context);
-
-    // Get total number of detections
-    auto Nd = in_message.get<Tensor>("inference_output_num_detections");
-    // Copy to host
-    size_t nbytes = Nd->nbytes();
-    std::vector<int> Ndh(nbytes);
-    CUDA_TRY(cudaMemcpy(Ndh.data(), Nd->data(), nbytes, cudaMemcpyDeviceToHost));
-    // Check if zero detections, in which case we return empty messages
-    if (Ndh[0] == 0) {
-      // Create empty messages for each label
-      for (int k = 0; k < label_names_.get().size(); k++) {
-        // Loop over label name and index
-        auto label = label_names_.get()[k];
-
-        auto boxes_mx = matx::make_tensor<float>({1, 2, 2});
-        auto coords_mx = matx::make_tensor<float>({1, 1, 2});
-        (coords_mx = -1.0).run();
-
-        // MatX to Holoscan tensor
-        auto boxes_hs = std::make_shared<holoscan::Tensor>(boxes_mx.GetDLPackTensor());
-        auto coords_hs = std::make_shared<holoscan::Tensor>(coords_mx.GetDLPackTensor());
-
-        out_message.add(boxes_hs, (label + "_rectangle").c_str());
-        out_message.add(coords_hs, (label + "_label").c_str());
-      }
+    auto out_message = nvidia::gxf::Entity::New(context.context());
 
-      op_output.emit(out_message, "out");
+    // The post-processing runs on the stream of the inference, without host synchronization
+    if (cuda_stream_handler_.from_message(context.context(), in_message) != GXF_SUCCESS) {
+      throw std::runtime_error("Failed to get the CUDA stream from incoming messages");
+    }
+    const cudaStream_t cuda_stream = cuda_stream_handler_.get_cuda_stream(context.context());
 
-      return;
+    const auto& label_names = label_names_.get();
+    const int num_labels = static_cast<int>(label_names.size());
+    const int capacity = max_boxes_per_label_.get();
+    if (num_labels > kMaxLabels) {
+      throw std::runtime_error(fmt::format("At most {} labels are supported", kMaxLabels));
     }
 
-    // Boxes detected, get boxes, scores and labels
+    auto num_detections = in_message.get<Tensor>("inference_output_num_detections");
     auto boxes = in_message.get<Tensor>("inference_output_detection_boxes");
     auto scores = in_message.get<Tensor>("inference_output_detection_scores");
-    auto labels = in_message.get<Tensor>("inference_output_detection_classes");
-    int32_t Nb = scores->shape()[1];  // Number of boxes
-
-    // Holoscan tensors to MatX tensors
-    auto scores_mx = matx::make_tensor<float>((float*)scores->data(), {1, Nb});
-    auto boxes_mx = matx::make_tensor<float>((float*)boxes->data(), {1, Nb, 4});
-    auto labels_mx = matx::make_tensor<int>((int*)labels->data(), {1, Nb});
-
-    // Find box indices with a score larger than threshold
-    auto ix_mx = matx::make_tensor<int>({Nb});
-    auto Ns = matx::make_tensor<int>({});  // Number of boxes above threshold
-    (matx::mtie(ix_mx, Ns) = matx::find_idx(scores_mx, matx::GTE{scores_threshold_.get()})).run();
-    cudaStreamSynchronize(0);
-
-    // Get boxes and labels corresponding to indices
-    auto boxes_ix_mx = matx::make_tensor<float>({1, Ns(), 4});
-    auto labels_ix_mx = matx::make_tensor<int>({1, Ns()});
-    auto ixs_mx = ix_mx.Slice({0}, {Ns()});
-    (boxes_ix_mx = matx::remap<1>(boxes_mx, ixs_mx)).run();
-    (labels_ix_mx = matx::remap<1>(labels_mx, ixs_mx)).run();
-    cudaStreamSynchronize(0);
-
-    // Get x0,y0 coordinates from boxes
-    auto coords_mx = matx::make_tensor<float>({1, Ns(), 2});
-    (coords_mx = boxes_ix_mx.Slice({0, 0, 0}, {matx::matxEnd, matx::matxEnd, 2})).run();
-
-    // Create messages for each label
-    auto Nl = matx::make_tensor<int>({});  // Number of label boxes
-    for (int k = 0; k < label_names_.get().size(); k++) {
-      // Loop over label name and index
-      auto label = label_names_.get()[k];
-
-      // Find boxes equal to label index
-      (matx::mtie(ixs_mx, Nl) = matx::find_idx(labels_ix_mx, matx::EQ{k + 1})).run();
-      cudaStreamSynchronize(0);
-
-      if (Nl() > 0) {
-        // Label has boxes, create output messages
-        auto ixl_mx = ixs_mx.Slice({0}, {Nl()});
-
-        // Get boxes and labels corresponding to indices
-
-        auto boxesl_mx = matx::make_tensor<float>({1, Nl(), 4});
-        auto coordsl_mx = matx::make_tensor<float>({1, Nl(), 2});
-        (boxesl_mx = matx::remap<1>(boxes_ix_mx, ixl_mx)).run();
-        (coordsl_mx = matx::remap<1>(coords_mx, ixl_mx)).run();
-        cudaStreamSynchronize(0);
-
-        // Reshape boxes to Holoviz shape
-        auto boxesls_mx = boxesl_mx.View({1, 2 * Nl(), 2});
-
-        // MatX to Holoscan tensor
-        auto boxes_hs = std::make_shared<holoscan::Tensor>(boxesls_mx.GetDLPackTensor());
-        auto coords_hs = std::make_shared<holoscan::Tensor>(coordsl_mx.GetDLPackTensor());
-        out_message.add(boxes_hs, (label + "_rectangle").c_str());
-        out_message.add(coords_hs, (label + "_label").c_str());
-
-      } else {
-        // Label has no boxes, create empty output messages
-        auto boxesl_mx = matx::make_tensor<float>({1, 2, 2});
-        auto coordsl_mx = matx::make_tensor<float>({1, 1, 2});
-        (coordsl_mx = -1.0).run();
-
-        // MatX to Holoscan tensor
-        auto boxes_hs = std::make_shared<holoscan::Tensor>(boxesl_mx.GetDLPackTensor());
-        auto coords_hs = std::make_shared<holoscan::Tensor>(coordsl_mx.GetDLPackTensor());
-        out_message.add(boxes_hs, (label + "_rectangle").c_str());
-        out_message.add(coords_hs, (label + "_label").c_str());
+    auto classes = in_message.get<Tensor>("inference_output_detection_classes");
+    const int max_boxes = static_cast<int>(scores->shape()[1]);
+
+    auto allocator = nvidia::gxf::Handle<nvidia::gxf::Allocator>::Create(
+        context.context(), allocator_.get()->gxf_cid());
+
+    // Fixed-capacity tensors of each label, from the allocator (e.g. a BlockMemoryPool)
+    const auto add_tensor = [&](const std::string& name, const nvidia::gxf::Shape& shape,
+                                auto element) {
+      auto tensor = out_message.value().add<nvidia::gxf::Tensor>(name.c_str());
+      if (!tensor) { throw std::runtime_error(fmt::format("Failed to add tensor '{}'", name)); }
+      tensor.value()->reshape<decltype(element)>(
+          shape, nvidia::gxf::MemoryStorageType::kDevice, allocator.value());
+      if (!tensor.value()->pointer()) {
+        throw std::runtime_error(fmt::format("Failed to allocate tensor '{}'", name));
       }
+      return tensor.value()->pointer();
+    };
+    LabelOutputs outputs{};
+    for (int k = 0; k < num_labels; k++) {
+      outputs.rectangles[k] = reinterpret_cast<float2*>(
+          add_tensor(label_names[k] + "_rectangle", {1, 2 * capacity, 2}, float{}));
+      outputs.labels[k] = reinterpret_cast<float2*>(
+          add_tensor(label_names[k] + "_label", {1, capacity, 2}, float{}));
+    }
+    auto counts = reinterpret_cast<int*>(add_tensor("detection_counts", {num_labels}, int{}));
+
+    const size_t shared_size = max_boxes * (sizeof(float4) + sizeof(float) + 3 * sizeof(int));
+    detection_postprocess_kernel<<<1, kThreads, shared_size, cuda_stream>>>(
+        static_cast<const int*>(num_detections->data()),
+        static_cast<const float4*>(boxes->data()),
+        static_cast<const float*>(scores->data()),
+        static_cast<const int*>(classes->data()),
+        max_boxes,
+        num_labels,
+        capacity,
+        scores_threshold_.get(),
+        iou_threshold_.get(),
+        outputs,
+        counts);
+    CUDA_TRY(cudaPeekAtLastError());
+
+    // pass the CUDA stream to the output message
+    if (cuda_stream_handler_.to_message(out_message) != GXF_SUCCESS) {
+      throw std::runtime_error("Failed to add the CUDA stream to the outgoing messages");
     }
 
     // Emit output message
-    op_output.emit(out_message, "out");
+    auto result = gxf::Entity(std::move(out_message.value()));
+    op_output.emit(result, "out");
   };
 
  private:
   Parameter<float> scores_threshold_;
+  Parameter<float> iou_threshold_;
   Parameter<std::vector<std::string>> label_names_;
+  Parameter<int32_t> max_boxes_per_label_;
+  Parameter<std::shared_ptr<Allocator>> allocator_;
+  CudaStreamHandler cuda_stream_handler_;
 };
 
 }  // namespace holoscan::ops
@@ -284,9 +360,12 @@ class App : public holoscan::Application {
         "segmentation_postprocessor", from_config("segmentation_postprocessor"),
                                                   Arg("allocator") = pool);
 
-    /* detection postprocessor */
+    /* detection postprocessor, its small output tensors come from a pool */
+    auto detection_pool = make_resource<BlockMemoryPool>(
+        "detection_pool", from_config("detection_pool"), Arg("storage_type") = 1);
     auto detection_postprocessor = make_operator<ops::DetectionPostprocessorOp>(
-        "detection_postprocessor", from_config("detection_postprocessor"), Arg("allocator") = pool);
+        "detection_postprocessor", from_config("detection_postprocessor"),
+        Arg("allocator") = detection_pool);
 
     /* visualizer */
     auto holoviz = make_operator<ops::HolovizOp>(
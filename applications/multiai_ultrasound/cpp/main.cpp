@@ -17,6 +17,11 @@
 
 #include <getopt.h>
 
+#include <algorithm>
+#include <string>
+#include <utility>
+#include <vector>
+
 #include <holoscan/holoscan.hpp>
 #include <holoscan/operators/format_converter/format_converter.hpp>
 #include <holoscan/operators/holoviz/holoviz.hpp>
@@ -31,6 +36,7 @@
 #include <aja_source.hpp>
 #endif
 
+#include <peer_copy.hpp>
 #include <visualizer_icardio.hpp>
 
 #define HOLOSCAN_VERSION \
@@ -112,10 +118,25 @@ class App : public holoscan::Application {
                                                   format_convert_pool_blocks),
                                               Arg("cuda_stream_pool") = cuda_stream_pool);
 
+    // With explicit placement the models listed in `placement.models` run in a second
+    // InferenceOp on `placement.device`, their inputs and results cross GPUs through PeerCopyOp
+    const bool placement = from_config("placement.enabled").as<bool>();
+    std::vector<std::string> placed_models;
+    int32_t placed_device = 0;
+    if (placement) {
+      placed_models = from_config("placement.models").as<std::vector<std::string>>();
+      placed_device = from_config("placement.device").as<int32_t>();
+    }
+    auto is_placed = [&placed_models](const std::string& model) {
+      return std::find(placed_models.begin(), placed_models.end(), model) != placed_models.end();
+    };
+
     ops::InferenceOp::DataMap model_path_map;
-    model_path_map.insert("plax_chamber", datapath + "/plax_chamber.onnx");
-    model_path_map.insert("aortic_stenosis", datapath + "/aortic_stenosis.onnx");
-    model_path_map.insert("bmode_perspective", datapath + "/bmode_perspective.onnx");
+    ops::InferenceOp::DataMap placed_model_path_map;
+    for (const std::string model : {"plax_chamber", "aortic_stenosis", "bmode_perspective"}) {
+      auto& path_map = is_placed(model) ? placed_model_path_map : model_path_map;
+      path_map.insert(model, datapath + "/" + model + ".onnx");
+    }
 
     const auto plax_chamber_output_size = 320 * 320 * sizeof(float) * 6;
     const auto aortic_stenosis_output_size = sizeof(float) * 2;
@@ -134,6 +155,54 @@ class App : public holoscan::Application {
                                             2 * 3),
                                         Arg("cuda_stream_pool") = cuda_stream_pool);
 
+    std::shared_ptr<Operator> placed_inference;
+    std::shared_ptr<Operator> copy_to_placed;
+    std::shared_ptr<Operator> copy_from_placed;
+    if (placement) {
+      const auto report_period = from_config("placement.report_period").as<uint32_t>();
+      // the inference and both copy edges get their own streams, created on the GPU they run on
+      auto placed_stream_pool =
+          make_resource<CudaStreamPool>("placed_cuda_stream", placed_device, 0, 0, 1, 5);
+      placed_inference = make_operator<ops::InferenceOp>(
+          "multiai_inference_placed",
+          from_config("multiai_inference_placed"),
+          Arg("model_path_map", placed_model_path_map),
+          Arg("allocator") =
+              make_resource<BlockMemoryPool>("multiai_inference_placed_allocator",
+                                             (int32_t)nvidia::gxf::MemoryStorageType::kDevice,
+                                             block_size,
+                                             2 * placed_models.size(),
+                                             placed_device),
+          Arg("cuda_stream_pool") = placed_stream_pool);
+
+      // pre-processed inputs, the largest is the aortic stenosis one
+      copy_to_placed = make_operator<ops::PeerCopyOp>(
+          "copy_to_placed",
+          Arg("device_id", placed_device),
+          Arg("report_period", report_period),
+          Arg("allocator") =
+              make_resource<BlockMemoryPool>("copy_to_placed_allocator",
+                                             (int32_t)nvidia::gxf::MemoryStorageType::kDevice,
+                                             300 * 300 * sizeof(float) * 3,
+                                             2 * placed_models.size(),
+                                             placed_device),
+          Arg("cuda_stream_pool") =
+              make_resource<CudaStreamPool>("copy_to_placed_stream", placed_device, 0, 0, 1, 5));
+
+      // results go back to GPU 0 where the post-processor and the visualizer run
+      copy_from_placed = make_operator<ops::PeerCopyOp>(
+          "copy_from_placed",
+          Arg("device_id", 0),
+          Arg("report_period", report_period),
+          Arg("allocator") =
+              make_resource<BlockMemoryPool>("copy_from_placed_allocator",
+                                             (int32_t)nvidia::gxf::MemoryStorageType::kDevice,
+                                             block_size,
+                                             2 * placed_models.size()),
+          Arg("cuda_stream_pool") =
+              make_resource<CudaStreamPool>("copy_from_placed_stream", 0, 0, 0, 1, 5));
+    }
+
     //  version 2.6 supports the CUDA version of `max_per_channel_scaled`
     const bool supports_cuda_processing =
 #if HOLOSCAN_VERSION >= 20600
@@ -201,21 +270,28 @@ class App : public holoscan::Application {
     add_flow(source, b_mode_pers_pre, {{source_port_name, ""}});
     add_flow(source, holoviz, {{source_port_name, "receivers"}});
 
-    add_flow(plax_cham_pre, multiai_inference, {{"", "receivers"}});
-    add_flow(aortic_ste_pre, multiai_inference, {{"", "receivers"}});
-    add_flow(b_mode_pers_pre, multiai_inference, {{"", "receivers"}});
+    const std::vector<std::pair<std::string, std::shared_ptr<Operator>>> preprocessors = {
+        {"plax_chamber", plax_cham_pre},
+        {"aortic_stenosis", aortic_ste_pre},
+        {"bmode_perspective", b_mode_pers_pre}};
+    for (const auto& [model, preprocessor] : preprocessors) {
+      if (is_placed(model)) {
+        add_flow(preprocessor, copy_to_placed, {{"", "receivers"}});
+      } else {
+        add_flow(preprocessor, multiai_inference, {{"", "receivers"}});
+      }
+    }
 
     add_flow(multiai_inference, multiai_postprocessor, {{"transmitter", "receivers"}});
+    if (placement) {
+      add_flow(copy_to_placed, placed_inference, {{"output", "receivers"}});
+      add_flow(placed_inference, copy_from_placed, {{"transmitter", "receivers"}});
+      add_flow(copy_from_placed, multiai_postprocessor, {{"output", "receivers"}});
+    }
     add_flow(multiai_postprocessor, visualizer_icardio, {{"transmitter", "receivers"}});
 
-    add_flow(visualizer_icardio, holoviz, {{"keypoints", "receivers"}});
-    add_flow(visualizer_icardio, holoviz, {{"keyarea_1", "receivers"}});
-    add_flow(visualizer_icardio, holoviz, {{"keyarea_2", "receivers"}});
-    add_flow(visualizer_icardio, holoviz, {{"keyarea_3", "receivers"}});
-    add_flow(visualizer_icardio, holoviz, {{"keyarea_4", "receivers"}});
-    add_flow(visualizer_icardio, holoviz, {{"keyarea_5", "receivers"}});
-    add_flow(visualizer_icardio, holoviz, {{"lines", "receivers"}});
-    add_flow(visualizer_icardio, holoviz, {{"logo", "receivers"}});
+    // all overlay tensors arrive in a single message
+    add_flow(visualizer_icardio, holoviz, {{"overlay", "receivers"}});
 
     if (record_type_ == Record::INPUT) {
       if (is_aja_source_) {
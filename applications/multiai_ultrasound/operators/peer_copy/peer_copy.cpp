@@ -0,0 +1,258 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "peer_copy.hpp"
+
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+#include "holoscan/core/execution_context.hpp"
+#include "holoscan/core/gxf/entity.hpp"
+#include "holoscan/core/io_context.hpp"
+#include "holoscan/core/operator_spec.hpp"
+#include "holoscan/core/resources/gxf/allocator.hpp"
+#include "holoscan/logger/logger.hpp"
+
+#define CUDA_TRY(stmt)                                                                       \
+  {                                                                                          \
+    cudaError_t cuda_status = stmt;                                                          \
+    if (cudaSuccess != cuda_status) {                                                        \
+      HOLOSCAN_LOG_ERROR("CUDA runtime call {} in line {} of file {} failed with '{}' ({})", \
+                         #stmt,                                                              \
+                         __LINE__,                                                           \
+                         __FILE__,                                                           \
+                         cudaGetErrorString(cuda_status),                                    \
+                         int(cuda_status));                                                  \
+      throw std::runtime_error("CUDA runtime call failed");                                  \
+    }                                                                                        \
+  }
+
+namespace holoscan::ops {
+
+namespace {
+
+/// Makes `device` current for the lifetime of the guard
+class DeviceGuard {
+ public:
+  explicit DeviceGuard(int device) {
+    CUDA_TRY(cudaGetDevice(&previous_));
+    if (previous_ != device) { CUDA_TRY(cudaSetDevice(device)); }
+    device_ = device;
+  }
+  ~DeviceGuard() {
+    if (previous_ != device_) { cudaSetDevice(previous_); }
+  }
+
+ private:
+  int previous_ = 0;
+  int device_ = 0;
+};
+
+}  // namespace
+
+void PeerCopyOp::setup(OperatorSpec& spec) {
+  spec.output<gxf::Entity>("output");
+
+  spec.param(receivers_, "receivers", "Receivers", "List of receivers", {});
+  spec.param(device_id_, "device_id", "Device ID", "GPU the tensors are copied to", 0);
+  spec.param(allocator_,
+             "allocator",
+             "Allocator",
+             "Allocator for the copied tensors, it must allocate on `device_id`");
+  spec.param(report_period_,
+             "report_period",
+             "Report Period",
+             "Number of messages between transfer time reports, 0 disables the reports",
+             300u);
+  cuda_stream_handler_.define_params(spec);
+}
+
+void PeerCopyOp::start() {
+  int device_count = 0;
+  CUDA_TRY(cudaGetDeviceCount(&device_count));
+  if (device_id_.get() < 0 || device_id_.get() >= device_count) {
+    throw std::runtime_error(fmt::format(
+        "PeerCopyOp '{}': device {} not available ({} GPUs)", name(), device_id_.get(),
+        device_count));
+  }
+}
+
+void PeerCopyOp::stop() {
+  DeviceGuard guard(device_id_.get());
+  for (auto& transfer : transfers_) {
+    cudaEventSynchronize(transfer.stop);
+    free_events_.push_back(transfer.start);
+    free_events_.push_back(transfer.stop);
+  }
+  transfers_.clear();
+  for (auto event : free_events_) { cudaEventDestroy(event); }
+  free_events_.clear();
+  peers_.clear();
+}
+
+void PeerCopyOp::enable_peer_access(int src_device) {
+  if (!peers_.insert(src_device).second) { return; }
+
+  int can_access = 0;
+  CUDA_TRY(cudaDeviceCanAccessPeer(&can_access, device_id_.get(), src_device));
+  if (!can_access) {
+    HOLOSCAN_LOG_WARN("PeerCopyOp '{}': no peer access from GPU {} to GPU {}, copies are staged "
+                      "through host memory",
+                      name(),
+                      device_id_.get(),
+                      src_device);
+    return;
+  }
+  const cudaError_t err = cudaDeviceEnablePeerAccess(src_device, 0);
+  if (err == cudaErrorPeerAccessAlreadyEnabled) {
+    // enabled by another operator, clear the sticky error state
+    cudaGetLastError();
+  } else if (err != cudaSuccess) {
+    CUDA_TRY(err);
+  }
+  HOLOSCAN_LOG_INFO(
+      "PeerCopyOp '{}': peer copies GPU {} -> GPU {}", name(), src_device, device_id_.get());
+}
+
+cudaEvent_t PeerCopyOp::acquire_event() {
+  if (!free_events_.empty()) {
+    cudaEvent_t event = free_events_.back();
+    free_events_.pop_back();
+    return event;
+  }
+  cudaEvent_t event;
+  CUDA_TRY(cudaEventCreate(&event));
+  return event;
+}
+
+void PeerCopyOp::retire_transfers() {
+  // transfers complete in order on the copy stream, stop at the first one still running
+  while (!transfers_.empty()) {
+    Transfer& transfer = transfers_.front();
+    const cudaError_t status = cudaEventQuery(transfer.stop);
+    if (status == cudaErrorNotReady) { break; }
+    CUDA_TRY(status);
+
+    float ms = 0.f;
+    CUDA_TRY(cudaEventElapsedTime(&ms, transfer.start, transfer.stop));
+    reported_ms_ += ms;
+    reported_bytes_ += transfer.bytes;
+    ++reported_count_;
+
+    free_events_.push_back(transfer.start);
+    free_events_.push_back(transfer.stop);
+    transfers_.pop_front();
+  }
+
+  if (report_period_.get() > 0 && reported_count_ >= report_period_.get()) {
+    const double mean_ms = reported_ms_ / reported_count_;
+    const double gbps = reported_ms_ > 0.0 ? reported_bytes_ / (reported_ms_ * 1e6) : 0.0;
+    HOLOSCAN_LOG_INFO("PeerCopyOp '{}': {} transfers to GPU {}, {} bytes mean, {:.3f} ms mean, "
+                      "{:.2f} GB/s",
+                      name(),
+                      reported_count_,
+                      device_id_.get(),
+                      reported_bytes_ / reported_count_,
+                      mean_ms,
+                      gbps);
+    reported_count_ = 0;
+    reported_bytes_ = 0;
+    reported_ms_ = 0.0;
+  }
+}
+
+void PeerCopyOp::compute(InputContext& op_input, OutputContext& op_output,
+                         ExecutionContext& context) {
+  auto in_messages = op_input.receive<std::vector<gxf::Entity>>("receivers").value();
+
+  const int device = device_id_.get();
+  DeviceGuard guard(device);
+
+  std::vector<nvidia::gxf::Entity> messages(in_messages.begin(), in_messages.end());
+  // the copy stream waits for the producers of all inputs
+  if (cuda_stream_handler_.from_messages(context.context(), messages) != GXF_SUCCESS) {
+    throw std::runtime_error("Failed to get the CUDA stream from incoming messages");
+  }
+  const cudaStream_t stream = cuda_stream_handler_.get_cuda_stream(context.context());
+
+  retire_transfers();
+
+  auto allocator =
+      nvidia::gxf::Handle<nvidia::gxf::Allocator>::Create(context.context(), allocator_->gxf_cid());
+  auto out_message = nvidia::gxf::Entity::New(context.context());
+  if (!out_message) { throw std::runtime_error("Failed to allocate the output message"); }
+
+  Transfer transfer;
+  transfer.start = acquire_event();
+  transfer.stop = acquire_event();
+  CUDA_TRY(cudaEventRecord(transfer.start, stream));
+
+  for (auto& message : messages) {
+    auto tensors = message.findAll<nvidia::gxf::Tensor>();
+    if (!tensors) { throw std::runtime_error("Failed to enumerate the input tensors"); }
+    for (auto& maybe_tensor : tensors.value()) {
+      if (!maybe_tensor) { continue; }
+      const auto& in_tensor = maybe_tensor.value();
+
+      // keep the layout of the source so the buffer is copied as a single span
+      nvidia::gxf::Tensor::stride_array_t strides{};
+      for (uint32_t i = 0; i < in_tensor->rank(); ++i) { strides[i] = in_tensor->stride(i); }
+
+      auto out_tensor = out_message.value().add<nvidia::gxf::Tensor>(in_tensor.name());
+      if (!out_tensor) { throw std::runtime_error("Failed to add the output tensor"); }
+      if (!out_tensor.value()->reshapeCustom(in_tensor->shape(),
+                                             in_tensor->element_type(),
+                                             in_tensor->bytes_per_element(),
+                                             strides,
+                                             nvidia::gxf::MemoryStorageType::kDevice,
+                                             allocator.value())) {
+        throw std::runtime_error(
+            fmt::format("Failed to allocate tensor '{}' on GPU {}", in_tensor.name(), device));
+      }
+
+      const void* src = in_tensor->pointer();
+      void* dst = out_tensor.value()->pointer();
+      const size_t size = in_tensor->size();
+      if (in_tensor->storage_type() == nvidia::gxf::MemoryStorageType::kDevice) {
+        cudaPointerAttributes attributes;
+        CUDA_TRY(cudaPointerGetAttributes(&attributes, src));
+        if (attributes.device == device) {
+          CUDA_TRY(cudaMemcpyAsync(dst, src, size, cudaMemcpyDeviceToDevice, stream));
+        } else {
+          enable_peer_access(attributes.device);
+          CUDA_TRY(cudaMemcpyPeerAsync(dst, device, src, attributes.device, size, stream));
+        }
+      } else {
+        CUDA_TRY(cudaMemcpyAsync(dst, src, size, cudaMemcpyHostToDevice, stream));
+      }
+      transfer.bytes += size;
+    }
+  }
+
+  CUDA_TRY(cudaEventRecord(transfer.stop, stream));
+  // the source buffers must stay valid until the copies are done
+  transfer.inputs = std::move(in_messages);
+  transfers_.push_back(std::move(transfer));
+
+  nvidia::gxf::Expected<nvidia::gxf::Entity> out(out_message.value());
+  cuda_stream_handler_.to_message(out);
+  auto result = gxf::Entity(std::move(out_message.value()));
+  op_output.emit(result, "output");
+}
+
+}  // namespace holoscan::ops
@@ -0,0 +1,88 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef HOLOSCAN_OPERATORS_PEER_COPY_HPP
+#define HOLOSCAN_OPERATORS_PEER_COPY_HPP
+
+#include <cuda_runtime.h>
+
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "holoscan/core/gxf/gxf_operator.hpp"
+#include "holoscan/utils/cuda_stream_handler.hpp"
+
+namespace holoscan::ops {
+/**
+ * @brief Copy all tensors of the received messages to another GPU.
+ *
+ * Marks an explicit inter-GPU edge of the graph. The tensors are copied with
+ * `cudaMemcpyPeerAsync` on a stream of the `cuda_stream_pool`, which is expected to be created on
+ * `device_id`, so the copy is ordered after the producer through the stream handler events and
+ * never blocks the host. Peer access is enabled once per source GPU when the topology allows it;
+ * otherwise the driver stages the copy through host memory.
+ *
+ * The mean transfer time and bandwidth of the edge are logged every `report_period` messages.
+ */
+class PeerCopyOp : public holoscan::Operator {
+ public:
+  HOLOSCAN_OPERATOR_FORWARD_ARGS(PeerCopyOp)
+
+  PeerCopyOp() = default;
+
+  void setup(OperatorSpec& spec) override;
+  void start() override;
+  void stop() override;
+  void compute(InputContext& op_input, OutputContext& op_output,
+               ExecutionContext& context) override;
+
+ private:
+  /// A copy in flight; the inputs are held until its stop event completes
+  struct Transfer {
+    std::vector<gxf::Entity> inputs;
+    cudaEvent_t start = nullptr;
+    cudaEvent_t stop = nullptr;
+    uint64_t bytes = 0;
+  };
+
+  void enable_peer_access(int src_device);
+  cudaEvent_t acquire_event();
+  void retire_transfers();
+
+  Parameter<std::vector<IOSpec*>> receivers_;
+  Parameter<int32_t> device_id_;
+  Parameter<std::shared_ptr<Allocator>> allocator_;
+  Parameter<uint32_t> report_period_;
+
+  CudaStreamHandler cuda_stream_handler_;
+
+  std::deque<Transfer> transfers_;
+  std::vector<cudaEvent_t> free_events_;
+  std::set<int> peers_;
+
+  uint32_t reported_count_ = 0;
+  uint64_t reported_bytes_ = 0;
+  double reported_ms_ = 0.0;
+};
+
+}  // namespace holoscan::ops
+
+#endif /* HOLOSCAN_OPERATORS_PEER_COPY_HPP */
@@ -65,7 +65,6 @@ class PyVisualizerICardioOp : public VisualizerICardioOp {
                         std::string data_dir = "../data/multiai_ultrasound",
                         std::shared_ptr<holoscan::CudaStreamPool> cuda_stream_pool = nullptr,
                         // TODO(grelee): handle receivers similarly to HolovizOp?  (default: {})
-                        // TODO(grelee): handle transmitter similarly to HolovizOp?
                         const std::string& name = "visualizer_icardio")
       : VisualizerICardioOp(ArgList{Arg{"allocator", allocator},
                                     Arg{"in_tensor_names", in_tensor_names},
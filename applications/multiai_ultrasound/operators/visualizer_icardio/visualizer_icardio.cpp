@@ -15,6 +15,7 @@
  * limitations under the License.
  */
 
+#include <algorithm>
 #include <functional>
 #include <utility>
 
@@ -34,14 +35,7 @@
 namespace holoscan::ops {
 
 void VisualizerICardioOp::setup(OperatorSpec& spec) {
-  auto& out_tensor_1 = spec.output<gxf::Entity>("keypoints");
-  auto& out_tensor_2 = spec.output<gxf::Entity>("keyarea_1");
-  auto& out_tensor_3 = spec.output<gxf::Entity>("keyarea_2");
-  auto& out_tensor_4 = spec.output<gxf::Entity>("keyarea_3");
-  auto& out_tensor_5 = spec.output<gxf::Entity>("keyarea_4");
-  auto& out_tensor_6 = spec.output<gxf::Entity>("keyarea_5");
-  auto& out_tensor_7 = spec.output<gxf::Entity>("lines");
-  auto& out_tensor_8 = spec.output<gxf::Entity>("logo");
+  spec.output<gxf::Entity>("overlay");
 
   spec.param(
       in_tensor_names_, "in_tensor_names", "Input Tensors", "Input tensors", {std::string("")});
@@ -55,18 +49,6 @@ void VisualizerICardioOp::setup(OperatorSpec& spec) {
   spec.param(input_on_cuda_, "input_on_cuda", "Input buffer on CUDA", "", true);
   spec.param(allocator_, "allocator", "Allocator", "Output Allocator");
   spec.param(receivers_, "receivers", "Receivers", "List of receivers", {});
-  spec.param(transmitters_,
-             "transmitters",
-             "Transmitters",
-             "List of transmitters",
-             {&out_tensor_1,
-              &out_tensor_2,
-              &out_tensor_3,
-              &out_tensor_4,
-              &out_tensor_5,
-              &out_tensor_6,
-              &out_tensor_7,
-              &out_tensor_8});
   cuda_stream_handler_.define_params(spec);
 }
 
@@ -144,72 +126,109 @@ void VisualizerICardioOp::compute(InputContext& op_input, OutputContext& op_outp
     auto coords = static_cast<float*>(data_per_tensor.at(pc_tensor_name_)->device_buffer->data());
     auto datasize = tensor_size_map_[pc_tensor_name_];
 
-    if (transmitters_.get().size() > 0) {
-      for (unsigned int a = 0; a < transmitters_.get().size(); ++a) {
-        auto out_message = nvidia::gxf::Entity::New(context.context());
-        if (!out_message) { HoloInfer::raise_error(module_, "Tick, Out message allocation"); }
-        std::string current_tensor_name{out_tensor_names_.get()[a]};
-        auto out_tensor = out_message.value().add<nvidia::gxf::Tensor>(current_tensor_name.c_str());
-        if (!out_tensor) { HoloInfer::raise_error(module_, "Tick, Out tensor allocation"); }
-        if (tensor_to_shape_.find(current_tensor_name) == tensor_to_shape_.end()) {
-          HoloInfer::raise_error(
-              module_, "Tick, Output Tensor shape mapping not found for " + current_tensor_name);
+    // Place every overlay tensor in one packed geometry buffer, generated by a single kernel
+    OverlayLayout layout;
+    std::vector<std::pair<std::string, nvidia::gxf::Shape>> views;
+    bool has_logo = false;
+    int geometry_size = 0;
+    for (const auto& current_tensor_name : out_tensor_names_.get()) {
+      if (tensor_to_shape_.find(current_tensor_name) == tensor_to_shape_.end()) {
+        HoloInfer::raise_error(
+            module_, "Tick, Output Tensor shape mapping not found for " + current_tensor_name);
+      }
+      if (current_tensor_name.compare("logo") == 0) {
+        has_logo = true;
+        continue;
+      }
+      if (layout.num_entries == OverlayLayout::kMaxEntries) {
+        HoloInfer::raise_error(module_, "Tick, too many overlay tensors");
+      }
+      std::vector<int> shape_dim = tensor_to_shape_.at(current_tensor_name);
+      int property_size = shape_dim[2];
+      const int entry = layout.num_entries++;
+
+      if (property_size <= 3) {
+        layout.src_index[entry] = 1;
+        layout.count[entry] =
+            std::min(static_cast<int>(datasize[datasize.size() - 1] / 2) - 1, shape_dim[1]);
+      } else {
+        if (tensor_to_index_.find(current_tensor_name) == tensor_to_index_.end()) {
+          HoloInfer::raise_error(module_, "Tick, tensor to index mapping failed");
         }
-        std::vector<int> shape_dim = tensor_to_shape_.at(current_tensor_name);
-        nvidia::gxf::Shape output_shape{shape_dim[0], shape_dim[1], shape_dim[2]};
-
-        if (current_tensor_name.compare("logo") == 0) {
-          nvidia::gxf::Shape shape{shape_dim[0], shape_dim[1], shape_dim[2]};
-          auto type = nvidia::gxf::PrimitiveType::kUnsigned8;
-          auto bytes_per_element = nvidia::gxf::PrimitiveTypeSize(type);
-          auto strides = nvidia::gxf::ComputeTrivialStrides(shape, bytes_per_element);
-          if (!out_tensor.value()->wrapMemory(shape,
-                                              type,
-                                              bytes_per_element,
-                                              strides,
-                                              nvidia::gxf::MemoryStorageType::kDevice,
-                                              logo_image_,
-                                              nullptr)) {
-            HoloInfer::raise_error(module_, "Tick, wrap logo memory.");
-          }
-        } else {
-          out_tensor.value()->reshape<float>(
-              output_shape, nvidia::gxf::MemoryStorageType::kDevice, allocator.value());
-          if (!out_tensor.value()->pointer()) {
-            HoloInfer::raise_error(module_, "Tick, Out tensor buffer allocation");
-          }
-          nvidia::gxf::Expected<float*> out_tensor_data = out_tensor.value()->data<float>();
-          if (!out_tensor_data) {
-            HoloInfer::raise_error(module_, "Tick, Getting out tensor data");
-          }
-          float* out_tensor_buffer = out_tensor_data.value();
-
-          int property_size = shape_dim[2];
-
-          if (property_size <= 3) {
-            gen_coords(1,
-                       (datasize[datasize.size() - 1] / 2) - 1,
-                       property_size,
-                       coords,
-                       out_tensor_buffer,
-                       cuda_stream);
-          } else {
-            if (tensor_to_index_.find(current_tensor_name) == tensor_to_index_.end()) {
-              HoloInfer::raise_error(module_, "Tick, tensor to index mapping failed");
-            }
-            int index_coord = tensor_to_index_.at(current_tensor_name);
-            if (index_coord >= 1 && index_coord <= 5) {
-              gen_coords(index_coord, 1, property_size, coords, out_tensor_buffer, cuda_stream);
-            } else {
-              HoloInfer::raise_error(module_, "Tick, invalid coordinate from tensor");
-            }
-          }
+        int index_coord = tensor_to_index_.at(current_tensor_name);
+        if (index_coord < 1 || index_coord > 5) {
+          HoloInfer::raise_error(module_, "Tick, invalid coordinate from tensor");
         }
-        cuda_stream_handler_.to_message(out_message);
-        auto result = gxf::Entity(std::move(out_message.value()));
-        op_output.emit(result, current_tensor_name.c_str());
+        layout.src_index[entry] = index_coord;
+        layout.count[entry] = 1;
       }
+      layout.offset[entry] = geometry_size;
+      layout.property_size[entry] = property_size;
+      geometry_size += shape_dim[0] * shape_dim[1] * property_size;
+      views.emplace_back(current_tensor_name,
+                         nvidia::gxf::Shape{shape_dim[0], shape_dim[1], shape_dim[2]});
     }
+
+    auto out_message = nvidia::gxf::Entity::New(context.context());
+    if (!out_message) { HoloInfer::raise_error(module_, "Tick, Out message allocation"); }
+
+    if (geometry_size > 0) {
+      // The views share one allocation, returned to the allocator when the last view is released
+      auto allocator_resource = allocator_.get();
+      nvidia::byte* geometry_ptr = allocator_resource->allocate(
+          geometry_size * sizeof(float), holoscan::MemoryStorageType::kDevice);
+      if (!geometry_ptr) { HoloInfer::raise_error(module_, "Tick, Out tensor buffer allocation"); }
+      std::shared_ptr<nvidia::byte> geometry(
+          geometry_ptr, [allocator_resource](nvidia::byte* ptr) { allocator_resource->free(ptr); });
+      float* geometry_data = reinterpret_cast<float*>(geometry_ptr);
+
+      gen_overlay(layout, coords, geometry_data, cuda_stream);
+
+      auto type = nvidia::gxf::PrimitiveType::kFloat32;
+      auto bytes_per_element = nvidia::gxf::PrimitiveTypeSize(type);
+      for (size_t i = 0; i < views.size(); ++i) {
+        auto out_tensor = out_message.value().add<nvidia::gxf::Tensor>(views[i].first.c_str());
+        if (!out_tensor) { HoloInfer::raise_error(module_, "Tick, Out tensor allocation"); }
+        const auto& shape = views[i].second;
+        if (!out_tensor.value()->wrapMemory(
+                shape,
+                type,
+                bytes_per_element,
+                nvidia::gxf::ComputeTrivialStrides(shape, bytes_per_element),
+                nvidia::gxf::MemoryStorageType::kDevice,
+                geometry_data + layout.offset[i],
+                [geometry](void*) mutable {
+                  geometry.reset();
+                  return nvidia::gxf::Success;
+                })) {
+          HoloInfer::raise_error(module_, "Tick, wrap overlay memory.");
+        }
+      }
+    }
+
+    if (has_logo) {
+      // The logo was uploaded once in start() and is passed by reference every frame
+      std::vector<int> shape_dim = tensor_to_shape_.at("logo");
+      nvidia::gxf::Shape shape{shape_dim[0], shape_dim[1], shape_dim[2]};
+      auto type = nvidia::gxf::PrimitiveType::kUnsigned8;
+      auto bytes_per_element = nvidia::gxf::PrimitiveTypeSize(type);
+      auto strides = nvidia::gxf::ComputeTrivialStrides(shape, bytes_per_element);
+      auto out_tensor = out_message.value().add<nvidia::gxf::Tensor>("logo");
+      if (!out_tensor) { HoloInfer::raise_error(module_, "Tick, Out tensor allocation"); }
+      if (!out_tensor.value()->wrapMemory(shape,
+                                          type,
+                                          bytes_per_element,
+                                          strides,
+                                          nvidia::gxf::MemoryStorageType::kDevice,
+                                          logo_image_,
+                                          nullptr)) {
+        HoloInfer::raise_error(module_, "Tick, wrap logo memory.");
+      }
+    }
+
+    cuda_stream_handler_.to_message(out_message);
+    auto result = gxf::Entity(std::move(out_message.value()));
+    op_output.emit(result, "overlay");
   } catch (const std::runtime_error& r_) {
     HoloInfer::raise_error(module_, "Tick, Message->" + std::string(r_.what()));
   } catch (...) { HoloInfer::raise_error(module_, "Tick, unknown exception"); }
@@ -19,30 +19,36 @@
 
 namespace holoscan::ops {
 
-__global__ void gen_coords_kernel(unsigned int count, int property_size, const float* input,
-                                  float* output) {
-  const uint32_t index = blockIdx.x * blockDim.x + threadIdx.x;
+// One thread per (overlay tensor, point); all tensors are written into one packed buffer
+__global__ void gen_overlay_kernel(OverlayLayout layout, const float* input, float* output) {
+  const int point = threadIdx.x;
+  const int entry = threadIdx.y;
 
-  if (index >= count) { return; }
+  if (entry >= layout.num_entries || point >= layout.count[entry]) { return; }
 
-  output[index * property_size + 0] = input[index * 2 + 1];
-  output[index * property_size + 1] = input[index * 2 + 0];
+  const int property_size = layout.property_size[entry];
+  const float* src = input + 2 * (layout.src_index[entry] + point);
+  float* dst = output + layout.offset[entry] + point * property_size;
+
+  dst[0] = src[1];
+  dst[1] = src[0];
   if (property_size == 3) {
     // keypoint
-    output[index * property_size + 2] = 0.01f;
+    dst[2] = 0.01f;
   } else if (property_size == 4) {
     // key area
-    output[index * property_size + 2] = 0.04f;
-    output[index * property_size + 3] = 0.02f;
+    dst[2] = 0.04f;
+    dst[3] = 0.02f;
   }
 }
 
-void gen_coords(unsigned int offset, unsigned int count, int property_size, const float* input,
-                float* output, cudaStream_t stream) {
-  dim3 block(8, 1, 1);
-  dim3 grid((count + block.x - 1) / block.x, 1, 1);
+void gen_overlay(const OverlayLayout& layout, const float* input, float* output,
+                 cudaStream_t stream) {
+  int max_count = 1;
+  for (int i = 0; i < layout.num_entries; ++i) { max_count = std::max(max_count, layout.count[i]); }
+  dim3 block(max_count, layout.num_entries, 1);
 
-  gen_coords_kernel<<<grid, block, 0, stream>>>(count, property_size, input + 2 * offset, output);
+  gen_overlay_kernel<<<1, block, 0, stream>>>(layout, input, output);
   CUDA_TRY(cudaPeekAtLastError());
 }
 
@@ -20,6 +20,7 @@
 
 #include <cuda.h>
 
+#include <algorithm>
 #include <stdexcept>
 
 #include <holoscan/logger/logger.hpp>
@@ -40,8 +41,26 @@
 
 namespace holoscan::ops {
 
-void gen_coords(unsigned int offset, unsigned int count, int property_size, const float* input,
-                float* output, cudaStream_t stream);
+/**
+ * @brief Placement of the overlay tensors in the packed geometry buffer.
+ *
+ * Entry i takes count[i] coordinate pairs of the input starting at pair src_index[i] and writes
+ * them with property_size[i] floats per point at offset[i] floats into the buffer.
+ */
+struct OverlayLayout {
+  static constexpr int kMaxEntries = 8;
+  int num_entries = 0;
+  int offset[kMaxEntries];
+  int property_size[kMaxEntries];
+  int src_index[kMaxEntries];
+  int count[kMaxEntries];
+};
+
+/**
+ * @brief Generates the geometry of all overlay tensors in a single kernel launch.
+ */
+void gen_overlay(const OverlayLayout& layout, const float* input, float* output,
+                 cudaStream_t stream);
 
 }  // namespace holoscan::ops
 
@@ -55,7 +55,6 @@ class VisualizerICardioOp : public holoscan::Operator {
   Parameter<std::vector<std::string>> out_tensor_names_;
   Parameter<std::shared_ptr<Allocator>> allocator_;
   Parameter<std::vector<IOSpec*>> receivers_;
-  Parameter<std::vector<IOSpec*>> transmitters_;
   Parameter<std::string> data_dir_;
   Parameter<bool> input_on_cuda_;
 
@@ -253,19 +253,8 @@ class MultiAIICardio(Application):
         # prepare postprocessed output for visualization with holoviz
         self.add_flow(multiai_postprocessor, visualizer_icardio, {("transmitter", "receivers")})
 
-        # connect the overlays to holoviz
-        visualizer_inputs = (
-            "keypoints",
-            "keyarea_1",
-            "keyarea_2",
-            "keyarea_3",
-            "keyarea_4",
-            "keyarea_5",
-            "lines",
-            "logo",
-        )
-        for src in visualizer_inputs:
-            self.add_flow(visualizer_icardio, holoviz, {(src, "receivers")})
+        # connect the overlays to holoviz, all overlay tensors arrive in a single message
+        self.add_flow(visualizer_icardio, holoviz, {("overlay", "receivers")})
 
         # Flow for the recorder
         if record_type == "input":
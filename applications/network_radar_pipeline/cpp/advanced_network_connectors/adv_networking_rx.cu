@@ -16,6 +16,8 @@
  */
 #include "adv_networking_rx.h"  // TODO: Rename networking connectors
 
+#include <numeric>
+
 #if SPOOF_PACKET_DATA
 /**
  * This function converts the packet count to packet metadata. We just treat the
@@ -41,7 +43,9 @@ __device__ __forceinline__ void gen_meta_from_pkt_cnt(RfMetaData* meta, const ui
 #endif
 
 __global__ void place_packet_data_kernel(complex_t* out, const void* const* const __restrict__ in,
-                                         int* sample_cnt, bool* received_end,
+                                         ArrayState* state, uint32_t* ring,
+                                         unsigned int* ring_tail, const uint32_t ring_size,
+                                         const uint32_t samples_per_arr,
                                          const size_t buffer_pos, const uint16_t pkt_len,
                                          const uint16_t buffer_size, const uint16_t num_channels,
                                          const uint16_t num_pulses, const uint16_t num_samples,
@@ -75,7 +79,6 @@ __global__ void place_packet_data_kernel(complex_t* out, const void* const* cons
   if (meta->waveform_id >= buffer_pos + buffer_size || meta->waveform_id < buffer_pos) { return; }
 
   const uint16_t buffer_idx = meta->waveform_id % buffer_size;
-  if (meta->end_array && threadIdx.x == 0) { received_end[buffer_idx] = true; }
 
   // Compute pointer in buffer memory
   const uint32_t idx_offset = meta->sample_idx + meta->pulse_idx * num_samples +
@@ -86,33 +89,47 @@ __global__ void place_packet_data_kernel(complex_t* out, const void* const* cons
     out[idx_offset + i] = samples[i];
   }
 
+  // Count the samples once the whole block placed them. The block completing the array, or
+  // placing its End-of-Array (EOA) packet, publishes it to the host, one time.
+  __syncthreads();
   if (threadIdx.x == 0) {
-    // todo Smarter way than atomicAdd
-    atomicAdd(&sample_cnt[buffer_idx], meta->pkt_samples);
+    ArrayState* array = &state[buffer_idx];
+    __threadfence();
+    const int placed = atomicAdd(&array->sample_cnt, meta->pkt_samples) + meta->pkt_samples;
+    const bool complete = meta->end_array || placed >= static_cast<int>(samples_per_arr);
+    if (complete && atomicExch(&array->published, 1) == 0) {
+      ring[atomicAdd(ring_tail, 1) % ring_size] = meta->waveform_id;
+      __threadfence_system();
+    }
   }
 }
 
-void place_packet_data(complex_t* out, const void* const* const in, int* sample_cnt,
-                       bool* received_end, const size_t buffer_pos, const uint16_t pkt_len,
+void place_packet_data(complex_t* out, const void* const* const in, ArrayState* state,
+                       uint32_t* ring, unsigned int* ring_tail, const uint32_t ring_size,
+                       const uint32_t samples_per_arr, const size_t buffer_pos,
+                       const uint16_t pkt_len,
                        const uint32_t num_pkts, const uint16_t buffer_size,
                        const uint16_t num_channels, const uint16_t num_pulses,
                        const uint16_t num_samples, const uint64_t total_pkts,
                        const uint16_t pkts_per_pulse, const uint16_t max_waveform_id,
                        cudaStream_t stream) {
   // Each thread processes an individual packet
-  place_packet_data_kernel<<<num_pkts, 128, buffer_size * sizeof(int), stream>>>(out,
-                                                                                 in,
-                                                                                 sample_cnt,
-                                                                                 received_end,
-                                                                                 buffer_pos,
-                                                                                 pkt_len,
-                                                                                 buffer_size,
-                                                                                 num_channels,
-                                                                                 num_pulses,
-                                                                                 num_samples,
-                                                                                 total_pkts,
-                                                                                 pkts_per_pulse,
-                                                                                 max_waveform_id);
+  place_packet_data_kernel<<<num_pkts, 128, 0, stream>>>(out,
+                                                         in,
+                                                         state,
+                                                         ring,
+                                                         ring_tail,
+                                                         ring_size,
+                                                         samples_per_arr,
+                                                         buffer_pos,
+                                                         pkt_len,
+                                                         buffer_size,
+                                                         num_channels,
+                                                         num_pulses,
+                                                         num_samples,
+                                                         total_pkts,
+                                                         pkts_per_pulse,
+                                                         max_waveform_id);
 }
 
 using namespace holoscan::advanced_network;
@@ -161,10 +178,18 @@ void AdvConnectorOpRx::setup(OperatorSpec& spec) {
                           "interface_name",
                           "Port name",
                           "Name of the port to poll on from the advanced_network config");
+  spec.param<bool>(event_driven_,
+                   "event_driven",
+                   "Event-driven RX",
+                   "Run only when the manager signals ready bursts instead of polling the queues",
+                   false);
 }
 
 void AdvConnectorOpRx::initialize() {
   HOLOSCAN_LOG_INFO("AdvConnectorOpRx::initialize()");
+  // Only waits for bursts once watched, when event_driven is set
+  rx_condition_ = fragment()->make_condition<AdvNetworkRxCondition>(name() + "_rx_ready");
+  add_arg(rx_condition_);
   holoscan::Operator::initialize();
 
   port_id_ = get_port_id(interface_name_.get());
@@ -187,20 +212,23 @@ void AdvConnectorOpRx::initialize() {
     exit(1);
   }
 
+  buffer_track = AdvBufferTracking(buffer_size_.get());
+  make_tensor(rf_data,
+              {buffer_size_.get(), num_channels_.get(), num_pulses_.get(), num_samples_.get()});
+
   // Allocate memory and create CUDA streams for each concurrent batch
   for (int n = 0; n < num_concurrent; n++) {
     if (gpu_direct_.get()) {
       cudaMallocHost((void**)&h_dev_ptrs_[n], sizeof(void*) * batch_size_.get() * 2);
     }
 
-    buffer_track = AdvBufferTracking(buffer_size_.get());
-    make_tensor(rf_data,
-                {buffer_size_.get(), num_channels_.get(), num_pulses_.get(), num_samples_.get()});
-
     cudaStreamCreateWithFlags(&streams_[n], cudaStreamNonBlocking);
     cudaEventCreate(&events_[n]);
     // Warmup
     place_packet_data(nullptr,
+                        nullptr,
+                        nullptr,
+                        nullptr,
                         nullptr,
                         0,
                         0,
@@ -261,18 +289,27 @@ std::vector<AdvConnectorOpRx::RxMsg> AdvConnectorOpRx::free_bufs() {
 }
 
 void AdvConnectorOpRx::free_bufs_and_emit_arrays(OutputContext& op_output) {
-  std::vector<AdvConnectorOpRx::RxMsg> completed_msgs = free_bufs();
-  if (completed_msgs.empty()) { return; }
-  cudaStream_t stream = completed_msgs[0].stream;
+  free_bufs();
+  emit_completed_arrays(op_output);
+}
 
-  buffer_track.transfer(cudaMemcpyDeviceToHost, stream);
-  cudaStreamSynchronize(stream);
+void AdvConnectorOpRx::emit_completed_arrays(OutputContext& op_output) {
+  bool waited = false;
+  uint32_t waveform_id;
 
-  for (size_t i = 0; i < buffer_track.buffer_size; i++) {
-    const size_t pos_wrap = (buffer_track.pos + i) % buffer_track.buffer_size;
-    if (!buffer_track.received_end_h[pos_wrap]) { continue; }
+  // Completed arrays are published by place_packet_data_kernel, polling costs no synchronization
+  while (buffer_track.pop_completed(&waveform_id)) {
+    // Arrays behind the tracker were already skipped, their state was cleared
+    if (waveform_id < buffer_track.pos) { continue; }
 
-    // Received End-of-Array (EOA) message, emit to downstream operators
+    // Processing waits on the GPU for the batches in flight, which may still place samples
+    if (!waited) {
+      for (auto& evt : events_) { cudaStreamWaitEvent(proc_stream, evt, 0); }
+      waited = true;
+    }
+
+    // Received a complete array or its End-of-Array (EOA), emit to downstream operators
+    const size_t pos_wrap = waveform_id % buffer_track.buffer_size;
     auto params =
         std::make_shared<RFArray>(rf_data.Slice<3>({static_cast<index_t>(pos_wrap), 0, 0, 0},
                                                    {matxDropDim, matxEnd, matxEnd, matxEnd}),
@@ -280,22 +317,13 @@ void AdvConnectorOpRx::free_bufs_and_emit_arrays(OutputContext& op_output) {
                                   proc_stream);
 
     op_output.emit(params, "rf_out");
-    HOLOSCAN_LOG_INFO("Emitting {} with {}/{} samples",
-                      buffer_track.pos + i,
-                      buffer_track.sample_cnt_h[pos_wrap],
-                      samples_per_arr);
+    HOLOSCAN_LOG_DEBUG("Emitting {}", waveform_id);
 
-    // Increment the tracker 'i' number of times. This allows us to not get hung on arrays
+    // Increment the tracker up to this array. This allows us to not get hung on arrays
     // where the EOA was either dropped or missed. Ex: if the EOA for array 11 was dropped,
     // we will emit array 12 when its EOA arrives, incrementing from 10 -> 12.
-    for (size_t j = 0; j <= i; j++) {
-      buffer_track.increment();
-      HOLOSCAN_LOG_INFO("Next waveform expected: {}", buffer_track.pos);
-    }
-
-    buffer_track.transfer(cudaMemcpyHostToDevice, stream);
-    cudaStreamSynchronize(stream);
-    break;
+    while (buffer_track.pos <= waveform_id) { buffer_track.increment(streams_[cur_idx]); }
+    HOLOSCAN_LOG_DEBUG("Next waveform expected: {}", buffer_track.pos);
   }
 }
 
@@ -330,15 +358,16 @@ void AdvConnectorOpRx::compute(InputContext& op_input, OutputContext& op_output,
     // entire burst buffer pointer is saved and freed once an entire batch is received.
     if (gpu_direct_.get()) {
       if (split_boundary_.get()) {
+        get_packet_ptrs(burst, 1, &h_dev_ptrs_[cur_idx][aggr_pkts_recv_]);
         for (int p = 0; p < get_num_packets(burst); p++) {
-          h_dev_ptrs_[cur_idx][aggr_pkts_recv_ + p] = get_segment_packet_ptr(burst, 1, p);
           ttl_bytes_in_cur_batch_ +=
               get_segment_packet_length(burst, 0, p) + get_segment_packet_length(burst, 1, p);
         }
       } else {
+        void** dev_ptrs = &h_dev_ptrs_[cur_idx][aggr_pkts_recv_];
+        get_packet_ptrs(burst, 0, dev_ptrs);
         for (int p = 0; p < get_num_packets(burst); p++) {
-          h_dev_ptrs_[cur_idx][aggr_pkts_recv_ + p] =
-              reinterpret_cast<uint8_t*>(get_packet_ptr(burst, p)) + PADDED_HDR_SIZE;
+          dev_ptrs[p] = reinterpret_cast<uint8_t*>(dev_ptrs[p]) + PADDED_HDR_SIZE;
           ttl_bytes_in_cur_batch_ += get_burst_tot_byte(burst);
         }
       }
@@ -347,7 +376,7 @@ void AdvConnectorOpRx::compute(InputContext& op_input, OutputContext& op_output,
 
     aggr_pkts_recv_ += get_num_packets(burst);
 
-    HOLOSCAN_LOG_INFO("aggr_pkts_recv_ {} ttl_bytes_recv_ {} batch_size_ {}",
+    HOLOSCAN_LOG_DEBUG("aggr_pkts_recv_ {} ttl_bytes_recv_ {} batch_size_ {}",
         aggr_pkts_recv_, ttl_bytes_recv_, batch_size_.get());
 
     // Once we've aggregated enough packets, do some work
@@ -365,8 +394,11 @@ void AdvConnectorOpRx::compute(InputContext& op_input, OutputContext& op_output,
         // Copy packet I/Q contents to appropriate location in 'rf_data'
         place_packet_data(rf_data.Data(),
                           h_dev_ptrs_[cur_idx],
-                          buffer_track.sample_cnt_d,
-                          buffer_track.received_end_d,
+                          buffer_track.state_d,
+                          buffer_track.ring_d,
+                          buffer_track.ring_tail_d,
+                          buffer_track.ring_size,
+                          static_cast<uint32_t>(samples_per_arr),
                           buffer_track.pos,
                           nom_payload_size_,
                           aggr_pkts_recv_,
@@ -402,11 +434,23 @@ void AdvConnectorOpRx::compute(InputContext& op_input, OutputContext& op_output,
   }
 
   if (!pkts_arrived) {
-    free_bufs();
+    free_bufs_and_emit_arrays(op_output);
   }
+
+  // Batches in flight still have packets to free and arrays to emit, keep polling until done
+  if (out_q.empty()) { rx_condition_->rearm(); }
+}
+
+void AdvConnectorOpRx::start() {
+  if (!event_driven_.get()) { return; }
+
+  std::vector<int> queues(get_num_rx_queues(port_id_));
+  std::iota(queues.begin(), queues.end(), 0);
+  rx_condition_->watch(port_id_, queues);
 }
 
 void AdvConnectorOpRx::stop() {
+  rx_condition_->unwatch();
   HOLOSCAN_LOG_INFO(
       "\n"
       "AdvConnectorOpRx exit report:\n"
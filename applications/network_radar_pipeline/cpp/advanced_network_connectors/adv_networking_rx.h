@@ -18,6 +18,7 @@
 
 #include "common.h"
 #include "advanced_network/common.h"
+#include "advanced_network/rx_condition.h"
 
 #include <arpa/inet.h>
 
@@ -27,86 +28,61 @@
 #define SPOOF_PACKET_DATA      true
 #define SPOOF_SAMPLES_PER_PKT  1024  // byte count must be less than 'max_packet_size' config
 
-// Tracks the status of filling an RF array
+// State of filling one RF array, updated by place_packet_data_kernel
+struct ArrayState {
+  int sample_cnt;  // Samples placed in the array
+  int published;   // The array was published to the completion ring
+};
+
+// Tracks the status of filling the RF arrays. The kernel counts the samples of every array with
+// atomics and publishes the waveform ID of completed arrays to a host-mapped ring, which the
+// host polls without synchronizing with the receive streams.
 struct AdvBufferTracking {
+  static constexpr uint32_t EMPTY_SLOT = 0xFFFFFFFF;
+
   size_t pos;
   size_t pos_wrap;
   size_t buffer_size;
-  int *sample_cnt_h;
-  int *sample_cnt_d;
-  bool *received_end_h;
-  bool *received_end_d;
+  ArrayState *state_d;
+  uint32_t *ring_h;           // Host-pinned and mapped ring of completed waveform IDs
+  uint32_t *ring_d;           // Device pointer of ring_h
+  unsigned int *ring_tail_d;  // Next ring slot written by the device
+  uint32_t ring_size;
+  size_t ring_head;           // Next ring slot read by the host
 
   AdvBufferTracking() = default;
   explicit AdvBufferTracking(const size_t _buffer_size)
-    : pos(0), pos_wrap(0), buffer_size(_buffer_size) {
-    // Reserve sample count
-    cudaMallocHost((void **)&sample_cnt_h, buffer_size*sizeof(int));
-    cudaMalloc((void **)&sample_cnt_d,     buffer_size*sizeof(int));
-    memset(sample_cnt_h,     0, buffer_size*sizeof(int));
-    cudaMemset(sample_cnt_d, 0, buffer_size*sizeof(int));
-
-    // Reserve end-of-array signal
-    cudaMallocHost((void **)&received_end_h, buffer_size*sizeof(bool));
-    cudaMalloc((void **)&received_end_d,     buffer_size*sizeof(bool));
-    memset(received_end_h,     0, buffer_size*sizeof(bool));
-    cudaMemset(received_end_d, 0, buffer_size*sizeof(bool));
-  }
-
-  cudaError_t transferSamples(const cudaMemcpyKind kind, cudaStream_t stream) {
-    void *src;
-    void *dst;
-
-    if (kind == cudaMemcpyHostToDevice) {
-      src = sample_cnt_h;
-      dst = sample_cnt_d;
-    } else {
-      src = sample_cnt_d;
-      dst = sample_cnt_h;
-    }
-    return cudaMemcpyAsync(dst, src, buffer_size*sizeof(int), kind, stream);
+    : pos(0), pos_wrap(0), buffer_size(_buffer_size),
+      ring_size(static_cast<uint32_t>(2 * _buffer_size)), ring_head(0) {
+    // Reserve array states
+    cudaMalloc((void **)&state_d, buffer_size*sizeof(ArrayState));
+    cudaMemset(state_d, 0, buffer_size*sizeof(ArrayState));
+
+    // Reserve completion ring. At most buffer_size arrays are published before the host clears
+    // their state, so the ring never overruns.
+    cudaHostAlloc((void **)&ring_h, ring_size*sizeof(uint32_t), cudaHostAllocMapped);
+    for (uint32_t i = 0; i < ring_size; i++) { ring_h[i] = EMPTY_SLOT; }
+    cudaHostGetDevicePointer((void **)&ring_d, ring_h, 0);
+    cudaMalloc((void **)&ring_tail_d, sizeof(unsigned int));
+    cudaMemset(ring_tail_d, 0, sizeof(unsigned int));
   }
 
-  cudaError_t transferEndArray(const cudaMemcpyKind kind, cudaStream_t stream) {
-    void *src;
-    void *dst;
-
-    if (kind == cudaMemcpyHostToDevice) {
-      src = received_end_h;
-      dst = received_end_d;
-    } else if (kind == cudaMemcpyDeviceToHost) {
-      src = received_end_d;
-      dst = received_end_h;
-    } else {
-      HOLOSCAN_LOG_ERROR("Unknown option {}", (int)kind);
-      return cudaErrorInvalidValue;
-    }
-    return cudaMemcpyAsync(dst, src, buffer_size*sizeof(bool), kind, stream);
+  // Pops the next waveform ID published by the device, false if there is none yet
+  bool pop_completed(uint32_t *waveform_id) {
+    volatile uint32_t *slot = &ring_h[ring_head % ring_size];
+    if (*slot == EMPTY_SLOT) { return false; }
+    *waveform_id = *slot;
+    *slot = EMPTY_SLOT;
+    ring_head++;
+    return true;
   }
 
-  // TODO: Faster way than two separate memcpy's?
-  cudaError_t transfer(const cudaMemcpyKind kind, cudaStream_t stream) {
-    cudaError_t err;
-    err = transferSamples(kind, stream);
-    if (err != cudaSuccess) {
-      return err;
-    }
-    err = transferEndArray(kind, stream);
-    if (err != cudaSuccess) {
-      return err;
-    }
-    return cudaSuccess;
-  }
-
-  void increment() {
-    received_end_h[pos_wrap] = false;
-    sample_cnt_h[pos_wrap] = 0;
+  // Clears the state of the current array, ordered before the next kernel on the stream
+  cudaError_t increment(cudaStream_t stream) {
+    const cudaError_t err = cudaMemsetAsync(&state_d[pos_wrap], 0, sizeof(ArrayState), stream);
     pos++;
     pos_wrap = pos % buffer_size;
-  }
-
-  bool is_ready(const size_t samples_per_arr) {
-    return received_end_h[pos_wrap] || sample_cnt_h[pos_wrap] >= samples_per_arr;
+    return err;
   }
 };
 
@@ -130,6 +106,7 @@ class AdvConnectorOpRx : public Operator {
   void compute(InputContext& op_input,
                OutputContext& op_output,
                ExecutionContext& context) override;
+  void start() override;
   void stop() override;
 
  private:
@@ -148,7 +125,9 @@ class AdvConnectorOpRx : public Operator {
   Parameter<uint32_t> batch_size_;         // Batch size for one processing block
   Parameter<uint16_t> max_packet_size_;    // Maximum size of a single packet
   Parameter<std::string> interface_name_;  // Port name from advanced_network config to poll on
+  Parameter<bool> event_driven_;           // Wait for ready RX bursts instead of polling
   int port_id_;                            // Port ID to poll on
+  std::shared_ptr<holoscan::advanced_network::AdvNetworkRxCondition> rx_condition_;
 
   // Holds burst buffers that cannot be freed yet
   struct RxMsg {
@@ -159,6 +138,7 @@ class AdvConnectorOpRx : public Operator {
   };
   std::vector<RxMsg> free_bufs();
   void free_bufs_and_emit_arrays(OutputContext& op_output);
+  void emit_completed_arrays(OutputContext& op_output);
 
   RxMsg cur_msg_{};
   std::queue<RxMsg> out_q;
@@ -16,6 +16,37 @@
  */
 #include "basic_networking_rx.h"
 
+/**
+ * Scatters the I/Q samples of a burst of RFPackets, copied to the GPU as received, to their
+ * positions in the RF buffer using the packet headers. One block places one packet.
+ */
+__global__ void place_basic_packet_data_kernel(complex_t* out, const uint8_t* __restrict__ pkts,
+                                               const uint32_t stride, const size_t buffer_pos,
+                                               const uint16_t buffer_size,
+                                               const uint16_t num_channels,
+                                               const uint16_t num_pulses,
+                                               const uint16_t num_samples) {
+  const uint32_t channel_stride = static_cast<uint32_t>(num_samples) * num_pulses;
+  const uint32_t buffer_stride = num_channels * channel_stride;
+  const uint8_t* pkt = pkts + static_cast<size_t>(blockIdx.x) * stride;
+  const RfMetaData* meta = reinterpret_cast<const RfMetaData*>(pkt);
+  const complex_t* samples = reinterpret_cast<const complex_t*>(pkt + RFPacket::payload_offset);
+
+  // Make sure this isn't wrapping the buffer - drop if it is
+  if (meta->waveform_id >= buffer_pos + buffer_size || meta->waveform_id < buffer_pos) { return; }
+  if (meta->channel_idx >= num_channels || meta->pulse_idx >= num_pulses ||
+      meta->sample_idx + meta->pkt_samples > num_samples) {
+    return;
+  }
+
+  const uint16_t buffer_idx = meta->waveform_id % buffer_size;
+  const uint32_t idx_offset = meta->sample_idx + meta->pulse_idx * num_samples +
+                              meta->channel_idx * channel_stride + buffer_idx * buffer_stride;
+  for (uint16_t i = threadIdx.x; i < meta->pkt_samples; i += blockDim.x) {
+    out[idx_offset + i] = samples[i];
+  }
+}
+
 namespace holoscan::ops {
 
 void BasicConnectorOpRx::setup(OperatorSpec& spec) {
@@ -54,7 +85,6 @@ void BasicConnectorOpRx::initialize() {
   holoscan::Operator::initialize();
   num_rx = 0;
   buffer_track = BasicBufferTracking(buffer_size.get());
-  pkt_buf = new RFPacket[max_pkts];
   rf_data = new tensor_t<complex_t, 4>(
     {buffer_size.get(), num_channels.get(), num_pulses.get(), num_samples.get()});
 
@@ -66,60 +96,106 @@ void BasicConnectorOpRx::initialize() {
                                     num_samples.get());
 
   cudaStreamCreateWithFlags(&stream, cudaStreamNonBlocking);
+
+  // Each slot holds one burst of up to max_pkts packets of max_payload_size bytes (the stride)
+  for (auto& slot : slots_) {
+    cudaMalloc(reinterpret_cast<void**>(&slot.pkts_d),
+               static_cast<size_t>(max_pkts.get()) * payload_size.get());
+    cudaEventCreateWithFlags(&slot.evt, cudaEventDisableTiming);
+  }
   HOLOSCAN_LOG_INFO("Expecting to receive {} packets", num_transmits.get() * pkts_per_arr);
 }
 
+BasicConnectorOpRx::~BasicConnectorOpRx() {
+  for (auto& slot : slots_) {
+    if (slot.pkts_d == nullptr) { continue; }
+    release_slot(slot);
+    cudaEventDestroy(slot.evt);
+    cudaFree(slot.pkts_d);
+  }
+  if (rf_data) { delete rf_data; }
+}
+
+void BasicConnectorOpRx::release_slot(RxSlot& slot) {
+  if (!slot.burst) { return; }
+  cudaEventSynchronize(slot.evt);
+  if (!slot.burst->pooled) { delete[] slot.burst->data; }
+  slot.burst.reset();
+}
+
 void BasicConnectorOpRx::compute(InputContext& op_input,
                                OutputContext& op_output,
                                ExecutionContext& context) {
   auto in = op_input.receive<std::shared_ptr<NetworkOpBurstParams>>("burst_in").value();
   num_rx += in->num_pkts;
 
+  // Batched receives (recvmmsg) place packets at a fixed stride, otherwise packets are packed
+  // and all expected to be max_payload_size long
+  const uint32_t stride = in->stride > 0 ? in->stride : payload_size.get();
+  const size_t n_bytes = in->stride > 0 && in->num_pkts > 0 ?
+      static_cast<size_t>(in->num_pkts - 1) * stride + in->pkt_lens[in->num_pkts - 1] : in->len;
+  if (in->num_pkts > max_pkts.get() || stride > payload_size.get()) {
+    HOLOSCAN_LOG_ERROR("Burst of {} packets with a stride of {} exceeds the RX buffers, dropping",
+      in->num_pkts, stride);
+    if (!in->pooled) { delete[] in->data; }
+    return;
+  }
+
+  // The headers are read on the host to track the arrays, the samples are placed on the GPU
   uint8_t *buf_ptr = in->data;
   for (size_t i = 0; i < in->num_pkts; i++) {
-    // Get packet and adjust pointer
-    pkt_buf[i] = RFPacket(buf_ptr);
-    buf_ptr += payload_size;  // RFPacket::packet_size(pkt_buf[i].get_num_samples());
+    RFPacket pkt(buf_ptr);
+    buf_ptr += stride;
 
     // Make sure this isn't wrapping the buffer - drop if it is
-    if ((pkt_buf[i].get_waveform_id() >= buffer_track.pos + buffer_size.get()) ||
-        (pkt_buf[i].get_waveform_id() < buffer_track.pos)) {
+    if ((pkt.get_waveform_id() >= buffer_track.pos + buffer_size.get()) ||
+        (pkt.get_waveform_id() < buffer_track.pos)) {
       HOLOSCAN_LOG_ERROR("Waveform ID {} exceeds buffer limits (pos: {}, size: {}), dropping",
-        pkt_buf[i].get_waveform_id(), buffer_track.pos, buffer_size.get());
-    } else {  // Copy into rf_data
-      const index_t buffer_idx  = pkt_buf[i].get_waveform_id() % buffer_size.get();
-      const index_t channel_idx = pkt_buf[i].get_channel_idx();
-      const index_t pulse_idx   = pkt_buf[i].get_pulse_idx();
-      const index_t sample_idx  = pkt_buf[i].get_sample_idx();
-      const uint16_t end_array  = pkt_buf[i].get_end_array();
+        pkt.get_waveform_id(), buffer_track.pos, buffer_size.get());
+    } else {
+      const index_t buffer_idx = pkt.get_waveform_id() % buffer_size.get();
 
       // Mark if we've received the end-of-array message
-      if (end_array) {
+      if (pkt.get_end_array()) {
         buffer_track.received_end[buffer_idx] = true;
       }
-
-      buffer_track.sample_cnt[buffer_idx] += pkt_buf[i].get_num_samples();
-      auto rf_tensor = rf_data->Slice<1>(
-        {buffer_idx, channel_idx, pulse_idx, sample_idx},
-        {matxDropDim, matxDropDim, matxDropDim, sample_idx + pkt_buf[i].get_num_samples()});
-      const size_t n_bytes = RFPacket::payload_size(pkt_buf[i].get_num_samples());
-      cudaMemcpy(rf_tensor.Data(), pkt_buf[i].data(), n_bytes, cudaMemcpyHostToDevice);
+      buffer_track.sample_cnt[buffer_idx] += pkt.get_num_samples();
     }
 
     if ((num_rx - in->num_pkts + i) % 1000 == 0) {
       HOLOSCAN_LOG_INFO("Packet: [{}, {}, {}, {} - {}] ({} total, {} / {})",
-        pkt_buf[i].get_waveform_id(),
-        pkt_buf[i].get_pulse_idx(),
-        pkt_buf[i].get_channel_idx(),
-        pkt_buf[i].get_sample_idx(),
-        pkt_buf[i].get_num_samples(),
+        pkt.get_waveform_id(),
+        pkt.get_pulse_idx(),
+        pkt.get_channel_idx(),
+        pkt.get_sample_idx(),
+        pkt.get_num_samples(),
         num_rx,
         buffer_track.sample_cnt[buffer_track.pos_wrap],
         samples_per_arr);
     }
   }
 
-  delete[] in->data;
+  // Copy the whole burst in one transfer and scatter it to 'rf_data'. Both are queued on the
+  // stream the arrays are emitted with, so downstream operators see the samples in order.
+  RxSlot& slot = slots_[cur_slot];
+  cur_slot = (cur_slot + 1) % num_concurrent;
+  release_slot(slot);
+  if (in->num_pkts > 0) {
+    cudaMemcpyAsync(slot.pkts_d, in->data, n_bytes, cudaMemcpyHostToDevice, stream);
+    place_basic_packet_data_kernel<<<in->num_pkts, 128, 0, stream>>>(rf_data->Data(),
+                                                                     slot.pkts_d,
+                                                                     stride,
+                                                                     buffer_track.pos,
+                                                                     buffer_size.get(),
+                                                                     num_channels.get(),
+                                                                     num_pulses.get(),
+                                                                     num_samples.get());
+    if (cudaGetLastError() != cudaSuccess) {
+      HOLOSCAN_LOG_ERROR("Failed to place {} packets in the RF buffer", in->num_pkts);
+    }
+  }
+  cudaEventRecord(slot.evt, stream);
+  slot.burst = in;
 
   // Check if we can emit an array
   if (buffer_track.is_ready(samples_per_arr)) {
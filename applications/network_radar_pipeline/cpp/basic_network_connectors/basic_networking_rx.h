@@ -16,6 +16,9 @@
  */
 #pragma once
 
+#include <array>
+#include <memory>
+
 #include "common.h"
 #include "basic_network_operator_rx.h"
 
@@ -54,10 +57,7 @@ class BasicConnectorOpRx : public Operator {
   HOLOSCAN_OPERATOR_FORWARD_ARGS(BasicConnectorOpRx)
 
   BasicConnectorOpRx() = default;
-  ~BasicConnectorOpRx() {
-    if (pkt_buf) { delete pkt_buf; }
-    if (rf_data) { delete rf_data; }
-  }
+  ~BasicConnectorOpRx();
 
   void setup(OperatorSpec& spec) override;
   void initialize() override;
@@ -66,6 +66,17 @@ class BasicConnectorOpRx : public Operator {
                ExecutionContext& context) override;
 
  private:
+  static constexpr int num_concurrent = 4;  // Number of bursts in flight on the GPU
+
+  // A burst copied to the GPU in one transfer, held until the copy and the scatter kernel are
+  // done with it so pooled (pinned) buffers aren't reused under the copy
+  struct RxSlot {
+    std::shared_ptr<NetworkOpBurstParams> burst;
+    uint8_t *pkts_d = nullptr;  // Device copy of the burst's packets
+    cudaEvent_t evt;
+  };
+  void release_slot(RxSlot &slot);
+
   int num_rx;
   Parameter<uint16_t> max_pkts;
   Parameter<uint16_t> payload_size;
@@ -75,7 +86,8 @@ class BasicConnectorOpRx : public Operator {
   Parameter<uint16_t> num_samples;
   Parameter<uint16_t> waveform_length;
   Parameter<uint16_t> num_channels;
-  RFPacket *pkt_buf;
+  std::array<RxSlot, num_concurrent> slots_;
+  int cur_slot = 0;
   size_t samples_per_arr;
   size_t pkts_per_arr;
   BasicBufferTracking buffer_track;
@@ -71,16 +71,48 @@ class App : public holoscan::Application {
     using namespace holoscan;
     HOLOSCAN_LOG_INFO("Initializing radar pipeline as data processor");
 
-    // Radar algorithms
-    auto pc   = make_operator<ops::PulseCompressionOp>(
-      "pulse_compression",
-      from_config("radar_pipeline"),
-      make_condition<CountCondition>(from_config("radar_pipeline.num_transmits").as<size_t>()));
-    auto tpc  = make_operator<ops::ThreePulseCancellerOp>(
-      "three_pulse_canceller",
-      from_config("radar_pipeline"));
-    auto dop  = make_operator<ops::DopplerOp>("doppler", from_config("radar_pipeline"));
-    auto cfar = make_operator<ops::CFAROp>("cfar", from_config("radar_pipeline"));
+    // With beamforming, the radar stages process the beams as their channels
+    const bool beamforming = from_config("radar_pipeline.beamforming").as<bool>();
+    const Arg stage_channels("num_channels", beamforming
+        ? from_config("radar_pipeline.num_beams").as<int64_t>()
+        : from_config("radar_pipeline.num_channels").as<int64_t>());
+
+    // Radar algorithms, either one operator per stage or all stages in one operator
+    // that can replay them as a CUDA graph
+    std::shared_ptr<Operator> radar_in;
+    if (from_config("radar_pipeline.fused_processing").as<bool>()) {
+      radar_in = make_operator<ops::RadarProcessingOp>(
+        "radar_processing",
+        from_config("radar_pipeline"),
+        stage_channels,
+        make_condition<CountCondition>(from_config("radar_pipeline.num_transmits").as<size_t>()));
+    } else {
+      auto pc   = make_operator<ops::PulseCompressionOp>(
+        "pulse_compression",
+        from_config("radar_pipeline"),
+        stage_channels,
+        make_condition<CountCondition>(from_config("radar_pipeline.num_transmits").as<size_t>()));
+      auto tpc  = make_operator<ops::ThreePulseCancellerOp>(
+        "three_pulse_canceller",
+        from_config("radar_pipeline"),
+        stage_channels);
+      auto dop  = make_operator<ops::DopplerOp>("doppler",
+        from_config("radar_pipeline"), stage_channels);
+      auto cfar = make_operator<ops::CFAROp>("cfar",
+        from_config("radar_pipeline"), stage_channels);
+
+      add_flow(pc, tpc,   {{"pc_out", "tpc_in"}});
+      add_flow(tpc, dop,  {{"tpc_out", "dop_in"}});
+      add_flow(dop, cfar, {{"dop_out", "cfar_in"}});
+      radar_in = pc;
+    }
+
+    // Beams of the received elements, weights can be sent to the beamformer's weights_in
+    if (beamforming) {
+      auto bf = make_operator<ops::BeamformerOp>("beamformer", from_config("radar_pipeline"));
+      add_flow(bf, radar_in, {{"beams_out", "rf_in"}});
+      radar_in = bf;
+    }
 
     // Network operators
     if (from_config("rx_params.use_ano").as<bool>()) {
@@ -90,7 +122,7 @@ class App : public holoscan::Application {
         from_config("rx_params"),
         from_config("radar_pipeline"),
         make_condition<BooleanCondition>("is_alive", true));
-      add_flow(adv_rx_pkt, pc,         {{"rf_out", "rf_in"}});
+      add_flow(adv_rx_pkt, radar_in,   {{"rf_out", "rf_in"}});
     } else {
       // Basic
       auto bas_net_rx = make_operator<ops::BasicNetworkOpRx>(
@@ -102,12 +134,8 @@ class App : public holoscan::Application {
         from_config("basic_network"),
         from_config("radar_pipeline"));
       add_flow(bas_net_rx, bas_rx_pkt, {{"burst_out", "burst_in"}});
-      add_flow(bas_rx_pkt, pc,         {{"rf_out", "rf_in"}});
+      add_flow(bas_rx_pkt, radar_in,   {{"rf_out", "rf_in"}});
     }
-
-    add_flow(pc, tpc,   {{"pc_out", "tpc_in"}});
-    add_flow(tpc, dop,  {{"tpc_out", "dop_in"}});
-    add_flow(dop, cfar, {{"dop_out", "cfar_in"}});
   }
 
  public:
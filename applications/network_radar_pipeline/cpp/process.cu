@@ -16,8 +16,663 @@
  */
 #include "process.h"
 
+#include <cfloat>
+#include <cmath>
+#include <cooperative_groups.h>
+#include <cub/block/block_scan.cuh>
+
 namespace holoscan::ops {
 
+namespace {
+index_t next_pow2(index_t n) {
+  index_t rnd = 1;
+  while (rnd < n) { rnd *= 2; }
+  return rnd;
+}
+
+/**
+ * Windowed, normalized and conjugated FFT of the waveform for matched filtering (assuming
+ * the waveform is the same for every pulse), so the waveform is precomputed in the
+ * frequency domain.
+ */
+void init_waveform(tensor_t<complex_t, 1>& waveformView,
+                   tensor_t<complex_t, 0>& norms,
+                   index_t waveform_length,
+                   index_t num_samples_rnd) {
+  make_tensor(waveformView, {num_samples_rnd});
+  cudaMemset(waveformView.Data(), 0, num_samples_rnd * sizeof(complex_t));
+
+  auto waveformPart = slice(waveformView, {0}, {waveform_length});
+  auto waveformFull = slice(waveformView, {0}, {num_samples_rnd});
+
+  // Apply a Hamming window to the waveform to suppress sidelobes. Other
+  // windows could be used as well (e.g., Taylor windows). Ultimately, it is
+  // just an element-wise weighting by a pre-computed window function.
+  (waveformPart = waveformPart * hamming<0>({waveform_length})).run();
+
+  // Normalize by L2 norm
+  make_tensor(norms);
+  (norms = sum(norm(waveformPart))).run();
+  (norms = sqrt(norms)).run();
+  (waveformPart = waveformPart / norms).run();
+
+  // Do FFT
+  (waveformFull = fft(waveformPart, num_samples_rnd)).run();
+  (waveformFull = conj(waveformFull)).run();
+}
+
+// Pulse compression of zeroPaddedInput in place, once its first num_samples are filled
+void run_pulse_compression(tensor_t<complex_t, 3> zeroPaddedInput,
+                           tensor_t<complex_t, 1> waveformView,
+                           index_t num_samples,
+                           cudaStream_t stream) {
+  const index_t num_samples_rnd = zeroPaddedInput.Size(2);
+  auto waveformFFT = clone<3>(waveformView,
+                              {zeroPaddedInput.Size(0), zeroPaddedInput.Size(1), matxKeepDim});
+
+  // Zero out the pad portion of the zero-padded input
+  auto zp = slice<3>(zeroPaddedInput, {0, 0, num_samples},
+                                      {matxEnd, matxEnd, num_samples_rnd});
+  (zp = 0).run(stream);
+
+  (zeroPaddedInput = fft(zeroPaddedInput)).run(stream);
+  (zeroPaddedInput = zeroPaddedInput * waveformFFT).run(stream);
+  (zeroPaddedInput = ifft(zeroPaddedInput)).run(stream);
+}
+
+void run_three_pulse_canceller(tensor_t<complex_t, 3> inputView,
+                               tensor_t<complex_t, 3> tpcView,
+                               tensor_t<float_t, 1> cancelMask,
+                               index_t num_pulses,
+                               index_t numCompressedSamples,
+                               cudaStream_t stream) {
+  const index_t num_channels = tpcView.Size(0);
+  auto x = inputView.Permute({0, 2, 1}).Slice(
+      {0, 0, 0}, {num_channels, numCompressedSamples, num_pulses});
+  auto xo = tpcView.Permute({0, 2, 1}).Slice(
+      {0, 0, 0}, {num_channels, numCompressedSamples, num_pulses});
+  (xo = conv1d(x, cancelMask, matxConvCorrMode_t::MATX_C_MODE_SAME)).run(stream);
+}
+
+void run_doppler(tensor_t<complex_t, 3> tpcView,
+                 tensor_t<float_t, 1> cancelMask,
+                 index_t num_pulses,
+                 index_t numCompressedSamples,
+                 cudaStream_t stream) {
+  const index_t num_channels = tpcView.Size(0);
+  const index_t cpulses = num_pulses - (cancelMask.Size(0) - 1);
+
+  auto xc = tpcView.Slice({0, 0, 0}, {num_channels, cpulses, numCompressedSamples});
+  auto xf = tpcView.Permute({0, 2, 1});
+
+  (xc = xc * hamming<1>({num_channels, cpulses, numCompressedSamples})).run(stream);
+  (xf = fft(xf)).run(stream);
+}
+
+// Zeroed three-pulse canceller outputs of num_slots CPIs
+void init_tpc_buffers(std::vector<tensor_t<complex_t, 3>>& tpcView,
+                      size_t num_slots,
+                      index_t num_channels,
+                      index_t num_pulses_rnd,
+                      index_t numCompressedSamples) {
+  tpcView.resize(num_slots);
+  for (auto& t : tpcView) {
+    make_tensor(t, {num_channels, num_pulses_rnd, numCompressedSamples});
+    cudaMemset(t.Data(), 0, t.TotalSize() * sizeof(complex_t));
+    t.PrefetchDevice(0);
+  }
+}
+
+constexpr int cfarThreads = 256;
+constexpr int maxOsCells = 128;
+
+// Number of cells in the window around the cell under test, less the guard cells
+index_t cfar_training_cells(const CFARConfig& cfg) {
+  const index_t gy = 2 * cfg.guard_doppler + 1;
+  const index_t gx = 2 * cfg.guard_range + 1;
+  const index_t wy = gy + 2 * cfg.train_doppler;
+  const index_t wx = gx + 2 * cfg.train_range;
+  return wy * wx - gy * gx;
+}
+
+// OS-CFAR noise estimate rank (1-based) among n training cells
+__host__ __device__ inline int os_rank_of(float os_rank, int n) {
+  const int k = static_cast<int>(ceilf(os_rank * n));
+  return k < 1 ? 1 : (k > n ? n : k);
+}
+
+/**
+ * Inclusive prefix sum of |X|^2 along range for every Doppler row, written from row 1 and
+ * column 1 of the summed-area table. The sums are kept in double since the box sums are
+ * differences of large prefix sums.
+ */
+__global__ void cfar_row_scan_kernel(const complex_t* __restrict__ x,
+                                     double* __restrict__ sat,
+                                     index_t rows,
+                                     index_t cols) {
+  using BlockScan = cub::BlockScan<double, cfarThreads>;
+  __shared__ typename BlockScan::TempStorage temp;
+  __shared__ double carry;
+
+  const index_t ch = blockIdx.y;
+  const index_t row = blockIdx.x;
+  const complex_t* in = x + (ch * rows + row) * cols;
+  double* out = sat + (ch * (rows + 1) + row + 1) * (cols + 1) + 1;
+
+  if (threadIdx.x == 0) { carry = 0; }
+  __syncthreads();
+
+  for (index_t base = 0; base < cols; base += cfarThreads) {
+    const index_t col = base + threadIdx.x;
+    double v = 0;
+    if (col < cols) {
+      const complex_t s = in[col];
+      v = static_cast<double>(s.real()) * s.real() + static_cast<double>(s.imag()) * s.imag();
+    }
+    double incl, total;
+    BlockScan(temp).InclusiveSum(v, incl, total);
+    if (col < cols) { out[col] = carry + incl; }
+    __syncthreads();
+    if (threadIdx.x == 0) { carry += total; }
+    __syncthreads();
+  }
+}
+
+// Accumulate the row prefix sums down each column to complete the summed-area table
+__global__ void cfar_col_scan_kernel(double* __restrict__ sat, index_t rows, index_t cols) {
+  const index_t col = static_cast<index_t>(blockIdx.x) * blockDim.x + threadIdx.x + 1;
+  if (col > cols) { return; }
+
+  double* s = sat + blockIdx.y * (rows + 1) * (cols + 1) + col;
+  double acc = 0;
+  for (index_t r = 1; r <= rows; r++) {
+    acc += s[r * (cols + 1)];
+    s[r * (cols + 1)] = acc;
+  }
+}
+
+// Sum of the cells in rows [r0, r1] and columns [c0, c1], both inclusive
+__device__ inline double box_sum(const double* sat, index_t stride,
+                                 index_t r0, index_t r1, index_t c0, index_t c1) {
+  return sat[(r1 + 1) * stride + c1 + 1] - sat[r0 * stride + c1 + 1] -
+         sat[(r1 + 1) * stride + c0] + sat[r0 * stride + c0];
+}
+
+// Append a detection with one atomic per group of detecting threads in the warp
+__device__ inline void push_detection(CFARDetection* dets, uint32_t* count, uint32_t max_dets,
+                                      const CFARDetection& det) {
+  auto g = cooperative_groups::coalesced_threads();
+  uint32_t base = 0;
+  if (g.thread_rank() == 0) { base = atomicAdd(count, g.size()); }
+  base = g.shfl(base, 0);
+  const uint32_t idx = base + g.thread_rank();
+  if (idx < max_dets) { dets[idx] = det; }
+}
+
+/**
+ * Cell-averaging CFAR over the summed-area table. Windows are clipped at the edges of the
+ * map and the threshold uses the number of training cells left, as the masked convolution
+ * did before.
+ */
+__global__ void ca_cfar_kernel(const complex_t* __restrict__ x,
+                               const double* __restrict__ sat,
+                               index_t rows,
+                               index_t cols,
+                               CFARConfig cfg,
+                               CFARDetection* dets,
+                               uint32_t* count) {
+  const index_t col = static_cast<index_t>(blockIdx.x) * blockDim.x + threadIdx.x;
+  const index_t row = blockIdx.y;
+  const index_t ch = blockIdx.z;
+  if (col >= cols) { return; }
+
+  const index_t stride = cols + 1;
+  const double* s = sat + ch * (rows + 1) * stride;
+  const index_t oy = cfg.guard_doppler + cfg.train_doppler;
+  const index_t ox = cfg.guard_range + cfg.train_range;
+
+  const index_t r0 = max(row - oy, index_t{0}), r1 = min(row + oy, rows - 1);
+  const index_t c0 = max(col - ox, index_t{0}), c1 = min(col + ox, cols - 1);
+  const index_t g0 = max(row - cfg.guard_doppler, index_t{0});
+  const index_t g1 = min(row + cfg.guard_doppler, rows - 1);
+  const index_t h0 = max(col - cfg.guard_range, index_t{0});
+  const index_t h1 = min(col + cfg.guard_range, cols - 1);
+
+  const index_t n = (r1 - r0 + 1) * (c1 - c0 + 1) - (g1 - g0 + 1) * (h1 - h0 + 1);
+  if (n <= 0) { return; }
+
+  const float noise = static_cast<float>(
+      (box_sum(s, stride, r0, r1, c0, c1) - box_sum(s, stride, g0, g1, h0, h1)) / n);
+  const float xpow = cuda::std::norm(x[(ch * rows + row) * cols + col]);
+  const float alpha = n * (powf(cfg.pfa, -1.0f / n) - 1.f);
+
+  if (xpow > alpha * noise) {
+    push_detection(dets, count, cfg.max_detections,
+                   {static_cast<int32_t>(ch), static_cast<int32_t>(row),
+                    static_cast<int32_t>(col), 10.f * log10f(xpow / fmaxf(noise, FLT_MIN))});
+  }
+}
+
+// k-th smallest (0-based) of v[0, n), reordering v
+__device__ inline float select_kth(float* v, int n, int k) {
+  int lo = 0, hi = n - 1;
+  while (lo < hi) {
+    const float pivot = v[(lo + hi) / 2];
+    int i = lo, j = hi;
+    while (i <= j) {
+      while (v[i] < pivot) { i++; }
+      while (v[j] > pivot) { j--; }
+      if (i <= j) {
+        const float t = v[i];
+        v[i++] = v[j];
+        v[j--] = t;
+      }
+    }
+    if (k <= j) {
+      hi = j;
+    } else if (k >= i) {
+      lo = i;
+    } else {
+      break;
+    }
+  }
+  return v[k];
+}
+
+/**
+ * Ordered-statistic CFAR. The noise estimate is the os_rank-th training cell in sorted
+ * order and osAlpha[n] holds the threshold multiplier for n training cells.
+ */
+__global__ void os_cfar_kernel(const complex_t* __restrict__ x,
+                               const float* __restrict__ osAlpha,
+                               index_t rows,
+                               index_t cols,
+                               CFARConfig cfg,
+                               CFARDetection* dets,
+                               uint32_t* count) {
+  const index_t col = static_cast<index_t>(blockIdx.x) * blockDim.x + threadIdx.x;
+  const index_t row = blockIdx.y;
+  const index_t ch = blockIdx.z;
+  if (col >= cols) { return; }
+
+  const complex_t* in = x + ch * rows * cols;
+  const index_t oy = cfg.guard_doppler + cfg.train_doppler;
+  const index_t ox = cfg.guard_range + cfg.train_range;
+
+  float v[maxOsCells];
+  int n = 0;
+  for (index_t r = max(row - oy, index_t{0}); r <= min(row + oy, rows - 1); r++) {
+    const bool guard_row = r >= row - cfg.guard_doppler && r <= row + cfg.guard_doppler;
+    for (index_t c = max(col - ox, index_t{0}); c <= min(col + ox, cols - 1); c++) {
+      if (guard_row && c >= col - cfg.guard_range && c <= col + cfg.guard_range) { continue; }
+      v[n++] = cuda::std::norm(in[r * cols + c]);
+    }
+  }
+  if (n == 0) { return; }
+
+  const float noise = select_kth(v, n, os_rank_of(cfg.os_rank, n) - 1);
+  const float xpow = cuda::std::norm(in[row * cols + col]);
+
+  if (xpow > osAlpha[n] * noise) {
+    push_detection(dets, count, cfg.max_detections,
+                   {static_cast<int32_t>(ch), static_cast<int32_t>(row),
+                    static_cast<int32_t>(col), 10.f * log10f(xpow / fmaxf(noise, FLT_MIN))});
+  }
+}
+
+/**
+ * Check the CFAR configuration and, for OS-CFAR, tabulate the threshold multiplier of every
+ * training cell count. alpha solves Pfa = prod_{i<k} (n - i) / (n - i + alpha), see Richards,
+ * "Fundamentals of Radar Signal Processing", section 7.5.
+ */
+void init_cfar(const CFARConfig& cfg, tensor_t<float_t, 1>& osAlpha) {
+  if (cfg.guard_doppler < 0 || cfg.guard_range < 0 || cfg.train_doppler < 0 ||
+      cfg.train_range < 0 || cfar_training_cells(cfg) == 0) {
+    throw std::runtime_error("CFAR needs non-negative window sizes and some training cells");
+  }
+  if (cfg.pfa <= 0.f || cfg.pfa >= 1.f) {
+    throw std::runtime_error("cfar_pfa must be in (0, 1)");
+  }
+
+  const index_t max_n = cfar_training_cells(cfg);
+  make_tensor(osAlpha, {max_n + 1});
+  if (cfg.method != CFARMethod::OS) { return; }
+
+  if (max_n > maxOsCells) {
+    throw std::runtime_error(fmt::format("OS-CFAR supports up to {} training cells, got {}",
+                                         maxOsCells, max_n));
+  }
+  if (cfg.os_rank <= 0.f || cfg.os_rank > 1.f) {
+    throw std::runtime_error("cfar_os_rank must be in (0, 1]");
+  }
+
+  const double log_pfa = std::log(static_cast<double>(cfg.pfa));
+  osAlpha(0) = 0;
+  for (index_t n = 1; n <= max_n; n++) {
+    const int k = os_rank_of(cfg.os_rank, static_cast<int>(n));
+    auto log_pfa_of = [&](double alpha) {
+      double sum = 0;
+      for (int i = 0; i < k; i++) { sum += std::log((n - i) / (n - i + alpha)); }
+      return sum;
+    };
+    double lo = 0, hi = 1;
+    while (log_pfa_of(hi) > log_pfa) { hi *= 2; }
+    for (int it = 0; it < 100; it++) {
+      const double mid = 0.5 * (lo + hi);
+      (log_pfa_of(mid) > log_pfa ? lo : hi) = mid;
+    }
+    osAlpha(n) = static_cast<float_t>(hi);
+  }
+  osAlpha.PrefetchDevice(0);
+}
+
+// Allocate the per-CPI CFAR buffers of num_slots CPIs
+void init_cfar_buffers(std::vector<CFARBuffers>& bufs,
+                       size_t num_slots,
+                       const CFARConfig& cfg,
+                       index_t num_channels,
+                       index_t num_pulses_rnd,
+                       index_t numCompressedSamples) {
+  bufs.resize(num_slots);
+  for (auto& b : bufs) {
+    if (cfg.method == CFARMethod::CA) {
+      make_tensor(b.sat, {num_channels, num_pulses_rnd + 1, numCompressedSamples + 1});
+      cudaMemset(b.sat.Data(), 0, b.sat.TotalSize() * sizeof(double));
+      b.sat.PrefetchDevice(0);
+    }
+    cudaMalloc(&b.detections, cfg.max_detections * sizeof(CFARDetection));
+    cudaMalloc(&b.count, sizeof(uint32_t));
+    cudaMemset(b.count, 0, sizeof(uint32_t));
+  }
+}
+
+void free_cfar_buffers(std::vector<CFARBuffers>& bufs) {
+  for (auto& b : bufs) {
+    cudaFree(b.detections);
+    cudaFree(b.count);
+  }
+  bufs.clear();
+}
+
+// Detections of the last CPI run on a slot, waiting for it to finish
+uint32_t read_detection_count(const CFARBuffers& bufs) {
+  uint32_t count = 0;
+  if (bufs.count != nullptr) {
+    cudaMemcpy(&count, bufs.count, sizeof(count), cudaMemcpyDeviceToHost);
+  }
+  return count;
+}
+
+void run_cfar(tensor_t<complex_t, 3> tpcView,
+              const CFARConfig& cfg,
+              tensor_t<float_t, 1> osAlpha,
+              const CFARBuffers& bufs,
+              cudaStream_t stream) {
+  const index_t num_channels = tpcView.Size(0);
+  const index_t rows = tpcView.Size(1);
+  const index_t cols = tpcView.Size(2);
+  const dim3 grid((cols + cfarThreads - 1) / cfarThreads, rows, num_channels);
+
+  cudaMemsetAsync(bufs.count, 0, sizeof(uint32_t), stream);
+  if (cfg.method == CFARMethod::CA) {
+    cfar_row_scan_kernel<<<dim3(rows, num_channels), cfarThreads, 0, stream>>>(
+        tpcView.Data(), bufs.sat.Data(), rows, cols);
+    cfar_col_scan_kernel<<<dim3(grid.x, num_channels), cfarThreads, 0, stream>>>(
+        bufs.sat.Data(), rows, cols);
+    ca_cfar_kernel<<<grid, cfarThreads, 0, stream>>>(
+        tpcView.Data(), bufs.sat.Data(), rows, cols, cfg, bufs.detections, bufs.count);
+  } else {
+    os_cfar_kernel<<<grid, cfarThreads, 0, stream>>>(
+        tpcView.Data(), osAlpha.Data(), rows, cols, cfg, bufs.detections, bufs.count);
+  }
+}
+}  // namespace
+
+// ----- CFARParams -----------------------------------------------------------
+void CFARParams::setup(OperatorSpec& spec) {
+  spec.param(method,
+              "cfar_method",
+              "CFAR method",
+              "ca for cell-averaging or os for ordered-statistic CFAR", std::string("ca"));
+  spec.param(guard_doppler,
+              "cfar_guard_doppler",
+              "CFAR Doppler guard cells",
+              "Guard cells on each side of the cell under test in Doppler", 1L);
+  spec.param(guard_range,
+              "cfar_guard_range",
+              "CFAR range guard cells",
+              "Guard cells on each side of the cell under test in range", 1L);
+  spec.param(train_doppler,
+              "cfar_train_doppler",
+              "CFAR Doppler training cells",
+              "Training cells on each side of the guard cells in Doppler", 1L);
+  spec.param(train_range,
+              "cfar_train_range",
+              "CFAR range training cells",
+              "Training cells on each side of the guard cells in range", 5L);
+  spec.param(pfa,
+              "cfar_pfa",
+              "Probability of false alarm",
+              "Probability of false alarm the threshold is set for", 1e-5f);
+  spec.param(os_rank,
+              "cfar_os_rank",
+              "OS-CFAR rank",
+              "Rank of the OS-CFAR noise estimate, as a fraction of the training cells", 0.75f);
+  spec.param(max_detections,
+              "cfar_max_detections",
+              "Maximum detections",
+              "Size of the detection list of a CPI", 4096u);
+}
+
+CFARConfig CFARParams::config() const {
+  CFARConfig cfg;
+  if (method.get() == "ca") {
+    cfg.method = CFARMethod::CA;
+  } else if (method.get() == "os") {
+    cfg.method = CFARMethod::OS;
+  } else {
+    throw std::runtime_error(fmt::format("Unknown cfar_method {}", method.get()));
+  }
+  cfg.guard_doppler = guard_doppler.get();
+  cfg.guard_range = guard_range.get();
+  cfg.train_doppler = train_doppler.get();
+  cfg.train_range = train_range.get();
+  cfg.pfa = pfa.get();
+  cfg.os_rank = os_rank.get();
+  cfg.max_detections = max_detections.get();
+  return cfg;
+}
+
+// ----- CPISlots -------------------------------------------------------------
+void CPISlots::init(size_t num_slots) {
+  streams.resize(num_slots);
+  input_ready.resize(num_slots);
+  input_consumed.resize(num_slots);
+  for (size_t i = 0; i < num_slots; i++) {
+    cudaStreamCreateWithFlags(&streams[i], cudaStreamNonBlocking);
+    cudaEventCreateWithFlags(&input_ready[i], cudaEventDisableTiming);
+    cudaEventCreateWithFlags(&input_consumed[i], cudaEventDisableTiming);
+  }
+}
+
+CPISlots::~CPISlots() {
+  for (size_t i = 0; i < streams.size(); i++) {
+    cudaStreamSynchronize(streams[i]);
+    cudaEventDestroy(input_ready[i]);
+    cudaEventDestroy(input_consumed[i]);
+    cudaStreamDestroy(streams[i]);
+  }
+}
+
+size_t CPISlots::acquire(cudaStream_t in_stream) {
+  const size_t slot = next;
+  next = (next + 1) % streams.size();
+  cudaEventRecord(input_ready[slot], in_stream);
+  cudaStreamWaitEvent(streams[slot], input_ready[slot], 0);
+  return slot;
+}
+
+void CPISlots::release_input(size_t slot, cudaStream_t in_stream) {
+  cudaEventRecord(input_consumed[slot], streams[slot]);
+  cudaStreamWaitEvent(in_stream, input_consumed[slot], 0);
+}
+
+// ----- BeamformerOp ---------------------------------------------------------
+void BeamformerOp::setup(OperatorSpec& spec) {
+  spec.input<std::shared_ptr<RFArray>>("rf_in");
+  spec.input<std::shared_ptr<BeamWeights>>("weights_in").condition(ConditionType::kNone);
+  spec.output<std::shared_ptr<RFArray>>("beams_out");
+  spec.param(num_pulses,
+              "num_pulses",
+              "Number of pulses",
+              "Number of pulses per channel", {});
+  spec.param(num_channels,
+              "num_channels",
+              "Number of channels",
+              "Number of array elements", {});
+  spec.param(num_samples,
+              "num_samples",
+              "Number of samples",
+              "Number of samples per channel", {});
+  spec.param(num_beams,
+              "num_beams",
+              "Number of beams",
+              "Number of beams formed from the elements", {});
+  spec.param(beam_min_angle_deg,
+              "beam_min_angle_deg",
+              "First beam angle",
+              "Steering angle of the first beam from broadside, in degrees", -60.f);
+  spec.param(beam_max_angle_deg,
+              "beam_max_angle_deg",
+              "Last beam angle",
+              "Steering angle of the last beam from broadside, in degrees", 60.f);
+  spec.param(element_spacing,
+              "element_spacing",
+              "Element spacing",
+              "Spacing of the array elements, in wavelengths", 0.5f);
+  spec.param(gemm_precision,
+              "gemm_precision",
+              "GEMM precision",
+              "cuBLAS compute precision of the beamforming GEMM: fp32, tf32 or fp16",
+              std::string("fp32"));
+  spec.param(num_cpi_buffers,
+              "num_cpi_buffers",
+              "Number of CPI buffers",
+              "Number of CPIs in flight, each with its own buffers and stream", 1u);
+}
+
+BeamformerOp::~BeamformerOp() {
+  if (handle != nullptr) { cublasDestroy(handle); }
+}
+
+// Conjugated steering vectors of a uniform linear array, scaled for unity gain on each beam
+void BeamformerOp::steering_weights(std::vector<complex_t>& w) const {
+  const index_t nb = num_beams.get();
+  const index_t ne = num_channels.get();
+  const double min_angle = beam_min_angle_deg.get() * M_PI / 180.0;
+  const double max_angle = beam_max_angle_deg.get() * M_PI / 180.0;
+  w.resize(nb * ne);
+  for (index_t b = 0; b < nb; b++) {
+    const double angle = nb == 1 ? 0.5 * (min_angle + max_angle)
+                                 : min_angle + (max_angle - min_angle) * b / (nb - 1);
+    const double phase_step = -2.0 * M_PI * element_spacing.get() * std::sin(angle);
+    for (index_t e = 0; e < ne; e++) {
+      w[b * ne + e] = complex_t(static_cast<float_t>(std::cos(phase_step * e) / ne),
+                                static_cast<float_t>(std::sin(phase_step * e) / ne));
+    }
+  }
+}
+
+void BeamformerOp::initialize() {
+  HOLOSCAN_LOG_INFO("BeamformerOp::initialize()");
+  holoscan::Operator::initialize();
+
+  if (num_cpi_buffers.get() == 0) {
+    throw std::runtime_error("num_cpi_buffers must be at least 1");
+  }
+  if (num_beams.get() < 1) {
+    throw std::runtime_error("num_beams must be at least 1");
+  }
+  if (gemm_precision.get() == "fp32") {
+    compute_type = CUBLAS_COMPUTE_32F;
+  } else if (gemm_precision.get() == "tf32") {
+    compute_type = CUBLAS_COMPUTE_32F_FAST_TF32;
+  } else if (gemm_precision.get() == "fp16") {
+    compute_type = CUBLAS_COMPUTE_32F_FAST_16F;
+  } else {
+    throw std::runtime_error(fmt::format("Unknown gemm_precision {}", gemm_precision.get()));
+  }
+  if (cublasCreate(&handle) != CUBLAS_STATUS_SUCCESS) {
+    throw std::runtime_error("Failed to create the cuBLAS handle");
+  }
+
+  std::vector<complex_t> w;
+  steering_weights(w);
+  weights.resize(num_cpi_buffers.get());
+  beams.resize(num_cpi_buffers.get());
+  for (size_t slot = 0; slot < weights.size(); slot++) {
+    make_tensor(weights[slot], {num_beams.get(), num_channels.get()}, MATX_DEVICE_MEMORY);
+    cudaMemcpy(weights[slot].Data(), w.data(), w.size() * sizeof(complex_t),
+               cudaMemcpyHostToDevice);
+    make_tensor(beams[slot], {num_beams.get(), num_pulses.get(), num_samples.get()},
+                MATX_DEVICE_MEMORY);
+  }
+  slots.init(num_cpi_buffers.get());
+
+  HOLOSCAN_LOG_INFO("BeamformerOp::initialize() done, {} beams of {} elements ({})",
+                    num_beams.get(), num_channels.get(), gemm_precision.get());
+}
+
+// Each slot copies the new weights on its own stream, after the CPI it is running
+void BeamformerOp::set_weights(const BeamWeights& update) {
+  if (update.weights.Size(0) != num_beams.get() || update.weights.Size(1) != num_channels.get()
+      || !update.weights.IsContiguous()) {
+    HOLOSCAN_LOG_ERROR("Ignoring beam weights of shape [{}, {}], expected contiguous [{}, {}]",
+                       update.weights.Size(0), update.weights.Size(1),
+                       num_beams.get(), num_channels.get());
+    return;
+  }
+  for (size_t slot = 0; slot < slots.size(); slot++) {
+    cudaEventRecord(slots.input_ready[slot], update.stream);
+    cudaStreamWaitEvent(slots.streams[slot], slots.input_ready[slot], 0);
+    cudaMemcpyAsync(weights[slot].Data(), update.weights.Data(), weights[slot].Bytes(),
+                    cudaMemcpyDefault, slots.streams[slot]);
+    slots.release_input(slot, update.stream);
+  }
+}
+
+void BeamformerOp::compute(InputContext& op_input, OutputContext& op_output, ExecutionContext&) {
+  HOLOSCAN_LOG_DEBUG("BeamformerOp::compute() called");
+  auto update = op_input.receive<std::shared_ptr<BeamWeights>>("weights_in");
+  if (update && update.value()) { set_weights(*update.value()); }
+
+  auto in = op_input.receive<std::shared_ptr<RFArray>>("rf_in").value();
+  if (in->data.Size(0) != num_channels.get() || !in->data.IsContiguous()) {
+    throw std::runtime_error(fmt::format(
+        "Beamforming needs contiguous arrays of {} elements, got {}",
+        num_channels.get(), in->data.Size(0)));
+  }
+  const size_t slot = slots.acquire(in->stream);
+  cudaStream_t stream = slots.streams[slot];
+
+  // Row-major Y = W X is column-major Y^T = X^T W^T, with the same buffers
+  const int n = static_cast<int>(num_pulses.get() * num_samples.get());
+  const int nb = static_cast<int>(num_beams.get());
+  const int ne = static_cast<int>(num_channels.get());
+  const cuComplex alpha = make_cuComplex(1.f, 0.f);
+  const cuComplex beta = make_cuComplex(0.f, 0.f);
+  cublasSetStream(handle, stream);
+  const cublasStatus_t status = cublasGemmEx(handle, CUBLAS_OP_N, CUBLAS_OP_N, n, nb, ne,
+      &alpha, in->data.Data(), CUDA_C_32F, n, weights[slot].Data(), CUDA_C_32F, ne,
+      &beta, beams[slot].Data(), CUDA_C_32F, n, compute_type, CUBLAS_GEMM_DEFAULT);
+  if (status != CUBLAS_STATUS_SUCCESS) {
+    HOLOSCAN_LOG_ERROR("Beamforming GEMM failed with {}", static_cast<int>(status));
+  }
+  slots.release_input(slot, in->stream);
+
+  op_output.emit(std::make_shared<RFArray>(beams[slot], in->waveform_id, stream), "beams_out");
+}
+
 // ----- PulseCompressionOp ---------------------------------------------------
 void PulseCompressionOp::setup(OperatorSpec& spec) {
   spec.input<std::shared_ptr<RFArray>>("rf_in");
@@ -38,45 +693,45 @@ void PulseCompressionOp::setup(OperatorSpec& spec) {
               "num_samples",
               "Number of samples",
               "Number of samples per channel", {});
+  spec.param(num_cpi_buffers,
+              "num_cpi_buffers",
+              "Number of CPI buffers",
+              "Number of CPIs in flight, each with its own buffers and stream", 1u);
 }
 
 void PulseCompressionOp::initialize() {
   HOLOSCAN_LOG_INFO("PulseCompressionOp::initialize()");
   holoscan::Operator::initialize();
 
-  num_samples_rnd = 1;
-  while (num_samples_rnd < num_samples.get()) {
-    num_samples_rnd *= 2;
+  if (num_cpi_buffers.get() == 0) {
+    throw std::runtime_error("num_cpi_buffers must be at least 1");
   }
 
-  make_tensor(waveformView, {num_samples_rnd});
-  cudaMemset(waveformView.Data(), 0, num_samples_rnd * sizeof(complex_t));
-
-  make_tensor(zeroPaddedInput, {num_channels.get(), num_pulses.get(), num_samples_rnd});
-
-  // Precondition FFT of waveform for matched filtering (assuming waveform is the
-  // same for every pulse) this allows us to precompute waveform in frequency domain
-  auto waveformPart = slice(waveformView, {0}, {waveform_length.get()});
-  auto waveformFull = slice(waveformView, {0}, {num_samples_rnd});
-
-  // Apply a Hamming window to the waveform to suppress sidelobes. Other
-  // windows could be used as well (e.g., Taylor windows). Ultimately, it is
-  // just an element-wise weighting by a pre-computed window function.
-  (waveformPart = waveformPart * hamming<0>({waveform_length.get()})).run();
-
-  // Normalize by L2 norm
-  make_tensor(norms);
-  (norms = sum(norm(waveformPart))).run();
-  (norms = sqrt(norms)).run();
-  (waveformPart = waveformPart / norms).run();
-
-  // Do FFT
-  (waveformFull = fft(waveformPart, num_samples_rnd)).run();
-  (waveformFull = conj(waveformFull)).run();
+  num_samples_rnd = next_pow2(num_samples.get());
+  zeroPaddedInput.resize(num_cpi_buffers.get());
+  for (auto& zp : zeroPaddedInput) {
+    make_tensor(zp, {num_channels.get(), num_pulses.get(), num_samples_rnd});
+  }
+  init_waveform(waveformView, norms, waveform_length.get(), num_samples_rnd);
+  slots.init(num_cpi_buffers.get());
 
   HOLOSCAN_LOG_INFO("PulseCompressionOp::initialize() done");
 }
 
+void PulseCompressionOp::start() {
+  // MatX caches FFT plans per stream, so each slot's stream gets its own
+  for (size_t slot = 0; slot < slots.size(); slot++) {
+    auto& zp = zeroPaddedInput[slot];
+    cudaMemsetAsync(zp.Data(), 0, zp.TotalSize() * sizeof(complex_t), slots.streams[slot]);
+    run_pulse_compression(zp, waveformView, num_samples.get(), slots.streams[slot]);
+  }
+  for (auto stream : slots.streams) {
+    cudaStreamSynchronize(stream);
+  }
+  HOLOSCAN_LOG_INFO("PulseCompressionOp::start() created the FFT plans of {} CPI slots",
+                    slots.size());
+}
+
 /**
  * @brief Stage 1 - Pulse compression - convolution via FFTs
  *
@@ -92,24 +747,18 @@ void PulseCompressionOp::compute(InputContext& op_input,
                                  ExecutionContext&) {
   HOLOSCAN_LOG_INFO("PulseCompressionOp::compute() called");
   auto in = op_input.receive<std::shared_ptr<RFArray>>("rf_in").value();
-  cudaStream_t stream = in->stream;
-
-  auto waveformFFT = clone<3>(waveformView, {num_channels.get(), num_pulses.get(), matxKeepDim});
+  const size_t slot = slots.acquire(in->stream);
+  cudaStream_t stream = slots.streams[slot];
 
   HOLOSCAN_LOG_INFO("Dim: {}, {}, {}", in->data.Size(0), in->data.Size(1), in->data.Size(2));
 
-  // Zero out the pad portion of the zero-padded input and copy the data portion
-  auto zp = slice<3>(zeroPaddedInput, {0, 0, num_samples.get()},
-                                      {matxEnd, matxEnd, num_samples_rnd});
-  auto data = slice<3>(zeroPaddedInput, {0, 0, 0}, {matxEnd, matxEnd, num_samples.get()});
-  (zp = 0).run(stream);
+  // Copy the data portion of the zero-padded input, then let the sender reuse its buffer
+  auto data = slice<3>(zeroPaddedInput[slot], {0, 0, 0}, {matxEnd, matxEnd, num_samples.get()});
   matx::copy(data, in->data, stream);
+  slots.release_input(slot, in->stream);
+  run_pulse_compression(zeroPaddedInput[slot], waveformView, num_samples.get(), stream);
 
-  (zeroPaddedInput = fft(zeroPaddedInput)).run(stream);
-  (zeroPaddedInput = zeroPaddedInput * waveformFFT).run(stream);
-  (zeroPaddedInput = ifft(zeroPaddedInput)).run(stream);
-
-  auto params = std::make_shared<ThreePulseCancellerData>(zeroPaddedInput, stream);
+  auto params = std::make_shared<ThreePulseCancellerData>(zeroPaddedInput[slot], slot, stream);
   op_output.emit(params, "pc_out");
 }
 
@@ -133,6 +782,10 @@ void ThreePulseCancellerOp::setup(OperatorSpec& spec) {
               "num_samples",
               "Number of samples",
               "Number of samples per channel", {});
+  spec.param(num_cpi_buffers,
+              "num_cpi_buffers",
+              "Number of CPI buffers",
+              "Number of CPIs in flight, each with its own buffers and stream", 1u);
 }
 
 void ThreePulseCancellerOp::initialize() {
@@ -145,13 +798,11 @@ void ThreePulseCancellerOp::initialize() {
   }
 
   numCompressedSamples = num_samples.get() - waveform_length.get() + 1;
-  make_tensor(tpcView, {num_channels.get(), num_pulses_rnd, numCompressedSamples});
+  init_tpc_buffers(tpcView, num_cpi_buffers.get(), num_channels.get(), num_pulses_rnd,
+                   numCompressedSamples);
   make_tensor(cancelMask, {3});
   cancelMask.SetVals({1, -2, 1});
 
-  cudaMemset(tpcView.Data(), 0, tpcView.TotalSize() * sizeof(complex_t));
-
-  tpcView.PrefetchDevice(0);
   cancelMask.PrefetchDevice(0);
   HOLOSCAN_LOG_INFO("ThreePulseCancellerOp::initialize() done");
 }
@@ -179,13 +830,13 @@ void ThreePulseCancellerOp::compute(InputContext& op_input,
   HOLOSCAN_LOG_INFO("Three pulse canceller compute() called");
   auto tpc_data = op_input.receive<std::shared_ptr<ThreePulseCancellerData>>("tpc_in").value();
 
-  auto x = tpc_data->inputView.Permute({0, 2, 1}).Slice(
-      {0, 0, 0}, {num_channels.get(), numCompressedSamples, num_pulses.get()});
-  auto xo = tpcView.Permute({0, 2, 1}).Slice(
-      {0, 0, 0}, {num_channels.get(), numCompressedSamples, num_pulses.get()});
-  (xo = conv1d(x, cancelMask, matxConvCorrMode_t::MATX_C_MODE_SAME)).run(tpc_data->stream);
+  auto out = tpcView.at(tpc_data->slot);
+
+  run_three_pulse_canceller(tpc_data->inputView, out, cancelMask, num_pulses.get(),
+                            numCompressedSamples, tpc_data->stream);
 
-  auto params = std::make_shared<DopplerData>(tpcView, cancelMask, tpc_data->stream);
+  auto params = std::make_shared<DopplerData>(out, cancelMask, tpc_data->slot,
+                                              tpc_data->stream);
   op_output.emit(params, "tpc_out");
 }
 
@@ -239,17 +890,11 @@ void DopplerOp::compute(InputContext& op_input,
   HOLOSCAN_LOG_INFO("Doppler compute() called");
   auto dop_data = op_input.receive<std::shared_ptr<DopplerData>>("dop_in").value();
 
-  const index_t cpulses = num_pulses.get() - (dop_data->cancelMask.Size(0) - 1);
-
-  auto xc = dop_data->tpcView.Slice({0, 0, 0},
-                                      {num_channels.get(), cpulses, numCompressedSamples});
-  auto xf = dop_data->tpcView.Permute({0, 2, 1});
-
-  (xc = xc * hamming<1>({num_channels.get(), num_pulses.get() - (dop_data->cancelMask.Size(0) - 1),
-                        numCompressedSamples})).run(dop_data->stream);
-  (xf = fft(xf)).run(dop_data->stream);
+  run_doppler(dop_data->tpcView, dop_data->cancelMask, num_pulses.get(), numCompressedSamples,
+              dop_data->stream);
 
-  auto params = std::make_shared<CFARData>(dop_data->tpcView, dop_data->stream);
+  // Doppler processing is in place, in the slot's three-pulse canceller buffer
+  auto params = std::make_shared<CFARData>(dop_data->tpcView, dop_data->slot, dop_data->stream);
   op_output.emit(params, "dop_out");
 }
 
@@ -275,6 +920,11 @@ void CFAROp::setup(OperatorSpec& spec) {
               "num_samples",
               "Number of samples",
               "Number of samples per channel", {});
+  spec.param(num_cpi_buffers,
+              "num_cpi_buffers",
+              "Number of CPI buffers",
+              "Number of CPIs in flight, each with its own buffers and stream", 1u);
+  cfar_params.setup(spec);
 }
 
 void CFAROp::initialize() {
@@ -290,50 +940,25 @@ void CFAROp::initialize() {
 
   numCompressedSamples = num_samples.get() - waveform_length.get() + 1;
 
-  make_tensor(normT, {num_channels.get(), num_pulses_rnd + cfarMaskY - 1,
-              numCompressedSamples + cfarMaskX - 1});
-  make_tensor(ba, {num_channels.get(), num_pulses_rnd + cfarMaskY - 1,
-              numCompressedSamples + cfarMaskX - 1});
-  make_tensor(dets, {num_channels.get(), num_pulses_rnd, numCompressedSamples});
-  make_tensor(xPow, {num_channels.get(), num_pulses_rnd, numCompressedSamples});
-  make_tensor(cfarMaskView, {cfarMaskY, cfarMaskX});
-
-  // Mask for cfar detection
-  // G == guard, R == reference, C == CUT
-  // mask = [
-  //    R R R R R ;
-  //    R R R R R ;
-  //    R R R R R ;
-  //    R R R R R ;
-  //    R R R R R ;
-  //    R G G G R ;
-  //    R G C G R ;
-  //    R G G G R ;
-  //    R R R R R ;
-  //    R R R R R ;
-  //    R R R R R ;
-  //    R R R R R ;
-  //    R R R R R ];
-  //  }
-  cfarMaskView.SetVals({{1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1},
-                          {1, 1, 1, 1, 1, 0, 0, 0, 1, 1, 1, 1, 1},
-                          {1, 1, 1, 1, 1, 0, 0, 0, 1, 1, 1, 1, 1},
-                          {1, 1, 1, 1, 1, 0, 0, 0, 1, 1, 1, 1, 1},
-                          {1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1}});
-
-  // Pre-process CFAR convolution
-  (normT = conv2d(ones({num_channels.get(), num_pulses_rnd, numCompressedSamples}), cfarMaskView,
-           matxConvCorrMode_t::MATX_C_MODE_FULL)).run();
-
-  ba.PrefetchDevice(0);
-  normT.PrefetchDevice(0);
-  cfarMaskView.PrefetchDevice(0);
-  dets.PrefetchDevice(0);
-  xPow.PrefetchDevice(0);
+  cfar = cfar_params.config();
+  init_cfar(cfar, osAlpha);
+  init_cfar_buffers(cfar_bufs, num_cpi_buffers.get(), cfar, num_channels.get(), num_pulses_rnd,
+                    numCompressedSamples);
 
   HOLOSCAN_LOG_INFO("CFAROp::initialize() done");
 }
 
+CFAROp::~CFAROp() {
+  free_cfar_buffers(cfar_bufs);
+}
+
+void CFAROp::stop() {
+  if (transmits == 0) { return; }
+  const uint32_t count = read_detection_count(cfar_bufs.at(last_slot));
+  HOLOSCAN_LOG_INFO("CFAR found {} detections in the last CPI{}", count,
+                    count > cfar.max_detections ? ", the list was truncated" : "");
+}
+
 /**
  * @brief Stage 4 - Constant False Alarm Rate (CFAR) Detector - averaging or median
  *
@@ -360,14 +985,13 @@ void CFAROp::initialize() {
   * guard cells form a hole within the training window, but CA-CFAR is
   * largely just an averaging filter otherwise with a threshold check
   * at each pixel after applying the filter.
-  * Currently, the window below is defined statically because it is then
-  * easy to visualize, but more typically the number of guard and
-  * reference cells would be given as input and the window would be
-  * constructed; we could update to such an approach, but I'm keeping
-  * it simple for now.
-
-  * We apply CFAR to the power of X; X is still complex until this point
-  * Xpow = abs(X).^2;
+
+  * The guard and training sizes are parameters. CA-CFAR sums the window
+  * from a summed-area table of Xpow = abs(X).^2, so its cost does not
+  * depend on the window size. OS-CFAR instead uses the cfar_os_rank-th
+  * training cell in sorted order, which is robust to interfering targets
+  * in the training cells. Cells above the threshold are compacted into a
+  * list of CFARDetection rather than a dense mask.
   */
 void CFAROp::compute(InputContext& op_input,
                      OutputContext&,
@@ -375,39 +999,180 @@ void CFAROp::compute(InputContext& op_input,
   HOLOSCAN_LOG_INFO("CFAR compute() called");
   auto cfar_data = op_input.receive<std::shared_ptr<CFARData>>("cfar_in").value();
 
-  (xPow = norm(cfar_data->tpcView)).run(cfar_data->stream);
-
-  // Estimate the background average power in each cell
-  // background_averages = conv2(Xpow, mask, 'same') ./ norm;
-  (ba = conv2d(xPow, cfarMaskView, matxConvCorrMode_t::MATX_C_MODE_FULL)).run(cfar_data->stream);
-
-  // Computing number of cells contributing to each cell.
-  // This can be done with a convolution of the cfarMask with
-  // ones.
-  // norm = conv2(ones(size(X)), mask, 'same');
-  auto normTrim = normT.Slice({0, cfarMaskY / 2, cfarMaskX / 2},
-                              {num_channels.get(), num_pulses_rnd + cfarMaskY / 2,
-                               numCompressedSamples + cfarMaskX / 2});
-
-  auto baTrim = ba.Slice({0, cfarMaskY / 2, cfarMaskX / 2},
-                         {num_channels.get(), num_pulses_rnd + cfarMaskY / 2,
-                          numCompressedSamples + cfarMaskX / 2});
-  (baTrim = baTrim / normTrim).run(cfar_data->stream);
-
-  // The scalar alpha is used as a multiplier on the background averages
-  // to achieve a constant false alarm rate (under certain assumptions);
-  // it is based upon the desired probability of false alarm (Pfa) and
-  // number of reference cells used to estimate the background for the
-  // CUT. For the purposes of computation, it can be assumed as a given
-  // constant, although it does vary at the edges due to the different
-  // training windows.
-  // Declare a detection if the power exceeds the background estimate
-  // times alpha for a particular cell.
-  // dets(find(Xpow > alpha.*background_averages)) = 1;
-
-  // These 2 branches are functionally equivalent.  A custom op is more
-  // efficient as it can avoid repeated loads.
-  calcDets(dets, xPow, baTrim, normTrim, pfa).run(cfar_data->stream);
+  run_cfar(cfar_data->tpcView, cfar, osAlpha, cfar_bufs.at(cfar_data->slot),
+           cfar_data->stream);
+  last_slot = cfar_data->slot;
+
+  // Interrupt if we're done
+  transmits++;
+  if (transmits == num_transmits.get()) {
+    HOLOSCAN_LOG_INFO("Received {} of {} transmits, exiting...", transmits, num_transmits.get());
+    GxfGraphInterrupt(context.context());
+  }
+}
+
+// ----- RadarProcessingOp ----------------------------------------------------
+void RadarProcessingOp::setup(OperatorSpec& spec) {
+  spec.input<std::shared_ptr<RFArray>>("rf_in");
+  spec.param(num_transmits, "num_transmits",
+              "Number of waveform transmissions",
+              "Number of waveform transmissions to simulate", {});
+  spec.param(num_pulses,
+              "num_pulses",
+              "Number of pulses",
+              "Number of pulses per channel", {});
+  spec.param(num_channels,
+              "num_channels",
+              "Number of channels",
+              "Number of channels", {});
+  spec.param(waveform_length,
+              "waveform_length",
+              "NWaveform length",
+              "Length of waveform", {});
+  spec.param(num_samples,
+              "num_samples",
+              "Number of samples",
+              "Number of samples per channel", {});
+  spec.param(use_cuda_graph,
+              "use_cuda_graph",
+              "Use a CUDA graph",
+              "Capture the per-CPI processing into a CUDA graph and replay it", true);
+  spec.param(num_cpi_buffers,
+              "num_cpi_buffers",
+              "Number of CPI buffers",
+              "Number of CPIs in flight, each with its own buffers and stream", 1u);
+  cfar_params.setup(spec);
+}
+
+void RadarProcessingOp::initialize() {
+  HOLOSCAN_LOG_INFO("RadarProcessingOp::initialize()");
+  holoscan::Operator::initialize();
+
+  if (num_cpi_buffers.get() == 0) {
+    throw std::runtime_error("num_cpi_buffers must be at least 1");
+  }
+  const size_t num_slots = num_cpi_buffers.get();
+
+  transmits = 0;
+  num_samples_rnd = next_pow2(num_samples.get());
+  num_pulses_rnd = 1;
+  while (num_pulses_rnd <= num_pulses.get()) {
+    num_pulses_rnd *= 2;
+  }
+  numCompressedSamples = num_samples.get() - waveform_length.get() + 1;
+
+  // Pulse compression
+  zeroPaddedInput.resize(num_slots);
+  for (auto& zp : zeroPaddedInput) {
+    make_tensor(zp, {num_channels.get(), num_pulses.get(), num_samples_rnd});
+  }
+  init_waveform(waveformView, norms, waveform_length.get(), num_samples_rnd);
+
+  // Three-pulse canceller
+  init_tpc_buffers(tpcView, num_slots, num_channels.get(), num_pulses_rnd,
+                   numCompressedSamples);
+  make_tensor(cancelMask, {3});
+  cancelMask.SetVals({1, -2, 1});
+  cancelMask.PrefetchDevice(0);
+
+  // CFAR
+  cfar = cfar_params.config();
+  init_cfar(cfar, osAlpha);
+  init_cfar_buffers(cfar_bufs, num_slots, cfar, num_channels.get(), num_pulses_rnd,
+                    numCompressedSamples);
+
+  slots.init(num_slots);
+  graph_exec.assign(num_slots, nullptr);
+  if (use_cuda_graph.get()) {
+    cudaStreamCreateWithFlags(&capture_stream, cudaStreamNonBlocking);
+  }
+  HOLOSCAN_LOG_INFO("RadarProcessingOp::initialize() done");
+}
+
+RadarProcessingOp::~RadarProcessingOp() {
+  for (auto exec : graph_exec) {
+    if (exec != nullptr) { cudaGraphExecDestroy(exec); }
+  }
+  if (capture_stream != nullptr) { cudaStreamDestroy(capture_stream); }
+  free_cfar_buffers(cfar_bufs);
+}
+
+void RadarProcessingOp::start() {
+  for (size_t slot = 0; slot < slots.size(); slot++) {
+    // Graphs are captured on capture_stream, so that is the stream their plans are cached for
+    warm_up(slot, use_cuda_graph.get() ? capture_stream : slots.streams[slot]);
+    if (use_cuda_graph.get() && !graph_failed) {
+      capture_graph(slot);
+    }
+  }
+}
+
+void RadarProcessingOp::stop() {
+  if (transmits == 0) { return; }
+  const uint32_t count = read_detection_count(cfar_bufs.at(last_slot));
+  HOLOSCAN_LOG_INFO("CFAR found {} detections in the last CPI{}", count,
+                    count > cfar.max_detections ? ", the list was truncated" : "");
+}
+
+void RadarProcessingOp::run_stages(size_t slot, cudaStream_t stream) {
+  run_pulse_compression(zeroPaddedInput[slot], waveformView, num_samples.get(), stream);
+  run_three_pulse_canceller(zeroPaddedInput[slot], tpcView[slot], cancelMask, num_pulses.get(),
+                            numCompressedSamples, stream);
+  run_doppler(tpcView[slot], cancelMask, num_pulses.get(), numCompressedSamples, stream);
+  run_cfar(tpcView[slot], cfar, osAlpha, cfar_bufs[slot], stream);
+}
+
+// Run the stages once on a zeroed input, then clear the output of the padded pulses again
+void RadarProcessingOp::warm_up(size_t slot, cudaStream_t stream) {
+  auto& zp = zeroPaddedInput[slot];
+  cudaMemsetAsync(zp.Data(), 0, zp.TotalSize() * sizeof(complex_t), stream);
+  run_stages(slot, stream);
+  cudaMemsetAsync(tpcView[slot].Data(), 0, tpcView[slot].TotalSize() * sizeof(complex_t), stream);
+  cudaStreamSynchronize(stream);
+}
+
+void RadarProcessingOp::capture_graph(size_t slot) {
+  // Relaxed mode, in case MatX still has to allocate while capturing
+  cudaGraph_t graph;
+  cudaError_t err = cudaStreamBeginCapture(capture_stream, cudaStreamCaptureModeRelaxed);
+  if (err == cudaSuccess) {
+    run_stages(slot, capture_stream);
+    err = cudaStreamEndCapture(capture_stream, &graph);
+  }
+  if (err == cudaSuccess) {
+    err = cudaGraphInstantiateWithFlags(&graph_exec[slot], graph, 0);
+    cudaGraphDestroy(graph);
+  }
+  if (err != cudaSuccess) {
+    HOLOSCAN_LOG_WARN("Failed to capture the radar processing graph ({}), running eagerly",
+                      cudaGetErrorString(err));
+    cudaGetLastError();
+    graph_exec[slot] = nullptr;
+    graph_failed = true;
+    return;
+  }
+  HOLOSCAN_LOG_INFO("Captured the radar processing graph of CPI slot {}", slot);
+}
+
+void RadarProcessingOp::compute(InputContext& op_input,
+                                OutputContext&,
+                                ExecutionContext& context) {
+  HOLOSCAN_LOG_DEBUG("RadarProcessingOp compute() called");
+  auto in = op_input.receive<std::shared_ptr<RFArray>>("rf_in").value();
+  const size_t slot = slots.acquire(in->stream);
+  cudaStream_t stream = slots.streams[slot];
+
+  // The input buffer changes between CPIs, so its copy stays out of the graph
+  auto data = slice<3>(zeroPaddedInput[slot], {0, 0, 0}, {matxEnd, matxEnd, num_samples.get()});
+  matx::copy(data, in->data, stream);
+  slots.release_input(slot, in->stream);
+
+  if (graph_exec[slot] != nullptr) {
+    cudaGraphLaunch(graph_exec[slot], stream);
+  } else {
+    run_stages(slot, stream);
+  }
+  last_slot = slot;
 
   // Interrupt if we're done
   transmits++;
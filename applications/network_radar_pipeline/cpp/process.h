@@ -16,9 +16,76 @@
  */
 #pragma once
 
+#include <cublas_v2.h>
+#include <string>
+#include <vector>
 #include "common.h"
 
 // ---------- Structures ----------
+/**
+ * Streams and events of the CPIs in flight. Every stage keeps one output buffer per slot and
+ * all of a CPI's work runs on its slot's stream. A buffer is then only reused once the CPI
+ * that held it, K CPIs earlier, has finished, while consecutive CPIs overlap on the GPU.
+ */
+struct CPISlots {
+  CPISlots() = default;
+  CPISlots(const CPISlots&) = delete;
+  CPISlots& operator=(const CPISlots&) = delete;
+  ~CPISlots();
+
+  void init(size_t num_slots);
+
+  // Take the next slot and make its stream wait for the work already queued on in_stream
+  size_t acquire(cudaStream_t in_stream);
+
+  // Make in_stream wait until the slot has consumed its input, so the sender can reuse it
+  void release_input(size_t slot, cudaStream_t in_stream);
+
+  size_t size() const { return streams.size(); }
+
+  std::vector<cudaStream_t> streams;
+  std::vector<cudaEvent_t> input_ready;
+  std::vector<cudaEvent_t> input_consumed;
+  size_t next = 0;
+};
+
+// A cell of the range-Doppler map that crossed the CFAR threshold
+struct CFARDetection {
+  int32_t channel;
+  int32_t doppler;
+  int32_t range;
+  float snr_db;  // Power of the cell over the noise estimate
+};
+
+enum class CFARMethod { CA, OS };
+
+// CFAR window and threshold, in cells on each side of the cell under test
+struct CFARConfig {
+  CFARMethod method;
+  index_t guard_doppler;
+  index_t guard_range;
+  index_t train_doppler;
+  index_t train_range;
+  float pfa;
+  float os_rank;  // Rank of the OS-CFAR noise estimate, as a fraction of the training cells
+  uint32_t max_detections;
+};
+
+// CFAR buffers of one in-flight CPI
+struct CFARBuffers {
+  tensor_t<double, 3> sat;  // Summed-area table of |X|^2, with a leading row and column of 0
+  CFARDetection* detections = nullptr;
+  uint32_t* count = nullptr;  // Detections found, may exceed max_detections
+};
+
+// Beamforming weights of every beam, [beams, elements], already conjugated
+struct BeamWeights {
+  BeamWeights(tensor_t<complex_t, 2> _weights, cudaStream_t _stream)
+    : weights(_weights), stream(_stream) {}
+  tensor_t<complex_t, 2> weights;
+  cudaStream_t stream;  // Stream the weights were written on
+};
+
 struct PulseCompressionData {
   PulseCompressionData(tensor_t<complex_t, 1> _waveformView,
                        tensor_t<complex_t, 3> _inputView,
@@ -31,63 +98,96 @@ struct PulseCompressionData {
 
 struct ThreePulseCancellerData {
   ThreePulseCancellerData(tensor_t<complex_t, 3> _inputView,
+                          size_t _slot,
                           cudaStream_t _stream)
-    : inputView(_inputView), stream(_stream)  {}
+    : inputView(_inputView), slot(_slot), stream(_stream)  {}
   tensor_t<complex_t, 3> inputView;
+  size_t slot;  // CPI slot, see CPISlots
   cudaStream_t stream;
 };
 
 struct DopplerData {
   DopplerData(tensor_t<complex_t, 3> _tpcView,
               tensor_t<float_t, 1> _cancelMask,
+              size_t _slot,
               cudaStream_t _stream)
-    : tpcView(_tpcView), cancelMask(_cancelMask), stream(_stream)  {}
+    : tpcView(_tpcView), cancelMask(_cancelMask), slot(_slot), stream(_stream)  {}
   tensor_t<complex_t, 3> tpcView;
   tensor_t<float_t, 1> cancelMask;
+  size_t slot;
   cudaStream_t stream;
 };
 
 struct CFARData {
   CFARData(tensor_t<complex_t, 3> _tpcView,
+           size_t _slot,
            cudaStream_t _stream)
-    : tpcView(_tpcView), stream(_stream)  {}
+    : tpcView(_tpcView), slot(_slot), stream(_stream)  {}
   tensor_t<complex_t, 3> tpcView;
+  size_t slot;
   cudaStream_t stream;
 };
 
 // ---------- Operators ----------
-/* Custom MatX operator for calculation detections in CFAR step. */
-template <class O, class I1, class I2, class I3, class I4>
-class calcDets : public BaseOp<calcDets<O, I1, I2, I3, I4>> {
- private:
-  O out_;
-  I1 xpow_;
-  I2 ba_;
-  I3 norm_;
-  I4 pfa_;
+namespace holoscan::ops {
 
- public:
-  calcDets(O out, I1 xpow, I2 ba, I3 norm, I4 pfa)
-      : out_(out), xpow_(xpow), ba_(ba), norm_(norm), pfa_(pfa)  { }
-
-  __device__ inline void operator()(index_t idz, index_t idy, index_t idx) {
-    typename I1::type xpow = xpow_(idz, idy, idx);
-    typename I2::type ba = ba_(idz, idy, idx);
-    typename I2::type norm = norm_(idz, idy, idx);
-    typename I2::type alpha = norm * (cuda::std::powf(pfa_, -1.0f / norm) - 1.f);
-    out_(idz, idy, idx) = (xpow > alpha * ba) ? 1 : 0;
-  }
-
-  __host__ __device__ inline index_t Size(uint32_t i) const {
-    return out_.Size(i);
-  }
-
-  static inline constexpr __host__ __device__ int32_t Rank() {
-    return O::Rank();
-  }
+// CFAR parameters shared by CFAROp and RadarProcessingOp
+struct CFARParams {
+  void setup(OperatorSpec& spec);
+  CFARConfig config() const;
+
+  Parameter<std::string> method;
+  Parameter<int64_t> guard_doppler;
+  Parameter<int64_t> guard_range;
+  Parameter<int64_t> train_doppler;
+  Parameter<int64_t> train_range;
+  Parameter<float> pfa;
+  Parameter<float> os_rank;
+  Parameter<uint32_t> max_detections;
 };
 
-namespace holoscan::ops {
+class BeamformerOp : public Operator {
+ public:
+  HOLOSCAN_OPERATOR_FORWARD_ARGS(BeamformerOp)
+
+  BeamformerOp() = default;
+  ~BeamformerOp();
+
+  void setup(OperatorSpec& spec) override;
+  void initialize() override;
+
+  /**
+   * @brief Stage 0 - Digital beamforming - complex GEMM across the array elements
+   *
+   * Forms num_beams beams from the num_channels elements of a [elements, pulses, samples]
+   * array, emitting a [beams, pulses, samples] array that the following stages process
+   * as channels. Every pulse and sample uses the same weights, so all of them are one
+   * GEMM: Y[beams, pulses * samples] = W[beams, elements] X[elements, pulses * samples].
+   * The initial weights steer a uniform linear array to evenly spaced angles; new ones
+   * can be sent to weights_in at any time and apply from the next CPI.
+   */
+  void compute(InputContext& op_input, OutputContext& op_output, ExecutionContext&) override;
+
+ private:
+  void steering_weights(std::vector<complex_t>& w) const;
+  void set_weights(const BeamWeights& update);
+
+  Parameter<int64_t> num_pulses;
+  Parameter<int64_t> num_samples;
+  Parameter<int64_t> num_channels;
+  Parameter<int64_t> num_beams;
+  Parameter<float> beam_min_angle_deg;
+  Parameter<float> beam_max_angle_deg;
+  Parameter<float> element_spacing;
+  Parameter<std::string> gemm_precision;
+  Parameter<uint32_t> num_cpi_buffers;
+  cublasComputeType_t compute_type;
+
+  cublasHandle_t handle = nullptr;
+  std::vector<tensor_t<complex_t, 2>> weights;
+  std::vector<tensor_t<complex_t, 3>> beams;
+  CPISlots slots;
+};  // BeamformerOp
 
 class PulseCompressionOp : public Operator {
  public:
@@ -98,6 +198,10 @@ class PulseCompressionOp : public Operator {
   void setup(OperatorSpec& spec) override;
   void initialize() override;
 
+  // Run pulse compression once on each slot's stream, so the FFT plans exist before the
+  // first CPI
+  void start() override;
+
   /**
    * @brief Stage 1 - Pulse compression - convolution via FFTs
    *
@@ -115,11 +219,13 @@ class PulseCompressionOp : public Operator {
   Parameter<int64_t> num_samples;
   Parameter<int64_t> waveform_length;
   Parameter<int64_t> num_channels;
+  Parameter<uint32_t> num_cpi_buffers;
   index_t num_samples_rnd;
 
   tensor_t<complex_t, 1> waveformView;
   tensor_t<complex_t, 0> norms;
-  tensor_t<complex_t, 3> zeroPaddedInput;
+  std::vector<tensor_t<complex_t, 3>> zeroPaddedInput;
+  CPISlots slots;
 };  // PulseCompressionOp
 
 class ThreePulseCancellerOp : public Operator {
@@ -155,11 +261,12 @@ class ThreePulseCancellerOp : public Operator {
   Parameter<int64_t> num_samples;
   Parameter<int64_t> waveform_length;
   Parameter<int64_t> num_channels;
+  Parameter<uint32_t> num_cpi_buffers;
   index_t numCompressedSamples;
   index_t num_pulses_rnd;
 
   tensor_t<float_t, 1> cancelMask;
-  tensor_t<complex_t, 3> tpcView;
+  std::vector<tensor_t<complex_t, 3>> tpcView;
 };  // ThreePulseCancellerOp
 
 class DopplerOp : public Operator {
@@ -200,9 +307,11 @@ class CFAROp : public Operator {
   HOLOSCAN_OPERATOR_FORWARD_ARGS(CFAROp)
 
   CFAROp() = default;
+  ~CFAROp();
 
   void setup(OperatorSpec& spec) override;
   void initialize() override;
+  void stop() override;
 
   /**
    * @brief Stage 4 - Constant False Alarm Rate (CFAR) Detector - averaging or median
@@ -230,14 +339,13 @@ class CFAROp : public Operator {
    * guard cells form a hole within the training window, but CA-CFAR is
    * largely just an averaging filter otherwise with a threshold check
    * at each pixel after applying the filter.
-   * Currently, the window below is defined statically because it is then
-   * easy to visualize, but more typically the number of guard and
-   * reference cells would be given as input and the window would be
-   * constructed; we could update to such an approach, but I'm keeping
-   * it simple for now.
-
-   * We apply CFAR to the power of X; X is still complex until this point
-   * Xpow = abs(X).^2;
+
+   * The guard and training sizes are parameters. CA-CFAR sums the window
+   * from a summed-area table of Xpow = abs(X).^2, so its cost does not
+   * depend on the window size. OS-CFAR instead uses the cfar_os_rank-th
+   * training cell in sorted order, which is robust to interfering targets
+   * in the training cells. Cells above the threshold are compacted into a
+   * list of CFARDetection rather than a dense mask.
    */
   void compute(InputContext& op_input, OutputContext&, ExecutionContext&) override;
 
@@ -247,18 +355,74 @@ class CFAROp : public Operator {
   Parameter<int64_t> num_samples;
   Parameter<int64_t> waveform_length;
   Parameter<int64_t> num_channels;
+  Parameter<uint32_t> num_cpi_buffers;
+  CFARParams cfar_params;
+  CFARConfig cfar;
   index_t numCompressedSamples;
   index_t num_pulses_rnd;
-  const index_t cfarMaskX = 13;
-  const index_t cfarMaskY = 5;
-  static const constexpr float pfa = 1e-5f;
   size_t transmits;
+  size_t last_slot = 0;
 
-  tensor_t<float_t, 3> normT;
-  tensor_t<float_t, 3> ba;
-  tensor_t<int, 3> dets;
-  tensor_t<float_t, 3> xPow;
-  tensor_t<float_t, 2> cfarMaskView;
+  tensor_t<float_t, 1> osAlpha;
+  std::vector<CFARBuffers> cfar_bufs;
 };  // CFAROp
 
+class RadarProcessingOp : public Operator {
+ public:
+  HOLOSCAN_OPERATOR_FORWARD_ARGS(RadarProcessingOp)
+
+  RadarProcessingOp() = default;
+  ~RadarProcessingOp();
+
+  void setup(OperatorSpec& spec) override;
+  void initialize() override;
+  void start() override;
+  void stop() override;
+
+  /**
+   * @brief All four stages - pulse compression, three-pulse canceller, Doppler and CFAR -
+   * in one operator
+   *
+   * The shapes are fixed by the configuration, so start() runs every stage once on zeroed
+   * buffers, which creates the FFT plans, and with use_cuda_graph captures the per-CPI
+   * sequence of MatX calls into a CUDA graph. Each CPI copies its input into the
+   * zero-padded buffer and replays the graph, with one launch instead of one per MatX call.
+   * Each CPI slot has its own buffers, so it gets its own graph.
+   */
+  void compute(InputContext& op_input, OutputContext&, ExecutionContext&) override;
+
+ private:
+  void run_stages(size_t slot, cudaStream_t stream);
+  void warm_up(size_t slot, cudaStream_t stream);
+  void capture_graph(size_t slot);
+
+  Parameter<uint16_t> num_transmits;
+  Parameter<int64_t> num_pulses;
+  Parameter<int64_t> num_samples;
+  Parameter<int64_t> waveform_length;
+  Parameter<int64_t> num_channels;
+  Parameter<bool> use_cuda_graph;
+  Parameter<uint32_t> num_cpi_buffers;
+  CFARParams cfar_params;
+  CFARConfig cfar;
+  index_t num_samples_rnd;
+  index_t numCompressedSamples;
+  index_t num_pulses_rnd;
+  size_t transmits;
+  size_t last_slot = 0;
+
+  tensor_t<complex_t, 1> waveformView;
+  tensor_t<complex_t, 0> norms;
+  tensor_t<float_t, 1> cancelMask;
+  tensor_t<float_t, 1> osAlpha;
+  std::vector<tensor_t<complex_t, 3>> zeroPaddedInput;
+  std::vector<tensor_t<complex_t, 3>> tpcView;
+  std::vector<CFARBuffers> cfar_bufs;
+  CPISlots slots;
+
+  cudaStream_t capture_stream = nullptr;
+  std::vector<cudaGraphExec_t> graph_exec;
+  bool graph_failed = false;
+};  // RadarProcessingOp
+
 }  // namespace holoscan::ops
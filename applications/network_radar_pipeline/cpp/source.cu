@@ -16,16 +16,79 @@
  */
 #include "source.h"
 
-#include <chrono>
+#include <curand_kernel.h>
+#include <cmath>
+#include <random>
+#include <thread>
 
 namespace holoscan::ops {
 
+namespace {
+constexpr int sim_threads = 256;
+constexpr int max_targets = 64;
+constexpr float chirp_sweep = 0.5f;  // LFM sweep over the waveform, in cycles per sample
+
+// The targets are passed by value, with their Doppler phase at the first pulse of the CPI
+struct SimScene {
+  SimTarget targets[max_targets];
+  float doppler_phase[max_targets];
+  int num_targets;
+};
+
+/**
+ * One sample per thread: noise that changes every CPI, clutter that is the same on every
+ * pulse so the MTI filter removes it, and the LFM echo of every target covering the sample.
+ * Philox counters are indexed by sample, so the output only depends on the seed and CPI.
+ */
+__global__ void simulate_kernel(complex_t* __restrict__ out,
+                                index_t num_pulses,
+                                index_t num_samples,
+                                index_t waveform_length,
+                                SimScene scene,
+                                uint64_t seed,
+                                uint64_t cpi,
+                                float noise_sigma,
+                                float clutter_sigma) {
+  const index_t n = static_cast<index_t>(blockIdx.x) * blockDim.x + threadIdx.x;
+  const index_t p = blockIdx.y;
+  const index_t c = blockIdx.z;
+  if (n >= num_samples) { return; }
+
+  curandStatePhilox4_32_10_t state;
+  curand_init(seed, (c * num_pulses + p) * num_samples + n, cpi * 4, &state);
+  const float2 noise = curand_normal2(&state);
+  curand_init(~seed, c * num_samples + n, 0, &state);
+  const float2 clutter = curand_normal2(&state);
+
+  float re = noise_sigma * noise.x + clutter_sigma * clutter.x;
+  float im = noise_sigma * noise.y + clutter_sigma * clutter.y;
+
+  for (int t = 0; t < scene.num_targets; t++) {
+    const SimTarget& tgt = scene.targets[t];
+    const index_t k = n - tgt.range_bin;
+    if (k < 0 || k >= waveform_length) { continue; }
+
+    const float kf = static_cast<float>(k);
+    float phase = 0.5f * chirp_sweep * kf * kf / waveform_length;
+    phase += scene.doppler_phase[t] + tgt.doppler * p + tgt.steering * c;
+    phase -= floorf(phase);
+
+    float s, co;
+    sincospif(2.f * phase, &s, &co);
+    re += tgt.amplitude * co;
+    im += tgt.amplitude * s;
+  }
+
+  out[(c * num_pulses + p) * num_samples + n] = complex_t(re, im);
+}
+}  // namespace
+
 // ----- TargetSimulator ------------------------------------------------------
 void TargetSimulator::setup(OperatorSpec& spec) {
   spec.output<std::shared_ptr<RFChannel>>("rf_out");
   spec.param(data_rate, "data_rate",
               "Data rate to generate data (Gbps)",
-              "Operates by sleeping before emitting a single channel", {});
+              "Sustained rate channels are emitted at, 0 to emit as fast as possible", {});
   spec.param(num_transmits, "num_transmits",
               "Number of waveform transmissions",
               "Number of waveform transmissions to simulate", {});
@@ -44,39 +107,114 @@ void TargetSimulator::setup(OperatorSpec& spec) {
               "num_samples",
               "Number of samples",
               "Number of samples per channel", {});
+  spec.param(num_targets,
+              "num_targets",
+              "Number of targets",
+              "Number of point targets in the simulated scene", static_cast<uint16_t>(8));
+  spec.param(seed,
+              "seed",
+              "Random seed",
+              "Seed of the scene, noise and clutter", static_cast<uint64_t>(1));
+  spec.param(noise_power,
+              "noise_power",
+              "Noise power",
+              "Power of the complex Gaussian noise per sample", 1.0f);
+  spec.param(clutter_power,
+              "clutter_power",
+              "Clutter power",
+              "Power of the stationary clutter per sample", 100.0f);
+  spec.param(min_snr_db,
+              "min_snr_db",
+              "Minimum target SNR",
+              "Lowest per-sample SNR of a target in dB", 0.0f);
+  spec.param(max_snr_db,
+              "max_snr_db",
+              "Maximum target SNR",
+              "Highest per-sample SNR of a target in dB", 20.0f);
 }
 
 void TargetSimulator::initialize() {
   HOLOSCAN_LOG_INFO("TargetSimulator::initialize()");
   holoscan::Operator::initialize();
 
+  if (num_targets.get() > max_targets) {
+    throw std::runtime_error(fmt::format("At most {} targets can be simulated", max_targets));
+  }
+  if (waveform_length.get() > num_samples.get()) {
+    throw std::runtime_error("waveform_length must not exceed num_samples");
+  }
+
   cudaStreamCreateWithFlags(&stream, cudaStreamNonBlocking);
   transmit_count = 0;
   channel_idx = 0;
 
-  /**
-   * This is a rudimentary formula to account for the fact that there is unaccounted for
-   * processing outside of this Operator. Without it, the true data rate when set to higher
-   * values will skew low.
-   */
-  double modifier = 1;
-  int lowest_realtime = 20;  // Lowest data rate modifier is necessary
-  if (data_rate.get() > lowest_realtime) {
-    double diff = 0.0015 * static_cast<double>(data_rate.get() - lowest_realtime);
-    modifier = modifier > diff ? modifier - diff : 0;
+  // Period of one channel to achieve the desired data rate
+  bits_per_channel = 8.0 * num_samples.get() * num_pulses.get() * sizeof(complex_t);
+  channel_period = std::chrono::nanoseconds(0);
+  if (data_rate.get() > 0) {
+    channel_period = std::chrono::nanoseconds(
+        static_cast<int64_t>(bits_per_channel / data_rate.get()));
   }
 
-  // Compute how long to sleep to achieve desired data rate
-  double bits_per_channel = 8 * num_samples.get() * num_pulses.get() * sizeof(complex_t);
-  double tsleep_sec = bits_per_channel / static_cast<double>(1e9 * data_rate.get());
-  tsleep_us = static_cast<int>(modifier * tsleep_sec * 1e6);
+  // Place the targets, from the seed only
+  std::mt19937_64 rng(seed.get());
+  std::uniform_int_distribution<int32_t> range_dist(0, num_samples.get() - waveform_length.get());
+  std::uniform_real_distribution<float> doppler_dist(-0.5f, 0.5f);
+  std::uniform_real_distribution<float> angle_dist(-M_PI / 3, M_PI / 3);
+  std::uniform_real_distribution<float> snr_dist(min_snr_db.get(), max_snr_db.get());
+  targets.resize(num_targets.get());
+  for (auto& tgt : targets) {
+    tgt.range_bin = range_dist(rng);
+    tgt.doppler = doppler_dist(rng);
+    // Half-wavelength element spacing
+    tgt.steering = 0.5f * std::sin(angle_dist(rng));
+    tgt.amplitude = std::sqrt(noise_power.get() * std::pow(10.f, snr_dist(rng) / 10.f));
+    HOLOSCAN_LOG_INFO("Target at range bin {}, Doppler {:.3f} cycles/pulse, amplitude {:.2f}",
+                      tgt.range_bin, tgt.doppler, tgt.amplitude);
+  }
 
-  // Initialize tensor
-  make_tensor(simSignal, {num_channels.get(), num_pulses.get(), num_samples.get()});
-  simSignal.PrefetchDevice(stream);
+  // Initialize tensors
+  for (auto& sig : simSignal) {
+    make_tensor(sig, {num_channels.get(), num_pulses.get(), num_samples.get()});
+    sig.PrefetchDevice(stream);
+  }
   HOLOSCAN_LOG_INFO("TargetSimulator::initialize() done");
 }
 
+void TargetSimulator::simulate(tensor_t<complex_t, 3>& signal) {
+  SimScene scene;
+  scene.num_targets = static_cast<int>(targets.size());
+  for (size_t t = 0; t < targets.size(); t++) {
+    scene.targets[t] = targets[t];
+    // Keep the Doppler phase continuous across CPIs without losing float precision
+    const double phase = static_cast<double>(targets[t].doppler) *
+                         static_cast<double>(transmit_count) * num_pulses.get();
+    scene.doppler_phase[t] = static_cast<float>(phase - std::floor(phase));
+  }
+
+  const dim3 grid((num_samples.get() + sim_threads - 1) / sim_threads,
+                  num_pulses.get(),
+                  num_channels.get());
+  simulate_kernel<<<grid, sim_threads, 0, stream>>>(signal.Data(),
+                                                    num_pulses.get(),
+                                                    num_samples.get(),
+                                                    waveform_length.get(),
+                                                    scene,
+                                                    seed.get(),
+                                                    transmit_count,
+                                                    std::sqrt(noise_power.get() / 2),
+                                                    std::sqrt(clutter_power.get() / 2));
+}
+
+void TargetSimulator::stop() {
+  if (channels_sent < 2) { return; }
+  // The first channel starts the clock, so it is not counted
+  const double elapsed = std::chrono::duration<double>(
+      std::chrono::steady_clock::now() - first_emit).count();
+  HOLOSCAN_LOG_INFO("TargetSimulator sent {} channels at {:.2f} Gbps", channels_sent,
+                    (channels_sent - 1) * bits_per_channel / elapsed / 1e9);
+}
+
 void TargetSimulator::compute(InputContext&,
                               OutputContext& op_output,
                               ExecutionContext& context) {
@@ -85,30 +223,33 @@ void TargetSimulator::compute(InputContext&,
     return;
   }
 
-  std::chrono::steady_clock::time_point sim_start = std::chrono::steady_clock::now();
-
   HOLOSCAN_LOG_INFO("TargetSimulator::compute() - simulation {} of {}, channel {} of {}",
     transmit_count+1, num_transmits.get(), channel_idx+1, num_channels.get());
 
+  auto& signal = simSignal[transmit_count % 2];
   if (channel_idx == 0) {
-    // todo Simulate targets
-    auto sig_real = simSignal.RealView();
-    auto sig_imag = simSignal.ImagView();
-    (sig_real = sig_real + ones(sig_real.Shape())).run(stream);
-    (sig_imag = sig_imag + 2 * ones(sig_imag.Shape())).run(stream);
+    simulate(signal);
   }
 
-  // Subtract time spent simulating from channel sleep time
-  std::chrono::steady_clock::time_point sim_end = std::chrono::steady_clock::now();
-  auto sim_dt = std::chrono::duration_cast<std::chrono::microseconds>(sim_end - sim_start).count();
-  if (tsleep_us > sim_dt) {
-    usleep(tsleep_us - sim_dt);
+  // Emit on a fixed schedule, so time spent outside this operator does not lower the rate.
+  // After a stall, at most one CPI worth of channels is sent back to back to catch up.
+  const auto now = std::chrono::steady_clock::now();
+  if (channels_sent == 0) {
+    first_emit = now;
+    next_emit = now;
+  }
+  if (channel_period.count() > 0) {
+    const auto backlog = channel_period * num_channels.get();
+    if (next_emit + backlog < now) { next_emit = now - backlog; }
+    if (now < next_emit) { std::this_thread::sleep_until(next_emit); }
+    next_emit += channel_period;
   }
 
-  auto channel_data = simSignal.Slice<2>({channel_idx, 0, 0},
-                                         {matxDropDim, matxEnd, matxEnd});
+  auto channel_data = signal.Slice<2>({channel_idx, 0, 0},
+                                      {matxDropDim, matxEnd, matxEnd});
   auto params = std::make_shared<RFChannel>(channel_data, transmit_count, channel_idx, stream);
   op_output.emit(params, "rf_out");
+  channels_sent++;
 
   channel_idx++;
   if (channel_idx == num_channels.get()) {
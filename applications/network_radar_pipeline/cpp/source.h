@@ -18,8 +18,27 @@
 
 #include "common.h"
 
+#include <chrono>
+#include <vector>
+
 namespace holoscan::ops {
 
+// A point target of the simulated scene
+struct SimTarget {
+  int32_t range_bin;  // Delay of the echo in samples
+  float doppler;      // Doppler shift in cycles per pulse
+  float amplitude;
+  float steering;     // Phase step across channels in cycles, from the target's angle
+};
+
+/**
+ * @brief Synthetic radar source for load testing the receive side
+ *
+ * Each CPI is generated on the GPU: the echoes of num_targets point targets of an LFM
+ * waveform, each with its own delay, Doppler and angle, over stationary clutter and
+ * complex Gaussian noise. The scene and the noise come from seed only, so runs are
+ * reproducible. Channels are emitted on a schedule that sustains data_rate Gbps.
+ */
 class TargetSimulator : public Operator {
  public:
   HOLOSCAN_OPERATOR_FORWARD_ARGS(TargetSimulator)
@@ -29,22 +48,39 @@ class TargetSimulator : public Operator {
 
   void setup(OperatorSpec& spec) override;
   void initialize() override;
+  void stop() override;
   void compute(InputContext&, OutputContext& op_output, ExecutionContext&) override;
 
  private:
+  void simulate(tensor_t<complex_t, 3>& signal);
+
   cudaStream_t stream;
-  Parameter<int> data_rate;
+  Parameter<double> data_rate;
   Parameter<uint16_t> num_transmits;
   Parameter<uint16_t> num_pulses;
   Parameter<uint16_t> num_samples;
   Parameter<uint16_t> waveform_length;
   Parameter<uint16_t> num_channels;
   Parameter<uint16_t> samplesPerPkt;
+  Parameter<uint16_t> num_targets;
+  Parameter<uint64_t> seed;
+  Parameter<float> noise_power;
+  Parameter<float> clutter_power;
+  Parameter<float> min_snr_db;
+  Parameter<float> max_snr_db;
   index_t transmit_count;
   index_t channel_idx;
-  int tsleep_us;
 
-  tensor_t<complex_t, 3> simSignal;
+  // Rate pacing, one period per channel
+  std::chrono::nanoseconds channel_period;
+  std::chrono::steady_clock::time_point next_emit;
+  std::chrono::steady_clock::time_point first_emit;
+  size_t channels_sent = 0;
+  double bits_per_channel;
+
+  // One CPI is generated while the previous one may still be packetized
+  tensor_t<complex_t, 3> simSignal[2];
+  std::vector<SimTarget> targets;
 };
 
 };  // namespace holoscan::ops
@@ -0,0 +1,168 @@
+# SPDX-FileCopyrightText: Copyright (c) 2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+# SPDX-License-Identifier: Apache-2.0
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+"""Build a TensorRT engine of the Faster R-CNN detector for the `trt` detector path.
+
+The detector is exported to ONNX with fixed-size outputs (`--max_detections` rows, padded with
+zero scores) so the engine has static output shapes, then built with FP16 or with INT8 calibrated
+on frames of the recorded video the application replays.
+
+Example:
+    python3 build_trt_engine.py --data data/object_detection_torch --precision int8
+"""
+
+import argparse
+import os
+import sys
+
+import tensorrt as trt
+import torch
+from torchvision.models import ResNet50_Weights, detection
+from torchvision.models.detection import FasterRCNN_ResNet50_FPN_Weights
+
+sys.path.append(os.path.join(os.path.dirname(os.path.abspath(__file__)), "../../utilities"))
+from gxf_entity_codec import EntityReader  # noqa: E402
+
+DEVICE = torch.device("cuda")
+
+
+class FixedSizeDetector(torch.nn.Module):
+    """Faster R-CNN taking the HWC float frame of the format converter, with padded outputs."""
+
+    def __init__(self, max_detections):
+        super().__init__()
+        self.max_detections = max_detections
+        self.model = detection.fasterrcnn_resnet50_fpn(
+            weights=FasterRCNN_ResNet50_FPN_Weights.DEFAULT,
+            weights_backbone=ResNet50_Weights.DEFAULT,
+            box_detections_per_img=max_detections,
+        )
+
+    def forward(self, image):
+        detections = self.model([image.permute(2, 0, 1)])[0]
+        n = self.max_detections
+        boxes = torch.cat([detections["boxes"], detections["boxes"].new_zeros(n, 4)])[:n]
+        scores = torch.cat([detections["scores"], detections["scores"].new_zeros(n)])[:n]
+        labels = torch.cat([detections["labels"], detections["labels"].new_zeros(n)])[:n]
+        return boxes, labels.to(torch.int32), scores
+
+
+class VideoCalibrator(trt.IInt8EntropyCalibrator2):
+    """Feeds every `stride`-th frame of a GXF recording to the INT8 calibration."""
+
+    def __init__(self, reader, num_frames, stride, cache_file):
+        super().__init__()
+        self.reader = reader
+        self.indices = list(range(0, reader.num_entities, stride))[:num_frames]
+        self.cache_file = cache_file
+        self.batch = None
+
+    def get_batch_size(self):
+        return 1
+
+    def get_batch(self, names):
+        if not self.indices:
+            return None
+        frame = self.reader.get_frame(self.indices.pop(0))
+        # same scaling as the `detect_preprocessor` format converter
+        self.batch = torch.from_numpy(frame).to(DEVICE, torch.float32).div_(255.0).contiguous()
+        return [int(self.batch.data_ptr())]
+
+    def read_calibration_cache(self):
+        if os.path.exists(self.cache_file):
+            with open(self.cache_file, "rb") as f:
+                return f.read()
+        return None
+
+    def write_calibration_cache(self, cache):
+        with open(self.cache_file, "wb") as f:
+            f.write(cache)
+
+
+def export_onnx(onnx_file, height, width, max_detections):
+    model = FixedSizeDetector(max_detections).to(DEVICE).eval()
+    image = torch.rand(height, width, 3, device=DEVICE)
+    torch.onnx.export(
+        model,
+        (image,),
+        onnx_file,
+        opset_version=17,
+        input_names=["input"],
+        output_names=["boxes", "labels", "scores"],
+    )
+
+
+def build_engine(onnx_file, engine_file, precision, calibrator):
+    logger = trt.Logger(trt.Logger.INFO)
+    builder = trt.Builder(logger)
+    network = builder.create_network(1 << int(trt.NetworkDefinitionCreationFlag.EXPLICIT_BATCH))
+    parser = trt.OnnxParser(network, logger)
+    with open(onnx_file, "rb") as f:
+        if not parser.parse(f.read()):
+            for i in range(parser.num_errors):
+                print(parser.get_error(i), file=sys.stderr)
+            return False
+
+    config = builder.create_builder_config()
+    # layers without INT8 implementations (RoI align, NMS) fall back to FP16
+    config.set_flag(trt.BuilderFlag.FP16)
+    if precision == "int8":
+        config.set_flag(trt.BuilderFlag.INT8)
+        config.int8_calibrator = calibrator
+
+    serialized = builder.build_serialized_network(network, config)
+    if serialized is None:
+        return False
+    with open(engine_file, "wb") as f:
+        f.write(serialized)
+    return True
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("--data", required=True, help="Data directory of the application")
+    parser.add_argument("--basename", default="cars", help="Basename of the recorded video")
+    parser.add_argument("--precision", choices=["fp16", "int8"], default="int8")
+    parser.add_argument("--output", help="Engine file, default <data>/frcnn_resnet50_<precision>")
+    parser.add_argument("--max_detections", type=int, default=100)
+    parser.add_argument("--calibration_frames", type=int, default=200)
+    parser.add_argument("--calibration_stride", type=int, default=5)
+    args = parser.parse_args()
+
+    os.environ["TORCH_HOME"] = os.getcwd()
+    engine_file = args.output or os.path.join(
+        args.data, f"frcnn_resnet50_{args.precision}.engine"
+    )
+    onnx_file = os.path.join(args.data, "frcnn_resnet50_fixed.onnx")
+    cache_file = os.path.join(args.data, "frcnn_resnet50_int8.cache")
+
+    with EntityReader(directory=args.data, basename=args.basename) as reader:
+        height, width, _ = reader.get_frame(0).shape
+        if not os.path.exists(onnx_file):
+            export_onnx(onnx_file, height, width, args.max_detections)
+
+        calibrator = None
+        if args.precision == "int8":
+            calibrator = VideoCalibrator(
+                reader, args.calibration_frames, args.calibration_stride, cache_file
+            )
+        if not build_engine(onnx_file, engine_file, args.precision, calibrator):
+            print("TensorRT engine generation failed.", file=sys.stderr)
+            sys.exit(1)
+    print(f"TensorRT engine saved to '{engine_file}'.")
+
+
+if __name__ == "__main__":
+    main()
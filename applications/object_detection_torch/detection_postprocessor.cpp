@@ -0,0 +1,206 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "detection_postprocessor.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+#include <cuda_runtime.h>
+
+#define CUDA_TRY(stmt)                                                                       \
+  {                                                                                          \
+    cudaError_t cuda_status = stmt;                                                          \
+    if (cudaSuccess != cuda_status) {                                                        \
+      HOLOSCAN_LOG_ERROR("CUDA runtime call {} in line {} of file {} failed with '{}' ({})", \
+                         #stmt,                                                              \
+                         __LINE__,                                                           \
+                         __FILE__,                                                           \
+                         cudaGetErrorString(cuda_status),                                    \
+                         int(cuda_status));                                                  \
+      throw std::runtime_error("CUDA runtime call failed");                                  \
+    }                                                                                        \
+  }
+
+namespace holoscan::ops {
+
+void DetectionPostprocessorOp::setup(OperatorSpec& spec) {
+  spec.input<gxf::Entity>("in");
+  spec.output<gxf::Entity>("out");
+
+  spec.param(boxes_tensor_name_, "boxes_tensor_name", "Boxes", "Boxes tensor", std::string("boxes"));
+  spec.param(scores_tensor_name_, "scores_tensor_name", "Scores", "Scores tensor", std::string("scores"));
+  spec.param(labels_tensor_name_, "labels_tensor_name", "Labels", "Labels tensor", std::string("labels"));
+  spec.param(label_names_,
+             "label_names",
+             "Label Names",
+             "Name of each label id, starting with label id 1",
+             {});
+  spec.param(class_names_, "class_names", "Class Names", "Displayed classes", {});
+  spec.param(max_objects_,
+             "max_objects",
+             "Maximum Objects",
+             "Maximum number of displayed objects of each class",
+             {});
+  spec.param(threshold_, "threshold", "Threshold", "Minimum score of a detection", 0.75f);
+  spec.param(width_, "width", "Width", "Width of the detector input in pixels", 1920);
+  spec.param(height_, "height", "Height", "Height of the detector input in pixels", 1080);
+  spec.param(allocator_, "allocator", "Allocator", "Output Allocator");
+  cuda_stream_handler_.define_params(spec);
+}
+
+void DetectionPostprocessorOp::start() {
+  const auto& class_names = class_names_.get();
+  if (class_names.size() != max_objects_.get().size()) {
+    throw std::runtime_error("class_names and max_objects must have the same size");
+  }
+  if (class_names.size() > DetectionLayout::kMaxClasses) {
+    throw std::runtime_error(fmt::format("At most {} classes are supported",
+                                         DetectionLayout::kMaxClasses));
+  }
+
+  layout_ = DetectionLayout{};
+  layout_.num_classes = class_names.size();
+  layout_.threshold = threshold_.get();
+  layout_.scale_x = 1.f / width_.get();
+  layout_.scale_y = 1.f / height_.get();
+  size_t offset = 0;
+  for (int c = 0; c < layout_.num_classes; ++c) {
+    layout_.max_objects[c] = max_objects_.get()[c];
+    layout_.rect_offset[c] = offset;
+    offset += layout_.max_objects[c] * 2 * 2;
+    layout_.text_offset[c] = offset;
+    offset += layout_.max_objects[c] * 2;
+  }
+  output_size_ = offset * sizeof(float);
+
+  // map every label to its displayed class
+  const auto object_class = std::find(class_names.begin(), class_names.end(), "object");
+  std::vector<int16_t> label_classes;
+  for (const auto& label : label_names_.get()) {
+    auto it = std::find(class_names.begin(), class_names.end(), label);
+    if (it == class_names.end()) { it = object_class; }
+    label_classes.push_back(it == class_names.end() ? -1 : it - class_names.begin());
+  }
+  if (!label_classes.empty()) {
+    CUDA_TRY(cudaMalloc(&label_classes_, label_classes.size() * sizeof(int16_t)));
+    CUDA_TRY(cudaMemcpy(label_classes_,
+                        label_classes.data(),
+                        label_classes.size() * sizeof(int16_t),
+                        cudaMemcpyHostToDevice));
+  }
+}
+
+void DetectionPostprocessorOp::stop() {
+  if (label_classes_) {
+    cudaFree(label_classes_);
+    label_classes_ = nullptr;
+  }
+}
+
+void DetectionPostprocessorOp::compute(InputContext& op_input, OutputContext& op_output,
+                                       ExecutionContext& context) {
+  auto in_message = op_input.receive<gxf::Entity>("in").value();
+  if (cuda_stream_handler_.from_message(context.context(), in_message) != GXF_SUCCESS) {
+    throw std::runtime_error("Failed to get the CUDA stream from incoming messages");
+  }
+  const cudaStream_t stream = cuda_stream_handler_.get_cuda_stream(context.context());
+
+  auto& entity = static_cast<nvidia::gxf::Entity&>(in_message);
+  auto get_tensor = [&entity](const std::string& name) {
+    auto tensor = entity.get<nvidia::gxf::Tensor>(name.c_str());
+    if (!tensor) { throw std::runtime_error(fmt::format("Tensor '{}' not found", name)); }
+    if (tensor.value()->storage_type() != nvidia::gxf::MemoryStorageType::kDevice) {
+      throw std::runtime_error(fmt::format("Tensor '{}' must be on the device", name));
+    }
+    return tensor.value();
+  };
+  auto boxes = get_tensor(boxes_tensor_name_.get());
+  auto scores = get_tensor(scores_tensor_name_.get());
+  auto labels = get_tensor(labels_tensor_name_.get());
+
+  const int count = scores->element_count();
+  if (boxes->element_type() != nvidia::gxf::PrimitiveType::kFloat32 ||
+      scores->element_type() != nvidia::gxf::PrimitiveType::kFloat32 ||
+      boxes->element_count() != static_cast<uint64_t>(count) * 4 ||
+      labels->element_count() != static_cast<uint64_t>(count)) {
+    throw std::runtime_error("Expected float32 boxes [N, 4], float32 scores [N] and labels [N]");
+  }
+  const auto labels_type = labels->element_type();
+  if (labels_type != nvidia::gxf::PrimitiveType::kInt32 &&
+      labels_type != nvidia::gxf::PrimitiveType::kInt64) {
+    throw std::runtime_error("Labels must be int32 or int64");
+  }
+
+  auto out_message = nvidia::gxf::Entity::New(context.context());
+  if (!out_message) { throw std::runtime_error("Failed to allocate the output message"); }
+
+  if (output_size_ > 0) {
+    // the views share one allocation, returned to the allocator when the last view is released
+    auto allocator = allocator_.get();
+    nvidia::byte* output_ptr = allocator->allocate(output_size_, MemoryStorageType::kDevice);
+    if (!output_ptr) { throw std::runtime_error("Failed to allocate the output buffer"); }
+    std::shared_ptr<nvidia::byte> output(
+        output_ptr, [allocator](nvidia::byte* ptr) { allocator->free(ptr); });
+    float* output_data = reinterpret_cast<float*>(output_ptr);
+
+    CUDA_TRY(generate_boxes(layout_,
+                            static_cast<const float*>(boxes->pointer()),
+                            static_cast<const float*>(scores->pointer()),
+                            labels->pointer(),
+                            labels_type == nvidia::gxf::PrimitiveType::kInt64,
+                            count,
+                            label_classes_,
+                            label_names_.get().size(),
+                            output_data,
+                            stream));
+
+    const auto type = nvidia::gxf::PrimitiveType::kFloat32;
+    const auto bytes_per_element = nvidia::gxf::PrimitiveTypeSize(type);
+    auto add_view = [&](const std::string& name, int32_t rows, int offset) {
+      auto tensor = out_message.value().add<nvidia::gxf::Tensor>(name.c_str());
+      if (!tensor) { throw std::runtime_error("Failed to add the output tensor"); }
+      const nvidia::gxf::Shape shape{1, rows, 2};
+      if (!tensor.value()->wrapMemory(shape,
+                                      type,
+                                      bytes_per_element,
+                                      nvidia::gxf::ComputeTrivialStrides(shape, bytes_per_element),
+                                      nvidia::gxf::MemoryStorageType::kDevice,
+                                      output_data + offset,
+                                      [output](void*) mutable {
+                                        output.reset();
+                                        return nvidia::gxf::Success;
+                                      })) {
+        throw std::runtime_error(fmt::format("Failed to wrap tensor '{}'", name));
+      }
+    };
+    for (int c = 0; c < layout_.num_classes; ++c) {
+      const auto& name = class_names_.get()[c];
+      add_view(name, 2 * layout_.max_objects[c], layout_.rect_offset[c]);
+      add_view(name + "text", layout_.max_objects[c], layout_.text_offset[c]);
+    }
+  }
+
+  nvidia::gxf::Expected<nvidia::gxf::Entity> out(out_message.value());
+  cuda_stream_handler_.to_message(out);
+  auto result = gxf::Entity(std::move(out_message.value()));
+  op_output.emit(result, "out");
+}
+
+}  // namespace holoscan::ops
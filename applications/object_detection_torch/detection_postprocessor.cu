@@ -0,0 +1,89 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "detection_postprocessor.cuh"
+
+namespace holoscan::ops {
+
+namespace {
+
+// One thread per class walks the score-ordered detections, so the slots are filled in order
+template <typename LabelT>
+__global__ void generate_boxes_kernel(DetectionLayout layout, const float* boxes,
+                                      const float* scores, const LabelT* labels, int count,
+                                      const int16_t* label_classes, int num_labels,
+                                      float* output) {
+  const int c = threadIdx.x;
+  if (c >= layout.num_classes) { return; }
+
+  float* rects = output + layout.rect_offset[c];
+  float* texts = output + layout.text_offset[c];
+  const int max_objects = layout.max_objects[c];
+
+  int n = 0;
+  for (int i = 0; i < count && n < max_objects; ++i) {
+    if (scores[i] < layout.threshold) { continue; }
+    const int label = static_cast<int>(labels[i]) - 1;
+    if (label < 0 || label >= num_labels || label_classes[label] != c) { continue; }
+
+    const float x0 = boxes[4 * i + 0] * layout.scale_x;
+    const float y0 = boxes[4 * i + 1] * layout.scale_y;
+    rects[4 * n + 0] = x0;
+    rects[4 * n + 1] = y0;
+    rects[4 * n + 2] = boxes[4 * i + 2] * layout.scale_x;
+    rects[4 * n + 3] = boxes[4 * i + 3] * layout.scale_y;
+    texts[2 * n + 0] = x0;
+    texts[2 * n + 1] = y0;
+    ++n;
+  }
+  for (; n < max_objects; ++n) {
+    for (int k = 0; k < 4; ++k) { rects[4 * n + k] = -1.f; }
+    texts[2 * n + 0] = -1.f;
+    texts[2 * n + 1] = -1.f;
+  }
+}
+
+}  // namespace
+
+cudaError_t generate_boxes(const DetectionLayout& layout, const float* boxes, const float* scores,
+                           const void* labels, bool labels_are_64bit, int count,
+                           const int16_t* label_classes, int num_labels, float* output,
+                           cudaStream_t stream) {
+  const dim3 block(DetectionLayout::kMaxClasses);
+  if (labels_are_64bit) {
+    generate_boxes_kernel<<<1, block, 0, stream>>>(layout,
+                                                   boxes,
+                                                   scores,
+                                                   static_cast<const int64_t*>(labels),
+                                                   count,
+                                                   label_classes,
+                                                   num_labels,
+                                                   output);
+  } else {
+    generate_boxes_kernel<<<1, block, 0, stream>>>(layout,
+                                                   boxes,
+                                                   scores,
+                                                   static_cast<const int32_t*>(labels),
+                                                   count,
+                                                   label_classes,
+                                                   num_labels,
+                                                   output);
+  }
+  return cudaGetLastError();
+}
+
+}  // namespace holoscan::ops
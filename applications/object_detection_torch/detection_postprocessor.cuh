@@ -0,0 +1,70 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef OBJECT_DETECTION_TORCH_DETECTION_POSTPROCESSOR_CUH
+#define OBJECT_DETECTION_TORCH_DETECTION_POSTPROCESSOR_CUH
+
+#include <cuda_runtime.h>
+
+#include <cstdint>
+
+namespace holoscan::ops {
+
+/**
+ * @brief Placement of the per-class Holoviz tensors in the packed output buffer.
+ *
+ * Class `c` has `max_objects[c]` rectangles of two coordinates at `rect_offset[c]` and as many
+ * text positions at `text_offset[c]`, offsets are in floats.
+ */
+struct DetectionLayout {
+  static constexpr int kMaxClasses = 32;
+
+  int num_classes = 0;
+  int max_objects[kMaxClasses] = {};
+  int rect_offset[kMaxClasses] = {};
+  int text_offset[kMaxClasses] = {};
+  float threshold = 0.f;
+  // boxes are in pixels, Holoviz expects normalized coordinates
+  float scale_x = 1.f;
+  float scale_y = 1.f;
+};
+
+/**
+ * @brief Threshold the detections and scatter them into the fixed-size per-class tensors.
+ *
+ * Detections are taken in score order until a class is full, the remaining slots of a class are
+ * moved off-screen.
+ *
+ * @param layout output placement
+ * @param boxes [count, 4] boxes as x0, y0, x1, y1 in pixels
+ * @param scores [count] scores
+ * @param labels [count] 1-based label ids, int32 or int64
+ * @param labels_are_64bit true if `labels` is int64
+ * @param count number of detections
+ * @param label_classes class of each label id - 1, -1 to discard
+ * @param num_labels number of entries in `label_classes`
+ * @param output packed output buffer
+ * @param stream CUDA stream
+ */
+cudaError_t generate_boxes(const DetectionLayout& layout, const float* boxes, const float* scores,
+                           const void* labels, bool labels_are_64bit, int count,
+                           const int16_t* label_classes, int num_labels, float* output,
+                           cudaStream_t stream);
+
+}  // namespace holoscan::ops
+
+#endif /* OBJECT_DETECTION_TORCH_DETECTION_POSTPROCESSOR_CUH */
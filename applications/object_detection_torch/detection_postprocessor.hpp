@@ -0,0 +1,77 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef OBJECT_DETECTION_TORCH_DETECTION_POSTPROCESSOR_HPP
+#define OBJECT_DETECTION_TORCH_DETECTION_POSTPROCESSOR_HPP
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <holoscan/holoscan.hpp>
+#include <holoscan/utils/cuda_stream_handler.hpp>
+
+#include "detection_postprocessor.cuh"
+
+namespace holoscan::ops {
+
+/**
+ * @brief GPU post-processing of the Faster R-CNN detections for Holoviz.
+ *
+ * Replaces the host `generate_boxes` operation of the InferenceProcessorOp. Detections above
+ * `threshold` are scattered by class into fixed-size tensors, `<class>` with `max_objects`
+ * rectangles and `<class>text` with their label positions, all views of one device buffer
+ * written by a single kernel. Unused slots are moved off-screen, so Holoviz needs two layers per
+ * class instead of two per object.
+ *
+ * Labels not listed in `class_names` go to the `object` class when there is one.
+ */
+class DetectionPostprocessorOp : public holoscan::Operator {
+ public:
+  HOLOSCAN_OPERATOR_FORWARD_ARGS(DetectionPostprocessorOp)
+
+  DetectionPostprocessorOp() = default;
+
+  void setup(OperatorSpec& spec) override;
+  void start() override;
+  void stop() override;
+  void compute(InputContext& op_input, OutputContext& op_output,
+               ExecutionContext& context) override;
+
+ private:
+  Parameter<std::string> boxes_tensor_name_;
+  Parameter<std::string> scores_tensor_name_;
+  Parameter<std::string> labels_tensor_name_;
+  Parameter<std::vector<std::string>> label_names_;
+  Parameter<std::vector<std::string>> class_names_;
+  Parameter<std::vector<int32_t>> max_objects_;
+  Parameter<float> threshold_;
+  Parameter<int32_t> width_;
+  Parameter<int32_t> height_;
+  Parameter<std::shared_ptr<Allocator>> allocator_;
+
+  CudaStreamHandler cuda_stream_handler_;
+
+  DetectionLayout layout_;
+  size_t output_size_ = 0;
+  int16_t* label_classes_ = nullptr;
+};
+
+}  // namespace holoscan::ops
+
+#endif /* OBJECT_DETECTION_TORCH_DETECTION_POSTPROCESSOR_HPP */
@@ -17,6 +17,9 @@
 
 #include <getopt.h>
 
+#include <algorithm>
+#include <fstream>
+
 #include <holoscan/holoscan.hpp>
 #include <holoscan/operators/format_converter/format_converter.hpp>
 #include <holoscan/operators/holoviz/holoviz.hpp>
@@ -29,6 +32,8 @@
 #include <aja_source.hpp>
 #endif
 
+#include "detection_postprocessor.hpp"
+
 class App : public holoscan::Application {
  public:
   void set_source(const std::string &source) {
@@ -75,23 +80,23 @@ class App : public holoscan::Application {
                                               Arg("in_dtype") = in_dtype,
                                               Arg("pool") = pool_resource);
 
+    // "torch" runs the TorchScript model with the host post-processing, "trt" runs the TensorRT
+    // engine from build_trt_engine.py with the post-processing on the GPU
+    const bool trt_detector = from_config("detector").as<std::string>() == "trt";
+
     ops::InferenceOp::DataMap model_path_map;
-    std::string model_file_name = "frcnn_resnet50_t.pt";
+    std::string model_file_name = trt_detector ? from_config("trt_engine").as<std::string>()
+                                               : std::string("frcnn_resnet50_t.pt");
 
     model_path_map.insert("detect", datapath + "/" + model_file_name);
 
     auto detect_inference = make_operator<ops::InferenceOp>(
-        "detect_inference", from_config("detect_inference"),
+        "detect_inference",
+        from_config(trt_detector ? "detect_inference_trt" : "detect_inference"),
         Arg("model_path_map", model_path_map), Arg("allocator") = pool_resource);
 
     std::string processing_config_path = datapath+"/postprocessing.yaml";
 
-    auto detect_postprocessor =
-        make_operator<ops::InferenceProcessorOp>("detect_postprocessor",
-                                                   from_config("detect_postprocessor"),
-                                                   Arg("config_path", processing_config_path),
-                                                   Arg("allocator") = pool_resource);
-
     std::map<std::string, int> label_count;
     std::map<std::string, std::vector<float>> color_map;
 
@@ -143,33 +148,82 @@ class App : public holoscan::Application {
       }
     }
 
+    std::shared_ptr<Operator> detect_postprocessor;
+    if (trt_detector) {
+      std::vector<std::string> class_names;
+      std::vector<int32_t> max_objects;
+      size_t total_objects = 0;
+      for (const auto &[name, count] : label_count) {
+        class_names.push_back(name);
+        max_objects.push_back(count);
+        total_objects += count;
+      }
+      auto get_setting = [&configuration](const std::string &group, const std::string &key,
+                                          const std::string &default_value) {
+        auto group_it = configuration.find(group);
+        if (group_it == configuration.end()) { return default_value; }
+        auto it = group_it->second.find(key);
+        return it == group_it->second.end() ? default_value : it->second;
+      };
+
+      std::vector<std::string> label_names;
+      std::ifstream label_file(datapath + "/" + get_setting("params", "label_file", "labels.txt"));
+      for (std::string line; std::getline(label_file, line);) { label_names.push_back(line); }
+
+      detect_postprocessor = make_operator<ops::DetectionPostprocessorOp>(
+          "detect_postprocessor",
+          Arg("label_names", label_names),
+          Arg("class_names", class_names),
+          Arg("max_objects", max_objects),
+          Arg("threshold", std::stof(get_setting("params", "threshold", "0.75"))),
+          Arg("width", std::stoi(get_setting("display", "width", "1920"))),
+          Arg("height", std::stoi(get_setting("display", "height", "1080"))),
+          Arg("allocator") = make_resource<BlockMemoryPool>(
+              "detect_postprocessor_pool",
+              (int32_t)nvidia::gxf::MemoryStorageType::kDevice,
+              // two rectangle corners and a text position per displayed object
+              std::max<size_t>(total_objects, 1) * 3 * 2 * sizeof(float),
+              2),
+          Arg("cuda_stream_pool") = make_resource<CudaStreamPool>("cuda_stream", 0, 0, 0, 1, 5));
+    } else {
+      detect_postprocessor =
+          make_operator<ops::InferenceProcessorOp>("detect_postprocessor",
+                                                   from_config("detect_postprocessor"),
+                                                   Arg("config_path", processing_config_path),
+                                                   Arg("allocator") = pool_resource);
+    }
+
     size_t num_of_objects = 0;
     for (const auto &item : label_count) {
       num_of_objects += item.second;
     }
     std::cout << "Maximum number of items displayed in Holoviz: " << num_of_objects << std::endl;
-    std::vector<ops::HolovizOp::InputSpec> input_object_specs(1 + 2 * num_of_objects);
+    // the GPU post-processing emits one rectangle and one text tensor per class
+    size_t num_of_layers = trt_detector ? label_count.size() : num_of_objects;
+    std::vector<ops::HolovizOp::InputSpec> input_object_specs(1 + 2 * num_of_layers);
 
     int object_populated_so_far = 0;
     for (const auto &item : label_count) {
       auto key = item.first;
-      auto max_objects = item.second;
+      auto max_objects = trt_detector ? 1 : item.second;
 
       for (int u = 0; u < max_objects; u++) {
         int index = 2 * u + object_populated_so_far;
-        input_object_specs[index].tensor_name_ = key + std::to_string(u);
+        const std::string suffix = trt_detector ? std::string() : std::to_string(u);
+        input_object_specs[index].tensor_name_ = key + suffix;
         input_object_specs[index].priority_ = 1;
         input_object_specs[index].line_width_ = 4;
         input_object_specs[index].depth_map_render_mode_ =
             ops::HolovizOp::DepthMapRenderMode::POINTS;
         input_object_specs[index].type_ = ops::HolovizOp::InputType::RECTANGLES;
 
-        input_object_specs[index + 1].tensor_name_ = key + "text" + std::to_string(u);
+        input_object_specs[index + 1].tensor_name_ = key + "text" + suffix;
         input_object_specs[index + 1].priority_ = 1;
         input_object_specs[index + 1].depth_map_render_mode_ =
             ops::HolovizOp::DepthMapRenderMode::POINTS;
         input_object_specs[index + 1].type_ = ops::HolovizOp::InputType::TEXT;
-        input_object_specs[index + 1].text_ = {key};
+        input_object_specs[index + 1].text_ =
+            std::vector<std::string>(trt_detector ? item.second : 1, key);
 
         if (color_map.find(key) != color_map.end()) {
           input_object_specs[index].color_ = color_map.at(key);
@@ -220,8 +274,13 @@ class App : public holoscan::Application {
     }
 
     add_flow(detect_preprocessor, detect_inference, {{"", "receivers"}});
-    add_flow(detect_inference, detect_postprocessor, {{"transmitter", "receivers"}});
-    add_flow(detect_postprocessor, holoviz, {{"", "receivers"}});
+    if (trt_detector) {
+      add_flow(detect_inference, detect_postprocessor, {{"transmitter", "in"}});
+      add_flow(detect_postprocessor, holoviz, {{"out", "receivers"}});
+    } else {
+      add_flow(detect_inference, detect_postprocessor, {{"transmitter", "receivers"}});
+      add_flow(detect_postprocessor, holoviz, {{"", "receivers"}});
+    }
   }
 
  private:
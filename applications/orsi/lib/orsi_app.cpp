@@ -16,6 +16,7 @@
  */
 
 #include "orsi_app.hpp"
+#include "orsi_session_inference.hpp"
 
 
 #ifdef USE_VIDEOMASTER
@@ -131,6 +132,51 @@ void OrsiApp::initVideoSource(const  std::shared_ptr<holoscan::CudaStreamPool>&
     }
 }
 
+bool OrsiApp::multiSessionEnabled() {
+  for (const auto& yaml_node : config().yaml_nodes()) {
+    if (yaml_node["multi_session"]) { return from_config("multi_session.enabled").as<bool>(); }
+  }
+  return false;
+}
+
+void OrsiApp::initSessionSources() {
+  using namespace holoscan;
+
+  session_names = from_config("multi_session.sessions").as<std::vector<std::string>>();
+  const auto basenames = from_config("multi_session.basenames").as<std::vector<std::string>>();
+  if (session_names.empty() || basenames.size() != session_names.size()) {
+    throw std::runtime_error("multi_session needs one replayer basename per session");
+  }
+
+  // live capture cards are single stream, the sessions are replayed
+  session_sources.clear();
+  for (size_t i = 0; i < session_names.size(); i++) {
+    session_sources.push_back(make_operator<ops::VideoStreamReplayerOp>(
+        "replayer_" + session_names[i],
+        from_config("replayer"),
+        Arg("basename", basenames[i]),
+        Arg("directory", datapath)));
+  }
+}
+
+std::shared_ptr<holoscan::Operator> OrsiApp::makeSessionInference(
+    const std::string& name, const std::shared_ptr<holoscan::Allocator>& allocator) {
+  using namespace holoscan;
+
+  std::vector<std::string> model_paths;
+  for (const auto& model : from_config("multi_session.models").as<std::vector<std::string>>()) {
+    model_paths.push_back(datapath + "/models/" + model);
+  }
+  return make_operator<ops::orsi::SessionInferenceOp>(
+      name,
+      from_config("session_inference"),
+      Arg("session_names", session_names),
+      Arg("model_paths", model_paths),
+      Arg("slo_ms", from_config("multi_session.slo_ms").as<std::vector<double>>()),
+      Arg("engine_cache_dir", datapath + "/engines"),
+      Arg("allocator") = allocator);
+}
+
 /** Helper function to parse the command line arguments */
 bool parse_arguments(int argc, char** argv, std::string& config_name, std::string& data_path) {
   static struct option long_options[] = {{"data", required_argument, 0, 'd'}, {0, 0, 0, 0}};
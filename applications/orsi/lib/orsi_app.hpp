@@ -21,6 +21,7 @@
 #include <format_converter.hpp>
 
 #include <string>
+#include <vector>
 
 enum class VideoSource {
   REPLAYER,
@@ -50,6 +51,18 @@ class OrsiApp : public holoscan::Application {
   // initialize video
   void initVideoSource(const std::shared_ptr<holoscan::CudaStreamPool>& cuda_stream_pool);
 
+  // Multi-session mode: one replayer per session (OR) and the models shared between them
+  std::vector<std::string> session_names;
+  std::vector<std::shared_ptr<holoscan::Operator>> session_sources;
+
+  // true when the multi_session section of the config is enabled
+  bool multiSessionEnabled();
+  // initialize the video of every session of the multi_session section
+  void initSessionSources();
+  // make the operator running `model_paths` of multi_session for all the sessions at once
+  std::shared_ptr<holoscan::Operator> makeSessionInference(
+      const std::string& name, const std::shared_ptr<holoscan::Allocator>& allocator);
+
  public:
   void set_source(const std::string& source);
   void set_datapath(const std::string& path);
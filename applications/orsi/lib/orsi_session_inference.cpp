@@ -0,0 +1,449 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "orsi_session_inference.hpp"
+
+#include <algorithm>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace holoscan::ops::orsi {
+
+namespace {
+
+// The ports depend on session_names, read from the arguments given before setup()
+std::vector<std::string> session_names_arg(const std::vector<holoscan::Arg>& args) {
+  for (const auto& arg : args) {
+    if (arg.name() != "session_names") { continue; }
+    const std::any& value = arg.value();
+    if (value.type() == typeid(YAML::Node)) {
+      return std::any_cast<YAML::Node>(value).as<std::vector<std::string>>();
+    }
+    if (value.type() == typeid(std::vector<std::string>)) {
+      return std::any_cast<std::vector<std::string>>(value);
+    }
+  }
+  return {};
+}
+
+size_t element_size(nvinfer1::DataType type) {
+  switch (type) {
+    case nvinfer1::DataType::kFLOAT:
+      return sizeof(float);
+    case nvinfer1::DataType::kHALF:
+      return sizeof(uint16_t);
+    default:
+      throw std::runtime_error("The network input and output must be float32 or float16");
+  }
+}
+
+// Elements of one batch entry, `dims` without its batch dimension when `batched`
+size_t volume(const nvinfer1::Dims& dims, bool batched) {
+  size_t count = 1;
+  for (int i = batched ? 1 : 0; i < dims.nbDims; ++i) { count *= std::max<int64_t>(dims.d[i], 1); }
+  return count;
+}
+
+}  // namespace
+
+SessionSloTracker::SessionSloTracker(std::vector<double> slo_ms, size_t num_tiers, size_t window,
+                                     double percentile, double recover_ratio)
+    : slo_ms_(std::move(slo_ms)),
+      num_tiers_(std::max<size_t>(num_tiers, 1)),
+      window_(std::max<size_t>(window, 1)),
+      percentile_(std::clamp(percentile, 0.0, 1.0)),
+      recover_ratio_(recover_ratio),
+      recent_(slo_ms_.size()),
+      all_(slo_ms_.size()),
+      violations_(slo_ms_.size(), 0),
+      tier_frames_(num_tiers_, 0) {}
+
+double SessionSloTracker::percentile_ms(const std::deque<double>& samples) const {
+  if (samples.empty()) { return 0.0; }
+  std::vector<double> sorted(samples.begin(), samples.end());
+  const size_t rank = std::min(sorted.size() - 1, static_cast<size_t>(percentile_ * sorted.size()));
+  std::nth_element(sorted.begin(), sorted.begin() + rank, sorted.end());
+  return sorted[rank];
+}
+
+bool SessionSloTracker::record(const std::vector<double>& latency_ms) {
+  tier_frames_[tier_]++;
+  for (size_t s = 0; s < slo_ms_.size() && s < latency_ms.size(); ++s) {
+    recent_[s].push_back(latency_ms[s]);
+    if (recent_[s].size() > window_) { recent_[s].pop_front(); }
+    all_[s].push_back(latency_ms[s]);
+    if (latency_ms[s] > slo_ms_[s]) { violations_[s]++; }
+  }
+  if (slo_ms_.empty() || recent_[0].size() < window_) { return false; }
+
+  bool missed = false;
+  bool recovered = true;
+  for (size_t s = 0; s < slo_ms_.size(); ++s) {
+    const double latency = percentile_ms(recent_[s]);
+    missed |= latency > slo_ms_[s];
+    recovered &= latency < recover_ratio_ * slo_ms_[s];
+  }
+
+  size_t tier = tier_;
+  if (missed && tier_ + 1 < num_tiers_) {
+    tier = tier_ + 1;
+  } else if (recovered && tier_ > 0) {
+    tier = tier_ - 1;
+  }
+  if (tier == tier_) { return false; }
+
+  // A new window is observed before changing again, the latencies of the old tier don't apply
+  tier_ = tier;
+  for (auto& samples : recent_) { samples.clear(); }
+  return true;
+}
+
+void SessionSloTracker::report(const std::vector<std::string>& session_names) const {
+  for (size_t s = 0; s < all_.size(); ++s) {
+    if (all_[s].empty()) { continue; }
+    std::vector<double> sorted = all_[s];
+    std::sort(sorted.begin(), sorted.end());
+    auto at = [&](double p) {
+      return sorted[std::min(sorted.size() - 1, static_cast<size_t>(p * sorted.size()))];
+    };
+    HOLOSCAN_LOG_INFO(
+        "Session {}: {} frames, latency p50 {:.2f} ms, p95 {:.2f} ms, max {:.2f} ms, "
+        "{} over the SLO of {:.2f} ms",
+        s < session_names.size() ? session_names[s] : std::to_string(s),
+        sorted.size(),
+        at(0.5),
+        at(0.95),
+        sorted.back(),
+        violations_[s],
+        slo_ms_[s]);
+  }
+  for (size_t t = 0; t < tier_frames_.size(); ++t) {
+    HOLOSCAN_LOG_INFO("Model tier {}: {} batches", t, tier_frames_[t]);
+  }
+}
+
+void SessionInferenceOp::setup(OperatorSpec& spec) {
+  const auto session_names = session_names_arg(args());
+  input_names_.clear();
+  for (size_t i = 0; i < session_names.size(); ++i) {
+    input_names_.push_back("in_" + std::to_string(i));
+    spec.input<gxf::Entity>(input_names_.back());
+  }
+  spec.output<gxf::Entity>("transmitter");
+
+  spec.param(model_paths_,
+             "model_paths",
+             "ModelPaths",
+             "Paths of the ONNX models, from the most accurate to the cheapest.");
+  spec.param(session_names_, "session_names", "SessionNames", "Names of the sessions.");
+  spec.param(engine_cache_dir_,
+             "engine_cache_dir",
+             "EngineCacheDir",
+             "Directory of the TensorRT engines built from the models.");
+  spec.param(enable_fp16_, "enable_fp16", "EnableFP16", "Build the engines with FP16.", false);
+  spec.param(in_tensor_name_,
+             "in_tensor_name",
+             "InputTensorName",
+             "Name of the preprocessed tensor of each session.");
+  spec.param(out_tensor_name_,
+             "out_tensor_name",
+             "OutputTensorName",
+             "Prefix of the output tensors, suffixed with the session index.");
+  spec.param(slo_ms_,
+             "slo_ms",
+             "SLO",
+             "Latency SLO of each session in ms, or one SLO for all the sessions.",
+             std::vector<double>{50.0});
+  spec.param(slo_window_,
+             "slo_window",
+             "SLOWindow",
+             "Batches over which the latency percentile is taken before changing the model.",
+             60U);
+  spec.param(slo_percentile_,
+             "slo_percentile",
+             "SLOPercentile",
+             "Latency percentile checked against the SLO.",
+             0.95);
+  spec.param(recover_ratio_,
+             "recover_ratio",
+             "RecoverRatio",
+             "Fraction of the SLO under which the more accurate model is used again.",
+             0.5);
+  spec.param(allocator_, "allocator", "Allocator", "Allocator of the output tensors.");
+
+  cuda_stream_handler_.define_params(spec);
+}
+
+void SessionInferenceOp::load_tier(Tier& tier) {
+  const std::vector<char> plan = trt_engine::load_or_build_engine(
+      logger_, engine_cache_dir_.get(), tier.model_path, batch_size_, enable_fp16_.get());
+
+  tier.engine.reset(runtime_->deserializeCudaEngine(plan.data(), plan.size()));
+  if (!tier.engine) {
+    throw std::runtime_error(fmt::format("Failed to load the engine of {}", tier.model_path));
+  }
+  tier.context.reset(tier.engine->createExecutionContext());
+  if (!tier.context) { throw std::runtime_error("Failed to create the execution context"); }
+
+  for (int i = 0; i < tier.engine->getNbIOTensors(); ++i) {
+    const char* name = tier.engine->getIOTensorName(i);
+    auto& binding_name =
+        tier.engine->getTensorIOMode(name) == nvinfer1::TensorIOMode::kINPUT ? tier.input_name
+                                                                             : tier.output_name;
+    if (!binding_name.empty()) {
+      throw std::runtime_error(
+          fmt::format("The network {} must have a single input and output", tier.model_path));
+    }
+    binding_name = name;
+  }
+  if (tier.input_name.empty() || tier.output_name.empty()) {
+    throw std::runtime_error(
+        fmt::format("The network {} must have an input and an output", tier.model_path));
+  }
+  if (tier.engine->getTensorDataType(tier.input_name.c_str()) != nvinfer1::DataType::kFLOAT) {
+    throw std::runtime_error(fmt::format("The input of {} must be float32", tier.model_path));
+  }
+
+  // a static batch of 1 is run once per session
+  nvinfer1::Dims input_dims = tier.engine->getTensorShape(tier.input_name.c_str());
+  const bool dynamic_batch = input_dims.nbDims == 4 && input_dims.d[0] == -1;
+  if (dynamic_batch) {
+    input_dims.d[0] = batch_size_;
+    tier.context->setInputShape(tier.input_name.c_str(), input_dims);
+  } else if (input_dims.nbDims == 4 && input_dims.d[0] != 1) {
+    throw std::runtime_error(
+        fmt::format("The batch of {} must be dynamic or 1", tier.model_path));
+  }
+  nvinfer1::Dims output_dims = tier.context->getTensorShape(tier.output_name.c_str());
+  tier.input_size = volume(input_dims, input_dims.nbDims == 4);
+  tier.output_size = volume(output_dims, output_dims.nbDims == 4);
+  tier.output_type = tier.engine->getTensorDataType(tier.output_name.c_str());
+  tier.output_dims = output_dims;
+  if (output_dims.nbDims == 4) {
+    // drop the batch dimension
+    for (int i = 1; i < output_dims.nbDims; ++i) { tier.output_dims.d[i - 1] = output_dims.d[i]; }
+    tier.output_dims.nbDims = output_dims.nbDims - 1;
+  }
+
+  if (cudaMalloc(&tier.input_binding, tier.input_size * sizeof(float) * batch_size_) !=
+          cudaSuccess ||
+      cudaMalloc(&tier.output_binding,
+                 tier.output_size * element_size(tier.output_type) * batch_size_) != cudaSuccess) {
+    throw std::runtime_error("Failed to allocate the network bindings");
+  }
+  tier.context->setTensorAddress(tier.input_name.c_str(), tier.input_binding);
+  tier.context->setTensorAddress(tier.output_name.c_str(), tier.output_binding);
+}
+
+void SessionInferenceOp::start() {
+  batch_size_ = static_cast<int>(session_names_.get().size());
+  if (batch_size_ == 0 || static_cast<size_t>(batch_size_) != input_names_.size()) {
+    throw std::runtime_error("session_names must name at least one session");
+  }
+  if (model_paths_.get().empty()) { throw std::runtime_error("model_paths must not be empty"); }
+
+  std::vector<double> slo_ms = slo_ms_.get();
+  if (slo_ms.size() == 1) { slo_ms.resize(batch_size_, slo_ms[0]); }
+  if (slo_ms.size() != static_cast<size_t>(batch_size_)) {
+    throw std::runtime_error("slo_ms must have one SLO, or one per session");
+  }
+
+  runtime_.reset(nvinfer1::createInferRuntime(logger_));
+  tiers_.clear();
+  tiers_.resize(model_paths_.get().size());
+  for (size_t t = 0; t < tiers_.size(); ++t) {
+    tiers_[t].model_path = model_paths_.get()[t];
+    load_tier(tiers_[t]);
+    const Tier& first = tiers_.front();
+    if (tiers_[t].input_size != first.input_size || tiers_[t].output_size != first.output_size ||
+        tiers_[t].output_type != first.output_type) {
+      throw std::runtime_error(
+          fmt::format("The model {} must have the input and output shapes of {}",
+                      tiers_[t].model_path,
+                      first.model_path));
+    }
+  }
+
+  slo_tracker_ = SessionSloTracker(std::move(slo_ms),
+                                   tiers_.size(),
+                                   slo_window_.get(),
+                                   slo_percentile_.get(),
+                                   recover_ratio_.get());
+  pending_head_ = pending_tail_ = 0;
+}
+
+void CUDART_CB SessionInferenceOp::mark_done(void* pending) {
+  static_cast<Pending*>(pending)->done_ns.store(
+      std::chrono::steady_clock::now().time_since_epoch().count(), std::memory_order_release);
+}
+
+void SessionInferenceOp::poll_pending() {
+  while (pending_head_ != pending_tail_) {
+    Pending& pending = pending_[pending_head_ % kMaxPending];
+    const int64_t done_ns = pending.done_ns.load(std::memory_order_acquire);
+    if (done_ns < 0) { break; }
+    const double latency_ms =
+        (done_ns - pending.received.time_since_epoch().count()) / 1e6;
+    pending_head_++;
+
+    // the sessions of a batch are received together and complete together
+    const size_t tier = slo_tracker_.tier();
+    if (slo_tracker_.record(std::vector<double>(batch_size_, latency_ms))) {
+      HOLOSCAN_LOG_WARN("Switching from model {} to {} after a {:.2f} ms latency",
+                        tiers_[tier].model_path,
+                        tiers_[slo_tracker_.tier()].model_path,
+                        latency_ms);
+    }
+  }
+}
+
+void SessionInferenceOp::compute(InputContext& op_input, OutputContext& op_output,
+                                 ExecutionContext& context) {
+  const auto received = std::chrono::steady_clock::now();
+
+  std::vector<gxf::Entity> entities;
+  entities.reserve(input_names_.size());
+  for (const auto& name : input_names_) {
+    auto maybe_entity = op_input.receive<gxf::Entity>(name.c_str());
+    if (!maybe_entity) { throw std::runtime_error(fmt::format("Failed to receive {}", name)); }
+    entities.push_back(maybe_entity.value());
+  }
+
+  // the inference runs on the stream of the first session, the other streams are synchronized
+  // to it
+  std::vector<nvidia::gxf::Entity> messages(entities.begin(), entities.end());
+  if (cuda_stream_handler_.from_messages(context.context(), messages) != GXF_SUCCESS) {
+    throw std::runtime_error("Failed to get the CUDA stream from incoming messages");
+  }
+  const cudaStream_t stream = cuda_stream_handler_.get_cuda_stream(context.context());
+
+  poll_pending();
+  if (pending_tail_ - pending_head_ == kMaxPending) {
+    cudaStreamSynchronize(stream);
+    poll_pending();
+  }
+  Tier& tier = tiers_[slo_tracker_.tier()];
+
+  // stack the inputs of the sessions in the batch
+  const bool batched = tier.engine->getTensorShape(tier.input_name.c_str()).d[0] == -1;
+  const size_t input_bytes = tier.input_size * sizeof(float);
+  for (size_t s = 0; s < messages.size(); ++s) {
+    auto maybe_tensor = messages[s].get<nvidia::gxf::Tensor>(in_tensor_name_.get().c_str());
+    if (!maybe_tensor) {
+      throw std::runtime_error(fmt::format(
+          "Tensor {} not found in the message of {}", in_tensor_name_.get(), input_names_[s]));
+    }
+    const auto tensor = maybe_tensor.value();
+    if (tensor->storage_type() != nvidia::gxf::MemoryStorageType::kDevice ||
+        tensor->element_type() != nvidia::gxf::PrimitiveType::kFloat32 ||
+        tensor->size() != input_bytes) {
+      throw std::runtime_error(fmt::format(
+          "Tensor {} of {} must be a float32 device tensor of {} elements",
+          in_tensor_name_.get(),
+          input_names_[s],
+          tier.input_size));
+    }
+    cudaMemcpyAsync(static_cast<uint8_t*>(tier.input_binding) + s * input_bytes,
+                    tensor->pointer(),
+                    input_bytes,
+                    cudaMemcpyDeviceToDevice,
+                    stream);
+  }
+
+  const size_t output_bytes = tier.output_size * element_size(tier.output_type);
+  if (batched) {
+    if (!tier.context->enqueueV3(stream)) {
+      throw std::runtime_error("Failed to enqueue the inference");
+    }
+  } else {
+    for (int s = 0; s < batch_size_; ++s) {
+      tier.context->setTensorAddress(tier.input_name.c_str(),
+                                     static_cast<uint8_t*>(tier.input_binding) + s * input_bytes);
+      tier.context->setTensorAddress(
+          tier.output_name.c_str(), static_cast<uint8_t*>(tier.output_binding) + s * output_bytes);
+      if (!tier.context->enqueueV3(stream)) {
+        throw std::runtime_error("Failed to enqueue the inference");
+      }
+    }
+  }
+
+  // one tensor of shape [1, ...] per session, like the InferenceOp output
+  nvidia::gxf::Shape shape;
+  {
+    std::array<int32_t, nvidia::gxf::Shape::kMaxRank> dims{1};
+    for (int i = 0; i < tier.output_dims.nbDims; ++i) { dims[i + 1] = tier.output_dims.d[i]; }
+    shape = nvidia::gxf::Shape(dims, tier.output_dims.nbDims + 1);
+  }
+  const auto element_type = tier.output_type == nvinfer1::DataType::kHALF
+                                ? nvidia::gxf::PrimitiveType::kFloat16
+                                : nvidia::gxf::PrimitiveType::kFloat32;
+  std::vector<nvidia::gxf::TensorDescription> descriptions;
+  for (int s = 0; s < batch_size_; ++s) {
+    descriptions.push_back({fmt::format("{}_{}", out_tensor_name_.get(), s),
+                            nvidia::gxf::MemoryStorageType::kDevice,
+                            shape,
+                            element_type,
+                            0,
+                            nvidia::gxf::ComputeTrivialStrides(
+                                shape, nvidia::gxf::PrimitiveTypeSize(element_type))});
+  }
+  auto allocator = nvidia::gxf::Handle<nvidia::gxf::Allocator>::Create(
+      fragment()->executor().context(), allocator_->gxf_cid());
+  auto out_message = CreateTensorMap(context.context(), allocator.value(), descriptions, false);
+  if (!out_message) { throw std::runtime_error("Failed to create the output message"); }
+  for (int s = 0; s < batch_size_; ++s) {
+    auto out_tensor = out_message.value().get<nvidia::gxf::Tensor>(descriptions[s].name.c_str());
+    if (!out_tensor || !out_tensor.value()->pointer()) {
+      throw std::runtime_error("Failed to allocate the output tensors");
+    }
+    cudaMemcpyAsync(out_tensor.value()->pointer(),
+                    static_cast<uint8_t*>(tier.output_binding) + s * output_bytes,
+                    output_bytes,
+                    cudaMemcpyDeviceToDevice,
+                    stream);
+  }
+
+  // the latency is taken when the stream reaches this point, without waiting for it here
+  Pending& pending = pending_[pending_tail_ % kMaxPending];
+  pending.received = received;
+  pending.done_ns.store(-1, std::memory_order_relaxed);
+  if (cudaLaunchHostFunc(stream, mark_done, &pending) == cudaSuccess) { pending_tail_++; }
+
+  // pass the CUDA stream to the output message
+  if (cuda_stream_handler_.to_message(out_message) != GXF_SUCCESS) {
+    throw std::runtime_error("Failed to add the CUDA stream to the outgoing messages");
+  }
+  auto result = gxf::Entity(std::move(out_message.value()));
+  op_output.emit(result, "transmitter");
+}
+
+void SessionInferenceOp::stop() {
+  cudaDeviceSynchronize();
+  poll_pending();
+  slo_tracker_.report(session_names_.get());
+  for (auto& tier : tiers_) {
+    tier.context.reset();
+    tier.engine.reset();
+    cudaFree(tier.input_binding);
+    cudaFree(tier.output_binding);
+  }
+  tiers_.clear();
+  runtime_.reset();
+}
+
+}  // namespace holoscan::ops::orsi
@@ -0,0 +1,158 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <NvInfer.h>
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <deque>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <holoscan/core/resources/gxf/allocator.hpp>
+#include <holoscan/holoscan.hpp>
+#include <holoscan/utils/cuda_stream_handler.hpp>
+
+#include "../../../operators/tensorrt_engine_util.hpp"
+
+namespace holoscan::ops::orsi {
+
+/**
+ * @brief Tracks the latency of every session against its SLO and picks the model tier
+ *
+ * Tier 0 is the most accurate model, higher tiers are cheaper. When a session misses its SLO
+ * at the `slo_percentile` over a full window, the next cheaper tier is used; when every session
+ * is below `recover_ratio` of its SLO over a full window, the next more accurate one.
+ */
+class SessionSloTracker {
+ public:
+  SessionSloTracker() = default;
+  SessionSloTracker(std::vector<double> slo_ms, size_t num_tiers, size_t window,
+                    double percentile, double recover_ratio);
+
+  /// @brief Records the latency of a frame of each session, returns true if the tier changed
+  bool record(const std::vector<double>& latency_ms);
+
+  size_t tier() const { return tier_; }
+
+  /// @brief Logs the latency and the SLO violations of each session and the frames per tier
+  void report(const std::vector<std::string>& session_names) const;
+
+ private:
+  double percentile_ms(const std::deque<double>& samples) const;
+
+  std::vector<double> slo_ms_;
+  size_t num_tiers_ = 1;
+  size_t window_ = 1;
+  double percentile_ = 0.95;
+  double recover_ratio_ = 0.5;
+  size_t tier_ = 0;
+
+  std::vector<std::deque<double>> recent_;  // Latencies of the current window per session
+  std::vector<std::vector<double>> all_;    // Latencies of the whole run per session
+  std::vector<uint64_t> violations_;
+  std::vector<uint64_t> tier_frames_;
+};
+
+/**
+ * @brief Runs one segmentation network for several sessions (video streams) in a single batch
+ *
+ * Receives the preprocessed `in_tensor_name` tensor of session `i` of `session_names` on port
+ * `in_<i>`, copies them into one batched input binding and runs the engine once. The scores of
+ * session `i` are emitted as tensor `<out_tensor_name>_<i>` of shape [1, ...] in one message, so
+ * each session's postprocessor picks its own tensor.
+ *
+ * `model_paths` lists the ONNX models from the most accurate to the cheapest. The engines are
+ * built with a batch of the number of sessions, cached in `engine_cache_dir`, and all loaded
+ * once, shared by the sessions. The end-to-end latency of every batch (from the time the frames
+ * are received to the inference completing on the GPU) is checked against the per-session
+ * `slo_ms` to switch to a cheaper model when the GPU is saturated, and back once it recovers.
+ * The models must have the same input and output shapes.
+ */
+class SessionInferenceOp : public Operator {
+ public:
+  HOLOSCAN_OPERATOR_FORWARD_ARGS(SessionInferenceOp)
+
+  SessionInferenceOp() = default;
+
+  void setup(OperatorSpec& spec) override;
+  void start() override;
+  void compute(InputContext& op_input, OutputContext& op_output,
+               ExecutionContext& context) override;
+  void stop() override;
+
+ private:
+  template <typename T>
+  using NvInferHandle = trt_engine::NvInferHandle<T>;
+
+  // Engine of one model tier with its bindings for a full batch
+  struct Tier {
+    std::string model_path;
+    NvInferHandle<nvinfer1::ICudaEngine> engine;
+    NvInferHandle<nvinfer1::IExecutionContext> context;
+    std::string input_name;
+    std::string output_name;
+    nvinfer1::Dims output_dims;  // Without the batch dimension
+    size_t input_size = 0;       // Elements of one session
+    size_t output_size = 0;      // Elements of one session
+    void* input_binding = nullptr;
+    void* output_binding = nullptr;
+    nvinfer1::DataType output_type;
+  };
+
+  // A batch in flight, completed by a host function on the stream
+  struct Pending {
+    std::chrono::steady_clock::time_point received;
+    std::atomic<int64_t> done_ns{-1};
+  };
+
+  void load_tier(Tier& tier);
+  void poll_pending();
+  static void CUDART_CB mark_done(void* pending);
+
+  Parameter<std::vector<std::string>> model_paths_;
+  Parameter<std::vector<std::string>> session_names_;
+  Parameter<std::string> engine_cache_dir_;
+  Parameter<bool> enable_fp16_;
+  Parameter<std::string> in_tensor_name_;
+  Parameter<std::string> out_tensor_name_;
+  Parameter<std::vector<double>> slo_ms_;
+  Parameter<uint32_t> slo_window_;
+  Parameter<double> slo_percentile_;
+  Parameter<double> recover_ratio_;
+  Parameter<std::shared_ptr<Allocator>> allocator_;
+
+  trt_engine::Logger logger_;
+  NvInferHandle<nvinfer1::IRuntime> runtime_;
+  std::vector<Tier> tiers_;
+  int batch_size_ = 0;
+  SessionSloTracker slo_tracker_;
+
+  static constexpr size_t kMaxPending = 8;
+  std::array<Pending, kMaxPending> pending_;
+  size_t pending_head_ = 0;  // Next batch to complete
+  size_t pending_tail_ = 0;  // Next batch to launch
+
+  std::vector<std::string> input_names_;
+  CudaStreamHandler cuda_stream_handler_;
+};
+
+}  // namespace holoscan::ops::orsi
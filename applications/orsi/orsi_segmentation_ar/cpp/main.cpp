@@ -34,6 +34,11 @@ class App : public OrsiApp {
   void compose() override {
     using namespace holoscan;
 
+    if (multiSessionEnabled()) {
+      composeMultiSession();
+      return;
+    }
+
     std::shared_ptr<Resource> allocator_resource =
         make_resource<UnboundedAllocator>("unbounded_allocator");
 
@@ -126,6 +131,45 @@ class App : public OrsiApp {
     add_flow(multiai_inference, segmentation_postprocessor, {{"transmitter", ""}});
     add_flow(segmentation_postprocessor, orsi_visualizer, {{"", "receivers"}});
   }
+
+ private:
+  // Several ORs on one GPU: the segmentation model runs once for all the sessions, the
+  // preprocessing, postprocessing and visualization run per session
+  void composeMultiSession() {
+    using namespace holoscan;
+
+    auto allocator_resource = make_resource<UnboundedAllocator>("unbounded_allocator");
+    initSessionSources();
+    auto session_inference = makeSessionInference("session_inference", allocator_resource);
+
+    for (size_t i = 0; i < session_names.size(); i++) {
+      const std::string& name = session_names[i];
+      auto format_converter = make_operator<ops::orsi::FormatConverterOp>(
+          "format_converter_" + name,
+          from_config("format_converter"),
+          Arg("in_tensor_name", std::string("")),
+          Arg("allocator") = allocator_resource);
+      auto segmentation_preprocessor = make_operator<ops::orsi::SegmentationPreprocessorOp>(
+          "segmentation_preprocessor_" + name,
+          from_config("segmentation_preprocessor"),
+          Arg("allocator") = allocator_resource);
+      auto segmentation_postprocessor = make_operator<ops::orsi::SegmentationPostprocessorOp>(
+          "segmentation_postprocessor_" + name,
+          from_config("segmentation_postprocessor"),
+          from_config("session_postprocessor"),
+          Arg("in_tensor_name", fmt::format("tool_seg_infer_{}", i)),
+          Arg("allocator") = allocator_resource);
+      auto holoviz = make_operator<ops::HolovizOp>(
+          "holoviz_" + name, from_config("session_holoviz"), Arg("window_title", name));
+
+      add_flow(session_sources[i], format_converter, {{"", "source_video"}});
+      add_flow(format_converter, segmentation_preprocessor);
+      add_flow(segmentation_preprocessor, session_inference, {{"", fmt::format("in_{}", i)}});
+      add_flow(session_inference, segmentation_postprocessor, {{"transmitter", ""}});
+      add_flow(session_sources[i], holoviz, {{"", "receivers"}});
+      add_flow(segmentation_postprocessor, holoviz, {{"", "receivers"}});
+    }
+  }
 };
 
 int main(int argc, char** argv) {
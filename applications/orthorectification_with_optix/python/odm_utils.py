@@ -74,47 +74,48 @@ def load_frame_odm(
     sensor_up_str = ",".join([str(item) for item in sensor_up])
 
     # use camera model to get bounding box estimates in world coordinates assuming
-    # flat plane elevation with min elevation
-    if not use_mosaic_bbox:
-        # vector in direction of corners
-        x_edge = shot.camera.focal * np.tan(np.deg2rad(hfov / 2.0))
-        y_edge = shot.camera.focal * np.tan(np.deg2rad(vfov / 2.0))
-
-        bot_right = np.array(
-            shot._transfo_rotation.apply([x_edge, y_edge, shot.camera.focal], inverse=True)
-        )
-        bot_right = bot_right / norm(bot_right)
-
-        bot_left = np.array(
-            shot._transfo_rotation.apply([-x_edge, y_edge, shot.camera.focal], inverse=True)
-        )
-        bot_left = bot_left / norm(bot_left)
-
-        top_left = np.array(
-            shot._transfo_rotation.apply([-x_edge, -y_edge, shot.camera.focal], inverse=True)
-        )
-        top_left = top_left / norm(top_left)
-
-        top_right = np.array(
-            shot._transfo_rotation.apply([x_edge, -y_edge, shot.camera.focal], inverse=True)
-        )
-        top_right = top_right / norm(top_right)
-
-        corners = np.vstack([bot_right, bot_left, top_left, top_right, bot_right])
-
-        utm_corners = ray_plane_intersections_cpu(
-            np.array([0, 0, 1]), np.array([0, 0, min_el]), corners, np.array(utm_sensor_pos)
-        )
-
-        bpts = MultiPoint(list(utm_corners))
-        bbox = bpts.convex_hull
-    else:
-        bbox = mosaic_bbox
+    # flat plane elevation with min elevation. The footprint is kept even when rendering to the
+    # mosaic bounds, since the tiled mode only renders the tiles that it covers.
+
+    # vector in direction of corners
+    x_edge = shot.camera.focal * np.tan(np.deg2rad(hfov / 2.0))
+    y_edge = shot.camera.focal * np.tan(np.deg2rad(vfov / 2.0))
+
+    bot_right = np.array(
+        shot._transfo_rotation.apply([x_edge, y_edge, shot.camera.focal], inverse=True)
+    )
+    bot_right = bot_right / norm(bot_right)
+
+    bot_left = np.array(
+        shot._transfo_rotation.apply([-x_edge, y_edge, shot.camera.focal], inverse=True)
+    )
+    bot_left = bot_left / norm(bot_left)
+
+    top_left = np.array(
+        shot._transfo_rotation.apply([-x_edge, -y_edge, shot.camera.focal], inverse=True)
+    )
+    top_left = top_left / norm(top_left)
+
+    top_right = np.array(
+        shot._transfo_rotation.apply([x_edge, -y_edge, shot.camera.focal], inverse=True)
+    )
+    top_right = top_right / norm(top_right)
+
+    corners = np.vstack([bot_right, bot_left, top_left, top_right, bot_right])
+
+    utm_corners = ray_plane_intersections_cpu(
+        np.array([0, 0, 1]), np.array([0, 0, min_el]), corners, np.array(utm_sensor_pos)
+    )
+
+    bpts = MultiPoint(list(utm_corners))
+    footprint = bpts.convex_hull
+    bbox = mosaic_bbox if use_mosaic_bbox else footprint
 
     camera_loc = Point(utm_sensor_pos)
 
     meta = {
         "wkt": bbox.wkt,
+        "footprint_wkt": footprint.wkt,
         "wkt_camera_loc": camera_loc.wkt,
         "image_name": shot.image_name,
         "sensor_dir": sensor_dir_str,
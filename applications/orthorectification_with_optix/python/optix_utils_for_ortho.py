@@ -16,6 +16,7 @@
 
 import ctypes  # C interop helpers
 import os
+from collections import OrderedDict
 
 import cupy as cp
 import numpy as np
@@ -36,6 +37,7 @@ class State:
         self.image_gsd = None
         self.image_geot = None
         self.image_wkt = None
+        self.footprint_bounds = None
 
         self.terrain_pix = None
         self.terrain_width = None
@@ -89,36 +91,40 @@ def build_terrain_geom(state: State):
         + state.terrain_geot[3]
         - state.terrain_ymin
     )
+    state.terrain_vert_grid, state.terrain_tri_grid = grid_geom(x, y, state.terrain_pix)
+
+
+def grid_geom(x, y, zz):
+    width = x.size
+    height = y.size
+
+    # build verts
     xx, yy = np.meshgrid(x, y)
-    zz = state.terrain_pix
     vert_grid = np.vstack((xx, yy, zz)).reshape([3, -1]).transpose()
 
     # build triangles
-    ai = np.arange(0, state.terrain_width - 1)
-    aj = np.arange(0, state.terrain_height - 1)
+    ai = np.arange(0, width - 1)
+    aj = np.arange(0, height - 1)
     aii, ajj = np.meshgrid(ai, aj)
-    a = aii + ajj * state.terrain_width
+    a = aii + ajj * width
     a = a.flatten()
 
     tria = np.vstack(
         (
             a,
-            a + state.terrain_width,
-            a + state.terrain_width + 1,
+            a + width,
+            a + width + 1,
             a,
-            a + state.terrain_width + 1,
+            a + width + 1,
             a + 1,
         )
     )
     tri_grid = np.transpose(tria).reshape([-1, 3])
 
-    state.terrain_vert_grid = vert_grid.reshape(vert_grid.size)
-    state.terrain_tri_grid = tri_grid.reshape(tri_grid.size)
+    return vert_grid.reshape(vert_grid.size), tri_grid.reshape(tri_grid.size)
 
 
-def load_terrain_host(state: State, terrain_fname):
-    dset = gdal.Open(terrain_fname, gdal.GA_ReadOnly)
-
+def load_terrain_georef(state: State, dset):
     nx = dset.RasterXSize
     ny = dset.RasterYSize
     state.terrain_width = nx
@@ -132,12 +138,94 @@ def load_terrain_host(state: State, terrain_fname):
     state.terrain_ymin = geot[3] + (ny - 1) * geot[5]
     state.terrain_gsd = geot[1]
 
+
+def load_terrain_host(state: State, terrain_fname):
+    dset = gdal.Open(terrain_fname, gdal.GA_ReadOnly)
+    load_terrain_georef(state, dset)
+
     state.terrain_pix = dset.GetRasterBand(1).ReadAsArray()
     state.terrain_zmax = np.max(state.terrain_pix)
 
     dset = None
 
 
+def load_terrain_meta(state: State, terrain_fname):
+    # same as load_terrain_host without keeping the elevation pixels, which the tiled mode
+    # reads per tile
+    dset = gdal.Open(terrain_fname, gdal.GA_ReadOnly)
+    load_terrain_georef(state, dset)
+
+    state.terrain_pix = None
+    state.terrain_zmax = dset.GetRasterBand(1).ComputeRasterMinMax(False)[1]
+
+    dset = None
+
+
+class TerrainTileCache:
+    """DEM tiles loaded on demand, each with its own geometry acceleration structure
+
+    Tiles share their edge row and column of DEM pixels with their neighbours so the terrain has
+    no cracks, and the acceleration structures of recently used tiles stay on the device.
+    """
+
+    def __init__(self, state: State, terrain_fname, ctx, tile_size, max_resident_tiles):
+        self.state = state
+        self.dset = gdal.Open(terrain_fname, gdal.GA_ReadOnly)
+        self.ctx = ctx
+        self.tile_size = tile_size
+        self.max_resident_tiles = max_resident_tiles
+        self.num_tile_cols = -(-(state.terrain_width - 1) // tile_size)
+        self.num_tile_rows = -(-(state.terrain_height - 1) // tile_size)
+        self.tiles = OrderedDict()
+
+    def tile_ids(self, bounds, margin):
+        # tiles overlapping the (xmin, ymin, xmax, ymax) world bounds grown by margin
+        geot = self.state.terrain_geot
+        xmin, ymin, xmax, ymax = bounds
+        col0 = (xmin - margin - geot[0]) / geot[1]
+        col1 = (xmax + margin - geot[0]) / geot[1]
+        row0 = (ymax + margin - geot[3]) / geot[5]
+        row1 = (ymin - margin - geot[3]) / geot[5]
+
+        tc0 = max(int(col0 // self.tile_size), 0)
+        tc1 = min(int(col1 // self.tile_size), self.num_tile_cols - 1)
+        tr0 = max(int(row0 // self.tile_size), 0)
+        tr1 = min(int(row1 // self.tile_size), self.num_tile_rows - 1)
+        return [(tr, tc) for tr in range(tr0, tr1 + 1) for tc in range(tc0, tc1 + 1)]
+
+    def get(self, tile_id, cuda_stream):
+        if tile_id in self.tiles:
+            self.tiles.move_to_end(tile_id)
+            return self.tiles[tile_id][0]
+
+        tr, tc = tile_id
+        col0 = tc * self.tile_size
+        row0 = tr * self.tile_size
+        width = min(self.tile_size, self.state.terrain_width - 1 - col0) + 1
+        height = min(self.tile_size, self.state.terrain_height - 1 - row0) + 1
+        zz = self.dset.GetRasterBand(1).ReadAsArray(col0, row0, width, height)
+
+        geot = self.state.terrain_geot
+        x = np.arange(col0, col0 + width) * geot[1] + geot[0] - self.state.terrain_xmin
+        y = np.arange(row0, row0 + height) * geot[5] + geot[3] - self.state.terrain_ymin
+        vert_grid, tri_grid = grid_geom(x, y, zz)
+
+        gas_handle, d_gas_output_buffer, _ = build_gas(self.ctx, vert_grid, tri_grid, cuda_stream)
+        # the build inputs go out of scope here
+        cuda_stream.synchronize()
+
+        self.tiles[tile_id] = (gas_handle, d_gas_output_buffer)
+        return gas_handle
+
+    def trim(self, keep):
+        # evict the least recently used tiles that are not in keep
+        for tile_id in list(self.tiles.keys()):
+            if len(self.tiles) <= self.max_resident_tiles:
+                break
+            if tile_id not in keep:
+                del self.tiles[tile_id]
+
+
 ###################
 ## Sensor Stuff
 ###################
@@ -379,11 +467,17 @@ def compile_cuda(
     return ptx
 
 
-def set_pipeline_options():
+def set_pipeline_options(allow_instancing=False):
+    # the tiled mode traces against an instance of every terrain tile and of the sensor plane
+    if allow_instancing:
+        graph_flags = int(optix.TRAVERSABLE_GRAPH_FLAG_ALLOW_SINGLE_LEVEL_INSTANCING)
+    else:
+        graph_flags = int(optix.TRAVERSABLE_GRAPH_FLAG_ALLOW_SINGLE_GAS)
+
     if optix.version()[1] >= 2:
         return optix.PipelineCompileOptions(
             usesMotionBlur=False,
-            traversableGraphFlags=int(optix.TRAVERSABLE_GRAPH_FLAG_ALLOW_SINGLE_GAS),
+            traversableGraphFlags=graph_flags,
             numPayloadValues=3,
             numAttributeValues=3,
             exceptionFlags=int(optix.EXCEPTION_FLAG_NONE),
@@ -393,7 +487,7 @@ def set_pipeline_options():
     else:
         return optix.PipelineCompileOptions(
             usesMotionBlur=False,
-            traversableGraphFlags=int(optix.TRAVERSABLE_GRAPH_FLAG_ALLOW_SINGLE_GAS),
+            traversableGraphFlags=graph_flags,
             numPayloadValues=3,
             numAttributeValues=3,
             exceptionFlags=int(optix.EXCEPTION_FLAG_NONE),
@@ -440,7 +534,7 @@ def create_program_groups(ctx, module):
     return [raygen_prog_group, miss_prog_group, hitgroup_prog_group]
 
 
-def create_pipeline(ctx, program_groups, pipeline_compile_options):
+def create_pipeline(ctx, program_groups, pipeline_compile_options, max_traversable_depth=1):
     print("Creating pipeline ... ")
 
     max_trace_depth = 2
@@ -467,7 +561,10 @@ def create_pipeline(ctx, program_groups, pipeline_compile_options):
     )
 
     pipeline.setStackSize(
-        dc_stack_size_from_trav, dc_stack_size_from_state, cc_stack_size, 1  # maxTraversableDepth
+        dc_stack_size_from_trav,
+        dc_stack_size_from_state,
+        cc_stack_size,
+        max_traversable_depth,
     )
 
     return pipeline
@@ -547,6 +644,11 @@ def create_accel(state: State, ctx, cuda_stream):
     tri_grid_ter = state.terrain_tri_grid
     tri_grid = np.concatenate([tri_grid_ter, tri_grid_sen])
 
+    gas_handle, d_gas_output_buffer, _ = build_gas(ctx, vert_grid, tri_grid, cuda_stream)
+    return (gas_handle, d_gas_output_buffer)
+
+
+def build_gas(ctx, vert_grid, tri_grid, cuda_stream):
     accel_options = optix.AccelBuildOptions(
         buildFlags=int(optix.BUILD_FLAG_ALLOW_RANDOM_VERTEX_ACCESS),
         operation=optix.BUILD_OPERATION_BUILD,
@@ -590,10 +692,67 @@ def create_accel(state: State, ctx, cuda_stream):
     )
     # cuda_stream.synchronize()
 
-    return (gas_handle, d_gas_output_buffer)
+    # the build inputs are returned so callers can keep them alive until the build is done
+    return (gas_handle, d_gas_output_buffer, (d_vert_grid, d_tri_grid, d_temp_buffer_gas))
+
+
+# OptixInstance
+instance_dtype = np.dtype(
+    {
+        "names": [
+            "transform",
+            "instanceId",
+            "sbtOffset",
+            "visibilityMask",
+            "flags",
+            "traversableHandle",
+            "pad",
+        ],
+        "formats": [("f4", 12), "u4", "u4", "u4", "u4", "u8", ("u4", 2)],
+        "align": True,
+    }
+)
+
+
+def build_ias(ctx, gas_handles, cuda_stream):
+    # one identity instance per GAS; terrain tiles and the sensor plane share the hit group
+    h_instances = np.zeros(len(gas_handles), dtype=instance_dtype)
+    h_instances["transform"] = [1.0, 0.0, 0.0, 0.0, 0.0, 1.0, 0.0, 0.0, 0.0, 0.0, 1.0, 0.0]
+    h_instances["visibilityMask"] = 255
+    h_instances["flags"] = int(optix.INSTANCE_FLAG_NONE)
+    h_instances["traversableHandle"] = gas_handles
+    d_instances = array_to_device_memory(h_instances, stream=cuda_stream)
+
+    accel_options = optix.AccelBuildOptions(
+        buildFlags=int(optix.BUILD_FLAG_NONE),
+        operation=optix.BUILD_OPERATION_BUILD,
+    )
 
+    instance_input = optix.BuildInputInstanceArray()
+    instance_input.instances = d_instances.ptr
+    instance_input.numInstances = len(gas_handles)
 
-def launch(state: State, pipeline, sbt, trav_handle, cuda_stream):
+    ias_buffer_sizes = ctx.accelComputeMemoryUsage([accel_options], [instance_input])
+
+    d_temp_buffer_ias = cp.cuda.alloc(ias_buffer_sizes.tempSizeInBytes)
+    d_ias_output_buffer = cp.cuda.alloc(ias_buffer_sizes.outputSizeInBytes)
+
+    ias_handle = ctx.accelBuild(
+        cuda_stream.ptr,
+        [accel_options],
+        [instance_input],
+        d_temp_buffer_ias.ptr,
+        ias_buffer_sizes.tempSizeInBytes,
+        d_ias_output_buffer.ptr,
+        ias_buffer_sizes.outputSizeInBytes,
+        [],  # emitted properties
+    )
+    cuda_stream.synchronize()
+
+    return (ias_handle, d_ias_output_buffer)
+
+
+def create_sensor_texture(state: State, cuda_stream):
     d_tex_pix = cp.array(state.sensor_tex_pixels)
     alpha = state.sensor_alpha
     d_tex_pix = cp.dstack([d_tex_pix, alpha])
@@ -611,6 +770,7 @@ def launch(state: State, pipeline, sbt, trav_handle, cuda_stream):
     # cuda_stream.synchronize()
 
     res_desc = cp.cuda.texture.ResourceDescriptor(cp.cuda.runtime.cudaResourceTypeArray, d_cuda_arr)
+    # the texture object keeps the resource descriptor and so the CUDA array alive
 
     tex_desc = cp.cuda.texture.TextureDescriptor(
         addressModes=[cp.cuda.runtime.cudaAddressModeBorder, cp.cuda.runtime.cudaAddressModeBorder],
@@ -619,23 +779,21 @@ def launch(state: State, pipeline, sbt, trav_handle, cuda_stream):
         normalizedCoords=1,
     )
 
-    pix_width = state.image_width
-    pix_height = state.image_height
-    d_pix = state.image
+    return cp.cuda.texture.TextureObject(res_desc, tex_desc)
 
-    float2_dtype = np.dtype([("x", "f4"), ("y", "f4")], align=True)
 
-    tex_obj = cp.cuda.texture.TextureObject(res_desc, tex_desc)
+def pack_params(state: State, trav_handle, tex_obj, image_ptr, image_corner_coords):
+    float2_dtype = np.dtype([("x", "f4"), ("y", "f4")], align=True)
 
     # TODO remove the padding variable after data alignment is addressed
     params = [
         ("u8", "trav_handle", trav_handle),
         ("u8", "sensor_tex", tex_obj.ptr),
-        ("u8", "image", d_pix.data.ptr),
-        ("u4", "image_width", pix_width),
-        ("u4", "image_height", pix_height),
-        ("f4", "image_corner_coords_x", state.image_corner_coords[0].astype(np.float32)),
-        ("f4", "image_corner_coords_y", state.image_corner_coords[1].astype(np.float32)),
+        ("u8", "image", image_ptr),
+        ("u4", "image_width", state.image_width),
+        ("u4", "image_height", state.image_height),
+        ("f4", "image_corner_coords_x", image_corner_coords[0].astype(np.float32)),
+        ("f4", "image_corner_coords_y", image_corner_coords[1].astype(np.float32)),
         ("f4", "image_gsd", state.image_gsd.astype(np.float32)),
         ("f4", "sensor_focal_length", state.sensor_focal_length.astype(np.float32)),
         ("f4", "terrain_zmax", state.terrain_zmax.astype(np.float32)),
@@ -683,7 +841,17 @@ def launch(state: State, pipeline, sbt, trav_handle, cuda_stream):
         {"names": names, "formats": formats, "itemsize": itemsize, "align": True}
     )
 
-    h_params = np.array([tuple(values)], dtype=params_dtype)
+    return np.array([tuple(values)], dtype=params_dtype)
+
+
+def launch(state: State, pipeline, sbt, trav_handle, cuda_stream):
+    tex_obj = create_sensor_texture(state, cuda_stream)
+
+    pix_width = state.image_width
+    pix_height = state.image_height
+    d_pix = state.image
+
+    h_params = pack_params(state, trav_handle, tex_obj, d_pix.data.ptr, state.image_corner_coords)
     d_params = array_to_device_memory(h_params, stream=cuda_stream)
     # cuda_stream.synchronize()
 
@@ -699,7 +867,62 @@ def launch(state: State, pipeline, sbt, trav_handle, cuda_stream):
     )
     cuda_stream.synchronize()
 
-    d_pix = cp.reshape(d_pix, (state.image_height, state.image_width, 4))
+    return download_image(state)
+
+
+def launch_tiles(state: State, pipeline, sbt, trav_handle, cuda_streams, tile_size, margin):
+    # Render the output tiles covering the frame footprint, spread over the given streams. Tiles
+    # outside the footprint keep their previous result in the mosaic.
+    tex_obj = create_sensor_texture(state, cuda_streams[0])
+    texture_ready = cuda_streams[0].record()
+    for cuda_stream in cuda_streams[1:]:
+        cuda_stream.wait_event(texture_ready)
+
+    d_pix = state.image
+    pix_width = state.image_width
+    pix_height = state.image_height
+    gsd = float(state.image_gsd)
+
+    # output pixel window of the footprint; rows grow with northing until download_image
+    xmin, ymin, xmax, ymax = state.footprint_bounds
+    corner_x = state.image_corner_coords[0] + state.terrain_xmin
+    corner_y = state.image_corner_coords[1] + state.terrain_ymin
+    px0 = min(max(int(np.floor((xmin - margin - corner_x) / gsd)), 0), pix_width)
+    px1 = min(max(int(np.ceil((xmax + margin - corner_x) / gsd)), 0), pix_width)
+    py0 = min(max(int(np.floor((ymin - margin - corner_y) / gsd)), 0), pix_height)
+    py1 = min(max(int(np.ceil((ymax + margin - corner_y) / gsd)), 0), pix_height)
+
+    # the host parameters have to outlive their asynchronous copies
+    launch_params = []
+    for ty in range(py0, py1, tile_size):
+        for tx in range(px0, px1, tile_size):
+            cuda_stream = cuda_streams[len(launch_params) % len(cuda_streams)]
+
+            tile_corner = state.image_corner_coords + np.array([tx * gsd, ty * gsd])
+            tile_ptr = d_pix.data.ptr + (ty * pix_width + tx) * 4
+            h_params = pack_params(state, trav_handle, tex_obj, tile_ptr, tile_corner)
+            d_params = array_to_device_memory(h_params, stream=cuda_stream)
+            launch_params.append((h_params, d_params))
+
+            optix.launch(
+                pipeline,
+                cuda_stream.ptr,
+                d_params.ptr,
+                h_params.dtype.itemsize,
+                sbt,
+                min(tile_size, px1 - tx),
+                min(tile_size, py1 - ty),
+                1,  # depth
+            )
+
+    for cuda_stream in cuda_streams:
+        cuda_stream.synchronize()
+
+    return download_image(state)
+
+
+def download_image(state: State):
+    d_pix = cp.reshape(state.image, (state.image_height, state.image_width, 4))
     d_pix = cp.flipud(d_pix)
     h_pix = cp.asnumpy(d_pix)
 
@@ -28,6 +28,9 @@ from holoscan.operators import HolovizOp
 from odm_utils import load_all_frames_odm
 from optix_utils_for_ortho import (
     State,
+    TerrainTileCache,
+    build_gas,
+    build_ias,
     build_sensor_geom,
     build_terrain_geom,
     compile_cuda,
@@ -39,8 +42,10 @@ from optix_utils_for_ortho import (
     create_sbt,
     init_render_params,
     launch,
+    launch_tiles,
     load_sensor_texture,
     load_terrain_host,
+    load_terrain_meta,
     set_pipeline_options,
 )
 from ortho_utils import create_blank_basemap, extract_extent_nativeCRS, load_basemap
@@ -73,6 +78,14 @@ nb = 3  # how many bands to write to the GeoTiff
 render_scale = 0.5  # scale the holoview window up or down
 fps = 8.0  # rate limit the simulated sensor feed to this many frames per second
 
+# tiled mode for large DEMs and mosaics
+use_tiling = False  # load DEM tiles on demand and only render the output tiles a frame covers
+terrain_tile_size = 512  # DEM pixels along each edge of a terrain tile
+max_resident_tiles = 32  # terrain tiles whose acceleration structures stay on the GPU
+output_tile_size = 256  # output pixels along each edge of a render tile
+num_render_streams = 4  # CUDA streams the render tiles are spread over
+footprint_margin = 25.0  # meters around the frame footprint covered for occluders and rendering
+
 # ---------------Helper Functionality -------------------------#
 # TODO Extend to camera models other than perspective
 
@@ -163,8 +176,12 @@ class LoadTerrain(Operator):
         if use_mosaic_bbox:
             self.state.image = mosaic_image_d
 
-        load_terrain_host(self.state, dem_image_fname)
-        build_terrain_geom(self.state)
+        if use_tiling:
+            # the terrain tiles are loaded by the ortho operator as frames need them
+            load_terrain_meta(self.state, dem_image_fname)
+        else:
+            load_terrain_host(self.state, dem_image_fname)
+            build_terrain_geom(self.state)
 
         spec.input("sensor_meta")
         spec.input("sensor_pix")
@@ -177,8 +194,6 @@ class LoadTerrain(Operator):
         sensor_meta = op_input.receive("sensor_meta")
         sensor_pix = op_input.receive("sensor_pix")
 
-        # TODO dynamically update / load terrain based on image footprint location
-
         op_output.emit(self.state, "optix_state")
         op_output.emit(sensor_meta, "sensor_meta")
         op_output.emit(sensor_pix, "sensor_pix")
@@ -206,6 +221,7 @@ class PrepOdmMeta4Ortho(Operator):
 
         optix_state.frame_number = sensor_meta["frame_number"]
         optix_state.bounding_box_estimate = wkt_load(sensor_meta["wkt"]).bounds
+        optix_state.footprint_bounds = wkt_load(sensor_meta["footprint_wkt"]).bounds
         optix_state.sensor_dir = np.array(
             [float(item) for item in sensor_meta["sensor_dir"].split(",")]
         )
@@ -240,16 +256,22 @@ class OptixOrthoOp(Operator):
             project_cu, cuda_tk_path, include_path, project_include_path
         )
         self.ctx = create_ctx()
+        self.terrain_tiles = None
         # Need to call the base class constructor last
         super().__init__(*args, **kwargs)
 
     def setup(self, spec: OperatorSpec):
-        pipeline_options = set_pipeline_options()
+        pipeline_options = set_pipeline_options(allow_instancing=use_tiling)
         module = create_module(self.ctx, pipeline_options, self.project_ptx)
         self.prog_groups = create_program_groups(self.ctx, module)
 
-        self.pipeline = create_pipeline(self.ctx, self.prog_groups, pipeline_options)
+        self.pipeline = create_pipeline(
+            self.ctx, self.prog_groups, pipeline_options, 2 if use_tiling else 1
+        )
         self.stream = cp.cuda.Stream()
+        self.render_streams = [self.stream]
+        if use_tiling:
+            self.render_streams += [cp.cuda.Stream() for _ in range(num_render_streams - 1)]
 
         spec.input("optix_state")
         spec.input("sensor_pix")
@@ -264,10 +286,13 @@ class OptixOrthoOp(Operator):
         load_sensor_texture(optix_state, sensor_pix)
         build_sensor_geom(optix_state)
 
-        gas_handle, d_gas_output_buffer = create_accel(optix_state, self.ctx, self.stream)
+        if use_tiling:
+            ortho_pix = self.render_tiled(optix_state)
+        else:
+            gas_handle, d_gas_output_buffer = create_accel(optix_state, self.ctx, self.stream)
 
-        sbt = create_sbt(self.prog_groups)
-        ortho_pix = launch(optix_state, self.pipeline, sbt, gas_handle, self.stream)
+            sbt = create_sbt(self.prog_groups)
+            ortho_pix = launch(optix_state, self.pipeline, sbt, gas_handle, self.stream)
 
         gtiff_meta = {}
         gtiff_meta["xsize"] = optix_state.image_width
@@ -279,6 +304,36 @@ class OptixOrthoOp(Operator):
         op_output.emit(gtiff_meta, "gtiff_meta")
         op_output.emit(ortho_pix, "ortho_pix")
 
+    def render_tiled(self, optix_state):
+        if self.terrain_tiles is None:
+            self.terrain_tiles = TerrainTileCache(
+                optix_state, dem_image_fname, self.ctx, terrain_tile_size, max_resident_tiles
+            )
+
+        # terrain under the footprint and around it, for rays occluded on their way to the sensor
+        tile_ids = self.terrain_tiles.tile_ids(optix_state.footprint_bounds, footprint_margin)
+        gas_handles = [self.terrain_tiles.get(tile_id, self.stream) for tile_id in tile_ids]
+        self.terrain_tiles.trim(tile_ids)
+
+        # the sensor plane inputs are held until build_ias synchronizes the stream
+        sensor_gas_handle, d_sensor_gas_buffer, sensor_build_inputs = build_gas(
+            self.ctx, optix_state.sensor_vert_grid, optix_state.sensor_tri_grid, self.stream
+        )
+        ias_handle, d_ias_buffer = build_ias(
+            self.ctx, gas_handles + [sensor_gas_handle], self.stream
+        )
+
+        sbt = create_sbt(self.prog_groups)
+        return launch_tiles(
+            optix_state,
+            self.pipeline,
+            sbt,
+            ias_handle,
+            self.render_streams,
+            output_tile_size,
+            footprint_margin,
+        )
+
 
 class ProcessOrthoOp(Operator):
     def __init__(self, *args, **kwargs):
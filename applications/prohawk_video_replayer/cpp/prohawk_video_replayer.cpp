@@ -32,7 +32,7 @@ class ProhawkVideoProcessingApp : public holoscan::Application {
     auto replayer = make_operator<ops::VideoStreamReplayerOp>(
         "replayer", from_config("replayer"), Arg("directory", datapath));
 
-    auto prohawkOP = make_operator<ops::ProhawkOp>("input");
+    auto prohawkOP = make_operator<ops::ProhawkOp>("input", from_config("prohawk"));
     auto visualizer = make_operator<ops::HolovizOp>("holoviz", from_config("holoviz"));
 
     add_flow(replayer, prohawkOP, {{"", "input"}});
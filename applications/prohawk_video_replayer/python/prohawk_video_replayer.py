@@ -31,7 +31,7 @@ class ProhawkVideoProcessingApp(Application):
         replayer = VideoStreamReplayerOp(
             self, name="replayer", directory=self.datapath, **self.kwargs("replayer")
         )
-        prohawk_op = ProhawkOp(self, name="input")
+        prohawk_op = ProhawkOp(self, name="input", **self.kwargs("prohawk"))
         visualizer = HolovizOp(self, name="holoviz", **self.kwargs("holoviz"))
 
         self.add_flow(replayer, prohawk_op, {("output", "input")})
@@ -0,0 +1,155 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Valley Tech Systems, Inc.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <cuda_bf16.h>
+#include <cuda_fp16.h>
+#include <cuda_runtime.h>
+#include <cuda/std/complex>
+
+#include "matx.h"
+
+// Packet placement kernel of the VITA 49 RX connector, kept in a header so the kernel
+// benchmarks can launch it without the operator
+
+// One warp places each packet, so 4 packets per block
+constexpr int WARPS_PER_BLOCK = 4;
+
+// Convert one big-endian 16-bit I/Q pair to a scaled complex float
+__device__ inline float2 iq_to_float2(const uint32_t word, const float scalar) {
+  // Swap the bytes within each 16-bit half: I is the low half, Q the high half
+  const uint32_t swapped = __byte_perm(word, 0, 0x2301);
+  return make_float2(static_cast<int16_t>(swapped & 0xFFFF) * scalar,
+                     static_cast<int16_t>(swapped >> 16) * scalar);
+}
+
+__device__ inline void store_sample(cuda::std::complex<float>& dst, const float2 v) {
+  dst = cuda::std::complex<float>(v.x, v.y);
+}
+
+__device__ inline void store_sample(matx::matxFp16Complex& dst, const float2 v) {
+  reinterpret_cast<__half2&>(dst) = __float22half2_rn(v);
+}
+
+__device__ inline void store_sample(matx::matxBf16Complex& dst, const float2 v) {
+  reinterpret_cast<__nv_bfloat162&>(dst) = __float22bfloat162_rn(v);
+}
+
+// Store 4 consecutive samples to a 16-byte aligned dst, with 16-byte stores
+__device__ inline void store_samples(cuda::std::complex<float>* dst, const float2 s0,
+                                     const float2 s1, const float2 s2, const float2 s3) {
+  float4* dst4 = reinterpret_cast<float4*>(dst);
+  dst4[0] = make_float4(s0.x, s0.y, s1.x, s1.y);
+  dst4[1] = make_float4(s2.x, s2.y, s3.x, s3.y);
+}
+
+template <typename T>
+__device__ inline void store_samples(T* dst, const float2 s0, const float2 s1,
+                                     const float2 s2, const float2 s3) {
+  uint4 packed;
+  T* samples = reinterpret_cast<T*>(&packed);
+  store_sample(samples[0], s0);
+  store_sample(samples[1], s1);
+  store_sample(samples[2], s2);
+  store_sample(samples[3], s3);
+  *reinterpret_cast<uint4*>(dst) = packed;
+}
+
+// CUDA kernel to place one VRT packet per warp, as complex float or half precision samples
+template <typename T>
+__global__ void place_packet_data_kernel(T* out,
+                                         const void* const* const __restrict__ in,
+                                         const int cur_idx,
+                                         const int num_packets_per_batch,
+                                         const int num_complex_samples_per_packet
+  ) {
+  // Warmup
+  if (out == nullptr)
+    return;
+
+  const int lane = threadIdx.x % warpSize;
+  const int packet = blockIdx.x * WARPS_PER_BLOCK + threadIdx.x / warpSize;
+  if (packet >= num_packets_per_batch)
+    return;
+
+  // The in pointer is an array holding a pointer to the samples of each packet slot
+  // of the batch (in[12500]), in packet count order. A null pointer is a dropped packet.
+  //
+  // The out pointer is a 3d tensor with structure:
+  // 1                        2
+  // ---------------------------------------------
+  // [P1][P2][P3]...[P20]     [P1][P2][P3]...[P20]
+  // [P21][P22]...[P40]       [P21][P22]...[P40]
+  // ...                      ...
+  // [P12780]...[P12800]      [P12780]...[P12800]
+  // so packet slots are laid out back to back within section cur_idx.
+  const int n = num_complex_samples_per_packet;
+  T* dst = out + (static_cast<size_t>(cur_idx) * num_packets_per_batch + packet) * n;
+  const void* src = in[packet];
+
+  if (src == nullptr) {
+    for (int i = lane; i < n; i += warpSize) {
+      store_sample(dst[i], make_float2(0.0f, 0.0f));
+    }
+    return;
+  }
+
+  // Scale the int16 values to -1.0 thru +1.0 by dividing by 2^15 - 1 (0x7FFF)
+  constexpr float scalar = 1.0 / 0x7FFF;
+
+  // 16-byte loads of 4 interleaved 16-bit I/Q samples, stored as two float4, or one
+  // uint4 of half precision samples
+  int vectorized = 0;
+  if (reinterpret_cast<uintptr_t>(src) % sizeof(uint4) == 0 &&
+      reinterpret_cast<uintptr_t>(dst) % sizeof(uint4) == 0) {
+    vectorized = n / 4;
+    const uint4* src4 = reinterpret_cast<const uint4*>(src);
+    for (int i = lane; i < vectorized; i += warpSize) {
+      const uint4 words = src4[i];
+      store_samples(dst + 4 * i,
+                    iq_to_float2(words.x, scalar),
+                    iq_to_float2(words.y, scalar),
+                    iq_to_float2(words.z, scalar),
+                    iq_to_float2(words.w, scalar));
+    }
+    vectorized *= 4;
+  }
+
+  // Remaining samples, or the whole packet if the payload is not 16-byte aligned
+  const uint32_t* words = reinterpret_cast<const uint32_t*>(src);
+  for (int i = vectorized + lane; i < n; i += warpSize) {
+    store_sample(dst[i], iq_to_float2(words[i], scalar));
+  }
+}
+
+template <typename T>
+void place_packet_data(T* out,
+                       const void* const* const in,
+                       const uint16_t cur_idx,
+                       const int num_packets_per_batch,
+                       const int num_complex_samples_per_packet,
+                       cudaStream_t stream) {
+  // At this point, we're processing num_ffts_per_batch * num_packets_per_fft packet slots
+  // (e.g. 625 * 20 = 12,500), one warp per slot so each packet is read with coalesced loads.
+  const int num_blocks = (num_packets_per_batch + WARPS_PER_BLOCK - 1) / WARPS_PER_BLOCK;
+  place_packet_data_kernel<<<num_blocks, WARPS_PER_BLOCK * 32, 0, stream>>>(
+          out,
+          in,
+          cur_idx,
+          num_packets_per_batch,
+          num_complex_samples_per_packet);
+}
@@ -0,0 +1,467 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Valley Tech Systems, Inc.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "vita49_psd_tx.h"
+#include "vita49_rx.h"
+
+#include <arpa/inet.h>
+#include <endian.h>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+using in_t = std::tuple<tensor_t<int8_t, 1>, cudaStream_t>;
+
+// Header buffer bytes of each packet, enough for the UDP and context packet headers
+constexpr size_t HEADER_STRIDE = 160;
+// Words of a data packet header: VRT header, stream ID, integer and fractional timestamps
+constexpr size_t DATA_HEADER_WORDS = 5;
+// Words of a context packet: header, CIF0, CIF1, three CIF0 fields and the spectrum field
+constexpr size_t CONTEXT_PACKET_WORDS = 26;
+
+namespace holoscan::ops {
+
+namespace {
+
+// Writes the headers and PSD bytes of one packet per block into its TX buffer
+__global__ void write_psd_packets(void* const* packets,
+                                  const PsdTxPacket* descs,
+                                  const uint8_t* headers,
+                                  const int8_t* psds) {
+  const PsdTxPacket desc = descs[blockIdx.x];
+  uint8_t* pkt = static_cast<uint8_t*>(packets[blockIdx.x]);
+  for (int i = threadIdx.x; i < desc.header_len; i += blockDim.x) {
+    pkt[i] = headers[desc.header_offset + i];
+  }
+
+  int8_t* payload = reinterpret_cast<int8_t*>(pkt + desc.header_len);
+  const int8_t* src = psds + desc.payload_offset;
+  for (int i = threadIdx.x; i < desc.payload_len + desc.padding; i += blockDim.x) {
+    payload[i] = i < desc.payload_len ? src[i] : 0;
+  }
+}
+
+void put_be32(uint8_t*& out, uint32_t val) {
+  val = htonl(val);
+  memcpy(out, &val, sizeof(val));
+  out += sizeof(val);
+}
+
+void put_be64(uint8_t*& out, uint64_t val) {
+  val = htobe64(val);
+  memcpy(out, &val, sizeof(val));
+  out += sizeof(val);
+}
+
+int64_t to_fixed(double val, int radix) {
+  return static_cast<int64_t>(std::llround(val * static_cast<double>(1LL << radix)));
+}
+
+uint16_t ipv4_checksum(const void* hdr, size_t len) {
+  const uint8_t* bytes = static_cast<const uint8_t*>(hdr);
+  uint32_t sum = 0;
+  for (size_t i = 0; i + 1 < len; i += 2) { sum += (bytes[i] << 8) | bytes[i + 1]; }
+  while (sum >> 16) { sum = (sum & 0xffff) + (sum >> 16); }
+  return htons(static_cast<uint16_t>(~sum));
+}
+
+}  // namespace
+
+bool Vita49PsdConnectorOpTx::ContextFields::operator==(const ContextFields& other) const {
+  return rf_ref_freq_hz == other.rf_ref_freq_hz && sample_rate_sps == other.sample_rate_sps &&
+         bandwidth_hz == other.bandwidth_hz && spectrum_type == other.spectrum_type &&
+         window_type == other.window_type &&
+         num_transform_points == other.num_transform_points &&
+         num_window_points == other.num_window_points && resolution_hz == other.resolution_hz &&
+         span_hz == other.span_hz && num_averages == other.num_averages &&
+         weighting_factor == other.weighting_factor && f1_index == other.f1_index &&
+         f2_index == other.f2_index && window_time_delta == other.window_time_delta;
+}
+
+void Vita49PsdConnectorOpTx::setup(OperatorSpec& spec) {
+  spec.input<in_t>("in");
+
+  spec.param<int>(burst_size_,
+      "burst_size",
+      "Burst size",
+      "Number of int8 PSD bins of each channel");
+  spec.param<uint16_t>(num_channels_,
+      "num_channels",
+      "Number of channels",
+      "Number of channels to send", 1);
+  spec.param<uint16_t>(first_channel_,
+      "first_channel",
+      "First channel",
+      "Channel number of the first channel of the input", 0);
+  spec.param<int32_t>(device_,
+      "device",
+      "CUDA device",
+      "CUDA device holding the PSDs and the TX packet buffers", 0);
+  spec.param<std::string>(interface_name_,
+      "interface_name",
+      "Name of the TX port",
+      "Name of the TX port from the advanced_network config",
+      "psd_tx");
+  spec.param<uint16_t>(queue_id_,
+      "queue_id",
+      "TX queue",
+      "TX queue of the port, its memory region must be in GPU memory", 0);
+  spec.param<std::string>(eth_dst_addr_,
+      "eth_dst_addr",
+      "Ethernet destination",
+      "Destination MAC address of the packets");
+  spec.param<std::string>(ip_src_addr_,
+      "ip_src_addr",
+      "IP source",
+      "Source IPv4 address of the packets");
+  spec.param<std::string>(ip_dst_addr_,
+      "ip_dst_addr",
+      "IP destination",
+      "Destination IPv4 address of the packets");
+  spec.param<uint16_t>(base_dest_port_,
+      "base_dest_port",
+      "Base destination port",
+      "Base destination UDP port of the packets (+ channel)");
+  spec.param<uint16_t>(max_payload_size_,
+      "max_payload_size",
+      "Max payload size",
+      "Most PSD bytes per data packet, a multiple of 4. Larger PSDs are split into several "
+      "packets", 8192);
+  spec.param<uint32_t>(context_interval_,
+      "context_interval",
+      "Context interval",
+      "PSDs of a channel between two context packets, 0 to only send them on changes", 10);
+  spec.param<uint32_t>(num_inflight_bursts_,
+      "num_inflight_bursts",
+      "Number of bursts in flight",
+      "Bursts being written by the GPU before waiting for the oldest one", 8);
+}
+
+void Vita49PsdConnectorOpTx::initialize() {
+  holoscan::Operator::initialize();
+
+  port_id_ = get_port_id(interface_name_.get());
+  if (port_id_ == -1) {
+    HOLOSCAN_LOG_ERROR("Invalid TX port {} specified in the config", interface_name_.get());
+    exit(1);
+  }
+  if (max_payload_size_.get() == 0 || max_payload_size_.get() % 4 != 0) {
+    HOLOSCAN_LOG_ERROR("max_payload_size must be a non-zero multiple of 4, got {}",
+                       max_payload_size_.get());
+    exit(1);
+  }
+  if (get_mac_addr(port_id_, eth_src_) != Status::SUCCESS) {
+    HOLOSCAN_LOG_ERROR("Failed to get the MAC address of TX port {}", interface_name_.get());
+    exit(1);
+  }
+  format_eth_addr(eth_dst_, eth_dst_addr_.get());
+  inet_pton(AF_INET, ip_src_addr_.get().c_str(), &ip_src_);
+  inet_pton(AF_INET, ip_dst_addr_.get().c_str(), &ip_dst_);
+
+  packets_per_psd_ = (burst_size_.get() + max_payload_size_.get() - 1) / max_payload_size_.get();
+  max_packets_ = num_channels_.get() * (packets_per_psd_ + 1);
+  channels_.resize(num_channels_.get());
+
+  // The kernel reads the packet pointers, descriptors and headers from pinned memory
+  cudaSetDevice(device_.get());
+  inflight_.resize(num_inflight_bursts_.get());
+  for (auto& slot : inflight_) {
+    cudaHostAlloc(reinterpret_cast<void**>(&slot.packets), max_packets_ * sizeof(void*),
+                  cudaHostAllocMapped);
+    cudaHostAlloc(reinterpret_cast<void**>(&slot.descs), max_packets_ * sizeof(PsdTxPacket),
+                  cudaHostAllocMapped);
+    cudaHostAlloc(reinterpret_cast<void**>(&slot.headers), max_packets_ * HEADER_STRIDE,
+                  cudaHostAllocMapped);
+    cudaEventCreateWithFlags(&slot.written, cudaEventDisableTiming);
+  }
+  HOLOSCAN_LOG_INFO("Sending {} channels as {} data packets per PSD on TX port {} queue {}",
+                    num_channels_.get(), packets_per_psd_, interface_name_.get(),
+                    queue_id_.get());
+}
+
+Vita49PsdConnectorOpTx::~Vita49PsdConnectorOpTx() {
+  for (auto& slot : inflight_) {
+    if (slot.written != nullptr) {
+      cudaEventSynchronize(slot.written);
+      cudaEventDestroy(slot.written);
+    }
+    cudaFreeHost(slot.packets);
+    cudaFreeHost(slot.descs);
+    cudaFreeHost(slot.headers);
+  }
+}
+
+Vita49PsdConnectorOpTx::ChannelSend Vita49PsdConnectorOpTx::channel_send(
+        uint16_t channel, MetadataDictionary& meta, size_t psd_offset) const {
+  ChannelSend send;
+  send.channel = channel;
+  send.psd_offset = psd_offset;
+  send.stream_id = meta.get<uint32_t>("stream_id", 0);
+  send.integer_timestamp = meta.get<uint32_t>("integer_timestamp", 0);
+  send.fractional_timestamp = meta.get<uint64_t>("fractional_timestamp", 0);
+  send.change_indicator = meta.get<bool>("change_indicator", false);
+
+  auto& context = send.context;
+  context.rf_ref_freq_hz = meta.get<double>("rf_ref_freq_hz", 0.0);
+  context.sample_rate_sps = meta.get<double>("sample_rate_hz", 0.0);
+  context.bandwidth_hz = meta.get<double>("bandwidth_hz", 0.0);
+  context.spectrum_type = meta.get<uint8_t>("spectrum_type", 0);
+  context.window_type = meta.get<uint8_t>("window_type", 0);
+  context.num_transform_points = meta.get<uint32_t>("num_transform_points", 0);
+  context.num_window_points = meta.get<uint32_t>("num_window_points", 0);
+  context.resolution_hz = meta.get<uint64_t>("resolution", 0);
+  context.span_hz = meta.get<uint64_t>("span", 0);
+  context.num_averages = meta.get<uint32_t>("num_averages", 0);
+  context.weighting_factor = static_cast<int32_t>(meta.get<float>("weighting_factor", 0.0f));
+  context.f1_index = meta.get<int32_t>("f1_index", 0);
+  context.f2_index = meta.get<int32_t>("f2_index", 0);
+  context.window_time_delta = meta.get<uint32_t>("window_time_delta", 0);
+
+  const auto& state = channels_[channel];
+  send.send_context = !state.context_sent || send.change_indicator ||
+                      !(context == state.context) ||
+                      (context_interval_.get() > 0 &&
+                       state.psds_since_context >= context_interval_.get());
+  return send;
+}
+
+size_t Vita49PsdConnectorOpTx::write_udp_headers(uint8_t* out, uint16_t channel,
+                                                 size_t vrt_len) const {
+  auto* pkt = reinterpret_cast<advanced_network::UDPIPV4Pkt*>(out);
+  memset(pkt, 0, sizeof(*pkt));
+  memcpy(pkt->eth.h_dest, eth_dst_, sizeof(eth_dst_));
+  memcpy(pkt->eth.h_source, eth_src_, sizeof(eth_src_));
+  pkt->eth.h_proto = htons(ETH_P_IP);
+
+  pkt->ip.version = 4;
+  pkt->ip.ihl = sizeof(pkt->ip) / 4;
+  pkt->ip.tot_len = htons(sizeof(pkt->ip) + sizeof(pkt->udp) + vrt_len);
+  pkt->ip.frag_off = htons(IP_DF);
+  pkt->ip.ttl = 64;
+  pkt->ip.protocol = IPPROTO_UDP;
+  pkt->ip.saddr = ip_src_;
+  pkt->ip.daddr = ip_dst_;
+  pkt->ip.check = ipv4_checksum(&pkt->ip, sizeof(pkt->ip));
+
+  // No UDP checksum, it is optional over IPv4
+  const uint16_t port = base_dest_port_.get() + first_channel_.get() + channel;
+  pkt->udp.source = htons(port);
+  pkt->udp.dest = htons(port);
+  pkt->udp.len = htons(sizeof(pkt->udp) + vrt_len);
+  return sizeof(*pkt);
+}
+
+size_t Vita49PsdConnectorOpTx::write_data_header(uint8_t* out, const ChannelSend& send,
+                                                 uint8_t count, size_t payload_len) const {
+  const size_t vrt_len = DATA_HEADER_WORDS * 4 + payload_len;
+  uint8_t* p = out + write_udp_headers(out, send.channel, vrt_len);
+
+  // Signal data packet with stream ID, UTC integer and picosecond fractional timestamps
+  put_be32(p, (1u << 28) | (1u << 22) | (2u << 20) | ((count & 0xf) << 16) | (vrt_len / 4));
+  put_be32(p, send.stream_id);
+  put_be32(p, send.integer_timestamp);
+  put_be64(p, send.fractional_timestamp);
+  return p - out;
+}
+
+size_t Vita49PsdConnectorOpTx::write_context_packet(uint8_t* out, const ChannelSend& send,
+                                                    uint8_t count) const {
+  uint8_t* p = out + write_udp_headers(out, send.channel, CONTEXT_PACKET_WORDS * 4);
+  const auto& context = send.context;
+
+  put_be32(p, (4u << 28) | (1u << 22) | (2u << 20) | ((count & 0xf) << 16) |
+              CONTEXT_PACKET_WORDS);
+  put_be32(p, send.stream_id);
+  put_be32(p, send.integer_timestamp);
+  put_be64(p, send.fractional_timestamp);
+
+  // CIF0: change indicator, bandwidth, RF reference frequency, sample rate and CIF1 enable.
+  // CIF1: spectrum. Fields follow in CIF0 then CIF1 bit order, most significant first
+  put_be32(p, (send.change_indicator ? (1u << 31) : 0) | (1u << 29) | (1u << 27) | (1u << 21) |
+              (1u << 1));
+  put_be32(p, 1u << 10);
+  put_be64(p, to_fixed(context.bandwidth_hz, BW_RADIX));
+  put_be64(p, to_fixed(context.rf_ref_freq_hz, FREQ_RADIX));
+  put_be64(p, to_fixed(context.sample_rate_sps, SR_RADIX));
+
+  put_be32(p, context.spectrum_type);
+  put_be32(p, context.window_type);
+  put_be32(p, context.num_transform_points);
+  put_be32(p, context.num_window_points);
+  put_be64(p, to_fixed(context.resolution_hz, FREQ_RADIX));
+  put_be64(p, to_fixed(context.span_hz, FREQ_RADIX));
+  put_be32(p, context.num_averages);
+  put_be32(p, context.weighting_factor);
+  put_be32(p, context.f1_index);
+  put_be32(p, context.f2_index);
+  put_be32(p, context.window_time_delta);
+  return p - out;
+}
+
+void Vita49PsdConnectorOpTx::compute(InputContext& op_input,
+                                     OutputContext& op_output,
+                                     ExecutionContext& context) {
+  static int not_available_count = 0;
+  cudaSetDevice(device_.get());
+  auto input = op_input.receive<in_t>("in").value();
+  auto& psds = std::get<0>(input);
+  cudaStream_t stream = std::get<1>(input);
+  auto meta = metadata();
+
+  sends_.clear();
+  if (meta->has_key("batched_channels")) {
+    // Batched input: one PSD per channel, each with the metadata of its channel
+    using ChannelMetadata = std::vector<std::shared_ptr<MetadataDictionary>>;
+    auto channel_metadata = meta->get<ChannelMetadata>("channel_metadata", ChannelMetadata{});
+    for (uint16_t channel = 0; channel < num_channels_.get(); channel++) {
+      MetadataDictionary* channel_meta = meta.get();
+      if (channel < channel_metadata.size() && channel_metadata[channel]) {
+        channel_meta = channel_metadata[channel].get();
+      }
+      sends_.push_back(channel_send(channel, *channel_meta,
+                                    static_cast<size_t>(channel) * burst_size_.get()));
+    }
+  } else {
+    if (!meta->has_key("channel_number")) {
+      HOLOSCAN_LOG_CRITICAL("Input metadata does not have channel_number set");
+      throw std::runtime_error("Missing channel_number");
+    }
+    const int channel = meta->get<uint16_t>("channel_number") - first_channel_.get();
+    if (channel < 0 || channel >= num_channels_.get()) {
+      HOLOSCAN_LOG_CRITICAL("Channel {} is outside of the configured channels {} to {}",
+                            channel + first_channel_.get(), first_channel_.get(),
+                            first_channel_.get() + num_channels_.get() - 1);
+      throw std::runtime_error("Invalid channel_number");
+    }
+    sends_.push_back(channel_send(channel, *meta, 0));
+  }
+
+  size_t num_packets = 0;
+  for (const auto& send : sends_) { num_packets += packets_per_psd_ + (send.send_context ? 1 : 0); }
+
+  // Make room for this input, only waiting if every burst is in flight
+  send_written(inflight_count_ == inflight_.size() ? 1 : 0);
+
+  auto burst = create_tx_burst_params();
+  set_header(burst, port_id_, queue_id_.get(), num_packets, 1);
+  if (!is_tx_burst_available(burst)) {
+    // Dropped PSDs don't count for the context state, so a context change is sent with the next
+    if (++not_available_count == 10000) {
+      HOLOSCAN_LOG_ERROR(
+        "TX port {}, queue {}, burst not available too many times consecutively. "
+        "Make sure memory region has enough buffers",
+        port_id_, queue_id_.get());
+      not_available_count = 0;
+    }
+    free_tx_metadata(burst);
+    ttl_psds_dropped_ += sends_.size();
+    return;
+  }
+  not_available_count = 0;
+
+  Status ret;
+  if ((ret = get_tx_packet_burst(burst)) != Status::SUCCESS) {
+    HOLOSCAN_LOG_ERROR("Error returned from get_tx_packet_burst: {}", static_cast<int>(ret));
+    ttl_psds_dropped_ += sends_.size();
+    return;
+  }
+
+  auto& slot = inflight_[(inflight_head_ + inflight_count_) % inflight_.size()];
+  size_t pkt = 0;
+  auto add_packet = [&](uint16_t header_len, size_t payload_offset, uint16_t payload_len) {
+    auto& desc = slot.descs[pkt];
+    desc.header_offset = pkt * HEADER_STRIDE;
+    desc.header_len = header_len;
+    desc.payload_offset = payload_offset;
+    desc.payload_len = payload_len;
+    desc.padding = (4 - payload_len % 4) % 4;
+    return set_packet_lengths(burst, pkt++, {header_len + payload_len + desc.padding});
+  };
+
+  for (const auto& send : sends_) {
+    auto& channel = channels_[send.channel];
+    if (send.send_context) {
+      const auto len =
+          write_context_packet(slot.headers + pkt * HEADER_STRIDE, send, channel.context_count);
+      if ((ret = add_packet(len, 0, 0)) != Status::SUCCESS) { break; }
+      channel.context_count = (channel.context_count + 1) & 0xf;
+      channel.context = send.context;
+      channel.context_sent = true;
+      channel.psds_since_context = 0;
+      ttl_context_pkts_++;
+    }
+
+    for (size_t i = 0; i < packets_per_psd_ && ret == Status::SUCCESS; i++) {
+      const size_t offset = i * max_payload_size_.get();
+      const size_t payload_len =
+          std::min<size_t>(max_payload_size_.get(), burst_size_.get() - offset);
+      const size_t padded_len = (payload_len + 3) / 4 * 4;
+      const auto len = write_data_header(slot.headers + pkt * HEADER_STRIDE, send,
+                                         channel.data_count, padded_len);
+      ret = add_packet(len, send.psd_offset + offset, payload_len);
+      channel.data_count = (channel.data_count + 1) & 0xf;
+      ttl_data_pkts_++;
+    }
+    if (ret != Status::SUCCESS) { break; }
+    channel.psds_since_context++;
+  }
+  if (ret != Status::SUCCESS) {
+    HOLOSCAN_LOG_ERROR("Failed to set lengths for packet {}", pkt - 1);
+    free_all_packets_and_burst_tx(burst);
+    return;
+  }
+
+  // One block per packet writes its headers and PSD bytes into the GPU packet buffer
+  get_packet_ptrs(burst, 0, slot.packets);
+  write_psd_packets<<<num_packets, 128, 0, stream>>>(
+      slot.packets, slot.descs, slot.headers, psds.Data());
+  cudaEventRecord(slot.written, stream);
+  slot.burst = burst;
+  inflight_count_++;
+
+  send_written(0);
+}
+
+void Vita49PsdConnectorOpTx::send_written(size_t min_bursts) {
+  while (inflight_count_ > 0) {
+    auto& slot = inflight_[inflight_head_];
+    if (min_bursts > 0) {
+      cudaEventSynchronize(slot.written);
+      min_bursts--;
+    } else if (cudaEventQuery(slot.written) != cudaSuccess) {
+      break;
+    }
+    send_tx_burst(slot.burst);
+    slot.burst = nullptr;
+    inflight_head_ = (inflight_head_ + 1) % inflight_.size();
+    inflight_count_--;
+  }
+}
+
+void Vita49PsdConnectorOpTx::stop() {
+  send_written(inflight_count_);
+  HOLOSCAN_LOG_INFO("Vita49PsdConnectorOpTx exit report:");
+  HOLOSCAN_LOG_INFO(
+      "\n"
+      "    Data packets sent: {}\n"
+      " Context packets sent: {}\n"
+      "         PSDs dropped: {}\n",
+      ttl_data_pkts_,
+      ttl_context_pkts_,
+      ttl_psds_dropped_);
+}
+
+}  // namespace holoscan::ops
@@ -0,0 +1,154 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Valley Tech Systems, Inc.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <vector>
+#include "holoscan/holoscan.hpp"
+#include "matx.h"
+#include "advanced_network/common.h"
+
+namespace holoscan::ops {
+
+// A packet of a TX burst: its Ethernet, IP, UDP and VRT headers, built on the host, followed by
+// payload_len bytes of the PSDs and zero padding to a 32-bit word
+struct PsdTxPacket {
+  uint32_t header_offset;   // Offset of the headers in the header buffer of the burst
+  uint32_t payload_offset;  // Offset of the payload in the PSDs
+  uint16_t header_len;
+  uint16_t payload_len;
+  uint16_t padding;
+};
+
+/**
+ * @brief Sends PSDs as VITA 49.2 packets through advanced_network TX, straight from the GPU
+ *
+ * Alternative to V49PsdPacketizer, which copies the PSDs to the host and sends them over kernel
+ * UDP. The few dozen header bytes of each packet are built from the metadata into a pinned
+ * buffer, and one kernel writes them with the int8 PSDs into the TX packet buffers in GPU
+ * memory. The burst holding the packets of every channel of an input is sent once the kernel
+ * is done, without the PSDs going through the host.
+ *
+ * PSDs larger than max_payload_size are split into several data packets so that they fit the
+ * MTU. The context packet of a channel is sent again when its fields change, when the input
+ * sets change_indicator, or every context_interval PSDs.
+ */
+class Vita49PsdConnectorOpTx : public Operator {
+ public:
+  HOLOSCAN_OPERATOR_FORWARD_ARGS(Vita49PsdConnectorOpTx)
+
+  Vita49PsdConnectorOpTx() = default;
+
+  ~Vita49PsdConnectorOpTx();
+
+  void setup(OperatorSpec& spec) override;
+  void initialize() override;
+  void compute(InputContext& op_input,
+               OutputContext& op_output,
+               ExecutionContext& context) override;
+  void stop() override;
+
+ private:
+  // Context packet fields of a channel
+  struct ContextFields {
+    double rf_ref_freq_hz = 0.0;
+    double sample_rate_sps = 0.0;
+    double bandwidth_hz = 0.0;
+    uint8_t spectrum_type = 0;
+    uint8_t window_type = 0;
+    uint32_t num_transform_points = 0;
+    uint32_t num_window_points = 0;
+    double resolution_hz = 0.0;
+    double span_hz = 0.0;
+    uint32_t num_averages = 0;
+    int32_t weighting_factor = 0;
+    int32_t f1_index = 0;
+    int32_t f2_index = 0;
+    uint32_t window_time_delta = 0;
+
+    bool operator==(const ContextFields& other) const;
+  };
+
+  // One channel of the current input
+  struct ChannelSend {
+    uint16_t channel;  // Index from first_channel
+    size_t psd_offset;
+    uint32_t stream_id = 0;
+    uint32_t integer_timestamp = 0;
+    uint64_t fractional_timestamp = 0;
+    bool change_indicator = false;
+    bool send_context = false;
+    ContextFields context;
+  };
+
+  struct Channel {
+    uint8_t data_count = 0;  // 4-bit VRT packet counts of the data and context packets
+    uint8_t context_count = 0;
+    bool context_sent = false;
+    uint32_t psds_since_context = 0;
+    ContextFields context;
+  };
+
+  // TX burst whose packets the GPU is writing, with the pinned buffers its kernel reads
+  struct InflightBurst {
+    advanced_network::BurstParams* burst = nullptr;
+    cudaEvent_t written = nullptr;
+    void** packets = nullptr;
+    PsdTxPacket* descs = nullptr;
+    uint8_t* headers = nullptr;
+  };
+
+  ChannelSend channel_send(uint16_t channel, MetadataDictionary& meta, size_t psd_offset) const;
+  size_t write_udp_headers(uint8_t* out, uint16_t channel, size_t vrt_len) const;
+  size_t write_context_packet(uint8_t* out, const ChannelSend& send, uint8_t count) const;
+  size_t write_data_header(uint8_t* out, const ChannelSend& send, uint8_t count,
+                           size_t payload_len) const;
+  void send_written(size_t min_bursts);
+
+  Parameter<int> burst_size_;
+  Parameter<uint16_t> num_channels_;
+  Parameter<uint16_t> first_channel_;
+  Parameter<int32_t> device_;
+  Parameter<std::string> interface_name_;
+  Parameter<uint16_t> queue_id_;
+  Parameter<std::string> eth_dst_addr_;
+  Parameter<std::string> ip_src_addr_;
+  Parameter<std::string> ip_dst_addr_;
+  Parameter<uint16_t> base_dest_port_;
+  Parameter<uint16_t> max_payload_size_;
+  Parameter<uint32_t> context_interval_;
+  Parameter<uint32_t> num_inflight_bursts_;
+
+  int port_id_;
+  char eth_src_[6];
+  char eth_dst_[6];
+  uint32_t ip_src_;  // Network order
+  uint32_t ip_dst_;
+  size_t packets_per_psd_;
+  size_t max_packets_;  // Packets of an input with every channel and its context
+
+  std::vector<Channel> channels_;
+  std::vector<ChannelSend> sends_;
+  std::vector<InflightBurst> inflight_;
+  size_t inflight_head_ = 0;  // Oldest burst not sent yet
+  size_t inflight_count_ = 0;
+
+  uint64_t ttl_data_pkts_ = 0;
+  uint64_t ttl_context_pkts_ = 0;
+  uint64_t ttl_psds_dropped_ = 0;
+};  // Vita49PsdConnectorOpTx
+
+}  // namespace holoscan::ops
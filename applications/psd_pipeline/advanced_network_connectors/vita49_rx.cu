@@ -17,86 +17,18 @@
 #include "vita49_rx.h"
 #include "swap.h"
 #include "swap.cuh"
+#include "place_packet_data.cuh"
 
-using out_t = std::tuple<tensor_t<complex, 2>, cudaStream_t>;
+#include <type_traits>
 
-constexpr uint32_t CONTEXT_QUEUE_ID = 0;
+template <typename T>
+using stream_tensor_t = std::tuple<tensor_t<T, 2>, cudaStream_t>;
+using out_t = stream_tensor_t<complex>;
 
 using namespace std::complex_literals;
 
-// CUDA kernel to process an individual VRT packet
-__global__ void place_packet_data_kernel(complex* out,
-                                         const void* const* const __restrict__ in,
-                                         const int cur_idx,
-                                         const int num_complex_samples_per_packet
-  ) {
-  // Warmup
-  if (out == nullptr)
-    return;
-
-  // The in pointer is an array holding a pointer to the samples for
-  // an entire batch (in[640]).
-  // blockIdx.x is the packet row and threadIdx.x the packet index
-  // This assumes interleaved 16-bit short IQ samples
-  const int16_t *samples = reinterpret_cast<const int16_t*>(
-          in[(blockIdx.x * blockDim.x) + threadIdx.x]);
-
-  // Scale the int16 values to -1.0 thru +1.0 by dividing by 2^15 - 1 (0x7FFF)
-  constexpr float scalar = 1.0 / 0x7FFF;
-
-  // The out pointer is a 4d tensor with structure:
-  // 1                        2
-  // ---------------------------------------------
-  // [P1][P2][P3]...[P20]     [P1][P2][P3]...[P20]
-  // [P21][P22]...[P40]       [P21][P22]...[P40]
-  // ...                      ...
-  // [P12780]...[P12800]      [P12780]...[P12800]
-  // We want to get to the index of one of these packets.
-  // gridDim.x is num_ffts_per_batch
-  // blockDim.x is num_packets_per_fft
-  // blockIdx.x is the packet row
-  // threadIdx.x is the packet index
-  // First, get to the right section of the output tensor (1 or 2),
-  // then, index into the row,
-  // then, index into the packet
-  size_t offset = (num_complex_samples_per_packet * blockDim.x * gridDim.x * cur_idx)
-                + (num_complex_samples_per_packet * blockDim.x * blockIdx.x)
-                + (num_complex_samples_per_packet * threadIdx.x);
-
-  // Copy data while performing an endian flip and casting to complex float
-  for (size_t i = 0; i < num_complex_samples_per_packet; ++i) {
-    out[offset + i] = complex(static_cast<float>(bswap_16(samples[i * 2])) * scalar,
-                      static_cast<float>(bswap_16(samples[(i * 2) + 1])) * scalar);
-  }
-}
-
-void place_packet_data(complex* out,
-                       const void* const* const in,
-                       const uint16_t cur_idx,
-                       const int num_ffts_per_batch,
-                       const int num_packets_per_fft,
-                       const int num_complex_samples_per_packet,
-                       cudaStream_t stream) {
-  // CUDA execution config <<<Dg, Db, Ns, S>>> where:
-  // Dg: dimensionality of the grid of blocks
-  // Db: dimensionality of the block of threads
-  // Ns: number of bytes in shared memory that is dynamically
-  //     allocated _per block_ for this call in addition to
-  //     the statically allocated memory
-  //  S: associated CUDA stream
-  // At this point, we're processing num_ffts_per_batch * num_packets_per_fft packets
-  // (e.g. 625 * 20 = 12,500).
-  // So, let's launch a grid for every num_packets_per_fft and a thread for every packet.
-  // This would make blockIdx.x the packet row and threadIdx.x the packet.
-  place_packet_data_kernel<<<
-      num_ffts_per_batch,
-      num_packets_per_fft,
-      num_packets_per_fft * sizeof(int), stream>>>(
-          out,
-          in,
-          cur_idx,
-          num_complex_samples_per_packet);
-}
+// Packet count values behind the expected one that are taken as reordered, not as a gap
+constexpr uint8_t REORDER_WINDOW = 4;
 
 namespace holoscan::ops {
 
@@ -135,14 +67,50 @@ void Vita49ConnectorOpRx::setup(OperatorSpec& spec) {
       "num_channels",
       "Number of channels",
       "Number of channels to process", 2);
+  spec.param<uint16_t>(first_channel_,
+      "first_channel",
+      "First channel",
+      "Channel number of the first channel to process, its data comes on RX queue first + 1",
+      0);
+  spec.param<uint16_t>(context_queue_,
+      "context_queue",
+      "Context queue",
+      "RX queue carrying the context packets of the processed channels", 0);
+  spec.param<int32_t>(device_,
+      "device",
+      "CUDA device",
+      "CUDA device holding the sample buffers of the processed channels", 0);
+  spec.param<std::string>(precision_,
+      "precision",
+      "Precision",
+      "Precision of the emitted samples: fp32, fp16 or bf16", "fp32");
   spec.param<std::string>(interface_name_,
       "interface_name",
       "Name of the RX port",
       "Name of the RX port from the advanced_network config",
       "sdr_data");
+  spec.param<bool>(event_driven_,
+      "event_driven",
+      "Event-driven RX",
+      "Run only when the manager signals ready bursts instead of polling the queues",
+      false);
+}
+
+template <typename F>
+void Vita49ConnectorOpRx::with_rf_data(std::shared_ptr<struct Channel> channel, F&& f) {
+  if (precision_.get() == "fp16") {
+    f(channel->rf_data_fp16);
+  } else if (precision_.get() == "bf16") {
+    f(channel->rf_data_bf16);
+  } else {
+    f(channel->rf_data);
+  }
 }
 
 void Vita49ConnectorOpRx::initialize() {
+  // Only waits for bursts once watched, when event_driven is set
+  rx_condition_ = fragment()->make_condition<AdvNetworkRxCondition>(name() + "_rx_ready");
+  add_arg(rx_condition_);
   holoscan::Operator::initialize();
 
   port_id_ = get_port_id(interface_name_.get());
@@ -152,14 +120,22 @@ void Vita49ConnectorOpRx::initialize() {
   }
 
   num_packets_per_batch = num_ffts_per_batch_.get() * num_packets_per_fft_.get();
+  if (precision_.get() != "fp32" && precision_.get() != "fp16" && precision_.get() != "bf16") {
+    HOLOSCAN_LOG_ERROR("Invalid precision {}, expected fp32, fp16 or bf16", precision_.get());
+    exit(1);
+  }
 
-  for (uint16_t channel_num = 0; channel_num < num_channels_.get(); channel_num++) {
+  // Buffers, streams and events of the channels live on the device of their data region
+  cudaSetDevice(device_.get());
+  for (uint16_t i = 0; i < num_channels_.get(); i++) {
     auto new_channel = std::make_shared<struct Channel>();
-    new_channel->channel_num = channel_num;
-    make_tensor(new_channel->rf_data,
-                {num_simul_batches_.get(),
-                 num_ffts_per_batch_.get(),
-                 num_packets_per_fft_.get() * num_complex_samples_per_packet_.get()});
+    new_channel->channel_num = first_channel_.get() + i;
+    with_rf_data(new_channel, [&](auto& rf_data) {
+      make_tensor(rf_data,
+                  {num_simul_batches_.get(),
+                   num_ffts_per_batch_.get(),
+                   num_packets_per_fft_.get() * num_complex_samples_per_packet_.get()});
+    });
 
     // Allocate memory and create CUDA streams for each concurrent batch
     for (int n = 0; n < num_simul_batches_.get(); n++) {
@@ -168,13 +144,15 @@ void Vita49ConnectorOpRx::initialize() {
       cudaStreamCreateWithFlags(&new_channel->streams[n], cudaStreamNonBlocking);
       cudaEventCreate(&new_channel->events[n]);
       // Warmup
-      place_packet_data(nullptr,
-                        nullptr,
-                        0,
-                        num_ffts_per_batch_.get(),
-                        num_packets_per_fft_.get(),
-                        num_complex_samples_per_packet_.get(),
-                        new_channel->streams[n]);
+      with_rf_data(new_channel, [&](auto& rf_data) {
+        using T = typename std::decay_t<decltype(rf_data)>::value_type;
+        place_packet_data<T>(nullptr,
+                             nullptr,
+                             0,
+                             num_packets_per_batch,
+                             num_complex_samples_per_packet_.get(),
+                             new_channel->streams[n]);
+      });
       cudaStreamSynchronize(new_channel->streams[n]);
     }
 
@@ -221,21 +199,42 @@ bool Vita49ConnectorOpRx::free_bufs_and_emit_arrays(
       channel->current_context.context_changed = false;
   }
 
-  auto data = slice<2>(channel->rf_data, {static_cast<index_t>(channel->cur_idx), 0, 0},
-              {matxDropDim, matxEnd, matxEnd});
-  op_output.emit(out_t {data, completed_msg.value().stream}, "out");
+  with_rf_data(channel, [&](auto& rf_data) {
+    using T = typename std::decay_t<decltype(rf_data)>::value_type;
+    auto data = slice<2>(rf_data, {static_cast<index_t>(channel->cur_idx), 0, 0},
+                {matxDropDim, matxEnd, matxEnd});
+    op_output.emit(stream_tensor_t<T> {data, completed_msg.value().stream}, "out");
+  });
   return true;
 }
 
+void Vita49ConnectorOpRx::start() {
+  if (!event_driven_.get()) { return; }
+
+  std::vector<int> queues{context_queue_.get()};
+  for (auto& channel : channel_list) { queues.push_back(channel->channel_num + 1); }
+  rx_condition_->watch(port_id_, queues);
+}
+
 void Vita49ConnectorOpRx::compute(
         InputContext& op_input,
         OutputContext& op_output,
         ExecutionContext& context) {
-  const auto num_rx_queues = get_num_rx_queues(port_id_);
+  cudaSetDevice(device_.get());
+  receive_bursts(op_output);
+
+  // Batches in flight are emitted one per compute(), keep polling until all of them are
+  for (auto& channel : channel_list) {
+    if (!channel->out_q.empty()) { return; }
+  }
+  rx_condition_->rearm();
+}
+
+void Vita49ConnectorOpRx::receive_bursts(OutputContext& op_output) {
+
   // Try to emit any waiting data on any channel that's ready (but
   // only one "emit()" call per "compute()" call).
-  for (uint16_t q = CONTEXT_QUEUE_ID + 1; q < num_rx_queues; q++) {
-    auto channel = channel_list.at(q - 1);
+  for (auto& channel : channel_list) {
     if (free_bufs_and_emit_arrays(op_output, channel)) {
       break;
     }
@@ -247,7 +246,7 @@ void Vita49ConnectorOpRx::compute(
 
   // Check for a context packet first
   BurstParams *burst;
-  auto status = get_rx_burst(&burst, port_id_, CONTEXT_QUEUE_ID);
+  auto status = get_rx_burst(&burst, port_id_, context_queue_.get());
 
   // If we have a new context packet, get the metadata out and free
   if (status == Status::SUCCESS) {
@@ -256,13 +255,15 @@ void Vita49ConnectorOpRx::compute(
       auto channel_num = get_packet_flow_id(burst, p);
 
       // Stream ID channel is 1-indexed, but our list is 0-indexed
-      if (channel_num >= num_channels_.get()) {
-          HOLOSCAN_LOG_CRITICAL("Configured for {} channels, but got context from channel {}",
-                                num_channels_.get(), channel_num);
-          throw;
+      if (channel_num < first_channel_.get() ||
+          channel_num >= first_channel_.get() + num_channels_.get()) {
+          HOLOSCAN_LOG_CRITICAL("Configured for channels {} to {}, but got context from "
+                                "channel {}", first_channel_.get(),
+                                first_channel_.get() + num_channels_.get() - 1, channel_num);
+          throw std::runtime_error("Context packet of an unexpected channel");
       }
 
-      auto channel = channel_list.at(channel_num);
+      auto channel = channel_list.at(channel_num - first_channel_.get());
 
       ContextPacket *ctxt = reinterpret_cast<ContextPacket*>(get_segment_packet_ptr(burst, 1, p));
 
@@ -318,11 +319,11 @@ void Vita49ConnectorOpRx::compute(
     return;
   }
 
-  for (uint16_t q = CONTEXT_QUEUE_ID + 1; q < num_rx_queues; q++) {
+  for (uint16_t i = 0; i < num_channels_.get(); i++) {
     // If there's new data, start processing it
-    auto status = get_rx_burst(&burst, port_id_, q);
+    auto status = get_rx_burst(&burst, port_id_, channel_list[i]->channel_num + 1);
     if (status == Status::SUCCESS) {
-      process_channel_data(op_output, burst, q - 1);
+      process_channel_data(op_output, burst, i);
     }
   }
 }
@@ -330,8 +331,8 @@ void Vita49ConnectorOpRx::compute(
 void Vita49ConnectorOpRx::process_channel_data(
         OutputContext& op_output,
         BurstParams *burst,
-        uint16_t channel_num) {
-  auto channel = channel_list.at(channel_num);
+        uint16_t channel_idx) {
+  auto channel = channel_list.at(channel_idx);
   if (!channel->context_received) {
     HOLOSCAN_LOG_INFO("Waiting to process channel {} data until context is received",
                       channel->channel_num);
@@ -349,66 +350,142 @@ void Vita49ConnectorOpRx::process_channel_data(
       channel->meta_set = true;
   }
 
+  // Place each packet in the slot given by its 4-bit VRT packet count, so dropped packets
+  // leave a zeroed hole instead of shifting the rest of the batch
   uint64_t ttl_bytes_in_cur_batch = 0;
-  for (int p = 0; p < get_num_packets(burst); p++) {
-      channel->h_dev_ptrs[channel->cur_idx][channel->aggr_pkts_recv + p]
-          = get_segment_packet_ptr(burst, 2, p);
-      ttl_bytes_in_cur_batch += get_segment_packet_length(burst, 0, p)
-          + get_segment_packet_length(burst, 1, p)
-          + get_segment_packet_length(burst, 2, p);
+  bool burst_attached = false;
+  const int num_packets = get_num_packets(burst);
+  for (int p = 0; p < num_packets; p++) {
+    ttl_bytes_in_cur_batch += get_segment_packet_length(burst, 0, p)
+        + get_segment_packet_length(burst, 1, p)
+        + get_segment_packet_length(burst, 2, p);
+
+    auto vrt = reinterpret_cast<VitaMetaData*>(get_segment_packet_ptr(burst, 1, p));
+    const uint8_t packet_count = (get_vrt_header_h(vrt) >> 16) & 0xF;
+    void* samples = get_segment_packet_ptr(burst, 2, p);
+
+    if (channel->seq_valid) {
+      const uint8_t behind = (channel->next_packet_count - packet_count) & 0xF;
+      if (behind > 0 && behind <= REORDER_WINDOW) {
+        // Late packet: fill its hole if it is still in the batch being aggregated
+        auto& ptrs = channel->h_dev_ptrs[channel->cur_idx];
+        if (behind <= channel->aggr_pkts_recv
+            && ptrs[channel->aggr_pkts_recv - behind] == nullptr) {
+          ptrs[channel->aggr_pkts_recv - behind] = samples;
+          channel->ttl_pkts_dropped--;
+          channel->ttl_pkts_reordered++;
+        } else {
+          channel->ttl_pkts_discarded++;
+        }
+        continue;
+      }
+
+      const uint8_t gap = (packet_count - channel->next_packet_count) & 0xF;
+      channel->ttl_pkts_dropped += gap;
+      for (uint8_t g = 0; g < gap; g++) {
+        add_packet_slot(channel, nullptr, burst, false, burst_attached);
+      }
+    }
+
+    channel->next_packet_count = (packet_count + 1) & 0xF;
+    channel->seq_valid = true;
+    add_packet_slot(channel, samples, burst, p == num_packets - 1, burst_attached);
   }
 
   channel->ttl_bytes_recv += ttl_bytes_in_cur_batch;
-  channel->aggr_pkts_recv += get_num_packets(burst);
+  channel->ttl_pkts_recv += num_packets;
+
+  // The burst is freed with the batch holding its last packet
+  if (!burst_attached) {
+    attach_burst(channel, burst);
+  }
+}
+
+void Vita49ConnectorOpRx::attach_burst(std::shared_ptr<struct Channel> channel,
+                                       BurstParams *burst) {
+  if (channel->cur_msg.num_batches >= MAX_ANO_BATCHES) {
+    HOLOSCAN_LOG_CRITICAL("More than {} bursts in one batch on channel {}",
+                          MAX_ANO_BATCHES, channel->channel_num);
+    throw std::runtime_error("Too many bursts in one batch");
+  }
   channel->cur_msg.msg[channel->cur_msg.num_batches++] = burst;
+}
+
+void Vita49ConnectorOpRx::add_packet_slot(
+        std::shared_ptr<struct Channel> channel,
+        void *samples,
+        BurstParams *burst,
+        bool last_packet,
+        bool& burst_attached) {
+  channel->h_dev_ptrs[channel->cur_idx][channel->aggr_pkts_recv++] = samples;
 
   // Once we've aggregated enough packets, do some work
-  if (channel->aggr_pkts_recv >= num_packets_per_batch) {
-    HOLOSCAN_LOG_DEBUG("Aggregated {} packets on channel {} index {} - sending downstream",
-                      channel->aggr_pkts_recv, channel->channel_num, channel->cur_idx);
+  if (channel->aggr_pkts_recv < num_packets_per_batch) {
+    return;
+  }
+
+  // Packets of this burst after the end of the batch go to the next one
+  if (last_packet && !burst_attached) {
+    attach_burst(channel, burst);
+    burst_attached = true;
+  }
 
-    // Copy packet I/Q contents to appropriate location in 'rf_data'
-    place_packet_data(channel->rf_data.Data(),
+  HOLOSCAN_LOG_DEBUG("Aggregated {} packets on channel {} index {} - sending downstream",
+                    channel->aggr_pkts_recv, channel->channel_num, channel->cur_idx);
+
+  // Copy packet I/Q contents to appropriate location in 'rf_data'
+  with_rf_data(channel, [&](auto& rf_data) {
+    place_packet_data(rf_data.Data(),
                       channel->h_dev_ptrs[channel->cur_idx],
                       channel->cur_idx,
-                      num_ffts_per_batch_.get(),
-                      num_packets_per_fft_.get(),
+                      num_packets_per_batch,
                       num_complex_samples_per_packet_.get(),
                       channel->streams[channel->cur_idx]);
+  });
+
+  cudaEventRecord(channel->events[channel->cur_idx], channel->streams[channel->cur_idx]);
+  channel->cur_msg.stream = channel->streams[channel->cur_idx];
+  channel->cur_msg.evt = channel->events[channel->cur_idx];
+  channel->out_q.push(channel->cur_msg);
+  channel->cur_msg.num_batches = 0;
+
+  auto ret = cudaGetLastError();
+  if (ret != cudaSuccess) {
+    HOLOSCAN_LOG_ERROR("CUDA error with {} packets in batch", num_packets_per_batch);
+    HOLOSCAN_LOG_ERROR("Error: {}", cudaGetErrorString(ret));
+    exit(1);
+  }
 
-    cudaEventRecord(channel->events[channel->cur_idx], channel->streams[channel->cur_idx]);
-    channel->cur_msg.stream = channel->streams[channel->cur_idx];
-    channel->cur_msg.evt = channel->events[channel->cur_idx];
-    channel->out_q.push(channel->cur_msg);
-    channel->cur_msg.num_batches = 0;
-
-    channel->ttl_pkts_recv += channel->aggr_pkts_recv;
-
-    auto ret = cudaGetLastError();
-    if (ret != cudaSuccess) {
-      HOLOSCAN_LOG_ERROR("CUDA error with {} packets in batch", num_ffts_per_batch_.get());
-      HOLOSCAN_LOG_ERROR("Error: {}", cudaGetErrorString(ret));
-      exit(1);
-    }
-
-    channel->meta_set = false;
-    channel->aggr_pkts_recv = 0;
-    channel->cur_idx = (channel->cur_idx + 1) % num_simul_batches_.get();
+  if (channel->ttl_pkts_dropped > channel->batch_pkts_dropped) {
+    HOLOSCAN_LOG_WARN("Channel {} dropped {} packets in the last batch",
+                      channel->channel_num,
+                      channel->ttl_pkts_dropped - channel->batch_pkts_dropped);
   }
+  channel->batch_pkts_dropped = channel->ttl_pkts_dropped;
+
+  channel->meta_set = false;
+  channel->aggr_pkts_recv = 0;
+  channel->cur_idx = (channel->cur_idx + 1) % num_simul_batches_.get();
 }
 
 void Vita49ConnectorOpRx::stop() {
+  rx_condition_->unwatch();
   HOLOSCAN_LOG_INFO("Vita49ConnectorOpRx exit report:");
-  for (uint16_t channel_num = 0; channel_num < num_channels_.get(); channel_num++) {
-    auto channel = channel_list.at(channel_num);
+  for (auto& channel : channel_list) {
     HOLOSCAN_LOG_INFO(
         "\n"
         "------- CH {} --------\n"
         "   Processed bytes: {}\n"
-        " Processed packets: {}\n",
+        " Processed packets: {}\n"
+        "   Dropped packets: {}\n"
+        " Reordered packets: {}\n"
+        " Discarded packets: {}\n",
         channel->channel_num,
         channel->ttl_bytes_recv,
-        channel->ttl_pkts_recv);
+        channel->ttl_pkts_recv,
+        channel->ttl_pkts_dropped,
+        channel->ttl_pkts_reordered,
+        channel->ttl_pkts_discarded);
   }
 }
 }  // namespace holoscan::ops
@@ -19,10 +19,13 @@
 #include "holoscan/holoscan.hpp"
 #include "matx.h"
 #include "advanced_network/common.h"
+#include "advanced_network/rx_condition.h"
 
 using namespace holoscan::advanced_network;
 using namespace matx;
 using complex = cuda::std::complex<float>;
+using complex_fp16 = matxFp16Complex;
+using complex_bf16 = matxBf16Complex;
 
 struct VitaMetaData {
     uint32_t vrt_header;
@@ -77,6 +80,7 @@ class Vita49ConnectorOpRx : public Operator {
   void compute(InputContext& op_input,
                OutputContext& op_output,
                ExecutionContext& context) override;
+  void start() override;
   void stop() override;
 
  private:
@@ -88,8 +92,14 @@ class Vita49ConnectorOpRx : public Operator {
   Parameter<uint16_t> num_ffts_per_batch_;
   Parameter<uint16_t> num_simul_batches_;
   Parameter<uint16_t> num_channels_;
+  Parameter<uint16_t> first_channel_;
+  Parameter<uint16_t> context_queue_;
+  Parameter<int32_t> device_;
+  Parameter<std::string> precision_;
   Parameter<std::string> interface_name_;
+  Parameter<bool> event_driven_;
   int port_id_;
+  std::shared_ptr<holoscan::advanced_network::AdvNetworkRxCondition> rx_condition_;
   uint32_t num_packets_per_batch;
 
   // Holds burst buffers that cannot be freed yet
@@ -103,7 +113,10 @@ class Vita49ConnectorOpRx : public Operator {
   struct Channel {
     uint16_t channel_num;
     int cur_idx = 0;
+    // Only the buffer of the output precision is allocated
     tensor_t<complex, 3> rf_data;
+    tensor_t<complex_fp16, 3> rf_data_fp16;
+    tensor_t<complex_bf16, 3> rf_data_bf16;
     std::array<void **, num_concurrent> h_dev_ptrs;
     std::array<cudaStream_t, num_concurrent> streams;
     std::array<cudaEvent_t, num_concurrent> events;
@@ -115,17 +128,34 @@ class Vita49ConnectorOpRx : public Operator {
     std::queue<RxMsg> out_q;
     uint64_t ttl_bytes_recv = 0;
     uint64_t ttl_pkts_recv = 0;
-    uint64_t aggr_pkts_recv = 0;
+    uint64_t aggr_pkts_recv = 0;   // Packet slots filled in the current batch
+    bool seq_valid = false;        // A packet count has been seen
+    uint8_t next_packet_count = 0;
+    uint64_t ttl_pkts_dropped = 0;
+    uint64_t ttl_pkts_reordered = 0;
+    uint64_t ttl_pkts_discarded = 0;  // Duplicates, or too late for their batch
+    uint64_t batch_pkts_dropped = 0;  // ttl_pkts_dropped at the end of the last batch
   };
 
   std::vector<std::shared_ptr<struct Channel>> channel_list;
 
+  // Calls f with the sample buffer of the output precision
+  template <typename F>
+  void with_rf_data(std::shared_ptr<struct Channel> channel, F&& f);
   std::optional<RxMsg> free_buf(std::shared_ptr<struct Channel> channel);
   bool free_bufs_and_emit_arrays(OutputContext& op_output, std::shared_ptr<struct Channel> channel);
+  void receive_bursts(OutputContext& op_output);
   void process_channel_data(
           OutputContext& op_output,
           BurstParams *burst,
-          uint16_t channel_num);
+          uint16_t channel_idx);
+  void add_packet_slot(
+          std::shared_ptr<struct Channel> channel,
+          void *samples,
+          BurstParams *burst,
+          bool last_packet,
+          bool& burst_attached);
+  void attach_burst(std::shared_ptr<struct Channel> channel, BurstParams *burst);
 };  // Vita49ConnectorOpRx
 
 }  // namespace holoscan::ops
@@ -3,8 +3,22 @@
 // SPDX-License-Identifier: Apache-2.0
 #include "data_writer.hpp"
 
+#include <fcntl.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstring>
+
+#ifdef DATA_WRITER_GDS
+#include <cufile.h>
+#endif
+
 using in_t = std::tuple<tensor_t<complex, 2>, cudaStream_t>;
 
+namespace {
+// Alignment of the buffers, file offsets and sizes used with O_DIRECT
+constexpr size_t DIRECT_IO_ALIGNMENT = 4096;
+}  // namespace
+
 namespace holoscan::ops {
 
 void DataWriter::setup(OperatorSpec& spec) {
@@ -17,14 +31,129 @@ void DataWriter::setup(OperatorSpec& spec) {
         "num_bursts",
         "Number of bursts"
         "Number of sample bursts to process at once");
+    spec.param(mode,
+        "mode",
+        "Mode",
+        "snapshot: overwrite one file per channel on each compute(), "
+        "record: stream every input to a rolling set of files",
+        std::string("snapshot"));
+    spec.param(output_dir,
+        "output_dir",
+        "Output directory",
+        "Directory for the recording files",
+        std::string("."));
+    spec.param(file_prefix,
+        "file_prefix",
+        "File prefix",
+        "Prefix of the recording files",
+        std::string("data_writer_rec"));
+    spec.param(file_size_mb,
+        "file_size_mb",
+        "File size (MB)",
+        "Size each recording file is preallocated to before moving to the next one",
+        static_cast<uint64_t>(4096));
+    spec.param(num_files,
+        "num_files",
+        "Number of files",
+        "Number of recording files in the rolling set, the oldest is overwritten",
+        8u);
+    spec.param(queue_depth,
+        "queue_depth",
+        "Queue depth",
+        "Number of staging buffers waiting to be written, inputs are dropped when all are busy",
+        8u);
+    spec.param(use_gds,
+        "use_gds",
+        "Use GPUDirect Storage",
+        "Write device memory straight to storage through cuFile when available",
+        false);
 }
 
 void DataWriter::initialize() {
     holoscan::Operator::initialize();
-    make_tensor(data_host, {num_bursts.get(), burst_size.get()}, MATX_HOST_MEMORY);
+
+    if (mode.get() == "snapshot") {
+        make_tensor(data_host, {num_bursts.get(), burst_size.get()}, MATX_HOST_MEMORY);
+        return;
+    }
+    if (mode.get() != "record") {
+        HOLOSCAN_LOG_CRITICAL("Invalid data writer mode {}, expected snapshot or record",
+            mode.get());
+        throw std::runtime_error("Invalid mode");
+    }
+    recording = true;
+
+    const size_t bytes = sizeof(complex) * num_bursts.get() * burst_size.get();
+    record_size = (bytes + DIRECT_IO_ALIGNMENT - 1) / DIRECT_IO_ALIGNMENT * DIRECT_IO_ALIGNMENT;
+    records_per_file = (file_size_mb.get() << 20) / record_size;
+    if (records_per_file == 0 || num_files.get() == 0 || queue_depth.get() == 0) {
+        HOLOSCAN_LOG_CRITICAL("file_size_mb must hold at least one {} byte record, and "
+            "num_files and queue_depth must be at least 1", record_size);
+        throw std::runtime_error("Invalid recording configuration");
+    }
+
+#ifdef DATA_WRITER_GDS
+    if (use_gds.get()) {
+        CUfileError_t status = cuFileDriverOpen();
+        if (status.err == CU_FILE_SUCCESS) {
+            gds = true;
+        } else {
+            HOLOSCAN_LOG_WARN("cuFile driver unavailable ({}), writing through host memory",
+                static_cast<int>(status.err));
+        }
+    }
+#else
+    if (use_gds.get()) {
+        HOLOSCAN_LOG_WARN("The data writer was built without cuFile, writing through host memory");
+    }
+#endif
+
+    staging.resize(queue_depth.get());
+    for (size_t i = 0; i < staging.size(); i++) {
+        auto& buf = staging[i];
+        cudaError_t err = gds ? cudaMalloc(&buf.data, record_size)
+                              : cudaMallocHost(&buf.data, record_size);
+        if (err != cudaSuccess ||
+                reinterpret_cast<uintptr_t>(buf.data) % DIRECT_IO_ALIGNMENT != 0 ||
+                cudaEventCreateWithFlags(&buf.copied, cudaEventDisableTiming) != cudaSuccess) {
+            HOLOSCAN_LOG_CRITICAL("Failed to allocate {} byte aligned staging buffer",
+                record_size);
+            throw std::runtime_error("Failed to allocate staging buffer");
+        }
+        // The padding after the burst is written as zeros
+        if (gds) {
+            cudaMemset(buf.data, 0, record_size);
+        } else {
+            memset(buf.data, 0, record_size);
+        }
+#ifdef DATA_WRITER_GDS
+        if (gds) {
+            CUfileError_t status = cuFileBufRegister(buf.data, record_size, 0);
+            if (status.err != CU_FILE_SUCCESS) {
+                HOLOSCAN_LOG_CRITICAL("Failed to register GDS buffer: {}",
+                    static_cast<int>(status.err));
+                throw std::runtime_error("Failed to register GDS buffer");
+            }
+        }
+#endif
+        free_buffers.push_back(i);
+    }
+
+    HOLOSCAN_LOG_INFO("Recording {} byte bursts to {} files of {} records in {}{}",
+        bytes, num_files.get(), records_per_file, output_dir.get(), gds ? " with GDS" : "");
+    open_file(0);
+    io_thread = std::thread(&DataWriter::io_loop, this);
 }
 
 void DataWriter::compute(InputContext& op_input, OutputContext& op_output, ExecutionContext&) {
+    if (recording) {
+        compute_record(op_input);
+    } else {
+        compute_snapshot(op_input);
+    }
+}
+
+void DataWriter::compute_snapshot(InputContext& op_input) {
     auto data = op_input.receive<in_t>("in").value();
     copy(data_host, std::get<0>(data));
 
@@ -48,4 +177,208 @@ void DataWriter::compute(InputContext& op_input, OutputContext& op_output, Execu
     out_file.close();
 }
 
+void DataWriter::compute_record(InputContext& op_input) {
+    auto data = op_input.receive<in_t>("in").value();
+    auto& in = std::get<0>(data);
+    auto stream = std::get<1>(data);
+
+    // Never block the pipeline on storage: drop the burst if every buffer is busy
+    size_t buffer;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (free_buffers.empty()) {
+            if (dropped++ % 100 == 0) {
+                HOLOSCAN_LOG_WARN("Storage is falling behind, {} bursts dropped", dropped.load());
+            }
+            return;
+        }
+        buffer = free_buffers.back();
+        free_buffers.pop_back();
+    }
+
+    auto& buf = staging[buffer];
+    const size_t bytes = sizeof(complex) * num_bursts.get() * burst_size.get();
+    cudaMemcpyAsync(buf.data, in.Data(), bytes,
+        gds ? cudaMemcpyDeviceToDevice : cudaMemcpyDeviceToHost, stream);
+    cudaEventRecord(buf.copied, stream);
+
+    auto meta = metadata();
+    Record record;
+    record.buffer = buffer;
+    record.channel_number = meta->get<uint16_t>("channel_number", 0);
+    record.stream_id = meta->get<uint32_t>("stream_id", 0);
+    record.integer_timestamp = meta->get<uint32_t>("integer_timestamp", 0);
+    record.fractional_timestamp = meta->get<uint64_t>("fractional_timestamp", 0);
+    record.bandwidth_hz = meta->get<double>("bandwidth_hz", 0.0);
+    record.rf_ref_freq_hz = meta->get<double>("rf_ref_freq_hz", 0.0);
+    record.sample_rate_hz = meta->get<double>("sample_rate_hz", 0.0);
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        pending.push_back(record);
+    }
+    cv.notify_one();
+}
+
+void DataWriter::io_loop() {
+    while (true) {
+        Record record;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            cv.wait(lock, [this] { return stopping || !pending.empty(); });
+            if (pending.empty()) {
+                return;
+            }
+            record = pending.front();
+            pending.pop_front();
+        }
+
+        cudaEventSynchronize(staging[record.buffer].copied);
+        write_record(record);
+
+        std::lock_guard<std::mutex> lock(mutex);
+        free_buffers.push_back(record.buffer);
+    }
+}
+
+void DataWriter::open_file(size_t index) {
+    close_file();
+    file_index = index;
+    file_records = 0;
+
+    const std::string base = output_dir.get() + "/" + file_prefix.get() + "_" +
+        std::to_string(index);
+    const std::string path = base + ".dat";
+    fd = open(path.c_str(), O_WRONLY | O_CREAT | O_DIRECT, 0644);
+    if (fd < 0 && errno == EINVAL && !gds) {
+        HOLOSCAN_LOG_WARN("{} does not support O_DIRECT, using buffered writes", output_dir.get());
+        fd = open(path.c_str(), O_WRONLY | O_CREAT, 0644);
+    }
+    if (fd < 0) {
+        HOLOSCAN_LOG_CRITICAL("Failed to open {}: {}", path, strerror(errno));
+        throw std::runtime_error("Failed to open recording file");
+    }
+
+    // Preallocate so the writes never extend the file
+    const off_t file_bytes = static_cast<off_t>(records_per_file * record_size);
+    int ret = ftruncate(fd, file_bytes) == 0 ? posix_fallocate(fd, 0, file_bytes) : errno;
+    if (ret != 0) {
+        HOLOSCAN_LOG_WARN("Failed to preallocate {} bytes for {}: {}",
+            file_bytes, path, strerror(ret));
+    }
+
+#ifdef DATA_WRITER_GDS
+    if (gds) {
+        CUfileDescr_t descr{};
+        descr.handle.fd = fd;
+        descr.type = CU_FILE_HANDLE_TYPE_OPAQUE_FD;
+        CUfileError_t status = cuFileHandleRegister(&cufile_handle, &descr);
+        if (status.err != CU_FILE_SUCCESS) {
+            HOLOSCAN_LOG_CRITICAL("Failed to register {} with cuFile: {}",
+                path, static_cast<int>(status.err));
+            throw std::runtime_error("Failed to register recording file");
+        }
+    }
+#endif
+
+    index_file.open(base + ".idx", std::ios::out | std::ios::trunc);
+    index_file << "offset,bytes,channel_number,stream_id,integer_timestamp,"
+                  "fractional_timestamp,bandwidth_hz,rf_ref_freq_hz,sample_rate_hz\n";
+    HOLOSCAN_LOG_INFO("Recording to {}", path);
+}
+
+void DataWriter::close_file() {
+    if (index_file.is_open()) {
+        index_file.close();
+    }
+#ifdef DATA_WRITER_GDS
+    if (cufile_handle != nullptr) {
+        cuFileHandleDeregister(cufile_handle);
+        cufile_handle = nullptr;
+    }
+#endif
+    if (fd >= 0) {
+        close(fd);
+        fd = -1;
+    }
+}
+
+void DataWriter::write_record(const Record& record) {
+    if (file_records == records_per_file) {
+        open_file((file_index + 1) % num_files.get());
+    }
+
+    const off_t offset = static_cast<off_t>(file_records * record_size);
+    const void* data = staging[record.buffer].data;
+    ssize_t written;
+#ifdef DATA_WRITER_GDS
+    if (gds) {
+        written = cuFileWrite(cufile_handle, data, record_size, offset, 0);
+    } else {
+        written = pwrite(fd, data, record_size, offset);
+    }
+#else
+    written = pwrite(fd, data, record_size, offset);
+#endif
+    if (written != static_cast<ssize_t>(record_size)) {
+        HOLOSCAN_LOG_ERROR("Failed to write record {} to file {}: {}",
+            records_written, file_index, written < 0 ? strerror(errno) : "short write");
+        return;
+    }
+
+    index_file << offset << ","
+               << sizeof(complex) * num_bursts.get() * burst_size.get() << ","
+               << record.channel_number << ","
+               << record.stream_id << ","
+               << record.integer_timestamp << ","
+               << record.fractional_timestamp << ","
+               << record.bandwidth_hz << ","
+               << record.rf_ref_freq_hz << ","
+               << record.sample_rate_hz << "\n";
+    index_file.flush();
+    file_records++;
+    records_written++;
+}
+
+void DataWriter::stop() {
+    if (!io_thread.joinable()) {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    cv.notify_one();
+    io_thread.join();
+    close_file();
+    HOLOSCAN_LOG_INFO("Recorded {} bursts, dropped {}", records_written, dropped.load());
+}
+
+DataWriter::~DataWriter() {
+    stop();
+    for (auto& buf : staging) {
+        if (buf.copied != nullptr) {
+            cudaEventDestroy(buf.copied);
+        }
+        if (buf.data == nullptr) {
+            continue;
+        }
+#ifdef DATA_WRITER_GDS
+        if (gds) {
+            cuFileBufDeregister(buf.data);
+        }
+#endif
+        if (gds) {
+            cudaFree(buf.data);
+        } else {
+            cudaFreeHost(buf.data);
+        }
+    }
+#ifdef DATA_WRITER_GDS
+    if (gds) {
+        cuFileDriverClose();
+    }
+#endif
+}
+
 }  // namespace holoscan::ops
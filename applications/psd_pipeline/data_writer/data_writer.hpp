@@ -1,7 +1,13 @@
 // SPDX-FileCopyrightText: 2024 Valley Tech Systems, Inc.
 //
 // SPDX-License-Identifier: Apache-2.0
+#include <atomic>
+#include <condition_variable>
+#include <deque>
 #include <fstream>
+#include <mutex>
+#include <thread>
+#include <vector>
 #include <matx.h>
 #include "holoscan/holoscan.hpp"
 
@@ -14,15 +20,70 @@ class DataWriter : public Operator {
      HOLOSCAN_OPERATOR_FORWARD_ARGS(DataWriter)
 
      DataWriter() = default;
+     ~DataWriter();
 
      void setup(OperatorSpec& spec) override;
      void initialize() override;
      void compute(InputContext& op_input, OutputContext& op_output, ExecutionContext&) override;
+     void stop() override;
 
  private:
+     // One burst waiting for the I/O thread, with its index sidecar fields
+     struct Record {
+         size_t buffer;
+         uint16_t channel_number;
+         uint32_t stream_id;
+         uint32_t integer_timestamp;
+         uint64_t fractional_timestamp;
+         double bandwidth_hz;
+         double rf_ref_freq_hz;
+         double sample_rate_hz;
+     };
+
+     // Staging buffer for one burst, pinned host memory or registered device memory for GDS
+     struct Staging {
+         void* data = nullptr;
+         cudaEvent_t copied = nullptr;
+     };
+
+     void compute_snapshot(InputContext& op_input);
+     void compute_record(InputContext& op_input);
+     void io_loop();
+     void open_file(size_t index);
+     void close_file();
+     void write_record(const Record& record);
+
      tensor_t<complex, 2> data_host;
      Parameter<int> burst_size;
      Parameter<int> num_bursts;
+     Parameter<std::string> mode;
+     Parameter<std::string> output_dir;
+     Parameter<std::string> file_prefix;
+     Parameter<uint64_t> file_size_mb;
+     Parameter<uint32_t> num_files;
+     Parameter<uint32_t> queue_depth;
+     Parameter<bool> use_gds;
+
+     bool recording = false;
+     bool gds = false;
+     size_t record_size = 0;   // Burst size padded to the O_DIRECT alignment
+     size_t records_per_file = 0;
+     std::vector<Staging> staging;
+     std::vector<size_t> free_buffers;
+     std::deque<Record> pending;
+     std::mutex mutex;
+     std::condition_variable cv;
+     std::thread io_thread;
+     bool stopping = false;
+     std::atomic<uint64_t> dropped{0};
+
+     // Only used by the I/O thread
+     int fd = -1;
+     size_t file_index = 0;
+     size_t file_records = 0;
+     std::ofstream index_file;
+     uint64_t records_written = 0;
+     void* cufile_handle = nullptr;  // CUfileHandle_t, kept opaque so the header has no cuFile
 };
 
 }  // namespace holoscan::ops
@@ -1,15 +1,28 @@
 // SPDX-FileCopyrightText: 2024 Valley Tech Systems, Inc.
 //
 // SPDX-License-Identifier: Apache-2.0
+#include <string>
+#include <vector>
 #include "advanced_network_connectors/vita49_rx.h"
+#include "advanced_network_connectors/vita49_psd_tx.h"
 #include <fft.hpp>
+#include <fused_psd.hpp>
 #include <high_rate_psd.hpp>
 #include <low_rate_psd.hpp>
+#include <matx_workspace.hpp>
 #include <vita49_psd_packetizer.hpp>
 #include <data_writer.hpp>
 
 // #define WRITE_DATA
 
+// Channels [first_channel, first_channel + num_channels) processed on one GPU
+struct GpuChain {
+    int32_t device;
+    uint16_t first_channel;
+    uint16_t num_channels;
+    uint16_t context_queue;  // RX queue with the context packets of these channels
+};
+
 class PsdPipeline : public holoscan::Application {
  public:
     void compose() override {
@@ -22,46 +35,144 @@ class PsdPipeline : public holoscan::Application {
         }
         HOLOSCAN_LOG_INFO("Configured the Advanced Network manager");
 
-        auto vitaConnectorOp = make_operator<ops::Vita49ConnectorOpRx>(
-            "vitaConnectorOp",
-            from_config("vita_connector"));
+        auto chains = gpu_chains();
+        for (size_t g = 0; g < chains.size(); g++) {
+            add_chain(chains[g], chains.size() > 1 ? "_gpu" + std::to_string(g) : "");
+        }
+    }
 
-        auto fftOp = make_operator<ops::FFT>(
-            "fftOp",
-            from_config("fft"));
+ private:
+    // The gpu_chains section, or one chain with every channel on GPU 0
+    std::vector<GpuChain> gpu_chains() {
+        std::vector<GpuChain> chains;
+        for (const auto& yaml_node : config().yaml_nodes()) {
+            if (!yaml_node["gpu_chains"]) {
+                continue;
+            }
+            for (const auto& chain : yaml_node["gpu_chains"]) {
+                chains.push_back(GpuChain{
+                    chain["device"].as<int32_t>(),
+                    chain["first_channel"].as<uint16_t>(),
+                    chain["num_channels"].as<uint16_t>(),
+                    chain["context_queue"].as<uint16_t>(0)});
+            }
+        }
+        if (chains.empty()) {
+            auto num_channels = from_config("vita_connector.num_channels").as<uint16_t>();
+            chains.push_back(GpuChain{0, 0, num_channels, 0});
+        }
+        return chains;
+    }
 
-        auto highRatePsdOp = make_operator<ops::HighRatePSD>(
-            "highRatePsdOp",
-            from_config("high_rate_psd"));
+    // Connector, FFT, PSD and packetizer of one chain, every operator on the chain's GPU
+    void add_chain(const GpuChain& chain, const std::string& suffix) {
+        using namespace holoscan;
 
-        auto lowRatePsdOp = make_operator<ops::LowRatePSD>(
-            "lowRatePsdOp",
-            from_config("low_rate_psd"));
+        HOLOSCAN_LOG_INFO("Channels {} to {} on GPU {}", chain.first_channel,
+                chain.first_channel + chain.num_channels - 1, chain.device);
+        ArgList chain_args{
+            Arg("device", chain.device),
+            Arg("first_channel", chain.first_channel),
+            Arg("num_channels", chain.num_channels)};
+        // Samples, spectra and high rate PSDs are stored in this precision
+        auto precision_name = from_config("precision").as<std::string>();
+        auto precision = Arg("precision", precision_name);
 
-        auto packetizerOp = make_operator<ops::V49PsdPacketizer>(
-            "packetizerOp",
-            from_config("vita49_psd_packetizer"),
-            make_condition<CountCondition>(from_config("num_psds").as<int64_t>()));
+        auto vitaConnectorOp = make_operator<ops::Vita49ConnectorOpRx>(
+            "vitaConnectorOp" + suffix,
+            from_config("vita_connector"),
+            chain_args,
+            Arg("context_queue", chain.context_queue),
+            precision);
+
+        // Output buffers and FFT plans of the FFT and PSD operators, with one cuFFT work area
+        auto workspace = make_resource<MatxWorkspacePool>(
+            "workspace" + suffix,
+            from_config("workspace"));
+
+        auto fftOp = make_operator<ops::FFT>(
+            "fftOp" + suffix,
+            from_config("fft"),
+            chain_args,
+            Arg("workspace", workspace),
+            precision);
+
+        auto packetizerOp = packetizer(chain_args, suffix);
 
         add_operator(vitaConnectorOp);
         add_operator(fftOp);
-        add_operator(highRatePsdOp);
-        add_operator(lowRatePsdOp);
         add_operator(packetizerOp);
         add_flow(vitaConnectorOp, fftOp);
-        add_flow(fftOp, highRatePsdOp);
-        add_flow(highRatePsdOp, lowRatePsdOp);
-        add_flow(lowRatePsdOp, packetizerOp);
+
+        // One kernel from FFT output to 8-bit PSD instead of the high/low rate pair
+        if (from_config("fuse_psd").as<bool>()) {
+            auto fusedPsdOp = make_operator<ops::FusedPSD>(
+                "fusedPsdOp" + suffix,
+                from_config("fused_psd"),
+                chain_args);
+            add_operator(fusedPsdOp);
+            add_flow(fftOp, fusedPsdOp);
+            add_flow(fusedPsdOp, packetizerOp);
+        } else {
+            auto highRatePsdOp = make_operator<ops::HighRatePSD>(
+                "highRatePsdOp" + suffix,
+                from_config("high_rate_psd"),
+                chain_args,
+                Arg("workspace", workspace),
+                precision);
+
+            auto lowRatePsdOp = make_operator<ops::LowRatePSD>(
+                "lowRatePsdOp" + suffix,
+                from_config("low_rate_psd"),
+                chain_args,
+                Arg("workspace", workspace));
+
+            add_operator(highRatePsdOp);
+            add_operator(lowRatePsdOp);
+            add_flow(fftOp, highRatePsdOp);
+            add_flow(highRatePsdOp, lowRatePsdOp);
+            add_flow(lowRatePsdOp, packetizerOp);
+        }
 
 #ifdef WRITE_DATA
-        auto dataWriterOp = make_operator<ops::DataWriter>(
-            "dataWriterOp",
-            from_config("data_writer"),
-            make_condition<CountCondition>(2));
-        add_operator(dataWriterOp);
-        add_flow(vitaConnectorOp, dataWriterOp);
+        // The data writer only takes complex float samples
+        if (chain.first_channel == 0 && precision_name == "fp32") {
+            auto dataWriterOp = make_operator<ops::DataWriter>(
+                "dataWriterOp",
+                from_config("data_writer"),
+                make_condition<CountCondition>(2));
+            add_operator(dataWriterOp);
+            add_flow(vitaConnectorOp, dataWriterOp);
+        }
 #endif
     }
+
+    // Sends the PSDs over kernel UDP, or from the GPU through an advanced_network TX queue
+    std::shared_ptr<holoscan::Operator> packetizer(const holoscan::ArgList& chain_args,
+            const std::string& suffix) {
+        using namespace holoscan;
+
+        auto count = make_condition<CountCondition>(
+            "packetizerCount" + suffix,
+            from_config("num_psds").as<int64_t>());
+        auto psd_tx = from_config("psd_tx").as<std::string>();
+        if (psd_tx == "advanced_network") {
+            return make_operator<ops::Vita49PsdConnectorOpTx>(
+                "packetizerOp" + suffix,
+                from_config("vita49_psd_tx"),
+                chain_args,
+                count);
+        }
+        if (psd_tx != "udp") {
+            HOLOSCAN_LOG_ERROR("Invalid psd_tx {}, expected udp or advanced_network", psd_tx);
+            exit(1);
+        }
+        return make_operator<ops::V49PsdPacketizer>(
+            "packetizerOp" + suffix,
+            from_config("vita49_psd_packetizer"),
+            chain_args,
+            count);
+    }
 };
 
 int main(int argc, char** argv) {
@@ -18,13 +18,16 @@
 #include "gxf/std/tensor.hpp"
 #include "holoscan/holoscan.hpp"
 #include "pva_unsharp_mask/pva_unsharp_mask.hpp"
+#include "pva_unsharp_mask/pva_unsharp_mask_async.hpp"
 
 #include <holoscan/operators/holoviz/holoviz.hpp>
 #include <holoscan/operators/video_stream_recorder/video_stream_recorder.hpp>
 #include <holoscan/operators/video_stream_replayer/video_stream_replayer.hpp>
 #include <holoscan/core/system/gpu_resource_monitor.hpp>
 
+#include <deque>
 #include <iostream>
+#include <memory>
 #include <string>
 
 namespace holoscan::ops {
@@ -35,9 +38,22 @@ class PVAVideoFilterExecutor : public Operator {
 
   void setup(OperatorSpec& spec) override {
     spec.param(allocator_, "allocator", "Allocator", "Allocator to allocate output tensor.");
+    spec.param(frames_in_flight_,
+               "frames_in_flight",
+               "Frames in flight",
+               "Number of frames submitted to the PVA before the oldest is waited on. Each frame "
+               "above 1 adds a frame of latency but lets the PVA work while the next frame is "
+               "prepared.",
+               3u);
     spec.input<gxf::Entity>("input");
     spec.output<gxf::Entity>("output");
   }
+
+  void stop() override {
+    // Frames still in flight are dropped once the PVA has written them
+    pvaAsync_.reset();
+    in_flight_.clear();
+  }
   void compute(InputContext& op_input, OutputContext& op_output,
                ExecutionContext& context) override {
     auto maybe_input_message = op_input.receive<gxf::Entity>("input");
@@ -88,16 +104,41 @@ class PVAVideoFilterExecutor : public Operator {
 
     if (!pvaOperatorTask_.isInitialized()) {
       pvaOperatorTask_.init(imageWidth, imageHeight, inputLinePitch, outputLinePitch);
+      pvaAsync_ = std::make_unique<PvaUnsharpMaskAsync>(pvaOperatorTask_, frames_in_flight_);
     }
-    pvaOperatorTask_.process(input_tensor_data, output_tensor_data);
-    auto result = gxf::Entity(std::move(out_message.value()));
 
-    op_output.emit(result, "output");
+    // The input message is held so its buffer stays valid until the PVA has read it
+    InFlight frame{pvaAsync_->submit(input_tensor_data, output_tensor_data),
+                   maybe_input_message.value(),
+                   gxf::Entity(std::move(out_message.value()))};
+    in_flight_.push_back(std::move(frame));
+
+    // Emit at most one frame per call: the oldest one once its fence signals, or after waiting
+    // on it when the pipeline is full
+    auto& oldest = in_flight_.front();
+    if (in_flight_.size() >= frames_in_flight_.get()) {
+      if (pvaAsync_->wait(oldest.fence) != 0) {
+        HOLOSCAN_LOG_ERROR("PVA unsharp mask failed");
+      }
+    } else if (!pvaAsync_->signaled(oldest.fence)) {
+      return;
+    }
+    op_output.emit(oldest.output, "output");
+    in_flight_.pop_front();
   }
 
  private:
+  struct InFlight {
+    PvaUnsharpMaskAsync::Fence fence;
+    gxf::Entity input;
+    gxf::Entity output;
+  };
+
   Parameter<std::shared_ptr<Allocator>> allocator_;
+  Parameter<uint32_t> frames_in_flight_;
   PvaUnsharpMask pvaOperatorTask_;
+  std::unique_ptr<PvaUnsharpMaskAsync> pvaAsync_;
+  std::deque<InFlight> in_flight_;
 };
 }  // namespace holoscan::ops
 
@@ -110,11 +151,15 @@ class App : public holoscan::Application {
     uint32_t max_height{1080};
     int64_t source_block_size = max_width * max_height * 3;
 
+    // The output blocks are allocated once and recycled, one per frame in flight plus the one
+    // held by the visualizer
+    const uint32_t frames_in_flight =
+        from_config("pva_video_filter.frames_in_flight").as<uint32_t>();
     std::shared_ptr<BlockMemoryPool> pva_allocator =
-        make_resource<BlockMemoryPool>("allocator", 1, source_block_size, 1);
+        make_resource<BlockMemoryPool>("allocator", 1, source_block_size, frames_in_flight + 1);
 
     auto pva_video_filter = make_operator<ops::PVAVideoFilterExecutor>(
-        "pva_video_filter", Arg("allocator") = pva_allocator);
+        "pva_video_filter", from_config("pva_video_filter"), Arg("allocator") = pva_allocator);
 
     auto source = make_operator<ops::VideoStreamReplayerOp>("replayer", from_config("replayer"));
 
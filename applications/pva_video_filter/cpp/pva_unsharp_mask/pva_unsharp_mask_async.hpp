@@ -0,0 +1,117 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef PVA_UNSHARP_MASK_ASYNC_HPP
+#define PVA_UNSHARP_MASK_ASYNC_HPP
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <thread>
+
+#include "pva_unsharp_mask.hpp"
+
+// Submit/fence front end for PvaUnsharpMask. The pre-compiled library only exposes a blocking
+// process() call, so submissions are executed in order by a worker thread and the caller keeps
+// several frames in flight instead of waiting on the PVA for each one. A fence is the sequence
+// number of a submission and signals once its output has been written.
+class PvaUnsharpMaskAsync {
+ public:
+  using Fence = uint64_t;
+
+  PvaUnsharpMaskAsync(PvaUnsharpMask& task, uint32_t max_in_flight)
+      : task_(task), max_in_flight_(max_in_flight > 0 ? max_in_flight : 1) {
+    worker_ = std::thread([this] { run(); });
+  }
+
+  ~PvaUnsharpMaskAsync() {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      stopping_ = true;
+    }
+    cv_.notify_all();
+    worker_.join();
+  }
+
+  PvaUnsharpMaskAsync(const PvaUnsharpMaskAsync&) = delete;
+  PvaUnsharpMaskAsync& operator=(const PvaUnsharpMaskAsync&) = delete;
+
+  // Queues src -> dst, blocking only while max_in_flight submissions are outstanding
+  Fence submit(uint8_t* src, uint8_t* dst) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    cv_.wait(lock, [this] { return submitted_ - completed_ < max_in_flight_; });
+    queue_.push_back({src, dst});
+    const Fence fence = ++submitted_;
+    lock.unlock();
+    cv_.notify_all();
+    return fence;
+  }
+
+  bool signaled(Fence fence) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return completed_ >= fence;
+  }
+
+  // Returns the first non-zero status of the process() calls so far, or 0
+  int32_t wait(Fence fence) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    cv_.wait(lock, [this, fence] { return completed_ >= fence; });
+    return status_;
+  }
+
+  uint32_t in_flight() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return static_cast<uint32_t>(submitted_ - completed_);
+  }
+
+ private:
+  struct Job {
+    uint8_t* src;
+    uint8_t* dst;
+  };
+
+  void run() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (true) {
+      cv_.wait(lock, [this] { return stopping_ || !queue_.empty(); });
+      // Drain outstanding jobs before stopping so no fence is left unsignaled
+      if (queue_.empty()) { return; }
+      const Job job = queue_.front();
+      queue_.pop_front();
+      lock.unlock();
+      const int32_t status = task_.process(job.src, job.dst);
+      lock.lock();
+      if (status != 0 && status_ == 0) { status_ = status; }
+      ++completed_;
+      cv_.notify_all();
+    }
+  }
+
+  PvaUnsharpMask& task_;
+  const uint32_t max_in_flight_;
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  std::deque<Job> queue_;
+  Fence submitted_ = 0;
+  Fence completed_ = 0;
+  int32_t status_ = 0;
+  bool stopping_ = false;
+  std::thread worker_;
+};
+
+#endif  // PVA_UNSHARP_MASK_ASYNC_HPP
@@ -15,10 +15,12 @@
  * limitations under the License.
  */
 #include <arpa/inet.h>
+#include <cub/block/block_reduce.cuh>
 #include <cuda/std/complex>
 #include "basic_network_operator_rx.h"
 #include "basic_network_operator_tx.h"
 #include "holoscan/holoscan.hpp"
+#include "holoscan/utils/cuda_stream_handler.hpp"
 #include "matx.h"
 
 using namespace matx;
@@ -32,46 +34,52 @@ struct TaggedSignalData {
   tensor_t<ComplexType, 1> signal;
 };
 
-// A detected pulse.
+// Detected pulses of one signal.
 //
-// This represents a pulse that has been found by the threshold detector.
-struct DetectedPulseSlice {
-  DetectedPulseSlice(int _id, int _offset, int _zero_bin, tensor_t<ComplexType, 1> _signal,
-                     tensor_t<ftype, 1> _power)
-      : signal(_signal), power(_power), zero_bin(_zero_bin), offset(_offset), id(_id) {}
-  // ID the pulse is derived from
+// The edges are found by the threshold detector and stay on the device, so the pulses can be
+// described without copying anything back to the host.
+struct DetectedPulses {
+  DetectedPulses(int _id, int _zero_bin, tensor_t<ComplexType, 1> _signal,
+                 tensor_t<ftype, 1> _power, tensor_t<unsigned int, 1> _rising_edges,
+                 tensor_t<unsigned int, 1> _falling_edges, tensor_t<int, 0> _rising_edge_count,
+                 tensor_t<int, 0> _falling_edge_count)
+      : id(_id),
+        zero_bin(_zero_bin),
+        signal(_signal),
+        power(_power),
+        rising_edges(_rising_edges),
+        falling_edges(_falling_edges),
+        rising_edge_count(_rising_edge_count),
+        falling_edge_count(_falling_edge_count) {}
+  // ID the pulses are derived from
   int id;
-  // Starting bin of the following tensors.
-  int offset;
   // Center bin of the original full signal.
   int zero_bin;
-  // Power of the pulse
-  tensor_t<ftype, 1> power;
-  // Raw signal of the pulse.
-  // This is not used in this implementation,
-  // But may be used to do advanced pulse charatarization.
+  // Raw signal, not used in this implementation
+  // but may be used to do advanced pulse charatarization.
   tensor_t<ComplexType, 1> signal;
+  // Power of the signal
+  tensor_t<ftype, 1> power;
+  // First bin of each pulse
+  tensor_t<unsigned int, 1> rising_edges;
+  // Bin after the last one of each pulse
+  tensor_t<unsigned int, 1> falling_edges;
+  tensor_t<int, 0> rising_edge_count;
+  tensor_t<int, 0> falling_edge_count;
 };
 
-// Processed pulse description
-struct PulseDescription {
-  PulseDescription(int _id, int _low, int _high, int _zero, float _max_amplitude, float _sum_power,
-                   float _average_amplitude)
-      : id(_id),
-        low_bin(_low),
-        high_bin(_high),
-        zero_bin(_zero),
-        max_amplitude(_max_amplitude),
-        sum_power(_sum_power),
-        average_amplitude(_average_amplitude) {}
-  // Id the pulse was derived from.
-  int id;
+// Pulse descriptor word (PDW), with the fixed layout of the network report.
+struct PulseDescriptorWord {
+  // Id the pulse was derived from, the time of arrival of the pulse.
+  uint32_t id;
   // Starting bin of the pulse
-  int low_bin;
-  // Final bin of the pulse
-  int high_bin;
+  uint32_t low_bin;
+  // Bin after the final bin of the pulse, so the width is high_bin - low_bin
+  uint32_t high_bin;
   // Center of the pulse in the original full signal.
-  int zero_bin;
+  uint32_t zero_bin;
+  // Bin of the maximum amplitude, the frequency of the pulse
+  uint32_t peak_bin;
   // Maximum amplitude of pulse
   float max_amplitude;
   // Total power of pulse
@@ -80,8 +88,75 @@ struct PulseDescription {
   float average_amplitude;
 };
 
+// PDWs of one signal, in device memory
+struct PulseDescriptions {
+  PulseDescriptions(int _id, uint32_t _max_pulses, std::shared_ptr<PulseDescriptorWord> _pdws,
+                    std::shared_ptr<uint32_t> _count)
+      : id(_id), max_pulses(_max_pulses), pdws(_pdws), count(_count) {}
+  int id;
+  uint32_t max_pulses;
+  // Array of max_pulses words, of which the first *count are valid
+  std::shared_ptr<PulseDescriptorWord> pdws;
+  std::shared_ptr<uint32_t> count;
+};
+
 // Number of int32s in the network report message.
-const unsigned int burst_length = 7;
+const unsigned int burst_length = sizeof(PulseDescriptorWord) / sizeof(uint32_t);
+
+// Number of threads describing one pulse
+constexpr int pdw_threads = 256;
+
+// Pair the rising and falling edges and describe each pulse with one block.
+__global__ void pulse_descriptor_kernel(const float* __restrict__ power,
+                                        const unsigned int* __restrict__ rising_edges,
+                                        const unsigned int* __restrict__ falling_edges,
+                                        const int* rising_edge_count,
+                                        const int* falling_edge_count,
+                                        uint32_t max_pulses,
+                                        uint32_t id,
+                                        uint32_t zero_bin,
+                                        PulseDescriptorWord* pdws,
+                                        uint32_t* count) {
+  using ArgMax = cub::KeyValuePair<int, float>;
+  using SumReduce = cub::BlockReduce<float, pdw_threads>;
+  using MaxReduce = cub::BlockReduce<ArgMax, pdw_threads>;
+  __shared__ typename SumReduce::TempStorage sum_temp;
+  __shared__ typename MaxReduce::TempStorage max_temp;
+
+  // Pulses past max_pulses are dropped
+  const int pulses = min(min(*rising_edge_count, *falling_edge_count),
+                         static_cast<int>(max_pulses));
+  if (blockIdx.x == 0 && threadIdx.x == 0) { *count = pulses; }
+
+  for (int p = blockIdx.x; p < pulses; p += gridDim.x) {
+    const unsigned int low = rising_edges[p];
+    const unsigned int high = falling_edges[p];
+
+    float sum = 0;
+    ArgMax peak(low, -1.f);
+    for (unsigned int bin = low + threadIdx.x; bin < high; bin += blockDim.x) {
+      const float v = power[bin];
+      sum += v;
+      if (v > peak.value) { peak = ArgMax(bin, v); }
+    }
+    sum = SumReduce(sum_temp).Sum(sum);
+    peak = MaxReduce(max_temp).Reduce(peak, cub::ArgMax());
+
+    if (threadIdx.x == 0) {
+      PulseDescriptorWord pdw;
+      pdw.id = id;
+      pdw.low_bin = low;
+      pdw.high_bin = high;
+      pdw.zero_bin = zero_bin;
+      pdw.peak_bin = peak.key;
+      pdw.max_amplitude = peak.value;
+      pdw.sum_power = sum;
+      pdw.average_amplitude = sum / (high - low);
+      pdws[p] = pdw;
+    }
+    __syncthreads();
+  }
+}
 
 // Displays or prints the pulse descriptions.
 class PulsePrinterOp : public holoscan::Operator {
@@ -89,8 +164,13 @@ class PulsePrinterOp : public holoscan::Operator {
   HOLOSCAN_OPERATOR_FORWARD_ARGS(PulsePrinterOp);
   PulsePrinterOp() = default;
 
+  ~PulsePrinterOp() {
+    if (host_pdws != nullptr) { cudaFreeHost(host_pdws); }
+    if (host_count != nullptr) { cudaFreeHost(host_count); }
+  }
+
   void setup(holoscan::OperatorSpec& spec) override {
-    spec.input<PulseDescription>("pulse_description");
+    spec.input<PulseDescriptions>("pulse_description");
     spec.output<NetworkOpBurstParams>("burst_out");
     // Sample rate to display the Hz on screen.
     spec.param(sample_rate, "sample_rate", "Samples per second", "Sample rate in Hz.", {});
@@ -98,73 +178,136 @@ class PulsePrinterOp : public holoscan::Operator {
     spec.param(to_screen, "to_screen", "Print data to screen", "Print Data to screen", {});
     // True if this Operator transmits on the udp network.
     spec.param(to_tx, "to_tx", "Send Data through Tx", "Send data through Tx", {});
+    cuda_stream_handler_.define_params(spec);
   }
 
   void compute(holoscan::InputContext& op_input, holoscan::OutputContext& op_output,
-               holoscan::ExecutionContext&) override {
-    auto data = op_input.receive<PulseDescription>("pulse_description");
-    // Frequency resolution of the FFT
-    float resolution_mhz = (sample_rate.get() / (2e6 * data->zero_bin));
-    float low_freq = (data->low_bin - data->zero_bin) * resolution_mhz;
-    float high_freq = (data->high_bin - data->zero_bin) * resolution_mhz;
-    // Print to screen
-    if (to_screen.get()) {
-      std::cout << "Sum power " << data->sum_power << std::endl;
-      std::cout << "Pulse started at " << low_freq << " MHz" << std::endl;
-      std::cout << "Pulse end at " << high_freq << " MHz" << std::endl;
-      std::cout << "Max power:" << data->max_amplitude << std::endl;
-      std::cout << "Average amplitude " << data->average_amplitude << std::endl;
+               holoscan::ExecutionContext& context) override {
+    auto data = op_input.receive<PulseDescriptions>("pulse_description");
+
+    // One copy of all the PDWs of the signal
+    if (data->max_pulses > host_max_pulses) {
+      if (host_pdws != nullptr) {
+        cudaFreeHost(host_pdws);
+        host_pdws = nullptr;
+        host_max_pulses = 0;
+      }
+      check_cuda(cudaMallocHost(&host_pdws, data->max_pulses * sizeof(PulseDescriptorWord)),
+                 "cudaMallocHost");
+      if (host_count == nullptr) {
+        check_cuda(cudaMallocHost(&host_count, sizeof(uint32_t)), "cudaMallocHost");
+      }
+      host_max_pulses = data->max_pulses;
     }
 
-    auto buff = new uint32_t[7];
-    // Next, place these values into a network burst operator and send it
-    if (to_tx.get()) {
-      buff[0] = htonl((uint32_t)data->id);
-      buff[1] = htonl((uint32_t)data->low_bin);
-      buff[2] = htonl((uint32_t)data->high_bin);
-      buff[3] = htonl((uint32_t)data->zero_bin);
-      buff[4] = htonl((uint32_t)data->sum_power);
-      buff[5] = htonl((uint32_t)data->max_amplitude);
-      buff[6] = htonl((uint32_t)data->average_amplitude);
-      auto out = std::make_shared<NetworkOpBurstParams>(
-          (uint8_t*)buff, sizeof(uint32_t) * burst_length, 1);
-      HOLOSCAN_LOG_INFO("Forwarding message to Network TX");
-      op_output.emit(out, "burst_out");
+    // The stream comes from the operator's stream pool. Pool streams are blocking streams, so the
+    // copies still wait for the descriptor kernel on the default stream.
+    const cudaStream_t stream = cuda_stream_handler_.get_cuda_stream(context.context());
+    check_cuda(cudaMemcpyAsync(host_count, data->count.get(), sizeof(uint32_t),
+                               cudaMemcpyDeviceToHost, stream),
+               "cudaMemcpyAsync");
+    check_cuda(cudaMemcpyAsync(host_pdws, data->pdws.get(),
+                               data->max_pulses * sizeof(PulseDescriptorWord),
+                               cudaMemcpyDeviceToHost, stream),
+               "cudaMemcpyAsync");
+    check_cuda(cudaStreamSynchronize(stream), "cudaStreamSynchronize");
+
+    for (uint32_t i = 0; i < *host_count; i++) {
+      const PulseDescriptorWord& pdw = host_pdws[i];
+      // Frequency resolution of the FFT
+      float resolution_mhz = (sample_rate.get() / (2e6 * pdw.zero_bin));
+      float low_freq = (static_cast<int>(pdw.low_bin) - static_cast<int>(pdw.zero_bin)) *
+                       resolution_mhz;
+      float high_freq = (static_cast<int>(pdw.high_bin) - static_cast<int>(pdw.zero_bin)) *
+                        resolution_mhz;
+      float peak_freq = (static_cast<int>(pdw.peak_bin) - static_cast<int>(pdw.zero_bin)) *
+                        resolution_mhz;
+      // Print to screen
+      if (to_screen.get()) {
+        std::cout << "Pulse in signal " << pdw.id << std::endl;
+        std::cout << "Sum power " << pdw.sum_power << std::endl;
+        std::cout << "Pulse started at " << low_freq << " MHz" << std::endl;
+        std::cout << "Pulse end at " << high_freq << " MHz" << std::endl;
+        std::cout << "Peak at " << peak_freq << " MHz" << std::endl;
+        std::cout << "Max power:" << pdw.max_amplitude << std::endl;
+        std::cout << "Average amplitude " << pdw.average_amplitude << std::endl;
+      }
+
+      // Next, place these values into a network burst operator and send it
+      if (to_tx.get()) {
+        auto buff = new uint32_t[burst_length];
+        buff[0] = htonl(pdw.id);
+        buff[1] = htonl(pdw.low_bin);
+        buff[2] = htonl(pdw.high_bin);
+        buff[3] = htonl(pdw.zero_bin);
+        buff[4] = htonl((uint32_t)pdw.sum_power);
+        buff[5] = htonl((uint32_t)pdw.max_amplitude);
+        buff[6] = htonl((uint32_t)pdw.average_amplitude);
+        buff[7] = htonl(pdw.peak_bin);
+        auto out = std::make_shared<NetworkOpBurstParams>(
+            (uint8_t*)buff, sizeof(uint32_t) * burst_length, 1);
+        HOLOSCAN_LOG_INFO("Forwarding message to Network TX");
+        op_output.emit(out, "burst_out");
+      }
     }
   }
   holoscan::Parameter<float> sample_rate;
   holoscan::Parameter<bool> to_screen;
   holoscan::Parameter<bool> to_tx;
+
+ private:
+  static void check_cuda(cudaError_t err, const char* call) {
+    if (err != cudaSuccess) {
+      HOLOSCAN_LOG_ERROR("{} failed: {}", call, cudaGetErrorString(err));
+      throw std::runtime_error("CUDA error in PulsePrinterOp");
+    }
+  }
+
+  holoscan::CudaStreamHandler cuda_stream_handler_;
+  PulseDescriptorWord* host_pdws = nullptr;
+  uint32_t* host_count = nullptr;
+  uint32_t host_max_pulses = 0;
 };
 
-// Calculates pulse descriptions.
+// Calculates pulse descriptions on the device.
 class PulseDescriptorOp : public holoscan::Operator {
  public:
   HOLOSCAN_OPERATOR_FORWARD_ARGS(PulseDescriptorOp);
   PulseDescriptorOp() = default;
 
   void setup(holoscan::OperatorSpec& spec) override {
-    spec.input<DetectedPulseSlice>("detected_pulses");
-    spec.output<PulseDescription>("pulse_description");
+    spec.input<DetectedPulses>("detected_pulses");
+    spec.output<PulseDescriptions>("pulse_description");
   }
 
   void compute(holoscan::InputContext& op_input, holoscan::OutputContext& op_output,
                holoscan::ExecutionContext&) override {
-    auto data = op_input.receive<DetectedPulseSlice>("detected_pulses");
-    tensor_t<float, 0> sum_power{};
-    tensor_t<float, 0> maximum_power{};
-    // Compute statistics of of the pulse. Sum and average.
-    sum(sum_power, data->power, 0);
-    rmax(maximum_power, data->power, 0);
-    cudaStreamSynchronize(0);
-    float average_amplitude = sum_power() / data->power.Size(0);
-    auto out = std::make_shared<PulseDescription>(data->id,
-                                                  data->offset,
-                                                  data->offset + data->power.Size(0),
-                                                  data->zero_bin,
-                                                  maximum_power(),
-                                                  sum_power(),
-                                                  average_amplitude);
+    auto data = op_input.receive<DetectedPulses>("detected_pulses");
+    const uint32_t max_pulses = data->rising_edges.Size(0);
+
+    // Stream-ordered allocations, freed once the last user of the message drops it
+    PulseDescriptorWord* pdws;
+    uint32_t* count;
+    cudaMallocAsync(&pdws, max_pulses * sizeof(PulseDescriptorWord), 0);
+    cudaMallocAsync(&count, sizeof(uint32_t), 0);
+
+    // Compute statistics of of the pulses. Sum, average and the peak.
+    pulse_descriptor_kernel<<<max_pulses, pdw_threads>>>(data->power.Data(),
+                                                           data->rising_edges.Data(),
+                                                           data->falling_edges.Data(),
+                                                           data->rising_edge_count.Data(),
+                                                           data->falling_edge_count.Data(),
+                                                           max_pulses,
+                                                           data->id,
+                                                           data->zero_bin,
+                                                           pdws,
+                                                           count);
+
+    auto out = std::make_shared<PulseDescriptions>(
+        data->id,
+        max_pulses,
+        std::shared_ptr<PulseDescriptorWord>(pdws, [](auto p) { cudaFreeAsync(p, 0); }),
+        std::shared_ptr<uint32_t>(count, [](auto p) { cudaFreeAsync(p, 0); }));
     op_output.emit(out, "pulse_description");
   }
 };
@@ -183,7 +326,7 @@ class ThresholdingOp : public holoscan::Operator {
   ThresholdingOp() = default;
   void setup(holoscan::OperatorSpec& spec) override {
     spec.input<TaggedSignalData>("fft_input");
-    spec.output<DetectedPulseSlice>("detected_pulses");
+    spec.output<DetectedPulses>("detected_pulses");
 
     spec.param(threshold_param,
                "threshold",
@@ -200,16 +343,19 @@ class ThresholdingOp : public holoscan::Operator {
   void compute(holoscan::InputContext& op_input, holoscan::OutputContext& op_output,
                holoscan::ExecutionContext&) override {
     auto data = op_input.receive<TaggedSignalData>("fft_input");
-    auto thresh_mask = make_tensor<char>({data->signal.Size(0) + 1});
-    tensor_t<float, 1> power = make_tensor<ftype>({data->signal.Size(0)});
+    const index_t size = data->signal.Size(0);
+    auto thresh_mask = make_tensor<char>({size + 2});
+    tensor_t<float, 1> power = make_tensor<ftype>({size});
     tensor_t<float, 0> threshold{};
 
     threshold() = threshold_param.get();
 
     (power = abs(data->signal)).run();
-    // Prepend a zero so we can shift the data to test for rising and falling edges
+    // Pad with a zero on both sides so we can shift the data to test for rising and falling
+    // edges, and a pulse running to the last sample still has a falling edge
     thresh_mask(0) = 0;
-    (thresh_mask.Slice({1}, {data->signal.Size(0) + 1}) = (power > threshold)).run();
+    thresh_mask(size + 1) = 0;
+    (thresh_mask.Slice({1}, {size + 1}) = (power > threshold)).run();
 
     tensor_t<int, 0> rising_edge_count{};
     tensor_t<int, 0> falling_edge_count{};
@@ -217,8 +363,8 @@ class ThresholdingOp : public holoscan::Operator {
     auto rising_edges_index = make_tensor<unsigned int>({max_pulse_count.get()});
     auto falling_edges_index = make_tensor<unsigned int>({max_pulse_count.get()});
 
-    auto right_shift = thresh_mask.Slice({0}, {data->signal.Size(0)});
-    auto original = thresh_mask.Slice({1}, {data->signal.Size(0) + 1});
+    auto right_shift = thresh_mask.Slice({0}, {size + 1});
+    auto original = thresh_mask.Slice({1}, {size + 2});
 
     // Threshold detector works by shifting a binary array by one and using logic to find the edges.
     // This:
@@ -239,29 +385,17 @@ class ThresholdingOp : public holoscan::Operator {
     find_idx(rising_edges_index, rising_edge_count, rising_edge_op, GT{0});
     find_idx(falling_edges_index, falling_edge_count, falling_edge_op, GT{0});
 
-    cudaStreamSynchronize(0);
-
-    if (rising_edge_count() != falling_edge_count()) {
-      HOLOSCAN_LOG_INFO("RISING AND FALLING EDGE COUNTS DO NOT MATCH");
-      for (int i = 0; i < rising_edge_count(); i++) {
-        std::cout << "Rising edge at " << rising_edges_index(i) << std::endl;
-      }
-      for (int i = 0; i < falling_edge_count(); i++) {
-        std::cout << "Falling edge at " << falling_edges_index(i) << std::endl;
-      }
-    } else {
-      for (int i = 0; i < rising_edge_count(); i++) {
-        auto out = std::make_shared<DetectedPulseSlice>(
-            data->id,
-            rising_edges_index(i),
-            // Falling edge is the index after the pulse since the slice is exclusive at the second
-            // parameter this is correct.
-            data->signal.Size(0) / 2,
-            data->signal.Slice({rising_edges_index(i)}, {falling_edges_index(i)}),
-            power.Slice({rising_edges_index(i)}, {falling_edges_index(i)}));
-        op_output.emit(out, "detected_pulses");
-      }
-    }
+    // The edges are paired on the device by PulseDescriptorOp. Falling edges are the index
+    // after the pulse, so [rising, falling) is the pulse.
+    auto out = std::make_shared<DetectedPulses>(data->id,
+                                                size / 2,
+                                                data->signal,
+                                                power,
+                                                rising_edges_index,
+                                                falling_edges_index,
+                                                rising_edge_count,
+                                                falling_edge_count);
+    op_output.emit(out, "detected_pulses");
   }
 
  private:
@@ -391,7 +525,10 @@ class App : public holoscan::Application {
     auto fft = make_operator<FFTOp>("fft");
     auto thresh = make_operator<ThresholdingOp>("pulse_detector", from_config("pulse_detector"));
     auto descrip = make_operator<PulseDescriptorOp>("pulse_descriptor");
-    auto printer = make_operator<PulsePrinterOp>("pulse_printer", from_config("printer"));
+    auto printer = make_operator<PulsePrinterOp>(
+        "pulse_printer",
+        from_config("printer"),
+        Arg("cuda_stream_pool") = make_resource<CudaStreamPool>("cuda_stream", 0, 0, 0, 1, 1));
     auto net_tx = make_operator<ops::BasicNetworkOpTx>("net_tx", from_config("network_tx"));
 
     add_flow(net_rx, convert, {{"burst_out", "burst_in"}});
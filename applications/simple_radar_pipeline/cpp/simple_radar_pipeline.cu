@@ -16,6 +16,11 @@
  */
 
 #include "holoscan/holoscan.hpp"
+#include <cooperative_groups.h>
+#include <cfloat>
+#include <cmath>
+#include <string>
+#include <cub/block/block_scan.cuh>
 #include <cuda/std/complex>
 #include "matx.h"
 
@@ -60,37 +65,225 @@ struct CFARData {
   cudaStream_t stream;
 };
 
-/* Custom MatX operator for calculation detections in CFAR step. */
-template <class O, class I1, class I2, class I3, class I4>
-class calcDets : public BaseOp<calcDets<O, I1, I2, I3, I4>> {
- private:
-    O out_;
-    I1 xpow_;
-    I2 ba_;
-    I3 norm_;
-    I4 pfa_;
+// A cell of the range-Doppler map that crossed the CFAR threshold
+struct CFARDetection {
+  int32_t channel;
+  int32_t doppler;
+  int32_t range;
+  float snr_db;  // Power of the cell over the noise estimate
+};
 
- public:
-    calcDets(O out, I1 xpow, I2 ba, I3 norm, I4 pfa)
-        : out_(out), xpow_(xpow), ba_(ba), norm_(norm), pfa_(pfa)  { }
-
-    __device__ inline void operator()(index_t idz, index_t idy, index_t idx) {
-      typename I1::type xpow = xpow_(idz, idy, idx);
-      typename I2::type ba = ba_(idz, idy, idx);
-      typename I2::type norm = norm_(idz, idy, idx);
-      typename I2::type alpha = norm * (cuda::std::powf(pfa_, -1.0f / norm) - 1.f);
-      out_(idz, idy, idx) = (xpow > alpha * ba) ? 1 : 0;
+enum class CFARMethod { CA, OS };
+
+// CFAR window and threshold, in cells on each side of the cell under test
+struct CFARConfig {
+  CFARMethod method;
+  index_t guard_doppler;
+  index_t guard_range;
+  index_t train_doppler;
+  index_t train_range;
+  float pfa;
+  float os_rank;  // Rank of the OS-CFAR noise estimate, as a fraction of the training cells
+  uint32_t max_detections;
+};
+
+/* CFAR kernels, summing the training window from a summed-area table or sorting it */
+constexpr int cfarThreads = 256;
+constexpr int maxOsCells = 128;
+
+// Number of cells in the window around the cell under test, less the guard cells
+index_t cfar_training_cells(const CFARConfig& cfg) {
+  const index_t gy = 2 * cfg.guard_doppler + 1;
+  const index_t gx = 2 * cfg.guard_range + 1;
+  const index_t wy = gy + 2 * cfg.train_doppler;
+  const index_t wx = gx + 2 * cfg.train_range;
+  return wy * wx - gy * gx;
+}
+
+// OS-CFAR noise estimate rank (1-based) among n training cells
+__host__ __device__ inline int os_rank_of(float os_rank, int n) {
+  const int k = static_cast<int>(ceilf(os_rank * n));
+  return k < 1 ? 1 : (k > n ? n : k);
+}
+
+/**
+ * Inclusive prefix sum of |X|^2 along range for every Doppler row, written from row 1 and
+ * column 1 of the summed-area table. The sums are kept in double since the box sums are
+ * differences of large prefix sums.
+ */
+__global__ void cfar_row_scan_kernel(const ComplexType* __restrict__ x,
+                                     double* __restrict__ sat,
+                                     index_t rows,
+                                     index_t cols) {
+  using BlockScan = cub::BlockScan<double, cfarThreads>;
+  __shared__ typename BlockScan::TempStorage temp;
+  __shared__ double carry;
+
+  const index_t ch = blockIdx.y;
+  const index_t row = blockIdx.x;
+  const ComplexType* in = x + (ch * rows + row) * cols;
+  double* out = sat + (ch * (rows + 1) + row + 1) * (cols + 1) + 1;
+
+  if (threadIdx.x == 0) { carry = 0; }
+  __syncthreads();
+
+  for (index_t base = 0; base < cols; base += cfarThreads) {
+    const index_t col = base + threadIdx.x;
+    double v = 0;
+    if (col < cols) {
+      const ComplexType s = in[col];
+      v = static_cast<double>(s.real()) * s.real() + static_cast<double>(s.imag()) * s.imag();
     }
+    double incl, total;
+    BlockScan(temp).InclusiveSum(v, incl, total);
+    if (col < cols) { out[col] = carry + incl; }
+    __syncthreads();
+    if (threadIdx.x == 0) { carry += total; }
+    __syncthreads();
+  }
+}
+
+// Accumulate the row prefix sums down each column to complete the summed-area table
+__global__ void cfar_col_scan_kernel(double* __restrict__ sat, index_t rows, index_t cols) {
+  const index_t col = static_cast<index_t>(blockIdx.x) * blockDim.x + threadIdx.x + 1;
+  if (col > cols) { return; }
 
-    __host__ __device__ inline index_t Size(uint32_t i) const {
-      return out_.Size(i);
+  double* s = sat + blockIdx.y * (rows + 1) * (cols + 1) + col;
+  double acc = 0;
+  for (index_t r = 1; r <= rows; r++) {
+    acc += s[r * (cols + 1)];
+    s[r * (cols + 1)] = acc;
+  }
+}
+
+// Sum of the cells in rows [r0, r1] and columns [c0, c1], both inclusive
+__device__ inline double box_sum(const double* sat, index_t stride,
+                                 index_t r0, index_t r1, index_t c0, index_t c1) {
+  return sat[(r1 + 1) * stride + c1 + 1] - sat[r0 * stride + c1 + 1] -
+         sat[(r1 + 1) * stride + c0] + sat[r0 * stride + c0];
+}
+
+// Append a detection with one atomic per group of detecting threads in the warp
+__device__ inline void push_detection(CFARDetection* dets, uint32_t* count, uint32_t max_dets,
+                                      const CFARDetection& det) {
+  auto g = cooperative_groups::coalesced_threads();
+  uint32_t base = 0;
+  if (g.thread_rank() == 0) { base = atomicAdd(count, g.size()); }
+  base = g.shfl(base, 0);
+  const uint32_t idx = base + g.thread_rank();
+  if (idx < max_dets) { dets[idx] = det; }
+}
+
+/**
+ * Cell-averaging CFAR over the summed-area table. Windows are clipped at the edges of the
+ * map and the threshold uses the number of training cells left, as the masked convolution
+ * did before.
+ */
+__global__ void ca_cfar_kernel(const ComplexType* __restrict__ x,
+                               const double* __restrict__ sat,
+                               index_t rows,
+                               index_t cols,
+                               CFARConfig cfg,
+                               CFARDetection* dets,
+                               uint32_t* count) {
+  const index_t col = static_cast<index_t>(blockIdx.x) * blockDim.x + threadIdx.x;
+  const index_t row = blockIdx.y;
+  const index_t ch = blockIdx.z;
+  if (col >= cols) { return; }
+
+  const index_t stride = cols + 1;
+  const double* s = sat + ch * (rows + 1) * stride;
+  const index_t oy = cfg.guard_doppler + cfg.train_doppler;
+  const index_t ox = cfg.guard_range + cfg.train_range;
+
+  const index_t r0 = max(row - oy, index_t{0}), r1 = min(row + oy, rows - 1);
+  const index_t c0 = max(col - ox, index_t{0}), c1 = min(col + ox, cols - 1);
+  const index_t g0 = max(row - cfg.guard_doppler, index_t{0});
+  const index_t g1 = min(row + cfg.guard_doppler, rows - 1);
+  const index_t h0 = max(col - cfg.guard_range, index_t{0});
+  const index_t h1 = min(col + cfg.guard_range, cols - 1);
+
+  const index_t n = (r1 - r0 + 1) * (c1 - c0 + 1) - (g1 - g0 + 1) * (h1 - h0 + 1);
+  if (n <= 0) { return; }
+
+  const float noise = static_cast<float>(
+      (box_sum(s, stride, r0, r1, c0, c1) - box_sum(s, stride, g0, g1, h0, h1)) / n);
+  const float xpow = cuda::std::norm(x[(ch * rows + row) * cols + col]);
+  const float alpha = n * (powf(cfg.pfa, -1.0f / n) - 1.f);
+
+  if (xpow > alpha * noise) {
+    push_detection(dets, count, cfg.max_detections,
+                   {static_cast<int32_t>(ch), static_cast<int32_t>(row),
+                    static_cast<int32_t>(col), 10.f * log10f(xpow / fmaxf(noise, FLT_MIN))});
+  }
+}
+
+// k-th smallest (0-based) of v[0, n), reordering v
+__device__ inline float select_kth(float* v, int n, int k) {
+  int lo = 0, hi = n - 1;
+  while (lo < hi) {
+    const float pivot = v[(lo + hi) / 2];
+    int i = lo, j = hi;
+    while (i <= j) {
+      while (v[i] < pivot) { i++; }
+      while (v[j] > pivot) { j--; }
+      if (i <= j) {
+        const float t = v[i];
+        v[i++] = v[j];
+        v[j--] = t;
+      }
+    }
+    if (k <= j) {
+      hi = j;
+    } else if (k >= i) {
+      lo = i;
+    } else {
+      break;
     }
+  }
+  return v[k];
+}
 
-    static inline constexpr __host__ __device__ int32_t Rank() {
-      return O::Rank();
+/**
+ * Ordered-statistic CFAR. The noise estimate is the os_rank-th training cell in sorted
+ * order and osAlpha[n] holds the threshold multiplier for n training cells.
+ */
+__global__ void os_cfar_kernel(const ComplexType* __restrict__ x,
+                               const float* __restrict__ osAlpha,
+                               index_t rows,
+                               index_t cols,
+                               CFARConfig cfg,
+                               CFARDetection* dets,
+                               uint32_t* count) {
+  const index_t col = static_cast<index_t>(blockIdx.x) * blockDim.x + threadIdx.x;
+  const index_t row = blockIdx.y;
+  const index_t ch = blockIdx.z;
+  if (col >= cols) { return; }
+
+  const ComplexType* in = x + ch * rows * cols;
+  const index_t oy = cfg.guard_doppler + cfg.train_doppler;
+  const index_t ox = cfg.guard_range + cfg.train_range;
+
+  float v[maxOsCells];
+  int n = 0;
+  for (index_t r = max(row - oy, index_t{0}); r <= min(row + oy, rows - 1); r++) {
+    const bool guard_row = r >= row - cfg.guard_doppler && r <= row + cfg.guard_doppler;
+    for (index_t c = max(col - ox, index_t{0}); c <= min(col + ox, cols - 1); c++) {
+      if (guard_row && c >= col - cfg.guard_range && c <= col + cfg.guard_range) { continue; }
+      v[n++] = cuda::std::norm(in[r * cols + c]);
     }
-};
+  }
+  if (n == 0) { return; }
+
+  const float noise = select_kth(v, n, os_rank_of(cfg.os_rank, n) - 1);
+  const float xpow = cuda::std::norm(in[row * cols + col]);
 
+  if (xpow > osAlpha[n] * noise) {
+    push_detection(dets, count, cfg.max_detections,
+                   {static_cast<int32_t>(ch), static_cast<int32_t>(row),
+                    static_cast<int32_t>(col), 10.f * log10f(xpow / fmaxf(noise, FLT_MIN))});
+  }
+}
 
 
 namespace holoscan::ops {
@@ -348,12 +541,33 @@ class CFAROp : public Operator {
 
   CFAROp() = default;
 
+  ~CFAROp() {
+    cudaFree(detections);
+    cudaFree(count);
+  }
+
   void setup(OperatorSpec& spec) override {
     spec.input<CFARData>("cfar_in");
     spec.param(numPulses, "numPulses", "Number of pulses", "Number of pulses per channel", {});
     spec.param(numChannels, "numChannels", "Number of channels", "Number of channels", {});
     spec.param(waveformLength, "waveformLength", "NWaveform length", "Length of waveform", {});
     spec.param(numSamples, "numSamples", "Number of samples", "Number of samples per channel", {});
+    spec.param(cfarMethod, "cfarMethod", "CFAR method",
+        "ca for cell-averaging or os for ordered-statistic CFAR", std::string("ca"));
+    spec.param(guardDoppler, "guardDoppler", "Doppler guard cells",
+        "Guard cells on each side of the cell under test in Doppler", 1L);
+    spec.param(guardRange, "guardRange", "Range guard cells",
+        "Guard cells on each side of the cell under test in range", 1L);
+    spec.param(trainDoppler, "trainDoppler", "Doppler training cells",
+        "Training cells on each side of the guard cells in Doppler", 1L);
+    spec.param(trainRange, "trainRange", "Range training cells",
+        "Training cells on each side of the guard cells in range", 5L);
+    spec.param(pfa, "pfa", "Probability of false alarm",
+        "Probability of false alarm the threshold is set for", 1e-5f);
+    spec.param(osRank, "osRank", "OS-CFAR rank",
+        "Rank of the OS-CFAR noise estimate, as a fraction of the training cells", 0.75f);
+    spec.param(maxDetections, "maxDetections", "Maximum detections",
+        "Size of the detection list of a CPI", 4096u);
   }
 
   void initialize() override {
@@ -367,48 +581,80 @@ class CFAROp : public Operator {
 
     numCompressedSamples = numSamples.get() - waveformLength.get() + 1;
 
-    make_tensor(normT,
-        {numChannels.get(), numPulsesRnd + cfarMaskY - 1,
-         numCompressedSamples + cfarMaskX - 1});
-    make_tensor(ba,
-        {numChannels.get(), numPulsesRnd + cfarMaskY - 1,
-         numCompressedSamples + cfarMaskX - 1});
-    make_tensor(dets,
-        {numChannels.get(), numPulsesRnd, numCompressedSamples});
-    make_tensor(xPow,
-        {numChannels.get(), numPulsesRnd, numCompressedSamples});
-    make_tensor(cfarMaskView, {cfarMaskY, cfarMaskX});
-
-    // Mask for cfar detection
-    // G == guard, R == reference, C == CUT
-    // mask = [
-    //    R R R R R ;
-    //    R R R R R ;
-    //    R R R R R ;
-    //    R R R R R ;
-    //    R R R R R ;
-    //    R G G G R ;
-    //    R G C G R ;
-    //    R G G G R ;
-    //    R R R R R ;
-    //    R R R R R ;
-    //    R R R R R ;
-    //    R R R R R ;
-    //    R R R R R ];
-    //  }
-    cfarMaskView.SetVals({{1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1},
-                           {1, 1, 1, 1, 1, 0, 0, 0, 1, 1, 1, 1, 1},
-                           {1, 1, 1, 1, 1, 0, 0, 0, 1, 1, 1, 1, 1},
-                           {1, 1, 1, 1, 1, 0, 0, 0, 1, 1, 1, 1, 1},
-                           {1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1}});
-
-    // Pre-process CFAR convolution
-    (normT = conv2d(ones({numChannels.get(), numPulsesRnd, numCompressedSamples}),
-           cfarMaskView, matxConvCorrMode_t::MATX_C_MODE_FULL)).run();
+    if (cfarMethod.get() == "ca") {
+      cfg.method = CFARMethod::CA;
+    } else if (cfarMethod.get() == "os") {
+      cfg.method = CFARMethod::OS;
+    } else {
+      throw std::runtime_error(fmt::format("Unknown cfarMethod {}", cfarMethod.get()));
+    }
+    cfg.guard_doppler = guardDoppler.get();
+    cfg.guard_range = guardRange.get();
+    cfg.train_doppler = trainDoppler.get();
+    cfg.train_range = trainRange.get();
+    cfg.pfa = pfa.get();
+    cfg.os_rank = osRank.get();
+    cfg.max_detections = maxDetections.get();
+
+    if (cfg.guard_doppler < 0 || cfg.guard_range < 0 || cfg.train_doppler < 0 ||
+        cfg.train_range < 0 || cfar_training_cells(cfg) == 0) {
+      throw std::runtime_error("CFAR needs non-negative window sizes and some training cells");
+    }
+    if (cfg.pfa <= 0.f || cfg.pfa >= 1.f) {
+      throw std::runtime_error("pfa must be in (0, 1)");
+    }
+
+    const index_t maxTrainingCells = cfar_training_cells(cfg);
+    make_tensor(osAlpha, {maxTrainingCells + 1});
+
+    if (cfg.method == CFARMethod::CA) {
+      // Row 0 and column 0 of the summed-area table stay zero
+      make_tensor(sat, {numChannels.get(), numPulsesRnd + 1, numCompressedSamples + 1});
+      cudaMemset(sat.Data(), 0, sat.TotalSize() * sizeof(double));
+    } else {
+      if (maxTrainingCells > maxOsCells) {
+        throw std::runtime_error(fmt::format(
+            "OS-CFAR supports up to {} training cells, got {}", maxOsCells, maxTrainingCells));
+      }
+      if (cfg.os_rank <= 0.f || cfg.os_rank > 1.f) {
+        throw std::runtime_error("osRank must be in (0, 1]");
+      }
+
+      // Threshold multiplier of every training cell count, solving
+      // Pfa = prod_{i<k} (n - i) / (n - i + alpha) by bisection
+      const double logPfa = std::log(static_cast<double>(cfg.pfa));
+      osAlpha(0) = 0;
+      for (index_t n = 1; n <= maxTrainingCells; n++) {
+        const int k = os_rank_of(cfg.os_rank, static_cast<int>(n));
+        auto logPfaOf = [&](double alpha) {
+          double sum = 0;
+          for (int i = 0; i < k; i++) { sum += std::log((n - i) / (n - i + alpha)); }
+          return sum;
+        };
+        double lo = 0, hi = 1;
+        while (logPfaOf(hi) > logPfa) { hi *= 2; }
+        for (int it = 0; it < 100; it++) {
+          const double mid = 0.5 * (lo + hi);
+          (logPfaOf(mid) > logPfa ? lo : hi) = mid;
+        }
+        osAlpha(n) = static_cast<ftype>(hi);
+      }
+    }
+
+    cudaMalloc(&detections, cfg.max_detections * sizeof(CFARDetection));
+    cudaMalloc(&count, sizeof(uint32_t));
+    cudaMemset(count, 0, sizeof(uint32_t));
 
     HOLOSCAN_LOG_INFO("CFAROp::initialize() done");
   }
 
+  void stop() override {
+    uint32_t found = 0;
+    cudaMemcpy(&found, count, sizeof(found), cudaMemcpyDeviceToHost);
+    HOLOSCAN_LOG_INFO("CFAR found {} detections in the last CPI{}", found,
+        found > cfg.max_detections ? ", the list was truncated" : "");
+  }
+
   /**
    * @brief Stage 4 - Constant False Alarm Rate (CFAR) Detector - averaging or median
    *
@@ -435,14 +681,13 @@ class CFAROp : public Operator {
    * guard cells form a hole within the training window, but CA-CFAR is
    * largely just an averaging filter otherwise with a threshold check
    * at each pixel after applying the filter.
-   * Currently, the window below is defined statically because it is then
-   * easy to visualize, but more typically the number of guard and
-   * reference cells would be given as input and the window would be
-   * constructed; we could update to such an approach, but I'm keeping
-   * it simple for now.
-
-   * We apply CFAR to the power of X; X is still complex until this point
-   * Xpow = abs(X).^2;
+
+   * The guard and training sizes are parameters. CA-CFAR sums the window
+   * from a summed-area table of Xpow = abs(X).^2, so its cost does not
+   * depend on the window size. OS-CFAR instead uses the osRank-th training
+   * cell in sorted order, which is robust to interfering targets in the
+   * training cells. Cells above the threshold are compacted into a list of
+   * CFARDetection rather than a dense mask.
    */
   void compute(InputContext& op_input, OutputContext&, ExecutionContext&) override {
     HOLOSCAN_LOG_DEBUG("CFAR compute() called");
@@ -454,41 +699,25 @@ class CFAROp : public Operator {
     }
 
     auto cfar_data_val = cfar_data.value();
-
-    (xPow = abs2(cfar_data_val.tpcView)).run(cfar_data_val.stream);
-
-    // Estimate the background average power in each cell
-    // background_averages = conv2(Xpow, mask, 'same') ./ norm;
-    (ba =
-      conv2d(xPow, cfarMaskView, matxConvCorrMode_t::MATX_C_MODE_FULL)).run(cfar_data_val.stream);
-
-    // Computing number of cells contributing to each cell.
-    // This can be done with a convolution of the cfarMask with
-    // ones.
-    // norm = conv2(ones(size(X)), mask, 'same');
-    auto normTrim = slice(normT, {0, cfarMaskY / 2, cfarMaskX / 2},
-                                 {numChannels.get(), numPulsesRnd + cfarMaskY / 2,
-                                  numCompressedSamples + cfarMaskX / 2});
-
-    auto baTrim = slice(ba, {0, cfarMaskY / 2, cfarMaskX / 2},
-                            {numChannels.get(), numPulsesRnd + cfarMaskY / 2,
-                             numCompressedSamples + cfarMaskX / 2});
-    (baTrim = baTrim / normTrim).run(cfar_data_val.stream);
-
-    // The scalar alpha is used as a multiplier on the background averages
-    // to achieve a constant false alarm rate (under certain assumptions);
-    // it is based upon the desired probability of false alarm (Pfa) and
-    // number of reference cells used to estimate the background for the
-    // CUT. For the purposes of computation, it can be assumed as a given
-    // constant, although it does vary at the edges due to the different
-    // training windows.
-    // Declare a detection if the power exceeds the background estimate
-    // times alpha for a particular cell.
-    // dets(find(Xpow > alpha.*background_averages)) = 1;
-
-    // These 2 branches are functionally equivalent.  A custom op is more
-    // efficient as it can avoid repeated loads.
-    calcDets(dets, xPow, baTrim, normTrim, pfa).run(cfar_data_val.stream);
+    auto x = cfar_data_val.tpcView;
+    cudaStream_t stream = cfar_data_val.stream;
+
+    const index_t rows = x.Size(1);
+    const index_t cols = x.Size(2);
+    const dim3 grid((cols + cfarThreads - 1) / cfarThreads, rows, numChannels.get());
+
+    cudaMemsetAsync(count, 0, sizeof(uint32_t), stream);
+    if (cfg.method == CFARMethod::CA) {
+      cfar_row_scan_kernel<<<dim3(rows, numChannels.get()), cfarThreads, 0, stream>>>(
+          x.Data(), sat.Data(), rows, cols);
+      cfar_col_scan_kernel<<<dim3(grid.x, numChannels.get()), cfarThreads, 0, stream>>>(
+          sat.Data(), rows, cols);
+      ca_cfar_kernel<<<grid, cfarThreads, 0, stream>>>(
+          x.Data(), sat.Data(), rows, cols, cfg, detections, count);
+    } else {
+      os_cfar_kernel<<<grid, cfarThreads, 0, stream>>>(
+          x.Data(), osAlpha.Data(), rows, cols, cfg, detections, count);
+    }
   };
 
  private:
@@ -496,17 +725,22 @@ class CFAROp : public Operator {
   Parameter<int64_t> numSamples;
   Parameter<int64_t> waveformLength;
   Parameter<int64_t> numChannels;
+  Parameter<std::string> cfarMethod;
+  Parameter<int64_t> guardDoppler;
+  Parameter<int64_t> guardRange;
+  Parameter<int64_t> trainDoppler;
+  Parameter<int64_t> trainRange;
+  Parameter<float> pfa;
+  Parameter<float> osRank;
+  Parameter<uint32_t> maxDetections;
   index_t numCompressedSamples;
   index_t numPulsesRnd;
-  const index_t cfarMaskX = 13;
-  const index_t cfarMaskY = 5;
-  static const constexpr float pfa = 1e-5f;
-
-  tensor_t<ftype, 3> normT;
-  tensor_t<ftype, 3> ba;
-  tensor_t<int, 3> dets;
-  tensor_t<ftype, 3> xPow;
-  tensor_t<ftype, 2> cfarMaskView;
+  CFARConfig cfg;
+
+  tensor_t<double, 3> sat;
+  tensor_t<ftype, 1> osAlpha;
+  CFARDetection* detections = nullptr;
+  uint32_t* count = nullptr;  // Detections found, may exceed maxDetections
 };
 
 
@@ -35,6 +35,8 @@ class CropOp : public Operator{
   Parameter<int> y_;
   Parameter<int> width_;
   Parameter<int> height_;
+  Parameter<std::shared_ptr<Allocator>> allocator_;
+  CudaStreamHandler cuda_stream_handler_;
 };
 
 }  // namespace holoscan::ops
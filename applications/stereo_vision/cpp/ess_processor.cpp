@@ -17,6 +17,7 @@
 
 #include "ess_processor.h"
 #include <npp.h>
+#include <algorithm>
 #include "stereo_depth_kernels.h"
 
 namespace holoscan::ops {
@@ -27,18 +28,22 @@ void ESSPreprocessorOp::setup(OperatorSpec& spec) {
   spec.output<holoscan::gxf::Entity>("output");
   spec.param(width_, "width", "width", "width", 0);
   spec.param(height_, "height", "height", "height", 0);
+  spec.param(allocator_, "allocator", "Allocator", "Allocator for the ESS input tensors");
+  cuda_stream_handler_.define_params(spec);
 }
 
 void ESSPreprocessorOp::compute(InputContext& op_input, OutputContext& op_output,
                                 ExecutionContext& context) {
-  auto maybe_tensormap1 = op_input.receive<holoscan::TensorMap>("input1");
-  const auto tensormap1 = maybe_tensormap1.value();
+  auto in_message1 = op_input.receive<holoscan::gxf::Entity>("input1").value();
+  auto in_message2 = op_input.receive<holoscan::gxf::Entity>("input2").value();
 
-  auto maybe_tensormap2 = op_input.receive<holoscan::TensorMap>("input2");
-  const auto tensormap2 = maybe_tensormap2.value();
+  if ((in_message1.findAll<nvidia::gxf::Tensor>()->size() != 1) ||
+      (in_message2.findAll<nvidia::gxf::Tensor>()->size() != 1)) {
+    throw std::runtime_error("Expecting single tensor input");
+  }
 
-  auto tensor1 = tensormap1.begin()->second;
-  auto tensor2 = tensormap2.begin()->second;
+  auto tensor1 = in_message1.get<Tensor>();
+  auto tensor2 = in_message2.get<Tensor>();
 
   int orig_height = tensor1->shape()[0];
   int orig_width = tensor1->shape()[1];
@@ -49,76 +54,49 @@ void ESSPreprocessorOp::compute(InputContext& op_input, OutputContext& op_output
     throw std::runtime_error("IMAGE SIZES DO NOT MATCH");
   }
 
-  if ((tensormap1.size() != 1) || (tensormap2.size() != 1)) {
-    throw std::runtime_error("Expecting single tensor input");
-  }
-
   if (!(nChannels == 3 || nChannels == 4)) {
     throw std::runtime_error("Input tensor must have 3 or 4 channels");
   }
 
-  auto pointerLeft = std::shared_ptr<void*>(new void*, [](void** pointerLeft) {
-    if (pointerLeft != nullptr) {
-      if (*pointerLeft != nullptr) { cudaFree(*pointerLeft); }
-      delete pointerLeft;
-    }
-  });
+  if (cuda_stream_handler_.from_messages(context.context(), {in_message1, in_message2}) !=
+      GXF_SUCCESS) {
+    throw std::runtime_error("Failed to get the CUDA stream from incoming messages");
+  }
+  const cudaStream_t cuda_stream = cuda_stream_handler_.get_cuda_stream(context.context());
 
-  auto pointerRight = std::shared_ptr<void*>(new void*, [](void** pointerRight) {
-    if (pointerRight != nullptr) {
-      if (*pointerRight != nullptr) { cudaFree(*pointerRight); }
-      delete pointerRight;
+  auto allocator = nvidia::gxf::Handle<nvidia::gxf::Allocator>::Create(context.context(),
+                                                                         allocator_->gxf_cid());
+  auto out_message = nvidia::gxf::Entity::New(context.context());
+  auto gxf_tensor_left = out_message.value().add<nvidia::gxf::Tensor>("input_left");
+  auto gxf_tensor_right = out_message.value().add<nvidia::gxf::Tensor>("input_right");
+  nvidia::gxf::Shape shape = nvidia::gxf::Shape{1, 3, height_, width_};
+  for (const auto& gxf_tensor : {gxf_tensor_left.value(), gxf_tensor_right.value()}) {
+    if (!gxf_tensor->reshape<float>(
+            shape, nvidia::gxf::MemoryStorageType::kDevice, allocator.value())) {
+      throw std::runtime_error("Failed to allocate output tensor");
     }
-  });
-
-  cudaMalloc(pointerLeft.get(), width_ * height_ * sizeof(float) * 3);
-  cudaMalloc(pointerRight.get(), width_ * height_ * sizeof(float) * 3);
+  }
 
-  nvidia::gxf::Shape shape = nvidia::gxf::Shape{1, 3, height_, width_};
   preprocessESS(static_cast<uint8_t*>(tensor1->data()),
-                static_cast<float*>(*pointerLeft.get()),
+                gxf_tensor_left.value()->data<float>().value(),
                 orig_width,
                 orig_height,
                 nChannels,
                 width_,
                 height_,
-                0);
+                cuda_stream);
   preprocessESS(static_cast<uint8_t*>(tensor2->data()),
-                static_cast<float*>(*pointerRight.get()),
+                gxf_tensor_right.value()->data<float>().value(),
                 orig_width,
                 orig_height,
                 nChannels,
                 width_,
                 height_,
-                0);
-
-  auto out_message = nvidia::gxf::Entity::New(context.context());
-  auto gxf_tensor_left = out_message.value().add<nvidia::gxf::Tensor>("input_left");
-
-  gxf_tensor_left.value()->wrapMemory(shape,
-                                      nvidia::gxf::PrimitiveType::kFloat32,
-                                      sizeof(float),
-                                      nvidia::gxf::ComputeTrivialStrides(shape, sizeof(float)),
-                                      nvidia::gxf::MemoryStorageType::kDevice,
-                                      *pointerLeft,
-                                      [orig_pointer = pointerLeft](void*) mutable {
-                                        orig_pointer.reset();  // decrement ref count
-                                        return nvidia::gxf::Success;
-                                      });
-
-  auto gxf_tensor_right = out_message.value().add<nvidia::gxf::Tensor>("input_right");
-
-  gxf_tensor_right.value()->wrapMemory(shape,
-                                       nvidia::gxf::PrimitiveType::kFloat32,
-                                       sizeof(float),
-                                       nvidia::gxf::ComputeTrivialStrides(shape, sizeof(float)),
-                                       nvidia::gxf::MemoryStorageType::kDevice,
-                                       *pointerRight,
-                                       [orig_pointer = pointerRight](void*) mutable {
-                                         orig_pointer.reset();  // decrement ref count
-                                         return nvidia::gxf::Success;
-                                       });
+                cuda_stream);
 
+  if (cuda_stream_handler_.to_message(out_message) != GXF_SUCCESS) {
+    throw std::runtime_error("Failed to add the CUDA stream to the outgoing messages");
+  }
   op_output.emit(out_message.value(), "output");
 }
 
@@ -127,63 +105,121 @@ void ESSPostprocessorOp::setup(OperatorSpec& spec) {
   spec.output<holoscan::gxf::Entity>("output");
   spec.param(width_, "width", "width", "width", 0);
   spec.param(height_, "height", "height", "height", 0);
+  spec.param(allocator_, "allocator", "Allocator", "Allocator for the output disparity map");
+  cuda_stream_handler_.define_params(spec);
+}
+
+void ESSPostprocessorOp::start() {
+  if (nppGetStreamContext(&npp_stream_ctx_) != NPP_SUCCESS) {
+    throw std::runtime_error("Failed to get NPP CUDA stream context");
+  }
 }
 
 void ESSPostprocessorOp::compute(InputContext& op_input, OutputContext& op_output,
                                  ExecutionContext& context) {
-  auto maybe_tensormap = op_input.receive<holoscan::TensorMap>("input");
-  const auto tensormap = maybe_tensormap.value();
+  auto in_message = op_input.receive<holoscan::gxf::Entity>("input").value();
 
-  auto tensor_disp = tensormap.at("output_left");
-  auto tensor_conf = tensormap.at("output_conf");
+  auto tensor_disp = in_message.get<Tensor>("output_left");
+  auto tensor_conf = in_message.get<Tensor>("output_conf");
+  if (!tensor_disp || !tensor_conf) {
+    throw std::runtime_error("Expecting output_left and output_conf tensors");
+  }
 
   int orig_height = tensor_disp->shape()[1];
   int orig_width = tensor_disp->shape()[2];
 
-  auto pointer = std::shared_ptr<void*>(new void*, [](void** pointer) {
-    if (pointer != nullptr) {
-      if (*pointer != nullptr) { cudaFree(*pointer); }
-      delete pointer;
-    }
-  });
-
-  cudaMalloc(pointer.get(), width_ * height_ * sizeof(float));
-
-  confidenceMask(
-      (float*)tensor_disp->data(), (float*)tensor_conf->data(), 0.05, orig_width, orig_height, 0);
+  if (cuda_stream_handler_.from_message(context.context(), in_message) != GXF_SUCCESS) {
+    throw std::runtime_error("Failed to get the CUDA stream from incoming messages");
+  }
+  const cudaStream_t cuda_stream = cuda_stream_handler_.get_cuda_stream(context.context());
+  npp_stream_ctx_.hStream = cuda_stream;
 
-  NppStatus status = nppiResize_32f_C1R(static_cast<Npp32f*>(tensor_disp->data()),
-                                        orig_width * sizeof(Npp32f),
-                                        {orig_width, orig_height},
-                                        {0, 0, orig_width, orig_height},
-                                        (Npp32f*)*pointer,
-                                        width_ * sizeof(Npp32f),
-                                        {width_, height_},
-                                        {0, 0, width_, height_},
-                                        NPPI_INTER_NN);
+  auto allocator = nvidia::gxf::Handle<nvidia::gxf::Allocator>::Create(context.context(),
+                                                                         allocator_->gxf_cid());
+  auto out_message = nvidia::gxf::Entity::New(context.context());
+  auto gxf_tensor = out_message.value().add<nvidia::gxf::Tensor>("");
+  nvidia::gxf::Shape shape = nvidia::gxf::Shape{height_, width_, 1};
+  if (!gxf_tensor.value()->reshape<float>(
+          shape, nvidia::gxf::MemoryStorageType::kDevice, allocator.value())) {
+    throw std::runtime_error("Failed to allocate output tensor");
+  }
+  Npp32f* disparity = gxf_tensor.value()->data<Npp32f>().value();
+
+  confidenceMask((float*)tensor_disp->data(),
+                 (float*)tensor_conf->data(),
+                 0.05,
+                 orig_width,
+                 orig_height,
+                 cuda_stream);
+
+  NppStatus status = nppiResize_32f_C1R_Ctx(static_cast<Npp32f*>(tensor_disp->data()),
+                                            orig_width * sizeof(Npp32f),
+                                            {orig_width, orig_height},
+                                            {0, 0, orig_width, orig_height},
+                                            disparity,
+                                            width_ * sizeof(Npp32f),
+                                            {width_, height_},
+                                            {0, 0, width_, height_},
+                                            NPPI_INTER_NN,
+                                            npp_stream_ctx_);
+  if (status != NPP_SUCCESS) { throw std::runtime_error("Failed to resize disparity map"); }
+
+  status = nppiMulC_32f_C1IR_Ctx(static_cast<Npp32f>(width_) / static_cast<Npp32f>(orig_width),
+                                 disparity,
+                                 width_ * sizeof(Npp32f),
+                                 {width_, height_},
+                                 npp_stream_ctx_);
+  if (status != NPP_SUCCESS) { throw std::runtime_error("Failed to rescale disparity map"); }
+
+  if (cuda_stream_handler_.to_message(out_message) != GXF_SUCCESS) {
+    throw std::runtime_error("Failed to add the CUDA stream to the outgoing messages");
+  }
+  op_output.emit(out_message.value(), "output");
+}
 
-  status = nppiMulC_32f_C1IR(static_cast<Npp32f>(width_) / static_cast<Npp32f>(orig_width),
-                             (Npp32f*)*pointer,
-                             width_ * sizeof(Npp32f),
-                             {width_, height_});
+void TimedInferenceOp::setup(OperatorSpec& spec) {
+  InferenceOp::setup(spec);
+  spec.param(report_interval_,
+             "report_interval",
+             "Report interval",
+             "Frames between latency reports, 0 to only report when stopped",
+             300);
+}
 
-  nvidia::gxf::Shape shape = nvidia::gxf::Shape{height_, width_, 1};
+void TimedInferenceOp::add(Stats& stats, double ms) {
+  stats.frames++;
+  stats.total_ms += ms;
+  stats.max_ms = std::max(stats.max_ms, ms);
+}
 
-  auto out_message = nvidia::gxf::Entity::New(context.context());
-  auto gxf_tensor = out_message.value().add<nvidia::gxf::Tensor>("");
+void TimedInferenceOp::log(const char* what, const Stats& stats) {
+  if (stats.frames == 0) { return; }
+  HOLOSCAN_LOG_INFO("{}: {} {:.2f} ms mean, {:.2f} ms max over {} frames",
+                    name(),
+                    what,
+                    stats.total_ms / stats.frames,
+                    stats.max_ms,
+                    stats.frames);
+}
 
-  gxf_tensor.value()->wrapMemory(shape,
-                                 nvidia::gxf::PrimitiveType::kFloat32,
-                                 sizeof(float),
-                                 nvidia::gxf::ComputeTrivialStrides(shape, sizeof(float)),
-                                 nvidia::gxf::MemoryStorageType::kDevice,
-                                 *pointer,
-                                 [orig_pointer = pointer](void*) mutable {
-                                   orig_pointer.reset();  // decrement ref count
-                                   return nvidia::gxf::Success;
-                                 });
+void TimedInferenceOp::compute(InputContext& op_input, OutputContext& op_output,
+                               ExecutionContext& context) {
+  const auto begin = std::chrono::steady_clock::now();
+  InferenceOp::compute(op_input, op_output, context);
+  const double ms =
+      std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - begin).count();
+
+  add(interval_, ms);
+  add(total_, ms);
+  if (report_interval_ > 0 && interval_.frames >= static_cast<uint64_t>(report_interval_.get())) {
+    log("inference", interval_);
+    interval_ = Stats{};
+  }
+}
 
-  op_output.emit(out_message.value(), "output");
+void TimedInferenceOp::stop() {
+  log("inference over the run", total_);
+  InferenceOp::stop();
 }
 
 }  // namespace holoscan::ops
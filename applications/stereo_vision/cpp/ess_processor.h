@@ -18,8 +18,11 @@
 #ifndef ESS_PROCESSOR_OP
 #define ESS_PROCESSOR_OP
 
+#include <npp.h>
+#include <chrono>
 #include <holoscan/holoscan.hpp>
 #include <holoscan/operators/holoviz/holoviz.hpp>
+#include <holoscan/operators/inference/inference.hpp>
 #include <holoscan/operators/video_stream_replayer/video_stream_replayer.hpp>
 #include <holoscan/utils/cuda_stream_handler.hpp>
 
@@ -37,6 +40,8 @@ class ESSPreprocessorOp : public Operator {
  private:
   Parameter<int> width_;
   Parameter<int> height_;
+  Parameter<std::shared_ptr<Allocator>> allocator_;
+  CudaStreamHandler cuda_stream_handler_;
 };
 
 // Masks low confidence pixels and resizes and rescales the disparity map to the desired resolution.
@@ -45,11 +50,41 @@ class ESSPostprocessorOp : public Operator {
   HOLOSCAN_OPERATOR_FORWARD_ARGS(ESSPostprocessorOp);
   ESSPostprocessorOp() = default;
   void setup(OperatorSpec& spec) override;
+  void start() override;
   void compute(InputContext&, OutputContext& op_output, ExecutionContext&) override;
 
  private:
   Parameter<int> width_;
   Parameter<int> height_;
+  Parameter<std::shared_ptr<Allocator>> allocator_;
+  CudaStreamHandler cuda_stream_handler_;
+  NppStreamContext npp_stream_ctx_{};
+};
+
+// InferenceOp that logs the mean and maximum latency of its engine every `report_interval`
+// frames, and over the whole run when stopped. InferenceOp waits for the engine to finish, so
+// this is the time spent in TensorRT on the GPU or DLA, including any input reformatting.
+class TimedInferenceOp : public InferenceOp {
+ public:
+  HOLOSCAN_OPERATOR_FORWARD_ARGS_SUPER(TimedInferenceOp, InferenceOp);
+  TimedInferenceOp() = default;
+  void setup(OperatorSpec& spec) override;
+  void stop() override;
+  void compute(InputContext& op_input, OutputContext& op_output,
+               ExecutionContext& context) override;
+
+ private:
+  Parameter<int> report_interval_;
+
+  struct Stats {
+    uint64_t frames = 0;
+    double total_ms = 0.0;
+    double max_ms = 0.0;
+  };
+  void add(Stats& stats, double ms);
+  void log(const char* what, const Stats& stats);
+  Stats interval_;
+  Stats total_;
 };
 
 }  // namespace holoscan::ops
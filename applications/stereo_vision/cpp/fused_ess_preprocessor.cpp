@@ -0,0 +1,194 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "fused_ess_preprocessor.h"
+#include "split_video.h"
+#include "stereo_depth_kernels.h"
+
+namespace holoscan::ops {
+
+void FusedESSPreprocessorOp::setup(OperatorSpec& spec) {
+  spec.input<holoscan::gxf::Entity>("input");
+  spec.output<holoscan::gxf::Entity>("output");
+  spec.param(width_, "width", "width", "ESS input width", 0);
+  spec.param(height_, "height", "height", "ESS input height", 0);
+  spec.param(crop_x_, "crop_x", "crop x", "top left x of the crop in rectified coordinates", 0);
+  spec.param(crop_y_, "crop_y", "crop y", "top left y of the crop in rectified coordinates", 0);
+  spec.param(crop_width_, "crop_width", "crop width", "crop width, 0 for the full eye", 0);
+  spec.param(crop_height_, "crop_height", "crop height", "crop height, 0 for the full eye", 0);
+  spec.param(stereo_video_layout_,
+             "stereo_video_layout",
+             "Stereo Video Layout",
+             "Horizontal or Vertical Concatenation of Stereo Video Frames",
+             STEREO_VIDEO_HORIZONTAL);
+  spec.param(output_fp16_,
+             "output_fp16",
+             "Output FP16",
+             "Emit the ESS inputs as fp16 instead of fp32, for engines with fp16 input bindings",
+             false);
+  spec.param(allocator_, "allocator", "Allocator", "Allocator for the ESS input tensors");
+  cuda_stream_handler_.define_params(spec);
+}
+
+void FusedESSPreprocessorOp::start() {
+  if (!rectification_map_left_ || !rectification_map_right_) {
+    throw std::runtime_error("Rectification maps must be set before starting");
+  }
+  if (rectification_map_left_->width_ != rectification_map_right_->width_ ||
+      rectification_map_left_->height_ != rectification_map_right_->height_) {
+    throw std::runtime_error("Rectification maps must have the same dimensions");
+  }
+
+  const int map_width = rectification_map_left_->width_;
+  const int map_height = rectification_map_left_->height_;
+  cudaMalloc((void**)&map_left_, map_width * map_height * sizeof(__half2));
+  cudaMalloc((void**)&map_right_, map_width * map_height * sizeof(__half2));
+  packRectificationMap(rectification_map_left_->mapx_,
+                       rectification_map_left_->mapy_,
+                       map_left_,
+                       map_width,
+                       map_height,
+                       0);
+  packRectificationMap(rectification_map_right_->mapx_,
+                       rectification_map_right_->mapy_,
+                       map_right_,
+                       map_width,
+                       map_height,
+                       0);
+  cudaStreamSynchronize(0);
+}
+
+void FusedESSPreprocessorOp::stop() {
+  cudaFree(map_left_);
+  cudaFree(map_right_);
+  map_left_ = nullptr;
+  map_right_ = nullptr;
+}
+
+void FusedESSPreprocessorOp::compute(InputContext& op_input, OutputContext& op_output,
+                                     ExecutionContext& context) {
+  auto in_message = op_input.receive<holoscan::gxf::Entity>("input").value();
+
+  if (in_message.findAll<nvidia::gxf::Tensor>()->size() != 1) {
+    throw std::runtime_error("Expecting single tensor input");
+  }
+
+  auto tensor = in_message.get<Tensor>();
+  int height = tensor->shape()[0];
+  int width = tensor->shape()[1];
+  int nChannels = tensor->shape()[2];
+
+  if (!(nChannels == 3 || nChannels == 4)) {
+    throw std::runtime_error("Input tensor must have 3 or 4 channels");
+  }
+
+  const size_t pitch = width * nChannels;
+  int eye_width, eye_height;
+  size_t eye_offset;
+  if (stereo_video_layout_.get() == STEREO_VIDEO_VERTICAL) {
+    eye_width = width;
+    eye_height = height / 2;
+    eye_offset = eye_height * pitch;
+  } else if (stereo_video_layout_.get() == STEREO_VIDEO_HORIZONTAL) {
+    eye_width = width / 2;
+    eye_height = height;
+    eye_offset = eye_width * nChannels;
+  } else {
+    throw std::runtime_error("UNKNOWN INPUT FORMAT");
+  }
+
+  if (eye_width != rectification_map_left_->width_ ||
+      eye_height != rectification_map_left_->height_) {
+    throw std::runtime_error("Dimensions do not match rectification map");
+  }
+
+  const int crop_width = crop_width_ > 0 ? crop_width_.get() : eye_width;
+  const int crop_height = crop_height_ > 0 ? crop_height_.get() : eye_height;
+  if (crop_x_ < 0 || crop_y_ < 0 || (crop_x_ + crop_width) > eye_width ||
+      (crop_y_ + crop_height) > eye_height) {
+    throw std::runtime_error("Crop exceeds image boundaries");
+  }
+
+  if (cuda_stream_handler_.from_message(context.context(), in_message) != GXF_SUCCESS) {
+    throw std::runtime_error("Failed to get the CUDA stream from incoming messages");
+  }
+  const cudaStream_t cuda_stream = cuda_stream_handler_.get_cuda_stream(context.context());
+
+  auto allocator = nvidia::gxf::Handle<nvidia::gxf::Allocator>::Create(context.context(),
+                                                                         allocator_->gxf_cid());
+  auto out_message = nvidia::gxf::Entity::New(context.context());
+  auto gxf_tensor_left = out_message.value().add<nvidia::gxf::Tensor>("input_left");
+  auto gxf_tensor_right = out_message.value().add<nvidia::gxf::Tensor>("input_right");
+  nvidia::gxf::Shape shape = nvidia::gxf::Shape{1, 3, height_, width_};
+  const auto element_type =
+      output_fp16_ ? nvidia::gxf::PrimitiveType::kFloat16 : nvidia::gxf::PrimitiveType::kFloat32;
+  for (const auto& gxf_tensor : {gxf_tensor_left.value(), gxf_tensor_right.value()}) {
+    if (!gxf_tensor->reshapeCustom(shape,
+                                   element_type,
+                                   nvidia::gxf::PrimitiveTypeSize(element_type),
+                                   nvidia::gxf::Unexpected{GXF_UNINITIALIZED_VALUE},
+                                   nvidia::gxf::MemoryStorageType::kDevice,
+                                   allocator.value())) {
+      throw std::runtime_error("Failed to allocate output tensor");
+    }
+  }
+
+  if (output_fp16_) {
+    rectifyPreprocessESS(static_cast<const uint8_t*>(tensor->data()),
+                         pitch,
+                         nChannels,
+                         eye_offset,
+                         map_left_,
+                         map_right_,
+                         eye_width,
+                         eye_height,
+                         crop_x_,
+                         crop_y_,
+                         crop_width,
+                         crop_height,
+                         reinterpret_cast<__half*>(gxf_tensor_left.value()->pointer()),
+                         reinterpret_cast<__half*>(gxf_tensor_right.value()->pointer()),
+                         width_,
+                         height_,
+                         cuda_stream);
+  } else {
+    rectifyPreprocessESS(static_cast<const uint8_t*>(tensor->data()),
+                         pitch,
+                         nChannels,
+                         eye_offset,
+                         map_left_,
+                         map_right_,
+                         eye_width,
+                         eye_height,
+                         crop_x_,
+                         crop_y_,
+                         crop_width,
+                         crop_height,
+                         gxf_tensor_left.value()->data<float>().value(),
+                         gxf_tensor_right.value()->data<float>().value(),
+                         width_,
+                         height_,
+                         cuda_stream);
+  }
+
+  if (cuda_stream_handler_.to_message(out_message) != GXF_SUCCESS) {
+    throw std::runtime_error("Failed to add the CUDA stream to the outgoing messages");
+  }
+  op_output.emit(out_message.value(), "output");
+}
+
+}  // namespace holoscan::ops
@@ -0,0 +1,70 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef FUSED_ESS_PREPROCESSOR_OP
+#define FUSED_ESS_PREPROCESSOR_OP
+
+#include <cuda_fp16.h>
+#include <memory>
+
+#include <holoscan/holoscan.hpp>
+#include <holoscan/utils/cuda_stream_handler.hpp>
+
+#include "undistort_rectify.h"
+
+namespace holoscan::ops {
+
+// Takes a stacked RGB or RGBA U8 stereo frame and produces the ESS inference inputs in a single
+// pass. For every output pixel of each eye the rectification map, the crop window and the
+// bilinear resize are applied together, replacing SplitVideoOp, UndistortRectifyOp, CropOp and
+// ESSPreprocessorOp. With `output_fp16` the inputs are written as half precision, the format of
+// ESS engines built with fp16 input bindings for DLA, so that TensorRT does not reformat them.
+class FusedESSPreprocessorOp : public Operator {
+ public:
+  HOLOSCAN_OPERATOR_FORWARD_ARGS(FusedESSPreprocessorOp);
+  FusedESSPreprocessorOp() = default;
+  void setup(OperatorSpec& spec) override;
+  void start() override;
+  void stop() override;
+  void compute(InputContext&, OutputContext& op_output, ExecutionContext&) override;
+  void setRectificationMaps(std::shared_ptr<UndistortRectifyOp::RectificationMap> left,
+                            std::shared_ptr<UndistortRectifyOp::RectificationMap> right) {
+    rectification_map_left_ = left;
+    rectification_map_right_ = right;
+  }
+
+ private:
+  Parameter<int> width_;
+  Parameter<int> height_;
+  Parameter<int> crop_x_;
+  Parameter<int> crop_y_;
+  Parameter<int> crop_width_;
+  Parameter<int> crop_height_;
+  Parameter<int> stereo_video_layout_;
+  Parameter<bool> output_fp16_;
+  Parameter<std::shared_ptr<Allocator>> allocator_;
+  CudaStreamHandler cuda_stream_handler_;
+
+  std::shared_ptr<UndistortRectifyOp::RectificationMap> rectification_map_left_;
+  std::shared_ptr<UndistortRectifyOp::RectificationMap> rectification_map_right_;
+  // packed fp16 displacement tables built from the rectification maps in start()
+  __half2* map_left_ = nullptr;
+  __half2* map_right_ = nullptr;
+};
+
+}  // namespace holoscan::ops
+#endif
@@ -35,6 +35,8 @@ class HeatmapOp : public Operator {
  private:
   Parameter<float> max_disp_;
   Parameter<float> min_disp_;
+  Parameter<std::shared_ptr<Allocator>> allocator_;
+  CudaStreamHandler cuda_stream_handler_;
 };
 
 }  // namespace holoscan::ops
@@ -31,6 +31,7 @@
 #include <holoscan/operators/format_converter/format_converter.hpp>
 #include "crop.h"
 #include "ess_processor.h"
+#include "fused_ess_preprocessor.h"
 #include "heat_map.h"
 #include "split_video.h"
 #include "stereo_depth_kernels.h"
@@ -92,8 +93,11 @@ class StereoDepthApp : public holoscan::Application {
     auto v4l2_converter = make_operator<ops::FormatConverterOp>(
         "converter", in_dtype, out_dtype, v4l2_converter_pool);
 
-    auto splitter = make_operator<ops::SplitVideoOp>(
-        "splitter", Arg("stereo_video_layout", STEREO_VIDEO_HORIZONTAL));
+    // The stereo operators allocate their per-frame outputs from device block pools and run
+    // asynchronously on their own CUDA streams. Each pool holds enough blocks to cover the frames
+    // in flight between an operator and the sink.
+    const uint64_t num_blocks = 4;
+    auto cuda_stream_pool = make_resource<CudaStreamPool>("cuda_stream", 0, 0, 0, 1, 8);
 
     float R1_float[9];
     float R2_float[9];
@@ -122,33 +126,57 @@ class StereoDepthApp : public holoscan::Application {
     auto rectification_map2 = std::make_shared<ops::UndistortRectifyOp::RectificationMap>(
         &M2[0], &d2[0], R2_float, P2_float, width, height);
 
-    auto rectifier1 = make_operator<ops::UndistortRectifyOp>("rectifier1");
-    rectifier1->setRectificationMap(rectification_map1);
-    auto rectifier2 = make_operator<ops::UndistortRectifyOp>("rectifier2");
-    rectifier2->setRectificationMap(rectification_map2);
-
     auto holoviz = make_operator<ops::HolovizOp>("holoviz", from_config("holoviz"));
 
-    auto ess_preprocessor =
-        make_operator<ops::ESSPreprocessorOp>("ess_preprocessor", from_config("ess_preprocessor"));
+    // the ESS input holds a left and a right CHW image per frame, fp16 for engines with fp16
+    // input bindings and float otherwise
+    const uint64_t ess_input_size =
+        from_config("ess_preprocessor.width").as<int>() *
+        from_config("ess_preprocessor.height").as<int>() * 3 *
+        (from_config("ess_preprocessor.output_fp16").as<bool>() ? sizeof(__half) : sizeof(float));
+    const uint64_t roi_size = roi[2] * roi[3];
+
+    // split, rectify, crop to the valid region and resample to the ESS input in a single pass
+    auto ess_preprocessor = make_operator<ops::FusedESSPreprocessorOp>(
+        "ess_preprocessor",
+        from_config("ess_preprocessor"),
+        Arg("crop_x", roi[0]),
+        Arg("crop_y", roi[1]),
+        Arg("crop_width", roi[2]),
+        Arg("crop_height", roi[3]),
+        Arg("stereo_video_layout", STEREO_VIDEO_HORIZONTAL),
+        Arg("allocator") = make_resource<BlockMemoryPool>(
+            "pool_ess_preprocessor", 1, ess_input_size, 2 * num_blocks),
+        Arg("cuda_stream_pool") = cuda_stream_pool);
+    ess_preprocessor->setRectificationMaps(rectification_map1, rectification_map2);
+
+    // the disparity is already cropped, so only resize it back to the crop resolution
     auto ess_postprocessor = make_operator<ops::ESSPostprocessorOp>(
-        "ess_postprocessor", Arg("width", width), Arg("height", height));
-
-    auto crop_color = make_operator<ops::CropOp>("crop_color",
-                                                 Arg("x", roi[0]),
-                                                 Arg("y", roi[1]),
-                                                 Arg("width", roi[2]),
-                                                 Arg("height", roi[3]));
-
-    auto crop_disparity_ess = make_operator<ops::CropOp>("crop_disparity_ess",
-                                                         Arg("x", roi[0]),
-                                                         Arg("y", roi[1]),
-                                                         Arg("width", roi[2]),
-                                                         Arg("height", roi[3]));
-
-    auto heatmap_ess = make_operator<ops::HeatmapOp>("heatmap_ess", from_config("heatmap_ess"));
-
-    auto ess_inference = make_operator<ops::InferenceOp>(
+        "ess_postprocessor",
+        Arg("width", roi[2]),
+        Arg("height", roi[3]),
+        Arg("allocator") = make_resource<BlockMemoryPool>(
+            "pool_ess_postprocessor", 1, roi_size * sizeof(float), num_blocks),
+        Arg("cuda_stream_pool") = cuda_stream_pool);
+
+    auto crop_color = make_operator<ops::CropOp>(
+        "crop_color",
+        Arg("x", roi[0]),
+        Arg("y", roi[1]),
+        Arg("width", roi[2]),
+        Arg("height", roi[3]),
+        Arg("allocator") =
+            make_resource<BlockMemoryPool>("pool_crop_color", 1, roi_size * 3, num_blocks),
+        Arg("cuda_stream_pool") = cuda_stream_pool);
+
+    auto heatmap_ess = make_operator<ops::HeatmapOp>(
+        "heatmap_ess",
+        from_config("heatmap_ess"),
+        Arg("allocator") =
+            make_resource<BlockMemoryPool>("pool_heatmap_ess", 1, roi_size * 3, num_blocks),
+        Arg("cuda_stream_pool") = cuda_stream_pool);
+
+    auto ess_inference = make_operator<ops::TimedInferenceOp>(
         "inference",
         from_config("ess_inference"),
         Arg("allocator") = make_resource<UnboundedAllocator>("pool_ess"));
@@ -159,17 +187,12 @@ class StereoDepthApp : public holoscan::Application {
 
     // Rectification
     add_flow(source, v4l2_converter, {{source_output, "source_video"}});
-    add_flow(v4l2_converter, splitter, {{"tensor", "input"}});
-    add_flow(splitter, rectifier1, {{"output1", "input"}});
-    add_flow(splitter, rectifier2, {{"output2", "input"}});
+    add_flow(v4l2_converter, ess_preprocessor, {{"tensor", "input"}});
 
     // // Stereo Disparity Estimation
-    add_flow(rectifier1, ess_preprocessor, {{"output", "input1"}});
-    add_flow(rectifier2, ess_preprocessor, {{"output", "input2"}});
     add_flow(ess_preprocessor, ess_inference, {{"output", "receivers"}});
     add_flow(ess_inference, ess_postprocessor, {{"transmitter", "input"}});
-    add_flow(ess_postprocessor, crop_disparity_ess, {{"output", "input"}});
-    add_flow(crop_disparity_ess, heatmap_ess, {{"output", "input"}});
+    add_flow(ess_postprocessor, heatmap_ess, {{"output", "input"}});
     add_flow(heatmap_ess, holoviz, {{"output", "receivers"}});
   }
 };
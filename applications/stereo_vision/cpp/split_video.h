@@ -35,6 +35,8 @@ class SplitVideoOp : public Operator {
 
  private:
   Parameter<int> stereo_video_layout_;
+  Parameter<std::shared_ptr<Allocator>> allocator_;
+  CudaStreamHandler cuda_stream_handler_;
 };
 
 // combines two videos into a single horizontally or vertically stacked video
@@ -47,6 +49,8 @@ class MergeVideoOp : public Operator {
 
  private:
   Parameter<int> stereo_video_layout_;
+  Parameter<std::shared_ptr<Allocator>> allocator_;
+  CudaStreamHandler cuda_stream_handler_;
 };
 }  // namespace holoscan::ops
 #endif
@@ -162,3 +162,157 @@ void preprocessESS(uint8_t* input, float* output, uint32_t input_width, uint32_t
   preprocessESSKernel<<<launch_grid, block_dim, 0, stream>>>(
       input, output, input_width, input_height, input_channels, output_width, output_height);
 }
+
+__global__ void packRectificationMapKernel(const float* mapx, const float* mapy, __half2* map,
+                                           uint32_t width, uint32_t height) {
+  uint32_t nx = blockIdx.x * blockDim.x + threadIdx.x;
+  uint32_t ny = blockIdx.y * blockDim.y + threadIdx.y;
+  if (nx < width & ny < height) {
+    size_t tid = (nx + ny * width);
+    map[tid] = __floats2half2_rn(mapx[tid] - static_cast<float>(nx),
+                                 mapy[tid] - static_cast<float>(ny));
+  }
+}
+
+void packRectificationMap(const float* mapx, const float* mapy, __half2* map, uint32_t width,
+                          uint32_t height, cudaStream_t stream) {
+  const dim3 block_dim(32, 32);
+  const dim3 launch_grid((width + (block_dim.x - 1)) / block_dim.x,
+                         (height + (block_dim.y - 1)) / block_dim.y);
+  packRectificationMapKernel<<<launch_grid, block_dim, 0, stream>>>(
+      mapx, mapy, map, width, height);
+}
+
+// bilinear sample of the packed displacement map at a fractional rectified pixel, returning the
+// source coordinate in the raw camera image
+__device__ float2 sampleRectificationMap(const __half2* map, float u, float v, uint32_t width,
+                                         uint32_t height) {
+  float fu = fminf(fmaxf(u, 0.0f), static_cast<float>(width - 1));
+  float fv = fminf(fmaxf(v, 0.0f), static_cast<float>(height - 1));
+  uint32_t x0 = static_cast<uint32_t>(fu);
+  uint32_t y0 = static_cast<uint32_t>(fv);
+  uint32_t x1 = min(x0 + 1, width - 1);
+  uint32_t y1 = min(y0 + 1, height - 1);
+  float a = fu - static_cast<float>(x0);
+  float b = fv - static_cast<float>(y0);
+  float2 d00 = __half22float2(map[x0 + y0 * width]);
+  float2 d10 = __half22float2(map[x1 + y0 * width]);
+  float2 d01 = __half22float2(map[x0 + y1 * width]);
+  float2 d11 = __half22float2(map[x1 + y1 * width]);
+  float dx = (1 - a) * (1 - b) * d00.x + a * (1 - b) * d10.x + (1 - a) * b * d01.x + a * b * d11.x;
+  float dy = (1 - a) * (1 - b) * d00.y + a * (1 - b) * d10.y + (1 - a) * b * d01.y + a * b * d11.y;
+  return make_float2(u + dx, v + dy);
+}
+
+__device__ inline void storeESSInput(float* output, float value) {
+  *output = value;
+}
+
+__device__ inline void storeESSInput(__half* output, float value) {
+  *output = __float2half(value);
+}
+
+template <typename T>
+__global__ void rectifyPreprocessESSKernel(const uint8_t* input, uint32_t input_pitch,
+                                           uint32_t input_channels, size_t eye_offset,
+                                           const __half2* map_left, const __half2* map_right,
+                                           uint32_t eye_width, uint32_t eye_height,
+                                           uint32_t crop_x, uint32_t crop_y, uint32_t crop_width,
+                                           uint32_t crop_height, T* output_left,
+                                           T* output_right, uint32_t output_width,
+                                           uint32_t output_height) {
+  // one thread per output pixel, blockIdx.z selects the eye
+  uint32_t out_nx = blockIdx.x * blockDim.x + threadIdx.x;
+  uint32_t out_ny = blockIdx.y * blockDim.y + threadIdx.y;
+  if (out_nx < output_width & out_ny < output_height) {
+    const bool right = blockIdx.z == 1;
+    const uint8_t* image = right ? input + eye_offset : input;
+    T* output = right ? output_right : output_left;
+
+    // same output -> input mapping as preprocessESS, applied to the cropped rectified image
+    float u = crop_x + (float)out_nx * (float)crop_width / (float)output_width;
+    float v = crop_y + (float)out_ny * (float)crop_height / (float)output_height;
+    float2 src = sampleRectificationMap(right ? map_right : map_left, u, v, eye_width, eye_height);
+
+    size_t plane = output_width * output_height;
+    size_t out_ind = out_nx + out_ny * output_width;
+    // rectified pixels that map outside of the camera image are black
+    if (src.x < 0.0f || src.y < 0.0f || src.x > (float)(eye_width - 1) ||
+        src.y > (float)(eye_height - 1)) {
+#pragma unroll
+      for (int c = 0; c < 3; c++) { storeESSInput(&output[out_ind + c * plane], 0.0f); }
+      return;
+    }
+
+    uint32_t x0 = static_cast<uint32_t>(src.x);
+    uint32_t y0 = static_cast<uint32_t>(src.y);
+    uint32_t x1 = min(x0 + 1, eye_width - 1);
+    uint32_t y1 = min(y0 + 1, eye_height - 1);
+    float a = src.x - static_cast<float>(x0);
+    float b = src.y - static_cast<float>(y0);
+    const uint8_t* p00 = image + y0 * input_pitch + x0 * input_channels;
+    const uint8_t* p10 = image + y0 * input_pitch + x1 * input_channels;
+    const uint8_t* p01 = image + y1 * input_pitch + x0 * input_channels;
+    const uint8_t* p11 = image + y1 * input_pitch + x1 * input_channels;
+#pragma unroll
+    for (int c = 0; c < 3; c++) {
+      float value = (1 - a) * (1 - b) * p00[c] + a * (1 - b) * p10[c] + (1 - a) * b * p01[c] +
+                    a * b * p11[c];
+      storeESSInput(&output[out_ind + c * plane], value * (1.0f / 255.0f));
+    }
+  }
+}
+
+template <typename T>
+void launchRectifyPreprocessESS(const uint8_t* input, uint32_t input_pitch,
+                                uint32_t input_channels, size_t eye_offset,
+                                const __half2* map_left, const __half2* map_right,
+                                uint32_t eye_width, uint32_t eye_height, uint32_t crop_x,
+                                uint32_t crop_y, uint32_t crop_width, uint32_t crop_height,
+                                T* output_left, T* output_right, uint32_t output_width,
+                                uint32_t output_height, cudaStream_t stream) {
+  const dim3 block_dim(32, 32);
+  const dim3 launch_grid((output_width + (block_dim.x - 1)) / block_dim.x,
+                         (output_height + (block_dim.y - 1)) / block_dim.y,
+                         2);
+  rectifyPreprocessESSKernel<T><<<launch_grid, block_dim, 0, stream>>>(input,
+                                                                       input_pitch,
+                                                                       input_channels,
+                                                                       eye_offset,
+                                                                       map_left,
+                                                                       map_right,
+                                                                       eye_width,
+                                                                       eye_height,
+                                                                       crop_x,
+                                                                       crop_y,
+                                                                       crop_width,
+                                                                       crop_height,
+                                                                       output_left,
+                                                                       output_right,
+                                                                       output_width,
+                                                                       output_height);
+}
+
+void rectifyPreprocessESS(const uint8_t* input, uint32_t input_pitch, uint32_t input_channels,
+                          size_t eye_offset, const __half2* map_left, const __half2* map_right,
+                          uint32_t eye_width, uint32_t eye_height, uint32_t crop_x,
+                          uint32_t crop_y, uint32_t crop_width, uint32_t crop_height,
+                          float* output_left, float* output_right, uint32_t output_width,
+                          uint32_t output_height, cudaStream_t stream) {
+  launchRectifyPreprocessESS(input, input_pitch, input_channels, eye_offset, map_left,
+                             map_right, eye_width, eye_height, crop_x, crop_y, crop_width,
+                             crop_height, output_left, output_right, output_width,
+                             output_height, stream);
+}
+
+void rectifyPreprocessESS(const uint8_t* input, uint32_t input_pitch, uint32_t input_channels,
+                          size_t eye_offset, const __half2* map_left, const __half2* map_right,
+                          uint32_t eye_width, uint32_t eye_height, uint32_t crop_x,
+                          uint32_t crop_y, uint32_t crop_width, uint32_t crop_height,
+                          __half* output_left, __half* output_right, uint32_t output_width,
+                          uint32_t output_height, cudaStream_t stream) {
+  launchRectifyPreprocessESS(input, input_pitch, input_channels, eye_offset, map_left,
+                             map_right, eye_width, eye_height, crop_x, crop_y, crop_width,
+                             crop_height, output_left, output_right, output_width,
+                             output_height, stream);
+}
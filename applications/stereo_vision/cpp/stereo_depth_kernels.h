@@ -19,6 +19,7 @@
 #define STEREO_DEPTH_KERNELS_HPP
 
 #include <cuda.h>
+#include <cuda_fp16.h>
 
 
 void makeRectificationMap(float* M, float* d, float* R, float* P, float* mapx, float* mapy,
@@ -34,4 +35,30 @@ void preprocessESS(uint8_t* input, float* output, uint32_t input_width, uint32_t
                    uint32_t input_channels, uint32_t output_width, uint32_t output_height,
                    cudaStream_t stream);
 
+// Packs a float remap table into per-pixel half precision displacements (map - pixel position).
+// Storing the displacement rather than the absolute source coordinate keeps sub-pixel accuracy
+// in fp16 for frames wider than 2048 pixels.
+void packRectificationMap(const float* mapx, const float* mapy, __half2* map, uint32_t width,
+                          uint32_t height, cudaStream_t stream);
+
+// Rectifies, crops and resamples both eyes of a stacked stereo frame straight into the planar
+// float NxCxHxW ESS inputs, scaled to [0, 1]. The left eye starts at input and the right eye at
+// input + eye_offset bytes; both have eye_width x eye_height pixels with input_pitch bytes per
+// row. The crop window is given in rectified coordinates.
+void rectifyPreprocessESS(const uint8_t* input, uint32_t input_pitch, uint32_t input_channels,
+                          size_t eye_offset, const __half2* map_left, const __half2* map_right,
+                          uint32_t eye_width, uint32_t eye_height, uint32_t crop_x,
+                          uint32_t crop_y, uint32_t crop_width, uint32_t crop_height,
+                          float* output_left, float* output_right, uint32_t output_width,
+                          uint32_t output_height, cudaStream_t stream);
+
+// Same as above with half precision outputs, the input format preferred by DLA engines built
+// with fp16 input bindings.
+void rectifyPreprocessESS(const uint8_t* input, uint32_t input_pitch, uint32_t input_channels,
+                          size_t eye_offset, const __half2* map_left, const __half2* map_right,
+                          uint32_t eye_width, uint32_t eye_height, uint32_t crop_x,
+                          uint32_t crop_y, uint32_t crop_width, uint32_t crop_height,
+                          __half* output_left, __half* output_right, uint32_t output_width,
+                          uint32_t output_height, cudaStream_t stream);
+
 #endif
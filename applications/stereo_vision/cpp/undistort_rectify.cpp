@@ -222,16 +222,25 @@ std::vector<std::pair<float, float>> UndistortRectifyOp::undistortPoints(
 void UndistortRectifyOp::setup(OperatorSpec& spec) {
   spec.input<holoscan::gxf::Entity>("input");
   spec.output<holoscan::gxf::Entity>("output");
+  spec.param(allocator_, "allocator", "Allocator", "Allocator for the rectified output");
+  cuda_stream_handler_.define_params(spec);
+}
+
+void UndistortRectifyOp::start() {
+  if (nppGetStreamContext(&npp_stream_ctx_) != NPP_SUCCESS) {
+    throw std::runtime_error("Failed to get NPP CUDA stream context");
+  }
 }
 
 void UndistortRectifyOp::compute(InputContext& op_input, OutputContext& op_output,
                                  ExecutionContext& context) {
-  auto maybe_tensormap = op_input.receive<holoscan::TensorMap>("input");
-  const auto tensormap = maybe_tensormap.value();
+  auto in_message = op_input.receive<holoscan::gxf::Entity>("input").value();
 
-  if (tensormap.size() != 1) { throw std::runtime_error("Expecting single tensor input"); }
+  if (in_message.findAll<nvidia::gxf::Tensor>()->size() != 1) {
+    throw std::runtime_error("Expecting single tensor input");
+  }
 
-  auto tensor = tensormap.begin()->second;
+  auto tensor = in_message.get<Tensor>();
 
   int height = tensor->shape()[0];
   int width = tensor->shape()[1];
@@ -248,72 +257,70 @@ void UndistortRectifyOp::compute(InputContext& op_input, OutputContext& op_outpu
     throw std::runtime_error("Number of channels in input must be 1, 3 or 4");
   }
 
-  auto pointer = std::shared_ptr<void*>(new void*, [](void** pointer) {
-    if (pointer != nullptr) {
-      if (*pointer != nullptr) { cudaFree(*pointer); }
-      delete pointer;
-    }
-  });
+  if (cuda_stream_handler_.from_message(context.context(), in_message) != GXF_SUCCESS) {
+    throw std::runtime_error("Failed to get the CUDA stream from incoming messages");
+  }
+  npp_stream_ctx_.hStream = cuda_stream_handler_.get_cuda_stream(context.context());
+
+  auto allocator = nvidia::gxf::Handle<nvidia::gxf::Allocator>::Create(context.context(),
+                                                                         allocator_->gxf_cid());
+  auto out_message = nvidia::gxf::Entity::New(context.context());
+  auto gxf_tensor = out_message.value().add<nvidia::gxf::Tensor>("");
+  nvidia::gxf::Shape shape = nvidia::gxf::Shape{height, width, nChannels};
+  if (!gxf_tensor.value()->reshape<uint8_t>(
+          shape, nvidia::gxf::MemoryStorageType::kDevice, allocator.value())) {
+    throw std::runtime_error("Failed to allocate output tensor");
+  }
 
-  cudaMalloc(pointer.get(), width * height * nChannels * sizeof(uint8_t));
   NppStatus status;
   if (nChannels == 1) {
-    nppiRemap_8u_C1R(static_cast<Npp8u*>(tensor->data()),
-                     {width, height},
-                     width * nChannels * sizeof(Npp8u),
-                     {0, 0, width, height},
-                     rectification_map_->mapx_,
-                     width * sizeof(Npp32f),
-                     rectification_map_->mapy_,
-                     width * sizeof(Npp32f),
-                     static_cast<Npp8u*>(*pointer.get()),
-                     width * nChannels * sizeof(Npp8u),
-                     {width, height},
-                     NPPI_INTER_LINEAR);
+    status = nppiRemap_8u_C1R_Ctx(static_cast<Npp8u*>(tensor->data()),
+                                  {width, height},
+                                  width * nChannels * sizeof(Npp8u),
+                                  {0, 0, width, height},
+                                  rectification_map_->mapx_,
+                                  width * sizeof(Npp32f),
+                                  rectification_map_->mapy_,
+                                  width * sizeof(Npp32f),
+                                  gxf_tensor.value()->data<Npp8u>().value(),
+                                  width * nChannels * sizeof(Npp8u),
+                                  {width, height},
+                                  NPPI_INTER_LINEAR,
+                                  npp_stream_ctx_);
   } else if (nChannels == 3) {
-    status = nppiRemap_8u_C3R(static_cast<Npp8u*>(tensor->data()),
-                              {width, height},
-                              width * nChannels * sizeof(Npp8u),
-                              {0, 0, width, height},
-                              rectification_map_->mapx_,
-                              width * sizeof(Npp32f),
-                              rectification_map_->mapy_,
-                              width * sizeof(Npp32f),
-                              static_cast<Npp8u*>(*pointer.get()),
-                              width * nChannels * sizeof(Npp8u),
-                              {width, height},
-                              NPPI_INTER_LINEAR);
-  } else if (nChannels == 4) {
-    nppiRemap_8u_C4R(static_cast<Npp8u*>(tensor->data()),
-                     {width, height},
-                     width * nChannels * sizeof(Npp8u),
-                     {0, 0, width, height},
-                     rectification_map_->mapx_,
-                     width * sizeof(Npp32f),
-                     rectification_map_->mapy_,
-                     width * sizeof(Npp32f),
-                     static_cast<Npp8u*>(*pointer.get()),
-                     width * nChannels * sizeof(Npp8u),
-                     {width, height},
-                     NPPI_INTER_LINEAR);
+    status = nppiRemap_8u_C3R_Ctx(static_cast<Npp8u*>(tensor->data()),
+                                  {width, height},
+                                  width * nChannels * sizeof(Npp8u),
+                                  {0, 0, width, height},
+                                  rectification_map_->mapx_,
+                                  width * sizeof(Npp32f),
+                                  rectification_map_->mapy_,
+                                  width * sizeof(Npp32f),
+                                  gxf_tensor.value()->data<Npp8u>().value(),
+                                  width * nChannels * sizeof(Npp8u),
+                                  {width, height},
+                                  NPPI_INTER_LINEAR,
+                                  npp_stream_ctx_);
   } else {
-    throw std::runtime_error("Number of channels in input must be 1, 3 or 4");
+    status = nppiRemap_8u_C4R_Ctx(static_cast<Npp8u*>(tensor->data()),
+                                  {width, height},
+                                  width * nChannels * sizeof(Npp8u),
+                                  {0, 0, width, height},
+                                  rectification_map_->mapx_,
+                                  width * sizeof(Npp32f),
+                                  rectification_map_->mapy_,
+                                  width * sizeof(Npp32f),
+                                  gxf_tensor.value()->data<Npp8u>().value(),
+                                  width * nChannels * sizeof(Npp8u),
+                                  {width, height},
+                                  NPPI_INTER_LINEAR,
+                                  npp_stream_ctx_);
   }
-  auto out_message = nvidia::gxf::Entity::New(context.context());
-  auto gxf_tensor = out_message.value().add<nvidia::gxf::Tensor>("");
-  nvidia::gxf::Shape shape = nvidia::gxf::Shape{height, width, nChannels};
-  int element_size = nvidia::gxf::PrimitiveTypeSize(nvidia::gxf::PrimitiveType::kUnsigned8);
-  gxf_tensor.value()->wrapMemory(shape,
-                                 nvidia::gxf::PrimitiveType::kUnsigned8,
-                                 element_size,
-                                 nvidia::gxf::ComputeTrivialStrides(shape, element_size),
-                                 nvidia::gxf::MemoryStorageType::kDevice,
-                                 *pointer,
-                                 [orig_pointer = pointer](void*) mutable {
-                                   orig_pointer.reset();  // decrement ref count
-                                   return nvidia::gxf::Success;
-                                 });
+  if (status != NPP_SUCCESS) { throw std::runtime_error("Failed to remap input image"); }
 
+  if (cuda_stream_handler_.to_message(out_message) != GXF_SUCCESS) {
+    throw std::runtime_error("Failed to add the CUDA stream to the outgoing messages");
+  }
   op_output.emit(out_message.value(), "output");
 }
 
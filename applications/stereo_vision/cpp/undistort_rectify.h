@@ -18,6 +18,7 @@
 #ifndef OPERATORS_UNDISTORT_RECTIFY
 #define OPERATORS_UNDISTORT_RECTIFY
 
+#include <npp.h>
 #include <holoscan/holoscan.hpp>
 #include <holoscan/operators/holoviz/holoviz.hpp>
 #include <holoscan/operators/video_stream_replayer/video_stream_replayer.hpp>
@@ -52,6 +53,7 @@ class UndistortRectifyOp : public Operator {
   HOLOSCAN_OPERATOR_FORWARD_ARGS(UndistortRectifyOp);
   UndistortRectifyOp() = default;
   void setup(OperatorSpec& spec) override;
+  void start() override;
   void compute(InputContext&, OutputContext& op_output, ExecutionContext&) override;
   void setRectificationMap(std::shared_ptr<RectificationMap> rectification_map) {
     rectification_map_ = rectification_map;
@@ -59,6 +61,9 @@ class UndistortRectifyOp : public Operator {
 
  private:
   std::shared_ptr<RectificationMap> rectification_map_;
+  Parameter<std::shared_ptr<Allocator>> allocator_;
+  CudaStreamHandler cuda_stream_handler_;
+  NppStreamContext npp_stream_ctx_{};
   static std::vector<std::pair<float, float>> distortPoints(
       std::vector<std::pair<float, float>> pts_in, float* M, float* d);
   static std::vector<std::pair<float, float>> undistortPoints(
@@ -13,11 +13,27 @@
 #See the License for the specific language governing permissions and
 #limitations under the License.
 
-if [ "$#" -ne 1 ]; then
-    echo "Error: expecting path/to/data as only input argument"
+if [ "$#" -lt 1 ] || [ "$#" -gt 3 ]; then
+    echo "Error: expecting path/to/data [fp32|fp16|int8] [dla_core] as input arguments"
     exit 1
 fi
 
+# engine precision and DLA core, -1 to build for the GPU only
+PRECISION=${2:-fp32}
+DLA_CORE=${3:--1}
+case "$PRECISION" in
+    fp32|fp16|int8) ;;
+    *) echo "Error: unknown precision $PRECISION, expecting fp32, fp16 or int8"; exit 1 ;;
+esac
+# ESS does not ship an int8 calibration cache, it has to be provided
+if [ "$PRECISION" == "int8" ] && [ ! -f "$ESS_INT8_CALIBRATION_CACHE" ]; then
+    echo "Error: int8 requires ESS_INT8_CALIBRATION_CACHE to point to a calibration cache"
+    exit 1
+fi
+if [ "$PRECISION" == "int8" ]; then
+    ESS_INT8_CALIBRATION_CACHE=$(realpath "$ESS_INT8_CALIBRATION_CACHE")
+fi
+
 SCRIPTDIR=$( cd -- "$( dirname -- "${BASH_SOURCE[0]}" )" &> /dev/null && pwd )
 
 #get the ess and tao converter from ngc to produce engine file for ess stereo matching
@@ -35,4 +51,12 @@ else
 fi
 wget --content-disposition 'https://api.ngc.nvidia.com/v2/models/org/nvidia/team/isaac/dnn_stereo_disparity/3.0.0/files?redirect=true&path=ess.etlt' -O ess.etlt
 chmod +x tao-converter
-./tao-converter ess.etlt -k ess -t fp32 -o output_left,output_conf -e "../../ess.engine"
+CONVERTER_ARGS=(-t "$PRECISION")
+if [ "$PRECISION" == "int8" ]; then
+    CONVERTER_ARGS+=(-c "$ESS_INT8_CALIBRATION_CACHE")
+fi
+# tao-converter builds DLA engines with GPU fallback for the unsupported layers
+if [ "$DLA_CORE" -ge 0 ]; then
+    CONVERTER_ARGS+=(-u "$DLA_CORE")
+fi
+./tao-converter ess.etlt -k ess "${CONVERTER_ARGS[@]}" -o output_left,output_conf -e "../../ess.engine"
@@ -23,6 +23,7 @@
 #include <holoscan/operators/inference/inference.hpp>
 #include <holoscan/operators/segmentation_postprocessor/segmentation_postprocessor.hpp>
 #include <holoscan/operators/holoviz/holoviz.hpp>
+#include <segmentation_pipeline.hpp>
 
 #ifdef AJA_SOURCE
 #include <aja_source.hpp>
@@ -37,11 +38,12 @@ class App : public holoscan::Application {
      datapath = path;
   }
 
+  void set_fused_pipeline(bool fused) { fused_pipeline_ = fused; }
+
   void compose() override {
     using namespace holoscan;
 
     std::shared_ptr<Operator> source;
-    std::shared_ptr<Operator> drop_alpha_channel;
 
     if (is_aja_source_) {
       source = make_operator<ops::AJASourceOp>("aja", from_config("aja"));
@@ -53,82 +55,107 @@ class App : public holoscan::Application {
     const std::shared_ptr<CudaStreamPool> cuda_stream_pool =
         make_resource<CudaStreamPool>("cuda_stream", 0, 0, 0, 1, 5);
 
-    const int width = 1920;
-    const int height = 1080;
-    const int n_channels = 4;
-    const int bpp = 4;
-    if (is_aja_source_) {
-      uint64_t drop_alpha_block_size = width * height * n_channels * bpp;
-      uint64_t drop_alpha_num_blocks = 2;
-      drop_alpha_channel = make_operator<ops::FormatConverterOp>(
-          "drop_alpha_channel",
-          from_config("drop_alpha_channel"),
-          Arg("pool") = make_resource<BlockMemoryPool>(
-              "pool", 1, drop_alpha_block_size, drop_alpha_num_blocks),
-          Arg("cuda_stream_pool") = cuda_stream_pool);
-    }
-
-    int width_preprocessor = 1264;
-    int height_preprocessor = 1080;
-    uint64_t preprocessor_block_size = width_preprocessor * height_preprocessor * n_channels * bpp;
-    uint64_t preprocessor_num_blocks = 3;
-    auto segmentation_preprocessor = make_operator<ops::FormatConverterOp>(
-        "segmentation_preprocessor",
-        from_config("segmentation_preprocessor"),
-        Arg("in_tensor_name", std::string(is_aja_source_ ? "source_video" : "")),
-        Arg("pool") = make_resource<BlockMemoryPool>(
-            "pool", 1, preprocessor_block_size, preprocessor_num_blocks),
-        Arg("cuda_stream_pool") = cuda_stream_pool);
-
-    const int n_channels_inference = 2;
-    const int width_inference = 256;
-    const int height_inference = 256;
-    const int bpp_inference = 4;
-    const uint64_t inference_block_size =
-        width_inference * height_inference * n_channels_inference * bpp_inference;
-    const uint64_t inference_num_blocks = 2;
-
-    ops::InferenceOp::DataMap model_path_map;
-    model_path_map.insert("ultrasound_seg", datapath + "/us_unet_256x256_nhwc.onnx");
-    auto segmentation_inference = make_operator<ops::InferenceOp>(
-        "segmentation_inference_holoinfer",
-        from_config("segmentation_inference_holoinfer"),
-        Arg("model_path_map", model_path_map),
-        Arg("allocator") =
-            make_resource<BlockMemoryPool>("pool", 1, inference_block_size, inference_num_blocks));
-
-    const uint64_t postprocessor_block_size = width_inference * height_inference;
-    const uint64_t postprocessor_num_blocks = 2;
-    auto segmentation_postprocessor = make_operator<ops::SegmentationPostprocessorOp>(
-        "segmentation_postprocessor",
-        from_config("segmentation_postprocessor"),
-        Arg("allocator") = make_resource<BlockMemoryPool>(
-            "pool", 1, postprocessor_block_size, postprocessor_num_blocks));
-
     auto segmentation_visualizer =
         make_operator<ops::HolovizOp>("segmentation_visualizer",
                                       from_config("segmentation_visualizer"),
                                       Arg("allocator") = make_resource<UnboundedAllocator>("pool"),
                                       Arg("cuda_stream_pool") = cuda_stream_pool);
 
-    // Flow definition
+    const std::string source_output = is_aja_source_ ? "video_buffer_output" : "";
+    add_flow(source, segmentation_visualizer, {{source_output, "receivers"}});
 
-    if (is_aja_source_) {
-      add_flow(source, segmentation_visualizer, {{"video_buffer_output", "receivers"}});
-      add_flow(source, drop_alpha_channel, {{"video_buffer_output", ""}});
-      add_flow(drop_alpha_channel, segmentation_preprocessor);
+    const int width_inference = 256;
+    const int height_inference = 256;
+    const std::string model_path = datapath + "/us_unet_256x256_nhwc.onnx";
+
+    if (fused_pipeline_) {
+      // preprocessing, inference and postprocessing in one operator, reading the RGBA AJA frames
+      // directly
+      const uint64_t pipeline_block_size = width_inference * height_inference;
+      const uint64_t pipeline_num_blocks = 2;
+      auto segmentation_pipeline = make_operator<ops::SegmentationPipelineOp>(
+          "segmentation_pipeline",
+          from_config("segmentation_pipeline"),
+          Arg("model_path", model_path),
+          Arg("engine_cache_dir", datapath + "/engines"),
+          Arg("allocator") = make_resource<BlockMemoryPool>(
+              "pool", 1, pipeline_block_size, pipeline_num_blocks),
+          Arg("cuda_stream_pool") = cuda_stream_pool);
+
+      add_flow(source, segmentation_pipeline, {{source_output, "source_video"}});
+      add_flow(segmentation_pipeline, segmentation_visualizer, {{"out_tensor", "receivers"}});
     } else {
-      add_flow(source, segmentation_visualizer, {{"", "receivers"}});
-      add_flow(source, segmentation_preprocessor);
-    }
+      std::shared_ptr<Operator> drop_alpha_channel;
+
+      const int width = 1920;
+      const int height = 1080;
+      const int n_channels = 4;
+      const int bpp = 4;
+      if (is_aja_source_) {
+        uint64_t drop_alpha_block_size = width * height * n_channels * bpp;
+        uint64_t drop_alpha_num_blocks = 2;
+        drop_alpha_channel = make_operator<ops::FormatConverterOp>(
+            "drop_alpha_channel",
+            from_config("drop_alpha_channel"),
+            Arg("pool") = make_resource<BlockMemoryPool>(
+                "pool", 1, drop_alpha_block_size, drop_alpha_num_blocks),
+            Arg("cuda_stream_pool") = cuda_stream_pool);
+      }
+
+      int width_preprocessor = 1264;
+      int height_preprocessor = 1080;
+      uint64_t preprocessor_block_size =
+          width_preprocessor * height_preprocessor * n_channels * bpp;
+      uint64_t preprocessor_num_blocks = 3;
+      auto segmentation_preprocessor = make_operator<ops::FormatConverterOp>(
+          "segmentation_preprocessor",
+          from_config("segmentation_preprocessor"),
+          Arg("in_tensor_name", std::string(is_aja_source_ ? "source_video" : "")),
+          Arg("pool") = make_resource<BlockMemoryPool>(
+              "pool", 1, preprocessor_block_size, preprocessor_num_blocks),
+          Arg("cuda_stream_pool") = cuda_stream_pool);
 
-    add_flow(segmentation_preprocessor, segmentation_inference, {{"", "receivers"}});
-    add_flow(segmentation_inference, segmentation_postprocessor, {{"transmitter", ""}});
-    add_flow(segmentation_postprocessor, segmentation_visualizer, {{"", "receivers"}});
+      const int n_channels_inference = 2;
+      const int bpp_inference = 4;
+      const uint64_t inference_block_size =
+          width_inference * height_inference * n_channels_inference * bpp_inference;
+      const uint64_t inference_num_blocks = 2;
+
+      ops::InferenceOp::DataMap model_path_map;
+      model_path_map.insert("ultrasound_seg", model_path);
+      auto segmentation_inference = make_operator<ops::InferenceOp>(
+          "segmentation_inference_holoinfer",
+          from_config("segmentation_inference_holoinfer"),
+          Arg("model_path_map", model_path_map),
+          Arg("allocator") = make_resource<BlockMemoryPool>(
+              "pool", 1, inference_block_size, inference_num_blocks));
+
+      const uint64_t postprocessor_block_size = width_inference * height_inference;
+      const uint64_t postprocessor_num_blocks = 2;
+      auto segmentation_postprocessor = make_operator<ops::SegmentationPostprocessorOp>(
+          "segmentation_postprocessor",
+          from_config("segmentation_postprocessor"),
+          Arg("allocator") = make_resource<BlockMemoryPool>(
+              "pool", 1, postprocessor_block_size, postprocessor_num_blocks));
+
+      // Flow definition
+
+      if (is_aja_source_) {
+        add_flow(source, drop_alpha_channel, {{"video_buffer_output", ""}});
+        add_flow(drop_alpha_channel, segmentation_preprocessor);
+      } else {
+        add_flow(source, segmentation_preprocessor);
+      }
+
+      add_flow(segmentation_preprocessor, segmentation_inference, {{"", "receivers"}});
+      add_flow(segmentation_inference, segmentation_postprocessor, {{"transmitter", ""}});
+      add_flow(segmentation_postprocessor, segmentation_visualizer, {{"", "receivers"}});
+    }
   }
 
  private:
   bool is_aja_source_ = false;
+  bool fused_pipeline_ = true;
   std::string datapath = "data/ultrasound_segmentation";
 };
 
@@ -179,6 +206,7 @@ int main(int argc, char** argv) {
 
   auto source = app->from_config("source").as<std::string>();
   app->set_source(source);
+  app->set_fused_pipeline(app->from_config("fused_pipeline").as<bool>());
   if (data_path != "") app->set_datapath(data_path);
 
   app->run();
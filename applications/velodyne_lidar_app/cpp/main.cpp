@@ -16,18 +16,27 @@
  */
 
 #include <iostream>
+#include <string>
+#include <vector>
 
 #include <holoscan/holoscan.hpp>
 #include <holoscan/operators/holoviz/holoviz.hpp>
 
 #include <basic_network_operator_rx.h>
 #include <velodyne_lidar.hpp>
+#include <velodyne_fusion.hpp>
 
 class App : public holoscan::Application {
  public:
   void compose() override {
     using namespace holoscan;
 
+    auto ports = sensor_ports();
+    if (!ports.empty()) {
+      compose_fusion(ports);
+      return;
+    }
+
     auto net_rx = make_operator<ops::BasicNetworkOpRx>(
         "network_rx", from_config("network_rx"), make_condition<BooleanCondition>("is_alive"));
     auto velodyne_op = make_operator<holoscan::ops::VelodyneLidarOp>("lidar", from_config("lidar"));
@@ -36,6 +45,41 @@ class App : public holoscan::Application {
     add_flow(net_rx, velodyne_op, {{"burst_out", "burst_in"}});
     add_flow(velodyne_op, viz_op, {{"cloud_out", "receivers"}});
   }
+
+ private:
+  // UDP port of each sensor of the sensors section, empty for a single sensor
+  std::vector<uint16_t> sensor_ports() {
+    std::vector<uint16_t> ports;
+    for (const auto& yaml_node : config().yaml_nodes()) {
+      if (!yaml_node["sensors"]) { continue; }
+      for (const auto& sensor : yaml_node["sensors"]) {
+        ports.push_back(sensor["dst_port"].as<uint16_t>());
+      }
+    }
+    return ports;
+  }
+
+  // One receiver and lidar operator per sensor, merged into a single cloud
+  void compose_fusion(const std::vector<uint16_t>& ports) {
+    using namespace holoscan;
+
+    auto fusion_op =
+        make_operator<holoscan::ops::VelodyneFusionOp>("fusion", from_config("fusion"));
+    auto viz_op = make_operator<holoscan::ops::HolovizOp>("holoviz", from_config("holoviz"));
+    for (size_t i = 0; i < ports.size(); i++) {
+      const auto suffix = "_" + std::to_string(i);
+      auto net_rx = make_operator<ops::BasicNetworkOpRx>(
+          "network_rx" + suffix,
+          from_config("network_rx"),
+          Arg("dst_port", ports[i]),
+          make_condition<BooleanCondition>("is_alive" + suffix));
+      auto velodyne_op =
+          make_operator<holoscan::ops::VelodyneLidarOp>("lidar" + suffix, from_config("lidar"));
+      add_flow(net_rx, velodyne_op, {{"burst_out", "burst_in"}});
+      add_flow(velodyne_op, fusion_op, {{"cloud_out", "clouds_in"}});
+    }
+    add_flow(fusion_op, viz_op, {{"cloud_out", "receivers"}});
+  }
 };
 
 int main(int argc, char** argv) {
@@ -31,7 +31,8 @@ class App : public holoscan::Application {
   App(const std::string& render_config_file, const std::vector<std::string>& render_preset_files,
       const std::string& write_config_file, const std::string& density_volume_file,
       const std::optional<float>& density_min, const std::optional<float>& density_max,
-      const std::string& mask_volume_file, int count)
+      const std::string& mask_volume_file, int count, float frame_time_target,
+      bool temporal_accumulation)
       : render_config_file_(render_config_file),
         render_preset_files_(render_preset_files),
         write_config_file_(write_config_file),
@@ -39,7 +40,9 @@ class App : public holoscan::Application {
         density_min_(density_min),
         density_max_(density_max),
         mask_volume_file_(mask_volume_file),
-        count_(count) {}
+        count_(count),
+        frame_time_target_(frame_time_target),
+        temporal_accumulation_(temporal_accumulation) {}
   App() = delete;
 
   void compose() override {
@@ -90,6 +93,8 @@ class App : public holoscan::Application {
                                              Arg("alloc_width", 1024u),
                                              Arg("alloc_height", 768u),
                                              Arg("cuda_stream_pool", cuda_stream_pool),
+                                             Arg("frame_time_target", frame_time_target_),
+                                             Arg("temporal_accumulation", temporal_accumulation_),
                                              volume_renderer_optional_args);
 
     auto holoviz = make_operator<ops::HolovizOp>(
@@ -147,6 +152,8 @@ class App : public holoscan::Application {
   const std::optional<float> density_max_;
   const std::string mask_volume_file_;
   const int count_;
+  const float frame_time_target_;
+  const bool temporal_accumulation_;
 };
 
 int main(int argc, char** argv) {
@@ -162,6 +169,8 @@ int main(int argc, char** argv) {
   std::optional<float> density_max;
   std::string mask_volume_file;
   int count = -1;
+  float frame_time_target = 0.f;
+  bool temporal_accumulation = false;
 
   struct option long_options[] = {{"help", no_argument, 0, 'h'},
                                   {"usages", no_argument, 0, 'u'},
@@ -173,13 +182,15 @@ int main(int argc, char** argv) {
                                   {"density_max", optional_argument, 0, 'a'},
                                   {"mask", required_argument, 0, 'm'},
                                   {"count", optional_argument, 0, 'n'},
+                                  {"frame_time_target", required_argument, 0, 'f'},
+                                  {"temporal", no_argument, 0, 't'},
                                   {0, 0, 0, 0}};
 
   // parse options
   while (true) {
     int option_index = 0;
 
-    const int c = getopt_long(argc, argv, "huc:p:w:d:i:a:m:e", long_options, &option_index);
+    const int c = getopt_long(argc, argv, "huc:p:w:d:i:a:m:ef:t", long_options, &option_index);
 
     if (c == -1) { break; }
 
@@ -220,6 +231,12 @@ int main(int argc, char** argv) {
             << mask_volume_file_default << "')" << std::endl
             << "  -n <COUNT>, --count <COUNT>           Duration to run application "
                "(default '-1' for unlimited duration)"
+            << std::endl
+            << "  -f <MS>, --frame_time_target <MS>     Render time budget in milliseconds, the "
+               "render quality is adapted to hold it (default '0' for fixed quality)"
+            << std::endl
+            << "  -t, --temporal                        Accumulate frames over time, reprojected "
+               "while the camera moves"
             << std::endl;
         return 0;
 
@@ -255,6 +272,14 @@ int main(int argc, char** argv) {
         count = stoi(argument);
         break;
 
+      case 'f':
+        frame_time_target = std::stof(argument);
+        break;
+
+      case 't':
+        temporal_accumulation = true;
+        break;
+
       case '?':
         // unknown option, error already printed by getop_long
         break;
@@ -275,7 +300,9 @@ int main(int argc, char** argv) {
                                              density_min,
                                              density_max,
                                              mask_volume_file,
-                                             count);
+                                             count,
+                                             frame_time_target,
+                                             temporal_accumulation);
   app->run();
 
   holoscan::log_info("Application has finished running.");
@@ -64,6 +64,8 @@ class VolumeRenderingApp(Application):
         density_min,
         density_max,
         mask_volume_file,
+        frame_time_target=0.0,
+        temporal_accumulation=False,
         **kwargs,
     ):
         self._rendering_config = render_config_file
@@ -73,6 +75,8 @@ class VolumeRenderingApp(Application):
         self._mask_volume_file = mask_volume_file
         self._density_min = density_min
         self._density_max = density_max
+        self._frame_time_target = frame_time_target
+        self._temporal_accumulation = temporal_accumulation
 
         super().__init__(argv, *args, **kwargs)
 
@@ -133,6 +137,8 @@ class VolumeRenderingApp(Application):
             alloc_width=1024,
             alloc_height=768,
             cuda_stream_pool=cuda_stream_pool,
+            frame_time_target=self._frame_time_target,
+            temporal_accumulation=self._temporal_accumulation,
             **volume_renderer_args,
         )
 
@@ -277,6 +283,23 @@ if __name__ == "__main__":
         dest="mask",
         help=f"Name of mask volume file to load (default {mask_volume_file_default})",
     )
+    parser.add_argument(
+        "-f",
+        "--frame_time_target",
+        action="store",
+        type=float,
+        default=0.0,
+        dest="frame_time_target",
+        help="Render time budget in milliseconds, the render quality is adapted to hold it "
+        "(default 0 for fixed quality)",
+    )
+    parser.add_argument(
+        "-t",
+        "--temporal",
+        action="store_true",
+        dest="temporal_accumulation",
+        help="Accumulate frames over time, reprojected while the camera moves",
+    )
     parser.add_argument(
         "-h", "--help", action="help", default=argparse.SUPPRESS, help="Help message"
     )
@@ -300,6 +323,8 @@ if __name__ == "__main__":
         density_min=args.density_min,
         density_max=args.density_max,
         mask_volume_file=str(args.mask) if "mask" in args else None,
+        frame_time_target=args.frame_time_target,
+        temporal_accumulation=args.temporal_accumulation,
     )
     app.config()
 
@@ -15,10 +15,10 @@
  * limitations under the License.
  */
 
-#include "operators/XrFrameOp/convert_depth/convert_depth_to_screen_space_op.hpp"
 #include "holoscan/holoscan.hpp"
 #include "operators/XrFrameOp/begin_frame/xr_begin_frame_op.hpp"
 #include "operators/XrFrameOp/end_frame/xr_end_frame_op.hpp"
+#include "operators/XrFrameOp/split_eyes/xr_split_eyes_op.hpp"
 #include "operators/XrTransformOp/XrTransformControlOp/xr_transform_control_op.hpp"
 #include "operators/XrTransformOp/XrTransformRenderOp/xr_transform_render_op.hpp"
 
@@ -27,7 +27,10 @@
 
 #include <getopt.h>
 #include <nlohmann/json.hpp>
+#include <set>
 #include <string>
+#include <utility>
+#include <vector>
 
 /**
  * Dummy YAML convert function for shared data type
@@ -115,12 +118,14 @@ class App : public holoscan::Application {
  public:
   App(const std::string& render_config_file, const std::string& write_config_file,
       const std::string& density_volume_file, const std::string& mask_volume_file,
-      bool enable_eye_tracking)
+      bool enable_eye_tracking, bool late_latch, bool split_eyes)
       : render_config_file_(render_config_file),
         write_config_file_(write_config_file),
         density_volume_file_(density_volume_file),
         mask_volume_file_(mask_volume_file),
-        enable_eye_tracking_(enable_eye_tracking) {}
+        enable_eye_tracking_(enable_eye_tracking),
+        late_latch_(late_latch),
+        split_eyes_(split_eyes) {}
   App() = delete;
 
   void compose() override {
@@ -140,7 +145,9 @@ class App : public holoscan::Application {
         holoscan::Arg("session") = xr_session,
         holoscan::Arg("enable_eye_tracking") = enable_eye_tracking_);
     auto xr_end_frame = make_operator<holoscan::openxr::XrEndFrameOp>(
-        "xr_end_frame", holoscan::Arg("session") = xr_session);
+        "xr_end_frame",
+        holoscan::Arg("session") = xr_session,
+        holoscan::Arg("late_latch") = late_latch_);
 
     auto xr_transform_controller =
         make_operator<holoscan::openxr::XrTransformControlOp>("xr_transform_controller");
@@ -148,7 +155,8 @@ class App : public holoscan::Application {
         "xr_transform_render",
         holoscan::Arg("display_width", xr_session->display_width()),
         holoscan::Arg("display_height", xr_session->display_height()),
-        holoscan::Arg("config_file", render_config_file_));
+        holoscan::Arg("config_file", render_config_file_),
+        holoscan::Arg("convert_depth", true));
 
     auto density_volume_loader = make_operator<holoscan::ops::VolumeLoaderOp>(
         "density_volume_loader",
@@ -171,33 +179,56 @@ class App : public holoscan::Application {
         "volume_renderer",
         holoscan::Arg("config_file", render_config_file_),
         holoscan::Arg("write_config_file", write_config_file_));
-
-    auto convert_depth =
-        make_operator<holoscan::openxr::ConvertDepthToScreenSpaceOp>("convert_depth");
+    // with split eyes the renderer above renders the left eye on the display GPU, and a second
+    // renderer the right eye on the next GPU
+    std::vector<std::shared_ptr<holoscan::ops::VolumeRendererOp>> volume_renderers{
+        volume_renderer};
+    std::shared_ptr<holoscan::openxr::XrSplitEyesOp> xr_split_eyes;
+    std::shared_ptr<holoscan::openxr::XrMergeEyesOp> xr_merge_eyes;
+    if (split_eyes_) {
+      const uint32_t right_cuda_device = 1;
+      volume_renderer->add_arg(holoscan::Arg("stereo_mode", std::string("LEFT")));
+      volume_renderers.push_back(make_operator<holoscan::ops::VolumeRendererOp>(
+          "right_volume_renderer",
+          holoscan::Arg("config_file", render_config_file_),
+          holoscan::Arg("cuda_device", right_cuda_device),
+          holoscan::Arg("stereo_mode", std::string("RIGHT")),
+          holoscan::Arg("cuda_stream_pool",
+                        make_resource<holoscan::CudaStreamPool>(
+                            "right_cuda_stream", right_cuda_device, 0, 0, 1, 5))));
+      xr_split_eyes = make_operator<holoscan::openxr::XrSplitEyesOp>(
+          "xr_split_eyes", holoscan::Arg("right_cuda_device", right_cuda_device));
+      xr_merge_eyes = make_operator<holoscan::openxr::XrMergeEyesOp>(
+          "xr_merge_eyes", holoscan::Arg("right_cuda_device", right_cuda_device));
+    }
 
     // OpenXR render loop.
     add_flow(xr_begin_frame, xr_end_frame, {{"xr_frame", "xr_frame"}});
 
-    // volume data loader
-    add_flow(density_volume_loader,
-             volume_renderer,
-             {
-                 {"volume", "density_volume"},
-                 {"spacing", "density_spacing"},
-                 {"permute_axis", "density_permute_axis"},
-                 {"flip_axes", "density_flip_axes"},
-             });
+    // volume data loader, each renderer gets its own copy of the volumes on its GPU
+    for (auto& renderer : volume_renderers) {
+      add_flow(density_volume_loader,
+               renderer,
+               {
+                   {"volume", "density_volume"},
+                   {"spacing", "density_spacing"},
+                   {"permute_axis", "density_permute_axis"},
+                   {"flip_axes", "density_flip_axes"},
+               });
+    }
     add_flow(density_volume_loader, xr_transform_controller, {{"extent", "extent"}});
 
     if (mask_volume_loader) {
-      add_flow(mask_volume_loader,
-               volume_renderer,
-               {
-                   {"volume", "mask_volume"},
-                   {"spacing", "mask_spacing"},
-                   {"permute_axis", "mask_permute_axis"},
-                   {"flip_axes", "mask_flip_axes"},
-               });
+      for (auto& renderer : volume_renderers) {
+        add_flow(mask_volume_loader,
+                 renderer,
+                 {
+                     {"volume", "mask_volume"},
+                     {"spacing", "mask_spacing"},
+                     {"permute_axis", "mask_permute_axis"},
+                     {"flip_axes", "mask_flip_axes"},
+                 });
+      }
     }
 
     // Transform the volume with controller input.
@@ -222,23 +253,34 @@ class App : public holoscan::Application {
                  {"right_camera_model", "right_camera_model"},
              });
 
-    add_flow(xr_begin_frame,
-             volume_renderer,
-             {
-                 {"depth_range", "depth_range"},
-                 {"left_camera_pose", "left_camera_pose"},
-                 {"right_camera_pose", "right_camera_pose"},
-                 {"left_camera_model", "left_camera_model"},
-                 {"right_camera_model", "right_camera_model"},
-                 {"eye_gaze_pose", "eye_gaze_pose"},
-             });
-
-    add_flow(xr_transform_controller,
-             volume_renderer,
-             {
-                 {"crop_box", "crop_box"},
-                 {"volume_pose", "volume_pose"},
-             });
+    const std::set<std::pair<std::string, std::string>> views{
+        {"left_camera_pose", "left_camera_pose"},
+        {"right_camera_pose", "right_camera_pose"},
+        {"left_camera_model", "left_camera_model"},
+        {"right_camera_model", "right_camera_model"},
+    };
+    for (auto& renderer : volume_renderers) {
+      add_flow(xr_begin_frame,
+               renderer,
+               {
+                   {"depth_range", "depth_range"},
+                   {"eye_gaze_pose", "eye_gaze_pose"},
+                   {"left_eye_gaze_pose", "left_eye_gaze_pose"},
+                   {"right_eye_gaze_pose", "right_eye_gaze_pose"},
+               });
+      // with split eyes the views come with the eye buffers of the same frame
+      add_flow(split_eyes_ ? std::shared_ptr<holoscan::Operator>(xr_split_eyes)
+                           : std::shared_ptr<holoscan::Operator>(xr_begin_frame),
+               renderer,
+               views);
+
+      add_flow(xr_transform_controller,
+               renderer,
+               {
+                   {"crop_box", "crop_box"},
+                   {"volume_pose", "volume_pose"},
+               });
+    }
 
     add_flow(xr_transform_controller,
              xr_transform_renderer,
@@ -259,28 +301,64 @@ class App : public holoscan::Application {
                  {"render_settings", "in"},
              });
 
-    add_flow(render_settings_source,
-             volume_renderer,
-             {
-                 {"out", "merge_settings"},
-             });
+    for (auto& renderer : volume_renderers) {
+      add_flow(render_settings_source,
+               renderer,
+               {
+                   {"out", "merge_settings"},
+               });
+    }
 #else
 
-    add_flow(xr_transform_renderer,
-             volume_renderer,
-             {
-                 {"render_settings", "merge_settings"},
-             });
+    for (auto& renderer : volume_renderers) {
+      add_flow(xr_transform_renderer,
+               renderer,
+               {
+                   {"render_settings", "merge_settings"},
+               });
+    }
 
 #endif
-    add_flow(xr_begin_frame, volume_renderer, {{"color_buffer", "color_buffer_in"}});
-    add_flow(volume_renderer, xr_transform_renderer, {{"color_buffer_out", "color_buffer_in"}});
+    if (split_eyes_) {
+      // the left eye is rendered into the top halves of the swapchain buffers, the right eye on
+      // the second GPU is copied into the bottom halves
+      add_flow(xr_begin_frame, xr_split_eyes, views);
+      add_flow(xr_begin_frame,
+               xr_split_eyes,
+               {{"color_buffer", "color_buffer_in"}, {"depth_buffer", "depth_buffer_in"}});
+      add_flow(
+          xr_split_eyes,
+          volume_renderers[0],
+          {{"left_color_buffer", "color_buffer_in"}, {"left_depth_buffer", "depth_buffer_in"}});
+      add_flow(
+          xr_split_eyes,
+          volume_renderers[1],
+          {{"right_color_buffer", "color_buffer_in"}, {"right_depth_buffer", "depth_buffer_in"}});
+      add_flow(xr_split_eyes,
+               xr_merge_eyes,
+               {{"color_buffer_out", "color_buffer_in"}, {"depth_buffer_out", "depth_buffer_in"}});
+      add_flow(volume_renderers[0],
+               xr_merge_eyes,
+               {{"color_buffer_out", "left_color_buffer"},
+                {"depth_buffer_out", "left_depth_buffer"}});
+      add_flow(volume_renderers[1],
+               xr_merge_eyes,
+               {{"color_buffer_out", "right_color_buffer"},
+                {"depth_buffer_out", "right_depth_buffer"}});
+      add_flow(xr_merge_eyes,
+               xr_transform_renderer,
+               {{"color_buffer_out", "color_buffer_in"}, {"depth_buffer_out", "depth_buffer_in"}});
+    } else {
+      add_flow(xr_begin_frame, volume_renderer, {{"color_buffer", "color_buffer_in"}});
+      add_flow(
+          volume_renderer, xr_transform_renderer, {{"color_buffer_out", "color_buffer_in"}});
+
+      add_flow(xr_begin_frame, volume_renderer, {{"depth_buffer", "depth_buffer_in"}});
+      // the renderer converts the depth to screen space on its stream before compositing
+      add_flow(
+          volume_renderer, xr_transform_renderer, {{"depth_buffer_out", "depth_buffer_in"}});
+    }
     add_flow(xr_transform_renderer, xr_end_frame, {{"color_buffer_out", "color_buffer"}});
-
-    add_flow(xr_begin_frame, volume_renderer, {{"depth_buffer", "depth_buffer_in"}});
-    add_flow(volume_renderer, convert_depth, {{"depth_buffer_out", "depth_buffer_in"}});
-    add_flow(xr_begin_frame, convert_depth, {{"depth_range", "depth_range"}});
-    add_flow(convert_depth, xr_transform_renderer, {{"depth_buffer_out", "depth_buffer_in"}});
     add_flow(xr_transform_renderer, xr_end_frame, {{"depth_buffer_out", "depth_buffer"}});
   }
 
@@ -289,6 +367,8 @@ class App : public holoscan::Application {
   const std::string density_volume_file_;
   const std::string mask_volume_file_;
   const bool enable_eye_tracking_;
+  const bool late_latch_;
+  const bool split_eyes_;
 };
 
 int main(int argc, char** argv) {
@@ -305,6 +385,8 @@ int main(int argc, char** argv) {
   std::string density_volume_file;
   std::string mask_volume_file;
   bool enable_eye_tracking = false;
+  bool late_latch = false;
+  bool split_eyes = false;
 
   struct option long_options[] = {{"help", no_argument, 0, 'h'},
                                   {"config", required_argument, 0, 'c'},
@@ -312,13 +394,15 @@ int main(int argc, char** argv) {
                                   {"density", required_argument, 0, 'd'},
                                   {"mask", required_argument, 0, 'm'},
                                   {"eye-tracking", no_argument, 0, 'e'},
+                                  {"late-latch", no_argument, 0, 'l'},
+                                  {"split-eyes", no_argument, 0, 's'},
                                   {0, 0, 0, 0}};
 
   // parse options
   while (true) {
     int option_index = 0;
 
-    const int c = getopt_long(argc, argv, "hc:w:d:m:e", long_options, &option_index);
+    const int c = getopt_long(argc, argv, "hc:w:d:m:els", long_options, &option_index);
 
     if (c == -1) { break; }
 
@@ -343,6 +427,12 @@ int main(int argc, char** argv) {
                "(default '"
             << mask_volume_file_default << "')" << std::endl
             << "  -e, --eye-tracking                    Enable eye tracking and foveated rendering."
+            << std::endl
+            << "  -l, --late-latch                      Reproject the rendered views to the "
+               "latest display pose."
+            << std::endl
+            << "  -s, --split-eyes                      Render each eye on its own GPU, the "
+               "right eye on GPU 1."
             << std::endl;
         return 0;
 
@@ -366,6 +456,14 @@ int main(int argc, char** argv) {
         enable_eye_tracking = true;
         break;
 
+      case 'l':
+        late_latch = true;
+        break;
+
+      case 's':
+        split_eyes = true;
+        break;
+
       case '?':
         // unknown option, error already printed by getop_long
         break;
@@ -383,7 +481,9 @@ int main(int argc, char** argv) {
           write_config_file,
           density_volume_file,
           mask_volume_file,
-          enable_eye_tracking);
+          enable_eye_tracking,
+          late_latch,
+          split_eyes);
   app.run();
   return 0;
 }
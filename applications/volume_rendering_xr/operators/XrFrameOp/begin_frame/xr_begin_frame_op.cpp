@@ -49,6 +49,9 @@ void XrBeginFrameOp::setup(OperatorSpec& spec) {
   spec.output<nvidia::gxf::Pose3D>("head_pose").condition(ConditionType::kNone);
   // eye gaze pose in view space
   spec.output<nvidia::gxf::Pose3D>("eye_gaze_pose").condition(ConditionType::kNone);
+  // eye gaze pose of each eye in the view space of the eye, the foveation centers
+  spec.output<nvidia::gxf::Pose3D>("left_eye_gaze_pose").condition(ConditionType::kNone);
+  spec.output<nvidia::gxf::Pose3D>("right_eye_gaze_pose").condition(ConditionType::kNone);
 
   // render buffer
   spec.output<holoscan::gxf::Entity>("color_buffer");
@@ -59,6 +62,12 @@ void XrBeginFrameOp::setup(OperatorSpec& spec) {
              "enable_eye_tracking",
              "Eye tracking enable switch",
              "Enable eye tracking");
+  spec.param(gaze_fixation_distance_,
+             "gaze_fixation_distance",
+             "Gaze fixation distance",
+             "Distance in meters along the eye gaze of the point both eyes fixate, used to derive "
+             "the gaze of each eye. 0 fixates at infinity.",
+             0.5f);
 }
 
 void XrBeginFrameOp::start() {
@@ -407,6 +416,14 @@ void XrBeginFrameOp::compute(InputContext& input, OutputContext& output,
       auto eye_gaze_message = poseAction(space_location.pose);
       output.emit(eye_gaze_message, "eye_gaze_pose");
     }
+
+    space_location = eye_gaze_space_->locateSpace(space, frame.state.predictedDisplayTime);
+    if ((space_location.locationFlags & xr::SpaceLocationFlagBits::PositionValid) &&
+        (space_location.locationFlags & xr::SpaceLocationFlagBits::OrientationValid) &&
+        (frame.views.size() == 2)) {
+      output.emit(eyeGazePose(space_location.pose, frame.views[0].pose), "left_eye_gaze_pose");
+      output.emit(eyeGazePose(space_location.pose, frame.views[1].pose), "right_eye_gaze_pose");
+    }
   }
 }
 
@@ -429,6 +446,42 @@ nvidia::gxf::Pose3D XrBeginFrameOp::poseAction(const xr::Posef& pose) {
   return pose3d;
 }
 
+nvidia::gxf::Pose3D XrBeginFrameOp::eyeGazePose(const xr::Posef& gaze_pose,
+                                                const xr::Posef& eye_pose) {
+  const Eigen::Vector3f gaze_position(
+      gaze_pose.position.x, gaze_pose.position.y, gaze_pose.position.z);
+  const Eigen::Quaternionf gaze_orientation(gaze_pose.orientation.w,
+                                            gaze_pose.orientation.x,
+                                            gaze_pose.orientation.y,
+                                            gaze_pose.orientation.z);
+  const Eigen::Vector3f eye_position(eye_pose.position.x, eye_pose.position.y, eye_pose.position.z);
+  const Eigen::Quaternionf eye_orientation(eye_pose.orientation.w,
+                                           eye_pose.orientation.x,
+                                           eye_pose.orientation.y,
+                                           eye_pose.orientation.z);
+
+  // the combined gaze starts between the eyes, rotate it towards the fixation point as seen from
+  // the eye
+  const Eigen::Vector3f gaze_direction = gaze_orientation * -Eigen::Vector3f::UnitZ();
+  Eigen::Quaternionf orientation = gaze_orientation;
+  if (gaze_fixation_distance_.get() > 0.f) {
+    const Eigen::Vector3f fixation = gaze_position + gaze_direction * gaze_fixation_distance_.get();
+    orientation = Eigen::Quaternionf::FromTwoVectors(gaze_direction, fixation - eye_position) *
+                  gaze_orientation;
+  }
+
+  // to the view space of the eye
+  const Eigen::Quaternionf eye_inverse = eye_orientation.conjugate();
+  const Eigen::Vector3f position = eye_inverse * (gaze_position - eye_position);
+  orientation = eye_inverse * orientation;
+
+  nvidia::gxf::Pose3D pose3d;
+  pose3d.translation = {position.x(), position.y(), position.z()};
+  Eigen::Map<Eigen::Matrix<float, 3, 3, Eigen::RowMajor>>(pose3d.rotation.data()) =
+      orientation.normalized().matrix();
+  return pose3d;
+}
+
 nvidia::gxf::Pose3D XrBeginFrameOp::toPose3D(const xr::View& view) {
   nvidia::gxf::Pose3D pose;
   pose.translation = {
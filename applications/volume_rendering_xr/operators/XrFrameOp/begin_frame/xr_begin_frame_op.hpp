@@ -39,6 +39,7 @@ class XrBeginFrameOp : public Operator {
  private:
   Parameter<std::shared_ptr<holoscan::openxr::XrSession>> session_;
   Parameter<bool> enable_eye_tracking_;
+  Parameter<float> gaze_fixation_distance_;
 
   std::unique_ptr<XrCudaInteropSwapchain> color_swapchain_;
   std::unique_ptr<XrCudaInteropSwapchain> depth_swapchain_;
@@ -52,6 +53,8 @@ class XrBeginFrameOp : public Operator {
 
   bool boolAction(const xr::Session& xr_session, const std::string& name);
   nvidia::gxf::Pose3D poseAction(const xr::Posef& pose);
+  // gaze of an eye in its view space, from the combined gaze and the eye pose in the same space
+  nvidia::gxf::Pose3D eyeGazePose(const xr::Posef& gaze_pose, const xr::Posef& eye_pose);
 
   nvidia::gxf::Pose3D toPose3D(const xr::View& view);
   nvidia::gxf::CameraModel toCameraModel(const xr::View& view, uint32_t display_width,
@@ -19,26 +19,29 @@
 
 namespace {
 
-__global__ void convertDepthToScreenSpaceKernel(float* depth_buffer, int width, int height,
-                                                float near_z, float far_z) {
+// screen space depth = a + b / linear depth
+__global__ void convertDepthToScreenSpaceKernel(float* depth_buffer, size_t pitch, int width,
+                                                int height, float near_z, float far_z, float a,
+                                                float b) {
   int px = blockIdx.x * blockDim.x + threadIdx.x;
   int py = blockIdx.y * blockDim.y + threadIdx.y;
   if ((px >= width) || (py >= height)) return;
-  int pixel_index = py * width + px;
+  float* depth = reinterpret_cast<float*>(reinterpret_cast<uint8_t*>(depth_buffer) + py * pitch);
 
-  float linear_depth = fmaxf(near_z, fminf(depth_buffer[pixel_index], far_z));
-  depth_buffer[pixel_index] =
-      ((linear_depth * far_z) - (near_z * far_z)) / (linear_depth * (far_z - near_z));
+  float linear_depth = fmaxf(near_z, fminf(depth[px], far_z));
+  depth[px] = a + b / linear_depth;
 }
 
 }  // namespace
 
-void convertDepthToScreenSpace(cudaStream_t stream, float* depth_buffer, int width, int height,
-                               float near_z, float far_z) {
-  int tx = 8;
+void convertDepthToScreenSpace(cudaStream_t stream, float* depth_buffer, size_t pitch, int width,
+                               int height, float near_z, float far_z) {
+  int tx = 32;
   int ty = 8;
-  dim3 blocks(width / tx + 1, height / ty + 1);
+  dim3 blocks((width + tx - 1) / tx, (height + ty - 1) / ty);
   dim3 threads(tx, ty);
+  const float a = far_z / (far_z - near_z);
+  const float b = -(near_z * far_z) / (far_z - near_z);
   convertDepthToScreenSpaceKernel<<<blocks, threads, 0, stream>>>(
-      depth_buffer, width, height, near_z, far_z);
+      depth_buffer, pitch, width, height, near_z, far_z, a, b);
 }
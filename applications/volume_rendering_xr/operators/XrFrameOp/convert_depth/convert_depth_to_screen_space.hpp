@@ -20,7 +20,11 @@
 
 #include <cuda_runtime.h>
 
-void convertDepthToScreenSpace(cudaStream_t stream, float* color_image, int width, int height,
-                               float near_z, float far_z);
+// Converts a D32F depth buffer from linear world units to screen space ([0,1]) in place.
+//
+// `height` covers all the rows of the buffer, so both stereo views of a vertically stacked
+// buffer are converted by a single launch.
+void convertDepthToScreenSpace(cudaStream_t stream, float* depth_buffer, size_t pitch, int width,
+                               int height, float near_z, float far_z);
 
 #endif /* HOLOSCAN_OPERATORS_OPENXR_CONVERT_DEPTH_TO_SCREEN_SPACE_HPP */
@@ -62,6 +62,7 @@ void ConvertDepthToScreenSpaceOp::compute(InputContext& input, OutputContext& ou
   }
   convertDepthToScreenSpace(stream_,
                             reinterpret_cast<float*>(depth_buffer->pointer()),
+                            depth_buffer->video_frame_info().color_planes[0].stride,
                             depth_buffer->video_frame_info().width,
                             depth_buffer->video_frame_info().height,
                             depth_range->x,
@@ -0,0 +1,112 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2023 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "reproject_views.hpp"
+
+namespace {
+
+// Fixed point iterations refining the depth of the reprojected point
+constexpr int kIterations = 2;
+
+__device__ float linearDepth(float depth, float near_z, float far_z) {
+  return (near_z * far_z) / (far_z - depth * (far_z - near_z));
+}
+
+__global__ void reprojectViewsKernel(ReprojectionViews views, const uint8_t* color_in,
+                                     size_t color_pitch, const float* depth_in,
+                                     size_t depth_pitch, uint8_t* color_out, float* depth_out,
+                                     int width, int height, float near_z, float far_z) {
+  int px = blockIdx.x * blockDim.x + threadIdx.x;
+  int py = blockIdx.y * blockDim.y + threadIdx.y;
+  if ((px >= width) || (py >= height)) return;
+  // stereo views are stacked vertically
+  const int row_offset = blockIdx.z * height;
+  const ReprojectionView& view = views.views[blockIdx.z];
+
+  auto depth_at = [&](int x, int y) {
+    return reinterpret_cast<const float*>(reinterpret_cast<const uint8_t*>(depth_in) +
+                                          (row_offset + y) * depth_pitch)[x];
+  };
+
+  // ray through the pixel center in the late view space, OpenXR views look down -z
+  const float* late = view.late_tangents;
+  const float tx = late[0] + (px + 0.5f) / width * (late[1] - late[0]);
+  const float ty = late[2] - (py + 0.5f) / height * (late[2] - late[3]);
+
+  // start with the depth at the same pixel and refine with the depth at the reprojected pixel
+  float depth = depth_at(px, py);
+  int sx = -1;
+  int sy = -1;
+  for (int iteration = 0; iteration < kIterations; ++iteration) {
+    const float z = linearDepth(depth, near_z, far_z);
+    const float x = tx * z;
+    const float y = ty * z;
+    const float* m = view.late_to_render;
+    const float rx = m[0] * x + m[1] * y - m[2] * z + m[3];
+    const float ry = m[4] * x + m[5] * y - m[6] * z + m[7];
+    const float rz = m[8] * x + m[9] * y - m[10] * z + m[11];
+    if (rz >= 0.f) {
+      sx = -1;
+      break;
+    }
+    const float* render = view.render_tangents;
+    const float u = (rx / -rz - render[0]) / (render[1] - render[0]) * width;
+    const float v = (render[2] - ry / -rz) / (render[2] - render[3]) * height;
+    sx = static_cast<int>(floorf(u));
+    sy = static_cast<int>(floorf(v));
+    if ((sx < 0) || (sx >= width) || (sy < 0) || (sy >= height)) {
+      sx = -1;
+      break;
+    }
+    depth = depth_at(sx, sy);
+  }
+
+  uchar4* color = reinterpret_cast<uchar4*>(color_out + (row_offset + py) * color_pitch) + px;
+  float* depth_value =
+      reinterpret_cast<float*>(reinterpret_cast<uint8_t*>(depth_out) +
+                               (row_offset + py) * depth_pitch) + px;
+  if (sx < 0) {
+    *color = make_uchar4(0, 0, 0, 0);
+    *depth_value = 1.f;
+    return;
+  }
+  *color = reinterpret_cast<const uchar4*>(color_in + (row_offset + sy) * color_pitch)[sx];
+  *depth_value = depth;
+}
+
+}  // namespace
+
+void reprojectViews(cudaStream_t stream, const ReprojectionViews& views, const uint8_t* color_in,
+                    size_t color_pitch, const float* depth_in, size_t depth_pitch,
+                    uint8_t* color_out, float* depth_out, int width, int height, float near_z,
+                    float far_z) {
+  int tx = 8;
+  int ty = 8;
+  dim3 blocks(width / tx + 1, height / ty + 1, 2);
+  dim3 threads(tx, ty);
+  reprojectViewsKernel<<<blocks, threads, 0, stream>>>(views,
+                                                        color_in,
+                                                        color_pitch,
+                                                        depth_in,
+                                                        depth_pitch,
+                                                        color_out,
+                                                        depth_out,
+                                                        width,
+                                                        height,
+                                                        near_z,
+                                                        far_z);
+}
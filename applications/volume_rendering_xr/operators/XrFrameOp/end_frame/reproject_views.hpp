@@ -0,0 +1,47 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2023 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef HOLOSCAN_OPERATORS_OPENXR_REPROJECT_VIEWS_HPP
+#define HOLOSCAN_OPERATORS_OPENXR_REPROJECT_VIEWS_HPP
+
+#include <cuda_runtime.h>
+
+#include <cstdint>
+
+// One of the views stacked vertically in the color and depth buffers.
+struct ReprojectionView {
+  // row major 3x4 transform from the late view space to the view space the view was rendered in
+  float late_to_render[12];
+  // tangents of the late and the render field of view angles {left, right, up, down}
+  float late_tangents[4];
+  float render_tangents[4];
+};
+
+struct ReprojectionViews {
+  ReprojectionView views[2];
+};
+
+// Reprojects the rendered stereo views to the late poses, using the screen space depth to
+// reconstruct the scene. Pixels reprojected from outside of the rendered views are
+// transparent at the far plane. Color is RGBA8, depth float, pitches are in bytes, width and
+// height are the size of a single view. The output buffers must not alias the inputs.
+void reprojectViews(cudaStream_t stream, const ReprojectionViews& views, const uint8_t* color_in,
+                    size_t color_pitch, const float* depth_in, size_t depth_pitch,
+                    uint8_t* color_out, float* depth_out, int width, int height, float near_z,
+                    float far_z);
+
+#endif /* HOLOSCAN_OPERATORS_OPENXR_REPROJECT_VIEWS_HPP */
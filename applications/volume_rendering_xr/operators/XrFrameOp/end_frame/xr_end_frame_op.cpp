@@ -17,6 +17,11 @@
 
 #include "xr_end_frame_op.hpp"
 
+#include <cmath>
+#include <stdexcept>
+
+#include "reproject_views.hpp"
+
 #include "Eigen/Dense"
 #include "gxf/core/entity.hpp"
 #include "gxf/cuda/cuda_event.hpp"
@@ -25,11 +30,125 @@
 
 namespace holoscan::openxr {
 
+namespace {
+
+Eigen::Affine3f to_eigen(const xr::Posef& pose) {
+  return Eigen::Translation3f(pose.position.x, pose.position.y, pose.position.z) *
+         Eigen::Quaternionf(
+             pose.orientation.w, pose.orientation.x, pose.orientation.y, pose.orientation.z);
+}
+
+void to_tangents(const xr::Fovf& fov, float* tangents) {
+  tangents[0] = std::tan(fov.angleLeft);
+  tangents[1] = std::tan(fov.angleRight);
+  tangents[2] = std::tan(fov.angleUp);
+  tangents[3] = std::tan(fov.angleDown);
+}
+
+void ensure_size(void*& buffer, size_t& buffer_size, size_t size) {
+  if (buffer_size >= size) { return; }
+  if (buffer) { cudaFree(buffer); }
+  buffer = nullptr;
+  buffer_size = 0;
+  if (cudaMalloc(&buffer, size) != cudaSuccess) {
+    throw std::runtime_error("Failed to allocate reprojection buffer");
+  }
+  buffer_size = size;
+}
+
+}  // namespace
+
+XrEndFrameOp::~XrEndFrameOp() {
+  if (color_target_) { cudaFree(color_target_); }
+  if (depth_target_) { cudaFree(depth_target_); }
+}
+
 void XrEndFrameOp::setup(OperatorSpec& spec) {
   spec.input<XrFrame>("xr_frame");
   spec.input<holoscan::gxf::Entity>("color_buffer");
   spec.input<holoscan::gxf::Entity>("depth_buffer");
   spec.param(session_, "session", "OpenXR Session", "handles to OpenXR and Vulkan context");
+  spec.param(late_latch_,
+             "late_latch",
+             "Late Latch",
+             "Locate the views again before ending the frame and reproject the buffers to them",
+             false);
+}
+
+void XrEndFrameOp::reproject(XrSession& session, holoscan::gxf::Entity& color_message,
+                             holoscan::gxf::Entity& depth_message,
+                             const std::vector<xr::View>& render_views,
+                             const std::vector<xr::View>& late_views) {
+  auto color_buffer = static_cast<nvidia::gxf::Entity&>(color_message)
+                          .get<nvidia::gxf::VideoBuffer>()
+                          .value();
+  auto depth_buffer = static_cast<nvidia::gxf::Entity&>(depth_message)
+                          .get<nvidia::gxf::VideoBuffer>()
+                          .value();
+  const size_t color_pitch = color_buffer->video_frame_info().color_planes[0].stride;
+  const size_t depth_pitch = depth_buffer->video_frame_info().color_planes[0].stride;
+  if (depth_buffer->video_frame_info().color_format !=
+      nvidia::gxf::VideoFormat::GXF_VIDEO_FORMAT_GRAY32F) {
+    throw std::runtime_error("Reprojection requires a float depth buffer");
+  }
+
+  // the buffers are written on the streams recorded with the messages
+  cudaStream_t stream = session.cuda_stream();
+  for (auto* message : {&color_message, &depth_message}) {
+    auto cuda_events = message->findAll<nvidia::gxf::CudaEvent>().value();
+    for (auto cuda_event : cuda_events) {
+      if (cuda_event.has_value() && cuda_event.value()->event().has_value()) {
+        if (cudaStreamWaitEvent(stream, cuda_event.value()->event().value()) != cudaSuccess) {
+          throw std::runtime_error("cudaStreamWaitEvent failed");
+        }
+      }
+    }
+  }
+
+  ReprojectionViews views;
+  for (int i = 0; i < 2; i++) {
+    const Eigen::Matrix4f late_to_render =
+        (to_eigen(render_views[i].pose).inverse() * to_eigen(late_views[i].pose)).matrix();
+    for (int row = 0; row < 3; row++) {
+      for (int column = 0; column < 4; column++) {
+        views.views[i].late_to_render[row * 4 + column] = late_to_render(row, column);
+      }
+    }
+    to_tangents(late_views[i].fov, views.views[i].late_tangents);
+    to_tangents(render_views[i].fov, views.views[i].render_tangents);
+  }
+
+  const size_t color_size = color_pitch * color_buffer->video_frame_info().height;
+  const size_t depth_size = depth_pitch * depth_buffer->video_frame_info().height;
+  ensure_size(color_target_, color_target_size_, color_size);
+  ensure_size(depth_target_, depth_target_size_, depth_size);
+
+  reprojectViews(stream,
+                 views,
+                 color_buffer->pointer(),
+                 color_pitch,
+                 reinterpret_cast<const float*>(depth_buffer->pointer()),
+                 depth_pitch,
+                 reinterpret_cast<uint8_t*>(color_target_),
+                 reinterpret_cast<float*>(depth_target_),
+                 session.display_width(),
+                 session.display_height(),
+                 session.view_configuration_depth_range().recommendedNearZ,
+                 session.view_configuration_depth_range().recommendedFarZ);
+
+  // the swapchain releases wait for the session stream
+  if ((cudaMemcpyAsync(color_buffer->pointer(),
+                       color_target_,
+                       color_size,
+                       cudaMemcpyDeviceToDevice,
+                       stream) != cudaSuccess) ||
+      (cudaMemcpyAsync(depth_buffer->pointer(),
+                       depth_target_,
+                       depth_size,
+                       cudaMemcpyDeviceToDevice,
+                       stream) != cudaSuccess)) {
+    throw std::runtime_error("Failed to copy the reprojected buffers");
+  }
 }
 
 void XrEndFrameOp::compute(InputContext& input, OutputContext& output, ExecutionContext& context) {
@@ -39,6 +158,22 @@ void XrEndFrameOp::compute(InputContext& input, OutputContext& output, Execution
   auto depth_message = input.receive<holoscan::gxf::Entity>("depth_buffer").value();
   auto frame = input.receive<XrFrame>("xr_frame");
 
+  std::vector<xr::View> views = frame->views;
+  if (late_latch_.get()) {
+    xr::ViewState view_state;
+    xr::ViewLocateInfo view_locate_info(xr::ViewConfigurationType::PrimaryStereo,
+                                        frame->state.predictedDisplayTime,
+                                        session->reference_space());
+    std::vector<xr::View> late_views =
+        session->handle().locateViewsToVector(view_locate_info, view_state.put());
+    const xr::ViewStateFlags valid =
+        xr::ViewStateFlagBits::PositionValid | xr::ViewStateFlagBits::OrientationValid;
+    if (((view_state.viewStateFlags & valid) == valid) && (late_views.size() == views.size())) {
+      reproject(*session, color_message, depth_message, views, late_views);
+      views = late_views;
+    }
+  }
+
   frame->color_swapchain.release(color_message);
   frame->depth_swapchain.release(depth_message);
 
@@ -60,8 +195,8 @@ void XrEndFrameOp::compute(InputContext& input, OutputContext& output, Execution
         session->view_configuration_depth_range().recommendedFarZ,
     });
     projection_layer_views[i] = xr::CompositionLayerProjectionView({
-        frame->views[i].pose,
-        frame->views[i].fov,
+        views[i].pose,
+        views[i].fov,
         xr::SwapchainSubImage(frame->color_swapchain.handle(), rect, 0),
         &depth_info[i],
     });
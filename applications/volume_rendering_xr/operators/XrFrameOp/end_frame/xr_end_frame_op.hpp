@@ -18,6 +18,8 @@
 #ifndef HOLOSCAN_OPERATORS_OPENXR_XR_END_FRAME_OP_HPP
 #define HOLOSCAN_OPERATORS_OPENXR_XR_END_FRAME_OP_HPP
 
+#include <vector>
+
 #include "holoscan/holoscan.hpp"
 #include "xr_session.hpp"
 
@@ -25,17 +27,34 @@ namespace holoscan::openxr {
 
 // Ends each OpenXR frame by submitting layers to OpenXR for compositing and
 // display.
+//
+// With late_latch, the views are located again at the predicted display time just before the
+// frame ends and the rendered buffers are reprojected on the GPU from the poses they were
+// rendered with to these late poses, using the depth buffer. The late poses are submitted with
+// the layer, so the runtime's own depth based reprojection starts from them.
 class XrEndFrameOp : public Operator {
  public:
   HOLOSCAN_OPERATOR_FORWARD_ARGS(XrEndFrameOp)
 
   XrEndFrameOp() = default;
+  ~XrEndFrameOp();
 
   void setup(OperatorSpec& spec) override;
   void compute(InputContext& input, OutputContext& output, ExecutionContext& context) override;
 
  private:
+  void reproject(XrSession& session, holoscan::gxf::Entity& color_message,
+                 holoscan::gxf::Entity& depth_message, const std::vector<xr::View>& render_views,
+                 const std::vector<xr::View>& late_views);
+
   Parameter<std::shared_ptr<holoscan::openxr::XrSession>> session_;
+  Parameter<bool> late_latch_;
+
+  // reprojection targets, copied back to the swapchain buffers
+  void* color_target_ = nullptr;
+  void* depth_target_ = nullptr;
+  size_t color_target_size_ = 0;
+  size_t depth_target_size_ = 0;
 };
 
 }  // namespace holoscan::openxr
@@ -0,0 +1,328 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "xr_split_eyes_op.hpp"
+
+#include <mutex>
+#include <string>
+
+#include "gxf/cuda/cuda_event.hpp"
+#include "gxf/multimedia/camera.hpp"
+#include "gxf/multimedia/video.hpp"
+
+namespace holoscan::openxr {
+
+namespace {
+
+// The XR session imports the swapchain buffers into the default CUDA device
+constexpr int kDisplayCudaDevice = 0;
+
+nvidia::gxf::Handle<nvidia::gxf::VideoBuffer> get_video_buffer(holoscan::gxf::Entity& message) {
+  return static_cast<nvidia::gxf::Entity&>(message).get<nvidia::gxf::VideoBuffer>().value();
+}
+
+// Layout of one eye of a vertically stacked buffer, with the stride of the stacked buffer
+nvidia::gxf::VideoBufferInfo eye_info(const nvidia::gxf::VideoBufferInfo& stacked) {
+  nvidia::gxf::VideoBufferInfo info = stacked;
+  info.height = stacked.height / 2;
+  for (auto& plane : info.color_planes) {
+    plane.height = info.height;
+    plane.size = static_cast<uint64_t>(plane.stride) * plane.height;
+  }
+  return info;
+}
+
+void wait_for_events(cudaStream_t stream, holoscan::gxf::Entity& message) {
+  auto cuda_events = message.findAll<nvidia::gxf::CudaEvent>().value();
+  for (auto cuda_event : cuda_events) {
+    if (cuda_event.has_value() && cuda_event.value()->event().has_value()) {
+      if (cudaStreamWaitEvent(stream, cuda_event.value()->event().value()) != cudaSuccess) {
+        throw std::runtime_error("cudaStreamWaitEvent failed");
+      }
+    }
+  }
+}
+
+void record_event(cudaStream_t stream, holoscan::gxf::Entity& message) {
+  nvidia::gxf::Handle<nvidia::gxf::CudaEvent> cuda_event =
+      static_cast<nvidia::gxf::Entity&>(message).add<nvidia::gxf::CudaEvent>().value();
+  cuda_event->init();
+  if (cudaEventRecord(cuda_event->event().value(), stream) != cudaSuccess) {
+    throw std::runtime_error("cudaEventRecord failed");
+  }
+}
+
+template <typename T>
+void forward(InputContext& input, OutputContext& output, const char* name) {
+  auto value = input.receive<T>(name);
+  if (value) { output.emit(value.value(), name); }
+}
+
+}  // namespace
+
+class XrSplitEyesOp::BufferPool {
+ public:
+  BufferPool(uint32_t cuda_device, size_t size) : cuda_device_(cuda_device), size_(size) {}
+  ~BufferPool() {
+    cudaSetDevice(cuda_device_);
+    for (void* buffer : free_) { cudaFree(buffer); }
+    cudaSetDevice(kDisplayCudaDevice);
+  }
+
+  size_t size() const { return size_; }
+
+  void* acquire() {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (!free_.empty()) {
+        void* buffer = free_.back();
+        free_.pop_back();
+        return buffer;
+      }
+    }
+    void* buffer = nullptr;
+    cudaSetDevice(cuda_device_);
+    const cudaError_t result = cudaMalloc(&buffer, size_);
+    cudaSetDevice(kDisplayCudaDevice);
+    if (result != cudaSuccess) { throw std::runtime_error("Failed to allocate an eye buffer"); }
+    return buffer;
+  }
+
+  void release(void* buffer) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    free_.push_back(buffer);
+  }
+
+ private:
+  const uint32_t cuda_device_;
+  const size_t size_;
+  std::mutex mutex_;
+  std::vector<void*> free_;
+};
+
+void XrSplitEyesOp::setup(OperatorSpec& spec) {
+  spec.input<holoscan::gxf::Entity>("color_buffer_in");
+  spec.input<holoscan::gxf::Entity>("depth_buffer_in");
+  spec.input<nvidia::gxf::Pose3D>("left_camera_pose");
+  spec.input<nvidia::gxf::Pose3D>("right_camera_pose");
+  spec.input<nvidia::gxf::CameraModel>("left_camera_model");
+  spec.input<nvidia::gxf::CameraModel>("right_camera_model");
+
+  spec.output<nvidia::gxf::Pose3D>("left_camera_pose");
+  spec.output<nvidia::gxf::Pose3D>("right_camera_pose");
+  spec.output<nvidia::gxf::CameraModel>("left_camera_model");
+  spec.output<nvidia::gxf::CameraModel>("right_camera_model");
+  spec.output<holoscan::gxf::Entity>("left_color_buffer");
+  spec.output<holoscan::gxf::Entity>("left_depth_buffer");
+  spec.output<holoscan::gxf::Entity>("right_color_buffer");
+  spec.output<holoscan::gxf::Entity>("right_depth_buffer");
+  spec.output<holoscan::gxf::Entity>("color_buffer_out");
+  spec.output<holoscan::gxf::Entity>("depth_buffer_out");
+
+  spec.param(right_cuda_device_,
+             "right_cuda_device",
+             "Right CUDA device",
+             "CUDA device ordinal the right eye is rendered on",
+             1u);
+}
+
+void XrSplitEyesOp::start() {
+  color_pool_.reset();
+  depth_pool_.reset();
+}
+
+void XrSplitEyesOp::compute(InputContext& input, OutputContext& output,
+                            ExecutionContext& context) {
+  auto color_message = input.receive<holoscan::gxf::Entity>("color_buffer_in").value();
+  auto depth_message = input.receive<holoscan::gxf::Entity>("depth_buffer_in").value();
+
+  // the views of this frame go out before its buffers, so that each renderer renders them
+  forward<nvidia::gxf::Pose3D>(input, output, "left_camera_pose");
+  forward<nvidia::gxf::Pose3D>(input, output, "right_camera_pose");
+  forward<nvidia::gxf::CameraModel>(input, output, "left_camera_model");
+  forward<nvidia::gxf::CameraModel>(input, output, "right_camera_model");
+
+  auto emit_eyes = [&](holoscan::gxf::Entity& stacked_message,
+                       std::shared_ptr<BufferPool>& pool,
+                       const char* left_name,
+                       const char* right_name) {
+    nvidia::gxf::Handle<nvidia::gxf::VideoBuffer> stacked = get_video_buffer(stacked_message);
+    const nvidia::gxf::VideoBufferInfo info = eye_info(stacked->video_frame_info());
+    const size_t eye_size = info.color_planes[0].size;
+
+    // the top half of the swapchain buffer, owned by the stacked message
+    auto left_message = holoscan::gxf::Entity::New(&context);
+    auto left = static_cast<nvidia::gxf::Entity&>(left_message)
+                    .add<nvidia::gxf::VideoBuffer>()
+                    .value();
+    left->wrapMemory(
+        info, eye_size, nvidia::gxf::MemoryStorageType::kDevice, stacked->pointer(), nullptr);
+    output.emit(left_message, left_name);
+
+    if (!pool || (pool->size() != eye_size)) {
+      pool = std::make_shared<BufferPool>(right_cuda_device_.get(), eye_size);
+    }
+    auto right_message = holoscan::gxf::Entity::New(&context);
+    auto right = static_cast<nvidia::gxf::Entity&>(right_message)
+                     .add<nvidia::gxf::VideoBuffer>()
+                     .value();
+    right->wrapMemory(info,
+                      eye_size,
+                      nvidia::gxf::MemoryStorageType::kDevice,
+                      pool->acquire(),
+                      [pool](void* pointer) {
+                        pool->release(pointer);
+                        return nvidia::gxf::Success;
+                      });
+    output.emit(right_message, right_name);
+  };
+  emit_eyes(color_message, color_pool_, "left_color_buffer", "right_color_buffer");
+  emit_eyes(depth_message, depth_pool_, "left_depth_buffer", "right_depth_buffer");
+
+  output.emit(color_message, "color_buffer_out");
+  output.emit(depth_message, "depth_buffer_out");
+}
+
+void XrMergeEyesOp::setup(OperatorSpec& spec) {
+  spec.input<holoscan::gxf::Entity>("color_buffer_in");
+  spec.input<holoscan::gxf::Entity>("depth_buffer_in");
+  spec.input<holoscan::gxf::Entity>("left_color_buffer");
+  spec.input<holoscan::gxf::Entity>("left_depth_buffer");
+  spec.input<holoscan::gxf::Entity>("right_color_buffer");
+  spec.input<holoscan::gxf::Entity>("right_depth_buffer");
+
+  spec.output<holoscan::gxf::Entity>("color_buffer_out");
+  spec.output<holoscan::gxf::Entity>("depth_buffer_out");
+
+  spec.param(right_cuda_device_,
+             "right_cuda_device",
+             "Right CUDA device",
+             "CUDA device ordinal the right eye is rendered on",
+             1u);
+}
+
+void XrMergeEyesOp::start() {
+  display_cuda_device_ = kDisplayCudaDevice;
+  cudaSetDevice(display_cuda_device_);
+  if (cudaStreamCreate(&cuda_stream_) != cudaSuccess) {
+    throw std::runtime_error("cudaStreamCreate failed");
+  }
+
+  // peer to peer copies if the GPUs support it, else the driver stages them through the host
+  int can_access_peer = 0;
+  const int right_cuda_device = static_cast<int>(right_cuda_device_.get());
+  cudaDeviceCanAccessPeer(&can_access_peer, display_cuda_device_, right_cuda_device);
+  if (can_access_peer) {
+    const cudaError_t result = cudaDeviceEnablePeerAccess(right_cuda_device, 0);
+    if ((result != cudaSuccess) && (result != cudaErrorPeerAccessAlreadyEnabled)) {
+      throw std::runtime_error("cudaDeviceEnablePeerAccess failed");
+    }
+    // clear the sticky error of an already enabled peer access
+    cudaGetLastError();
+  } else {
+    HOLOSCAN_LOG_WARN("GPU {} can't access GPU {}, the right eye is copied through the host",
+                      display_cuda_device_,
+                      right_cuda_device);
+  }
+}
+
+void XrMergeEyesOp::stop() {
+  for (auto& in_flight : in_flight_) {
+    cudaEventSynchronize(in_flight.done);
+    free_events_.push_back(in_flight.done);
+  }
+  in_flight_.clear();
+  for (auto event : free_events_) { cudaEventDestroy(event); }
+  free_events_.clear();
+  if (cuda_stream_) {
+    cudaStreamDestroy(cuda_stream_);
+    cuda_stream_ = nullptr;
+  }
+}
+
+void XrMergeEyesOp::release_copied_buffers() {
+  // copies on the stream complete in order
+  while (!in_flight_.empty() && (cudaEventQuery(in_flight_.front().done) == cudaSuccess)) {
+    free_events_.push_back(in_flight_.front().done);
+    in_flight_.pop_front();
+  }
+}
+
+void XrMergeEyesOp::compute(InputContext& input, OutputContext& output,
+                            ExecutionContext& context) {
+  cudaSetDevice(display_cuda_device_);
+  release_copied_buffers();
+
+  auto color_message = input.receive<holoscan::gxf::Entity>("color_buffer_in").value();
+  auto depth_message = input.receive<holoscan::gxf::Entity>("depth_buffer_in").value();
+  auto left_color_message = input.receive<holoscan::gxf::Entity>("left_color_buffer").value();
+  auto left_depth_message = input.receive<holoscan::gxf::Entity>("left_depth_buffer").value();
+  auto right_color_message = input.receive<holoscan::gxf::Entity>("right_color_buffer").value();
+  auto right_depth_message = input.receive<holoscan::gxf::Entity>("right_depth_buffer").value();
+
+  // both eyes are rendered, the events of the right eye are recorded on the other GPU
+  for (auto* message : {&color_message,
+                        &depth_message,
+                        &left_color_message,
+                        &left_depth_message,
+                        &right_color_message,
+                        &right_depth_message}) {
+    wait_for_events(cuda_stream_, *message);
+  }
+
+  auto copy_right_eye = [&](holoscan::gxf::Entity& stacked_message,
+                            holoscan::gxf::Entity& eye_message) {
+    nvidia::gxf::Handle<nvidia::gxf::VideoBuffer> stacked = get_video_buffer(stacked_message);
+    nvidia::gxf::Handle<nvidia::gxf::VideoBuffer> eye = get_video_buffer(eye_message);
+    const auto& stacked_plane = stacked->video_frame_info().color_planes[0];
+    const auto& eye_plane = eye->video_frame_info().color_planes[0];
+    const uint32_t eye_height = eye->video_frame_info().height;
+    if (cudaMemcpy2DAsync(stacked->pointer() + static_cast<size_t>(stacked_plane.stride) *
+                                                   eye_height,
+                          stacked_plane.stride,
+                          eye->pointer(),
+                          eye_plane.stride,
+                          static_cast<size_t>(eye_plane.width) * eye_plane.bytes_per_pixel,
+                          eye_height,
+                          cudaMemcpyDefault,
+                          cuda_stream_) != cudaSuccess) {
+      throw std::runtime_error("Failed to copy the right eye to the swapchain buffer");
+    }
+  };
+  copy_right_eye(color_message, right_color_message);
+  copy_right_eye(depth_message, right_depth_message);
+
+  // the right eye buffers go back to their pool once the copies are done
+  cudaEvent_t done;
+  if (!free_events_.empty()) {
+    done = free_events_.back();
+    free_events_.pop_back();
+  } else if (cudaEventCreateWithFlags(&done, cudaEventDisableTiming) != cudaSuccess) {
+    throw std::runtime_error("cudaEventCreate failed");
+  }
+  if (cudaEventRecord(done, cuda_stream_) != cudaSuccess) {
+    throw std::runtime_error("cudaEventRecord failed");
+  }
+  in_flight_.push_back({done, {right_color_message, right_depth_message}});
+
+  record_event(cuda_stream_, color_message);
+  record_event(cuda_stream_, depth_message);
+  output.emit(color_message, "color_buffer_out");
+  output.emit(depth_message, "depth_buffer_out");
+}
+
+}  // namespace holoscan::openxr
@@ -0,0 +1,94 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef HOLOSCAN_OPERATORS_OPENXR_XR_SPLIT_EYES_OP_HPP
+#define HOLOSCAN_OPERATORS_OPENXR_XR_SPLIT_EYES_OP_HPP
+
+#include <cuda_runtime.h>
+
+#include <deque>
+#include <memory>
+#include <vector>
+
+#include "holoscan/holoscan.hpp"
+
+namespace holoscan::openxr {
+
+// Splits the vertically stacked color and depth swapchain buffers of a frame into one buffer pair
+// per eye, so that each eye is rendered by its own renderer on its own GPU.
+//
+// The left eye buffers are the top halves of the swapchain buffers, rendered in place on the
+// display GPU. The right eye buffers are allocated on `right_cuda_device` and copied into the
+// bottom halves by XrMergeEyesOp. The swapchain buffers are forwarded to XrMergeEyesOp, and the
+// camera poses and models of the frame are emitted together with the eye buffers, so that both
+// renderers render the views of the same frame.
+class XrSplitEyesOp : public Operator {
+ public:
+  HOLOSCAN_OPERATOR_FORWARD_ARGS(XrSplitEyesOp)
+
+  XrSplitEyesOp() = default;
+
+  void setup(OperatorSpec& spec) override;
+  void start() override;
+  void compute(InputContext& input, OutputContext& output, ExecutionContext& context) override;
+
+  // Device buffers of the right eye, reused once the messages holding them are destroyed
+  class BufferPool;
+
+ private:
+  Parameter<uint32_t> right_cuda_device_;
+
+  std::shared_ptr<BufferPool> color_pool_;
+  std::shared_ptr<BufferPool> depth_pool_;
+};
+
+// Copies the right eye rendered on the second GPU into the bottom halves of the swapchain
+// buffers, the left eye is already rendered in place, and emits the swapchain buffers.
+//
+// The copies run on a stream of the display GPU after the render events of both eyes, peer to
+// peer if the GPUs support it. The right eye buffers are kept until their copy is done.
+class XrMergeEyesOp : public Operator {
+ public:
+  HOLOSCAN_OPERATOR_FORWARD_ARGS(XrMergeEyesOp)
+
+  XrMergeEyesOp() = default;
+
+  void setup(OperatorSpec& spec) override;
+  void start() override;
+  void stop() override;
+  void compute(InputContext& input, OutputContext& output, ExecutionContext& context) override;
+
+ private:
+  void release_copied_buffers();
+
+  Parameter<uint32_t> right_cuda_device_;
+
+  int display_cuda_device_ = 0;
+  cudaStream_t cuda_stream_ = nullptr;
+
+  // right eye messages read by a copy, dropped once done is reached
+  struct InFlight {
+    cudaEvent_t done;
+    std::vector<holoscan::gxf::Entity> messages;
+  };
+  std::deque<InFlight> in_flight_;
+  std::vector<cudaEvent_t> free_events_;
+};
+
+}  // namespace holoscan::openxr
+
+#endif  // HOLOSCAN_OPERATORS_OPENXR_XR_SPLIT_EYES_OP_HPP
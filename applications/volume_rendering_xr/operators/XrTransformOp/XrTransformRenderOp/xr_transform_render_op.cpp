@@ -21,6 +21,9 @@
 
 #include <holoviz/imgui/imgui.h>
 
+#include "convert_depth_to_screen_space.hpp"
+#include "gxf/multimedia/video.hpp"
+
 namespace holoscan::openxr {
 
 struct TransferFunction {
@@ -56,6 +59,12 @@ void XrTransformRenderOp::setup(OperatorSpec& spec) {
              "Configuration file",
              "Configuration file",
              std::string("./configs/ctnv_bb_er.json"));
+  spec.param(convert_depth_,
+             "convert_depth",
+             "Convert Depth",
+             "Convert the linear depth of `depth_buffer_in` to screen space before compositing, "
+             "instead of running a separate ConvertDepthToScreenSpaceOp",
+             false);
 
   render_params_.reset(new Params);
 }
@@ -131,6 +140,21 @@ void XrTransformRenderOp::compute(InputContext& input, OutputContext& output,
     }
   }
 
+  if (convert_depth_.get()) {
+    // runs on the stream the depth is composited on, no extra synchronization needed
+    if (depth_buffer->video_frame_info().color_format !=
+        nvidia::gxf::VideoFormat::GXF_VIDEO_FORMAT_GRAY32F) {
+      throw std::runtime_error("Unsupported depth buffer format");
+    }
+    convertDepthToScreenSpace(cuda_stream_,
+                              reinterpret_cast<float*>(depth_buffer->pointer()),
+                              depth_buffer->video_frame_info().color_planes[0].stride,
+                              depth_buffer->video_frame_info().width,
+                              depth_buffer->video_frame_info().height,
+                              depth_range->x,
+                              depth_range->y);
+  }
+
   viz::SetCurrent(instance_);
 
   viz::Begin();
@@ -45,6 +45,7 @@ class XrTransformRenderOp : public Operator {
   Parameter<std::string> config_file_;
   Parameter<uint32_t> display_width_;
   Parameter<uint32_t> display_height_;
+  Parameter<bool> convert_depth_;
 
   UxBoundingBoxRenderer ui_box_renderer_;
   UxWindowRenderer ui_window_renderer_;
@@ -143,6 +143,17 @@ UxBoundingBoxController::UxBoundingBoxController(UxBoundingBox& boundingBox)
   corners_.push_back(Corner(P, P, P, box_.corners[5]));
   corners_.push_back(Corner(P, P, N, box_.corners[6]));
   corners_.push_back(Corner(N, P, N, box_.corners[7]));
+
+  corner_signs_.resize(3, corners_.size());
+  for (int i = 0; i < corners_.size(); i++) {
+    corner_signs_.col(i) << corners_[i].sign_x, corners_[i].sign_y, corners_[i].sign_z;
+  }
+  edge_p0_signs_.resize(3, edges_.size());
+  edge_p1_signs_.resize(3, edges_.size());
+  for (int i = 0; i < edges_.size(); i++) {
+    edge_p0_signs_.col(i) << edges_[i].p0_x, edges_[i].p0_y, edges_[i].p0_z;
+    edge_p1_signs_.col(i) << edges_[i].p1_x, edges_[i].p1_y, edges_[i].p1_z;
+  }
 }
 
 void UxBoundingBoxController::reset() {
@@ -222,15 +233,17 @@ void UxBoundingBoxController::cursorMove(Eigen::Affine3f pose) {
         widget_ = -1;
 
         // prescendence 1
+        test_corners(current_cursor, ranges_);
         for (int i = 0; i < corners_.size(); i++) {
-          float range = test_corner(current_cursor, corners_[i]);
+          float range = ranges_[i];
           RECORD_RANGE(range, DRAG_CORNER)
         }
 
         if (pending_range == 0.0f) {
           // prescendence 2
+          test_edges(current_cursor, ranges_);
           for (int i = 0; i < edges_.size(); i++) {
-            float range = test_edge(current_cursor, edges_[i]);
+            float range = ranges_[i];
             RECORD_RANGE(range, DRAG_EDGE)
           }
 
@@ -341,33 +354,36 @@ void UxBoundingBoxController::cursorRelease() {
   box_.state = holoscan::openxr::INACTIVE;
 }
 
-float UxBoundingBoxController::test_edge(Eigen::Vector3f& cursor, Edge& edge) {
-  // find distance from cursor to line
-  Eigen::Vector3f p0(edge.p0_x * box_.half_extent[0],
-                     edge.p0_y * box_.half_extent[1],
-                     edge.p0_z * box_.half_extent[2]);
-  Eigen::Vector3f p1(edge.p1_x * box_.half_extent[0],
-                     edge.p1_y * box_.half_extent[1],
-                     edge.p1_z * box_.half_extent[2]);
-
-  Eigen::Vector3f v0 = cursor - p0;
-  Eigen::Vector3f v1 = cursor - p1;
-  Eigen::Vector3f segment = p1 - p0;
-  float segment_length = segment.norm();
-  float distance = v0.cross(v1).norm() / segment_length;
-
-  float activation_distance = BOX_MIN_EXTENT;  //
-
-  if (distance < activation_distance) {
+void UxBoundingBoxController::test_edges(const Eigen::Vector3f& cursor, Eigen::ArrayXf& ranges) {
+  // distance from cursor to the line of every edge, columns are edges
+  const Eigen::Matrix3Xf p0 = box_.half_extent.asDiagonal() * edge_p0_signs_;
+  const Eigen::Matrix3Xf p1 = box_.half_extent.asDiagonal() * edge_p1_signs_;
+  const Eigen::Matrix3Xf v0 = (-p0).colwise() + cursor;
+  const Eigen::Matrix3Xf segment = p1 - p0;
+
+  // |v0 x v1| = |v0 x segment| since v1 = v0 - segment
+  Eigen::Matrix3Xf cross(3, segment.cols());
+  cross.row(0) = v0.row(1).cwiseProduct(segment.row(2)) - v0.row(2).cwiseProduct(segment.row(1));
+  cross.row(1) = v0.row(2).cwiseProduct(segment.row(0)) - v0.row(0).cwiseProduct(segment.row(2));
+  cross.row(2) = v0.row(0).cwiseProduct(segment.row(1)) - v0.row(1).cwiseProduct(segment.row(0));
+
+  const Eigen::ArrayXf segment_length = segment.colwise().norm().transpose().array();
+  const Eigen::ArrayXf distance = cross.colwise().norm().transpose().array() / segment_length;
+  // projection of the cursor on the edge
+  const Eigen::ArrayXf d =
+      v0.cwiseProduct(segment).colwise().sum().transpose().array() / segment_length;
+
+  const float activation_distance = BOX_MIN_EXTENT;
+  ranges.resize(edges_.size());
+  for (int i = 0; i < edges_.size(); i++) {
+    ranges[i] = 0;
     // test if projected point is on the edge
-    Eigen::Vector3f n = segment / segment_length;
-    float d = n.dot(v0);
-    if (d > activation_distance / 2 && d < segment_length - activation_distance / 2) {
-      edge.state.projection = d / segment_length;
-      return 1.0f - clamp(distance / activation_distance, 0, 1);
+    if (distance[i] < activation_distance && d[i] > activation_distance / 2 &&
+        d[i] < segment_length[i] - activation_distance / 2) {
+      edges_[i].state.projection = d[i] / segment_length[i];
+      ranges[i] = 1.0f - clamp(distance[i] / activation_distance, 0, 1);
     }
   }
-  return 0;
 }
 
 void UxBoundingBoxController::drag_edge(Eigen::Vector3f& cursor, Edge& edge) {
@@ -449,15 +465,14 @@ void UxBoundingBoxController::drag_face(Eigen::Vector3f& cursor, Face& face) {
   box_.global_transform.translation() = T - dT;
 }
 
-float UxBoundingBoxController::test_corner(Eigen::Vector3f& cursor, Corner& corner) {
-  // find distance from cursor to corner
-  Eigen::Vector3f p0(corner.sign_x * box_.half_extent[0],
-                     corner.sign_y * box_.half_extent[1],
-                     corner.sign_z * box_.half_extent[2]);
-  float distance = (cursor - p0).norm();
-  float activation_distance = BOX_MIN_EXTENT;
+void UxBoundingBoxController::test_corners(const Eigen::Vector3f& cursor,
+                                           Eigen::ArrayXf& ranges) {
+  // find distance from cursor to every corner, columns are corners
+  const Eigen::Matrix3Xf p0 = box_.half_extent.asDiagonal() * corner_signs_;
+  const Eigen::ArrayXf distance = (p0.colwise() - cursor).colwise().norm().transpose().array();
+  const float activation_distance = BOX_MIN_EXTENT;
 
-  return 1.0f - clamp(distance / activation_distance, 0, 1);
+  ranges = 1.0f - (distance / activation_distance).min(1.0f).max(0.0f);
 }
 
 void UxBoundingBoxController::drag_corner(Eigen::Vector3f& cursor, Corner& corner) {
@@ -70,7 +70,8 @@ class UxBoundingBoxController {
     UxEdge& state;
   };
   std::vector<Edge> edges_;
-  float test_edge(Eigen::Vector3f& cursor, Edge& edge);
+  // activation range of every edge, evaluated in one batch
+  void test_edges(const Eigen::Vector3f& cursor, Eigen::ArrayXf& ranges);
   void drag_edge(Eigen::Vector3f& cursor, Edge& edge);
 
   // Faces
@@ -100,7 +101,14 @@ class UxBoundingBoxController {
     UxCorner& state;
   };
   std::vector<Corner> corners_;
-  float test_corner(Eigen::Vector3f& cursor, Corner& corner);
+  // activation range of every corner, evaluated in one batch
+  void test_corners(const Eigen::Vector3f& cursor, Eigen::ArrayXf& ranges);
+
+  // endpoint signs of the widgets, one column per widget, for the batched tests
+  Eigen::Matrix3Xf corner_signs_;
+  Eigen::Matrix3Xf edge_p0_signs_;
+  Eigen::Matrix3Xf edge_p1_signs_;
+  Eigen::ArrayXf ranges_;
   void drag_corner(Eigen::Vector3f& cursor, Corner& corner);
 
   // control actions
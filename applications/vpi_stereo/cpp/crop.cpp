@@ -34,15 +34,18 @@ void CropOp::setup(OperatorSpec& spec) {
   spec.param(y_, "y", "top left y", "top left y coordinate", 0);
   spec.param(width_, "width", "width", "width", 0);
   spec.param(height_, "height", "height", "height", 0);
+  spec.param(allocator_, "allocator", "Allocator", "Allocator for the cropped output");
+  cuda_stream_handler_.define_params(spec);
 }
 
 void CropOp::compute(InputContext& op_input, OutputContext& op_output, ExecutionContext& context) {
-  auto maybe_tensormap = op_input.receive<holoscan::TensorMap>("input");
-  const auto tensormap = maybe_tensormap.value();
+  auto in_message = op_input.receive<holoscan::gxf::Entity>("input").value();
 
-  if (tensormap.size() != 1) { throw std::runtime_error("Expecting single tensor input"); }
+  if (in_message.findAll<nvidia::gxf::Tensor>()->size() != 1) {
+    throw std::runtime_error("Expecting single tensor input");
+  }
 
-  auto tensor = tensormap.begin()->second;
+  auto tensor = in_message.get<Tensor>();
   int orig_height = tensor->shape()[0];
   int orig_width = tensor->shape()[1];
   int nChannels = tensor->shape()[2];
@@ -63,37 +66,38 @@ void CropOp::compute(InputContext& op_input, OutputContext& op_output, Execution
     throw std::runtime_error("Crop exceeds image boundaries");
   }
 
-  auto pointer = std::shared_ptr<void*>(new void*, [](void** pointer) {
-    if (pointer != nullptr) {
-      if (*pointer != nullptr) { cudaFree(*pointer); }
-      delete pointer;
-    }
-  });
-  cudaMalloc(pointer.get(), width_ * height_ * element_size * nChannels);
-
-  nvidia::gxf::Shape shape = nvidia::gxf::Shape{height_, width_, nChannels};
-  cudaMemcpy2D(*pointer,
-               width_ * element_size * nChannels,
-               static_cast<void*>((char*)tensor->data() + x_ * element_size * nChannels),
-               orig_width * element_size * nChannels,
-               width_ * element_size * nChannels,
-               height_,
-               cudaMemcpyDeviceToDevice);
+  if (cuda_stream_handler_.from_message(context.context(), in_message) != GXF_SUCCESS) {
+    throw std::runtime_error("Failed to get the CUDA stream from incoming messages");
+  }
+  const cudaStream_t cuda_stream = cuda_stream_handler_.get_cuda_stream(context.context());
 
+  auto allocator = nvidia::gxf::Handle<nvidia::gxf::Allocator>::Create(context.context(),
+                                                                         allocator_->gxf_cid());
   auto out_message = nvidia::gxf::Entity::New(context.context());
   auto gxf_tensor = out_message.value().add<nvidia::gxf::Tensor>("");
+  nvidia::gxf::Shape shape = nvidia::gxf::Shape{height_, width_, nChannels};
+  if (!gxf_tensor.value()->reshapeCustom(shape,
+                                         data_type,
+                                         element_size,
+                                         nvidia::gxf::ComputeTrivialStrides(shape, element_size),
+                                         nvidia::gxf::MemoryStorageType::kDevice,
+                                         allocator.value())) {
+    throw std::runtime_error("Failed to allocate output tensor");
+  }
 
-  gxf_tensor.value()->wrapMemory(shape,
-                                 nvidia::gxf::PrimitiveType::kUnsigned8,
-                                 element_size,
-                                 nvidia::gxf::ComputeTrivialStrides(shape, element_size),
-                                 nvidia::gxf::MemoryStorageType::kDevice,
-                                 *pointer,
-                                 [orig_pointer = pointer](void*) mutable {
-                                   orig_pointer.reset();  // decrement ref count
-                                   return nvidia::gxf::Success;
-                                 });
+  const size_t pixel_size = element_size * nChannels;
+  cudaMemcpy2DAsync(gxf_tensor.value()->pointer(),
+                    width_ * pixel_size,
+                    static_cast<char*>(tensor->data()) + (y_ * orig_width + x_) * pixel_size,
+                    orig_width * pixel_size,
+                    width_ * pixel_size,
+                    height_,
+                    cudaMemcpyDeviceToDevice,
+                    cuda_stream);
 
+  if (cuda_stream_handler_.to_message(out_message) != GXF_SUCCESS) {
+    throw std::runtime_error("Failed to add the CUDA stream to the outgoing messages");
+  }
   op_output.emit(out_message.value(), "output");
 }
 
@@ -19,6 +19,7 @@
 #define OPERATORS_CROP
 
 #include <holoscan/holoscan.hpp>
+#include <holoscan/utils/cuda_stream_handler.hpp>
 
 namespace holoscan::ops {
 
@@ -34,6 +35,8 @@ class CropOp : public Operator {
   Parameter<int> y_;
   Parameter<int> width_;
   Parameter<int> height_;
+  Parameter<std::shared_ptr<Allocator>> allocator_;
+  CudaStreamHandler cuda_stream_handler_;
 };
 
 }  // namespace holoscan::ops
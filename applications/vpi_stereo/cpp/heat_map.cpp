@@ -25,16 +25,19 @@ void HeatmapOp::setup(OperatorSpec& spec) {
   spec.output<holoscan::gxf::Entity>("output");
   spec.param(min_disp_, "min_disp", "min_disp", "min_disp", 0.0f);
   spec.param(max_disp_, "max_disp", "max_disp", "max_disp", 255.0f);
+  spec.param(allocator_, "allocator", "Allocator", "Allocator for the output heatmap");
+  cuda_stream_handler_.define_params(spec);
 }
 
 void HeatmapOp::compute(InputContext& op_input, OutputContext& op_output,
                         ExecutionContext& context) {
-  auto maybe_tensormap = op_input.receive<holoscan::TensorMap>("input");
-  const auto tensormap = maybe_tensormap.value();
+  auto in_message = op_input.receive<holoscan::gxf::Entity>("input").value();
 
-  if (tensormap.size() != 1) { throw std::runtime_error("Expecting single tensor input"); }
+  if (in_message.findAll<nvidia::gxf::Tensor>()->size() != 1) {
+    throw std::runtime_error("Expecting single tensor input");
+  }
 
-  auto tensor = tensormap.begin()->second;
+  auto tensor = in_message.get<Tensor>();
   int height = tensor->shape()[0];
   int width = tensor->shape()[1];
   int nChannels = tensor->shape()[2];
@@ -44,39 +47,32 @@ void HeatmapOp::compute(InputContext& op_input, OutputContext& op_output,
     throw std::runtime_error("Expecting grayscale input");
   }
 
-  auto pointer = std::shared_ptr<void*>(new void*, [](void** pointer) {
-    if (pointer != nullptr) {
-      if (*pointer != nullptr) { cudaFree(*pointer); }
-      delete pointer;
-    }
-  });
+  if (cuda_stream_handler_.from_message(context.context(), in_message) != GXF_SUCCESS) {
+    throw std::runtime_error("Failed to get the CUDA stream from incoming messages");
+  }
+  const cudaStream_t cuda_stream = cuda_stream_handler_.get_cuda_stream(context.context());
+
+  auto allocator = nvidia::gxf::Handle<nvidia::gxf::Allocator>::Create(context.context(),
+                                                                         allocator_->gxf_cid());
+  auto out_message = nvidia::gxf::Entity::New(context.context());
+  auto gxf_tensor = out_message.value().add<nvidia::gxf::Tensor>("");
+  nvidia::gxf::Shape shape = nvidia::gxf::Shape{height, width, 3};
+  if (!gxf_tensor.value()->reshape<uint8_t>(
+          shape, nvidia::gxf::MemoryStorageType::kDevice, allocator.value())) {
+    throw std::runtime_error("Failed to allocate output tensor");
+  }
 
-  cudaMalloc(pointer.get(), width * height * 3 * sizeof(uint8_t));
   heatmapF32(static_cast<float*>(tensor->data()),
-             static_cast<uint8_t*>(*pointer),
+             gxf_tensor.value()->data<uint8_t>().value(),
              min_disp_,
              max_disp_,
              width,
              height,
-             0);
-  auto element_type = nvidia::gxf::PrimitiveType::kUnsigned8;
-  int element_size = nvidia::gxf::PrimitiveTypeSize(element_type);
-  nvidia::gxf::Shape shape = nvidia::gxf::Shape{height, width, 3};
-
-  auto out_message = nvidia::gxf::Entity::New(context.context());
-  auto gxf_tensor = out_message.value().add<nvidia::gxf::Tensor>("");
-
-  gxf_tensor.value()->wrapMemory(shape,
-                                 nvidia::gxf::PrimitiveType::kUnsigned8,
-                                 element_size,
-                                 nvidia::gxf::ComputeTrivialStrides(shape, element_size),
-                                 nvidia::gxf::MemoryStorageType::kDevice,
-                                 *pointer,
-                                 [orig_pointer = pointer](void*) mutable {
-                                   orig_pointer.reset();  // decrement ref count
-                                   return nvidia::gxf::Success;
-                                 });
+             cuda_stream);
 
+  if (cuda_stream_handler_.to_message(out_message) != GXF_SUCCESS) {
+    throw std::runtime_error("Failed to add the CUDA stream to the outgoing messages");
+  }
   op_output.emit(out_message.value(), "output");
 }
 
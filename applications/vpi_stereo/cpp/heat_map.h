@@ -19,6 +19,7 @@
 #define OPERATORS_HEATMAP
 
 #include <holoscan/holoscan.hpp>
+#include <holoscan/utils/cuda_stream_handler.hpp>
 
 namespace holoscan::ops {
 
@@ -32,6 +33,8 @@ class HeatmapOp : public Operator {
  private:
   Parameter<float> max_disp_;
   Parameter<float> min_disp_;
+  Parameter<std::shared_ptr<Allocator>> allocator_;
+  CudaStreamHandler cuda_stream_handler_;
 };
 
 }  // namespace holoscan::ops
@@ -77,8 +77,6 @@ class VPIStereoApp : public holoscan::Application {
     auto out_dtype = Arg("out_dtype", std::string("rgb888"));
     auto v4l2_converter = make_operator<ops::FormatConverterOp>(
         "converter", in_dtype, out_dtype, v4l2_converter_pool);
-    auto splitter = make_operator<ops::SplitVideoOp>(
-        "splitter", Arg("stereo_video_layout", STEREO_VIDEO_HORIZONTAL));
 
     // load camera calibration data
     YAML::Node calibration = YAML::LoadFile(stereo_calibration_);
@@ -91,6 +89,22 @@ class VPIStereoApp : public holoscan::Application {
     int width = calibration["width"].as<int>();
     int height = calibration["height"].as<int>();
 
+    // The stereo operators allocate their per-frame outputs from device block pools and run
+    // asynchronously on their own CUDA streams. Each pool holds enough blocks to cover the frames
+    // in flight between an operator and the sink.
+    const uint64_t num_blocks = 4;
+    auto cuda_stream_pool = make_resource<CudaStreamPool>("cuda_stream", 0, 0, 0, 1, 8);
+    const uint64_t rgb_frame_size = width * height * 3;
+    // the VPI stereo operator holds its inputs and outputs until the frames in flight complete
+    const uint64_t pipeline_depth = from_config("vpi_stereo.pipeline_depth").as<int>();
+
+    auto splitter = make_operator<ops::SplitVideoOp>(
+        "splitter",
+        Arg("stereo_video_layout", STEREO_VIDEO_HORIZONTAL),
+        Arg("allocator") =
+            make_resource<BlockMemoryPool>("pool_splitter", 1, rgb_frame_size, 2 * num_blocks),
+        Arg("cuda_stream_pool") = cuda_stream_pool);
+
     // solve transforms for rectification using calibration.
     float R1_float[9];
     float R2_float[9];
@@ -113,35 +127,64 @@ class VPIStereoApp : public holoscan::Application {
                                            Q_float,
                                            roi);
 
-    // generate flow maps from transforms
+    // generate flow maps from transforms, or load them from the cache for this calibration
+    const std::string map_cache_dir = from_config("rectification.cache_dir").as<std::string>();
     auto rectification_map1 = std::make_shared<ops::UndistortRectifyOp::RectificationMap>(
-        &M1[0], &d1[0], R1_float, P1_float, width, height);
+        &M1[0], &d1[0], R1_float, P1_float, width, height, map_cache_dir);
     auto rectification_map2 = std::make_shared<ops::UndistortRectifyOp::RectificationMap>(
-        &M2[0], &d2[0], R2_float, P2_float, width, height);
+        &M2[0], &d2[0], R2_float, P2_float, width, height, map_cache_dir);
 
     // init rectification operators
-    auto rectifier1 = make_operator<ops::UndistortRectifyOp>("rectifier1");
+    auto rectifier1 = make_operator<ops::UndistortRectifyOp>(
+        "rectifier1",
+        Arg("allocator") =
+            make_resource<BlockMemoryPool>(
+                "pool_rectifier1", 1, rgb_frame_size, num_blocks + pipeline_depth),
+        Arg("cuda_stream_pool") = cuda_stream_pool);
     rectifier1->setRectificationMap(rectification_map1);
-    auto rectifier2 = make_operator<ops::UndistortRectifyOp>("rectifier2");
+    auto rectifier2 = make_operator<ops::UndistortRectifyOp>(
+        "rectifier2",
+        Arg("allocator") =
+            make_resource<BlockMemoryPool>(
+                "pool_rectifier2", 1, rgb_frame_size, num_blocks + pipeline_depth),
+        Arg("cuda_stream_pool") = cuda_stream_pool);
     rectifier2->setRectificationMap(rectification_map2);
 
     // adjust frames for display
-    auto crop_color = make_operator<ops::CropOp>("crop_color",
-                                                 Arg("x", roi[0]),
-                                                 Arg("y", roi[1]),
-                                                 Arg("width", roi[2]),
-                                                 Arg("height", roi[3]));
-
-    auto crop_disparity = make_operator<ops::CropOp>("crop_disparity",
-                                                     Arg("x", roi[0]),
-                                                     Arg("y", roi[1]),
-                                                     Arg("width", roi[2]),
-                                                     Arg("height", roi[3]));
-    auto heatmap = make_operator<ops::HeatmapOp>("heatmap", from_config("heatmap"));
+    const uint64_t roi_size = roi[2] * roi[3];
+    auto crop_color = make_operator<ops::CropOp>(
+        "crop_color",
+        Arg("x", roi[0]),
+        Arg("y", roi[1]),
+        Arg("width", roi[2]),
+        Arg("height", roi[3]),
+        Arg("allocator") =
+            make_resource<BlockMemoryPool>("pool_crop_color", 1, roi_size * 3, num_blocks),
+        Arg("cuda_stream_pool") = cuda_stream_pool);
+
+    auto crop_disparity = make_operator<ops::CropOp>(
+        "crop_disparity",
+        Arg("x", roi[0]),
+        Arg("y", roi[1]),
+        Arg("width", roi[2]),
+        Arg("height", roi[3]),
+        Arg("allocator") = make_resource<BlockMemoryPool>(
+            "pool_crop_disparity", 1, roi_size * sizeof(float), num_blocks),
+        Arg("cuda_stream_pool") = cuda_stream_pool);
+    auto heatmap = make_operator<ops::HeatmapOp>(
+        "heatmap",
+        from_config("heatmap"),
+        Arg("allocator") =
+            make_resource<BlockMemoryPool>("pool_heatmap", 1, roi_size * 3, num_blocks),
+        Arg("cuda_stream_pool") = cuda_stream_pool);
 
     // window for viz of left camera + left disparity
     auto merger = make_operator<ops::MergeVideoOp>(
-        "merger", Arg("stereo_video_layout", STEREO_VIDEO_HORIZONTAL));
+        "merger",
+        Arg("stereo_video_layout", STEREO_VIDEO_HORIZONTAL),
+        Arg("allocator") =
+            make_resource<BlockMemoryPool>("pool_merger", 1, roi_size * 3 * 2, num_blocks),
+        Arg("cuda_stream_pool") = cuda_stream_pool);
     auto holoviz = make_operator<ops::HolovizOp>("holoviz", from_config("holoviz"));
 
     // Rectification
@@ -151,7 +194,14 @@ class VPIStereoApp : public holoscan::Application {
     add_flow(splitter, rectifier2, {{"output2", "input"}});
 
     // VPI processing
-    auto vpi_stereo = make_operator<ops::VPIStereoOp>("vpi_stereo", from_config("vpi_stereo"));
+    auto vpi_stereo = make_operator<ops::VPIStereoOp>(
+        "vpi_stereo",
+        from_config("vpi_stereo"),
+        Arg("allocator") = make_resource<BlockMemoryPool>("pool_vpi_stereo",
+                                                          1,
+                                                          width * height * sizeof(float),
+                                                          num_blocks + pipeline_depth),
+        Arg("cuda_stream_pool") = cuda_stream_pool);
 
     // Compute stereo disparity
     add_flow(rectifier1, vpi_stereo, {{"output", "input1"}});
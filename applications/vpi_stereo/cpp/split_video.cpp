@@ -35,16 +35,19 @@ void SplitVideoOp::setup(OperatorSpec& spec) {
              "Stereo Video Layout",
              "Horizontal or Vertical Concatenation of Stereo Video Frames",
              STEREO_VIDEO_HORIZONTAL);
+  spec.param(allocator_, "allocator", "Allocator", "Allocator for the left and right frames");
+  cuda_stream_handler_.define_params(spec);
 }
 
 void SplitVideoOp::compute(InputContext& op_input, OutputContext& op_output,
                            ExecutionContext& context) {
-  auto maybe_tensormap = op_input.receive<holoscan::TensorMap>("input");
-  const auto tensormap = maybe_tensormap.value();
+  auto in_message = op_input.receive<holoscan::gxf::Entity>("input").value();
 
-  if (tensormap.size() != 1) { throw std::runtime_error("Expecting single tensor input"); }
+  if (in_message.findAll<nvidia::gxf::Tensor>()->size() != 1) {
+    throw std::runtime_error("Expecting single tensor input");
+  }
 
-  auto tensor = tensormap.begin()->second;
+  auto tensor = in_message.get<Tensor>();
   int height = tensor->shape()[0];
   int width = tensor->shape()[1];
   int nChannels = tensor->shape()[2];
@@ -52,85 +55,74 @@ void SplitVideoOp::compute(InputContext& op_input, OutputContext& op_output,
   nvidia::gxf::Tensor tensor_gxf(tensor->dl_ctx());
   nvidia::gxf::PrimitiveType data_type = tensor_gxf.element_type();
   int element_size = nvidia::gxf::PrimitiveTypeSize(data_type);
-  auto pointer1 = std::shared_ptr<void*>(new void*, [](void** pointer1) {
-    if (pointer1 != nullptr) {
-      if (*pointer1 != nullptr) { cudaFree(*pointer1); }
-      delete pointer1;
-    }
-  });
-
-  auto pointer2 = std::shared_ptr<void*>(new void*, [](void** pointer2) {
-    if (pointer2 != nullptr) {
-      if (*pointer2 != nullptr) { cudaFree(*pointer2); }
-      delete pointer2;
-    }
-  });
-
-  cudaMalloc(pointer1.get(), width * height * element_size * nChannels / 2);
-  cudaMalloc(pointer2.get(), width * height * element_size * nChannels / 2);
+  const size_t pixel_size = element_size * nChannels;
 
   nvidia::gxf::Shape shape;
   if (stereo_video_layout_.get() == STEREO_VIDEO_VERTICAL) {
-    cudaMemcpy(*pointer1,
-               static_cast<void*>(tensor->data()),
-               width * (height / 2) * element_size * nChannels,
-               cudaMemcpyDeviceToDevice);
-    cudaMemcpy(
-        *pointer2,
-        static_cast<void*>((char*)tensor->data() + width * (height / 2) * element_size * nChannels),
-        width * (height / 2) * element_size * nChannels,
-        cudaMemcpyDeviceToDevice);
     shape = nvidia::gxf::Shape{height / 2, width, nChannels};
   } else if (stereo_video_layout_.get() == STEREO_VIDEO_HORIZONTAL) {
-    cudaMemcpy2D(*pointer1,
-                 (width / 2) * element_size * nChannels,
-                 static_cast<void*>(tensor->data()),
-                 width * element_size * nChannels,
-                 (width / 2) * element_size * nChannels,
-                 height,
-                 cudaMemcpyDeviceToDevice);
-    cudaMemcpy2D(*pointer2,
-                 (width / 2) * element_size * nChannels,
-                 static_cast<void*>((char*)tensor->data() + (width / 2) * element_size * nChannels),
-                 width * element_size * nChannels,
-                 (width / 2) * element_size * nChannels,
-                 height,
-                 cudaMemcpyDeviceToDevice);
     shape = nvidia::gxf::Shape{height, width / 2, nChannels};
   } else {
     throw std::runtime_error("UNKNOWN OUTPUT FORMAT");
   }
 
+  if (cuda_stream_handler_.from_message(context.context(), in_message) != GXF_SUCCESS) {
+    throw std::runtime_error("Failed to get the CUDA stream from incoming messages");
+  }
+  const cudaStream_t cuda_stream = cuda_stream_handler_.get_cuda_stream(context.context());
+
+  auto allocator = nvidia::gxf::Handle<nvidia::gxf::Allocator>::Create(context.context(),
+                                                                         allocator_->gxf_cid());
   auto out_message1 = nvidia::gxf::Entity::New(context.context());
   auto gxf_tensor1 = out_message1.value().add<nvidia::gxf::Tensor>("");
-
-  gxf_tensor1.value()->wrapMemory(shape,
-                                  data_type,
-                                  element_size,
-                                  nvidia::gxf::ComputeTrivialStrides(shape, element_size),
-                                  nvidia::gxf::MemoryStorageType::kDevice,
-                                  *pointer1,
-                                  [orig_pointer = pointer1](void*) mutable {
-                                    orig_pointer.reset();  // decrement ref count
-                                    return nvidia::gxf::Success;
-                                  });
-
-  op_output.emit(out_message1.value(), "output1");
-
   auto out_message2 = nvidia::gxf::Entity::New(context.context());
   auto gxf_tensor2 = out_message2.value().add<nvidia::gxf::Tensor>("");
-  gxf_tensor2.value()->wrapMemory(shape,
-                                  data_type,
-                                  element_size,
-                                  nvidia::gxf::ComputeTrivialStrides(shape, element_size),
-                                  nvidia::gxf::MemoryStorageType::kDevice,
-                                  *pointer2,
-                                  [orig_pointer = pointer2](void*) mutable {
-                                    orig_pointer.reset();  // decrement ref count
-
-                                    return nvidia::gxf::Success;
-                                  });
+  for (const auto& gxf_tensor : {gxf_tensor1.value(), gxf_tensor2.value()}) {
+    if (!gxf_tensor->reshapeCustom(shape,
+                                   data_type,
+                                   element_size,
+                                   nvidia::gxf::ComputeTrivialStrides(shape, element_size),
+                                   nvidia::gxf::MemoryStorageType::kDevice,
+                                   allocator.value())) {
+      throw std::runtime_error("Failed to allocate output tensor");
+    }
+  }
+
+  const char* src = static_cast<const char*>(tensor->data());
+  if (stereo_video_layout_.get() == STEREO_VIDEO_VERTICAL) {
+    const size_t half_size = width * (height / 2) * pixel_size;
+    cudaMemcpyAsync(
+        gxf_tensor1.value()->pointer(), src, half_size, cudaMemcpyDeviceToDevice, cuda_stream);
+    cudaMemcpyAsync(gxf_tensor2.value()->pointer(),
+                    src + half_size,
+                    half_size,
+                    cudaMemcpyDeviceToDevice,
+                    cuda_stream);
+  } else {
+    const size_t half_pitch = (width / 2) * pixel_size;
+    cudaMemcpy2DAsync(gxf_tensor1.value()->pointer(),
+                      half_pitch,
+                      src,
+                      width * pixel_size,
+                      half_pitch,
+                      height,
+                      cudaMemcpyDeviceToDevice,
+                      cuda_stream);
+    cudaMemcpy2DAsync(gxf_tensor2.value()->pointer(),
+                      half_pitch,
+                      src + half_pitch,
+                      width * pixel_size,
+                      half_pitch,
+                      height,
+                      cudaMemcpyDeviceToDevice,
+                      cuda_stream);
+  }
 
+  if (cuda_stream_handler_.to_message(out_message1) != GXF_SUCCESS ||
+      cuda_stream_handler_.to_message(out_message2) != GXF_SUCCESS) {
+    throw std::runtime_error("Failed to add the CUDA stream to the outgoing messages");
+  }
+  op_output.emit(out_message1.value(), "output1");
   op_output.emit(out_message2.value(), "output2");
 }
 
@@ -143,22 +135,22 @@ void MergeVideoOp::setup(OperatorSpec& spec) {
              "Stereo Video Layout",
              "Horizontal or Vertical Concatenation of Stereo Video Frames",
              STEREO_VIDEO_HORIZONTAL);
+  spec.param(allocator_, "allocator", "Allocator", "Allocator for the merged frame");
+  cuda_stream_handler_.define_params(spec);
 }
 
 void MergeVideoOp::compute(InputContext& op_input, OutputContext& op_output,
                            ExecutionContext& context) {
-  auto maybe_tensormap1 = op_input.receive<holoscan::TensorMap>("input1");
-  const auto tensormap1 = maybe_tensormap1.value();
-
-  auto maybe_tensormap2 = op_input.receive<holoscan::TensorMap>("input2");
-  const auto tensormap2 = maybe_tensormap2.value();
+  auto in_message1 = op_input.receive<holoscan::gxf::Entity>("input1").value();
+  auto in_message2 = op_input.receive<holoscan::gxf::Entity>("input2").value();
 
-  if ((tensormap1.size() != 1) || (tensormap2.size() != 1)) {
+  if ((in_message1.findAll<nvidia::gxf::Tensor>()->size() != 1) ||
+      (in_message2.findAll<nvidia::gxf::Tensor>()->size() != 1)) {
     throw std::runtime_error("Expecting single tensor input");
   }
 
-  auto tensor1 = tensormap1.begin()->second;
-  auto tensor2 = tensormap2.begin()->second;
+  auto tensor1 = in_message1.get<Tensor>();
+  auto tensor2 = in_message2.get<Tensor>();
 
   int height = tensor1->shape()[0];
   int width = tensor1->shape()[1];
@@ -176,62 +168,65 @@ void MergeVideoOp::compute(InputContext& op_input, OutputContext& op_output,
   nvidia::gxf::Tensor tensor_gxf(tensor1->dl_ctx());
   nvidia::gxf::PrimitiveType data_type = tensor_gxf.element_type();
   int element_size = nvidia::gxf::PrimitiveTypeSize(data_type);
-
-  auto pointer = std::shared_ptr<void*>(new void*, [](void** pointer) {
-    if (pointer != nullptr) {
-      if (*pointer != nullptr) { cudaFree(*pointer); }
-      delete pointer;
-    }
-  });
-  cudaMalloc(pointer.get(), width * height * element_size * nChannels * 2);
+  const size_t pixel_size = element_size * nChannels;
 
   nvidia::gxf::Shape shape;
   if (stereo_video_layout_.get() == STEREO_VIDEO_VERTICAL) {
-    cudaMemcpy(*pointer,
-               static_cast<void*>(tensor1->data()),
-               width * height * element_size * nChannels,
-               cudaMemcpyDeviceToDevice);
-    cudaMemcpy(static_cast<void*>(static_cast<char*>(*pointer) +
-                                  width * height * element_size * nChannels),
-               static_cast<void*>(tensor2->data()),
-               width * height * element_size * nChannels,
-               cudaMemcpyDeviceToDevice);
     shape = nvidia::gxf::Shape{height * 2, width, nChannels};
   } else if (stereo_video_layout_.get() == STEREO_VIDEO_HORIZONTAL) {
-    cudaMemcpy2D(*pointer,
-                 width * 2 * element_size * nChannels,
-                 static_cast<void*>(tensor1->data()),
-                 width * element_size * nChannels,
-                 width * element_size * nChannels,
-                 height,
-                 cudaMemcpyDeviceToDevice);
-    cudaMemcpy2D(
-        static_cast<void*>(static_cast<char*>(*pointer) + width * element_size * nChannels),
-        width * 2 * element_size * nChannels,
-        static_cast<void*>(tensor2->data()),
-        width * element_size * nChannels,
-        width * element_size * nChannels,
-        height,
-        cudaMemcpyDeviceToDevice);
     shape = nvidia::gxf::Shape{height, width * 2, nChannels};
   } else {
     throw std::runtime_error("UNKNOWN OUTPUT FORMAT");
   }
 
+  if (cuda_stream_handler_.from_messages(context.context(), {in_message1, in_message2}) !=
+      GXF_SUCCESS) {
+    throw std::runtime_error("Failed to get the CUDA stream from incoming messages");
+  }
+  const cudaStream_t cuda_stream = cuda_stream_handler_.get_cuda_stream(context.context());
+
+  auto allocator = nvidia::gxf::Handle<nvidia::gxf::Allocator>::Create(context.context(),
+                                                                         allocator_->gxf_cid());
   auto out_message = nvidia::gxf::Entity::New(context.context());
   auto gxf_tensor = out_message.value().add<nvidia::gxf::Tensor>("");
+  if (!gxf_tensor.value()->reshapeCustom(shape,
+                                         data_type,
+                                         element_size,
+                                         nvidia::gxf::ComputeTrivialStrides(shape, element_size),
+                                         nvidia::gxf::MemoryStorageType::kDevice,
+                                         allocator.value())) {
+    throw std::runtime_error("Failed to allocate output tensor");
+  }
 
-  gxf_tensor.value()->wrapMemory(shape,
-                                 data_type,
-                                 element_size,
-                                 nvidia::gxf::ComputeTrivialStrides(shape, element_size),
-                                 nvidia::gxf::MemoryStorageType::kDevice,
-                                 *pointer,
-                                 [orig_pointer = pointer](void*) mutable {
-                                   orig_pointer.reset();  // decrement ref count
-                                   return nvidia::gxf::Success;
-                                 });
+  char* dst = static_cast<char*>(gxf_tensor.value()->pointer());
+  if (stereo_video_layout_.get() == STEREO_VIDEO_VERTICAL) {
+    const size_t frame_size = width * height * pixel_size;
+    cudaMemcpyAsync(dst, tensor1->data(), frame_size, cudaMemcpyDeviceToDevice, cuda_stream);
+    cudaMemcpyAsync(
+        dst + frame_size, tensor2->data(), frame_size, cudaMemcpyDeviceToDevice, cuda_stream);
+  } else {
+    const size_t pitch = width * pixel_size;
+    cudaMemcpy2DAsync(dst,
+                      pitch * 2,
+                      tensor1->data(),
+                      pitch,
+                      pitch,
+                      height,
+                      cudaMemcpyDeviceToDevice,
+                      cuda_stream);
+    cudaMemcpy2DAsync(dst + pitch,
+                      pitch * 2,
+                      tensor2->data(),
+                      pitch,
+                      pitch,
+                      height,
+                      cudaMemcpyDeviceToDevice,
+                      cuda_stream);
+  }
 
+  if (cuda_stream_handler_.to_message(out_message) != GXF_SUCCESS) {
+    throw std::runtime_error("Failed to add the CUDA stream to the outgoing messages");
+  }
   op_output.emit(out_message.value(), "output");
 }
 }  // namespace holoscan::ops
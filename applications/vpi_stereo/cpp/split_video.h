@@ -19,6 +19,7 @@
 #define OPERATORS_SPLIT_VIDEO
 
 #include <holoscan/holoscan.hpp>
+#include <holoscan/utils/cuda_stream_handler.hpp>
 
 namespace holoscan::ops {
 #define STEREO_VIDEO_HORIZONTAL 0
@@ -33,6 +34,8 @@ class SplitVideoOp : public Operator {
 
  private:
   Parameter<int> stereo_video_layout_;
+  Parameter<std::shared_ptr<Allocator>> allocator_;
+  CudaStreamHandler cuda_stream_handler_;
 };
 
 class MergeVideoOp : public Operator {
@@ -44,6 +47,8 @@ class MergeVideoOp : public Operator {
 
  private:
   Parameter<int> stereo_video_layout_;
+  Parameter<std::shared_ptr<Allocator>> allocator_;
+  CudaStreamHandler cuda_stream_handler_;
 };
 }  // namespace holoscan::ops
 #endif
@@ -19,11 +19,15 @@
 #include <iostream>
 #include "stereo_depth_kernels.h"
 
-__global__ void makeRectificationMapKernel(float* M, float* d, float* R, float* P, float* mapx,
-                                           float* mapy, uint32_t width, uint32_t height) {
+__global__ void makeRectificationMapKernel(RectificationParams params, __half2* map,
+                                           uint32_t width, uint32_t height) {
   uint32_t u = blockIdx.x * blockDim.x + threadIdx.x;
   uint32_t v = blockIdx.y * blockDim.y + threadIdx.y;
   if (u < width & v < height) {
+    const float* M = params.M;
+    const float* d = params.d;
+    const float* R = params.R;
+    const float* P = params.P;
     float x = (static_cast<float>(u) - P[2]) / P[0];
     float y = (static_cast<float>(v) - P[6]) / P[5];
     float z2 = R[2] * x + R[5] * y + R[8];
@@ -35,18 +39,67 @@ __global__ void makeRectificationMapKernel(float* M, float* d, float* R, float*
     float u3 = rad * u2 + 2 * d[2] * xy + d[3] * (r2 + 2 * (u2 * u2));
     float v3 = rad * v2 + d[2] * (r2 + 2 * v2 * v2) + 2 * d[3] * xy;
     size_t tid = (u + v * width);
-    mapx[tid] = M[0] * u3 + M[2];
-    mapy[tid] = M[4] * v3 + M[5];
+    map[tid] = __floats2half2_rn(M[0] * u3 + M[2] - static_cast<float>(u),
+                                 M[4] * v3 + M[5] - static_cast<float>(v));
   }
 }
 
-void makeRectificationMap(float* M, float* d, float* R, float* P, float* mapx, float* mapy,
-                          uint32_t width, uint32_t height, cudaStream_t stream) {
+void makeRectificationMap(const RectificationParams& params, __half2* map, uint32_t width,
+                          uint32_t height, cudaStream_t stream) {
   const dim3 block_dim(32, 32);
   const dim3 launch_grid((width + (block_dim.x - 1)) / block_dim.x,
                          (height + (block_dim.y - 1)) / block_dim.y);
-  makeRectificationMapKernel<<<launch_grid, block_dim, 0, stream>>>(
-      M, d, R, P, mapx, mapy, width, height);
+  makeRectificationMapKernel<<<launch_grid, block_dim, 0, stream>>>(params, map, width, height);
+}
+
+template <int C>
+__global__ void remapBilinearKernel(const uint8_t* input, uint32_t input_pitch,
+                                    const __half2* map, uint8_t* output, uint32_t output_pitch,
+                                    uint32_t width, uint32_t height) {
+  uint32_t u = blockIdx.x * blockDim.x + threadIdx.x;
+  uint32_t v = blockIdx.y * blockDim.y + threadIdx.y;
+  if (u >= width | v >= height) { return; }
+
+  const float2 delta = __half22float2(map[u + v * width]);
+  const float sx = static_cast<float>(u) + delta.x;
+  const float sy = static_cast<float>(v) + delta.y;
+  uint8_t* dst = output + v * output_pitch + u * C;
+  if (!(sx >= 0.0f && sy >= 0.0f && sx <= width - 1 && sy <= height - 1)) {
+#pragma unroll
+    for (int c = 0; c < C; c++) { dst[c] = 0; }
+    return;
+  }
+
+  const int x0 = min(static_cast<int>(sx), static_cast<int>(width) - 2);
+  const int y0 = min(static_cast<int>(sy), static_cast<int>(height) - 2);
+  const float fx = sx - x0;
+  const float fy = sy - y0;
+  const uint8_t* p00 = input + y0 * input_pitch + x0 * C;
+  const uint8_t* p10 = p00 + input_pitch;
+#pragma unroll
+  for (int c = 0; c < C; c++) {
+    const float top = p00[c] + fx * (p00[c + C] - p00[c]);
+    const float bottom = p10[c] + fx * (p10[c + C] - p10[c]);
+    dst[c] = static_cast<uint8_t>(top + fy * (bottom - top) + 0.5f);
+  }
+}
+
+void remapBilinear(const uint8_t* input, uint32_t input_pitch, const __half2* map,
+                   uint8_t* output, uint32_t output_pitch, uint32_t width, uint32_t height,
+                   uint32_t channels, cudaStream_t stream) {
+  const dim3 block_dim(32, 8);
+  const dim3 launch_grid((width + (block_dim.x - 1)) / block_dim.x,
+                         (height + (block_dim.y - 1)) / block_dim.y);
+  if (channels == 1) {
+    remapBilinearKernel<1><<<launch_grid, block_dim, 0, stream>>>(
+        input, input_pitch, map, output, output_pitch, width, height);
+  } else if (channels == 3) {
+    remapBilinearKernel<3><<<launch_grid, block_dim, 0, stream>>>(
+        input, input_pitch, map, output, output_pitch, width, height);
+  } else {
+    remapBilinearKernel<4><<<launch_grid, block_dim, 0, stream>>>(
+        input, input_pitch, map, output, output_pitch, width, height);
+  }
 }
 
 __global__ void heatmapF32Kernel(float* grayscale, uint8_t* rgb, float min_val, float inv_window,
@@ -19,9 +19,28 @@
 #define STEREO_DEPTH_KERNELS_HPP
 
 #include <cuda.h>
+#include <cuda_fp16.h>
 
-void makeRectificationMap(float* M, float* d, float* R, float* P, float* mapx, float* mapy,
-                          uint32_t width, uint32_t height, cudaStream_t stream);
+// Camera matrix, distortion, rectification rotation and projection of one eye, passed to the
+// map kernel by value so no device allocation or upload is needed
+struct RectificationParams {
+  float M[9];
+  float d[5];
+  float R[9];
+  float P[12];
+};
+
+// Builds the remap table as per-pixel half precision displacements (source - destination pixel
+// position). Storing the displacement rather than the absolute coordinate keeps sub-pixel
+// accuracy in fp16 and halves the table compared to two float maps.
+void makeRectificationMap(const RectificationParams& params, __half2* map, uint32_t width,
+                          uint32_t height, cudaStream_t stream);
+
+// Bilinear remap of an interleaved 8-bit image with 1, 3 or 4 channels through a displacement
+// table from makeRectificationMap. Pixels sampling outside the input are set to zero.
+void remapBilinear(const uint8_t* input, uint32_t input_pitch, const __half2* map,
+                   uint8_t* output, uint32_t output_pitch, uint32_t width, uint32_t height,
+                   uint32_t channels, cudaStream_t stream);
 
 void heatmapF32(float* grayscale, uint8_t* rgb, float min_val, float max_val, uint32_t width,
                 uint32_t height, cudaStream_t stream);
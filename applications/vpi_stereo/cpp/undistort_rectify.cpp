@@ -17,45 +17,148 @@
 
 #include "undistort_rectify.h"
 #include <math.h>
-#include <npp.h>
 #include <Eigen/Dense>
 #include <Eigen/Geometry>
-#include "stereo_depth_kernels.h"
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
 
 namespace holoscan::ops {
 
 // Rectification Maps Data Structure
+namespace {
+
+// Bump when the layout of the cached tables changes
+constexpr uint64_t kMapCacheVersion = 1;
+
+void cudaCheck(cudaError_t err, const char* what) {
+  if (err != cudaSuccess) {
+    throw std::runtime_error(std::string(what) + " failed: " + cudaGetErrorString(err));
+  }
+}
+
+RectificationParams makeParams(const float* M, const float* d, const float* R, const float* P) {
+  RectificationParams params;
+  std::copy(M, M + 9, params.M);
+  std::copy(d, d + 5, params.d);
+  std::copy(R, R + 9, params.R);
+  std::copy(P, P + 12, params.P);
+  return params;
+}
+
+// FNV-1a
+uint64_t hashBytes(const void* data, size_t size, uint64_t hash = 14695981039346656037ull) {
+  const uint8_t* bytes = static_cast<const uint8_t*>(data);
+  for (size_t i = 0; i < size; i++) { hash = (hash ^ bytes[i]) * 1099511628211ull; }
+  return hash;
+}
+
+}  // namespace
+
+UndistortRectifyOp::RectificationMap::Map::Map(int width, int height)
+    : width(width), height(height) {
+  cudaCheck(cudaMalloc(reinterpret_cast<void**>(&data), sizeof(__half2) * width * height),
+            "cudaMalloc");
+}
+
+// cudaFree synchronizes the device, so remaps still reading a replaced table finish first
+UndistortRectifyOp::RectificationMap::Map::~Map() {
+  cudaFree(data);
+}
+
 UndistortRectifyOp::RectificationMap::RectificationMap(float* M, float* d, float* R, float* P,
-                                                       int width, int height) {
-  setParameters(M, d, R, P, width, height);
+                                                       int width, int height,
+                                                       const std::string& cache_dir) {
+  setParameters(M, d, R, P, width, height, cache_dir);
 }
 UndistortRectifyOp::RectificationMap::~RectificationMap() {
-  cudaFree(mapx_);
-  cudaFree(mapy_);
+  std::atomic_store(&map_, std::shared_ptr<const Map>());
+  if (stream_ != nullptr) { cudaStreamDestroy(stream_); }
 }
 void UndistortRectifyOp::RectificationMap::setParameters(float* M, float* d, float* R, float* P,
-                                                         int width, int height) {
-  if (mapx_ != NULL) { cudaFree(mapx_); }
-  if (mapy_ != NULL) { cudaFree(mapy_); }
-  cudaMalloc((void**)&mapx_, height * width * sizeof(float));
-  cudaMalloc((void**)&mapy_, height * width * sizeof(float));
-  float *d_M, *d_d, *d_R, *d_P;
-  cudaMalloc((void**)&d_M, 9 * sizeof(float));
-  cudaMalloc((void**)&d_d, 5 * sizeof(float));
-  cudaMalloc((void**)&d_R, 9 * sizeof(float));
-  cudaMalloc((void**)&d_P, 12 * sizeof(float));
-  cudaMemcpy(d_M, M, 9 * sizeof(float), cudaMemcpyHostToDevice);
-  cudaMemcpy(d_d, d, 5 * sizeof(float), cudaMemcpyHostToDevice);
-  cudaMemcpy(d_R, R, 9 * sizeof(float), cudaMemcpyHostToDevice);
-  cudaMemcpy(d_P, P, 12 * sizeof(float), cudaMemcpyHostToDevice);
-  makeRectificationMap(d_M, d_d, d_R, d_P, mapx_, mapy_, width, height, 0);
-  cudaFree(d_M);
-  cudaFree(d_d);
-  cudaFree(d_R);
-  cudaFree(d_P);
-
-  width_ = width;
-  height_ = height;
+                                                         int width, int height,
+                                                         const std::string& cache_dir) {
+  {
+    std::lock_guard<std::mutex> lock(build_mutex_);
+    width_ = width;
+    height_ = height;
+    cache_dir_ = cache_dir;
+  }
+  recalibrate(M, d, R, P);
+}
+
+void UndistortRectifyOp::RectificationMap::recalibrate(float* M, float* d, float* R, float* P) {
+  auto map = build(makeParams(M, d, R, P));
+  std::atomic_store(&map_, map);
+}
+
+std::string UndistortRectifyOp::RectificationMap::cachePath(
+    const RectificationParams& params) const {
+  if (cache_dir_.empty()) { return ""; }
+  const int dims[2] = {width_, height_};
+  uint64_t hash = hashBytes(&kMapCacheVersion, sizeof(kMapCacheVersion));
+  hash = hashBytes(&params, sizeof(params), hash);
+  hash = hashBytes(dims, sizeof(dims), hash);
+  char name[64];
+  snprintf(name, sizeof(name), "rectification_%016llx.bin", static_cast<unsigned long long>(hash));
+  return (std::filesystem::path(cache_dir_) / name).string();
+}
+
+std::shared_ptr<const UndistortRectifyOp::RectificationMap::Map>
+UndistortRectifyOp::RectificationMap::build(const RectificationParams& params) {
+  std::lock_guard<std::mutex> lock(build_mutex_);
+  if (stream_ == nullptr) {
+    // Side stream, so rebuilding does not serialize with the remaps of frames in flight
+    cudaCheck(cudaStreamCreateWithFlags(&stream_, cudaStreamNonBlocking), "cudaStreamCreate");
+  }
+
+  auto map = std::make_shared<Map>(width_, height_);
+  const size_t size = sizeof(__half2) * width_ * height_;
+  const std::string path = cachePath(params);
+  std::vector<char> host;
+
+  if (!path.empty()) {
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    if (file && static_cast<size_t>(file.tellg()) == size) {
+      host.resize(size);
+      file.seekg(0);
+      if (file.read(host.data(), size)) {
+        cudaCheck(cudaMemcpyAsync(map->data, host.data(), size, cudaMemcpyHostToDevice, stream_),
+                  "cudaMemcpyAsync");
+        cudaCheck(cudaStreamSynchronize(stream_), "cudaStreamSynchronize");
+        HOLOSCAN_LOG_INFO("Loaded rectification map from {}", path);
+        return map;
+      }
+    }
+  }
+
+  makeRectificationMap(params, map->data, width_, height_, stream_);
+  cudaCheck(cudaGetLastError(), "makeRectificationMap");
+  if (path.empty()) {
+    cudaCheck(cudaStreamSynchronize(stream_), "cudaStreamSynchronize");
+    return map;
+  }
+
+  host.resize(size);
+  cudaCheck(cudaMemcpyAsync(host.data(), map->data, size, cudaMemcpyDeviceToHost, stream_),
+            "cudaMemcpyAsync");
+  cudaCheck(cudaStreamSynchronize(stream_), "cudaStreamSynchronize");
+
+  // Write to a temporary file first so an interrupted write never leaves a truncated table
+  std::error_code ec;
+  std::filesystem::create_directories(cache_dir_, ec);
+  const std::string tmp_path = path + ".tmp";
+  {
+    std::ofstream file(tmp_path, std::ios::binary | std::ios::trunc);
+    file.write(host.data(), size);
+    if (!file) {
+      HOLOSCAN_LOG_WARN("Failed to write rectification map cache {}", tmp_path);
+      return map;
+    }
+  }
+  std::filesystem::rename(tmp_path, path, ec);
+  if (ec) { HOLOSCAN_LOG_WARN("Failed to write rectification map cache {}", path); }
+  return map;
 }
 
 void UndistortRectifyOp::stereoRectify(float* M1, float* d1, float* M2, float* d2, float* R,
@@ -222,98 +325,66 @@ std::vector<std::pair<float, float>> UndistortRectifyOp::undistortPoints(
 void UndistortRectifyOp::setup(OperatorSpec& spec) {
   spec.input<holoscan::gxf::Entity>("input");
   spec.output<holoscan::gxf::Entity>("output");
+  spec.param(allocator_, "allocator", "Allocator", "Allocator for the rectified output");
+  cuda_stream_handler_.define_params(spec);
 }
 
 void UndistortRectifyOp::compute(InputContext& op_input, OutputContext& op_output,
                                  ExecutionContext& context) {
-  auto maybe_tensormap = op_input.receive<holoscan::TensorMap>("input");
-  const auto tensormap = maybe_tensormap.value();
+  auto in_message = op_input.receive<holoscan::gxf::Entity>("input").value();
 
-  if (tensormap.size() != 1) { throw std::runtime_error("Expecting single tensor input"); }
+  if (in_message.findAll<nvidia::gxf::Tensor>()->size() != 1) {
+    throw std::runtime_error("Expecting single tensor input");
+  }
 
-  auto tensor = tensormap.begin()->second;
+  auto tensor = in_message.get<Tensor>();
 
   int height = tensor->shape()[0];
   int width = tensor->shape()[1];
   int nChannels = tensor->shape()[2];
 
-  if (rectification_map_->mapx_ == NULL || rectification_map_->mapy_ == NULL) {
-    throw std::runtime_error("Rectification maps must be created before dewarping");
-  }
+  // Hold the table for this frame; a concurrent recalibration swaps in a new one for the next
+  auto map = rectification_map_ ? rectification_map_->map() : nullptr;
+  if (!map) { throw std::runtime_error("Rectification maps must be created before dewarping"); }
 
-  if (width != rectification_map_->width_ || height != rectification_map_->height_) {
+  if (width != map->width || height != map->height) {
     throw std::runtime_error("Dimensions do not match rectification map");
   }
   if (!(nChannels == 1 || nChannels == 3 || nChannels == 4)) {
     throw std::runtime_error("Number of channels in input must be 1, 3 or 4");
   }
 
-  auto pointer = std::shared_ptr<void*>(new void*, [](void** pointer) {
-    if (pointer != nullptr) {
-      if (*pointer != nullptr) { cudaFree(*pointer); }
-      delete pointer;
-    }
-  });
-
-  cudaMalloc(pointer.get(), width * height * nChannels * sizeof(uint8_t));
-  NppStatus status;
-  if (nChannels == 1) {
-    nppiRemap_8u_C1R(static_cast<Npp8u*>(tensor->data()),
-                     {width, height},
-                     width * nChannels * sizeof(Npp8u),
-                     {0, 0, width, height},
-                     rectification_map_->mapx_,
-                     width * sizeof(Npp32f),
-                     rectification_map_->mapy_,
-                     width * sizeof(Npp32f),
-                     static_cast<Npp8u*>(*pointer.get()),
-                     width * nChannels * sizeof(Npp8u),
-                     {width, height},
-                     NPPI_INTER_LINEAR);
-  } else if (nChannels == 3) {
-    status = nppiRemap_8u_C3R(static_cast<Npp8u*>(tensor->data()),
-                              {width, height},
-                              width * nChannels * sizeof(Npp8u),
-                              {0, 0, width, height},
-                              rectification_map_->mapx_,
-                              width * sizeof(Npp32f),
-                              rectification_map_->mapy_,
-                              width * sizeof(Npp32f),
-                              static_cast<Npp8u*>(*pointer.get()),
-                              width * nChannels * sizeof(Npp8u),
-                              {width, height},
-                              NPPI_INTER_LINEAR);
-  } else if (nChannels == 4) {
-    nppiRemap_8u_C4R(static_cast<Npp8u*>(tensor->data()),
-                     {width, height},
-                     width * nChannels * sizeof(Npp8u),
-                     {0, 0, width, height},
-                     rectification_map_->mapx_,
-                     width * sizeof(Npp32f),
-                     rectification_map_->mapy_,
-                     width * sizeof(Npp32f),
-                     static_cast<Npp8u*>(*pointer.get()),
-                     width * nChannels * sizeof(Npp8u),
-                     {width, height},
-                     NPPI_INTER_LINEAR);
-  } else {
-    throw std::runtime_error("Number of channels in input must be 1, 3 or 4");
+  if (cuda_stream_handler_.from_message(context.context(), in_message) != GXF_SUCCESS) {
+    throw std::runtime_error("Failed to get the CUDA stream from incoming messages");
   }
+  const cudaStream_t stream = cuda_stream_handler_.get_cuda_stream(context.context());
+
+  auto allocator = nvidia::gxf::Handle<nvidia::gxf::Allocator>::Create(context.context(),
+                                                                         allocator_->gxf_cid());
   auto out_message = nvidia::gxf::Entity::New(context.context());
   auto gxf_tensor = out_message.value().add<nvidia::gxf::Tensor>("");
   nvidia::gxf::Shape shape = nvidia::gxf::Shape{height, width, nChannels};
-  int element_size = nvidia::gxf::PrimitiveTypeSize(nvidia::gxf::PrimitiveType::kUnsigned8);
-  gxf_tensor.value()->wrapMemory(shape,
-                                 nvidia::gxf::PrimitiveType::kUnsigned8,
-                                 element_size,
-                                 nvidia::gxf::ComputeTrivialStrides(shape, element_size),
-                                 nvidia::gxf::MemoryStorageType::kDevice,
-                                 *pointer,
-                                 [orig_pointer = pointer](void*) mutable {
-                                   orig_pointer.reset();  // decrement ref count
-                                   return nvidia::gxf::Success;
-                                 });
+  if (!gxf_tensor.value()->reshape<uint8_t>(
+          shape, nvidia::gxf::MemoryStorageType::kDevice, allocator.value())) {
+    throw std::runtime_error("Failed to allocate output tensor");
+  }
 
+  remapBilinear(static_cast<uint8_t*>(tensor->data()),
+                width * nChannels,
+                map->data,
+                gxf_tensor.value()->data<uint8_t>().value(),
+                width * nChannels,
+                width,
+                height,
+                nChannels,
+                stream);
+  if (cudaGetLastError() != cudaSuccess) {
+    throw std::runtime_error("Failed to remap input image");
+  }
+
+  if (cuda_stream_handler_.to_message(out_message) != GXF_SUCCESS) {
+    throw std::runtime_error("Failed to add the CUDA stream to the outgoing messages");
+  }
   op_output.emit(out_message.value(), "output");
 }
 
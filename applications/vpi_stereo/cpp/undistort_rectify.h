@@ -18,7 +18,18 @@
 #ifndef OPERATORS_UNDISTORT_RECTIFY
 #define OPERATORS_UNDISTORT_RECTIFY
 
+#include <cuda_fp16.h>
+#include <cuda_runtime.h>
+
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
 #include <holoscan/holoscan.hpp>
+#include <holoscan/utils/cuda_stream_handler.hpp>
+
+#include "stereo_depth_kernels.h"
 
 namespace holoscan::ops {
 
@@ -26,18 +37,40 @@ class UndistortRectifyOp : public Operator {
   static void stereoRecitfy();
 
  public:
+  // Remap table of one eye, stored as fp16 displacements. Tables are built on a side stream and
+  // optionally cached on disk under cache_dir, keyed by a hash of the calibration, so later
+  // startups with the same calibration skip the computation. recalibrate() rebuilds the table
+  // while frames are being rectified and swaps it in atomically.
   class RectificationMap {
    public:
+    struct Map {
+      Map(int width, int height);
+      ~Map();
+      __half2* data = nullptr;
+      int width = 0;
+      int height = 0;
+    };
+
     RectificationMap() {}
-    RectificationMap(float* M, float* d, float* R, float* P, int width, int height);
+    RectificationMap(float* M, float* d, float* R, float* P, int width, int height,
+                     const std::string& cache_dir = "");
     ~RectificationMap();
-    void setParameters(float* M, float* d, float* R, float* P, int width, int height);
-    float* mapx_ = NULL;
-    float* mapy_ = NULL;
-    int width_ = 0;
-    int height_ = 0;
+    void setParameters(float* M, float* d, float* R, float* P, int width, int height,
+                       const std::string& cache_dir = "");
+    // May be called from any thread; frames already queued keep using the previous table
+    void recalibrate(float* M, float* d, float* R, float* P);
+    std::shared_ptr<const Map> map() const { return std::atomic_load(&map_); }
 
    private:
+    std::shared_ptr<const Map> build(const RectificationParams& params);
+    std::string cachePath(const RectificationParams& params) const;
+
+    std::shared_ptr<const Map> map_;
+    std::mutex build_mutex_;
+    cudaStream_t stream_ = nullptr;
+    std::string cache_dir_;
+    int width_ = 0;
+    int height_ = 0;
   };
 
   static void stereoRectify(float* M1, float* d1, float* M2, float* d2, float* R, float* t,
@@ -54,6 +87,8 @@ class UndistortRectifyOp : public Operator {
 
  private:
   std::shared_ptr<RectificationMap> rectification_map_;
+  Parameter<std::shared_ptr<Allocator>> allocator_;
+  CudaStreamHandler cuda_stream_handler_;
   static std::vector<std::pair<float, float>> distortPoints(
       std::vector<std::pair<float, float>> pts_in, float* M, float* d);
   static std::vector<std::pair<float, float>> undistortPoints(
@@ -39,6 +39,28 @@
 
 namespace holoscan::ops {
 
+namespace {
+
+// Points a cached wrapper at new tensor memory. vpiImageSetWrapper requires the format and size
+// the wrapper was created with, so the wrapper is only recreated when those change.
+void updateWrapper(const VPIImageData& data, VPIImage& wrapper) {
+  if (wrapper != nullptr) {
+    VPIImageFormat format;
+    int32_t width, height;
+    CHECK_VPI(vpiImageGetFormat(wrapper, &format));
+    CHECK_VPI(vpiImageGetSize(wrapper, &width, &height));
+    if (format == data.buffer.pitch.format && width == data.buffer.pitch.planes[0].width &&
+        height == data.buffer.pitch.planes[0].height) {
+      CHECK_VPI(vpiImageSetWrapper(wrapper, &data));
+      return;
+    }
+    vpiImageDestroy(wrapper);
+  }
+  CHECK_VPI(vpiImageCreateWrapper(&data, NULL, VPI_BACKEND_CUDA, &wrapper));
+}
+
+}  // namespace
+
 // inputs are expected to be a rectified stereo pair of Tensors that hold rgb888 data in HWC
 // layout. input1 should be the left camera view, and input2 the right.
 // output is a disparity map Tensor of float data in HWC layout with size width x height x 1
@@ -50,12 +72,29 @@ void VPIStereoOp::setup(OperatorSpec& spec) {
   spec.param(height_, "height");
   spec.param(maxDisparity_, "maxDisparity");
   spec.param(downscaleFactor_, "downscaleFactor");
+  spec.param(pipeline_depth_,
+             "pipeline_depth",
+             "Pipeline depth",
+             "Number of frames in flight, each on its own VPI stream. Above 1 the disparity of a "
+             "frame is emitted pipeline_depth - 1 frames later.",
+             1);
+  spec.param(backend_,
+             "backend",
+             "Disparity backend",
+             "Backend for the disparity estimator: 'auto' uses OFA|PVA|VIC when available and "
+             "falls back to CUDA, 'ofa' requires OFA|PVA|VIC and 'cuda' always uses CUDA. Format "
+             "conversion and rescaling always run on CUDA.",
+             std::string("auto"));
+  spec.param(allocator_, "allocator", "Allocator", "Allocator for the output disparity map");
+  cuda_stream_handler_.define_params(spec);
 }
 
 // VPI stereo disparity estimator can use this combination of accelerators on most Tegra platforms.
 #define OFA_PVA_VIC (VPI_BACKEND_OFA | VPI_BACKEND_PVA | VPI_BACKEND_VIC)
 
 void VPIStereoOp::start() {
+  if (pipeline_depth_ < 1) { throw std::runtime_error("pipeline_depth must be at least 1"); }
+
   // set the VPI stereo disparity parameters
   CHECK_VPI(vpiInitStereoDisparityEstimatorCreationParams(&createParams_));
   createParams_.maxDisparity = maxDisparity_;
@@ -66,71 +105,109 @@ void VPIStereoOp::start() {
 
   // prefer to offload GPU if other accelerators are available. Check the VPI context to discover
   // which backends are available.
-  backends_ = OFA_PVA_VIC;
-  inFmt_ = VPI_IMAGE_FORMAT_Y8_ER_BL;
   VPIContext vpiCtx;
   CHECK_VPI(vpiContextGetCurrent(&vpiCtx));
   uint64_t vpiCtxFlags;
   CHECK_VPI(vpiContextGetFlags(vpiCtx, &vpiCtxFlags));
-  if ((vpiCtxFlags & OFA_PVA_VIC) != OFA_PVA_VIC) {
-    printf("Info: OFA|PVA|VIC not available! Falling back to CUDA backend.\n");
+  const bool accelerators = (vpiCtxFlags & OFA_PVA_VIC) == OFA_PVA_VIC;
+  if (backend_.get() == "ofa" && !accelerators) {
+    throw std::runtime_error("backend 'ofa' requested but OFA|PVA|VIC are not available");
+  }
+  if (backend_.get() != "auto" && backend_.get() != "ofa" && backend_.get() != "cuda") {
+    throw std::runtime_error("backend must be one of 'auto', 'ofa' or 'cuda'");
+  }
+  if (backend_.get() == "cuda" || !accelerators) {
+    if (backend_.get() == "auto") {
+      printf("Info: OFA|PVA|VIC not available! Falling back to CUDA backend.\n");
+    }
     backends_ = VPI_BACKEND_CUDA;
     inFmt_ = VPI_IMAGE_FORMAT_Y8_ER;
   } else {
+    backends_ = OFA_PVA_VIC;
+    inFmt_ = VPI_IMAGE_FORMAT_Y8_ER_BL;
     // VPI's accelerator-based stereo has a unique flavor of confidence map that performs better
     // than the default. Select it here.
     submitParams_.confidenceType = VPI_STEREO_CONFIDENCE_INFERENCE;
   }
-  CHECK_VPI(vpiStreamCreate(0, &stream_));
-  CHECK_VPI(vpiCreateStereoDisparityEstimator(
-      backends_, width_, height_, inFmt_, &createParams_, &payload_));
-
-  // intermediate images
-  CHECK_VPI(vpiImageCreate(
-      width_, height_, VPI_IMAGE_FORMAT_RGB8, backends_ | VPI_BACKEND_CUDA, &inLeftRGB_));
-  CHECK_VPI(vpiImageCreate(
-      width_, height_, VPI_IMAGE_FORMAT_RGB8, backends_ | VPI_BACKEND_CUDA, &inRightRGB_));
-  CHECK_VPI(vpiImageCreate(width_, height_, inFmt_, backends_ | VPI_BACKEND_CUDA, &inLeftMono_));
-  CHECK_VPI(vpiImageCreate(width_, height_, inFmt_, backends_ | VPI_BACKEND_CUDA, &inRightMono_));
-  CHECK_VPI(vpiImageCreate(widthDownscaled_,
-                           heightDownscaled_,
-                           VPI_IMAGE_FORMAT_U16,
-                           backends_ | VPI_BACKEND_CUDA,
-                           &outConf16_));
-  CHECK_VPI(vpiImageCreate(widthDownscaled_,
-                           heightDownscaled_,
-                           VPI_IMAGE_FORMAT_S16,
-                           backends_ | VPI_BACKEND_CUDA,
-                           &outDisp16_));
-  CHECK_VPI(vpiImageCreate(widthDownscaled_,
-                           heightDownscaled_,
-                           VPI_IMAGE_FORMAT_F32,
-                           backends_ | VPI_BACKEND_CUDA,
-                           &outDisp_));
+
+  // one stream, payload and set of intermediate images per frame in flight, so that the
+  // disparity engine of one frame overlaps the CUDA pre/post processing of the next
+  slots_.resize(pipeline_depth_);
+  for (auto& slot : slots_) {
+    CHECK_VPI(vpiStreamCreate(0, &slot.stream));
+    CHECK_VPI(vpiCreateStereoDisparityEstimator(
+        backends_, width_, height_, inFmt_, &createParams_, &slot.payload));
+
+    // intermediate images
+    CHECK_VPI(vpiImageCreate(
+        width_, height_, VPI_IMAGE_FORMAT_RGB8, backends_ | VPI_BACKEND_CUDA, &slot.inLeftRGB));
+    CHECK_VPI(vpiImageCreate(
+        width_, height_, VPI_IMAGE_FORMAT_RGB8, backends_ | VPI_BACKEND_CUDA, &slot.inRightRGB));
+    CHECK_VPI(
+        vpiImageCreate(width_, height_, inFmt_, backends_ | VPI_BACKEND_CUDA, &slot.inLeftMono));
+    CHECK_VPI(
+        vpiImageCreate(width_, height_, inFmt_, backends_ | VPI_BACKEND_CUDA, &slot.inRightMono));
+    CHECK_VPI(vpiImageCreate(widthDownscaled_,
+                             heightDownscaled_,
+                             VPI_IMAGE_FORMAT_U16,
+                             backends_ | VPI_BACKEND_CUDA,
+                             &slot.outConf16));
+    CHECK_VPI(vpiImageCreate(widthDownscaled_,
+                             heightDownscaled_,
+                             VPI_IMAGE_FORMAT_S16,
+                             backends_ | VPI_BACKEND_CUDA,
+                             &slot.outDisp16));
+    CHECK_VPI(vpiImageCreate(widthDownscaled_,
+                             heightDownscaled_,
+                             VPI_IMAGE_FORMAT_F32,
+                             backends_ | VPI_BACKEND_CUDA,
+                             &slot.outDisp));
+  }
+  next_slot_ = 0;
 }
 
 void VPIStereoOp::stop() {
-  vpiStreamDestroy(stream_);
-  vpiPayloadDestroy(payload_);
-  vpiImageDestroy(inLeftRGB_);
-  vpiImageDestroy(inRightRGB_);
-  vpiImageDestroy(inLeftMono_);
-  vpiImageDestroy(inRightMono_);
-  vpiImageDestroy(outConf16_);
-  vpiImageDestroy(outDisp16_);
-  vpiImageDestroy(outDisp_);
+  // frames still in flight are dropped, but their work must finish before the images go away
+  for (auto& slot : slots_) {
+    vpiStreamSync(slot.stream);
+    vpiStreamDestroy(slot.stream);
+    vpiPayloadDestroy(slot.payload);
+    vpiImageDestroy(slot.inLeftRGB);
+    vpiImageDestroy(slot.inRightRGB);
+    vpiImageDestroy(slot.inLeftMono);
+    vpiImageDestroy(slot.inRightMono);
+    vpiImageDestroy(slot.outConf16);
+    vpiImageDestroy(slot.outDisp16);
+    vpiImageDestroy(slot.outDisp);
+    vpiImageDestroy(slot.inLeftWrapper);
+    vpiImageDestroy(slot.inRightWrapper);
+    vpiImageDestroy(slot.outDispWrapper);
+  }
+  slots_.clear();
+}
+
+void VPIStereoOp::retire(FrameSlot& slot, OutputContext& op_output) {
+  if (!slot.pending) { return; }
+  // VPI algorithms execute asynchronously. Sync the stream to ensure they are complete.
+  CHECK_VPI(vpiStreamSync(slot.stream));
+  slot.inputs.clear();
+  op_output.emit(slot.output, "output");
+  slot.output = nvidia::gxf::Entity();
+  slot.pending = false;
 }
 
 void VPIStereoOp::compute(InputContext& op_input, OutputContext& op_output,
                           ExecutionContext& context) {
-  auto maybe_tensormap1 = op_input.receive<holoscan::TensorMap>("input1");
-  const auto tensormap1 = maybe_tensormap1.value();
+  auto in_message1 = op_input.receive<holoscan::gxf::Entity>("input1").value();
+  auto in_message2 = op_input.receive<holoscan::gxf::Entity>("input2").value();
 
-  auto maybe_tensormap2 = op_input.receive<holoscan::TensorMap>("input2");
-  const auto tensormap2 = maybe_tensormap2.value();
+  if ((in_message1.findAll<nvidia::gxf::Tensor>()->size() != 1) ||
+      (in_message2.findAll<nvidia::gxf::Tensor>()->size() != 1)) {
+    throw std::runtime_error("Expecting two single-tensor inputs");
+  }
 
-  auto tensor1 = tensormap1.begin()->second;
-  auto tensor2 = tensormap2.begin()->second;
+  auto tensor1 = in_message1.get<Tensor>();
+  auto tensor2 = in_message2.get<Tensor>();
 
   // input HWC layout, RGB8
   int orig_height = tensor1->shape()[0];
@@ -142,14 +219,33 @@ void VPIStereoOp::compute(InputContext& op_input, OutputContext& op_output,
     throw std::runtime_error("Input tensor shapes do not match");
   }
 
-  if ((tensormap1.size() != 1) || (tensormap2.size() != 1)) {
-    throw std::runtime_error("Expecting two single-tensor inputs");
+  if (!(nChannels == 3)) { throw std::runtime_error("Input tensors expected to have 3 channels"); }
+
+  // The inputs are produced asynchronously on the upstream CUDA streams. VPI runs on its own
+  // stream and backends, so wait for the inputs to be ready before submitting VPI work.
+  if (cuda_stream_handler_.from_messages(context.context(), {in_message1, in_message2}) !=
+      GXF_SUCCESS) {
+    throw std::runtime_error("Failed to get the CUDA stream from incoming messages");
   }
+  const cudaStream_t cuda_stream = cuda_stream_handler_.get_cuda_stream(context.context());
+  cudaStreamSynchronize(cuda_stream);
 
-  if (!(nChannels == 3)) { throw std::runtime_error("Input tensors expected to have 3 channels"); }
+  // allocate output buffer for F32 disparity
+  nvidia::gxf::Shape shape = nvidia::gxf::Shape{orig_height, orig_width, 1};
+  auto allocator = nvidia::gxf::Handle<nvidia::gxf::Allocator>::Create(context.context(),
+                                                                         allocator_->gxf_cid());
+  auto out_message = nvidia::gxf::Entity::New(context.context());
+  auto gxf_tensor_disparity = out_message.value().add<nvidia::gxf::Tensor>("");
+  if (!gxf_tensor_disparity.value()->reshape<float>(
+          shape, nvidia::gxf::MemoryStorageType::kDevice, allocator.value())) {
+    throw std::runtime_error("Failed to allocate output tensor");
+  }
+
+  // the slot was retired at the end of the previous call
+  FrameSlot& slot = slots_[next_slot_];
+  next_slot_ = (next_slot_ + 1) % slots_.size();
 
-  // wrap tensor buffers in VPIImages
-  VPIImage inLeftRGB, inRightRGB, outDisp;
+  // point the cached wrappers at this frame's tensor buffers
   VPIImageData data;
   data.bufferType = VPI_IMAGE_BUFFER_CUDA_PITCH_LINEAR;
   data.buffer.pitch.format = VPI_IMAGE_FORMAT_RGB8;
@@ -159,64 +255,58 @@ void VPIStereoOp::compute(InputContext& op_input, OutputContext& op_output,
   data.buffer.pitch.planes[0].width = orig_width;
   data.buffer.pitch.planes[0].height = orig_height;
   data.buffer.pitch.planes[0].pixelType = VPI_PIXEL_TYPE_3U8;
-  CHECK_VPI(vpiImageCreateWrapper(&data, NULL, VPI_BACKEND_CUDA, &inLeftRGB));
+  updateWrapper(data, slot.inLeftWrapper);
   // right is same size as left, just different pointer
   data.buffer.pitch.planes[0].data = tensor2->data();
-  CHECK_VPI(vpiImageCreateWrapper(&data, NULL, VPI_BACKEND_CUDA, &inRightRGB));
+  updateWrapper(data, slot.inRightWrapper);
 
-  // allocate output buffer for F32 disparity
-  auto pointerDisp = std::shared_ptr<void*>(new void*, [](void** pointer) {
-    if (pointer != nullptr) {
-      if (*pointer != nullptr) { cudaFree(*pointer); }
-      delete pointer;
-    }
-  });
-  cudaMalloc(pointerDisp.get(), orig_width * orig_height * sizeof(float));
   // wrap output for VPI
   data.buffer.pitch.format = VPI_IMAGE_FORMAT_F32;
-  data.buffer.pitch.planes[0].data = *pointerDisp.get();
+  data.buffer.pitch.planes[0].data = gxf_tensor_disparity.value()->pointer();
   data.buffer.pitch.planes[0].pitchBytes = orig_width * sizeof(float);
   data.buffer.pitch.planes[0].width = orig_width;
   data.buffer.pitch.planes[0].height = orig_height;
   data.buffer.pitch.planes[0].pixelType = VPI_PIXEL_TYPE_F32;
-  CHECK_VPI(vpiImageCreateWrapper(&data, NULL, VPI_BACKEND_CUDA, &outDisp));
+  updateWrapper(data, slot.outDispWrapper);
 
   // first, rescale the inputs to the target resolution if necessary
-  VPIImage inLeft = inLeftRGB;
-  VPIImage inRight = inRightRGB;
+  VPIImage inLeft = slot.inLeftWrapper;
+  VPIImage inRight = slot.inRightWrapper;
   if ((width_ != orig_width) || (height_ != orig_height)) {
-    CHECK_VPI(vpiSubmitRescale(stream_,
+    CHECK_VPI(vpiSubmitRescale(slot.stream,
                                VPI_BACKEND_CUDA,
-                               inLeftRGB,
-                               inLeftRGB_,
+                               slot.inLeftWrapper,
+                               slot.inLeftRGB,
                                VPI_INTERP_CATMULL_ROM,
                                VPI_BORDER_CLAMP,
                                0));
-    CHECK_VPI(vpiSubmitRescale(stream_,
+    CHECK_VPI(vpiSubmitRescale(slot.stream,
                                VPI_BACKEND_CUDA,
-                               inRightRGB,
-                               inRightRGB_,
+                               slot.inRightWrapper,
+                               slot.inRightRGB,
                                VPI_INTERP_CATMULL_ROM,
                                VPI_BORDER_CLAMP,
                                0));
-    inLeft = inLeftRGB_;
-    inRight = inRightRGB_;
+    inLeft = slot.inLeftRGB;
+    inRight = slot.inRightRGB;
   }
 
   // next, convert from RGB888 to a grayscale format
   /// Note: RGB888 -> Y8 conversion is only supported on CUDA backend
   /// (VIC would be able to convert RGBA8888, but for the purpose of this example we use RGB888)
-  CHECK_VPI(vpiSubmitConvertImageFormat(stream_, VPI_BACKEND_CUDA, inLeft, inLeftMono_, NULL));
-  CHECK_VPI(vpiSubmitConvertImageFormat(stream_, VPI_BACKEND_CUDA, inRight, inRightMono_, NULL));
+  CHECK_VPI(
+      vpiSubmitConvertImageFormat(slot.stream, VPI_BACKEND_CUDA, inLeft, slot.inLeftMono, NULL));
+  CHECK_VPI(
+      vpiSubmitConvertImageFormat(slot.stream, VPI_BACKEND_CUDA, inRight, slot.inRightMono, NULL));
 
   // then, estimate stereo disparity
-  CHECK_VPI(vpiSubmitStereoDisparityEstimator(stream_,
+  CHECK_VPI(vpiSubmitStereoDisparityEstimator(slot.stream,
                                               backends_,
-                                              payload_,
-                                              inLeftMono_,
-                                              inRightMono_,
-                                              outDisp16_,
-                                              outConf16_,
+                                              slot.payload,
+                                              slot.inLeftMono,
+                                              slot.inRightMono,
+                                              slot.outDisp16,
+                                              slot.outConf16,
                                               &submitParams_));
 
   // finally, convert stereo output from 16 bit (10.5 fixed point) to float
@@ -227,40 +317,31 @@ void VPIStereoOp::compute(InputContext& op_input, OutputContext& op_output,
   // rescale output back to the original size if necessary. Using NEAREST since interpolation would
   // introduce false disparity values at discontinuities.
   if ((widthDownscaled_ != orig_width) || (heightDownscaled_ != orig_height)) {
-    CHECK_VPI(
-        vpiSubmitConvertImageFormat(stream_, VPI_BACKEND_CUDA, outDisp16_, outDisp_, &convParams));
-    CHECK_VPI(vpiSubmitRescale(
-        stream_, VPI_BACKEND_CUDA, outDisp_, outDisp, VPI_INTERP_NEAREST, VPI_BORDER_CLAMP, 0));
+    CHECK_VPI(vpiSubmitConvertImageFormat(
+        slot.stream, VPI_BACKEND_CUDA, slot.outDisp16, slot.outDisp, &convParams));
+    CHECK_VPI(vpiSubmitRescale(slot.stream,
+                               VPI_BACKEND_CUDA,
+                               slot.outDisp,
+                               slot.outDispWrapper,
+                               VPI_INTERP_NEAREST,
+                               VPI_BORDER_CLAMP,
+                               0));
   } else {
-    CHECK_VPI(
-        vpiSubmitConvertImageFormat(stream_, VPI_BACKEND_CUDA, outDisp16_, outDisp, &convParams));
+    CHECK_VPI(vpiSubmitConvertImageFormat(
+        slot.stream, VPI_BACKEND_CUDA, slot.outDisp16, slot.outDispWrapper, &convParams));
   }
-  // VPI algorithms execute asynchronously. Sync the stream to ensure they are complete.
-  CHECK_VPI(vpiStreamSync(stream_));
-
-  // clean up VPIImage wrappers
-  vpiImageDestroy(inLeftRGB);
-  vpiImageDestroy(inRightRGB);
-  vpiImageDestroy(outDisp);
 
-  // post FP32 disparity tensor as output message
-  nvidia::gxf::Shape shape = nvidia::gxf::Shape{orig_height, orig_width, 1};
-
-  auto out_message = nvidia::gxf::Entity::New(context.context());
-  auto gxf_tensor_disparity = out_message.value().add<nvidia::gxf::Tensor>("");
+  // post FP32 disparity tensor as output message once the slot is retired
+  if (cuda_stream_handler_.to_message(out_message) != GXF_SUCCESS) {
+    throw std::runtime_error("Failed to add the CUDA stream to the outgoing messages");
+  }
+  slot.inputs = {in_message1, in_message2};
+  slot.output = std::move(out_message.value());
+  slot.pending = true;
 
-  gxf_tensor_disparity.value()->wrapMemory(shape,
-                                           nvidia::gxf::PrimitiveType::kFloat32,
-                                           sizeof(float),
-                                           nvidia::gxf::ComputeTrivialStrides(shape, sizeof(float)),
-                                           nvidia::gxf::MemoryStorageType::kDevice,
-                                           *pointerDisp,
-                                           [orig_pointer = pointerDisp](void*) mutable {
-                                             orig_pointer.reset();  // decrement ref count
-                                             return nvidia::gxf::Success;
-                                           });
-
-  op_output.emit(out_message.value(), "output");
+  // retire the oldest frame in flight, which frees the slot used by the next call. With a single
+  // slot that is the frame just submitted.
+  retire(slots_[next_slot_], op_output);
 }
 
 }  // namespace holoscan::ops
@@ -18,12 +18,16 @@
 #ifndef VPI_STEREO_OP
 #define VPI_STEREO_OP
 
+#include <string>
+#include <vector>
+
 #include <vpi/Image.h>
 #include <vpi/ImageFormat.h>
 #include <vpi/Stream.h>
 #include <vpi/Types.h>
 #include <vpi/algo/StereoDisparity.h>
 #include <holoscan/holoscan.hpp>
+#include <holoscan/utils/cuda_stream_handler.hpp>
 
 namespace holoscan::ops {
 
@@ -37,27 +41,49 @@ class VPIStereoOp : public Operator {
   void compute(InputContext&, OutputContext& op_output, ExecutionContext&) override;
 
  private:
+  // VPI stream, payload and images for one frame in flight. Each slot is reused once its
+  // previous frame has been retired.
+  struct FrameSlot {
+    VPIStream stream = nullptr;
+    VPIPayload payload = nullptr;
+    VPIImage inLeftRGB = nullptr;
+    VPIImage inRightRGB = nullptr;
+    VPIImage inLeftMono = nullptr;
+    VPIImage inRightMono = nullptr;
+    VPIImage outConf16 = nullptr;
+    VPIImage outDisp16 = nullptr;
+    VPIImage outDisp = nullptr;
+    // wrappers of the input and output tensors, re-pointed with vpiImageSetWrapper each frame
+    VPIImage inLeftWrapper = nullptr;
+    VPIImage inRightWrapper = nullptr;
+    VPIImage outDispWrapper = nullptr;
+    // messages kept alive until the VPI work reading and writing them completes
+    bool pending = false;
+    std::vector<holoscan::gxf::Entity> inputs;
+    nvidia::gxf::Entity output;
+  };
+
+  // waits for the frame in the slot and emits its disparity
+  void retire(FrameSlot& slot, OutputContext& op_output);
+
   Parameter<int> width_;
   Parameter<int> height_;
   Parameter<int> maxDisparity_;
   Parameter<int> downscaleFactor_;
+  Parameter<int> pipeline_depth_;
+  Parameter<std::string> backend_;
+  Parameter<std::shared_ptr<Allocator>> allocator_;
+  CudaStreamHandler cuda_stream_handler_;
   int widthDownscaled_;
   int heightDownscaled_;
 
   // VPI objects that can be reused each compute() call
-  VPIStream stream_;
   VPIStereoDisparityEstimatorCreationParams createParams_;
   VPIStereoDisparityEstimatorParams submitParams_;
-  VPIPayload payload_;
   VPIImageFormat inFmt_;
   uint64_t backends_;
-  VPIImage inLeftRGB_;
-  VPIImage inRightRGB_;
-  VPIImage inLeftMono_;
-  VPIImage inRightMono_;
-  VPIImage outConf16_;
-  VPIImage outDisp16_;
-  VPIImage outDisp_;
+  std::vector<FrameSlot> slots_;
+  size_t next_slot_ = 0;
 };
 
 }  // namespace holoscan::ops
@@ -118,6 +118,12 @@ class XrGeometrySourceOp : public Operator {
     spec.output<std::shared_ptr<xr::CompositionLayerBaseHeader>>("xr_composition_layer");
   }
 
+  void start() override {
+    // The geometry is static, it is generated once and passed by reference every frame. Only the
+    // model matrices of the specs change per frame.
+    generate_torus_vertices();
+  }
+
   void compute(InputContext& op_input, OutputContext& op_output,
                ExecutionContext& context) override {
     auto frame_state = op_input.receive<xr::FrameState>("xr_frame_state");
@@ -130,15 +136,8 @@ class XrGeometrySourceOp : public Operator {
      ======
     */
 
-    // Initialize the torus vertices
-    generate_torus_vertices();
-    add_data<TORUS_MAJOR_SEGMENTS * TORUS_MINOR_SEGMENTS * 6, 3>(
-        entity,  // 6 vertices per quad (2 triangles × 3 vertices)
-        "torus",
-        torus_array,
-        context);
-
-    add_data<24, 3>(entity, "cube", cube_array, context);
+    add_data(entity, "torus", torus_array);  // 6 vertices per quad (2 triangles × 3 vertices)
+    add_data(entity, "cube", cube_array);
 
     /* ======
      Create an XR composition layer by current frame state.
@@ -165,12 +164,15 @@ class XrGeometrySourceOp : public Operator {
                     static_cast<float>(frame_state->predictedDisplayTime.get()) / 1'000'000'000,
                     glm::vec3(0, -1, 0));
 
+    const std::vector<glm::mat4> view_projections =
+        XrViewsHelper::create_view_projections(xr_composition_layer);
+
     HolovizOp::InputSpec torus_spec = XrViewsHelper::create_spec_with_views(
-        "torus", HolovizOp::InputType::TRIANGLES_3D, xr_composition_layer, model_matrix_torus);
+        "torus", HolovizOp::InputType::TRIANGLES_3D, view_projections, model_matrix_torus);
     specs.push_back(torus_spec);
 
     HolovizOp::InputSpec cube_spec = XrViewsHelper::create_spec_with_views(
-        "cube", HolovizOp::InputType::LINES_3D, xr_composition_layer, model_matrix_cube);
+        "cube", HolovizOp::InputType::LINES_3D, view_projections, model_matrix_cube);
     specs.push_back(cube_spec);
 
     // emit outputs
@@ -182,16 +184,21 @@ class XrGeometrySourceOp : public Operator {
   }
 
  private:
-  // Helper function to add a tensor with data to an entity.
+  // Helper function to add a tensor referencing static geometry to an entity.
   template <std::size_t N, std::size_t C>
   void add_data(gxf::Entity& entity, const char* name,
-                const std::array<std::array<float, C>, N>& data, ExecutionContext& context) {
-    auto allocator = nvidia::gxf::Handle<nvidia::gxf::Allocator>::Create(context.context(),
-                                                                         allocator_->gxf_cid());
+                std::array<std::array<float, C>, N>& data) {
     auto tensor = static_cast<nvidia::gxf::Entity&>(entity).add<nvidia::gxf::Tensor>(name).value();
-    tensor->reshape<float>(
-        nvidia::gxf::Shape({N, C}), nvidia::gxf::MemoryStorageType::kHost, allocator.value());
-    std::memcpy(tensor->pointer(), data.data(), N * C * sizeof(float));
+    const nvidia::gxf::Shape shape({N, C});
+    const auto type = nvidia::gxf::PrimitiveType::kFloat32;
+    const auto bytes_per_element = nvidia::gxf::PrimitiveTypeSize(type);
+    tensor->wrapMemory(shape,
+                       type,
+                       bytes_per_element,
+                       nvidia::gxf::ComputeTrivialStrides(shape, bytes_per_element),
+                       nvidia::gxf::MemoryStorageType::kHost,
+                       data.data(),
+                       nullptr);
   }
   // Create a render buffer with swapchain
   void create_render_buffer(ExecutionContext& context, OutputContext& op_output) {
@@ -14,6 +14,10 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
+#include <memory>
+#include <string>
+#include <vector>
+
 #include "glm/ext/matrix_clip_space.hpp"
 #include "glm/ext/matrix_float4x4.hpp"
 #include "glm/ext/matrix_transform.hpp"
@@ -30,17 +34,12 @@ namespace holoscan::ops {
 
 namespace XrViewsHelper {
 
-// Create HolovizOp::InputSpec with XR stereo views
-HolovizOp::InputSpec create_spec_with_views(
-    const std::string& tensor_name, const HolovizOp::InputType type,
-    std::shared_ptr<XrCompositionLayerProjectionStorage> composition_layer,
-    const glm::mat4& model_matrix = glm::mat4(1.0f)) {
-  // Setup HolovizOp::InputSpec
-  HolovizOp::InputSpec spec;
-  spec.tensor_name_ = tensor_name;
-  spec.type_ = type;
-
-  // Add a Holoviz view for each XR composition layer view.
+// View-projection matrix of each XR composition layer view, computed once per frame and shared
+// by all the specs of the frame.
+std::vector<glm::mat4> create_view_projections(
+    std::shared_ptr<XrCompositionLayerProjectionStorage> composition_layer) {
+  std::vector<glm::mat4> view_projections;
+  view_projections.reserve(composition_layer->viewCount);
   for (int i = 0; i < composition_layer->viewCount; i++) {
     xr::CompositionLayerProjectionView& view = composition_layer->views[i];
 
@@ -59,14 +58,32 @@ HolovizOp::InputSpec create_spec_with_views(
                           composition_layer->depth_info[i].nearZ,
                           composition_layer->depth_info[i].farZ);
 
+    view_projections.push_back(projection_matrix * view_matrix);
+  }
+  return view_projections;
+}
+
+// Create HolovizOp::InputSpec with XR stereo views. All views are drawn by the single Holoviz
+// layer of the spec, so the geometry is submitted once for both eyes.
+HolovizOp::InputSpec create_spec_with_views(const std::string& tensor_name,
+                                            const HolovizOp::InputType type,
+                                            const std::vector<glm::mat4>& view_projections,
+                                            const glm::mat4& model_matrix = glm::mat4(1.0f)) {
+  // Setup HolovizOp::InputSpec
+  HolovizOp::InputSpec spec;
+  spec.tensor_name_ = tensor_name;
+  spec.type_ = type;
+
+  const float view_width = 1.0f / view_projections.size();
+  for (size_t i = 0; i < view_projections.size(); i++) {
     glm::mat4 view_projection_matrix_row_major =
-        glm::transpose(projection_matrix * view_matrix * model_matrix);
+        glm::transpose(view_projections[i] * model_matrix);
 
     // For stereo views, use side-by-side image layout.
     HolovizOp::InputSpec::View xr_view;
-    xr_view.offset_x_ = i * 0.5f;
+    xr_view.offset_x_ = i * view_width;
     xr_view.offset_y_ = 0;
-    xr_view.width_ = 0.5f;
+    xr_view.width_ = view_width;
     xr_view.height_ = 1.0f;
 
     std::array<float, 16> matrix_array;
@@ -80,6 +97,15 @@ HolovizOp::InputSpec create_spec_with_views(
   return spec;
 }
 
+// Create HolovizOp::InputSpec with XR stereo views
+HolovizOp::InputSpec create_spec_with_views(
+    const std::string& tensor_name, const HolovizOp::InputType type,
+    std::shared_ptr<XrCompositionLayerProjectionStorage> composition_layer,
+    const glm::mat4& model_matrix = glm::mat4(1.0f)) {
+  return create_spec_with_views(
+      tensor_name, type, create_view_projections(composition_layer), model_matrix);
+}
+
 }  // namespace XrViewsHelper
 
 }  // namespace holoscan::ops
@@ -19,13 +19,42 @@
 #define HOLOSCAN_BENCHMARK
 
 #include <stdlib.h>
+#include <memory>
 #include <string>
+#include <type_traits>
 #include <unordered_set>
+#include <utility>
 
 #include "holoscan/holoscan.hpp"
 
+#include "flow_histogram.hpp"
+#include "gpu_partition.hpp"
+#include "operator_profiler.hpp"
+#include "run_environment.hpp"
+#include "wcrt_monitor.hpp"
+
 class BenchmarkedApplication : public holoscan::Application {
  public:
+  /**
+   * Hides Fragment::make_operator() so that, with HOLOSCAN_OPERATOR_PROFILING,
+   * HOLOSCAN_GPU_MEMORY_FILE or HOLOSCAN_GPU_SM_PARTITIONS set, the operators composed by the
+   * application are created as ProfiledOperator<OperatorT>.
+   */
+  template <typename OperatorT, typename... ArgsT>
+  std::shared_ptr<OperatorT> make_operator(ArgsT&&... args) {
+    if constexpr (std::is_final_v<OperatorT>) {
+      return Fragment::make_operator<OperatorT>(std::forward<ArgsT>(args)...);
+    } else {
+      if (!profiling_enabled() && !GpuMemoryTracker::requested() &&
+          !gpu_partition::SmPartitions::requested()) {
+        return Fragment::make_operator<OperatorT>(std::forward<ArgsT>(args)...);
+      }
+      auto op = Fragment::make_operator<ProfiledOperator<OperatorT>>(std::forward<ArgsT>(args)...);
+      if (profiling_enabled()) { op->set_profiles(&operator_profiles_); }
+      return op;
+    }
+  }
+
   inline void add_flow(const std::shared_ptr<holoscan::Operator>& upstream_op,
                        const std::shared_ptr<holoscan::Operator>& downstream_op) override {
     this->add_flow(upstream_op, downstream_op, {});
@@ -47,15 +76,67 @@ class BenchmarkedApplication : public holoscan::Application {
       conditioned_nodes_.insert(upstream_op);
       upstream_op->add_arg(make_condition<holoscan::CountCondition>(num_source_messages_));
     }
+
+    pin_operator(upstream_op);
+    pin_operator(downstream_op);
   }
 
   inline void run() override {
+    // Share the GPU, before any CUDA context is created
+    const char* mps_percentage_str = std::getenv("HOLOSCAN_MPS_THREAD_PERCENTAGE");
+    if (mps_percentage_str) { gpu_partition::set_mps_thread_percentage(mps_percentage_str); }
+    // The green contexts outlive the run, the operators' streams may still be in use
+    if (gpu_partition::SmPartitions::requested()) {
+      gpu_partition::SmPartitions::instance().create(std::getenv("HOLOSCAN_GPU_SM_PARTITIONS"));
+    }
+
+    // Fix the CPUs and the priority of the scheduler worker threads, which inherit them
+    const char* cpu_affinity_str = std::getenv("HOLOSCAN_CPU_AFFINITY");
+    if (cpu_affinity_str) { run_environment::set_cpu_affinity(cpu_affinity_str); }
+    const char* fifo_priority_str = std::getenv("HOLOSCAN_SCHED_FIFO_PRIORITY");
+    int fifo_priority = 0;
+    if (fifo_priority_str && run_environment::set_fifo_priority(std::stoi(fifo_priority_str))) {
+      fifo_priority = std::stoi(fifo_priority_str);
+    }
+    const char* pinned_operators_str = std::getenv("HOLOSCAN_PINNED_OPERATORS");
+    if (pinned_operators_str) {
+      pinned_operators_ = run_environment::parse_names(pinned_operators_str);
+    }
+
+    // Attribute the GPU memory allocations, from the initialization of the graph on
+    const char* gpu_memory_file = std::getenv("HOLOSCAN_GPU_MEMORY_FILE");
+    const bool track_gpu_memory = gpu_memory_file && GpuMemoryTracker::instance().start();
+
     // Enable data flow tracking
     if (!data_flow_tracker()) track();
     tracker_ = data_flow_tracker();
     // Get the data flow tracking logging file name from the environment variable
     const char* flow_tracking_log_file = std::getenv("HOLOSCAN_FLOW_TRACKING_LOG_FILE");
-    if (!flow_tracking_log_file) {
+    // Aggregate the latencies in-process instead when a histogram file is given
+    const char* histogram_file = std::getenv("HOLOSCAN_FLOW_HISTOGRAM_FILE");
+    // The online WCRT analysis needs the histograms as well, even if they aren't written
+    const char* wcrt_deadline_str = std::getenv("HOLOSCAN_WCRT_DEADLINE_MS");
+    if (histogram_file || wcrt_deadline_str) {
+      const char* period_str = std::getenv("HOLOSCAN_FLOW_HISTOGRAM_PERIOD");
+      const auto period = std::chrono::seconds(period_str ? std::stoi(period_str) : 10);
+      histograms_ = std::make_unique<FlowHistograms>(histogram_file ? histogram_file : "", period);
+      if (!histograms_->start()) { histograms_.reset(); }
+    }
+    if (histograms_ && wcrt_deadline_str) {
+      const char* percentile_str = std::getenv("HOLOSCAN_WCRT_PERCENTILE");
+      const char* period_str = std::getenv("HOLOSCAN_WCRT_PERIOD_MS");
+      const char* wcrt_file = std::getenv("HOLOSCAN_WCRT_FILE");
+      wcrt_monitor_ = std::make_unique<WcrtMonitor>(
+          *histograms_,
+          std::chrono::microseconds(static_cast<int64_t>(std::stod(wcrt_deadline_str) * 1000)),
+          percentile_str ? std::stod(percentile_str) : 1.0,
+          std::chrono::milliseconds(period_str ? std::stoi(period_str) : 1000),
+          wcrt_file ? wcrt_file : "");
+      wcrt_monitor_->start();
+    }
+    if (histograms_) {
+      tracker_->enable_logging(histograms_->log_file());
+    } else if (!flow_tracking_log_file) {
       tracker_->enable_logging();
     } else {
       tracker_->enable_logging(flow_tracking_log_file);
@@ -89,17 +170,82 @@ class BenchmarkedApplication : public holoscan::Application {
     } else {
       holoscan::Fragment::scheduler(
           holoscan::Fragment::make_scheduler<holoscan::GreedyScheduler>("greedy-scheduler"));
+      if (!pinned_operators_.empty()) {
+        HOLOSCAN_LOG_WARN("Operators can only be pinned with the multithread or eventbased "
+                          "scheduler, HOLOSCAN_PINNED_OPERATORS is ignored");
+        pinned_operators_.clear();
+      }
     }
+    run_environment::record(std::getenv("HOLOSCAN_RUN_ENVIRONMENT_FILE"),
+                            scheduler_str ? scheduler_str : "greedy",
+                            fifo_priority,
+                            pinned_operators_);
 
     // Call the parent's class' run()
     holoscan::Application::run();
+
+    if (histograms_) {
+      tracker_->end_logging();
+      histograms_->stop();
+      if (wcrt_monitor_) { wcrt_monitor_->stop(); }
+    }
+    if (profiling_enabled()) { print_operator_profiles(); }
+    if (track_gpu_memory) { GpuMemoryTracker::instance().stop(gpu_memory_file); }
   }
   ~BenchmarkedApplication() { /*tracker_->print();*/
   }
 
  private:
+  /// Give the operator a dedicated worker thread if it's in HOLOSCAN_PINNED_OPERATORS
+  void pin_operator(const std::shared_ptr<holoscan::Operator>& op) {
+    if (pinned_operators_.find(op->name()) == pinned_operators_.end() ||
+        pinned_nodes_.find(op) != pinned_nodes_.end()) {
+      return;
+    }
+    if (!pinned_thread_pool_) {
+      pinned_thread_pool_ = make_thread_pool("pinned_operators", pinned_operators_.size());
+    }
+    pinned_thread_pool_->add(op, true);
+    pinned_nodes_.insert(op);
+  }
+
+  static bool profiling_enabled() {
+    const char* profiling_str = std::getenv("HOLOSCAN_OPERATOR_PROFILING");
+    return profiling_str && profiling_str[0] != '\0' && std::string(profiling_str) != "0";
+  }
+
+  /// CPU time of compute() and, with the histograms, the queue wait before it
+  void print_operator_profiles() {
+    auto ms = [](uint64_t us) { return us / 1000.; };
+    operator_profiles_.for_each([&](const std::string& op_name, const LatencyHistogram& cpu_time) {
+      const LatencyHistogram* queue_wait = histograms_ ? histograms_->queue_wait(op_name) : nullptr;
+      HOLOSCAN_LOG_INFO(
+          "Operator {}: {} computes, CPU time (ms) avg {:.3f}, p50 {:.3f}, p99 {:.3f}, max {:.3f}"
+          "{}",
+          op_name,
+          cpu_time.count(),
+          cpu_time.mean() / 1000.,
+          ms(cpu_time.percentile(0.5)),
+          ms(cpu_time.percentile(0.99)),
+          ms(cpu_time.max()),
+          queue_wait
+              ? fmt::format(", queue wait (ms) avg {:.3f}, p50 {:.3f}, p99 {:.3f}, max {:.3f}",
+                            queue_wait->mean() / 1000.,
+                            ms(queue_wait->percentile(0.5)),
+                            ms(queue_wait->percentile(0.99)),
+                            ms(queue_wait->max()))
+              : std::string());
+    });
+  }
+
   holoscan::DataFlowTracker* tracker_ = nullptr;
+  std::unique_ptr<FlowHistograms> histograms_;
+  std::unique_ptr<WcrtMonitor> wcrt_monitor_;
+  OperatorProfiles operator_profiles_;
   std::unordered_set<std::shared_ptr<holoscan::Operator>> conditioned_nodes_;
+  std::set<std::string> pinned_operators_;
+  std::unordered_set<std::shared_ptr<holoscan::Operator>> pinned_nodes_;
+  std::shared_ptr<holoscan::ThreadPool> pinned_thread_pool_;
   int num_source_messages_ = 100;
 };
 
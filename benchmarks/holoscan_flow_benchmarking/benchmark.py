@@ -14,6 +14,7 @@
 # limitations under the License.
 
 import argparse
+import json
 import logging
 import os
 import subprocess
@@ -31,6 +32,16 @@ logging.basicConfig(format="%(asctime)s %(levelname)s: %(message)s", level=loggi
 stop_gpu_monitoring = False
 stop_gpu_monitoring_lock = threading.Lock()
 
+# statistic of a sweep configuration compared by each --sweep-objective, and whether lower is
+# better
+SWEEP_OBJECTIVES = {
+    "mean": ("mean_ms", True),
+    "p99": ("p99_ms", True),
+    "p99_9": ("p99_9_ms", True),
+    "max": ("max_ms", True),
+    "throughput": ("throughput_fps", False),
+}
+
 
 def monitor_gpu(gpu_uuids, filename):
     logger.info("Monitoring GPU utilization in a separate thread")
@@ -85,6 +96,229 @@ def run_command(app_launch_command, env):
         sys.exit(1)
 
 
+def sweep_configurations(schedulers, worker_threads, instance_counts):
+    """(scheduler, worker threads, instances, tag) of each configuration of a sweep
+
+    The greedy scheduler has a single worker thread, so it is run once per instance count.
+    """
+    configurations = []
+    for instances in instance_counts:
+        for scheduler in schedulers:
+            for num_worker_threads in [1] if scheduler == "greedy" else worker_threads:
+                tag = f"{scheduler}-w{num_worker_threads}-i{instances}"
+                configurations.append((scheduler, num_worker_threads, instances, tag))
+    return configurations
+
+
+def summarize_configuration(log_directory, tag, runs, instances):
+    """Latency and throughput statistics of a configuration from its final histogram files
+
+    The latency statistics are those of the worst path of the worst instance, the mean is over
+    all messages. The throughput is the message rate of the slowest path, summed over the
+    instances and averaged over the runs. Returns None if no histogram file was written.
+    """
+    stats = {"max_ms": 0.0, "p99_9_ms": 0.0, "p99_ms": 0.0}
+    total_ms = 0.0
+    total_count = 0
+    run_throughputs = []
+    for i in range(1, runs + 1):
+        run_throughput = 0.0
+        for j in range(1, instances + 1):
+            filename = os.path.join(log_directory, f"histogram_{tag}_{i}_{j}.json")
+            try:
+                with open(filename) as f:
+                    report = json.load(f)
+            except (OSError, ValueError):
+                logger.warning(f"Histogram file {filename} is missing or incomplete")
+                continue
+            paths = [path for path in report["paths"] if path["count"] > 0]
+            if not paths:
+                continue
+            for path in paths:
+                for key in stats:
+                    stats[key] = max(stats[key], path[key])
+                total_ms += path["mean_ms"] * path["count"]
+                total_count += path["count"]
+            if report["elapsed_s"] > 0:
+                run_throughput += min(path["count"] for path in paths) / report["elapsed_s"]
+        run_throughputs.append(run_throughput)
+    if total_count == 0:
+        return None
+    stats["mean_ms"] = total_ms / total_count
+    stats["throughput_fps"] = sum(run_throughputs) / len(run_throughputs)
+    return stats
+
+
+def summarize_sweep(log_directory, configurations, runs, objective):
+    """Log the statistics of each sweep configuration and recommend one per instance count
+
+    The summary is also written to sweep_summary.json in the log directory.
+    """
+    key, lower_is_better = SWEEP_OBJECTIVES[objective]
+    results = []
+    for scheduler, num_worker_threads, instances, tag in configurations:
+        stats = summarize_configuration(log_directory, tag, runs, instances)
+        if stats is None:
+            logger.warning(f"No latencies were recorded with the {tag} configuration")
+            continue
+        results.append(
+            {
+                "scheduler": scheduler,
+                "worker_threads": num_worker_threads,
+                "instances": instances,
+                **stats,
+            }
+        )
+
+    logger.info("Sweep results (latency of the worst path in ms, throughput in messages/s):")
+    logger.info(
+        f"{'scheduler':>12} {'workers':>8} {'instances':>10} {'mean':>9} {'p99':>9} "
+        f"{'p99.9':>9} {'max':>9} {'throughput':>11}"
+    )
+    for result in results:
+        logger.info(
+            f"{result['scheduler']:>12} {result['worker_threads']:>8} {result['instances']:>10} "
+            f"{result['mean_ms']:>9.3f} {result['p99_ms']:>9.3f} {result['p99_9_ms']:>9.3f} "
+            f"{result['max_ms']:>9.3f} {result['throughput_fps']:>11.1f}"
+        )
+
+    # A tie on the objective goes to the higher throughput, then to the lower p99 latency
+    recommended = {}
+    for result in results:
+        best = recommended.get(result["instances"])
+        rank = (
+            result[key] if lower_is_better else -result[key],
+            -result["throughput_fps"],
+            result["p99_ms"],
+        )
+        if best is None or rank < best[0]:
+            recommended[result["instances"]] = (rank, result)
+    for instances, (_, result) in sorted(recommended.items()):
+        logger.info(
+            f"Recommended configuration for {instances} instance(s) by {objective}: "
+            f"{result['scheduler']} scheduler with {result['worker_threads']} worker thread(s), "
+            f"{key} {result[key]:.3f}"
+        )
+
+    with open(os.path.join(log_directory, "sweep_summary.json"), "w") as f:
+        json.dump(
+            {
+                "objective": objective,
+                "configurations": results,
+                "recommended": {
+                    str(instances): result for instances, (_, result) in recommended.items()
+                },
+            },
+            f,
+            indent=2,
+        )
+    return recommended
+
+
+def run_configuration(
+    args, env, app_launch_command, log_directory, scheduler, num_worker_threads, instances, tag
+):
+    """Run args.runs runs of instances application instances with one scheduler configuration
+
+    The output files of the configuration are named <kind>_<tag>_<run-id>_<instance-id>. Returns
+    the names of the log and GPU utilization files.
+    """
+    # Copy env so that the scheduler of a configuration does not leak into the next one
+    env = env.copy()
+    if scheduler == "multithread":
+        env["HOLOSCAN_SCHEDULER"] = scheduler
+        env["HOLOSCAN_MULTITHREAD_WORKER_THREADS"] = str(num_worker_threads)
+    elif scheduler == "eventbased":
+        env["HOLOSCAN_SCHEDULER"] = scheduler
+        env["HOLOSCAN_EVENTBASED_WORKER_THREADS"] = str(num_worker_threads)
+    elif scheduler == "greedy":
+        # Greedy is the default scheduler of the applications
+        env.pop("HOLOSCAN_SCHEDULER", None)
+    else:
+        logger.error(f"Unsupported scheduler {scheduler}")
+        sys.exit(1)
+    log_files = []
+    gpu_utilization_log_files = []
+    for i in range(1, args.runs + 1):
+        logger.info(f"Run {i} started for {tag} scheduler.")
+        instance_threads = []
+        if args.monitor_gpu:
+            gpu_utilization_logfile_name = (
+                "gpu_utilization_" + tag + "_" + str(i) + ".csv"
+            )
+            fully_qualified_gpu_utilization_logfile_name = os.path.abspath(
+                os.path.join(log_directory, gpu_utilization_logfile_name)
+            )
+            gpu_monitoring_thread = threading.Thread(
+                target=monitor_gpu,
+                args=(args.gpu, fully_qualified_gpu_utilization_logfile_name),
+            )
+            gpu_monitoring_thread.start()
+        for j in range(1, instances + 1):
+            # prepend the full path of the log directory before log file name
+            # log file name format: logger_<scheduler>_<run-id>_<instance-id>.log
+            logfile_name = "logger_" + tag + "_" + str(i) + "_" + str(j) + ".log"
+            fully_qualified_log_filename = os.path.abspath(
+                os.path.join(log_directory, logfile_name)
+            )
+            # make a copy of env before sending to the thread
+            env_copy = env.copy()
+            if args.histogram:
+                # histogram file name format: histogram_<scheduler>_<run-id>_<instance-id>.json
+                logfile_name = "histogram_" + tag + "_" + str(i) + "_" + str(j) + ".json"
+                fully_qualified_log_filename = os.path.abspath(
+                    os.path.join(log_directory, logfile_name)
+                )
+                env_copy["HOLOSCAN_FLOW_HISTOGRAM_FILE"] = fully_qualified_log_filename
+                env_copy["HOLOSCAN_FLOW_HISTOGRAM_PERIOD"] = str(args.histogram_period)
+                if args.wcrt_deadline is not None:
+                    # WCRT file name format: wcrt_<scheduler>_<run-id>_<instance-id>.json
+                    env_copy["HOLOSCAN_WCRT_DEADLINE_MS"] = str(args.wcrt_deadline)
+                    env_copy["HOLOSCAN_WCRT_PERCENTILE"] = str(args.wcrt_percentile)
+                    env_copy["HOLOSCAN_WCRT_FILE"] = os.path.abspath(
+                        os.path.join(
+                            log_directory,
+                            "wcrt_" + tag + "_" + str(i) + "_" + str(j) + ".json",
+                        )
+                    )
+            else:
+                env_copy["HOLOSCAN_FLOW_TRACKING_LOG_FILE"] = fully_qualified_log_filename
+            if args.track_gpu_memory:
+                # GPU memory file name format: gpu_memory_<scheduler>_<run-id>_<instance-id>.json
+                env_copy["HOLOSCAN_GPU_MEMORY_FILE"] = os.path.abspath(
+                    os.path.join(
+                        log_directory,
+                        "gpu_memory_" + tag + "_" + str(i) + "_" + str(j) + ".json",
+                    )
+                )
+            # affinity, governor and GPU clocks of the run:
+            # run_environment_<scheduler>_<run-id>_<instance-id>.json
+            env_copy["HOLOSCAN_RUN_ENVIRONMENT_FILE"] = os.path.abspath(
+                os.path.join(
+                    log_directory,
+                    "run_environment_" + tag + "_" + str(i) + "_" + str(j) + ".json",
+                )
+            )
+            instance_thread = threading.Thread(
+                target=run_command, args=(app_launch_command, env_copy)
+            )
+            instance_thread.start()
+            instance_threads.append(instance_thread)
+            log_files.append(logfile_name)
+        for each_thread in instance_threads:
+            each_thread.join()
+        if args.monitor_gpu:
+            stop_gpu_monitoring_lock.acquire()
+            global stop_gpu_monitoring
+            stop_gpu_monitoring = True
+            stop_gpu_monitoring_lock.release()
+            gpu_monitoring_thread.join()
+            gpu_utilization_log_files.append(gpu_utilization_logfile_name)
+        logger.info(f"Run {i} completed for {tag} scheduler.")
+        time.sleep(1)  # cool down period
+    return log_files, gpu_utilization_log_files
+
+
 def main():
     parser = argparse.ArgumentParser(
         description="Run performance evaluation for a HoloHub application",
@@ -186,6 +420,113 @@ assignment in Holoscan's Inference operator.",
     parser.add_argument(
         "-u", "--monitor_gpu", action="store_true", help="enable this to monitor GPU utilization"
     )
+    parser.add_argument(
+        "--histogram",
+        action="store_true",
+        help="aggregate the latencies of each path in-process and write their percentiles\n"
+        "as JSON instead of logging every message (C++ applications only)",
+    )
+    parser.add_argument(
+        "--cpus",
+        type=str,
+        default=None,
+        help="CPU list, e.g. 2-5,8, the scheduler worker threads are restricted to\n"
+        "(C++ applications only)",
+    )
+    parser.add_argument(
+        "--sched-fifo",
+        type=int,
+        default=None,
+        help="SCHED_FIFO priority (1-99) of the scheduler worker threads, requires CAP_SYS_NICE\n"
+        "(C++ applications only)",
+    )
+    parser.add_argument(
+        "--pin-operators",
+        type=str,
+        default=None,
+        help="comma-separated names of operators given a dedicated worker thread each, with the\n"
+        "multithread or eventbased scheduler (C++ applications only)",
+    )
+    parser.add_argument(
+        "--mps-thread-percentage",
+        type=int,
+        default=None,
+        help="percentage (1-100) of the SMs the application may use under MPS, set as\n"
+        "CUDA_MPS_ACTIVE_THREAD_PERCENTAGE of every instance",
+    )
+    parser.add_argument(
+        "--gpu-sm-partitions",
+        type=str,
+        default=None,
+        help="SM partitions like '32:replayer,holoviz;16:recorder', each a number of SMs and\n"
+        "the operators running on them in a CUDA green context, the other operators run on\n"
+        "the remaining SMs (C++ applications only, CUDA 12.4)",
+    )
+    parser.add_argument(
+        "--profile-operators",
+        action="store_true",
+        help="wrap the compute() of each operator in an NVTX range and log the CPU time of\n"
+        "each operator, and the GPU time of GXF codelets using CudaStreamHandler, at exit\n"
+        "(C++ applications only)",
+    )
+    parser.add_argument(
+        "--track-gpu-memory",
+        action="store_true",
+        help="attribute the device and pinned memory allocations to operators with CUPTI and\n"
+        "write the current and peak usage of each to JSON at exit (C++ applications only)",
+    )
+    parser.add_argument(
+        "--histogram-period",
+        type=int,
+        default=10,
+        help="period in seconds of the JSON dumps with --histogram (default: 10)",
+    )
+    parser.add_argument(
+        "--wcrt-deadline",
+        type=float,
+        default=None,
+        help="end-to-end deadline in ms: continuously compute the worst-case response time\n"
+        "bound of every path from the measured execution times, warn when it exceeds the\n"
+        "deadline and write it as JSON, implies --histogram (C++ applications only)",
+    )
+    parser.add_argument(
+        "--wcrt-percentile",
+        type=float,
+        default=1.0,
+        help="fraction of the execution times of an operator below its worst-case execution\n"
+        "time with --wcrt-deadline (default: 1.0, the observed maximum)",
+    )
+    parser.add_argument(
+        "--sweep",
+        action="store_true",
+        help="run every scheduler of --sched with every worker thread count of\n"
+        "--sweep-worker-threads and instance count of --sweep-instances, and recommend the\n"
+        "configuration with the lowest --sweep-objective, implies --histogram\n"
+        "(C++ applications only)",
+    )
+    parser.add_argument(
+        "--sweep-worker-threads",
+        type=int,
+        nargs="+",
+        default=[1, 2, 4, 8],
+        help="worker thread counts of the multithread and eventbased schedulers in a sweep\n"
+        "(default: 1 2 4 8)",
+    )
+    parser.add_argument(
+        "--sweep-instances",
+        type=int,
+        nargs="+",
+        default=None,
+        help="instance counts in a sweep, a configuration is recommended for each\n"
+        "(default: the --instances count)",
+    )
+    parser.add_argument(
+        "--sweep-objective",
+        choices=list(SWEEP_OBJECTIVES),
+        default="p99",
+        help="latency statistic of the worst path a sweep minimizes, or throughput to maximize\n"
+        "the messages per second of all instances (default: p99)",
+    )
     parser.add_argument("--level", type=str, default="INFO", help="Logging verbosity level")
 
     args = parser.parse_args()
@@ -199,6 +540,14 @@ assignment in Holoscan's Inference operator.",
             "num_worker_threads is ignored as multithread or eventbased scheduler is not used"
         )
 
+    if args.wcrt_deadline is not None and not args.histogram:
+        logger.info("--wcrt-deadline aggregates the latencies in-process, enabling --histogram")
+        args.histogram = True
+
+    if args.sweep and not args.histogram:
+        logger.info("--sweep compares the in-process latency histograms, enabling --histogram")
+        args.histogram = True
+
     log_directory = None
     if args.log_directory is None:
         # create a timestamped directory: log_directory_<timestamp> in the current directory
@@ -235,66 +584,50 @@ assignment in Holoscan's Inference operator.",
     if args.num_messages != 100:
         env["HOLOSCAN_NUM_SOURCE_MESSAGES"] = str(args.num_messages)
 
+    if args.profile_operators:
+        env["HOLOSCAN_OPERATOR_PROFILING"] = "1"
+
+    if args.cpus:
+        env["HOLOSCAN_CPU_AFFINITY"] = args.cpus
+    if args.sched_fifo:
+        env["HOLOSCAN_SCHED_FIFO_PRIORITY"] = str(args.sched_fifo)
+    if args.pin_operators:
+        env["HOLOSCAN_PINNED_OPERATORS"] = args.pin_operators
+    if args.mps_thread_percentage:
+        env["HOLOSCAN_MPS_THREAD_PERCENTAGE"] = str(args.mps_thread_percentage)
+    if args.gpu_sm_partitions:
+        env["HOLOSCAN_GPU_SM_PARTITIONS"] = args.gpu_sm_partitions
+
     if args.run_command == "":
         app_launch_command = "./run launch " + args.holohub_application + " " + args.language
     else:
         app_launch_command = args.run_command
 
+    if args.sweep:
+        configurations = sweep_configurations(
+            args.sched, args.sweep_worker_threads, args.sweep_instances or [args.instances]
+        )
+    else:
+        configurations = [
+            (scheduler, args.num_worker_threads, args.instances, scheduler)
+            for scheduler in args.sched
+        ]
+
     log_files = []
     gpu_utilization_log_files = []
-    for scheduler in args.sched:
-        if scheduler == "multithread":
-            env["HOLOSCAN_SCHEDULER"] = scheduler
-            env["HOLOSCAN_MULTITHREAD_WORKER_THREADS"] = str(args.num_worker_threads)
-        elif scheduler == "eventbased":
-            env["HOLOSCAN_SCHEDULER"] = scheduler
-            env["HOLOSCAN_EVENTBASED_WORKER_THREADS"] = str(args.num_worker_threads)
-        elif scheduler != "greedy":
-            logger.error("Unsupported scheduler ", scheduler)
-            sys.exit(1)
-        # No need to set the scheduler for greedy scheduler
-        for i in range(1, args.runs + 1):
-            logger.info(f"Run {i} started for {scheduler} scheduler.")
-            instance_threads = []
-            if args.monitor_gpu:
-                gpu_utilization_logfile_name = (
-                    "gpu_utilization_" + scheduler + "_" + str(i) + ".csv"
-                )
-                fully_qualified_gpu_utilization_logfile_name = os.path.abspath(
-                    os.path.join(log_directory, gpu_utilization_logfile_name)
-                )
-                gpu_monitoring_thread = threading.Thread(
-                    target=monitor_gpu,
-                    args=(args.gpu, fully_qualified_gpu_utilization_logfile_name),
-                )
-                gpu_monitoring_thread.start()
-            for j in range(1, args.instances + 1):
-                # prepend the full path of the log directory before log file name
-                # log file name format: logger_<scheduler>_<run-id>_<instance-id>.log
-                logfile_name = "logger_" + scheduler + "_" + str(i) + "_" + str(j) + ".log"
-                fully_qualified_log_filename = os.path.abspath(
-                    os.path.join(log_directory, logfile_name)
-                )
-                # make a copy of env before sending to the thread
-                env_copy = env.copy()
-                env_copy["HOLOSCAN_FLOW_TRACKING_LOG_FILE"] = fully_qualified_log_filename
-                instance_thread = threading.Thread(
-                    target=run_command, args=(app_launch_command, env_copy)
-                )
-                instance_thread.start()
-                instance_threads.append(instance_thread)
-                log_files.append(logfile_name)
-            for each_thread in instance_threads:
-                each_thread.join()
-            if args.monitor_gpu:
-                stop_gpu_monitoring_lock.acquire()
-                global stop_gpu_monitoring
-                stop_gpu_monitoring = True
-                stop_gpu_monitoring_lock.release()
-                gpu_monitoring_thread.join()
-                gpu_utilization_log_files.append(gpu_utilization_logfile_name)
-            logger.info(f"Run {i} completed for {scheduler} scheduler.")
-            time.sleep(1)  # cool down period
+    for scheduler, num_worker_threads, instances, tag in configurations:
+        config_log_files, config_gpu_files = run_configuration(
+            args,
+            env,
+            app_launch_command,
+            log_directory,
+            scheduler,
+            num_worker_threads,
+            instances,
+            tag,
+        )
+        log_files += config_log_files
+        gpu_utilization_log_files += config_gpu_files
     logger.info("****************************************************************")
     logger.info("Evaluation completed.")
     logger.info("****************************************************************")
@@ -322,6 +655,9 @@ assignment in Holoscan's Inference operator.",
         logger.error("Some log files are missing. Please check the log directory.")
         sys.exit(1)
 
+    if args.sweep:
+        summarize_sweep(log_directory, configurations, args.runs, args.sweep_objective)
+
 
 if __name__ == "__main__":
     main()
@@ -22,6 +22,12 @@ class BenchmarkedApplication(Application):
 
     def run(self):
         print("Running benchmarked application")
+
+        # Limit the SMs of the process under MPS, before its CUDA context is created
+        mps_percentage = os.environ.get("HOLOSCAN_MPS_THREAD_PERCENTAGE", None)
+        if mps_percentage:
+            os.environ["CUDA_MPS_ACTIVE_THREAD_PERCENTAGE"] = mps_percentage
+
         tracker = self.track()
 
         # Get the data flow tracking log file from environment variable
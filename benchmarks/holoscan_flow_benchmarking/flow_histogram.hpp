@@ -0,0 +1,405 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef HOLOSCAN_FLOW_HISTOGRAM
+#define HOLOSCAN_FLOW_HISTOGRAM
+
+#include <fcntl.h>
+#include <stdlib.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "holoscan/holoscan.hpp"
+
+/**
+ * Latency histogram with the log-linear bucketing of HDR histograms: 2048 linear sub-buckets per
+ * power of two, i.e. a relative error below 0.1%, over 1 us to 2^32 us (about 71 minutes).
+ * Recording is lock-free and can run concurrently with reading.
+ */
+class LatencyHistogram {
+ public:
+  static constexpr int kSubBucketBits = 11;
+  static constexpr uint64_t kSubBucketCount = 1ULL << kSubBucketBits;
+  static constexpr uint64_t kSubBucketHalfCount = kSubBucketCount / 2;
+  static constexpr uint64_t kMaxValue = (1ULL << 32) - 1;
+  static constexpr size_t kBucketCount = (32 - kSubBucketBits + 2) * kSubBucketHalfCount;
+
+  LatencyHistogram() {
+    for (auto& count : counts_) { count.store(0, std::memory_order_relaxed); }
+  }
+
+  void record(uint64_t value_us) {
+    value_us = std::min(value_us, kMaxValue);
+    counts_[index_of(value_us)].fetch_add(1, std::memory_order_relaxed);
+    sum_.fetch_add(value_us, std::memory_order_relaxed);
+    uint64_t min = min_.load(std::memory_order_relaxed);
+    while (value_us < min && !min_.compare_exchange_weak(min, value_us)) {}
+    uint64_t max = max_.load(std::memory_order_relaxed);
+    while (value_us > max && !max_.compare_exchange_weak(max, value_us)) {}
+    // released last so that a reader seeing the count also sees the bucket
+    count_.fetch_add(1, std::memory_order_release);
+  }
+
+  uint64_t count() const { return count_.load(std::memory_order_acquire); }
+  uint64_t min() const { return count() ? min_.load(std::memory_order_relaxed) : 0; }
+  uint64_t max() const { return max_.load(std::memory_order_relaxed); }
+  double mean() const {
+    const uint64_t count = this->count();
+    return count ? static_cast<double>(sum_.load(std::memory_order_relaxed)) / count : 0.;
+  }
+
+  /// @return the value below which the given fraction of the recorded values fall, in us
+  uint64_t percentile(double fraction) const {
+    const uint64_t count = this->count();
+    if (count == 0) { return 0; }
+    const uint64_t target = std::max<uint64_t>(1, static_cast<uint64_t>(fraction * count + 0.5));
+    uint64_t cumulative = 0;
+    for (size_t index = 0; index < kBucketCount; ++index) {
+      cumulative += counts_[index].load(std::memory_order_relaxed);
+      if (cumulative >= target) { return std::min(highest_equivalent(index), max()); }
+    }
+    return max();
+  }
+
+ private:
+  static size_t index_of(uint64_t value) {
+    const int power = 63 - __builtin_clzll(value | (kSubBucketCount - 1));
+    const int bucket = power - (kSubBucketBits - 1);
+    const uint64_t sub_bucket = value >> bucket;
+    if (bucket == 0) { return sub_bucket; }
+    return (bucket + 1) * kSubBucketHalfCount + (sub_bucket - kSubBucketHalfCount);
+  }
+
+  static uint64_t highest_equivalent(size_t index) {
+    if (index < kSubBucketCount) { return index; }
+    const int bucket = index / kSubBucketHalfCount - 1;
+    const uint64_t sub_bucket = index % kSubBucketHalfCount + kSubBucketHalfCount;
+    return ((sub_bucket + 1) << bucket) - 1;
+  }
+
+  std::array<std::atomic<uint64_t>, kBucketCount> counts_;
+  std::atomic<uint64_t> count_{0};
+  std::atomic<uint64_t> sum_{0};
+  std::atomic<uint64_t> min_{UINT64_MAX};
+  std::atomic<uint64_t> max_{0};
+};
+
+/**
+ * In-process aggregation of the data flow tracking log into one LatencyHistogram per path.
+ *
+ * The tracker's log is written to a FIFO instead of a file and parsed by a thread as it is
+ * written, so that no per-message log is kept. The percentiles of every path are written as JSON
+ * to `output_file` every `period`, and a final time by `stop()`, unless `output_file` is empty.
+ * The queue wait of each operator, from the publication of a message by the upstream operator to
+ * its reception, and its execution time, from the reception to the publication, are aggregated as
+ * well.
+ */
+class FlowHistograms {
+ public:
+  FlowHistograms(std::string output_file, std::chrono::seconds period)
+      : output_file_(std::move(output_file)), period_(period) {}
+
+  ~FlowHistograms() { stop(); }
+
+  /// Start the parser and the periodic dumps, then the tracker should log to `log_file()`
+  bool start() {
+    char fifo_dir[] = "/tmp/holoscan_flow_XXXXXX";
+    if (mkdtemp(fifo_dir) == nullptr) {
+      HOLOSCAN_LOG_ERROR("Failed to create a directory for the flow tracking FIFO");
+      return false;
+    }
+    fifo_path_ = std::string(fifo_dir) + "/flow_tracking.log";
+    if (mkfifo(fifo_path_.c_str(), 0600) != 0) {
+      HOLOSCAN_LOG_ERROR("Failed to create the flow tracking FIFO {}", fifo_path_);
+      return false;
+    }
+    start_time_ = std::chrono::steady_clock::now();
+    parser_thread_ = std::thread(&FlowHistograms::parse, this);
+    if (output_file_.empty()) { return true; }
+    dump_thread_ = std::thread([this] {
+      std::unique_lock<std::mutex> lock(stop_mutex_);
+      while (!stop_condition_.wait_for(lock, period_, [this] { return stopped_; })) {
+        dump(false);
+      }
+    });
+    return true;
+  }
+
+  const std::string& log_file() const { return fifo_path_; }
+
+  /// @return the queue wait histogram of the operator, nullptr if it received no message
+  const LatencyHistogram* queue_wait(const std::string& op_name) {
+    std::lock_guard<std::mutex> lock(paths_mutex_);
+    auto queue_wait = queue_waits_.find(op_name);
+    return queue_wait == queue_waits_.end() ? nullptr : queue_wait->second.get();
+  }
+
+  /// @return the execution time histogram of the operator, nullptr if it published no message
+  const LatencyHistogram* execution_time(const std::string& op_name) {
+    std::lock_guard<std::mutex> lock(paths_mutex_);
+    auto execution_time = execution_times_.find(op_name);
+    return execution_time == execution_times_.end() ? nullptr : execution_time->second.get();
+  }
+
+  /// @return the operators of every path seen so far, with the latency histogram of the path
+  std::vector<std::pair<std::vector<std::string>, const LatencyHistogram*>> paths() {
+    std::lock_guard<std::mutex> lock(paths_mutex_);
+    std::vector<std::pair<std::vector<std::string>, const LatencyHistogram*>> paths;
+    for (const auto& [path, histogram] : paths_) {
+      paths.emplace_back(path_operators_[path], histogram.get());
+    }
+    return paths;
+  }
+
+  /// Wait for the log to be parsed, after the tracker closed it, and write the final summary
+  void stop() {
+    if (!parser_thread_.joinable()) { return; }
+    // Unblocks the parser if the tracker never opened the FIFO
+    const int fd = open(fifo_path_.c_str(), O_WRONLY | O_NONBLOCK);
+    if (fd >= 0) { close(fd); }
+    parser_thread_.join();
+    {
+      std::lock_guard<std::mutex> lock(stop_mutex_);
+      stopped_ = true;
+    }
+    stop_condition_.notify_all();
+    if (dump_thread_.joinable()) {
+      dump_thread_.join();
+      dump(true);
+    }
+    std::filesystem::remove_all(std::filesystem::path(fifo_path_).parent_path());
+  }
+
+  /// Escape a string for a JSON dump
+  static std::string escape(const std::string& text) {
+    std::string escaped;
+    for (char c : text) {
+      if (c == '"' || c == '\\') { escaped += '\\'; }
+      escaped += c;
+    }
+    return escaped;
+  }
+
+  /// Replace the file atomically so that a reader never sees a partial dump
+  static void write_atomically(const std::string& file, const std::string& content) {
+    const std::string temporary_file = file + ".tmp";
+    {
+      std::ofstream output(temporary_file, std::ios::trunc);
+      output << content;
+      if (!output) {
+        HOLOSCAN_LOG_ERROR("Failed to write {}", temporary_file);
+        return;
+      }
+    }
+    std::error_code error;
+    std::filesystem::rename(temporary_file, file, error);
+    if (error) { HOLOSCAN_LOG_ERROR("Failed to write {}: {}", file, error.message()); }
+  }
+
+ private:
+  struct Hop {
+    std::string op;
+    uint64_t receive;
+    uint64_t publish;
+  };
+
+  // Path of (operator,receive timestamp,publish timestamp) hops separated by "->", as written by
+  // the tracker and parsed by log_parser.py
+  static bool parse_line(const std::string& line, std::vector<Hop>& hops) {
+    hops.clear();
+    size_t begin = 0;
+    while ((begin = line.find('(', begin)) != std::string::npos) {
+      const size_t end = line.find(')', begin);
+      const size_t first = line.find(',', begin);
+      const size_t second = first == std::string::npos ? first : line.find(',', first + 1);
+      if (end == std::string::npos || second == std::string::npos || second > end) { return false; }
+      try {
+        hops.push_back({line.substr(begin + 1, first - begin - 1),
+                        std::stoull(line.substr(first + 1, second - first - 1)),
+                        std::stoull(line.substr(second + 1, end - second - 1))});
+      } catch (const std::exception&) { return false; }
+      begin = end + 1;
+    }
+    return !hops.empty();
+  }
+
+  void parse() {
+    std::ifstream log(fifo_path_);
+    std::unordered_map<std::string, LatencyHistogram*> cache;
+    std::unordered_map<std::string, std::pair<LatencyHistogram*, uint64_t>> receptions;
+    std::unordered_map<std::string, std::pair<LatencyHistogram*, uint64_t>> executions;
+    std::vector<Hop> hops;
+    Hop last_source{}, last_sink{};
+    std::string last_path;
+    for (std::string line; std::getline(log, line);) {
+      if (line.empty() || line[0] != '(' || !parse_line(line, hops)) { continue; }
+
+      std::string path = hops.front().op;
+      for (size_t hop = 1; hop < hops.size(); ++hop) { path += "," + hops[hop].op; }
+      // Same message logged again, see log_parser.is_same_path()
+      const Hop& source = hops.front();
+      const Hop& sink = hops.back();
+      const uint64_t sink_delta = std::max(sink.publish, last_sink.publish) -
+                                  std::min(sink.publish, last_sink.publish);
+      const bool same_message = path == last_path && source.receive == last_source.receive &&
+                                source.publish == last_source.publish && sink_delta <= 20;
+      last_path = path;
+      last_source = source;
+      last_sink = sink;
+      if (same_message || sink.publish < source.receive) { continue; }
+
+      auto cached = cache.find(path);
+      if (cached == cache.end()) {
+        std::lock_guard<std::mutex> lock(paths_mutex_);
+        auto& histogram = paths_[path];
+        if (!histogram) {
+          histogram = std::make_unique<LatencyHistogram>();
+          for (const Hop& hop : hops) { path_operators_[path].push_back(hop.op); }
+        }
+        cached = cache.emplace(path, histogram.get()).first;
+      }
+      cached->second->record(sink.publish - source.receive);
+
+      // A reception is logged once per path going through the operator
+      for (size_t hop = 1; hop < hops.size(); ++hop) {
+        auto reception = receptions.find(hops[hop].op);
+        if (reception == receptions.end()) {
+          std::lock_guard<std::mutex> lock(paths_mutex_);
+          auto& histogram = queue_waits_[hops[hop].op];
+          if (!histogram) { histogram = std::make_unique<LatencyHistogram>(); }
+          reception = receptions.emplace(hops[hop].op, std::make_pair(histogram.get(), 0)).first;
+        }
+        auto& [histogram, last_receive] = reception->second;
+        if (hops[hop].receive == last_receive || hops[hop].receive < hops[hop - 1].publish) {
+          continue;
+        }
+        last_receive = hops[hop].receive;
+        histogram->record(hops[hop].receive - hops[hop - 1].publish);
+      }
+
+      for (const Hop& hop : hops) {
+        auto execution = executions.find(hop.op);
+        if (execution == executions.end()) {
+          std::lock_guard<std::mutex> lock(paths_mutex_);
+          auto& histogram = execution_times_[hop.op];
+          if (!histogram) { histogram = std::make_unique<LatencyHistogram>(); }
+          execution = executions.emplace(hop.op, std::make_pair(histogram.get(), 0)).first;
+        }
+        auto& [histogram, last_receive] = execution->second;
+        if (hop.receive == last_receive || hop.publish < hop.receive) { continue; }
+        last_receive = hop.receive;
+        histogram->record(hop.publish - hop.receive);
+      }
+    }
+  }
+
+  static void write_stats(std::ostream& json, const LatencyHistogram& histogram) {
+    auto ms = [](uint64_t us) { return us / 1000.; };
+    json << "\"count\": " << histogram.count() << ", \"min_ms\": " << ms(histogram.min())
+         << ", \"mean_ms\": " << histogram.mean() / 1000.
+         << ", \"p50_ms\": " << ms(histogram.percentile(0.5))
+         << ", \"p90_ms\": " << ms(histogram.percentile(0.9))
+         << ", \"p99_ms\": " << ms(histogram.percentile(0.99))
+         << ", \"p99_9_ms\": " << ms(histogram.percentile(0.999))
+         << ", \"max_ms\": " << ms(histogram.max()) << "}";
+  }
+
+  void dump(bool final) {
+    const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start_time_;
+    std::ostringstream json;
+    json.setf(std::ios::fixed);
+    json.precision(3);
+    json << "{\n  \"final\": " << (final ? "true" : "false") << ",\n  \"elapsed_s\": "
+         << elapsed.count() << ",\n  \"paths\": [";
+    {
+      std::lock_guard<std::mutex> lock(paths_mutex_);
+      const char* separator = "";
+      for (const auto& [path, histogram] : paths_) {
+        auto ms = [](uint64_t us) { return us / 1000.; };
+        json << separator << "\n    {\"path\": \"" << escape(path) << "\", ";
+        write_stats(json, *histogram);
+        separator = ",";
+        if (final) {
+          HOLOSCAN_LOG_INFO(
+              "Path {}: {} messages, latency (ms) p50 {:.3f}, p90 {:.3f}, p99 {:.3f}, "
+              "p99.9 {:.3f}, max {:.3f}",
+              path,
+              histogram->count(),
+              ms(histogram->percentile(0.5)),
+              ms(histogram->percentile(0.9)),
+              ms(histogram->percentile(0.99)),
+              ms(histogram->percentile(0.999)),
+              ms(histogram->max()));
+        }
+      }
+      json << "\n  ],\n  \"queue_waits\": [";
+      separator = "";
+      for (const auto& [op_name, histogram] : queue_waits_) {
+        json << separator << "\n    {\"operator\": \"" << escape(op_name) << "\", ";
+        write_stats(json, *histogram);
+        separator = ",";
+      }
+      json << "\n  ],\n  \"execution_times\": [";
+      separator = "";
+      for (const auto& [op_name, histogram] : execution_times_) {
+        json << separator << "\n    {\"operator\": \"" << escape(op_name) << "\", ";
+        write_stats(json, *histogram);
+        separator = ",";
+      }
+    }
+    json << "\n  ]\n}\n";
+    write_atomically(output_file_, json.str());
+  }
+
+  std::string output_file_;
+  std::chrono::seconds period_;
+  std::string fifo_path_;
+  std::chrono::steady_clock::time_point start_time_;
+
+  // The histogram maps only grow, histograms are recorded without the lock through the parser's
+  // caches
+  std::mutex paths_mutex_;
+  std::map<std::string, std::unique_ptr<LatencyHistogram>> paths_;
+  std::map<std::string, std::unique_ptr<LatencyHistogram>> queue_waits_;
+  std::map<std::string, std::unique_ptr<LatencyHistogram>> execution_times_;
+  std::map<std::string, std::vector<std::string>> path_operators_;
+
+  std::thread parser_thread_;
+  std::thread dump_thread_;
+  std::mutex stop_mutex_;
+  std::condition_variable stop_condition_;
+  bool stopped_ = false;
+};
+
+#endif /* HOLOSCAN_FLOW_HISTOGRAM */
@@ -0,0 +1,327 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef HOLOSCAN_GPU_MEMORY_TRACKER
+#define HOLOSCAN_GPU_MEMORY_TRACKER
+
+#include <cxxabi.h>
+#include <dlfcn.h>
+#include <execinfo.h>
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstdlib>
+#include <map>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "holoscan/holoscan.hpp"
+
+#include "flow_histogram.hpp"
+
+#if __has_include(<cupti.h>)
+#include <cupti.h>
+#include <generated_cuda_meta.h>
+#define HOLOSCAN_GPU_MEMORY_TRACKER_CUPTI 1
+#endif
+
+/**
+ * Attribution of the device and pinned host memory allocations of the application to their
+ * owner, with the current and peak usage of each.
+ *
+ * The allocations are hooked with CUPTI callbacks on the CUDA driver API, which every allocation
+ * of the runtime API (`cudaMalloc()`, `cudaMallocAsync()`, `cudaMallocHost()`, ...), of GXF
+ * allocators, TensorRT or MatX ends up in, however the CUDA runtime is linked. CUPTI is loaded
+ * at runtime, so that applications don't link it. The owner of an allocation is the operator
+ * whose initialize(), start(), compute() or stop() made it, as set by OwnerScope, otherwise the
+ * function which called the CUDA API, e.g. the `initialize()` of a `BlockMemoryPool` reserving its
+ * blocks or the `start()` of a GXF codelet.
+ */
+class GpuMemoryTracker {
+ public:
+  enum Kind { kDevice, kPinned, kKinds };
+
+  /// Sets the owner of the allocations made by the calling thread while in scope
+  class OwnerScope {
+   public:
+    explicit OwnerScope(const std::string& owner) : previous_(current_owner()) {
+      current_owner() = &owner;
+    }
+    ~OwnerScope() { current_owner() = previous_; }
+
+   private:
+    const std::string* previous_;
+  };
+
+  static GpuMemoryTracker& instance() {
+    static GpuMemoryTracker tracker;
+    return tracker;
+  }
+
+  /// @return whether HOLOSCAN_GPU_MEMORY_FILE is set
+  static bool requested() { return std::getenv("HOLOSCAN_GPU_MEMORY_FILE") != nullptr; }
+
+  /// Subscribe to the allocations of the process, false if CUPTI is not available
+  bool start() {
+#ifdef HOLOSCAN_GPU_MEMORY_TRACKER_CUPTI
+    for (const char* library : {"libcupti.so", "libcupti.so.12", "libcupti.so.11.8",
+                                "/usr/local/cuda/extras/CUPTI/lib64/libcupti.so"}) {
+      if ((cupti_ = dlopen(library, RTLD_NOW | RTLD_LOCAL))) { break; }
+    }
+    if (!cupti_) {
+      HOLOSCAN_LOG_ERROR("Failed to load CUPTI, GPU memory is not tracked: {}", dlerror());
+      return false;
+    }
+    subscribe_ = reinterpret_cast<decltype(&cuptiSubscribe)>(dlsym(cupti_, "cuptiSubscribe"));
+    enable_callback_ =
+        reinterpret_cast<decltype(&cuptiEnableCallback)>(dlsym(cupti_, "cuptiEnableCallback"));
+    unsubscribe_ =
+        reinterpret_cast<decltype(&cuptiUnsubscribe)>(dlsym(cupti_, "cuptiUnsubscribe"));
+    if (!subscribe_ || !enable_callback_ || !unsubscribe_ ||
+        subscribe_(&subscriber_, &GpuMemoryTracker::callback, this) != CUPTI_SUCCESS) {
+      HOLOSCAN_LOG_ERROR("Failed to subscribe to CUPTI callbacks, GPU memory is not tracked");
+      return false;
+    }
+    for (const CUpti_CallbackId id : {
+             CUPTI_DRIVER_TRACE_CBID_cuMemAlloc_v2,
+             CUPTI_DRIVER_TRACE_CBID_cuMemAllocPitch_v2,
+             CUPTI_DRIVER_TRACE_CBID_cuMemAllocManaged,
+             CUPTI_DRIVER_TRACE_CBID_cuMemAllocAsync,
+             CUPTI_DRIVER_TRACE_CBID_cuMemAllocAsync_ptsz,
+             CUPTI_DRIVER_TRACE_CBID_cuMemFree_v2,
+             CUPTI_DRIVER_TRACE_CBID_cuMemFreeAsync,
+             CUPTI_DRIVER_TRACE_CBID_cuMemFreeAsync_ptsz,
+             CUPTI_DRIVER_TRACE_CBID_cuMemAllocHost_v2,
+             CUPTI_DRIVER_TRACE_CBID_cuMemHostAlloc,
+             CUPTI_DRIVER_TRACE_CBID_cuMemFreeHost,
+             CUPTI_DRIVER_TRACE_CBID_cuMemHostRegister_v2,
+             CUPTI_DRIVER_TRACE_CBID_cuMemHostUnregister,
+         }) {
+      enable_callback_(1, subscriber_, CUPTI_CB_DOMAIN_DRIVER_API, id);
+    }
+    return true;
+#else
+    HOLOSCAN_LOG_ERROR("Built without CUPTI headers, GPU memory is not tracked");
+    return false;
+#endif
+  }
+
+  /// Stop tracking, log the usage of every owner and write it as JSON to `output_file`
+  void stop(const std::string& output_file) {
+#ifdef HOLOSCAN_GPU_MEMORY_TRACKER_CUPTI
+    if (!subscriber_) { return; }
+    unsubscribe_(subscriber_);
+    subscriber_ = nullptr;
+#endif
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto mb = [](uint64_t bytes) { return bytes / (1024. * 1024.); };
+    std::vector<std::pair<std::string, Usage>> owners(owners_.begin(), owners_.end());
+    std::sort(owners.begin(), owners.end(), [](const auto& a, const auto& b) {
+      return a.second.peak[kDevice] + a.second.peak[kPinned] >
+             b.second.peak[kDevice] + b.second.peak[kPinned];
+    });
+
+    std::ostringstream json;
+    json.setf(std::ios::fixed);
+    json.precision(3);
+    json << "{\n  \"device_peak_mb\": " << mb(total_.peak[kDevice])
+         << ",\n  \"pinned_peak_mb\": " << mb(total_.peak[kPinned]) << ",\n  \"owners\": [";
+    const char* separator = "";
+    for (const auto& [owner, usage] : owners) {
+      HOLOSCAN_LOG_INFO(
+          "GPU memory of {}: device {:.3f} MB (peak {:.3f} MB), pinned {:.3f} MB (peak {:.3f} MB), "
+          "{} allocations",
+          owner,
+          mb(usage.current[kDevice]),
+          mb(usage.peak[kDevice]),
+          mb(usage.current[kPinned]),
+          mb(usage.peak[kPinned]),
+          usage.allocations);
+      json << separator << "\n    {\"owner\": \"" << FlowHistograms::escape(owner)
+           << "\", \"device_current_mb\": " << mb(usage.current[kDevice])
+           << ", \"device_peak_mb\": " << mb(usage.peak[kDevice])
+           << ", \"pinned_current_mb\": " << mb(usage.current[kPinned])
+           << ", \"pinned_peak_mb\": " << mb(usage.peak[kPinned])
+           << ", \"allocations\": " << usage.allocations << "}";
+      separator = ",";
+    }
+    json << "\n  ]\n}\n";
+    HOLOSCAN_LOG_INFO("GPU memory peak: device {:.3f} MB, pinned {:.3f} MB",
+                      mb(total_.peak[kDevice]),
+                      mb(total_.peak[kPinned]));
+    if (!output_file.empty()) { FlowHistograms::write_atomically(output_file, json.str()); }
+  }
+
+ private:
+  struct Usage {
+    std::array<uint64_t, kKinds> current{};
+    std::array<uint64_t, kKinds> peak{};
+    uint64_t allocations = 0;
+  };
+
+  struct Allocation {
+    Usage* owner;
+    uint64_t size;
+    Kind kind;
+  };
+
+  static const std::string*& current_owner() {
+    thread_local const std::string* owner = nullptr;
+    return owner;
+  }
+
+  /// @return the first function of the call stack outside of CUPTI and CUDA
+  static std::string caller() {
+    void* frames[32];
+    const int count = backtrace(frames, 32);
+    bool in_cuda = false;
+    for (int frame = 0; frame < count; ++frame) {
+      Dl_info info{};
+      if (!dladdr(frames[frame], &info) || !info.dli_fname) { continue; }
+      const std::string object = info.dli_fname;
+      const bool cuda = object.find("libcupti") != std::string::npos ||
+                        object.find("libcuda") != std::string::npos;
+      in_cuda = in_cuda || cuda;
+      // frames in the tracker itself, before the CUDA ones
+      if (!in_cuda || cuda) { continue; }
+      if (!info.dli_sname) { return object.substr(object.find_last_of('/') + 1); }
+      // runtime API linked statically
+      if (std::string(info.dli_sname).rfind("cuda", 0) == 0) { continue; }
+      int status = 0;
+      char* demangled = abi::__cxa_demangle(info.dli_sname, nullptr, nullptr, &status);
+      std::string name = status == 0 ? demangled : info.dli_sname;
+      free(demangled);
+      // drop the arguments
+      return name.substr(0, name.find('('));
+    }
+    return "<unknown>";
+  }
+
+  void allocated(uintptr_t address, uint64_t size, Kind kind) {
+    const std::string* owner = current_owner();
+    // resolved before locking, the backtrace is slow
+    const std::string name = owner ? *owner : caller();
+    std::lock_guard<std::mutex> lock(mutex_);
+    Usage& usage = owners_[name];
+    usage.current[kind] += size;
+    usage.peak[kind] = std::max(usage.peak[kind], usage.current[kind]);
+    ++usage.allocations;
+    total_.current[kind] += size;
+    total_.peak[kind] = std::max(total_.peak[kind], total_.current[kind]);
+    allocations_[address] = {&usage, size, kind};
+  }
+
+  void freed(uintptr_t address) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto allocation = allocations_.find(address);
+    // allocated before the tracking started
+    if (allocation == allocations_.end()) { return; }
+    const auto& [usage, size, kind] = allocation->second;
+    usage->current[kind] -= size;
+    total_.current[kind] -= size;
+    allocations_.erase(allocation);
+  }
+
+#ifdef HOLOSCAN_GPU_MEMORY_TRACKER_CUPTI
+  static void CUPTIAPI callback(void* user_data, CUpti_CallbackDomain domain,
+                               CUpti_CallbackId id, const void* data) {
+    const auto* info = static_cast<const CUpti_CallbackData*>(data);
+    if (domain != CUPTI_CB_DOMAIN_DRIVER_API || info->callbackSite != CUPTI_API_EXIT) { return; }
+    if (*static_cast<const CUresult*>(info->functionReturnValue) != CUDA_SUCCESS) { return; }
+    auto* tracker = static_cast<GpuMemoryTracker*>(user_data);
+    const void* params = info->functionParams;
+    auto address = [](auto pointer) { return reinterpret_cast<uintptr_t>(pointer); };
+    switch (id) {
+      case CUPTI_DRIVER_TRACE_CBID_cuMemAlloc_v2: {
+        const auto* p = static_cast<const cuMemAlloc_v2_params*>(params);
+        tracker->allocated(*p->dptr, p->bytesize, kDevice);
+        break;
+      }
+      case CUPTI_DRIVER_TRACE_CBID_cuMemAllocPitch_v2: {
+        const auto* p = static_cast<const cuMemAllocPitch_v2_params*>(params);
+        tracker->allocated(*p->dptr, *p->pPitch * p->Height, kDevice);
+        break;
+      }
+      case CUPTI_DRIVER_TRACE_CBID_cuMemAllocManaged: {
+        const auto* p = static_cast<const cuMemAllocManaged_params*>(params);
+        tracker->allocated(*p->dptr, p->bytesize, kDevice);
+        break;
+      }
+      case CUPTI_DRIVER_TRACE_CBID_cuMemAllocAsync: {
+        const auto* p = static_cast<const cuMemAllocAsync_params*>(params);
+        tracker->allocated(*p->dptr, p->bytesize, kDevice);
+        break;
+      }
+      case CUPTI_DRIVER_TRACE_CBID_cuMemAllocAsync_ptsz: {
+        const auto* p = static_cast<const cuMemAllocAsync_ptsz_params*>(params);
+        tracker->allocated(*p->dptr, p->bytesize, kDevice);
+        break;
+      }
+      case CUPTI_DRIVER_TRACE_CBID_cuMemFree_v2:
+        tracker->freed(static_cast<const cuMemFree_v2_params*>(params)->dptr);
+        break;
+      case CUPTI_DRIVER_TRACE_CBID_cuMemFreeAsync:
+        tracker->freed(static_cast<const cuMemFreeAsync_params*>(params)->dptr);
+        break;
+      case CUPTI_DRIVER_TRACE_CBID_cuMemFreeAsync_ptsz:
+        tracker->freed(static_cast<const cuMemFreeAsync_ptsz_params*>(params)->dptr);
+        break;
+      case CUPTI_DRIVER_TRACE_CBID_cuMemAllocHost_v2: {
+        const auto* p = static_cast<const cuMemAllocHost_v2_params*>(params);
+        tracker->allocated(address(*p->pp), p->bytesize, kPinned);
+        break;
+      }
+      case CUPTI_DRIVER_TRACE_CBID_cuMemHostAlloc: {
+        const auto* p = static_cast<const cuMemHostAlloc_params*>(params);
+        tracker->allocated(address(*p->pp), p->bytesize, kPinned);
+        break;
+      }
+      case CUPTI_DRIVER_TRACE_CBID_cuMemHostRegister_v2: {
+        const auto* p = static_cast<const cuMemHostRegister_v2_params*>(params);
+        tracker->allocated(address(p->p), p->bytesize, kPinned);
+        break;
+      }
+      case CUPTI_DRIVER_TRACE_CBID_cuMemFreeHost:
+        tracker->freed(address(static_cast<const cuMemFreeHost_params*>(params)->p));
+        break;
+      case CUPTI_DRIVER_TRACE_CBID_cuMemHostUnregister:
+        tracker->freed(address(static_cast<const cuMemHostUnregister_params*>(params)->p));
+        break;
+      default:
+        break;
+    }
+  }
+
+  void* cupti_ = nullptr;
+  decltype(&cuptiSubscribe) subscribe_ = nullptr;
+  decltype(&cuptiEnableCallback) enable_callback_ = nullptr;
+  decltype(&cuptiUnsubscribe) unsubscribe_ = nullptr;
+  CUpti_SubscriberHandle subscriber_ = nullptr;
+#endif
+
+  std::mutex mutex_;
+  std::map<std::string, Usage> owners_;
+  Usage total_;
+  std::unordered_map<uintptr_t, Allocation> allocations_;
+};
+
+#endif /* HOLOSCAN_GPU_MEMORY_TRACKER */
@@ -0,0 +1,268 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef HOLOSCAN_GPU_PARTITION
+#define HOLOSCAN_GPU_PARTITION
+
+#include <dlfcn.h>
+
+#include <cstdlib>
+#include <map>
+#include <memory>
+#include <set>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "holoscan/holoscan.hpp"
+
+#include "run_environment.hpp"
+
+#if __has_include(<cuda.h>)
+#include <cuda.h>
+#if CUDA_VERSION >= 12040
+#define HOLOSCAN_GPU_PARTITION_GREEN_CONTEXTS 1
+#endif
+#endif
+
+/**
+ * Share of the GPU given to a benchmarked application, so that a best-effort application or group
+ * of operators cannot inflate the latency of a critical one, see the "GPU partitioning" section of
+ * the README:
+ * - HOLOSCAN_MPS_THREAD_PERCENTAGE: CUDA_MPS_ACTIVE_THREAD_PERCENTAGE of the process. Under MPS,
+ *   each process, e.g. each fragment of a distributed application or each application, is limited
+ *   to this percentage of the SMs.
+ * - HOLOSCAN_GPU_SM_PARTITIONS: partitions like "32:replayer,format_converter;16:recorder", each
+ *   a number of SMs and the operators running on them. The other operators run on the remaining
+ *   SMs. Each partition is a CUDA green context which the operators' initialize(), start(),
+ *   compute() and stop() make current, so that their streams and kernels stay on its SMs.
+ */
+namespace gpu_partition {
+
+/// Limit the SMs of the process under MPS, before its CUDA context is created
+inline bool set_mps_thread_percentage(const std::string& percentage) {
+  int value = 0;
+  try {
+    value = std::stoi(percentage);
+  } catch (const std::exception&) {}
+  if (value < 1 || value > 100) {
+    HOLOSCAN_LOG_ERROR("Invalid MPS thread percentage '{}', expected 1-100", percentage);
+    return false;
+  }
+  setenv("CUDA_MPS_ACTIVE_THREAD_PERCENTAGE", std::to_string(value).c_str(), 1);
+  HOLOSCAN_LOG_INFO("MPS active thread percentage {}%", value);
+  return true;
+}
+
+/// SM partitions of the device, each a green context bound to a set of operators
+class SmPartitions {
+ public:
+  /// Makes the partition of an operator current on the calling thread while in scope
+  class ContextScope {
+   public:
+    explicit ContextScope(const std::string& op_name) {
+#ifdef HOLOSCAN_GPU_PARTITION_GREEN_CONTEXTS
+      auto& partitions = instance();
+      CUcontext context = partitions.context(op_name);
+      if (context == nullptr || partitions.get_current_(&previous_) != CUDA_SUCCESS) { return; }
+      active_ = partitions.set_current_(context) == CUDA_SUCCESS;
+#endif
+    }
+    ~ContextScope() {
+#ifdef HOLOSCAN_GPU_PARTITION_GREEN_CONTEXTS
+      if (active_) { instance().set_current_(previous_); }
+#endif
+    }
+
+   private:
+#ifdef HOLOSCAN_GPU_PARTITION_GREEN_CONTEXTS
+    CUcontext previous_ = nullptr;
+    bool active_ = false;
+#endif
+  };
+
+  static SmPartitions& instance() {
+    static SmPartitions partitions;
+    return partitions;
+  }
+
+  /// @return whether HOLOSCAN_GPU_SM_PARTITIONS is set
+  static bool requested() {
+    const char* partitions = std::getenv("HOLOSCAN_GPU_SM_PARTITIONS");
+    return partitions && partitions[0] != '\0';
+  }
+
+  /**
+   * Split the SMs of the current device according to `spec`, e.g. "32:a,b;16:c", and create a
+   * green context for each partition and one for the remaining SMs. False if the driver doesn't
+   * support green contexts (CUDA 12.4) or the device doesn't have enough SMs.
+   */
+  bool create(const std::string& spec) {
+#ifdef HOLOSCAN_GPU_PARTITION_GREEN_CONTEXTS
+    std::vector<std::pair<unsigned int, std::set<std::string>>> requested;
+    std::stringstream list(spec);
+    for (std::string partition; std::getline(list, partition, ';');) {
+      const size_t colon = partition.find(':');
+      int sms = 0;
+      try {
+        sms = std::stoi(partition.substr(0, colon));
+      } catch (const std::exception&) {}
+      if (colon == std::string::npos || sms <= 0) {
+        HOLOSCAN_LOG_ERROR("Invalid SM partition '{}', expected <SMs>:<operator>,...", partition);
+        return false;
+      }
+      requested.emplace_back(sms, run_environment::parse_names(partition.substr(colon + 1)));
+    }
+    if (requested.empty() || !load()) { return false; }
+
+    CUdevice device;
+    CUdevResource available;
+    if (init_(0) != CUDA_SUCCESS || device_get_(&device, device_) != CUDA_SUCCESS ||
+        get_resource_(device, &available, CU_DEV_RESOURCE_TYPE_SM) != CUDA_SUCCESS) {
+      HOLOSCAN_LOG_ERROR("Failed to query the SMs of GPU {}", device_);
+      return false;
+    }
+    const unsigned int total_sms = available.sm.smCount;
+
+    // Carve the partitions one after the other, the last remainder runs the other operators
+    std::vector<CUdevResource> resources;
+    for (const auto& [sms, operators] : requested) {
+      CUdevResource group;
+      CUdevResource remaining;
+      unsigned int groups = 1;
+      if (split_(&group, &groups, &available, &remaining, 0, sms) != CUDA_SUCCESS || groups != 1 ||
+          remaining.sm.smCount == 0) {
+        HOLOSCAN_LOG_ERROR("Failed to split {} SMs out of the {} left on GPU {}",
+                           sms,
+                           available.sm.smCount,
+                           device_);
+        return false;
+      }
+      resources.push_back(group);
+      available = remaining;
+    }
+    resources.push_back(available);
+
+    for (size_t index = 0; index < resources.size(); ++index) {
+      CUdevResourceDesc desc;
+      Partition partition{};
+      if (generate_desc_(&desc, &resources[index], 1) != CUDA_SUCCESS ||
+          green_ctx_create_(&partition.green_ctx, desc, device, CU_GREEN_CTX_DEFAULT_STREAM) !=
+              CUDA_SUCCESS ||
+          ctx_from_green_ctx_(&partition.context, partition.green_ctx) != CUDA_SUCCESS) {
+        HOLOSCAN_LOG_ERROR("Failed to create the green context of SM partition {}", index);
+        destroy();
+        return false;
+      }
+      partition.sms = resources[index].sm.smCount;
+      std::string operators = "(others)";
+      if (index < requested.size()) {
+        partition.operators = requested[index].second;
+        operators = fmt::format("{}", fmt::join(partition.operators, ","));
+      }
+      partitions_.push_back(partition);
+      HOLOSCAN_LOG_INFO("SM partition {} of GPU {}: {} of {} SMs, operators {}",
+                        index,
+                        device_,
+                        partition.sms,
+                        total_sms,
+                        operators);
+    }
+    return true;
+#else
+    HOLOSCAN_LOG_ERROR("Built without CUDA 12.4 headers, SM partitions are not available");
+    return false;
+#endif
+  }
+
+  /// Destroy the green contexts, once the operators are done with them
+  void destroy() {
+#ifdef HOLOSCAN_GPU_PARTITION_GREEN_CONTEXTS
+    for (const auto& partition : partitions_) { green_ctx_destroy_(partition.green_ctx); }
+    partitions_.clear();
+#endif
+  }
+
+ private:
+#ifdef HOLOSCAN_GPU_PARTITION_GREEN_CONTEXTS
+  struct Partition {
+    CUgreenCtx green_ctx = nullptr;
+    CUcontext context = nullptr;
+    unsigned int sms = 0;
+    std::set<std::string> operators;
+  };
+
+  /// @return the context of the partition running `op_name`, null without partitions
+  CUcontext context(const std::string& op_name) const {
+    if (partitions_.empty()) { return nullptr; }
+    for (const auto& partition : partitions_) {
+      if (partition.operators.count(op_name)) { return partition.context; }
+    }
+    return partitions_.back().context;
+  }
+
+  /// Load the driver API at runtime, so that applications don't link libcuda
+  bool load() {
+    if (!(driver_ = dlopen("libcuda.so.1", RTLD_NOW | RTLD_LOCAL))) {
+      HOLOSCAN_LOG_ERROR("Failed to load the CUDA driver: {}", dlerror());
+      return false;
+    }
+    init_ = reinterpret_cast<decltype(&cuInit)>(dlsym(driver_, "cuInit"));
+    device_get_ = reinterpret_cast<decltype(&cuDeviceGet)>(dlsym(driver_, "cuDeviceGet"));
+    get_resource_ = reinterpret_cast<decltype(&cuDeviceGetDevResource)>(
+        dlsym(driver_, "cuDeviceGetDevResource"));
+    split_ = reinterpret_cast<decltype(&cuDevSmResourceSplitByCount)>(
+        dlsym(driver_, "cuDevSmResourceSplitByCount"));
+    generate_desc_ = reinterpret_cast<decltype(&cuDevResourceGenerateDesc)>(
+        dlsym(driver_, "cuDevResourceGenerateDesc"));
+    green_ctx_create_ =
+        reinterpret_cast<decltype(&cuGreenCtxCreate)>(dlsym(driver_, "cuGreenCtxCreate"));
+    green_ctx_destroy_ =
+        reinterpret_cast<decltype(&cuGreenCtxDestroy)>(dlsym(driver_, "cuGreenCtxDestroy"));
+    ctx_from_green_ctx_ =
+        reinterpret_cast<decltype(&cuCtxFromGreenCtx)>(dlsym(driver_, "cuCtxFromGreenCtx"));
+    get_current_ = reinterpret_cast<decltype(&cuCtxGetCurrent)>(dlsym(driver_, "cuCtxGetCurrent"));
+    set_current_ = reinterpret_cast<decltype(&cuCtxSetCurrent)>(dlsym(driver_, "cuCtxSetCurrent"));
+    if (!init_ || !device_get_ || !get_resource_ || !split_ || !generate_desc_ ||
+        !green_ctx_create_ || !green_ctx_destroy_ || !ctx_from_green_ctx_ || !get_current_ ||
+        !set_current_) {
+      HOLOSCAN_LOG_ERROR("The CUDA driver doesn't support green contexts, it needs CUDA 12.4");
+      return false;
+    }
+    return true;
+  }
+
+  void* driver_ = nullptr;
+  /// The first device of CUDA_VISIBLE_DEVICES, which the operators run on
+  int device_ = 0;
+  decltype(&cuInit) init_ = nullptr;
+  decltype(&cuDeviceGet) device_get_ = nullptr;
+  decltype(&cuDeviceGetDevResource) get_resource_ = nullptr;
+  decltype(&cuDevSmResourceSplitByCount) split_ = nullptr;
+  decltype(&cuDevResourceGenerateDesc) generate_desc_ = nullptr;
+  decltype(&cuGreenCtxCreate) green_ctx_create_ = nullptr;
+  decltype(&cuGreenCtxDestroy) green_ctx_destroy_ = nullptr;
+  decltype(&cuCtxFromGreenCtx) ctx_from_green_ctx_ = nullptr;
+  decltype(&cuCtxGetCurrent) get_current_ = nullptr;
+  decltype(&cuCtxSetCurrent) set_current_ = nullptr;
+  std::vector<Partition> partitions_;
+#endif
+};
+
+}  // namespace gpu_partition
+
+#endif /* HOLOSCAN_GPU_PARTITION */
@@ -0,0 +1,111 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef HOLOSCAN_OPERATOR_PROFILER
+#define HOLOSCAN_OPERATOR_PROFILER
+
+#include <nvtx3/nvToolsExt.h>
+
+#include <chrono>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+
+#include "holoscan/holoscan.hpp"
+
+#include "flow_histogram.hpp"
+#include "gpu_memory_tracker.hpp"
+#include "gpu_partition.hpp"
+
+/// CPU time of the compute() calls of each profiled operator
+class OperatorProfiles {
+ public:
+  /// @return the histogram of the operator, valid as long as the profiles
+  LatencyHistogram* cpu_time(const std::string& op_name) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto& histogram = cpu_times_[op_name];
+    if (!histogram) { histogram = std::make_unique<LatencyHistogram>(); }
+    return histogram.get();
+  }
+
+  template <typename FuncT>
+  void for_each(FuncT func) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (const auto& [op_name, histogram] : cpu_times_) { func(op_name, *histogram); }
+  }
+
+ private:
+  std::mutex mutex_;
+  std::map<std::string, std::unique_ptr<LatencyHistogram>> cpu_times_;
+};
+
+/**
+ * Operator wrapping each compute() of OperatorT in an NVTX range named after the operator and
+ * recording its CPU time, if given profiles. The NVTX ranges let Nsight Systems attribute the GPU
+ * work launched by compute() to the operator (`nsys profile -t cuda,nvtx`). The GPU memory
+ * allocated by the operator is attributed to it as well, see GpuMemoryTracker, and its GPU work
+ * runs on its SM partition, if any, see gpu_partition::SmPartitions.
+ */
+template <typename OperatorT>
+class ProfiledOperator : public OperatorT {
+ public:
+  using OperatorT::OperatorT;
+
+  void set_profiles(OperatorProfiles* profiles) { profiles_ = profiles; }
+
+  void initialize() override {
+    GpuMemoryTracker::OwnerScope owner(this->name());
+    gpu_partition::SmPartitions::ContextScope partition(this->name());
+    OperatorT::initialize();
+  }
+
+  void start() override {
+    GpuMemoryTracker::OwnerScope owner(this->name());
+    gpu_partition::SmPartitions::ContextScope partition(this->name());
+    OperatorT::start();
+  }
+
+  void stop() override {
+    GpuMemoryTracker::OwnerScope owner(this->name());
+    gpu_partition::SmPartitions::ContextScope partition(this->name());
+    OperatorT::stop();
+  }
+
+  void compute(holoscan::InputContext& op_input, holoscan::OutputContext& op_output,
+               holoscan::ExecutionContext& context) override {
+    GpuMemoryTracker::OwnerScope owner(this->name());
+    gpu_partition::SmPartitions::ContextScope partition(this->name());
+    if (profiles_ == nullptr) {
+      OperatorT::compute(op_input, op_output, context);
+      return;
+    }
+    if (cpu_time_ == nullptr) { cpu_time_ = profiles_->cpu_time(this->name()); }
+    nvtxRangePushA(this->name().c_str());
+    const auto start = std::chrono::steady_clock::now();
+    OperatorT::compute(op_input, op_output, context);
+    const auto end = std::chrono::steady_clock::now();
+    nvtxRangePop();
+    cpu_time_->record(std::chrono::duration_cast<std::chrono::microseconds>(end - start).count());
+  }
+
+ private:
+  OperatorProfiles* profiles_ = nullptr;
+  LatencyHistogram* cpu_time_ = nullptr;
+};
+
+#endif /* HOLOSCAN_OPERATOR_PROFILER */
@@ -0,0 +1,215 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef HOLOSCAN_RUN_ENVIRONMENT
+#define HOLOSCAN_RUN_ENVIRONMENT
+
+#include <sched.h>
+#include <stdio.h>
+
+#include <cerrno>
+#include <cstring>
+#include <fstream>
+#include <set>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "holoscan/holoscan.hpp"
+
+/**
+ * Controls and records the execution environment of a benchmarked application, see the
+ * "Reproducible Runs" section of the README:
+ * - HOLOSCAN_CPU_AFFINITY: CPU list, e.g. "2-5,8", the scheduler worker threads are restricted to
+ * - HOLOSCAN_SCHED_FIFO_PRIORITY: SCHED_FIFO priority (1-99) of the worker threads
+ * - HOLOSCAN_PINNED_OPERATORS: comma separated operators given a dedicated worker thread each
+ * - HOLOSCAN_RUN_ENVIRONMENT_FILE: JSON file the effective environment is written to
+ */
+namespace run_environment {
+
+/// @return the CPUs of a list like "2-5,8", empty if it is invalid
+inline std::vector<int> parse_cpu_list(const std::string& cpu_list) {
+  std::set<int> cpus;
+  std::stringstream ranges(cpu_list);
+  for (std::string range; std::getline(ranges, range, ',');) {
+    try {
+      const size_t dash = range.find('-');
+      const int first = std::stoi(range.substr(0, dash));
+      const int last = dash == std::string::npos ? first : std::stoi(range.substr(dash + 1));
+      if (first < 0 || last < first || last >= CPU_SETSIZE) { return {}; }
+      for (int cpu = first; cpu <= last; ++cpu) { cpus.insert(cpu); }
+    } catch (const std::exception&) { return {}; }
+  }
+  return std::vector<int>(cpus.begin(), cpus.end());
+}
+
+/// @return the comma separated names, trimmed
+inline std::set<std::string> parse_names(const std::string& names) {
+  std::set<std::string> result;
+  std::stringstream list(names);
+  for (std::string name; std::getline(list, name, ',');) {
+    const size_t first = name.find_first_not_of(" \t");
+    if (first == std::string::npos) { continue; }
+    result.insert(name.substr(first, name.find_last_not_of(" \t") - first + 1));
+  }
+  return result;
+}
+
+/**
+ * Restrict the calling thread, and the threads it creates afterwards such as the scheduler
+ * workers, to the CPUs of the list.
+ */
+inline bool set_cpu_affinity(const std::string& cpu_list) {
+  const std::vector<int> cpus = parse_cpu_list(cpu_list);
+  if (cpus.empty()) {
+    HOLOSCAN_LOG_ERROR("Invalid CPU list '{}'", cpu_list);
+    return false;
+  }
+  cpu_set_t cpu_set;
+  CPU_ZERO(&cpu_set);
+  for (int cpu : cpus) { CPU_SET(cpu, &cpu_set); }
+  if (sched_setaffinity(0, sizeof(cpu_set), &cpu_set) != 0) {
+    HOLOSCAN_LOG_ERROR("Failed to set the CPU affinity to '{}': {}", cpu_list,
+                       std::strerror(errno));
+    return false;
+  }
+  return true;
+}
+
+/// Use SCHED_FIFO for the calling thread and the threads it creates afterwards
+inline bool set_fifo_priority(int priority) {
+  sched_param param{};
+  param.sched_priority = priority;
+  if (sched_setscheduler(0, SCHED_FIFO, &param) != 0) {
+    HOLOSCAN_LOG_ERROR(
+        "Failed to set the SCHED_FIFO priority {}: {}, CAP_SYS_NICE or an rtprio limit is needed",
+        priority,
+        std::strerror(errno));
+    return false;
+  }
+  return true;
+}
+
+/// @return the CPUs the calling thread may run on, as a list like "2-5,8"
+inline std::string effective_cpu_list() {
+  cpu_set_t cpu_set;
+  CPU_ZERO(&cpu_set);
+  if (sched_getaffinity(0, sizeof(cpu_set), &cpu_set) != 0) { return std::string(); }
+  std::string cpu_list;
+  for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+    if (!CPU_ISSET(cpu, &cpu_set)) { continue; }
+    int last = cpu;
+    while (last + 1 < CPU_SETSIZE && CPU_ISSET(last + 1, &cpu_set)) { ++last; }
+    if (!cpu_list.empty()) { cpu_list += ","; }
+    cpu_list += last == cpu ? std::to_string(cpu) : fmt::format("{}-{}", cpu, last);
+    cpu = last;
+  }
+  return cpu_list;
+}
+
+inline std::string read_first_line(const std::string& path) {
+  std::ifstream file(path);
+  std::string line;
+  std::getline(file, line);
+  return line;
+}
+
+/// @return the cpufreq governors of the CPUs of the list, e.g. "performance" or "2-3:powersave,..."
+inline std::string cpu_governors(const std::string& cpu_list) {
+  std::string governors;
+  std::string last_governor;
+  for (int cpu : parse_cpu_list(cpu_list)) {
+    std::string governor = read_first_line(
+        fmt::format("/sys/devices/system/cpu/cpu{}/cpufreq/scaling_governor", cpu));
+    if (governor.empty()) { governor = "unknown"; }
+    if (governor == last_governor) { continue; }
+    if (!governors.empty()) { governors += ","; }
+    governors += fmt::format("{}:{}", cpu, governor);
+    last_governor = governor;
+  }
+  // single governor for all, e.g. "performance"
+  if (governors.find(',') == std::string::npos && !governors.empty()) {
+    governors = governors.substr(governors.find(':') + 1);
+  }
+  return governors;
+}
+
+/// @return the current and maximum SM and memory clocks of the GPUs, as reported by nvidia-smi
+inline std::vector<std::string> gpu_clocks() {
+  std::vector<std::string> clocks;
+  FILE* pipe = popen(
+      "nvidia-smi --query-gpu=index,name,clocks.sm,clocks.max.sm,clocks.mem,clocks.max.mem,"
+      "clocks_throttle_reasons.active --format=csv,noheader 2>/dev/null",
+      "r");
+  if (pipe == nullptr) { return clocks; }
+  char line[512];
+  while (fgets(line, sizeof(line), pipe) != nullptr) {
+    std::string clock(line);
+    while (!clock.empty() && (clock.back() == '\n' || clock.back() == '\r')) { clock.pop_back(); }
+    if (!clock.empty()) { clocks.push_back(clock); }
+  }
+  pclose(pipe);
+  return clocks;
+}
+
+inline std::string escape(const std::string& text) {
+  std::string escaped;
+  for (char c : text) {
+    if (c == '"' || c == '\\') { escaped += '\\'; }
+    escaped += c;
+  }
+  return escaped;
+}
+
+/// Log the effective environment and write it to the file as JSON if one is given
+inline void record(const char* file, const std::string& scheduler, int fifo_priority,
+                   const std::set<std::string>& pinned_operators) {
+  const std::string cpu_list = effective_cpu_list();
+  const std::string governors = cpu_governors(cpu_list);
+  const std::vector<std::string> clocks = gpu_clocks();
+  HOLOSCAN_LOG_INFO("Benchmark environment: scheduler {}, CPUs {}, SCHED_FIFO priority {}, "
+                    "governor {}",
+                    scheduler,
+                    cpu_list,
+                    fifo_priority,
+                    governors);
+  for (const auto& clock : clocks) { HOLOSCAN_LOG_INFO("Benchmark environment: GPU {}", clock); }
+  if (file == nullptr) { return; }
+
+  std::ofstream json(file, std::ios::trunc);
+  json << "{\n  \"scheduler\": \"" << escape(scheduler) << "\",\n  \"cpu_affinity\": \""
+       << escape(cpu_list) << "\",\n  \"sched_fifo_priority\": " << fifo_priority
+       << ",\n  \"cpu_governor\": \"" << escape(governors) << "\",\n  \"pinned_operators\": [";
+  const char* separator = "";
+  for (const auto& op_name : pinned_operators) {
+    json << separator << "\"" << escape(op_name) << "\"";
+    separator = ", ";
+  }
+  // index, name, clocks.sm, clocks.max.sm, clocks.mem, clocks.max.mem, throttle reasons
+  json << "],\n  \"gpus\": [";
+  separator = "";
+  for (const auto& clock : clocks) {
+    json << separator << "\n    \"" << escape(clock) << "\"";
+    separator = ",";
+  }
+  json << "\n  ]\n}\n";
+  if (!json) { HOLOSCAN_LOG_ERROR("Failed to write the benchmark environment to {}", file); }
+}
+
+}  // namespace run_environment
+
+#endif /* HOLOSCAN_RUN_ENVIRONMENT */
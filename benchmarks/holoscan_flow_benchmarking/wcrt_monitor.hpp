@@ -0,0 +1,345 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef HOLOSCAN_WCRT_MONITOR
+#define HOLOSCAN_WCRT_MONITOR
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <queue>
+#include <set>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "holoscan/holoscan.hpp"
+
+#include "flow_histogram.hpp"
+
+/**
+ * Online worst-case response time (WCRT) analysis of the running application.
+ *
+ * The application graph is the union of the paths seen by the data flow tracker, and the
+ * worst-case execution time (WCET) of each operator is the `percentile` of its execution times
+ * measured by the tracker, i.e. the observed maximum by default. Every `period`, the analytical
+ * WCRT bound of `tutorials/holoscan_response_time_analysis/computeWCRT.py` is computed from every
+ * root to every leaf of the graph and compared with the deadline, so that an execution time
+ * increase which could make a message late is reported before a message actually is. The bounds
+ * are written as JSON to `output_file`, unless it is empty.
+ */
+class WcrtMonitor {
+ public:
+  using Successors = std::map<std::string, std::set<std::string>>;
+
+  WcrtMonitor(FlowHistograms& histograms, std::chrono::microseconds deadline, double percentile,
+              std::chrono::milliseconds period, std::string output_file)
+      : histograms_(histograms),
+        deadline_(deadline),
+        percentile_(percentile),
+        period_(period),
+        output_file_(std::move(output_file)) {}
+
+  ~WcrtMonitor() { stop(); }
+
+  void start() {
+    thread_ = std::thread([this] {
+      std::unique_lock<std::mutex> lock(stop_mutex_);
+      while (!stop_condition_.wait_for(lock, period_, [this] { return stopped_; })) {
+        update(false);
+      }
+    });
+  }
+
+  /// Stop the periodic analysis, to be called after FlowHistograms::stop() for a final analysis
+  void stop() {
+    if (!thread_.joinable()) { return; }
+    {
+      std::lock_guard<std::mutex> lock(stop_mutex_);
+      stopped_ = true;
+    }
+    stop_condition_.notify_all();
+    thread_.join();
+    update(true);
+  }
+
+  /**
+   * WCRT bound from `source` to `sink` following computeWCRT.py: the longest path, plus the worst
+   * queuing delay at any operator of the graph, where an operator with several successors waits
+   * for the longest path to its immediate post-dominator.
+   *
+   * @return the bound in the unit of `wcet`, nullopt if the graph between source and sink has a
+   * cycle, which the analysis does not cover
+   */
+  static std::optional<uint64_t> response_time_bound(const Successors& successors,
+                                                     const std::map<std::string, uint64_t>& wcet,
+                                                     const std::string& source,
+                                                     const std::string& sink) {
+    // Operators of the paths from source to sink, in topological order
+    std::map<std::string, int> state;  // 1 while visited, 2 once done
+    std::map<std::string, bool> reaches_sink;
+    std::vector<std::string> postorder;
+    bool cyclic = false;
+    std::function<bool(const std::string&)> visit = [&](const std::string& node) {
+      auto& node_state = state[node];
+      if (node_state == 1) { cyclic = true; }
+      if (node_state != 0) { return reaches_sink[node]; }
+      node_state = 1;
+      bool reaches = node == sink;
+      auto next = successors.find(node);
+      if (node != sink && next != successors.end()) {
+        for (const auto& successor : next->second) { reaches = visit(successor) || reaches; }
+      }
+      node_state = 2;
+      reaches_sink[node] = reaches;
+      if (reaches) { postorder.push_back(node); }
+      return reaches;
+    };
+    if (!visit(source) || cyclic) { return cyclic ? std::nullopt : std::optional<uint64_t>(0); }
+
+    Successors graph;
+    for (const auto& node : postorder) {
+      auto next = successors.find(node);
+      if (node == sink || next == successors.end()) { continue; }
+      for (const auto& successor : next->second) {
+        if (reaches_sink[successor]) { graph[node].insert(successor); }
+      }
+    }
+    auto cost = [&wcet](const std::string& node) {
+      auto node_wcet = wcet.find(node);
+      return node_wcet == wcet.end() ? int64_t(0) : static_cast<int64_t>(node_wcet->second);
+    };
+    // Weight of a path: execution time of all its operators but the last one
+    auto weight = [&cost](const std::vector<std::string>& path) {
+      int64_t path_weight = 0;
+      for (size_t hop = 0; hop + 1 < path.size(); ++hop) { path_weight += cost(path[hop]); }
+      return path_weight;
+    };
+
+    // Longest path weight between two operators, -1 if there is no path
+    std::map<std::pair<std::string, std::string>, int64_t> longest_weights;
+    std::function<int64_t(const std::string&, const std::string&)> longest =
+        [&](const std::string& from, const std::string& to) -> int64_t {
+      if (from == to) { return 0; }
+      auto memo = longest_weights.find({from, to});
+      if (memo != longest_weights.end()) { return memo->second; }
+      int64_t best = -1;
+      for (const auto& successor : graph[from]) {
+        const int64_t rest = longest(successor, to);
+        if (rest >= 0) { best = std::max<int64_t>(best, cost(from) + rest); }
+      }
+      longest_weights[{from, to}] = best;
+      return best;
+    };
+
+    // Post-dominators, sink first; the immediate one is the closest, with the most post-dominators
+    std::map<std::string, std::set<std::string>> postdominators;
+    std::map<std::string, int64_t> waiting;
+    for (const auto& node : postorder) {
+      std::set<std::string> common;
+      bool first = true;
+      for (const auto& successor : graph[node]) {
+        const auto& successor_postdominators = postdominators[successor];
+        if (first) {
+          common = successor_postdominators;
+          first = false;
+        } else {
+          std::set<std::string> intersection;
+          std::set_intersection(common.begin(), common.end(), successor_postdominators.begin(),
+                                successor_postdominators.end(),
+                                std::inserter(intersection, intersection.begin()));
+          common = std::move(intersection);
+        }
+      }
+      if (graph[node].size() > 1) {
+        std::string immediate;
+        for (const auto& candidate : common) {
+          if (immediate.empty() ||
+              postdominators[candidate].size() > postdominators[immediate].size()) {
+            immediate = candidate;
+          }
+        }
+        waiting[node] = longest(node, immediate);
+      } else {
+        waiting[node] = cost(node);
+      }
+      common.insert(node);
+      postdominators[node] = std::move(common);
+    }
+
+    // Longest path from the source to the sink
+    std::set<std::string> longest_path{source};
+    for (std::string node = source; node != sink;) {
+      for (const auto& successor : graph[node]) {
+        if (cost(node) + longest(successor, sink) == longest(node, sink)) {
+          node = successor;
+          break;
+        }
+      }
+      longest_path.insert(node);
+    }
+    const int64_t longest_path_cost = longest(source, sink) + waiting[sink];
+
+    // Shortest paths, in hops, from the source
+    std::map<std::string, std::string> parents{{source, source}};
+    std::queue<std::string> frontier({source});
+    while (!frontier.empty()) {
+      const std::string node = frontier.front();
+      frontier.pop();
+      for (const auto& successor : graph[node]) {
+        if (parents.emplace(successor, node).second) { frontier.push(successor); }
+      }
+    }
+
+    int64_t bound = 0;
+    for (const auto& node : postorder) {
+      std::vector<std::string> shortest_path{node};
+      while (shortest_path.back() != source) {
+        shortest_path.push_back(parents[shortest_path.back()]);
+      }
+      std::reverse(shortest_path.begin(), shortest_path.end());
+
+      // Messages queued from the source to the operator, then the longest path to the sink
+      int64_t candidate = shortest_path.size() * waiting[node] + longest(node, sink) +
+                          waiting[sink];
+      if (longest_path.count(node) == 0) {
+        candidate += longest_path_cost - weight(shortest_path);
+      }
+      bound = std::max(bound, candidate);
+    }
+    return bound;
+  }
+
+ private:
+  struct Bound {
+    uint64_t wcrt_us;
+    uint64_t max_observed_us;
+  };
+
+  void update(bool final) {
+    Successors successors;
+    std::set<std::string> operators;
+    // (root, leaf) of every path with its largest observed latency
+    std::map<std::pair<std::string, std::string>, uint64_t> max_observed;
+    for (const auto& [path, latency] : histograms_.paths()) {
+      if (path.empty()) { continue; }
+      for (size_t hop = 0; hop < path.size(); ++hop) {
+        operators.insert(path[hop]);
+        if (hop + 1 < path.size()) { successors[path[hop]].insert(path[hop + 1]); }
+      }
+      auto& observed = max_observed[{path.front(), path.back()}];
+      observed = std::max(observed, latency->max());
+    }
+    std::map<std::string, uint64_t> wcet;
+    for (const auto& op_name : operators) {
+      const LatencyHistogram* execution_time = histograms_.execution_time(op_name);
+      wcet[op_name] = execution_time ? execution_time->percentile(percentile_) : 0;
+    }
+
+    std::map<std::pair<std::string, std::string>, Bound> bounds;
+    for (const auto& [ends, observed] : max_observed) {
+      const auto bound = response_time_bound(successors, wcet, ends.first, ends.second);
+      if (!bound) {
+        if (warned_cycles_.insert(ends).second) {
+          HOLOSCAN_LOG_WARN("The graph from {} to {} has a cycle, its WCRT is not bounded",
+                            ends.first,
+                            ends.second);
+        }
+        continue;
+      }
+      bounds[ends] = {*bound, observed};
+    }
+
+    auto ms = [](uint64_t us) { return us / 1000.; };
+    for (const auto& [ends, bound] : bounds) {
+      const bool violated = bound.wcrt_us > static_cast<uint64_t>(deadline_.count());
+      if (violated && violations_.insert(ends).second) {
+        HOLOSCAN_LOG_WARN(
+            "WCRT bound from {} to {} is {:.3f} ms, above the {:.3f} ms deadline (observed max "
+            "{:.3f} ms)",
+            ends.first,
+            ends.second,
+            ms(bound.wcrt_us),
+            ms(deadline_.count()),
+            ms(bound.max_observed_us));
+      } else if (!violated && violations_.erase(ends)) {
+        HOLOSCAN_LOG_INFO("WCRT bound from {} to {} is back to {:.3f} ms, within the deadline",
+                          ends.first,
+                          ends.second,
+                          ms(bound.wcrt_us));
+      }
+      if (final) {
+        HOLOSCAN_LOG_INFO("WCRT bound from {} to {}: {:.3f} ms, observed max {:.3f} ms",
+                          ends.first,
+                          ends.second,
+                          ms(bound.wcrt_us),
+                          ms(bound.max_observed_us));
+      }
+    }
+
+    if (output_file_.empty()) { return; }
+    std::ostringstream json;
+    json.setf(std::ios::fixed);
+    json.precision(3);
+    json << "{\n  \"final\": " << (final ? "true" : "false")
+         << ",\n  \"deadline_ms\": " << ms(deadline_.count()) << ",\n  \"bounds\": [";
+    const char* separator = "";
+    for (const auto& [ends, bound] : bounds) {
+      json << separator << "\n    {\"source\": \"" << FlowHistograms::escape(ends.first)
+           << "\", \"sink\": \"" << FlowHistograms::escape(ends.second)
+           << "\", \"wcrt_ms\": " << ms(bound.wcrt_us)
+           << ", \"max_observed_ms\": " << ms(bound.max_observed_us) << ", \"violated\": "
+           << (bound.wcrt_us > static_cast<uint64_t>(deadline_.count()) ? "true" : "false")
+           << "}";
+      separator = ",";
+    }
+    json << "\n  ],\n  \"wcet_ms\": {";
+    separator = "";
+    for (const auto& [op_name, op_wcet] : wcet) {
+      json << separator << "\n    \"" << FlowHistograms::escape(op_name)
+           << "\": " << ms(op_wcet);
+      separator = ",";
+    }
+    json << "\n  }\n}\n";
+    FlowHistograms::write_atomically(output_file_, json.str());
+  }
+
+  FlowHistograms& histograms_;
+  std::chrono::microseconds deadline_;
+  double percentile_;
+  std::chrono::milliseconds period_;
+  std::string output_file_;
+
+  // Only used by the monitoring thread, then by stop() once it's joined
+  std::set<std::pair<std::string, std::string>> violations_;
+  std::set<std::pair<std::string, std::string>> warned_cycles_;
+
+  std::thread thread_;
+  std::mutex stop_mutex_;
+  std::condition_variable stop_condition_;
+  bool stopped_ = false;
+};
+
+#endif /* HOLOSCAN_WCRT_MONITOR */
@@ -0,0 +1,151 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef HOLOHUB_KERNEL_BENCHMARK_HPP
+#define HOLOHUB_KERNEL_BENCHMARK_HPP
+
+#include <benchmark/benchmark.h>
+#include <cuda_runtime.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#define BENCHMARK_CUDA_TRY(stmt)                                                      \
+  {                                                                                   \
+    cudaError_t cuda_status = stmt;                                                   \
+    if (cudaSuccess != cuda_status) {                                                 \
+      throw std::runtime_error(std::string("CUDA runtime call " #stmt " failed: ") + \
+                               cudaGetErrorString(cuda_status));                      \
+    }                                                                                 \
+  }
+
+namespace holohub::benchmarks {
+
+/// Device or pinned host allocation released with the benchmark state
+template <typename T>
+class Buffer {
+ public:
+  explicit Buffer(size_t count, bool pinned_host = false) : count_(count), host_(pinned_host) {
+    if (host_) {
+      BENCHMARK_CUDA_TRY(cudaMallocHost(&data_, count * sizeof(T)));
+    } else {
+      BENCHMARK_CUDA_TRY(cudaMalloc(&data_, count * sizeof(T)));
+    }
+  }
+  Buffer(const Buffer&) = delete;
+  Buffer& operator=(const Buffer&) = delete;
+  ~Buffer() {
+    if (host_) {
+      cudaFreeHost(data_);
+    } else {
+      cudaFree(data_);
+    }
+  }
+
+  T* get() const { return data_; }
+  size_t count() const { return count_; }
+  size_t bytes() const { return count_ * sizeof(T); }
+
+  /// Copy count() elements from host memory
+  void upload(const T* src) {
+    BENCHMARK_CUDA_TRY(cudaMemcpy(data_, src, bytes(), cudaMemcpyHostToDevice));
+  }
+
+ private:
+  T* data_ = nullptr;
+  size_t count_;
+  bool host_;
+};
+
+/// Random bytes, the same for each run so that data dependent kernels are comparable
+inline std::vector<uint8_t> random_bytes(size_t count, uint32_t seed = 1) {
+  std::mt19937 generator(seed);
+  std::uniform_int_distribution<int> distribution(0, 255);
+  std::vector<uint8_t> bytes(count);
+  for (auto& b : bytes) { b = static_cast<uint8_t>(distribution(generator)); }
+  return bytes;
+}
+
+/// Theoretical DRAM bandwidth of the current device in GB/s, 0 if the device does not report
+/// its memory clock, as integrated GPUs do
+inline double peak_bandwidth_gbps() {
+  int device = 0;
+  int clock_khz = 0;
+  int bus_width_bits = 0;
+  if (cudaGetDevice(&device) != cudaSuccess ||
+      cudaDeviceGetAttribute(&clock_khz, cudaDevAttrMemoryClockRate, device) != cudaSuccess ||
+      cudaDeviceGetAttribute(&bus_width_bits, cudaDevAttrGlobalMemoryBusWidth, device) !=
+          cudaSuccess) {
+    return 0.0;
+  }
+  // Double data rate
+  return 2.0 * clock_khz * 1e3 * (bus_width_bits / 8.0) / 1e9;
+}
+
+/// Time `launch(stream)` with CUDA events and report the bandwidth it achieves
+///
+/// `bytes` is the minimum traffic of one launch: every input byte read once and every output
+/// byte written once. The GB/s counter divides it by the GPU time of the launch, and peak_pct
+/// compares that with peak_bandwidth_gbps(). One untimed launch warms up the kernel first.
+template <typename Launch>
+void run_kernel(benchmark::State& state, size_t bytes, Launch&& launch) {
+  cudaStream_t stream;
+  cudaEvent_t start;
+  cudaEvent_t stop;
+  BENCHMARK_CUDA_TRY(cudaStreamCreateWithFlags(&stream, cudaStreamNonBlocking));
+  BENCHMARK_CUDA_TRY(cudaEventCreate(&start));
+  BENCHMARK_CUDA_TRY(cudaEventCreate(&stop));
+
+  launch(stream);
+  BENCHMARK_CUDA_TRY(cudaGetLastError());
+  BENCHMARK_CUDA_TRY(cudaStreamSynchronize(stream));
+
+  double total_seconds = 0.0;
+  for (auto _ : state) {
+    BENCHMARK_CUDA_TRY(cudaEventRecord(start, stream));
+    launch(stream);
+    BENCHMARK_CUDA_TRY(cudaEventRecord(stop, stream));
+    BENCHMARK_CUDA_TRY(cudaEventSynchronize(stop));
+    float ms = 0.f;
+    BENCHMARK_CUDA_TRY(cudaEventElapsedTime(&ms, start, stop));
+    state.SetIterationTime(ms / 1e3);
+    total_seconds += ms / 1e3;
+  }
+  BENCHMARK_CUDA_TRY(cudaGetLastError());
+
+  cudaEventDestroy(stop);
+  cudaEventDestroy(start);
+  cudaStreamDestroy(stream);
+
+  // Counter rates are taken over CPU time, the GPU time is accumulated here instead
+  const double gbps =
+      total_seconds > 0.0 ? bytes * static_cast<double>(state.iterations()) / total_seconds / 1e9
+                          : 0.0;
+  const double peak = peak_bandwidth_gbps();
+  state.counters["bytes"] = static_cast<double>(bytes);
+  state.counters["GB/s"] = gbps;
+  state.counters["peak_pct"] = peak > 0.0 ? 100.0 * gbps / peak : 0.0;
+}
+
+}  // namespace holohub::benchmarks
+
+#endif /* HOLOHUB_KERNEL_BENCHMARK_HPP */
@@ -0,0 +1,113 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <algorithm>
+#include <numeric>
+#include <vector>
+
+#include "advanced_network/kernels.h"
+#include "advanced_network_connectors/place_packet_data.cuh"
+
+#include "kernel_benchmark.hpp"
+
+namespace holohub::benchmarks {
+
+namespace {
+
+// Packets of the synthetic bursts are 128-byte aligned slots of a single pool, handed to the
+// kernels out of order the way the buffers of a NIC ring come back after reordering
+struct PacketPool {
+  PacketPool(size_t num_packets, size_t packet_bytes, size_t payload_offset)
+      : stride(((payload_offset + packet_bytes + 127) / 128) * 128),
+        pool(num_packets * stride),
+        pointers(num_packets) {
+    const auto bytes = random_bytes(pool.count());
+    pool.upload(bytes.data());
+
+    std::vector<size_t> order(num_packets);
+    std::iota(order.begin(), order.end(), 0);
+    std::shuffle(order.begin(), order.end(), std::mt19937(2));
+    std::vector<const void*> host_pointers(num_packets);
+    for (size_t i = 0; i < num_packets; i++) {
+      host_pointers[i] = pool.get() + order[i] * stride + payload_offset;
+    }
+    pointers.upload(host_pointers.data());
+  }
+
+  size_t stride;
+  Buffer<uint8_t> pool;
+  Buffer<const void*> pointers;
+};
+
+// args: packet length in bytes, packets per burst
+void BM_simple_packet_reorder(benchmark::State& state) {
+  const auto pkt_len = static_cast<uint16_t>(state.range(0));
+  const auto num_pkts = static_cast<uint32_t>(state.range(1));
+  PacketPool packets(num_pkts, pkt_len, 0);
+  Buffer<uint8_t> out(static_cast<size_t>(pkt_len) * num_pkts);
+
+  run_kernel(state, 2 * out.bytes() + packets.pointers.bytes(), [&](cudaStream_t stream) {
+    simple_packet_reorder(out.get(), packets.pointers.get(), pkt_len, num_pkts, stream);
+  });
+}
+
+// With header-data split the samples start their own NIC buffer, otherwise they follow the VRT
+// header and are only word aligned, which takes the kernel off its 16-byte load path
+constexpr size_t kUnalignedPayloadOffset = 4;
+
+// args: packets per batch, complex samples per packet, payload aligned to 16 bytes
+template <typename T>
+void BM_place_packet_data(benchmark::State& state) {
+  const auto num_packets = static_cast<int>(state.range(0));
+  const auto num_samples = static_cast<int>(state.range(1));
+  const size_t offset = state.range(2) ? 0 : kUnalignedPayloadOffset;
+  PacketPool packets(num_packets, num_samples * sizeof(uint32_t), offset);
+  Buffer<T> out(static_cast<size_t>(num_packets) * num_samples);
+
+  const size_t bytes = static_cast<size_t>(num_packets) * num_samples * sizeof(uint32_t) +
+                       out.bytes() + packets.pointers.bytes();
+  run_kernel(state, bytes, [&](cudaStream_t stream) {
+    place_packet_data(out.get(), packets.pointers.get(), 0, num_packets, num_samples, stream);
+  });
+}
+
+}  // namespace
+
+BENCHMARK(BM_simple_packet_reorder)
+    ->ArgNames({"pkt_len", "num_pkts"})
+    ->ArgsProduct({{64, 1500, 8000}, {1024, 16384, 65536}})
+    ->UseManualTime();
+
+BENCHMARK(BM_place_packet_data<cuda::std::complex<float>>)
+    ->Name("BM_place_packet_data<fp32>")
+    ->ArgNames({"packets", "samples", "aligned"})
+    ->ArgsProduct({{1250, 12500}, {256, 1024, 2048}, {0, 1}})
+    ->UseManualTime();
+
+BENCHMARK(BM_place_packet_data<matx::matxFp16Complex>)
+    ->Name("BM_place_packet_data<fp16>")
+    ->ArgNames({"packets", "samples", "aligned"})
+    ->ArgsProduct({{1250, 12500}, {256, 1024, 2048}, {0, 1}})
+    ->UseManualTime();
+
+BENCHMARK(BM_place_packet_data<matx::matxBf16Complex>)
+    ->Name("BM_place_packet_data<bf16>")
+    ->ArgNames({"packets", "samples", "aligned"})
+    ->ArgsProduct({{1250, 12500}, {256, 1024, 2048}, {0, 1}})
+    ->UseManualTime();
+
+}  // namespace holohub::benchmarks
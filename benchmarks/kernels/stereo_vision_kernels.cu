@@ -0,0 +1,109 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <vector>
+
+#include "stereo_depth_kernels.h"
+
+#include "kernel_benchmark.hpp"
+
+namespace holohub::benchmarks {
+
+namespace {
+
+// args: width, height
+void BM_heatmapF32(benchmark::State& state) {
+  const auto width = static_cast<uint32_t>(state.range(0));
+  const auto height = static_cast<uint32_t>(state.range(1));
+  const size_t pixels = static_cast<size_t>(width) * height;
+  Buffer<float> disparity(pixels);
+  Buffer<uint8_t> rgb(3 * pixels);
+  std::vector<float> ramp(pixels);
+  for (size_t i = 0; i < pixels; i++) { ramp[i] = static_cast<float>(i % 256); }
+  disparity.upload(ramp.data());
+
+  run_kernel(state, disparity.bytes() + rgb.bytes(), [&](cudaStream_t stream) {
+    heatmapF32(disparity.get(), rgb.get(), 0.f, 255.f, width, height, stream);
+  });
+}
+
+// args: input width, input height, input channels, output width, output height
+void BM_preprocessESS(benchmark::State& state) {
+  const auto in_width = static_cast<uint32_t>(state.range(0));
+  const auto in_height = static_cast<uint32_t>(state.range(1));
+  const auto in_channels = static_cast<uint32_t>(state.range(2));
+  const auto out_width = static_cast<uint32_t>(state.range(3));
+  const auto out_height = static_cast<uint32_t>(state.range(4));
+  const size_t in_bytes = static_cast<size_t>(in_width) * in_height * in_channels;
+  // The bilinear taps of the last row and column read one pixel past the image
+  Buffer<uint8_t> input(in_bytes + (in_width + 1) * in_channels);
+  input.upload(random_bytes(input.count()).data());
+  Buffer<float> output(3 * static_cast<size_t>(out_width) * out_height);
+
+  run_kernel(state, in_bytes + output.bytes(), [&](cudaStream_t stream) {
+    preprocessESS(input.get(), output.get(), in_width, in_height, in_channels, out_width,
+                  out_height, stream);
+  });
+}
+
+// args: eye width, eye height, input channels, output width, output height
+void BM_rectifyPreprocessESS(benchmark::State& state) {
+  const auto eye_width = static_cast<uint32_t>(state.range(0));
+  const auto eye_height = static_cast<uint32_t>(state.range(1));
+  const auto in_channels = static_cast<uint32_t>(state.range(2));
+  const auto out_width = static_cast<uint32_t>(state.range(3));
+  const auto out_height = static_cast<uint32_t>(state.range(4));
+  // horizontally stacked stereo frame
+  const uint32_t pitch = 2 * eye_width * in_channels;
+  Buffer<uint8_t> input(static_cast<size_t>(pitch) * eye_height);
+  input.upload(random_bytes(input.count()).data());
+  // identity displacement maps
+  Buffer<__half2> map(static_cast<size_t>(eye_width) * eye_height);
+  BENCHMARK_CUDA_TRY(cudaMemset(map.get(), 0, map.bytes()));
+  Buffer<float> left(3 * static_cast<size_t>(out_width) * out_height);
+  Buffer<float> right(left.count());
+
+  run_kernel(state, input.bytes() + 2 * map.bytes() + 2 * left.bytes(), [&](cudaStream_t stream) {
+    rectifyPreprocessESS(input.get(), pitch, in_channels, eye_width * in_channels, map.get(),
+                         map.get(), eye_width, eye_height, 0, 0, eye_width, eye_height,
+                         left.get(), right.get(), out_width, out_height, stream);
+  });
+}
+
+}  // namespace
+
+BENCHMARK(BM_heatmapF32)
+    ->ArgNames({"width", "height"})
+    ->Args({960, 576})
+    ->Args({1920, 1080})
+    ->Args({3840, 2160})
+    ->UseManualTime();
+
+// Camera frames scaled to the 960x576 input of the ESS model
+BENCHMARK(BM_preprocessESS)
+    ->ArgNames({"in_width", "in_height", "in_channels", "out_width", "out_height"})
+    ->ArgsProduct({{1920}, {1080}, {3, 4}, {960}, {576}})
+    ->ArgsProduct({{3840}, {2160}, {3, 4}, {960}, {576}})
+    ->UseManualTime();
+
+// Fused split + rectify + resize of a side-by-side frame into both ESS inputs
+BENCHMARK(BM_rectifyPreprocessESS)
+    ->ArgNames({"eye_width", "eye_height", "in_channels", "out_width", "out_height"})
+    ->ArgsProduct({{1920}, {1080}, {3, 4}, {960}, {576}})
+    ->UseManualTime();
+
+}  // namespace holohub::benchmarks
@@ -0,0 +1,92 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <cuda_fp16.h>
+
+#include <vector>
+
+#include "tool_tracking_postprocessor.cuh"
+
+#include "kernel_benchmark.hpp"
+
+namespace holohub::benchmarks {
+
+namespace {
+
+using holoscan::ops::MaskFormat;
+using holoscan::ops::MaskType;
+
+size_t mask_element_bytes(MaskType type) {
+  switch (type) {
+    case MaskType::FLOAT32:
+      return sizeof(float);
+    case MaskType::FLOAT16:
+      return sizeof(__half);
+    case MaskType::UINT8:
+      return sizeof(uint8_t);
+  }
+  return 0;
+}
+
+// args: mask width, mask height, MaskType, mask scale, MaskFormat
+//
+// All tools are above the probability threshold, so every binary mask is read.
+void BM_tool_tracking_postprocess(benchmark::State& state) {
+  constexpr uint32_t kTools = 7;
+  const auto width = static_cast<uint32_t>(state.range(0));
+  const auto height = static_cast<uint32_t>(state.range(1));
+  const auto mask_type = static_cast<MaskType>(state.range(2));
+  const auto mask_scale = static_cast<uint32_t>(state.range(3));
+  const auto mask_format = static_cast<MaskFormat>(state.range(4));
+
+  Buffer<float> probs(kTools);
+  Buffer<float2> coords(kTools);
+  Buffer<float3> filtered(kTools);
+  Buffer<float3> colors(kTools);
+  const std::vector<float> ones(4 * kTools, 1.f);
+  probs.upload(ones.data());
+  coords.upload(reinterpret_cast<const float2*>(ones.data()));
+  colors.upload(reinterpret_cast<const float3*>(ones.data()));
+
+  // Random bytes are valid masks of all types, besides the odd float NaN, which the blend
+  // does not branch on
+  Buffer<uint8_t> masks(kTools * width * height * mask_element_bytes(mask_type));
+  masks.upload(random_bytes(masks.count()).data());
+
+  const size_t out_pixels =
+      static_cast<size_t>((width + mask_scale - 1) / mask_scale) *
+      ((height + mask_scale - 1) / mask_scale);
+  Buffer<uint8_t> colored(out_pixels *
+                          (mask_format == MaskFormat::FLOAT32 ? sizeof(float4) : sizeof(uchar4)));
+
+  run_kernel(state, masks.bytes() + colored.bytes(), [&](cudaStream_t stream) {
+    holoscan::ops::cuda_postprocess(kTools, 0.5f, probs.get(), coords.get(), filtered.get(),
+                                    width, height, colors.get(), masks.get(), mask_type,
+                                    mask_scale, mask_format, colored.get(), stream);
+  });
+}
+
+}  // namespace
+
+// The 107x60 masks of the endoscopy tool tracking model, and a full HD model output
+BENCHMARK(BM_tool_tracking_postprocess)
+    ->ArgNames({"width", "height", "type", "scale", "format"})
+    ->ArgsProduct({{107}, {60}, {0, 1, 2}, {1}, {0, 1}})
+    ->ArgsProduct({{1920}, {1080}, {0, 1, 2}, {1, 2}, {0, 1}})
+    ->UseManualTime();
+
+}  // namespace holohub::benchmarks
@@ -0,0 +1,99 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <cstring>
+#include <vector>
+
+#include "velodyne_constants.hpp"
+#include "velodyne_convert_xyz.hpp"
+
+#include "kernel_benchmark.hpp"
+
+namespace holohub::benchmarks {
+
+namespace {
+
+using data_collection::sensors::kVelodyneBank0Header;
+using data_collection::sensors::kVelodyneBlocks;
+using data_collection::sensors::kVelodyneRecords;
+using data_collection::sensors::PointXYZ;
+using data_collection::sensors::RawVelodynePacket;
+using data_collection::sensors::VelodyneConvertXYZHelper;
+using data_collection::sensors::VelodyneReturnSelection;
+using data_collection::sensors::VelodyneSensorModel;
+
+// Packets of one sensor rotation: azimuths sweep the full circle, ranges are random
+std::vector<RawVelodynePacket> make_packets(size_t num_packets) {
+  const auto bytes = random_bytes(num_packets * sizeof(RawVelodynePacket));
+  std::vector<RawVelodynePacket> packets(num_packets);
+  std::memcpy(packets.data(), bytes.data(), bytes.size());
+  for (size_t p = 0; p < num_packets; p++) {
+    for (uint32_t j = 0; j < kVelodyneBlocks; j++) {
+      auto& block = packets[p].blocks_[j];
+      block.header_ = kVelodyneBank0Header;
+      block.azimuth_hundredths_degrees_ =
+          static_cast<uint16_t>(((p * kVelodyneBlocks + j) * 36000) /
+                                (num_packets * kVelodyneBlocks));
+    }
+  }
+  return packets;
+}
+
+// args: packets per burst
+//
+// Times the burst conversion of the operator as it runs: gathering the packets into pinned
+// memory, the upload and the kernel, so the counted bytes are the uploaded packets and the
+// points written.
+template <VelodyneSensorModel Model>
+void BM_velodyne_convert_xyz(benchmark::State& state) {
+  const auto num_packets = static_cast<size_t>(state.range(0));
+  const auto packets = make_packets(num_packets);
+  std::vector<const RawVelodynePacket*> pointers;
+  for (const auto& packet : packets) { pointers.push_back(&packet); }
+  Buffer<PointXYZ> xyz(num_packets * kVelodyneBlocks * kVelodyneRecords);
+
+  VelodyneConvertXYZHelper helper;
+  helper.SetSensorModel(Model, {}, VelodyneReturnSelection::kAll);
+  const size_t bytes = num_packets * sizeof(RawVelodynePacket) + xyz.bytes();
+  run_kernel(state, bytes, [&](cudaStream_t stream) {
+    helper.ConvertRawPacketsToDeviceXYZ(
+        pointers.data(), num_packets, xyz.get(), num_packets, 0, stream);
+  });
+}
+
+}  // namespace
+
+// A VLP-16 sends 754 packets per second
+BENCHMARK(BM_velodyne_convert_xyz<VelodyneSensorModel::kVLP16>)
+    ->Name("BM_velodyne_convert_xyz<VLP16>")
+    ->ArgName("packets")
+    ->Arg(1)
+    ->Arg(76)
+    ->Arg(754)
+    ->Arg(4096)
+    ->UseManualTime();
+
+BENCHMARK(BM_velodyne_convert_xyz<VelodyneSensorModel::kHDL32E>)
+    ->Name("BM_velodyne_convert_xyz<HDL32E>")
+    ->ArgName("packets")
+    ->Arg(1)
+    ->Arg(76)
+    ->Arg(754)
+    ->Arg(4096)
+    ->UseManualTime();
+
+}  // namespace holohub::benchmarks
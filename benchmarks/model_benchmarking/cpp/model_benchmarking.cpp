@@ -15,8 +15,20 @@
  * limitations under the License.
  */
 
+#include <cuda_runtime.h>
 #include <getopt.h>
+#include <yaml-cpp/yaml.h>
+
+#include <algorithm>
+#include <chrono>
+#include <deque>
+#include <filesystem>
+#include <fstream>
 #include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
 
 #include <holoscan/operators/format_converter/format_converter.hpp>
 #include <holoscan/operators/holoviz/holoviz.hpp>
@@ -24,29 +36,216 @@
 #include <holoscan/operators/segmentation_postprocessor/segmentation_postprocessor.hpp>
 #include <holoscan/operators/v4l2_video_capture/v4l2_video_capture.hpp>
 #include <holoscan/operators/video_stream_replayer/video_stream_replayer.hpp>
+#include "frame_checksum_sink.hpp"
 #include "holoscan/holoscan.hpp"
+#include "holoscan/utils/cuda_stream_handler.hpp"
 
 namespace holoscan::ops {
 
 /**
- * @brief This Operator takes an input tensor and does nothing with it. It works as a sink
- * without any function.
- *
+ * @brief Measurements of one sweep run, shared by the timing sinks of all pipelines.
+ */
+struct BenchmarkStats {
+  std::mutex mutex;
+  // end-to-end latency from the source and GPU time of the inference, of each measured frame
+  std::vector<double> latencies_ms;
+  std::vector<double> gpu_times_ms;
+  size_t peak_used_memory = 0;
+  // completion of the first and last measured frames
+  std::chrono::steady_clock::time_point first;
+  std::chrono::steady_clock::time_point last;
+  int64_t warmup_frames = 0;
+};
+
+/**
+ * @brief Host timestamps and GPU start events of the frames in flight on one pipeline. The
+ * pipeline keeps the frame order, so the sink matches them in FIFO order.
+ */
+class PipelineTiming {
+ public:
+  ~PipelineTiming() {
+    for (auto event : free_events_) { cudaEventDestroy(event); }
+    for (auto event : started_) { cudaEventDestroy(event); }
+  }
+
+  void push_sent() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    sent_.push_back(std::chrono::steady_clock::now());
+  }
+
+  void push_started(cudaStream_t stream) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    cudaEvent_t event = nullptr;
+    if (free_events_.empty()) {
+      if (cudaEventCreate(&event) != cudaSuccess) {
+        throw std::runtime_error("Failed to create CUDA event");
+      }
+    } else {
+      event = free_events_.back();
+      free_events_.pop_back();
+    }
+    cudaEventRecord(event, stream);
+    started_.push_back(event);
+  }
+
+  // Returns the timestamp and start event of the oldest frame, the event is given back with
+  // release()
+  std::pair<std::chrono::steady_clock::time_point, cudaEvent_t> pop() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (sent_.empty() || started_.empty()) {
+      throw std::runtime_error("Frame completed without being timed");
+    }
+    auto result = std::make_pair(sent_.front(), started_.front());
+    sent_.pop_front();
+    started_.pop_front();
+    return result;
+  }
+
+  void release(cudaEvent_t event) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    free_events_.push_back(event);
+  }
+
+ private:
+  std::mutex mutex_;
+  std::deque<std::chrono::steady_clock::time_point> sent_;
+  std::deque<cudaEvent_t> started_;
+  std::vector<cudaEvent_t> free_events_;
+};
+
+/**
+ * @brief Passes messages through, recording when they left the source.
  */
-class SinkOp : public holoscan::Operator {
+class TimestampOp : public holoscan::Operator {
  public:
-  HOLOSCAN_OPERATOR_FORWARD_ARGS(SinkOp)
+  HOLOSCAN_OPERATOR_FORWARD_ARGS(TimestampOp)
 
-  SinkOp() = default;
+  TimestampOp() = default;
 
-  void setup(OperatorSpec& spec) { spec.input<std::any>("in"); }
+  void set_timing(std::shared_ptr<PipelineTiming> timing) { timing_ = std::move(timing); }
+
+  void setup(OperatorSpec& spec) {
+    spec.input<gxf::Entity>("in");
+    spec.output<gxf::Entity>("out");
+  }
 
   void compute(InputContext& op_input, OutputContext& op_output, ExecutionContext&) {
-    auto value = op_input.receive<std::any>("in");
+    auto message = op_input.receive<gxf::Entity>("in").value();
+    timing_->push_sent();
+    op_output.emit(message, "out");
+  }
+
+ private:
+  std::shared_ptr<PipelineTiming> timing_;
+};
+
+/**
+ * @brief Passes messages through, recording a CUDA event on their stream before the inference.
+ */
+class GpuTimerStartOp : public holoscan::Operator {
+ public:
+  HOLOSCAN_OPERATOR_FORWARD_ARGS(GpuTimerStartOp)
+
+  GpuTimerStartOp() = default;
+
+  void set_timing(std::shared_ptr<PipelineTiming> timing) { timing_ = std::move(timing); }
+
+  void setup(OperatorSpec& spec) {
+    spec.input<gxf::Entity>("in");
+    spec.output<gxf::Entity>("out");
+    cuda_stream_handler_.define_params(spec);
+  }
+
+  void compute(InputContext& op_input, OutputContext& op_output, ExecutionContext& context) {
+    auto message = op_input.receive<gxf::Entity>("in").value();
+    if (cuda_stream_handler_.from_message(context.context(), message) != GXF_SUCCESS) {
+      throw std::runtime_error("Failed to get the CUDA stream from incoming messages");
+    }
+    timing_->push_started(cuda_stream_handler_.get_cuda_stream(context.context()));
+    op_output.emit(message, "out");
   }
+
+ private:
+  std::shared_ptr<PipelineTiming> timing_;
+  CudaStreamHandler cuda_stream_handler_;
 };
+
+/**
+ * @brief Sink recording the GPU time of the inference and the end-to-end latency of each frame.
+ */
+class TimingSinkOp : public holoscan::Operator {
+ public:
+  HOLOSCAN_OPERATOR_FORWARD_ARGS(TimingSinkOp)
+
+  TimingSinkOp() = default;
+
+  void set_timing(std::shared_ptr<PipelineTiming> timing, std::shared_ptr<BenchmarkStats> stats) {
+    timing_ = std::move(timing);
+    stats_ = std::move(stats);
+  }
+
+  void setup(OperatorSpec& spec) {
+    spec.input<gxf::Entity>("in");
+    cuda_stream_handler_.define_params(spec);
+  }
+
+  void stop() {
+    if (end_event_) {
+      cudaEventDestroy(end_event_);
+      end_event_ = nullptr;
+    }
+  }
+
+  void compute(InputContext& op_input, OutputContext&, ExecutionContext& context) {
+    auto message = op_input.receive<gxf::Entity>("in").value();
+    if (cuda_stream_handler_.from_message(context.context(), message) != GXF_SUCCESS) {
+      throw std::runtime_error("Failed to get the CUDA stream from incoming messages");
+    }
+    if (!end_event_ && cudaEventCreate(&end_event_) != cudaSuccess) {
+      throw std::runtime_error("Failed to create CUDA event");
+    }
+    cudaEventRecord(end_event_, cuda_stream_handler_.get_cuda_stream(context.context()));
+
+    auto [sent, started] = timing_->pop();
+    cudaEventSynchronize(end_event_);
+    const auto now = std::chrono::steady_clock::now();
+    float gpu_time_ms = 0.f;
+    cudaEventElapsedTime(&gpu_time_ms, started, end_event_);
+    timing_->release(started);
+
+    if (frame_index_++ < stats_->warmup_frames) { return; }
+
+    size_t free_memory = 0, total_memory = 0;
+    cudaMemGetInfo(&free_memory, &total_memory);
+
+    std::lock_guard<std::mutex> lock(stats_->mutex);
+    if (stats_->latencies_ms.empty()) { stats_->first = now; }
+    stats_->last = now;
+    stats_->latencies_ms.push_back(
+        std::chrono::duration<double, std::milli>(now - sent).count());
+    stats_->gpu_times_ms.push_back(gpu_time_ms);
+    stats_->peak_used_memory = std::max(stats_->peak_used_memory, total_memory - free_memory);
+  }
+
+ private:
+  std::shared_ptr<PipelineTiming> timing_;
+  std::shared_ptr<BenchmarkStats> stats_;
+  CudaStreamHandler cuda_stream_handler_;
+  cudaEvent_t end_event_ = nullptr;
+  int64_t frame_index_ = 0;
+};
+
 }  // namespace holoscan::ops
 
+/**
+ * @brief One configuration of a sweep.
+ */
+struct SweepPoint {
+  std::string precision;
+  int instances = 1;
+  int cuda_streams = 1;
+};
+
 class App : public holoscan::Application {
  public:
   App() = default;
@@ -73,9 +272,89 @@ class App : public holoscan::Application {
     }
   }
 
+  /**
+   * @brief Runs the app as one point of a sweep: cuda_streams pipelines, each with its own
+   * CUDA streams and timing, replay frames + warmup frames through the inference into a timing
+   * sink.
+   */
+  void set_sweep_point(const SweepPoint& point, int64_t frames,
+                       std::shared_ptr<holoscan::ops::BenchmarkStats> stats) {
+    sweep_point_ = point;
+    sweep_frames_ = frames;
+    stats_ = std::move(stats);
+  }
+
+  void compose_sweep() {
+    using namespace holoscan;
+
+    std::shared_ptr<Resource> pool_resource = make_resource<UnboundedAllocator>("pool");
+    auto frame_count =
+        make_condition<CountCondition>("frame_count", sweep_frames_ + stats_->warmup_frames);
+    std::shared_ptr<Operator> source;
+    if (replayer) {
+      source = make_operator<ops::VideoStreamReplayerOp>(
+          "replayer", frame_count, from_config("replayer"), Arg("directory") = datapath);
+    } else {
+      source = make_operator<ops::V4L2VideoCaptureOp>(
+          "source", frame_count, from_config("source"), Arg("allocator") = pool_resource);
+    }
+
+    for (int stream = 0; stream < sweep_point_.cuda_streams; stream++) {
+      const std::string suffix = "_" + std::to_string(stream);
+      auto timing = std::make_shared<ops::PipelineTiming>();
+      auto cuda_stream_pool =
+          make_resource<CudaStreamPool>("cuda_stream_pool" + suffix, 0, 0, 0, 1, 5);
+
+      auto timestamp = make_operator<ops::TimestampOp>("timestamp" + suffix);
+      timestamp->set_timing(timing);
+      auto preprocessor = make_operator<ops::FormatConverterOp>("preprocessor" + suffix,
+                                                                from_config("preprocessor"),
+                                                                Arg("pool") = pool_resource,
+                                                                cuda_stream_pool);
+      auto gpu_timer = make_operator<ops::GpuTimerStartOp>("gpu_timer" + suffix);
+      gpu_timer->set_timing(timing);
+
+      ops::InferenceOp::DataMap model_path_map;
+      ops::InferenceOp::DataVecMap pre_processor_map;
+      ops::InferenceOp::DataVecMap inference_map;
+      for (int i = 0; i < sweep_point_.instances; i++) {
+        std::string model_index_str = "own_model_" + std::to_string(i);
+        model_path_map.insert(model_index_str, datapath + "/" + model_name);
+        pre_processor_map.insert(model_index_str, {"source_video"});
+        inference_map.insert(model_index_str, {"output" + std::to_string(i)});
+      }
+      auto inference =
+          make_operator<ops::InferenceOp>("inference" + suffix,
+                                          from_config("inference"),
+                                          Arg("allocator") = pool_resource,
+                                          Arg("model_path_map", model_path_map),
+                                          Arg("pre_processor_map", pre_processor_map),
+                                          Arg("inference_map", inference_map),
+                                          Arg("enable_fp16") = sweep_point_.precision == "fp16",
+                                          cuda_stream_pool);
+      auto sink = make_operator<ops::TimingSinkOp>("sink" + suffix);
+      sink->set_timing(timing, stats_);
+
+      if (replayer) {
+        add_flow(source, timestamp, {{"", "in"}});
+      } else {
+        add_flow(source, timestamp, {{"signal", "in"}});
+      }
+      add_flow(timestamp, preprocessor, {{"out", "source_video"}});
+      add_flow(preprocessor, gpu_timer, {{"tensor", "in"}});
+      add_flow(gpu_timer, inference, {{"out", "receivers"}});
+      add_flow(inference, sink, {{"transmitter", "in"}});
+    }
+  }
+
   void compose() override {
     using namespace holoscan;
 
+    if (stats_) {
+      compose_sweep();
+      return;
+    }
+
     std::shared_ptr<Resource> pool_resource = make_resource<UnboundedAllocator>("pool");
     std::shared_ptr<Operator> source;
 
@@ -135,10 +414,20 @@ class App : public holoscan::Application {
       add_flow(source, preprocessor, {{"signal", "source_video"}});
     }
     add_flow(preprocessor, inference, {{"tensor", "receivers"}});
+
+    // Headless sinks checksumming the output, with the checksum files of each one suffixed
+    auto sink_args = [this](const std::string& suffix) {
+      auto args = from_config("sink");
+      for (const char* file : {"golden_file", "checksum_file"}) {
+        const auto path = from_config(std::string("sink.") + file).as<std::string>();
+        if (!path.empty()) { args.add(Arg(file, path + suffix)); }
+      }
+      return args;
+    };
     if (only_inference) {
       HOLOSCAN_LOG_INFO(
           "Only inference mode is on, no post-processing and visualization will be done.");
-      auto sink = make_operator<ops::SinkOp>("sink");
+      auto sink = make_operator<ops::FrameChecksumSinkOp>("sink", sink_args(""));
       add_flow(inference, sink);
       return;
     }
@@ -162,7 +451,8 @@ class App : public holoscan::Application {
       HOLOSCAN_LOG_INFO("Inference and Post-processing mode is on. No visualization will be done.");
       for (int i = 0; i < num_inferences; i++) {
         std::string sink_name = "sink" + std::to_string(i);
-        auto sink = make_operator<ops::SinkOp, std::string>(sink_name);
+        auto sink = make_operator<ops::FrameChecksumSinkOp, std::string>(
+            sink_name, sink_args(num_inferences > 1 ? "." + std::to_string(i) : ""));
         add_flow(postprocessors[i], sink);
       }
       return;
@@ -177,6 +467,10 @@ class App : public holoscan::Application {
   int num_inferences = 1;
   bool only_inference = false, inference_postprocessing = false, headless = false, replayer = false;
   std::string datapath, model_name;
+  // sweep mode
+  SweepPoint sweep_point_;
+  int64_t sweep_frames_ = 0;
+  std::shared_ptr<holoscan::ops::BenchmarkStats> stats_;
 };
 
 void print_help() {
@@ -202,13 +496,17 @@ void print_help() {
       << "  -l, --multi-inference <num>     Number of inferences to run in parallel (default: 1)"
       << std::endl;
   std::cout << "  -e, --headless                  Run holoviz in headless mode." << std::endl;
+  std::cout << "  -s, --sweep <path>              Run the configurations of the 'sweep' config "
+               "section for the model and write their results to <path> (.json or .csv)"
+            << std::endl;
   std::cout << "  -h, --help                      Print this help" << std::endl;
 }
 
 /** Helper function to parse the command line arguments */
 bool parse_arguments(int argc, char** argv, std::string& config_name, std::string& data_path,
                      std::string& model_name, bool& only_inference, bool& inference_postprocessing,
-                     int& num_inferences, bool& headless, bool& replayer) {
+                     int& num_inferences, bool& headless, bool& replayer,
+                     std::string& sweep_output) {
   static struct option long_options[] = {{"help", required_argument, 0, 'h'},
                                          {"data", required_argument, 0, 'd'},
                                          {"model-name", required_argument, 0, 'm'},
@@ -217,9 +515,10 @@ bool parse_arguments(int argc, char** argv, std::string& config_name, std::strin
                                          {"headless", optional_argument, 0, 'e'},
                                          {"replayer", optional_argument, 0, 'r'},
                                          {"multi-inference", required_argument, 0, 'l'},
+                                         {"sweep", required_argument, 0, 's'},
                                          {0, 0, 0, 0}};
 
-  while (int c = getopt_long(argc, argv, "hd:m:v:iperl:", long_options, NULL)) {
+  while (int c = getopt_long(argc, argv, "hd:m:v:iperl:s:", long_options, NULL)) {
     if (c == -1 || c == '?') break;
 
     switch (c) {
@@ -247,6 +546,9 @@ bool parse_arguments(int argc, char** argv, std::string& config_name, std::strin
       case 'l':
         num_inferences = std::stoi(optarg);
         break;
+      case 's':
+        sweep_output = optarg;
+        break;
       default:
         std::cerr << "Unknown arguments returned: " << c << std::endl;
         print_help();
@@ -258,6 +560,125 @@ bool parse_arguments(int argc, char** argv, std::string& config_name, std::strin
   return true;
 }
 
+/** Percentile p in [0, 100] of values, which are reordered */
+double percentile(std::vector<double>& values, double p) {
+  if (values.empty()) { return 0.0; }
+  const size_t index = std::min(values.size() - 1, static_cast<size_t>(p / 100.0 * values.size()));
+  std::nth_element(values.begin(), values.begin() + index, values.end());
+  return values[index];
+}
+
+struct SweepResult {
+  SweepPoint point;
+  size_t frames = 0;
+  double throughput_fps = 0.0;
+  double latency_p50_ms = 0.0;
+  double latency_p99_ms = 0.0;
+  double gpu_time_p50_ms = 0.0;
+  double gpu_time_p99_ms = 0.0;
+  double gpu_memory_mib = 0.0;
+};
+
+/** Writes the results as a JSON array or, for any other extension than .json, as CSV */
+void write_sweep_results(const std::string& path, const std::vector<SweepResult>& results) {
+  std::ofstream out(path);
+  if (!out) {
+    std::cerr << "Failed to open " << path << " for writing." << std::endl;
+    return;
+  }
+  const bool json = std::filesystem::path(path).extension() == ".json";
+  if (json) {
+    out << "[\n";
+  } else {
+    out << "precision,instances,cuda_streams,frames,throughput_fps,latency_p50_ms,"
+           "latency_p99_ms,gpu_time_p50_ms,gpu_time_p99_ms,gpu_memory_mib\n";
+  }
+  for (size_t i = 0; i < results.size(); i++) {
+    const auto& r = results[i];
+    if (json) {
+      out << "  {\"precision\": \"" << r.point.precision << "\", \"instances\": "
+          << r.point.instances << ", \"cuda_streams\": " << r.point.cuda_streams
+          << ", \"frames\": " << r.frames << ", \"throughput_fps\": " << r.throughput_fps
+          << ", \"latency_p50_ms\": " << r.latency_p50_ms
+          << ", \"latency_p99_ms\": " << r.latency_p99_ms
+          << ", \"gpu_time_p50_ms\": " << r.gpu_time_p50_ms
+          << ", \"gpu_time_p99_ms\": " << r.gpu_time_p99_ms
+          << ", \"gpu_memory_mib\": " << r.gpu_memory_mib << "}"
+          << (i + 1 < results.size() ? "," : "") << "\n";
+    } else {
+      out << r.point.precision << "," << r.point.instances << "," << r.point.cuda_streams << ","
+          << r.frames << "," << r.throughput_fps << "," << r.latency_p50_ms << ","
+          << r.latency_p99_ms << "," << r.gpu_time_p50_ms << "," << r.gpu_time_p99_ms << ","
+          << r.gpu_memory_mib << "\n";
+    }
+  }
+  if (json) { out << "]\n"; }
+}
+
+/** Runs every configuration of the 'sweep' config section, rewriting the results after each */
+int run_sweep(const std::string& config_path, const std::string& sweep_output,
+              const std::string& data_path, const std::string& model_name, bool replayer) {
+  const YAML::Node sweep = YAML::LoadFile(config_path)["sweep"];
+  if (!sweep) {
+    std::cerr << "Config file " << config_path << " has no 'sweep' section." << std::endl;
+    return 1;
+  }
+  const auto precisions =
+      sweep["precisions"].as<std::vector<std::string>>(std::vector<std::string>{"fp32"});
+  const auto instances = sweep["instances"].as<std::vector<int>>(std::vector<int>{1});
+  const auto cuda_streams = sweep["cuda_streams"].as<std::vector<int>>(std::vector<int>{1});
+  const int64_t frames = sweep["frames"].as<int64_t>(500);
+  const int64_t warmup_frames = sweep["warmup_frames"].as<int64_t>(50);
+
+  std::vector<SweepResult> results;
+  for (const auto& precision : precisions) {
+    if (precision != "fp32" && precision != "fp16") {
+      std::cerr << "Skipping unsupported precision " << precision
+                << ", the inference operator builds fp32 or fp16 engines." << std::endl;
+      continue;
+    }
+    for (int num_instances : instances) {
+      for (int num_streams : cuda_streams) {
+        const SweepPoint point{precision, num_instances, num_streams};
+        HOLOSCAN_LOG_INFO("Sweep: precision {}, {} instances, {} CUDA streams",
+                          precision,
+                          num_instances,
+                          num_streams);
+
+        auto stats = std::make_shared<holoscan::ops::BenchmarkStats>();
+        stats->warmup_frames = warmup_frames;
+        auto app = holoscan::make_application<App>(
+            data_path, model_name, num_instances, true, false, true, replayer);
+        app->config(config_path);
+        app->set_sweep_point(point, frames, stats);
+        if (num_streams > 1) {
+          // one worker per pipeline and one for the source
+          app->scheduler(app->make_scheduler<holoscan::MultiThreadScheduler>(
+              "multithread_scheduler",
+              holoscan::Arg("worker_thread_number", static_cast<int64_t>(num_streams + 1))));
+        }
+        app->run();
+
+        SweepResult result;
+        result.point = point;
+        result.frames = stats->latencies_ms.size();
+        const double seconds = std::chrono::duration<double>(stats->last - stats->first).count();
+        if (result.frames > 1 && seconds > 0.0) {
+          result.throughput_fps = (result.frames - 1) / seconds;
+        }
+        result.latency_p50_ms = percentile(stats->latencies_ms, 50.0);
+        result.latency_p99_ms = percentile(stats->latencies_ms, 99.0);
+        result.gpu_time_p50_ms = percentile(stats->gpu_times_ms, 50.0);
+        result.gpu_time_p99_ms = percentile(stats->gpu_times_ms, 99.0);
+        result.gpu_memory_mib = stats->peak_used_memory / (1024.0 * 1024.0);
+        results.push_back(result);
+        write_sweep_results(sweep_output, results);
+      }
+    }
+  }
+  return 0;
+}
+
 int main(int argc, char** argv) {
   // Parse the arguments
   std::string config_name = "";
@@ -265,6 +686,7 @@ int main(int argc, char** argv) {
   std::string model_name = "us_unet_256x256_nhwc.onnx";
   bool only_inference = false, inference_postprocessing = false, headless = false, replayer = false;
   int num_inferences = 1;
+  std::string sweep_output;
   if (!parse_arguments(argc,
                        argv,
                        config_name,
@@ -274,10 +696,24 @@ int main(int argc, char** argv) {
                        inference_postprocessing,
                        num_inferences,
                        headless,
-                       replayer)) {
+                       replayer,
+                       sweep_output)) {
     return 1;
   }
 
+  if (!sweep_output.empty()) {
+    std::string config_path = config_name;
+    if (config_path.empty()) {
+      config_path = std::filesystem::canonical(argv[0]).parent_path().string() +
+                    "/model_benchmarking.yaml";
+    }
+    if (!std::filesystem::exists(config_path)) {
+      std::cerr << "Config file " << config_path << " does not exist." << std::endl;
+      return 1;
+    }
+    return run_sweep(config_path, sweep_output, data_path, model_name, replayer);
+  }
+
   auto app = holoscan::make_application<App>(data_path,
                                              model_name,
                                              num_inferences,
@@ -0,0 +1,261 @@
+# SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+# SPDX-License-Identifier: Apache-2.0
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+"""Compare release benchmarking results against a stored baseline.
+
+A baseline holds the end-to-end latency samples of each path of each benchmark scenario, i.e.
+each `output/<app>_<runs>_<instances>_<messages>_<scheduler>_<display>_<realtime>` directory of
+`run_benchmarks.sh`, for one platform. A new run regresses when its latencies are significantly
+higher than the baseline's, according to a one-sided Mann-Whitney U test, and at least one of the
+compared percentiles increased beyond the threshold.
+"""
+
+import argparse
+import glob
+import json
+import math
+import os
+import sys
+
+import numpy as np
+
+sys.path.append(
+    os.path.join(os.path.dirname(os.path.abspath(__file__)), "..", "holoscan_flow_benchmarking")
+)
+from log_parser import parse_log_as_paths_latencies  # noqa: E402
+
+# Messages discarded at the beginning and the end of each log, as analyze.py does by default
+SKIP_BEGIN_MESSAGES = 10
+DISCARD_LAST_MESSAGES = 10
+
+
+def load_scenarios(output_dir):
+    """Return {scenario: {path: latencies in ms}} for the scenario directories of output_dir"""
+    scenarios = {}
+    for scenario_dir in sorted(glob.glob(os.path.join(output_dir, "*"))):
+        log_files = sorted(glob.glob(os.path.join(scenario_dir, "logger_*.log")))
+        if not log_files:
+            continue
+        paths = {}
+        for log_file in log_files:
+            for path, latencies in parse_log_as_paths_latencies(log_file).items():
+                paths.setdefault(path, []).extend(
+                    latencies[SKIP_BEGIN_MESSAGES:-DISCARD_LAST_MESSAGES]
+                )
+        scenarios[os.path.basename(scenario_dir)] = {
+            path: latencies for path, latencies in paths.items() if latencies
+        }
+    return scenarios
+
+
+def downsample(latencies, max_samples):
+    """Keep the distribution of the latencies with at most max_samples evenly spaced quantiles"""
+    samples = np.sort(np.asarray(latencies, dtype=float))
+    if len(samples) > max_samples:
+        samples = np.quantile(samples, np.linspace(0, 1, max_samples))
+    return [round(float(sample), 4) for sample in samples]
+
+
+def mann_whitney_greater(baseline, candidate):
+    """One-sided Mann-Whitney U test, normal approximation with tie correction.
+
+    Returns the p-value of the candidate latencies being stochastically greater than the baseline
+    latencies.
+    """
+    baseline = np.asarray(baseline, dtype=float)
+    candidate = np.asarray(candidate, dtype=float)
+    n1, n2 = len(candidate), len(baseline)
+    values = np.concatenate([candidate, baseline])
+    order = np.argsort(values, kind="mergesort")
+    sorted_values = values[order]
+    # average ranks of ties
+    ranks = np.empty(len(values))
+    _, first, counts = np.unique(sorted_values, return_index=True, return_counts=True)
+    for start, count in zip(first, counts):
+        ranks[order[start : start + count]] = start + (count + 1) / 2.0
+    u = ranks[:n1].sum() - n1 * (n1 + 1) / 2.0
+    n = n1 + n2
+    tie_correction = (counts**3 - counts).sum() / (n * (n - 1)) if n > 1 else 0.0
+    sigma = math.sqrt(n1 * n2 / 12.0 * ((n + 1) - tie_correction))
+    if sigma == 0:
+        return 1.0
+    z = (u - n1 * n2 / 2.0 - 0.5) / sigma
+    return 0.5 * math.erfc(z / math.sqrt(2))
+
+
+def compare(baseline, candidate, percentiles, threshold, alpha):
+    """Return the comparison results of every baseline scenario and path"""
+    results = []
+    for scenario, baseline_paths in sorted(baseline["scenarios"].items()):
+        candidate_paths = candidate.get(scenario)
+        for path, baseline_path in sorted(baseline_paths.items()):
+            result = {"scenario": scenario, "path": path, "regressed": [], "status": "pass"}
+            results.append(result)
+            latencies = candidate_paths.get(path) if candidate_paths is not None else None
+            if not latencies:
+                result["status"] = "missing"
+                continue
+            baseline_samples = baseline_path["samples"]
+            result["p_value"] = mann_whitney_greater(baseline_samples, latencies)
+            result["percentiles"] = {}
+            for percentile in percentiles:
+                before = float(np.percentile(baseline_samples, percentile))
+                after = float(np.percentile(latencies, percentile))
+                change = (after - before) / before if before > 0 else 0.0
+                result["percentiles"][str(percentile)] = {
+                    "baseline_ms": before,
+                    "candidate_ms": after,
+                    "change": change,
+                }
+                if change > threshold:
+                    result["regressed"].append(percentile)
+            if result["p_value"] < alpha and result["regressed"]:
+                result["status"] = "fail"
+    return results
+
+
+def format_report(results, baseline, percentiles, threshold, alpha):
+    lines = [
+        f"# Release benchmarking comparison against {baseline.get('version', '?')} "
+        f"({baseline.get('platform', '?')})",
+        "",
+        f"Regression: Mann-Whitney p-value < {alpha} and a percentile more than "
+        f"{threshold * 100:.1f}% higher.",
+        "",
+        "| Status | Scenario | Path | p-value | "
+        + " | ".join(f"p{percentile} (ms)" for percentile in percentiles)
+        + " |",
+        "|---" * (4 + len(percentiles)) + "|",
+    ]
+    for result in results:
+        status = result["status"].upper()
+        if result["status"] == "missing":
+            cells = ["-"] * (1 + len(percentiles))
+        else:
+            cells = [f"{result['p_value']:.2g}"]
+            for percentile in percentiles:
+                values = result["percentiles"][str(percentile)]
+                cell = (
+                    f"{values['baseline_ms']:.2f} → {values['candidate_ms']:.2f} "
+                    f"({values['change'] * 100:+.1f}%)"
+                )
+                if result["status"] == "fail" and percentile in result["regressed"]:
+                    cell = f"**{cell}**"
+                cells.append(cell)
+        lines.append(
+            f"| {status} | {result['scenario']} | {result['path']} | "
+            + " | ".join(cells)
+            + " |"
+        )
+    failed = sum(result["status"] != "pass" for result in results)
+    lines += ["", f"{len(results) - failed} of {len(results)} paths passed."]
+    return "\n".join(lines) + "\n"
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description="Create release benchmarking baselines and compare new runs against them",
+        formatter_class=argparse.RawTextHelpFormatter,
+    )
+    subparsers = parser.add_subparsers(dest="command", required=True)
+
+    create_parser = subparsers.add_parser(
+        "create", help="create a baseline from a benchmark output"
+    )
+    create_parser.add_argument("output_dir", help="run_benchmarks.sh output directory")
+    create_parser.add_argument("baseline", help="baseline JSON file to write")
+    create_parser.add_argument("--version", required=True, help="release version, e.g. v3.0.0")
+    create_parser.add_argument("--platform", required=True, help="platform, e.g. x86_64_A6000")
+    create_parser.add_argument(
+        "--max-samples",
+        type=int,
+        default=5000,
+        help="latency samples kept per path (default: 5000)",
+    )
+
+    compare_parser = subparsers.add_parser(
+        "compare", help="compare a benchmark output to a baseline"
+    )
+    compare_parser.add_argument("output_dir", help="run_benchmarks.sh output directory")
+    compare_parser.add_argument("baseline", help="baseline JSON file of the same platform")
+    compare_parser.add_argument(
+        "-p",
+        "--percentiles",
+        type=float,
+        nargs="+",
+        default=[50, 90, 99, 99.9],
+        help="percentiles compared (default: 50 90 99 99.9)",
+    )
+    compare_parser.add_argument(
+        "--threshold",
+        type=float,
+        default=0.05,
+        help="relative percentile increase considered a regression (default: 0.05)",
+    )
+    compare_parser.add_argument(
+        "--alpha",
+        type=float,
+        default=0.01,
+        help="significance level of the Mann-Whitney U test (default: 0.01)",
+    )
+    compare_parser.add_argument("--report", help="markdown report file, printed if not given")
+    compare_parser.add_argument("--json", help="JSON results file")
+
+    args = parser.parse_args()
+
+    scenarios = load_scenarios(args.output_dir)
+    if not scenarios:
+        print(f"No benchmark logs found in {args.output_dir}", file=sys.stderr)
+        sys.exit(2)
+
+    if args.command == "create":
+        baseline = {
+            "version": args.version,
+            "platform": args.platform,
+            "scenarios": {
+                scenario: {
+                    path: {
+                        "count": len(latencies),
+                        "samples": downsample(latencies, args.max_samples),
+                    }
+                    for path, latencies in paths.items()
+                }
+                for scenario, paths in scenarios.items()
+            },
+        }
+        with open(args.baseline, "w") as f:
+            json.dump(baseline, f)
+        print(f"Baseline of {len(scenarios)} scenarios written to {args.baseline}")
+        return
+
+    with open(args.baseline, "r") as f:
+        baseline = json.load(f)
+    results = compare(baseline, scenarios, args.percentiles, args.threshold, args.alpha)
+    report = format_report(results, baseline, args.percentiles, args.threshold, args.alpha)
+    if args.report:
+        with open(args.report, "w") as f:
+            f.write(report)
+    else:
+        print(report)
+    if args.json:
+        with open(args.json, "w") as f:
+            json.dump(results, f, indent=2)
+
+    if any(result["status"] != "pass" for result in results):
+        print("Performance regression detected", file=sys.stderr)
+        sys.exit(1)
+
+
+if __name__ == "__main__":
+    main()
@@ -280,6 +280,7 @@ main() {
     ARGS=("$@")
     local process_only=false
     local data_dirs=()
+    local baseline=""
 
     for i in "${!ARGS[@]}"; do
         arg="${ARGS[i]}"
@@ -291,6 +292,7 @@ main() {
             echo "  --dryrun             Print commands without running them"
             echo "  --print              Print platform details"
             echo "  --process <path(s)>  Process prior output without running new benchmarks. Multiple --process values can be specified."
+            echo "  --compare <path>     Compare the results against a baseline JSON file, failing on regressions"
             exit 0;
         elif [[ "$arg" == "--dryrun" ]]; then
             DO_DRY_RUN="true";
@@ -302,6 +304,9 @@ main() {
             data_dirs+=("${ARGS[i + 1]}")
             process_only=true
             skipnext=1;
+        elif [[ "$arg" == "--compare" ]]; then
+            baseline="${ARGS[i + 1]}"
+            skipnext=1;
         fi
     done
 
@@ -329,6 +334,17 @@ main() {
                 --log_dir ${data_dir}
         done
     done
+
+    if [[ -n "${baseline}" ]]; then
+        local status=0
+        for data_dir in ${data_dirs[@]}; do
+            run_command python3 ${SCRIPT_DIR}/compare_release.py compare \
+                ${data_dir}/output ${baseline} \
+                --report ${data_dir}/comparison_report.md \
+                --json ${data_dir}/comparison_report.json || status=1
+        done
+        return $status
+    fi
 }
 
 main "$@"
@@ -18,11 +18,14 @@
 #include <cuda.h>
 #include <cuda_runtime.h>
 
+#include <algorithm>
 #include <string>
 #include <utility>
 
 #include "VideoMasterHD_ApplicationBuffers.h"
 #include "VideoMasterHD_String.h"
+#include "gxf/cuda/cuda_stream.hpp"
+#include "gxf/cuda/cuda_stream_id.hpp"
 #include "gxf/multimedia/video.hpp"
 #include "VideoMasterAPIHelper/api.hpp"
 #include "VideoMasterAPIHelper/api_success.hpp"
@@ -101,6 +104,10 @@ gxf_result_t VideoMasterBase::stop() {
   GXF_LOG_INFO("Stopping stream and closing handles");
 
   if (_stream_handle) {
+    if (_slot_statistics.acquired) {
+      update_dropped_slots();
+      log_slot_statistics();
+    }
     _stream_handle.reset();
   }
 
@@ -114,6 +121,15 @@ gxf_result_t VideoMasterBase::stop() {
 
   free_buffers();
 
+  if (_copy_event) {
+    cudaEventDestroy(_copy_event);
+    _copy_event = nullptr;
+  }
+  if (_copy_stream) {
+    cudaStreamDestroy(_copy_stream);
+    _copy_stream = nullptr;
+  }
+
   return GXF_SUCCESS;
 }
 
@@ -222,6 +238,22 @@ gxf::Expected<void> VideoMasterBase::init_buffers() {
   std::vector<ULONG> buffer_sizes;
   free_buffers();
 
+  // One slot is processed by the pipeline while the board works on the next ones
+  if (_nb_slots < 2) {
+    GXF_LOG_ERROR("At least 2 slots are required, %u configured", _nb_slots.get());
+    return gxf::Unexpected{GXF_FAILURE};
+  }
+  _rdma_buffers.resize(_nb_slots);
+  _non_rdma_buffers.resize(_nb_slots);
+  _slot_handles.resize(_nb_slots);
+
+  if (!_copy_stream &&
+      (cudaStreamCreateWithFlags(&_copy_stream, cudaStreamNonBlocking) != cudaSuccess ||
+       cudaEventCreateWithFlags(&_copy_event, cudaEventDisableTiming) != cudaSuccess)) {
+    GXF_LOG_ERROR("Failed to create the slot copy CUDA stream");
+    return gxf::Unexpected{GXF_FAILURE};
+  }
+
   if (_use_rdma || _is_input) {
     for (auto &slot : _rdma_buffers)
       slot.resize(_video_information->get_nb_buffer_types());
@@ -256,6 +288,12 @@ gxf::Expected<void> VideoMasterBase::init_buffers() {
       if ((buffer_type_index != _video_information->get_buffer_type() || !_use_rdma) || _is_input) {
         void *allocated_buffer = nullptr;
         posix_memalign(&allocated_buffer, 4096, buffer_sizes[buffer_type_index]);
+        // Pinned, so that copies to and from the GPU are asynchronous DMAs
+        if (cudaHostRegister(allocated_buffer, buffer_sizes[buffer_type_index],
+                             cudaHostRegisterDefault) != cudaSuccess) {
+          cudaGetLastError();
+          GXF_LOG_WARNING("Failed to pin slot buffer, GPU copies will be staged");
+        }
         _non_rdma_buffers[slot_index][buffer_type_index] = (BYTE*)allocated_buffer;
       }
     }
@@ -303,12 +341,20 @@ void VideoMasterBase::free_buffers() {
   }
   if (!_use_rdma || _is_input) {
     for (auto& slot : _non_rdma_buffers)
-      for (auto& buffer : slot) free(buffer);
+      for (auto& buffer : slot) {
+        if (buffer) {
+          cudaHostUnregister(buffer);
+          cudaGetLastError();
+        }
+        free(buffer);
+        buffer = nullptr;
+      }
   }
 }
 
 gxf::Expected<void> VideoMasterBase::start_stream() {
   _slot_count = 0;
+  _slot_statistics = {};
 
   const auto &id_to_stream_type = _is_input ? id_to_rx_stream_type : id_to_tx_stream_type;
 
@@ -325,6 +371,62 @@ gxf::Expected<void> VideoMasterBase::start_stream() {
   return gxf::Success;
 }
 
+int VideoMasterBase::slot_index(HANDLE slot_handle) const {
+  auto it = std::find(_slot_handles.begin(), _slot_handles.end(), slot_handle);
+  return it == _slot_handles.end() ? -1 : static_cast<int>(it - _slot_handles.begin());
+}
+
+void VideoMasterBase::record_slot_wait(std::chrono::steady_clock::time_point wait_start,
+                                       bool timed_out) {
+  auto wait_time = std::chrono::duration_cast<std::chrono::nanoseconds>(
+      std::chrono::steady_clock::now() - wait_start);
+  _slot_statistics.wait_time += wait_time;
+  _slot_statistics.max_wait_time = std::max(_slot_statistics.max_wait_time, wait_time);
+  if (timed_out) {
+    _slot_statistics.timeouts++;
+  } else {
+    _slot_statistics.acquired++;
+  }
+}
+
+void VideoMasterBase::update_dropped_slots() {
+  ULONG dropped = 0;
+  if (!Deltacast::Helper::ApiSuccess{
+          VHD_GetStreamProperty(*stream_handle(), VHD_CORE_SP_SLOTS_DROPPED, &dropped)}) {
+    return;
+  }
+  if (dropped > _slot_statistics.dropped) {
+    GXF_LOG_WARNING("%lu slot(s) missed by the board (%lu in total)",
+                    (unsigned long)(dropped - _slot_statistics.dropped), (unsigned long)dropped);
+    _slot_statistics.dropped = dropped;
+  }
+}
+
+void VideoMasterBase::log_slot_statistics() {
+  const auto& stats = _slot_statistics;
+  const double wait_ms = std::chrono::duration<double, std::milli>(stats.wait_time).count();
+  const double max_wait_ms =
+      std::chrono::duration<double, std::milli>(stats.max_wait_time).count();
+  GXF_LOG_INFO("Slots: %lu acquired, %lu missed, %lu timeouts, %lu with the pool exhausted - "
+               "wait %.3f ms average, %.3f ms max", (unsigned long)stats.acquired,
+               (unsigned long)stats.dropped, (unsigned long)stats.timeouts,
+               (unsigned long)stats.exhausted,
+               stats.acquired ? wait_ms / stats.acquired : 0.0, max_wait_ms);
+}
+
+cudaStream_t VideoMasterBase::copy_stream(const gxf::Entity& message) {
+  auto maybe_stream_id = message.get<gxf::CudaStreamId>();
+  if (maybe_stream_id) {
+    auto maybe_stream = gxf::Handle<gxf::CudaStream>::Create(message.context(),
+                                                              maybe_stream_id.value()->stream_cid);
+    if (maybe_stream) {
+      cudaEventRecord(_copy_event, maybe_stream.value()->stream().value());
+      cudaStreamWaitEvent(_copy_stream, _copy_event, 0);
+    }
+  }
+  return _copy_stream;
+}
+
 bool VideoMasterBase::gxf_log_on_error(Deltacast::Helper::ApiSuccess result
                                       , const std::string& message) {
   bool result_b = static_cast<bool>(result);
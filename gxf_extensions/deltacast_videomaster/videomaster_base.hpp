@@ -17,12 +17,16 @@
 #define NVIDIA_HOLOSCAN_GXF_EXTENSIONS_VIDEOMASTER_BASE_HPP_
 
 #include <array>
+#include <chrono>
 #include <string>
 #include <vector>
 #include <optional>
 
+#include <cuda_runtime.h>
+
 #include "VideoMasterHD_Core.h"
 #include "gxf/std/codelet.hpp"
+#include "gxf/std/entity.hpp"
 #include "gxf/std/memory_buffer.hpp"
 #include "VideoMasterAPIHelper/handle_manager.hpp"
 #include "VideoMasterAPIHelper/VideoInformation/core.hpp"
@@ -41,9 +45,21 @@ class VideoMasterBase : public gxf::Codelet {
 
   gxf_result_t stop() override;
 
+  /// Counters of the slot pool, since the stream was started
+  struct SlotStatistics {
+    uint64_t acquired = 0;        ///< Slots filled by the board (source) or filled for it (TX)
+    uint64_t timeouts = 0;        ///< Waits for a slot that timed out
+    uint64_t exhausted = 0;       ///< Source: slots acquired while every other one was held
+    uint64_t dropped = 0;         ///< Slots dropped (RX) or repeated (TX) by the board
+    std::chrono::nanoseconds wait_time{0};      ///< Total time spent waiting for slots
+    std::chrono::nanoseconds max_wait_time{0};  ///< Longest single wait
+  };
+  const SlotStatistics& slot_statistics() const { return _slot_statistics; }
+
  protected:
   static const uint32_t SLOT_TIMEOUT = 100;
-  static const uint32_t NB_SLOTS = 4;
+  static const uint32_t DEFAULT_NB_SLOTS = 4;
+  gxf::Parameter<uint32_t> _nb_slots;
   gxf::Parameter<bool> _use_rdma;
   gxf::Parameter<uint32_t> _board_index;
   gxf::Parameter<uint32_t> _channel_index;
@@ -56,10 +72,14 @@ class VideoMasterBase : public gxf::Codelet {
   VHD_CHANNELTYPE _channel_type;
   bool _has_lost_signal;
   std::unique_ptr<Deltacast::Helper::VideoInformation> _video_information;
-  std::array<std::vector<gxf::MemoryBuffer>, NB_SLOTS> _rdma_buffers;
-  std::array<std::vector<BYTE*>, NB_SLOTS> _non_rdma_buffers;
-  std::array<HANDLE, NB_SLOTS> _slot_handles;
+  std::vector<std::vector<gxf::MemoryBuffer>> _rdma_buffers;
+  std::vector<std::vector<BYTE*>> _non_rdma_buffers;
+  std::vector<HANDLE> _slot_handles;
   uint64_t _slot_count;
+  SlotStatistics _slot_statistics;
+  // Copies between host slots and the GPU, so that they do not wait for the default stream
+  cudaStream_t _copy_stream = nullptr;
+  cudaEvent_t _copy_event = nullptr;
 
   gxf::Expected<void> configure_board();
   gxf::Expected<void> open_stream();
@@ -71,6 +91,13 @@ class VideoMasterBase : public gxf::Codelet {
   bool signal_present();
   bool set_loopback_state(bool state);
 
+  int slot_index(HANDLE slot_handle) const;
+  void record_slot_wait(std::chrono::steady_clock::time_point wait_start, bool timed_out);
+  void update_dropped_slots();
+  void log_slot_statistics();
+  // _copy_stream, after the work queued on the CUDA stream of message, if any
+  cudaStream_t copy_stream(const gxf::Entity& message);
+
   Deltacast::Helper::VideoFormat video_format;
 
  private:
@@ -0,0 +1,151 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "videomaster_composite.hpp"
+
+namespace nvidia {
+namespace holoscan {
+namespace videomaster {
+
+namespace {
+
+constexpr unsigned kBlockWidth = 32;
+constexpr unsigned kBlockHeight = 8;
+constexpr int kPixelsPerGroup = 6;
+
+// Bilinear sample of image at the center of the output pixel (x, y), as RGBA in [0, 1]
+__device__ float4 sample(const DeviceImage& image, int x, int y, int width, int height) {
+  const float sx = fmaxf((x + 0.5f) * image.width / width - 0.5f, 0.f);
+  const float sy = fmaxf((y + 0.5f) * image.height / height - 0.5f, 0.f);
+  const int x0 = min(static_cast<int>(sx), image.width - 1);
+  const int y0 = min(static_cast<int>(sy), image.height - 1);
+  const int x1 = min(x0 + 1, image.width - 1);
+  const int y1 = min(y0 + 1, image.height - 1);
+  const float fx = sx - x0;
+  const float fy = sy - y0;
+
+  float4 result;
+  float* out = &result.x;
+  const uint8_t* row0 = image.data + static_cast<size_t>(y0) * image.pitch;
+  const uint8_t* row1 = image.data + static_cast<size_t>(y1) * image.pitch;
+  for (int c = 0; c < 4; ++c) {
+    if (c >= image.channels) {
+      out[c] = 1.f;
+      continue;
+    }
+    const int c0 = x0 * image.channels + c;
+    const int c1 = x1 * image.channels + c;
+    const float top = row0[c0] * (1.f - fx) + row0[c1] * fx;
+    const float bottom = row1[c0] * (1.f - fx) + row1[c1] * fx;
+    out[c] = (top * (1.f - fy) + bottom * fy) * (1.f / 255.f);
+  }
+  return result;
+}
+
+__device__ inline float3 composite(const DeviceImage& video, const DeviceImage& overlay,
+                                   bool has_overlay, int x, int y, int width, int height) {
+  const float4 v = sample(video, x, y, width, height);
+  if (!has_overlay) { return make_float3(v.x, v.y, v.z); }
+  const float4 o = sample(overlay, x, y, width, height);
+  return make_float3(o.x * o.w + v.x * (1.f - o.w),
+                     o.y * o.w + v.y * (1.f - o.w),
+                     o.z * o.w + v.z * (1.f - o.w));
+}
+
+__device__ inline uint32_t quantize10(float v, float offset, float range) {
+  return static_cast<uint32_t>(fminf(fmaxf(offset + range * v + 0.5f, 4.f), 1019.f));
+}
+
+// BT.709 video range: Y in [64, 940], Cb and Cr in [64, 960] around 512
+__device__ inline uint32_t luma(float3 p) {
+  return quantize10(0.2126f * p.x + 0.7152f * p.y + 0.0722f * p.z, 64.f, 876.f);
+}
+
+__device__ inline void chroma(float3 a, float3 b, uint32_t& cb, uint32_t& cr) {
+  const float r = 0.5f * (a.x + b.x);
+  const float g = 0.5f * (a.y + b.y);
+  const float bl = 0.5f * (a.z + b.z);
+  cb = quantize10(-0.1146f * r - 0.3854f * g + 0.5f * bl, 512.f, 896.f);
+  cr = quantize10(0.5f * r - 0.4542f * g - 0.0458f * bl, 512.f, 896.f);
+}
+
+// One thread per group of 6 pixels, which is one 16-byte v210 block
+__global__ void yuv422_10_kernel(DeviceImage video, DeviceImage overlay, bool has_overlay,
+                                 uint8_t* dst, int dst_pitch, int width, int height) {
+  const int group = blockIdx.x * blockDim.x + threadIdx.x;
+  const int row = blockIdx.y * blockDim.y + threadIdx.y;
+  const int x = group * kPixelsPerGroup;
+  if (x >= width || row >= height) { return; }
+
+  float3 p[kPixelsPerGroup];
+  uint32_t y[kPixelsPerGroup];
+  for (int i = 0; i < kPixelsPerGroup; ++i) {
+    // The padding of the last group of a line repeats the last pixel
+    p[i] = composite(video, overlay, has_overlay, min(x + i, width - 1), row, width, height);
+    y[i] = luma(p[i]);
+  }
+  uint32_t cb[3], cr[3];
+  for (int i = 0; i < 3; ++i) { chroma(p[2 * i], p[2 * i + 1], cb[i], cr[i]); }
+
+  uint4 block;
+  block.x = cb[0] | (y[0] << 10) | (cr[0] << 20);
+  block.y = y[1] | (cb[1] << 10) | (y[2] << 20);
+  block.z = cr[1] | (y[3] << 10) | (cb[2] << 20);
+  block.w = y[4] | (cr[2] << 10) | (y[5] << 20);
+  *reinterpret_cast<uint4*>(dst + static_cast<size_t>(row) * dst_pitch + group * 16) = block;
+}
+
+__global__ void bgra_kernel(DeviceImage image, uint8_t* dst, int dst_pitch, int width,
+                            int height) {
+  const int x = blockIdx.x * blockDim.x + threadIdx.x;
+  const int row = blockIdx.y * blockDim.y + threadIdx.y;
+  if (x >= width || row >= height) { return; }
+
+  const float4 p = sample(image, x, row, width, height);
+  uchar4 out;
+  out.x = static_cast<uint8_t>(p.z * 255.f + 0.5f);
+  out.y = static_cast<uint8_t>(p.y * 255.f + 0.5f);
+  out.z = static_cast<uint8_t>(p.x * 255.f + 0.5f);
+  out.w = static_cast<uint8_t>(p.w * 255.f + 0.5f);
+  *reinterpret_cast<uchar4*>(dst + static_cast<size_t>(row) * dst_pitch + x * 4) = out;
+}
+
+dim3 grid_for(int width, int height) {
+  return dim3((width + kBlockWidth - 1) / kBlockWidth, (height + kBlockHeight - 1) / kBlockHeight);
+}
+
+}  // namespace
+
+cudaError_t compositeToYUV422_10(const DeviceImage& video, const DeviceImage* overlay,
+                                 uint8_t* dst, int dst_pitch, int width, int height,
+                                 cudaStream_t stream) {
+  const int groups = (width + kPixelsPerGroup - 1) / kPixelsPerGroup;
+  yuv422_10_kernel<<<grid_for(groups, height), dim3(kBlockWidth, kBlockHeight), 0, stream>>>(
+      video, overlay ? *overlay : DeviceImage{}, overlay != nullptr, dst, dst_pitch, width,
+      height);
+  return cudaGetLastError();
+}
+
+cudaError_t packToBGRA(const DeviceImage& image, uint8_t* dst, int dst_pitch, int width,
+                       int height, cudaStream_t stream) {
+  bgra_kernel<<<grid_for(width, height), dim3(kBlockWidth, kBlockHeight), 0, stream>>>(
+      image, dst, dst_pitch, width, height);
+  return cudaGetLastError();
+}
+
+}  // namespace videomaster
+}  // namespace holoscan
+}  // namespace nvidia
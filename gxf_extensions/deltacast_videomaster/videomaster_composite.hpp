@@ -0,0 +1,56 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef NVIDIA_HOLOSCAN_GXF_EXTENSIONS_VIDEOMASTER_COMPOSITE_HPP_
+#define NVIDIA_HOLOSCAN_GXF_EXTENSIONS_VIDEOMASTER_COMPOSITE_HPP_
+
+#include <cstdint>
+
+#include <cuda_runtime.h>
+
+namespace nvidia {
+namespace holoscan {
+namespace videomaster {
+
+/// Packed 8-bit RGB (channels 3) or RGBA (channels 4) image in device memory
+struct DeviceImage {
+  const uint8_t* data = nullptr;
+  int width = 0;
+  int height = 0;
+  int channels = 0;
+  int pitch = 0;
+};
+
+// Final stage of the transmitter, writing straight into a slot buffer (dst, device memory).
+// The images are bilinearly resized to width x height, so that no format converter is needed
+// upstream. The kernels are launched on stream; the launch error, if any, is returned.
+
+// Blends overlay (RGBA, may be null) over video and packs the result as BT.709 video range
+// YUV 4:2:2 10-bit (v210: 6 pixels in 4 little-endian words), the VHD_BUFPACK_VIDEO_YUV422_10
+// layout of the board.
+cudaError_t compositeToYUV422_10(const DeviceImage& video, const DeviceImage* overlay,
+                                 uint8_t* dst, int dst_pitch, int width, int height,
+                                 cudaStream_t stream);
+
+// Packs image as the BGRA of VHD_BUFPACK_VIDEO_RGBA_32 (opaque if image is RGB), for the keyer
+cudaError_t packToBGRA(const DeviceImage& image, uint8_t* dst, int dst_pitch, int width,
+                       int height, cudaStream_t stream);
+
+}  // namespace videomaster
+}  // namespace holoscan
+}  // namespace nvidia
+
+#endif  // NVIDIA_HOLOSCAN_GXF_EXTENSIONS_VIDEOMASTER_COMPOSITE_HPP_
@@ -18,6 +18,9 @@
 #include <cuda.h>
 #include <cuda_runtime.h>
 
+#include <chrono>
+#include <memory>
+#include <mutex>
 #include <string>
 #include <utility>
 
@@ -28,7 +31,8 @@ namespace nvidia {
 namespace holoscan {
 namespace videomaster {
 
-VideoMasterSource::VideoMasterSource() : VideoMasterBase(true) {}
+VideoMasterSource::VideoMasterSource()
+    : VideoMasterBase(true), _released_slots(std::make_shared<ReleasedSlots>()) {}
 
 gxf_result_t VideoMasterSource::registerInterface(gxf::Registrar *registrar) {
   gxf::Expected<void> result;
@@ -47,6 +51,8 @@ gxf_result_t VideoMasterSource::registerInterface(gxf::Registrar *registrar) {
                                  "Progressiveness of the video frames to send.");
   result &= registrar->parameter(_framerate, "framerate", "Framerate",
                                  "Framerate of the signal to generate.");
+  result &= registrar->parameter(_nb_slots, "slots", "Slots",
+                                 "Number of slots the board captures into.", DEFAULT_NB_SLOTS);
 
   return gxf::ToResultCode(result);
 }
@@ -80,6 +86,11 @@ gxf_result_t VideoMasterSource::tick() {
       return GXF_FAILURE;
     }
 
+    {
+      std::lock_guard<std::mutex> lock(_released_slots->mutex);
+      _released_slots->slots.clear();
+    }
+    _held_slots = 0;
     result &= init_buffers();
     result &= start_stream();
 
@@ -99,16 +110,24 @@ gxf_result_t VideoMasterSource::tick() {
     return GXF_FAILURE;
   }
 
+  queue_released_slots();
+
   HANDLE slot_handle;
+  auto wait_start = std::chrono::steady_clock::now();
   ULONG api_result = VHD_WaitSlotFilled(*stream_handle(), &slot_handle, SLOT_TIMEOUT);
+  record_slot_wait(wait_start, api_result == VHDERR_TIMEOUT);
   if (api_result != VHDERR_NOERROR && api_result != VHDERR_TIMEOUT) {
     GXF_LOG_ERROR("Failed to wait for incoming slot");
     return GXF_FAILURE;
   }
   if (api_result != VHDERR_NOERROR && api_result == VHDERR_TIMEOUT) {
-    GXF_LOG_INFO("Timeout");
+    if (_held_slots == _slot_handles.size())
+      GXF_LOG_INFO("Timeout, every slot is still held downstream");
+    else
+      GXF_LOG_INFO("Timeout");
     return GXF_SUCCESS;
   }
+  update_dropped_slots();
 
   BYTE *buffer = nullptr;
   ULONG buffer_size = 0;
@@ -119,23 +138,55 @@ gxf_result_t VideoMasterSource::tick() {
                                 }, "Failed to get slot buffer");
 
   if (!success_b) {
+    VHD_QueueInSlot(slot_handle);
     return GXF_FAILURE;
   }
 
-  auto result = transmit_buffer_data(buffer, buffer_size);
+  // The slot is held until every message wrapping its buffer is destroyed, while the board
+  // keeps capturing into the other ones
+  _held_slots++;
+  if (_held_slots == _slot_handles.size())
+    _slot_statistics.exhausted++;
 
-  VHD_QueueInSlot(slot_handle);
+  auto result = transmit_buffer_data(slot_handle, buffer, buffer_size);
+  if (!result) {
+    VHD_QueueInSlot(slot_handle);
+    _held_slots--;
+  }
   _slot_count++;
 
   return gxf::ToResultCode(result);
 }
 
-gxf::Expected<void> VideoMasterSource::transmit_buffer_data(void *buffer, uint32_t buffer_size) {
+void VideoMasterSource::queue_released_slots() {
+  std::vector<HANDLE> released;
+  {
+    std::lock_guard<std::mutex> lock(_released_slots->mutex);
+    released.swap(_released_slots->slots);
+  }
+  for (HANDLE slot_handle : released) {
+    gxf_log_on_error(Deltacast::Helper::ApiSuccess{VHD_QueueInSlot(slot_handle)}
+                     , "Failed to queue slot");
+    _held_slots--;
+  }
+}
+
+gxf::Expected<void> VideoMasterSource::transmit_buffer_data(HANDLE slot_handle, void *buffer,
+                                                            uint32_t buffer_size) {
   if (!_use_rdma) {
-    cudaMemcpy(_rdma_buffers[_slot_count % NB_SLOTS]
-                            [_video_information->get_buffer_type()].pointer(), buffer,
-               buffer_size, cudaMemcpyHostToDevice);
-    buffer = _rdma_buffers[_slot_count % NB_SLOTS][_video_information->get_buffer_type()].pointer();
+    // Each slot has its own device buffer, held along with the slot
+    int index = slot_index(slot_handle);
+    if (index < 0) {
+      GXF_LOG_ERROR("Unknown slot filled by the board");
+      return gxf::Unexpected{GXF_FAILURE};
+    }
+    void *device_buffer = _rdma_buffers[index][_video_information->get_buffer_type()].pointer();
+    cudaMemcpyAsync(device_buffer, buffer, buffer_size, cudaMemcpyHostToDevice, _copy_stream);
+    if (cudaStreamSynchronize(_copy_stream) != cudaSuccess) {
+      GXF_LOG_ERROR("Failed to copy the slot buffer to the device");
+      return gxf::Unexpected{GXF_FAILURE};
+    }
+    buffer = device_buffer;
   }
   auto message = gxf::Entity::New(context());
   if (!message) {
@@ -159,7 +210,12 @@ gxf::Expected<void> VideoMasterSource::transmit_buffer_data(void *buffer, uint32
   gxf::VideoBufferInfo info{format->width, format->height, video_type.value, color_planes,
                             gxf::SurfaceLayout::GXF_SURFACE_LAYOUT_PITCH_LINEAR};
   auto storage_type = gxf::MemoryStorageType::kDevice;
-  target_buffer.value()->wrapMemory(info, buffer_size, storage_type, buffer, nullptr);
+  target_buffer.value()->wrapMemory(info, buffer_size, storage_type, buffer,
+      [released_slots = _released_slots, slot_handle](void*) {
+        std::lock_guard<std::mutex> lock(released_slots->mutex);
+        released_slots->slots.push_back(slot_handle);
+        return gxf::Success;
+      });
 
   return _signal->publish(std::move(message.value()));
 }
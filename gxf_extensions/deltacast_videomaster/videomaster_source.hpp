@@ -17,6 +17,8 @@
 #define NVIDIA_HOLOSCAN_GXF_EXTENSIONS_VIDEOMASTER_SOURCE_HPP_
 
 #include <array>
+#include <memory>
+#include <mutex>
 #include <string>
 #include <vector>
 
@@ -39,7 +41,18 @@ class VideoMasterSource : public VideoMasterBase {
  private:
   gxf::Parameter<gxf::Handle<gxf::Transmitter>> _signal;
 
-  gxf::Expected<void> transmit_buffer_data(void* buffer, uint32_t buffer_size);
+  // Slots whose buffer was released downstream, to queue back to the board on the next tick
+  struct ReleasedSlots {
+    std::mutex mutex;
+    std::vector<HANDLE> slots;
+  };
+
+  gxf::Expected<void> transmit_buffer_data(HANDLE slot_handle, void* buffer, uint32_t buffer_size);
+  void queue_released_slots();
+
+  // Shared with the release callbacks, which may run after the codelet is destroyed
+  std::shared_ptr<ReleasedSlots> _released_slots;
+  uint32_t _held_slots = 0;
   gxf::Parameter<uint32_t> _width;
   gxf::Parameter<uint32_t> _height;
   gxf::Parameter<bool> _progressive;
@@ -18,6 +18,7 @@
 #include <cuda.h>
 #include <cuda_runtime.h>
 
+#include <chrono>
 #include <string>
 #include <utility>
 
@@ -25,11 +26,73 @@
 #include "VideoMasterHD_Sdi.h"
 #include "VideoMasterHD_Keyer.h"
 #include "gxf/multimedia/video.hpp"
+#include "gxf/std/tensor.hpp"
 
 namespace nvidia {
 namespace holoscan {
 namespace videomaster {
 
+namespace {
+
+// RGB(A) image of the message, from the tensor or the video buffer (e.g. the render buffer of
+// Holoviz) named name, or the first of them if name is empty
+gxf::Expected<DeviceImage> find_image(const gxf::Entity& message, const std::string& name) {
+  const char* component_name = name.empty() ? nullptr : name.c_str();
+  DeviceImage image;
+  gxf::MemoryStorageType storage = gxf::MemoryStorageType::kDevice;
+
+  auto maybe_tensor = message.get<gxf::Tensor>(component_name);
+  auto maybe_video_buffer = message.get<gxf::VideoBuffer>(component_name);
+  if (maybe_tensor) {
+    auto tensor = maybe_tensor.value();
+    const auto shape = tensor->shape();
+    const int rank = shape.rank();
+    if (tensor->element_type() != gxf::PrimitiveType::kUnsigned8 || rank < 3 ||
+        (rank == 4 && shape.dimension(0) != 1) || rank > 4) {
+      GXF_LOG_ERROR("Tensor '%s' is not a uint8 HWC image", name.c_str());
+      return gxf::Unexpected{GXF_INVALID_DATA_FORMAT};
+    }
+    image.data = tensor->pointer();
+    image.height = shape.dimension(rank - 3);
+    image.width = shape.dimension(rank - 2);
+    image.channels = shape.dimension(rank - 1);
+    image.pitch = tensor->stride(rank - 3);
+    storage = tensor->storage_type();
+  } else if (maybe_video_buffer) {
+    auto video_buffer = maybe_video_buffer.value();
+    const auto& info = video_buffer->video_frame_info();
+    if (info.color_format == gxf::VideoFormat::GXF_VIDEO_FORMAT_RGBA) {
+      image.channels = 4;
+    } else if (info.color_format == gxf::VideoFormat::GXF_VIDEO_FORMAT_RGB) {
+      image.channels = 3;
+    } else {
+      GXF_LOG_ERROR("Video buffer '%s' is neither RGB nor RGBA", name.c_str());
+      return gxf::Unexpected{GXF_INVALID_DATA_FORMAT};
+    }
+    image.data = video_buffer->pointer();
+    image.width = info.width;
+    image.height = info.height;
+    image.pitch = info.color_planes[0].stride;
+    storage = video_buffer->storage_type();
+  } else {
+    GXF_LOG_ERROR("No tensor or video buffer '%s' in the message", name.c_str());
+    return gxf::Unexpected{GXF_FAILURE};
+  }
+
+  if (image.channels != 3 && image.channels != 4) {
+    GXF_LOG_ERROR("Image '%s' has %d channels, expected RGB or RGBA", name.c_str(),
+                  image.channels);
+    return gxf::Unexpected{GXF_INVALID_DATA_FORMAT};
+  }
+  if (storage != gxf::MemoryStorageType::kDevice) {
+    GXF_LOG_ERROR("Image '%s' is not in device memory", name.c_str());
+    return gxf::Unexpected{GXF_MEMORY_INVALID_STORAGE_MODE};
+  }
+  return image;
+}
+
+}  // namespace
+
 const std::unordered_map<uint32_t, VHD_GENLOCKSOURCE> id_to_genlock_source = {
     {0, VHD_GENLOCK_RX0}, {1, VHD_GENLOCK_RX1}, {2, VHD_GENLOCK_RX2},   {3, VHD_GENLOCK_RX3},
     {4, VHD_GENLOCK_RX4}, {5, VHD_GENLOCK_RX5}, {6, VHD_GENLOCK_RX6},   {7, VHD_GENLOCK_RX7},
@@ -73,8 +136,17 @@ gxf_result_t VideoMasterTransmitter::registerInterface(gxf::Registrar *registrar
                                  "Framerate of the signal to generate.");
   result &= registrar->parameter(_source, "source", "Source", "Source data.");
   result &= registrar->parameter(_pool, "pool", "Pool", "Pool to allocate the buffers.");
+  result &= registrar->parameter(_nb_slots, "slots", "Slots",
+                                 "Number of slots queued to the board.", DEFAULT_NB_SLOTS);
   result &= registrar->parameter(_overlay, "enable_overlay", "Overlay",
                 "Specifies whether the input buffers should be treated as overlay data.", false);
+  result &= registrar->parameter(_video_tensor, "video_tensor", "Video tensor",
+                "Name of the RGB or RGBA tensor or video buffer to send, the first one if empty.",
+                std::string(""));
+  result &= registrar->parameter(_overlay_tensor, "overlay_tensor", "Overlay tensor",
+                "Name of an RGBA tensor or video buffer of the same message, alpha blended over "
+                "the video before it is sent. None if empty; unused with enable_overlay, where "
+                "the keyer of the board blends the input over the live video.", std::string(""));
 
   return gxf::ToResultCode(result);
 }
@@ -93,6 +165,7 @@ gxf_result_t VideoMasterTransmitter::start() {
       VHD_SetBoardProperty(*board_handle(), *opt_sync_source_property, VHD_GENLOCK_LOCAL);
 
     result &= configure_stream();
+    result &= configure_stream_for_yuv();
     result &= init_buffers();
     result &= start_stream();
 
@@ -113,14 +186,6 @@ gxf_result_t VideoMasterTransmitter::tick() {
   }
   message = std::move(maybe_message.value());
 
-  gxf::Expected<gxf::Handle<gxf::Tensor>> maybe_video = gxf::Unexpected{GXF_UNINITIALIZED_VALUE};
-  maybe_video = message.get<gxf::Tensor>();
-  if (!maybe_video) {
-    GXF_LOG_ERROR("Failed to retrieve VideoBuffer");
-    return GXF_FAILURE;
-  }
-  auto frame = maybe_video.value();
-
   if (_overlay) {
     if (!signal_present()) {
       if (!_has_lost_signal)
@@ -151,13 +216,18 @@ gxf_result_t VideoMasterTransmitter::tick() {
 
   HANDLE slot_handle;
   if (_slot_count >= _slot_handles.size()) {
-    success_b = gxf_log_on_error(Deltacast::Helper::ApiSuccess{
-                                      VHD_WaitSlotSent(*stream_handle(), &slot_handle, SLOT_TIMEOUT)
-                                      }, "Failed to wait for slot to be sent");
+    auto wait_start = std::chrono::steady_clock::now();
+    ULONG api_result = VHD_WaitSlotSent(*stream_handle(), &slot_handle, SLOT_TIMEOUT);
+    record_slot_wait(wait_start, api_result == VHDERR_TIMEOUT);
+    success_b = gxf_log_on_error(Deltacast::Helper::ApiSuccess{api_result}
+                                 , "Failed to wait for slot to be sent");
     if (!success_b)
       return GXF_FAILURE;
+    update_dropped_slots();
   } else {
-    slot_handle = _slot_handles[_slot_count % NB_SLOTS];
+    // The first slots of the pool are filled before the board has sent any of them
+    slot_handle = _slot_handles[_slot_count % _slot_handles.size()];
+    _slot_statistics.acquired++;
   }
 
   BYTE *buffer = nullptr;
@@ -171,8 +241,10 @@ gxf_result_t VideoMasterTransmitter::tick() {
     return GXF_FAILURE;
   }
 
-  cudaMemcpy(buffer, frame->pointer(), buffer_size,
-            (_use_rdma ? cudaMemcpyDeviceToDevice : cudaMemcpyDeviceToHost));
+  auto written = write_slot(message, buffer, buffer_size);
+  if (!written) {
+    return gxf::ToResultCode(written);
+  }
 
   success_b = gxf_log_on_error(Deltacast::Helper::ApiSuccess{
                                     VHD_QueueOutSlot(slot_handle)
@@ -186,6 +258,58 @@ gxf_result_t VideoMasterTransmitter::tick() {
   return GXF_SUCCESS;
 }
 
+gxf_result_t VideoMasterTransmitter::stop() {
+  _staging_buffer.freeBuffer();
+  return VideoMasterBase::stop();
+}
+
+gxf::Expected<void> VideoMasterTransmitter::write_slot(const gxf::Entity& message, BYTE* buffer,
+                                                       ULONG buffer_size) {
+  auto video = find_image(message, _video_tensor.get());
+  if (!video) {
+    return gxf::ForwardError(video);
+  }
+  gxf::Expected<DeviceImage> overlay = gxf::Unexpected{GXF_UNINITIALIZED_VALUE};
+  if (!_overlay && !_overlay_tensor.get().empty()) {
+    overlay = find_image(message, _overlay_tensor.get());
+    if (!overlay) {
+      return gxf::ForwardError(overlay);
+    }
+  }
+
+  // Host slots are written through a device buffer, copied at once over PCIe
+  uint8_t* destination = buffer;
+  if (!_use_rdma) {
+    if (_staging_buffer.size() != buffer_size) {
+      auto resized = _staging_buffer.resize(_pool, buffer_size, gxf::MemoryStorageType::kDevice);
+      if (!resized) {
+        GXF_LOG_ERROR("Failed to allocate the staging buffer");
+        return gxf::ForwardError(resized);
+      }
+    }
+    destination = _staging_buffer.pointer();
+  }
+
+  // Ordered after the producer of the frame, without waiting for the rest of the device
+  cudaStream_t stream = copy_stream(message);
+  const int width = video_format.width;
+  const int height = video_format.height;
+  const int pitch = buffer_size / height;
+  cudaError_t cuda_result =
+      _overlay ? packToBGRA(video.value(), destination, pitch, width, height, stream)
+               : compositeToYUV422_10(video.value(), overlay ? &overlay.value() : nullptr,
+                                      destination, pitch, width, height, stream);
+  if (cuda_result == cudaSuccess && !_use_rdma) {
+    cuda_result = cudaMemcpyAsync(buffer, destination, buffer_size, cudaMemcpyDeviceToHost,
+                                  stream);
+  }
+  if (cuda_result != cudaSuccess || cudaStreamSynchronize(stream) != cudaSuccess) {
+    GXF_LOG_ERROR("Failed to write the frame to the slot buffer");
+    return gxf::Unexpected{GXF_FAILURE};
+  }
+  return gxf::Success;
+}
+
 gxf::Expected<void> VideoMasterTransmitter::configure_board_for_overlay() {
   bool success_b = true;
 
@@ -264,6 +388,17 @@ gxf::Expected<void> VideoMasterTransmitter::configure_stream_for_overlay() {
   return success_b ? gxf::Success : gxf::Unexpected{GXF_FAILURE};
 }
 
+gxf::Expected<void> VideoMasterTransmitter::configure_stream_for_yuv() {
+  // The SDI signal is YUV 4:2:2 10-bit, which the composite kernel packs itself
+  bool success_b = gxf_log_on_error(Deltacast::Helper::ApiSuccess{
+                                    VHD_SetStreamProperty(*stream_handle()
+                                                         , VHD_CORE_SP_BUFFER_PACKING
+                                                         , VHD_BUFPACK_VIDEO_YUV422_10)
+                                     }, "Could not set buffer packing");
+
+  return success_b ? gxf::Success : gxf::Unexpected{GXF_FAILURE};
+}
+
 }  // namespace videomaster
 }  // namespace holoscan
 }  // namespace nvidia
@@ -22,6 +22,7 @@
 
 #include "gxf/std/receiver.hpp"
 #include "videomaster_base.hpp"
+#include "videomaster_composite.hpp"
 
 namespace nvidia {
 namespace holoscan {
@@ -35,6 +36,7 @@ class VideoMasterTransmitter : public VideoMasterBase {
 
   gxf_result_t start() override;
   gxf_result_t tick() override;
+  gxf_result_t stop() override;
 
  private:
   gxf::Parameter<gxf::Handle<gxf::Receiver>> _source;
@@ -43,9 +45,15 @@ class VideoMasterTransmitter : public VideoMasterBase {
   gxf::Parameter<bool> _progressive;
   gxf::Parameter<uint32_t> _framerate;
   gxf::Parameter<bool> _overlay;
+  gxf::Parameter<std::string> _video_tensor;
+  gxf::Parameter<std::string> _overlay_tensor;
+  // Written by the kernels when the slots are in host memory, then copied to the slot
+  gxf::MemoryBuffer _staging_buffer;
 
   gxf::Expected<void> configure_board_for_overlay();
   gxf::Expected<void> configure_stream_for_overlay();
+  gxf::Expected<void> configure_stream_for_yuv();
+  gxf::Expected<void> write_slot(const gxf::Entity& message, BYTE* buffer, ULONG buffer_size);
 };
 
 }  // namespace videomaster
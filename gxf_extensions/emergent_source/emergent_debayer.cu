@@ -0,0 +1,143 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "emergent_debayer.hpp"
+
+namespace nvidia {
+namespace holoscan {
+
+namespace {
+
+constexpr unsigned kBlockWidth = 32;
+constexpr unsigned kBlockHeight = 8;
+
+// Mosaic sampled with the borders mirrored, so that every site has neighbors of each color
+struct Mosaic {
+  const uint8_t* data;
+  int pitch;
+  int width;
+  int height;
+
+  __device__ inline float operator()(int x, int y) const {
+    x = x < 0 ? -x : (x >= width ? 2 * width - 2 - x : x);
+    y = y < 0 ? -y : (y >= height ? 2 * height - 2 - y : y);
+    return static_cast<float>(data[y * pitch + x]);
+  }
+};
+
+__device__ inline uint8_t clamp_u8(float v) {
+  return static_cast<uint8_t>(fminf(fmaxf(v + 0.5f, 0.f), 255.f));
+}
+
+// Sum of the samples 1 and 2 away along each axis, and of the diagonal ones
+__device__ inline float axis1(const Mosaic& m, int x, int y) {
+  return m(x - 1, y) + m(x + 1, y) + m(x, y - 1) + m(x, y + 1);
+}
+__device__ inline float horizontal2(const Mosaic& m, int x, int y) {
+  return m(x - 2, y) + m(x + 2, y);
+}
+__device__ inline float vertical2(const Mosaic& m, int x, int y) {
+  return m(x, y - 2) + m(x, y + 2);
+}
+__device__ inline float diagonal1(const Mosaic& m, int x, int y) {
+  return m(x - 1, y - 1) + m(x + 1, y - 1) + m(x - 1, y + 1) + m(x + 1, y + 1);
+}
+
+// Green at a red or blue site
+__device__ inline float green_at_chroma(const Mosaic& m, int x, int y, DebayerMethod method) {
+  if (method == DebayerMethod::kBilinear) { return 0.25f * axis1(m, x, y); }
+  // Hamilton-Adams: interpolate along the direction with the smaller gradient, corrected by
+  // the second derivative of the center color
+  const float c = m(x, y);
+  const float lh = 2.f * c - horizontal2(m, x, y);
+  const float lv = 2.f * c - vertical2(m, x, y);
+  const float gh = 0.5f * (m(x - 1, y) + m(x + 1, y)) + 0.25f * lh;
+  const float gv = 0.5f * (m(x, y - 1) + m(x, y + 1)) + 0.25f * lv;
+  const float dh = fabsf(m(x - 1, y) - m(x + 1, y)) + fabsf(lh);
+  const float dv = fabsf(m(x, y - 1) - m(x, y + 1)) + fabsf(lv);
+  return dh < dv ? gh : (dv < dh ? gv : 0.5f * (gh + gv));
+}
+
+// At a green site, the color whose samples are left and right (horizontal) or above and below
+__device__ inline float chroma_at_green(const Mosaic& m, int x, int y, bool horizontal,
+                                        DebayerMethod method) {
+  const float near = horizontal ? m(x - 1, y) + m(x + 1, y) : m(x, y - 1) + m(x, y + 1);
+  if (method == DebayerMethod::kBilinear) { return 0.5f * near; }
+  // Malvar-He-Cutler gradient-corrected interpolation
+  const float along = horizontal ? horizontal2(m, x, y) : vertical2(m, x, y);
+  const float across = horizontal ? vertical2(m, x, y) : horizontal2(m, x, y);
+  return (5.f * m(x, y) + 4.f * near - along - diagonal1(m, x, y) + 0.5f * across) * 0.125f;
+}
+
+// Red at a blue site or blue at a red one
+__device__ inline float chroma_at_chroma(const Mosaic& m, int x, int y, DebayerMethod method) {
+  if (method == DebayerMethod::kBilinear) { return 0.25f * diagonal1(m, x, y); }
+  return (6.f * m(x, y) + 2.f * diagonal1(m, x, y) -
+          1.5f * (horizontal2(m, x, y) + vertical2(m, x, y))) *
+         0.125f;
+}
+
+// One thread per pixel. red_x and red_y are the parity of the red sites.
+__global__ void debayer_kernel(Mosaic m, uint8_t* dst, int dst_pitch, int channels, int red_x,
+                               int red_y, DebayerMethod method) {
+  const int x = blockIdx.x * blockDim.x + threadIdx.x;
+  const int y = blockIdx.y * blockDim.y + threadIdx.y;
+  if (x >= m.width || y >= m.height) { return; }
+
+  const bool red_row = (y & 1) == red_y;
+  const bool red_column = (x & 1) == red_x;
+  float r, g, b;
+  if (red_row == red_column) {
+    // Red or blue site
+    const float c = m(x, y);
+    const float other = chroma_at_chroma(m, x, y, method);
+    g = green_at_chroma(m, x, y, method);
+    r = red_row ? c : other;
+    b = red_row ? other : c;
+  } else {
+    // Green site, red is along the row on red rows
+    g = m(x, y);
+    const float along_row = chroma_at_green(m, x, y, true, method);
+    const float along_column = chroma_at_green(m, x, y, false, method);
+    r = red_row ? along_row : along_column;
+    b = red_row ? along_column : along_row;
+  }
+
+  uint8_t* out = dst + static_cast<size_t>(y) * dst_pitch + x * channels;
+  out[0] = clamp_u8(r);
+  out[1] = clamp_u8(g);
+  out[2] = clamp_u8(b);
+  if (channels == 4) { out[3] = 255; }
+}
+
+}  // namespace
+
+cudaError_t debayer(const uint8_t* src, int src_pitch, uint8_t* dst, int dst_pitch, int width,
+                    int height, int dst_channels, BayerPattern pattern, DebayerMethod method,
+                    cudaStream_t stream) {
+  // Parity of the red sites: RGGB (0, 0), GBRG (0, 1), GRBG (1, 0), BGGR (1, 1)
+  const int red_x = (pattern == BayerPattern::kGRBG || pattern == BayerPattern::kBGGR) ? 1 : 0;
+  const int red_y = (pattern == BayerPattern::kGBRG || pattern == BayerPattern::kBGGR) ? 1 : 0;
+  const dim3 block(kBlockWidth, kBlockHeight);
+  const dim3 grid((width + kBlockWidth - 1) / kBlockWidth,
+                  (height + kBlockHeight - 1) / kBlockHeight);
+  debayer_kernel<<<grid, block, 0, stream>>>(
+      Mosaic{src, src_pitch, width, height}, dst, dst_pitch, dst_channels, red_x, red_y, method);
+  return cudaGetLastError();
+}
+
+}  // namespace holoscan
+}  // namespace nvidia
@@ -0,0 +1,45 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef NVIDIA_HOLOSCAN_GXF_EXTENSIONS_EMERGENT_DEBAYER_HPP_
+#define NVIDIA_HOLOSCAN_GXF_EXTENSIONS_EMERGENT_DEBAYER_HPP_
+
+#include <cstdint>
+
+#include <cuda_runtime.h>
+
+namespace nvidia {
+namespace holoscan {
+
+/// Color of the top-left 2x2 quad of the mosaic, read left to right and top to bottom
+enum class BayerPattern { kRGGB, kGBRG, kGRBG, kBGGR };
+
+enum class DebayerMethod {
+  kBilinear,   ///< Average of the nearest samples of each color
+  kEdgeAware,  ///< Green along the smoother direction, red and blue gradient-corrected
+};
+
+// Demosaics an 8-bit Bayer frame to packed RGB (dst_channels 3) or RGBA (dst_channels 4,
+// opaque alpha). Source and destination are device pointers. The kernel is launched on stream;
+// the launch error, if any, is returned.
+cudaError_t debayer(const uint8_t* src, int src_pitch, uint8_t* dst, int dst_pitch, int width,
+                    int height, int dst_channels, BayerPattern pattern, DebayerMethod method,
+                    cudaStream_t stream);
+
+}  // namespace holoscan
+}  // namespace nvidia
+
+#endif  // NVIDIA_HOLOSCAN_GXF_EXTENSIONS_EMERGENT_DEBAYER_HPP_
@@ -16,16 +16,70 @@
  */
 
 #include <string.h>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <string>
+#include <thread>
 #include <utility>
+#include <vector>
 
 #include "gxf/core/handle.hpp"
 #include "gxf/multimedia/video.hpp"
+#include "gxf/std/timestamp.hpp"
 #include "emergent_source.hpp"
 
 
 namespace nvidia {
 namespace holoscan {
 
+namespace {
+
+// Receptions of a camera behind the others before a synchronized tick gives up
+constexpr uint32_t kMaxAlignFrames = FRAMES_BUFFERS;
+// Time for the cameras to lock to the PTP master, and from arming to the first frame
+constexpr auto kPtpLockTimeout = std::chrono::seconds(10);
+constexpr uint64_t kPtpGateDelayNs = 1000000000ULL;
+
+int64_t SteadyClockNow() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+// Timestamps the message with the host time the (first) frame was received at
+gxf_result_t AddTimestamp(gxf::Entity& message, int64_t acqtime) {
+  auto timestamp = message.add<gxf::Timestamp>("timestamp");
+  if (!timestamp) {
+    GXF_LOG_ERROR("Failed to allocate timestamp.\n");
+    return GXF_FAILURE;
+  }
+  timestamp.value()->acqtime = acqtime;
+  timestamp.value()->pubtime = SteadyClockNow();
+  return GXF_SUCCESS;
+}
+
+bool ToBayerPattern(PIXEL_FORMAT format, BayerPattern* pattern) {
+  switch (format) {
+    case GVSP_PIX_BAYRG8:
+      *pattern = BayerPattern::kRGGB;
+      return true;
+    case GVSP_PIX_BAYGB8:
+      *pattern = BayerPattern::kGBRG;
+      return true;
+    case GVSP_PIX_BAYGR8:
+      *pattern = BayerPattern::kGRBG;
+      return true;
+    case GVSP_PIX_BAYBG8:
+      *pattern = BayerPattern::kBGGR;
+      return true;
+    default:
+      return false;
+  }
+}
+
+}  // namespace
+
 EmergentSource::EmergentSource() {}
 
 gxf_result_t EmergentSource::registerInterface(gxf::Registrar* registrar) {
@@ -47,12 +101,37 @@ gxf_result_t EmergentSource::registerInterface(gxf::Registrar* registrar) {
   result &= registrar->parameter(
     gain_, "gain", "gain",
     "Analog Gain", kDefaultGain);
+  result &= registrar->parameter(
+    debayer_, "debayer", "Debayer",
+    "Demosaic on the GPU: none, bilinear or edge_aware.", std::string(kDefaultDebayer));
+  result &= registrar->parameter(
+    generate_alpha_, "generate_alpha", "Generate Alpha",
+    "Output RGBA instead of RGB when debayering.", kDefaultGenerateAlpha);
+  result &= registrar->parameter(
+    batch_size_, "batch_size", "Batch Size",
+    "Number of frames gathered into each published tensor, 1 to publish every frame.",
+    kDefaultBatchSize);
+  result &= registrar->parameter(
+    pool_, "pool", "Pool",
+    "Allocator of the debayered and batched frames.",
+    gxf::Registrar::NoDefaultParameter(), GXF_PARAMETER_FLAGS_OPTIONAL);
+  result &= registrar->parameter(
+    num_cameras_, "num_cameras", "Number of Cameras",
+    "Number of cameras captured together, one frame of each per message.", kDefaultNumCameras);
+  result &= registrar->parameter(
+    serials_, "serials", "Serials",
+    "Serial numbers of the cameras to open, in output order. The first EVT cameras if empty.",
+    std::vector<std::string>{});
+  result &= registrar->parameter(
+    sync_, "sync", "Sync",
+    "Camera synchronization: none, ptp or trigger.", std::string(kDefaultSync));
+  result &= cuda_stream_handler_.registerInterface(registrar);
   return gxf::ToResultCode(result);
 }
 
-EVT_ERROR EmergentSource::OpenEVTCamera() {
+EVT_ERROR EmergentSource::OpenEVTCameras() {
   struct GigEVisionDeviceInfo deviceInfo[kMaxCameras];
-  unsigned int count, camera_index;
+  unsigned int count;
   EVT_ERROR err = EVT_SUCCESS;
 
   // Find all cameras in system.
@@ -63,72 +142,89 @@ EVT_ERROR EmergentSource::OpenEVTCamera() {
     return EVT_ERROR_ENODEV;
   }
 
-  // Find and use first EVT camera.
-  for (camera_index = 0; camera_index < kMaxCameras; camera_index++) {
+  // Find the EVT cameras, in the order of serials if given.
+  std::vector<unsigned int> evt_cameras;
+  for (unsigned int camera_index = 0; camera_index < std::min(count, kMaxCameras);
+       camera_index++) {
     const char* EVT_models[] = { "HS", "HT", "HR", "HB", "LR", "LB", "HZ" };
     int EVT_models_count = sizeof(EVT_models) / sizeof(EVT_models[0]);
-    bool is_EVT_camera = false;
     for (int i = 0; i < EVT_models_count; i++) {
       if (strncmp(deviceInfo[camera_index].modelName, EVT_models[i], 2) == 0) {
-        is_EVT_camera = true;
+        evt_cameras.push_back(camera_index);
         break;  // it is an EVT camera
       }
     }
-    if (is_EVT_camera) {
-      break;  // Use the first EVT camera.
-    }
-    if (camera_index == (kMaxCameras - 1)) {
-      GXF_LOG_ERROR("No EVT cameras found.\n");
+  }
+  std::vector<unsigned int> selected;
+  if (serials_.get().empty()) {
+    if (evt_cameras.size() < cameras_.size()) {
+      GXF_LOG_ERROR("Found %zu EVT cameras, %zu requested.\n", evt_cameras.size(),
+                    cameras_.size());
       return EVT_ERROR_ENODEV;
     }
+    selected.assign(evt_cameras.begin(), evt_cameras.begin() + cameras_.size());
+  } else {
+    for (const auto& serial : serials_.get()) {
+      auto found = std::find_if(evt_cameras.begin(), evt_cameras.end(), [&](unsigned int i) {
+        return serial == deviceInfo[i].serialNumber;
+      });
+      if (found == evt_cameras.end()) {
+        GXF_LOG_ERROR("No EVT camera with serial number %s.\n", serial.c_str());
+        return EVT_ERROR_ENODEV;
+      }
+      selected.push_back(*found);
+    }
   }
 
-  // Open the camera with GPU 0 if use_rdma_ == true.
-  if (use_rdma_) {
-    camera_.gpuDirectDeviceId = 0;
-  }
-  err = EVT_CameraOpen(&camera_, &deviceInfo[camera_index]);
-  if (err != EVT_SUCCESS) {
-    GXF_LOG_ERROR("Error while opening camera.\n");
-    return err;
+  // Open the cameras with GPU 0 if use_rdma_ == true.
+  for (size_t i = 0; i < cameras_.size(); i++) {
+    if (use_rdma_) {
+      cameras_[i].camera.gpuDirectDeviceId = 0;
+    }
+    err = EVT_CameraOpen(&cameras_[i].camera, &deviceInfo[selected[i]]);
+    if (err != EVT_SUCCESS) {
+      GXF_LOG_ERROR("Error while opening camera %s.\n", deviceInfo[selected[i]].serialNumber);
+      for (size_t j = 0; j < i; j++) { EVT_CameraClose(&cameras_[j].camera); }
+      return err;
+    }
   }
   return err;
 }
 
-EVT_ERROR EmergentSource::CheckCameraCapabilities() {
+EVT_ERROR EmergentSource::CheckCameraCapabilities(CEmergentCamera* camera) {
   EVT_ERROR err = EVT_SUCCESS;
   unsigned int height_max, width_max;
   unsigned int frame_rate_max, frame_rate_min;
 
   // Check resolution
-  EVT_CameraGetUInt32ParamMax(&camera_, "Height", &height_max);
-  EVT_CameraGetUInt32ParamMax(&camera_, "Width", &width_max);
+  EVT_CameraGetUInt32ParamMax(camera, "Height", &height_max);
+  EVT_CameraGetUInt32ParamMax(camera, "Width", &width_max);
   if ((width_ == 0U) || (width_ > width_max) ||
     (height_ == 0U) || (height_ > height_max)) {
     GXF_LOG_ERROR("Given resolution is not supported. Supported max"
       " resolution is (%u, %u)\n", width_max, height_max);
     return EVT_ERROR_INVAL;
   }
-  EVT_CameraSetUInt32Param(&camera_, "Width", width_);
-  EVT_CameraSetUInt32Param(&camera_, "Height", height_);
+  EVT_CameraSetUInt32Param(camera, "Width", width_);
+  EVT_CameraSetUInt32Param(camera, "Height", height_);
 
   // Check Framerate
-  EVT_CameraGetUInt32ParamMax(&camera_, "FrameRate", &frame_rate_max);
-  EVT_CameraGetUInt32ParamMin(&camera_, "FrameRate", &frame_rate_min);
+  EVT_CameraGetUInt32ParamMax(camera, "FrameRate", &frame_rate_max);
+  EVT_CameraGetUInt32ParamMin(camera, "FrameRate", &frame_rate_min);
   if ((framerate_ > frame_rate_max) || (framerate_ < frame_rate_min)) {
     GXF_LOG_ERROR("Given framerate is not supported. Supported framrate"
       " range is [%u, %u]\n", frame_rate_min, frame_rate_max);
     return EVT_ERROR_INVAL;
   }
-  EVT_CameraSetUInt32Param(&camera_, "FrameRate", framerate_);
+  EVT_CameraSetUInt32Param(camera, "FrameRate", framerate_);
 
-  EVT_CameraSetUInt32Param(&camera_, "Exposure", exposure_);
-  EVT_CameraSetUInt32Param(&camera_, "Gain", gain_);
+  EVT_CameraSetUInt32Param(camera, "Exposure", exposure_);
+  EVT_CameraSetUInt32Param(camera, "Gain", gain_);
 
   return err;
 }
 
-void EmergentSource::SetDefaultConfiguration() {
+void EmergentSource::SetDefaultConfiguration(CEmergentCamera* camera) {
   unsigned int width_max, height_max, param_val_max;
   unsigned long enum_buffer_size_return = 0;
   const unsigned long enum_buffer_size = 1000;
@@ -137,114 +233,247 @@ void EmergentSource::SetDefaultConfiguration() {
   char* next_token;
 
   // Order is important as param max/mins get updated.
-  EVT_CameraGetEnumParamRange(&camera_, "PixelFormat", enum_buffer,
+  EVT_CameraGetEnumParamRange(camera, "PixelFormat", enum_buffer,
     enum_buffer_size, &enum_buffer_size_return);
   char* enum_member = strtok_s(enum_buffer, ",", &next_token);
-  EVT_CameraSetEnumParam(&camera_, "PixelFormat", enum_member);
+  EVT_CameraSetEnumParam(camera, "PixelFormat", enum_member);
 
-  EVT_CameraSetUInt32Param(&camera_, "FrameRate", 30);
+  EVT_CameraSetUInt32Param(camera, "FrameRate", 30);
 
-  EVT_CameraSetUInt32Param(&camera_, "OffsetX", 0);
-  EVT_CameraSetUInt32Param(&camera_, "OffsetY", 0);
+  EVT_CameraSetUInt32Param(camera, "OffsetX", 0);
+  EVT_CameraSetUInt32Param(camera, "OffsetY", 0);
 
-  EVT_CameraGetUInt32ParamMax(&camera_, "Width", &width_max);
-  EVT_CameraSetUInt32Param(&camera_, "Width", width_max);
+  EVT_CameraGetUInt32ParamMax(camera, "Width", &width_max);
+  EVT_CameraSetUInt32Param(camera, "Width", width_max);
 
-  EVT_CameraGetUInt32ParamMax(&camera_, "Height", &height_max);
-  EVT_CameraSetUInt32Param(&camera_, "Height", height_max);
+  EVT_CameraGetUInt32ParamMax(camera, "Height", &height_max);
+  EVT_CameraSetUInt32Param(camera, "Height", height_max);
 
-  EVT_CameraSetEnumParam(&camera_, "AcquisitionMode", "Continuous");
-  EVT_CameraSetUInt32Param(&camera_, "AcquisitionFrameCount", 1);
-  EVT_CameraSetEnumParam(&camera_, "TriggerSelector", "AcquisitionStart");
-  EVT_CameraSetEnumParam(&camera_, "TriggerMode", "Off");
-  EVT_CameraSetEnumParam(&camera_, "TriggerSource", "Software");
-  EVT_CameraSetEnumParam(&camera_, "BufferMode", "Off");
-  EVT_CameraSetUInt32Param(&camera_, "BufferNum", 0);
+  EVT_CameraSetEnumParam(camera, "AcquisitionMode", "Continuous");
+  EVT_CameraSetUInt32Param(camera, "AcquisitionFrameCount", 1);
+  EVT_CameraSetEnumParam(camera, "TriggerSelector", "AcquisitionStart");
+  EVT_CameraSetEnumParam(camera, "TriggerMode", "Off");
+  EVT_CameraSetEnumParam(camera, "TriggerSource", "Software");
+  EVT_CameraSetEnumParam(camera, "BufferMode", "Off");
+  EVT_CameraSetUInt32Param(camera, "BufferNum", 0);
 
-  EVT_CameraGetUInt32ParamMax(&camera_, "GevSCPSPacketSize", &param_val_max);
-  EVT_CameraSetUInt32Param(&camera_, "GevSCPSPacketSize", param_val_max);
+  EVT_CameraGetUInt32ParamMax(camera, "GevSCPSPacketSize", &param_val_max);
+  EVT_CameraSetUInt32Param(camera, "GevSCPSPacketSize", param_val_max);
 
-  EVT_CameraSetUInt32Param(&camera_, "Exposure", 3072);
+  EVT_CameraSetUInt32Param(camera, "Exposure", 3072);
 
-  EVT_CameraSetUInt32Param(&camera_, "Gain", 4095);
+  EVT_CameraSetUInt32Param(camera, "Gain", 4095);
 
   // Optical black correction is set to 10
-  EVT_CameraSetUInt32Param(&camera_, "Offset", 10);
+  EVT_CameraSetUInt32Param(camera, "Offset", 10);
+
+  EVT_CameraSetBoolParam(camera, "LUTEnable", false);
+  EVT_CameraSetBoolParam(camera, "AutoGain", false);
+
+  EVT_CameraSetUInt32Param(camera, "WB_R_GAIN_Value", 256);
+  EVT_CameraSetUInt32Param(camera, "WB_GR_GAIN_Value", 166);
+  EVT_CameraSetUInt32Param(camera, "WB_GB_GAIN_Value", 162);
+  EVT_CameraSetUInt32Param(camera, "WB_B_GAIN_Value", 272);
+}
+
+void EmergentSource::ConfigureSync(CEmergentCamera* camera) {
+  switch (sync_mode_) {
+    case SyncMode::kPtp:
+      // Frame times are then on the clock of the PTP master, and acquisition starts at the
+      // gate time set by StartSynchronizedAcquisition
+      EVT_CameraSetEnumParam(camera, "PtpMode", "TwoStep");
+      break;
+    case SyncMode::kTrigger:
+      // A frame per pulse on the trigger input, shared by all the cameras
+      EVT_CameraSetEnumParam(camera, "TriggerSelector", "FrameStart");
+      EVT_CameraSetEnumParam(camera, "TriggerMode", "On");
+      EVT_CameraSetEnumParam(camera, "TriggerSource", "Hardware");
+      break;
+    case SyncMode::kNone:
+      break;
+  }
+}
+
+EVT_ERROR EmergentSource::StartSynchronizedAcquisition() {
+  if (sync_mode_ == SyncMode::kPtp) {
+    // Wait for every camera to lock to the master, one of them or a grandmaster clock
+    const auto deadline = std::chrono::steady_clock::now() + kPtpLockTimeout;
+    for (auto& camera : cameras_) {
+      while (true) {
+        char status[64] = {};
+        unsigned long status_size = 0;
+        EVT_CameraGetEnumParam(&camera.camera, "PtpStatus", status, sizeof(status), &status_size);
+        if (strcmp(status, "Master") == 0 || strcmp(status, "Slave") == 0) { break; }
+        if (std::chrono::steady_clock::now() > deadline) {
+          GXF_LOG_ERROR("Camera did not lock to PTP, status %s.\n", status);
+          return EVT_ERROR_INVAL;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+      }
+    }
 
-  EVT_CameraSetBoolParam(&camera_, "LUTEnable", false);
-  EVT_CameraSetBoolParam(&camera_, "AutoGain", false);
+    // Start every camera at the same PTP time, so that their frame times line up
+    unsigned int time_high = 0, time_low = 0;
+    EVT_CameraExecuteCommand(&cameras_.front().camera, "GevTimestampControlLatch");
+    EVT_CameraGetUInt32Param(&cameras_.front().camera, "GevTimestampValueHigh", &time_high);
+    EVT_CameraGetUInt32Param(&cameras_.front().camera, "GevTimestampValueLow", &time_low);
+    const uint64_t gate = ((static_cast<uint64_t>(time_high) << 32) | time_low) + kPtpGateDelayNs;
+    for (auto& camera : cameras_) {
+      EVT_CameraSetUInt32Param(&camera.camera, "PtpAcquisitionGateTimeHigh",
+                               static_cast<unsigned int>(gate >> 32));
+      EVT_CameraSetUInt32Param(&camera.camera, "PtpAcquisitionGateTimeLow",
+                               static_cast<unsigned int>(gate & 0xffffffffULL));
+    }
+  }
 
-  EVT_CameraSetUInt32Param(&camera_, "WB_R_GAIN_Value", 256);
-  EVT_CameraSetUInt32Param(&camera_, "WB_GR_GAIN_Value", 166);
-  EVT_CameraSetUInt32Param(&camera_, "WB_GB_GAIN_Value", 162);
-  EVT_CameraSetUInt32Param(&camera_, "WB_B_GAIN_Value", 272);
+  // With a hardware trigger, the cameras are all armed before the first pulse
+  for (auto& camera : cameras_) {
+    EVT_ERROR err = EVT_CameraExecuteCommand(&camera.camera, "AcquisitionStart");
+    if (err != EVT_SUCCESS) {
+      GXF_LOG_ERROR("Acquisition start failed. Error %d\n", err);
+      return err;
+    }
+  }
+  return EVT_SUCCESS;
 }
 
 gxf_result_t EmergentSource::start() {
+  cuda_stream_handler_.setProfilingName(name());
   GXF_LOG_INFO("Emergent Source: RDMA is %s", use_rdma_ ? "enabled" : "disabled");
 
   EVT_ERROR err = EVT_SUCCESS;
 
-  // Open EVT camera in system.
-  if (OpenEVTCamera() != EVT_SUCCESS) {
-    GXF_LOG_ERROR("No EVT camera found.\n");
+  const std::string& debayer = debayer_.get();
+  use_debayer_ = debayer != "none";
+  if (debayer == "bilinear") {
+    debayer_method_ = DebayerMethod::kBilinear;
+  } else if (debayer == "edge_aware") {
+    debayer_method_ = DebayerMethod::kEdgeAware;
+  } else if (use_debayer_) {
+    GXF_LOG_ERROR("Unsupported debayer method %s.\n", debayer.c_str());
     return GXF_FAILURE;
   }
-
-  SetDefaultConfiguration();
-
-  // Check Camera Capabilities
-  if (CheckCameraCapabilities() != EVT_SUCCESS) {
-    GXF_LOG_ERROR("EVT Camera does not support requested format.\n");
+  if (use_debayer_ && !ToBayerPattern(kDefaultPixelFormat, &bayer_pattern_)) {
+    GXF_LOG_ERROR("Debayering requires an 8-bit Bayer pixel format.\n");
+    return GXF_FAILURE;
+  }
+  if (batch_size_ == 0U) {
+    GXF_LOG_ERROR("The batch size must be at least 1.\n");
+    return GXF_FAILURE;
+  }
+  const uint32_t num_cameras =
+      serials_.get().empty() ? num_cameras_.get() : static_cast<uint32_t>(serials_.get().size());
+  if (num_cameras == 0U || num_cameras > kMaxCameras) {
+    GXF_LOG_ERROR("The number of cameras must be between 1 and %u.\n", kMaxCameras);
+    return GXF_FAILURE;
+  }
+  if (num_cameras > 1U && batch_size_ > 1U) {
+    GXF_LOG_ERROR("Several cameras are batched by view, the batch size must be 1.\n");
+    return GXF_FAILURE;
+  }
+  const std::string& sync = sync_.get();
+  if (sync == "none") {
+    sync_mode_ = SyncMode::kNone;
+  } else if (sync == "ptp") {
+    sync_mode_ = SyncMode::kPtp;
+  } else if (sync == "trigger") {
+    sync_mode_ = SyncMode::kTrigger;
+  } else {
+    GXF_LOG_ERROR("Unsupported sync mode %s.\n", sync.c_str());
+    return GXF_FAILURE;
+  }
+  batch_frames_ = num_cameras > 1U ? num_cameras : batch_size_.get();
+  frame_period_ns_ = 1e9 / framerate_;
+  have_ptp_origin_ = false;
+  have_group_ = false;
+  dropped_groups_ = 0;
+  gpu_output_ = use_debayer_ || batch_frames_ > 1U;
+  channels_ = use_debayer_ ? (generate_alpha_ ? 4U : 3U) : 1U;
+  if (gpu_output_ && !pool_.try_get()) {
+    GXF_LOG_ERROR("Debayering and batching require a pool.\n");
+    return GXF_FAILURE;
+  }
+  // Without RDMA, frames are uploaded before the kernel reads them
+  if (use_debayer_ && !use_rdma_ &&
+      cudaMalloc(&raw_device_, static_cast<size_t>(width_) * height_) != cudaSuccess) {
+    GXF_LOG_ERROR("Failed to allocate the upload buffer.\n");
     return GXF_FAILURE;
   }
 
-  // Prepare for streaming.
-  err = EVT_CameraOpenStream(&camera_);
-  if (err != EVT_SUCCESS) {
-    GXF_LOG_ERROR("EVT_CameraOpenStream failed. Error: %d\n", err);
-    EVT_CameraClose(&camera_);
-    GXF_LOG_ERROR("Camera Closed\n");
+  // Open the EVT cameras in system.
+  cameras_.clear();
+  cameras_.resize(num_cameras);
+  if (OpenEVTCameras() != EVT_SUCCESS) {
+    GXF_LOG_ERROR("No EVT camera found.\n");
     return GXF_FAILURE;
   }
 
-  // Allocate buffers
-  for (unsigned int frame_count = 0U; frame_count < FRAMES_BUFFERS; frame_count++) {
-    evt_frame_[frame_count].size_x = width_;
-    evt_frame_[frame_count].size_y = height_;
-    // TODO: Add the option for providing different pixel_type
-    evt_frame_[frame_count].pixel_type = kDefaultPixelFormat;
+  for (auto& camera : cameras_) {
+    SetDefaultConfiguration(&camera.camera);
 
-    err = EVT_AllocateFrameBuffer(&camera_, &evt_frame_[frame_count], EVT_FRAME_BUFFER_ZERO_COPY);
-    if (err != EVT_SUCCESS) {
-      GXF_LOG_ERROR("EVT_AllocateFrameBuffer Error!\n");
+    // Check Camera Capabilities
+    if (CheckCameraCapabilities(&camera.camera) != EVT_SUCCESS) {
+      GXF_LOG_ERROR("EVT Camera does not support requested format.\n");
       return GXF_FAILURE;
     }
+    ConfigureSync(&camera.camera);
 
-    err = EVT_CameraQueueFrame(&camera_, &evt_frame_[frame_count]);
+    // Prepare for streaming.
+    err = EVT_CameraOpenStream(&camera.camera);
     if (err != EVT_SUCCESS) {
-      GXF_LOG_ERROR("EVT_CameraQueueFrame Error!\n");
+      GXF_LOG_ERROR("EVT_CameraOpenStream failed. Error: %d\n", err);
+      EVT_CameraClose(&camera.camera);
+      GXF_LOG_ERROR("Camera Closed\n");
       return GXF_FAILURE;
     }
+
+    // Allocate buffers
+    for (unsigned int frame_count = 0U; frame_count < FRAMES_BUFFERS; frame_count++) {
+      CEmergentFrame& frame = camera.frames[frame_count];
+      frame.size_x = width_;
+      frame.size_y = height_;
+      // TODO: Add the option for providing different pixel_type
+      frame.pixel_type = kDefaultPixelFormat;
+
+      err = EVT_AllocateFrameBuffer(&camera.camera, &frame, EVT_FRAME_BUFFER_ZERO_COPY);
+      if (err != EVT_SUCCESS) {
+        GXF_LOG_ERROR("EVT_AllocateFrameBuffer Error!\n");
+        return GXF_FAILURE;
+      }
+
+      err = EVT_CameraQueueFrame(&camera.camera, &frame);
+      if (err != EVT_SUCCESS) {
+        GXF_LOG_ERROR("EVT_CameraQueueFrame Error!\n");
+        return GXF_FAILURE;
+      }
+    }
   }
 
   // Start streaming
-  err = EVT_CameraExecuteCommand(&camera_, "AcquisitionStart");
-  if (err != EVT_SUCCESS) {
-    GXF_LOG_ERROR("Acquisition start failed. Error %d\n", err);
-    return GXF_FAILURE;
+  if (StartSynchronizedAcquisition() != EVT_SUCCESS) { return GXF_FAILURE; }
+  if (num_cameras > 1U) {
+    GXF_LOG_INFO("Emergent Source: capturing %u cameras, sync %s", num_cameras, sync.c_str());
   }
   return GXF_SUCCESS;
 }
 
 gxf_result_t EmergentSource::tick() {
+  if (cameras_.size() > 1) { return TickCameras(); }
+
   EVT_ERROR err = EVT_SUCCESS;
+  Camera& camera = cameras_.front();
 
-  err = EVT_CameraGetFrame(&camera_, &evt_frame_recv_, EVT_INFINITE);
+  err = ReceiveFrame(0);
   if (err != EVT_SUCCESS) {
     GXF_LOG_ERROR("Failed to get frame. Error %d\n", err);
     return GXF_FAILURE;
   }
+  acqtime_ = camera.host_time;
+
+  if (gpu_output_) {
+    RequeueCompletedFrames();
+    return ProcessFrame(camera.recv, 0);
+  }
 
   auto message = gxf::Entity::New(context());
   if (!message) {
@@ -264,12 +493,13 @@ gxf_result_t EmergentSource::tick() {
   gxf::VideoBufferInfo info{width_, height_, video_type.value, color_planes,
                             gxf::SurfaceLayout::GXF_SURFACE_LAYOUT_PITCH_LINEAR};
   auto storage_type = use_rdma_ ? gxf::MemoryStorageType::kDevice : gxf::MemoryStorageType::kHost;
-  buffer.value()->wrapMemory(info, evt_frame_recv_.bufferSize, storage_type,
-                                         evt_frame_recv_.imagePtr, nullptr);
+  buffer.value()->wrapMemory(info, camera.recv.bufferSize, storage_type,
+                                         camera.recv.imagePtr, nullptr);
+  if (AddTimestamp(message.value(), acqtime_) != GXF_SUCCESS) { return GXF_FAILURE; }
 
   signal_->publish(std::move(message.value()));
 
-  err = EVT_CameraQueueFrame(&camera_, &evt_frame_recv_);  // Re-queue.
+  err = EVT_CameraQueueFrame(&camera.camera, &camera.recv);  // Re-queue.
   if (err != EVT_SUCCESS) {
     GXF_LOG_ERROR("Failed to queue the frame.\n");
     return GXF_FAILURE;
@@ -278,34 +508,287 @@ gxf_result_t EmergentSource::tick() {
   return gxf::ToResultCode(message);
 }
 
-gxf_result_t EmergentSource::stop() {
-  EVT_ERROR err = EVT_SUCCESS;
+EVT_ERROR EmergentSource::ReceiveFrame(uint32_t index) {
+  Camera& camera = cameras_[index];
+  EVT_ERROR err = EVT_CameraGetFrame(&camera.camera, &camera.recv, EVT_INFINITE);
+  if (err != EVT_SUCCESS) { return err; }
+  camera.host_time = SteadyClockNow();
+
+  // The trigger of the frame: with PTP, its frame time on the shared clock, otherwise the
+  // frames the camera has counted since its first one
+  int64_t trigger;
+  if (sync_mode_ == SyncMode::kPtp) {
+    if (!have_ptp_origin_) {
+      ptp_origin_ = camera.recv.timestamp;
+      have_ptp_origin_ = true;
+    }
+    const auto offset = static_cast<int64_t>(camera.recv.timestamp - ptp_origin_);
+    trigger = std::llround(offset / frame_period_ns_);
+  } else if (camera.received) {
+    trigger = camera.trigger + static_cast<uint16_t>(camera.recv.frame_id - camera.frame_id);
+  } else {
+    trigger = 0;
+  }
+  camera.frame_id = camera.recv.frame_id;
 
-  // Tell camera to stop streaming
-  err = EVT_CameraExecuteCommand(&camera_, "AcquisitionStop");
-  if (err != EVT_SUCCESS) {
-    GXF_LOG_ERROR("EVT_CameraExecuteCommand failed. Error: %d\n", err);
+  if (camera.received && trigger > camera.trigger + 1) {
+    camera.dropped += trigger - camera.trigger - 1;
+  }
+  camera.trigger = trigger;
+  camera.received = true;
+  return EVT_SUCCESS;
+}
+
+gxf_result_t EmergentSource::TickCameras() {
+  RequeueCompletedFrames();
+  for (uint32_t i = 0; i < cameras_.size(); i++) {
+    EVT_ERROR err = ReceiveFrame(i);
+    if (err != EVT_SUCCESS) {
+      GXF_LOG_ERROR("Failed to get frame of camera %u. Error %d\n", i, err);
+      return GXF_FAILURE;
+    }
+  }
+
+  // Frames of triggers another camera has missed are given back, until all the cameras
+  // are at the latest trigger
+  if (sync_mode_ != SyncMode::kNone) {
+    for (uint32_t skipped = 0; ; skipped++) {
+      int64_t target = cameras_.front().trigger;
+      for (const auto& camera : cameras_) { target = std::max(target, camera.trigger); }
+      bool aligned = true;
+      for (uint32_t i = 0; i < cameras_.size(); i++) {
+        if (cameras_[i].trigger >= target) { continue; }
+        aligned = false;
+        EVT_CameraQueueFrame(&cameras_[i].camera, &cameras_[i].recv);
+        EVT_ERROR err = ReceiveFrame(i);
+        if (err != EVT_SUCCESS) {
+          GXF_LOG_ERROR("Failed to get frame of camera %u. Error %d\n", i, err);
+          return GXF_FAILURE;
+        }
+      }
+      if (aligned) { break; }
+      if (skipped == kMaxAlignFrames) {
+        GXF_LOG_ERROR("The camera frames do not line up, check the camera synchronization.\n");
+        return GXF_FAILURE;
+      }
+    }
+  }
+
+  const int64_t group = cameras_.front().trigger;
+  if (have_group_ && group > last_group_ + 1) {
+    dropped_groups_ += group - last_group_ - 1;
+    GXF_LOG_WARNING("Emergent Source: %llu triggers without a frame of every camera",
+                    static_cast<unsigned long long>(dropped_groups_));
+  }
+  last_group_ = group;
+  have_group_ = true;
+
+  acqtime_ = cameras_.front().host_time;
+  for (const auto& camera : cameras_) { acqtime_ = std::min(acqtime_, camera.host_time); }
+  for (uint32_t i = 0; i < cameras_.size(); i++) {
+    gxf_result_t result = ProcessFrame(cameras_[i].recv, i);
+    if (result != GXF_SUCCESS) { return result; }
+  }
+  return GXF_SUCCESS;
+}
+
+gxf_result_t EmergentSource::AddCameraInfo(gxf::Entity& message) {
+  // Camera and host time of each view
+  for (uint32_t i = 0; i < cameras_.size(); i++) {
+    auto timestamp = message.add<gxf::Timestamp>(("camera" + std::to_string(i)).c_str());
+    if (!timestamp) {
+      GXF_LOG_ERROR("Failed to allocate timestamp.\n");
+      return GXF_FAILURE;
+    }
+    timestamp.value()->acqtime = static_cast<int64_t>(cameras_[i].recv.timestamp);
+    timestamp.value()->pubtime = cameras_[i].host_time;
+  }
+
+  auto tensor = message.add<gxf::Tensor>("dropped_frames");
+  if (!tensor) {
+    GXF_LOG_ERROR("Failed to allocate the dropped frames tensor.\n");
     return GXF_FAILURE;
   }
+  auto* dropped = new uint64_t[cameras_.size()];
+  for (size_t i = 0; i < cameras_.size(); i++) { dropped[i] = cameras_[i].dropped; }
+  const gxf::Shape shape{static_cast<int32_t>(cameras_.size())};
+  auto wrapped = tensor.value()->wrapMemory(
+      shape, gxf::PrimitiveType::kUnsigned64, sizeof(uint64_t),
+      gxf::ComputeTrivialStrides(shape, sizeof(uint64_t)), gxf::MemoryStorageType::kSystem,
+      dropped, [](void* pointer) {
+        delete[] static_cast<uint64_t*>(pointer);
+        return gxf::Success;
+      });
+  if (!wrapped) {
+    delete[] dropped;
+    GXF_LOG_ERROR("Failed to wrap the dropped frames tensor.\n");
+    return GXF_FAILURE;
+  }
+  return GXF_SUCCESS;
+}
 
-  // Release frame buffers
-  for (unsigned int frame_count = 0U; frame_count < kNumBuffers; frame_count++) {
-    if (EVT_ReleaseFrameBuffer(&camera_, &evt_frame_[frame_count]) != EVT_SUCCESS) {
-      GXF_LOG_ERROR("Failed to release buffers.\n");
+gxf_result_t EmergentSource::ProcessFrame(const CEmergentFrame& frame, uint32_t camera) {
+  // The debayering of every camera's frame runs on this stream, sent along with the tensor
+  if (cuda_stream_handler_.fromMessages(context(), std::vector<gxf::Entity>()) != GXF_SUCCESS) {
+    GXF_LOG_ERROR("Failed to allocate the CUDA stream.\n");
+    return GXF_FAILURE;
+  }
+  cudaStream_t stream = cuda_stream_handler_.getCudaStream();
+
+  const size_t frame_size = static_cast<size_t>(width_) * height_ * channels_;
+  uint8_t* dst = nullptr;
+  int dst_pitch = width_ * channels_;
+  if (batch_count_ == 0U) {
+    batch_message_ = gxf::Entity::New(context());
+    if (!batch_message_) {
+      GXF_LOG_ERROR("Failed to allocate message.\n");
+      return GXF_FAILURE;
+    }
+    batch_acqtime_ = acqtime_;
+    if (batch_frames_ > 1U) {
+      auto tensor = batch_message_.value().add<gxf::Tensor>("frames");
+      if (!tensor || !tensor.value()->reshape<uint8_t>(
+                         gxf::Shape{static_cast<int32_t>(batch_frames_),
+                                    static_cast<int32_t>(height_.get()),
+                                    static_cast<int32_t>(width_.get()),
+                                    static_cast<int32_t>(channels_)},
+                         gxf::MemoryStorageType::kDevice, pool_.try_get().value())) {
+        GXF_LOG_ERROR("Failed to allocate the batch tensor.\n");
+        return GXF_FAILURE;
+      }
+      batch_tensor_ = tensor.value();
+    }
+  }
+  if (batch_frames_ > 1U) {
+    dst = batch_tensor_->data<uint8_t>().value() + batch_count_ * frame_size;
+  } else {
+    auto buffer = batch_message_.value().add<gxf::VideoBuffer>();
+    if (!buffer) {
+      GXF_LOG_ERROR("Failed to allocate video buffer.\n");
+      return GXF_FAILURE;
+    }
+    auto allocated = generate_alpha_
+        ? buffer.value()->resize<gxf::VideoFormat::GXF_VIDEO_FORMAT_RGBA>(
+              width_, height_, gxf::SurfaceLayout::GXF_SURFACE_LAYOUT_PITCH_LINEAR,
+              gxf::MemoryStorageType::kDevice, pool_.try_get().value())
+        : buffer.value()->resize<gxf::VideoFormat::GXF_VIDEO_FORMAT_RGB>(
+              width_, height_, gxf::SurfaceLayout::GXF_SURFACE_LAYOUT_PITCH_LINEAR,
+              gxf::MemoryStorageType::kDevice, pool_.try_get().value());
+    if (!allocated) {
+      GXF_LOG_ERROR("Failed to allocate the debayered frame.\n");
       return GXF_FAILURE;
     }
+    dst = buffer.value()->pointer();
+    dst_pitch = buffer.value()->video_frame_info().color_planes[0].stride;
   }
 
-  // Host side tear down for stream.
-  if (EVT_CameraCloseStream(&camera_) != EVT_SUCCESS) {
-    GXF_LOG_ERROR("Failed to close camera successfully.\n");
+  const uint8_t* src = frame.imagePtr;
+  const size_t raw_size = static_cast<size_t>(width_) * height_;
+  cudaError_t status;
+  if (use_debayer_) {
+    if (!use_rdma_) {
+      cudaMemcpyAsync(raw_device_, src, raw_size, cudaMemcpyHostToDevice, stream);
+      src = raw_device_;
+    }
+    status = debayer(src, width_, dst, dst_pitch, width_, height_, channels_, bayer_pattern_,
+                     debayer_method_, stream);
+  } else {
+    status = cudaMemcpyAsync(dst, src, raw_size, cudaMemcpyDefault, stream);
+  }
+
+  // The camera gets the frame back once the GPU is done reading it
+  cudaEvent_t done;
+  if (!free_events_.empty()) {
+    done = free_events_.back();
+    free_events_.pop_back();
+  } else if (cudaEventCreateWithFlags(&done, cudaEventDisableTiming) != cudaSuccess) {
+    GXF_LOG_ERROR("Failed to create a CUDA event.\n");
     return GXF_FAILURE;
   }
+  cudaEventRecord(done, stream);
+  pending_frames_.push_back({frame, camera, done});
 
-  if (EVT_CameraClose(&camera_) != EVT_SUCCESS) {
-    GXF_LOG_ERROR("Failed to close camera successfully.\n");
+  if (status != cudaSuccess) {
+    GXF_LOG_ERROR("Failed to process the frame: %s\n", cudaGetErrorString(status));
+    return GXF_FAILURE;
+  }
+
+  if (++batch_count_ < batch_frames_) {
+    return GXF_SUCCESS;
+  }
+  batch_count_ = 0U;
+  if (cameras_.size() > 1 && AddCameraInfo(batch_message_.value()) != GXF_SUCCESS) {
+    return GXF_FAILURE;
+  }
+  if (AddTimestamp(batch_message_.value(), batch_acqtime_) != GXF_SUCCESS) { return GXF_FAILURE; }
+  if (cuda_stream_handler_.toMessage(batch_message_) != GXF_SUCCESS) {
+    GXF_LOG_ERROR("Failed to add the CUDA stream to the output message.\n");
     return GXF_FAILURE;
   }
+  return gxf::ToResultCode(signal_->publish(std::move(batch_message_.value())));
+}
+
+void EmergentSource::RequeueCompletedFrames() {
+  // Work on the stream completes in order
+  while (!pending_frames_.empty() && cudaEventQuery(pending_frames_.front().done) == cudaSuccess) {
+    PendingFrame& pending = pending_frames_.front();
+    if (EVT_CameraQueueFrame(&cameras_[pending.camera].camera, &pending.frame) != EVT_SUCCESS) {
+      GXF_LOG_ERROR("Failed to queue the frame.\n");
+    }
+    free_events_.push_back(pending.done);
+    pending_frames_.pop_front();
+  }
+}
+
+gxf_result_t EmergentSource::stop() {
+  EVT_ERROR err = EVT_SUCCESS;
+
+  for (auto& pending : pending_frames_) {
+    cudaEventSynchronize(pending.done);
+    free_events_.push_back(pending.done);
+  }
+  pending_frames_.clear();
+  for (auto event : free_events_) { cudaEventDestroy(event); }
+  free_events_.clear();
+  if (raw_device_ != nullptr) {
+    cudaFree(raw_device_);
+    raw_device_ = nullptr;
+  }
+  batch_count_ = 0U;
+
+  if (cameras_.size() > 1) {
+    GXF_LOG_INFO("Emergent Source: %llu triggers without a frame of every camera",
+                 static_cast<unsigned long long>(dropped_groups_));
+  }
+
+  for (auto& camera : cameras_) {
+    // Tell camera to stop streaming
+    err = EVT_CameraExecuteCommand(&camera.camera, "AcquisitionStop");
+    if (err != EVT_SUCCESS) {
+      GXF_LOG_ERROR("EVT_CameraExecuteCommand failed. Error: %d\n", err);
+      return GXF_FAILURE;
+    }
+
+    // Release frame buffers
+    for (unsigned int frame_count = 0U; frame_count < kNumBuffers; frame_count++) {
+      if (EVT_ReleaseFrameBuffer(&camera.camera, &camera.frames[frame_count]) != EVT_SUCCESS) {
+        GXF_LOG_ERROR("Failed to release buffers.\n");
+        return GXF_FAILURE;
+      }
+    }
+
+    // Host side tear down for stream.
+    if (EVT_CameraCloseStream(&camera.camera) != EVT_SUCCESS) {
+      GXF_LOG_ERROR("Failed to close camera successfully.\n");
+      return GXF_FAILURE;
+    }
+
+    if (EVT_CameraClose(&camera.camera) != EVT_SUCCESS) {
+      GXF_LOG_ERROR("Failed to close camera successfully.\n");
+      return GXF_FAILURE;
+    }
+  }
+  cameras_.clear();
 
   return GXF_SUCCESS;
 }
@@ -23,10 +23,17 @@
 #include <EmergentCamera.h>
 #include <EmergentCameraAPIs.h>
 
+#include <cuda_runtime.h>
+
+#include <deque>
 #include <string>
 #include <vector>
 
+#include "../utils/cuda_stream_handler.hpp"
+#include "emergent_debayer.hpp"
+#include "gxf/std/allocator.hpp"
 #include "gxf/std/codelet.hpp"
+#include "gxf/std/tensor.hpp"
 #include "gxf/std/transmitter.hpp"
 
 #define FRAMES_BUFFERS 256
@@ -46,13 +53,29 @@ constexpr bool kDefaultRDMA = false;
 constexpr PIXEL_FORMAT kDefaultPixelFormat = GVSP_PIX_BAYGB8;
 constexpr uint32_t kDefaultExposure = 3072;
 constexpr uint32_t kDefaultGain = 4095;
+constexpr char kDefaultDebayer[] = "none";
+constexpr bool kDefaultGenerateAlpha = false;
+constexpr uint32_t kDefaultBatchSize = 1;
+constexpr uint32_t kDefaultNumCameras = 1;
+constexpr char kDefaultSync[] = "none";
 
 
 /// @brief Video input codelet for use with Emergent cameras using ConnectX-6
 ///
 /// Provides a codelet for supporting Emergent camera as a source.
 /// It offers support for GPUDirect-RDMA on Quadro GPUs.
-/// The output is a VideoBuffer object.
+/// The output is a VideoBuffer object, the raw Bayer frame by default. With `debayer`, frames
+/// are demosaiced on the GPU into an RGB(A) VideoBuffer allocated from `pool`. With a
+/// `batch_size` K above 1, K consecutive frames are instead gathered into one device Tensor
+/// named "frames" of shape [K, height, width, channels], published once it is full.
+/// Messages carry a "timestamp" whose acqtime is the steady clock time, in nanoseconds, the
+/// (first) frame was received at.
+/// With `num_cameras` N above 1, the cameras are opened together and a frame of each is
+/// gathered into a device Tensor named "frames" of shape [N, height, width, channels], one
+/// message per trigger. With `sync` set to `ptp` or `trigger`, the frames of a message are
+/// those of the same PTP frame time or hardware trigger. The message also carries the camera
+/// and host times of each frame, as Timestamps named "camera0" to "camera<N-1>", and a host
+/// uint64 Tensor named "dropped_frames" with the frames each camera has missed so far.
 
 class EmergentSource : public gxf::Codelet {
  public:
@@ -65,9 +88,39 @@ class EmergentSource : public gxf::Codelet {
   gxf_result_t stop() override;
 
  private:
-  EVT_ERROR CheckCameraCapabilities();
-  EVT_ERROR OpenEVTCamera();
-  void SetDefaultConfiguration();
+  enum class SyncMode { kNone, kPtp, kTrigger };
+
+  // An open camera, streaming into its own frame buffers
+  struct Camera {
+    CEmergentCamera camera;
+    CEmergentFrame frames[FRAMES_BUFFERS];
+    CEmergentFrame recv;
+    // Trigger the last received frame belongs to, and the frames the camera did not deliver
+    bool received = false;
+    int64_t trigger = 0;
+    uint16_t frame_id = 0;
+    uint64_t dropped = 0;
+    // Steady clock time the last frame was received at
+    int64_t host_time = 0;
+  };
+
+  EVT_ERROR CheckCameraCapabilities(CEmergentCamera* camera);
+  EVT_ERROR OpenEVTCameras();
+  void SetDefaultConfiguration(CEmergentCamera* camera);
+  void ConfigureSync(CEmergentCamera* camera);
+  EVT_ERROR StartSynchronizedAcquisition();
+  EVT_ERROR ReceiveFrame(uint32_t index);
+  gxf_result_t TickCameras();
+  gxf_result_t AddCameraInfo(gxf::Entity& message);
+  gxf_result_t ProcessFrame(const CEmergentFrame& frame, uint32_t camera);
+  void RequeueCompletedFrames();
+
+  // A frame the GPU is still reading, queued back to its camera once done is reached
+  struct PendingFrame {
+    CEmergentFrame frame;
+    uint32_t camera;
+    cudaEvent_t done;
+  };
 
   gxf::Parameter<gxf::Handle<gxf::Transmitter>> signal_;
   gxf::Parameter<uint32_t> width_;
@@ -76,10 +129,44 @@ class EmergentSource : public gxf::Codelet {
   gxf::Parameter<bool> use_rdma_;
   gxf::Parameter<uint32_t> exposure_;
   gxf::Parameter<uint32_t> gain_;
-
-  CEmergentCamera camera_;
-  CEmergentFrame evt_frame_[FRAMES_BUFFERS];
-  CEmergentFrame evt_frame_recv_;
+  gxf::Parameter<std::string> debayer_;
+  gxf::Parameter<bool> generate_alpha_;
+  gxf::Parameter<uint32_t> batch_size_;
+  gxf::Parameter<gxf::Handle<gxf::Allocator>> pool_;
+  gxf::Parameter<uint32_t> num_cameras_;
+  gxf::Parameter<std::vector<std::string>> serials_;
+  gxf::Parameter<std::string> sync_;
+  CudaStreamHandler cuda_stream_handler_;
+
+  std::vector<Camera> cameras_;
+  SyncMode sync_mode_ = SyncMode::kNone;
+  // Frames gathered into a message: batch_size frames of one camera, or one of each camera
+  uint32_t batch_frames_ = 1;
+  // With PTP, the frame time of trigger 0 and the frame period, in camera clock nanoseconds
+  bool have_ptp_origin_ = false;
+  uint64_t ptp_origin_ = 0;
+  double frame_period_ns_ = 0.0;
+  // Trigger of the last message, and the triggers no message was emitted for
+  bool have_group_ = false;
+  int64_t last_group_ = 0;
+  uint64_t dropped_groups_ = 0;
+
+  // Debayering or batching, the frames are processed on the GPU
+  bool gpu_output_ = false;
+  bool use_debayer_ = false;
+  DebayerMethod debayer_method_ = DebayerMethod::kBilinear;
+  BayerPattern bayer_pattern_ = BayerPattern::kGBRG;
+  uint32_t channels_ = 1;
+  // Without RDMA, the frame uploaded for the debayer kernel
+  uint8_t* raw_device_ = nullptr;
+  std::deque<PendingFrame> pending_frames_;
+  std::vector<cudaEvent_t> free_events_;
+  gxf::Expected<gxf::Entity> batch_message_ = gxf::Unexpected{GXF_UNINITIALIZED_VALUE};
+  gxf::Handle<gxf::Tensor> batch_tensor_;
+  uint32_t batch_count_ = 0;
+  // Steady clock time the last frame, and the first frame of the batch, were received at
+  int64_t acqtime_ = 0;
+  int64_t batch_acqtime_ = 0;
 };
 
 }  // namespace holoscan
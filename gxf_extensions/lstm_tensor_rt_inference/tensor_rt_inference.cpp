@@ -161,6 +161,22 @@ gxf::Expected<void> SerializeEnginePlan(const std::vector<char>& plan, const std
   return gxf::Success;
 }
 
+// Writes a serialized timing cache to the specified file path
+gxf::Expected<void> SerializeTimingCache(const nvinfer1::IHostMemory& cache,
+                                         const std::string& path) {
+  std::ofstream out_stream(path.c_str(), std::ofstream::binary);
+  if (!out_stream.is_open()) {
+    GXF_LOG_ERROR("Failed to create timing cache file %s.", path.c_str());
+    return gxf::Unexpected{GXF_FAILURE};
+  }
+  out_stream.write(static_cast<const char*>(cache.data()), cache.size());
+  if (out_stream.bad()) {
+    GXF_LOG_ERROR("Failed to writing to timing cache file %s.", path.c_str());
+    return gxf::Unexpected{GXF_FAILURE};
+  }
+  return gxf::Success;
+}
+
 }  // namespace
 
 // Logging interface for the TensorRT builder, engine and runtime, to redirect logging,
@@ -289,7 +305,52 @@ gxf_result_t TensorRtInference::registerInterface(gxf::Registrar* registrar) {
                                  "Relaxed Dimension Check",
                                  "Ignore dimensions of 1 for input tensor dimension check.",
                                  true);
+  result &= registrar->parameter(swap_state_buffers_,
+                                 "swap_state_buffers",
+                                 "Swap State Buffers",
+                                 "Alternate two buffers per state tensor, read and written by the "
+                                 "model, instead of copying the output states to the input states. "
+                                 "The output state tensors are then not published.",
+                                 false);
+  result &= registrar->parameter(use_timing_cache_,
+                                 "use_timing_cache",
+                                 "Use Timing Cache",
+                                 "Load and save a TensorRT timing cache in the engine cache "
+                                 "directory, so that engine builds reuse the tactic timings.",
+                                 true);
+  result &= registrar->parameter(background_engine_build_,
+                                 "background_engine_build",
+                                 "Background Engine Build",
+                                 "When the engine has to be built, start with the previous engine "
+                                 "or one built without optimization, and swap in the optimized "
+                                 "engine once it is built on a background thread.",
+                                 false);
+  result &= registrar->parameter(use_cuda_graph_,
+                                 "use_cuda_graph",
+                                 "Use CUDA Graph",
+                                 "Capture the inference in a CUDA graph per set of tensor "
+                                 "addresses and replay it while the input shapes do not change.",
+                                 false);
 
+  result &= registrar->parameter(num_streams_,
+                                 "num_streams",
+                                 "Number of Streams",
+                                 "Number of streams batched through the engine, one per receiver "
+                                 "of rx. Streams keep their own recurrent states.",
+                                 1);
+  result &= registrar->parameter(max_batch_wait_ms_,
+                                 "max_batch_wait_ms",
+                                 "Max Batch Wait",
+                                 "With several streams, milliseconds to wait for the frames of "
+                                 "all streams before running a partial batch.",
+                                 5l);
+  result &= registrar->parameter(stream_tx_,
+                                 "stream_tx",
+                                 "Stream TX",
+                                 "With several streams, transmitters to publish the output "
+                                 "tensors of each stream, in the order of rx.",
+                                 gxf::Registrar::NoDefaultParameter(),
+                                 GXF_PARAMETER_FLAGS_OPTIONAL);
   result &= registrar->parameter(rx_, "rx", "RX", "List of receivers to take input tensors");
   result &= registrar->parameter(tx_, "tx", "TX", "Transmitter to publish output tensors");
 
@@ -299,6 +360,8 @@ gxf_result_t TensorRtInference::registerInterface(gxf::Registrar* registrar) {
 }
 
 gxf_result_t TensorRtInference::start() {
+  cuda_stream_handler_.setProfilingName(name());
+
   // Validates parameter
   if (!EndsWith(model_file_path_.get(), ".onnx")) {
     GXF_LOG_ERROR("Only supports ONNX model: %s.", model_file_path_.get().c_str());
@@ -333,6 +396,40 @@ gxf_result_t TensorRtInference::start() {
     return GXF_FAILURE;
   }
 
+#if NV_TENSORRT_MAJOR < 8 || (NV_TENSORRT_MAJOR == 8 && NV_TENSORRT_MINOR <5)
+  if (swap_state_buffers_.get() || use_cuda_graph_.get()) {
+    GXF_LOG_ERROR("swap_state_buffers and use_cuda_graph require TensorRT 8.5 or later.");
+    return GXF_FAILURE;
+  }
+#endif
+
+  // Checks the batched mode, with a receiver and a transmitter per stream
+  const int32_t num_streams = num_streams_.get();
+  const bool batched = num_streams > 1;
+  if (batched) {
+#if NV_TENSORRT_MAJOR < 8 || (NV_TENSORRT_MAJOR == 8 && NV_TENSORRT_MINOR <5)
+    GXF_LOG_ERROR("num_streams above 1 requires TensorRT 8.5 or later.");
+    return GXF_FAILURE;
+#endif
+    const auto stream_tx = stream_tx_.try_get();
+    if (rx_.get().size() != static_cast<size_t>(num_streams) || !stream_tx ||
+        stream_tx.value().size() != static_cast<size_t>(num_streams)) {
+      GXF_LOG_ERROR("Batching %d streams requires as many receivers in rx and stream_tx.",
+                    num_streams);
+      return GXF_ARGUMENT_INVALID;
+    }
+    if (swap_state_buffers_.get()) {
+      GXF_LOG_ERROR("swap_state_buffers is not supported with several streams.");
+      return GXF_ARGUMENT_INVALID;
+    }
+    if (max_batch_size_.get() < num_streams) {
+      GXF_LOG_ERROR("Maximum batch size %d is below the number of streams %d.",
+                    max_batch_size_.get(),
+                    num_streams);
+      return GXF_ARGUMENT_INVALID;
+    }
+  }
+
   // Initializes TensorRT registered plugins
   cuda_logger_.setVerbose(verbose_.get());
   const auto plugins_lib_namespace = plugins_lib_namespace_.try_get();
@@ -360,6 +457,20 @@ gxf_result_t TensorRtInference::start() {
   std::string engine_file_path = maybe_engine_file_path.value();
   engine_file_path_ = engine_file_path;
 
+  timing_cache_file_path_ = engine_cache_dir_.get() + "/" + host_engine_capability + ".timing";
+
+  // With a background build, the previous engine serves until the update is built
+  std::vector<char> plan;
+  bool background = background_engine_build_.get();
+  const bool previous_engine =
+      background && force_engine_update_ && ReadEntireBinaryFile(engine_file_path, plan);
+#if NV_TENSORRT_MAJOR < 8 || (NV_TENSORRT_MAJOR == 8 && NV_TENSORRT_MINOR < 6)
+  if (background && !previous_engine) {
+    GXF_LOG_WARNING("An unoptimized engine requires TensorRT 8.6, building the engine in start().");
+    background = false;
+  }
+#endif
+
   if (force_engine_update_) {
     // Deletes engine plan file if exists for forced update
     std::remove(engine_file_path.c_str());
@@ -371,27 +482,34 @@ gxf_result_t TensorRtInference::start() {
   }
 
   // Loads Cuda engine into std::vector<char> plan or creates it if needed.
-  std::vector<char> plan;
+  bool built = false;
   if (force_engine_update_ || !ReadEntireBinaryFile(engine_file_path, plan)) {
     const char* warning_note = force_engine_update_ ? " (forced by config)" : "";
-    GXF_LOG_WARNING(
-        "Rebuilding CUDA engine %s%s. "
-        "Note: this process may take up to several minutes.",
-        engine_file_path.c_str(),
-        warning_note);
-    auto result = convertModelToEngine();
-    if (!result) {
-      GXF_LOG_ERROR("Failed to create engine plan for model %s.", model_file_path_.get().c_str());
-      return gxf::ToResultCode(result);
-    }
-
-    // Skips loading file and uses in-memory engine plan directly.
-    plan = std::move(result.value());
-
-    // Tries to serializes the plan and proceeds anyway
-    if (!SerializeEnginePlan(plan, engine_file_path)) {
-      GXF_LOG_ERROR(
-          "Engine plan serialization failed. Proceeds with in-memory engine plan anyway.");
+    if (background) {
+      GXF_LOG_WARNING("Building CUDA engine %s%s in the background, using %s meanwhile.",
+                      engine_file_path.c_str(),
+                      warning_note,
+                      previous_engine ? "the previous engine" : "an unoptimized engine");
+      if (!previous_engine) {
+        auto result = convertModelToEngine(0);
+        if (!result) {
+          GXF_LOG_ERROR("Failed to create engine plan for model %s.",
+                        model_file_path_.get().c_str());
+          return gxf::ToResultCode(result);
+        }
+        plan = std::move(result.value());
+      }
+      startBackgroundEngineBuild();
+    } else {
+      GXF_LOG_WARNING(
+          "Rebuilding CUDA engine %s%s. "
+          "Note: this process may take up to several minutes.",
+          engine_file_path.c_str(),
+          warning_note);
+      auto result = buildAndSerializeEngine();
+      if (!result) { return gxf::ToResultCode(result); }
+      plan = std::move(result.value());
+      built = true;
     }
   }
 
@@ -401,6 +519,26 @@ gxf_result_t TensorRtInference::start() {
   // Deserialize the CUDA engine
   if (verbose_.get()) { GXF_LOG_DEBUG("Creating inference runtime."); }
   cuda_engine_.reset(infer_runtime_->deserializeCudaEngine(plan.data(), plan.size()));
+  if (!cuda_engine_ && !built && !engine_build_thread_.joinable()) {
+    // A cached engine from another TensorRT version can not be deserialized
+    GXF_LOG_WARNING("Failed to deserialize CUDA engine %s, rebuilding it.",
+                    engine_file_path.c_str());
+    auto result = buildAndSerializeEngine();
+    if (!result) { return gxf::ToResultCode(result); }
+    plan = std::move(result.value());
+    cuda_engine_.reset(infer_runtime_->deserializeCudaEngine(plan.data(), plan.size()));
+  }
+  if (!cuda_engine_ && engine_build_thread_.joinable()) {
+    GXF_LOG_WARNING("Failed to deserialize the previous engine, waiting for the build of %s.",
+                    engine_file_path.c_str());
+    engine_build_thread_.join();
+    plan = std::move(background_plan_);
+    cuda_engine_.reset(infer_runtime_->deserializeCudaEngine(plan.data(), plan.size()));
+  }
+  if (!cuda_engine_) {
+    GXF_LOG_ERROR("Failed to deserialize CUDA engine %s.", engine_file_path.c_str());
+    return GXF_FAILURE;
+  }
 
   // Debug spews
   if (verbose_.get()) {
@@ -450,6 +588,15 @@ gxf_result_t TensorRtInference::start() {
   // Allocates CUDA buffer pointers for binding to be populated in tick()
   cuda_buffers_.resize(input_tensor_names_.get().size() + output_tensor_names_.get().size(),
                        nullptr);
+  binding_addresses_.assign(cuda_buffers_.size(), nullptr);
+  destroyCudaGraphs();
+  last_input_shapes_.clear();
+  cuda_graph_failed_ = false;
+  state_buffers_.assign(state_tensor_count_, {});
+  state_parity_ = 0;
+  batch_inputs_.assign(batched ? input_number : 0, {});
+  pending_frames_.assign(batched ? num_streams : 0, gxf::Unexpected{GXF_UNINITIALIZED_VALUE});
+  pending_since_.assign(pending_frames_.size(), {});
 
   // Initialize internal state tensors
   internal_states_ = gxf::Entity::New(context());
@@ -517,21 +664,59 @@ gxf_result_t TensorRtInference::start() {
               .c_str());
     }
 
-    // Create tensor for input states
-    if (std::find(input_state_tensor_names_.get().begin(),
-                  input_state_tensor_names_.get().end(),
-                  tensor_name) != input_state_tensor_names_.get().end()) {
-      const BindingInfo& binding_info = binding_infos_[tensor_name];
-      const gxf::Shape shape{Dims2Dimensions(dims), binding_info.rank};
-
-      const auto maybe_input_state_tensor =
-          internal_states_.value().add<gxf::Tensor>(tensor_name.c_str());
-      if (!maybe_input_state_tensor) {
-        GXF_LOG_ERROR("Failed to create input state tensor %s.", tensor_name.c_str());
-        return maybe_input_state_tensor.error();
+    // Batches have a row per stream
+    const BindingInfo& binding_info = binding_infos_[tensor_name];
+    std::array<int32_t, gxf::Shape::kMaxRank> dimensions = Dims2Dimensions(dims);
+    if (batched) {
+      if (dims.nbDims == 0 || dims.d[0] != -1) {
+        GXF_LOG_ERROR("Input %s requires a dynamic batch dimension to batch several streams.",
+                      binding_name.c_str());
+        return GXF_FAILURE;
       }
+      dimensions[0] = num_streams;
+    }
+    const gxf::Shape shape{dimensions, binding_info.rank};
+
+    // Create tensor for input states, and its twin with swap_state_buffers or, in batched mode,
+    // for the state rows of partial batches
+    const auto state_it = std::find(input_state_tensor_names_.get().begin(),
+                                    input_state_tensor_names_.get().end(),
+                                    tensor_name);
+    if (state_it != input_state_tensor_names_.get().end()) {
+      const size_t state_index = state_it - input_state_tensor_names_.get().begin();
+
+      const int buffer_count = swap_state_buffers_.get() || batched ? 2 : 1;
+      for (int buffer = 0; buffer < buffer_count; ++buffer) {
+        const std::string name =
+            buffer == 0 ? tensor_name : tensor_name + (batched ? "_batch" : "_swap");
+        const auto maybe_input_state_tensor =
+            internal_states_.value().add<gxf::Tensor>(name.c_str());
+        if (!maybe_input_state_tensor) {
+          GXF_LOG_ERROR("Failed to create input state tensor %s.", name.c_str());
+          return maybe_input_state_tensor.error();
+        }
 
-      const auto result = maybe_input_state_tensor.value()->reshapeCustom(
+        const auto result = maybe_input_state_tensor.value()->reshapeCustom(
+            shape,
+            binding_info.element_type,
+            gxf::PrimitiveTypeSize(binding_info.element_type),
+            gxf::Unexpected{GXF_UNINITIALIZED_VALUE},
+            gxf::MemoryStorageType::kDevice,
+            pool_);
+        if (!result) {
+          GXF_LOG_ERROR("Failed to allocate for input state tensor %s", name.c_str());
+          return gxf::ToResultCode(result);
+        }
+        state_buffers_[state_index][buffer] = maybe_input_state_tensor.value();
+      }
+    } else if (batched) {
+      const std::string name = tensor_name + "_batch";
+      const auto maybe_batch_tensor = internal_states_.value().add<gxf::Tensor>(name.c_str());
+      if (!maybe_batch_tensor) {
+        GXF_LOG_ERROR("Failed to create batch tensor %s.", name.c_str());
+        return maybe_batch_tensor.error();
+      }
+      const auto result = maybe_batch_tensor.value()->reshapeCustom(
           shape,
           binding_info.element_type,
           gxf::PrimitiveTypeSize(binding_info.element_type),
@@ -539,9 +724,10 @@ gxf_result_t TensorRtInference::start() {
           gxf::MemoryStorageType::kDevice,
           pool_);
       if (!result) {
-        GXF_LOG_ERROR("Failed to allocate for input state tensor %s", tensor_name.c_str());
+        GXF_LOG_ERROR("Failed to allocate for batch tensor %s", name.c_str());
         return gxf::ToResultCode(result);
       }
+      batch_inputs_[j] = maybe_batch_tensor.value();
     }
   }
 
@@ -608,7 +794,68 @@ gxf_result_t TensorRtInference::start() {
   return GXF_SUCCESS;
 }
 
-gxf::Expected<std::vector<char>> TensorRtInference::convertModelToEngine() {
+gxf::Expected<std::vector<char>> TensorRtInference::buildAndSerializeEngine() {
+  auto result = convertModelToEngine();
+  if (!result) {
+    GXF_LOG_ERROR("Failed to create engine plan for model %s.", model_file_path_.get().c_str());
+    return result;
+  }
+
+  // Tries to serializes the plan and proceeds anyway
+  if (!SerializeEnginePlan(result.value(), engine_file_path_)) {
+    GXF_LOG_ERROR("Engine plan serialization failed. Proceeds with in-memory engine plan anyway.");
+  }
+  return result;
+}
+
+void TensorRtInference::startBackgroundEngineBuild() {
+  background_plan_.clear();
+  engine_build_done_ = false;
+  engine_build_thread_ = std::thread([this]() {
+    auto result = buildAndSerializeEngine();
+    if (result) { background_plan_ = std::move(result.value()); }
+    engine_build_done_ = true;
+  });
+}
+
+gxf::Expected<void> TensorRtInference::swapBackgroundEngine() {
+  engine_build_thread_.join();
+  if (background_plan_.empty()) {
+    GXF_LOG_ERROR("Background build of engine %s failed, keeping the current engine.",
+                  engine_file_path_.c_str());
+    return gxf::Success;
+  }
+
+  NvInferHandle<nvinfer1::ICudaEngine> engine(
+      infer_runtime_->deserializeCudaEngine(background_plan_.data(), background_plan_.size()));
+  background_plan_.clear();
+  if (!engine) {
+    GXF_LOG_ERROR("Failed to deserialize engine %s, keeping the current engine.",
+                  engine_file_path_.c_str());
+    return gxf::Success;
+  }
+  NvInferHandle<nvinfer1::IExecutionContext> execution_ctx(engine->createExecutionContext());
+  if (!execution_ctx) {
+    GXF_LOG_ERROR("Failed to create execution context for engine %s.",
+                  engine_file_path_.c_str());
+    return gxf::Success;
+  }
+
+  // Bindings are the same for both engines of the model, the shapes and addresses are set on
+  // every tick. The current engine may still run the previous frame.
+  const cudaError_t cuda_status =
+      CUDA_TRY(cudaStreamSynchronize(cuda_stream_handler_.getCudaStream()));
+  if (cuda_status != cudaSuccess) { return gxf::Unexpected{GXF_FAILURE}; }
+  destroyCudaGraphs();
+  last_input_shapes_.clear();
+  cuda_execution_ctx_ = std::move(execution_ctx);
+  cuda_engine_ = std::move(engine);
+  GXF_LOG_INFO("Swapped in the optimized engine %s.", engine_file_path_.c_str());
+  return gxf::Success;
+}
+
+gxf::Expected<std::vector<char>> TensorRtInference::convertModelToEngine(
+    int optimization_level) {
   // Creates the engine Builder
   NvInferHandle<nvinfer1::IBuilder> builder(nvinfer1::createInferBuilder(cuda_logger_));
 
@@ -627,6 +874,24 @@ gxf::Expected<std::vector<char>> TensorRtInference::convertModelToEngine() {
     builderConfig->setDLACore(dla_core.value());
   }
   if (enable_fp16_.get()) { builderConfig->setFlag(nvinfer1::BuilderFlag::kFP16); }
+#if NV_TENSORRT_MAJOR > 8 || (NV_TENSORRT_MAJOR == 8 && NV_TENSORRT_MINOR >= 6)
+  if (optimization_level >= 0) { builderConfig->setBuilderOptimizationLevel(optimization_level); }
+#endif
+
+  // Tactic timings from previous builds, on this device, spare measuring them again
+  NvInferHandle<nvinfer1::ITimingCache> timing_cache;
+  if (use_timing_cache_.get()) {
+    std::vector<char> timing_cache_blob;
+    if (ReadEntireBinaryFile(timing_cache_file_path_, timing_cache_blob)) {
+      GXF_LOG_INFO("Loading timing cache %s", timing_cache_file_path_.c_str());
+    }
+    timing_cache.reset(
+        builderConfig->createTimingCache(timing_cache_blob.data(), timing_cache_blob.size()));
+    if (!timing_cache || !builderConfig->setTimingCache(*timing_cache, false)) {
+      GXF_LOG_WARNING("Failed to use timing cache %s.", timing_cache_file_path_.c_str());
+      timing_cache.reset();
+    }
+  }
 
   // Parses ONNX with explicit batch size for support of dynamic shapes/batch
   #if NV_TENSORRT_MAJOR < 10
@@ -670,9 +935,10 @@ gxf::Expected<std::vector<char>> TensorRtInference::convertModelToEngine() {
     }
     if (dims.d[0] == -1) {
       // Only case with first dynamic dimension is supported and assumed to be batch size.
-      // Always optimizes for 1-batch.
+      // Optimizes for 1-batch, or a batch of all streams.
       dims.d[0] = 1;
       optimization_profile->setDimensions(bind_name, nvinfer1::OptProfileSelector::kMIN, dims);
+      dims.d[0] = std::max(num_streams_.get(), 1);
       optimization_profile->setDimensions(bind_name, nvinfer1::OptProfileSelector::kOPT, dims);
       dims.d[0] = max_batch_size_.get();
       if (max_batch_size_.get() <= 0) {
@@ -697,6 +963,13 @@ gxf::Expected<std::vector<char>> TensorRtInference::convertModelToEngine() {
     return gxf::Unexpected{GXF_FAILURE};
   }
 
+  // Saves the timings measured by this build with the cached ones, proceeds anyway on failure
+  if (timing_cache) {
+    NvInferHandle<nvinfer1::IHostMemory> timing_cache_blob(
+        builderConfig->getTimingCache()->serialize());
+    if (timing_cache_blob) { SerializeTimingCache(*timing_cache_blob, timing_cache_file_path_); }
+  }
+
   // Prepares return value
   std::vector<char> result;
   const char* data = static_cast<const char*>(model_stream->data());
@@ -705,7 +978,73 @@ gxf::Expected<std::vector<char>> TensorRtInference::convertModelToEngine() {
   return result;
 }
 
+gxf::Expected<void> TensorRtInference::enqueue(cudaStream_t stream) {
+#if NV_TENSORRT_MAJOR < 8 || (NV_TENSORRT_MAJOR == 8 && NV_TENSORRT_MINOR <5)
+  if (!cuda_execution_ctx_->enqueueV2(cuda_buffers_.data(), stream, nullptr)) {
+    return gxf::Unexpected{GXF_FAILURE};
+  }
+  return gxf::Success;
+#else
+  // TensorRT needs one enqueue outside of a capture after input shapes changed
+  const bool shapes_changed = input_shapes_ != last_input_shapes_;
+  last_input_shapes_ = input_shapes_;
+  if (!use_cuda_graph_.get() || cuda_graph_failed_ || shapes_changed) {
+    if (shapes_changed) { destroyCudaGraphs(); }
+    if (!cuda_execution_ctx_->enqueueV3(stream)) { return gxf::Unexpected{GXF_FAILURE}; }
+    return gxf::Success;
+  }
+
+  auto it = std::find_if(cuda_graphs_.begin(), cuda_graphs_.end(), [this](const CudaGraph& g) {
+    return g.addresses == binding_addresses_;
+  });
+  if (it == cuda_graphs_.end()) {
+    cudaGraph_t graph = nullptr;
+    cudaGraphExec_t exec = nullptr;
+    bool captured = false;
+    if (cudaStreamBeginCapture(stream, cudaStreamCaptureModeThreadLocal) == cudaSuccess) {
+      const bool enqueued = cuda_execution_ctx_->enqueueV3(stream);
+      captured = cudaStreamEndCapture(stream, &graph) == cudaSuccess && enqueued &&
+                 cudaGraphInstantiateWithFlags(&exec, graph, 0) == cudaSuccess;
+    }
+    if (graph) { cudaGraphDestroy(graph); }
+    if (!captured) {
+      // The stream may not support capture, e.g. the legacy default stream
+      cudaGetLastError();
+      GXF_LOG_WARNING("Failed to capture inference of engine %s in a CUDA graph, disabling it.",
+                      engine_file_path_.c_str());
+      cuda_graph_failed_ = true;
+      if (!cuda_execution_ctx_->enqueueV3(stream)) { return gxf::Unexpected{GXF_FAILURE}; }
+      return gxf::Success;
+    }
+    if (cuda_graphs_.size() == kMaxCudaGraphs) {
+      cudaGraphExecDestroy(cuda_graphs_.back().exec);
+      cuda_graphs_.pop_back();
+    }
+    cuda_graphs_.push_front(CudaGraph{binding_addresses_, exec});
+  } else if (it != cuda_graphs_.begin()) {
+    cuda_graphs_.splice(cuda_graphs_.begin(), cuda_graphs_, it);
+  }
+
+  const cudaError_t cuda_status = CUDA_TRY(cudaGraphLaunch(cuda_graphs_.front().exec, stream));
+  if (cuda_status != cudaSuccess) { return gxf::Unexpected{GXF_FAILURE}; }
+  return gxf::Success;
+#endif
+}
+
+void TensorRtInference::destroyCudaGraphs() {
+  for (auto& graph : cuda_graphs_) { cudaGraphExecDestroy(graph.exec); }
+  cuda_graphs_.clear();
+}
+
 gxf_result_t TensorRtInference::stop() {
+  if (engine_build_thread_.joinable()) {
+    GXF_LOG_INFO("Waiting for the background build of engine %s.", engine_file_path_.c_str());
+    engine_build_thread_.join();
+  }
+  destroyCudaGraphs();
+  state_buffers_.clear();
+  batch_inputs_.clear();
+  pending_frames_.clear();
   cuda_execution_ctx_ = nullptr;
   cuda_engine_ = nullptr;
   infer_runtime_ = nullptr;
@@ -720,6 +1059,8 @@ gxf_result_t TensorRtInference::stop() {
 }
 
 gxf_result_t TensorRtInference::tick() {
+  if (num_streams_.get() > 1) { return tickBatch(); }
+
   // Grabs latest messages from all receivers
   std::vector<gxf::Entity> messages;
   messages.reserve(rx_.get().size());
@@ -738,6 +1079,12 @@ gxf_result_t TensorRtInference::tick() {
     GXF_LOG_ERROR("Failed to get the CUDA stream from incoming messages");
     return stream_handler_result;
   }
+
+  // Switches to the optimized engine between two frames once it is built
+  if (engine_build_thread_.joinable() && engine_build_done_) {
+    auto result = swapBackgroundEngine();
+    if (!result) { return gxf::ToResultCode(result); }
+  }
   // Tries to retrieve timestamp if clock present
   gxf::Expected<gxf::Handle<gxf::Timestamp>> maybe_input_timestamp = gxf::Unexpected{GXF_FAILURE};
   for (auto& msg : messages) {
@@ -745,6 +1092,7 @@ gxf_result_t TensorRtInference::tick() {
     if (maybe_input_timestamp) { break; }
   }
   // Populates input tensors
+  input_shapes_.clear();
   for (uint32_t input_index = 0; input_index < input_tensor_names_.get().size(); ++input_index) {
     const auto& tensor_name = input_tensor_names_.get()[input_index];
     const std::string& binding_name = input_binding_names_.get()[input_index];
@@ -761,6 +1109,12 @@ gxf_result_t TensorRtInference::tick() {
         GXF_LOG_ERROR("Failed to retrieve Tensor %s", tensor_name.c_str());
         return GXF_FAILURE;
       }
+    } else if (swap_state_buffers_.get()) {
+      const size_t state_index = std::find(input_state_tensor_names_.get().begin(),
+                                           input_state_tensor_names_.get().end(),
+                                           tensor_name) -
+                                 input_state_tensor_names_.get().begin();
+      maybe_tensor = state_buffers_[state_index][state_parity_];
     } else {
       maybe_tensor = internal_states_.value().get<gxf::Tensor>(tensor_name.c_str());
       if (!maybe_tensor) {
@@ -868,6 +1222,7 @@ gxf_result_t TensorRtInference::tick() {
                     binding_info.binding_name.c_str());
       return GXF_FAILURE;
     }
+    input_shapes_.insert(input_shapes_.end(), dims.d, dims.d + dims.nbDims);
 
     // Binds input tensor buffer
 #if NV_TENSORRT_MAJOR < 8 || (NV_TENSORRT_MAJOR == 8 && NV_TENSORRT_MINOR <5)
@@ -875,6 +1230,7 @@ gxf_result_t TensorRtInference::tick() {
 #else
     cuda_execution_ctx_->setTensorAddress(binding_name.c_str(), input_tensor.pointer());
 #endif
+    binding_addresses_[binding_info.index] = input_tensor.pointer();
   }
 
   // Creates result message entity
@@ -889,6 +1245,27 @@ gxf_result_t TensorRtInference::tick() {
        ++output_index) {
     const auto& tensor_name = output_tensor_names_.get()[output_index];
     const std::string& binding_name = output_binding_names_.get()[output_index];
+
+    // Output states are written to the state buffers read by the next frame
+    const auto state_it = std::find(output_state_tensor_names_.get().begin(),
+                                    output_state_tensor_names_.get().end(),
+                                    tensor_name);
+    if (swap_state_buffers_.get() && state_it != output_state_tensor_names_.get().end()) {
+      const size_t state_index = state_it - output_state_tensor_names_.get().begin();
+      gxf::Tensor& state = *state_buffers_[state_index][state_parity_ ^ 1];
+      const auto state_dims = cuda_engine_->getTensorShape(binding_name.c_str());
+      uint64_t state_elements = 1;
+      for (int32_t i = 0; i < state_dims.nbDims; ++i) { state_elements *= state_dims.d[i]; }
+      if (state_elements * state.bytes_per_element() != state.size()) {
+        GXF_LOG_ERROR("Output state tensor %s does not match the size of input state tensor %s",
+                      tensor_name.c_str(),
+                      input_state_tensor_names_.get()[state_index].c_str());
+        return GXF_FAILURE;
+      }
+      cuda_execution_ctx_->setTensorAddress(binding_name.c_str(), state.pointer());
+      binding_addresses_[binding_infos_[tensor_name].index] = state.pointer();
+      continue;
+    }
 #endif
     auto maybe_result_tensor = maybe_result_message.value().add<gxf::Tensor>(tensor_name.c_str());
     if (!maybe_result_tensor) {
@@ -924,20 +1301,20 @@ gxf_result_t TensorRtInference::tick() {
     cuda_execution_ctx_->setTensorAddress(binding_name.c_str(),
                                           maybe_result_tensor.value()->pointer());
 #endif
+    binding_addresses_[binding_info.index] = maybe_result_tensor.value()->pointer();
   }
 
   // Runs inference on specified CUDA stream
-#if NV_TENSORRT_MAJOR < 8 || (NV_TENSORRT_MAJOR == 8 && NV_TENSORRT_MINOR <5)
-  if (!cuda_execution_ctx_->enqueueV2(
-          cuda_buffers_.data(), cuda_stream_handler_.getCudaStream(), nullptr)) {
-#else
-  if (!cuda_execution_ctx_->enqueueV3(cuda_stream_handler_.getCudaStream())) {
-#endif
+  if (!enqueue(cuda_stream_handler_.getCudaStream())) {
     GXF_LOG_ERROR("TensorRT task enqueue for engine %s failed.", engine_file_path_.c_str());
     return GXF_FAILURE;
   }
+  // The states written by this frame are read by the next one
+  if (swap_state_buffers_.get()) { state_parity_ ^= 1; }
+
   // Copy output state tensor to the input state tensor of the next stage
-  for (uint32_t i = 0; i < state_tensor_count_; ++i) {
+  const uint32_t copied_state_count = swap_state_buffers_.get() ? 0 : state_tensor_count_;
+  for (uint32_t i = 0; i < copied_state_count; ++i) {
     // Get output state tensor
     const auto out_state_tensor = maybe_result_message.value()
                                       .get<gxf::Tensor>(output_state_tensor_names_.get()[i].c_str())
@@ -1011,6 +1388,263 @@ gxf_result_t TensorRtInference::tick() {
   }
 }
 
+gxf_result_t TensorRtInference::tickBatch() {
+#if NV_TENSORRT_MAJOR < 8 || (NV_TENSORRT_MAJOR == 8 && NV_TENSORRT_MINOR <5)
+  return GXF_FAILURE;
+#else
+  // Keeps the frame of each stream until its batch runs
+  const size_t stream_count = rx_.get().size();
+  const auto now = std::chrono::steady_clock::now();
+  std::vector<size_t> streams;  // stream of each row of the batch
+  auto oldest = now;
+  for (size_t stream = 0; stream < stream_count; ++stream) {
+    if (!pending_frames_[stream]) {
+      pending_frames_[stream] = rx_.get()[stream]->receive();
+      if (!pending_frames_[stream]) { continue; }
+      pending_since_[stream] = now;
+    }
+    streams.push_back(stream);
+    oldest = std::min(oldest, pending_since_[stream]);
+  }
+  if (streams.empty()) { return GXF_SUCCESS; }
+  if (streams.size() < stream_count &&
+      now - oldest < std::chrono::milliseconds(max_batch_wait_ms_.get())) {
+    return GXF_SUCCESS;
+  }
+
+  std::vector<gxf::Entity> messages;
+  messages.reserve(streams.size());
+  for (size_t stream : streams) {
+    messages.push_back(std::move(pending_frames_[stream].value()));
+    pending_frames_[stream] = gxf::Unexpected{GXF_UNINITIALIZED_VALUE};
+  }
+
+  // sync with the CUDA streams from the input messages
+  gxf_result_t stream_handler_result = cuda_stream_handler_.fromMessages(context(), messages);
+  if (stream_handler_result != GXF_SUCCESS) {
+    GXF_LOG_ERROR("Failed to get the CUDA stream from incoming messages");
+    return stream_handler_result;
+  }
+  const cudaStream_t cuda_stream = cuda_stream_handler_.getCudaStream();
+
+  // Switches to the optimized engine between two batches once it is built
+  if (engine_build_thread_.joinable() && engine_build_done_) {
+    auto result = swapBackgroundEngine();
+    if (!result) { return gxf::ToResultCode(result); }
+  }
+
+  // Rows of a full batch are the state slots of the streams, in order
+  const int32_t batch_size = static_cast<int32_t>(streams.size());
+  const bool full_batch = streams.size() == stream_count;
+  // Copies rows of the batch, from or to the slots of their streams
+  const auto copy_rows = [&](void* dst, bool dst_slots, const void* src, bool src_slots,
+                             size_t row_bytes, size_t rows) {
+    for (size_t row = 0; row < rows; ++row) {
+      const size_t dst_row = dst_slots ? streams[row] : row;
+      const size_t src_row = src_slots ? streams[row] : row;
+      const cudaError_t cuda_status =
+          CUDA_TRY(cudaMemcpyAsync(static_cast<uint8_t*>(dst) + dst_row * row_bytes,
+                                   static_cast<const uint8_t*>(src) + src_row * row_bytes,
+                                   row_bytes,
+                                   cudaMemcpyDeviceToDevice,
+                                   cuda_stream));
+      if (cuda_status != cudaSuccess) { return false; }
+    }
+    return true;
+  };
+
+  // Gathers the input tensors of the streams and their states into the batch
+  input_shapes_.clear();
+  for (uint32_t input_index = 0; input_index < input_tensor_names_.get().size(); ++input_index) {
+    const auto& tensor_name = input_tensor_names_.get()[input_index];
+    const std::string& binding_name = input_binding_names_.get()[input_index];
+    const auto& binding_info = binding_infos_[tensor_name];
+
+    void* address = nullptr;
+    if (batch_inputs_[input_index]) {
+      gxf::Tensor& batch_tensor = *batch_inputs_[input_index];
+      const uint64_t row_bytes = batch_tensor.size() / stream_count;
+      for (int32_t row = 0; row < batch_size; ++row) {
+        auto maybe_tensor = messages[row].get<gxf::Tensor>(tensor_name.c_str());
+        if (!maybe_tensor) {
+          GXF_LOG_ERROR("Failed to retrieve Tensor %s of stream %zu",
+                        tensor_name.c_str(),
+                        streams[row]);
+          return GXF_FAILURE;
+        }
+        const gxf::Tensor& tensor = *maybe_tensor.value();
+        if (tensor.element_type() != binding_info.element_type || tensor.size() != row_bytes ||
+            tensor.storage_type() != gxf::MemoryStorageType::kDevice) {
+          GXF_LOG_ERROR("Tensor %s of stream %zu does not match a batch row of %s (%s)",
+                        tensor_name.c_str(),
+                        streams[row],
+                        binding_name.c_str(),
+                        FormatDims(binding_info.dimensions, binding_info.rank).c_str());
+          return GXF_FAILURE;
+        }
+        const cudaError_t cuda_status =
+            CUDA_TRY(cudaMemcpyAsync(static_cast<uint8_t*>(batch_tensor.pointer()) +
+                                         row * row_bytes,
+                                     tensor.pointer(),
+                                     row_bytes,
+                                     cudaMemcpyDeviceToDevice,
+                                     cuda_stream));
+        if (cuda_status != cudaSuccess) { return GXF_FAILURE; }
+      }
+      address = batch_tensor.pointer();
+    } else {
+      const size_t state_index = std::find(input_state_tensor_names_.get().begin(),
+                                           input_state_tensor_names_.get().end(),
+                                           tensor_name) -
+                                 input_state_tensor_names_.get().begin();
+      gxf::Tensor& slots = *state_buffers_[state_index][0];
+      address = slots.pointer();
+      if (!full_batch) {
+        gxf::Tensor& rows = *state_buffers_[state_index][1];
+        if (!copy_rows(rows.pointer(),
+                       false,
+                       slots.pointer(),
+                       true,
+                       slots.size() / stream_count,
+                       batch_size)) {
+          return GXF_FAILURE;
+        }
+        address = rows.pointer();
+      }
+    }
+
+    nvinfer1::Dims dims;
+    dims.nbDims = binding_info.rank;
+    for (int32_t i = 0; i < dims.nbDims; ++i) { dims.d[i] = binding_info.dimensions[i]; }
+    dims.d[0] = batch_size;
+    if (!cuda_execution_ctx_->setInputShape(binding_name.c_str(), dims)) {
+      GXF_LOG_ERROR("Failed to update input binding %s dimensions.", binding_name.c_str());
+      return GXF_FAILURE;
+    }
+    input_shapes_.insert(input_shapes_.end(), dims.d, dims.d + dims.nbDims);
+    cuda_execution_ctx_->setTensorAddress(binding_name.c_str(), address);
+    binding_addresses_[binding_info.index] = address;
+  }
+
+  // Creates the batch output tensors, shared by the messages of the streams
+  gxf::Expected<gxf::Entity> maybe_batch_message = gxf::Entity::New(context());
+  if (!maybe_batch_message) { return gxf::ToResultCode(maybe_batch_message); }
+  std::vector<gxf::Handle<gxf::Tensor>> batch_outputs;
+  for (uint32_t output_index = 0; output_index < output_tensor_names_.get().size();
+       ++output_index) {
+    const auto& tensor_name = output_tensor_names_.get()[output_index];
+    const std::string& binding_name = output_binding_names_.get()[output_index];
+    const auto& binding_info = binding_infos_[tensor_name];
+
+    auto maybe_result_tensor = maybe_batch_message.value().add<gxf::Tensor>(tensor_name.c_str());
+    if (!maybe_result_tensor) {
+      GXF_LOG_ERROR("Failed to create output tensor %s", tensor_name.c_str());
+      return gxf::ToResultCode(maybe_result_tensor);
+    }
+    const auto binding_dims = cuda_execution_ctx_->getTensorShape(binding_name.c_str());
+    gxf::Shape shape{Dims2Dimensions(binding_dims), binding_info.rank};
+    auto result = maybe_result_tensor.value()->reshapeCustom(
+        shape,
+        binding_info.element_type,
+        gxf::PrimitiveTypeSize(binding_info.element_type),
+        gxf::Unexpected{GXF_UNINITIALIZED_VALUE},
+        gxf::MemoryStorageType::kDevice,
+        pool_);
+    if (!result) {
+      GXF_LOG_ERROR("Failed to allocate for output tensor %s", tensor_name.c_str());
+      return gxf::ToResultCode(result);
+    }
+    cuda_execution_ctx_->setTensorAddress(binding_name.c_str(),
+                                          maybe_result_tensor.value()->pointer());
+    binding_addresses_[binding_info.index] = maybe_result_tensor.value()->pointer();
+    batch_outputs.push_back(maybe_result_tensor.value());
+  }
+
+  // Runs inference on specified CUDA stream
+  if (!enqueue(cuda_stream)) {
+    GXF_LOG_ERROR("TensorRT task enqueue for engine %s failed.", engine_file_path_.c_str());
+    return GXF_FAILURE;
+  }
+
+  // Scatters the output states back to the slots of the streams
+  for (uint32_t i = 0; i < state_tensor_count_; ++i) {
+    const auto out_state_tensor = maybe_batch_message.value().get<gxf::Tensor>(
+        output_state_tensor_names_.get()[i].c_str());
+    if (!out_state_tensor) {
+      GXF_LOG_ERROR("Failed to get output tensor %s", output_state_tensor_names_.get()[i].c_str());
+      return GXF_FAILURE;
+    }
+    gxf::Tensor& slots = *state_buffers_[i][0];
+    const size_t row_bytes = slots.size() / stream_count;
+    if (out_state_tensor.value()->size() != row_bytes * batch_size) {
+      GXF_LOG_ERROR("Output state tensor %s does not match input state tensor %s",
+                    output_state_tensor_names_.get()[i].c_str(),
+                    input_state_tensor_names_.get()[i].c_str());
+      return GXF_FAILURE;
+    }
+    if (!copy_rows(slots.pointer(),
+                   !full_batch,
+                   out_state_tensor.value()->pointer(),
+                   false,
+                   full_batch ? slots.size() : row_bytes,
+                   full_batch ? 1 : batch_size)) {
+      return GXF_FAILURE;
+    }
+  }
+
+  // Publishes the rows of each stream as tensor views, which keep the batch alive
+  for (int32_t row = 0; row < batch_size; ++row) {
+    gxf::Expected<gxf::Entity> maybe_result_message = gxf::Entity::New(context());
+    if (!maybe_result_message) { return gxf::ToResultCode(maybe_result_message); }
+    for (uint32_t output_index = 0; output_index < batch_outputs.size(); ++output_index) {
+      const auto& tensor_name = output_tensor_names_.get()[output_index];
+      gxf::Tensor& batch_tensor = *batch_outputs[output_index];
+      auto maybe_view = maybe_result_message.value().add<gxf::Tensor>(tensor_name.c_str());
+      if (!maybe_view) {
+        GXF_LOG_ERROR("Failed to create output tensor %s", tensor_name.c_str());
+        return gxf::ToResultCode(maybe_view);
+      }
+      std::array<int32_t, gxf::Shape::kMaxRank> dimensions;
+      for (uint32_t i = 0; i < batch_tensor.rank(); ++i) {
+        dimensions[i] = batch_tensor.shape().dimension(i);
+      }
+      dimensions[0] = 1;
+      const uint64_t row_bytes = batch_tensor.size() / batch_size;
+      auto result = maybe_view.value()->wrapMemory(
+          gxf::Shape{dimensions, batch_tensor.rank()},
+          batch_tensor.element_type(),
+          batch_tensor.bytes_per_element(),
+          gxf::Unexpected{GXF_UNINITIALIZED_VALUE},
+          gxf::MemoryStorageType::kDevice,
+          static_cast<uint8_t*>(batch_tensor.pointer()) + row * row_bytes,
+          [batch_message = maybe_batch_message.value()](void*) mutable {
+            batch_message = gxf::Entity();
+            return gxf::Success;
+          });
+      if (!result) {
+        GXF_LOG_ERROR("Failed to wrap output tensor %s", tensor_name.c_str());
+        return gxf::ToResultCode(result);
+      }
+    }
+
+    // pass the CUDA stream to the output message
+    stream_handler_result = cuda_stream_handler_.toMessage(maybe_result_message);
+    if (stream_handler_result != GXF_SUCCESS) {
+      GXF_LOG_ERROR("Failed to add the CUDA stream to the outgoing messages");
+      return stream_handler_result;
+    }
+
+    // Publishes result with the acqtime of the frame of the stream
+    const auto maybe_input_timestamp = messages[row].get<gxf::Timestamp>("timestamp");
+    const int64_t acqtime = maybe_input_timestamp ? maybe_input_timestamp.value()->acqtime : 0;
+    auto result = stream_tx_.try_get().value()[streams[row]]->publish(
+        maybe_result_message.value(), acqtime);
+    if (!result) { return gxf::ToResultCode(result); }
+  }
+  return GXF_SUCCESS;
+#endif
+}
+
 static std::string replaceChar(const std::string& string, char match, char replacement) {
   std::string result = string;
   std::replace(result.begin(), result.end(), match, replacement);
@@ -20,9 +20,14 @@
 #include <NvInfer.h>
 #include <cuda_runtime.h>
 
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <list>
 #include <memory>
 #include <mutex>
 #include <string>
+#include <thread>
 #include <unordered_map>
 #include <vector>
 
@@ -61,6 +66,22 @@ class TensorRTInferenceLogger : public nvinfer1::ILogger {
 /// If the engine cache directory has no pre-existing engine file for an architecture, it will
 /// generate this dynamically.
 /// Requires gxf::CudaStream to run load on specific CUDA stream.
+///
+/// With swap_state_buffers, every recurrent state has two buffers, one read and the other
+/// written by the model, swapped on every frame instead of copying the output state to the
+/// input state. With use_cuda_graph, the inference is captured in a CUDA graph per set of
+/// tensor addresses, replayed while the input shapes do not change. Both require TensorRT 8.5.
+///
+/// Builds load and save a timing cache next to the engine files. With background_engine_build,
+/// a missing or forcibly updated engine is built on a background thread while the previous
+/// engine, or one built without optimization, runs the inference. The optimized engine is
+/// swapped in between two frames.
+///
+/// With num_streams above 1, one engine serves a stream per receiver of rx. The frames of the
+/// streams are gathered into a batch once every stream has one, or max_batch_wait_ms after the
+/// first arrived. Each stream keeps its recurrent state in its row of batched state tensors,
+/// and receives its rows of the output tensors on its transmitter of stream_tx. Requires a
+/// dynamic batch dimension on every input and TensorRT 8.5.
 class TensorRtInference : public gxf::Codelet {
  public:
   gxf_result_t start() override;
@@ -93,8 +114,21 @@ class TensorRtInference : public gxf::Codelet {
   } BindingInfo;
   std::unordered_map<std::string, BindingInfo> binding_infos_;
 
-  // Converts loaded model to engine plan
-  gxf::Expected<std::vector<char>> convertModelToEngine();
+  // Converts loaded model to engine plan, at the default level of optimization when
+  // optimization_level is negative
+  gxf::Expected<std::vector<char>> convertModelToEngine(int optimization_level = -1);
+  // Converts the model and serializes the plan to the engine file path
+  gxf::Expected<std::vector<char>> buildAndSerializeEngine();
+  void startBackgroundEngineBuild();
+  // Replaces the engine and execution context with the one built in the background
+  gxf::Expected<void> swapBackgroundEngine();
+
+  // Batched mode of tick(), for num_streams streams
+  gxf_result_t tickBatch();
+
+  // Runs inference on stream, through the CUDA graph of the current bindings when enabled
+  gxf::Expected<void> enqueue(cudaStream_t stream);
+  void destroyCudaGraphs();
 
   gxf::Parameter<std::string> model_file_path_;
   gxf::Parameter<std::string> engine_cache_dir_;
@@ -114,6 +148,13 @@ class TensorRtInference : public gxf::Codelet {
   gxf::Parameter<bool> enable_fp16_;
   gxf::Parameter<bool> relaxed_dimension_check_;
   gxf::Parameter<bool> verbose_;
+  gxf::Parameter<bool> use_timing_cache_;
+  gxf::Parameter<bool> background_engine_build_;
+  gxf::Parameter<bool> swap_state_buffers_;
+  gxf::Parameter<bool> use_cuda_graph_;
+  gxf::Parameter<int32_t> num_streams_;
+  gxf::Parameter<int64_t> max_batch_wait_ms_;
+  gxf::Parameter<std::vector<gxf::Handle<gxf::Transmitter>>> stream_tx_;
 
   gxf::Parameter<std::vector<gxf::Handle<gxf::Receiver>>> rx_;
   gxf::Parameter<gxf::Handle<gxf::Transmitter>> tx_;
@@ -129,7 +170,35 @@ class TensorRtInference : public gxf::Codelet {
 
   uint32_t state_tensor_count_ = 0;
   gxf::Expected<gxf::Entity> internal_states_ = gxf::Unexpected{GXF_UNINITIALIZED_VALUE};
+  // With swap_state_buffers, the buffers of each state, read and written on alternate frames.
+  // In batched mode, the state slots of all streams and the state rows of a partial batch.
+  std::vector<std::array<gxf::Handle<gxf::Tensor>, 2>> state_buffers_;
+  uint32_t state_parity_ = 0;
+
+  // Instantiated graphs by tensor addresses in binding order, most recently used first
+  struct CudaGraph {
+    std::vector<void*> addresses;
+    cudaGraphExec_t exec;
+  };
+  static constexpr size_t kMaxCudaGraphs = 8;
+  std::list<CudaGraph> cuda_graphs_;
+  std::vector<void*> binding_addresses_;
+  // Input shapes of the last frame, a change invalidates the graphs
+  std::vector<int32_t> input_shapes_;
+  std::vector<int32_t> last_input_shapes_;
+  bool cuda_graph_failed_ = false;
+
+  // Batched mode: batch tensor by input, null for states, and the frame waiting per stream
+  std::vector<gxf::Handle<gxf::Tensor>> batch_inputs_;
+  std::vector<gxf::Expected<gxf::Entity>> pending_frames_;
+  std::vector<std::chrono::steady_clock::time_point> pending_since_;
   std::string engine_file_path_;
+  std::string timing_cache_file_path_;
+
+  std::thread engine_build_thread_;
+  // Set by the build thread once background_plan_ holds the plan, empty on failure
+  std::atomic<bool> engine_build_done_{false};
+  std::vector<char> background_plan_;
 
   holoscan::CudaStreamHandler cuda_stream_handler_;
 };
@@ -0,0 +1,272 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef GXF_EXTENSIONS_UTILS_CUDA_GRAPH_CACHE_HPP
+#define GXF_EXTENSIONS_UTILS_CUDA_GRAPH_CACHE_HPP
+
+#include <cuda_runtime.h>
+
+#include <cstdint>
+#include <cstring>
+#include <list>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "common/logger.hpp"
+
+namespace nvidia {
+namespace holoscan {
+
+/**
+ * This class replays the GPU work of an operator tick as a CUDA graph.
+ *
+ * Operators launching a fixed sequence of kernels per tick pay the launch latency of each of
+ * them. The cache captures that work on the operator's stream into a graph which is launched
+ * once per tick instead. Tensor pointers, and the scalars the kernels take, usually change from
+ * tick to tick while the sequence of launches doesn't, so graphs are looked up by two keys:
+ * - the shape key holds whatever changes the sequence of CUDA calls of the work, e.g. the input
+ *   shapes and formats. A graph is captured per shape key, up to `capacity` graphs, the least
+ *   recently used one is evicted.
+ * - the params key holds whatever else the work passes to CUDA, e.g. pointers and scalars. When
+ *   it changes, the work is captured again and the kernel node parameters of the existing graph
+ *   are updated with cudaGraphExecUpdate(), which is much cheaper than instantiating a graph.
+ *   The graph is replayed as is while the params key is unchanged.
+ *
+ * The first `warmup_launches` ticks of a shape run directly, since first launches may allocate
+ * memory or load modules, which can't be captured. When the work can't be captured or the
+ * graph can't be instantiated, the work of that shape keeps running directly. Work on the
+ * legacy default stream, or on a stream which is already being captured, runs directly too.
+ *
+ * Usage, with a CudaStreamHandler providing the stream:
+ * - add an instance of CudaGraphCache to your operator
+ * - in the tick() function wrap the CUDA calls in a callable taking the stream and returning a
+ *   cudaError_t, and call CudaGraphCache::launch() with the keys of this tick
+ *
+ *   const auto shape = CudaGraphCache::makeKey(width, height, format);
+ *   const auto params = CudaGraphCache::makeKey(in_ptr, out_ptr, threshold);
+ *   cuda_result = graph_cache_.launch(shape, params, stream, [&](cudaStream_t s) {
+ *     return launch_kernels(in_ptr, out_ptr, width, height, threshold, s);
+ *   });
+ *
+ * The work must only enqueue asynchronous operations on the given stream, no synchronization
+ * and no host reads of device results. An instance isn't thread safe, use one per operator.
+ */
+class CudaGraphCache {
+ public:
+  using Key = std::vector<uint64_t>;
+
+  /**
+   * @param capacity         maximum number of graphs kept, one per shape key
+   * @param warmup_launches  number of ticks of each shape run directly before capturing it
+   */
+  explicit CudaGraphCache(size_t capacity = 4, uint32_t warmup_launches = 1)
+      : capacity_(capacity > 0 ? capacity : 1), warmup_launches_(warmup_launches) {}
+
+  CudaGraphCache(const CudaGraphCache&) = delete;
+  CudaGraphCache& operator=(const CudaGraphCache&) = delete;
+
+  ~CudaGraphCache() { clear(); }
+
+  /**
+   * Build a key from integers, enums, floating point values and pointers
+   *
+   * @return Key
+   */
+  template <typename... T>
+  static Key makeKey(const T&... values) {
+    Key key;
+    key.reserve(sizeof...(values));
+    (key.push_back(toKeyValue(values)), ...);
+    return key;
+  }
+
+  /**
+   * Run the work of a tick on a stream, replaying its graph when possible
+   *
+   * @param shape_key   key of what changes the sequence of CUDA calls of the work
+   * @param params_key  key of the other arguments of the work's CUDA calls
+   * @param stream      stream to run the work on
+   * @param work        callable enqueuing the work on the stream passed to it, returning a
+   *                    cudaError_t
+   * @return cudaError_t
+   */
+  template <typename F>
+  cudaError_t launch(const Key& shape_key, const Key& params_key, cudaStream_t stream, F&& work) {
+    if (!capturable(stream)) {
+      ++direct_launches_;
+      return work(stream);
+    }
+
+    Entry& entry = findOrInsert(shape_key);
+    if (entry.failed || entry.launches < warmup_launches_) {
+      ++entry.launches;
+      ++direct_launches_;
+      return work(stream);
+    }
+
+    if (!entry.exec || entry.params_key != params_key) {
+      cudaGraph_t graph = nullptr;
+      cudaError_t result = capture(stream, work, &graph);
+      if (result == cudaSuccess) { result = instantiateOrUpdate(entry, graph); }
+      if (graph) { cudaGraphDestroy(graph); }
+      if (result != cudaSuccess) {
+        GXF_LOG_WARNING("Failed to capture a CUDA graph (%s), launching the work directly",
+                        cudaGetErrorString(result));
+        // clear the error of the capture, the direct launch reports its own errors
+        cudaGetLastError();
+        destroyExec(entry);
+        entry.failed = true;
+        ++direct_launches_;
+        return work(stream);
+      }
+      entry.params_key = params_key;
+    } else {
+      ++replays_;
+    }
+    return cudaGraphLaunch(entry.exec, stream);
+  }
+
+  /**
+   * Destroy all graphs, e.g. when the buffers the work uses are reallocated
+   */
+  void clear() {
+    for (auto&& entry : entries_) { destroyExec(entry); }
+    entries_.clear();
+  }
+
+  /// Number of graphs captured, updates of an existing graph included
+  uint64_t captures() const { return captures_; }
+  /// Number of graph updates with new kernel node parameters
+  uint64_t updates() const { return updates_; }
+  /// Number of launches of a graph without a new capture
+  uint64_t replays() const { return replays_; }
+  /// Number of launches of the work without a graph
+  uint64_t directLaunches() const { return direct_launches_; }
+
+ private:
+  struct Entry {
+    Key shape_key;
+    Key params_key;
+    cudaGraphExec_t exec = nullptr;
+    uint32_t launches = 0;
+    bool failed = false;
+  };
+
+  template <typename T>
+  static uint64_t toKeyValue(const T& value) {
+    if constexpr (std::is_pointer_v<T>) {
+      return reinterpret_cast<uintptr_t>(value);
+    } else if constexpr (std::is_enum_v<T>) {
+      return static_cast<uint64_t>(value);
+    } else if constexpr (std::is_floating_point_v<T>) {
+      // the bits of the value, a new value must change the key
+      const double d = value;
+      uint64_t bits;
+      static_assert(sizeof(bits) == sizeof(d));
+      std::memcpy(&bits, &d, sizeof(bits));
+      return bits;
+    } else {
+      static_assert(std::is_integral_v<T>, "Key values must be integers, enums, floats or "
+                                           "pointers");
+      return static_cast<uint64_t>(value);
+    }
+  }
+
+  static bool capturable(cudaStream_t stream) {
+    if (stream == cudaStreamLegacy || stream == nullptr) { return false; }
+    // work on a stream being captured becomes part of the enclosing graph
+    cudaStreamCaptureStatus status = cudaStreamCaptureStatusNone;
+    return cudaStreamIsCapturing(stream, &status) == cudaSuccess &&
+           status == cudaStreamCaptureStatusNone;
+  }
+
+  Entry& findOrInsert(const Key& shape_key) {
+    for (auto it = entries_.begin(); it != entries_.end(); ++it) {
+      if (it->shape_key == shape_key) {
+        // most recently used first
+        entries_.splice(entries_.begin(), entries_, it);
+        return entries_.front();
+      }
+    }
+    if (entries_.size() >= capacity_) {
+      destroyExec(entries_.back());
+      entries_.pop_back();
+    }
+    entries_.push_front(Entry{shape_key});
+    return entries_.front();
+  }
+
+  template <typename F>
+  cudaError_t capture(cudaStream_t stream, F& work, cudaGraph_t* graph) {
+    cudaError_t result = cudaStreamBeginCapture(stream, cudaStreamCaptureModeThreadLocal);
+    if (result != cudaSuccess) { return result; }
+    const cudaError_t work_result = work(stream);
+    // the capture must be ended even when the work failed
+    result = cudaStreamEndCapture(stream, graph);
+    if (work_result != cudaSuccess) { return work_result; }
+    if (result == cudaSuccess) { ++captures_; }
+    return result;
+  }
+
+  cudaError_t instantiateOrUpdate(Entry& entry, cudaGraph_t graph) {
+    if (entry.exec) {
+      // the topology of the graph is the same unless the shape key misses a dependency, in
+      // which case the graph is instantiated again
+#if CUDART_VERSION >= 12000
+      cudaGraphExecUpdateResultInfo info;
+      const cudaError_t result = cudaGraphExecUpdate(entry.exec, graph, &info);
+#else
+      cudaGraphNode_t error_node = nullptr;
+      cudaGraphExecUpdateResult info;
+      const cudaError_t result = cudaGraphExecUpdate(entry.exec, graph, &error_node, &info);
+#endif
+      if (result == cudaSuccess) {
+        ++updates_;
+        return cudaSuccess;
+      }
+      cudaGetLastError();
+      destroyExec(entry);
+    }
+#if CUDART_VERSION >= 12000
+    return cudaGraphInstantiate(&entry.exec, graph, 0);
+#else
+    return cudaGraphInstantiate(&entry.exec, graph, nullptr, nullptr, 0);
+#endif
+  }
+
+  static void destroyExec(Entry& entry) {
+    if (entry.exec) { cudaGraphExecDestroy(entry.exec); }
+    entry.exec = nullptr;
+  }
+
+  const size_t capacity_;
+  const uint32_t warmup_launches_;
+
+  /// Graphs by shape key, most recently used first
+  std::list<Entry> entries_;
+
+  uint64_t captures_ = 0;
+  uint64_t updates_ = 0;
+  uint64_t replays_ = 0;
+  uint64_t direct_launches_ = 0;
+};
+
+}  // namespace holoscan
+}  // namespace nvidia
+
+#endif /* GXF_EXTENSIONS_UTILS_CUDA_GRAPH_CACHE_HPP */
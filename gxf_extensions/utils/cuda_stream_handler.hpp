@@ -18,6 +18,12 @@
 #ifndef GXF_EXTENSIONS_UTILS_CUDA_STREAM_HANDLER_HPP
 #define GXF_EXTENSIONS_UTILS_CUDA_STREAM_HANDLER_HPP
 
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <deque>
+#include <mutex>
+#include <string>
 #include <utility>
 #include <vector>
 
@@ -28,6 +34,69 @@
 namespace nvidia {
 namespace holoscan {
 
+/**
+ * Process-wide pool of CUDA events without timing, used to chain CUDA streams.
+ *
+ * cudaStreamWaitEvent() waits for the work captured by the last record of the event, so an event
+ * can be released as soon as the wait is enqueued. The pool therefore only holds as many events
+ * as streams are chained concurrently.
+ */
+class CudaEventPool {
+ public:
+  static CudaEventPool& instance() {
+    static CudaEventPool pool;
+    return pool;
+  }
+
+  /**
+   * Get an event from the pool, or create one if it is empty
+   *
+   * @return cudaEvent_t, nullptr if the event can't be created
+   */
+  cudaEvent_t acquire() {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (!free_events_.empty()) {
+        const cudaEvent_t event = free_events_.back();
+        free_events_.pop_back();
+        return event;
+      }
+    }
+    cudaEvent_t event = nullptr;
+    const cudaError_t result = cudaEventCreateWithFlags(&event, cudaEventDisableTiming);
+    if (cudaSuccess != result) {
+      GXF_LOG_ERROR("Failed to create CUDA event: %s", cudaGetErrorString(result));
+      return nullptr;
+    }
+    ++created_events_;
+    return event;
+  }
+
+  /**
+   * Return an event to the pool
+   *
+   * @param event
+   */
+  void release(cudaEvent_t event) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    free_events_.push_back(event);
+  }
+
+  /// Number of events created by the pool
+  uint64_t createdEvents() const { return created_events_; }
+
+ private:
+  CudaEventPool() = default;
+  ~CudaEventPool() {
+    // The CUDA runtime may already be unloaded at exit, errors are ignored
+    for (auto&& event : free_events_) { cudaEventDestroy(event); }
+  }
+
+  std::mutex mutex_;
+  std::vector<cudaEvent_t> free_events_;
+  std::atomic<uint64_t> created_events_{0};
+};
+
 /**
  * This class handles usage of CUDA streams for operators.
  *
@@ -43,11 +112,18 @@ namespace holoscan {
  * - in the tick() function call CudaStreamHandler::fromMessage(), this will get the CUDA stream
  *   from the message of the previous operator. When the operator receives multiple messages, then
  *   call CudaStreamHandler::fromMessages(). This will synchronize with multiple streams.
+ *   When the messages carry a single stream, that stream is used as is, without a wait. Events
+ *   for the waits on multiple streams come from the process-wide CudaEventPool.
  * - when executing CUDA functions CudaStreamHandler::get() to get the CUDA stream which should
  *   be used by your CUDA function
  * - before publishing the output message(s) of your operator call CudaStreamHandler::toMessage() on
  *   each message. This will add the CUDA stream used by the CUDA functions in your operator to
  *   the output message.
+ *
+ * When profiling is enabled with CudaStreamHandler::setProfilingName(), the GPU time of each tick
+ * is measured with CUDA events recorded on the stream by fromMessage() or fromMessages() and by
+ * the first following toMessage(). The number of cross-stream waits inserted by the handler, and
+ * of ticks run on an upstream stream without a wait, are logged as well.
  */
 class CudaStreamHandler {
  public:
@@ -55,13 +131,19 @@ class CudaStreamHandler {
    * @brief Destroy the CudaStreamHandler object
    */
   ~CudaStreamHandler() {
-    for (auto&& event : cuda_events_) {
-      const cudaError_t result = cudaEventDestroy(event);
-      if (cudaSuccess != result) {
-        GXF_LOG_ERROR("Failed to destroy CUDA event: %s", cudaGetErrorString(result));
+    if (profiling_) {
+      collectGpuTimings(true);
+      if (gpu_ticks_ > 0) {
+        GXF_LOG_INFO("%s: GPU time over %lu ticks: avg %.3f ms, min %.3f ms, max %.3f ms",
+                     profiling_name_.c_str(), gpu_ticks_, gpu_time_sum_ms_ / gpu_ticks_,
+                     gpu_time_min_ms_, gpu_time_max_ms_);
       }
+      GXF_LOG_INFO("%s: %lu cross-stream waits, %lu ticks on an adopted upstream stream",
+                   profiling_name_.c_str(), cross_stream_waits_, adopted_streams_);
+      for (auto&& timing : gpu_timings_free_) { destroyGpuTiming(timing); }
+      for (auto&& timing : gpu_timings_pending_) { destroyGpuTiming(timing); }
+      if (gpu_timing_started_) { destroyGpuTiming(gpu_timing_); }
     }
-    cuda_events_.clear();
   }
 
   /**
@@ -96,6 +178,7 @@ class CudaStreamHandler {
           gxf::Handle<gxf::CudaStream>::Create(context, maybe_cuda_stream_id.value()->stream_cid);
       if (maybe_cuda_stream_handle) {
         message_cuda_stream_handle_ = maybe_cuda_stream_handle.value();
+        countAdoptedStream();
       }
     } else {
       // if no stream had been found, allocate a stream and use that
@@ -103,72 +186,88 @@ class CudaStreamHandler {
       if (result != GXF_SUCCESS) { return result; }
       message_cuda_stream_handle_ = cuda_stream_handle_;
     }
+    startGpuTiming();
     return GXF_SUCCESS;
   }
 
   /**
    * Get the CUDA stream for the operation from the incoming messages
    *
+   * If the messages carry a single stream, it is used as by fromMessage(): the operations of the
+   * operator are ordered after those of its producers without any wait. Otherwise the internal
+   * stream, or the first message stream if no stream pool is set, waits for the other streams.
+   * Without any message stream, the internal stream is used.
+   *
    * @param context
    * @param messages
    * @return gxf_result_t
    */
   gxf_result_t fromMessages(gxf_context_t context,
                             const std::vector<nvidia::gxf::Entity>& messages) {
-    const gxf_result_t result = allocateInternalStream();
-    if (result != GXF_SUCCESS) { return result; }
+    // collect the distinct streams of the messages
+    message_streams_.clear();
+    for (auto& msg : messages) {
+      const auto maybe_cuda_stream_id = msg.get<gxf::CudaStreamId>();
+      if (!maybe_cuda_stream_id) { continue; }
+      const auto maybe_cuda_stream_handle =
+          gxf::Handle<gxf::CudaStream>::Create(context, maybe_cuda_stream_id.value()->stream_cid);
+      if (!maybe_cuda_stream_handle) { continue; }
+      const auto& handle = maybe_cuda_stream_handle.value();
+      if (std::none_of(message_streams_.begin(),
+                       message_streams_.end(),
+                       [&handle](const auto& stream) { return stream.cid() == handle.cid(); })) {
+        message_streams_.push_back(handle);
+      }
+    }
 
-    if (!cuda_stream_handle_) {
-      // if no CUDA stream can be allocated because no stream pool is set, then don't sync
-      // with incoming streams. CUDA operations of this operator will use the default stream
-      // which sync with all other streams by default.
+    if (message_streams_.size() == 1) {
+      message_cuda_stream_handle_ = message_streams_.front();
+      countAdoptedStream();
+      startGpuTiming();
       return GXF_SUCCESS;
     }
 
-    // iterate through all messages and use events to chain incoming streams with the internal
-    // stream
-    auto event_it = cuda_events_.begin();
-    for (auto& msg : messages) {
-      const auto maybe_cuda_stream_id = msg.get<gxf::CudaStreamId>();
-      if (maybe_cuda_stream_id) {
-        const auto maybe_cuda_stream_handle =
-            gxf::Handle<gxf::CudaStream>::Create(context, maybe_cuda_stream_id.value()->stream_cid);
-        if (maybe_cuda_stream_handle) {
-          const cudaStream_t cuda_stream = maybe_cuda_stream_handle.value()->stream().value();
-          cudaError_t result;
-
-          // allocate a new event if needed
-          if (event_it == cuda_events_.end()) {
-            cudaEvent_t cuda_event;
-            result = cudaEventCreateWithFlags(&cuda_event, cudaEventDisableTiming);
-            if (cudaSuccess != result) {
-              GXF_LOG_ERROR("Failed to create input CUDA event: %s", cudaGetErrorString(result));
-              return GXF_FAILURE;
-            }
-            cuda_events_.push_back(cuda_event);
-            event_it = cuda_events_.end();
-            --event_it;
-          }
-
-          result = cudaEventRecord(*event_it, cuda_stream);
-          if (cudaSuccess != result) {
-            GXF_LOG_ERROR("Failed to record event for message stream: %s",
-                          cudaGetErrorString(result));
-            return GXF_FAILURE;
-          }
-          result = cudaStreamWaitEvent(cuda_stream_handle_->stream().value(), *event_it);
-          if (cudaSuccess != result) {
-            GXF_LOG_ERROR("Failed to record wait on message event: %s", cudaGetErrorString(result));
-            return GXF_FAILURE;
-          }
-          ++event_it;
-        }
+    const gxf_result_t result = allocateInternalStream();
+    if (result != GXF_SUCCESS) { return result; }
+    message_cuda_stream_handle_ = cuda_stream_handle_;
+
+    if (!message_cuda_stream_handle_) {
+      if (message_streams_.empty()) {
+        // if no CUDA stream can be allocated because no stream pool is set, and no message
+        // carries a stream, CUDA operations of this operator will use the default stream which
+        // sync with all other streams by default.
+        return GXF_SUCCESS;
       }
+      message_cuda_stream_handle_ = message_streams_.front();
+      countAdoptedStream();
     }
-    message_cuda_stream_handle_ = cuda_stream_handle_;
+
+    // use events to chain the other incoming streams with the selected stream
+    const cudaStream_t cuda_stream = message_cuda_stream_handle_->stream().value();
+    for (auto& message_stream : message_streams_) {
+      if (message_stream.cid() == message_cuda_stream_handle_.cid()) { continue; }
+      const gxf_result_t wait_result =
+          waitForStream(cuda_stream, message_stream->stream().value());
+      if (wait_result != GXF_SUCCESS) { return wait_result; }
+    }
+    startGpuTiming();
     return GXF_SUCCESS;
   }
 
+  /**
+   * Total number of cross-stream waits inserted by all handlers of the process
+   *
+   * @return uint64_t
+   */
+  static uint64_t totalCrossStreamWaits() { return statistics().cross_stream_waits; }
+
+  /**
+   * Total number of ticks of all handlers of the process which used an upstream stream directly
+   *
+   * @return uint64_t
+   */
+  static uint64_t totalAdoptedStreams() { return statistics().adopted_streams; }
+
   /**
    * @brief Add the used CUDA stream to the outgoing message
    *
@@ -184,6 +283,7 @@ class CudaStreamHandler {
       }
       maybe_stream_id.value()->stream_cid = message_cuda_stream_handle_.cid();
     }
+    stopGpuTiming();
     return GXF_SUCCESS;
   }
 
@@ -220,7 +320,119 @@ class CudaStreamHandler {
     return cudaStreamDefault;
   }
 
+  /**
+   * Enable the GPU time measurement of each tick if the HOLOSCAN_OPERATOR_PROFILING environment
+   * variable is set, e.g. by the flow benchmarking harness. A summary is logged under the given
+   * name when the handler is destroyed.
+   *
+   * @param name name of the operator
+   */
+  void setProfilingName(const std::string& name) {
+    const char* profiling = std::getenv("HOLOSCAN_OPERATOR_PROFILING");
+    profiling_ = profiling != nullptr && profiling[0] != '\0' && std::string(profiling) != "0";
+    profiling_name_ = name;
+  }
+
  private:
+  struct GpuTiming {
+    cudaEvent_t start = nullptr;
+    cudaEvent_t end = nullptr;
+  };
+
+  void startGpuTiming() {
+    if (!profiling_) { return; }
+    collectGpuTimings(false);
+    if (!gpu_timing_started_) {
+      if (!gpu_timings_free_.empty()) {
+        gpu_timing_ = gpu_timings_free_.back();
+        gpu_timings_free_.pop_back();
+      } else if (cudaEventCreate(&gpu_timing_.start) != cudaSuccess ||
+                 cudaEventCreate(&gpu_timing_.end) != cudaSuccess) {
+        GXF_LOG_ERROR("%s: failed to create the GPU timing events, profiling disabled",
+                      profiling_name_.c_str());
+        destroyGpuTiming(gpu_timing_);
+        profiling_ = false;
+        return;
+      }
+    }
+    // A tick without output restarts the timing
+    gpu_timing_started_ = cudaEventRecord(gpu_timing_.start, getCudaStream()) == cudaSuccess;
+    if (!gpu_timing_started_) { gpu_timings_free_.push_back(gpu_timing_); }
+  }
+
+  void stopGpuTiming() {
+    if (!gpu_timing_started_) { return; }
+    gpu_timing_started_ = false;
+    if (cudaEventRecord(gpu_timing_.end, getCudaStream()) != cudaSuccess) {
+      gpu_timings_free_.push_back(gpu_timing_);
+      return;
+    }
+    gpu_timings_pending_.push_back(gpu_timing_);
+  }
+
+  /// Accumulate the timings which completed, or all of them if wait is set
+  void collectGpuTimings(bool wait) {
+    while (!gpu_timings_pending_.empty()) {
+      GpuTiming timing = gpu_timings_pending_.front();
+      const cudaError_t status =
+          wait ? cudaEventSynchronize(timing.end) : cudaEventQuery(timing.end);
+      if (status == cudaErrorNotReady) { return; }
+      float elapsed_ms = 0.f;
+      if (status == cudaSuccess &&
+          cudaEventElapsedTime(&elapsed_ms, timing.start, timing.end) == cudaSuccess) {
+        gpu_time_min_ms_ = gpu_ticks_ ? std::min(gpu_time_min_ms_, elapsed_ms) : elapsed_ms;
+        gpu_time_max_ms_ = std::max(gpu_time_max_ms_, elapsed_ms);
+        gpu_time_sum_ms_ += elapsed_ms;
+        ++gpu_ticks_;
+      }
+      gpu_timings_pending_.pop_front();
+      gpu_timings_free_.push_back(timing);
+    }
+  }
+
+  struct Statistics {
+    std::atomic<uint64_t> cross_stream_waits{0};
+    std::atomic<uint64_t> adopted_streams{0};
+  };
+
+  static Statistics& statistics() {
+    static Statistics statistics;
+    return statistics;
+  }
+
+  void countAdoptedStream() {
+    ++adopted_streams_;
+    ++statistics().adopted_streams;
+  }
+
+  /// Make waiting_stream wait for the work enqueued so far on stream
+  gxf_result_t waitForStream(cudaStream_t waiting_stream, cudaStream_t stream) {
+    CudaEventPool& pool = CudaEventPool::instance();
+    const cudaEvent_t event = pool.acquire();
+    if (event == nullptr) { return GXF_FAILURE; }
+    cudaError_t result = cudaEventRecord(event, stream);
+    if (cudaSuccess != result) {
+      GXF_LOG_ERROR("Failed to record event for message stream: %s", cudaGetErrorString(result));
+      pool.release(event);
+      return GXF_FAILURE;
+    }
+    result = cudaStreamWaitEvent(waiting_stream, event);
+    pool.release(event);
+    if (cudaSuccess != result) {
+      GXF_LOG_ERROR("Failed to record wait on message event: %s", cudaGetErrorString(result));
+      return GXF_FAILURE;
+    }
+    ++cross_stream_waits_;
+    ++statistics().cross_stream_waits;
+    return GXF_SUCCESS;
+  }
+
+  static void destroyGpuTiming(GpuTiming& timing) {
+    if (timing.start) { cudaEventDestroy(timing.start); }
+    if (timing.end) { cudaEventDestroy(timing.end); }
+    timing = GpuTiming{};
+  }
+
   /**
    * Allocate the internal CUDA stream
    *
@@ -250,15 +462,30 @@ class CudaStreamHandler {
   /// a warning once.
   bool default_stream_warning_ = false;
 
-  /// Array of CUDA events used to synchronize the internal CUDA stream with multiple incoming
-  /// streams
-  std::vector<cudaEvent_t> cuda_events_;
+  /// Distinct streams of the messages given to fromMessages(), kept to reuse its storage
+  std::vector<gxf::Handle<gxf::CudaStream>> message_streams_;
+
+  /// Cross-stream waits inserted and ticks run on an upstream stream by this handler
+  uint64_t cross_stream_waits_ = 0;
+  uint64_t adopted_streams_ = 0;
 
   /// The CUDA stream which is attached to the incoming message
   gxf::Handle<gxf::CudaStream> message_cuda_stream_handle_;
 
   /// Allocated internal CUDA stream handle
   gxf::Handle<gxf::CudaStream> cuda_stream_handle_;
+
+  /// GPU time measurement, see setProfilingName()
+  bool profiling_ = false;
+  std::string profiling_name_;
+  bool gpu_timing_started_ = false;
+  GpuTiming gpu_timing_;
+  std::deque<GpuTiming> gpu_timings_pending_;
+  std::vector<GpuTiming> gpu_timings_free_;
+  uint64_t gpu_ticks_ = 0;
+  double gpu_time_sum_ms_ = 0.;
+  float gpu_time_min_ms_ = 0.f;
+  float gpu_time_max_ms_ = 0.f;
 };
 
 }  // namespace holoscan
@@ -0,0 +1,128 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "qcap_color_convert.hpp"
+
+namespace nvidia {
+namespace holoscan {
+
+namespace {
+
+constexpr unsigned kBlockWidth = 32;
+constexpr unsigned kBlockHeight = 8;
+
+__device__ inline uint8_t clamp_u8(float v) {
+  return static_cast<uint8_t>(fminf(fmaxf(v + 0.5f, 0.f), 255.f));
+}
+
+__device__ inline void store_pixel(uint8_t* dst, int channels, uint8_t r, uint8_t g, uint8_t b) {
+  dst[0] = r;
+  dst[1] = g;
+  dst[2] = b;
+  if (channels == 4) { dst[3] = 255; }
+}
+
+// BT.601 video range
+__device__ inline void store_yuv(uint8_t* dst, int channels, int y, int u, int v) {
+  const float c = 1.164f * static_cast<float>(y - 16);
+  const float d = static_cast<float>(u - 128);
+  const float e = static_cast<float>(v - 128);
+  store_pixel(dst,
+              channels,
+              clamp_u8(c + 1.596f * e),
+              clamp_u8(c - 0.392f * d - 0.813f * e),
+              clamp_u8(c + 2.017f * d));
+}
+
+// One thread per horizontal pair of pixels, which share their chroma in both formats
+__global__ void yuy2_kernel(const uint8_t* src, int src_pitch, uint8_t* dst, int width,
+                            int height, int channels) {
+  const int x = 2 * (blockIdx.x * blockDim.x + threadIdx.x);
+  const int row = blockIdx.y * blockDim.y + threadIdx.y;
+  if (x >= width || row >= height) { return; }
+
+  // Y0 U Y1 V
+  const uchar4 p = *reinterpret_cast<const uchar4*>(src + row * src_pitch + 2 * x);
+  uint8_t* out = dst + (static_cast<size_t>(row) * width + x) * channels;
+  store_yuv(out, channels, p.x, p.y, p.w);
+  store_yuv(out + channels, channels, p.z, p.y, p.w);
+}
+
+__global__ void nv12_kernel(const uint8_t* y_plane, int y_pitch, const uint8_t* uv_plane,
+                            int uv_pitch, uint8_t* dst, int width, int height, int channels) {
+  const int x = 2 * (blockIdx.x * blockDim.x + threadIdx.x);
+  const int row = blockIdx.y * blockDim.y + threadIdx.y;
+  if (x >= width || row >= height) { return; }
+
+  const uchar2 luma = *reinterpret_cast<const uchar2*>(y_plane + row * y_pitch + x);
+  const uchar2 chroma = *reinterpret_cast<const uchar2*>(uv_plane + (row / 2) * uv_pitch + x);
+  uint8_t* out = dst + (static_cast<size_t>(row) * width + x) * channels;
+  store_yuv(out, channels, luma.x, chroma.x, chroma.y);
+  store_yuv(out + channels, channels, luma.y, chroma.x, chroma.y);
+}
+
+// One thread per pixel; swap selects BGR input
+__global__ void packed_kernel(const uint8_t* src, int src_pitch, int src_channels, bool swap,
+                              uint8_t* dst, int width, int height, int channels) {
+  const int x = blockIdx.x * blockDim.x + threadIdx.x;
+  const int row = blockIdx.y * blockDim.y + threadIdx.y;
+  if (x >= width || row >= height) { return; }
+
+  const uint8_t* in = src + row * src_pitch + x * src_channels;
+  uint8_t* out = dst + (static_cast<size_t>(row) * width + x) * channels;
+  const uint8_t r = swap ? in[2] : in[0];
+  const uint8_t b = swap ? in[0] : in[2];
+  store_pixel(out, channels, r, in[1], b);
+  if (channels == 4 && src_channels == 4) { out[3] = in[3]; }
+}
+
+dim3 grid_for(int width, int height) {
+  return dim3((width + kBlockWidth - 1) / kBlockWidth, (height + kBlockHeight - 1) / kBlockHeight);
+}
+
+}  // namespace
+
+cudaError_t convertYUY2ToRGB(const uint8_t* src, int src_pitch, uint8_t* dst, int width,
+                             int height, int dst_channels, cudaStream_t stream) {
+  yuy2_kernel<<<grid_for(width / 2, height), dim3(kBlockWidth, kBlockHeight), 0, stream>>>(
+      src, src_pitch, dst, width, height, dst_channels);
+  return cudaGetLastError();
+}
+
+cudaError_t convertNV12ToRGB(const uint8_t* y, int y_pitch, const uint8_t* uv, int uv_pitch,
+                             uint8_t* dst, int width, int height, int dst_channels,
+                             cudaStream_t stream) {
+  nv12_kernel<<<grid_for(width / 2, height), dim3(kBlockWidth, kBlockHeight), 0, stream>>>(
+      y, y_pitch, uv, uv_pitch, dst, width, height, dst_channels);
+  return cudaGetLastError();
+}
+
+cudaError_t convertBGRToRGB(const uint8_t* src, int src_pitch, uint8_t* dst, int width,
+                            int height, int dst_channels, cudaStream_t stream) {
+  packed_kernel<<<grid_for(width, height), dim3(kBlockWidth, kBlockHeight), 0, stream>>>(
+      src, src_pitch, 3, true, dst, width, height, dst_channels);
+  return cudaGetLastError();
+}
+
+cudaError_t convertImageToRGB(const uint8_t* src, int src_channels, uint8_t* dst, int width,
+                              int height, int dst_channels, cudaStream_t stream) {
+  packed_kernel<<<grid_for(width, height), dim3(kBlockWidth, kBlockHeight), 0, stream>>>(
+      src, width * src_channels, src_channels, false, dst, width, height, dst_channels);
+  return cudaGetLastError();
+}
+
+}  // namespace holoscan
+}  // namespace nvidia
@@ -0,0 +1,49 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef NVIDIA_HOLOSCAN_GXF_EXTENSIONS_QCAP_COLOR_CONVERT_HPP_
+#define NVIDIA_HOLOSCAN_GXF_EXTENSIONS_QCAP_COLOR_CONVERT_HPP_
+
+#include <cstdint>
+
+#include <cuda_runtime.h>
+
+namespace nvidia {
+namespace holoscan {
+
+// Color conversions of captured frames to packed RGB (dst_channels 3) or RGBA (dst_channels 4,
+// opaque alpha). Source and destination are device pointers, dst is tightly packed and the
+// width is even. YUV is BT.601 video range, as the NPP conversions used before. The kernels
+// are launched on stream; the launch error, if any, is returned.
+
+cudaError_t convertYUY2ToRGB(const uint8_t* src, int src_pitch, uint8_t* dst, int width,
+                             int height, int dst_channels, cudaStream_t stream);
+
+cudaError_t convertNV12ToRGB(const uint8_t* y, int y_pitch, const uint8_t* uv, int uv_pitch,
+                             uint8_t* dst, int width, int height, int dst_channels,
+                             cudaStream_t stream);
+
+cudaError_t convertBGRToRGB(const uint8_t* src, int src_pitch, uint8_t* dst, int width,
+                            int height, int dst_channels, cudaStream_t stream);
+
+// Packed RGB or RGBA (src_channels) image, e.g. a decoded placeholder, to the output format
+cudaError_t convertImageToRGB(const uint8_t* src, int src_channels, uint8_t* dst, int width,
+                              int height, int dst_channels, cudaStream_t stream);
+
+}  // namespace holoscan
+}  // namespace nvidia
+
+#endif  // NVIDIA_HOLOSCAN_GXF_EXTENSIONS_QCAP_COLOR_CONVERT_HPP_
@@ -22,13 +22,14 @@
 
 #include <cuda.h>
 #include <cuda_runtime.h>
-#include <npp.h>
 
 #include <sstream>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include "gxf/multimedia/video.hpp"
+#include "qcap_color_convert.hpp"
 
 #define STB_IMAGE_IMPLEMENTATION
 #include <stb_image.h>
@@ -48,6 +49,21 @@ EXPAND_FILE(no_sdk_png)
 namespace nvidia {
 namespace holoscan {
 
+namespace {
+
+template <gxf::VideoFormat F>
+gxf::VideoBufferInfo videoBufferInfo(uint32_t width, uint32_t height) {
+  gxf::VideoTypeTraits<F> video_type;
+  gxf::VideoFormatSize<F> color_format;
+  return gxf::VideoBufferInfo{width,
+                              height,
+                              video_type.value,
+                              color_format.getDefaultColorPlanes(width, height),
+                              gxf::SurfaceLayout::GXF_SURFACE_LAYOUT_PITCH_LINEAR};
+}
+
+}  // namespace
+
 QRETURN on_process_signal_removed(PVOID pDevice, ULONG nVideoInput, ULONG nAudioInput,
                                   PVOID pUserData) {
   struct QCAPSource* qcap = (struct QCAPSource*)pUserData;
@@ -180,6 +196,12 @@ gxf_result_t QCAPSource::registerInterface(gxf::Registrar* registrar) {
                                  "Pixel Format.",
                                  std::string(kDefaultPixelFormatStr));
 
+  result &= registrar->parameter(output_pixel_format_str_,
+                                 "output_pixel_format",
+                                 "OutputPixelFormat",
+                                 "Output Pixel Format, rgb24 or rgba32.",
+                                 std::string(kDefaultOutputPixelFormatStr));
+
   result &= registrar->parameter(
       input_type_str_, "input_type", "InputType", "Input Type.", std::string(kDefaultInputTypeStr));
 
@@ -192,6 +214,8 @@ gxf_result_t QCAPSource::registerInterface(gxf::Registrar* registrar) {
   result &= registrar->parameter(
       sdi12g_mode_, "sdi12g_mode", "SDI12GMode", "SDI 12G Mode.", kDefaultSDI12GMode);
 
+  result &= cuda_stream_handler_.registerInterface(registrar);
+
   m_status = STATUS_NO_DEVICE;
 
   return gxf::ToResultCode(result);
@@ -231,42 +255,49 @@ void QCAPSource::loadImage(const char* filename, const unsigned char* buffer, co
                image->height,
                image->components);
 
-  // memset(image->data, 128, image->width * image->height * image->components);
-
-  if (image->components == 4) {
-    int width = image->width;
-    int height = image->height;
-
-    if (cuMemAlloc(&image->cu_src, width * height * 4) != CUDA_SUCCESS) {
-      throw std::runtime_error("cuMemAlloc failed.");
-    }
-    if (cuMemAlloc(&image->cu_dst, width * height * 3) != CUDA_SUCCESS) {
-      throw std::runtime_error("cuMemAlloc failed.");
-    }
-    if (cuMemcpyHtoD(image->cu_src, image->data, width * height * 4) != CUDA_SUCCESS) {
-      throw std::runtime_error("cuMemcpyHtoD failed.");
-    }
+  if (image->components != 3 && image->components != 4) {
+    GXF_LOG_INFO("QCAP Source: image %s has %d components, expected 3 or 4",
+                 filename,
+                 image->components);
+    stbi_image_free(image->data);
+    image->data = nullptr;
+    return;
+  }
 
-    if (output_pixel_format_ == PIXELFORMAT_RGB24) {  // RGBA to RGB
-      NppStatus status;
-      NppiSize oSizeROI;
-      int video_width = width;
-      int video_height = height;
-      oSizeROI.width = video_width;
-      oSizeROI.height = video_height;
-      const int aDstOrder[3] = {0, 1, 2};
-      status = nppiSwapChannels_8u_C4C3R((Npp8u*)image->cu_src,
-                                         video_width * 4,
-                                         (Npp8u*)image->cu_dst,
-                                         video_width * 3,
-                                         oSizeROI,
-                                         aDstOrder);
-      if (status != 0) {
-        GXF_LOG_INFO(
-            "QCAP Source: image convert error %d %dx%d", status, video_width, video_height);
-      }
-    }
+  // Converted to the output format once, so that ticks without signal only wrap cu_dst
+  int width = image->width;
+  int height = image->height;
+  int out_channels = (output_pixel_format_ == PIXELFORMAT_RGB24 ? 3 : 4);
+  if (cuMemAlloc(&image->cu_src, width * height * image->components) != CUDA_SUCCESS) {
+    throw std::runtime_error("cuMemAlloc failed.");
+  }
+  if (cuMemAlloc(&image->cu_dst, width * height * out_channels) != CUDA_SUCCESS) {
+    throw std::runtime_error("cuMemAlloc failed.");
+  }
+  if (cuMemcpyHtoD(image->cu_src, image->data, width * height * image->components) !=
+      CUDA_SUCCESS) {
+    throw std::runtime_error("cuMemcpyHtoD failed.");
   }
+  cudaError_t status = convertImageToRGB(reinterpret_cast<const uint8_t*>(image->cu_src),
+                                         image->components,
+                                         reinterpret_cast<uint8_t*>(image->cu_dst),
+                                         width,
+                                         height,
+                                         out_channels,
+                                         cudaStreamDefault);
+  if (status == cudaSuccess) { status = cudaStreamSynchronize(cudaStreamDefault); }
+  if (status != cudaSuccess) {
+    GXF_LOG_INFO("QCAP Source: image convert error %s %dx%d",
+                 cudaGetErrorString(status),
+                 width,
+                 height);
+  }
+
+  // Only the converted image is kept
+  if (cuMemFree(image->cu_src) != CUDA_SUCCESS) { throw std::runtime_error("cuMemFree failed."); }
+  image->cu_src = 0;
+  stbi_image_free(image->data);
+  image->data = nullptr;
 }
 
 void QCAPSource::destroyImage(struct Image* image) {
@@ -304,6 +335,8 @@ void QCAPSource::cleanupCuda() {
 }
 
 gxf_result_t QCAPSource::start() {
+  cuda_stream_handler_.setProfilingName(name());
+
   if (pixel_format_str_.get().compare("yuy2") == 0) {
     pixel_format_ = PIXELFORMAT_YUY2;
   } else if (pixel_format_str_.get().compare("nv12") == 0) {
@@ -312,6 +345,12 @@ gxf_result_t QCAPSource::start() {
     pixel_format_ = PIXELFORMAT_BGR24;
   }
 
+  if (output_pixel_format_str_.get().compare("rgba32") == 0) {
+    output_pixel_format_ = PIXELFORMAT_ARGB32;  // R G B A in memory
+  } else {
+    output_pixel_format_ = PIXELFORMAT_RGB24;
+  }
+
   if (input_type_str_.get().compare("dvi_d") == 0) {
     input_type_ = INPUTTYPE_DVI_D;
   } else if (input_type_str_.get().compare("dp") == 0) {
@@ -329,6 +368,9 @@ gxf_result_t QCAPSource::start() {
   GXF_LOG_INFO("QCAP Source: Resolution %dx%d", width_.get(), height_.get());
   GXF_LOG_INFO(
       "QCAP Source: Pixel format is %s (%d)", pixel_format_str_.get().c_str(), pixel_format_);
+  GXF_LOG_INFO("QCAP Source: Output pixel format is %s (%d)",
+               output_pixel_format_str_.get().c_str(),
+               output_pixel_format_);
   GXF_LOG_INFO("QCAP Source: Input type is %s (%d)", input_type_str_.get().c_str(), input_type_);
 
   initCuda();
@@ -345,6 +387,8 @@ gxf_result_t QCAPSource::start() {
 
   for (int i = 0; i < kDefaultColorConvertBufferSize; i++) {
     cudaMalloc((void**)&m_pRGBBUffer[i], kDefaultPreviewSize);
+    if (!use_rdma_) { cudaMalloc((void**)&m_pYUVBuffer[i], kDefaultPreviewSize); }
+    cudaEventCreateWithFlags(&m_convertEvent[i], cudaEventDisableTiming);
   }
 
   QCAP_CREATE((char*)device_specifier_.get().c_str(), 0, nullptr, &m_hDevice, TRUE);
@@ -422,21 +466,39 @@ gxf_result_t QCAPSource::stop() {
 
     m_queue.quit();
 
+    for (int i = 0; i < kDefaultColorConvertBufferSize; i++) {
+      releaseConvertBuffer(i);
+      cudaEventDestroy(m_convertEvent[i]);
+      m_convertEvent[i] = nullptr;
+    }
+
     if (use_rdma_) {
       for (int i = 0; i < kDefaultGPUDirectRingQueueSize; i++) {
         QCAP_UNBIND_VIDEO_GPUDIRECT_PREVIEW_BUFFER(
             m_hDevice, i, m_pGPUDirectBuffer[i], kDefaultPreviewSize);
         // QCAP_FREE_VIDEO_GPUDIRECT_PREVIEW_BUFFER(m_hDevice, m_pGPUDirectBuffer[i],
         // kDefaultPreviewSize);
-        cudaFree((void**)&m_pGPUDirectBuffer[i]);
+        cudaFree(m_pGPUDirectBuffer[i]);
+        m_pGPUDirectBuffer[i] = nullptr;
       }
     }
 
-    for (int i = 0; i < kDefaultColorConvertBufferSize; i++) { cudaFree((void**)&m_pRGBBUffer[i]); }
+    for (int i = 0; i < kDefaultColorConvertBufferSize; i++) {
+      cudaFree(m_pRGBBUffer[i]);
+      m_pRGBBUffer[i] = nullptr;
+      cudaFree(m_pYUVBuffer[i]);
+      m_pYUVBuffer[i] = nullptr;
+    }
+
+    for (auto& [plane, size] : m_registeredPlanes) {
+      if (size != 0) { cudaHostUnregister(plane); }
+    }
+    m_registeredPlanes.clear();
 
     destroyImage(&m_iNoDeviceImage);
     destroyImage(&m_iNoSignalImage);
     destroyImage(&m_iSignalRemovedImage);
+    destroyImage(&m_iNoSdkImage);
 
     cleanupCuda();
 
@@ -446,6 +508,39 @@ gxf_result_t QCAPSource::stop() {
   return GXF_SUCCESS;
 }
 
+void QCAPSource::releaseConvertBuffer(unsigned long index) {
+  if (m_convertEvent[index]) { cudaEventSynchronize(m_convertEvent[index]); }
+  if (m_pPendingRCBuffer[index]) {
+    QCAP_RCBUFFER_UNLOCK_DATA(m_pPendingRCBuffer[index]);
+    QCAP_RCBUFFER_RELEASE(m_pPendingRCBuffer[index]);
+    m_pPendingRCBuffer[index] = nullptr;
+  }
+}
+
+const unsigned char* QCAPSource::uploadPlane(const unsigned char* plane, size_t size,
+                                             unsigned char* dst, cudaStream_t stream) {
+  // QCAP reuses a few preview buffers, each is pinned the first time it is seen so that the
+  // upload is an asynchronous DMA. Should pinning fail, the copy is staged by the driver.
+  void* key = const_cast<unsigned char*>(plane);
+  auto it = m_registeredPlanes.find(key);
+  if (it != m_registeredPlanes.end() && it->second != 0 && it->second < size) {
+    cudaHostUnregister(key);
+    m_registeredPlanes.erase(it);
+    it = m_registeredPlanes.end();
+  }
+  if (it == m_registeredPlanes.end()) {
+    if (cudaHostRegister(key, size, cudaHostRegisterDefault) == cudaSuccess) {
+      m_registeredPlanes[key] = size;
+    } else {
+      cudaGetLastError();
+      GXF_LOG_WARNING("QCAP Source: failed to pin capture buffer %p, uploading pageable", plane);
+      m_registeredPlanes[key] = 0;
+    }
+  }
+  cudaMemcpyAsync(dst, plane, size, cudaMemcpyHostToDevice, stream);
+  return dst;
+}
+
 gxf_result_t QCAPSource::tick() {
   PreviewFrame preview;
 
@@ -462,8 +557,11 @@ gxf_result_t QCAPSource::tick() {
     return GXF_FAILURE;
   }
 
+  const bool output_rgb = (output_pixel_format_ == PIXELFORMAT_RGB24);
+  const int out_channels = output_rgb ? 3 : 4;
+
   // GXF_LOG_ERROR("QCAP Source: status %d in tick", m_status);
-  // Show error image
+  // Show error image, converted to the output format in start()
   if (m_status != STATUS_SIGNAL_LOCKED) {
     struct Image* image = nullptr;
     switch (m_status) {
@@ -480,23 +578,18 @@ gxf_result_t QCAPSource::tick() {
         image = &m_iNoSignalImage;
         break;
     }
-    int out_width = image->width;
-    int out_height = image->height;
-    int out_size = out_width * out_height * (output_pixel_format_ == PIXELFORMAT_RGB24 ? 3 : 4);
+    if (image == nullptr || image->cu_dst == 0) { return GXF_SUCCESS; }
+    uint32_t out_width = image->width;
+    uint32_t out_height = image->height;
+    int out_size = out_width * out_height * out_channels;
 
     // GXF_LOG_ERROR("QCAP Source: show %d image %dx%d", m_status, out_width, out_height);
-    gxf::VideoTypeTraits<gxf::VideoFormat::GXF_VIDEO_FORMAT_RGB> video_type;
-    gxf::VideoFormatSize<gxf::VideoFormat::GXF_VIDEO_FORMAT_RGB> color_format;
-    auto color_planes = color_format.getDefaultColorPlanes(out_width, out_height);
-    gxf::VideoBufferInfo info{(uint32_t)out_width,
-                              (uint32_t)out_height,
-                              video_type.value,
-                              color_planes,
-                              gxf::SurfaceLayout::GXF_SURFACE_LAYOUT_PITCH_LINEAR};
+    auto info = output_rgb
+                    ? videoBufferInfo<gxf::VideoFormat::GXF_VIDEO_FORMAT_RGB>(out_width, out_height)
+                    : videoBufferInfo<gxf::VideoFormat::GXF_VIDEO_FORMAT_RGBA>(out_width,
+                                                                                out_height);
     auto storage_type = gxf::MemoryStorageType::kDevice;
-    // auto storage_type = gxf::MemoryStorageType::kHost;
     buffer.value()->wrapMemory(info, out_size, storage_type, (void*)image->cu_dst, nullptr);
-    // buffer.value()->wrapMemory(info, out_size, storage_type, (void*) image->data, nullptr);
     const auto result = video_buffer_output_->publish(std::move(message.value()));
     return gxf::ToResultCode(message);
   }
@@ -511,16 +604,28 @@ gxf_result_t QCAPSource::tick() {
   PVOID pRCBuffer = QCAP_BUFFER_GET_RCBUFFER(preview.pFrameBuffer, preview.nFrameBufferLen);
   qcap_av_frame_t* pAVFrame = (qcap_av_frame_t*)QCAP_RCBUFFER_LOCK_DATA(pRCBuffer);
 
-  PVOID frame = pAVFrame->pData[0];
-  NppStatus status;
-  NppiSize oSizeROI;
   int video_width = m_nVideoWidth;
   int video_height = m_nVideoHeight;
-  oSizeROI.width = video_width;
-  oSizeROI.height = video_height;
+  if (static_cast<size_t>(video_width) * video_height * 4 > kDefaultPreviewSize) {
+    GXF_LOG_ERROR("QCAP Source: %dx%d exceeds the conversion buffers", video_width, video_height);
+    QCAP_RCBUFFER_UNLOCK_DATA(pRCBuffer);
+    QCAP_RCBUFFER_RELEASE(pRCBuffer);
+    return GXF_FAILURE;
+  }
+
+  // The conversion into this buffer three frames ago must be done before it is reused, and
+  // the capture buffer it read is handed back to QCAP then
   m_nRGBBufferIndex = (m_nRGBBufferIndex + 1) % kDefaultColorConvertBufferSize;
-  frame = m_pRGBBUffer[m_nRGBBufferIndex];
-  auto storage_type = use_rdma_ ? gxf::MemoryStorageType::kDevice : gxf::MemoryStorageType::kHost;
+  releaseConvertBuffer(m_nRGBBufferIndex);
+  unsigned char* frame = m_pRGBBUffer[m_nRGBBufferIndex];
+  // The colour conversion of the frame is queued on this stream, which the output carries
+  if (cuda_stream_handler_.fromMessages(context(), std::vector<gxf::Entity>()) != GXF_SUCCESS) {
+    GXF_LOG_ERROR("QCAP Source: Failed to allocate the CUDA stream.");
+    QCAP_RCBUFFER_UNLOCK_DATA(pRCBuffer);
+    QCAP_RCBUFFER_RELEASE(pRCBuffer);
+    return GXF_FAILURE;
+  }
+  cudaStream_t stream = cuda_stream_handler_.getCudaStream();
 
 #if 0  // for debug
   struct cudaPointerAttributes attributes;
@@ -530,33 +635,49 @@ gxf_result_t QCAPSource::tick() {
   GXF_LOG_INFO("video preview cb frame: %p type: %d\n", pAVFrame->pData[0], attributes.type);
 #endif
 
-  storage_type = gxf::MemoryStorageType::kDevice;
-  if (pixel_format_ == PIXELFORMAT_YUY2 &&
-      output_pixel_format_ == PIXELFORMAT_RGB24) {  // YUY2 to RGB
-    status = nppiYCbCr422ToRGB_8u_C2C3R(
-        pAVFrame->pData[0], video_width * 2, (Npp8u*)frame, video_width * 3, oSizeROI);
-  } else if (pixel_format_ == PIXELFORMAT_BGR24 &&
-             output_pixel_format_ == PIXELFORMAT_RGB24) {  // Default is BGR. BGR to RGB
-    const int aDstOrder[3] = {2, 1, 0};
-    status = nppiSwapChannels_8u_C3R(
-        pAVFrame->pData[0], video_width * 3, (Npp8u*)frame, video_width * 3, oSizeROI, aDstOrder);
-  } else if (pixel_format_ == PIXELFORMAT_NV12 &&
-             output_pixel_format_ == PIXELFORMAT_RGB24) {  // NV12 to RGB
-    const int aDstOrder[3] = {2, 1, 0};
-    Npp8u* input[2];
-    input[0] = (Npp8u*)pAVFrame->pData[0];
-    input[1] = (Npp8u*)pAVFrame->pData[1];
-    status = nppiNV12ToRGB_8u_P2C3R(input, video_width, (Npp8u*)frame, video_width * 3, oSizeROI);
+  // With GPUDirect the planes already are in device memory
+  const unsigned char* plane0 = pAVFrame->pData[0];
+  const unsigned char* plane1 = pAVFrame->pData[1];
+  unsigned char* staging = m_pYUVBuffer[m_nRGBBufferIndex];
+  cudaError_t status;
+  if (pixel_format_ == PIXELFORMAT_YUY2) {  // YUY2 to RGB
+    if (!use_rdma_) {
+      plane0 = uploadPlane(plane0, video_width * video_height * 2, staging, stream);
+    }
+    status = convertYUY2ToRGB(
+        plane0, video_width * 2, frame, video_width, video_height, out_channels, stream);
+  } else if (pixel_format_ == PIXELFORMAT_BGR24) {  // Default is BGR. BGR to RGB
+    if (!use_rdma_) {
+      plane0 = uploadPlane(plane0, video_width * video_height * 3, staging, stream);
+    }
+    status = convertBGRToRGB(
+        plane0, video_width * 3, frame, video_width, video_height, out_channels, stream);
+  } else if (pixel_format_ == PIXELFORMAT_NV12) {  // NV12 to RGB
+    if (!use_rdma_) {
+      plane0 = uploadPlane(plane0, video_width * video_height, staging, stream);
+      plane1 = uploadPlane(
+          plane1, video_width * video_height / 2, staging + video_width * video_height, stream);
+    }
+    status = convertNV12ToRGB(plane0,
+                              video_width,
+                              plane1,
+                              video_width,
+                              frame,
+                              video_width,
+                              video_height,
+                              out_channels,
+                              stream);
   } else {
-    status = NPP_ERROR;
+    status = cudaErrorInvalidValue;
   }
 
-  QCAP_RCBUFFER_UNLOCK_DATA(pRCBuffer);
-  QCAP_RCBUFFER_RELEASE(pRCBuffer);
+  // QCAP gets the capture buffer back once the conversion is done
+  cudaEventRecord(m_convertEvent[m_nRGBBufferIndex], stream);
+  m_pPendingRCBuffer[m_nRGBBufferIndex] = pRCBuffer;
 
-  if (status != 0) {
-    GXF_LOG_INFO("QCAP Source: convert error %d buffer %p(%08x) to %p(%08x) %dx%d\n",
-                 status,
+  if (status != cudaSuccess) {
+    GXF_LOG_INFO("QCAP Source: convert error %s buffer %p(%08x) to %p(%08x) %dx%d\n",
+                 cudaGetErrorString(status),
                  pAVFrame->pData[0],
                  pixel_format_,
                  frame,
@@ -566,18 +687,19 @@ gxf_result_t QCAPSource::tick() {
     return GXF_FAILURE;
   }
 
-  int out_width = m_nVideoWidth;
-  int out_height = m_nVideoHeight;
-  int out_size = out_width * out_height * 3;
+  if (cuda_stream_handler_.toMessage(message) != GXF_SUCCESS) {
+    GXF_LOG_ERROR("QCAP Source: Failed to add the CUDA stream to the output message.");
+    return GXF_FAILURE;
+  }
+
+  uint32_t out_width = m_nVideoWidth;
+  uint32_t out_height = m_nVideoHeight;
+  int out_size = out_width * out_height * out_channels;
 
-  gxf::VideoTypeTraits<gxf::VideoFormat::GXF_VIDEO_FORMAT_RGB> video_type;
-  gxf::VideoFormatSize<gxf::VideoFormat::GXF_VIDEO_FORMAT_RGB> color_format;
-  auto color_planes = color_format.getDefaultColorPlanes(out_width, out_height);
-  gxf::VideoBufferInfo info{(uint32_t)out_width,
-                            (uint32_t)out_height,
-                            video_type.value,
-                            color_planes,
-                            gxf::SurfaceLayout::GXF_SURFACE_LAYOUT_PITCH_LINEAR};
+  auto info = output_rgb
+                  ? videoBufferInfo<gxf::VideoFormat::GXF_VIDEO_FORMAT_RGB>(out_width, out_height)
+                  : videoBufferInfo<gxf::VideoFormat::GXF_VIDEO_FORMAT_RGBA>(out_width, out_height);
+  auto storage_type = gxf::MemoryStorageType::kDevice;
   buffer.value()->wrapMemory(info, out_size, storage_type, frame, nullptr);
   const auto result = video_buffer_output_->publish(std::move(message.value()));
 
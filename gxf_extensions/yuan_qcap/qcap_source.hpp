@@ -18,6 +18,7 @@
 #define NVIDIA_HOLOSCAN_GXF_EXTENSIONS_QCAP_SOURCE_HPP_
 
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 #include <cuda.h>
@@ -25,6 +26,7 @@
 
 #include "qcap_queue.hpp"
 
+#include "../utils/cuda_stream_handler.hpp"
 #include "gxf/std/codelet.hpp"
 #include "gxf/std/transmitter.hpp"
 
@@ -95,6 +97,7 @@ constexpr char kDefaultPixelFormatStr[] = "bgr24";
 constexpr uint32_t kDefaultPixelFormat = PIXELFORMAT_BGR24;
 // constexpr uint32_t kDefaultPixelFormat = PIXELFORMAT_YUY2;
 // constexpr uint32_t kDefaultPixelFormat = PIXELFORMAT_NV12;
+constexpr char kDefaultOutputPixelFormatStr[] = "rgb24";
 constexpr uint32_t kDefaultOutputPixelFormat = PIXELFORMAT_RGB24;
 constexpr uint32_t kDefaultDisplayPortMstMode = DISPLAYPORT_SST_MODE;
 constexpr char kDefaultInputTypeStr[] = "auto";
@@ -127,7 +130,12 @@ enum DeviceStatus {
 ///
 /// Provides a codelet for supporting capture card as a source.
 /// It offers support for GPUDirect-RDMA on Quadro GPUs.
-/// The output is a VideoBuffer object.
+/// The output is a VideoBuffer object in device memory, RGB or RGBA.
+///
+/// Captured frames are converted on the GPU, on the stream of the optional cuda_stream_pool,
+/// which is added to the output message. With RDMA they are read where the card wrote them,
+/// otherwise they are uploaded from pinned host memory first. The capture buffer is handed
+/// back to QCAP once its conversion is done.
 class QCAPSource : public gxf::Codelet {
  public:
   QCAPSource();
@@ -154,11 +162,13 @@ class QCAPSource : public gxf::Codelet {
   gxf::Parameter<bool> use_rdma_;
   gxf::Parameter<std::string> pixel_format_str_;
   uint32_t pixel_format_;
+  gxf::Parameter<std::string> output_pixel_format_str_;
   uint32_t output_pixel_format_;
   gxf::Parameter<uint32_t> mst_mode_;
   gxf::Parameter<std::string> input_type_str_;
   uint32_t input_type_;
   gxf::Parameter<uint32_t> sdi12g_mode_;
+  CudaStreamHandler cuda_stream_handler_;
 
   volatile DeviceStatus m_status = STATUS_NO_SDK;
   void* m_hDevice = nullptr;
@@ -176,6 +186,19 @@ class QCAPSource : public gxf::Codelet {
   unsigned char* m_pRGBBUffer[kDefaultColorConvertBufferSize] = {};
   unsigned long m_nRGBBufferIndex = 0;
 
+  // Per color convert buffer: without RDMA the device copy of the captured planes, the end of
+  // the last conversion into the buffer and the capture buffer it read, released after it.
+  unsigned char* m_pYUVBuffer[kDefaultColorConvertBufferSize] = {};
+  cudaEvent_t m_convertEvent[kDefaultColorConvertBufferSize] = {};
+  void* m_pPendingRCBuffer[kDefaultColorConvertBufferSize] = {};
+
+  // Without RDMA: host capture planes registered with CUDA (size 0: registration failed)
+  std::unordered_map<void*, size_t> m_registeredPlanes;
+
+  void releaseConvertBuffer(unsigned long index);
+  const unsigned char* uploadPlane(const unsigned char* plane, size_t size, unsigned char* dst,
+                                   cudaStream_t stream);
+
   CUcontext m_CudaContext = nullptr;
 
   struct Image m_iNoDeviceImage;
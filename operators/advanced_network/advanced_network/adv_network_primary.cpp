@@ -0,0 +1,59 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <signal.h>
+#include <yaml-cpp/yaml.h>
+#include "advanced_network/common.h"
+
+// Standalone DPDK primary process. It owns the NIC, the packet pools and the flow rules of an
+// advanced_network config, and serves the rings that applications configured with
+// `multi_process: {type: secondary}` attach to.
+int main(int argc, char** argv) {
+  using namespace holoscan::advanced_network;
+
+  if (argc != 2) {
+    HOLOSCAN_LOG_ERROR("Usage: {} <config.yaml>", argv[0]);
+    return 1;
+  }
+
+  auto config = YAML::LoadFile(argv[1])["advanced_network"]["cfg"].as<NetworkConfig>();
+  if (config.multi_process_.type_ != ProcessType::PRIMARY) {
+    HOLOSCAN_LOG_ERROR("{} must set advanced_network.cfg.multi_process.type to primary", argv[1]);
+    return 1;
+  }
+
+  // Block the signals before the workers start so that only this thread receives them
+  sigset_t signals;
+  sigemptyset(&signals);
+  sigaddset(&signals, SIGINT);
+  sigaddset(&signals, SIGTERM);
+  pthread_sigmask(SIG_BLOCK, &signals, nullptr);
+
+  if (adv_net_init(config) != Status::SUCCESS) {
+    HOLOSCAN_LOG_ERROR("Failed to initialize the advanced network primary process");
+    return 1;
+  }
+
+  HOLOSCAN_LOG_INFO("Primary process running with file prefix {}, stop with Ctrl-C",
+                    config.multi_process_.file_prefix_);
+  int signal = 0;
+  sigwait(&signals, &signal);
+
+  print_stats();
+  shutdown();
+  return 0;
+}
@@ -15,12 +15,15 @@
  * limitations under the License.
  */
 
+#include <chrono>
 #include <thread>
 #include <unordered_map>
 #include <unordered_set>
 
 #include "advanced_network/manager.h"
 #include "advanced_network/common.h"
+#include "advanced_network/kernels.h"
+#include "advanced_network/metrics_server.h"
 #include "holoscan/holoscan.hpp"
 #if ANO_MGR_DPDK || ANO_MGR_GPUNETIO
 #include <rte_mbuf.h>
@@ -37,6 +40,7 @@ namespace holoscan::advanced_network {
 
 // Declare a static global variable for the manager
 static Manager* g_ano_mgr = nullptr;
+static std::unique_ptr<MetricsServer> g_metrics_server;
 
 const std::unordered_map<LogLevel::Level, std::string> LogLevel::level_to_string_map = {
     {TRACE, "trace"},
@@ -118,6 +122,150 @@ uint16_t get_segment_packet_length(BurstParams* burst, int seg, int idx) {
   return g_ano_mgr->get_segment_packet_length(burst, seg, idx);
 }
 
+Status get_packet_ptrs(BurstParams* burst, int seg, void** out) {
+  ASSERT_ANO_MGR_INITIALIZED();
+  return g_ano_mgr->get_packet_ptrs(burst, seg, out);
+}
+
+Status get_packet_lengths(BurstParams* burst, int seg, uint16_t* out) {
+  ASSERT_ANO_MGR_INITIALIZED();
+  return g_ano_mgr->get_packet_lengths(burst, seg, out);
+}
+
+Status get_burst_frame_info(BurstParams* burst, BurstFrameInfo* info) {
+  ASSERT_ANO_MGR_INITIALIZED();
+  return g_ano_mgr->get_burst_frame_info(burst, info);
+}
+
+Status set_flow_demux(int port, int queue, const std::vector<FlowDemuxConfig>& flows) {
+  ASSERT_ANO_MGR_INITIALIZED();
+  return g_ano_mgr->set_flow_demux(port, queue, flows);
+}
+
+Status demux_rx_burst(BurstParams* burst, cudaStream_t stream) {
+  ASSERT_ANO_MGR_INITIALIZED();
+  return g_ano_mgr->demux_rx_burst(burst, stream);
+}
+
+Status get_flow_demux_status(int port, int queue, uint16_t flow_id, FlowDemuxStatus* status) {
+  ASSERT_ANO_MGR_INITIALIZED();
+  return g_ano_mgr->get_flow_demux_status(port, queue, flow_id, status);
+}
+
+Status reset_flow_demux(int port, int queue, uint16_t flow_id, uint64_t first_seq,
+                        cudaStream_t stream) {
+  ASSERT_ANO_MGR_INITIALIZED();
+  return g_ano_mgr->reset_flow_demux(port, queue, flow_id, first_seq, stream);
+}
+
+namespace {
+
+struct SegmentTensorContext {
+  DLManagedTensor tensor;
+  int64_t shape[2];
+  int64_t strides[2];
+};
+
+bool is_device_pointer(const void* ptr, int* device_id) {
+  cudaPointerAttributes attr;
+  if (cudaPointerGetAttributes(&attr, ptr) != cudaSuccess) {
+    cudaGetLastError();
+    return false;
+  }
+  *device_id = attr.device;
+  return attr.type == cudaMemoryTypeDevice || attr.type == cudaMemoryTypeManaged;
+}
+
+}  // namespace
+
+std::shared_ptr<holoscan::Tensor> get_segment_packets_tensor(BurstParams* burst, int seg,
+                                                             int length, void* gather_buf,
+                                                             cudaStream_t stream, bool* gathered) {
+  ASSERT_ANO_MGR_INITIALIZED();
+  if (gathered != nullptr) { *gathered = false; }
+  if (burst == nullptr || seg < 0 || seg >= burst->hdr.hdr.num_segs) {
+    HOLOSCAN_LOG_ERROR("Invalid burst or segment {} for tensor", seg);
+    return nullptr;
+  }
+
+  const int64_t num_pkts = get_num_packets(burst);
+  if (num_pkts == 0) { return nullptr; }
+
+  const auto base = reinterpret_cast<uintptr_t>(g_ano_mgr->get_segment_packet_ptr(burst, seg, 0));
+  const int64_t len =
+      length >= 0 ? length : g_ano_mgr->get_segment_packet_length(burst, seg, 0);
+  int64_t stride = len;
+  if (num_pkts > 1) {
+    stride = static_cast<int64_t>(
+        reinterpret_cast<uintptr_t>(g_ano_mgr->get_segment_packet_ptr(burst, seg, 1)) - base);
+  }
+
+  bool strided = stride >= len;
+  for (int64_t i = 2; strided && i < num_pkts; i++) {
+    strided = reinterpret_cast<uintptr_t>(g_ano_mgr->get_segment_packet_ptr(burst, seg, i)) ==
+              base + i * stride;
+  }
+
+  int device_id = 0;
+  const bool on_device = is_device_pointer(reinterpret_cast<void*>(base), &device_id);
+  void* data = reinterpret_cast<void*>(base);
+
+  if (!strided) {
+    if (gather_buf == nullptr) { return nullptr; }
+
+    std::vector<const void*> ptrs(num_pkts);
+    for (int64_t i = 0; i < num_pkts; i++) {
+      ptrs[i] = g_ano_mgr->get_segment_packet_ptr(burst, seg, i);
+    }
+
+    if (on_device) {
+      if (len > UINT16_MAX) {
+        HOLOSCAN_LOG_ERROR("Cannot gather {} bytes per packet on the GPU", len);
+        return nullptr;
+      }
+      // The pointer list is stream-ordered, so calls don't need to wait for previous gathers
+      void** d_ptrs = nullptr;
+      if (cudaMallocAsync(&d_ptrs, num_pkts * sizeof(void*), stream) != cudaSuccess) {
+        HOLOSCAN_LOG_ERROR("Failed to allocate the gather list of {} packets", num_pkts);
+        return nullptr;
+      }
+      cudaMemcpyAsync(d_ptrs, ptrs.data(), num_pkts * sizeof(void*), cudaMemcpyHostToDevice,
+                      stream);
+      simple_packet_reorder(gather_buf, d_ptrs, len, num_pkts, stream);
+      cudaFreeAsync(d_ptrs, stream);
+    } else {
+      for (int64_t i = 0; i < num_pkts; i++) {
+        memcpy(static_cast<uint8_t*>(gather_buf) + i * len, ptrs[i], len);
+      }
+    }
+
+    data = gather_buf;
+    stride = len;
+    if (gathered != nullptr) { *gathered = true; }
+  }
+
+  auto ctx = new SegmentTensorContext;
+  ctx->shape[0] = num_pkts;
+  ctx->shape[1] = len;
+  ctx->strides[0] = stride;
+  ctx->strides[1] = 1;
+
+  auto& dl = ctx->tensor.dl_tensor;
+  dl.data = data;
+  dl.device = on_device ? DLDevice{kDLCUDA, device_id} : DLDevice{kDLCPU, 0};
+  dl.ndim = 2;
+  dl.dtype = DLDataType{kDLUInt, 8, 1};
+  dl.shape = ctx->shape;
+  dl.strides = ctx->strides;
+  dl.byte_offset = 0;
+  ctx->tensor.manager_ctx = ctx;
+  ctx->tensor.deleter = [](DLManagedTensor* self) {
+    delete static_cast<SegmentTensorContext*>(self->manager_ctx);
+  };
+
+  return std::make_shared<holoscan::Tensor>(&ctx->tensor);
+}
+
 void free_all_segment_packets(BurstParams* burst, int seg) {
   ASSERT_ANO_MGR_INITIALIZED();
   g_ano_mgr->free_all_segment_packets(burst, seg);
@@ -167,6 +315,28 @@ Status get_mac_addr(int port, char* mac) {
   return g_ano_mgr->get_mac_addr(port, mac);
 }
 
+Status get_ptp_time(int port, uint64_t* time) {
+  ASSERT_ANO_MGR_INITIALIZED();
+  return g_ano_mgr->get_ptp_time(port, time);
+}
+
+Status register_tx_buffer(int port, void* addr, size_t len) {
+  ASSERT_ANO_MGR_INITIALIZED();
+  return g_ano_mgr->register_tx_buffer(port, addr, len);
+}
+
+Status unregister_tx_buffer(int port, void* addr) {
+  ASSERT_ANO_MGR_INITIALIZED();
+  return g_ano_mgr->unregister_tx_buffer(port, addr);
+}
+
+Status get_tx_ext_buffer_burst(BurstParams* burst, const void* hdr, int hdr_len,
+                               void* const* bufs, const uint16_t* lens,
+                               TxBufferFreeCallback free_cb, void* cb_arg) {
+  ASSERT_ANO_MGR_INITIALIZED();
+  return g_ano_mgr->get_tx_ext_buffer_burst(burst, hdr, hdr_len, bufs, lens, free_cb, cb_arg);
+}
+
 bool is_tx_burst_available(BurstParams* burst) {
   ASSERT_ANO_MGR_INITIALIZED();
   return g_ano_mgr->is_tx_burst_available(burst);
@@ -205,6 +375,12 @@ Status set_udp_payload(BurstParams* burst, int idx, void* data, int len) {
   return g_ano_mgr->set_udp_payload(burst, idx, data, len);
 }
 
+Status get_tx_large_send_burst(BurstParams* burst, const void* hdr, int hdr_len, const void* data,
+                               int len, int seg_size) {
+  ASSERT_ANO_MGR_INITIALIZED();
+  return g_ano_mgr->get_tx_large_send_burst(burst, hdr, hdr_len, data, len, seg_size);
+}
+
 Status set_packet_lengths(BurstParams* burst, int idx, const std::initializer_list<int>& lens) {
   ASSERT_ANO_MGR_INITIALIZED();
   return g_ano_mgr->set_packet_lengths(burst, idx, lens);
@@ -252,6 +428,11 @@ void free_rx_burst(BurstParams* burst) {
   g_ano_mgr->free_rx_burst(burst);
 }
 
+void free_rx_bursts(BurstParams** bursts, int num_bursts) {
+  ASSERT_ANO_MGR_INITIALIZED();
+  g_ano_mgr->free_rx_bursts(bursts, num_bursts);
+}
+
 void free_rx_metadata(BurstParams* burst) {
   ASSERT_ANO_MGR_INITIALIZED();
   g_ano_mgr->free_rx_metadata(burst);
@@ -269,6 +450,11 @@ void* get_packet_ptr(BurstParams* burst, int idx) {
 
 void shutdown() {
   ASSERT_ANO_MGR_INITIALIZED();
+  if (g_metrics_server) {
+    g_metrics_server->stop();
+    g_metrics_server.reset();
+  }
+  g_ano_mgr->stop_ptp_clocks();
   g_ano_mgr->shutdown();
 }
 
@@ -292,6 +478,45 @@ Status get_rx_burst(BurstParams** burst) {
   return g_ano_mgr->get_rx_burst(burst);
 }
 
+int get_rx_bursts(BurstParams** bursts, int max_bursts, int port, int q) {
+  ASSERT_ANO_MGR_INITIALIZED();
+  return g_ano_mgr->get_rx_bursts(bursts, max_bursts, port, q);
+}
+
+int get_rx_burst_count(int port, int q) {
+  ASSERT_ANO_MGR_INITIALIZED();
+  return g_ano_mgr->get_rx_burst_count(port, q);
+}
+
+Status set_rx_ready_callback(int port, int q, std::function<void()> cb) {
+  ASSERT_ANO_MGR_INITIALIZED();
+  return g_ano_mgr->set_rx_ready_callback(port, q, std::move(cb));
+}
+
+std::vector<QueueLatencyStats> get_queue_latency_stats() {
+  ASSERT_ANO_MGR_INITIALIZED();
+  return g_ano_mgr->get_queue_latency_stats();
+}
+
+Status get_stats(ManagerStats& stats) {
+  ASSERT_ANO_MGR_INITIALIZED();
+  stats = ManagerStats{};
+  stats.timestamp_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                           std::chrono::system_clock::now().time_since_epoch())
+                           .count();
+  return g_ano_mgr->get_stats(stats);
+}
+
+Status add_flow(int port, const FlowConfig& flow) {
+  ASSERT_ANO_MGR_INITIALIZED();
+  return g_ano_mgr->add_flow(port, flow);
+}
+
+Status remove_flow(int port, uint16_t flow_id) {
+  ASSERT_ANO_MGR_INITIALIZED();
+  return g_ano_mgr->remove_flow(port, flow_id);
+}
+
 uint16_t get_num_rx_queues(int port_id) {
   ASSERT_ANO_MGR_INITIALIZED();
   return g_ano_mgr->get_num_rx_queues(port_id);
@@ -303,10 +528,23 @@ void print_stats() {
 }
 
 Status adv_net_init(NetworkConfig &config) {
+  const auto manager_type = config.common_.manager_type == ManagerType::DEFAULT
+                                ? ManagerFactory::get_default_manager_type()
+                                : config.common_.manager_type;
+  if (config.multi_process_.type_ != ProcessType::STANDALONE &&
+      manager_type != ManagerType::DPDK) {
+    HOLOSCAN_LOG_ERROR("multi_process is only supported by the DPDK manager");
+    return Status::NOT_SUPPORTED;
+  }
+
   ManagerFactory::set_manager_type(config.common_.manager_type);
 
   auto mgr = &(ManagerFactory::get_active_manager());
 
+  if (Manager::resolve_auto_affinity(config) != Status::SUCCESS) {
+    return Status::INVALID_PARAMETER;
+  }
+
   if (!mgr->set_config_and_initialize(config)) {
     return Status::INTERNAL_ERROR;
   }
@@ -320,6 +558,33 @@ Status adv_net_init(NetworkConfig &config) {
     }
   }
 
+  // Managers converting NIC timestamps have already started their clocks
+  if (mgr->start_ptp_clocks() != Status::SUCCESS) { return Status::INTERNAL_ERROR; }
+
+  if (config.metrics_.port_ != 0) {
+    // The server must not take time away from the workers
+    const int metrics_core = config.metrics_.cpu_core_;
+    bool worker_core = metrics_core == config.common_.master_core_;
+    for (const auto& intf : config.ifs_) {
+      for (const auto& q : intf.rx_.queues_) {
+        worker_core |= strtol(q.common_.cpu_core_.c_str(), nullptr, 10) == metrics_core;
+      }
+      for (const auto& q : intf.tx_.queues_) {
+        worker_core |= strtol(q.common_.cpu_core_.c_str(), nullptr, 10) == metrics_core;
+      }
+    }
+    if (metrics_core >= 0 && worker_core) {
+      HOLOSCAN_LOG_ERROR("Metrics server core {} is already used by a worker", metrics_core);
+      return Status::INVALID_PARAMETER;
+    }
+
+    g_metrics_server = std::make_unique<MetricsServer>(config.metrics_);
+    if (!g_metrics_server->start()) {
+      g_metrics_server.reset();
+      return Status::INTERNAL_ERROR;
+    }
+  }
+
   return Status::SUCCESS;
 }
 
@@ -376,13 +641,18 @@ bool YAML::convert<holoscan::advanced_network::NetworkConfig>::parse_memory_regi
         holoscan::advanced_network::GetMemoryKindFromString(mr["kind"].template as<std::string>());
     tmr.buf_size_ = mr["buf_size"].as<size_t>();
     tmr.num_bufs_ = mr["num_bufs"].as<size_t>();
-    tmr.affinity_ = mr["affinity"].as<uint32_t>();
+    if (mr["affinity"].as<std::string>() == "auto") {
+      tmr.affinity_ = holoscan::advanced_network::MR_AFFINITY_AUTO;
+    } else {
+      tmr.affinity_ = mr["affinity"].as<uint32_t>();
+    }
     try {
       tmr.access_ = holoscan::advanced_network::GetMemoryAccessPropertiesFromList(mr["access"]);
     } catch (const std::exception& e) {
       tmr.access_ = holoscan::advanced_network::MEM_ACCESS_LOCAL;
     }
     tmr.owned_ = mr["owned"].template as<bool>(true);
+    tmr.prefault_ = mr["prefault"].template as<bool>(false);
   } catch (const std::exception& e) {
     HOLOSCAN_LOG_ERROR("Error parsing MemoryRegionConfig: {}", e.what());
     return false;
@@ -404,6 +674,7 @@ bool parse_common_queue_config(const YAML::Node& q_item,
     common.id_ = q_item["id"].as<int>();
     common.cpu_core_ = q_item["cpu_core"].as<std::string>();
     common.batch_size_ = q_item["batch_size"].as<int>();
+    common.split_boundary_ = q_item["split_boundary"].as<int>(0);
     common.extra_queue_config_ = nullptr;
     if (q_item["memory_regions"].IsDefined()) {
       const auto& mrs = q_item["memory_regions"];
@@ -418,6 +689,11 @@ bool parse_common_queue_config(const YAML::Node& q_item,
     HOLOSCAN_LOG_ERROR("No memory regions defined for queue: {}", common.name_);
     return false;
   }
+  if (common.split_boundary_ < 0 || (common.split_boundary_ > 0 && common.mrs_.size() < 2)) {
+    HOLOSCAN_LOG_ERROR("split_boundary of queue {} needs a header and a payload memory region",
+                       common.name_);
+    return false;
+  }
   return true;
 }
 
@@ -431,6 +707,71 @@ bool parse_common_queue_config(const YAML::Node& q_item,
 bool YAML::convert<holoscan::advanced_network::NetworkConfig>::parse_rx_queue_common_config(
     const YAML::Node& q_item, holoscan::advanced_network::RxQueueConfig& q) {
   if (!parse_common_queue_config(q_item, q.common_)) { return false; }
+
+  if (q_item["overload_policy"].IsDefined()) {
+    const auto policy_str = q_item["overload_policy"].as<std::string>();
+    q.overload_policy_ = holoscan::advanced_network::GetRxOverloadPolicyFromString(policy_str);
+    if (q.overload_policy_ == holoscan::advanced_network::RxOverloadPolicy::INVALID) {
+      HOLOSCAN_LOG_ERROR("Invalid overload_policy '{}' for queue: {}", policy_str, q.common_.name_);
+      return false;
+    }
+  }
+
+  if (q_item["tap"].IsDefined()) {
+    const auto& tap = q_item["tap"];
+    q.tap_.file_ = tap["file"].as<std::string>();
+    q.tap_.cpu_core_ = tap["cpu_core"].as<std::string>();
+    q.tap_.snap_len_ = tap["snap_len"].as<uint32_t>(0);
+    q.tap_.buffer_pkts_ = tap["buffer_pkts"].as<uint32_t>(8192);
+    if (q.tap_.buffer_pkts_ == 0) {
+      HOLOSCAN_LOG_ERROR("Invalid tap buffer_pkts 0 for queue: {}", q.common_.name_);
+      return false;
+    }
+  }
+
+  if (q_item["adaptive_poll"].IsDefined()) {
+    const auto& poll = q_item["adaptive_poll"];
+    q.adaptive_poll_.enabled_ = true;
+    q.adaptive_poll_.idle_polls_ = poll["idle_polls"].as<uint32_t>(1024);
+    q.adaptive_poll_.pause_polls_ = poll["pause_polls"].as<uint32_t>(16384);
+    q.adaptive_poll_.max_sleep_ms_ = poll["max_sleep_ms"].as<uint32_t>(100);
+    if (q.adaptive_poll_.max_sleep_ms_ == 0) {
+      HOLOSCAN_LOG_ERROR("Invalid adaptive_poll max_sleep_ms 0 for queue: {}", q.common_.name_);
+      return false;
+    }
+  }
+
+  if (q_item["filter"].IsDefined()) {
+    for (const auto& rule_item : q_item["filter"]) {
+      holoscan::advanced_network::RxFilterRule rule;
+      rule.name_ = rule_item["name"].as<std::string>("rule" + std::to_string(q.filter_.size()));
+      rule.offset_ = rule_item["offset"].as<uint16_t>();
+      rule.size_ = rule_item["size"].as<uint32_t>(1);
+      rule.mask_ = rule_item["mask"].as<uint32_t>(0xFFFFFFFF);
+      rule.value_ = rule_item["value"].as<uint32_t>();
+      rule.negate_ = rule_item["negate"].as<bool>(false);
+      rule.tag_ = rule_item["tag"].as<uint16_t>(0);
+      const auto action_str = rule_item["action"].as<std::string>("drop");
+      rule.action_ = holoscan::advanced_network::GetRxFilterActionFromString(action_str);
+      if (rule.action_ == holoscan::advanced_network::RxFilterAction::INVALID) {
+        HOLOSCAN_LOG_ERROR("Invalid filter action '{}' for queue: {}", action_str, q.common_.name_);
+        return false;
+      }
+      if (rule.size_ != 1 && rule.size_ != 2 && rule.size_ != 4) {
+        HOLOSCAN_LOG_ERROR(
+            "Invalid filter field size {} for queue: {}", rule.size_, q.common_.name_);
+        return false;
+      }
+      q.filter_.push_back(rule);
+    }
+    if (q.filter_.size() > holoscan::advanced_network::MAX_RX_FILTER_RULES) {
+      HOLOSCAN_LOG_ERROR("Queue {} has {} filter rules, at most {} are supported",
+                         q.common_.name_,
+                         q.filter_.size(),
+                         holoscan::advanced_network::MAX_RX_FILTER_RULES);
+      return false;
+    }
+  }
   return true;
 }
 
@@ -488,6 +829,18 @@ bool YAML::convert<holoscan::advanced_network::NetworkConfig>::parse_tx_queue_co
     HOLOSCAN_LOG_ERROR("Error parsing TxQueueConfig: {}", e.what());
     return false;
   }
+
+  if (q_item["rate_limit"].IsDefined()) {
+    const auto& rate_limit = q_item["rate_limit"];
+    q.rate_limit_.gbps_ = rate_limit["gbps"].as<double>(0.0);
+    q.rate_limit_.burst_bytes_ = rate_limit["burst_bytes"].as<uint32_t>(0);
+    q.rate_limit_.ipg_ns_ = rate_limit["ipg_ns"].as<uint32_t>(0);
+    if (q.rate_limit_.gbps_ < 0) {
+      HOLOSCAN_LOG_ERROR("Invalid rate_limit gbps {} for queue: {}",
+                         q.rate_limit_.gbps_, q.common_.name_);
+      return false;
+    }
+  }
   return true;
 }
 
@@ -16,6 +16,7 @@
  */
 
 #pragma once
+#include <functional>
 #include <vector>
 #include <string>
 #include <unordered_set>
@@ -37,8 +38,9 @@ enum class ErrorGlobalStats {
   OUT_OF_RX_BUFFERS = 0,
   RX_QUEUE_FULL = 1,
   METADATA_BUF_DEPLETED = 2,
+  RX_PACKETS_DROPPED = 3,
 
-  SENTINEL = 3,
+  SENTINEL = 4,
 };
 
 namespace detail {
@@ -129,6 +131,143 @@ void* get_packet_ptr(BurstParams* burst, int idx);
  */
 uint16_t get_segment_packet_length(BurstParams* burst, int seg, int idx);
 
+/**
+ * @brief Get the pointers of one segment of all packets in a burst
+ *
+ * Fills out with num_pkts pointers in a single call instead of one get_segment_packet_ptr call
+ * per packet. out may be mapped pinned host memory (cudaHostAlloc with cudaHostAllocMapped) so
+ * a kernel can read the pointers without a separate copy.
+ *
+ * @param burst Burst structure containing packets
+ * @param seg Segment of packet
+ * @param out Array of at least num_pkts pointers to fill
+ * @return Status indicating status. Valid values are:
+ *    SUCCESS: Pointers filled
+ *    INVALID_PARAMETER: Segment is out of range for the burst
+ */
+Status get_packet_ptrs(BurstParams* burst, int seg, void** out);
+
+/**
+ * @brief Get the lengths of one segment of all packets in a burst
+ *
+ * Fills out with num_pkts lengths in a single call instead of one get_segment_packet_length
+ * call per packet. As with get_packet_ptrs, out may be mapped pinned host memory.
+ *
+ * @param burst Burst structure containing packets
+ * @param seg Segment of packet
+ * @param out Array of at least num_pkts lengths to fill
+ * @return Status indicating status. Valid values are:
+ *    SUCCESS: Lengths filled
+ *    INVALID_PARAMETER: Segment is out of range for the burst
+ *    NOT_SUPPORTED: Manager doesn't report packet lengths
+ */
+Status get_packet_lengths(BurstParams* burst, int seg, uint16_t* out);
+
+/**
+ * @brief Get one segment of all packets in a burst as a 2D [num_pkts, length] uint8 tensor
+ *
+ * When the segment buffers of the packets are evenly strided, as with fixed-size packets
+ * received in a header-data split GPU memory region, the tensor is a zero-copy strided view of
+ * the burst. It is only valid until the burst is freed. Otherwise, the segments are gathered into
+ * gather_buf on the given stream, which is then the tensor data.
+ *
+ * All packets are assumed to have at least length bytes in the segment.
+ *
+ * @param burst Burst structure containing packets
+ * @param seg Segment of packet
+ * @param length Bytes per packet in the tensor. Defaults to the segment length of the first packet
+ * @param gather_buf Optional buffer of num_pkts * length bytes, in the same memory type as the
+ * segment, used when the segment isn't strided. Without it, non-strided segments return nullptr
+ * @param stream CUDA stream of the gather
+ * @param gathered Optional output set to true if the packets were gathered in gather_buf
+ * @return Tensor of the segment, or nullptr if the burst is empty or couldn't be converted
+ */
+std::shared_ptr<holoscan::Tensor> get_segment_packets_tensor(BurstParams* burst, int seg,
+                                                             int length = -1,
+                                                             void* gather_buf = nullptr,
+                                                             cudaStream_t stream = 0,
+                                                             bool* gathered = nullptr);
+
+/**
+ * @brief Get the frame carried by a frame-aligned RX burst
+ *
+ * Bursts are frame-aligned when the queue cuts bursts on frames, with the `burst_cut` option
+ * of the Rivermax manager. The frame payloads are in place in the receive buffer, so when the
+ * frame is contiguous payload_ptr can be used as a strided buffer of num_pkts payloads.
+ *
+ * @param burst Burst structure containing packets
+ * @param info Frame information to fill
+ * @return Status indicating status. Valid values are:
+ *    SUCCESS: Frame information filled
+ *    NOT_SUPPORTED: Burst isn't frame-aligned
+ */
+Status get_burst_frame_info(BurstParams* burst, BurstFrameInfo* info);
+
+/**
+ * @brief Demultiplex the flows of an RX queue into a GPU frame buffer per flow
+ *
+ * Once set, demux_rx_burst copies the packets of each flow listed into the frame of its flow
+ * with a single kernel per burst, by sequence number or in arrival order. Packets of other
+ * flows are left alone. An empty list removes the demux of the queue.
+ *
+ * @param port Port ID of the queue
+ * @param queue RX queue ID
+ * @param flows Destination of each flow, by flow ID
+ * @return Status indicating status. Valid values are:
+ *    SUCCESS: Flow demux set
+ *    INVALID_PARAMETER: Invalid queue or flow destinations
+ *    NULL_PTR: Out of memory
+ */
+Status set_flow_demux(int port, int queue, const std::vector<FlowDemuxConfig>& flows);
+
+/**
+ * @brief Launch the demux of the flows of an RX burst on a stream
+ *
+ * The burst can be freed once the stream reached the launch, for instance after a
+ * cudaStreamSynchronize or an event recorded after this call.
+ *
+ * @param burst Burst received on a queue with a flow demux
+ * @param stream CUDA stream of the demux kernel
+ * @return Status indicating status. Valid values are:
+ *    SUCCESS: Demux launched
+ *    INVALID_PARAMETER: The queue has no flow demux, or the burst exceeds its batch size
+ */
+Status demux_rx_burst(BurstParams* burst, cudaStream_t stream);
+
+/**
+ * @brief Get the progress of the current frame of a demultiplexed flow
+ *
+ * Counters include the demux launches that completed, so the demux stream should be
+ * synchronized first. A frame is complete when every slot was written.
+ *
+ * @param port Port ID of the queue
+ * @param queue RX queue ID
+ * @param flow_id Flow ID
+ * @param status Progress of the frame
+ * @return Status indicating status. Valid values are:
+ *    SUCCESS: Status filled
+ *    INVALID_PARAMETER: The queue has no flow demux for the flow
+ */
+Status get_flow_demux_status(int port, int queue, uint16_t flow_id, FlowDemuxStatus* status);
+
+/**
+ * @brief Start the next frame of a demultiplexed flow
+ *
+ * Clears the frame counters of the flow and sets the sequence number of its first slot,
+ * ordered with the demux launches on the stream.
+ *
+ * @param port Port ID of the queue
+ * @param queue RX queue ID
+ * @param flow_id Flow ID
+ * @param first_seq Sequence number of the first slot of the frame
+ * @param stream CUDA stream of the demux kernel
+ * @return Status indicating status. Valid values are:
+ *    SUCCESS: Frame reset
+ *    INVALID_PARAMETER: The queue has no flow demux for the flow
+ */
+Status reset_flow_demux(int port, int queue, uint16_t flow_id, uint64_t first_seq,
+                        cudaStream_t stream);
+
 /**
  * @brief Get packet length of an entire packet
  *
@@ -217,6 +356,96 @@ Status set_udp_header(BurstParams* burst, int idx, int udp_len, uint16_t src_por
  */
 Status set_udp_payload(BurstParams* burst, int idx, void* data, int len);
 
+/**
+ * @brief Populate a TX burst with one large UDP send
+ *
+ * Splits a payload of up to 64KB into UDP datagrams of seg_size bytes, each sent with a copy of
+ * the header template. The IPv4 and UDP lengths, IPv4 ID and checksums of every datagram are
+ * filled in from the template, so no per-packet header call is needed. When the NIC supports UDP
+ * segmentation offload, the burst holds a single buffer chain that the NIC segments on the wire.
+ * Otherwise the datagrams are built in software, one packet per datagram.
+ *
+ * The burst must have its port and queue set, and is sent with send_tx_burst. The first segment
+ * of the queue must be in CPU-accessible memory, and only that segment is used.
+ *
+ * @param burst Burst structure to populate
+ * @param hdr Ethernet, IPv4 and UDP header template. The IPv4 ID is the one of the first datagram
+ * @param hdr_len Length of the header template
+ * @param data Payload to send
+ * @param len Length of the payload
+ * @param seg_size Payload bytes per datagram
+ * @return Status indicating status. Valid values are:
+ *    SUCCESS: Burst populated
+ *    INVALID_PARAMETER: Invalid header template or sizes for the queue
+ *    NO_FREE_BURST_BUFFERS: No burst buffers to allocate
+ *    NO_FREE_PACKET_BUFFERS: Not enough packet buffers available
+ *    NOT_SUPPORTED: Not supported by the manager or the queue memory type
+ */
+Status get_tx_large_send_burst(BurstParams* burst, const void* hdr, int hdr_len, const void* data,
+                               int len, int seg_size);
+
+/**
+ * @brief Register an application buffer for zero-copy transmit
+ *
+ * Registers and DMA maps a device or pinned host buffer with the NIC of a port so packets of
+ * get_tx_ext_buffer_burst can point into it. Registration is slow and should be done once at
+ * startup. The buffer must be aligned to and a multiple of 64KB, the GPU page size.
+ *
+ * @param port Port ID of the NIC
+ * @param addr Start of the buffer
+ * @param len Length of the buffer
+ * @return Status indicating status. Valid values are:
+ *    SUCCESS: Buffer registered
+ *    INVALID_PARAMETER: Invalid port, or misaligned buffer
+ *    INTERNAL_ERROR: The buffer couldn't be registered or mapped
+ *    NOT_SUPPORTED: Not supported by the manager
+ */
+Status register_tx_buffer(int port, void* addr, size_t len);
+
+/**
+ * @brief Unregister a buffer registered with register_tx_buffer
+ *
+ * No packet of the buffer can be in flight.
+ *
+ * @param port Port ID of the NIC
+ * @param addr Start of the buffer
+ * @return Status indicating status. Valid values are:
+ *    SUCCESS: Buffer unregistered
+ *    INVALID_PARAMETER: Buffer isn't registered on the port
+ *    NOT_SUPPORTED: Not supported by the manager
+ */
+Status unregister_tx_buffer(int port, void* addr);
+
+/**
+ * @brief Populate a TX burst with packet payloads in application buffers, without a copy
+ *
+ * Each packet is a header buffer from the first memory region of the queue, filled from the
+ * header template, chained to its payload in a registered application buffer. The IPv4 and UDP
+ * lengths are filled in for each payload and the NIC computes the IPv4 checksum. The headers can
+ * still be changed with the set_*_header functions before the burst is sent.
+ *
+ * The burst must have its port, queue and number of packets set (as with get_tx_packet_burst),
+ * and is sent with send_tx_burst. The payloads must stay valid until free_cb is called for them,
+ * once per packet. The burst has two segments: headers and payloads.
+ *
+ * @param burst Burst structure to populate
+ * @param hdr Ethernet, IPv4 and UDP header template
+ * @param hdr_len Length of the header template
+ * @param bufs Payload address of each packet, in buffers registered with register_tx_buffer
+ * @param lens Payload length of each packet
+ * @param free_cb Optional callback called when the NIC is done with a payload
+ * @param cb_arg Argument passed to free_cb
+ * @return Status indicating status. Valid values are:
+ *    SUCCESS: Burst populated
+ *    INVALID_PARAMETER: Invalid header template, or payload outside the registered buffers
+ *    NO_FREE_BURST_BUFFERS: No burst buffers to allocate
+ *    NO_FREE_PACKET_BUFFERS: Not enough packet buffers available
+ *    NOT_SUPPORTED: Not supported by the manager or the queue memory type
+ */
+Status get_tx_ext_buffer_burst(BurstParams* burst, const void* hdr, int hdr_len,
+                               void* const* bufs, const uint16_t* lens,
+                               TxBufferFreeCallback free_cb = nullptr, void* cb_arg = nullptr);
+
 /**
  * @brief Test if a TX burst is available
  *
@@ -326,6 +555,17 @@ void free_all_segment_packets(BurstParams* burst, int seg);
  */
 void free_rx_burst(BurstParams* burst);
 
+/**
+ * @brief Free multiple receive bursts
+ *
+ * Frees the buffers containing receive bursts, typically the ones returned by get_rx_bursts.
+ * This function does not free packets; packets must be freed prior to calling this.
+ *
+ * @param bursts Array of bursts to free
+ * @param num_bursts Number of bursts in the array
+ */
+void free_rx_bursts(BurstParams** bursts, int num_bursts);
+
 /**
  * @brief Free a transmit burst buffer
  *
@@ -380,6 +620,20 @@ int64_t get_q_id(BurstParams* burst);
  */
 Status get_mac_addr(int port, char* mac);
 
+/**
+ * @brief Get the current PTP time of an interface
+ *
+ * Reads the PTP hardware clock of the NIC, which ptp4l disciplines to the grandmaster. NIC
+ * timestamps, `ptp_timestamp` of RX bursts and `set_packet_tx_time` use the same time base when
+ * the interface enables `ptp`.
+ *
+ * @param port Port number of interface
+ * @param time PTP time in nanoseconds
+ *
+ * @returns Status::SUCCESS on success, Status::NOT_SUPPORTED if the interface doesn't enable ptp
+ */
+Status get_ptp_time(int port, uint64_t* time);
+
 /**
  * @brief Get port number from interface name
  *
@@ -439,6 +693,91 @@ Status get_rx_burst(BurstParams** burst, int port);
  */
 Status get_rx_burst(BurstParams** burst);
 
+/**
+ * @brief Get up to max_bursts RX bursts from a queue in a single call
+ *
+ * Drains everything queued on a port/queue since the last call, up to max_bursts, which
+ * amortizes the per-call cost when bursts are small or arrive faster than the operator ticks.
+ *
+ * @param bursts Array of at least max_bursts burst pointers to fill
+ * @param max_bursts Maximum number of bursts to dequeue
+ * @param port Port ID of interface
+ * @param q Queue ID of interface
+ * @return Number of bursts stored in bursts. 0 if no bursts are ready to receive
+ */
+int get_rx_bursts(BurstParams** bursts, int max_bursts, int port, int q);
+
+/**
+ * @brief Get the number of RX bursts ready to receive on a queue
+ *
+ * @param port Port ID of interface
+ * @param q Queue ID of interface
+ * @return Number of bursts get_rx_burst can return without waiting, or -1 if the manager
+ * doesn't track it or the queue doesn't exist
+ */
+int get_rx_burst_count(int port, int q);
+
+/**
+ * @brief Set a function called by the manager each time bursts become ready on a queue
+ *
+ * The function runs on the manager's RX worker thread, so it must only signal another thread,
+ * e.g. a scheduling condition, and return. AdvNetworkRxCondition is built on it.
+ *
+ * @param port Port ID of interface
+ * @param q Queue ID of interface
+ * @param cb Function to call, or an empty function to remove the current one
+ * @return Status::SUCCESS, or Status::NOT_SUPPORTED if the manager doesn't signal ready bursts
+ */
+Status set_rx_ready_callback(int port, int q, std::function<void()> cb);
+
+/**
+ * @brief Get the latency statistics of all RX queues with latency_stats enabled
+ *
+ * Latencies are measured per burst and kept in histograms by the manager, so this can be
+ * called periodically while the application is running.
+ *
+ * @return Latency statistics per port/queue. Empty if not supported by the manager
+ */
+std::vector<QueueLatencyStats> get_queue_latency_stats();
+
+/**
+ * @brief Get a snapshot of the port, queue, pool and latency statistics of the manager
+ *
+ * The statistics have the same layout for all managers, and counters a manager doesn't track
+ * are left at 0. They are also served in the Prometheus text format by the HTTP endpoint
+ * enabled with the `metrics` option.
+ *
+ * @param stats Statistics to fill
+ * @return Status::SUCCESS, or Status::NOT_SUPPORTED if the manager doesn't report statistics
+ */
+Status get_stats(ManagerStats& stats);
+
+/**
+ * @brief Add an RX flow rule while the manager is running
+ *
+ * The flow steers matching packets to the queue in its action, the same way as the flows listed
+ * in the configuration, without restarting the manager. Packets of the flow are reported with
+ * the flow ID by get_packet_flow_id.
+ *
+ * @param port Port ID of interface
+ * @param flow Flow to add. The flow ID must be unique on the port
+ * @return Status::SUCCESS if the flow was added, Status::NOT_SUPPORTED if the manager can't
+ * change flows at runtime, or an error otherwise
+ */
+Status add_flow(int port, const FlowConfig& flow);
+
+/**
+ * @brief Remove an RX flow rule while the manager is running
+ *
+ * Works for the flows listed in the configuration as well as the ones added with add_flow.
+ *
+ * @param port Port ID of interface
+ * @param flow_id ID of the flow to remove
+ * @return Status::SUCCESS if the flow was removed, Status::INVALID_PARAMETER if no such flow
+ * exists, Status::NOT_SUPPORTED if the manager can't change flows at runtime
+ */
+Status remove_flow(int port, uint16_t flow_id);
+
 /**
  * @brief Set the header fields in a burst
  *
@@ -603,6 +942,30 @@ struct YAML::convert<holoscan::advanced_network::NetworkConfig> {
         input_spec.log_level_ = holoscan::advanced_network::LogLevel::WARN;
       }
 
+      if (node["metrics"].IsDefined()) {
+        const auto& metrics = node["metrics"];
+        input_spec.metrics_.port_ = metrics["port"].as<uint16_t>();
+        input_spec.metrics_.address_ = metrics["address"].as<std::string>("0.0.0.0");
+        input_spec.metrics_.cpu_core_ = metrics["cpu_core"].as<int>(-1);
+      }
+
+      if (node["multi_process"].IsDefined()) {
+        const auto& multi_process = node["multi_process"];
+        const auto type = multi_process["type"].as<std::string>("standalone");
+        if (type == "primary") {
+          input_spec.multi_process_.type_ = holoscan::advanced_network::ProcessType::PRIMARY;
+        } else if (type == "secondary") {
+          input_spec.multi_process_.type_ = holoscan::advanced_network::ProcessType::SECONDARY;
+        } else if (type == "standalone") {
+          input_spec.multi_process_.type_ = holoscan::advanced_network::ProcessType::STANDALONE;
+        } else {
+          HOLOSCAN_LOG_ERROR("Invalid multi_process type '{}'", type);
+          return false;
+        }
+        input_spec.multi_process_.file_prefix_ =
+            multi_process["file_prefix"].as<std::string>(input_spec.multi_process_.file_prefix_);
+      }
+
       try {
         const auto& mrs = node["memory_regions"];
         for (const auto& mr : mrs) {
@@ -630,6 +993,43 @@ struct YAML::convert<holoscan::advanced_network::NetworkConfig> {
           ifcfg.name_ = intf["name"].as<std::string>();
           ifcfg.address_ = intf["address"].as<std::string>();
 
+          if (intf["rdma"].IsDefined()) {
+            const auto& rdma = intf["rdma"];
+            const auto mode = rdma["mode"].as<std::string>("server");
+            if (mode != "server" && mode != "client") {
+              HOLOSCAN_LOG_ERROR("Invalid rdma mode '{}' for interface {}", mode, ifcfg.name_);
+              return false;
+            }
+            ifcfg.rdma_.server_ = mode == "server";
+            ifcfg.rdma_.peer_address_ = rdma["peer_address"].as<std::string>("");
+            ifcfg.rdma_.port_ = rdma["port"].as<uint16_t>(ifcfg.rdma_.port_);
+            ifcfg.rdma_.gid_index_ = rdma["gid_index"].as<int>(ifcfg.rdma_.gid_index_);
+            if (!ifcfg.rdma_.server_ && ifcfg.rdma_.peer_address_.empty()) {
+              HOLOSCAN_LOG_ERROR("rdma client interface {} needs a peer_address", ifcfg.name_);
+              return false;
+            }
+          }
+
+          if (intf["ptp"].IsDefined()) {
+            const auto& ptp = intf["ptp"];
+            ifcfg.ptp_.enabled_ = ptp["enabled"].as<bool>(true);
+            ifcfg.ptp_.device_ = ptp["device"].as<std::string>("");
+            ifcfg.ptp_.sync_interval_ms_ =
+                ptp["sync_interval_ms"].as<uint32_t>(ifcfg.ptp_.sync_interval_ms_);
+            if (ifcfg.ptp_.sync_interval_ms_ == 0) {
+              HOLOSCAN_LOG_ERROR("ptp sync_interval_ms of interface {} must be positive",
+                                 ifcfg.name_);
+              return false;
+            }
+          }
+
+          if (intf["af_xdp"].IsDefined()) {
+            const auto& af_xdp = intf["af_xdp"];
+            ifcfg.af_xdp_.zero_copy_ = af_xdp["zero_copy"].as<bool>(ifcfg.af_xdp_.zero_copy_);
+            ifcfg.af_xdp_.busy_poll_us_ =
+                af_xdp["busy_poll_us"].as<uint32_t>(ifcfg.af_xdp_.busy_poll_us_);
+          }
+
           try {
             const auto& rx = intf["rx"];
             holoscan::advanced_network::RxConfig rx_cfg;
@@ -638,6 +1038,20 @@ struct YAML::convert<holoscan::advanced_network::NetworkConfig> {
               rx_cfg.flow_isolation_ = rx["flow_isolation"].as<bool>();
             } catch (const std::exception& e) { rx_cfg.flow_isolation_ = false; }
 
+            try {
+              rx_cfg.latency_stats_ = rx["latency_stats"].as<bool>();
+            } catch (const std::exception& e) { rx_cfg.latency_stats_ = false; }
+
+            if (rx["kernel_mode"].IsDefined()) {
+              const auto mode_str = rx["kernel_mode"].as<std::string>();
+              rx_cfg.kernel_mode_ = holoscan::advanced_network::GetRxKernelModeFromString(mode_str);
+              if (rx_cfg.kernel_mode_ == holoscan::advanced_network::RxKernelMode::INVALID) {
+                HOLOSCAN_LOG_ERROR("Invalid RX kernel_mode '{}' for interface {}",
+                                   mode_str, ifcfg.name_);
+                return false;
+              }
+            }
+
             for (const auto& q_item : rx["queues"]) {
               holoscan::advanced_network::RxQueueConfig q;
               if (!parse_rx_queue_config(q_item, input_spec.common_.manager_type, q)) {
@@ -672,6 +1086,16 @@ struct YAML::convert<holoscan::advanced_network::NetworkConfig> {
               tx_cfg.accurate_send_ = tx["accurate_send"].as<bool>();
             } catch (const std::exception& e) { tx_cfg.accurate_send_ = false; }
 
+            if (tx["kernel_mode"].IsDefined()) {
+              const auto mode_str = tx["kernel_mode"].as<std::string>();
+              tx_cfg.kernel_mode_ = holoscan::advanced_network::GetTxKernelModeFromString(mode_str);
+              if (tx_cfg.kernel_mode_ == holoscan::advanced_network::TxKernelMode::INVALID) {
+                HOLOSCAN_LOG_ERROR("Invalid TX kernel_mode '{}' for interface {}",
+                                   mode_str, ifcfg.name_);
+                return false;
+              }
+            }
+
             for (const auto& q_item : tx["queues"]) {
               holoscan::advanced_network::TxQueueConfig q;
               if (!parse_tx_queue_config(q_item, input_spec.common_.manager_type, q)) {
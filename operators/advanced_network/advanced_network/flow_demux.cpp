@@ -0,0 +1,200 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "advanced_network/flow_demux.h"
+#include "advanced_network/manager.h"
+#include "holoscan/holoscan.hpp"
+
+namespace holoscan::advanced_network {
+
+FlowDemux::FlowDemux(const std::vector<FlowDemuxConfig>& flows, uint32_t max_pkts)
+    : flows_(flows), max_pkts_(max_pkts) {}
+
+FlowDemux::~FlowDemux() {
+  for (auto& stage : stages_) {
+    if (stage.done != nullptr) {
+      if (stage.in_flight) { cudaEventSynchronize(stage.done); }
+      cudaEventDestroy(stage.done);
+    }
+    cudaFreeHost(stage.seq_ptrs);
+    cudaFreeHost(stage.data_ptrs);
+    cudaFreeHost(stage.pkt_targets);
+  }
+  cudaFreeHost(targets_h_);
+  cudaFree(targets_d_);
+  cudaFree(counters_d_);
+}
+
+Status FlowDemux::init() {
+  if (flows_.empty() || flows_.size() >= FLOW_DEMUX_NO_TARGET || max_pkts_ == 0) {
+    HOLOSCAN_LOG_ERROR("Invalid flow demux of {} flows", flows_.size());
+    return Status::INVALID_PARAMETER;
+  }
+
+  for (size_t t = 0; t < flows_.size(); t++) {
+    const auto& flow = flows_[t];
+    const uint8_t width = flow.seq_width_;
+    if (flow.buf_ == nullptr || flow.num_slots_ == 0 || flow.slot_size_ == 0 ||
+        (width != 0 && width != 1 && width != 2 && width != 4 && width != 8) ||
+        !flow_targets_.emplace(flow.flow_id_, static_cast<uint16_t>(t)).second) {
+      HOLOSCAN_LOG_ERROR("Invalid flow demux target for flow {}", flow.flow_id_);
+      return Status::INVALID_PARAMETER;
+    }
+  }
+
+  const size_t num_targets = flows_.size();
+  const size_t counters_size = num_targets * NUM_COUNTERS * sizeof(uint32_t);
+  if (cudaMallocHost(&targets_h_, num_targets * sizeof(FlowDemuxTarget)) != cudaSuccess ||
+      cudaMalloc(&targets_d_, num_targets * sizeof(FlowDemuxTarget)) != cudaSuccess ||
+      cudaMalloc(&counters_d_, counters_size) != cudaSuccess ||
+      cudaMemset(counters_d_, 0, counters_size) != cudaSuccess) {
+    HOLOSCAN_LOG_ERROR("Failed to allocate the flow demux targets");
+    return Status::NULL_PTR;
+  }
+
+  for (size_t t = 0; t < num_targets; t++) {
+    const auto& flow = flows_[t];
+    auto& target = targets_h_[t];
+    target.out = flow.buf_;
+    target.num_pkts = &counters_d_[t * NUM_COUNTERS];
+    target.num_dropped = &counters_d_[t * NUM_COUNTERS + 1];
+    target.next_slot = &counters_d_[t * NUM_COUNTERS + 2];
+    target.first_seq = 0;
+    target.num_slots = flow.num_slots_;
+    target.copy_offset = flow.payload_offset_;
+    target.copy_len = flow.slot_size_;
+    target.seq_offset = flow.seq_offset_;
+    target.seq_width = flow.seq_width_;
+    target.seq_big_endian = flow.seq_big_endian_;
+  }
+
+  if (cudaMemcpy(targets_d_,
+                 targets_h_,
+                 num_targets * sizeof(FlowDemuxTarget),
+                 cudaMemcpyHostToDevice) != cudaSuccess) {
+    HOLOSCAN_LOG_ERROR("Failed to copy the flow demux targets");
+    return Status::INTERNAL_ERROR;
+  }
+
+  for (auto& stage : stages_) {
+    if (cudaMallocHost(&stage.seq_ptrs, max_pkts_ * sizeof(void*)) != cudaSuccess ||
+        cudaMallocHost(&stage.data_ptrs, max_pkts_ * sizeof(void*)) != cudaSuccess ||
+        cudaMallocHost(&stage.pkt_targets, max_pkts_ * sizeof(uint16_t)) != cudaSuccess ||
+        cudaEventCreateWithFlags(&stage.done, cudaEventDisableTiming) != cudaSuccess) {
+      HOLOSCAN_LOG_ERROR("Failed to allocate the flow demux stages");
+      return Status::NULL_PTR;
+    }
+  }
+
+  return Status::SUCCESS;
+}
+
+int FlowDemux::find_target(uint16_t flow_id) const {
+  const auto it = flow_targets_.find(flow_id);
+  return it == flow_targets_.end() ? -1 : it->second;
+}
+
+Status FlowDemux::demux(Manager& mgr, BurstParams* burst, cudaStream_t stream) {
+  const uint32_t num_pkts = burst->hdr.hdr.num_pkts;
+  if (num_pkts > max_pkts_) {
+    HOLOSCAN_LOG_ERROR("Burst of {} packets exceeds the flow demux batch size of {}",
+                       num_pkts,
+                       max_pkts_);
+    return Status::INVALID_PARAMETER;
+  }
+  if (num_pkts == 0) { return Status::SUCCESS; }
+
+  // The stage was last launched NUM_STAGES bursts ago, so this rarely waits
+  auto& stage = stages_[next_stage_];
+  if (stage.in_flight && cudaEventSynchronize(stage.done) != cudaSuccess) {
+    return Status::INTERNAL_ERROR;
+  }
+  stage.in_flight = false;
+
+  // Sequence numbers are in the headers and copies are from the payloads with header-data split
+  const int data_seg = burst->hdr.hdr.num_segs > 1 ? burst->hdr.hdr.num_segs - 1 : 0;
+  auto ret = mgr.get_packet_ptrs(burst, 0, stage.seq_ptrs);
+  if (ret == Status::SUCCESS && data_seg != 0) {
+    ret = mgr.get_packet_ptrs(burst, data_seg, stage.data_ptrs);
+  }
+  if (ret != Status::SUCCESS) { return ret; }
+
+  int last_flow = -1;
+  uint16_t last_target = FLOW_DEMUX_NO_TARGET;
+  for (uint32_t p = 0; p < num_pkts; p++) {
+    const int flow = mgr.get_packet_flow_id(burst, p);
+    if (flow != last_flow) {
+      const int target = find_target(flow);
+      last_target = target < 0 ? FLOW_DEMUX_NO_TARGET : static_cast<uint16_t>(target);
+      last_flow = flow;
+    }
+    stage.pkt_targets[p] = last_target;
+  }
+
+  flow_demux_packets(targets_d_,
+                     stage.pkt_targets,
+                     stage.seq_ptrs,
+                     data_seg != 0 ? stage.data_ptrs : stage.seq_ptrs,
+                     num_pkts,
+                     stream);
+  if (cudaEventRecord(stage.done, stream) != cudaSuccess) { return Status::INTERNAL_ERROR; }
+
+  stage.in_flight = true;
+  next_stage_ = (next_stage_ + 1) % NUM_STAGES;
+  return Status::SUCCESS;
+}
+
+Status FlowDemux::get_status(uint16_t flow_id, FlowDemuxStatus* status) const {
+  const int target = find_target(flow_id);
+  if (target < 0) { return Status::INVALID_PARAMETER; }
+
+  uint32_t counters[NUM_COUNTERS];
+  if (cudaMemcpy(counters,
+                 &counters_d_[target * NUM_COUNTERS],
+                 sizeof(counters),
+                 cudaMemcpyDeviceToHost) != cudaSuccess) {
+    return Status::INTERNAL_ERROR;
+  }
+
+  status->first_seq = targets_h_[target].first_seq;
+  status->num_pkts = counters[0];
+  status->num_dropped = counters[1];
+  status->complete = counters[0] >= flows_[target].num_slots_;
+  return Status::SUCCESS;
+}
+
+Status FlowDemux::reset(uint16_t flow_id, uint64_t first_seq, cudaStream_t stream) {
+  const int target = find_target(flow_id);
+  if (target < 0) { return Status::INVALID_PARAMETER; }
+
+  targets_h_[target].first_seq = first_seq;
+  if (cudaMemcpyAsync(&targets_d_[target].first_seq,
+                      &targets_h_[target].first_seq,
+                      sizeof(first_seq),
+                      cudaMemcpyHostToDevice,
+                      stream) != cudaSuccess ||
+      cudaMemsetAsync(&counters_d_[target * NUM_COUNTERS],
+                      0,
+                      NUM_COUNTERS * sizeof(uint32_t),
+                      stream) != cudaSuccess) {
+    return Status::INTERNAL_ERROR;
+  }
+
+  return Status::SUCCESS;
+}
+
+};  // namespace holoscan::advanced_network
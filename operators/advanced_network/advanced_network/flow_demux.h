@@ -0,0 +1,91 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <array>
+#include <unordered_map>
+#include <vector>
+#include "advanced_network/kernels.h"
+#include "advanced_network/types.h"
+
+namespace holoscan::advanced_network {
+
+class Manager;
+
+/**
+ * @brief Demultiplexes the flows of an RX queue into a GPU frame buffer per flow
+ *
+ * The packet pointers and flow targets of each burst are staged in pinned memory, and a single
+ * kernel per burst scatters every packet into the frame of its flow. Packets of flows without a
+ * target are left alone. A few stages are in flight at once, so a burst is staged while the
+ * kernels of the previous ones run. A demux is used by one thread at a time.
+ */
+class FlowDemux {
+ public:
+  FlowDemux(const std::vector<FlowDemuxConfig>& flows, uint32_t max_pkts);
+  ~FlowDemux();
+  FlowDemux(const FlowDemux&) = delete;
+  FlowDemux& operator=(const FlowDemux&) = delete;
+
+  /**
+   * @brief Validate the flows and allocate the targets and stages
+   */
+  Status init();
+
+  /**
+   * @brief Launch the demux of a burst on a stream
+   *
+   * The burst packets can be freed once the stream reached the launch.
+   */
+  Status demux(Manager& mgr, BurstParams* burst, cudaStream_t stream);
+
+  /**
+   * @brief Get the progress of the current frame of a flow, once the demux stream is synchronized
+   */
+  Status get_status(uint16_t flow_id, FlowDemuxStatus* status) const;
+
+  /**
+   * @brief Start the next frame of a flow at first_seq, ordered on a stream
+   */
+  Status reset(uint16_t flow_id, uint64_t first_seq, cudaStream_t stream);
+
+ private:
+  static constexpr int NUM_STAGES = 4;
+  static constexpr int NUM_COUNTERS = 3;  // num_pkts, num_dropped and next_slot of a target
+
+  struct Stage {
+    void** seq_ptrs = nullptr;
+    void** data_ptrs = nullptr;
+    uint16_t* pkt_targets = nullptr;
+    cudaEvent_t done = nullptr;
+    bool in_flight = false;
+  };
+
+  int find_target(uint16_t flow_id) const;
+
+  std::vector<FlowDemuxConfig> flows_;
+  std::unordered_map<uint16_t, uint16_t> flow_targets_;  // Flow ID to target index
+  uint32_t max_pkts_;
+  FlowDemuxTarget* targets_h_ = nullptr;  // Pinned copy of the targets
+  FlowDemuxTarget* targets_d_ = nullptr;
+  uint32_t* counters_d_ = nullptr;
+  std::array<Stage, NUM_STAGES> stages_;
+  int next_stage_ = 0;
+};
+
+};  // namespace holoscan::advanced_network
@@ -61,3 +61,227 @@ void simple_packet_reorder(void* out, const void* const* const in, uint16_t pkt_
                            uint32_t num_pkts, cudaStream_t stream) {
   simple_packet_reorder_kernel<<<num_pkts, 128, 0, stream>>>(out, in, pkt_len, num_pkts);
 }
+
+/**
+ * @brief Set all bits of a missing slot bitmap. Bits past the last slot are left cleared.
+ *
+ * @param missing_bitmap Bitmap of missing slots
+ * @param num_slots Number of packet slots in the frame
+ */
+__global__ void seq_packet_reorder_reset_kernel(uint32_t* missing_bitmap, uint32_t num_slots) {
+  const uint32_t num_words = (num_slots + 31) / 32;
+
+  for (uint32_t word = blockIdx.x * blockDim.x + threadIdx.x; word < num_words;
+       word += gridDim.x * blockDim.x) {
+    const uint32_t bits = num_slots - word * 32;
+    missing_bitmap[word] = bits >= 32 ? 0xFFFFFFFFU : ((1U << bits) - 1);
+  }
+}
+
+/**
+ * @brief Read an unaligned sequence number field of a packet
+ *
+ * @param pkt Packet
+ * @param width Width of the field in bytes
+ * @param big_endian True if the field is big endian
+ */
+__device__ __forceinline__ uint64_t read_seq_field(const uint8_t* pkt, uint8_t width,
+                                                   bool big_endian) {
+  uint64_t seq = 0;
+  for (int i = 0; i < width; i++) {
+    const uint64_t byte = pkt[big_endian ? i : (width - 1 - i)];
+    seq = (seq << 8) | byte;
+  }
+  return seq;
+}
+
+/**
+ * @brief Copy bytes with the widest loads the alignment of both buffers permits
+ *
+ * @param dst Destination buffer
+ * @param src Source buffer
+ * @param len Number of bytes to copy
+ * @param lane Index of the calling thread in the copying group
+ * @param num_lanes Number of threads in the copying group
+ */
+__device__ __forceinline__ void copy_packet_bytes(uint8_t* __restrict__ dst,
+                                                  const uint8_t* __restrict__ src, uint32_t len,
+                                                  uint32_t lane, uint32_t num_lanes) {
+  const uintptr_t alignment = reinterpret_cast<uintptr_t>(dst) | reinterpret_cast<uintptr_t>(src);
+  uint32_t pos = 0;
+
+  if ((alignment & 0xF) == 0) {
+    const uint32_t num_vec = len / sizeof(uint4);
+    for (uint32_t i = lane; i < num_vec; i += num_lanes) {
+      reinterpret_cast<uint4*>(dst)[i] = reinterpret_cast<const uint4*>(src)[i];
+    }
+    pos = num_vec * sizeof(uint4);
+  } else if ((alignment & 0x3) == 0) {
+    const uint32_t num_vec = len / sizeof(uint32_t);
+    for (uint32_t i = lane; i < num_vec; i += num_lanes) {
+      reinterpret_cast<uint32_t*>(dst)[i] = reinterpret_cast<const uint32_t*>(src)[i];
+    }
+    pos = num_vec * sizeof(uint32_t);
+  }
+
+  for (uint32_t i = pos + lane; i < len; i += num_lanes) { dst[i] = src[i]; }
+}
+
+/**
+ * @brief Sequence-aware packet reorder kernel. Each warp scatters one packet into the
+ *        frame slot given by its sequence number.
+ */
+__global__ void seq_packet_reorder_kernel(uint8_t* __restrict__ out,
+                                          uint32_t* __restrict__ missing_bitmap,
+                                          uint32_t* __restrict__ num_dropped,
+                                          const void* const* const __restrict__ in,
+                                          uint16_t copy_offset, uint16_t copy_len,
+                                          uint32_t num_pkts, uint16_t seq_offset,
+                                          uint8_t seq_width, bool seq_big_endian,
+                                          uint64_t first_seq, uint32_t num_slots) {
+  // Warmup
+  if (out == nullptr) return;
+
+  const uint32_t lane = threadIdx.x % warpSize;
+  const uint32_t pkt_idx = (blockIdx.x * blockDim.x + threadIdx.x) / warpSize;
+  if (pkt_idx >= num_pkts) return;
+
+  const uint8_t* pkt = static_cast<const uint8_t*>(in[pkt_idx]);
+  const uint64_t seq_mask = seq_width >= 8 ? ~0ULL : ((1ULL << (seq_width * 8)) - 1);
+  const uint64_t seq = read_seq_field(pkt + seq_offset, seq_width, seq_big_endian);
+  const uint64_t slot = (seq - first_seq) & seq_mask;
+
+  if (slot >= num_slots) {
+    if (lane == 0 && num_dropped != nullptr) { atomicAdd(num_dropped, 1); }
+    return;
+  }
+
+  copy_packet_bytes(out + slot * copy_len, pkt + copy_offset, copy_len, lane, warpSize);
+
+  if (lane == 0) { atomicAnd(&missing_bitmap[slot / 32], ~(1U << (slot % 32))); }
+}
+
+/**
+ * @brief Wrapper to launch the missing slot bitmap reset kernel
+ *
+ * @param missing_bitmap Bitmap of missing slots
+ * @param num_slots Number of packet slots in the frame
+ * @param stream CUDA stream
+ */
+void seq_packet_reorder_reset(uint32_t* missing_bitmap, uint32_t num_slots, cudaStream_t stream) {
+  const uint32_t num_words = (num_slots + 31) / 32;
+  const uint32_t threads = 256;
+  if (num_words == 0) return;
+  seq_packet_reorder_reset_kernel<<<(num_words + threads - 1) / threads, threads, 0, stream>>>(
+      missing_bitmap, num_slots);
+}
+
+/**
+ * @brief Wrapper to launch the sequence-aware packet reorder kernel
+ *
+ * @param out Frame buffer
+ * @param missing_bitmap Bitmap of missing slots
+ * @param num_dropped Optional counter of packets outside the frame
+ * @param in Pointer to list of input packet pointers
+ * @param copy_offset Offset into each packet to start copying from
+ * @param copy_len Number of bytes copied from each packet and slot size
+ * @param num_pkts Number of packets
+ * @param seq_offset Offset of the sequence number field
+ * @param seq_width Width of the sequence number field in bytes
+ * @param seq_big_endian True if the sequence number field is big endian
+ * @param first_seq Sequence number of the first slot
+ * @param num_slots Number of packet slots in the frame
+ * @param stream CUDA stream
+ */
+void seq_packet_reorder(void* out, uint32_t* missing_bitmap, uint32_t* num_dropped,
+                        const void* const* const in, uint16_t copy_offset, uint16_t copy_len,
+                        uint32_t num_pkts, uint16_t seq_offset, uint8_t seq_width,
+                        bool seq_big_endian, uint64_t first_seq, uint32_t num_slots,
+                        cudaStream_t stream) {
+  assert(seq_width == 1 || seq_width == 2 || seq_width == 4 || seq_width == 8);
+
+  // One warp per packet, four packets per block
+  const uint32_t threads = 128;
+  const uint32_t pkts_per_block = threads / 32;
+  const uint32_t blocks = (num_pkts + pkts_per_block - 1) / pkts_per_block;
+  if (blocks == 0) return;
+  seq_packet_reorder_kernel<<<blocks, threads, 0, stream>>>(static_cast<uint8_t*>(out),
+                                                           missing_bitmap,
+                                                           num_dropped,
+                                                           in,
+                                                           copy_offset,
+                                                           copy_len,
+                                                           num_pkts,
+                                                           seq_offset,
+                                                           seq_width,
+                                                           seq_big_endian,
+                                                           first_seq,
+                                                           num_slots);
+}
+
+/**
+ * @brief Flow demultiplexing kernel. Each warp scatters one packet into the frame slot of its
+ *        flow, given by its sequence number or by the order the warps claim the slots.
+ */
+__global__ void flow_demux_packets_kernel(const FlowDemuxTarget* __restrict__ targets,
+                                          const uint16_t* __restrict__ pkt_targets,
+                                          const void* const* const __restrict__ seq_in,
+                                          const void* const* const __restrict__ in,
+                                          uint32_t num_pkts) {
+  const uint32_t lane = threadIdx.x % warpSize;
+  const uint32_t pkt_idx = (blockIdx.x * blockDim.x + threadIdx.x) / warpSize;
+  if (pkt_idx >= num_pkts) return;
+
+  const uint16_t target_idx = pkt_targets[pkt_idx];
+  if (target_idx == FLOW_DEMUX_NO_TARGET) return;
+  const FlowDemuxTarget target = targets[target_idx];
+
+  uint64_t slot;
+  if (target.seq_width == 0) {
+    uint32_t next = 0;
+    if (lane == 0) { next = atomicAdd(target.next_slot, 1); }
+    slot = __shfl_sync(0xFFFFFFFFU, next, 0);
+  } else {
+    const uint8_t* pkt = static_cast<const uint8_t*>(seq_in[pkt_idx]);
+    const uint64_t seq_mask =
+        target.seq_width >= 8 ? ~0ULL : ((1ULL << (target.seq_width * 8)) - 1);
+    const uint64_t seq =
+        read_seq_field(pkt + target.seq_offset, target.seq_width, target.seq_big_endian);
+    slot = (seq - target.first_seq) & seq_mask;
+  }
+
+  if (slot >= target.num_slots) {
+    if (lane == 0) { atomicAdd(target.num_dropped, 1); }
+    return;
+  }
+
+  copy_packet_bytes(static_cast<uint8_t*>(target.out) + slot * target.copy_len,
+                    static_cast<const uint8_t*>(in[pkt_idx]) + target.copy_offset,
+                    target.copy_len,
+                    lane,
+                    warpSize);
+
+  if (lane == 0) { atomicAdd(target.num_pkts, 1); }
+}
+
+/**
+ * @brief Wrapper to launch the flow demultiplexing kernel
+ *
+ * @param targets Flow targets
+ * @param pkt_targets Target index of each packet
+ * @param seq_in Pointer to list of the packet pointers holding the sequence numbers
+ * @param in Pointer to list of the packet pointers holding the copied bytes
+ * @param num_pkts Number of packets
+ * @param stream CUDA stream
+ */
+void flow_demux_packets(const FlowDemuxTarget* targets, const uint16_t* pkt_targets,
+                        const void* const* const seq_in, const void* const* const in,
+                        uint32_t num_pkts, cudaStream_t stream) {
+  // One warp per packet, four packets per block
+  const uint32_t threads = 128;
+  const uint32_t pkts_per_block = threads / 32;
+  const uint32_t blocks = (num_pkts + pkts_per_block - 1) / pkts_per_block;
+  if (blocks == 0) return;
+  flow_demux_packets_kernel<<<blocks, threads, 0, stream>>>(
+      targets, pkt_targets, seq_in, in, num_pkts);
+}
@@ -18,6 +18,7 @@
 #pragma once
 #include <stdint.h>
 #include <assert.h>
+#include <stdbool.h>
 #include <cuda_runtime.h>
 
 #if __cplusplus
@@ -29,6 +30,85 @@ __attribute__((__visibility__("default"))) void simple_packet_reorder(void* out,
                                                                       uint16_t pkt_len,
                                                                       uint32_t num_pkts,
                                                                       cudaStream_t stream);
+
+/**
+ * @brief Mark all slots of a sequence reorder frame as missing
+ *
+ * Must be called before the first seq_packet_reorder of each frame.
+ *
+ * @param missing_bitmap Bitmap of missing slots, one bit per slot
+ * @param num_slots Number of packet slots in the frame
+ * @param stream CUDA stream
+ */
+__attribute__((__visibility__("default"))) void seq_packet_reorder_reset(uint32_t* missing_bitmap,
+                                                                         uint32_t num_slots,
+                                                                         cudaStream_t stream);
+
+/**
+ * @brief Scatter packets into a frame buffer by the sequence number they carry
+ *
+ * Each packet is copied to slot (seq - first_seq) of the frame, where the sequence number is
+ * read from seq_width bytes at seq_offset in the packet, and wraps at its width. The slot bit
+ * is cleared in missing_bitmap, so after all packets of a frame were processed the bits left
+ * set are the missing sequence numbers. Packets outside the frame are dropped and counted.
+ *
+ * @param out Frame buffer of num_slots slots of copy_len bytes
+ * @param missing_bitmap Bitmap of missing slots, one bit per slot
+ * @param num_dropped Optional counter of packets outside the frame. Can be NULL
+ * @param in Pointer to list of input packet pointers
+ * @param copy_offset Offset in bytes into each packet to start copying from
+ * @param copy_len Number of bytes copied from each packet, which is also the slot size
+ * @param num_pkts Number of packets
+ * @param seq_offset Offset in bytes of the sequence number field into each packet
+ * @param seq_width Width of the sequence number field in bytes: 1, 2, 4 or 8
+ * @param seq_big_endian True if the sequence number field is big endian (network order)
+ * @param first_seq Sequence number of the first slot of the frame
+ * @param num_slots Number of packet slots in the frame
+ * @param stream CUDA stream
+ */
+__attribute__((__visibility__("default"))) void seq_packet_reorder(
+    void* out, uint32_t* missing_bitmap, uint32_t* num_dropped, const void* const* const in,
+    uint16_t copy_offset, uint16_t copy_len, uint32_t num_pkts, uint16_t seq_offset,
+    uint8_t seq_width, bool seq_big_endian, uint64_t first_seq, uint32_t num_slots,
+    cudaStream_t stream);
+
+/**
+ * @brief Destination of one flow for flow_demux_packets, in device-visible memory
+ */
+struct FlowDemuxTarget {
+  void* out;              // Frame buffer of num_slots slots of copy_len bytes
+  uint32_t* num_pkts;     // Packets written to the frame
+  uint32_t* num_dropped;  // Packets outside the frame
+  uint32_t* next_slot;    // Next slot when the packets have no sequence number
+  uint64_t first_seq;     // Sequence number of the first slot
+  uint32_t num_slots;     // Number of packet slots in the frame
+  uint16_t copy_offset;   // Offset in bytes into each packet to start copying from
+  uint16_t copy_len;      // Number of bytes copied from each packet, which is also the slot size
+  uint16_t seq_offset;    // Offset in bytes of the sequence number field
+  uint8_t seq_width;      // Width of the sequence number field in bytes, 0 for arrival order
+  bool seq_big_endian;    // True if the sequence number field is big endian
+};
+
+#define FLOW_DEMUX_NO_TARGET 0xFFFF
+
+/**
+ * @brief Scatter the packets of several flows into the frame buffers of their flows
+ *
+ * Works like seq_packet_reorder for every flow in a single launch. Each packet is copied to the
+ * frame of targets[pkt_targets[p]], and packets with FLOW_DEMUX_NO_TARGET are skipped. The frame
+ * counters of each target are updated as the packets are written.
+ *
+ * @param targets Flow targets in device-visible memory
+ * @param pkt_targets Target index of each packet
+ * @param seq_in Pointer to list of the packet pointers holding the sequence numbers
+ * @param in Pointer to list of the packet pointers holding the copied bytes. Can be seq_in
+ * @param num_pkts Number of packets
+ * @param stream CUDA stream
+ */
+__attribute__((__visibility__("default"))) void flow_demux_packets(
+    const struct FlowDemuxTarget* targets, const uint16_t* pkt_targets,
+    const void* const* const seq_in, const void* const* const in, uint32_t num_pkts,
+    cudaStream_t stream);
 #if __cplusplus
 }
 #endif
@@ -15,6 +15,17 @@
  * limitations under the License.
  */
 #include <cuda.h>
+#include <climits>
+#include <cstdlib>
+#include <fstream>
+#include <atomic>
+#include <mutex>
+#include <set>
+#include <shared_mutex>
+#include <sstream>
+#include <thread>
+#include <unordered_map>
+#include <unistd.h>
 #include "advanced_network/manager.h"
 // Include the appropriate headers based on which ANO_MGR types are defined
 #if ANO_MGR_DPDK
@@ -26,6 +37,12 @@
 #if ANO_MGR_RIVERMAX
 #include "advanced_network/managers/rivermax/adv_network_rmax_mgr.h"
 #endif
+#if ANO_MGR_RDMA
+#include "advanced_network/managers/rdma/adv_network_rdma_mgr.h"
+#endif
+#if ANO_MGR_AF_XDP
+#include "advanced_network/managers/af_xdp/adv_network_af_xdp_mgr.h"
+#endif
 
 #if ANO_MGR_DPDK || ANO_MGR_GPUNETIO
 #include <rte_common.h>
@@ -50,6 +67,10 @@ ManagerType ManagerFactory::get_default_manager_type() {
   mgr_type = ManagerType::DOCA;
 #elif ANO_MGR_RIVERMAX
   mgr_type = ManagerType::RIVERMAX;
+#elif ANO_MGR_RDMA
+  mgr_type = ManagerType::RDMA;
+#elif ANO_MGR_AF_XDP
+  mgr_type = ManagerType::AF_XDP;
 #else
 #error "No Advanced Network manager defined"
 #endif
@@ -73,6 +94,16 @@ std::unique_ptr<Manager> ManagerFactory::create_instance(ManagerType type) {
     case ManagerType::RIVERMAX:
       _manager = std::make_unique<RmaxMgr>();
       break;
+#endif
+#if ANO_MGR_RDMA
+    case ManagerType::RDMA:
+      _manager = std::make_unique<RdmaMgr>();
+      break;
+#endif
+#if ANO_MGR_AF_XDP
+    case ManagerType::AF_XDP:
+      _manager = std::make_unique<AfXdpMgr>();
+      break;
 #endif
     case ManagerType::DEFAULT:
       _manager = create_instance(get_default_manager_type());
@@ -112,86 +143,324 @@ ManagerType ManagerFactory::get_manager_type(const Config& config) {
 
 template ManagerType ManagerFactory::get_manager_type<Config>(const Config&);
 
-Status Manager::allocate_memory_regions() {
-  HOLOSCAN_LOG_INFO("Registering memory regions");
 #if ANO_MGR_DPDK || ANO_MGR_GPUNETIO
-  for (auto& mr : cfg_.mrs_) {
-    void* ptr;
-    AllocRegion ar;
-    mr.second.ttl_size_ = RTE_ALIGN_CEIL(mr.second.adj_size_ * mr.second.num_bufs_, GPU_PAGE_SIZE);
-
-    if (mr.second.owned_) {
-      switch (mr.second.kind_) {
-        case MemoryKind::HOST:
-          ptr = malloc(mr.second.ttl_size_);
-          break;
-        case MemoryKind::HOST_PINNED:
-          if (cudaHostAlloc(&ptr, mr.second.ttl_size_, 0) != cudaSuccess) {
-            HOLOSCAN_LOG_CRITICAL("Failed to allocate CUDA pinned host memory!");
-            return Status::NULL_PTR;
-          }
-          break;
-        case MemoryKind::HUGE:
-          ptr = rte_malloc_socket(nullptr, mr.second.ttl_size_, 0, mr.second.affinity_);
-          break;
-        case MemoryKind::DEVICE: {
-          unsigned int flag = 1;
-          const auto align = RTE_ALIGN_CEIL(mr.second.ttl_size_, GPU_PAGE_SIZE);
-          CUdeviceptr cuptr;
-
-          cudaSetDevice(mr.second.affinity_);
-          cudaFree(0);  // Create primary context if it doesn't exist
-          const auto alloc_res = cuMemAlloc(&cuptr, align);
-
-          if (alloc_res != CUDA_SUCCESS) {
-            const char* err_str = nullptr;
-            cuGetErrorString(alloc_res, &err_str);
-            HOLOSCAN_LOG_CRITICAL("Could not allocate {:.2f}MB of GPU memory. Error: {}",
-                                  align / 1e6,
-                                  err_str);
-            return Status::NULL_PTR;
-          }
-
-          ptr = reinterpret_cast<void*>(cuptr);
-
-          const auto attr_res =
-              cuPointerSetAttribute(&flag, CU_POINTER_ATTRIBUTE_SYNC_MEMOPS, cuptr);
-          if (attr_res != CUDA_SUCCESS) {
-            HOLOSCAN_LOG_CRITICAL("Could not set pointer attributes");
-            return Status::NULL_PTR;
-          }
-          break;
+/**
+ * @brief Allocate the memory of one memory region, faulting its pages in if requested
+ */
+static Status allocate_memory_region(MemoryRegionConfig& mr, void** ptr_out, size_t gpu_page_size) {
+  void* ptr = nullptr;
+  mr.ttl_size_ = RTE_ALIGN_CEIL(mr.adj_size_ * mr.num_bufs_, gpu_page_size);
+
+  if (mr.owned_) {
+    switch (mr.kind_) {
+      case MemoryKind::HOST:
+        ptr = malloc(mr.ttl_size_);
+        break;
+      case MemoryKind::HOST_PINNED:
+        if (cudaHostAlloc(&ptr, mr.ttl_size_, 0) != cudaSuccess) {
+          HOLOSCAN_LOG_CRITICAL("Failed to allocate CUDA pinned host memory!");
+          return Status::NULL_PTR;
+        }
+        break;
+      case MemoryKind::HUGE:
+        ptr = rte_malloc_socket(nullptr, mr.ttl_size_, 0, mr.affinity_);
+        break;
+      case MemoryKind::DEVICE: {
+        unsigned int flag = 1;
+        const auto align = RTE_ALIGN_CEIL(mr.ttl_size_, gpu_page_size);
+        CUdeviceptr cuptr;
+
+        cudaSetDevice(mr.affinity_);
+        cudaFree(0);  // Create primary context if it doesn't exist
+        const auto alloc_res = cuMemAlloc(&cuptr, align);
+
+        if (alloc_res != CUDA_SUCCESS) {
+          const char* err_str = nullptr;
+          cuGetErrorString(alloc_res, &err_str);
+          HOLOSCAN_LOG_CRITICAL("Could not allocate {:.2f}MB of GPU memory. Error: {}",
+                                align / 1e6,
+                                err_str);
+          return Status::NULL_PTR;
         }
-        default:
-          HOLOSCAN_LOG_ERROR("Unknown memory type {}!", static_cast<int>(mr.second.kind_));
-          return Status::INVALID_PARAMETER;
-      }
 
-      if (ptr == nullptr) {
-        HOLOSCAN_LOG_CRITICAL("Fatal to allocate {} of type {} for MR",
-                              mr.second.ttl_size_,
-                              static_cast<int>(mr.second.kind_));
-        return Status::NULL_PTR;
+        ptr = reinterpret_cast<void*>(cuptr);
+
+        const auto attr_res =
+            cuPointerSetAttribute(&flag, CU_POINTER_ATTRIBUTE_SYNC_MEMOPS, cuptr);
+        if (attr_res != CUDA_SUCCESS) {
+          HOLOSCAN_LOG_CRITICAL("Could not set pointer attributes");
+          return Status::NULL_PTR;
+        }
+        break;
       }
+      default:
+        HOLOSCAN_LOG_ERROR("Unknown memory type {}!", static_cast<int>(mr.kind_));
+        return Status::INVALID_PARAMETER;
+    }
+
+    if (ptr == nullptr) {
+      HOLOSCAN_LOG_CRITICAL("Fatal to allocate {} of type {} for MR",
+                            mr.ttl_size_,
+                            static_cast<int>(mr.kind_));
+      return Status::NULL_PTR;
+    }
+
+    // Pinned and GPU memory is backed at allocation already
+    if (mr.prefault_ && (mr.kind_ == MemoryKind::HOST || mr.kind_ == MemoryKind::HUGE)) {
+      const size_t page_size = sysconf(_SC_PAGESIZE);
+      auto* bytes = static_cast<volatile uint8_t*>(ptr);
+      for (size_t off = 0; off < mr.ttl_size_; off += page_size) { bytes[off] = 0; }
+      HOLOSCAN_LOG_INFO("Prefaulted {} bytes of memory region {}", mr.ttl_size_, mr.name_);
     }
+  }
+
+  HOLOSCAN_LOG_INFO(
+      "Successfully allocated memory region {} at {} type {} with {} bytes "
+      "({} elements @ {} bytes total {})",
+      mr.name_,
+      ptr,
+      (int)mr.kind_,
+      mr.buf_size_,
+      mr.num_bufs_,
+      mr.adj_size_,
+      mr.ttl_size_);
+  *ptr_out = ptr;
+  return Status::SUCCESS;
+}
+#endif
+
+std::string normalize_pci_addr(const std::string& addr) {
+  std::string bdf = addr;
+  std::transform(bdf.begin(), bdf.end(), bdf.begin(), ::tolower);
+  const auto colon = bdf.find(':');
+  if (colon == std::string::npos) { return bdf; }
+  if (bdf.find(':', colon + 1) == std::string::npos) {
+    bdf = "0000:" + bdf;
+  } else if (colon > 4) {
+    bdf = bdf.substr(colon - 4);  // CUDA may report an 8 digit domain
+  }
+  return bdf;
+}
+
+Status Manager::allocate_memory_regions() {
+  HOLOSCAN_LOG_INFO("Registering memory regions");
+#if ANO_MGR_DPDK || ANO_MGR_GPUNETIO
+  // Each region is allocated, and faulted in if requested, from its own thread so that large
+  // regions on different NUMA nodes and GPUs don't wait on each other
+  std::vector<MemoryRegionConfig*> mrs;
+  for (auto& mr : cfg_.mrs_) { mrs.push_back(&mr.second); }
+
+  std::vector<void*> ptrs(mrs.size(), nullptr);
+  std::vector<Status> results(mrs.size(), Status::SUCCESS);
+  std::vector<std::thread> threads;
+  for (size_t i = 0; i < mrs.size(); i++) {
+    threads.emplace_back([&, i]() {
+      results[i] = allocate_memory_region(*mrs[i], &ptrs[i], GPU_PAGE_SIZE);
+    });
+  }
+  for (auto& t : threads) { t.join(); }
 
-    HOLOSCAN_LOG_INFO(
-        "Successfully allocated memory region {} at {} type {} with {} bytes "
-        "({} elements @ {} bytes total {})",
-        mr.second.name_,
-        ptr,
-        (int)mr.second.kind_,
-        mr.second.buf_size_,
-        mr.second.num_bufs_,
-        mr.second.adj_size_,
-        mr.second.ttl_size_);
-    ar_[mr.second.name_] = {mr.second.name_, ptr};
+  // The regions that were allocated are recorded even when another one failed, so that none
+  // of them is lost
+  for (size_t i = 0; i < mrs.size(); i++) {
+    if (results[i] == Status::SUCCESS) { ar_[mrs[i]->name_] = {mrs[i]->name_, ptrs[i]}; }
+  }
+  for (const auto result : results) {
+    if (result != Status::SUCCESS) { return result; }
   }
 #endif
   HOLOSCAN_LOG_INFO("Finished allocating memory regions");
   return Status::SUCCESS;
 }
 
+namespace {
+
+std::string read_sysfs_line(const std::string& path) {
+  std::ifstream f(path);
+  std::string line;
+  if (f.is_open()) { std::getline(f, line); }
+  return line;
+}
+
+/**
+ * @brief Parse a kernel CPU list such as "0-3,8,10-11"
+ */
+std::vector<int> parse_cpu_list(const std::string& list) {
+  std::vector<int> cpus;
+  std::stringstream ss(list);
+  std::string range;
+  while (std::getline(ss, range, ',')) {
+    if (range.empty()) { continue; }
+    const auto dash = range.find('-');
+    const int first = strtol(range.c_str(), nullptr, 10);
+    const int last = (dash == std::string::npos) ? first
+                                                 : strtol(range.c_str() + dash + 1, nullptr, 10);
+    for (int cpu = first; cpu <= last; cpu++) { cpus.push_back(cpu); }
+  }
+  return cpus;
+}
+
+/**
+ * @brief Resolved sysfs path of a PCIe device, which encodes its position in the PCIe tree
+ */
+std::string pci_sysfs_path(const std::string& bdf) {
+  char path[PATH_MAX];
+  const std::string link = "/sys/bus/pci/devices/" + bdf;
+  if (realpath(link.c_str(), path) == nullptr) { return ""; }
+  return path;
+}
+
+int pci_numa_node(const std::string& bdf) {
+  const auto node = read_sysfs_line("/sys/bus/pci/devices/" + bdf + "/numa_node");
+  return node.empty() ? -1 : strtol(node.c_str(), nullptr, 10);
+}
+
+/**
+ * @brief Number of PCIe hops between two devices, based on their common sysfs path prefix
+ */
+int pci_distance(const std::string& path_a, const std::string& path_b) {
+  std::vector<std::string> a, b;
+  std::string comp;
+  std::stringstream ssa(path_a), ssb(path_b);
+  while (std::getline(ssa, comp, '/')) { a.push_back(comp); }
+  while (std::getline(ssb, comp, '/')) { b.push_back(comp); }
+  size_t common = 0;
+  while (common < a.size() && common < b.size() && a[common] == b[common]) { common++; }
+  return static_cast<int>(a.size() + b.size() - 2 * common);
+}
+
+}  // namespace
+
+Status Manager::resolve_auto_affinity(NetworkConfig& cfg) {
+  std::set<int> used_cores = {0, cfg.common_.master_core_};
+  bool has_auto = false;
+
+  for (const auto& intf : cfg.ifs_) {
+    auto add_used = [&](const CommonQueueConfig& common) {
+      if (common.cpu_core_ == CPU_CORE_AUTO) {
+        has_auto = true;
+        return;
+      }
+      for (int core : parse_cpu_list(common.cpu_core_)) { used_cores.insert(core); }
+    };
+    for (const auto& q : intf.rx_.queues_) { add_used(q.common_); }
+    for (const auto& q : intf.tx_.queues_) { add_used(q.common_); }
+  }
+  for (const auto& mr : cfg.mrs_) { has_auto |= (mr.second.affinity_ == MR_AFFINITY_AUTO); }
+
+  if (!has_auto) { return Status::SUCCESS; }
+
+  HOLOSCAN_LOG_INFO("Resolving automatic CPU core and memory affinity");
+  const auto isolated = parse_cpu_list(read_sysfs_line("/sys/devices/system/cpu/isolated"));
+  const auto online = parse_cpu_list(read_sysfs_line("/sys/devices/system/cpu/online"));
+  const std::set<int> isolated_set(isolated.begin(), isolated.end());
+
+  for (auto& intf : cfg.ifs_) {
+    const auto bdf = normalize_pci_addr(intf.address_);
+    const int numa = pci_numa_node(bdf);
+    auto local = parse_cpu_list(read_sysfs_line("/sys/bus/pci/devices/" + bdf + "/local_cpulist"));
+    if (local.empty()) {
+      HOLOSCAN_LOG_WARN("No CPU locality found for interface {} ({}), using all online cores",
+                        intf.name_, intf.address_);
+      local = online;
+    }
+
+    // Isolated cores near the NIC first, then the other NIC-local cores
+    auto next_core = [&]() {
+      for (int core : local) {
+        if (isolated_set.count(core) && !used_cores.count(core)) { return core; }
+      }
+      for (int core : local) {
+        if (!used_cores.count(core)) { return core; }
+      }
+      return -1;
+    };
+
+    auto assign = [&](CommonQueueConfig& common, const char* dir) {
+      if (common.cpu_core_ != CPU_CORE_AUTO) { return true; }
+      const int core = next_core();
+      if (core < 0) {
+        HOLOSCAN_LOG_ERROR("No free CPU core local to interface {} for {} queue {}",
+                           intf.name_, dir, common.name_);
+        return false;
+      }
+      used_cores.insert(core);
+      common.cpu_core_ = std::to_string(core);
+      HOLOSCAN_LOG_INFO("Interface {} ({}, NUMA node {}) {} queue {}: CPU core {}{}",
+                        intf.name_, bdf, numa, dir, common.name_, core,
+                        isolated_set.count(core) ? " (isolated)" : "");
+      return true;
+    };
+
+    for (auto& q : intf.rx_.queues_) {
+      if (!assign(q.common_, "RX")) { return Status::INVALID_PARAMETER; }
+    }
+    for (auto& q : intf.tx_.queues_) {
+      if (!assign(q.common_, "TX")) { return Status::INVALID_PARAMETER; }
+    }
+  }
+
+  for (auto& [name, mr] : cfg.mrs_) {
+    if (mr.affinity_ != MR_AFFINITY_AUTO) { continue; }
+
+    // Place the region near the first interface that has a queue using it
+    std::string nic_bdf;
+    for (const auto& intf : cfg.ifs_) {
+      auto uses_mr = [&](const CommonQueueConfig& common) {
+        return std::find(common.mrs_.begin(), common.mrs_.end(), name) != common.mrs_.end();
+      };
+      for (const auto& q : intf.rx_.queues_) {
+        if (nic_bdf.empty() && uses_mr(q.common_)) { nic_bdf = normalize_pci_addr(intf.address_); }
+      }
+      for (const auto& q : intf.tx_.queues_) {
+        if (nic_bdf.empty() && uses_mr(q.common_)) { nic_bdf = normalize_pci_addr(intf.address_); }
+      }
+    }
+
+    if (nic_bdf.empty()) {
+      HOLOSCAN_LOG_WARN("Memory region {} is not used by any queue, using affinity 0", name);
+      mr.affinity_ = 0;
+      continue;
+    }
+
+    const int nic_numa = pci_numa_node(nic_bdf);
+    if (mr.kind_ != MemoryKind::DEVICE) {
+      mr.affinity_ = nic_numa < 0 ? 0 : nic_numa;
+      HOLOSCAN_LOG_INFO("Memory region {}: NUMA node {} (NIC {})", name, mr.affinity_, nic_bdf);
+      continue;
+    }
+
+    int num_gpus = 0;
+    if (cudaGetDeviceCount(&num_gpus) != cudaSuccess || num_gpus == 0) {
+      HOLOSCAN_LOG_ERROR("No GPU found to resolve the affinity of memory region {}", name);
+      return Status::INVALID_PARAMETER;
+    }
+
+    // Fewest PCIe hops from the NIC wins, preferring a GPU on the NIC's NUMA node on ties
+    const auto nic_path = pci_sysfs_path(nic_bdf);
+    int best_gpu = 0;
+    int best_score = INT_MAX;
+    for (int gpu = 0; gpu < num_gpus; gpu++) {
+      char bus_id[32];
+      if (cudaDeviceGetPCIBusId(bus_id, sizeof(bus_id), gpu) != cudaSuccess) { continue; }
+      const auto gpu_bdf = normalize_pci_addr(bus_id);
+      const auto gpu_path = pci_sysfs_path(gpu_bdf);
+      int score = (nic_path.empty() || gpu_path.empty()) ? INT_MAX / 4
+                                                         : pci_distance(nic_path, gpu_path) * 2;
+      if (pci_numa_node(gpu_bdf) != nic_numa) { score++; }
+      if (score < best_score) {
+        best_score = score;
+        best_gpu = gpu;
+      }
+    }
+
+    mr.affinity_ = best_gpu;
+    HOLOSCAN_LOG_INFO("Memory region {}: GPU {} (NIC {})", name, best_gpu, nic_bdf);
+  }
+
+  return Status::SUCCESS;
+}
+
 /**
  * @brief Generic implementation of get_port_id that looks up port in config
  * This is a final method that cannot be overridden by subclasses.
@@ -207,6 +476,108 @@ int Manager::get_port_id(const std::string& key) {
   return -1;
 }
 
+Status Manager::start_ptp_clocks() {
+  for (const auto& intf : cfg_.ifs_) {
+    if (!intf.ptp_.enabled_ || ptp_clocks_.count(intf.port_id_) != 0) { continue; }
+
+    const int port = intf.port_id_;
+    uint64_t ticks;
+    PtpClock::TickReader reader;
+    if (read_nic_clock(port, ticks)) {
+      reader = [this, port](uint64_t& t) { return read_nic_clock(port, t); };
+    }
+
+    auto clock = std::make_unique<PtpClock>(intf.ptp_, reader);
+    if (!clock->start(intf.address_)) {
+      HOLOSCAN_LOG_ERROR("Failed to start the PTP clock of interface {}", intf.name_);
+      return Status::INTERNAL_ERROR;
+    }
+    ptp_clocks_[port] = std::move(clock);
+  }
+
+  return Status::SUCCESS;
+}
+
+void Manager::stop_ptp_clocks() {
+  for (auto& clock : ptp_clocks_) { clock.second->stop(); }
+}
+
+PtpClock* Manager::get_ptp_clock(int port) const {
+  const auto it = ptp_clocks_.find(port);
+  return it == ptp_clocks_.end() ? nullptr : it->second.get();
+}
+
+Status Manager::get_ptp_time(int port, uint64_t* time) {
+  const auto clock = get_ptp_clock(port);
+  if (clock == nullptr) { return Status::NOT_SUPPORTED; }
+  return clock->now(*time) ? Status::SUCCESS : Status::INTERNAL_ERROR;
+}
+
+Status Manager::set_flow_demux(int port, int queue, const std::vector<FlowDemuxConfig>& flows) {
+  const auto key = std::make_pair(port, queue);
+  if (flows.empty()) {
+    flow_demuxes_.erase(key);
+    return Status::SUCCESS;
+  }
+
+  // Bursts of a queue hold at most a batch of packets
+  int batch_size = 0;
+  for (const auto& intf : cfg_.ifs_) {
+    if (intf.port_id_ != port) { continue; }
+    for (const auto& q : intf.rx_.queues_) {
+      if (q.common_.id_ == queue) { batch_size = q.common_.batch_size_; }
+    }
+  }
+  if (batch_size <= 0) {
+    HOLOSCAN_LOG_ERROR("Invalid port/queue combination in set_flow_demux: {}/{}", port, queue);
+    return Status::INVALID_PARAMETER;
+  }
+
+  auto demux = std::make_unique<FlowDemux>(flows, batch_size);
+  const auto ret = demux->init();
+  if (ret != Status::SUCCESS) { return ret; }
+
+  flow_demuxes_[key] = std::move(demux);
+  return Status::SUCCESS;
+}
+
+Status Manager::demux_rx_burst(BurstParams* burst, cudaStream_t stream) {
+  const auto it = flow_demuxes_.find({burst->hdr.hdr.port_id, burst->hdr.hdr.q_id});
+  if (it == flow_demuxes_.end()) { return Status::INVALID_PARAMETER; }
+  return it->second->demux(*this, burst, stream);
+}
+
+Status Manager::get_flow_demux_status(int port, int queue, uint16_t flow_id,
+                                      FlowDemuxStatus* status) {
+  const auto it = flow_demuxes_.find({port, queue});
+  if (it == flow_demuxes_.end()) { return Status::INVALID_PARAMETER; }
+  return it->second->get_status(flow_id, status);
+}
+
+Status Manager::reset_flow_demux(int port, int queue, uint16_t flow_id, uint64_t first_seq,
+                                 cudaStream_t stream) {
+  const auto it = flow_demuxes_.find({port, queue});
+  if (it == flow_demuxes_.end()) { return Status::INVALID_PARAMETER; }
+  return it->second->reset(flow_id, first_seq, stream);
+}
+
+// Per-packet fallbacks for managers without a faster way to walk a whole burst
+Status Manager::get_packet_ptrs(BurstParams* burst, int seg, void** out) {
+  if (seg < 0 || seg >= burst->hdr.hdr.num_segs) { return Status::INVALID_PARAMETER; }
+  for (int p = 0; p < static_cast<int>(burst->hdr.hdr.num_pkts); p++) {
+    out[p] = get_segment_packet_ptr(burst, seg, p);
+  }
+  return Status::SUCCESS;
+}
+
+Status Manager::get_packet_lengths(BurstParams* burst, int seg, uint16_t* out) {
+  if (seg < 0 || seg >= burst->hdr.hdr.num_segs) { return Status::INVALID_PARAMETER; }
+  for (int p = 0; p < static_cast<int>(burst->hdr.hdr.num_pkts); p++) {
+    out[p] = get_segment_packet_length(burst, seg, p);
+  }
+  return Status::SUCCESS;
+}
+
 bool Manager::validate_config() const {
   bool pass = true;
   std::set<std::string> mr_names;
@@ -259,6 +630,40 @@ void Manager::init_rx_core_q_map() {
   }
 }
 
+namespace {
+
+// RX ready callbacks by port/queue key, shared by every backend's RX workers
+std::shared_mutex rx_ready_mutex;
+std::unordered_map<uint32_t, std::function<void()>> rx_ready_callbacks;
+std::atomic<size_t> num_rx_ready_callbacks{0};
+
+uint32_t rx_ready_key(int port, int q) {
+  return (static_cast<uint32_t>(port) << 16) | static_cast<uint16_t>(q);
+}
+
+}  // namespace
+
+Status Manager::set_rx_ready_callback(int port, int q, std::function<void()> cb) {
+  if (get_rx_burst_count(port, q) < 0) { return Status::NOT_SUPPORTED; }
+
+  std::unique_lock<std::shared_mutex> lock(rx_ready_mutex);
+  if (cb) {
+    rx_ready_callbacks[rx_ready_key(port, q)] = std::move(cb);
+  } else {
+    rx_ready_callbacks.erase(rx_ready_key(port, q));
+  }
+  num_rx_ready_callbacks.store(rx_ready_callbacks.size(), std::memory_order_release);
+  return Status::SUCCESS;
+}
+
+void Manager::notify_rx_ready(int port, int q) {
+  if (num_rx_ready_callbacks.load(std::memory_order_acquire) == 0) { return; }
+
+  std::shared_lock<std::shared_mutex> lock(rx_ready_mutex);
+  const auto it = rx_ready_callbacks.find(rx_ready_key(port, q));
+  if (it != rx_ready_callbacks.end()) { it->second(); }
+}
+
 uint16_t Manager::get_num_rx_queues(int port_id) const {
   return cfg_.ifs_[port_id].rx_.queues_.size();
 }
@@ -316,4 +721,20 @@ Status Manager::get_rx_burst(BurstParams** burst) {
   return Status::NULL_PTR;
 }
 
+int Manager::get_rx_bursts(BurstParams** bursts, int max_bursts, int port, int q) {
+  int num_bursts = 0;
+
+  // Generic fallback for managers without a native batched dequeue
+  while (num_bursts < max_bursts) {
+    if (get_rx_burst(&bursts[num_bursts], port, q) != Status::SUCCESS) { break; }
+    num_bursts++;
+  }
+
+  return num_bursts;
+}
+
+void Manager::free_rx_bursts(BurstParams** bursts, int num_bursts) {
+  for (int i = 0; i < num_bursts; i++) { free_rx_burst(bursts[i]); }
+}
+
 };  // namespace holoscan::advanced_network
@@ -18,7 +18,13 @@
 #pragma once
 
 #include "advanced_network/types.h"
+#include "advanced_network/flow_demux.h"
+#include "advanced_network/ptp_clock.h"
+#include <functional>
+#include <map>
+#include <memory>
 #include <optional>
+#include <utility>
 
 namespace holoscan::advanced_network {
 
@@ -27,6 +33,14 @@ struct AllocRegion {
   void* ptr_;
 };
 
+/**
+ * @brief Normalize a PCIe address to the sysfs DDDD:BB:DD.F form
+ *
+ * The address is lowercased and given the 0000 domain when it has none. Anything that is not
+ * a PCIe address, such as an interface name, is only lowercased.
+ */
+std::string normalize_pci_addr(const std::string& addr);
+
 /**
  * @brief (Almost) ABC representing an interface into an advanced_network backend implementation
  *
@@ -45,6 +59,8 @@ class Manager {
   virtual uint16_t get_packet_length(BurstParams* burst, int idx) = 0;
   virtual void* get_segment_packet_ptr(BurstParams* burst, int seg, int idx) = 0;
   virtual uint16_t get_segment_packet_length(BurstParams* burst, int seg, int idx) = 0;
+  virtual Status get_packet_ptrs(BurstParams* burst, int seg, void** out);
+  virtual Status get_packet_lengths(BurstParams* burst, int seg, uint16_t* out);
   virtual uint16_t get_packet_flow_id(BurstParams* burst, int idx) = 0;
   virtual void* get_packet_extra_info(BurstParams* burst, int idx) = 0;
   virtual Status get_tx_packet_burst(BurstParams* burst) = 0;
@@ -54,6 +70,19 @@ class Manager {
   virtual Status set_udp_header(BurstParams* burst, int idx, int udp_len, uint16_t src_port,
                                 uint16_t dst_port) = 0;
   virtual Status set_udp_payload(BurstParams* burst, int idx, void* data, int len) = 0;
+  virtual Status get_tx_large_send_burst(BurstParams* burst, const void* hdr, int hdr_len,
+                                         const void* data, int len, int seg_size) {
+    return Status::NOT_SUPPORTED;
+  }
+  virtual Status register_tx_buffer(int port, void* addr, size_t len) {
+    return Status::NOT_SUPPORTED;
+  }
+  virtual Status unregister_tx_buffer(int port, void* addr) { return Status::NOT_SUPPORTED; }
+  virtual Status get_tx_ext_buffer_burst(BurstParams* burst, const void* hdr, int hdr_len,
+                                         void* const* bufs, const uint16_t* lens,
+                                         TxBufferFreeCallback free_cb, void* cb_arg) {
+    return Status::NOT_SUPPORTED;
+  }
   virtual bool is_tx_burst_available(BurstParams* burst) = 0;
 
   virtual Status set_packet_lengths(BurstParams* burst, int idx,
@@ -72,6 +101,9 @@ class Manager {
   virtual Status get_rx_burst(BurstParams** burst, int port, int q) = 0;
   virtual Status get_rx_burst(BurstParams** burst, int port_id);
   virtual Status get_rx_burst(BurstParams** burst);
+  virtual int get_rx_bursts(BurstParams** bursts, int max_bursts, int port, int q);
+  virtual int get_rx_burst_count(int port, int q) { return -1; }
+  virtual void free_rx_bursts(BurstParams** bursts, int num_bursts);
   virtual void free_rx_metadata(BurstParams* burst) = 0;
   virtual void free_tx_metadata(BurstParams* burst) = 0;
   virtual Status get_tx_metadata_buffer(BurstParams** burst) = 0;
@@ -80,9 +112,60 @@ class Manager {
   virtual int get_port_id(const std::string& key) final;  // NOLINT(readability/inheritance)
   virtual bool validate_config() const;
   virtual uint16_t get_num_rx_queues(int port_id) const;
+  virtual std::vector<QueueLatencyStats> get_queue_latency_stats() const { return {}; }
+  virtual Status get_stats(ManagerStats& stats) { return Status::NOT_SUPPORTED; }
+  virtual Status add_flow(int port, const FlowConfig& flow) { return Status::NOT_SUPPORTED; }
+  virtual Status remove_flow(int port, uint16_t flow_id) { return Status::NOT_SUPPORTED; }
+  virtual Status get_burst_frame_info(BurstParams* burst, BurstFrameInfo* info) {
+    return Status::NOT_SUPPORTED;
+  }
+  virtual Status get_ptp_time(int port, uint64_t* time);
+
+  /**
+   * @brief Open the PTP hardware clock of every interface enabling `ptp`
+   *
+   * The NIC clock of an interface is sampled against its PHC when read_nic_clock can read it.
+   * Interfaces whose clock is already started are skipped.
+   */
+  Status start_ptp_clocks();
+  void stop_ptp_clocks();
+
+  Status set_flow_demux(int port, int queue, const std::vector<FlowDemuxConfig>& flows);
+  Status demux_rx_burst(BurstParams* burst, cudaStream_t stream);
+  Status get_flow_demux_status(int port, int queue, uint16_t flow_id, FlowDemuxStatus* status);
+  Status reset_flow_demux(int port, int queue, uint16_t flow_id, uint64_t first_seq,
+                          cudaStream_t stream);
+
+  /**
+   * @brief Set the function called whenever bursts are handed to the application on a queue
+   *
+   * Only managers implementing get_rx_burst_count call notify_rx_ready from their RX workers.
+   * An empty function removes the callback of the queue.
+   */
+  Status set_rx_ready_callback(int port, int q, std::function<void()> cb);
+
+  /**
+   * @brief Run the RX ready callback of a queue, if any
+   *
+   * Called by the RX workers of a backend after enqueuing bursts of a queue. Costs one atomic
+   * load when no callback is set.
+   */
+  static void notify_rx_ready(int port, int q);
 
   virtual ~Manager() = default;
 
+  /**
+   * @brief Resolve `cpu_core: auto` and `affinity: auto` entries of a configuration
+   *
+   * Reads the PCIe topology from sysfs to place each queue on a core local to its NIC (isolated
+   * cores first, skipping core 0, the master core and cores already used in the config) and
+   * each memory region on the NUMA node or the GPU closest to the NIC using it.
+   *
+   * @param cfg Configuration to update in place
+   * @return Status::SUCCESS on success, or an error if an auto value couldn't be resolved
+   */
+  static Status resolve_auto_affinity(NetworkConfig& cfg);
+
  protected:
   static constexpr int MAX_IFS = 4;
   static constexpr int MAX_GPUS = 8;
@@ -99,8 +182,17 @@ class Manager {
   size_t next_port_index_ = 0;                            // For get_rx_burst next port check
   std::unordered_map<int, size_t> next_queue_index_map_;  // For get_rx_burst next queue check
 
+  std::unordered_map<int, std::unique_ptr<PtpClock>> ptp_clocks_;
+  std::map<std::pair<int, int>, std::unique_ptr<FlowDemux>> flow_demuxes_;
+
   virtual Status allocate_memory_regions();
   virtual void adjust_memory_regions() {}
+
+  /**
+   * @brief Read the device clock of a port, in the units of its RX and TX timestamps
+   */
+  virtual bool read_nic_clock(int port, uint64_t& ticks) { return false; }
+  PtpClock* get_ptp_clock(int port) const;
   void init_rx_core_q_map();
 };
 
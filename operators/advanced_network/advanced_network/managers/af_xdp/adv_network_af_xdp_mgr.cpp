@@ -0,0 +1,803 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <arpa/inet.h>
+#include <dirent.h>
+#include <linux/if_link.h>
+#include <linux/if_xdp.h>
+#include <net/if.h>
+#include <sys/ioctl.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+
+#include "adv_network_af_xdp_mgr.h"
+#include "holoscan/holoscan.hpp"
+
+// Busy polling options, missing from older kernel headers
+#ifndef SO_PREFER_BUSY_POLL
+#define SO_PREFER_BUSY_POLL 69
+#endif
+#ifndef SO_BUSY_POLL_BUDGET
+#define SO_BUSY_POLL_BUDGET 70
+#endif
+
+namespace holoscan::advanced_network {
+
+static inline uint32_t generate_queue_key(int port_id, int queue_id) {
+  return (static_cast<uint32_t>(port_id) << 16) | static_cast<uint32_t>(queue_id);
+}
+
+namespace {
+
+constexpr size_t HUGEPAGE_SIZE = 2 * 1024 * 1024;
+
+uint64_t now_ns() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+uint32_t next_pow2(uint32_t v) {
+  uint32_t p = 1;
+  while (p < v) { p <<= 1; }
+  return p;
+}
+
+/**
+ * @brief Frame size of a buffer in aligned UMEM mode, which the kernel prefixes with
+ * XDP_PACKET_HEADROOM
+ */
+uint32_t frame_size_for(size_t buf_size) {
+  return std::max<uint32_t>(2048, next_pow2(buf_size + XDP_PACKET_HEADROOM));
+}
+
+/**
+ * @brief Network interface of a PCIe address, or the address itself when it's a link name
+ */
+std::string resolve_ifname(const std::string& address) {
+  if (if_nametoindex(address.c_str()) != 0) { return address; }
+
+  const std::string dir = "/sys/bus/pci/devices/" + normalize_pci_addr(address) + "/net";
+  std::string ifname;
+  if (DIR* d = opendir(dir.c_str())) {
+    while (struct dirent* entry = readdir(d)) {
+      if (entry->d_name[0] != '.') {
+        ifname = entry->d_name;
+        break;
+      }
+    }
+    closedir(d);
+  }
+  return ifname;
+}
+
+uint16_t ipv4_checksum(const struct iphdr* ip) {
+  auto words = reinterpret_cast<const uint16_t*>(ip);
+  uint32_t sum = 0;
+  for (int i = 0; i < ip->ihl * 2; i++) { sum += words[i]; }
+  while (sum >> 16) { sum = (sum & 0xFFFF) + (sum >> 16); }
+  return static_cast<uint16_t>(~sum);
+}
+
+}  // namespace
+
+AfXdpMgr::~AfXdpMgr() {
+  shutdown();
+}
+
+bool AfXdpMgr::set_config_and_initialize(const NetworkConfig& cfg) {
+  if (!this->initialized_) {
+    cfg_ = cfg;
+    adjust_memory_regions();
+
+    if (!validate_config()) {
+      HOLOSCAN_LOG_CRITICAL("Config validation failed");
+      return false;
+    }
+
+    initialize();
+    if (!this->initialized_) {
+      HOLOSCAN_LOG_CRITICAL("Failed to initialize AF_XDP");
+      return false;
+    }
+
+    run();
+  }
+
+  return true;
+}
+
+void AfXdpMgr::adjust_memory_regions() {
+  for (auto& mr : cfg_.mrs_) { mr.second.adj_size_ = frame_size_for(mr.second.buf_size_); }
+}
+
+bool AfXdpMgr::validate_config() const {
+  bool pass = Manager::validate_config();
+  std::unordered_map<std::string, std::string> mr_queues;
+  const auto page_size = static_cast<size_t>(getpagesize());
+
+  for (const auto& intf : cfg_.ifs_) {
+    if (!intf.rx_.flows_.empty()) {
+      HOLOSCAN_LOG_WARN("Flows of interface {} are ignored, steer traffic to the RX queues with "
+                        "ethtool", intf.name_);
+    }
+
+    auto check_queue = [&](const CommonQueueConfig& q) {
+      if (q.mrs_.size() != 1) {
+        HOLOSCAN_LOG_ERROR("Queue {} must use exactly one memory region with AF_XDP", q.name_);
+        pass = false;
+        return;
+      }
+      // The frames of a queue are part of the UMEM of its socket
+      const auto [it, inserted] = mr_queues.emplace(q.mrs_[0], q.name_);
+      if (!inserted) {
+        HOLOSCAN_LOG_ERROR("Memory region {} is used by queues {} and {}, each AF_XDP queue needs "
+                           "its own", q.mrs_[0], it->second, q.name_);
+        pass = false;
+      }
+      const auto mr = cfg_.mrs_.find(q.mrs_[0]);
+      if (mr == cfg_.mrs_.end()) { return; }
+      if (mr->second.kind_ != MemoryKind::HUGE && mr->second.kind_ != MemoryKind::HOST) {
+        HOLOSCAN_LOG_ERROR("Memory region {} must be of kind huge or host with AF_XDP",
+                           q.mrs_[0]);
+        pass = false;
+      }
+      if (mr->second.adj_size_ > page_size) {
+        HOLOSCAN_LOG_ERROR("Buffers of memory region {} are {} bytes, AF_XDP frames hold at most "
+                           "{} bytes", q.mrs_[0], mr->second.buf_size_,
+                           page_size - XDP_PACKET_HEADROOM);
+        pass = false;
+      }
+    };
+    for (const auto& q : intf.rx_.queues_) { check_queue(q.common_); }
+    for (const auto& q : intf.tx_.queues_) { check_queue(q.common_); }
+  }
+
+  return pass;
+}
+
+int AfXdpMgr::open_port(InterfaceConfig& intf) {
+  const auto ifname = resolve_ifname(intf.address_);
+  if (ifname.empty()) {
+    HOLOSCAN_LOG_CRITICAL("No network interface found for {} ({})", intf.name_, intf.address_);
+    return -1;
+  }
+
+  std::array<char, 6> mac = {};
+  struct ifreq ifr = {};
+  const int fd = socket(AF_INET, SOCK_DGRAM, 0);
+  strncpy(ifr.ifr_name, ifname.c_str(), IFNAMSIZ - 1);
+  if (fd < 0 || ioctl(fd, SIOCGIFHWADDR, &ifr) < 0) {
+    HOLOSCAN_LOG_CRITICAL("Failed to get the MAC address of {}", ifname);
+    if (fd >= 0) { close(fd); }
+    return -1;
+  }
+  close(fd);
+  memcpy(mac.data(), ifr.ifr_hwaddr.sa_data, mac.size());
+
+  HOLOSCAN_LOG_INFO("{} ({}): using network interface {}", intf.name_, intf.address_, ifname);
+  ifnames_.push_back(ifname);
+  mac_addrs_.push_back(mac);
+  return 0;
+}
+
+int AfXdpMgr::create_socket(const InterfaceConfig& intf, AfXdpQueue& q, const std::string& rx_mr,
+                            const std::string& tx_mr) {
+  const auto mr_kind = cfg_.mrs_.at(q.has_rx ? rx_mr : tx_mr).kind_;
+  q.port_id = intf.port_id_;
+  q.frame_size = cfg_.mrs_.at(q.has_rx ? rx_mr : tx_mr).adj_size_;
+  q.rx_frames = q.has_rx ? cfg_.mrs_.at(rx_mr).num_bufs_ : 0;
+  q.tx_frames = q.has_tx ? cfg_.mrs_.at(tx_mr).num_bufs_ : 0;
+  if (q.has_rx && q.has_tx && cfg_.mrs_.at(tx_mr).adj_size_ != q.frame_size) {
+    HOLOSCAN_LOG_CRITICAL("RX and TX queue {} of {} need buffers of the same frame size",
+                          q.q_id,
+                          intf.name_);
+    return -1;
+  }
+
+  // One UMEM per socket, in hugepages when the memory regions are
+  const size_t size = static_cast<size_t>(q.rx_frames + q.tx_frames) * q.frame_size;
+  const bool huge = mr_kind == MemoryKind::HUGE;
+  q.area_size = huge ? (size + HUGEPAGE_SIZE - 1) & ~(HUGEPAGE_SIZE - 1) : size;
+  void* area = mmap(nullptr,
+                    q.area_size,
+                    PROT_READ | PROT_WRITE,
+                    MAP_PRIVATE | MAP_ANONYMOUS | MAP_POPULATE | (huge ? MAP_HUGETLB : 0),
+                    -1,
+                    0);
+  if (area == MAP_FAILED) {
+    HOLOSCAN_LOG_CRITICAL("Failed to map {} bytes of {} for the UMEM of queue {}: {}",
+                          q.area_size,
+                          huge ? "hugepages" : "memory",
+                          q.q_id,
+                          strerror(errno));
+    return -1;
+  }
+  q.area = static_cast<char*>(area);
+  if (q.has_rx) { ar_[rx_mr] = {rx_mr, q.area}; }
+  if (q.has_tx) { ar_[tx_mr] = {tx_mr, q.area + static_cast<size_t>(q.rx_frames) * q.frame_size}; }
+
+  struct xsk_umem_config umem_cfg = {};
+  umem_cfg.fill_size = next_pow2(std::max<uint32_t>(q.rx_frames, XSK_RING_PROD__DEFAULT_NUM_DESCS));
+  umem_cfg.comp_size = next_pow2(std::max<uint32_t>(q.tx_frames, XSK_RING_CONS__DEFAULT_NUM_DESCS));
+  umem_cfg.frame_size = q.frame_size;
+  umem_cfg.frame_headroom = 0;
+  umem_cfg.flags = 0;
+  int ret = xsk_umem__create(&q.umem, q.area, q.area_size, &q.fq, &q.cq, &umem_cfg);
+  if (ret != 0) {
+    HOLOSCAN_LOG_CRITICAL("Failed to create the UMEM of queue {}: {}", q.q_id, strerror(-ret));
+    return -1;
+  }
+
+  // Bound to the queue ID of the NIC, with the default XDP program redirecting its packets
+  struct xsk_socket_config xsk_cfg = {};
+  xsk_cfg.rx_size = umem_cfg.fill_size;
+  xsk_cfg.tx_size = umem_cfg.comp_size;
+  xsk_cfg.xdp_flags = XDP_FLAGS_UPDATE_IF_NOEXIST;
+  xsk_cfg.bind_flags = XDP_USE_NEED_WAKEUP | (intf.af_xdp_.zero_copy_ ? XDP_ZEROCOPY : XDP_COPY);
+  const auto& ifname = ifnames_[intf.port_id_];
+  ret = xsk_socket__create(&q.xsk, ifname.c_str(), q.q_id, q.umem, q.has_rx ? &q.rx : nullptr,
+                           q.has_tx ? &q.tx : nullptr, &xsk_cfg);
+  if (ret != 0 && intf.af_xdp_.zero_copy_) {
+    HOLOSCAN_LOG_WARN("{} queue {} has no zero-copy AF_XDP support, using copy mode",
+                      ifname,
+                      q.q_id);
+    xsk_cfg.bind_flags = XDP_USE_NEED_WAKEUP | XDP_COPY;
+    ret = xsk_socket__create(&q.xsk, ifname.c_str(), q.q_id, q.umem, q.has_rx ? &q.rx : nullptr,
+                             q.has_tx ? &q.tx : nullptr, &xsk_cfg);
+  }
+  if (ret != 0) {
+    HOLOSCAN_LOG_CRITICAL("Failed to create the AF_XDP socket of {} queue {}: {}",
+                          ifname,
+                          q.q_id,
+                          strerror(-ret));
+    return -1;
+  }
+
+  // Busy polling runs the driver from the application thread instead of softirqs
+  if (intf.af_xdp_.busy_poll_us_ > 0) {
+    const int fd = xsk_socket__fd(q.xsk);
+    const int prefer = 1;
+    const int timeout = intf.af_xdp_.busy_poll_us_;
+    const int budget = std::max<uint32_t>(q.rx_batch_size, 64);
+    if (setsockopt(fd, SOL_SOCKET, SO_PREFER_BUSY_POLL, &prefer, sizeof(prefer)) < 0 ||
+        setsockopt(fd, SOL_SOCKET, SO_BUSY_POLL, &timeout, sizeof(timeout)) < 0 ||
+        setsockopt(fd, SOL_SOCKET, SO_BUSY_POLL_BUDGET, &budget, sizeof(budget)) < 0) {
+      HOLOSCAN_LOG_WARN("Busy polling unavailable on {} queue {}: {}",
+                        ifname,
+                        q.q_id,
+                        strerror(errno));
+    } else {
+      q.busy_poll = true;
+    }
+  }
+
+  // The whole RX ring of frames starts in the fill ring
+  if (q.has_rx) {
+    uint32_t idx = 0;
+    if (xsk_ring_prod__reserve(&q.fq, q.rx_frames, &idx) != q.rx_frames) {
+      HOLOSCAN_LOG_CRITICAL("Failed to fill the fill ring of queue {}", q.q_id);
+      return -1;
+    }
+    for (uint32_t i = 0; i < q.rx_frames; i++) {
+      *xsk_ring_prod__fill_addr(&q.fq, idx + i) = static_cast<uint64_t>(i) * q.frame_size;
+    }
+    xsk_ring_prod__submit(&q.fq, q.rx_frames);
+  }
+
+  q.tx_free_frames.reserve(q.tx_frames);
+  for (uint32_t i = 0; i < q.tx_frames; i++) {
+    q.tx_free_frames.push_back(static_cast<uint64_t>(q.rx_frames + i) * q.frame_size);
+  }
+
+  HOLOSCAN_LOG_INFO("Created AF_XDP socket on {} queue {} with {} RX and {} TX frames of {} bytes",
+                    ifname,
+                    q.q_id,
+                    q.rx_frames,
+                    q.tx_frames,
+                    q.frame_size);
+  return 0;
+}
+
+BurstParams* AfXdpMgr::create_burst(uint32_t max_pkts) {
+  auto burst = std::make_unique<BurstParams>();
+  memset(burst.get(), 0, sizeof(BurstParams));
+  burst_pkts_.emplace_back(new void*[max_pkts]);
+  burst_lens_.emplace_back(new uint32_t[max_pkts]);
+  burst->pkts[0] = burst_pkts_.back().get();
+  burst->pkt_lens[0] = burst_lens_.back().get();
+  burst->hdr.hdr.num_segs = 1;
+  bursts_.push_back(std::move(burst));
+  return bursts_.back().get();
+}
+
+void AfXdpMgr::initialize() {
+  for (size_t i = 0; i < cfg_.ifs_.size(); i++) {
+    auto& intf = cfg_.ifs_[i];
+    intf.port_id_ = i;
+    if (open_port(intf) < 0) { return; }
+
+    // Sockets are per queue ID, shared by the RX and TX queue of the same ID
+    std::unordered_map<uint16_t, std::pair<std::string, std::string>> queue_mrs;
+    for (const auto& q_cfg : intf.rx_.queues_) {
+      auto& q = queues_[generate_queue_key(intf.port_id_, q_cfg.common_.id_)];
+      if (!q) { q = std::make_unique<AfXdpQueue>(); }
+      q->q_id = q_cfg.common_.id_;
+      q->has_rx = true;
+      q->rx_batch_size = q_cfg.common_.batch_size_;
+      q->timeout_us = q_cfg.timeout_us_;
+      queue_mrs[q->q_id].first = q_cfg.common_.mrs_[0];
+    }
+    for (const auto& q_cfg : intf.tx_.queues_) {
+      auto& q = queues_[generate_queue_key(intf.port_id_, q_cfg.common_.id_)];
+      if (!q) { q = std::make_unique<AfXdpQueue>(); }
+      q->q_id = q_cfg.common_.id_;
+      q->has_tx = true;
+      max_tx_batch_ = std::max(max_tx_batch_, q_cfg.common_.batch_size_);
+      queue_mrs[q->q_id].second = q_cfg.common_.mrs_[0];
+    }
+
+    for (const auto& [q_id, mrs] : queue_mrs) {
+      auto& q = queues_[generate_queue_key(intf.port_id_, q_id)];
+      if (create_socket(intf, *q, mrs.first, mrs.second) < 0) { return; }
+      for (int b = 0; q->has_rx && b < NUM_RX_BURSTS; b++) {
+        auto burst = create_burst(q->rx_batch_size);
+        burst->hdr.hdr.port_id = q->port_id;
+        burst->hdr.hdr.q_id = q->q_id;
+        burst->hdr.extra_burst_data = q.get();
+        q->free_bursts.push_back(burst);
+      }
+    }
+  }
+
+  for (int i = 0; i < NUM_TX_BURSTS && max_tx_batch_ > 0; i++) {
+    tx_free_bursts_.push_back(create_burst(max_tx_batch_));
+  }
+
+  this->initialized_ = true;
+}
+
+void AfXdpMgr::run() {
+  HOLOSCAN_LOG_INFO("AF_XDP manager ready, sockets are polled from get_rx_burst and "
+                    "send_tx_burst");
+}
+
+AfXdpQueue* AfXdpMgr::find_queue(uint32_t key) {
+  const auto it = queues_.find(key);
+  return it == queues_.end() ? nullptr : it->second.get();
+}
+
+void AfXdpMgr::kick_rx(AfXdpQueue& q) {
+  // With busy polling the driver only runs from the syscall
+  if (q.busy_poll || xsk_ring_prod__needs_wakeup(&q.fq)) {
+    recvfrom(xsk_socket__fd(q.xsk), nullptr, 0, MSG_DONTWAIT, nullptr, nullptr);
+  }
+}
+
+void AfXdpMgr::kick_tx(AfXdpQueue& q) {
+  if (q.busy_poll || xsk_ring_prod__needs_wakeup(&q.tx)) {
+    sendto(xsk_socket__fd(q.xsk), nullptr, 0, MSG_DONTWAIT, nullptr, 0);
+  }
+}
+
+Status AfXdpMgr::get_rx_burst(BurstParams** burst, int port, int q_id) {
+  auto q = find_queue(generate_queue_key(port, q_id));
+  if (q == nullptr || !q->has_rx) {
+    HOLOSCAN_LOG_ERROR("Invalid port/queue combination in get_rx_burst: {}/{}", port, q_id);
+    return Status::INVALID_PARAMETER;
+  }
+
+  if (q->pending == nullptr) {
+    std::lock_guard<std::mutex> lock(q->rx_mutex);
+    if (q->free_bursts.empty()) { return Status::NO_FREE_BURST_BUFFERS; }
+    q->pending = q->free_bursts.back();
+    q->free_bursts.pop_back();
+    q->pending->hdr.hdr.num_pkts = 0;
+    q->pending->hdr.hdr.nbytes = 0;
+  }
+
+  auto pending = q->pending;
+  kick_rx(*q);
+
+  uint32_t idx = 0;
+  const uint32_t num_rx =
+      xsk_ring_cons__peek(&q->rx, q->rx_batch_size - pending->hdr.hdr.num_pkts, &idx);
+  for (uint32_t i = 0; i < num_rx; i++) {
+    const auto desc = xsk_ring_cons__rx_desc(&q->rx, idx + i);
+    const auto pkt = pending->hdr.hdr.num_pkts++;
+    pending->pkts[0][pkt] = xsk_umem__get_data(q->area, xsk_umem__add_offset_to_addr(desc->addr));
+    pending->pkt_lens[0][pkt] = desc->len;
+    pending->hdr.hdr.nbytes += desc->len;
+  }
+  if (num_rx > 0) {
+    xsk_ring_cons__release(&q->rx, num_rx);
+    if (q->pending_start_ns == 0) { q->pending_start_ns = now_ns(); }
+  }
+
+  const auto num_pkts = pending->hdr.hdr.num_pkts;
+  const bool full = num_pkts >= q->rx_batch_size;
+  const bool timed_out = num_pkts > 0 && q->timeout_us > 0 &&
+                         now_ns() - q->pending_start_ns >= q->timeout_us * 1000;
+  if (!full && !timed_out) { return Status::NOT_READY; }
+
+  q->rx_pkts.fetch_add(num_pkts, std::memory_order_relaxed);
+  q->rx_bytes.fetch_add(pending->hdr.hdr.nbytes, std::memory_order_relaxed);
+  q->pending = nullptr;
+  q->pending_start_ns = 0;
+  *burst = pending;
+  return Status::SUCCESS;
+}
+
+void AfXdpMgr::refill(AfXdpQueue& q, void* const* pkts, size_t num_pkts) {
+  const uint64_t frame_mask = ~static_cast<uint64_t>(q.frame_size - 1);
+  std::lock_guard<std::mutex> lock(q.rx_mutex);
+
+  // The fill ring holds every RX frame, so there's always room for the freed ones
+  uint32_t idx = 0;
+  if (xsk_ring_prod__reserve(&q.fq, num_pkts, &idx) != num_pkts) {
+    HOLOSCAN_LOG_ERROR("Fill ring of queue {} full, {} frames lost", q.q_id, num_pkts);
+    return;
+  }
+  for (size_t i = 0; i < num_pkts; i++) {
+    const auto addr = static_cast<uint64_t>(static_cast<char*>(pkts[i]) - q.area);
+    *xsk_ring_prod__fill_addr(&q.fq, idx + i) = addr & frame_mask;
+  }
+  xsk_ring_prod__submit(&q.fq, num_pkts);
+}
+
+void AfXdpMgr::free_all_packets(BurstParams* burst) {
+  auto q = static_cast<AfXdpQueue*>(burst->hdr.extra_burst_data);
+  if (q == nullptr || burst->hdr.hdr.num_pkts == 0) { return; }
+
+  refill(*q, burst->pkts[0], burst->hdr.hdr.num_pkts);
+  burst->hdr.hdr.num_pkts = 0;
+}
+
+void AfXdpMgr::free_all_segment_packets(BurstParams* burst, int seg) {
+  if (seg == 0) { free_all_packets(burst); }
+}
+
+void AfXdpMgr::free_packet(BurstParams* burst, int pkt) {
+  auto q = static_cast<AfXdpQueue*>(burst->hdr.extra_burst_data);
+  if (q != nullptr) { refill(*q, &burst->pkts[0][pkt], 1); }
+}
+
+void AfXdpMgr::free_packet_segment(BurstParams* burst, int seg, int pkt) {
+  if (seg == 0) { free_packet(burst, pkt); }
+}
+
+void AfXdpMgr::free_rx_metadata(BurstParams* burst) {
+  auto q = static_cast<AfXdpQueue*>(burst->hdr.extra_burst_data);
+  if (q == nullptr) { return; }
+
+  std::lock_guard<std::mutex> lock(q->rx_mutex);
+  q->free_bursts.push_back(burst);
+}
+
+void AfXdpMgr::free_rx_burst(BurstParams* burst) {
+  free_all_packets(burst);
+  free_rx_metadata(burst);
+}
+
+void AfXdpMgr::reclaim_tx_frames(AfXdpQueue& q) {
+  uint32_t idx = 0;
+  const uint32_t num_done = xsk_ring_cons__peek(&q.cq, q.tx_frames, &idx);
+  for (uint32_t i = 0; i < num_done; i++) {
+    q.tx_free_frames.push_back(*xsk_ring_cons__comp_addr(&q.cq, idx + i));
+  }
+  if (num_done > 0) { xsk_ring_cons__release(&q.cq, num_done); }
+}
+
+bool AfXdpMgr::is_tx_burst_available(BurstParams* burst) {
+  auto q = find_queue(generate_queue_key(burst->hdr.hdr.port_id, burst->hdr.hdr.q_id));
+  if (q == nullptr || !q->has_tx) { return false; }
+
+  std::lock_guard<std::mutex> lock(q->tx_mutex);
+  if (q->tx_free_frames.size() < burst->hdr.hdr.num_pkts) {
+    kick_tx(*q);
+    reclaim_tx_frames(*q);
+  }
+  return q->tx_free_frames.size() >= burst->hdr.hdr.num_pkts;
+}
+
+Status AfXdpMgr::get_tx_packet_burst(BurstParams* burst) {
+  auto q = find_queue(generate_queue_key(burst->hdr.hdr.port_id, burst->hdr.hdr.q_id));
+  if (q == nullptr || !q->has_tx) {
+    HOLOSCAN_LOG_ERROR("Invalid port/queue combination in get_tx_packet_burst: {}/{}",
+                       burst->hdr.hdr.port_id,
+                       burst->hdr.hdr.q_id);
+    return Status::INVALID_PARAMETER;
+  }
+
+  const auto num_pkts = burst->hdr.hdr.num_pkts;
+  if (num_pkts > max_tx_batch_) {
+    HOLOSCAN_LOG_ERROR("Burst of {} packets is larger than the TX batch size {}",
+                       num_pkts,
+                       max_tx_batch_);
+    return Status::INVALID_PARAMETER;
+  }
+
+  std::lock_guard<std::mutex> lock(q->tx_mutex);
+  if (q->tx_free_frames.size() < num_pkts) {
+    kick_tx(*q);
+    reclaim_tx_frames(*q);
+    if (q->tx_free_frames.size() < num_pkts) { return Status::NO_FREE_PACKET_BUFFERS; }
+  }
+
+  for (size_t i = 0; i < num_pkts; i++) {
+    burst->pkts[0][i] = q->area + q->tx_free_frames.back();
+    burst->pkt_lens[0][i] = 0;
+    q->tx_free_frames.pop_back();
+  }
+  burst->hdr.hdr.nbytes = 0;
+
+  return Status::SUCCESS;
+}
+
+Status AfXdpMgr::send_tx_burst(BurstParams* burst) {
+  auto q = find_queue(generate_queue_key(burst->hdr.hdr.port_id, burst->hdr.hdr.q_id));
+  if (q == nullptr || !q->has_tx) {
+    HOLOSCAN_LOG_ERROR("Invalid port/queue combination in send_tx_burst: {}/{}",
+                       burst->hdr.hdr.port_id,
+                       burst->hdr.hdr.q_id);
+    return Status::INVALID_PARAMETER;
+  }
+
+  const auto num_pkts = burst->hdr.hdr.num_pkts;
+  uint64_t nbytes = 0;
+  bool reserved = false;
+  {
+    std::lock_guard<std::mutex> lock(q->tx_mutex);
+    uint32_t idx = 0;
+    reserved = xsk_ring_prod__reserve(&q->tx, num_pkts, &idx) == num_pkts;
+    for (size_t i = 0; reserved && i < num_pkts; i++) {
+      auto desc = xsk_ring_prod__tx_desc(&q->tx, idx + i);
+      desc->addr = static_cast<char*>(burst->pkts[0][i]) - q->area;
+      desc->len = burst->pkt_lens[0][i];
+      desc->options = 0;
+      nbytes += desc->len;
+    }
+    if (reserved) {
+      xsk_ring_prod__submit(&q->tx, num_pkts);
+      kick_tx(*q);
+      reclaim_tx_frames(*q);
+    }
+  }
+
+  if (!reserved) {
+    free_tx_burst(burst);
+    free_tx_metadata(burst);
+    HOLOSCAN_LOG_CRITICAL("Failed to reserve {} TX descriptors", num_pkts);
+    return Status::NO_SPACE_AVAILABLE;
+  }
+
+  q->tx_pkts.fetch_add(num_pkts, std::memory_order_relaxed);
+  q->tx_bytes.fetch_add(nbytes, std::memory_order_relaxed);
+  free_tx_metadata(burst);
+  return Status::SUCCESS;
+}
+
+void AfXdpMgr::free_tx_burst(BurstParams* burst) {
+  auto q = find_queue(generate_queue_key(burst->hdr.hdr.port_id, burst->hdr.hdr.q_id));
+  if (q == nullptr || !q->has_tx) { return; }
+
+  std::lock_guard<std::mutex> lock(q->tx_mutex);
+  for (size_t i = 0; i < burst->hdr.hdr.num_pkts; i++) {
+    q->tx_free_frames.push_back(static_cast<char*>(burst->pkts[0][i]) - q->area);
+  }
+}
+
+void AfXdpMgr::free_tx_metadata(BurstParams* burst) {
+  std::lock_guard<std::mutex> lock(tx_burst_mutex_);
+  tx_free_bursts_.push_back(burst);
+}
+
+Status AfXdpMgr::get_tx_metadata_buffer(BurstParams** burst) {
+  std::lock_guard<std::mutex> lock(tx_burst_mutex_);
+  if (tx_free_bursts_.empty()) {
+    HOLOSCAN_LOG_CRITICAL("Failed to get TX meta descriptor");
+    return Status::NO_FREE_BURST_BUFFERS;
+  }
+  *burst = tx_free_bursts_.back();
+  tx_free_bursts_.pop_back();
+  return Status::SUCCESS;
+}
+
+BurstParams* AfXdpMgr::create_tx_burst_params() {
+  BurstParams* burst = nullptr;
+  if (get_tx_metadata_buffer(&burst) != Status::SUCCESS) { return nullptr; }
+  return burst;
+}
+
+void* AfXdpMgr::get_packet_ptr(BurstParams* burst, int idx) {
+  return burst->pkts[0][idx];
+}
+
+void* AfXdpMgr::get_segment_packet_ptr(BurstParams* burst, int seg, int idx) {
+  return seg == 0 ? get_packet_ptr(burst, idx) : nullptr;
+}
+
+uint16_t AfXdpMgr::get_packet_length(BurstParams* burst, int idx) {
+  return burst->pkt_lens[0][idx];
+}
+
+uint16_t AfXdpMgr::get_segment_packet_length(BurstParams* burst, int seg, int idx) {
+  return seg == 0 ? get_packet_length(burst, idx) : 0;
+}
+
+uint16_t AfXdpMgr::get_packet_flow_id(BurstParams* burst, int idx) {
+  return 0;
+}
+
+void* AfXdpMgr::get_packet_extra_info(BurstParams* burst, int idx) {
+  return nullptr;
+}
+
+uint64_t AfXdpMgr::get_burst_tot_byte(BurstParams* burst) {
+  return burst->hdr.hdr.nbytes;
+}
+
+Status AfXdpMgr::set_packet_lengths(BurstParams* burst, int idx,
+                                    const std::initializer_list<int>& lens) {
+  if (lens.size() != 1) {
+    HOLOSCAN_LOG_ERROR("AF_XDP packets have a single segment");
+    return Status::INVALID_PARAMETER;
+  }
+  burst->pkt_lens[0][idx] = *lens.begin();
+  burst->hdr.hdr.nbytes += *lens.begin();
+  return Status::SUCCESS;
+}
+
+Status AfXdpMgr::set_eth_header(BurstParams* burst, int idx, char* dst_addr) {
+  auto pkt = static_cast<UDPIPV4Pkt*>(burst->pkts[0][idx]);
+  memcpy(pkt->eth.h_dest, dst_addr, sizeof(pkt->eth.h_dest));
+  memcpy(pkt->eth.h_source, mac_addrs_[burst->hdr.hdr.port_id].data(), sizeof(pkt->eth.h_source));
+  pkt->eth.h_proto = htons(ETH_P_IP);
+  return Status::SUCCESS;
+}
+
+Status AfXdpMgr::set_ipv4_header(BurstParams* burst, int idx, int ip_len, uint8_t proto,
+                                 unsigned int src_host, unsigned int dst_host) {
+  auto pkt = static_cast<UDPIPV4Pkt*>(burst->pkts[0][idx]);
+  pkt->ip.protocol = proto;
+  pkt->ip.ihl = 5;
+  pkt->ip.tot_len = htons(sizeof(pkt->ip) + ip_len);
+  pkt->ip.version = 4;
+  pkt->ip.ttl = pkt->ip.ttl == 0 ? 64 : pkt->ip.ttl;
+  pkt->ip.saddr = htonl(src_host);
+  pkt->ip.daddr = htonl(dst_host);
+
+  // No checksum offload with AF_XDP
+  pkt->ip.check = 0;
+  pkt->ip.check = ipv4_checksum(&pkt->ip);
+  return Status::SUCCESS;
+}
+
+Status AfXdpMgr::set_udp_header(BurstParams* burst, int idx, int udp_len, uint16_t src_port,
+                                uint16_t dst_port) {
+  auto pkt = static_cast<UDPIPV4Pkt*>(burst->pkts[0][idx]);
+  pkt->udp.check = 0;
+  pkt->udp.source = htons(src_port);
+  pkt->udp.dest = htons(dst_port);
+  pkt->udp.len = htons(udp_len + sizeof(pkt->udp));
+  return Status::SUCCESS;
+}
+
+Status AfXdpMgr::set_udp_payload(BurstParams* burst, int idx, void* data, int len) {
+  auto pkt = static_cast<char*>(burst->pkts[0][idx]);
+  memcpy(pkt + sizeof(UDPIPV4Pkt), data, len);
+  return Status::SUCCESS;
+}
+
+Status AfXdpMgr::set_packet_tx_time(BurstParams* burst, int idx, uint64_t timestamp) {
+  return Status::NOT_SUPPORTED;
+}
+
+Status AfXdpMgr::get_mac_addr(int port, char* mac) {
+  if (port < 0 || port >= static_cast<int>(mac_addrs_.size())) {
+    HOLOSCAN_LOG_CRITICAL("Port {} out of range in get_mac_addr() lookup", port);
+    return Status::INVALID_PARAMETER;
+  }
+
+  memcpy(mac, mac_addrs_[port].data(), mac_addrs_[port].size());
+  return Status::SUCCESS;
+}
+
+Status AfXdpMgr::get_stats(ManagerStats& stats) {
+  stats = {};
+  stats.timestamp_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                           std::chrono::system_clock::now().time_since_epoch())
+                           .count();
+
+  for (const auto& [key, q] : queues_) {
+    struct xdp_statistics xdp_stats = {};
+    socklen_t len = sizeof(xdp_stats);
+    getsockopt(xsk_socket__fd(q->xsk), SOL_XDP, XDP_STATISTICS, &xdp_stats, &len);
+
+    if (q->has_rx) {
+      QueueStats qs;
+      qs.port_id = q->port_id;
+      qs.q_id = q->q_id;
+      qs.dir = Direction::RX;
+      qs.packets = q->rx_pkts.load(std::memory_order_relaxed);
+      qs.bytes = q->rx_bytes.load(std::memory_order_relaxed);
+      qs.drops = xdp_stats.rx_dropped + xdp_stats.rx_ring_full;
+      stats.queues.push_back(qs);
+    }
+    if (q->has_tx) {
+      QueueStats qs;
+      qs.port_id = q->port_id;
+      qs.q_id = q->q_id;
+      qs.dir = Direction::TX;
+      qs.packets = q->tx_pkts.load(std::memory_order_relaxed);
+      qs.bytes = q->tx_bytes.load(std::memory_order_relaxed);
+      qs.drops = xdp_stats.tx_invalid_descs;
+      stats.queues.push_back(qs);
+    }
+  }
+
+  return Status::SUCCESS;
+}
+
+void AfXdpMgr::print_stats() {
+  HOLOSCAN_LOG_INFO("advanced_network AF_XDP manager stats");
+  for (const auto& [key, q] : queues_) {
+    struct xdp_statistics xdp_stats = {};
+    socklen_t len = sizeof(xdp_stats);
+    getsockopt(xsk_socket__fd(q->xsk), SOL_XDP, XDP_STATISTICS, &xdp_stats, &len);
+
+    HOLOSCAN_LOG_INFO("{} queue {}: RX {} packets {} bytes, TX {} packets {} bytes",
+                      ifnames_[q->port_id],
+                      q->q_id,
+                      q->rx_pkts.load(),
+                      q->rx_bytes.load(),
+                      q->tx_pkts.load(),
+                      q->tx_bytes.load());
+    HOLOSCAN_LOG_INFO(" - RX dropped: {}, RX ring full: {}, fill ring empty: {}",
+                      xdp_stats.rx_dropped,
+                      xdp_stats.rx_ring_full,
+                      xdp_stats.rx_fill_ring_empty_descs);
+    HOLOSCAN_LOG_INFO(" - RX invalid descriptors: {}, TX invalid descriptors: {}",
+                      xdp_stats.rx_invalid_descs,
+                      xdp_stats.tx_invalid_descs);
+  }
+}
+
+void AfXdpMgr::shutdown() {
+  for (auto& [key, q] : queues_) {
+    if (q->xsk != nullptr) { xsk_socket__delete(q->xsk); }
+    if (q->umem != nullptr) { xsk_umem__delete(q->umem); }
+    if (q->area != nullptr) { munmap(q->area, q->area_size); }
+  }
+  queues_.clear();
+  ar_.clear();
+
+  tx_free_bursts_.clear();
+  bursts_.clear();
+  burst_pkts_.clear();
+  burst_lens_.clear();
+  ifnames_.clear();
+  mac_addrs_.clear();
+  initialized_ = false;
+}
+
+};  // namespace holoscan::advanced_network
@@ -0,0 +1,153 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <xdp/xsk.h>
+
+#include <array>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "advanced_network/manager.h"
+
+namespace holoscan::advanced_network {
+
+/**
+ * @brief AF_XDP socket bound to one queue of a NIC
+ *
+ * RX and TX queues with the same ID share the socket and its UMEM. The UMEM holds the RX frames
+ * followed by the TX frames. RX frames are returned to the fill ring when the application frees
+ * them, and TX frames come back through the completion ring once the NIC has sent them.
+ */
+struct AfXdpQueue {
+  uint16_t port_id = 0;
+  uint16_t q_id = 0;
+  bool busy_poll = false;
+
+  char* area = nullptr;  // UMEM, RX frames then TX frames
+  size_t area_size = 0;
+  uint32_t frame_size = 0;
+  struct xsk_umem* umem = nullptr;
+  struct xsk_ring_prod fq;
+  struct xsk_ring_cons cq;
+  struct xsk_socket* xsk = nullptr;
+  struct xsk_ring_cons rx;
+  struct xsk_ring_prod tx;
+
+  // RX
+  bool has_rx = false;
+  uint32_t rx_batch_size = 0;
+  uint64_t timeout_us = 0;
+  uint32_t rx_frames = 0;
+  BurstParams* pending = nullptr;  // Burst being filled
+  uint64_t pending_start_ns = 0;
+  std::vector<BurstParams*> free_bursts;
+  std::mutex rx_mutex;  // Fill ring and free bursts, refilled from the threads freeing bursts
+
+  // TX
+  bool has_tx = false;
+  uint32_t tx_frames = 0;
+  std::vector<uint64_t> tx_free_frames;  // UMEM addresses of the TX frames not in use
+  std::mutex tx_mutex;
+
+  std::atomic<uint64_t> rx_pkts{0};
+  std::atomic<uint64_t> rx_bytes{0};
+  std::atomic<uint64_t> tx_pkts{0};
+  std::atomic<uint64_t> tx_bytes{0};
+};
+
+class AfXdpMgr : public Manager {
+ public:
+  AfXdpMgr() = default;
+  ~AfXdpMgr();
+  bool set_config_and_initialize(const NetworkConfig& cfg) override;
+  void initialize() override;
+  void run() override;
+
+  void* get_segment_packet_ptr(BurstParams* burst, int seg, int idx) override;
+  void* get_packet_ptr(BurstParams* burst, int idx) override;
+  uint16_t get_segment_packet_length(BurstParams* burst, int seg, int idx) override;
+  uint16_t get_packet_length(BurstParams* burst, int idx) override;
+  uint16_t get_packet_flow_id(BurstParams* burst, int idx) override;
+  void* get_packet_extra_info(BurstParams* burst, int idx) override;
+  Status get_tx_packet_burst(BurstParams* burst) override;
+  Status set_eth_header(BurstParams* burst, int idx, char* dst_addr) override;
+  Status set_ipv4_header(BurstParams* burst, int idx, int ip_len, uint8_t proto,
+                         unsigned int src_host, unsigned int dst_host) override;
+  Status set_udp_header(BurstParams* burst, int idx, int udp_len, uint16_t src_port,
+                        uint16_t dst_port) override;
+  Status set_udp_payload(BurstParams* burst, int idx, void* data, int len) override;
+  bool is_tx_burst_available(BurstParams* burst) override;
+
+  Status set_packet_lengths(BurstParams* burst, int idx,
+                            const std::initializer_list<int>& lens) override;
+  void free_all_segment_packets(BurstParams* burst, int seg) override;
+  void free_all_packets(BurstParams* burst) override;
+  void free_packet_segment(BurstParams* burst, int seg, int pkt) override;
+  void free_packet(BurstParams* burst, int pkt) override;
+  void free_rx_burst(BurstParams* burst) override;
+  void free_tx_burst(BurstParams* burst) override;
+
+  Status get_rx_burst(BurstParams** burst, int port, int q) override;
+  using holoscan::advanced_network::Manager::get_rx_burst;  // for overloads
+  Status set_packet_tx_time(BurstParams* burst, int idx, uint64_t timestamp) override;
+  void free_rx_metadata(BurstParams* burst) override;
+  void free_tx_metadata(BurstParams* burst) override;
+  Status get_tx_metadata_buffer(BurstParams** burst) override;
+  Status send_tx_burst(BurstParams* burst) override;
+  Status get_mac_addr(int port, char* mac) override;
+  void shutdown() override;
+  void print_stats() override;
+  uint64_t get_burst_tot_byte(BurstParams* burst) override;
+  BurstParams* create_tx_burst_params() override;
+  bool validate_config() const override;
+  Status get_stats(ManagerStats& stats) override;
+
+ protected:
+  void adjust_memory_regions() override;
+
+ private:
+  static constexpr int NUM_RX_BURSTS = 64;
+  static constexpr int NUM_TX_BURSTS = 256;
+  static constexpr uint32_t MIN_FRAME_SIZE = 2048;
+
+  int open_port(InterfaceConfig& intf);
+  int create_socket(const InterfaceConfig& intf, AfXdpQueue& q, const std::string& rx_mr,
+                    const std::string& tx_mr);
+  void kick_rx(AfXdpQueue& q);
+  void kick_tx(AfXdpQueue& q);
+  void reclaim_tx_frames(AfXdpQueue& q);
+  void refill(AfXdpQueue& q, void* const* pkts, size_t num_pkts);
+  BurstParams* create_burst(uint32_t max_pkts);
+  AfXdpQueue* find_queue(uint32_t key);
+
+  std::vector<std::string> ifnames_;
+  std::vector<std::array<char, 6>> mac_addrs_;
+  std::unordered_map<uint32_t, std::unique_ptr<AfXdpQueue>> queues_;
+  std::vector<std::unique_ptr<BurstParams>> bursts_;
+  std::vector<std::unique_ptr<void*[]>> burst_pkts_;
+  std::vector<std::unique_ptr<uint32_t[]>> burst_lens_;
+  std::vector<BurstParams*> tx_free_bursts_;
+  std::mutex tx_burst_mutex_;
+  uint32_t max_tx_batch_ = 0;
+};
+
+};  // namespace holoscan::advanced_network
@@ -0,0 +1,408 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2023 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "adv_network_dpdk_capture.h"
+#include <rte_ethdev.h>
+#include <fcntl.h>
+#include <limits.h>
+#include <pthread.h>
+#include <time.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include "holoscan/holoscan.hpp"
+
+namespace holoscan::advanced_network {
+
+namespace {
+
+constexpr uint32_t PCAPNG_SHB_TYPE = 0x0A0D0D0A;
+constexpr uint32_t PCAPNG_IDB_TYPE = 0x00000001;
+constexpr uint32_t PCAPNG_EPB_TYPE = 0x00000006;
+constexpr uint32_t PCAPNG_BYTE_ORDER_MAGIC = 0x1A2B3C4D;
+constexpr uint16_t PCAPNG_LINKTYPE_ETHERNET = 1;
+constexpr uint16_t PCAPNG_OPT_ENDOFOPT = 0;
+constexpr uint16_t PCAPNG_OPT_IF_TSRESOL = 9;
+constexpr uint8_t PCAPNG_TSRESOL_NS = 9;
+constexpr uint32_t PCAPNG_MAX_SNAP_LEN = 65535;
+
+// Enhanced packet block header, followed by the packet data padded to 4 bytes and the trailer
+struct PcapngEpbHeader {
+  uint32_t block_type;
+  uint32_t block_len;
+  uint32_t if_id;
+  uint32_t ts_high;
+  uint32_t ts_low;
+  uint32_t cap_len;
+  uint32_t orig_len;
+};
+constexpr size_t EPB_BLOCK_SLOT = sizeof(PcapngEpbHeader) + sizeof(uint32_t);
+
+const uint8_t pcapng_pad[4] = {0};
+
+uint64_t wall_time_ns() {
+  struct timespec ts;
+  clock_gettime(CLOCK_REALTIME, &ts);
+  return static_cast<uint64_t>(ts.tv_sec) * 1000000000ULL + ts.tv_nsec;
+}
+
+}  // namespace
+
+DpdkCaptureTap::DpdkCaptureTap(int port, int queue, const RxTapConfig& cfg,
+                               std::vector<bool> seg_on_gpu, int ts_offset, uint64_t ts_flag,
+                               double nic_clock_hz)
+    : port_(port),
+      queue_(queue),
+      cfg_(cfg),
+      seg_on_gpu_(std::move(seg_on_gpu)),
+      ts_offset_(ts_offset),
+      ts_flag_(ts_flag),
+      ns_per_nic_tick_(nic_clock_hz > 0 ? 1e9 / nic_clock_hz : 0) {
+  snap_len_ = (cfg_.snap_len_ == 0) ? PCAPNG_MAX_SNAP_LEN
+                                    : std::min(cfg_.snap_len_, PCAPNG_MAX_SNAP_LEN);
+}
+
+DpdkCaptureTap::~DpdkCaptureTap() {
+  stop();
+}
+
+bool DpdkCaptureTap::start() {
+  fd_ = open(cfg_.file_.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+  if (fd_ < 0) {
+    HOLOSCAN_LOG_ERROR("Failed to open capture file {}: {}", cfg_.file_, strerror(errno));
+    return false;
+  }
+
+  if (!write_header()) {
+    close(fd_);
+    fd_ = -1;
+    return false;
+  }
+
+  num_slots_ = (cfg_.buffer_pkts_ + TAP_BURST_SIZE - 1) / TAP_BURST_SIZE;
+  ring_ = std::make_unique<TapBurst[]>(num_slots_);
+  iov_.resize(TAP_WRITE_BURSTS * TAP_BURST_SIZE * (MAX_NUM_SEGS + 3));
+  blocks_.resize(TAP_WRITE_BURSTS * TAP_BURST_SIZE * EPB_BLOCK_SLOT);
+
+  if (std::find(seg_on_gpu_.begin(), seg_on_gpu_.end(), true) != seg_on_gpu_.end()) {
+    gpu_stage_size_ = TAP_WRITE_BURSTS * TAP_BURST_SIZE * (TAP_MAX_SEG_SIZE + TAP_GPU_MERGE_GAP);
+    if (cudaHostAlloc(&gpu_stage_, gpu_stage_size_, 0) != cudaSuccess ||
+        cudaStreamCreateWithFlags(&stream_, cudaStreamNonBlocking) != cudaSuccess) {
+      HOLOSCAN_LOG_ERROR("Failed to allocate GPU staging memory for capture tap {}/{}",
+                         port_, queue_);
+      close(fd_);
+      fd_ = -1;
+      return false;
+    }
+  }
+
+  // Map NIC timestamps to wall clock time
+  if (ts_offset_ >= 0 && ns_per_nic_tick_ > 0 && rte_eth_read_clock(port_, &nic_ref_ticks_) == 0) {
+    nic_ref_ns_ = wall_time_ns();
+  } else {
+    ns_per_nic_tick_ = 0;
+    HOLOSCAN_LOG_WARN("No NIC timestamps for capture tap {}/{}, using host time", port_, queue_);
+  }
+
+  running_.store(true);
+  writer_ = std::thread(&DpdkCaptureTap::writer_loop, this);
+
+  const int core = strtol(cfg_.cpu_core_.c_str(), nullptr, 10);
+  cpu_set_t cpuset;
+  CPU_ZERO(&cpuset);
+  CPU_SET(core, &cpuset);
+  if (pthread_setaffinity_np(writer_.native_handle(), sizeof(cpu_set_t), &cpuset) != 0) {
+    HOLOSCAN_LOG_WARN("Failed to pin capture tap {}/{} writer to core {}", port_, queue_, core);
+  }
+
+  HOLOSCAN_LOG_INFO("Capture tap on port {} queue {} writing {} from core {} (snap length {})",
+                    port_, queue_, cfg_.file_, core, snap_len_);
+  return true;
+}
+
+void DpdkCaptureTap::stop() {
+  if (!running_.exchange(false)) { return; }
+  writer_.join();
+
+  close(fd_);
+  fd_ = -1;
+  if (gpu_stage_ != nullptr) {
+    cudaFreeHost(gpu_stage_);
+    gpu_stage_ = nullptr;
+  }
+  if (stream_ != nullptr) {
+    cudaStreamDestroy(stream_);
+    stream_ = nullptr;
+  }
+
+  HOLOSCAN_LOG_INFO("Capture tap on port {} queue {}: {} packets ({} bytes) written, {} dropped",
+                    port_, queue_, get_captured_pkts(), written_bytes_.load(), get_dropped_pkts());
+}
+
+void DpdkCaptureTap::mirror(struct rte_mbuf* const* mbufs, int num) {
+  if (!running_.load(std::memory_order_relaxed)) { return; }
+
+  const uint64_t now_ns = wall_time_ns();
+  int off = 0;
+  while (off < num) {
+    const uint64_t head = head_.load(std::memory_order_relaxed);
+    if (head - tail_.load(std::memory_order_acquire) >= num_slots_) {
+      dropped_pkts_.fetch_add(num - off, std::memory_order_relaxed);
+      return;
+    }
+
+    auto& slot = ring_[head % num_slots_];
+    slot.rx_time_ns = now_ns;
+    slot.num_pkts = std::min(num - off, TAP_BURST_SIZE);
+    for (int p = 0; p < slot.num_pkts; p++) {
+      struct rte_mbuf* pkt = mbufs[off + p];
+      for (struct rte_mbuf* seg = pkt; seg != nullptr; seg = seg->next) {
+        rte_mbuf_refcnt_update(seg, 1);
+      }
+      slot.pkts[p] = pkt;
+    }
+
+    head_.store(head + 1, std::memory_order_release);
+    off += slot.num_pkts;
+  }
+}
+
+void DpdkCaptureTap::writer_loop() {
+  TapBurst* batch[TAP_WRITE_BURSTS];
+  bool write_ok = true;
+
+  while (true) {
+    const uint64_t tail = tail_.load(std::memory_order_relaxed);
+    const int num = static_cast<int>(
+        std::min<uint64_t>(head_.load(std::memory_order_acquire) - tail, TAP_WRITE_BURSTS));
+    if (num == 0) {
+      if (!running_.load(std::memory_order_relaxed)) { break; }
+      std::this_thread::yield();
+      continue;
+    }
+
+    for (int b = 0; b < num; b++) { batch[b] = &ring_[(tail + b) % num_slots_]; }
+
+    // Keep releasing packets after a write error so the RX pool isn't drained by the tap
+    if (write_ok) {
+      write_ok = write_bursts(batch, num);
+      if (!write_ok) {
+        HOLOSCAN_LOG_ERROR("Capture tap {}/{} failed writing {}: {}. Capture stopped",
+                           port_, queue_, cfg_.file_, strerror(errno));
+      }
+    }
+
+    for (int b = 0; b < num; b++) {
+      if (!write_ok) { dropped_pkts_.fetch_add(batch[b]->num_pkts, std::memory_order_relaxed); }
+      for (int p = 0; p < batch[b]->num_pkts; p++) { rte_pktmbuf_free(batch[b]->pkts[p]); }
+    }
+    tail_.store(tail + num, std::memory_order_release);
+  }
+}
+
+uint64_t DpdkCaptureTap::packet_time_ns(const struct rte_mbuf* mbuf, uint64_t fallback_ns) const {
+  if (ns_per_nic_tick_ == 0 || (mbuf->ol_flags & ts_flag_) == 0) { return fallback_ns; }
+
+  const auto ticks = *RTE_MBUF_DYNFIELD(mbuf, ts_offset_, const rte_mbuf_timestamp_t*);
+  const auto delta = static_cast<int64_t>(ticks - nic_ref_ticks_);
+  return nic_ref_ns_ + static_cast<int64_t>(delta * ns_per_nic_tick_);
+}
+
+bool DpdkCaptureTap::write_bursts(TapBurst* const* bursts, int num_bursts) {
+  size_t num_iov = 0;
+  size_t stage_offset = 0;
+  uint64_t bytes = 0;
+  int num_pkts = 0;
+
+  for (int b = 0; b < num_bursts; b++) {
+    const auto burst = bursts[b];
+    gpu_segs_.clear();
+
+    for (int p = 0; p < burst->num_pkts; p++) {
+      const struct rte_mbuf* pkt = burst->pkts[p];
+      uint32_t seg_bytes = 0;
+      int num_segs = 0;
+      for (const struct rte_mbuf* seg = pkt; seg != nullptr && num_segs < MAX_NUM_SEGS;
+           seg = seg->next, num_segs++) {
+        seg_bytes += seg->data_len;
+      }
+
+      const uint32_t cap_len = std::min({pkt->pkt_len, snap_len_, seg_bytes});
+      const uint32_t pad = (4 - (cap_len & 3)) & 3;
+      const uint32_t block_len = EPB_BLOCK_SLOT + cap_len + pad;
+      const uint64_t ts = packet_time_ns(pkt, burst->rx_time_ns);
+
+      uint8_t* block = &blocks_[(num_pkts + p) * EPB_BLOCK_SLOT];
+      auto hdr = reinterpret_cast<PcapngEpbHeader*>(block);
+      hdr->block_type = PCAPNG_EPB_TYPE;
+      hdr->block_len = block_len;
+      hdr->if_id = 0;
+      hdr->ts_high = static_cast<uint32_t>(ts >> 32);
+      hdr->ts_low = static_cast<uint32_t>(ts);
+      hdr->cap_len = cap_len;
+      hdr->orig_len = pkt->pkt_len;
+      memcpy(block + sizeof(PcapngEpbHeader), &block_len, sizeof(block_len));
+
+      iov_[num_iov++] = {block, sizeof(PcapngEpbHeader)};
+
+      uint32_t left = cap_len;
+      int seg_idx = 0;
+      for (const struct rte_mbuf* seg = pkt; seg_idx < num_segs && left > 0;
+           seg = seg->next, seg_idx++) {
+        const uint32_t len = std::min<uint32_t>(seg->data_len, left);
+        const auto addr = rte_pktmbuf_mtod(seg, uint8_t*);
+        if (seg_idx < static_cast<int>(seg_on_gpu_.size()) && seg_on_gpu_[seg_idx]) {
+          gpu_segs_.push_back({reinterpret_cast<uintptr_t>(addr), len, num_iov});
+        }
+        iov_[num_iov++] = {addr, len};
+        left -= len;
+      }
+
+      if (pad > 0) { iov_[num_iov++] = {const_cast<uint8_t*>(pcapng_pad), pad}; }
+      iov_[num_iov++] = {block + sizeof(PcapngEpbHeader), sizeof(uint32_t)};
+      bytes += block_len;
+    }
+
+    if (!gpu_segs_.empty()) { stage_offset = stage_gpu_segments(gpu_segs_, stage_offset); }
+    num_pkts += burst->num_pkts;
+  }
+
+  if (stream_ != nullptr && stage_offset > 0 && cudaStreamSynchronize(stream_) != cudaSuccess) {
+    HOLOSCAN_LOG_ERROR("Capture tap {}/{} failed to copy GPU packets", port_, queue_);
+    return false;
+  }
+
+  if (!write_iovs(iov_.data(), num_iov)) { return false; }
+
+  captured_pkts_.fetch_add(num_pkts, std::memory_order_relaxed);
+  written_bytes_.fetch_add(bytes, std::memory_order_relaxed);
+  return true;
+}
+
+/**
+ * @brief Copy the GPU segments of a burst to the staging buffer and point their iovecs to it
+ *
+ * Segments close to each other in GPU memory are merged into a single range, so a burst the
+ * NIC wrote to consecutive buffers is staged with a single copy.
+ *
+ * @return Staging buffer offset after the copied ranges
+ */
+size_t DpdkCaptureTap::stage_gpu_segments(std::vector<GpuSegment>& segs, size_t stage_offset) {
+  std::sort(segs.begin(), segs.end(),
+            [](const GpuSegment& a, const GpuSegment& b) { return a.addr < b.addr; });
+
+  auto stage = static_cast<uint8_t*>(gpu_stage_);
+  size_t first = 0;
+  while (first < segs.size()) {
+    const uintptr_t start = segs[first].addr;
+    uintptr_t end = start + segs[first].len;
+    size_t last = first + 1;
+    while (last < segs.size() && segs[last].addr <= end + TAP_GPU_MERGE_GAP) {
+      end = std::max<uintptr_t>(end, segs[last].addr + segs[last].len);
+      last++;
+    }
+
+    const size_t range_len = end - start;
+    if (stage_offset + range_len > gpu_stage_size_ ||
+        cudaMemcpyAsync(stage + stage_offset, reinterpret_cast<void*>(start), range_len,
+                        cudaMemcpyDeviceToHost, stream_) != cudaSuccess) {
+      // Unexpected with the staging size, but never hand GPU pointers to writev
+      for (size_t s = first; s < last; s++) { iov_[segs[s].iov_idx].iov_base = stage; }
+      HOLOSCAN_LOG_ERROR("Capture tap {}/{} could not stage GPU packets", port_, queue_);
+    } else {
+      for (size_t s = first; s < last; s++) {
+        iov_[segs[s].iov_idx].iov_base = stage + stage_offset + (segs[s].addr - start);
+      }
+      stage_offset += range_len;
+    }
+    first = last;
+  }
+
+  return stage_offset;
+}
+
+bool DpdkCaptureTap::write_iovs(struct iovec* iov, size_t num_iov) {
+  while (num_iov > 0) {
+    const int cnt = static_cast<int>(std::min<size_t>(num_iov, IOV_MAX));
+    ssize_t written = writev(fd_, iov, cnt);
+    if (written < 0) {
+      if (errno == EINTR) { continue; }
+      return false;
+    }
+
+    // Skip what was written, resuming partial writes in the middle of an iovec
+    while (num_iov > 0 && static_cast<size_t>(written) >= iov->iov_len) {
+      written -= iov->iov_len;
+      iov++;
+      num_iov--;
+    }
+    if (written > 0) {
+      iov->iov_base = static_cast<uint8_t*>(iov->iov_base) + written;
+      iov->iov_len -= written;
+    }
+  }
+  return true;
+}
+
+bool DpdkCaptureTap::write_header() {
+  uint8_t buf[64];
+  size_t len = 0;
+  auto put32 = [&](uint32_t v) {
+    memcpy(buf + len, &v, sizeof(v));
+    len += sizeof(v);
+  };
+  auto put16 = [&](uint16_t v) {
+    memcpy(buf + len, &v, sizeof(v));
+    len += sizeof(v);
+  };
+  auto put8 = [&](uint8_t v) { buf[len++] = v; };
+
+  // Section header block
+  put32(PCAPNG_SHB_TYPE);
+  put32(28);
+  put32(PCAPNG_BYTE_ORDER_MAGIC);
+  put16(1);  // Major version
+  put16(0);  // Minor version
+  put32(0xFFFFFFFF);  // Unknown section length
+  put32(0xFFFFFFFF);
+  put32(28);
+
+  // Interface description block with nanosecond timestamps
+  put32(PCAPNG_IDB_TYPE);
+  put32(32);
+  put16(PCAPNG_LINKTYPE_ETHERNET);
+  put16(0);
+  put32(snap_len_);
+  put16(PCAPNG_OPT_IF_TSRESOL);
+  put16(1);
+  put8(PCAPNG_TSRESOL_NS);
+  put8(0);  // Option padding
+  put16(0);
+  put16(PCAPNG_OPT_ENDOFOPT);
+  put16(0);
+  put32(32);
+
+  struct iovec iov = {buf, len};
+  if (!write_iovs(&iov, 1)) {
+    HOLOSCAN_LOG_ERROR("Failed to write capture file {}: {}", cfg_.file_, strerror(errno));
+    return false;
+  }
+  return true;
+}
+
+};  // namespace holoscan::advanced_network
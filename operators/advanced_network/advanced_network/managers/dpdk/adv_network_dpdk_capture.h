@@ -0,0 +1,136 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2023 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "advanced_network/types.h"
+#include <rte_mbuf.h>
+#include <cuda_runtime.h>
+#include <sys/uio.h>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace holoscan::advanced_network {
+
+/**
+ * @brief Mirror of an RX queue to a pcapng file, written from its own core
+ *
+ * The RX worker hands the mbufs it receives to the tap with an extra reference, so capturing
+ * costs it a refcount update per segment and never a copy. A writer thread turns them into
+ * pcapng enhanced packet blocks written with batched writev calls, then drops its reference.
+ * Segments in GPU memory are staged to pinned memory with one copy per contiguous range of
+ * the burst, which is a single copy when the NIC filled consecutive buffers.
+ *
+ * The number of packets held by the tap is bounded. When the writer falls behind, new packets
+ * are not captured, while the live traffic goes on untouched.
+ */
+class DpdkCaptureTap {
+ public:
+  static constexpr int TAP_BURST_SIZE = 64;           // Packets per mirrored burst
+  static constexpr int TAP_WRITE_BURSTS = 16;         // Bursts written per writer iteration
+  static constexpr size_t TAP_GPU_MERGE_GAP = 16384;  // Largest gap copied to merge GPU ranges
+  static constexpr size_t TAP_MAX_SEG_SIZE = 9216;    // GPU segment size used to size staging
+
+  /**
+   * @brief Construct a new capture tap. Nothing is captured until start() is called.
+   *
+   * @param port Port ID of the queue
+   * @param queue Queue ID
+   * @param cfg Tap configuration
+   * @param seg_on_gpu Whether each packet segment of the queue is in GPU memory
+   * @param ts_offset Offset of the NIC RX timestamp dynfield, or -1 if not available
+   * @param ts_flag RX timestamp dynflag
+   * @param nic_clock_hz NIC clock frequency to convert timestamps, or 0 if unknown
+   */
+  DpdkCaptureTap(int port, int queue, const RxTapConfig& cfg, std::vector<bool> seg_on_gpu,
+                 int ts_offset, uint64_t ts_flag, double nic_clock_hz);
+  ~DpdkCaptureTap();
+
+  bool start();
+  void stop();
+
+  /**
+   * @brief Mirror received packets to the tap. Called by the RX worker, never blocks.
+   *
+   * @param mbufs Packets just received. The caller keeps its own reference
+   * @param num Number of packets
+   */
+  void mirror(struct rte_mbuf* const* mbufs, int num);
+
+  uint64_t get_captured_pkts() const { return captured_pkts_.load(std::memory_order_relaxed); }
+  uint64_t get_dropped_pkts() const { return dropped_pkts_.load(std::memory_order_relaxed); }
+  int get_port() const { return port_; }
+  int get_queue() const { return queue_; }
+
+ private:
+  struct TapBurst {
+    uint64_t rx_time_ns;  // Wall clock time when the burst was mirrored
+    int num_pkts;
+    struct rte_mbuf* pkts[TAP_BURST_SIZE];
+  };
+
+  struct GpuSegment {
+    uintptr_t addr;
+    uint32_t len;
+    size_t iov_idx;
+  };
+
+  void writer_loop();
+  bool write_bursts(TapBurst* const* bursts, int num_bursts);
+  bool write_iovs(struct iovec* iov, size_t num_iov);
+  bool write_header();
+  size_t stage_gpu_segments(std::vector<GpuSegment>& segs, size_t stage_offset);
+  uint64_t packet_time_ns(const struct rte_mbuf* mbuf, uint64_t fallback_ns) const;
+
+  int port_;
+  int queue_;
+  RxTapConfig cfg_;
+  std::vector<bool> seg_on_gpu_;
+  int ts_offset_;
+  uint64_t ts_flag_;
+  double ns_per_nic_tick_;
+  uint64_t nic_ref_ticks_ = 0;
+  uint64_t nic_ref_ns_ = 0;
+  uint32_t snap_len_;
+  int fd_ = -1;
+
+  // Single producer (RX worker) / single consumer (writer) ring of bursts
+  std::unique_ptr<TapBurst[]> ring_;
+  uint64_t num_slots_ = 0;
+  alignas(64) std::atomic<uint64_t> head_{0};
+  alignas(64) std::atomic<uint64_t> tail_{0};
+
+  // Writer state, reused across iterations
+  std::vector<struct iovec> iov_;
+  std::vector<uint8_t> blocks_;  // Enhanced packet block headers and trailers
+  std::vector<GpuSegment> gpu_segs_;
+
+  void* gpu_stage_ = nullptr;
+  size_t gpu_stage_size_ = 0;
+  cudaStream_t stream_ = nullptr;
+
+  std::atomic<bool> running_{false};
+  std::thread writer_;
+  std::atomic<uint64_t> captured_pkts_{0};
+  std::atomic<uint64_t> dropped_pkts_{0};
+  std::atomic<uint64_t> written_bytes_{0};
+};
+
+};  // namespace holoscan::advanced_network
@@ -15,6 +15,7 @@
  * limitations under the License.
  */
 
+#include <algorithm>
 #include <atomic>
 #include <cmath>
 #include <cuda.h>
@@ -72,6 +73,41 @@ struct TxWorkerParams {
   struct rte_mempool* meta_pool;
   struct rte_mempool* burst_pool;
   struct rte_ether_addr mac_addr;
+  TxRateLimitConfig rate_limit;
+  double nic_clock_hz;      // Non-zero when accurate send scheduling can pace packets
+  int timestamp_offset;
+  uint64_t timestamp_mask;
+};
+
+/**
+ * @brief Token bucket shaping the rate of a TX queue
+ *
+ * Tokens are bytes on the wire, refilled at the target rate and capped at the burst
+ * allowance. With accurate send scheduling, packets are stamped with their departure time in
+ * NIC clock ticks and the NIC paces them. Otherwise the TX worker waits on the TSC.
+ */
+struct TxRateShaper {
+  // Ethernet preamble, start of frame delimiter, inter-frame gap and FCS
+  static constexpr uint32_t WIRE_OVERHEAD = 24;
+  // How far ahead of the NIC clock packets can be scheduled
+  static constexpr uint64_t HW_PACING_HORIZON_NS = 100000;
+
+  bool enabled = false;
+  bool hw_pacing = false;
+  int port;
+  double bytes_per_tick = 0;  // 0 when the rate isn't limited
+  double burst_bytes;
+  uint64_t ipg_ticks;
+  // Software pacing on the TSC
+  double tokens;
+  uint64_t last_tsc;
+  uint64_t next_tsc = 0;
+  // Hardware pacing on the NIC clock
+  uint64_t burst_ticks;
+  uint64_t horizon_ticks;
+  uint64_t next_tick = 0;
+  int timestamp_offset;
+  uint64_t timestamp_mask;
 };
 
 struct RxWorkerParams {
@@ -80,10 +116,15 @@ struct RxWorkerParams {
   int num_segs;
   uint64_t timeout_us;
   uint32_t batch_size;
+  RxOverloadPolicy overload_policy;
   struct rte_ring* ring;
   struct rte_mempool* flowid_pool;
   struct rte_mempool* burst_pool;
   struct rte_mempool* meta_pool;
+  DpdkCaptureTap* tap;
+  RxAdaptivePollConfig adaptive_poll;
+  RxAdaptivePollStats* poll_stats;
+  double nic_clock_hz;
 };
 
 struct RxWorkerMultiQPerQParams {
@@ -92,6 +133,9 @@ struct RxWorkerMultiQPerQParams {
   int num_segs;
   int batch_size;
   struct rte_ring* ring;
+  RxOverloadPolicy overload_policy;
+  DpdkCaptureTap* tap;
+  double nic_clock_hz;
 };
 
 struct RxWorkerMultiQParams {
@@ -99,6 +143,8 @@ struct RxWorkerMultiQParams {
   struct rte_mempool* flowid_pool;
   struct rte_mempool* burst_pool;
   struct rte_mempool* meta_pool;
+  RxAdaptivePollConfig adaptive_poll;
+  RxAdaptivePollStats* poll_stats;
 };
 
 /**
@@ -116,6 +162,188 @@ struct ExtraRxPacketInfo {
   uint16_t flow_id;
 };
 
+// Overload and drop counters shared by all RX workers, indexed by ErrorGlobalStats
+static std::array<std::atomic<uint64_t>, static_cast<int>(ErrorGlobalStats::SENTINEL)>
+    rx_error_stats{};
+
+static inline void inc_rx_error_stat(ErrorGlobalStats stat, uint64_t val = 1) {
+  rx_error_stats[static_cast<int>(stat)].fetch_add(val, std::memory_order_relaxed);
+}
+
+// NIC RX timestamp dynfield, registered when any interface enables latency_stats
+static int rx_timestamp_offset = -1;
+static uint64_t rx_timestamp_flag = 0;
+
+// PTP clocks of the ports enabling ptp, set before the workers are launched
+static PtpClock* rx_ptp_clocks[RTE_MAX_ETHPORTS] = {};
+
+/**
+ * @brief Per-burst timestamps used for latency stats, stored in the burst custom data
+ */
+struct DpdkRxBurstInfo {
+  uint64_t nic_timestamp;  // NIC RX timestamp of the first packet, 0 if not available
+  uint64_t enqueue_tsc;    // RX worker handed the burst to the application ring
+  uint64_t dequeue_tsc;    // Application dequeued the burst, 0 if not dequeued yet
+};
+static_assert(sizeof(DpdkRxBurstInfo) <= sizeof(BurstHeader::custom_burst_data),
+              "DpdkRxBurstInfo doesn't fit in the burst header");
+
+static inline DpdkRxBurstInfo* get_rx_burst_info(BurstParams* burst) {
+  return reinterpret_cast<DpdkRxBurstInfo*>(burst->hdr.custom_burst_data);
+}
+
+static inline void stamp_rx_burst(BurstParams* burst) {
+  auto info = get_rx_burst_info(burst);
+  info->nic_timestamp = 0;
+  info->dequeue_tsc = 0;
+  burst->hdr.hdr.ptp_timestamp = 0;
+
+  if (rx_timestamp_offset >= 0 && burst->hdr.hdr.num_pkts > 0) {
+    auto first = reinterpret_cast<rte_mbuf**>(burst->pkts[0])[0];
+    if (first->ol_flags & rx_timestamp_flag) {
+      info->nic_timestamp = *RTE_MBUF_DYNFIELD(first, rx_timestamp_offset, rte_mbuf_timestamp_t*);
+      const auto ptp_clock = rx_ptp_clocks[burst->hdr.hdr.port_id];
+      if (ptp_clock != nullptr) {
+        burst->hdr.hdr.ptp_timestamp = ptp_clock->ticks_to_ptp(info->nic_timestamp);
+      }
+    }
+  }
+
+  info->enqueue_tsc = rte_get_tsc_cycles();
+}
+
+/**
+ * @brief Adaptive polling of the queues served by one RX worker. See RxAdaptivePollConfig
+ *
+ * The worker reports every poll. Once its queues have been empty for long enough it pauses
+ * between polls, then arms the RX interrupt of every queue and sleeps in epoll until one of
+ * them fires. Interrupts are only armed while sleeping, so busy polling costs nothing extra.
+ */
+class RxAdaptivePoller {
+ public:
+  struct Queue {
+    uint16_t port;
+    uint16_t queue;
+    double nic_clock_hz;  // 0 when the wakeup latency can't be measured on the port
+  };
+
+  RxAdaptivePoller(const RxAdaptivePollConfig& cfg, std::vector<Queue> queues,
+                   RxAdaptivePollStats* stats)
+      : cfg_(cfg), queues_(std::move(queues)), stats_(stats) {}
+
+  /**
+   * @brief Register the RX interrupts. Must be called by the worker, since they are added to
+   * the epoll instance of the calling thread
+   */
+  void start() {
+    if (!cfg_.enabled_) { return; }
+
+    sleep_on_intr_ = true;
+    for (const auto& q : queues_) {
+      const int ret =
+          rte_eth_dev_rx_intr_ctl_q(q.port, q.queue, RTE_EPOLL_PER_THREAD, RTE_INTR_EVENT_ADD,
+                                    nullptr);
+      if (ret != 0) {
+        HOLOSCAN_LOG_WARN("RX interrupts not available on port/queue {}/{}: {}. Core {} will "
+                          "only pause when idle",
+                          q.port, q.queue, rte_strerror(-ret), rte_lcore_id());
+        sleep_on_intr_ = false;
+        break;
+      }
+    }
+  }
+
+  void stop() {
+    if (!sleep_on_intr_) { return; }
+    for (const auto& q : queues_) {
+      rte_eth_dev_rx_intr_ctl_q(q.port, q.queue, RTE_EPOLL_PER_THREAD, RTE_INTR_EVENT_DEL,
+                                nullptr);
+    }
+  }
+
+  /**
+   * @brief Report a poll of queue q_idx that returned packets
+   */
+  inline void on_packets(int q_idx, const struct rte_mbuf* first) {
+    if (empty_polls_ == 0) { return; }
+    if (woken_) { record_wakeup(q_idx, first); }
+    empty_polls_ = 0;
+  }
+
+  /**
+   * @brief Report an empty poll. The worker can't sleep while it holds a partial batch it
+   * must flush on a timeout
+   */
+  inline void on_empty_poll(bool can_sleep) {
+    if (!cfg_.enabled_ || ++empty_polls_ <= cfg_.idle_polls_) { return; }
+
+    if (!can_sleep || !sleep_on_intr_ || empty_polls_ <= cfg_.idle_polls_ + cfg_.pause_polls_) {
+      rte_pause();
+      return;
+    }
+
+    sleep();
+  }
+
+ private:
+  void sleep() {
+    for (const auto& q : queues_) { rte_eth_dev_rx_intr_enable(q.port, q.queue); }
+
+    // Packets received before the interrupts were armed don't raise them
+    bool pending = false;
+    for (const auto& q : queues_) {
+      if (rte_eth_rx_queue_count(q.port, q.queue) > 0) {
+        pending = true;
+        break;
+      }
+    }
+
+    if (pending) {
+      empty_polls_ = 1;
+    } else {
+      std::array<struct rte_epoll_event, Manager::MAX_RX_Q_PER_CORE> events;
+      const uint64_t start = rte_get_tsc_cycles();
+      const int num_events = rte_epoll_wait(RTE_EPOLL_PER_THREAD, events.data(),
+                                            queues_.size(), cfg_.max_sleep_ms_);
+      stats_->sleeps.fetch_add(1, std::memory_order_relaxed);
+      stats_->sleep_ns.fetch_add((rte_get_tsc_cycles() - start) * 1e9 / rte_get_tsc_hz(),
+                                 std::memory_order_relaxed);
+
+      // After a timeout the next empty poll sleeps again
+      if (num_events > 0) {
+        empty_polls_ = 1;
+      } else {
+        stats_->sleep_timeouts.fetch_add(1, std::memory_order_relaxed);
+      }
+      woken_ = true;
+    }
+
+    for (const auto& q : queues_) { rte_eth_dev_rx_intr_disable(q.port, q.queue); }
+  }
+
+  void record_wakeup(int q_idx, const struct rte_mbuf* first) {
+    woken_ = false;
+
+    const auto& q = queues_[q_idx];
+    if (q.nic_clock_hz <= 0 || rx_timestamp_offset < 0 ||
+        (first->ol_flags & rx_timestamp_flag) == 0) {
+      return;
+    }
+
+    const uint64_t rx_ts = *RTE_MBUF_DYNFIELD(first, rx_timestamp_offset, rte_mbuf_timestamp_t*);
+    uint64_t now;
+    if (rte_eth_read_clock(q.port, &now) != 0 || now < rx_ts) { return; }
+    stats_->wakeup.record(static_cast<uint64_t>((now - rx_ts) * 1e9 / q.nic_clock_hz));
+  }
+
+  RxAdaptivePollConfig cfg_;
+  std::vector<Queue> queues_;
+  RxAdaptivePollStats* stats_;
+  bool sleep_on_intr_ = false;
+  bool woken_ = false;  // Slept since the last packet
+  uint32_t empty_polls_ = 0;
+};
+
 /**
  * A map of log level to a tuple of the description and command strings.
  */
@@ -165,15 +393,23 @@ bool DpdkMgr::set_config_and_initialize(const NetworkConfig& cfg) {
       return false;
     }
 
-    stats_.Init(cfg_);
-    stats_thread_ = std::thread(&DpdkStats::Run, &stats_);
+    // Port statistics belong to the primary process
+    if (!is_secondary()) {
+      stats_.Init(cfg_);
+      stats_thread_ = std::thread(&DpdkStats::Run, &stats_);
+    }
 
     if (!validate_config()) {
       HOLOSCAN_LOG_CRITICAL("Config validation failed");
       return false;
     }
 
-    run();
+    // RX bursts are stamped in PTP time by the workers
+    if (start_ptp_clocks() != Status::SUCCESS) { return false; }
+    for (const auto& clock : ptp_clocks_) { rx_ptp_clocks[clock.first] = clock.second.get(); }
+
+    // The workers of the primary serve the rings a secondary process attached to
+    if (!is_secondary()) { run(); }
   }
 
   return true;
@@ -190,6 +426,37 @@ Status DpdkMgr::get_mac_addr(int port, char* mac) {
 }
 
 void DpdkMgr::adjust_memory_regions() {
+  // Header regions of split queues only need room for the split boundary, unless another queue
+  // uses them for whole packets or payloads
+  std::unordered_map<std::string, int> hdr_sizes;
+  std::unordered_set<std::string> full_size_mrs;
+  for (const auto& intf : cfg_.ifs_) {
+    for (const auto& q : intf.rx_.queues_) {
+      for (size_t mr_num = 0; mr_num < q.common_.mrs_.size(); mr_num++) {
+        const auto& name = q.common_.mrs_[mr_num];
+        if (mr_num == 0 && q.common_.split_boundary_ > 0) {
+          hdr_sizes[name] = std::max(hdr_sizes[name], q.common_.split_boundary_);
+        } else {
+          full_size_mrs.insert(name);
+        }
+      }
+    }
+    for (const auto& q : intf.tx_.queues_) {
+      for (const auto& name : q.common_.mrs_) { full_size_mrs.insert(name); }
+    }
+  }
+
+  for (const auto& hdr : hdr_sizes) {
+    auto& mr = cfg_.mrs_[hdr.first];
+    if (full_size_mrs.count(hdr.first) == 0 && static_cast<size_t>(hdr.second) < mr.buf_size_) {
+      HOLOSCAN_LOG_INFO("Reducing buffer size of header region {} from {} to {} bytes",
+                        mr.name_,
+                        mr.buf_size_,
+                        hdr.second);
+      mr.buf_size_ = hdr.second;
+    }
+  }
+
   for (auto& mr : cfg_.mrs_) {
     // mr.second.buf_size_ = ((target_el_size + 3) / 4) * 4;
     mr.second.adj_size_ = mr.second.buf_size_ + RTE_PKTMBUF_HEADROOM;
@@ -198,7 +465,10 @@ void DpdkMgr::adjust_memory_regions() {
 }
 
 Status DpdkMgr::map_mrs() {
-  // Map every MR to every device for now
+  // Map every MR to every device for now. Each mapping pins and registers the whole region
+  // with the NIC, so they're all done in parallel
+  std::vector<std::pair<struct rte_device*, const struct rte_pktmbuf_extmem*>> maps;
+  std::vector<uint16_t> map_ports;
   for (const auto& intf : cfg_.ifs_) {
     struct rte_eth_dev_info dev_info;
     int ret = rte_eth_dev_info_get(intf.port_id_, &dev_info);
@@ -208,22 +478,38 @@ Status DpdkMgr::map_mrs() {
     }
 
     for (const auto& ext_mem_el : ext_pktmbufs_) {
-      const auto& ext_mem = ext_mem_el.second;
+      maps.emplace_back(dev_info.device, ext_mem_el.second.get());
+      map_ports.push_back(intf.port_id_);
+    }
+  }
+
+  std::vector<Status> results(maps.size(), Status::SUCCESS);
+  std::vector<std::thread> threads;
+  for (size_t i = 0; i < maps.size(); i++) {
+    threads.emplace_back([&, i]() {
+      const auto* ext_mem = maps[i].second;
 
 #pragma GCC diagnostic push
 #pragma GCC diagnostic ignored "-Wdeprecated-declarations"
-      ret = rte_dev_dma_map(dev_info.device, ext_mem->buf_ptr, ext_mem->buf_iova, ext_mem->buf_len);
+      int ret =
+          rte_dev_dma_map(maps[i].first, ext_mem->buf_ptr, ext_mem->buf_iova, ext_mem->buf_len);
 #pragma GCC diagnostic pop
 
       if (ret) {
         HOLOSCAN_LOG_CRITICAL(
             "Could not DMA map EXT memory: {} err={}", ret, rte_strerror(rte_errno));
-        return Status::NULL_PTR;
+        results[i] = Status::NULL_PTR;
+        return;
       }
 
       HOLOSCAN_LOG_INFO(
-          "Mapped external memory descriptor for {} to device {}", ext_mem->buf_ptr, intf.port_id_);
-    }
+          "Mapped external memory descriptor for {} to device {}", ext_mem->buf_ptr, map_ports[i]);
+    });
+  }
+  for (auto& t : threads) { t.join(); }
+
+  for (const auto res : results) {
+    if (res != Status::SUCCESS) { return res; }
   }
 
   return Status::SUCCESS;
@@ -294,6 +580,208 @@ void DpdkMgr::setup_accurate_send_scheduling_mask() {
   done = true;
 }
 
+bool DpdkMgr::setup_rx_timestamp() {
+  if (rx_timestamp_offset >= 0) { return true; }
+
+  if (rte_mbuf_dyn_rx_timestamp_register(&rx_timestamp_offset, &rx_timestamp_flag) != 0) {
+    HOLOSCAN_LOG_ERROR("RX timestamp dynfield registration error: {}", rte_strerror(rte_errno));
+    rx_timestamp_offset = -1;
+    return false;
+  }
+
+  HOLOSCAN_LOG_INFO("Registered RX timestamp dynfield at offset {}", rx_timestamp_offset);
+  return true;
+}
+
+bool DpdkMgr::read_nic_clock(int port, uint64_t& ticks) {
+  return rte_eth_read_clock(port, &ticks) == 0;
+}
+
+void DpdkMgr::measure_nic_clock(int port) {
+  static constexpr int NIC_CLOCK_MEASURE_MS = 100;
+  uint64_t clk_start, clk_end;
+
+  // NIC timestamps are in device clock units, which need to be mapped to TSC time
+  if (rte_eth_read_clock(port, &clk_start) != 0) {
+    HOLOSCAN_LOG_WARN("Cannot read NIC clock on port {}. NIC timestamps won't be used", port);
+    nic_clock_hz_.erase(port);
+    return;
+  }
+  const uint64_t tsc_start = rte_get_tsc_cycles();
+  rte_delay_ms(NIC_CLOCK_MEASURE_MS);
+  rte_eth_read_clock(port, &clk_end);
+  const uint64_t tsc_end = rte_get_tsc_cycles();
+
+  nic_clock_hz_[port] = static_cast<double>(clk_end - clk_start) * rte_get_tsc_hz() /
+                        static_cast<double>(tsc_end - tsc_start);
+  HOLOSCAN_LOG_INFO("Port {} NIC clock frequency: {:.0f} Hz", port, nic_clock_hz_[port]);
+}
+
+/**
+ * @brief Create and start the capture tap of an RX queue, if it has one
+ *
+ * @return Tap to pass to the RX worker, or nullptr if the queue isn't captured
+ */
+DpdkCaptureTap* DpdkMgr::start_rx_tap(int port, const RxQueueConfig& q) {
+  if (q.tap_.file_.empty()) { return nullptr; }
+
+  std::vector<bool> seg_on_gpu;
+  for (const auto& mr_name : q.common_.mrs_) {
+    seg_on_gpu.push_back(cfg_.mrs_.at(mr_name).kind_ == MemoryKind::DEVICE);
+  }
+
+  const auto clk_it = nic_clock_hz_.find(port);
+  const double nic_clock_hz = (clk_it != nic_clock_hz_.end()) ? clk_it->second : 0;
+  auto tap = std::make_unique<DpdkCaptureTap>(port, q.common_.id_, q.tap_, seg_on_gpu,
+                                              rx_timestamp_offset, rx_timestamp_flag,
+                                              nic_clock_hz);
+  if (!tap->start()) {
+    HOLOSCAN_LOG_ERROR("Failed to start capture tap for queue {}. Queue won't be captured",
+                       q.common_.name_);
+    return nullptr;
+  }
+
+  auto ptr = tap.get();
+  rx_taps_[generate_queue_key(port, q.common_.id_)] = std::move(tap);
+  return ptr;
+}
+
+double DpdkMgr::get_rx_nic_clock_hz(int port) const {
+  if (rx_timestamp_offset < 0) { return 0; }
+  const auto clk_it = nic_clock_hz_.find(port);
+  return (clk_it != nic_clock_hz_.end()) ? clk_it->second : 0;
+}
+
+void DpdkMgr::record_rx_dequeue(BurstParams* burst) {
+  const uint32_t key = generate_queue_key(burst->hdr.hdr.port_id, burst->hdr.hdr.q_id);
+  const auto hist_it = rx_latency_stats_.find(key);
+  if (hist_it == rx_latency_stats_.end()) { return; }
+
+  auto info = get_rx_burst_info(burst);
+  info->dequeue_tsc = rte_get_tsc_cycles();
+  const double ns_per_cycle = 1e9 / rte_get_tsc_hz();
+  hist_it->second->ring_to_dequeue.record(
+      static_cast<uint64_t>((info->dequeue_tsc - info->enqueue_tsc) * ns_per_cycle));
+
+  if (info->nic_timestamp == 0) { return; }
+  const auto clk_it = nic_clock_hz_.find(burst->hdr.hdr.port_id);
+  uint64_t now;
+  if (clk_it == nic_clock_hz_.end() || clk_it->second <= 0 ||
+      rte_eth_read_clock(burst->hdr.hdr.port_id, &now) != 0 || now < info->nic_timestamp) {
+    return;
+  }
+  hist_it->second->wire_to_dequeue.record(
+      static_cast<uint64_t>((now - info->nic_timestamp) * 1e9 / clk_it->second));
+}
+
+void DpdkMgr::record_rx_free(BurstParams* burst) {
+  const uint32_t key = generate_queue_key(burst->hdr.hdr.port_id, burst->hdr.hdr.q_id);
+  const auto hist_it = rx_latency_stats_.find(key);
+  if (hist_it == rx_latency_stats_.end()) { return; }
+
+  auto info = get_rx_burst_info(burst);
+  if (info->dequeue_tsc == 0) { return; }
+  hist_it->second->dequeue_to_free.record(
+      static_cast<uint64_t>((rte_get_tsc_cycles() - info->dequeue_tsc) * 1e9 / rte_get_tsc_hz()));
+  info->dequeue_tsc = 0;
+}
+
+std::vector<QueueLatencyStats> DpdkMgr::get_queue_latency_stats() const {
+  std::vector<QueueLatencyStats> stats;
+  stats.reserve(rx_latency_stats_.size());
+  for (const auto& [key, hist] : rx_latency_stats_) {
+    QueueLatencyStats q_stats;
+    q_stats.port_id = get_port_from_key(key);
+    q_stats.q_id = get_queue_from_key(key);
+    q_stats.wire_to_dequeue = hist->wire_to_dequeue.summary();
+    q_stats.ring_to_dequeue = hist->ring_to_dequeue.summary();
+    q_stats.dequeue_to_free = hist->dequeue_to_free.summary();
+    stats.push_back(q_stats);
+  }
+
+  return stats;
+}
+
+Status DpdkMgr::get_stats(ManagerStats& stats) {
+  std::set<struct rte_mempool*> pools = {rx_burst_buffer, rx_flow_id_buffer, rx_metadata,
+                                         tx_metadata};
+
+  auto ring_occupancy = [](const std::unordered_map<uint32_t, struct rte_ring*>& rings,
+                           uint32_t key, QueueStats& q_stats) {
+    const auto ring_it = rings.find(key);
+    if (ring_it == rings.end() || ring_it->second == nullptr) { return; }
+    q_stats.ring_occupancy = rte_ring_count(ring_it->second);
+    q_stats.ring_capacity = rte_ring_get_capacity(ring_it->second);
+  };
+
+  for (const auto& intf : cfg_.ifs_) {
+    struct rte_eth_stats eth_stats;
+    if (rte_eth_stats_get(intf.port_id_, &eth_stats) != 0) { continue; }
+
+    PortStats port_stats;
+    port_stats.port_id = intf.port_id_;
+    port_stats.rx_packets = eth_stats.ipackets;
+    port_stats.rx_bytes = eth_stats.ibytes;
+    port_stats.rx_missed = eth_stats.imissed;
+    port_stats.rx_errors = eth_stats.ierrors;
+    port_stats.tx_packets = eth_stats.opackets;
+    port_stats.tx_bytes = eth_stats.obytes;
+    port_stats.tx_errors = eth_stats.oerrors;
+    stats.ports.push_back(port_stats);
+
+    // Per-queue NIC counters are only kept for the first queues of a port
+    for (const auto& q : intf.rx_.queues_) {
+      const uint32_t key = generate_queue_key(intf.port_id_, q.common_.id_);
+      QueueStats q_stats;
+      q_stats.port_id = intf.port_id_;
+      q_stats.q_id = q.common_.id_;
+      q_stats.dir = Direction::RX;
+      if (q.common_.id_ < RTE_ETHDEV_QUEUE_STAT_CNTRS) {
+        q_stats.packets = eth_stats.q_ipackets[q.common_.id_];
+        q_stats.bytes = eth_stats.q_ibytes[q.common_.id_];
+        q_stats.drops = eth_stats.q_errors[q.common_.id_];
+      }
+      ring_occupancy(rx_rings, key, q_stats);
+      stats.queues.push_back(q_stats);
+
+      const auto q_it = rx_dpdk_q_map_.find(key);
+      if (q_it != rx_dpdk_q_map_.end()) {
+        pools.insert(q_it->second->pools.begin(), q_it->second->pools.end());
+      }
+    }
+
+    for (const auto& q : intf.tx_.queues_) {
+      const uint32_t key = generate_queue_key(intf.port_id_, q.common_.id_);
+      QueueStats q_stats;
+      q_stats.port_id = intf.port_id_;
+      q_stats.q_id = q.common_.id_;
+      q_stats.dir = Direction::TX;
+      if (q.common_.id_ < RTE_ETHDEV_QUEUE_STAT_CNTRS) {
+        q_stats.packets = eth_stats.q_opackets[q.common_.id_];
+        q_stats.bytes = eth_stats.q_obytes[q.common_.id_];
+      }
+      ring_occupancy(tx_rings, key, q_stats);
+      stats.queues.push_back(q_stats);
+
+      const auto burst_it = tx_burst_buffers.find(key);
+      if (burst_it != tx_burst_buffers.end()) { pools.insert(burst_it->second); }
+      const auto q_it = tx_dpdk_q_map_.find(key);
+      if (q_it != tx_dpdk_q_map_.end()) {
+        pools.insert(q_it->second->pools.begin(), q_it->second->pools.end());
+      }
+    }
+  }
+
+  for (const auto pool : pools) {
+    if (pool == nullptr) { continue; }
+    stats.pools.push_back({pool->name, rte_mempool_avail_count(pool), pool->size});
+  }
+
+  stats.rx_dropped = rx_error_stats[static_cast<int>(ErrorGlobalStats::RX_PACKETS_DROPPED)].load();
+  stats.latency = get_queue_latency_stats();
+  return Status::SUCCESS;
+}
+
 int DpdkMgr::numa_from_mem(const MemoryRegionConfig& mr) {
   if (mr.kind_ == MemoryKind::DEVICE) {
     int val;
@@ -356,6 +844,18 @@ void DpdkMgr::create_dummy_rx_q() {
 void DpdkMgr::initialize() {
   int ret;
 
+  // Time spent in each startup phase, logged once the manager is initialized
+  std::vector<std::pair<const char*, double>> startup_phases;
+  double flows_ms = 0;
+  auto phase_begin = std::chrono::steady_clock::now();
+  auto end_phase = [&](const char* name, double excluded_ms = 0) {
+    const auto now = std::chrono::steady_clock::now();
+    startup_phases.emplace_back(
+        name,
+        std::chrono::duration<double, std::milli>(now - phase_begin).count() - excluded_ms);
+    phase_begin = now;
+  };
+
   static struct rte_eth_conf conf_eth_port = {
       .rxmode = {
               .mq_mode = RTE_ETH_MQ_RX_RSS,
@@ -385,9 +885,11 @@ void DpdkMgr::initialize() {
   std::unordered_map<uint16_t, std::pair<uint16_t, uint16_t>> port_q_num;
   std::unordered_map<uint16_t, std::string> port_id_to_name;
 
-  // Get GPU PCIe BDFs since they're needed to pass to DPDK
+  // Get GPU PCIe BDFs since they're needed to pass to DPDK. A secondary process runs no
+  // workers, it only needs the master core.
   for (const auto& intf : cfg_.ifs_) {
     ifs.emplace(intf.address_);
+    if (is_secondary()) { continue; }
     for (const auto& q : intf.rx_.queues_) { cores += q.common_.cpu_core_ + ","; }
 
     for (const auto& q : intf.tx_.queues_) { cores += q.common_.cpu_core_ + ","; }
@@ -398,10 +900,18 @@ void DpdkMgr::initialize() {
   num_ports = ifs.size();
   HOLOSCAN_LOG_INFO("Attempting to use {} ports for high-speed network", num_ports);
 
+  // Processes sharing the NIC find each other with the file prefix of their hugepage files
+  const auto& multi_process = cfg_.multi_process_;
+  const std::string file_prefix = multi_process.type_ == ProcessType::STANDALONE
+                                      ? generate_random_string(10)
+                                      : multi_process.file_prefix_;
   strncpy(_argv[arg++], "operator", max_arg_size - 1);
-  strncpy(_argv[arg++],
-          (std::string("--file-prefix=") + generate_random_string(10)).c_str(),
-          max_arg_size - 1);
+  strncpy(_argv[arg++], (std::string("--file-prefix=") + file_prefix).c_str(), max_arg_size - 1);
+  if (multi_process.type_ == ProcessType::PRIMARY) {
+    strncpy(_argv[arg++], "--proc-type=primary", max_arg_size - 1);
+  } else if (multi_process.type_ == ProcessType::SECONDARY) {
+    strncpy(_argv[arg++], "--proc-type=secondary", max_arg_size - 1);
+  }
   strncpy(_argv[arg++], "-l", max_arg_size - 1);
   strncpy(_argv[arg++], cores.c_str(), max_arg_size - 1);
 
@@ -432,6 +942,7 @@ void DpdkMgr::initialize() {
     HOLOSCAN_LOG_CRITICAL("Invalid EAL arguments: {}", rte_errno);
     return;
   }
+  end_phase("EAL init");
 
   // Set up the port IDs to map to DPDK port IDs
   for (auto& intf : cfg_.ifs_) {
@@ -446,6 +957,20 @@ void DpdkMgr::initialize() {
     rte_eth_macaddr_get(i, &mac_addrs[i]);
   }
 
+  // The primary process already set up the ports, pools, rings and flows
+  if (is_secondary()) {
+    if (attach_pools_and_rings() < 0) {
+      HOLOSCAN_LOG_CRITICAL("Failed to attach to the pools and rings of the primary process");
+      return;
+    }
+    end_phase("Attach to primary");
+    HOLOSCAN_LOG_INFO("DPDK secondary process attached to primary {} in {:.1f} ms",
+                      file_prefix,
+                      startup_phases.front().second + startup_phases.back().second);
+    this->initialized_ = true;
+    return;
+  }
+
   // Initialize the mapping to determine how many RX queues per core
   this->init_rx_core_q_map();
 
@@ -458,6 +983,7 @@ void DpdkMgr::initialize() {
     HOLOSCAN_LOG_CRITICAL("Failed to allocate memory");
     return;
   }
+  end_phase("MR allocation");
 
   if (register_mrs() != Status::SUCCESS) {
     HOLOSCAN_LOG_CRITICAL("Failed to register MRs");
@@ -468,6 +994,7 @@ void DpdkMgr::initialize() {
     HOLOSCAN_LOG_CRITICAL("Failed to map MRs");
     return;
   }
+  end_phase("MR registration and DMA map");
 
   // Build name to id mapping
   int max_rx_batch_size = 0;
@@ -574,6 +1101,10 @@ void DpdkMgr::initialize() {
           rx_seg->length = (seg == (q.common_.mrs_.size() - 1))
                               ? 0
                               : cfg_.mrs_[q.common_.mrs_[seg]].adj_size_ - RTE_PKTMBUF_HEADROOM;
+          // The split boundary sets the header length, the same as with the Rivermax manager
+          if (seg == 0 && q.common_.split_boundary_ > 0) {
+            rx_seg->length = std::min<uint32_t>(rx_seg->length, q.common_.split_boundary_);
+          }
           rx_seg->offset = 0;
         }
 
@@ -584,10 +1115,35 @@ void DpdkMgr::initialize() {
       uint32_t key = generate_queue_key(intf.port_id_, q.common_.id_);
       rx_dpdk_q_map_[key] = q_backend;
       rx_cfg_q_map_[key]  = &q;
+
+      if (rx.latency_stats_) {
+        rx_latency_stats_[key] = std::make_unique<RxQueueLatencyHistograms>();
+      }
     }
 
     local_port_conf[intf.port_id_].rxmode.offloads |= RTE_ETH_RX_OFFLOAD_CHECKSUM;
 
+    const bool has_tap = std::any_of(rx.queues_.begin(), rx.queues_.end(),
+                                     [](const RxQueueConfig& q) { return !q.tap_.file_.empty(); });
+    const bool has_adaptive_poll =
+        std::any_of(rx.queues_.begin(), rx.queues_.end(),
+                    [](const RxQueueConfig& q) { return q.adaptive_poll_.enabled_; });
+
+    // Interrupts are armed by idle adaptive polling workers only
+    if (has_adaptive_poll) { local_port_conf[intf.port_id_].intr_conf.rxq = 1; }
+
+    if ((rx.latency_stats_ || has_tap || has_adaptive_poll || intf.ptp_.enabled_) &&
+        rx.queues_.size() > 0) {
+      if ((dev_info.rx_offload_capa & RTE_ETH_RX_OFFLOAD_TIMESTAMP) == 0) {
+        HOLOSCAN_LOG_WARN("NIC RX timestamps not supported on port {}. Wire latencies won't "
+                          "be measured, and captures use host time",
+                          intf.port_id_);
+      } else if (setup_rx_timestamp()) {
+        local_port_conf[intf.port_id_].rxmode.offloads |= RTE_ETH_RX_OFFLOAD_TIMESTAMP;
+        nic_clock_hz_[intf.port_id_] = 0;  // Measured once the port is started
+      }
+    }
+
     // TX now
     // For now make a single queue. Support more sophisticated TX on next release
     const auto& tx = intf.tx_;
@@ -646,6 +1202,7 @@ void DpdkMgr::initialize() {
       }
 
       max_pkt_size = std::max(max_pkt_size, q_packet_size);
+      q_backend->cpu_writable = cfg_.mrs_[q.common_.mrs_[0]].kind_ != MemoryKind::DEVICE;
       uint32_t key = generate_queue_key(intf.port_id_, q.common_.id_);
       tx_dpdk_q_map_[key] = q_backend;
     }
@@ -680,6 +1237,14 @@ void DpdkMgr::initialize() {
           local_port_conf[intf.port_id_].txmode.offloads |= RTE_ETH_RX_OFFLOAD_TIMESTAMP;
         }
       }
+
+      // Rate-limited queues pace packets on the NIC clock, measured once the port is started
+      for (const auto& q : tx.queues_) {
+        if (q.rate_limit_.gbps_ > 0 || q.rate_limit_.ipg_ns_ > 0) {
+          nic_clock_hz_[intf.port_id_] = 0;
+          break;
+        }
+      }
     }
 
     if ((dev_info.tx_offload_capa & RTE_ETH_TX_OFFLOAD_MBUF_FAST_FREE) != 0) {
@@ -691,6 +1256,13 @@ void DpdkMgr::initialize() {
         RTE_ETH_TX_OFFLOAD_IPV4_CKSUM | RTE_ETH_TX_OFFLOAD_UDP_CKSUM |
         RTE_ETH_TX_OFFLOAD_TCP_CKSUM | RTE_ETH_TX_OFFLOAD_MULTI_SEGS;
 
+    // Large sends are segmented by the NIC when it can, and in software otherwise
+    if ((dev_info.tx_offload_capa & RTE_ETH_TX_OFFLOAD_UDP_TSO) != 0) {
+      local_port_conf[intf.port_id_].txmode.offloads |= RTE_ETH_TX_OFFLOAD_UDP_TSO;
+      tx_udp_seg_max_mbufs_[intf.port_id_] =
+          dev_info.tx_desc_lim.nb_seg_max > 0 ? dev_info.tx_desc_lim.nb_seg_max : UINT16_MAX;
+    }
+
 
     HOLOSCAN_LOG_INFO("Initializing port {} with {} RX queues and {} TX queues...",
                       intf.port_id_,
@@ -807,6 +1379,10 @@ void DpdkMgr::initialize() {
       HOLOSCAN_LOG_INFO("Successfully started port {}", intf.port_id_);
     }
 
+    if (nic_clock_hz_.find(intf.port_id_) != nic_clock_hz_.end()) {
+      measure_nic_clock(intf.port_id_);
+    }
+
     HOLOSCAN_LOG_INFO("Port {}, MAC address: {:02X}:{:02X}:{:02X}:{:02X}:{:02X}:{:02X}",
                       intf.port_id_,
                       conf_ports_eth_addr[intf.port_id_].addr_bytes[0],
@@ -817,20 +1393,31 @@ void DpdkMgr::initialize() {
                       conf_ports_eth_addr[intf.port_id_].addr_bytes[5]);
 
     // Start flows
-    int flow_num = 0;
+    const auto flows_begin = std::chrono::steady_clock::now();
     for (const auto& flow : rx.flows_) {
       HOLOSCAN_LOG_INFO("Adding RX flow {}", flow.name_);
       add_flow(intf.port_id_, flow);
     }
+    flows_ms += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() -
+                                                          flows_begin).count();
 
     apply_tx_offloads(intf.port_id_);
   }
-
+  end_phase("Packet pools and ports", flows_ms);
+  startup_phases.emplace_back("Flows", flows_ms);
 
   if (setup_pools_and_rings(max_rx_batch_size, max_tx_batch_size) < 0) {
     HOLOSCAN_LOG_ERROR("Failed to set up pools and rings!");
     return;
   }
+  end_phase("Burst pools and rings");
+
+  double total_ms = 0;
+  for (const auto& phase : startup_phases) { total_ms += phase.second; }
+  HOLOSCAN_LOG_INFO("DPDK manager startup took {:.1f} ms:", total_ms);
+  for (const auto& phase : startup_phases) {
+    HOLOSCAN_LOG_INFO(" - {}: {:.1f} ms", phase.first, phase.second);
+  }
 
   this->initialized_ = true;
 }
@@ -840,12 +1427,18 @@ int DpdkMgr::setup_pools_and_rings(int max_rx_batch, int max_tx_batch) {
   for (int i = 0; i < cfg_.ifs_.size(); i++) {
     int port_id = cfg_.ifs_[i].port_id_;
     for (int j = 0; j < cfg_.ifs_[i].rx_.queues_.size(); j++) {
-      int q_id = cfg_.ifs_[i].rx_.queues_[j].common_.id_;
+      const auto& q = cfg_.ifs_[i].rx_.queues_[j];
+      int q_id = q.common_.id_;
       std::string ring_name = "RX_RING_P" + std::to_string(port_id) + "_Q" + std::to_string(q_id);
 
+      // The RX worker dequeues from the ring too when reclaiming the oldest burst
+      unsigned int ring_flags = RING_F_SP_ENQ;
+      if (q.overload_policy_ != RxOverloadPolicy::DROP_OLDEST_IN_RING) {
+        ring_flags |= RING_F_SC_DEQ;
+      }
+
       struct rte_ring* ring = rte_ring_create(
-          ring_name.c_str(), 2048, rte_socket_id(),
-          RING_F_SC_DEQ | RING_F_SP_ENQ);
+          ring_name.c_str(), 2048, rte_socket_id(), ring_flags);
 
       if (ring == nullptr) {
         HOLOSCAN_LOG_CRITICAL(
@@ -974,12 +1567,151 @@ int DpdkMgr::setup_pools_and_rings(int max_rx_batch, int max_tx_batch) {
   return 0;
 }
 
+int DpdkMgr::attach_pools_and_rings() {
+  // Packet buffers are only shared across processes when they're in hugepages
+  for (const auto& [name, mr] : cfg_.mrs_) {
+    if (mr.kind_ != MemoryKind::HUGE) {
+      HOLOSCAN_LOG_CRITICAL("Memory region {} must be of kind huge to be used by a secondary "
+                            "process", name);
+      return -1;
+    }
+  }
+
+  auto lookup_pool = [](const std::string& name) {
+    auto pool = rte_mempool_lookup(name.c_str());
+    if (pool == nullptr) { HOLOSCAN_LOG_CRITICAL("Primary process has no mempool {}", name); }
+    return pool;
+  };
+  auto lookup_ring = [](const std::string& name) {
+    auto ring = rte_ring_lookup(name.c_str());
+    if (ring == nullptr) { HOLOSCAN_LOG_CRITICAL("Primary process has no ring {}", name); }
+    return ring;
+  };
+
+  for (const auto& intf : cfg_.ifs_) {
+    for (const auto& q : intf.rx_.queues_) {
+      const auto append =
+          "_P" + std::to_string(intf.port_id_) + "_Q" + std::to_string(q.common_.id_);
+      auto q_backend = new DPDKQueueConfig{};
+      for (int mr_num = 0; mr_num < q.common_.mrs_.size(); mr_num++) {
+        auto pool = lookup_pool("RXP" + append + "_MR" + std::to_string(mr_num));
+        if (pool == nullptr) { return -1; }
+        q_backend->pools.push_back(pool);
+      }
+
+      // RX rings have a single consumer, each queue is received by one process
+      uint32_t key = generate_queue_key(intf.port_id_, q.common_.id_);
+      rx_rings[key] = lookup_ring("RX_RING" + append);
+      if (rx_rings[key] == nullptr) { return -1; }
+      rx_dpdk_q_map_[key] = q_backend;
+      rx_cfg_q_map_[key] = &q;
+      HOLOSCAN_LOG_INFO("Attached to RX queue {} ({}) on port {}",
+                        q.common_.name_, q.common_.id_, intf.port_id_);
+    }
+
+    for (const auto& q : intf.tx_.queues_) {
+      const auto append =
+          "P" + std::to_string(intf.port_id_) + "_Q" + std::to_string(q.common_.id_);
+      auto q_backend = new DPDKQueueConfig{};
+      for (int mr_num = 0; mr_num < q.common_.mrs_.size(); mr_num++) {
+        auto pool = lookup_pool("TXP_" + append + "_MR" + std::to_string(mr_num));
+        if (pool == nullptr) { return -1; }
+        q_backend->pools.push_back(pool);
+      }
+      q_backend->cpu_writable = true;
+
+      uint32_t key = generate_queue_key(intf.port_id_, q.common_.id_);
+      tx_rings[key] = lookup_ring("TX_RING_" + append);
+      tx_burst_buffers[key] = lookup_pool("TX_BURST_POOL_" + append);
+      if (tx_rings[key] == nullptr || tx_burst_buffers[key] == nullptr) { return -1; }
+      tx_dpdk_q_map_[key] = q_backend;
+      HOLOSCAN_LOG_INFO("Attached to TX queue {} ({}) on port {}",
+                        q.common_.name_, q.common_.id_, intf.port_id_);
+    }
+  }
+
+  rx_burst_buffer = lookup_pool("RX_BURST_POOL");
+  rx_flow_id_buffer = lookup_pool("RX_FLOWID_POOL");
+  rx_metadata = lookup_pool("RX_META_POOL");
+  tx_metadata = lookup_pool("TX_META_POOL");
+  if (rx_burst_buffer == nullptr || rx_flow_id_buffer == nullptr || rx_metadata == nullptr ||
+      tx_metadata == nullptr) {
+    return -1;
+  }
+
+  return 0;
+}
+
 #define MAX_PATTERN_NUM 4
 #define MAX_ACTION_NUM 3
 
 
+Status DpdkMgr::add_flow(int port, const FlowConfig& cfg) {
+  if (is_secondary()) {
+    HOLOSCAN_LOG_ERROR("Flows are owned by the primary process, can't add flow {}", cfg.name_);
+    return Status::NOT_SUPPORTED;
+  }
+
+  if (port < 0 || port >= static_cast<int>(cfg_.ifs_.size())) {
+    HOLOSCAN_LOG_ERROR("Invalid port {} for flow {}", port, cfg.name_);
+    return Status::INVALID_PARAMETER;
+  }
+
+  const auto& queues = cfg_.ifs_[port].rx_.queues_;
+  if (std::none_of(queues.begin(), queues.end(), [&cfg](const RxQueueConfig& q) {
+        return q.common_.id_ == cfg.action_.id_;
+      })) {
+    HOLOSCAN_LOG_ERROR("Flow {} targets unknown RX queue {} on port {}",
+                       cfg.name_, cfg.action_.id_, port);
+    return Status::INVALID_PARAMETER;
+  }
+
+  std::lock_guard<std::mutex> lock(flow_mutex_);
+  const auto key = generate_queue_key(port, cfg.id_);
+  if (flows_.find(key) != flows_.end()) {
+    HOLOSCAN_LOG_ERROR("Flow ID {} already exists on port {}", cfg.id_, port);
+    return Status::INVALID_PARAMETER;
+  }
+
+  auto flow = create_flow(port, cfg);
+  if (flow == nullptr) {
+    HOLOSCAN_LOG_ERROR("Failed to add flow {} on port {}", cfg.name_, port);
+    return Status::INTERNAL_ERROR;
+  }
+
+  flows_[key] = flow;
+  HOLOSCAN_LOG_INFO("Added flow {} (ID {}) to queue {} on port {}",
+                    cfg.name_, cfg.id_, cfg.action_.id_, port);
+  return Status::SUCCESS;
+}
+
+Status DpdkMgr::remove_flow(int port, uint16_t flow_id) {
+  if (is_secondary()) {
+    HOLOSCAN_LOG_ERROR("Flows are owned by the primary process, can't remove flow {}", flow_id);
+    return Status::NOT_SUPPORTED;
+  }
+
+  std::lock_guard<std::mutex> lock(flow_mutex_);
+  const auto it = flows_.find(generate_queue_key(port, flow_id));
+  if (it == flows_.end()) {
+    HOLOSCAN_LOG_ERROR("No flow with ID {} on port {}", flow_id, port);
+    return Status::INVALID_PARAMETER;
+  }
+
+  struct rte_flow_error error;
+  if (rte_flow_destroy(port, it->second, &error) != 0) {
+    HOLOSCAN_LOG_ERROR("Failed to remove flow {} on port {}: {}",
+                       flow_id, port, error.message ? error.message : "unknown error");
+    return Status::INTERNAL_ERROR;
+  }
+
+  flows_.erase(it);
+  HOLOSCAN_LOG_INFO("Removed flow {} on port {}", flow_id, port);
+  return Status::SUCCESS;
+}
+
 // Taken from flow_block.c DPDK example */
-struct rte_flow* DpdkMgr::add_flow(int port, const FlowConfig& cfg) {
+struct rte_flow* DpdkMgr::create_flow(int port, const FlowConfig& cfg) {
   /* Declaring structs being used. 8< */
   struct rte_flow_attr attr;
   struct rte_flow_item pattern[MAX_PATTERN_NUM];
@@ -996,8 +1728,8 @@ struct rte_flow* DpdkMgr::add_flow(int port, const FlowConfig& cfg) {
   int res;
 
   // HWS requires using a non-zero group, so we make a jump event to group 3 for all ethernet
-  // packets
-  {
+  // packets. It's shared by all flows of the port.
+  if (flow_jumps_.find(port) == flow_jumps_.end()) {
     struct rte_flow_error jump_error;
     struct rte_flow_attr jump_attr{.group = 0, .ingress = 1};
     struct rte_flow_action_jump jump_v = {.group = 3};
@@ -1017,6 +1749,8 @@ struct rte_flow* DpdkMgr::add_flow(int port, const FlowConfig& cfg) {
           port, &jump_attr, jump_pattern, jump_actions, &jump_error);
       if (flow == nullptr) {
         HOLOSCAN_LOG_ERROR("rte_flow_create failed");
+      } else {
+        flow_jumps_[port] = flow;
       }
     } else {
       HOLOSCAN_LOG_ERROR("Failed flow validation: {}", res);
@@ -1154,6 +1888,12 @@ struct rte_flow* DpdkMgr::add_modify_flow_set(int port, int queue, const char* b
 }
 
 void DpdkMgr::apply_tx_offloads(int port) {
+  if (tx_udp_seg_max_mbufs_.find(port) != tx_udp_seg_max_mbufs_.end()) {
+    HOLOSCAN_LOG_INFO("Large sends on port {} use UDP segmentation offload", port);
+  } else {
+    HOLOSCAN_LOG_INFO("Large sends on port {} are segmented in software", port);
+  }
+
   for (const auto& q : cfg_.ifs_[port].tx_.queues_) {
     for (const auto& off : q.common_.offloads_) {
       if (off == "tx_eth_src") {  // Offload Ethernet source copy
@@ -1246,6 +1986,27 @@ DpdkMgr::~DpdkMgr() {
 bool DpdkMgr::validate_config() const {
   if (!Manager::validate_config()) { return false; }
 
+  // Tap writers run outside of EAL and must not steal a core from a worker
+  std::set<int> worker_cores = {cfg_.common_.master_core_};
+  for (const auto& intf : cfg_.ifs_) {
+    for (const auto& q : intf.rx_.queues_) {
+      worker_cores.insert(strtol(q.common_.cpu_core_.c_str(), nullptr, 10));
+    }
+    for (const auto& q : intf.tx_.queues_) {
+      worker_cores.insert(strtol(q.common_.cpu_core_.c_str(), nullptr, 10));
+    }
+  }
+  for (const auto& intf : cfg_.ifs_) {
+    for (const auto& q : intf.rx_.queues_) {
+      if (q.tap_.file_.empty()) { continue; }
+      if (worker_cores.count(strtol(q.tap_.cpu_core_.c_str(), nullptr, 10))) {
+        HOLOSCAN_LOG_ERROR("Capture tap of queue {} uses core {}, which is already used by a "
+                           "worker", q.common_.name_, q.tap_.cpu_core_);
+        return false;
+      }
+    }
+  }
+
   HOLOSCAN_LOG_INFO("Config validated successfully");
   return true;
 }
@@ -1286,11 +2047,29 @@ void DpdkMgr::run() {
       params->flowid_pool = rx_flow_id_buffer;
       params->meta_pool = rx_metadata;
       params->batch_size = q->common_.batch_size_;
+      params->timeout_us = q->timeout_us_;
+      params->overload_policy = q->overload_policy_;
+      params->tap = start_rx_tap(port_id, *q);
+      params->adaptive_poll = q->adaptive_poll_;
+      params->poll_stats = nullptr;
+      params->nic_clock_hz = get_rx_nic_clock_hz(port_id);
+      if (q->adaptive_poll_.enabled_) {
+        auto& poll_stats = rx_adaptive_poll_stats_[el.first];
+        poll_stats = std::make_unique<RxAdaptivePollStats>();
+        params->poll_stats = poll_stats.get();
+      }
       rte_eal_remote_launch(
           rx_core_worker, (void*)params, strtol(q->common_.cpu_core_.c_str(), NULL, 10));
     } else {
       // Multi-q worker
       auto params = new RxWorkerMultiQParams;
+
+      // The core backs off only when all its queues allow it, as late as the latest of them
+      auto& poll_cfg = params->adaptive_poll;
+      poll_cfg.enabled_ = true;
+      poll_cfg.idle_polls_ = 0;
+      poll_cfg.pause_polls_ = 0;
+      poll_cfg.max_sleep_ms_ = UINT32_MAX;
       for (const auto &q_info : el.second) {
         uint16_t port_id = q_info.first;
         uint16_t q_id    = q_info.second;
@@ -1299,7 +2078,28 @@ void DpdkMgr::run() {
         struct rte_ring* ring_ptr = rx_rings[key];
 
         params->q_params.push_back({port_id, q_id,
-                    (int)q->common_.mrs_.size(), q->common_.batch_size_, ring_ptr});
+                    (int)q->common_.mrs_.size(), q->common_.batch_size_, ring_ptr,
+                    q->overload_policy_, start_rx_tap(port_id, *q),
+                    get_rx_nic_clock_hz(port_id)});
+
+        const auto& q_poll = q->adaptive_poll_;
+        poll_cfg.enabled_ = poll_cfg.enabled_ && q_poll.enabled_;
+        poll_cfg.idle_polls_ = std::max(poll_cfg.idle_polls_, q_poll.idle_polls_);
+        poll_cfg.pause_polls_ = std::max(poll_cfg.pause_polls_, q_poll.pause_polls_);
+        poll_cfg.max_sleep_ms_ = std::min(poll_cfg.max_sleep_ms_, q_poll.max_sleep_ms_);
+      }
+
+      params->poll_stats = nullptr;
+      if (poll_cfg.enabled_) {
+        auto& poll_stats = rx_adaptive_poll_stats_[el.first];
+        poll_stats = std::make_unique<RxAdaptivePollStats>();
+        params->poll_stats = poll_stats.get();
+      } else if (std::any_of(el.second.begin(), el.second.end(), [this](const auto& q_info) {
+                   return rx_cfg_q_map_[generate_queue_key(q_info.first, q_info.second)]
+                       ->adaptive_poll_.enabled_;
+                 })) {
+        HOLOSCAN_LOG_WARN("Not all queues on core {} enable adaptive_poll. The core will busy "
+                          "poll", el.first);
       }
 
       params->burst_pool = rx_burst_buffer;
@@ -1315,13 +2115,18 @@ void DpdkMgr::run() {
       for (auto& q : tx.queues_) {
         uint32_t key = generate_queue_key(intf.port_id_, q.common_.id_);
         auto params = new TxWorkerParams;
-        //  params->hds    = q.common_.hds_ > 0;
         params->port = intf.port_id_;
         params->ring = tx_rings[key];
         params->queue = q.common_.id_;
         params->burst_pool = tx_burst_buffers[key];
         params->meta_pool = tx_metadata;
         params->batch_size = q.common_.batch_size_;
+        params->rate_limit = q.rate_limit_;
+        params->nic_clock_hz = 0;
+        params->timestamp_offset = static_cast<int>(timestamp_offset_);
+        params->timestamp_mask = tx.accurate_send_ ? timestamp_mask_ : 0;
+        const auto clk_it = nic_clock_hz_.find(intf.port_id_);
+        if (clk_it != nic_clock_hz_.end()) { params->nic_clock_hz = clk_it->second; }
         rte_eth_macaddr_get(intf.port_id_, &params->mac_addr);
         rte_eal_remote_launch(
             tx_worker, (void*)params, strtol(q.common_.cpu_core_.c_str(), NULL, 10));
@@ -1343,6 +2148,155 @@ void DpdkMgr::flush_packets(int port) {
   while (rte_eth_rx_burst(port, 0, &rx_mbuf, 1) != 0) { rte_pktmbuf_free(rx_mbuf); }
 }
 
+/**
+ * @brief Allocates the metadata and packet buffers of an RX burst, all or nothing
+ *
+ * @return true on success, otherwise err holds the depleted pool
+ */
+static bool alloc_rx_burst(struct rte_mempool* meta_pool, struct rte_mempool* burst_pool,
+                           struct rte_mempool* flowid_pool, int num_segs, BurstParams** burst,
+                           ErrorGlobalStats* err) {
+  if (rte_mempool_get(meta_pool, reinterpret_cast<void**>(burst)) < 0) {
+    *err = ErrorGlobalStats::METADATA_BUF_DEPLETED;
+    return false;
+  }
+
+  BurstParams* b = *burst;
+  if (rte_mempool_get_bulk(burst_pool, reinterpret_cast<void**>(&b->pkts[0]), num_segs) < 0) {
+    rte_mempool_put(meta_pool, b);
+    *err = ErrorGlobalStats::OUT_OF_RX_BUFFERS;
+    return false;
+  }
+
+  if (rte_mempool_get(flowid_pool, reinterpret_cast<void**>(&b->pkt_extra_info)) < 0) {
+    rte_mempool_put_bulk(burst_pool, reinterpret_cast<void* const*>(&b->pkts[0]), num_segs);
+    rte_mempool_put(meta_pool, b);
+    *err = ErrorGlobalStats::OUT_OF_RX_BUFFERS;
+    return false;
+  }
+
+  return true;
+}
+
+/**
+ * @brief Drops an RX burst that never reached the application, packets included
+ */
+static void drop_rx_burst(BurstParams* burst, struct rte_mempool* meta_pool,
+                          struct rte_mempool* burst_pool, struct rte_mempool* flowid_pool) {
+  const int num_pkts = burst->hdr.hdr.num_pkts;
+  if (num_pkts > 0) {
+    // Freeing the first segment releases the whole chain of scattered packets
+    rte_pktmbuf_free_bulk(reinterpret_cast<rte_mbuf**>(burst->pkts[0]), num_pkts);
+    inc_rx_error_stat(ErrorGlobalStats::RX_PACKETS_DROPPED, num_pkts);
+  }
+
+  rte_mempool_put(flowid_pool, burst->pkt_extra_info);
+  rte_mempool_put_bulk(
+      burst_pool, reinterpret_cast<void* const*>(&burst->pkts[0]), burst->hdr.hdr.num_segs);
+  burst->hdr.hdr.num_pkts = 0;
+  burst->pkt_extra_info = nullptr;
+  rte_mempool_put(meta_pool, burst);
+}
+
+/**
+ * @brief Drops packets already pulled off the NIC
+ */
+static void drop_rx_packets(struct rte_mbuf** mbufs, int num_pkts) {
+  if (num_pkts <= 0) { return; }
+  rte_pktmbuf_free_bulk(mbufs, num_pkts);
+  inc_rx_error_stat(ErrorGlobalStats::RX_PACKETS_DROPPED, num_pkts);
+}
+
+/**
+ * @brief Applies the overload policy of a queue while no RX burst can be allocated
+ *
+ * Called repeatedly until the allocation succeeds. pending holds packets received from
+ * the NIC but not yet copied into a burst; they're dropped under drop_newest.
+ */
+static void handle_rx_alloc_failure(RxOverloadPolicy policy, int port, int queue,
+                                    struct rte_ring* ring, struct rte_mempool* meta_pool,
+                                    struct rte_mempool* burst_pool,
+                                    struct rte_mempool* flowid_pool, struct rte_mbuf** pending,
+                                    int* num_pending) {
+  switch (policy) {
+    case RxOverloadPolicy::ABORT:
+      HOLOSCAN_LOG_CRITICAL("RX buffers depleted on port/queue {}/{} with abort policy",
+                            port, queue);
+      exit(1);
+    case RxOverloadPolicy::BLOCK:
+      rte_pause();
+      return;
+    case RxOverloadPolicy::DROP_OLDEST_IN_RING: {
+      BurstParams* oldest = nullptr;
+      if (rte_ring_dequeue(ring, reinterpret_cast<void**>(&oldest)) == 0) {
+        drop_rx_burst(oldest, meta_pool, burst_pool, flowid_pool);
+        return;
+      }
+      // Nothing left to reclaim in the ring, the application owns every buffer
+      [[fallthrough]];
+    }
+    case RxOverloadPolicy::DROP_NEWEST:
+    default: {
+      drop_rx_packets(pending, *num_pending);
+      *num_pending = 0;
+
+      // Keep the NIC queue drained so its mbufs get recycled
+      struct rte_mbuf* mbufs[DpdkMgr::DEFAULT_NUM_RX_BURST];
+      drop_rx_packets(mbufs, rte_eth_rx_burst(port, queue, mbufs, DpdkMgr::DEFAULT_NUM_RX_BURST));
+      return;
+    }
+  }
+}
+
+/**
+ * @brief Hands a complete RX burst to the application, applying the overload policy when
+ * the ring is full
+ *
+ * @return true if the burst was enqueued, false if it was dropped
+ */
+static bool enqueue_rx_burst(RxOverloadPolicy policy, struct rte_ring* ring, BurstParams* burst,
+                             struct rte_mempool* meta_pool, struct rte_mempool* burst_pool,
+                             struct rte_mempool* flowid_pool) {
+  stamp_rx_burst(burst);
+  const int port = burst->hdr.hdr.port_id;
+  const int q = burst->hdr.hdr.q_id;
+  if (rte_ring_enqueue(ring, reinterpret_cast<void*>(burst)) == 0) {
+    Manager::notify_rx_ready(port, q);
+    return true;
+  }
+
+  inc_rx_error_stat(ErrorGlobalStats::RX_QUEUE_FULL);
+  do {
+    switch (policy) {
+      case RxOverloadPolicy::ABORT:
+        HOLOSCAN_LOG_CRITICAL("RX ring {} full with abort policy", ring->name);
+        exit(1);
+      case RxOverloadPolicy::BLOCK:
+        rte_pause();
+        break;
+      case RxOverloadPolicy::DROP_OLDEST_IN_RING: {
+        BurstParams* oldest = nullptr;
+        if (rte_ring_dequeue(ring, reinterpret_cast<void**>(&oldest)) == 0) {
+          drop_rx_burst(oldest, meta_pool, burst_pool, flowid_pool);
+        }
+        break;
+      }
+      case RxOverloadPolicy::DROP_NEWEST:
+      default:
+        drop_rx_burst(burst, meta_pool, burst_pool, flowid_pool);
+        return false;
+    }
+
+    if (rte_ring_enqueue(ring, reinterpret_cast<void*>(burst)) == 0) {
+      Manager::notify_rx_ready(port, q);
+      return true;
+    }
+  } while (!force_quit.load());
+
+  drop_rx_burst(burst, meta_pool, burst_pool, flowid_pool);
+  return false;
+}
+
 /*
   RX worker supporting multiple queues for a single core. This is useful when a user wants
   to segregate traffic by queues, but they don't want to waste extra CPU cores by mapping a
@@ -1380,16 +2334,38 @@ int DpdkMgr::rx_core_multi_q_worker(void* arg) {
   uint16_t cur_segs       = tparams->q_params[cur_idx].num_segs;
   uint32_t cur_batch_size = tparams->q_params[cur_idx].batch_size;
 
+  std::vector<RxAdaptivePoller::Queue> poll_queues;
+  for (const auto& pq : tparams->q_params) {
+    poll_queues.push_back(
+        {static_cast<uint16_t>(pq.port), static_cast<uint16_t>(pq.queue), pq.nic_clock_hz});
+  }
+  RxAdaptivePoller poller(tparams->adaptive_poll, std::move(poll_queues), tparams->poll_stats);
+  poller.start();
 
   //
   //  run loop
   //
   while (!force_quit.load()) {
-    if (rte_mempool_get(tparams->meta_pool, reinterpret_cast<void**>(&bursts[cur_idx])) < 0) {
-      HOLOSCAN_LOG_ERROR("Processing function falling behind. No free buffers for metadata!");
-      exit(1);
+    ErrorGlobalStats alloc_err;
+    bool overloaded = false;
+    while (!alloc_rx_burst(tparams->meta_pool, tparams->burst_pool, tparams->flowid_pool,
+                           cur_segs, &bursts[cur_idx], &alloc_err)) {
+      if (!overloaded) {
+        HOLOSCAN_LOG_ERROR("Processing function falling behind. No free RX buffers on {}/{}!",
+                           cur_port, cur_q);
+        inc_rx_error_stat(alloc_err);
+        overloaded = true;
+      }
+
+      handle_rx_alloc_failure(tparams->q_params[cur_idx].overload_policy, cur_port, cur_q,
+                              tparams->q_params[cur_idx].ring, tparams->meta_pool,
+                              tparams->burst_pool, tparams->flowid_pool,
+                              &mbuf_arr[to_copy[cur_idx]], &nb_rx[cur_idx]);
+      if (force_quit.load()) { break; }
     }
 
+    if (overloaded && force_quit.load()) { break; }
+
     BurstParams* burst  = bursts[cur_idx];
 
     //  Queue ID for receiver to differentiate
@@ -1397,20 +2373,6 @@ int DpdkMgr::rx_core_multi_q_worker(void* arg) {
     burst->hdr.hdr.port_id  = cur_port;
     burst->hdr.hdr.num_segs = cur_segs;
 
-    for (int seg = 0; seg < cur_segs; seg++) {
-      if (rte_mempool_get(tparams->burst_pool, reinterpret_cast<void**>(&burst->pkts[seg])) < 0) {
-        HOLOSCAN_LOG_ERROR(
-            "Processing function falling behind. No free flow ID buffers for packets!");
-        continue;
-      }
-    }
-
-    if (rte_mempool_get(
-          tparams->flowid_pool, reinterpret_cast<void**>(&burst->pkt_extra_info)) < 0) {
-      HOLOSCAN_LOG_ERROR("Processing function falling behind. No free CPU buffers for packets!");
-      continue;
-    }
-
     ExtraRxPacketInfo *pkt_info = reinterpret_cast<ExtraRxPacketInfo*>(burst->pkt_extra_info);
 
     if (nb_rx[cur_idx] > 0) {
@@ -1465,7 +2427,12 @@ int DpdkMgr::rx_core_multi_q_worker(void* arg) {
                                reinterpret_cast<rte_mbuf**>(&mbuf_arr[0]),
                                DpdkMgr::DEFAULT_NUM_RX_BURST);
 
+      if (nb_rx[cur_idx] > 0 && tparams->q_params[cur_idx].tap != nullptr) {
+        tparams->q_params[cur_idx].tap->mirror(mbuf_arr, nb_rx[cur_idx]);
+      }
+
       if (nb_rx[cur_idx] == 0) {
+        poller.on_empty_poll(true);
         cur_idx = (cur_idx + 1) % num_queues;
         cur_port       = tparams->q_params[cur_idx].port;
         cur_q          = tparams->q_params[cur_idx].queue;
@@ -1474,6 +2441,8 @@ int DpdkMgr::rx_core_multi_q_worker(void* arg) {
         continue;
       }
 
+      poller.on_packets(cur_idx, mbuf_arr[0]);
+
       to_copy[cur_idx] = std::min(nb_rx[cur_idx],
                                   (int)(cur_batch_size - burst->hdr.hdr.num_pkts));
       memcpy(&burst->pkts[0][burst->hdr.hdr.num_pkts],
@@ -1506,7 +2475,12 @@ int DpdkMgr::rx_core_multi_q_worker(void* arg) {
 
       if (burst->hdr.hdr.num_pkts == cur_batch_size) {
         cur_pkt_in_batch[cur_idx] = 0;
-        rte_ring_enqueue(tparams->q_params[cur_idx].ring, reinterpret_cast<void*>(burst));
+        enqueue_rx_burst(tparams->q_params[cur_idx].overload_policy,
+                         tparams->q_params[cur_idx].ring,
+                         burst,
+                         tparams->meta_pool,
+                         tparams->burst_pool,
+                         tparams->flowid_pool);
 
         // Don't move to the next queue yet since there may be some packets left over in the array
         break;
@@ -1514,6 +2488,8 @@ int DpdkMgr::rx_core_multi_q_worker(void* arg) {
     } while (!force_quit.load());
   }
 
+  poller.stop();
+
   HOLOSCAN_LOG_INFO("Total packets received by application (Port/Queue {}): {}",
                      pq_str,
                      total_pkts);
@@ -1539,6 +2515,12 @@ int DpdkMgr::rx_core_worker(void* arg) {
   flush_packets(tparams->port);
   struct rte_mbuf* mbuf_arr[DEFAULT_NUM_RX_BURST];
 
+  RxAdaptivePoller poller(tparams->adaptive_poll,
+                          {{static_cast<uint16_t>(tparams->port),
+                            static_cast<uint16_t>(tparams->queue), tparams->nic_clock_hz}},
+                          tparams->poll_stats);
+  poller.start();
+
   HOLOSCAN_LOG_INFO("Starting RX Core {}, port {}, queue {}, socket {}",
                     rte_lcore_id(),
                     tparams->port,
@@ -1552,30 +2534,30 @@ int DpdkMgr::rx_core_worker(void* arg) {
   //
   while (!force_quit.load()) {
     BurstParams* burst;
-    if (rte_mempool_get(tparams->meta_pool, reinterpret_cast<void**>(&burst)) < 0) {
-      HOLOSCAN_LOG_ERROR("Processing function falling behind. No free buffers for metadata!");
-      exit(1);
+    ErrorGlobalStats alloc_err;
+    bool overloaded = false;
+    while (!alloc_rx_burst(tparams->meta_pool, tparams->burst_pool, tparams->flowid_pool,
+                           tparams->num_segs, &burst, &alloc_err)) {
+      if (!overloaded) {
+        HOLOSCAN_LOG_ERROR("Processing function falling behind. No free RX buffers on {}/{}!",
+                           tparams->port, tparams->queue);
+        inc_rx_error_stat(alloc_err);
+        overloaded = true;
+      }
+
+      handle_rx_alloc_failure(tparams->overload_policy, tparams->port, tparams->queue,
+                              tparams->ring, tparams->meta_pool, tparams->burst_pool,
+                              tparams->flowid_pool, &mbuf_arr[to_copy], &nb_rx);
+      if (force_quit.load()) { break; }
     }
 
+    if (overloaded && force_quit.load()) { break; }
+
     //  Queue ID for receiver to differentiate
     burst->hdr.hdr.q_id = tparams->queue;
     burst->hdr.hdr.port_id = tparams->port;
     burst->hdr.hdr.num_segs = tparams->num_segs;
 
-    for (int seg = 0; seg < tparams->num_segs; seg++) {
-      if (rte_mempool_get(tparams->burst_pool, reinterpret_cast<void**>(&burst->pkts[seg])) < 0) {
-        HOLOSCAN_LOG_ERROR(
-            "Processing function falling behind. No free RX bursts!");
-        continue;
-      }
-    }
-
-    if (rte_mempool_get(
-          tparams->flowid_pool, reinterpret_cast<void**>(&burst->pkt_extra_info)) < 0) {
-      HOLOSCAN_LOG_ERROR("Processing function falling behind. No free CPU buffers for packets!");
-      continue;
-    }
-
     ExtraRxPacketInfo *pkt_info = reinterpret_cast<ExtraRxPacketInfo*>(burst->pkt_extra_info);
 
     if (nb_rx > 0) {
@@ -1621,6 +2603,8 @@ int DpdkMgr::rx_core_worker(void* arg) {
                                reinterpret_cast<rte_mbuf**>(&mbuf_arr[0]),
                                DEFAULT_NUM_RX_BURST);
 
+      if (nb_rx > 0 && tparams->tap != nullptr) { tparams->tap->mirror(mbuf_arr, nb_rx); }
+
       if (nb_rx == 0) {
         if (burst->hdr.hdr.num_pkts > 0 && timeout_cycles > 0) {
           const auto cur_cycles = rte_get_tsc_cycles();
@@ -1628,15 +2612,19 @@ int DpdkMgr::rx_core_worker(void* arg) {
           // We hit our timeout. Send the partial batch immediately
           if ((cur_cycles - last_cycles) > timeout_cycles) {
             cur_pkt_in_batch = 0;
-            rte_ring_enqueue(tparams->ring, reinterpret_cast<void*>(burst));
+            enqueue_rx_burst(tparams->overload_policy, tparams->ring, burst,
+                             tparams->meta_pool, tparams->burst_pool, tparams->flowid_pool);
             last_cycles = cur_cycles;
             break;
           }
         }
 
+        poller.on_empty_poll(burst->hdr.hdr.num_pkts == 0 || timeout_cycles == 0);
         continue;
       }
 
+      poller.on_packets(0, mbuf_arr[0]);
+
       to_copy = std::min(nb_rx, (int)(tparams->batch_size - burst->hdr.hdr.num_pkts));
       memcpy(&burst->pkts[0][burst->hdr.hdr.num_pkts], &mbuf_arr, sizeof(rte_mbuf*) * to_copy);
 
@@ -1665,7 +2653,8 @@ int DpdkMgr::rx_core_worker(void* arg) {
       nb_rx -= to_copy;
 
       if (burst->hdr.hdr.num_pkts == tparams->batch_size) {
-        rte_ring_enqueue(tparams->ring, reinterpret_cast<void*>(burst));
+        enqueue_rx_burst(tparams->overload_policy, tparams->ring, burst,
+                         tparams->meta_pool, tparams->burst_pool, tparams->flowid_pool);
         cur_pkt_in_batch = 0;
         last_cycles = rte_get_tsc_cycles();
         break;
@@ -1674,7 +2663,8 @@ int DpdkMgr::rx_core_worker(void* arg) {
 
         // We hit our timeout. Send the partial batch immediately
         if ((cur_cycles - last_cycles) > timeout_cycles) {
-          rte_ring_enqueue(tparams->ring, reinterpret_cast<void*>(burst));
+          enqueue_rx_burst(tparams->overload_policy, tparams->ring, burst,
+                         tparams->meta_pool, tparams->burst_pool, tparams->flowid_pool);
           cur_pkt_in_batch = 0;
           last_cycles = cur_cycles;
           break;
@@ -1683,6 +2673,8 @@ int DpdkMgr::rx_core_worker(void* arg) {
     } while (!force_quit.load());
   }
 
+  poller.stop();
+
   HOLOSCAN_LOG_INFO("Total packets received by application (port/queue {}/{}): {}",
                      tparams->port,
                      tparams->queue,
@@ -1691,6 +2683,119 @@ int DpdkMgr::rx_core_worker(void* arg) {
   return 0;
 }
 
+static void init_tx_shaper(TxRateShaper& shaper, const TxWorkerParams& params) {
+  const auto& cfg = params.rate_limit;
+  if (cfg.gbps_ <= 0 && cfg.ipg_ns_ == 0) { return; }
+
+  shaper.enabled = true;
+  shaper.port = params.port;
+  shaper.hw_pacing = params.nic_clock_hz > 0 && params.timestamp_mask != 0;
+  const double ticks_hz = shaper.hw_pacing ? params.nic_clock_hz : rte_get_tsc_hz();
+  const double ticks_per_ns = ticks_hz / 1e9;
+
+  if (cfg.gbps_ > 0) { shaper.bytes_per_tick = cfg.gbps_ * 1e9 / 8 / ticks_hz; }
+  // A full-size frame must always fit in the bucket
+  shaper.burst_bytes = std::max<double>(
+      cfg.burst_bytes_, DpdkMgr::JUMBOFRAME_SIZE + TxRateShaper::WIRE_OVERHEAD);
+  shaper.ipg_ticks = static_cast<uint64_t>(cfg.ipg_ns_ * ticks_per_ns);
+  shaper.tokens = shaper.burst_bytes;
+  shaper.last_tsc = rte_get_tsc_cycles();
+  shaper.burst_ticks =
+      shaper.bytes_per_tick > 0 ? static_cast<uint64_t>(shaper.burst_bytes / shaper.bytes_per_tick)
+                                : 0;
+  shaper.horizon_ticks = static_cast<uint64_t>(TxRateShaper::HW_PACING_HORIZON_NS * ticks_per_ns);
+  shaper.timestamp_offset = params.timestamp_offset;
+  shaper.timestamp_mask = params.timestamp_mask;
+
+  HOLOSCAN_LOG_INFO("TX rate shaping on port {} queue {}: {} Gbps, burst {} bytes, gap {} ns, {}",
+                    params.port,
+                    params.queue,
+                    cfg.gbps_,
+                    shaper.burst_bytes,
+                    cfg.ipg_ns_,
+                    shaper.hw_pacing ? "accurate send scheduling" : "TSC pacing");
+}
+
+/**
+ * @brief Get the bytes a packet takes on the wire, counting every datagram of a large send
+ */
+static double tx_wire_bytes(const struct rte_mbuf* pkt) {
+  double bytes = pkt->pkt_len + TxRateShaper::WIRE_OVERHEAD;
+  if ((pkt->ol_flags & RTE_MBUF_F_TX_UDP_SEG) != 0 && pkt->tso_segsz > 0) {
+    const uint32_t hdr_len = pkt->l2_len + pkt->l3_len + pkt->l4_len;
+    const uint32_t num_dgrams = (pkt->pkt_len - hdr_len + pkt->tso_segsz - 1) / pkt->tso_segsz;
+    bytes += (num_dgrams - 1) * static_cast<double>(hdr_len + TxRateShaper::WIRE_OVERHEAD);
+  }
+  return bytes;
+}
+
+/**
+ * @brief Get how many of the next packets can be sent now without exceeding the rate
+ *
+ * With accurate send scheduling the packets are also stamped with their departure time,
+ * unless the application already set one with set_packet_tx_time.
+ *
+ * @param shaper Shaper of the queue
+ * @param pkts Packets to send
+ * @param num_pkts Number of packets to send
+ * @return Number of packets that can be sent now, possibly 0
+ */
+static uint16_t shape_tx_packets(TxRateShaper& shaper, struct rte_mbuf** pkts,
+                                 uint16_t num_pkts) {
+  uint16_t count = 0;
+
+  if (shaper.hw_pacing) {
+    uint64_t now;
+    if (rte_eth_read_clock(shaper.port, &now) != 0) { return num_pkts; }
+
+    while (count < num_pkts && shaper.next_tick <= now + shaper.horizon_ticks) {
+      // Idle time earns up to a burst of credit, but packets are never scheduled in the past
+      shaper.next_tick = std::max(shaper.next_tick, now - std::min(now, shaper.burst_ticks));
+      auto* pkt = pkts[count];
+      if ((pkt->ol_flags & shaper.timestamp_mask) == 0) {
+        pkt->ol_flags |= shaper.timestamp_mask;
+        *RTE_MBUF_DYNFIELD(pkt, shaper.timestamp_offset, uint64_t*) =
+            std::max(shaper.next_tick, now);
+      }
+
+      const double wire_bytes = tx_wire_bytes(pkt);
+      uint64_t gap = shaper.ipg_ticks;
+      if (shaper.bytes_per_tick > 0) {
+        gap = std::max(gap, static_cast<uint64_t>(wire_bytes / shaper.bytes_per_tick));
+      }
+      shaper.next_tick = std::max(shaper.next_tick, now) + gap;
+      count++;
+    }
+    return count;
+  }
+
+  const uint64_t now = rte_get_tsc_cycles();
+  if (shaper.bytes_per_tick > 0) {
+    shaper.tokens = std::min(shaper.burst_bytes,
+                             shaper.tokens + (now - shaper.last_tsc) * shaper.bytes_per_tick);
+  }
+  shaper.last_tsc = now;
+
+  while (count < num_pkts) {
+    if (shaper.ipg_ticks > 0 && now < shaper.next_tsc) { break; }
+
+    const double wire_bytes = tx_wire_bytes(pkts[count]);
+    if (shaper.bytes_per_tick > 0) {
+      // A large send bigger than the bucket leaves with a full bucket and is paid back after
+      if (shaper.tokens < std::min(wire_bytes, shaper.burst_bytes)) { break; }
+      shaper.tokens -= wire_bytes;
+    }
+    count++;
+
+    // Packets separated by a gap are sent one at a time
+    if (shaper.ipg_ticks > 0) {
+      shaper.next_tsc = now + shaper.ipg_ticks;
+      break;
+    }
+  }
+  return count;
+}
+
 int DpdkMgr::tx_core_worker(void* arg) {
   TxWorkerParams* tparams = (TxWorkerParams*)arg;
   uint64_t seq;
@@ -1706,6 +2811,9 @@ int DpdkMgr::tx_core_worker(void* arg) {
                     (void*)tparams->burst_pool,
                     (void*)tparams->ring);
 
+  TxRateShaper shaper;
+  init_tx_shaper(shaper, *tparams);
+
   while (!force_quit.load()) {
     if (rte_ring_dequeue(tparams->ring, reinterpret_cast<void**>(&msg)) != 0) { continue; }
 
@@ -1714,7 +2822,9 @@ int DpdkMgr::tx_core_worker(void* arg) {
       for (size_t p = 0; p < msg->hdr.hdr.num_pkts; p++) {
         for (int seg = 0; seg < msg->hdr.hdr.num_segs; seg++) {
           auto* mbuf = reinterpret_cast<struct rte_mbuf*>(msg->pkts[seg][p]);
-          mbuf->next = reinterpret_cast<struct rte_mbuf*>(msg->pkts[seg + 1][p]);
+          mbuf->next = seg + 1 < msg->hdr.hdr.num_segs
+                           ? reinterpret_cast<struct rte_mbuf*>(msg->pkts[seg + 1][p])
+                           : nullptr;
         }
 
         reinterpret_cast<struct rte_mbuf*>(msg->pkts[0][p])->nb_segs = msg->hdr.hdr.num_segs;
@@ -1728,6 +2838,15 @@ int DpdkMgr::tx_core_worker(void* arg) {
       auto to_send = static_cast<uint16_t>(
           std::min(static_cast<size_t>(DEFAULT_NUM_TX_BURST), msg->hdr.hdr.num_pkts - pkts_tx));
 
+      if (shaper.enabled) {
+        to_send = shape_tx_packets(
+            shaper, reinterpret_cast<rte_mbuf**>(&msg->pkts[0][pkts_tx]), to_send);
+        if (to_send == 0) {
+          rte_pause();
+          continue;
+        }
+      }
+
       // CPU-only or HDS mode
       int tx;
       tx = rte_eth_tx_burst(tparams->port,
@@ -1773,12 +2892,35 @@ uint16_t DpdkMgr::get_packet_length(BurstParams* burst, int idx) {
   return reinterpret_cast<rte_mbuf*>(burst->pkts[0][idx])->pkt_len;
 }
 
+Status DpdkMgr::get_packet_ptrs(BurstParams* burst, int seg, void** out) {
+  if (seg < 0 || seg >= burst->hdr.hdr.num_segs) { return Status::INVALID_PARAMETER; }
+  const auto mbufs = reinterpret_cast<rte_mbuf* const*>(burst->pkts[seg]);
+  for (size_t p = 0; p < burst->hdr.hdr.num_pkts; p++) {
+    out[p] = rte_pktmbuf_mtod(mbufs[p], void*);
+  }
+  return Status::SUCCESS;
+}
+
+Status DpdkMgr::get_packet_lengths(BurstParams* burst, int seg, uint16_t* out) {
+  if (seg < 0 || seg >= burst->hdr.hdr.num_segs) { return Status::INVALID_PARAMETER; }
+  const auto mbufs = reinterpret_cast<rte_mbuf* const*>(burst->pkts[seg]);
+  for (size_t p = 0; p < burst->hdr.hdr.num_pkts; p++) { out[p] = mbufs[p]->data_len; }
+  return Status::SUCCESS;
+}
+
 uint16_t DpdkMgr::get_packet_flow_id(BurstParams* burst, int idx) {
   const ExtraRxPacketInfo* info = reinterpret_cast<ExtraRxPacketInfo*>(burst->pkt_extra_info);
   return info[idx].flow_id;
 }
 
 Status DpdkMgr::set_packet_tx_time(BurstParams* burst, int idx, uint64_t timestamp) {
+  // Times are in PTP time when the port has a PTP clock, and in NIC clock units otherwise
+  const auto ptp_clock = get_ptp_clock(burst->hdr.hdr.port_id);
+  if (ptp_clock != nullptr) {
+    timestamp = ptp_clock->ptp_to_ticks(timestamp);
+    if (timestamp == 0) { return Status::NOT_READY; }
+  }
+
   reinterpret_cast<struct rte_mbuf**>(burst->pkts[0])[idx]->ol_flags |= timestamp_mask_;
   *RTE_MBUF_DYNFIELD(
       reinterpret_cast<rte_mbuf**>(burst->pkts[0])[idx], timestamp_offset_, uint64_t*) = timestamp;
@@ -1862,6 +3004,370 @@ Status DpdkMgr::set_udp_payload(BurstParams* burst, int idx, void* data, int len
   return Status::SUCCESS;
 }
 
+/**
+ * @brief Get the Ethernet and IPv4 header lengths of an Ethernet/IPv4/UDP header template
+ *
+ * @return true if the template is a valid IPv4 UDP header of exactly hdr_len bytes
+ */
+static bool parse_udp_header_template(const void* hdr, int hdr_len, uint16_t* l2_len,
+                                      uint16_t* l3_len) {
+  const auto* bytes = static_cast<const uint8_t*>(hdr);
+  if (hdr == nullptr || hdr_len < static_cast<int>(sizeof(UDPPkt))) { return false; }
+
+  const auto* eth = reinterpret_cast<const struct rte_ether_hdr*>(bytes);
+  *l2_len = sizeof(struct rte_ether_hdr);
+  uint16_t ether_type = eth->ether_type;
+  if (ether_type == rte_cpu_to_be_16(RTE_ETHER_TYPE_VLAN)) {
+    ether_type = reinterpret_cast<const struct rte_vlan_hdr*>(bytes + *l2_len)->eth_proto;
+    *l2_len += sizeof(struct rte_vlan_hdr);
+  }
+  if (ether_type != rte_cpu_to_be_16(RTE_ETHER_TYPE_IPV4)) { return false; }
+
+  const auto* ip = reinterpret_cast<const struct rte_ipv4_hdr*>(bytes + *l2_len);
+  *l3_len = rte_ipv4_hdr_len(ip);
+  return ip->next_proto_id == IPPROTO_UDP &&
+         hdr_len == *l2_len + *l3_len + static_cast<int>(sizeof(struct rte_udp_hdr));
+}
+
+Status DpdkMgr::get_tx_large_send_burst(BurstParams* burst, const void* hdr, int hdr_len,
+                                        const void* data, int len, int seg_size) {
+  const uint16_t port = burst->hdr.hdr.port_id;
+  const uint32_t key = generate_queue_key(port, burst->hdr.hdr.q_id);
+  const auto q_it = tx_dpdk_q_map_.find(key);
+  const auto burst_pool = tx_burst_buffers.find(key);
+  if (q_it == tx_dpdk_q_map_.end() || burst_pool == tx_burst_buffers.end()) {
+    HOLOSCAN_LOG_ERROR("Invalid port/queue combination in get_tx_large_send_burst: {}/{}",
+                       port,
+                       burst->hdr.hdr.q_id);
+    return Status::INVALID_PARAMETER;
+  }
+
+  if (!q_it->second->cpu_writable) {
+    HOLOSCAN_LOG_ERROR("Large sends need the first segment of queue {}/{} in CPU memory",
+                       port,
+                       burst->hdr.hdr.q_id);
+    return Status::NOT_SUPPORTED;
+  }
+
+  uint16_t l2_len;
+  uint16_t l3_len;
+  if (!parse_udp_header_template(hdr, hdr_len, &l2_len, &l3_len)) {
+    HOLOSCAN_LOG_ERROR("Large send header template must be an Ethernet/IPv4/UDP header");
+    return Status::INVALID_PARAMETER;
+  }
+
+  struct rte_mempool* pool = q_it->second->pools[0];
+  const uint16_t data_room = rte_pktmbuf_data_room_size(pool);
+  const int room = data_room - std::min<uint16_t>(data_room, RTE_PKTMBUF_HEADROOM);
+  const int l4_len = sizeof(struct rte_udp_hdr);
+  if (data == nullptr || len <= 0 || seg_size <= 0 || hdr_len + seg_size > room ||
+      l3_len + l4_len + len > UINT16_MAX) {
+    HOLOSCAN_LOG_ERROR("Invalid large send of {} bytes in {} byte datagrams for {} byte buffers",
+                       len,
+                       seg_size,
+                       room);
+    return Status::INVALID_PARAMETER;
+  }
+
+  const size_t max_pkts = burst_pool->second->elt_size / sizeof(void*);
+  const auto* payload = static_cast<const uint8_t*>(data);
+  burst->hdr.hdr.num_segs = 1;
+
+  if (rte_mempool_get(burst_pool->second, reinterpret_cast<void**>(&burst->pkts[0])) != 0) {
+    return Status::NO_FREE_BURST_BUFFERS;
+  }
+  auto pkts = reinterpret_cast<struct rte_mbuf**>(burst->pkts[0]);
+
+  // With segmentation offload the whole send is one chain of buffers, filled to capacity
+  const auto seg_it = tx_udp_seg_max_mbufs_.find(port);
+  if (seg_it != tx_udp_seg_max_mbufs_.end() && len > seg_size) {
+    const int first_len = std::min(len, room - hdr_len);
+    const int num_mbufs = 1 + (len - first_len + room - 1) / room;
+    if (num_mbufs <= seg_it->second && static_cast<size_t>(num_mbufs) <= max_pkts) {
+      if (rte_pktmbuf_alloc_bulk(pool, pkts, num_mbufs) != 0) {
+        rte_mempool_put(burst_pool->second, burst->pkts[0]);
+        return Status::NO_FREE_PACKET_BUFFERS;
+      }
+
+      auto* head = pkts[0];
+      auto* buf = rte_pktmbuf_mtod(head, uint8_t*);
+      rte_memcpy(buf, hdr, hdr_len);
+      rte_memcpy(buf + hdr_len, payload, first_len);
+      head->data_len = hdr_len + first_len;
+
+      int offset = first_len;
+      for (int m = 1; m < num_mbufs; m++) {
+        const int seg_len = std::min(room, len - offset);
+        rte_memcpy(rte_pktmbuf_mtod(pkts[m], void*), payload + offset, seg_len);
+        pkts[m]->data_len = seg_len;
+        pkts[m - 1]->next = pkts[m];
+        offset += seg_len;
+      }
+
+      head->nb_segs = num_mbufs;
+      head->pkt_len = hdr_len + len;
+      head->l2_len = l2_len;
+      head->l3_len = l3_len;
+      head->l4_len = l4_len;
+      head->tso_segsz = seg_size;
+      head->ol_flags |= RTE_MBUF_F_TX_IPV4 | RTE_MBUF_F_TX_IP_CKSUM | RTE_MBUF_F_TX_UDP_SEG;
+
+      // The NIC fixes up the lengths and checksums of each datagram from the pseudo header
+      auto* ip = reinterpret_cast<struct rte_ipv4_hdr*>(buf + l2_len);
+      auto* udp = reinterpret_cast<struct rte_udp_hdr*>(buf + l2_len + l3_len);
+      ip->total_length = rte_cpu_to_be_16(l3_len + l4_len + len);
+      ip->hdr_checksum = 0;
+      udp->dgram_len = rte_cpu_to_be_16(l4_len + len);
+      udp->dgram_cksum = rte_ipv4_phdr_cksum(ip, head->ol_flags);
+
+      burst->hdr.hdr.num_pkts = 1;
+      return Status::SUCCESS;
+    }
+  }
+
+  // Software segmentation: one packet per datagram, each a copy of the template
+  const int num_pkts = (len + seg_size - 1) / seg_size;
+  if (static_cast<size_t>(num_pkts) > max_pkts) {
+    HOLOSCAN_LOG_ERROR("Large send of {} datagrams exceeds the queue batch size of {}",
+                       num_pkts,
+                       max_pkts);
+    rte_mempool_put(burst_pool->second, burst->pkts[0]);
+    return Status::INVALID_PARAMETER;
+  }
+
+  if (rte_pktmbuf_alloc_bulk(pool, pkts, num_pkts) != 0) {
+    rte_mempool_put(burst_pool->second, burst->pkts[0]);
+    return Status::NO_FREE_PACKET_BUFFERS;
+  }
+
+  const auto* tmpl_ip = reinterpret_cast<const struct rte_ipv4_hdr*>(
+      static_cast<const uint8_t*>(hdr) + l2_len);
+  const uint16_t first_id = rte_be_to_cpu_16(tmpl_ip->packet_id);
+
+  for (int p = 0; p < num_pkts; p++) {
+    const int offset = p * seg_size;
+    const int dgram_len = std::min(seg_size, len - offset);
+    auto* buf = rte_pktmbuf_mtod(pkts[p], uint8_t*);
+    rte_memcpy(buf, hdr, hdr_len);
+    rte_memcpy(buf + hdr_len, payload + offset, dgram_len);
+
+    auto* ip = reinterpret_cast<struct rte_ipv4_hdr*>(buf + l2_len);
+    auto* udp = reinterpret_cast<struct rte_udp_hdr*>(buf + l2_len + l3_len);
+    ip->total_length = rte_cpu_to_be_16(l3_len + l4_len + dgram_len);
+    ip->packet_id = rte_cpu_to_be_16(static_cast<uint16_t>(first_id + p));
+    ip->hdr_checksum = 0;
+    udp->dgram_len = rte_cpu_to_be_16(l4_len + dgram_len);
+    udp->dgram_cksum = 0;
+
+    pkts[p]->data_len = hdr_len + dgram_len;
+    pkts[p]->pkt_len = hdr_len + dgram_len;
+    pkts[p]->l2_len = l2_len;
+    pkts[p]->l3_len = l3_len;
+    pkts[p]->ol_flags |= RTE_MBUF_F_TX_IPV4 | RTE_MBUF_F_TX_IP_CKSUM;
+  }
+
+  burst->hdr.hdr.num_pkts = num_pkts;
+  return Status::SUCCESS;
+}
+
+Status DpdkMgr::register_tx_buffer(int port, void* addr, size_t len) {
+  const auto base = reinterpret_cast<uintptr_t>(addr);
+  struct rte_eth_dev_info dev_info;
+  if (addr == nullptr || len == 0 || (base & GPU_PAGE_OFFSET) != 0 ||
+      (len & GPU_PAGE_OFFSET) != 0 || !rte_eth_dev_is_valid_port(port) ||
+      rte_eth_dev_info_get(port, &dev_info) != 0) {
+    HOLOSCAN_LOG_ERROR("Invalid TX buffer {} of {} bytes for port {}", addr, len, port);
+    return Status::INVALID_PARAMETER;
+  }
+
+  std::lock_guard<std::mutex> lock(tx_ext_mutex_);
+  if (tx_ext_pools_.find(port) == tx_ext_pools_.end()) {
+    // Payload mbufs hold no data, only the shared info of their buffer in the private area
+    const std::string pool_name = "TXEXT_P" + std::to_string(port);
+    const uint16_t priv_size =
+        RTE_ALIGN(sizeof(struct rte_mbuf_ext_shared_info), RTE_MBUF_PRIV_ALIGN);
+    auto pool = rte_pktmbuf_pool_create(pool_name.c_str(),
+                                        TX_EXT_NUM_MBUFS,
+                                        MEMPOOL_CACHE_SIZE,
+                                        priv_size,
+                                        0,
+                                        rte_eth_dev_socket_id(port));
+    if (pool == nullptr) {
+      HOLOSCAN_LOG_ERROR("Could not create mempool {}: {}", pool_name, rte_strerror(rte_errno));
+      return Status::INTERNAL_ERROR;
+    }
+    tx_ext_pools_[port] = pool;
+  }
+
+  // The buffer may already be known to DPDK when it's shared with another port
+  const int ret = rte_extmem_register(addr, len, nullptr, 0, GPU_PAGE_SIZE);
+  if (ret != 0 && rte_errno != EEXIST) {
+    HOLOSCAN_LOG_ERROR("Unable to register TX buffer {}: {}", addr, rte_strerror(rte_errno));
+    return Status::INTERNAL_ERROR;
+  }
+
+  const rte_iova_t iova = rte_mem_virt2iova(addr);
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wdeprecated-declarations"
+  const int map_ret = rte_dev_dma_map(dev_info.device, addr, iova, len);
+#pragma GCC diagnostic pop
+  if (map_ret != 0) {
+    HOLOSCAN_LOG_ERROR("Could not DMA map TX buffer {}: {}", addr, rte_strerror(rte_errno));
+    if (ret == 0) { rte_extmem_unregister(addr, len); }
+    return Status::INTERNAL_ERROR;
+  }
+
+  tx_ext_regions_[port].push_back({base, len, iova, ret == 0});
+  HOLOSCAN_LOG_INFO("Registered TX buffer {} of {} bytes on port {}", addr, len, port);
+  return Status::SUCCESS;
+}
+
+Status DpdkMgr::unregister_tx_buffer(int port, void* addr) {
+  std::lock_guard<std::mutex> lock(tx_ext_mutex_);
+  auto regions_it = tx_ext_regions_.find(port);
+  if (regions_it == tx_ext_regions_.end()) { return Status::INVALID_PARAMETER; }
+
+  auto& regions = regions_it->second;
+  const auto region = std::find_if(regions.begin(), regions.end(), [addr](const auto& r) {
+    return r.addr == reinterpret_cast<uintptr_t>(addr);
+  });
+  if (region == regions.end()) { return Status::INVALID_PARAMETER; }
+
+  struct rte_eth_dev_info dev_info;
+  if (rte_eth_dev_info_get(port, &dev_info) == 0) {
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wdeprecated-declarations"
+    rte_dev_dma_unmap(dev_info.device, addr, region->iova, region->len);
+#pragma GCC diagnostic pop
+  }
+  if (region->registered) { rte_extmem_unregister(addr, region->len); }
+
+  regions.erase(region);
+  return Status::SUCCESS;
+}
+
+static void ignore_tx_buffer_free(void* addr, void* arg) {}
+
+Status DpdkMgr::get_tx_ext_buffer_burst(BurstParams* burst, const void* hdr, int hdr_len,
+                                        void* const* bufs, const uint16_t* lens,
+                                        TxBufferFreeCallback free_cb, void* cb_arg) {
+  const uint16_t port = burst->hdr.hdr.port_id;
+  const uint32_t key = generate_queue_key(port, burst->hdr.hdr.q_id);
+  const auto q_it = tx_dpdk_q_map_.find(key);
+  const auto burst_pool = tx_burst_buffers.find(key);
+  if (q_it == tx_dpdk_q_map_.end() || burst_pool == tx_burst_buffers.end()) {
+    HOLOSCAN_LOG_ERROR("Invalid port/queue combination in get_tx_ext_buffer_burst: {}/{}",
+                       port,
+                       burst->hdr.hdr.q_id);
+    return Status::INVALID_PARAMETER;
+  }
+
+  if (!q_it->second->cpu_writable) {
+    HOLOSCAN_LOG_ERROR("TX buffer bursts need the first segment of queue {}/{} in CPU memory",
+                       port,
+                       burst->hdr.hdr.q_id);
+    return Status::NOT_SUPPORTED;
+  }
+
+  uint16_t l2_len;
+  uint16_t l3_len;
+  if (!parse_udp_header_template(hdr, hdr_len, &l2_len, &l3_len)) {
+    HOLOSCAN_LOG_ERROR("TX buffer burst header template must be an Ethernet/IPv4/UDP header");
+    return Status::INVALID_PARAMETER;
+  }
+
+  struct rte_mempool* hdr_pool = q_it->second->pools[0];
+  const uint16_t data_room = rte_pktmbuf_data_room_size(hdr_pool);
+  const size_t num_pkts = burst->hdr.hdr.num_pkts;
+  if (hdr_len > data_room - std::min<uint16_t>(data_room, RTE_PKTMBUF_HEADROOM) ||
+      num_pkts == 0 || num_pkts > burst_pool->second->elt_size / sizeof(void*)) {
+    HOLOSCAN_LOG_ERROR("Invalid TX buffer burst of {} packets", num_pkts);
+    return Status::INVALID_PARAMETER;
+  }
+
+  std::lock_guard<std::mutex> lock(tx_ext_mutex_);
+  const auto ext_pool = tx_ext_pools_.find(port);
+  const auto regions = tx_ext_regions_.find(port);
+  if (ext_pool == tx_ext_pools_.end() || regions == tx_ext_regions_.end()) {
+    HOLOSCAN_LOG_ERROR("No TX buffers registered on port {}", port);
+    return Status::INVALID_PARAMETER;
+  }
+
+  // Payloads are usually in the same region as the previous one
+  const TxExtBufferRegion* region = nullptr;
+  auto find_region = [&](const void* buf, uint16_t len) {
+    const auto addr = reinterpret_cast<uintptr_t>(buf);
+    auto in_region = [&](const TxExtBufferRegion& r) {
+      return addr >= r.addr && addr + len <= r.addr + r.len;
+    };
+    if (region != nullptr && in_region(*region)) { return true; }
+    for (const auto& r : regions->second) {
+      if (in_region(r)) {
+        region = &r;
+        return true;
+      }
+    }
+    return false;
+  };
+
+  for (size_t p = 0; p < num_pkts; p++) {
+    if (!find_region(bufs[p], lens[p])) {
+      HOLOSCAN_LOG_ERROR("TX buffer {} of packet {} isn't registered on port {}", bufs[p], p, port);
+      return Status::INVALID_PARAMETER;
+    }
+  }
+
+  burst->hdr.hdr.num_segs = 2;
+  if (rte_mempool_get_bulk(burst_pool->second, reinterpret_cast<void**>(&burst->pkts[0]), 2) !=
+      0) {
+    return Status::NO_FREE_BURST_BUFFERS;
+  }
+
+  auto hdrs = reinterpret_cast<struct rte_mbuf**>(burst->pkts[0]);
+  auto payloads = reinterpret_cast<struct rte_mbuf**>(burst->pkts[1]);
+  if (rte_pktmbuf_alloc_bulk(hdr_pool, hdrs, num_pkts) != 0) {
+    rte_mempool_put_bulk(burst_pool->second, reinterpret_cast<void* const*>(&burst->pkts[0]), 2);
+    return Status::NO_FREE_PACKET_BUFFERS;
+  }
+  if (rte_pktmbuf_alloc_bulk(ext_pool->second, payloads, num_pkts) != 0) {
+    rte_pktmbuf_free_bulk(hdrs, num_pkts);
+    rte_mempool_put_bulk(burst_pool->second, reinterpret_cast<void* const*>(&burst->pkts[0]), 2);
+    return Status::NO_FREE_PACKET_BUFFERS;
+  }
+
+  const int l4_len = sizeof(struct rte_udp_hdr);
+  for (size_t p = 0; p < num_pkts; p++) {
+    auto* buf = rte_pktmbuf_mtod(hdrs[p], uint8_t*);
+    rte_memcpy(buf, hdr, hdr_len);
+    auto* ip = reinterpret_cast<struct rte_ipv4_hdr*>(buf + l2_len);
+    auto* udp = reinterpret_cast<struct rte_udp_hdr*>(buf + l2_len + l3_len);
+    ip->total_length = rte_cpu_to_be_16(l3_len + l4_len + lens[p]);
+    ip->hdr_checksum = 0;
+    udp->dgram_len = rte_cpu_to_be_16(l4_len + lens[p]);
+    udp->dgram_cksum = 0;
+
+    hdrs[p]->data_len = hdr_len;
+    hdrs[p]->pkt_len = hdr_len + lens[p];
+    hdrs[p]->l2_len = l2_len;
+    hdrs[p]->l3_len = l3_len;
+    hdrs[p]->ol_flags |= RTE_MBUF_F_TX_IPV4 | RTE_MBUF_F_TX_IP_CKSUM;
+
+    // The NIC reads the payload in place. DPDK calls free_cb once the last reference is freed
+    find_region(bufs[p], lens[p]);
+    const uintptr_t offset = reinterpret_cast<uintptr_t>(bufs[p]) - region->addr;
+    const rte_iova_t iova = region->iova == RTE_BAD_IOVA ? RTE_BAD_IOVA : region->iova + offset;
+    auto* shinfo = static_cast<struct rte_mbuf_ext_shared_info*>(rte_mbuf_to_priv(payloads[p]));
+    shinfo->free_cb = free_cb != nullptr ? free_cb : ignore_tx_buffer_free;
+    shinfo->fcb_opaque = cb_arg;
+    rte_mbuf_ext_refcnt_set(shinfo, 1);
+    rte_pktmbuf_attach_extbuf(payloads[p], bufs[p], iova, lens[p], shinfo);
+    payloads[p]->data_len = lens[p];
+    payloads[p]->pkt_len = lens[p];
+  }
+
+  return Status::SUCCESS;
+}
+
 bool DpdkMgr::is_tx_burst_available(BurstParams* burst) {
   const uint32_t key = generate_queue_key(burst->hdr.hdr.port_id, burst->hdr.hdr.q_id);
   const auto& q = tx_dpdk_q_map_[key];
@@ -1906,7 +3412,10 @@ void DpdkMgr::free_all_packets(BurstParams* burst) {
   }
 }
 
-void DpdkMgr::free_rx_burst(BurstParams* burst) {
+// Returns the packet arrays and the flow IDs of an RX burst, but not the burst itself
+void DpdkMgr::release_rx_burst_packets(BurstParams* burst) {
+  if (!rx_latency_stats_.empty()) { record_rx_free(burst); }
+
   if (burst->pkt_extra_info != nullptr) {
     rte_mempool_put(rx_flow_id_buffer, (void*)burst->pkt_extra_info);
   }
@@ -1917,9 +3426,18 @@ void DpdkMgr::free_rx_burst(BurstParams* burst) {
 
   burst->hdr.hdr.num_pkts = 0;
   burst->pkt_extra_info = nullptr;
+}
+
+void DpdkMgr::free_rx_burst(BurstParams* burst) {
+  release_rx_burst_packets(burst);
   rte_mempool_put(rx_metadata, burst);
 }
 
+void DpdkMgr::free_rx_bursts(BurstParams** bursts, int num_bursts) {
+  for (int b = 0; b < num_bursts; b++) { release_rx_burst_packets(bursts[b]); }
+  rte_mempool_put_bulk(rx_metadata, reinterpret_cast<void* const*>(bursts), num_bursts);
+}
+
 void DpdkMgr::free_tx_burst(BurstParams* burst) {
   const uint32_t key = generate_queue_key(burst->hdr.hdr.port_id, burst->hdr.hdr.q_id);
   const auto burst_pool = tx_burst_buffers.find(key);
@@ -1945,9 +3463,37 @@ Status DpdkMgr::get_rx_burst(BurstParams** burst, int port, int q) {
     return Status::NOT_READY;
   }
 
+  if (!rx_latency_stats_.empty()) { record_rx_dequeue(*burst); }
+
   return Status::SUCCESS;
 }
 
+int DpdkMgr::get_rx_bursts(BurstParams** bursts, int max_bursts, int port, int q) {
+  uint32_t key = generate_queue_key(port, q);
+  const auto ring_it = rx_rings.find(key);
+
+  if (ring_it == rx_rings.end()) {
+    HOLOSCAN_LOG_ERROR("Invalid port/queue combination in get_rx_bursts: {}/{}", port, q);
+    return 0;
+  }
+
+  const int num_bursts = rte_ring_dequeue_burst(
+      ring_it->second, reinterpret_cast<void**>(bursts), max_bursts, nullptr);
+
+  if (!rx_latency_stats_.empty()) {
+    for (int b = 0; b < num_bursts; b++) { record_rx_dequeue(bursts[b]); }
+  }
+
+  return num_bursts;
+}
+
+int DpdkMgr::get_rx_burst_count(int port, int q) {
+  const auto ring_it = rx_rings.find(generate_queue_key(port, q));
+  if (ring_it == rx_rings.end()) { return -1; }
+
+  return static_cast<int>(rte_ring_count(ring_it->second));
+}
+
 void DpdkMgr::free_rx_metadata(BurstParams* burst) {
   rte_mempool_put(rx_metadata, burst);
 }
@@ -1995,8 +3541,12 @@ void DpdkMgr::shutdown() {
     HOLOSCAN_LOG_INFO("advanced_network DPDK manager shutting down");
     force_quit.store(true);
 
-    stats_.Shutdown();
-    stats_thread_.join();
+    for (auto& tap : rx_taps_) { tap.second->stop(); }
+
+    if (stats_thread_.joinable()) {
+      stats_.Shutdown();
+      stats_thread_.join();
+    }
   }
 }
 
@@ -2006,6 +3556,48 @@ void DpdkMgr::print_stats() {
   RTE_ETH_FOREACH_DEV(portid) {
     PrintDpdkStats(portid);
   }
+
+  auto error_stat = [](ErrorGlobalStats stat) {
+    return rx_error_stats[static_cast<int>(stat)].load();
+  };
+  HOLOSCAN_LOG_INFO("RX overload stats:");
+  HOLOSCAN_LOG_INFO(" - Out of RX buffers:   {}", error_stat(ErrorGlobalStats::OUT_OF_RX_BUFFERS));
+  HOLOSCAN_LOG_INFO(" - RX queue full:       {}", error_stat(ErrorGlobalStats::RX_QUEUE_FULL));
+  HOLOSCAN_LOG_INFO(" - Metadata depleted:   {}",
+                    error_stat(ErrorGlobalStats::METADATA_BUF_DEPLETED));
+  HOLOSCAN_LOG_INFO(" - RX packets dropped:  {}", error_stat(ErrorGlobalStats::RX_PACKETS_DROPPED));
+
+  auto print_latency = [](const char* name, const LatencySummary& lat) {
+    if (lat.count == 0) { return; }
+    HOLOSCAN_LOG_INFO(" - {}: count={} min={}ns mean={}ns p50={}ns p99={}ns p99.9={}ns max={}ns",
+                      name, lat.count, lat.min_ns, lat.mean_ns, lat.p50_ns, lat.p99_ns,
+                      lat.p999_ns, lat.max_ns);
+  };
+  for (const auto& clock : ptp_clocks_) {
+    HOLOSCAN_LOG_INFO("Port {} PTP clock {}: {} ns from CLOCK_REALTIME",
+                      clock.first,
+                      clock.second->device(),
+                      clock.second->realtime_offset_ns());
+  }
+  for (const auto& tap : rx_taps_) {
+    HOLOSCAN_LOG_INFO("RX capture tap port/queue {}/{}: {} captured, {} dropped",
+                      tap.second->get_port(), tap.second->get_queue(),
+                      tap.second->get_captured_pkts(), tap.second->get_dropped_pkts());
+  }
+
+  for (const auto& [core, poll_stats] : rx_adaptive_poll_stats_) {
+    HOLOSCAN_LOG_INFO("RX adaptive polling core {}: {} sleeps ({} timed out), {:.3f}s asleep",
+                      core, poll_stats->sleeps.load(), poll_stats->sleep_timeouts.load(),
+                      poll_stats->sleep_ns.load() / 1e9);
+    print_latency("Wakeup", poll_stats->wakeup.summary());
+  }
+
+  for (const auto& q_stats : get_queue_latency_stats()) {
+    HOLOSCAN_LOG_INFO("RX latency stats port/queue {}/{}:", q_stats.port_id, q_stats.q_id);
+    print_latency("Wire to dequeue", q_stats.wire_to_dequeue);
+    print_latency("Ring to dequeue", q_stats.ring_to_dequeue);
+    print_latency("Dequeue to free", q_stats.dequeue_to_free);
+  }
 }
 
 uint64_t DpdkMgr::get_burst_tot_byte(BurstParams* burst) {
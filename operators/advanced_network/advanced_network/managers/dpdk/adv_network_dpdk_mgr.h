@@ -46,10 +46,12 @@
 #include <rte_flow.h>
 #include <rte_gpudev.h>
 #include <atomic>
+#include <mutex>
 #include <unordered_map>
 #include "advanced_network/manager.h"
 #include "advanced_network/common.h"
 #include "adv_network_dpdk_stats.h"
+#include "adv_network_dpdk_capture.h"
 
 namespace holoscan::advanced_network {
 
@@ -57,6 +59,7 @@ struct DPDKQueueConfig {
   std::vector<struct rte_mempool*> pools;
   struct rte_eth_rxconf rxconf_qsplit;
   std::vector<union rte_eth_rxseg> rx_useg;
+  bool cpu_writable = true;  // Whether the CPU can write the buffers of the first segment
 };
 
 class DpdkLogLevel {
@@ -153,6 +156,7 @@ class DpdkMgr : public Manager {
   uint16_t default_num_tx_desc = 8192;
   int num_ports = 0;
   static constexpr int MEMPOOL_CACHE_SIZE = 32;
+  static constexpr int TX_EXT_NUM_MBUFS = 32767;  // Payload mbufs for application TX buffers
 
   static constexpr uint32_t GPU_PAGE_OFFSET = (GPU_PAGE_SIZE - 1);
   static constexpr uint32_t GPU_PAGE_MASK = (~GPU_PAGE_OFFSET);
@@ -164,6 +168,8 @@ class DpdkMgr : public Manager {
   void* get_packet_ptr(BurstParams* burst, int idx) override;
   uint16_t get_segment_packet_length(BurstParams* burst, int seg, int idx) override;
   uint16_t get_packet_length(BurstParams* burst, int idx) override;
+  Status get_packet_ptrs(BurstParams* burst, int seg, void** out) override;
+  Status get_packet_lengths(BurstParams* burst, int seg, uint16_t* out) override;
   uint16_t get_packet_flow_id(BurstParams* burst, int idx) override;
   void* get_packet_extra_info(BurstParams* burst, int idx) override;
   Status get_tx_packet_burst(BurstParams* burst) override;
@@ -173,6 +179,13 @@ class DpdkMgr : public Manager {
   Status set_udp_header(BurstParams* burst, int idx, int udp_len, uint16_t src_port,
                            uint16_t dst_port) override;
   Status set_udp_payload(BurstParams* burst, int idx, void* data, int len) override;
+  Status get_tx_large_send_burst(BurstParams* burst, const void* hdr, int hdr_len,
+                                 const void* data, int len, int seg_size) override;
+  Status register_tx_buffer(int port, void* addr, size_t len) override;
+  Status unregister_tx_buffer(int port, void* addr) override;
+  Status get_tx_ext_buffer_burst(BurstParams* burst, const void* hdr, int hdr_len,
+                                 void* const* bufs, const uint16_t* lens,
+                                 TxBufferFreeCallback free_cb, void* cb_arg) override;
   bool is_tx_burst_available(BurstParams* burst) override;
 
   Status set_packet_lengths(BurstParams* burst, int idx,
@@ -182,10 +195,13 @@ class DpdkMgr : public Manager {
   void free_packet(BurstParams* burst, int pkt) override;
   void free_all_packets(BurstParams* burst) override;
   void free_rx_burst(BurstParams* burst) override;
+  void free_rx_bursts(BurstParams** bursts, int num_bursts) override;
   void free_tx_burst(BurstParams* burst) override;
 
   Status get_rx_burst(BurstParams** burst, int port, int q) override;
   using holoscan::advanced_network::Manager::get_rx_burst;  // for overloads
+  int get_rx_bursts(BurstParams** bursts, int max_bursts, int port, int q) override;
+  int get_rx_burst_count(int port, int q) override;
   Status set_packet_tx_time(BurstParams* burst, int idx, uint64_t timestamp);
   void free_rx_metadata(BurstParams* burst) override;
   void free_tx_metadata(BurstParams* burst) override;
@@ -195,9 +211,14 @@ class DpdkMgr : public Manager {
   void shutdown() override;
   void print_stats() override;
   void adjust_memory_regions() override;
+  bool read_nic_clock(int port, uint64_t& ticks) override;
   uint64_t get_burst_tot_byte(BurstParams* burst) override;
   BurstParams* create_tx_burst_params() override;
   bool validate_config() const override;
+  std::vector<QueueLatencyStats> get_queue_latency_stats() const override;
+  Status get_stats(ManagerStats& stats) override;
+  Status add_flow(int port, const FlowConfig& cfg) override;
+  Status remove_flow(int port, uint16_t flow_id) override;
 
  private:
   static void PrintDpdkStats(int port);
@@ -207,8 +228,17 @@ class DpdkMgr : public Manager {
   static int tx_core_worker(void* arg);
   static void flush_packets(int port);
   void setup_accurate_send_scheduling_mask();
+  bool setup_rx_timestamp();
+  void measure_nic_clock(int port);
+  DpdkCaptureTap* start_rx_tap(int port, const RxQueueConfig& q);
+  double get_rx_nic_clock_hz(int port) const;
+  void record_rx_dequeue(BurstParams* burst);
+  void record_rx_free(BurstParams* burst);
+  void release_rx_burst_packets(BurstParams* burst);
   int setup_pools_and_rings(int max_rx_batch, int max_tx_batch);
-  struct rte_flow* add_flow(int port, const FlowConfig& cfg);
+  int attach_pools_and_rings();
+  bool is_secondary() const { return cfg_.multi_process_.type_ == ProcessType::SECONDARY; }
+  struct rte_flow* create_flow(int port, const FlowConfig& cfg);
   Status register_mrs();
   Status map_mrs();
   void create_dummy_rx_q();
@@ -227,6 +257,23 @@ class DpdkMgr : public Manager {
   std::unordered_map<uint32_t, DPDKQueueConfig*> rx_dpdk_q_map_;
   std::unordered_map<uint32_t, DPDKQueueConfig*> tx_dpdk_q_map_;
   std::unordered_map<uint32_t, const RxQueueConfig*> rx_cfg_q_map_;
+  std::unordered_map<uint32_t, std::unique_ptr<RxQueueLatencyHistograms>> rx_latency_stats_;
+  std::unordered_map<uint32_t, std::unique_ptr<DpdkCaptureTap>> rx_taps_;
+  std::unordered_map<int, std::unique_ptr<RxAdaptivePollStats>> rx_adaptive_poll_stats_;
+  std::unordered_map<int, double> nic_clock_hz_;
+  std::unordered_map<int, uint16_t> tx_udp_seg_max_mbufs_;  // Ports with UDP segmentation offload
+  struct TxExtBufferRegion {
+    uintptr_t addr;
+    size_t len;
+    rte_iova_t iova;
+    bool registered;  // Registered with DPDK by this region rather than another port
+  };
+  std::unordered_map<int, std::vector<TxExtBufferRegion>> tx_ext_regions_;
+  std::unordered_map<int, struct rte_mempool*> tx_ext_pools_;
+  std::mutex tx_ext_mutex_;
+  std::unordered_map<int, struct rte_flow*> flow_jumps_;
+  std::unordered_map<uint32_t, struct rte_flow*> flows_;
+  std::mutex flow_mutex_;
   struct rte_mempool* pkt_len_buffer;
   struct rte_mempool* rx_burst_buffer;
   struct rte_mempool* rx_flow_id_buffer;
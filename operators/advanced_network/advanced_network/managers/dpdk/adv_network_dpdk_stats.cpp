@@ -17,11 +17,46 @@
 
 #include "adv_network_dpdk_stats.h"
 #include "holoscan/holoscan.hpp"
+#include <algorithm>
+#include <cmath>
 #include <thread>
 #include <chrono>
 
 namespace holoscan::advanced_network {
 
+LatencySummary LatencyHistogram::summary() const {
+  LatencySummary out;
+  out.count = count_.load(std::memory_order_relaxed);
+  if (out.count == 0) { return out; }
+
+  out.min_ns = min_.load(std::memory_order_relaxed);
+  out.max_ns = max_.load(std::memory_order_relaxed);
+  out.mean_ns = sum_.load(std::memory_order_relaxed) / out.count;
+
+  // Buckets may move slightly while walking, so percentiles use the bucket total
+  std::array<uint64_t, NUM_BUCKETS> counts;
+  uint64_t total = 0;
+  for (int i = 0; i < NUM_BUCKETS; i++) {
+    counts[i] = buckets_[i].load(std::memory_order_relaxed);
+    total += counts[i];
+  }
+
+  const std::array<std::pair<double, uint64_t*>, 3> percentiles = {
+      {{0.50, &out.p50_ns}, {0.99, &out.p99_ns}, {0.999, &out.p999_ns}}};
+  uint64_t seen = 0;
+  size_t pct_idx = 0;
+  for (int i = 0; i < NUM_BUCKETS && pct_idx < percentiles.size(); i++) {
+    seen += counts[i];
+    while (pct_idx < percentiles.size() &&
+           seen >= std::max<uint64_t>(1, std::ceil(percentiles[pct_idx].first * total))) {
+      *percentiles[pct_idx].second = std::min(bucket_value(i), out.max_ns);
+      pct_idx++;
+    }
+  }
+
+  return out;
+}
+
 void DpdkStats::Init(const NetworkConfig &cfg) {
   cfg_ = cfg;
   init_ = true;
@@ -21,9 +21,88 @@
 #include <string>
 #include <vector>
 #include <array>
+#include <atomic>
+#include <cstdint>
 
 namespace holoscan::advanced_network {
 
+/**
+ * @brief Lock-free log-linear latency histogram
+ *
+ * HDR-style layout: values below SUB_BUCKETS ns are counted exactly, and every larger power
+ * of two is split in SUB_BUCKETS linear buckets, bounding the relative error to about 3%.
+ * Recording is a handful of relaxed atomics so it can be done from the data path by any
+ * thread, while readers take a consistent-enough snapshot for reporting.
+ */
+class LatencyHistogram {
+ public:
+  static constexpr int SUB_BUCKET_BITS = 5;
+  static constexpr int SUB_BUCKETS = 1 << SUB_BUCKET_BITS;
+  static constexpr int MAX_VALUE_BITS = 36;  // ~68s, larger values land in the last bucket
+  static constexpr int NUM_BUCKETS = (MAX_VALUE_BITS - SUB_BUCKET_BITS + 1) * SUB_BUCKETS;
+
+  inline void record(uint64_t value_ns) {
+    buckets_[bucket_index(value_ns)].fetch_add(1, std::memory_order_relaxed);
+    count_.fetch_add(1, std::memory_order_relaxed);
+    sum_.fetch_add(value_ns, std::memory_order_relaxed);
+
+    uint64_t cur = min_.load(std::memory_order_relaxed);
+    while (value_ns < cur &&
+           !min_.compare_exchange_weak(cur, value_ns, std::memory_order_relaxed)) {}
+    cur = max_.load(std::memory_order_relaxed);
+    while (value_ns > cur &&
+           !max_.compare_exchange_weak(cur, value_ns, std::memory_order_relaxed)) {}
+  }
+
+  LatencySummary summary() const;
+
+ private:
+  static inline int bucket_index(uint64_t value) {
+    if (value < SUB_BUCKETS) { return static_cast<int>(value); }
+
+    const int msb = 63 - __builtin_clzll(value);
+    if (msb >= MAX_VALUE_BITS) { return NUM_BUCKETS - 1; }
+
+    const int group = msb - SUB_BUCKET_BITS + 1;
+    return group * SUB_BUCKETS + static_cast<int>((value >> (group - 1)) - SUB_BUCKETS);
+  }
+
+  static inline uint64_t bucket_value(int idx) {
+    const int group = idx / SUB_BUCKETS;
+    const uint64_t sub = idx % SUB_BUCKETS;
+    if (group == 0) { return sub; }
+    return (sub + SUB_BUCKETS) << (group - 1);
+  }
+
+  std::array<std::atomic<uint64_t>, NUM_BUCKETS> buckets_{};
+  std::atomic<uint64_t> count_{0};
+  std::atomic<uint64_t> sum_{0};
+  std::atomic<uint64_t> min_{UINT64_MAX};
+  std::atomic<uint64_t> max_{0};
+};
+
+/**
+ * @brief Latency histograms of a single RX queue. See QueueLatencyStats
+ */
+struct RxQueueLatencyHistograms {
+  LatencyHistogram wire_to_dequeue;
+  LatencyHistogram ring_to_dequeue;
+  LatencyHistogram dequeue_to_free;
+};
+
+/**
+ * @brief Idle statistics of an RX worker using adaptive polling
+ *
+ * The wakeup latency is the time from the NIC receiving the first packet after a sleep to the
+ * worker polling it, and is only measured when NIC RX timestamps are available.
+ */
+struct RxAdaptivePollStats {
+  std::atomic<uint64_t> sleeps{0};
+  std::atomic<uint64_t> sleep_timeouts{0};  // Sleeps that ended without a packet
+  std::atomic<uint64_t> sleep_ns{0};
+  LatencyHistogram wakeup;
+};
+
 class DpdkStats {
  public:
     DpdkStats() = default;
@@ -16,6 +16,7 @@
  */
 
 #include <stdio.h>
+#include <algorithm>
 #include "adv_network_doca_kernels.h"
 #define ETHER_ADDR_LEN 6
 #define DOCA_DEBUG_KERNEL 0
@@ -63,18 +64,148 @@ __device__ __inline__ int raw_to_udp(const uintptr_t buf_addr, struct eth_ip_udp
   return 0;
 }
 
+using holoscan::advanced_network::MAX_RX_FILTER_RULES;
+using holoscan::advanced_network::RxFilterAction;
+
+/* Index of the first filter rule matching the packet, num_rules when none match */
+__device__ __inline__ uint32_t match_filter_rules(const struct adv_doca_rx_filter_rule* rules,
+                                                  uint32_t num_rules, const uint8_t* pkt,
+                                                  uint32_t len) {
+  for (uint32_t r = 0; r < num_rules; r++) {
+    const struct adv_doca_rx_filter_rule& rule = rules[r];
+    if (rule.offset + rule.size > len) continue;
+
+    uint32_t field = 0;
+    for (uint32_t b = 0; b < rule.size; b++) field = (field << 8) | pkt[rule.offset + b];
+    if (((field & rule.mask) == rule.value) != (rule.negate != 0)) return r;
+  }
+
+  return num_rules;
+}
+
+/*
+ * Position of a kept packet among the packets kept by the whole block, in packet order.
+ * Must be called by all threads of the block, kept returns the number of packets kept.
+ */
+__device__ __inline__ uint32_t block_compact_index(bool keep, uint32_t* kept) {
+  __shared__ uint32_t warp_kept[CUDA_BLOCK_THREADS / 32];
+  const uint32_t lane = threadIdx.x % 32;
+  const uint32_t warp = threadIdx.x / 32;
+  const uint32_t ballot = __ballot_sync(0xFFFFFFFF, keep);
+
+  if (lane == 0) warp_kept[warp] = __popc(ballot);
+  __syncthreads();
+
+  uint32_t offset = 0;
+  uint32_t total = 0;
+  for (uint32_t w = 0; w < blockDim.x / 32; w++) {
+    if (w == warp) offset = total;
+    total += warp_kept[w];
+  }
+  __syncthreads();
+
+  *kept = total;
+  return offset + __popc(ballot & ((1U << lane) - 1));
+}
+
+/*
+ * Filter the rx_pkt_num packets received at rx_buf_idx, appending the kept ones to the
+ * semaphore item slot after the slot_kept packets it already holds. Must be called by all
+ * threads of the block. Returns the number of packets kept, pkt0_addr the address of the first
+ * packet received.
+ */
+__device__ uint32_t filter_packets(struct doca_gpu_eth_rxq* rxq, uint64_t rx_buf_idx,
+                                   uint32_t rx_pkt_num, struct adv_doca_rx_filter* filter,
+                                   uint32_t slot, uint32_t slot_kept, uint32_t* rx_pkt_bytes,
+                                   uintptr_t* pkt0_addr, uint32_t* exit_cond) {
+  __shared__ struct adv_doca_rx_filter_rule rules[MAX_RX_FILTER_RULES];
+  __shared__ uint32_t rule_hits[MAX_RX_FILTER_RULES];
+  const uint32_t num_rules = filter->num_rules;
+  uintptr_t* slot_addr = filter->pkt_addr + slot * filter->slot_pkts + slot_kept;
+  uint16_t* slot_tag = filter->pkt_tag + slot * filter->slot_pkts + slot_kept;
+  uint32_t kept_total = 0;
+
+  if (threadIdx.x < num_rules) {
+    rules[threadIdx.x] = filter->rules[threadIdx.x];
+    rule_hits[threadIdx.x] = 0;
+  }
+  __syncthreads();
+
+  for (uint32_t base = 0; base < rx_pkt_num; base += blockDim.x) {
+    const uint32_t pkt_idx = base + threadIdx.x;
+    struct doca_gpu_buf* buf_ptr = NULL;
+    uintptr_t buf_addr = 0;
+    uint32_t pktb = 0;
+    uint16_t tag = 0;
+    bool keep = false;
+
+    if (pkt_idx < rx_pkt_num) {
+      doca_error_t ret = doca_gpu_dev_eth_rxq_get_buf(rxq, rx_buf_idx + pkt_idx, &buf_ptr);
+      if (ret == DOCA_SUCCESS) ret = doca_gpu_dev_buf_get_addr(buf_ptr, &buf_addr);
+      if (ret != DOCA_SUCCESS) {
+        printf("UDP Error %d filter doca_gpu_dev_eth_rxq_get_buf thread %d\n", ret, threadIdx.x);
+        if (exit_cond != NULL) DOCA_GPUNETIO_VOLATILE(*exit_cond) = 1;
+      } else {
+        doca_gpu_dev_eth_rxq_get_buf_bytes(rxq, pkt_idx, &pktb);
+        const uint32_t r = match_filter_rules(rules, num_rules, (const uint8_t*)buf_addr, pktb);
+        keep = true;
+        if (r < num_rules) {
+          atomicAdd_block(&rule_hits[r], 1);
+          keep = rules[r].action != static_cast<uint8_t>(RxFilterAction::DROP);
+          if (rules[r].action == static_cast<uint8_t>(RxFilterAction::TAG)) tag = rules[r].tag;
+        }
+      }
+      if (pkt_idx == 0) *pkt0_addr = buf_addr;
+    }
+
+    uint32_t kept;
+    const uint32_t pos = block_compact_index(keep, &kept);
+    if (keep) {
+      slot_addr[kept_total + pos] = buf_addr;
+      slot_tag[kept_total + pos] = tag;
+      atomicAdd_block(rx_pkt_bytes, pktb);
+    }
+    kept_total += kept;
+  }
+
+  /* Only this block updates the counters of its queue */
+  if (threadIdx.x < num_rules) filter->hits[threadIdx.x] += rule_hits[threadIdx.x];
+  if (threadIdx.x == 0) filter->dropped += rx_pkt_num - kept_total;
+  __syncthreads();
+
+  return kept_total;
+}
+
+/**
+ * @brief Publish one more ready semaphore item of this block's queue to the CPU. The counters
+ * of all queues sit next to each other in host memory, so the CPU finds every ready batch with
+ * a single scan instead of querying each semaphore.
+ *
+ * @param ready_list Per-queue count of semaphore items set ready
+ */
+__device__ __forceinline__ void signal_ready(uint32_t* ready_list) {
+  /* The semaphore status must be visible before the counter that announces it */
+  __threadfence_system();
+  const uint32_t ready = DOCA_GPUNETIO_VOLATILE(ready_list[blockIdx.x]);
+  DOCA_GPUNETIO_VOLATILE(ready_list[blockIdx.x]) = ready + 1;
+}
+
 /**
  * @brief Receiver packet kernel to where each CUDA Block receives on a different queue.
- * Works in persistent mode.
+ * Works in persistent mode. kFilter compiles in the GPU filter of the queues that have one.
  *
  * @param out Output buffer
  * @param in Pointer to list of input packet pointers
  * @param pkt_len Length of each packet. All packets must be same length for this example
  * @param num_pkts Number of packets
+ * @param ready_list Per-queue count of semaphore items set ready, polled by the CPU
  */
+template <bool kFilter>
 __global__ void receive_packets_kernel_persistent(int rxqn, uintptr_t* eth_rxq_gpu,
                                                   uintptr_t* sem_gpu, uint32_t* sem_idx_list,
-                                                  const uint32_t* batch_list, uint32_t* exit_cond) {
+                                                  const uint32_t* batch_list,
+                                                  const uintptr_t* filter_gpu,
+                                                  uint32_t* ready_list, uint32_t* exit_cond) {
   doca_error_t ret;
   struct doca_gpu_buf* buf_ptr = NULL;
   uintptr_t buf_addr;
@@ -92,10 +223,16 @@ __global__ void receive_packets_kernel_persistent(int rxqn, uintptr_t* eth_rxq_g
   __shared__ uint64_t rx_buf_idx;
   uint32_t pktb = 0;
   uint32_t tot_pkts_batch = 0;
+  uint32_t rx_pkt_kept = 0;
+  uint32_t filter_slot = 0;
+  uint32_t filter_kept = 0;
 
   // Warmup
   if (eth_rxq_gpu == NULL) return;
 
+  struct adv_doca_rx_filter* filter =
+      kFilter ? (struct adv_doca_rx_filter*)filter_gpu[blockIdx.x] : NULL;
+
   if (threadIdx.x == 0) {
     DOCA_GPUNETIO_VOLATILE(rx_pkt_bytes) = 0;
     /* Get next semaphore item to pass packets info to the CPU */
@@ -129,7 +266,24 @@ __global__ void receive_packets_kernel_persistent(int rxqn, uintptr_t* eth_rxq_g
 
     if (rx_pkt_num == 0) continue;
 
-    buf_idx = threadIdx.x;
+    if (kFilter && filter != NULL) {
+      rx_pkt_kept = filter_packets(rxq,
+                                   rx_buf_idx,
+                                   rx_pkt_num,
+                                   filter,
+                                   filter_slot,
+                                   filter_kept,
+                                   &rx_pkt_bytes,
+                                   &buf_addr,
+                                   exit_cond);
+      filter_kept += rx_pkt_kept;
+      if (threadIdx.x == 0 && tot_pkts_batch == 0) {
+        DOCA_GPUNETIO_VOLATILE(stats_global->gpu_pkt0_addr) = buf_addr;
+        DOCA_GPUNETIO_VOLATILE(stats_global->gpu_pkt0_idx) = rx_buf_idx;
+      }
+    }
+
+    buf_idx = (kFilter && filter != NULL) ? rx_pkt_num : threadIdx.x;
     while (buf_idx < rx_pkt_num) {
       ret = doca_gpu_dev_eth_rxq_get_buf(rxq, rx_buf_idx + buf_idx, &buf_ptr);
       if (ret != DOCA_SUCCESS) {
@@ -184,7 +338,7 @@ __global__ void receive_packets_kernel_persistent(int rxqn, uintptr_t* eth_rxq_g
     __syncthreads();
 
     if (threadIdx.x == 0 && rx_pkt_num > 0) {
-      tot_pkts_batch += rx_pkt_num;
+      tot_pkts_batch += (kFilter && filter != NULL) ? rx_pkt_kept : rx_pkt_num;
 #if DOCA_DEBUG_KERNEL == 1
       printf("Queue %d tot pkts %d/%d sem_idx %d\n",
              blockIdx.x,
@@ -197,6 +351,7 @@ __global__ void receive_packets_kernel_persistent(int rxqn, uintptr_t* eth_rxq_g
         DOCA_GPUNETIO_VOLATILE(stats_global->nbytes) = DOCA_GPUNETIO_VOLATILE(rx_pkt_bytes);
         __threadfence_system();
         doca_gpu_dev_semaphore_set_status(sem, sem_idx, DOCA_GPU_SEMAPHORE_STATUS_READY);
+        signal_ready(ready_list);
         sem_idx = (sem_idx + 1) % MAX_DEFAULT_SEM_X_QUEUE;
 
         /* Get next semaphore item to pass packets info to the CPU */
@@ -213,6 +368,12 @@ __global__ void receive_packets_kernel_persistent(int rxqn, uintptr_t* eth_rxq_g
         tot_pkts_batch = 0;
       }
     }
+
+    /* Every thread follows the semaphore item the kept packets are compacted into */
+    if (kFilter && filter != NULL && filter_kept >= batch_list[blockIdx.x]) {
+      filter_slot = (filter_slot + 1) % MAX_DEFAULT_SEM_X_QUEUE;
+      filter_kept = 0;
+    }
   } while (DOCA_GPUNETIO_VOLATILE(*exit_cond) == 0);
 
   __syncthreads();
@@ -223,6 +384,7 @@ __global__ void receive_packets_kernel_persistent(int rxqn, uintptr_t* eth_rxq_g
     DOCA_GPUNETIO_VOLATILE(stats_global->nbytes) = DOCA_GPUNETIO_VOLATILE(rx_pkt_bytes);
     __threadfence_system();
     doca_gpu_dev_semaphore_set_status(sem, sem_idx, DOCA_GPU_SEMAPHORE_STATUS_READY);
+    signal_ready(ready_list);
 
     /* Get next semaphore item to pass packets info to the CPU */
     ret = doca_gpu_dev_semaphore_get_custom_info_addr(sem, sem_idx, (void**)&stats_global);
@@ -238,16 +400,23 @@ __global__ void receive_packets_kernel_persistent(int rxqn, uintptr_t* eth_rxq_g
 
 /**
  * @brief Receiver packet kernel to where each CUDA Block receives on a different queue.
- * Works in non-persistent mode.
+ * Works in non-persistent mode, receiving a single batch per launch. The semaphore index of
+ * each queue is advanced on the GPU, so the kernel can be relaunched or replayed from a CUDA
+ * graph without any CPU update in between. kFilter compiles in the GPU filter of the queues that
+ * have one.
  *
  * @param out Output buffer
  * @param in Pointer to list of input packet pointers
  * @param pkt_len Length of each packet. All packets must be same length for this example
  * @param num_pkts Number of packets
+ * @param ready_list Per-queue count of semaphore items set ready, polled by the CPU
  */
+template <bool kFilter>
 __global__ void receive_packets_kernel_non_persistent(int rxqn, uintptr_t* eth_rxq_gpu,
                                                       uintptr_t* sem_gpu, uint32_t* sem_idx_list,
-                                                      const uint32_t* batch_list) {
+                                                      const uint32_t* batch_list,
+                                                      const uintptr_t* filter_gpu,
+                                                      uint32_t* ready_list) {
   doca_error_t ret;
   struct doca_gpu_buf* buf_ptr = NULL;
   uintptr_t buf_addr;
@@ -263,10 +432,14 @@ __global__ void receive_packets_kernel_non_persistent(int rxqn, uintptr_t* eth_r
   __shared__ uint32_t rx_pkt_bytes;
   __shared__ uint64_t rx_buf_idx;
   uint32_t pktb = 0;
+  uint32_t rx_pkt_kept = 0;
 
   // Warmup
   if (eth_rxq_gpu == NULL) return;
 
+  struct adv_doca_rx_filter* filter =
+      kFilter ? (struct adv_doca_rx_filter*)filter_gpu[blockIdx.x] : NULL;
+
   if (threadIdx.x == 0) DOCA_GPUNETIO_VOLATILE(rx_pkt_bytes) = 0;
   __syncthreads();
 
@@ -285,7 +458,33 @@ __global__ void receive_packets_kernel_non_persistent(int rxqn, uintptr_t* eth_r
     }
   }
 
-  buf_idx = threadIdx.x;
+  if (kFilter && filter != NULL) {
+    rx_pkt_kept = filter_packets(rxq,
+                                 rx_buf_idx,
+                                 rx_pkt_num,
+                                 filter,
+                                 sem_idx_list[blockIdx.x],
+                                 0,
+                                 &rx_pkt_bytes,
+                                 &buf_addr,
+                                 NULL);
+    if (threadIdx.x == 0 && rx_pkt_num > 0) {
+      /* Get next semaphore item to pass packets info to the CPU */
+      ret = doca_gpu_dev_semaphore_get_custom_info_addr(
+          sem, sem_idx_list[blockIdx.x], (void**)&stats_global);
+      if (ret != DOCA_SUCCESS) {
+        printf("UDP Error %d doca_gpu_dev_semaphore_get_custom_info_addr block %d thread %d\n",
+               ret,
+               blockIdx.x,
+               threadIdx.x);
+      }
+
+      DOCA_GPUNETIO_VOLATILE(stats_global->gpu_pkt0_addr) = buf_addr;
+      DOCA_GPUNETIO_VOLATILE(stats_global->gpu_pkt0_idx) = rx_buf_idx;
+    }
+  }
+
+  buf_idx = (kFilter && filter != NULL) ? rx_pkt_num : threadIdx.x;
   while (buf_idx < rx_pkt_num) {
     ret = doca_gpu_dev_eth_rxq_get_buf(rxq, rx_buf_idx + buf_idx, &buf_ptr);
     if (ret != DOCA_SUCCESS) {
@@ -353,11 +552,15 @@ __global__ void receive_packets_kernel_non_persistent(int rxqn, uintptr_t* eth_r
            batch_list[blockIdx.x],
            sem_idx_list[blockIdx.x]);
 #endif
-    DOCA_GPUNETIO_VOLATILE(stats_global->num_pkts) = DOCA_GPUNETIO_VOLATILE(rx_pkt_num);
+    DOCA_GPUNETIO_VOLATILE(stats_global->num_pkts) =
+        (kFilter && filter != NULL) ? rx_pkt_kept : DOCA_GPUNETIO_VOLATILE(rx_pkt_num);
     DOCA_GPUNETIO_VOLATILE(stats_global->nbytes) = DOCA_GPUNETIO_VOLATILE(rx_pkt_bytes);
     __threadfence_system();
     doca_gpu_dev_semaphore_set_status(
         sem, sem_idx_list[blockIdx.x], DOCA_GPU_SEMAPHORE_STATUS_READY);
+    signal_ready(ready_list);
+    /* Next launch fills the next semaphore item without the CPU updating the index */
+    sem_idx_list[blockIdx.x] = (sem_idx_list[blockIdx.x] + 1) % MAX_DEFAULT_SEM_X_QUEUE;
   }
 }
 
@@ -459,11 +662,129 @@ __global__ void send_packets_kernel(struct doca_gpu_eth_txq* txq, struct doca_gp
   __syncthreads();
 }
 
+/**
+ * @brief Enqueue the packets of a TX descriptor, strided across the calling threads.
+ *
+ * @param desc TX descriptor
+ * @param first_idx Index of the first packet handled by the thread
+ * @param stride Number of threads enqueueing packets of the descriptor
+ */
+__device__ __inline__ void enqueue_tx_desc_packets(const struct adv_doca_tx_desc& desc,
+                                                   uint32_t first_idx, uint32_t stride) {
+  struct doca_gpu_buf* buf = NULL;
+  doca_error_t ret;
+  uint32_t curr_position;
+  uint32_t mask_max_position;
+
+  doca_gpu_dev_eth_txq_get_info(desc.txq, &curr_position, &mask_max_position);
+
+  for (uint32_t pkt_idx = first_idx; pkt_idx < desc.num_pkts; pkt_idx += stride) {
+    ret = doca_gpu_dev_buf_get_buf(
+        desc.buf_arr, ((pkt_idx + desc.gpu_pkt0_idx) % desc.max_pkts), &buf);
+    if (ret != DOCA_SUCCESS) {
+      printf("Error %d doca_gpu_dev_buf_get_buf pkt_idx %d gpu_pkt0_idx %d\n",
+             ret,
+             pkt_idx,
+             desc.gpu_pkt0_idx);
+      break;
+    }
+
+    const uint32_t flags =
+        (desc.set_completion && pkt_idx == (desc.num_pkts - 1)) ? DOCA_GPU_SEND_FLAG_NOTIFY : 0;
+    ret = doca_gpu_dev_eth_txq_send_enqueue_weak(desc.txq,
+                                                 buf,
+                                                 desc.pkts_len[pkt_idx],
+                                                 ((curr_position + pkt_idx) & mask_max_position),
+                                                 flags);
+    if (ret != DOCA_SUCCESS) {
+      printf("Error %d doca_gpu_dev_eth_txq_send_enqueue_weak pkt_idx %d\n", ret, pkt_idx);
+      break;
+    }
+  }
+}
+
+/**
+ * @brief Send packet kernel for the bursts of several TX queues in one launch.
+ * Each row of blocks (blockIdx.y) sends one descriptor with a grid-stride loop, so a burst
+ * isn't limited to the number of threads in a block. The last block done with a
+ * descriptor commits and pushes its packets.
+ *
+ * @param batch Descriptors to send, one per TX queue
+ */
+__global__ void send_packets_kernel_batched(const struct adv_doca_tx_batch batch) {
+  const struct adv_doca_tx_desc& desc = batch.descs[blockIdx.y];
+
+  if (desc.num_pkts == 0) return;
+
+  enqueue_tx_desc_packets(desc, blockIdx.x * blockDim.x + threadIdx.x, gridDim.x * blockDim.x);
+  __syncthreads();
+
+  if (threadIdx.x == 0) {
+    /* Make this block's descriptors visible before the last block commits them */
+    __threadfence();
+    if (atomicAdd(&batch.blocks_done[blockIdx.y], 1) == gridDim.x - 1) {
+      batch.blocks_done[blockIdx.y] = 0;
+      doca_gpu_dev_eth_txq_commit_weak(desc.txq, desc.num_pkts);
+      doca_gpu_dev_eth_txq_push(desc.txq);
+      __threadfence_system();
+    }
+  }
+}
+
+/**
+ * @brief Persistent send packet kernel where each CUDA Block sends on a different queue.
+ * Polls its queue's ring for descriptors posted by the CPU until the exit condition is set.
+ *
+ * @param rings One ring per TX queue
+ * @param exit_cond Set to non-zero to stop the kernel
+ */
+__global__ void send_packets_kernel_persistent(struct adv_doca_tx_ring* rings,
+                                               uint32_t* exit_cond) {
+  struct adv_doca_tx_ring* ring = &rings[blockIdx.x];
+  __shared__ uint32_t running;
+  __shared__ uint32_t slot_ready;
+  uint32_t slot = 0;
+  bool keep_running;
+
+  // Warmup
+  if (rings == NULL) return;
+
+  do {
+    if (threadIdx.x == 0) {
+      DOCA_GPUNETIO_VOLATILE(running) = DOCA_GPUNETIO_VOLATILE(*exit_cond) == 0;
+      DOCA_GPUNETIO_VOLATILE(slot_ready) =
+          DOCA_GPUNETIO_VOLATILE(ring->status[slot]) == TX_RING_SLOT_READY;
+    }
+    __syncthreads();
+    /* Copy the shared flags before thread 0 updates them in the next iteration */
+    keep_running = running;
+
+    if (slot_ready) {
+      /* Don't read the descriptor before its status */
+      __threadfence_system();
+      const struct adv_doca_tx_desc desc = ring->descs[slot];
+
+      enqueue_tx_desc_packets(desc, threadIdx.x, blockDim.x);
+      __syncthreads();
+
+      if (threadIdx.x == 0) {
+        doca_gpu_dev_eth_txq_commit_weak(desc.txq, desc.num_pkts);
+        doca_gpu_dev_eth_txq_push(desc.txq);
+        __threadfence_system();
+        DOCA_GPUNETIO_VOLATILE(ring->status[slot]) = TX_RING_SLOT_FREE;
+      }
+      slot = (slot + 1) % TX_RING_SIZE;
+    }
+    __syncthreads();
+  } while (keep_running);
+}
+
 extern "C" {
 
 doca_error_t doca_receiver_packet_kernel(cudaStream_t stream, int rxqn, uintptr_t* eth_rxq_gpu,
                                          uintptr_t* sem_gpu, uint32_t* sem_idx_list,
-                                         uint32_t* batch_list, uint32_t* gpu_exit_condition,
+                                         uint32_t* batch_list, uintptr_t* filter_gpu,
+                                         uint32_t* ready_list, uint32_t* gpu_exit_condition,
                                          bool persistent) {
   cudaError_t result = cudaSuccess;
 
@@ -481,12 +802,25 @@ doca_error_t doca_receiver_packet_kernel(cudaStream_t stream, int rxqn, uintptr_
   }
 
   /* For simplicity launch 1 CUDA block with 32 CUDA threads */
-  if (persistent)
-    receive_packets_kernel_persistent<<<rxqn, CUDA_BLOCK_THREADS, 0, stream>>>(
-        rxqn, eth_rxq_gpu, sem_gpu, sem_idx_list, batch_list, gpu_exit_condition);
+  if (persistent && filter_gpu != NULL)
+    receive_packets_kernel_persistent<true><<<rxqn, CUDA_BLOCK_THREADS, 0, stream>>>(
+        rxqn,
+        eth_rxq_gpu,
+        sem_gpu,
+        sem_idx_list,
+        batch_list,
+        filter_gpu,
+        ready_list,
+        gpu_exit_condition);
+  else if (persistent)
+    receive_packets_kernel_persistent<false><<<rxqn, CUDA_BLOCK_THREADS, 0, stream>>>(
+        rxqn, eth_rxq_gpu, sem_gpu, sem_idx_list, batch_list, NULL, ready_list, gpu_exit_condition);
+  else if (filter_gpu != NULL)
+    receive_packets_kernel_non_persistent<true><<<rxqn, CUDA_BLOCK_THREADS, 0, stream>>>(
+        rxqn, eth_rxq_gpu, sem_gpu, sem_idx_list, batch_list, filter_gpu, ready_list);
   else
-    receive_packets_kernel_non_persistent<<<rxqn, CUDA_BLOCK_THREADS, 0, stream>>>(
-        rxqn, eth_rxq_gpu, sem_gpu, sem_idx_list, batch_list);
+    receive_packets_kernel_non_persistent<false><<<rxqn, CUDA_BLOCK_THREADS, 0, stream>>>(
+        rxqn, eth_rxq_gpu, sem_gpu, sem_idx_list, batch_list, NULL, ready_list);
 
   result = cudaGetLastError();
   if (cudaSuccess != result) {
@@ -498,6 +832,71 @@ doca_error_t doca_receiver_packet_kernel(cudaStream_t stream, int rxqn, uintptr_
   return DOCA_SUCCESS;
 }
 
+doca_error_t doca_receiver_packet_graph(cudaStream_t stream, int rxqn, uintptr_t* eth_rxq_gpu,
+                                        uintptr_t* sem_gpu, uint32_t* sem_idx_list,
+                                        uint32_t* batch_list, uintptr_t* filter_gpu,
+                                        uint32_t* ready_list, cudaGraphExec_t* graph_exec) {
+  cudaError_t result = cudaSuccess;
+  cudaGraph_t graph;
+
+  if (rxqn == 0 || eth_rxq_gpu == NULL || graph_exec == NULL) {
+    HOLOSCAN_LOG_ERROR("kernel_receive_packets graph invalid input values");
+    return DOCA_ERROR_INVALID_VALUE;
+  }
+
+  /* Check no previous CUDA errors */
+  result = cudaGetLastError();
+  if (cudaSuccess != result) {
+    HOLOSCAN_LOG_ERROR(
+        "[{}:{}] cuda failed with {} \n", __FILE__, __LINE__, cudaGetErrorString(result));
+    return DOCA_ERROR_BAD_STATE;
+  }
+
+  /*
+   * Capture the non-persistent receive kernel. Since it advances its own semaphore
+   * indices, replaying the graph receives the next batch of every queue.
+   */
+  result = cudaStreamBeginCapture(stream, cudaStreamCaptureModeThreadLocal);
+  if (cudaSuccess != result) {
+    HOLOSCAN_LOG_ERROR(
+        "[{}:{}] cuda failed with {} \n", __FILE__, __LINE__, cudaGetErrorString(result));
+    return DOCA_ERROR_BAD_STATE;
+  }
+
+  if (filter_gpu != NULL)
+    receive_packets_kernel_non_persistent<true><<<rxqn, CUDA_BLOCK_THREADS, 0, stream>>>(
+        rxqn, eth_rxq_gpu, sem_gpu, sem_idx_list, batch_list, filter_gpu, ready_list);
+  else
+    receive_packets_kernel_non_persistent<false><<<rxqn, CUDA_BLOCK_THREADS, 0, stream>>>(
+        rxqn, eth_rxq_gpu, sem_gpu, sem_idx_list, batch_list, NULL, ready_list);
+
+  result = cudaStreamEndCapture(stream, &graph);
+  if (cudaSuccess != result) {
+    HOLOSCAN_LOG_ERROR(
+        "[{}:{}] cuda failed with {} \n", __FILE__, __LINE__, cudaGetErrorString(result));
+    return DOCA_ERROR_BAD_STATE;
+  }
+
+  result = cudaGraphInstantiateWithFlags(graph_exec, graph, 0);
+  cudaGraphDestroy(graph);
+  if (cudaSuccess != result) {
+    HOLOSCAN_LOG_ERROR(
+        "[{}:{}] cuda failed with {} \n", __FILE__, __LINE__, cudaGetErrorString(result));
+    return DOCA_ERROR_BAD_STATE;
+  }
+
+  /* Upload now so that the first launch doesn't pay for it */
+  result = cudaGraphUpload(*graph_exec, stream);
+  if (cudaSuccess != result) {
+    HOLOSCAN_LOG_ERROR(
+        "[{}:{}] cuda failed with {} \n", __FILE__, __LINE__, cudaGetErrorString(result));
+    cudaGraphExecDestroy(*graph_exec);
+    return DOCA_ERROR_BAD_STATE;
+  }
+
+  return DOCA_SUCCESS;
+}
+
 doca_error_t doca_sender_packet_kernel(cudaStream_t stream, struct doca_gpu_eth_txq* txq,
                                        struct doca_gpu_buf_arr* buf_arr, uint32_t gpu_pkt0_idx,
                                        const size_t num_pkts, uint32_t max_pkts,
@@ -533,4 +932,69 @@ doca_error_t doca_sender_packet_kernel(cudaStream_t stream, struct doca_gpu_eth_
   return DOCA_SUCCESS;
 }
 
+doca_error_t doca_sender_packet_batch_kernel(cudaStream_t stream,
+                                             const struct adv_doca_tx_batch* batch,
+                                             uint32_t max_num_pkts) {
+  cudaError_t result = cudaSuccess;
+
+  if (batch == NULL || batch->num_descs == 0 || batch->num_descs > MAX_TX_BATCH_QUEUES ||
+      batch->blocks_done == NULL) {
+    HOLOSCAN_LOG_ERROR("kernel_send_packets batch invalid input values");
+    return DOCA_ERROR_INVALID_VALUE;
+  }
+
+  /* Check no previous CUDA errors */
+  result = cudaGetLastError();
+  if (cudaSuccess != result) {
+    HOLOSCAN_LOG_ERROR(
+        "[{}:{}] cuda failed with {} \n", __FILE__, __LINE__, cudaGetErrorString(result));
+    return DOCA_ERROR_BAD_STATE;
+  }
+
+  /* Enough blocks per queue for the largest burst, strided beyond that */
+  uint32_t blocks = (max_num_pkts + CUDA_BLOCK_THREADS - 1) / CUDA_BLOCK_THREADS;
+  blocks = std::max(1U, std::min(blocks, static_cast<uint32_t>(MAX_TX_BLOCKS_PER_QUEUE)));
+  send_packets_kernel_batched<<<dim3(blocks, batch->num_descs), CUDA_BLOCK_THREADS, 0, stream>>>(
+      *batch);
+
+  result = cudaGetLastError();
+  if (cudaSuccess != result) {
+    HOLOSCAN_LOG_ERROR(
+        "[{}:{}] cuda failed with {} \n", __FILE__, __LINE__, cudaGetErrorString(result));
+    return DOCA_ERROR_BAD_STATE;
+  }
+
+  return DOCA_SUCCESS;
+}
+
+doca_error_t doca_sender_packet_persistent_kernel(cudaStream_t stream, int txqn,
+                                                  struct adv_doca_tx_ring* rings,
+                                                  uint32_t* gpu_exit_condition) {
+  cudaError_t result = cudaSuccess;
+
+  if (txqn == 0 || gpu_exit_condition == NULL) {
+    HOLOSCAN_LOG_ERROR("kernel_send_packets persistent invalid input values");
+    return DOCA_ERROR_INVALID_VALUE;
+  }
+
+  /* Check no previous CUDA errors */
+  result = cudaGetLastError();
+  if (cudaSuccess != result) {
+    HOLOSCAN_LOG_ERROR(
+        "[{}:{}] cuda failed with {} \n", __FILE__, __LINE__, cudaGetErrorString(result));
+    return DOCA_ERROR_BAD_STATE;
+  }
+
+  send_packets_kernel_persistent<<<txqn, CUDA_BLOCK_THREADS, 0, stream>>>(rings,
+                                                                        gpu_exit_condition);
+  result = cudaGetLastError();
+  if (cudaSuccess != result) {
+    HOLOSCAN_LOG_ERROR(
+        "[{}:{}] cuda failed with {} \n", __FILE__, __LINE__, cudaGetErrorString(result));
+    return DOCA_ERROR_BAD_STATE;
+  }
+
+  return DOCA_SUCCESS;
+}
+
 } /* extern C */
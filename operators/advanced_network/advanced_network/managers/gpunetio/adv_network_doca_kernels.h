@@ -28,12 +28,23 @@ extern "C" {
 
 doca_error_t doca_receiver_packet_kernel(cudaStream_t stream, int rxqn, uintptr_t* eth_rxq_gpu,
                                          uintptr_t* sem_gpu, uint32_t* sem_idx_list,
-                                         uint32_t* batch_list, uint32_t* gpu_exit_condition,
+                                         uint32_t* batch_list, uintptr_t* filter_gpu,
+                                         uint32_t* ready_list, uint32_t* gpu_exit_condition,
                                          bool persistent);
+doca_error_t doca_receiver_packet_graph(cudaStream_t stream, int rxqn, uintptr_t* eth_rxq_gpu,
+                                        uintptr_t* sem_gpu, uint32_t* sem_idx_list,
+                                        uint32_t* batch_list, uintptr_t* filter_gpu,
+                                        uint32_t* ready_list, cudaGraphExec_t* graph_exec);
 doca_error_t doca_sender_packet_kernel(cudaStream_t stream, struct doca_gpu_eth_txq* txq,
                                        struct doca_gpu_buf_arr* buf_arr, uint32_t gpu_pkt0_idx,
                                        const size_t num_pkts, uint32_t max_pkts,
                                        uint32_t* gpu_pkts_len, bool set_completion);
+doca_error_t doca_sender_packet_batch_kernel(cudaStream_t stream,
+                                             const struct adv_doca_tx_batch* batch,
+                                             uint32_t max_num_pkts);
+doca_error_t doca_sender_packet_persistent_kernel(cudaStream_t stream, int txqn,
+                                                  struct adv_doca_tx_ring* rings,
+                                                  uint32_t* gpu_exit_condition);
 #if __cplusplus
 }
 #endif
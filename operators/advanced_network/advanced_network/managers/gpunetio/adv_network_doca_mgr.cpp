@@ -15,6 +15,7 @@
  * limitations under the License.
  */
 
+#include <algorithm>
 #include <atomic>
 #include <cmath>
 #include <complex>
@@ -76,6 +77,12 @@ std::atomic<bool> force_quit_doca = false;
 uint64_t stats_rx_tot_pkts;
 uint64_t stats_rx_tot_bytes;
 uint64_t stats_rx_tot_batch;
+uint64_t stats_rx_kernel_launches;
+uint64_t stats_rx_launch_cycles;
+uint64_t stats_rx_launch_max_cycles;
+uint64_t stats_rx_handoff_batches;
+uint64_t stats_rx_handoff_cycles;
+uint64_t stats_rx_handoff_max_cycles;
 
 uint64_t stats_tx_tot_pkts;
 uint64_t stats_tx_tot_bytes;
@@ -88,12 +95,14 @@ struct TxDocaWorkerQueue {
   uint32_t batch_size;
   struct rte_ring* ring;
   DocaTxQueue* txq;
+  DocaQueueCounters* counters;
 };
 
 struct TxDocaWorkerParams {
   int core_id;
   int txqn;
   int gpu_id;
+  TxKernelMode kernel_mode;
   struct doca_gpu* gdev;
   struct rte_mempool* meta_pool;
   struct rte_ether_addr mac_addr;
@@ -107,12 +116,14 @@ struct RxDocaWorkerQueue {
   uint32_t batch_size;
   DocaRxQueue* rxq;
   struct rte_ring* ring;
+  DocaQueueCounters* counters;
 };
 
 struct RxDocaWorkerParams {
   int core_id;
   int rxqn;
   int gpu_id;
+  RxKernelMode kernel_mode;
   struct doca_gpu* gdev;
   struct rte_mempool* meta_pool;
   struct RxDocaWorkerQueue rxqw[MAX_NUM_RX_QUEUES];
@@ -478,6 +489,7 @@ int DocaMgr::setup_pools_and_rings(int max_tx_batch) {
         HOLOSCAN_LOG_CRITICAL("Failed to allocate ring {}!", name);
         return -1;
       }
+      rx_q_counters_[key] = std::make_unique<DocaQueueCounters>();
     }
 
     for (const auto& q : intf.tx_.queues_) {
@@ -492,6 +504,7 @@ int DocaMgr::setup_pools_and_rings(int max_tx_batch) {
         HOLOSCAN_LOG_CRITICAL("Failed to allocate ring!");
         return -1;
       }
+      tx_q_counters_[key] = std::make_unique<DocaQueueCounters>();
     }
   }
 
@@ -790,6 +803,14 @@ void DocaMgr::initialize() {
         key = generate_queue_key(intf.port_id_, q.common_.id_);
         auto q_backend = rx_q_map_[key];
         q_backend->create_semaphore();
+
+        if (!q.filter_.empty()) {
+          HOLOSCAN_LOG_INFO("Create RX filter with {} rules", q.filter_.size());
+          if (q_backend->create_filter(q.filter_, q.common_.batch_size_) != DOCA_SUCCESS) {
+            HOLOSCAN_LOG_CRITICAL("Can't create RX filter of queue {}", q.common_.name_);
+            return;
+          }
+        }
       }
     }
   }
@@ -805,6 +826,12 @@ void DocaMgr::initialize() {
   stats_rx_tot_pkts = 0;
   stats_rx_tot_bytes = 0;
   stats_rx_tot_batch = 0;
+  stats_rx_kernel_launches = 0;
+  stats_rx_launch_cycles = 0;
+  stats_rx_launch_max_cycles = 0;
+  stats_rx_handoff_batches = 0;
+  stats_rx_handoff_cycles = 0;
+  stats_rx_handoff_max_cycles = 0;
 
   stats_tx_tot_pkts = 0;
   stats_tx_tot_bytes = 0;
@@ -1010,31 +1037,13 @@ doca_error_t DocaMgr::create_root_pipe(int port_id) {
     HOLOSCAN_LOG_INFO("Adding RX flow {} from {} to control pipe", flow.name_, flow.action_.id_);
     auto q_backend = static_cast<DocaRxQueue*>(flow.backend_config_);
 
-    struct doca_flow_fwd udp_fwd = {
-        .type = DOCA_FLOW_FWD_PIPE,
-        .next_pipe = q_backend->rxq_pipe,
-    };
-
-    // Reqork priority if you have multiple queues!!!
-    result = doca_flow_pipe_control_add_entry(0,
-                                              0,
-                                              root_pipe[port_id],
-                                              &udp_match,
-                                              nullptr,
-                                              nullptr,
-                                              nullptr,
-                                              nullptr,
-                                              nullptr,
-                                              nullptr,
-                                              &udp_fwd,
-                                              nullptr,
-                                              &(q_backend->root_udp_entry));
+    result =
+        add_root_flow_entry(port_id, flow, q_backend->rxq_pipe, &(q_backend->root_udp_entry));
+    if (result != DOCA_SUCCESS) { return result; }
 
-    if (result != DOCA_SUCCESS) {
-      HOLOSCAN_LOG_CRITICAL("Root pipe UDP entry creation failed with: {}",
-                            doca_error_get_descr(result));
-      return result;
-    }
+    std::lock_guard<std::mutex> lock(flow_mutex_);
+    flows_[generate_queue_key(port_id, flow.id_)] = {
+        q_backend->qid, q_backend->rxq_pipe, q_backend->root_udp_entry};
   }
 
   if (cnt_defq > 0) {
@@ -1078,6 +1087,137 @@ doca_error_t DocaMgr::create_root_pipe(int port_id) {
   return DOCA_SUCCESS;
 }
 
+/**
+ * @brief Add the root pipe entry steering the UDP ports of a flow to its pipe
+ *
+ * Matching on the flow ports lets several flows share the root pipe at the same priority,
+ * ahead of the default pipe entry.
+ */
+doca_error_t DocaMgr::add_root_flow_entry(int port_id, const FlowConfig& flow,
+                                          struct doca_flow_pipe* next_pipe,
+                                          struct doca_flow_pipe_entry** entry) {
+  doca_error_t result;
+  struct doca_flow_match udp_match = {0};
+  struct doca_flow_match udp_mask = {0};
+
+  udp_match.outer.l3_type = DOCA_FLOW_L3_TYPE_IP4;
+  udp_match.outer.l4_type_ext = DOCA_FLOW_L4_TYPE_EXT_UDP;
+  udp_mask.outer.l3_type = DOCA_FLOW_L3_TYPE_IP4;
+  udp_mask.outer.l4_type_ext = DOCA_FLOW_L4_TYPE_EXT_UDP;
+  if (flow.match_.udp_src_ > 0) {
+    udp_match.outer.udp.l4_port.src_port = rte_cpu_to_be_16(flow.match_.udp_src_);
+    udp_mask.outer.udp.l4_port.src_port = 0xffff;
+  }
+  if (flow.match_.udp_dst_ > 0) {
+    udp_match.outer.udp.l4_port.dst_port = rte_cpu_to_be_16(flow.match_.udp_dst_);
+    udp_mask.outer.udp.l4_port.dst_port = 0xffff;
+  }
+
+  struct doca_flow_fwd udp_fwd = {
+      .type = DOCA_FLOW_FWD_PIPE,
+      .next_pipe = next_pipe,
+  };
+
+  result = doca_flow_pipe_control_add_entry(0,
+                                            0,
+                                            root_pipe[port_id],
+                                            &udp_match,
+                                            &udp_mask,
+                                            nullptr,
+                                            nullptr,
+                                            nullptr,
+                                            nullptr,
+                                            nullptr,
+                                            &udp_fwd,
+                                            nullptr,
+                                            entry);
+  if (result != DOCA_SUCCESS) {
+    HOLOSCAN_LOG_CRITICAL("Root pipe UDP entry creation failed with: {}",
+                          doca_error_get_descr(result));
+  }
+
+  return result;
+}
+
+Status DocaMgr::add_flow(int port, const FlowConfig& cfg) {
+  if (port < 0 || port >= static_cast<int>(cfg_.ifs_.size()) || root_pipe[port] == nullptr) {
+    HOLOSCAN_LOG_ERROR("Invalid port {} for flow {}", port, cfg.name_);
+    return Status::INVALID_PARAMETER;
+  }
+
+  const auto q_it = rx_q_map_.find(generate_queue_key(port, cfg.action_.id_));
+  if (q_it == rx_q_map_.end()) {
+    HOLOSCAN_LOG_ERROR("Flow {} targets unknown RX queue {} on port {}",
+                       cfg.name_, cfg.action_.id_, port);
+    return Status::INVALID_PARAMETER;
+  }
+  auto q_backend = q_it->second;
+
+  std::lock_guard<std::mutex> lock(flow_mutex_);
+  const auto key = generate_queue_key(port, cfg.id_);
+  if (flows_.find(key) != flows_.end()) {
+    HOLOSCAN_LOG_ERROR("Flow ID {} already exists on port {}", cfg.id_, port);
+    return Status::INVALID_PARAMETER;
+  }
+
+  if (q_backend->create_udp_pipe(cfg, rxq_pipe_default) != DOCA_SUCCESS) {
+    HOLOSCAN_LOG_ERROR("Failed to create UDP pipe for flow {} on port {}", cfg.name_, port);
+    return Status::INTERNAL_ERROR;
+  }
+
+  DocaFlow flow = {q_backend->qid, q_backend->rxq_pipe, nullptr};
+  if (add_root_flow_entry(port, cfg, flow.pipe, &flow.root_entry) != DOCA_SUCCESS) {
+    doca_flow_pipe_destroy(flow.pipe);
+    return Status::INTERNAL_ERROR;
+  }
+
+  auto result = doca_flow_entries_process(df_port[port], 0, default_flow_timeout_usec, 0);
+  if (result != DOCA_SUCCESS) {
+    HOLOSCAN_LOG_ERROR("Root pipe entry process failed with: {}", doca_error_get_descr(result));
+    doca_flow_pipe_remove_entry(0, DOCA_FLOW_NO_WAIT, flow.root_entry);
+    doca_flow_pipe_destroy(flow.pipe);
+    return Status::INTERNAL_ERROR;
+  }
+
+  q_backend->root_udp_entry = flow.root_entry;
+  flows_[key] = flow;
+  HOLOSCAN_LOG_INFO("Added flow {} (ID {}) to queue {} on port {}",
+                    cfg.name_, cfg.id_, cfg.action_.id_, port);
+  return Status::SUCCESS;
+}
+
+Status DocaMgr::remove_flow(int port, uint16_t flow_id) {
+  std::lock_guard<std::mutex> lock(flow_mutex_);
+  const auto it = flows_.find(generate_queue_key(port, flow_id));
+  if (it == flows_.end()) {
+    HOLOSCAN_LOG_ERROR("No flow with ID {} on port {}", flow_id, port);
+    return Status::INVALID_PARAMETER;
+  }
+
+  const auto& flow = it->second;
+  auto result = doca_flow_pipe_remove_entry(0, DOCA_FLOW_NO_WAIT, flow.root_entry);
+  if (result == DOCA_SUCCESS) {
+    result = doca_flow_entries_process(df_port[port], 0, default_flow_timeout_usec, 0);
+  }
+  if (result != DOCA_SUCCESS) {
+    HOLOSCAN_LOG_ERROR("Failed to remove flow {} on port {}: {}",
+                       flow_id, port, doca_error_get_descr(result));
+    return Status::INTERNAL_ERROR;
+  }
+
+  // The queue keeps pointing to the last pipe created for it
+  auto q_backend = rx_q_map_[generate_queue_key(port, flow.qid)];
+  if (q_backend->rxq_pipe == flow.pipe) {
+    q_backend->rxq_pipe = nullptr;
+    q_backend->root_udp_entry = nullptr;
+  }
+  doca_flow_pipe_destroy(flow.pipe);
+
+  flows_.erase(it);
+  HOLOSCAN_LOG_INFO("Removed flow {} on port {}", flow_id, port);
+  return Status::SUCCESS;
+}
+
 DocaMgr::~DocaMgr() {
   // const auto& rx = cfg_.ifs_[0].rx_;
   // for (auto& q : rx.queues_) {
@@ -1142,7 +1282,15 @@ void DocaMgr::run() {
           if (cfg_.mrs_[q.common_.mrs_[0]].affinity_ == gpu_idx) {
             params_rx->rxqn++;
 
-            if (ridx == 0) params_rx->core_id = stoi(q.common_.cpu_core_);
+            if (ridx == 0) {
+              params_rx->core_id = stoi(q.common_.cpu_core_);
+              params_rx->kernel_mode = rx.kernel_mode_;
+            } else if (rx.kernel_mode_ != params_rx->kernel_mode) {
+              HOLOSCAN_LOG_WARN(
+                  "Interface {} kernel_mode differs from other interfaces on GPU {}, ignoring it",
+                  intf.name_,
+                  gpu_idx);
+            }
 
             uint32_t key = generate_queue_key(intf.port_id_, q.common_.id_);
             // Assign ring pointer to rxqw
@@ -1159,6 +1307,7 @@ void DocaMgr::run() {
             params_rx->rxqw[ridx].batch_size = q.common_.batch_size_;
             params_rx->rxqw[ridx].rxq = qinfo;
             params_rx->rxqw[ridx].port = intf.port_id_;
+            params_rx->rxqw[ridx].counters = rx_q_counters_[key].get();
 
             ridx++;
           }
@@ -1188,7 +1337,13 @@ void DocaMgr::run() {
             params_tx->txqn++;
             if (tidx == 0) {
               params_tx->core_id = stoi(q.common_.cpu_core_);
+              params_tx->kernel_mode = tx.kernel_mode_;
               rte_eth_macaddr_get(intf.port_id_, &params_tx->mac_addr);
+            } else if (tx.kernel_mode_ != params_tx->kernel_mode) {
+              HOLOSCAN_LOG_WARN(
+                  "Interface {} kernel_mode differs from other interfaces on GPU {}, ignoring it",
+                  intf.name_,
+                  gpu_idx);
             }
 
             uint32_t key = generate_queue_key(intf.port_id_, q.common_.id_);
@@ -1198,6 +1353,7 @@ void DocaMgr::run() {
             params_tx->txqw[tidx].txq = qinfo;
             params_tx->txqw[tidx].port = intf.port_id_;
             params_tx->txqw[tidx].ring = tx_rings[key];
+            params_tx->txqw[tidx].counters = tx_q_counters_[key].get();
             tidx++;
           }
         }
@@ -1232,7 +1388,12 @@ int DocaMgr::rx_core(void* arg) {
   uintptr_t *eth_rxq_cpu_list, *eth_rxq_gpu_list;
   uintptr_t *sem_cpu_list, *sem_gpu_list;
   uint32_t *sem_idx_cpu_list, *sem_idx_gpu_list;
+  uint32_t *sem_next_cpu_list, *sem_next_gpu_list;
   uint32_t *batch_cpu_list, *batch_gpu_list;
+  uint32_t *ready_cpu_list, *ready_gpu_list;
+  uint32_t consumed_list[MAX_DEFAULT_QUEUES] = {0};
+  void* bursts[MAX_DEFAULT_SEM_X_QUEUE];
+  uintptr_t *filter_cpu_list = nullptr, *filter_gpu_list = nullptr;
   uint32_t *cpu_exit_condition, *gpu_exit_condition;
   // int sem_idx[MAX_NUM_RX_QUEUES] = {0};
   struct adv_doca_rx_gpu_info* packets_stats;
@@ -1244,6 +1405,11 @@ int DocaMgr::rx_core(void* arg) {
   uint64_t last_batch = 0;
   int leastPriority;
   int greatestPriority;
+  const bool persistent = tparams->kernel_mode == RxKernelMode::PERSISTENT;
+  cudaGraphExec_t rx_graph = nullptr;
+  cudaEvent_t launch_events[MAX_RX_INFLIGHT_LAUNCHES];
+  int oldest_launch = 0;
+  int inflight_launches = 0;
 
   pthread_t self = pthread_self();
   cpu_set_t cpuset;
@@ -1328,6 +1494,19 @@ int DocaMgr::rx_core(void* arg) {
     exit(1);
   }
 
+  // Semaphore items written next by the non-persistent kernel, advanced by the GPU itself
+  result = doca_gpu_mem_alloc(tparams->gdev,
+                              tparams->rxqn * sizeof(uint32_t),
+                              GPU_PAGE_SIZE,
+                              DOCA_GPU_MEM_TYPE_CPU_GPU,
+                              (void**)&sem_next_gpu_list,
+                              (void**)&sem_next_cpu_list);
+  if (result != DOCA_SUCCESS) {
+    HOLOSCAN_LOG_ERROR("Failed to allocate gpu memory sem_next_gpu_list before launching kernel {}",
+                       doca_error_get_descr(result));
+    exit(1);
+  }
+
   result = doca_gpu_mem_alloc(tparams->gdev,
                               tparams->rxqn * sizeof(uintptr_t),
                               GPU_PAGE_SIZE,
@@ -1340,11 +1519,49 @@ int DocaMgr::rx_core(void* arg) {
     exit(1);
   }
 
+  // Ready items per queue, bumped by the kernel so the CPU scans one array instead of every
+  // semaphore
+  result = doca_gpu_mem_alloc(tparams->gdev,
+                              tparams->rxqn * sizeof(uint32_t),
+                              GPU_PAGE_SIZE,
+                              DOCA_GPU_MEM_TYPE_CPU_GPU,
+                              (void**)&ready_gpu_list,
+                              (void**)&ready_cpu_list);
+  if (result != DOCA_SUCCESS) {
+    HOLOSCAN_LOG_ERROR("Failed to allocate gpu memory ready_gpu_list before launching kernel {}",
+                       doca_error_get_descr(result));
+    exit(1);
+  }
+
+  // Filtered queues run the receive kernel instantiation with the GPU filter compiled in
+  bool filter_enabled = false;
+  for (int idx = 0; idx < tparams->rxqn; idx++) {
+    filter_enabled |= tparams->rxqw[idx].rxq->filter_gpu != nullptr;
+  }
+  if (filter_enabled) {
+    result = doca_gpu_mem_alloc(tparams->gdev,
+                                tparams->rxqn * sizeof(uintptr_t),
+                                GPU_PAGE_SIZE,
+                                DOCA_GPU_MEM_TYPE_CPU_GPU,
+                                (void**)&filter_gpu_list,
+                                (void**)&filter_cpu_list);
+    if (result != DOCA_SUCCESS) {
+      HOLOSCAN_LOG_ERROR("Failed to allocate gpu memory filter_gpu_list before launching kernel {}",
+                         doca_error_get_descr(result));
+      exit(1);
+    }
+    for (int idx = 0; idx < tparams->rxqn; idx++) {
+      filter_cpu_list[idx] = (uintptr_t)tparams->rxqw[idx].rxq->filter_gpu;
+    }
+  }
+
   for (int idx = 0; idx < tparams->rxqn; idx++) {
     eth_rxq_cpu_list[idx] = (uintptr_t)tparams->rxqw[idx].rxq->eth_rxq_gpu;
     sem_cpu_list[idx] = (uintptr_t)tparams->rxqw[idx].rxq->sem_gpu;
     sem_idx_cpu_list[idx] = 0;
+    sem_next_cpu_list[idx] = 0;
     batch_cpu_list[idx] = tparams->rxqw[idx].batch_size;
+    DOCA_GPUNETIO_VOLATILE(ready_cpu_list[idx]) = 0;
   }
 
   res_cuda = cudaStreamCreateWithPriority(&rx_stream, cudaStreamNonBlocking, greatestPriority);
@@ -1374,6 +1591,8 @@ int DocaMgr::rx_core(void* arg) {
                               sem_gpu_list,
                               sem_idx_gpu_list,
                               batch_gpu_list,
+                              nullptr,
+                              ready_gpu_list,
                               gpu_exit_condition,
                               false);
 #endif
@@ -1382,95 +1601,211 @@ int DocaMgr::rx_core(void* arg) {
 
   DOCA_GPUNETIO_VOLATILE(*cpu_exit_condition) = 0;
 
-  doca_receiver_packet_kernel(rx_stream,
-                              tparams->rxqn,
-                              eth_rxq_gpu_list,
-                              sem_gpu_list,
-                              sem_idx_gpu_list,
-                              batch_gpu_list,
-                              gpu_exit_condition,
-                              true);
+  if (tparams->kernel_mode == RxKernelMode::CUDA_GRAPH) {
+    result = doca_receiver_packet_graph(rx_stream,
+                                        tparams->rxqn,
+                                        eth_rxq_gpu_list,
+                                        sem_gpu_list,
+                                        sem_next_gpu_list,
+                                        batch_gpu_list,
+                                        filter_gpu_list,
+                                        ready_gpu_list,
+                                        &rx_graph);
+    if (result != DOCA_SUCCESS) {
+      HOLOSCAN_LOG_ERROR("Failed to create receive kernel CUDA graph: {}",
+                         doca_error_get_descr(result));
+      exit(1);
+    }
+  }
+
+  if (!persistent) {
+    for (int idx = 0; idx < MAX_RX_INFLIGHT_LAUNCHES; idx++) {
+      cudaEventCreateWithFlags(&launch_events[idx], cudaEventDisableTiming);
+    }
+  }
+
+  auto launch_rx_kernel = [&]() {
+    uint64_t start = rte_get_tsc_cycles();
+    if (tparams->kernel_mode == RxKernelMode::CUDA_GRAPH) {
+      res_cuda = cudaGraphLaunch(rx_graph, rx_stream);
+      result = (res_cuda == cudaSuccess) ? DOCA_SUCCESS : DOCA_ERROR_BAD_STATE;
+    } else {
+      result = doca_receiver_packet_kernel(rx_stream,
+                                           tparams->rxqn,
+                                           eth_rxq_gpu_list,
+                                           sem_gpu_list,
+                                           persistent ? sem_idx_gpu_list : sem_next_gpu_list,
+                                           batch_gpu_list,
+                                           filter_gpu_list,
+                                           ready_gpu_list,
+                                           gpu_exit_condition,
+                                           persistent);
+    }
+    uint64_t cycles = rte_get_tsc_cycles() - start;
+
+    stats_rx_kernel_launches++;
+    stats_rx_launch_cycles += cycles;
+    stats_rx_launch_max_cycles = std::max(stats_rx_launch_max_cycles, cycles);
+    return result;
+  };
+
+  if (persistent && launch_rx_kernel() != DOCA_SUCCESS) {
+    HOLOSCAN_LOG_ERROR("Failed to launch receive kernel");
+    exit(1);
+  }
 
   HOLOSCAN_LOG_INFO("DOCA receiver kernel ready!");
 
   uint64_t loop_count = 0;
   uint64_t loop_log_rate = 100000000;
+  uint64_t last_scan = rte_get_tsc_cycles();
+  uint32_t idle_scans = 0;
+  uint32_t idle_sleep_us = 1;
   while (!force_quit_doca.load()) {
     loop_count++;
 
+    // Keep the stream fed with single-batch launches so the GPU never idles between batches
+    if (!persistent) {
+      while (inflight_launches > 0 &&
+             cudaEventQuery(launch_events[oldest_launch]) != cudaErrorNotReady) {
+        oldest_launch = (oldest_launch + 1) % MAX_RX_INFLIGHT_LAUNCHES;
+        inflight_launches--;
+      }
+      while (inflight_launches < MAX_RX_INFLIGHT_LAUNCHES) {
+        if (launch_rx_kernel() != DOCA_SUCCESS) {
+          HOLOSCAN_LOG_ERROR("Failed to launch receive kernel");
+          force_quit_doca.store(true);
+          break;
+        }
+        int idx = (oldest_launch + inflight_launches) % MAX_RX_INFLIGHT_LAUNCHES;
+        cudaEventRecord(launch_events[idx], rx_stream);
+        inflight_launches++;
+      }
+    }
+
+    const uint64_t scan_start = rte_get_tsc_cycles();
+    uint32_t scan_batches = 0;
     for (int ridx = 0; ridx < tparams->rxqn; ridx++) {
-      result = doca_gpu_semaphore_get_status(
-          tparams->rxqw[ridx].rxq->sem_cpu, sem_idx_cpu_list[ridx], &status);
-      if (result != DOCA_SUCCESS) {
-        HOLOSCAN_LOG_ERROR("UDP semaphore error queue {}, result={}.", ridx, (int)result);
-        force_quit_doca.store(true);
-        break;
+      const auto rxq = tparams->rxqw[ridx].rxq;
+      const uint32_t pending =
+          std::min(DOCA_GPUNETIO_VOLATILE(ready_cpu_list[ridx]) - consumed_list[ridx],
+                   static_cast<uint32_t>(MAX_DEFAULT_SEM_X_QUEUE));
+      if (pending == 0) {
+        // Log semaphore status periodically while the queue is idle
+        if (loop_count % loop_log_rate == 0) {
+          doca_gpu_semaphore_get_status(rxq->sem_cpu, sem_idx_cpu_list[ridx], &status);
+          HOLOSCAN_LOG_INFO(
+              "rx_core Q {}, sem_idx {}, status: {}", ridx, sem_idx_cpu_list[ridx], (int)status);
+        }
+        continue;
       }
+      // Don't read the batch info before the counter that announced it
+      rte_smp_rmb();
 
-      // Log semaphore status periodically unless it's ready
-      if (status != DOCA_GPU_SEMAPHORE_STATUS_READY && (loop_count % loop_log_rate == 0)) {
-        HOLOSCAN_LOG_INFO(
-            "rx_core Q {}, sem_idx {}, status: {}", ridx, sem_idx_cpu_list[ridx], (int)status);
+      // One burst per pending item, the ones left over by filtered-out batches go back at the end
+      if (rte_mempool_get_bulk(tparams->meta_pool, bursts, pending) < 0) {
+        HOLOSCAN_LOG_ERROR("Processing function falling behind. No free buffers for metadata!");
+        force_quit_doca.store(true);
+        break;
       }
 
-      if (status == DOCA_GPU_SEMAPHORE_STATUS_READY) {
+      auto counters = tparams->rxqw[ridx].counters;
+      uint32_t num_bursts = 0;
+      for (uint32_t item = 0; item < pending; item++) {
+        const uint32_t sem_idx = sem_idx_cpu_list[ridx];
         result = doca_gpu_semaphore_get_custom_info_addr(
-            tparams->rxqw[ridx].rxq->sem_cpu, sem_idx_cpu_list[ridx], (void**)&(packets_stats));
+            rxq->sem_cpu, sem_idx, (void**)&(packets_stats));
         if (result != DOCA_SUCCESS) {
           HOLOSCAN_LOG_ERROR("UDP semaphore get address error.");
           force_quit_doca.store(true);
           break;
         }
 
-        if (rte_mempool_get(tparams->meta_pool, reinterpret_cast<void**>(&burst)) < 0) {
-          HOLOSCAN_LOG_ERROR("Processing function falling behind. No free buffers for metadata!");
-          force_quit_doca.store(true);
-          break;
+        // The filter may have dropped every packet of the batch, don't hand out empty bursts
+        if (rxq->filter_gpu == nullptr || packets_stats->num_pkts > 0) {
+          burst = reinterpret_cast<BurstParams*>(bursts[num_bursts++]);
+          //  Queue ID for receiver to differentiate
+          burst->hdr.hdr.q_id = tparams->rxqw[ridx].queue;
+          burst->hdr.hdr.first_pkt_addr = (uintptr_t)rxq->gpu_pkt_addr;
+          burst->hdr.hdr.max_pkt = rxq->max_pkt_num;
+          burst->hdr.hdr.max_pkt_size = rxq->max_pkt_size;
+          burst->hdr.hdr.port_id = tparams->rxqw[ridx].port;
+          burst->hdr.hdr.num_pkts = packets_stats->num_pkts;
+          burst->hdr.hdr.nbytes = packets_stats->nbytes;
+          burst->hdr.hdr.gpu_pkt0_idx = packets_stats->gpu_pkt0_idx;
+          burst->hdr.hdr.gpu_pkt0_addr = packets_stats->gpu_pkt0_addr;
+          // Kept packets aren't contiguous in the queue, they're listed by the filter
+          burst->hdr.extra_burst_data =
+              rxq->filter_gpu != nullptr ? &rxq->filter_slots[sem_idx] : nullptr;
+          HOLOSCAN_LOG_DEBUG(
+              "sem {} queue {} num_pkts {}", sem_idx, ridx, burst->hdr.hdr.num_pkts);
+          counters->pkts.fetch_add(packets_stats->num_pkts, std::memory_order_relaxed);
+          counters->bytes.fetch_add(packets_stats->nbytes, std::memory_order_relaxed);
+
+          // Update stats
+          total_pkts += burst->hdr.hdr.num_pkts;
+          stats_rx_tot_pkts += burst->hdr.hdr.num_pkts;
+          stats_rx_tot_bytes += burst->hdr.hdr.nbytes;
+          stats_rx_tot_batch++;
         }
 
-        //  Queue ID for receiver to differentiate
-        burst->hdr.hdr.q_id = tparams->rxqw[ridx].queue;
-        burst->hdr.hdr.first_pkt_addr = (uintptr_t)tparams->rxqw[ridx].rxq->gpu_pkt_addr;
-        burst->hdr.hdr.max_pkt = tparams->rxqw[ridx].rxq->max_pkt_num;
-        burst->hdr.hdr.max_pkt_size = tparams->rxqw[ridx].rxq->max_pkt_size;
-        burst->hdr.hdr.port_id = tparams->rxqw[ridx].port;
-        burst->hdr.hdr.num_pkts = packets_stats->num_pkts;
-        burst->hdr.hdr.nbytes = packets_stats->nbytes;
-        burst->hdr.hdr.gpu_pkt0_idx = packets_stats->gpu_pkt0_idx;
-        burst->hdr.hdr.gpu_pkt0_addr = packets_stats->gpu_pkt0_addr;
-        HOLOSCAN_LOG_DEBUG(
-            "sem {} queue {} num_pkts {}", sem_idx_cpu_list[ridx], ridx, burst->hdr.hdr.num_pkts);
-        // Check if the ring pointer assigned during setup is valid
-        if (tparams->rxqw[ridx].ring == nullptr) {
-          HOLOSCAN_LOG_ERROR("RX Worker: Ring pointer for queue index {} is null. Dropping burst.",
-                             ridx);
-          rte_mempool_put(tparams->meta_pool, burst);
-        } else {
-          // Enqueue into the specific ring associated with this worker queue
-          if (rte_ring_enqueue(tparams->rxqw[ridx].ring, reinterpret_cast<void*>(burst)) != 0) {
-            HOLOSCAN_LOG_WARN("RX ring for queue index {} is full. Dropping burst.", ridx);
-            rte_mempool_put(tparams->meta_pool, burst);
-          }
-        }
-
-        // Update stats
-        total_pkts += burst->hdr.hdr.num_pkts;
-        stats_rx_tot_pkts += burst->hdr.hdr.num_pkts;
-        stats_rx_tot_bytes += burst->hdr.hdr.nbytes;
-        stats_rx_tot_batch++;
-
         // Reset semaphore to free
-        result = doca_gpu_semaphore_set_status(tparams->rxqw[ridx].rxq->sem_cpu,
-                                               sem_idx_cpu_list[ridx],
-                                               DOCA_GPU_SEMAPHORE_STATUS_FREE);
+        result = doca_gpu_semaphore_set_status(
+            rxq->sem_cpu, sem_idx, DOCA_GPU_SEMAPHORE_STATUS_FREE);
         if (result != DOCA_SUCCESS) {
           HOLOSCAN_LOG_ERROR("UDP semaphore set status error queue {}.", ridx);
           force_quit_doca.store(true);
           break;
         }
 
-        sem_idx_cpu_list[ridx] = (sem_idx_cpu_list[ridx] + 1) % MAX_DEFAULT_SEM_X_QUEUE;
+        sem_idx_cpu_list[ridx] = (sem_idx + 1) % MAX_DEFAULT_SEM_X_QUEUE;
+        consumed_list[ridx]++;
+      }
+
+      // Hand every ready batch of the queue to its ring at once
+      uint32_t enqueued = 0;
+      if (tparams->rxqw[ridx].ring == nullptr) {
+        HOLOSCAN_LOG_ERROR("RX Worker: Ring pointer for queue index {} is null. Dropping burst.",
+                           ridx);
+      } else if (num_bursts > 0) {
+        enqueued =
+            rte_ring_enqueue_burst(tparams->rxqw[ridx].ring, bursts, num_bursts, nullptr);
+        if (enqueued < num_bursts) {
+          HOLOSCAN_LOG_WARN("RX ring for queue index {} is full. Dropping {} bursts.",
+                            ridx,
+                            num_bursts - enqueued);
+        }
+        if (enqueued > 0) {
+          Manager::notify_rx_ready(tparams->rxqw[ridx].port, tparams->rxqw[ridx].queue);
+        }
+      }
+      for (uint32_t idx = enqueued; idx < num_bursts; idx++) {
+        counters->drops.fetch_add(reinterpret_cast<BurstParams*>(bursts[idx])->hdr.hdr.num_pkts,
+                                  std::memory_order_relaxed);
+      }
+      if (enqueued < pending) {
+        rte_mempool_put_bulk(tparams->meta_pool, &bursts[enqueued], pending - enqueued);
       }
+
+      // The batches became ready after the previous scan started, at the latest
+      const uint64_t handoff = rte_get_tsc_cycles() - last_scan;
+      stats_rx_handoff_batches += num_bursts;
+      stats_rx_handoff_cycles += handoff * num_bursts;
+      stats_rx_handoff_max_cycles = std::max(stats_rx_handoff_max_cycles, handoff);
+      scan_batches += pending;
+    }
+    last_scan = scan_start;
+
+    // Back off while every queue is idle: spin first to keep the latency, then sleep for
+    // exponentially longer periods so an idle link doesn't burn the core
+    if (scan_batches > 0) {
+      idle_scans = 0;
+      idle_sleep_us = 1;
+    } else if (++idle_scans < RX_POLL_SPIN_SCANS) {
+      rte_pause();
+    } else {
+      rte_delay_us_sleep(idle_sleep_us);
+      idle_sleep_us = std::min(idle_sleep_us * 2, static_cast<uint32_t>(RX_POLL_MAX_SLEEP_US));
     }
   }
 
@@ -1480,21 +1815,35 @@ int DocaMgr::rx_core(void* arg) {
 
   for (int ridx = 0; ridx < tparams->rxqn; ridx++) {
     // HOLOSCAN_LOG_INFO("Check queue {} sem {}", ridx, sem_idx[ridx]);
-    doca_gpu_semaphore_get_status(
-        tparams->rxqw[ridx].rxq->sem_cpu, sem_idx_cpu_list[ridx], &status);
-    if (status == DOCA_GPU_SEMAPHORE_STATUS_READY) {
+    // Non-persistent modes may have several batches in flight when stopping
+    int pending = persistent ? 1 : MAX_RX_INFLIGHT_LAUNCHES;
+    for (int batch = 0; batch < pending; batch++) {
+      doca_gpu_semaphore_get_status(
+          tparams->rxqw[ridx].rxq->sem_cpu, sem_idx_cpu_list[ridx], &status);
+      if (status != DOCA_GPU_SEMAPHORE_STATUS_READY) { break; }
       doca_gpu_semaphore_get_custom_info_addr(
           tparams->rxqw[ridx].rxq->sem_cpu, sem_idx_cpu_list[ridx], (void**)&(packets_stats));
       last_batch += packets_stats->num_pkts;
       stats_rx_tot_pkts += packets_stats->num_pkts;
       stats_rx_tot_bytes += packets_stats->nbytes;
       stats_rx_tot_batch++;
+      sem_idx_cpu_list[ridx] = (sem_idx_cpu_list[ridx] + 1) % MAX_DEFAULT_SEM_X_QUEUE;
     }
   }
 
+  if (!persistent) {
+    for (int idx = 0; idx < MAX_RX_INFLIGHT_LAUNCHES; idx++) {
+      cudaEventDestroy(launch_events[idx]);
+    }
+  }
+  if (rx_graph != nullptr) { cudaGraphExecDestroy(rx_graph); }
+
   doca_gpu_mem_free(tparams->gdev, (void*)eth_rxq_gpu_list);
   doca_gpu_mem_free(tparams->gdev, (void*)sem_gpu_list);
   doca_gpu_mem_free(tparams->gdev, (void*)sem_idx_gpu_list);
+  doca_gpu_mem_free(tparams->gdev, (void*)sem_next_gpu_list);
+  doca_gpu_mem_free(tparams->gdev, (void*)ready_gpu_list);
+  if (filter_gpu_list != nullptr) { doca_gpu_mem_free(tparams->gdev, (void*)filter_gpu_list); }
   cudaStreamDestroy(rx_stream);
   doca_gpu_mem_free(tparams->gdev, (void*)gpu_exit_condition);
 
@@ -1523,6 +1872,11 @@ int DocaMgr::tx_core(void* arg) {
   BurstParams* burst;
   uint64_t cnt_pkts[MAX_DEFAULT_QUEUES] = {0};
   bool set_completion[MAX_DEFAULT_QUEUES] = {false};
+  struct adv_doca_tx_batch tx_batch = {};
+  uint32_t batch_max_pkts = 0;
+  struct adv_doca_tx_ring *tx_rings_gpu = nullptr, *tx_rings_cpu = nullptr;
+  uint32_t tx_ring_head[MAX_DEFAULT_QUEUES] = {0};
+  uint32_t *cpu_exit_condition = nullptr, *gpu_exit_condition = nullptr;
 #if MPS_ENABLED == 1
   CUdevice cuDevice;
   CUcontext cuContext;
@@ -1575,6 +1929,55 @@ int DocaMgr::tx_core(void* arg) {
     cudaStreamSynchronize(tx_stream[idxq]);
   }
 
+  // Batched and persistent modes send the bursts of all queues from the first stream
+  if (tparams->kernel_mode == TxKernelMode::BATCHED) {
+    result = doca_gpu_mem_alloc(tparams->gdev,
+                                MAX_TX_BATCH_QUEUES * sizeof(uint32_t),
+                                GPU_PAGE_SIZE,
+                                DOCA_GPU_MEM_TYPE_GPU,
+                                (void**)&tx_batch.blocks_done,
+                                nullptr);
+    if (result != DOCA_SUCCESS || tx_batch.blocks_done == nullptr) {
+      HOLOSCAN_LOG_ERROR("Failed to allocate gpu memory for batched send kernel {}",
+                         doca_error_get_descr(result));
+      exit(1);
+    }
+    cudaMemset(tx_batch.blocks_done, 0, MAX_TX_BATCH_QUEUES * sizeof(uint32_t));
+  } else if (tparams->kernel_mode == TxKernelMode::PERSISTENT) {
+    result = doca_gpu_mem_alloc(tparams->gdev,
+                                tparams->txqn * sizeof(struct adv_doca_tx_ring),
+                                GPU_PAGE_SIZE,
+                                DOCA_GPU_MEM_TYPE_CPU_GPU,
+                                (void**)&tx_rings_gpu,
+                                (void**)&tx_rings_cpu);
+    if (result != DOCA_SUCCESS || tx_rings_cpu == nullptr) {
+      HOLOSCAN_LOG_ERROR("Failed to allocate gpu memory for persistent send kernel rings {}",
+                         doca_error_get_descr(result));
+      exit(1);
+    }
+    memset(tx_rings_cpu, 0, tparams->txqn * sizeof(struct adv_doca_tx_ring));
+
+    result = doca_gpu_mem_alloc(tparams->gdev,
+                                GPU_PAGE_SIZE,
+                                GPU_PAGE_SIZE,
+                                DOCA_GPU_MEM_TYPE_GPU_CPU,
+                                (void**)&gpu_exit_condition,
+                                (void**)&cpu_exit_condition);
+    if (result != DOCA_SUCCESS || gpu_exit_condition == nullptr ||
+        cpu_exit_condition == nullptr) {
+      HOLOSCAN_LOG_ERROR("Function doca_gpu_mem_alloc returned {}", doca_error_get_descr(result));
+      exit(1);
+    }
+    DOCA_GPUNETIO_VOLATILE(*cpu_exit_condition) = 0;
+
+    if (doca_sender_packet_persistent_kernel(
+            tx_stream[0], tparams->txqn, tx_rings_gpu, gpu_exit_condition) != DOCA_SUCCESS) {
+      HOLOSCAN_LOG_ERROR("Failed to launch persistent send kernel");
+      exit(1);
+    }
+    HOLOSCAN_LOG_INFO("DOCA persistent sender kernel ready!");
+  }
+
   while (!force_quit_doca.load()) {
     for (int idxq = 0; idxq < tparams->txqn; idxq++) {
       /* Guardrail to prevent issues caused on ARM by the communication between application and
@@ -1587,6 +1990,12 @@ int DocaMgr::tx_core(void* arg) {
         continue;
       }
 
+      /* Wait for the persistent kernel to release the next ring slot before taking a burst */
+      if (tparams->kernel_mode == TxKernelMode::PERSISTENT &&
+          DOCA_GPUNETIO_VOLATILE(tx_rings_cpu[idxq].status[tx_ring_head[idxq]]) !=
+              TX_RING_SLOT_FREE)
+        continue;
+
       if (rte_ring_dequeue(tparams->txqw[idxq].ring, reinterpret_cast<void**>(&burst)) != 0)
         continue;
 
@@ -1599,18 +2008,43 @@ int DocaMgr::tx_core(void* arg) {
       cnt_pkts[idxq] += burst->hdr.hdr.num_pkts;
       if (cnt_pkts[idxq] > MAX_SQ_DESCR_NUM / 4) set_completion[idxq] = true;
 
-      doca_sender_packet_kernel(tx_stream[idxq],
-                                tparams->txqw[idxq].txq->eth_txq_gpu,
-                                tparams->txqw[idxq].txq->buf_arr_gpu,
-                                burst->hdr.hdr.gpu_pkt0_idx,
-                                burst->hdr.hdr.num_pkts,
-                                burst->hdr.hdr.max_pkt,
-                                burst->pkt_lens[0],
-                                set_completion[idxq]);
+      if (tparams->kernel_mode == TxKernelMode::PER_QUEUE) {
+        doca_sender_packet_kernel(tx_stream[idxq],
+                                  tparams->txqw[idxq].txq->eth_txq_gpu,
+                                  tparams->txqw[idxq].txq->buf_arr_gpu,
+                                  burst->hdr.hdr.gpu_pkt0_idx,
+                                  burst->hdr.hdr.num_pkts,
+                                  burst->hdr.hdr.max_pkt,
+                                  burst->pkt_lens[0],
+                                  set_completion[idxq]);
+      } else {
+        struct adv_doca_tx_desc desc;
+        desc.txq = tparams->txqw[idxq].txq->eth_txq_gpu;
+        desc.buf_arr = tparams->txqw[idxq].txq->buf_arr_gpu;
+        desc.pkts_len = burst->pkt_lens[0];
+        desc.gpu_pkt0_idx = burst->hdr.hdr.gpu_pkt0_idx;
+        desc.num_pkts = burst->hdr.hdr.num_pkts;
+        desc.max_pkts = burst->hdr.hdr.max_pkt;
+        desc.set_completion = set_completion[idxq];
+
+        if (tparams->kernel_mode == TxKernelMode::BATCHED) {
+          tx_batch.descs[tx_batch.num_descs++] = desc;
+          batch_max_pkts = std::max(batch_max_pkts, desc.num_pkts);
+        } else {
+          /* Publish the descriptor before handing the slot to the GPU */
+          auto& ring = tx_rings_cpu[idxq];
+          ring.descs[tx_ring_head[idxq]] = desc;
+          rte_wmb();
+          DOCA_GPUNETIO_VOLATILE(ring.status[tx_ring_head[idxq]]) = TX_RING_SLOT_READY;
+          tx_ring_head[idxq] = (tx_ring_head[idxq] + 1) % TX_RING_SIZE;
+        }
+      }
 
       rte_mempool_put(tparams->meta_pool, burst);
 
       stats_tx_tot_pkts += burst->hdr.hdr.num_pkts;
+      tparams->txqw[idxq].counters->pkts.fetch_add(burst->hdr.hdr.num_pkts,
+                                                   std::memory_order_relaxed);
       // stats_tx_tot_bytes += burst->hdr.hdr.nbytes;
       stats_tx_tot_batch++;
 
@@ -1625,10 +2059,30 @@ int DocaMgr::tx_core(void* arg) {
         set_completion[idxq] = false;
       }
     }
+
+    /* A single launch for the bursts dequeued from all queues */
+    if (tx_batch.num_descs > 0) {
+      doca_sender_packet_batch_kernel(tx_stream[0], &tx_batch, batch_max_pkts);
+      tx_batch.num_descs = 0;
+      batch_max_pkts = 0;
+    }
   }
 
   HOLOSCAN_LOG_DEBUG("DOCA RX must exit");
 
+  if (tparams->kernel_mode == TxKernelMode::PERSISTENT) {
+    DOCA_GPUNETIO_VOLATILE(*cpu_exit_condition) = 1;
+    HOLOSCAN_LOG_INFO("Wait send kernel completion");
+  }
+  cudaStreamSynchronize(tx_stream[0]);
+  if (tx_batch.blocks_done != nullptr) {
+    doca_gpu_mem_free(tparams->gdev, (void*)tx_batch.blocks_done);
+  }
+  if (tx_rings_gpu != nullptr) { doca_gpu_mem_free(tparams->gdev, (void*)tx_rings_gpu); }
+  if (gpu_exit_condition != nullptr) {
+    doca_gpu_mem_free(tparams->gdev, (void*)gpu_exit_condition);
+  }
+
   for (int idxq = 0; idxq < tparams->txqn; idxq++) {
     res_cuda = cudaStreamDestroy(tx_stream[idxq]);
     if (res_cuda != cudaSuccess) {
@@ -1648,6 +2102,11 @@ int DocaMgr::tx_core(void* arg) {
 void* DocaMgr::get_packet_ptr(BurstParams* burst, int idx) {
   uint32_t pkt = burst->hdr.hdr.gpu_pkt0_idx + idx;
 
+  if (burst->hdr.extra_burst_data != nullptr) {
+    auto slot = static_cast<const adv_doca_rx_filter_slot*>(burst->hdr.extra_burst_data);
+    return (void*)slot->pkt_addr[idx];
+  }
+
   // HOLOSCAN_LOG_INFO("get_gpu_pkt_ptr pkt {} gpu_pkt0_idx {} idx {} addr {}\n",
   //         pkt, burst->hdr.hdr.gpu_pkt0_idx, idx, burst->hdr.hdr.gpu_pkt0_addr);
 
@@ -1680,6 +2139,10 @@ uint16_t DocaMgr::get_packet_length(BurstParams* burst, int idx) {
 }
 
 uint16_t DocaMgr::get_packet_flow_id(BurstParams* burst, int idx) {
+  // Tag of the filter rule that matched the packet
+  if (burst->hdr.extra_burst_data != nullptr) {
+    return static_cast<const adv_doca_rx_filter_slot*>(burst->hdr.extra_burst_data)->pkt_tag[idx];
+  }
   return 0;
 }
 
@@ -1687,6 +2150,33 @@ uint16_t DocaMgr::get_segment_packet_length(BurstParams* burst, int seg, int idx
   return 0;
 }
 
+Status DocaMgr::get_packet_ptrs(BurstParams* burst, int seg, void** out) {
+  if (seg > 0) { return Status::INVALID_PARAMETER; }
+
+  const uint32_t num_pkts = burst->hdr.hdr.num_pkts;
+  if (burst->hdr.extra_burst_data != nullptr) {
+    auto slot = static_cast<const adv_doca_rx_filter_slot*>(burst->hdr.extra_burst_data);
+    for (uint32_t p = 0; p < num_pkts; p++) { out[p] = (void*)slot->pkt_addr[p]; }
+    return Status::SUCCESS;
+  }
+
+  // The burst is contiguous in the ring up to the wrap, then restarts at the first packet
+  const uint32_t max_pkt = burst->hdr.hdr.max_pkt;
+  const uint32_t max_pkt_size = burst->hdr.hdr.max_pkt_size;
+  const uint32_t pkt0 = burst->hdr.hdr.gpu_pkt0_idx;
+  const uint32_t before_wrap = pkt0 < max_pkt ? std::min(num_pkts, max_pkt - pkt0) : 0;
+  auto addr = (uintptr_t)burst->hdr.hdr.gpu_pkt0_addr;
+  for (uint32_t p = 0; p < before_wrap; p++, addr += max_pkt_size) { out[p] = (void*)addr; }
+  addr = (uintptr_t)burst->hdr.hdr.first_pkt_addr;
+  for (uint32_t p = before_wrap; p < num_pkts; p++, addr += max_pkt_size) { out[p] = (void*)addr; }
+  return Status::SUCCESS;
+}
+
+Status DocaMgr::get_packet_lengths(BurstParams* burst, int seg, uint16_t* out) {
+  // Packet lengths stay in the GPU receive ring
+  return Status::NOT_SUPPORTED;
+}
+
 Status DocaMgr::get_mac_addr(int port, char* mac) {
   if (port > 0) {
     HOLOSCAN_LOG_CRITICAL("Port {} out of range in get_mac_addr() lookup");
@@ -1788,6 +2278,10 @@ void DocaMgr::free_rx_burst(BurstParams* burst) {
   rte_mempool_put(rx_metadata, burst);
 }
 
+void DocaMgr::free_rx_bursts(BurstParams** bursts, int num_bursts) {
+  rte_mempool_put_bulk(rx_metadata, reinterpret_cast<void* const*>(bursts), num_bursts);
+}
+
 void DocaMgr::free_tx_burst(BurstParams* burst) {
   return;
 }
@@ -1810,6 +2304,28 @@ Status DocaMgr::get_rx_burst(BurstParams** burst, int port, int q) {
   return Status::SUCCESS;
 }
 
+int DocaMgr::get_rx_bursts(BurstParams** bursts, int max_bursts, int port, int q) {
+  uint32_t key = generate_queue_key(port, q);
+  auto ring_it = rx_rings.find(key);
+
+  if (ring_it == rx_rings.end()) {
+    HOLOSCAN_LOG_ERROR("get_rx_bursts: Could not find ring for port {}, queue {}. Check config.",
+                       port,
+                       q);
+    return 0;
+  }
+
+  return rte_ring_dequeue_burst(
+      ring_it->second, reinterpret_cast<void**>(bursts), max_bursts, nullptr);
+}
+
+int DocaMgr::get_rx_burst_count(int port, int q) {
+  auto ring_it = rx_rings.find(generate_queue_key(port, q));
+  if (ring_it == rx_rings.end()) { return -1; }
+
+  return static_cast<int>(rte_ring_count(ring_it->second));
+}
+
 void DocaMgr::free_rx_metadata(BurstParams* burst) {
   rte_mempool_put(rx_metadata, burst);
 }
@@ -1881,11 +2397,88 @@ void DocaMgr::shutdown() {
   // }
 }
 
+Status DocaMgr::get_stats(ManagerStats& stats) {
+  auto add_queue = [&stats](uint32_t key, Direction dir, const DocaQueueCounters* counters,
+                            const struct rte_ring* ring) {
+    QueueStats q_stats;
+    q_stats.port_id = get_port_from_key(key);
+    q_stats.q_id = get_queue_from_key(key);
+    q_stats.dir = dir;
+    if (counters != nullptr) {
+      q_stats.packets = counters->pkts.load(std::memory_order_relaxed);
+      q_stats.bytes = counters->bytes.load(std::memory_order_relaxed);
+      q_stats.drops = counters->drops.load(std::memory_order_relaxed);
+    }
+    if (ring != nullptr) {
+      q_stats.ring_occupancy = rte_ring_count(ring);
+      q_stats.ring_capacity = rte_ring_get_capacity(ring);
+    }
+    stats.queues.push_back(q_stats);
+  };
+
+  for (const auto& intf : cfg_.ifs_) {
+    struct rte_eth_stats eth_stats;
+    if (rte_eth_stats_get(intf.port_id_, &eth_stats) != 0) { continue; }
+
+    PortStats port_stats;
+    port_stats.port_id = intf.port_id_;
+    port_stats.rx_packets = eth_stats.ipackets;
+    port_stats.rx_bytes = eth_stats.ibytes;
+    port_stats.rx_missed = eth_stats.imissed;
+    port_stats.rx_errors = eth_stats.ierrors;
+    port_stats.tx_packets = eth_stats.opackets;
+    port_stats.tx_bytes = eth_stats.obytes;
+    port_stats.tx_errors = eth_stats.oerrors;
+    stats.ports.push_back(port_stats);
+  }
+
+  for (const auto& [key, counters] : rx_q_counters_) {
+    const auto ring_it = rx_rings.find(key);
+    add_queue(key, Direction::RX, counters.get(),
+              ring_it != rx_rings.end() ? ring_it->second : nullptr);
+    stats.rx_dropped += counters->drops.load(std::memory_order_relaxed);
+  }
+  for (const auto& [key, counters] : tx_q_counters_) {
+    const auto ring_it = tx_rings.find(key);
+    add_queue(key, Direction::TX, counters.get(),
+              ring_it != tx_rings.end() ? ring_it->second : nullptr);
+  }
+
+  for (const auto pool : {rx_metadata, tx_metadata}) {
+    if (pool == nullptr) { continue; }
+    stats.pools.push_back({pool->name, rte_mempool_avail_count(pool), pool->size});
+  }
+
+  return Status::SUCCESS;
+}
+
 void DocaMgr::print_stats() {
   HOLOSCAN_LOG_INFO("advanced_network DOCA manager stats");
   HOLOSCAN_LOG_INFO("Total Rx packets {}", stats_rx_tot_pkts);
   HOLOSCAN_LOG_INFO("Total Rx bytes {}", stats_rx_tot_bytes);
   HOLOSCAN_LOG_INFO("Total Rx batch processed {}", stats_rx_tot_batch);
+  if (stats_rx_kernel_launches > 0) {
+    const double cycles_per_us = rte_get_tsc_hz() / 1e6;
+    HOLOSCAN_LOG_INFO("Rx kernel launches {}, launch latency avg {:.2f} us, max {:.2f} us",
+                      stats_rx_kernel_launches,
+                      stats_rx_launch_cycles / cycles_per_us / stats_rx_kernel_launches,
+                      stats_rx_launch_max_cycles / cycles_per_us);
+  }
+  if (stats_rx_handoff_batches > 0) {
+    const double cycles_per_us = rte_get_tsc_hz() / 1e6;
+    HOLOSCAN_LOG_INFO("Rx semaphore to ring handoff avg {:.2f} us, max {:.2f} us",
+                      stats_rx_handoff_cycles / cycles_per_us / stats_rx_handoff_batches,
+                      stats_rx_handoff_max_cycles / cycles_per_us);
+  }
+
+  for (const auto& [key, rxq] : rx_q_map_) {
+    if (rxq->filter_cpu == nullptr) { continue; }
+    HOLOSCAN_LOG_INFO("Rx queue {} filter dropped {} packets", rxq->qid, rxq->filter_cpu->dropped);
+    for (size_t r = 0; r < rxq->filter_rules.size(); r++) {
+      HOLOSCAN_LOG_INFO("  Rule {} matched {} packets", rxq->filter_rules[r].name_,
+                        rxq->filter_cpu->hits[r]);
+    }
+  }
 
   HOLOSCAN_LOG_INFO("Total Tx packets {}", stats_tx_tot_pkts);
   HOLOSCAN_LOG_INFO("Total Tx bytes {}", stats_tx_tot_bytes);
@@ -20,6 +20,8 @@
 #include <stddef.h>
 #include <stdint.h>
 #include <atomic>
+#include <memory>
+#include <mutex>
 #include <tuple>
 #include <thread>
 #include <unordered_map>
@@ -56,6 +58,10 @@
 #define CUDA_BLOCK_THREADS 512
 #define MAX_DEFAULT_QUEUES 64
 #define MAX_DEFAULT_SEM_X_QUEUE 512
+#define MAX_RX_INFLIGHT_LAUNCHES 4
+// Idle Rx scans spent spinning before the worker starts sleeping, and the longest sleep
+#define RX_POLL_SPIN_SCANS 1024
+#define RX_POLL_MAX_SLEEP_US 64
 #define MAX_TX_BURST 1024
 #define THRESHOLD_PKT_SIZE 8192
 #define THRESHOLD_BUF_NUM 32768
@@ -70,6 +76,67 @@ struct adv_doca_rx_gpu_info {
   uint32_t gpu_pkt0_idx;
 };
 
+/* RX filter rule as evaluated by the receive kernel */
+struct adv_doca_rx_filter_rule {
+  uint32_t mask;
+  uint32_t value;
+  uint16_t offset;
+  uint16_t tag;
+  uint8_t size;
+  uint8_t action; /* RxFilterAction */
+  uint8_t negate;
+};
+
+/*
+ * RX filter of one queue, in GPU memory mapped for the CPU. The receive kernel compacts the
+ * packets it keeps into slot_pkts entries of pkt_addr and pkt_tag per semaphore item.
+ */
+struct adv_doca_rx_filter {
+  uint32_t num_rules;
+  uint32_t slot_pkts;
+  struct adv_doca_rx_filter_rule rules[holoscan::advanced_network::MAX_RX_FILTER_RULES];
+  unsigned long long hits[holoscan::advanced_network::MAX_RX_FILTER_RULES];
+  unsigned long long dropped;
+  uintptr_t* pkt_addr; /* GPU addresses */
+  uint16_t* pkt_tag;
+};
+
+/* CPU view of the packets kept by the filter for one semaphore item, set as extra_burst_data */
+struct adv_doca_rx_filter_slot {
+  const uintptr_t* pkt_addr;
+  const uint16_t* pkt_tag;
+};
+
+#define MAX_TX_BATCH_QUEUES 32
+#define MAX_TX_BLOCKS_PER_QUEUE 8
+#define TX_RING_SIZE 64
+#define TX_RING_SLOT_FREE 0
+#define TX_RING_SLOT_READY 1
+
+/* Burst of packets to send on one TX queue */
+struct adv_doca_tx_desc {
+  struct doca_gpu_eth_txq* txq;
+  struct doca_gpu_buf_arr* buf_arr;
+  uint32_t* pkts_len;
+  uint32_t gpu_pkt0_idx;
+  uint32_t num_pkts;
+  uint32_t max_pkts;
+  uint32_t set_completion;
+};
+
+/* Bursts sent by one batched kernel launch, at most one per TX queue. Passed by value. */
+struct adv_doca_tx_batch {
+  uint32_t num_descs;
+  uint32_t* blocks_done; /* One counter per descriptor in GPU memory, zeroed between launches */
+  struct adv_doca_tx_desc descs[MAX_TX_BATCH_QUEUES];
+};
+
+/* Single-producer ring of bursts polled by the persistent send kernel, one per TX queue */
+struct adv_doca_tx_ring {
+  struct adv_doca_tx_desc descs[TX_RING_SIZE];
+  uint32_t status[TX_RING_SIZE];
+};
+
 static uint64_t next_power_of_two(uint64_t x) {
   x--;
 
@@ -130,6 +197,8 @@ class DocaRxQueue {
   doca_error_t create_udp_pipe(const FlowConfig& cfg, struct doca_flow_pipe* rxq_pipe_default);
   doca_error_t create_semaphore();
   doca_error_t destroy_semaphore();
+  doca_error_t create_filter(const std::vector<RxFilterRule>& rules, uint32_t batch_size);
+  void destroy_filter();
 
   uint16_t qid;                         /* Number of queues */
   struct doca_gpu* gdev;                /* GPUNetio handler associated to queues*/
@@ -150,6 +219,19 @@ class DocaRxQueue {
   struct doca_gpu_semaphore* sem_cpu;     /* One semaphore per queue to report stats, CPU handler*/
   struct doca_gpu_semaphore_gpu* sem_gpu; /* One semaphore per queue to report stats, GPU handler*/
   enum doca_gpu_mem_type mtype;
+
+  std::vector<RxFilterRule> filter_rules;            /* GPU filter rules, empty when disabled */
+  struct adv_doca_rx_filter* filter_gpu = nullptr;     /* GPU filter state, GPU handler */
+  struct adv_doca_rx_filter* filter_cpu = nullptr;     /* GPU filter state, CPU handler */
+  void* filter_pkts_gpu = nullptr;                     /* Kept packet addresses and tags, GPU */
+  void* filter_pkts_cpu = nullptr;                     /* Kept packet addresses and tags, CPU */
+  std::vector<adv_doca_rx_filter_slot> filter_slots; /* One per semaphore item */
+};
+
+struct DocaFlow {
+  uint16_t qid;                           /* Queue the flow steers packets to */
+  struct doca_flow_pipe* pipe;            /* DOCA Flow UDP pipe of the flow */
+  struct doca_flow_pipe_entry* root_entry; /* DOCA Flow root entry jumping to the pipe */
 };
 
 class DocaTxQueue {
@@ -179,6 +261,15 @@ class DocaTxQueue {
   enum doca_gpu_mem_type mtype;
 };
 
+/**
+ * @brief Packet counters of a queue, updated by its worker and read by get_stats
+ */
+struct DocaQueueCounters {
+  std::atomic<uint64_t> pkts{0};
+  std::atomic<uint64_t> bytes{0};
+  std::atomic<uint64_t> drops{0};
+};
+
 class DocaMgr : public Manager {
  public:
   static_assert(MAX_INTERFACES <= RTE_MAX_ETHPORTS, "Too many interfaces configured");
@@ -198,6 +289,8 @@ class DocaMgr : public Manager {
   void* get_packet_ptr(BurstParams* burst, int idx) override;
   uint16_t get_packet_length(BurstParams* burst, int idx) override;
   uint16_t get_segment_packet_length(BurstParams* burst, int seg, int idx) override;
+  Status get_packet_ptrs(BurstParams* burst, int seg, void** out) override;
+  Status get_packet_lengths(BurstParams* burst, int seg, uint16_t* out) override;
   void* get_packet_extra_info(BurstParams* burst, int idx) override;
   uint16_t get_packet_flow_id(BurstParams* burst, int idx) override;
   Status get_tx_packet_burst(BurstParams* burst) override;
@@ -216,10 +309,13 @@ class DocaMgr : public Manager {
   void free_packet(BurstParams* burst, int pkt) override{};
   void free_all_packets(BurstParams* burst) override{};
   void free_rx_burst(BurstParams* burst) override;
+  void free_rx_bursts(BurstParams** bursts, int num_bursts) override;
   void free_tx_burst(BurstParams* burst) override;
 
   Status get_rx_burst(BurstParams** burst, int port, int q) override;
   using holoscan::advanced_network::Manager::get_rx_burst;  // for overloads
+  int get_rx_bursts(BurstParams** bursts, int max_bursts, int port, int q) override;
+  int get_rx_burst_count(int port, int q) override;
   Status set_packet_tx_time(BurstParams* burst, int idx, uint64_t timestamp);
   void free_rx_metadata(BurstParams* burst) override;
   void free_tx_metadata(BurstParams* burst) override;
@@ -229,6 +325,9 @@ class DocaMgr : public Manager {
   void shutdown() override;
   void print_stats() override;
   bool validate_config() const override;
+  Status add_flow(int port, const FlowConfig& cfg) override;
+  Status remove_flow(int port, uint16_t flow_id) override;
+  Status get_stats(ManagerStats& stats) override;
 
   uint64_t get_burst_tot_byte(BurstParams* burst) override;
   BurstParams* create_tx_burst_params() override;
@@ -237,13 +336,18 @@ class DocaMgr : public Manager {
   doca_error_t init_doca_devices();
   doca_error_t create_root_pipe(int port_id);
   doca_error_t create_default_pipe(int port_id, uint32_t cnt_defq);
+  doca_error_t add_root_flow_entry(int port_id, const FlowConfig& flow,
+                                   struct doca_flow_pipe* next_pipe,
+                                   struct doca_flow_pipe_entry** entry);
   struct doca_flow_port* init_doca_flow(uint16_t port_id, uint8_t rxq_num);
   int setup_pools_and_rings(int max_tx_batch);
   std::string GetQueueName(int port, int q, Direction dir);
   std::unordered_map<uint32_t, struct rte_ring*> tx_rings;
   std::unordered_map<uint32_t, struct rte_ring*> rx_rings;
-  struct rte_mempool* rx_metadata;
-  struct rte_mempool* tx_metadata;
+  std::unordered_map<uint32_t, std::unique_ptr<DocaQueueCounters>> rx_q_counters_;
+  std::unordered_map<uint32_t, std::unique_ptr<DocaQueueCounters>> tx_q_counters_;
+  struct rte_mempool* rx_metadata = nullptr;
+  struct rte_mempool* tx_metadata = nullptr;
   std::unordered_map<uint32_t, DocaRxQueue*> rx_q_map_;
   std::unordered_map<uint32_t, DocaTxQueue*> tx_q_map_;
   std::array<struct rte_eth_conf, MAX_INTERFACES> local_port_conf;
@@ -254,7 +358,9 @@ class DocaMgr : public Manager {
   std::array<struct doca_dev*, MAX_IFS> ddev{nullptr};
   std::array<struct doca_gpu*, MAX_GPUS> gdev{nullptr};
   std::array<struct doca_flow_port*, MAX_IFS> df_port;
-  std::array<struct doca_flow_pipe*, MAX_IFS> root_pipe;
+  std::array<struct doca_flow_pipe*, MAX_IFS> root_pipe{nullptr};
+  std::unordered_map<uint32_t, DocaFlow> flows_;
+  std::mutex flow_mutex_;
   struct doca_flow_pipe_entry* root_udp_entry;
   uint16_t rxq_num;
   uint16_t txq_num;
@@ -17,6 +17,7 @@
 
 #include <atomic>
 #include <cmath>
+#include <cstring>
 #include <complex>
 #include <chrono>
 #include <iostream>
@@ -166,6 +167,8 @@ DocaRxQueue::~DocaRxQueue() {
   if (result != DOCA_SUCCESS) {
     HOLOSCAN_LOG_ERROR("Failed to free gpu memory: {}", doca_error_get_descr(result));
   }
+
+  destroy_filter();
 }
 
 doca_error_t DocaRxQueue::create_udp_pipe(const FlowConfig& cfg,
@@ -330,6 +333,79 @@ doca_error_t DocaRxQueue::create_semaphore() {
   return DOCA_SUCCESS;
 }
 
+doca_error_t DocaRxQueue::create_filter(const std::vector<RxFilterRule>& rules,
+                                        uint32_t batch_size) {
+  doca_error_t result;
+
+  /*
+   * Filter state and kept packets reside on GPU, visible from CPU.
+   * The GPU updates the rule counters and writes the kept packets of every batch,
+   * the CPU reads the counters for stats and the packets for get_packet_ptr.
+   * A persistent kernel batch can overshoot the batch size by up to one receive.
+   */
+  const uint32_t slot_pkts = 2 * batch_size;
+  const size_t pkts_size =
+      MAX_DEFAULT_SEM_X_QUEUE * slot_pkts * (sizeof(uintptr_t) + sizeof(uint16_t));
+  result = doca_gpu_mem_alloc(gdev,
+                              pkts_size,
+                              GPU_PAGE_SIZE,
+                              DOCA_GPU_MEM_TYPE_GPU_CPU,
+                              &filter_pkts_gpu,
+                              &filter_pkts_cpu);
+  if (result != DOCA_SUCCESS || filter_pkts_cpu == nullptr) {
+    HOLOSCAN_LOG_ERROR("Failed to allocate RX filter packets: {}", doca_error_get_descr(result));
+    return DOCA_ERROR_NO_MEMORY;
+  }
+
+  result = doca_gpu_mem_alloc(gdev,
+                              sizeof(struct adv_doca_rx_filter),
+                              GPU_PAGE_SIZE,
+                              DOCA_GPU_MEM_TYPE_GPU_CPU,
+                              (void**)&filter_gpu,
+                              (void**)&filter_cpu);
+  if (result != DOCA_SUCCESS || filter_cpu == nullptr) {
+    HOLOSCAN_LOG_ERROR("Failed to allocate RX filter: {}", doca_error_get_descr(result));
+    return DOCA_ERROR_NO_MEMORY;
+  }
+
+  struct adv_doca_rx_filter filter = {};
+  filter.num_rules = rules.size();
+  filter.slot_pkts = slot_pkts;
+  for (size_t r = 0; r < rules.size(); r++) {
+    filter.rules[r].mask = rules[r].mask_;
+    filter.rules[r].value = rules[r].value_ & rules[r].mask_;
+    filter.rules[r].offset = rules[r].offset_;
+    filter.rules[r].tag = rules[r].tag_;
+    filter.rules[r].size = rules[r].size_;
+    filter.rules[r].action = static_cast<uint8_t>(rules[r].action_);
+    filter.rules[r].negate = rules[r].negate_;
+  }
+
+  const size_t num_pkts = MAX_DEFAULT_SEM_X_QUEUE * slot_pkts;
+  filter.pkt_addr = static_cast<uintptr_t*>(filter_pkts_gpu);
+  filter.pkt_tag = reinterpret_cast<uint16_t*>(filter.pkt_addr + num_pkts);
+  memcpy(filter_cpu, &filter, sizeof(filter));
+
+  auto pkt_addr_cpu = static_cast<const uintptr_t*>(filter_pkts_cpu);
+  auto pkt_tag_cpu = reinterpret_cast<const uint16_t*>(pkt_addr_cpu + num_pkts);
+  filter_slots.resize(MAX_DEFAULT_SEM_X_QUEUE);
+  for (int slot = 0; slot < MAX_DEFAULT_SEM_X_QUEUE; slot++) {
+    filter_slots[slot].pkt_addr = pkt_addr_cpu + slot * slot_pkts;
+    filter_slots[slot].pkt_tag = pkt_tag_cpu + slot * slot_pkts;
+  }
+  filter_rules = rules;
+
+  return DOCA_SUCCESS;
+}
+
+void DocaRxQueue::destroy_filter() {
+  if (filter_gpu != nullptr) { doca_gpu_mem_free(gdev, filter_gpu); }
+  if (filter_pkts_gpu != nullptr) { doca_gpu_mem_free(gdev, filter_pkts_gpu); }
+  filter_gpu = filter_cpu = nullptr;
+  filter_pkts_gpu = filter_pkts_cpu = nullptr;
+  filter_slots.clear();
+}
+
 doca_error_t DocaRxQueue::destroy_semaphore() {
   doca_error_t result;
 
@@ -0,0 +1,1093 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <arpa/inet.h>
+#include <netdb.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <chrono>
+#include <climits>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+
+#include <cuda.h>
+#include <cuda_runtime.h>
+
+#include "adv_network_rdma_mgr.h"
+#include "holoscan/holoscan.hpp"
+
+namespace holoscan::advanced_network {
+
+static inline uint32_t generate_queue_key(int port_id, int queue_id) {
+  return (static_cast<uint32_t>(port_id) << 16) | static_cast<uint32_t>(queue_id);
+}
+
+namespace {
+
+/**
+ * @brief Queue pair of one queue as exchanged with the peer when connecting
+ */
+struct RdmaEndpoint {
+  uint8_t dir;
+  uint8_t reserved;
+  uint16_t q_id;
+  uint32_t qpn;
+  uint32_t psn;
+  uint32_t rkey;
+  uint64_t addr;  // RX: packet buffers. TX: credit counter
+  uint64_t buf_size;
+  uint32_t num_bufs;
+  uint8_t gid[16];
+} __attribute__((packed));
+
+struct RdmaEndpointHeader {
+  uint32_t magic;
+  uint32_t num_endpoints;
+} __attribute__((packed));
+
+constexpr uint32_t ENDPOINT_MAGIC = 0x414e4f52;
+constexpr int CONNECT_TIMEOUT_S = 60;
+
+uint64_t now_ns() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+bool send_all(int fd, const void* buf, size_t len) {
+  auto ptr = static_cast<const char*>(buf);
+  while (len > 0) {
+    const ssize_t sent = send(fd, ptr, len, MSG_NOSIGNAL);
+    if (sent <= 0) { return false; }
+    ptr += sent;
+    len -= sent;
+  }
+  return true;
+}
+
+bool recv_all(int fd, void* buf, size_t len) {
+  auto ptr = static_cast<char*>(buf);
+  while (len > 0) {
+    const ssize_t received = recv(fd, ptr, len, 0);
+    if (received <= 0) { return false; }
+    ptr += received;
+    len -= received;
+  }
+  return true;
+}
+
+/**
+ * @brief TCP connection to the peer used to exchange the queue pairs. The server waits for the
+ * client, and the client retries until the server is up.
+ */
+int tcp_connect(const RdmaConfig& rdma) {
+  if (rdma.server_) {
+    const int listen_fd = socket(AF_INET, SOCK_STREAM, 0);
+    if (listen_fd < 0) { return -1; }
+    const int one = 1;
+    setsockopt(listen_fd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+
+    struct sockaddr_in addr = {};
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = INADDR_ANY;
+    addr.sin_port = htons(rdma.port_);
+    if (bind(listen_fd, reinterpret_cast<struct sockaddr*>(&addr), sizeof(addr)) < 0 ||
+        listen(listen_fd, 1) < 0) {
+      HOLOSCAN_LOG_ERROR("Failed to listen on port {}: {}", rdma.port_, strerror(errno));
+      close(listen_fd);
+      return -1;
+    }
+
+    HOLOSCAN_LOG_INFO("Waiting for the RDMA peer on port {}", rdma.port_);
+    const int fd = accept(listen_fd, nullptr, nullptr);
+    close(listen_fd);
+    return fd;
+  }
+
+  struct addrinfo hints = {};
+  struct addrinfo* res = nullptr;
+  hints.ai_family = AF_INET;
+  hints.ai_socktype = SOCK_STREAM;
+  const auto port = std::to_string(rdma.port_);
+  if (getaddrinfo(rdma.peer_address_.c_str(), port.c_str(), &hints, &res) != 0) {
+    HOLOSCAN_LOG_ERROR("Failed to resolve RDMA peer {}", rdma.peer_address_);
+    return -1;
+  }
+
+  HOLOSCAN_LOG_INFO("Connecting to the RDMA peer {}:{}", rdma.peer_address_, rdma.port_);
+  int fd = -1;
+  for (int attempt = 0; attempt < CONNECT_TIMEOUT_S * 10 && fd < 0; attempt++) {
+    fd = socket(res->ai_family, res->ai_socktype, res->ai_protocol);
+    if (fd >= 0 && connect(fd, res->ai_addr, res->ai_addrlen) < 0) {
+      close(fd);
+      fd = -1;
+      std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    }
+  }
+  freeaddrinfo(res);
+  return fd;
+}
+
+/**
+ * @brief PCIe address of an RDMA device, from sysfs
+ */
+std::string ib_device_pci_addr(const char* name) {
+  char path[PATH_MAX];
+  const std::string link = std::string("/sys/class/infiniband/") + name + "/device";
+  if (realpath(link.c_str(), path) == nullptr) { return ""; }
+  const std::string resolved(path);
+  return resolved.substr(resolved.find_last_of('/') + 1);
+}
+
+bool pci_addr_matches(const std::string& device_addr, const std::string& addr) {
+  return device_addr == normalize_pci_addr(addr);
+}
+
+}  // namespace
+
+RdmaMgr::~RdmaMgr() {
+  shutdown();
+}
+
+bool RdmaMgr::set_config_and_initialize(const NetworkConfig& cfg) {
+  if (!this->initialized_) {
+    cfg_ = cfg;
+
+    if (!validate_config()) {
+      HOLOSCAN_LOG_CRITICAL("Config validation failed");
+      return false;
+    }
+
+    initialize();
+    if (!this->initialized_) {
+      HOLOSCAN_LOG_CRITICAL("Failed to initialize RDMA");
+      return false;
+    }
+
+    run();
+  }
+
+  return true;
+}
+
+bool RdmaMgr::validate_config() const {
+  bool pass = Manager::validate_config();
+  std::unordered_map<std::string, std::string> mr_queues;
+
+  for (const auto& intf : cfg_.ifs_) {
+    if (!intf.rx_.flows_.empty()) {
+      HOLOSCAN_LOG_WARN("Flows of interface {} are ignored, RX queue N receives from TX queue N "
+                        "of the peer", intf.name_);
+    }
+
+    auto check_queue = [&](const CommonQueueConfig& q) {
+      if (q.mrs_.size() != 1) {
+        HOLOSCAN_LOG_ERROR("Queue {} must use exactly one memory region with RDMA", q.name_);
+        pass = false;
+        return;
+      }
+      // The buffers of a queue are a ring owned by its queue pair
+      const auto [it, inserted] = mr_queues.emplace(q.mrs_[0], q.name_);
+      if (!inserted) {
+        HOLOSCAN_LOG_ERROR("Memory region {} is used by queues {} and {}, each RDMA queue needs "
+                           "its own", q.mrs_[0], it->second, q.name_);
+        pass = false;
+      }
+      const auto mr = cfg_.mrs_.find(q.mrs_[0]);
+      if (mr != cfg_.mrs_.end() && mr->second.kind_ == MemoryKind::HUGE) {
+        HOLOSCAN_LOG_ERROR("Memory region {} can't be of kind huge with RDMA", q.mrs_[0]);
+        pass = false;
+      }
+    };
+    for (const auto& q : intf.rx_.queues_) { check_queue(q.common_); }
+    for (const auto& q : intf.tx_.queues_) { check_queue(q.common_); }
+  }
+
+  return pass;
+}
+
+void RdmaMgr::adjust_memory_regions() {
+  for (auto& mr : cfg_.mrs_) { mr.second.adj_size_ = mr.second.buf_size_; }
+}
+
+Status RdmaMgr::allocate_memory_regions() {
+  HOLOSCAN_LOG_INFO("Registering memory regions");
+  for (auto& [name, mr] : cfg_.mrs_) {
+    void* ptr = nullptr;
+    mr.ttl_size_ = (mr.adj_size_ * mr.num_bufs_ + GPU_PAGE_SIZE - 1) & ~(GPU_PAGE_SIZE - 1ULL);
+
+    if (mr.owned_) {
+      switch (mr.kind_) {
+        case MemoryKind::HOST:
+          ptr = aligned_alloc(GPU_PAGE_SIZE, mr.ttl_size_);
+          break;
+        case MemoryKind::HOST_PINNED:
+          if (cudaHostAlloc(&ptr, mr.ttl_size_, 0) != cudaSuccess) { ptr = nullptr; }
+          break;
+        case MemoryKind::DEVICE:
+          cudaSetDevice(mr.affinity_);
+          if (cudaMalloc(&ptr, mr.ttl_size_) != cudaSuccess) { ptr = nullptr; }
+          break;
+        default:
+          HOLOSCAN_LOG_ERROR("Unsupported memory kind {} for RDMA", static_cast<int>(mr.kind_));
+          return Status::INVALID_PARAMETER;
+      }
+
+      if (ptr == nullptr) {
+        HOLOSCAN_LOG_CRITICAL("Failed to allocate {} bytes of type {} for MR {}",
+                              mr.ttl_size_,
+                              static_cast<int>(mr.kind_),
+                              name);
+        return Status::NULL_PTR;
+      }
+    }
+
+    HOLOSCAN_LOG_INFO("Allocated memory region {} at {} type {} with {} buffers of {} bytes",
+                      name,
+                      ptr,
+                      static_cast<int>(mr.kind_),
+                      mr.num_bufs_,
+                      mr.adj_size_);
+    ar_[name] = {name, ptr};
+  }
+
+  return Status::SUCCESS;
+}
+
+int RdmaMgr::open_port(const InterfaceConfig& intf) {
+  int num_devs = 0;
+  struct ibv_device** devs = ibv_get_device_list(&num_devs);
+  if (devs == nullptr || num_devs == 0) {
+    HOLOSCAN_LOG_CRITICAL("No RDMA devices found");
+    return -1;
+  }
+
+  // Interfaces are given by PCIe address or RDMA device name
+  RdmaPort port;
+  for (int i = 0; i < num_devs && port.ctx == nullptr; i++) {
+    const char* name = ibv_get_device_name(devs[i]);
+    if (intf.address_ == name || pci_addr_matches(ib_device_pci_addr(name), intf.address_)) {
+      HOLOSCAN_LOG_INFO("{} ({}): using RDMA device {}", intf.name_, intf.address_, name);
+      port.ctx = ibv_open_device(devs[i]);
+    }
+  }
+  ibv_free_device_list(devs);
+
+  if (port.ctx == nullptr) {
+    HOLOSCAN_LOG_CRITICAL("No RDMA device found for interface {} ({})",
+                          intf.name_,
+                          intf.address_);
+    return -1;
+  }
+
+  port.pd = ibv_alloc_pd(port.ctx);
+  if (port.pd == nullptr) {
+    HOLOSCAN_LOG_CRITICAL("Failed to allocate the protection domain of {}", intf.name_);
+    return -1;
+  }
+
+  struct ibv_port_attr port_attr;
+  if (ibv_query_port(port.ctx, port.ib_port, &port_attr) != 0 ||
+      ibv_query_gid(port.ctx, port.ib_port, intf.rdma_.gid_index_, &port.gid) != 0) {
+    HOLOSCAN_LOG_CRITICAL("Failed to query port and GID {} of {}",
+                          intf.rdma_.gid_index_,
+                          intf.name_);
+    return -1;
+  }
+  port.mtu = port_attr.active_mtu;
+
+  ports_.push_back(port);
+  return 0;
+}
+
+struct ibv_mr* RdmaMgr::register_memory(struct ibv_pd* pd, const std::string& mr_name,
+                                        int access) {
+  const auto& mr = cfg_.mrs_.at(mr_name);
+  void* ptr = ar_.at(mr_name).ptr_;
+  struct ibv_mr* ibv_mr = nullptr;
+
+  // GPU memory is registered from its dmabuf when the driver exports one, and through
+  // nvidia-peermem otherwise
+  if (mr.kind_ == MemoryKind::DEVICE) {
+    int fd = -1;
+    const auto res = cuMemGetHandleForAddressRange(&fd,
+                                                   reinterpret_cast<CUdeviceptr>(ptr),
+                                                   mr.ttl_size_,
+                                                   CU_MEM_RANGE_HANDLE_TYPE_DMA_BUF_FD,
+                                                   0);
+    if (res == CUDA_SUCCESS) {
+      ibv_mr = ibv_reg_dmabuf_mr(pd, 0, mr.ttl_size_, reinterpret_cast<uint64_t>(ptr), fd, access);
+      close(fd);
+    }
+    if (ibv_mr == nullptr) {
+      HOLOSCAN_LOG_INFO("dmabuf unavailable for {}, registering it through nvidia-peermem",
+                        mr_name);
+    }
+  }
+
+  if (ibv_mr == nullptr) { ibv_mr = ibv_reg_mr(pd, ptr, mr.ttl_size_, access); }
+  if (ibv_mr == nullptr) {
+    HOLOSCAN_LOG_CRITICAL("Failed to register memory region {}: {}", mr_name, strerror(errno));
+    return nullptr;
+  }
+
+  mrs_[mr_name] = ibv_mr;
+  return ibv_mr;
+}
+
+int RdmaMgr::create_queue(const InterfaceConfig& intf, RdmaQueue& q, const std::string& mr_name) {
+  const auto& mr = cfg_.mrs_.at(mr_name);
+  auto& port = ports_[intf.port_id_];
+  const bool rx = q.dir == Direction::RX;
+
+  q.port_id = intf.port_id_;
+  q.bufs = static_cast<char*>(ar_.at(mr_name).ptr_);
+  q.buf_size = mr.adj_size_;
+  q.num_bufs = mr.num_bufs_;
+  q.psn = lrand48() & 0xFFFFFF;
+
+  const int access = rx ? IBV_ACCESS_LOCAL_WRITE | IBV_ACCESS_REMOTE_WRITE : IBV_ACCESS_LOCAL_WRITE;
+  q.mr = register_memory(port.pd, mr_name, access);
+  if (q.mr == nullptr) { return -1; }
+
+  // Credit counter written by the RX queue into the TX queue of the peer
+  void* credits = nullptr;
+  if (posix_memalign(&credits, 64, sizeof(uint64_t)) != 0) { return -1; }
+  memset(credits, 0, sizeof(uint64_t));
+  q.credits = static_cast<volatile uint64_t*>(credits);
+  q.credits_mr = ibv_reg_mr(
+      port.pd, credits, sizeof(uint64_t), IBV_ACCESS_LOCAL_WRITE | IBV_ACCESS_REMOTE_WRITE);
+  if (q.credits_mr == nullptr) {
+    HOLOSCAN_LOG_CRITICAL("Failed to register the credits of queue {}", q.q_id);
+    return -1;
+  }
+
+  struct ibv_device_attr dev_attr;
+  if (ibv_query_device(port.ctx, &dev_attr) != 0) { return -1; }
+  const uint32_t depth = std::min<uint32_t>(q.num_bufs, dev_attr.max_qp_wr);
+  if (depth < q.num_bufs) {
+    HOLOSCAN_LOG_WARN("Queue {} has {} buffers but the device allows {} work requests, "
+                      "only {} buffers are in flight", q.q_id, q.num_bufs, depth, depth);
+    q.num_bufs = depth;
+  }
+
+  q.cq = ibv_create_cq(port.ctx, depth, nullptr, nullptr, 0);
+  if (rx) { q.credit_cq = ibv_create_cq(port.ctx, CREDIT_QUEUE_DEPTH, nullptr, nullptr, 0); }
+  if (q.cq == nullptr || (rx && q.credit_cq == nullptr)) {
+    HOLOSCAN_LOG_CRITICAL("Failed to create the completion queues of queue {}", q.q_id);
+    return -1;
+  }
+
+  struct ibv_qp_init_attr init_attr = {};
+  init_attr.send_cq = rx ? q.credit_cq : q.cq;
+  init_attr.recv_cq = q.cq;
+  init_attr.qp_type = IBV_QPT_RC;
+  init_attr.cap.max_send_wr = rx ? CREDIT_QUEUE_DEPTH : depth;
+  init_attr.cap.max_recv_wr = rx ? depth : 1;
+  init_attr.cap.max_send_sge = 1;
+  init_attr.cap.max_recv_sge = 1;
+  init_attr.cap.max_inline_data = sizeof(uint64_t);
+  q.qp = ibv_create_qp(port.pd, &init_attr);
+  if (q.qp == nullptr) {
+    HOLOSCAN_LOG_CRITICAL("Failed to create the queue pair of queue {}: {}",
+                          q.q_id,
+                          strerror(errno));
+    return -1;
+  }
+
+  struct ibv_qp_attr attr = {};
+  attr.qp_state = IBV_QPS_INIT;
+  attr.pkey_index = 0;
+  attr.port_num = port.ib_port;
+  attr.qp_access_flags = IBV_ACCESS_LOCAL_WRITE | IBV_ACCESS_REMOTE_WRITE;
+  if (ibv_modify_qp(
+          q.qp, &attr, IBV_QP_STATE | IBV_QP_PKEY_INDEX | IBV_QP_PORT | IBV_QP_ACCESS_FLAGS) != 0) {
+    HOLOSCAN_LOG_CRITICAL("Failed to move the queue pair of queue {} to INIT", q.q_id);
+    return -1;
+  }
+
+  const uint32_t max_wrs = std::max<uint32_t>(q.batch_size, 64);
+  q.wcs.resize(max_wrs);
+  q.send_wrs.resize(max_wrs);
+  q.sges.resize(max_wrs);
+
+  // Every write-with-immediate consumes a receive. The sender never has more writes in flight
+  // than the RX buffers, so one receive per buffer is always enough.
+  if (rx) {
+    q.recv_wrs.resize(std::max<uint32_t>(q.num_bufs, max_wrs));
+    for (size_t i = 0; i < q.recv_wrs.size(); i++) {
+      q.recv_wrs[i] = {};
+      q.recv_wrs[i].next = (i + 1 < q.num_bufs) ? &q.recv_wrs[i + 1] : nullptr;
+    }
+    struct ibv_recv_wr* bad_wr = nullptr;
+    if (ibv_post_recv(q.qp, q.recv_wrs.data(), &bad_wr) != 0) {
+      HOLOSCAN_LOG_CRITICAL("Failed to post the receives of queue {}", q.q_id);
+      return -1;
+    }
+  }
+
+  return 0;
+}
+
+int RdmaMgr::connect_queues(const InterfaceConfig& intf) {
+  auto& port = ports_[intf.port_id_];
+  std::vector<RdmaQueue*> queues;
+  std::vector<RdmaEndpoint> local;
+
+  for (auto* map : {&rx_queues_, &tx_queues_}) {
+    for (auto& [key, q] : *map) {
+      if (q->port_id != intf.port_id_) { continue; }
+      RdmaEndpoint ep = {};
+      const bool rx = q->dir == Direction::RX;
+      ep.dir = static_cast<uint8_t>(q->dir);
+      ep.q_id = q->q_id;
+      ep.qpn = q->qp->qp_num;
+      ep.psn = q->psn;
+      ep.rkey = rx ? q->mr->rkey : q->credits_mr->rkey;
+      ep.addr = rx ? reinterpret_cast<uint64_t>(q->bufs) : reinterpret_cast<uint64_t>(q->credits);
+      ep.buf_size = q->buf_size;
+      ep.num_bufs = q->num_bufs;
+      memcpy(ep.gid, port.gid.raw, sizeof(ep.gid));
+      local.push_back(ep);
+      queues.push_back(q.get());
+    }
+  }
+
+  const int fd = tcp_connect(intf.rdma_);
+  if (fd < 0) {
+    HOLOSCAN_LOG_CRITICAL("Failed to connect interface {} to its RDMA peer", intf.name_);
+    return -1;
+  }
+
+  RdmaEndpointHeader hdr = {ENDPOINT_MAGIC, static_cast<uint32_t>(local.size())};
+  RdmaEndpointHeader peer_hdr = {};
+  std::vector<RdmaEndpoint> remote;
+  bool ok = send_all(fd, &hdr, sizeof(hdr)) &&
+            send_all(fd, local.data(), local.size() * sizeof(RdmaEndpoint)) &&
+            recv_all(fd, &peer_hdr, sizeof(peer_hdr)) && peer_hdr.magic == ENDPOINT_MAGIC;
+  if (ok) {
+    remote.resize(peer_hdr.num_endpoints);
+    ok = recv_all(fd, remote.data(), remote.size() * sizeof(RdmaEndpoint));
+  }
+  if (!ok) {
+    HOLOSCAN_LOG_CRITICAL("Failed to exchange the queue pairs of interface {}", intf.name_);
+    close(fd);
+    return -1;
+  }
+
+  for (auto* q : queues) {
+    // TX queue N connects to RX queue N of the peer and the other way around
+    const uint8_t peer_dir =
+        static_cast<uint8_t>(q->dir == Direction::RX ? Direction::TX : Direction::RX);
+    const auto ep = std::find_if(remote.begin(), remote.end(), [&](const RdmaEndpoint& e) {
+      return e.dir == peer_dir && e.q_id == q->q_id;
+    });
+    if (ep == remote.end()) {
+      HOLOSCAN_LOG_CRITICAL("Peer of interface {} has no {} queue {}",
+                            intf.name_,
+                            q->dir == Direction::RX ? "TX" : "RX",
+                            q->q_id);
+      close(fd);
+      return -1;
+    }
+
+    q->remote_addr = ep->addr;
+    q->remote_rkey = ep->rkey;
+    q->remote_buf_size = ep->buf_size;
+    q->remote_num_bufs = ep->num_bufs;
+
+    struct ibv_qp_attr attr = {};
+    attr.qp_state = IBV_QPS_RTR;
+    attr.path_mtu = port.mtu;
+    attr.dest_qp_num = ep->qpn;
+    attr.rq_psn = ep->psn;
+    attr.max_dest_rd_atomic = 1;
+    attr.min_rnr_timer = 12;
+    attr.ah_attr.is_global = 1;
+    memcpy(attr.ah_attr.grh.dgid.raw, ep->gid, sizeof(ep->gid));
+    attr.ah_attr.grh.sgid_index = intf.rdma_.gid_index_;
+    attr.ah_attr.grh.hop_limit = 64;
+    attr.ah_attr.port_num = port.ib_port;
+    if (ibv_modify_qp(q->qp,
+                      &attr,
+                      IBV_QP_STATE | IBV_QP_AV | IBV_QP_PATH_MTU | IBV_QP_DEST_QPN |
+                          IBV_QP_RQ_PSN | IBV_QP_MAX_DEST_RD_ATOMIC | IBV_QP_MIN_RNR_TIMER) != 0) {
+      HOLOSCAN_LOG_CRITICAL("Failed to move the queue pair of queue {} to RTR", q->q_id);
+      close(fd);
+      return -1;
+    }
+
+    attr = {};
+    attr.qp_state = IBV_QPS_RTS;
+    attr.timeout = 14;
+    attr.retry_cnt = 7;
+    attr.rnr_retry = 7;
+    attr.sq_psn = q->psn;
+    attr.max_rd_atomic = 1;
+    if (ibv_modify_qp(q->qp,
+                      &attr,
+                      IBV_QP_STATE | IBV_QP_TIMEOUT | IBV_QP_RETRY_CNT | IBV_QP_RNR_RETRY |
+                          IBV_QP_SQ_PSN | IBV_QP_MAX_QP_RD_ATOMIC) != 0) {
+      HOLOSCAN_LOG_CRITICAL("Failed to move the queue pair of queue {} to RTS", q->q_id);
+      close(fd);
+      return -1;
+    }
+
+    HOLOSCAN_LOG_INFO("Connected {} queue {} of interface {} to peer QP {}",
+                      q->dir == Direction::RX ? "RX" : "TX",
+                      q->q_id,
+                      intf.name_,
+                      ep->qpn);
+  }
+
+  // Neither side writes before both have all their queue pairs ready to receive
+  uint8_t ready = 1;
+  ok = send_all(fd, &ready, sizeof(ready)) && recv_all(fd, &ready, sizeof(ready));
+  close(fd);
+  if (!ok) {
+    HOLOSCAN_LOG_CRITICAL("RDMA peer of interface {} disconnected during setup", intf.name_);
+    return -1;
+  }
+
+  return 0;
+}
+
+BurstParams* RdmaMgr::create_burst(uint32_t max_pkts) {
+  auto burst = std::make_unique<BurstParams>();
+  memset(burst.get(), 0, sizeof(BurstParams));
+  burst_pkts_.emplace_back(new void*[max_pkts]);
+  burst_lens_.emplace_back(new uint32_t[max_pkts]);
+  burst->pkts[0] = burst_pkts_.back().get();
+  burst->pkt_lens[0] = burst_lens_.back().get();
+  burst->hdr.hdr.num_segs = 1;
+  bursts_.push_back(std::move(burst));
+  return bursts_.back().get();
+}
+
+void RdmaMgr::initialize() {
+  adjust_memory_regions();
+  if (allocate_memory_regions() != Status::SUCCESS) {
+    HOLOSCAN_LOG_CRITICAL("Failed to allocate memory regions");
+    return;
+  }
+
+  for (size_t i = 0; i < cfg_.ifs_.size(); i++) {
+    auto& intf = cfg_.ifs_[i];
+    intf.port_id_ = i;
+    if (open_port(intf) < 0) { return; }
+
+    for (const auto& q_cfg : intf.rx_.queues_) {
+      auto q = std::make_unique<RdmaQueue>();
+      q->dir = Direction::RX;
+      q->q_id = q_cfg.common_.id_;
+      q->batch_size = q_cfg.common_.batch_size_;
+      q->timeout_us = q_cfg.timeout_us_;
+      if (create_queue(intf, *q, q_cfg.common_.mrs_[0]) < 0) {
+        release_queue(*q);
+        return;
+      }
+      rx_queues_[generate_queue_key(intf.port_id_, q->q_id)] = std::move(q);
+    }
+
+    for (const auto& q_cfg : intf.tx_.queues_) {
+      auto q = std::make_unique<RdmaQueue>();
+      q->dir = Direction::TX;
+      q->q_id = q_cfg.common_.id_;
+      q->batch_size = q_cfg.common_.batch_size_;
+      if (create_queue(intf, *q, q_cfg.common_.mrs_[0]) < 0) {
+        release_queue(*q);
+        return;
+      }
+      max_tx_batch_ = std::max(max_tx_batch_, q->batch_size);
+      tx_queues_[generate_queue_key(intf.port_id_, q->q_id)] = std::move(q);
+    }
+
+    if (connect_queues(intf) < 0) { return; }
+  }
+
+  for (auto& [key, q] : rx_queues_) {
+    for (int i = 0; i < NUM_RX_BURSTS; i++) {
+      auto burst = create_burst(q->batch_size);
+      burst->hdr.hdr.port_id = q->port_id;
+      burst->hdr.hdr.q_id = q->q_id;
+      burst->hdr.extra_burst_data = q.get();
+      q->free_bursts.push_back(burst);
+    }
+  }
+  for (int i = 0; i < NUM_TX_BURSTS && max_tx_batch_ > 0; i++) {
+    tx_free_bursts_.push_back(create_burst(max_tx_batch_));
+  }
+
+  this->initialized_ = true;
+}
+
+void RdmaMgr::run() {
+  HOLOSCAN_LOG_INFO("RDMA manager ready, queues are polled from get_rx_burst and send_tx_burst");
+}
+
+RdmaQueue* RdmaMgr::find_queue(uint32_t key, Direction dir) {
+  auto& queues = dir == Direction::RX ? rx_queues_ : tx_queues_;
+  const auto it = queues.find(key);
+  return it == queues.end() ? nullptr : it->second.get();
+}
+
+Status RdmaMgr::get_rx_burst(BurstParams** burst, int port, int q_id) {
+  auto q = find_queue(generate_queue_key(port, q_id), Direction::RX);
+  if (q == nullptr) {
+    HOLOSCAN_LOG_ERROR("Invalid port/queue combination in get_rx_burst: {}/{}", port, q_id);
+    return Status::INVALID_PARAMETER;
+  }
+
+  if (q->pending == nullptr) {
+    std::lock_guard<std::mutex> lock(q->rx_mutex);
+    if (q->free_bursts.empty()) { return Status::NO_FREE_BURST_BUFFERS; }
+    q->pending = q->free_bursts.back();
+    q->free_bursts.pop_back();
+    q->pending->hdr.hdr.num_pkts = 0;
+    q->pending->hdr.hdr.nbytes = 0;
+  }
+
+  auto pending = q->pending;
+  const int max_wcs = std::min<size_t>(q->batch_size - pending->hdr.hdr.num_pkts, q->wcs.size());
+  const int num_wcs = ibv_poll_cq(q->cq, max_wcs, q->wcs.data());
+  if (num_wcs < 0) {
+    HOLOSCAN_LOG_ERROR("Failed to poll the completions of RX queue {}", q_id);
+    return Status::INTERNAL_ERROR;
+  }
+
+  for (int i = 0; i < num_wcs; i++) {
+    const auto& wc = q->wcs[i];
+    if (wc.status != IBV_WC_SUCCESS) {
+      q->errors++;
+      HOLOSCAN_LOG_ERROR("RX queue {} completion error: {}", q_id, ibv_wc_status_str(wc.status));
+      continue;
+    }
+
+    // The immediate carries the buffer the peer wrote to
+    const uint32_t slot = ntohl(wc.imm_data);
+    const auto idx = pending->hdr.hdr.num_pkts++;
+    pending->pkts[0][idx] = q->bufs + static_cast<size_t>(slot) * q->buf_size;
+    pending->pkt_lens[0][idx] = wc.byte_len;
+    pending->hdr.hdr.nbytes += wc.byte_len;
+  }
+
+  if (num_wcs > 0) {
+    for (int i = 0; i < num_wcs; i++) {
+      q->recv_wrs[i].next = (i + 1 < num_wcs) ? &q->recv_wrs[i + 1] : nullptr;
+    }
+    struct ibv_recv_wr* bad_wr = nullptr;
+    if (ibv_post_recv(q->qp, q->recv_wrs.data(), &bad_wr) != 0) {
+      HOLOSCAN_LOG_ERROR("Failed to repost {} receives on RX queue {}", num_wcs, q_id);
+    }
+    q->next += num_wcs;
+    if (q->pending_start_ns == 0) { q->pending_start_ns = now_ns(); }
+  }
+
+  const auto num_pkts = pending->hdr.hdr.num_pkts;
+  const bool full = num_pkts >= q->batch_size;
+  const bool timed_out = num_pkts > 0 && q->timeout_us > 0 &&
+                         now_ns() - q->pending_start_ns >= q->timeout_us * 1000;
+  if (!full && !timed_out) { return Status::NOT_READY; }
+
+  q->pkts.fetch_add(num_pkts, std::memory_order_relaxed);
+  q->bytes.fetch_add(pending->hdr.hdr.nbytes, std::memory_order_relaxed);
+  q->pending = nullptr;
+  q->pending_start_ns = 0;
+  *burst = pending;
+  return Status::SUCCESS;
+}
+
+void RdmaMgr::post_credits(RdmaQueue& q) {
+  // Retire the credit writes already sent so the send queue never fills. A write that doesn't
+  // fit is covered by the next one since the counter is cumulative.
+  struct ibv_wc wcs[4];
+  int num_wcs;
+  while ((num_wcs = ibv_poll_cq(q.credit_cq, 4, wcs)) > 0) {
+    for (int i = 0; i < num_wcs; i++) {
+      if (wcs[i].status != IBV_WC_SUCCESS) { q.errors++; }
+    }
+  }
+
+  *q.credits = q.completed;
+  struct ibv_sge sge = {reinterpret_cast<uint64_t>(q.credits), sizeof(uint64_t),
+                        q.credits_mr->lkey};
+  struct ibv_send_wr wr = {};
+  struct ibv_send_wr* bad_wr = nullptr;
+  wr.sg_list = &sge;
+  wr.num_sge = 1;
+  wr.opcode = IBV_WR_RDMA_WRITE;
+  wr.send_flags = IBV_SEND_INLINE;
+  if (++q.credit_writes % CREDIT_SIGNAL_INTERVAL == 0) { wr.send_flags |= IBV_SEND_SIGNALED; }
+  wr.wr.rdma.remote_addr = q.remote_addr;
+  wr.wr.rdma.rkey = q.remote_rkey;
+  if (ibv_post_send(q.qp, &wr, &bad_wr) != 0) {
+    HOLOSCAN_LOG_DEBUG("Credit write of RX queue {} deferred", q.q_id);
+  }
+}
+
+void RdmaMgr::free_all_packets(BurstParams* burst) {
+  // RX buffers are freed in ring order, returning them to the sender as credits
+  auto q = static_cast<RdmaQueue*>(burst->hdr.extra_burst_data);
+  if (q == nullptr || burst->hdr.hdr.num_pkts == 0) { return; }
+
+  std::lock_guard<std::mutex> lock(q->rx_mutex);
+  q->completed += burst->hdr.hdr.num_pkts;
+  burst->hdr.hdr.num_pkts = 0;
+  post_credits(*q);
+}
+
+void RdmaMgr::free_all_segment_packets(BurstParams* burst, int seg) {
+  if (seg == 0) { free_all_packets(burst); }
+}
+
+void RdmaMgr::free_rx_metadata(BurstParams* burst) {
+  auto q = static_cast<RdmaQueue*>(burst->hdr.extra_burst_data);
+  if (q == nullptr) { return; }
+
+  std::lock_guard<std::mutex> lock(q->rx_mutex);
+  q->free_bursts.push_back(burst);
+}
+
+void RdmaMgr::free_rx_burst(BurstParams* burst) {
+  free_all_packets(burst);
+  free_rx_metadata(burst);
+}
+
+int RdmaMgr::poll_tx_completions(RdmaQueue& q) {
+  const int num_wcs = ibv_poll_cq(q.cq, q.wcs.size(), q.wcs.data());
+  for (int i = 0; i < num_wcs; i++) {
+    const auto& wc = q.wcs[i];
+    if (wc.status != IBV_WC_SUCCESS) {
+      q.errors++;
+      HOLOSCAN_LOG_ERROR("TX queue {} completion error: {}", q.q_id, ibv_wc_status_str(wc.status));
+      continue;
+    }
+    // Completions are in order on a connected queue pair, each covers the whole burst
+    q.completed = wc.wr_id;
+  }
+  return num_wcs;
+}
+
+uint32_t RdmaMgr::tx_buffers_available(RdmaQueue& q) {
+  poll_tx_completions(q);
+  const uint64_t local_free = q.num_bufs - (q.next - q.completed);
+  const uint64_t remote_free = q.remote_num_bufs - (q.next - *q.credits);
+  return std::min(local_free, remote_free);
+}
+
+bool RdmaMgr::is_tx_burst_available(BurstParams* burst) {
+  auto q = find_queue(generate_queue_key(burst->hdr.hdr.port_id, burst->hdr.hdr.q_id),
+                      Direction::TX);
+  return q != nullptr && tx_buffers_available(*q) >= burst->hdr.hdr.num_pkts;
+}
+
+Status RdmaMgr::get_tx_packet_burst(BurstParams* burst) {
+  auto q = find_queue(generate_queue_key(burst->hdr.hdr.port_id, burst->hdr.hdr.q_id),
+                      Direction::TX);
+  if (q == nullptr) {
+    HOLOSCAN_LOG_ERROR("Invalid port/queue combination in get_tx_packet_burst: {}/{}",
+                       burst->hdr.hdr.port_id,
+                       burst->hdr.hdr.q_id);
+    return Status::INVALID_PARAMETER;
+  }
+
+  const auto num_pkts = burst->hdr.hdr.num_pkts;
+  if (num_pkts > max_tx_batch_) {
+    HOLOSCAN_LOG_ERROR("Burst of {} packets is larger than the TX batch size {}",
+                       num_pkts,
+                       max_tx_batch_);
+    return Status::INVALID_PARAMETER;
+  }
+  if (tx_buffers_available(*q) < num_pkts) { return Status::NO_FREE_PACKET_BUFFERS; }
+
+  for (size_t i = 0; i < num_pkts; i++) {
+    const size_t slot = (q->next + i) % q->num_bufs;
+    burst->pkts[0][i] = q->bufs + slot * q->buf_size;
+    burst->pkt_lens[0][i] = 0;
+  }
+  burst->hdr.hdr.nbytes = 0;
+  q->next += num_pkts;
+
+  return Status::SUCCESS;
+}
+
+Status RdmaMgr::send_tx_burst(BurstParams* burst) {
+  auto q = find_queue(generate_queue_key(burst->hdr.hdr.port_id, burst->hdr.hdr.q_id),
+                      Direction::TX);
+  if (q == nullptr) {
+    HOLOSCAN_LOG_ERROR("Invalid port/queue combination in send_tx_burst: {}/{}",
+                       burst->hdr.hdr.port_id,
+                       burst->hdr.hdr.q_id);
+    return Status::INVALID_PARAMETER;
+  }
+
+  const auto num_pkts = burst->hdr.hdr.num_pkts;
+  if (num_pkts == 0) {
+    free_tx_metadata(burst);
+    return Status::SUCCESS;
+  }
+  if (num_pkts > q->send_wrs.size()) {
+    q->send_wrs.resize(num_pkts);
+    q->sges.resize(num_pkts);
+  }
+
+  // One chain of writes per burst, only the last one signaled
+  uint64_t nbytes = 0;
+  for (size_t i = 0; i < num_pkts; i++) {
+    const uint32_t len = burst->pkt_lens[0][i];
+    if (len > q->remote_buf_size) {
+      HOLOSCAN_LOG_ERROR("Packet of {} bytes is larger than the {} byte buffers of the peer",
+                         len,
+                         q->remote_buf_size);
+      return Status::INVALID_PARAMETER;
+    }
+
+    const uint32_t remote_slot = (q->posted + i) % q->remote_num_bufs;
+    q->sges[i] = {reinterpret_cast<uint64_t>(burst->pkts[0][i]), len, q->mr->lkey};
+    auto& wr = q->send_wrs[i];
+    wr = {};
+    wr.wr_id = q->posted + i + 1;
+    wr.sg_list = &q->sges[i];
+    wr.num_sge = 1;
+    wr.opcode = IBV_WR_RDMA_WRITE_WITH_IMM;
+    wr.imm_data = htonl(remote_slot);
+    wr.send_flags = (i + 1 == num_pkts) ? IBV_SEND_SIGNALED : 0;
+    wr.wr.rdma.remote_addr = q->remote_addr + static_cast<uint64_t>(remote_slot) *
+                                                  q->remote_buf_size;
+    wr.wr.rdma.rkey = q->remote_rkey;
+    wr.next = (i + 1 < num_pkts) ? &q->send_wrs[i + 1] : nullptr;
+    nbytes += len;
+  }
+
+  struct ibv_send_wr* bad_wr = nullptr;
+  if (ibv_post_send(q->qp, q->send_wrs.data(), &bad_wr) != 0) {
+    q->errors++;
+    HOLOSCAN_LOG_ERROR("Failed to post {} writes on TX queue {}: {}",
+                       num_pkts,
+                       q->q_id,
+                       strerror(errno));
+    return Status::INTERNAL_ERROR;
+  }
+
+  q->posted += num_pkts;
+  q->pkts.fetch_add(num_pkts, std::memory_order_relaxed);
+  q->bytes.fetch_add(nbytes, std::memory_order_relaxed);
+  free_tx_metadata(burst);
+  return Status::SUCCESS;
+}
+
+void RdmaMgr::free_tx_burst(BurstParams* burst) {
+  // Buffers are handed out in ring order, only the latest burst can give its buffers back
+  auto q = find_queue(generate_queue_key(burst->hdr.hdr.port_id, burst->hdr.hdr.q_id),
+                      Direction::TX);
+  if (q == nullptr || burst->hdr.hdr.num_pkts == 0) { return; }
+
+  if (q->next - q->posted == burst->hdr.hdr.num_pkts) {
+    q->next = q->posted;
+  } else {
+    HOLOSCAN_LOG_WARN("TX queue {} burst freed out of order, send or free bursts in the order "
+                      "they were allocated", q->q_id);
+  }
+}
+
+void RdmaMgr::free_tx_metadata(BurstParams* burst) {
+  std::lock_guard<std::mutex> lock(tx_burst_mutex_);
+  tx_free_bursts_.push_back(burst);
+}
+
+Status RdmaMgr::get_tx_metadata_buffer(BurstParams** burst) {
+  std::lock_guard<std::mutex> lock(tx_burst_mutex_);
+  if (tx_free_bursts_.empty()) {
+    HOLOSCAN_LOG_CRITICAL("Failed to get TX meta descriptor");
+    return Status::NO_FREE_BURST_BUFFERS;
+  }
+  *burst = tx_free_bursts_.back();
+  tx_free_bursts_.pop_back();
+  return Status::SUCCESS;
+}
+
+BurstParams* RdmaMgr::create_tx_burst_params() {
+  BurstParams* burst = nullptr;
+  if (get_tx_metadata_buffer(&burst) != Status::SUCCESS) { return nullptr; }
+  return burst;
+}
+
+void* RdmaMgr::get_packet_ptr(BurstParams* burst, int idx) {
+  return burst->pkts[0][idx];
+}
+
+void* RdmaMgr::get_segment_packet_ptr(BurstParams* burst, int seg, int idx) {
+  return seg == 0 ? get_packet_ptr(burst, idx) : nullptr;
+}
+
+uint16_t RdmaMgr::get_packet_length(BurstParams* burst, int idx) {
+  return burst->pkt_lens[0][idx];
+}
+
+uint16_t RdmaMgr::get_segment_packet_length(BurstParams* burst, int seg, int idx) {
+  return seg == 0 ? get_packet_length(burst, idx) : 0;
+}
+
+uint16_t RdmaMgr::get_packet_flow_id(BurstParams* burst, int idx) {
+  return 0;
+}
+
+void* RdmaMgr::get_packet_extra_info(BurstParams* burst, int idx) {
+  return nullptr;
+}
+
+uint64_t RdmaMgr::get_burst_tot_byte(BurstParams* burst) {
+  return burst->hdr.hdr.nbytes;
+}
+
+Status RdmaMgr::set_packet_lengths(BurstParams* burst, int idx,
+                                   const std::initializer_list<int>& lens) {
+  if (lens.size() != 1) {
+    HOLOSCAN_LOG_ERROR("RDMA packets have a single segment");
+    return Status::INVALID_PARAMETER;
+  }
+  burst->pkt_lens[0][idx] = *lens.begin();
+  burst->hdr.hdr.nbytes += *lens.begin();
+  return Status::SUCCESS;
+}
+
+Status RdmaMgr::set_udp_payload(BurstParams* burst, int idx, void* data, int len) {
+  // Buffers may be in GPU or host memory
+  if (cudaMemcpy(burst->pkts[0][idx], data, len, cudaMemcpyDefault) != cudaSuccess) {
+    return Status::INTERNAL_ERROR;
+  }
+  return Status::SUCCESS;
+}
+
+// Packets are written directly into the buffers of the peer, there are no network headers
+Status RdmaMgr::set_eth_header(BurstParams* burst, int idx, char* dst_addr) {
+  return Status::NOT_SUPPORTED;
+}
+
+Status RdmaMgr::set_ipv4_header(BurstParams* burst, int idx, int ip_len, uint8_t proto,
+                                unsigned int src_host, unsigned int dst_host) {
+  return Status::NOT_SUPPORTED;
+}
+
+Status RdmaMgr::set_udp_header(BurstParams* burst, int idx, int udp_len, uint16_t src_port,
+                               uint16_t dst_port) {
+  return Status::NOT_SUPPORTED;
+}
+
+Status RdmaMgr::set_packet_tx_time(BurstParams* burst, int idx, uint64_t timestamp) {
+  return Status::NOT_SUPPORTED;
+}
+
+Status RdmaMgr::get_mac_addr(int port, char* mac) {
+  return Status::NOT_SUPPORTED;
+}
+
+Status RdmaMgr::get_stats(ManagerStats& stats) {
+  stats = {};
+  stats.timestamp_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                           std::chrono::system_clock::now().time_since_epoch())
+                           .count();
+
+  for (auto* map : {&rx_queues_, &tx_queues_}) {
+    for (const auto& [key, q] : *map) {
+      QueueStats qs;
+      qs.port_id = q->port_id;
+      qs.q_id = q->q_id;
+      qs.dir = q->dir;
+      qs.packets = q->pkts.load(std::memory_order_relaxed);
+      qs.bytes = q->bytes.load(std::memory_order_relaxed);
+      qs.drops = q->errors.load(std::memory_order_relaxed);
+      stats.queues.push_back(qs);
+    }
+  }
+
+  return Status::SUCCESS;
+}
+
+void RdmaMgr::print_stats() {
+  HOLOSCAN_LOG_INFO("advanced_network RDMA manager stats");
+  for (auto* map : {&rx_queues_, &tx_queues_}) {
+    for (const auto& [key, q] : *map) {
+      HOLOSCAN_LOG_INFO("Port {} {} queue {}: {} packets, {} bytes, {} errors",
+                        q->port_id,
+                        q->dir == Direction::RX ? "RX" : "TX",
+                        q->q_id,
+                        q->pkts.load(),
+                        q->bytes.load(),
+                        q->errors.load());
+    }
+  }
+}
+
+void RdmaMgr::release_queue(RdmaQueue& q) {
+  // Also called on a partly created queue, so every resource may be missing
+  if (q.qp != nullptr) { ibv_destroy_qp(q.qp); }
+  if (q.cq != nullptr) { ibv_destroy_cq(q.cq); }
+  if (q.credit_cq != nullptr) { ibv_destroy_cq(q.credit_cq); }
+  if (q.credits_mr != nullptr) { ibv_dereg_mr(q.credits_mr); }
+  free(const_cast<uint64_t*>(q.credits));
+  q.qp = nullptr;
+  q.cq = nullptr;
+  q.credit_cq = nullptr;
+  q.credits_mr = nullptr;
+  q.credits = nullptr;
+}
+
+void RdmaMgr::shutdown() {
+  for (auto* map : {&rx_queues_, &tx_queues_}) {
+    for (auto& [key, q] : *map) { release_queue(*q); }
+    map->clear();
+  }
+
+  for (auto& [name, mr] : mrs_) { ibv_dereg_mr(mr); }
+  mrs_.clear();
+
+  for (auto& [name, region] : ar_) {
+    if (region.ptr_ == nullptr) { continue; }
+    switch (cfg_.mrs_.at(name).kind_) {
+      case MemoryKind::HOST:
+        free(region.ptr_);
+        break;
+      case MemoryKind::HOST_PINNED:
+        cudaFreeHost(region.ptr_);
+        break;
+      case MemoryKind::DEVICE:
+        cudaFree(region.ptr_);
+        break;
+      default:
+        break;
+    }
+  }
+  ar_.clear();
+
+  for (auto& port : ports_) {
+    if (port.pd != nullptr) { ibv_dealloc_pd(port.pd); }
+    if (port.ctx != nullptr) { ibv_close_device(port.ctx); }
+  }
+  ports_.clear();
+
+  tx_free_bursts_.clear();
+  bursts_.clear();
+  burst_pkts_.clear();
+  burst_lens_.clear();
+  initialized_ = false;
+}
+
+};  // namespace holoscan::advanced_network
@@ -0,0 +1,177 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <infiniband/verbs.h>
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "advanced_network/manager.h"
+
+namespace holoscan::advanced_network {
+
+/**
+ * @brief Reliable connected queue pair of one RX or TX queue
+ *
+ * TX queue N writes its packets with RDMA WRITE-with-immediate into the buffers of RX queue N of
+ * the peer, in ring order. The RX queue returns the number of buffers freed by the application
+ * to a credit counter of the TX queue with an RDMA WRITE, so that the TX queue never overwrites
+ * a buffer that is still in use.
+ */
+struct RdmaQueue {
+  uint16_t port_id = 0;
+  uint16_t q_id = 0;
+  Direction dir = Direction::RX;
+  uint32_t batch_size = 0;
+  uint64_t timeout_us = 0;
+
+  struct ibv_cq* cq = nullptr;         // TX completions, or RX write-with-immediate completions
+  struct ibv_cq* credit_cq = nullptr;  // RX only, completions of the credit writes
+  struct ibv_qp* qp = nullptr;
+  struct ibv_mr* mr = nullptr;  // Packet buffers of the queue
+  char* bufs = nullptr;
+  size_t buf_size = 0;  // Stride between packet buffers
+  uint32_t num_bufs = 0;
+  uint32_t psn = 0;
+
+  // RX: buffers freed, written to the peer. TX: buffers freed by the peer, written by the peer
+  volatile uint64_t* credits = nullptr;
+  struct ibv_mr* credits_mr = nullptr;
+
+  // TX: packet buffers of the peer RX queue. RX: credit counter of the peer TX queue
+  uint64_t remote_addr = 0;
+  uint32_t remote_rkey = 0;
+  size_t remote_buf_size = 0;
+  uint32_t remote_num_bufs = 0;
+
+  uint64_t next = 0;       // TX: buffers handed out. RX: buffers received
+  uint64_t posted = 0;     // TX: buffers posted to the QP
+  uint64_t completed = 0;  // TX: buffers read by the NIC. RX: buffers freed by the application
+  uint32_t credit_writes = 0;
+
+  BurstParams* pending = nullptr;  // RX burst being filled
+  uint64_t pending_start_ns = 0;
+  std::vector<BurstParams*> free_bursts;  // RX burst metadata
+  std::mutex rx_mutex;  // Free bursts and credits, also used by the threads freeing bursts
+  std::vector<struct ibv_wc> wcs;
+  std::vector<struct ibv_recv_wr> recv_wrs;
+  std::vector<struct ibv_send_wr> send_wrs;
+  std::vector<struct ibv_sge> sges;
+
+  std::atomic<uint64_t> pkts{0};
+  std::atomic<uint64_t> bytes{0};
+  std::atomic<uint64_t> errors{0};
+};
+
+/**
+ * @brief Device context, protection domain and queues of one interface
+ */
+struct RdmaPort {
+  struct ibv_context* ctx = nullptr;
+  struct ibv_pd* pd = nullptr;
+  uint8_t ib_port = 1;
+  enum ibv_mtu mtu = IBV_MTU_4096;
+  union ibv_gid gid;
+};
+
+class RdmaMgr : public Manager {
+ public:
+  RdmaMgr() = default;
+  ~RdmaMgr();
+  bool set_config_and_initialize(const NetworkConfig& cfg) override;
+  void initialize() override;
+  void run() override;
+
+  void* get_segment_packet_ptr(BurstParams* burst, int seg, int idx) override;
+  void* get_packet_ptr(BurstParams* burst, int idx) override;
+  uint16_t get_segment_packet_length(BurstParams* burst, int seg, int idx) override;
+  uint16_t get_packet_length(BurstParams* burst, int idx) override;
+  uint16_t get_packet_flow_id(BurstParams* burst, int idx) override;
+  void* get_packet_extra_info(BurstParams* burst, int idx) override;
+  Status get_tx_packet_burst(BurstParams* burst) override;
+  Status set_eth_header(BurstParams* burst, int idx, char* dst_addr) override;
+  Status set_ipv4_header(BurstParams* burst, int idx, int ip_len, uint8_t proto,
+                         unsigned int src_host, unsigned int dst_host) override;
+  Status set_udp_header(BurstParams* burst, int idx, int udp_len, uint16_t src_port,
+                        uint16_t dst_port) override;
+  Status set_udp_payload(BurstParams* burst, int idx, void* data, int len) override;
+  bool is_tx_burst_available(BurstParams* burst) override;
+
+  Status set_packet_lengths(BurstParams* burst, int idx,
+                            const std::initializer_list<int>& lens) override;
+  void free_all_segment_packets(BurstParams* burst, int seg) override;
+  void free_all_packets(BurstParams* burst) override;
+  void free_packet_segment(BurstParams* burst, int seg, int pkt) override {}
+  void free_packet(BurstParams* burst, int pkt) override {}
+  void free_rx_burst(BurstParams* burst) override;
+  void free_tx_burst(BurstParams* burst) override;
+
+  Status get_rx_burst(BurstParams** burst, int port, int q) override;
+  using holoscan::advanced_network::Manager::get_rx_burst;  // for overloads
+  Status set_packet_tx_time(BurstParams* burst, int idx, uint64_t timestamp) override;
+  void free_rx_metadata(BurstParams* burst) override;
+  void free_tx_metadata(BurstParams* burst) override;
+  Status get_tx_metadata_buffer(BurstParams** burst) override;
+  Status send_tx_burst(BurstParams* burst) override;
+  Status get_mac_addr(int port, char* mac) override;
+  void shutdown() override;
+  void print_stats() override;
+  uint64_t get_burst_tot_byte(BurstParams* burst) override;
+  BurstParams* create_tx_burst_params() override;
+  bool validate_config() const override;
+  Status get_stats(ManagerStats& stats) override;
+
+ protected:
+  Status allocate_memory_regions() override;
+  void adjust_memory_regions() override;
+
+ private:
+  static constexpr int NUM_RX_BURSTS = 64;
+  static constexpr int NUM_TX_BURSTS = 256;
+  static constexpr uint32_t CREDIT_SIGNAL_INTERVAL = 32;
+  static constexpr uint32_t CREDIT_QUEUE_DEPTH = 4 * CREDIT_SIGNAL_INTERVAL;
+
+  int open_port(const InterfaceConfig& intf);
+  struct ibv_mr* register_memory(struct ibv_pd* pd, const std::string& mr_name, int access);
+  int create_queue(const InterfaceConfig& intf, RdmaQueue& q, const std::string& mr_name);
+  void release_queue(RdmaQueue& q);
+  int connect_queues(const InterfaceConfig& intf);
+  int poll_tx_completions(RdmaQueue& q);
+  void post_credits(RdmaQueue& q);
+  BurstParams* create_burst(uint32_t max_pkts);
+  RdmaQueue* find_queue(uint32_t key, Direction dir);
+  uint32_t tx_buffers_available(RdmaQueue& q);
+
+  std::vector<RdmaPort> ports_;
+  std::unordered_map<uint32_t, std::unique_ptr<RdmaQueue>> rx_queues_;
+  std::unordered_map<uint32_t, std::unique_ptr<RdmaQueue>> tx_queues_;
+  std::unordered_map<std::string, struct ibv_mr*> mrs_;
+  std::vector<std::unique_ptr<BurstParams>> bursts_;
+  std::vector<std::unique_ptr<void*[]>> burst_pkts_;
+  std::vector<std::unique_ptr<uint32_t[]>> burst_lens_;
+  std::vector<BurstParams*> tx_free_bursts_;
+  std::mutex tx_burst_mutex_;
+  uint32_t max_tx_batch_ = 0;
+};
+
+};  // namespace holoscan::advanced_network
@@ -57,10 +57,12 @@ class RmaxMgr : public Manager {
   void free_packet_segment(BurstParams* burst, int seg, int pkt) override;
   void free_packet(BurstParams* burst, int pkt) override;
   void free_rx_burst(BurstParams* burst) override;
+  void free_rx_bursts(BurstParams** bursts, int num_bursts) override;
   void free_tx_burst(BurstParams* burst) override;
 
   Status get_rx_burst(BurstParams** burst, int port, int q) override;
   using holoscan::advanced_network::Manager::get_rx_burst;  // for overloads
+  int get_rx_bursts(BurstParams** bursts, int max_bursts, int port, int q) override;
   Status set_packet_tx_time(BurstParams* burst, int idx, uint64_t timestamp);
   void free_rx_metadata(BurstParams* burst) override;
   void free_tx_metadata(BurstParams* burst) override;
@@ -71,6 +73,8 @@ class RmaxMgr : public Manager {
   uint64_t get_burst_tot_byte(BurstParams* burst) override;
   BurstParams* create_tx_burst_params() override;
   Status get_mac_addr(int port, char* mac) override;
+  Status get_burst_frame_info(BurstParams* burst, BurstFrameInfo* info) override;
+  Status get_stats(ManagerStats& stats) override;
 
  private:
   class RmaxMgrImpl;
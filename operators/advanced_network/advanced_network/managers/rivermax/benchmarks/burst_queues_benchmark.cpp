@@ -0,0 +1,140 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2023 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * Micro benchmark of the burst queues used by the Rivermax manager.
+ *
+ * Mimics the RX data path: a receiver thread takes a burst from the pool and pushes it to
+ * the output queue, an operator thread takes it from the output queue and returns it to the
+ * pool. Each burst carries its enqueue timestamp so the hand-off latency can be measured.
+ *
+ * Usage: burst_queues_benchmark [num_bursts] [pool_size]
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "rmax_mgr_impl/burst_queues.h"
+
+using namespace holoscan::advanced_network;
+
+namespace {
+
+struct BenchBurst {
+  std::chrono::steady_clock::time_point enqueue_time;
+};
+
+using BurstPtr = std::shared_ptr<BenchBurst>;
+
+struct BenchResult {
+  double mbursts_per_sec;
+  double p50_ns;
+  double p99_ns;
+  double p999_ns;
+};
+
+double percentile(std::vector<int64_t>& samples, double pct) {
+  size_t idx = static_cast<size_t>(pct / 100.0 * (samples.size() - 1));
+  std::nth_element(samples.begin(), samples.begin() + idx, samples.end());
+  return static_cast<double>(samples[idx]);
+}
+
+BenchResult run_benchmark(QueueInterface<BurstPtr>& pool, QueueInterface<BurstPtr>& out_queue,
+                          size_t pool_size, size_t num_bursts) {
+  for (size_t i = 0; i < pool_size; i++) { pool.enqueue(std::make_shared<BenchBurst>()); }
+
+  std::vector<int64_t> latencies(num_bursts);
+  std::atomic<bool> start{false};
+
+  std::thread receiver([&]() {
+    while (!start.load(std::memory_order_acquire)) { std::this_thread::yield(); }
+    BurstPtr burst;
+    for (size_t i = 0; i < num_bursts; i++) {
+      while (!pool.try_dequeue(burst)) { std::this_thread::yield(); }
+      burst->enqueue_time = std::chrono::steady_clock::now();
+      while (!out_queue.enqueue(burst)) { std::this_thread::yield(); }
+    }
+  });
+
+  std::thread consumer([&]() {
+    while (!start.load(std::memory_order_acquire)) { std::this_thread::yield(); }
+    BurstPtr burst;
+    for (size_t i = 0; i < num_bursts; i++) {
+      while (!out_queue.try_dequeue(burst)) { std::this_thread::yield(); }
+      latencies[i] = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                         std::chrono::steady_clock::now() - burst->enqueue_time)
+                         .count();
+      pool.enqueue(burst);
+    }
+  });
+
+  auto begin = std::chrono::steady_clock::now();
+  start.store(true, std::memory_order_release);
+  receiver.join();
+  consumer.join();
+  auto elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+
+  pool.clear();
+  out_queue.clear();
+
+  BenchResult result;
+  result.mbursts_per_sec = num_bursts / elapsed / 1e6;
+  result.p50_ns = percentile(latencies, 50.0);
+  result.p99_ns = percentile(latencies, 99.0);
+  result.p999_ns = percentile(latencies, 99.9);
+  return result;
+}
+
+void print_result(const std::string& name, const BenchResult& result) {
+  std::cout << name << ": " << result.mbursts_per_sec << " Mbursts/s, latency p50 "
+            << result.p50_ns << " ns, p99 " << result.p99_ns << " ns, p99.9 " << result.p999_ns
+            << " ns" << std::endl;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  size_t num_bursts = (argc > 1) ? std::strtoull(argv[1], nullptr, 10) : 10000000;
+  size_t pool_size = (argc > 2) ? std::strtoull(argv[2], nullptr, 10) : 64;
+  if (num_bursts == 0 || pool_size == 0) {
+    std::cerr << "Usage: " << argv[0] << " [num_bursts] [pool_size]" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  std::cout << "Bursts: " << num_bursts << ", pool size: " << pool_size << std::endl;
+
+  {
+    NonBlockingQueue<BurstPtr> pool;
+    NonBlockingQueue<BurstPtr> out_queue;
+    print_result("Mutex queue    ", run_benchmark(pool, out_queue, pool_size, num_bursts));
+  }
+  {
+    LockFreeQueue<BurstPtr> pool(pool_size);
+    LockFreeQueue<BurstPtr> out_queue(pool_size);
+    print_result("Lock-free queue", run_benchmark(pool, out_queue, pool_size, num_bursts));
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -27,8 +27,8 @@ class RmaxBurst;
 class IAnoBurstsCollection {
  public:
   virtual ~IAnoBurstsCollection() = default;
-  virtual bool enqueue_burst(std::shared_ptr<RmaxBurst> burst) = 0;
-  virtual std::shared_ptr<RmaxBurst> dequeue_burst() = 0;
+  virtual bool enqueue_burst(RmaxBurst* burst) = 0;
+  virtual RmaxBurst* dequeue_burst() = 0;
   virtual size_t available_bursts() = 0;
   virtual bool empty() = 0;
 };
@@ -53,8 +53,9 @@ class QueueInterface {
    * @brief Enqueues a value into the queue.
    *
    * @param value The value to enqueue.
+   * @return True if the value was enqueued, false if the queue is full.
    */
-  virtual void enqueue(const T& value) = 0;
+  virtual bool enqueue(const T& value) = 0;
 
   /**
    * @brief Tries to dequeue a value from the queue.
@@ -99,9 +100,12 @@ class AnoBurstsQueue : public IAnoBurstsCollection {
   /**
    * @brief Constructor for the AnoBurstsQueue class.
    *
-   * Initializes the AnoBurstsQueue instance.
+   * Initializes the AnoBurstsQueue instance. The lock-free queue is bounded, so it is sized
+   * to the burst pools feeding it and can't fill up as long as no burst is queued twice.
+   *
+   * @param capacity Maximal number of bursts the queue can hold when it is bounded.
    */
-  AnoBurstsQueue();
+  explicit AnoBurstsQueue(size_t capacity);
 
   /**
    * @brief Virtual destructor for the AnoBurstsQueue class.
@@ -114,14 +118,17 @@ class AnoBurstsQueue : public IAnoBurstsCollection {
    * @param burst The burst to put into the queue.
    * @return True if the burst was successfully put into the queue, false otherwise.
    */
-  bool enqueue_burst(std::shared_ptr<RmaxBurst> burst) override;
+  bool enqueue_burst(RmaxBurst* burst) override;
 
   /**
    * @brief Dequeues a burst from the queue.
    *
-   * @return A shared pointer to the burst.
+   * With USE_BLOCKING_QUEUE it waits up to GET_BURST_TIMEOUT_MS for a burst, otherwise it
+   * returns right away.
+   *
+   * @return A pointer to the burst, owned by the burst pool it comes from, or nullptr.
    */
-  std::shared_ptr<RmaxBurst> dequeue_burst() override;
+  RmaxBurst* dequeue_burst() override;
 
   /**
    * @brief Gets the number of available bursts in the queue.
@@ -137,20 +144,52 @@ class AnoBurstsQueue : public IAnoBurstsCollection {
    */
   bool empty() override { return m_queue->get_size() == 0; };
 
+  /**
+   * @brief Gets the maximal number of bursts the queue holds when it is bounded.
+   *
+   * @return The capacity of the queue.
+   */
+  size_t get_capacity() const { return m_capacity; }
+
   /**
    * @brief Clears the queue.
    */
   void clear();
 
  private:
-  std::unique_ptr<QueueInterface<std::shared_ptr<RmaxBurst>>> m_queue;
+  std::unique_ptr<QueueInterface<RmaxBurst*>> m_queue;
+  size_t m_capacity;
 };
 
 enum BurstFlags : uint8_t {
   FLAGS_NONE = 0,
   INFO_PER_PACKET = 1,
+  FRAME_ALIGNED = 2,
 };
 
+/**
+ * @brief How the RX burst manager decides where a burst ends
+ *
+ * PACKETS:       After batch_size packets (default)
+ * RTP_MARKER:    On a packet with the RTP marker bit set, or when the RTP timestamp changes
+ *                in case the marker packet was lost (SMPTE 2110 and RTP video streams)
+ * FRAME_PACKETS: Every frame_packets sequence numbers, counting lost packets (e.g. radar CPIs)
+ */
+enum class RxBurstCutMode { PACKETS, RTP_MARKER, FRAME_PACKETS };
+
+inline bool rx_burst_cut_mode_from_string(const std::string& str, RxBurstCutMode& mode) {
+  if (str == "packets") {
+    mode = RxBurstCutMode::PACKETS;
+  } else if (str == "rtp_marker") {
+    mode = RxBurstCutMode::RTP_MARKER;
+  } else if (str == "frame_packets") {
+    mode = RxBurstCutMode::FRAME_PACKETS;
+  } else {
+    return false;
+  }
+  return true;
+}
+
 struct AnoBurstExtendedInfo {
   uint32_t tag;
   BurstFlags burst_flags;
@@ -162,6 +201,7 @@ struct AnoBurstExtendedInfo {
   bool payload_on_cpu;
   uint16_t header_seg_idx;
   uint16_t payload_seg_idx;
+  BurstFrameInfo frame;  // Valid with FRAME_ALIGNED
 };
 
 struct RmaxPacketExtendedInfo {
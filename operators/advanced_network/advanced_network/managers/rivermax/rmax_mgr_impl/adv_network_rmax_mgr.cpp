@@ -28,6 +28,10 @@
 #include <vector>
 #include <tuple>
 #include <cassert>
+#include <cctype>
+#include <cstdlib>
+#include <cstring>
+#include <dirent.h>
 
 #include "adv_network_rmax_mgr.h"
 #include "rmax_mgr_impl/rmax_config_manager.h"
@@ -36,6 +40,7 @@
 #include "rmax_mgr_impl/rmax_chunk_consumer_ano.h"
 #include "rmax_mgr_impl/stats_printer.h"
 #include "rmax_ipo_receiver_service.h"
+#include "rmax_generic_sender_service.h"
 #include <holoscan/logger/logger.hpp>
 #include "rt_threads.h"
 
@@ -44,6 +49,7 @@ using namespace std::chrono;
 namespace holoscan::advanced_network {
 
 using namespace ral::services::rmax_ipo_receiver;
+using namespace ral::services::rmax_generic_sender;
 
 /**
  * A map of log level to a tuple of the description and command strings.
@@ -73,6 +79,32 @@ const std::unordered_map<LogLevel::Level, RmaxLogLevel::Level>
         {LogLevel::OFF, OFF},
 };
 
+namespace {
+
+/**
+ * @brief Gets the NUMA node of a CPU core from sysfs.
+ *
+ * @param core The CPU core, negative if unset.
+ * @return The NUMA node, or -1 if it is not known.
+ */
+int cpu_numa_node(int core) {
+  if (core < 0) { return -1; }
+  const std::string path = "/sys/devices/system/cpu/cpu" + std::to_string(core);
+  DIR* dir = opendir(path.c_str());
+  if (dir == nullptr) { return -1; }
+  int node = -1;
+  while (struct dirent* entry = readdir(dir)) {
+    if (std::strncmp(entry->d_name, "node", 4) == 0 && std::isdigit(entry->d_name[4])) {
+      node = std::atoi(entry->d_name + 4);
+      break;
+    }
+  }
+  closedir(dir);
+  return node;
+}
+
+}  // namespace
+
 /**
  * @brief Implementation class for RmaxMgr.
  *
@@ -108,9 +140,11 @@ class RmaxMgr::RmaxMgrImpl {
   void free_packet_segment(BurstParams* burst, int seg, int pkt);
   void free_packet(BurstParams* burst, int pkt);
   void free_rx_burst(BurstParams* burst);
+  void free_rx_bursts(BurstParams** bursts, int num_bursts);
   void free_tx_burst(BurstParams* burst);
   void format_eth_addr(char* dst, std::string addr);
   Status get_rx_burst(BurstParams** burst, int port, int q);
+  int get_rx_bursts(BurstParams** bursts, int max_bursts, int port, int q);
   Status set_packet_tx_time(BurstParams* burst, int idx, uint64_t timestamp);
   void free_rx_metadata(BurstParams* burst);
   void free_tx_metadata(BurstParams* burst);
@@ -118,6 +152,7 @@ class RmaxMgr::RmaxMgrImpl {
   Status send_tx_burst(BurstParams* burst);
   void shutdown();
   void print_stats();
+  Status get_stats(ManagerStats& stats);
   uint64_t get_burst_tot_byte(BurstParams* burst);
   BurstParams* create_tx_burst_params();
   Status get_mac_addr(int port, char* mac);
@@ -127,6 +162,8 @@ class RmaxMgr::RmaxMgrImpl {
   void setup_accurate_send_scheduling_mask();
   int setup_pools_and_rings(int max_rx_batch, int max_tx_batch);
   void initialize_rx_service(uint32_t service_id, const ExtRmaxIPOReceiverConfig& config);
+  void initialize_tx_service(uint32_t service_id, const RmaxGenericSenderConfig& config);
+  std::shared_ptr<TxBurstsManager> get_tx_burst_manager(BurstParams* burst);
 
  private:
   static constexpr int DEFAULT_NUM_RX_BURST = 64;
@@ -140,6 +177,8 @@ class RmaxMgr::RmaxMgrImpl {
   std::unordered_map<uint32_t, std::shared_ptr<RxPacketProcessor>> rx_packet_processors;
   std::unordered_map<uint32_t, std::shared_ptr<AnoBurstsQueue>> rx_bursts_out_queues_map_;
   std::vector<std::thread> rx_service_threads;
+  std::unordered_map<uint32_t, std::shared_ptr<RmaxGenericSenderService>> tx_services;
+  std::unordered_map<uint32_t, std::shared_ptr<TxBurstsManager>> tx_burst_managers;
   bool initialized_ = false;
   std::shared_ptr<ral::lib::RmaxAppsLibFacade> rmax_apps_lib = nullptr;
 };
@@ -214,6 +253,15 @@ void RmaxMgr::RmaxMgrImpl::initialize() {
     }
   }
 
+  auto tx_config_manager = std::dynamic_pointer_cast<TxConfigManager>(
+      config_manager.get_config_manager(RmaxConfigContainer::ConfigType::TX));
+
+  if (tx_config_manager) {
+    for (const auto& config : *tx_config_manager) {
+      initialize_tx_service(config.first, config.second);
+    }
+  }
+
   this->initialized_ = true;
 }
 
@@ -239,16 +287,23 @@ void RmaxMgr::RmaxMgrImpl::initialize_rx_service(uint32_t service_id,
   }
 
   // Create a dedicated queue for this service_id
-  auto queue = std::make_shared<AnoBurstsQueue>();
+  auto queue = std::make_shared<AnoBurstsQueue>(RxBurstsManager::DEFAULT_NUM_RX_BURSTS);
   rx_bursts_out_queues_map_[service_id] = queue;
 
+  // The receiver thread runs on the first application core and fills the bursts
+  const auto& cores = config.app_settings->app_threads_cores;
+  const int numa_node = cores.empty() ? -1 : cpu_numa_node(cores[0]);
+
   rx_services[service_id] = std::move(rx_service);
   rx_burst_managers[service_id] = std::make_shared<RxBurstsManager>(config.send_packet_ext_info,
                                                                     port_id,
                                                                     queue_id,
                                                                     config.max_chunk_size,
                                                                     config.app_settings->gpu_id,
-                                                                    queue);
+                                                                    queue,
+                                                                    numa_node);
+  rx_burst_managers[service_id]->set_burst_cut_mode(
+      config.burst_cut_mode, config.frame_packets, config.is_extended_sequence_number);
 
   rx_packet_processors[service_id] =
       std::make_shared<RxPacketProcessor>(rx_burst_managers[service_id]);
@@ -259,6 +314,50 @@ void RmaxMgr::RmaxMgrImpl::initialize_rx_service(uint32_t service_id,
   rx_services[service_id]->set_chunk_consumer(rmax_chunk_consumers[service_id].get());
 }
 
+/**
+ * @brief Initializes a TX service with the given configuration.
+ *
+ * This method creates a Rivermax generic sender service based on the provided configuration
+ * and the TX burst manager that maps advanced_network bursts onto the service memory.
+ *
+ * @param service_id The unique service id identifying the TX service.
+ * @param config The configuration for the TX service.
+ */
+void RmaxMgr::RmaxMgrImpl::initialize_tx_service(uint32_t service_id,
+                                                 const RmaxGenericSenderConfig& config) {
+  uint16_t port_id = RmaxBurst::burst_port_id_from_burst_tag(service_id);
+  uint16_t queue_id = RmaxBurst::burst_queue_id_from_burst_tag(service_id);
+
+  auto tx_service = std::make_shared<RmaxGenericSenderService>(config);
+  auto init_status = tx_service->get_init_status();
+  if (init_status != ReturnStatus::obj_init_success) {
+    HOLOSCAN_LOG_ERROR("Failed to initialize TX service, status: {}", (int)init_status);
+    return;
+  }
+
+  tx_services[service_id] = tx_service;
+  tx_burst_managers[service_id] = std::make_shared<TxBurstsManager>(port_id, queue_id, tx_service);
+}
+
+/**
+ * @brief Gets the TX burst manager of the burst's port and queue.
+ *
+ * @param burst The burst parameters.
+ * @return Shared pointer to the TX burst manager, or nullptr if the queue is not configured.
+ */
+std::shared_ptr<TxBurstsManager> RmaxMgr::RmaxMgrImpl::get_tx_burst_manager(BurstParams* burst) {
+  uint32_t key =
+      RmaxBurst::burst_tag_from_port_and_queue_id(burst->hdr.hdr.port_id, burst->hdr.hdr.q_id);
+  auto it = tx_burst_managers.find(key);
+  if (it == tx_burst_managers.end()) {
+    HOLOSCAN_LOG_ERROR("No Tx queue found for Rivermax service (port {}, queue {}). Check config.",
+                       burst->hdr.hdr.port_id,
+                       burst->hdr.hdr.q_id);
+    return nullptr;
+  }
+  return it->second;
+}
+
 /**
  * @brief Destructor for RmaxMgrImpl.
  *
@@ -274,6 +373,10 @@ RmaxMgr::RmaxMgrImpl::~RmaxMgrImpl() {
   }
   rx_services.clear();
 
+  tx_burst_managers.clear();
+
+  tx_services.clear();
+
   rx_burst_managers.clear();
 
   rx_packet_processors.clear();
@@ -352,6 +455,17 @@ class RmaxServicesSynchronizer : public IRmaxServicesSynchronizer {
  * is properly initialized before running.
  */
 void RmaxMgr::RmaxMgrImpl::run() {
+  HOLOSCAN_LOG_INFO("Starting TX Services");
+
+  for (const auto& [service_id, tx_service] : tx_services) {
+    ReturnStatus status = tx_service->run();
+    if (status != ReturnStatus::success) {
+      HOLOSCAN_LOG_ERROR("Tx Service (port {}, queue {}) failed to start",
+                         RmaxBurst::burst_port_id_from_burst_tag(service_id),
+                         RmaxBurst::burst_queue_id_from_burst_tag(service_id));
+    }
+  }
+
   HOLOSCAN_LOG_INFO("Starting RX Services");
 
   std::size_t num_services = rx_services.size();
@@ -463,12 +577,18 @@ Status RmaxMgr::RmaxMgrImpl::set_packet_tx_time(BurstParams* burst, int idx, uin
  * @return Status indicating the success or failure of the operation.
  */
 Status RmaxMgr::RmaxMgrImpl::get_tx_packet_burst(BurstParams* burst) {
-  return Status::NO_FREE_BURST_BUFFERS;
+  auto tx_burst_manager = get_tx_burst_manager(burst);
+  if (!tx_burst_manager) { return Status::INVALID_PARAMETER; }
+
+  return tx_burst_manager->get_tx_packet_burst(burst);
 }
 
 /**
  * @brief Sets the Ethernet header for a specific packet.
  *
+ * Rivermax generic streams build Layer 2-4 headers from the stream parameters, so this is
+ * a no-op kept for API compatibility.
+ *
  * @param burst The burst parameters.
  * @param idx The packet index.
  * @param dst_addr The destination address.
@@ -481,6 +601,8 @@ Status RmaxMgr::RmaxMgrImpl::set_eth_header(BurstParams* burst, int idx, char* d
 /**
  * @brief Sets the IPv4 header for a specific packet.
  *
+ * No-op, the IPv4 header is built by Rivermax.
+ *
  * @param burst The burst parameters.
  * @param idx The packet index.
  * @param ip_len The length of the IP packet.
@@ -497,6 +619,8 @@ Status RmaxMgr::RmaxMgrImpl::set_ipv4_header(BurstParams* burst, int idx, int ip
 /**
  * @brief Sets the UDP header for a specific packet.
  *
+ * No-op, the UDP header is built by Rivermax.
+ *
  * @param burst The burst parameters.
  * @param idx The packet index.
  * @param udp_len The length of the UDP packet.
@@ -519,7 +643,10 @@ Status RmaxMgr::RmaxMgrImpl::set_udp_header(BurstParams* burst, int idx, int udp
  * @return Status indicating the success or failure of the operation.
  */
 Status RmaxMgr::RmaxMgrImpl::set_udp_payload(BurstParams* burst, int idx, void* data, int len) {
-  return Status::SUCCESS;
+  auto tx_burst_manager = get_tx_burst_manager(burst);
+  if (!tx_burst_manager) { return Status::INVALID_PARAMETER; }
+
+  return tx_burst_manager->set_udp_payload(burst, idx, data, len);
 }
 
 /**
@@ -529,12 +656,18 @@ Status RmaxMgr::RmaxMgrImpl::set_udp_payload(BurstParams* burst, int idx, void*
  * @return True if a TX burst is available, false otherwise.
  */
 bool RmaxMgr::RmaxMgrImpl::is_tx_burst_available(BurstParams* burst) {
-  return false;
+  auto tx_burst_manager = get_tx_burst_manager(burst);
+  if (!tx_burst_manager) { return false; }
+
+  return tx_burst_manager->is_tx_burst_available(burst);
 }
 
 /**
  * @brief Sets the packet lengths for a specific packet.
  *
+ * The lengths describe the bytes of each segment that are sent after the Layer 2-4
+ * headers generated by Rivermax.
+ *
  * @param burst The burst parameters.
  * @param idx The packet index.
  * @param lens The list of lengths.
@@ -542,6 +675,16 @@ bool RmaxMgr::RmaxMgrImpl::is_tx_burst_available(BurstParams* burst) {
  */
 Status RmaxMgr::RmaxMgrImpl::set_packet_lengths(BurstParams* burst, int idx,
                                                 const std::initializer_list<int>& lens) {
+  if (lens.size() != static_cast<size_t>(burst->hdr.hdr.num_segs)) {
+    HOLOSCAN_LOG_ERROR("Number of lengths {} doesn't match number of segments {}",
+                       lens.size(),
+                       burst->hdr.hdr.num_segs);
+    return Status::INVALID_PARAMETER;
+  }
+
+  int seg = 0;
+  for (const auto& len : lens) { burst->pkt_lens[seg++][idx] = len; }
+
   return Status::SUCCESS;
 }
 
@@ -603,12 +746,50 @@ void RmaxMgr::RmaxMgrImpl::free_rx_burst(BurstParams* burst) {
   rmax_bursts_manager->rx_burst_done(static_cast<RmaxBurst*>(burst));
 }
 
+/**
+ * @brief Frees multiple RX bursts.
+ *
+ * Bursts returned by get_rx_bursts typically belong to the same service, so the
+ * service lookup is only repeated when the port/queue changes.
+ *
+ * @param bursts The array of bursts.
+ * @param num_bursts The number of bursts in the array.
+ */
+void RmaxMgr::RmaxMgrImpl::free_rx_bursts(BurstParams** bursts, int num_bursts) {
+  RxBurstsManager* rmax_bursts_manager = nullptr;
+  uint32_t cur_key = 0;
+
+  for (int i = 0; i < num_bursts; i++) {
+    uint32_t key = RmaxBurst::burst_tag_from_port_and_queue_id(bursts[i]->hdr.hdr.port_id,
+                                                               bursts[i]->hdr.hdr.q_id);
+    if (rmax_bursts_manager == nullptr || key != cur_key) {
+      auto rx_service_it = rx_services.find(key);
+      auto manager_it = rx_burst_managers.find(key);
+      if (rx_service_it == rx_services.end() || manager_it == rx_burst_managers.end() ||
+          !rx_service_it->second->is_alive()) {
+        HOLOSCAN_LOG_ERROR("Rmax Service is not initialized");
+        rmax_bursts_manager = nullptr;
+        continue;
+      }
+      rmax_bursts_manager = manager_it->second.get();
+      cur_key = key;
+    }
+
+    rmax_bursts_manager->rx_burst_done(static_cast<RmaxBurst*>(bursts[i]));
+  }
+}
+
 /**
  * @brief Frees the TX burst.
  *
  * @param burst The burst parameters.
  */
-void RmaxMgr::RmaxMgrImpl::free_tx_burst(BurstParams* burst) {}
+void RmaxMgr::RmaxMgrImpl::free_tx_burst(BurstParams* burst) {
+  auto tx_burst_manager = get_tx_burst_manager(burst);
+  if (!tx_burst_manager) { return; }
+
+  tx_burst_manager->free_tx_burst(burst);
+}
 
 /**
  * @brief Dequeues an RX burst.
@@ -626,14 +807,42 @@ Status RmaxMgr::RmaxMgrImpl::get_rx_burst(BurstParams** burst, int port, int q)
     return Status::INVALID_PARAMETER;
   }
 
-  auto out_burst_shared = queue_it->second->dequeue_burst();
-  if (out_burst_shared == nullptr) {
+  auto* out_burst = queue_it->second->dequeue_burst();
+  if (out_burst == nullptr) {
     return Status::NULL_PTR;
   }
-  *burst = out_burst_shared.get();
+  *burst = out_burst;
   return Status::SUCCESS;
 }
 
+/**
+ * @brief Gets up to max_bursts RX bursts from a single service queue.
+ *
+ * @param bursts The array to store the bursts in.
+ * @param max_bursts The maximal number of bursts to dequeue.
+ * @param port The port ID.
+ * @param q The queue ID.
+ * @return The number of bursts stored in bursts.
+ */
+int RmaxMgr::RmaxMgrImpl::get_rx_bursts(BurstParams** bursts, int max_bursts, int port, int q) {
+  uint32_t service_id = RmaxBurst::burst_tag_from_port_and_queue_id(port, q);
+  auto queue_it = rx_bursts_out_queues_map_.find(service_id);
+
+  if (queue_it == rx_bursts_out_queues_map_.end()) {
+    HOLOSCAN_LOG_ERROR("No Rx queue found for Rivermax service (port {}, queue {}). "
+                       "Check config.", port, q);
+    return 0;
+  }
+
+  int num_bursts = 0;
+  while (num_bursts < max_bursts) {
+    auto* out_burst = queue_it->second->dequeue_burst();
+    if (out_burst == nullptr) { break; }
+    bursts[num_bursts++] = out_burst;
+  }
+  return num_bursts;
+}
+
 /**
  * @brief Frees the RX metadata.
  *
@@ -646,7 +855,9 @@ void RmaxMgr::RmaxMgrImpl::free_rx_metadata(BurstParams* burst) {}
  *
  * @param burst The burst parameters.
  */
-void RmaxMgr::RmaxMgrImpl::free_tx_metadata(BurstParams* burst) {}
+void RmaxMgr::RmaxMgrImpl::free_tx_metadata(BurstParams* burst) {
+  delete burst;
+}
 
 /**
  * @brief Gets the TX metadata buffer.
@@ -655,17 +866,30 @@ void RmaxMgr::RmaxMgrImpl::free_tx_metadata(BurstParams* burst) {}
  * @return Status indicating the success or failure of the operation.
  */
 Status RmaxMgr::RmaxMgrImpl::get_tx_metadata_buffer(BurstParams** burst) {
+  *burst = create_tx_burst_params();
   return Status::SUCCESS;
 }
 
 /**
  * @brief Sends a TX burst.
  *
+ * The burst packets are committed to the Rivermax generic stream and paced by the NIC.
+ * The burst metadata is released regardless of the result, same as with other managers.
+ *
  * @param burst The burst parameters.
  * @return Status indicating the success or failure of the operation.
  */
 Status RmaxMgr::RmaxMgrImpl::send_tx_burst(BurstParams* burst) {
-  return Status::SUCCESS;
+  auto tx_burst_manager = get_tx_burst_manager(burst);
+  if (!tx_burst_manager) {
+    free_tx_metadata(burst);
+    return Status::INVALID_PARAMETER;
+  }
+
+  Status status = tx_burst_manager->send_tx_burst(burst);
+  free_tx_metadata(burst);
+
+  return status;
 }
 
 /**
@@ -687,9 +911,67 @@ void RmaxMgr::RmaxMgrImpl::shutdown() {
 void RmaxMgr::RmaxMgrImpl::print_stats() {
   std::stringstream ss;
   IpoRxStatsPrinter::print_total_stats(ss, rx_services);
+  GenericTxStatsPrinter::print_total_stats(ss, tx_services);
   HOLOSCAN_LOG_INFO(ss.str());
 }
 
+/**
+ * @brief Takes a snapshot of the Rmax manager statistics.
+ *
+ * Rivermax does not go through ethdev, so no port counters are reported. Queue counters
+ * are the totals of the streams of each service, and the pools are the RX burst pools.
+ *
+ * @param stats The statistics to fill.
+ * @return Status indicating the success or failure of the operation.
+ */
+Status RmaxMgr::RmaxMgrImpl::get_stats(ManagerStats& stats) {
+  for (const auto& [service_id, rx_service] : rx_services) {
+    QueueStats q_stats;
+    q_stats.port_id = RmaxBurst::burst_port_id_from_burst_tag(service_id);
+    q_stats.q_id = RmaxBurst::burst_queue_id_from_burst_tag(service_id);
+    q_stats.dir = Direction::RX;
+
+    auto streams_stats = rx_service->get_streams_statistics().first;
+    for (const auto& stream_stats : streams_stats) {
+      q_stats.packets += stream_stats.rx_counter;
+      q_stats.bytes += stream_stats.received_bytes;
+      q_stats.drops += stream_stats.rx_dropped;
+      stats.rx_dropped += stream_stats.unconsumed_packets;
+    }
+
+    auto queue_it = rx_bursts_out_queues_map_.find(service_id);
+    if (queue_it != rx_bursts_out_queues_map_.end()) {
+      q_stats.ring_occupancy = queue_it->second->available_bursts();
+      q_stats.ring_capacity = queue_it->second->get_capacity();
+    }
+    stats.queues.push_back(q_stats);
+
+    auto manager_it = rx_burst_managers.find(service_id);
+    if (manager_it != rx_burst_managers.end()) {
+      PoolStats pool;
+      pool.name = "RX_BURST_POOL_P" + std::to_string(q_stats.port_id) + "_Q" +
+                  std::to_string(q_stats.q_id);
+      pool.free = manager_it->second->get_free_bursts();
+      pool.size = RxBurstsManager::DEFAULT_NUM_RX_BURSTS;
+      pool.exhausted = manager_it->second->get_pool_exhausted_count();
+      stats.pools.push_back(pool);
+    }
+  }
+
+  for (const auto& [service_id, tx_service] : tx_services) {
+    const auto tx_stats = tx_service->get_stream_statistics();
+    QueueStats q_stats;
+    q_stats.port_id = RmaxBurst::burst_port_id_from_burst_tag(service_id);
+    q_stats.q_id = RmaxBurst::burst_queue_id_from_burst_tag(service_id);
+    q_stats.dir = Direction::TX;
+    q_stats.packets = tx_stats.committed_packets;
+    q_stats.bytes = tx_stats.committed_bytes;
+    stats.queues.push_back(q_stats);
+  }
+
+  return Status::SUCCESS;
+}
+
 /**
  * @brief Gets the total byte count of a burst.
  *
@@ -706,7 +988,9 @@ uint64_t RmaxMgr::RmaxMgrImpl::get_burst_tot_byte(BurstParams* burst) {
  * @return Pointer to the created burst parameters.
  */
 BurstParams* RmaxMgr::RmaxMgrImpl::create_tx_burst_params() {
-  return new BurstParams();
+  auto* burst = new BurstParams();
+  TxBurstsManager::get_tx_burst_info(burst)->slot_id = RmaxGenericSenderService::SLOT_NONE;
+  return burst;
 }
 
 /**
@@ -841,6 +1125,35 @@ uint16_t RmaxMgr::get_packet_flow_id(BurstParams* burst, int idx) {
   return 0;
 }
 
+/**
+ * @brief Takes a snapshot of the manager statistics.
+ *
+ * @param stats The statistics to fill.
+ * @return Status indicating the success or failure of the operation.
+ */
+Status RmaxMgr::get_stats(ManagerStats& stats) {
+  return pImpl->get_stats(stats);
+}
+
+/**
+ * @brief Gets the frame carried by a frame-aligned RX burst.
+ *
+ * @param burst The burst parameters.
+ * @param info The frame information to fill.
+ * @return Status indicating the success or failure of the operation.
+ */
+Status RmaxMgr::get_burst_frame_info(BurstParams* burst, BurstFrameInfo* info) {
+  if (burst == nullptr || info == nullptr) { return Status::NULL_PTR; }
+
+  const auto* burst_info = static_cast<RmaxBurst*>(burst)->get_burst_info();
+  if ((burst_info->burst_flags & BurstFlags::FRAME_ALIGNED) == 0) {
+    return Status::NOT_SUPPORTED;
+  }
+
+  *info = burst_info->frame;
+  return Status::SUCCESS;
+}
+
 /**
  * @brief Gets the extra information of a specific packet.
  *
@@ -990,6 +1303,16 @@ void RmaxMgr::free_rx_burst(BurstParams* burst) {
   pImpl->free_rx_burst(burst);
 }
 
+/**
+ * @brief Frees multiple RX bursts.
+ *
+ * @param bursts The array of bursts.
+ * @param num_bursts The number of bursts in the array.
+ */
+void RmaxMgr::free_rx_bursts(BurstParams** bursts, int num_bursts) {
+  pImpl->free_rx_bursts(bursts, num_bursts);
+}
+
 /**
  * @brief Frees the TX burst.
  *
@@ -1009,6 +1332,19 @@ Status RmaxMgr::get_rx_burst(BurstParams** burst, int port, int q) {
   return pImpl->get_rx_burst(burst, port, q);
 }
 
+/**
+ * @brief Gets up to max_bursts RX bursts.
+ *
+ * @param bursts The array to store the bursts in.
+ * @param max_bursts The maximal number of bursts to dequeue.
+ * @param port The port ID.
+ * @param q The queue ID.
+ * @return The number of bursts stored in bursts.
+ */
+int RmaxMgr::get_rx_bursts(BurstParams** bursts, int max_bursts, int port, int q) {
+  return pImpl->get_rx_bursts(bursts, max_bursts, port, q);
+}
+
 /**
  * @brief Sets the transmission time for a specific packet.
  *
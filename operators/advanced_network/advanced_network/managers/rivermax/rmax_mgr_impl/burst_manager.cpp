@@ -16,222 +16,125 @@
  */
 
 #include <cassert>
+#include <cerrno>
 #include <cstdlib>
 #include <cstring>
+#include <new>
 #include <string>
-#include <queue>
-#include <mutex>
-#include <condition_variable>
+#include <thread>
+#include <vector>
 #include <chrono>
 
+#include <linux/mempolicy.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
 #include <rivermax_api.h>
 #include "api/rmax_apps_lib_api.h"
 #include "rmax_service/rmax_ipo_receiver_service.h"
+#include "rmax_service/rmax_generic_sender_service.h"
 #include "rmax_mgr_impl/rmax_chunk_consumer_ano.h"
+#include "rmax_mgr_impl/burst_queues.h"
 #include <holoscan/logger/logger.hpp>
 
+// Lock-free bounded queues take precedence over the mutex based ones. A blocking queue waits
+// for a burst on dequeue, the lock-free one by polling.
+#define USE_LOCK_FREE_QUEUE 1
 #define USE_BLOCKING_QUEUE 0
-#define USE_BLOCKING_MEMPOOL 1
 
 using namespace ral::lib::core;
 using namespace ral::lib::services;
 
 namespace holoscan::advanced_network {
 
-/**
- * @brief A non-blocking queue implementation.
- *
- * @tparam T Type of elements stored in the queue.
- */
-template <typename T>
-class NonBlockingQueue : public QueueInterface<T> {
-  std::queue<T> queue_;
-  mutable std::mutex mutex_;
-
- public:
-  /**
-   * @brief Enqueues an element into the queue.
-   *
-   * @param value The element to be enqueued.
-   */
-  void enqueue(const T& value) override {
-    std::lock_guard<std::mutex> lock(mutex_);
-    queue_.push(value);
-  }
-
-  /**
-   * @brief Tries to dequeue an element from the queue.
-   *
-   * @param value Reference to store the dequeued element.
-   * @return true if an element was dequeued, false otherwise.
-   */
-  bool try_dequeue(T& value) override {
-    std::lock_guard<std::mutex> lock(mutex_);
-    if (queue_.empty()) { return false; }
-    value = queue_.front();
-    queue_.pop();
-    return true;
-  }
-
-  /**
-   * @brief Tries to dequeue an element from the queue.
-   *
-   * @param value Reference to store the dequeued element.
-   * @param timeout Timeout for the dequeue operation (ignored).
-   * @return true if an element was dequeued, false otherwise.
-   */
-  bool try_dequeue(T& value, std::chrono::milliseconds timeout) override {
-    return try_dequeue(value);
-  }
-
-  /**
-   * @brief Gets the size of the queue.
-   *
-   * @return The number of elements in the queue.
-   */
-  size_t get_size() const override {
-    std::lock_guard<std::mutex> lock(mutex_);
-    return queue_.size();
-  }
-
-  /**
-   * @brief Clears all elements from the queue.
-   */
-  void clear() override {
-    std::lock_guard<std::mutex> lock(mutex_);
-    while (!queue_.empty()) { queue_.pop(); }
-  }
-};
+namespace {
 
 /**
- * @brief A blocking queue implementation.
+ * @brief Maps anonymous memory, preferably on the given NUMA node.
+ *
+ * The policy is set before the pages are first touched, so they are allocated on the node
+ * without moving them afterwards.
  *
- * @tparam T Type of elements stored in the queue.
+ * @param size Size of the memory in bytes.
+ * @param numa_node NUMA node of the memory, -1 for the default policy.
+ * @return A pointer to the memory, or nullptr on failure.
  */
-template <typename T>
-class BlockingQueue : public QueueInterface<T> {
-  std::queue<T> queue_;
-  mutable std::mutex mutex_;
-  std::condition_variable cond_;
-
- public:
-  /**
-   * @brief Enqueues an element into the queue.
-   *
-   * @param value The element to be enqueued.
-   */
-  void enqueue(const T& value) override {
-    std::lock_guard<std::mutex> lock(mutex_);
-    queue_.push(value);
-    cond_.notify_one();
-  }
-
-  /**
-   * @brief Tries to dequeue an element from the queue (blocks forever).
-   *
-   * @param value Reference to store the dequeued element.
-   * @return true if an element was dequeued, false otherwise.
-   */
-  bool try_dequeue(T& value) override {
-    std::unique_lock<std::mutex> lock(mutex_);
-    cond_.wait(lock, [this] { return !queue_.empty(); });
-    value = queue_.front();
-    queue_.pop();
-    return true;
-  }
-
-  /**
-   * @brief Tries to dequeue an element from the queue.
-   *
-   * @param value Reference to store the dequeued element.
-   * @param timeout Timeout for the dequeue operation.
-   * @return true if an element was dequeued, false otherwise.
-   */
-  bool try_dequeue(T& value, std::chrono::milliseconds timeout) override {
-    std::unique_lock<std::mutex> lock(mutex_);
-    if (!cond_.wait_for(lock, timeout, [this] { return !queue_.empty(); })) { return false; }
-    value = queue_.front();
-    queue_.pop();
-    return true;
-  }
-
-  /**
-   * @brief Gets the size of the queue.
-   *
-   * @return The number of elements in the queue.
-   */
-  size_t get_size() const override {
-    std::lock_guard<std::mutex> lock(mutex_);
-    return queue_.size();
-  }
-
-  /**
-   * @brief Clears all elements from the queue.
-   */
-  void clear() override {
-    std::lock_guard<std::mutex> lock(mutex_);
-    while (!queue_.empty()) { queue_.pop(); }
-  }
-};
+void* map_numa_local(size_t size, int numa_node) {
+  void* memory = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+  if (memory == MAP_FAILED) { return nullptr; }
+  if (numa_node < 0) { return memory; }
+
+  constexpr size_t bits_per_mask = 8 * sizeof(unsigned long);
+  std::vector<unsigned long> node_mask(numa_node / bits_per_mask + 1, 0);
+  node_mask[numa_node / bits_per_mask] |= 1UL << (numa_node % bits_per_mask);
+  if (syscall(SYS_mbind,
+              memory,
+              size,
+              MPOL_PREFERRED,
+              node_mask.data(),
+              node_mask.size() * bits_per_mask + 1,
+              0) != 0) {
+    HOLOSCAN_LOG_WARN("Failed to bind the burst pool to NUMA node {}: {}",
+                      numa_node,
+                      std::strerror(errno));
+  }
+  return memory;
+}
 
-/**
- * @brief Memory pool for managing bursts of packets.
- */
-class AnoBurstsMemoryPool : public IAnoBurstsCollection {
- public:
-  AnoBurstsMemoryPool() = delete;
-
-  /**
-   * @brief Constructor with initial queue size.
-   *
-   * @param size Initial size of the memory pool.
-   * @param burst_handler Reference to the burst handler.
-   * @param tag Tag for the burst.
-   */
-  AnoBurstsMemoryPool(size_t size, RmaxBurst::BurstHandler& burst_handler, uint32_t tag);
-
-  /**
-   * @brief Destructor to clean up resources.
-   */
-  ~AnoBurstsMemoryPool();
-
-  bool enqueue_burst(std::shared_ptr<RmaxBurst> burst) override;
-  bool enqueue_burst(RmaxBurst* burst);
-  std::shared_ptr<RmaxBurst> dequeue_burst() override;
-  size_t available_bursts() override { return m_queue->get_size(); };
-  bool empty() override { return m_queue->get_size() == 0; };
-
- private:
-  std::unique_ptr<QueueInterface<std::shared_ptr<RmaxBurst>>> m_queue;
-  std::map<uint16_t, std::shared_ptr<RmaxBurst>> m_burst_map;
-  size_t m_initial_size;
-  mutable std::mutex m_burst_map_mutex;
-  mutable std::mutex m_queue_mutex;
-  uint32_t m_bursts_tag = 0;
-  RmaxBurst::BurstHandler& m_burst_handler;
-};
+constexpr size_t align_to_cache_line(size_t size) {
+  return (size + 63) & ~static_cast<size_t>(63);
+}
+
+}  // namespace
 
 /**
  * @brief Constructor for AnoBurstsMemoryPool.
  *
- * @param size Initial size of the memory pool.
+ * Allocates the bursts and their packet arrays in one NUMA-local block and chains them all
+ * into the free list.
+ *
+ * @param size Number of bursts in the pool.
  * @param burst_handler Reference to the burst handler.
  * @param tag Tag for the burst.
+ * @param numa_node NUMA node to allocate the bursts on, -1 for the default policy.
  */
 AnoBurstsMemoryPool::AnoBurstsMemoryPool(size_t size, RmaxBurst::BurstHandler& burst_handler,
-                                         uint32_t tag)
-    : m_initial_size(size), m_bursts_tag(tag), m_burst_handler(burst_handler) {
-#if USE_BLOCKING_MEMPOOL
-  m_queue = std::make_unique<BlockingQueue<std::shared_ptr<RmaxBurst>>>();
-#else
-  m_queue = std::make_unique<NonBlockingQueue<std::shared_ptr<RmaxBurst>>>();
-#endif
+                                         uint32_t tag, int numa_node)
+    : m_bursts_tag(tag), m_burst_handler(burst_handler) {
+  if (size > UINT16_MAX) {
+    throw std::invalid_argument("Burst pool size exceeds the burst ID range: " +
+                                std::to_string(size));
+  }
+
+  // Bursts are cache line aligned, so the receiver and the consumer of two neighbouring
+  // bursts don't share a line
+  const size_t burst_size = align_to_cache_line(sizeof(RmaxBurst));
+  const size_t packet_arrays_size = m_burst_handler.get_packet_arrays_size();
+  m_memory_size = size * (burst_size + packet_arrays_size);
+  m_memory = map_numa_local(m_memory_size, numa_node);
+  if (m_memory == nullptr) {
+    throw std::runtime_error("Failed to allocate the burst pool of " +
+                             std::to_string(m_memory_size) + " bytes");
+  }
 
+  auto* bursts_memory = static_cast<uint8_t*>(m_memory);
+  auto* packet_arrays_memory = bursts_memory + size * burst_size;
+  m_bursts.reserve(size);
   for (uint16_t i = 0; i < size; i++) {
-    auto burst = m_burst_handler.create_burst(i);
-    m_queue->enqueue(burst);
-    m_burst_map[i] = burst;
+    auto* burst = m_burst_handler.create_burst(
+        i, bursts_memory + i * burst_size, packet_arrays_memory + i * packet_arrays_size);
+    m_bursts.push_back(burst);
+  }
+
+  // Chain the bursts in order, burst 0 first
+  for (uint32_t i = 0; i < size; i++) {
+    m_bursts[i]->m_next_free.store(i + 1 < size ? i + 1 : FREE_LIST_END,
+                                   std::memory_order_relaxed);
+    m_bursts[i]->m_in_pool.store(true, std::memory_order_relaxed);
   }
+  m_free_count.store(size, std::memory_order_relaxed);
+  m_free_head.store(size > 0 ? 0 : FREE_LIST_END, std::memory_order_release);
 }
 
 /**
@@ -246,98 +149,127 @@ bool AnoBurstsMemoryPool::enqueue_burst(RmaxBurst* burst) {
     return false;
   }
 
-  uint16_t burst_id = burst->get_burst_id();
+  if (m_bursts_tag != burst->get_burst_tag()) {
+    HOLOSCAN_LOG_ERROR("Invalid burst tag");
+    return false;
+  }
 
-  std::lock_guard<std::mutex> lock(m_burst_map_mutex);
-  auto it = m_burst_map.find(burst_id);
-  if (it != m_burst_map.end()) {
-    std::shared_ptr<RmaxBurst> cur_burst = it->second;
-    return enqueue_burst(cur_burst);
-  } else {
+  const uint16_t burst_id = burst->get_burst_id();
+  if (burst_id >= m_bursts.size() || m_bursts[burst_id] != burst) {
     HOLOSCAN_LOG_ERROR("Invalid burst ID: {}", burst_id);
     return false;
   }
-}
 
-/**
- * @brief Puts a burst back into the memory pool.
- *
- * @param burst Shared pointer to the burst to be put back.
- * @return true if the burst was successfully put back, false otherwise.
- */
-bool AnoBurstsMemoryPool::enqueue_burst(std::shared_ptr<RmaxBurst> burst) {
-  if (burst == nullptr) {
-    HOLOSCAN_LOG_ERROR("Invalid burst");
+  if (burst->m_in_pool.exchange(true, std::memory_order_acq_rel)) {
+    HOLOSCAN_LOG_ERROR("Burst {} returned twice to burst_pool_tag {}", burst_id, m_bursts_tag);
     return false;
   }
 
-  std::lock_guard<std::mutex> lock(m_queue_mutex);
+  // The count is dropped before a taken burst leaves the pool, so it is below the pool size
+  // here unless the free list is corrupted
+  if (m_free_count.load(std::memory_order_acquire) >= m_bursts.size()) {
+    HOLOSCAN_LOG_ERROR("Burst pool {} is full, burst {} was not taken from it", m_bursts_tag,
+                       burst_id);
+    return false;
+  }
 
-  if (m_queue->get_size() < m_initial_size) {
-    auto burst_tag = burst->get_burst_tag();
-    if (m_bursts_tag != burst_tag) {
-      HOLOSCAN_LOG_ERROR("Invalid burst tag");
-      return false;
+  uint64_t head = m_free_head.load(std::memory_order_relaxed);
+  uint64_t new_head;
+  do {
+    burst->m_next_free.store(static_cast<uint32_t>(head), std::memory_order_relaxed);
+    new_head = ((head >> 32) + 1) << 32 | burst_id;
+  } while (!m_free_head.compare_exchange_weak(
+      head, new_head, std::memory_order_release, std::memory_order_relaxed));
+  m_free_count.fetch_add(1, std::memory_order_relaxed);
+  return true;
+}
+
+/**
+ * @brief Takes the first burst of the free list.
+ *
+ * @return A pointer to the burst, or nullptr if the pool is empty.
+ */
+RmaxBurst* AnoBurstsMemoryPool::try_dequeue_burst() {
+  uint64_t head = m_free_head.load(std::memory_order_acquire);
+  while (true) {
+    const uint32_t index = static_cast<uint32_t>(head);
+    if (index == FREE_LIST_END) { return nullptr; }
+    // The link may be stale if another thread takes the burst first, the generation in the
+    // head makes the exchange fail then
+    const uint32_t next = m_bursts[index]->m_next_free.load(std::memory_order_relaxed);
+    const uint64_t new_head = ((head >> 32) + 1) << 32 | next;
+    if (m_free_head.compare_exchange_weak(
+            head, new_head, std::memory_order_acquire, std::memory_order_acquire)) {
+      RmaxBurst* burst = m_bursts[index];
+      m_free_count.fetch_sub(1, std::memory_order_relaxed);
+      burst->m_in_pool.store(false, std::memory_order_release);
+      return burst;
     }
-    m_queue->enqueue(burst);
-    return true;
-  } else {
-    HOLOSCAN_LOG_ERROR("Burst pool is full burst_pool_tag {}", m_bursts_tag);
   }
-  return false;
 }
 
 /**
  * @brief Retrieves a burst from the memory pool.
  *
- * @return A shared pointer to the retrieved burst, or nullptr if no burst is available.
+ * @return A pointer to the retrieved burst, or nullptr if no burst is available.
  */
-std::shared_ptr<RmaxBurst> AnoBurstsMemoryPool::dequeue_burst() {
-  std::shared_ptr<RmaxBurst> burst;
-
-  if (m_queue->try_dequeue(burst,
-                           std::chrono::milliseconds(RxBurstsManager::GET_BURST_TIMEOUT_MS))) {
-    return burst;
-  }
+RmaxBurst* AnoBurstsMemoryPool::dequeue_burst() {
+  RmaxBurst* burst = try_dequeue_burst();
+  if (burst != nullptr) { return burst; }
+
+  // The application holds all the bursts, wait for one to come back
+  m_exhausted.fetch_add(1, std::memory_order_relaxed);
+  const auto deadline = std::chrono::steady_clock::now() +
+                        std::chrono::milliseconds(RxBurstsManager::GET_BURST_TIMEOUT_MS);
+  do {
+    std::this_thread::yield();
+    burst = try_dequeue_burst();
+    if (burst != nullptr) { return burst; }
+  } while (std::chrono::steady_clock::now() < deadline);
   return nullptr;
 }
 
 /**
  * @brief Destructor for the AnoBurstsMemoryPool class.
  *
- * Frees all bursts in the queue and clears the burst map.
+ * Deletes all bursts and releases the pool memory.
  */
 AnoBurstsMemoryPool::~AnoBurstsMemoryPool() {
-  std::shared_ptr<RmaxBurst> burst;
-
-  while (m_queue->get_size() > 0 && m_queue->try_dequeue(burst)) {
-    m_burst_handler.delete_burst(burst);
-  }
-  std::lock_guard<std::mutex> lock(m_burst_map_mutex);
-  m_burst_map.clear();
+  for (auto* burst : m_bursts) { m_burst_handler.delete_burst(burst); }
+  m_bursts.clear();
+  if (m_memory != nullptr) { munmap(m_memory, m_memory_size); }
 }
 
 /**
  * @brief Constructor for the AnoBurstsQueue class.
  *
- * Initializes the queue based on the USE_BLOCKING_QUEUE macro.
+ * Initializes the queue based on the USE_LOCK_FREE_QUEUE and USE_BLOCKING_QUEUE macros.
+ *
+ * @param capacity Maximal number of bursts held by a lock-free queue.
  */
-AnoBurstsQueue::AnoBurstsQueue() {
-#if USE_BLOCKING_QUEUE
-  m_queue = std::make_unique<BlockingQueue<std::shared_ptr<RmaxBurst>>>();
+AnoBurstsQueue::AnoBurstsQueue(size_t capacity) : m_capacity(capacity) {
+#if USE_LOCK_FREE_QUEUE
+  auto queue = std::make_unique<LockFreeQueue<RmaxBurst*>>(capacity);
+  m_capacity = queue->get_capacity();
+  m_queue = std::move(queue);
+#elif USE_BLOCKING_QUEUE
+  m_queue = std::make_unique<BlockingQueue<RmaxBurst*>>();
 #else
-  m_queue = std::make_unique<NonBlockingQueue<std::shared_ptr<RmaxBurst>>>();
+  m_queue = std::make_unique<NonBlockingQueue<RmaxBurst*>>();
 #endif
 }
 
 /**
  * @brief Enqueues a burst into the queue.
  *
- * @param burst A shared pointer to the burst to be enqueued.
- * @return True if the burst was successfully enqueued.
+ * @param burst A pointer to the burst to be enqueued.
+ * @return True if the burst was successfully enqueued, false if the queue is full.
  */
-bool AnoBurstsQueue::enqueue_burst(std::shared_ptr<RmaxBurst> burst) {
-  m_queue->enqueue(burst);
+bool AnoBurstsQueue::enqueue_burst(RmaxBurst* burst) {
+  if (!m_queue->enqueue(burst)) {
+    HOLOSCAN_LOG_ERROR("Bursts queue is full");
+    return false;
+  }
   return true;
 }
 
@@ -351,15 +283,17 @@ void AnoBurstsQueue::clear() {
 /**
  * @brief Retrieves a burst from the queue.
  *
- * @return A shared pointer to the retrieved burst, or nullptr if no burst is available.
+ * @return A pointer to the retrieved burst, or nullptr if no burst is available.
  */
-std::shared_ptr<RmaxBurst> AnoBurstsQueue::dequeue_burst() {
-  std::shared_ptr<RmaxBurst> burst;
+RmaxBurst* AnoBurstsQueue::dequeue_burst() {
+  RmaxBurst* burst = nullptr;
 
-  if (m_queue->try_dequeue(burst,
-                           std::chrono::milliseconds(RxBurstsManager::GET_BURST_TIMEOUT_MS))) {
-    return burst;
-  }
+#if USE_BLOCKING_QUEUE
+  const std::chrono::milliseconds timeout(RxBurstsManager::GET_BURST_TIMEOUT_MS);
+#else
+  const std::chrono::milliseconds timeout(0);
+#endif
+  if (m_queue->try_dequeue(burst, timeout)) { return burst; }
   return nullptr;
 }
 
@@ -393,25 +327,53 @@ RmaxBurst::BurstHandler::BurstHandler(bool send_packet_ext_info, int port_id, in
 }
 
 /**
- * @brief Creates and initializes a new burst with the given burst ID
+ * @brief Gets the size of the packet arrays of a burst.
+ *
+ * @return The size in bytes, a multiple of the cache line size.
+ */
+size_t RmaxBurst::BurstHandler::get_packet_arrays_size() const {
+  size_t size = 2 * MAX_PKT_IN_BURST * (sizeof(void*) + sizeof(uint32_t));
+  if (m_send_packet_ext_info) {
+    size += MAX_PKT_IN_BURST * (sizeof(void*) + sizeof(RmaxPacketExtendedInfo));
+  }
+  return (size + 63) & ~static_cast<size_t>(63);
+}
+
+/**
+ * @brief Creates and initializes a new burst with the given burst ID in preallocated memory
+ *
+ * The pointer arrays come first in the packet arrays so every array stays aligned.
  *
  * @param burst_id The ID of the burst to create.
- * @return A shared pointer to the created burst.
+ * @param burst_memory Memory for the RmaxBurst object.
+ * @param packet_arrays Memory for the packet arrays, of get_packet_arrays_size() bytes.
+ * @return A pointer to the created burst.
  */
-std::shared_ptr<RmaxBurst> RmaxBurst::BurstHandler::create_burst(uint16_t burst_id) {
-  std::shared_ptr<RmaxBurst> burst(new RmaxBurst(m_port_id, m_queue_id, MAX_PKT_IN_BURST));
+RmaxBurst* RmaxBurst::BurstHandler::create_burst(uint16_t burst_id, void* burst_memory,
+                                                 void* packet_arrays) {
+  auto* burst = new (burst_memory) RmaxBurst(m_port_id, m_queue_id, MAX_PKT_IN_BURST);
+  auto* arrays = static_cast<uint8_t*>(packet_arrays);
+
+  burst->pkts[0] = reinterpret_cast<void**>(arrays);
+  arrays += MAX_PKT_IN_BURST * sizeof(void*);
+  burst->pkts[1] = reinterpret_cast<void**>(arrays);
+  arrays += MAX_PKT_IN_BURST * sizeof(void*);
 
   if (m_send_packet_ext_info) {
-    burst->pkt_extra_info = reinterpret_cast<void**>(new RmaxPacketExtendedInfo*[MAX_PKT_IN_BURST]);
+    burst->pkt_extra_info = reinterpret_cast<void**>(arrays);
+    arrays += MAX_PKT_IN_BURST * sizeof(void*);
+    auto* packet_infos = reinterpret_cast<RmaxPacketExtendedInfo*>(arrays);
+    arrays += MAX_PKT_IN_BURST * sizeof(RmaxPacketExtendedInfo);
     for (int j = 0; j < MAX_PKT_IN_BURST; j++) {
-      burst->pkt_extra_info[j] = reinterpret_cast<void*>(new RmaxPacketExtendedInfo());
+      burst->pkt_extra_info[j] = new (&packet_infos[j]) RmaxPacketExtendedInfo();
     }
+  } else {
+    burst->pkt_extra_info = nullptr;
   }
 
-  burst->pkts[0] = new void*[MAX_PKT_IN_BURST];
-  burst->pkts[1] = new void*[MAX_PKT_IN_BURST];
-  burst->pkt_lens[0] = new uint32_t[MAX_PKT_IN_BURST];
-  burst->pkt_lens[1] = new uint32_t[MAX_PKT_IN_BURST];
+  burst->pkt_lens[0] = reinterpret_cast<uint32_t*>(arrays);
+  arrays += MAX_PKT_IN_BURST * sizeof(uint32_t);
+  burst->pkt_lens[1] = reinterpret_cast<uint32_t*>(arrays);
   std::memset(burst->pkt_lens[0], 0, MAX_PKT_IN_BURST * sizeof(uint32_t));
   std::memset(burst->pkt_lens[1], 0, MAX_PKT_IN_BURST * sizeof(uint32_t));
 
@@ -421,35 +383,20 @@ std::shared_ptr<RmaxBurst> RmaxBurst::BurstHandler::create_burst(uint16_t burst_
 }
 
 /**
- * @brief Deletes a burst and frees its associated resources.
+ * @brief Deletes a burst, its memory stays owned by the caller.
  *
- * @param burst A shared pointer to the burst to delete.
+ * @param burst A pointer to the burst to delete.
  */
-void RmaxBurst::BurstHandler::delete_burst(std::shared_ptr<RmaxBurst> burst) {
+void RmaxBurst::BurstHandler::delete_burst(RmaxBurst* burst) {
   if (burst == nullptr) {
     HOLOSCAN_LOG_ERROR("Invalid burst");
     return;
   }
 
-  if (m_send_packet_ext_info && burst->pkt_extra_info != nullptr) {
-    for (int i = 0; i < MAX_PKT_IN_BURST; i++) {
-      if (burst->pkt_extra_info[i] != nullptr) {
-        delete reinterpret_cast<RmaxPacketExtendedInfo*>(burst->pkt_extra_info[i]);
-        burst->pkt_extra_info[i] = nullptr;
-      }
-    }
-    delete[] burst->pkt_extra_info;
-    burst->pkt_extra_info = nullptr;
-  }
-
-  delete[] burst->pkts[0];
-  burst->pkts[0] = nullptr;
-  delete[] burst->pkts[1];
-  burst->pkts[1] = nullptr;
-  delete[] burst->pkt_lens[0];
-  burst->pkt_lens[0] = nullptr;
-  delete[] burst->pkt_lens[1];
-  burst->pkt_lens[1] = nullptr;
+  burst->pkt_extra_info = nullptr;
+  burst->pkts = {};
+  burst->pkt_lens = {};
+  burst->~RmaxBurst();
 }
 
 /**
@@ -463,21 +410,12 @@ void RxBurstsManager::rx_burst_done(RmaxBurst* burst) {
     return;
   }
 
-  IAnoBurstsCollection* basePtr = m_rx_bursts_mempool.get();
-
-  AnoBurstsMemoryPool* derivedPtr = dynamic_cast<AnoBurstsMemoryPool*>(basePtr);
-
-  if (derivedPtr) {
-    bool rc = derivedPtr->enqueue_burst(burst);
-    if (!rc) {
-      HOLOSCAN_LOG_ERROR("Failed to push burst back to the pool. Port_id {}:{}, queue_id {}:{}",
-                         burst->get_port_id(),
-                         m_port_id,
-                         burst->get_queue_id(),
-                         m_queue_id);
-    }
-  } else {
-    HOLOSCAN_LOG_ERROR("Failed to push burst back to the pool, cast failed");
+  if (!m_rx_bursts_mempool->enqueue_burst(burst)) {
+    HOLOSCAN_LOG_ERROR("Failed to push burst back to the pool. Port_id {}:{}, queue_id {}:{}",
+                       burst->get_port_id(),
+                       m_port_id,
+                       burst->get_queue_id(),
+                       m_queue_id);
   }
 }
 
@@ -492,10 +430,12 @@ void RxBurstsManager::rx_burst_done(RmaxBurst* burst) {
  * @param burst_out_size The minimum output burst size.
  * @param gpu_id The GPU ID.
  * @param rx_bursts_out_queue Shared pointer to the output queue for received bursts.
+ * @param numa_node NUMA node of the RX core the burst pool is allocated on, -1 if unknown.
  */
 RxBurstsManager::RxBurstsManager(bool send_packet_ext_info, int port_id, int queue_id,
                                  uint16_t burst_out_size, int gpu_id,
-                                 std::shared_ptr<IAnoBurstsCollection> rx_bursts_out_queue)
+                                 std::shared_ptr<IAnoBurstsCollection> rx_bursts_out_queue,
+                                 int numa_node)
     : m_send_packet_ext_info(send_packet_ext_info),
       m_port_id(port_id),
       m_queue_id(queue_id),
@@ -507,11 +447,11 @@ RxBurstsManager::RxBurstsManager(bool send_packet_ext_info, int port_id, int que
   const uint32_t burst_tag = RmaxBurst::burst_tag_from_port_and_queue_id(port_id, queue_id);
   m_gpu_direct = (m_gpu_id != INVALID_GPU_ID);
 
-  m_rx_bursts_mempool =
-      std::make_unique<AnoBurstsMemoryPool>(DEFAULT_NUM_RX_BURSTS, *m_burst_handler, burst_tag);
+  m_rx_bursts_mempool = std::make_unique<AnoBurstsMemoryPool>(
+      DEFAULT_NUM_RX_BURSTS, *m_burst_handler, burst_tag, numa_node);
 
   if (!m_rx_bursts_out_queue) {
-    m_rx_bursts_out_queue = std::make_shared<AnoBurstsQueue>();
+    m_rx_bursts_out_queue = std::make_shared<AnoBurstsQueue>(DEFAULT_NUM_RX_BURSTS);
     m_using_shared_out_queue = false;
   }
 
@@ -522,18 +462,328 @@ RxBurstsManager::RxBurstsManager(bool send_packet_ext_info, int port_id, int que
 /**
  * @brief Destructor for the RxBurstsManager class.
  *
- * Ensures that all bursts are properly returned to the memory pool.
+ * Ensures that all bursts are properly returned to the memory pool, and releases the pool
+ * before the burst handler it uses.
  */
 RxBurstsManager::~RxBurstsManager() {
-  if (m_using_shared_out_queue) { return; }
+  if (!m_using_shared_out_queue) {
+    // Get all bursts from the queue and return them to the memory pool
+    while (m_rx_bursts_out_queue->available_bursts() > 0) {
+      RmaxBurst* burst = m_rx_bursts_out_queue->dequeue_burst();
+      if (burst == nullptr) break;
+      m_rx_bursts_mempool->enqueue_burst(burst);
+    }
+  }
+  m_rx_bursts_mempool.reset();
+}
+
+namespace {
 
-  std::shared_ptr<RmaxBurst> burst;
-  // Get all bursts from the queue and return them to the memory pool
-  while (m_rx_bursts_out_queue->available_bursts() > 0) {
-    burst = m_rx_bursts_out_queue->dequeue_burst();
-    if (burst == nullptr) break;
-    m_rx_bursts_mempool->enqueue_burst(burst);
+constexpr size_t RTP_HEADER_SIZE = 12;
+
+/**
+ * @brief Parses the fields of an RTP header used to find frame boundaries.
+ *
+ * @return true if the header is a valid RTP header.
+ */
+bool parse_rtp_header(const uint8_t* rtp, size_t length, bool ext_seq_num, uint32_t& seq,
+                      uint32_t& rtp_timestamp, bool& marker) {
+  if (rtp == nullptr || length < RTP_HEADER_SIZE || (rtp[0] & 0xC0) != 0x80) { return false; }
+
+  marker = (rtp[1] & 0x80) != 0;
+  seq = rtp[3] | rtp[2] << 8;
+  rtp_timestamp = static_cast<uint32_t>(rtp[4]) << 24 | rtp[5] << 16 | rtp[6] << 8 | rtp[7];
+  if (ext_seq_num) {
+    // The high order bits follow the CSRC list, at the start of the payload header
+    const size_t offset = (rtp[0] & 0x0F) * 4;
+    if (length < offset + RTP_HEADER_SIZE + 2) { return false; }
+    seq |= (rtp[offset + 12] << 24) | (rtp[offset + 13] << 16);
   }
+  return true;
+}
+
+}  // namespace
+
+/**
+ * @brief Sets where bursts end.
+ *
+ * @param mode Burst cut mode.
+ * @param frame_packets Packets per frame in FRAME_PACKETS mode.
+ * @param ext_seq_num Whether the sequence number is extended to 32 bits by the payload header.
+ */
+void RxBurstsManager::set_burst_cut_mode(RxBurstCutMode mode, uint32_t frame_packets,
+                                         bool ext_seq_num) {
+  if (mode == RxBurstCutMode::FRAME_PACKETS && frame_packets == 0) {
+    HOLOSCAN_LOG_ERROR("frame_packets must be set to cut bursts on frames, cutting on packets");
+    mode = RxBurstCutMode::PACKETS;
+  }
+
+  m_burst_cut_mode = mode;
+  m_frame_packets = frame_packets;
+  m_ext_seq_num = ext_seq_num;
+  m_have_last_packet = false;
+  m_frame_position = 0;
+}
+
+/**
+ * @brief Submits the next packet in one of the frame burst cut modes.
+ *
+ * A burst in progress is closed before the packet when the packet starts a new frame, and
+ * after it when it ends the frame. Packets lost between two frames are counted in the frame
+ * they belong to in FRAME_PACKETS mode, and in the previous frame otherwise since it lost at
+ * least its marker packet.
+ *
+ * @param packet_data Extended information about the packet.
+ * @return ReturnStatus indicating the success or failure of the operation.
+ */
+ReturnStatus RxBurstsManager::submit_next_frame_packet(const RmaxPacketData& packet_data) {
+  if (!m_hds_on && m_gpu_direct) {
+    HOLOSCAN_LOG_ERROR("Frame burst cut needs header-data split with GPU memory, cutting on "
+                       "packets (port {}, queue {})",
+                       m_port_id,
+                       m_queue_id);
+    m_burst_cut_mode = RxBurstCutMode::PACKETS;
+    return submit_next_packet(packet_data);
+  }
+
+  const uint8_t* rtp = m_hds_on ? packet_data.header_ptr : packet_data.payload_ptr;
+  const size_t rtp_length = m_hds_on ? packet_data.header_length : packet_data.payload_length;
+  uint32_t seq = 0;
+  uint32_t rtp_timestamp = 0;
+  bool marker = false;
+  const bool valid_rtp = parse_rtp_header(rtp, rtp_length, m_ext_seq_num, seq, rtp_timestamp,
+                                          marker);
+
+  // Large jumps are a sender restart or reordering rather than losses
+  const uint32_t seq_mask = m_ext_seq_num ? UINT32_MAX : UINT16_MAX;
+  uint32_t lost = 0;
+  if (valid_rtp && m_have_last_packet) {
+    lost = (seq - m_last_seq - 1) & seq_mask;
+    if (lost > seq_mask / 2) { lost = 0; }
+  }
+
+  // A frame split on the burst capacity has no burst in progress, but its position is kept
+  const bool has_burst = m_cur_out_burst != nullptr && m_cur_out_burst->get_num_packets() > 0;
+  bool new_frame;
+  uint32_t prev_frame_lost;
+  if (m_burst_cut_mode == RxBurstCutMode::RTP_MARKER) {
+    new_frame = valid_rtp && m_have_last_packet && rtp_timestamp != m_last_rtp_timestamp;
+    prev_frame_lost = lost;
+  } else {
+    new_frame = m_frame_position + lost >= m_frame_packets;
+    prev_frame_lost = m_frame_packets - m_frame_position;
+  }
+
+  if (new_frame) {
+    if (m_burst_cut_mode == RxBurstCutMode::RTP_MARKER) {
+      lost = 0;
+    } else {
+      // Frames lost entirely are not reported
+      lost = (m_frame_position + lost - m_frame_packets) % m_frame_packets;
+    }
+    m_frame_position = 0;
+    if (has_burst) {
+      m_cur_out_burst->get_burst_info()->frame.missing_pkts += prev_frame_lost;
+      auto status = enqueue_frame_burst(true);
+      if (status != ReturnStatus::success) { return status; }
+    }
+  }
+
+  get_or_allocate_current_burst();
+  if (m_cur_out_burst == nullptr) {
+    HOLOSCAN_LOG_ERROR("Failed to allocate burst, running out of resources");
+    return ReturnStatus::no_free_chunks;
+  }
+
+  auto* burst_info = m_cur_out_burst->get_burst_info();
+  auto& frame = burst_info->frame;
+  const size_t idx = m_cur_out_burst->get_num_packets();
+  if (idx == 0) {
+    burst_info->burst_flags =
+        static_cast<BurstFlags>(burst_info->burst_flags | BurstFlags::FRAME_ALIGNED);
+    frame = {};
+    frame.payload_ptr = packet_data.payload_ptr;
+    frame.payload_stride = m_payload_stride_size;
+    frame.contiguous = true;
+  } else if (packet_data.payload_ptr !=
+             static_cast<uint8_t*>(frame.payload_ptr) + idx * frame.payload_stride) {
+    // The receive buffer wrapped around within the frame
+    frame.contiguous = false;
+  }
+
+  m_cur_out_burst->append_packet(packet_data);
+  frame.num_pkts++;
+  frame.missing_pkts += lost;
+  m_frame_position += lost + 1;
+
+  if (valid_rtp) {
+    m_have_last_packet = true;
+    m_last_seq = seq;
+    m_last_rtp_timestamp = rtp_timestamp;
+  }
+
+  const bool end_of_frame = (m_burst_cut_mode == RxBurstCutMode::RTP_MARKER)
+                                ? marker
+                                : m_frame_position >= m_frame_packets;
+  if (end_of_frame) {
+    m_frame_position = 0;
+    return enqueue_frame_burst(true);
+  }
+
+  if (m_cur_out_burst->get_num_packets() >= m_cur_out_burst->get_max_num_packets()) {
+    return enqueue_frame_burst(false);
+  }
+
+  return ReturnStatus::success;
+}
+
+/**
+ * @brief Closes the current frame burst and sends it to the output queue.
+ *
+ * @param complete Whether the burst ends on a frame boundary.
+ * @return ReturnStatus indicating the success or failure of the operation.
+ */
+ReturnStatus RxBurstsManager::enqueue_frame_burst(bool complete) {
+  if (m_cur_out_burst != nullptr) { m_cur_out_burst->get_burst_info()->frame.complete = complete; }
+  return enqueue_and_reset_current_burst();
+}
+
+/**
+ * @brief Constructor for the TxBurstsManager class.
+ *
+ * @param port_id ID of the port.
+ * @param queue_id ID of the queue.
+ * @param tx_service Shared pointer to the generic sender service.
+ */
+TxBurstsManager::TxBurstsManager(
+    int port_id, int queue_id,
+    std::shared_ptr<rmax_generic_sender::RmaxGenericSenderService> tx_service)
+    : m_port_id(port_id), m_queue_id(queue_id), m_tx_service(tx_service) {}
+
+/**
+ * @brief Checks if a TX burst is available.
+ *
+ * @param burst The burst parameters, number of packets must be set.
+ * @return True if a TX burst is available, false otherwise.
+ */
+bool TxBurstsManager::is_tx_burst_available(BurstParams* burst) {
+  return m_tx_service->is_slot_available(burst->hdr.hdr.num_pkts);
+}
+
+/**
+ * @brief Assigns service memory to the packets of a TX burst.
+ *
+ * @param burst The burst parameters, number of packets must be set.
+ * @return Status indicating the success or failure of the operation.
+ */
+Status TxBurstsManager::get_tx_packet_burst(BurstParams* burst) {
+  auto* tx_info = get_tx_burst_info(burst);
+  tx_info->slot_id = rmax_generic_sender::RmaxGenericSenderService::SLOT_NONE;
+
+  if (burst->hdr.hdr.num_pkts > m_tx_service->get_max_chunk_size()) {
+    HOLOSCAN_LOG_ERROR("Burst of {} packets exceeds TX batch size {} (port {}, queue {})",
+                       burst->hdr.hdr.num_pkts,
+                       m_tx_service->get_max_chunk_size(),
+                       m_port_id,
+                       m_queue_id);
+    return Status::INVALID_PARAMETER;
+  }
+
+  int slot_id = m_tx_service->acquire_slot(burst->hdr.hdr.num_pkts);
+  if (slot_id == rmax_generic_sender::RmaxGenericSenderService::SLOT_NONE) {
+    return Status::NO_FREE_BURST_BUFFERS;
+  }
+
+  auto& slot = m_tx_service->get_slot(slot_id);
+  tx_info->slot_id = slot_id;
+
+  if (m_tx_service->is_hds_on()) {
+    burst->hdr.hdr.num_segs = 2;
+    burst->pkts[0] = slot.hdr_ptrs.data();
+    burst->pkt_lens[0] = slot.hdr_lens.data();
+    burst->pkts[1] = slot.pld_ptrs.data();
+    burst->pkt_lens[1] = slot.pld_lens.data();
+  } else {
+    burst->hdr.hdr.num_segs = 1;
+    burst->pkts[0] = slot.pld_ptrs.data();
+    burst->pkt_lens[0] = slot.pld_lens.data();
+  }
+
+  return Status::SUCCESS;
+}
+
+/**
+ * @brief Copies payload data into a packet of a TX burst.
+ *
+ * The data is placed at the beginning of the last segment of the packet, since Layer 2-4
+ * headers are generated by Rivermax from the stream parameters.
+ *
+ * @param burst The burst parameters.
+ * @param idx The packet index.
+ * @param data The payload data.
+ * @param len The length of the payload data.
+ * @return Status indicating the success or failure of the operation.
+ */
+Status TxBurstsManager::set_udp_payload(BurstParams* burst, int idx, void* data, int len) {
+  int seg = burst->hdr.hdr.num_segs - 1;
+  if (static_cast<size_t>(len) > m_tx_service->get_payload_stride_size()) {
+    HOLOSCAN_LOG_ERROR("Payload of {} bytes exceeds TX buffer size {}",
+                       len,
+                       m_tx_service->get_payload_stride_size());
+    return Status::INVALID_PARAMETER;
+  }
+
+  if (m_tx_service->is_gpu_direct()) {
+    if (cudaMemcpy(burst->pkts[seg][idx], data, len, cudaMemcpyDefault) != cudaSuccess) {
+      HOLOSCAN_LOG_ERROR("Failed to copy payload to GPU TX buffer");
+      return Status::INTERNAL_ERROR;
+    }
+  } else {
+    memcpy(burst->pkts[seg][idx], data, len);
+  }
+  burst->pkt_lens[seg][idx] = len;
+
+  return Status::SUCCESS;
+}
+
+/**
+ * @brief Commits a TX burst to the hardware.
+ *
+ * If the burst can't be committed its slot is released and the packets are dropped.
+ *
+ * @param burst The burst parameters.
+ * @return Status indicating the success or failure of the operation.
+ */
+Status TxBurstsManager::send_tx_burst(BurstParams* burst) {
+  auto* tx_info = get_tx_burst_info(burst);
+  const bool hds_on = m_tx_service->is_hds_on();
+
+  ReturnStatus rc = m_tx_service->commit_slot(tx_info->slot_id,
+                                              burst->hdr.hdr.num_pkts,
+                                              hds_on ? burst->pkt_lens[0] : nullptr,
+                                              burst->pkt_lens[hds_on ? 1 : 0],
+                                              0);
+  if (rc != ReturnStatus::success) {
+    free_tx_burst(burst);
+    if (rc == ReturnStatus::no_free_chunks) { return Status::NO_SPACE_AVAILABLE; }
+    HOLOSCAN_LOG_ERROR("Failed to send TX burst on port {} queue {}", m_port_id, m_queue_id);
+    return Status::INTERNAL_ERROR;
+  }
+
+  tx_info->slot_id = rmax_generic_sender::RmaxGenericSenderService::SLOT_NONE;
+  return Status::SUCCESS;
+}
+
+/**
+ * @brief Releases the service memory of a TX burst that was not sent.
+ *
+ * @param burst The burst parameters.
+ */
+void TxBurstsManager::free_tx_burst(BurstParams* burst) {
+  auto* tx_info = get_tx_burst_info(burst);
+  m_tx_service->release_slot(tx_info->slot_id);
+  tx_info->slot_id = rmax_generic_sender::RmaxGenericSenderService::SLOT_NONE;
+  burst->hdr.hdr.num_pkts = 0;
 }
 
 };  // namespace holoscan::advanced_network
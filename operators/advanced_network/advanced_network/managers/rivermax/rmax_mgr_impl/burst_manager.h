@@ -18,18 +18,23 @@
 #ifndef BURST_MANAGER_H_
 #define BURST_MANAGER_H_
 
+#include <atomic>
 #include <cstddef>
 #include <iostream>
+#include <vector>
 
 #include "rmax_ano_data_types.h"
 #include "rmax_service/ipo_chunk_consumer_base.h"
 #include "rmax_service/rmax_ipo_receiver_service.h"
+#include "rmax_service/rmax_generic_sender_service.h"
 #include "advanced_network/types.h"
 #include <holoscan/logger/logger.hpp>
 
 namespace holoscan::advanced_network {
 using namespace ral::services;
 
+class AnoBurstsMemoryPool;
+
 /**
  * @class RmaxBurst
  * @brief Represents a burst of packets in the advanced network.
@@ -256,8 +261,13 @@ class RmaxBurst : public BurstParams {
     hdr.hdr.q_id = queue_id;
   }
 
+  friend class AnoBurstsMemoryPool;
+
  private:
   uint16_t m_max_num_packets = MAX_PKT_IN_BURST;
+  // Intrusive free list of the pool owning the burst
+  std::atomic<uint32_t> m_next_free{0};
+  std::atomic<bool> m_in_pool{false};
 };
 
 /**
@@ -276,19 +286,28 @@ class RmaxBurst::BurstHandler {
   BurstHandler(bool send_packet_ext_info, int port_id, int queue_id, bool gpu_direct);
 
   /**
-   * @brief Creates and initializes a new burst with the given burst ID
+   * @brief Gets the size of the packet arrays of a burst.
+   *
+   * @return The size in bytes, a multiple of the cache line size.
+   */
+  size_t get_packet_arrays_size() const;
+
+  /**
+   * @brief Creates and initializes a new burst with the given burst ID in preallocated memory
    *
    * @param burst_id The ID of the burst to create.
-   * @return A shared pointer to the created burst.
+   * @param burst_memory Memory for the RmaxBurst object.
+   * @param packet_arrays Memory for the packet arrays, of get_packet_arrays_size() bytes.
+   * @return A pointer to the created burst.
    */
-  std::shared_ptr<RmaxBurst> create_burst(uint16_t burst_id);
+  RmaxBurst* create_burst(uint16_t burst_id, void* burst_memory, void* packet_arrays);
 
   /**
-   * @brief Deletes a burst and frees its associated resources.
+   * @brief Deletes a burst, its memory stays owned by the caller.
    *
-   * @param burst A shared pointer to the burst to delete.
+   * @param burst A pointer to the burst to delete.
    */
-  void delete_burst(std::shared_ptr<RmaxBurst> burst);
+  void delete_burst(RmaxBurst* burst);
 
  private:
   bool m_send_packet_ext_info;
@@ -298,6 +317,83 @@ class RmaxBurst::BurstHandler {
   AnoBurstExtendedInfo m_burst_info;
 };
 
+/**
+ * @brief Fixed-capacity pool of RX bursts.
+ *
+ * The bursts and their packet arrays live in a single block allocated once, on the NUMA node
+ * of the RX core when it is known. Free bursts are chained through the bursts themselves in a
+ * lock-free list, so taking and returning a burst neither allocates nor touches a reference
+ * count. The head of the list carries a generation counter against ABA.
+ */
+class AnoBurstsMemoryPool final : public IAnoBurstsCollection {
+ public:
+  AnoBurstsMemoryPool() = delete;
+
+  /**
+   * @brief Constructor with the pool capacity.
+   *
+   * @param size Number of bursts in the pool.
+   * @param burst_handler Reference to the burst handler.
+   * @param tag Tag for the burst.
+   * @param numa_node NUMA node to allocate the bursts on, -1 for the default policy.
+   */
+  AnoBurstsMemoryPool(size_t size, RmaxBurst::BurstHandler& burst_handler, uint32_t tag,
+                      int numa_node = -1);
+
+  /**
+   * @brief Destructor to clean up resources.
+   */
+  ~AnoBurstsMemoryPool();
+
+  /**
+   * @brief Returns a burst to the pool.
+   *
+   * @param burst Pointer to a burst of this pool.
+   * @return true if the burst was put back, false if it is not from the pool or already free.
+   */
+  bool enqueue_burst(RmaxBurst* burst) override;
+
+  /**
+   * @brief Takes a burst from the pool, polling up to GET_BURST_TIMEOUT_MS when it is empty.
+   *
+   * @return A pointer to the burst, or nullptr if no burst was returned in time.
+   */
+  RmaxBurst* dequeue_burst() override;
+
+  size_t available_bursts() override { return m_free_count.load(std::memory_order_relaxed); }
+  bool empty() override { return available_bursts() == 0; }
+
+  /**
+   * @brief Gets the number of bursts in the pool.
+   *
+   * @return The pool capacity.
+   */
+  size_t get_size() const { return m_bursts.size(); }
+
+  /**
+   * @brief Gets the number of times a burst was requested while the pool was empty.
+   *
+   * @return The number of pool exhaustions.
+   */
+  uint64_t get_exhausted_count() const { return m_exhausted.load(std::memory_order_relaxed); }
+
+ private:
+  static constexpr uint32_t FREE_LIST_END = UINT32_MAX;
+
+  RmaxBurst* try_dequeue_burst();
+
+  // Generation in the high half, index of the first free burst in the low half
+  alignas(64) std::atomic<uint64_t> m_free_head{FREE_LIST_END};
+  std::atomic<size_t> m_free_count{0};
+  std::atomic<uint64_t> m_exhausted{0};
+  // Populated once in the constructor and indexed by burst ID, so no locking is needed
+  std::vector<RmaxBurst*> m_bursts;
+  void* m_memory = nullptr;
+  size_t m_memory_size = 0;
+  uint32_t m_bursts_tag = 0;
+  RmaxBurst::BurstHandler& m_burst_handler;
+};
+
 /**
  * @brief Manages RX bursts for advanced networking operations.
  *
@@ -323,10 +419,12 @@ class RxBurstsManager {
    * @param burst_out_size Size of the burst output.
    * @param gpu_id ID of the GPU.
    * @param rx_bursts_out_queue Shared pointer to the output queue for RX bursts.
+   * @param numa_node NUMA node of the RX core the burst pool is allocated on, -1 if unknown.
    */
   RxBurstsManager(bool send_packet_ext_info, int port_id, int queue_id, uint16_t burst_out_size = 0,
                   int gpu_id = INVALID_GPU_ID,
-                  std::shared_ptr<IAnoBurstsCollection> rx_bursts_out_queue = nullptr);
+                  std::shared_ptr<IAnoBurstsCollection> rx_bursts_out_queue = nullptr,
+                  int numa_node = -1);
 
   /**
    * @brief Destructor for the RxBurstsManager class.
@@ -357,6 +455,10 @@ class RxBurstsManager {
    * @return ReturnStatus indicating the success or failure of the operation.
    */
   inline ReturnStatus submit_next_packet(const RmaxPacketData& packet_data) {
+    if (m_burst_cut_mode != RxBurstCutMode::PACKETS) {
+      return submit_next_frame_packet(packet_data);
+    }
+
     get_or_allocate_current_burst();
     if (m_cur_out_burst == nullptr) {
       HOLOSCAN_LOG_ERROR("Failed to allocate burst, running out of resources");
@@ -372,6 +474,19 @@ class RxBurstsManager {
     return ReturnStatus::success;
   }
 
+  /**
+   * @brief Sets where bursts end.
+   *
+   * In the frame modes every burst holds a single frame, up to the burst capacity, and
+   * carries a BurstFrameInfo. The RTP header is read from the header segment with header-data
+   * split, and from the start of the payload otherwise.
+   *
+   * @param mode Burst cut mode.
+   * @param frame_packets Packets per frame in FRAME_PACKETS mode.
+   * @param ext_seq_num Whether the sequence number is extended to 32 bits by the payload header.
+   */
+  void set_burst_cut_mode(RxBurstCutMode mode, uint32_t frame_packets, bool ext_seq_num);
+
   /**
    * @brief Gets an RX burst. Do not use in a case shared queue is used
    *
@@ -384,8 +499,7 @@ class RxBurstsManager {
       throw std::logic_error("Cannot get RX burst when using shared output queue");
     }
 
-    auto out_burst = m_rx_bursts_out_queue->dequeue_burst().get();
-    *burst = static_cast<BurstParams*>(out_burst);
+    *burst = static_cast<BurstParams*>(m_rx_bursts_out_queue->dequeue_burst());
     if (*burst == nullptr) { return ReturnStatus::failure; }
     return ReturnStatus::success;
   }
@@ -397,23 +511,34 @@ class RxBurstsManager {
    */
   void rx_burst_done(RmaxBurst* burst);
 
+  /**
+   * @brief Gets the number of bursts left in the burst pool.
+   *
+   * @return The number of free bursts, out of DEFAULT_NUM_RX_BURSTS.
+   */
+  size_t get_free_bursts() { return m_rx_bursts_mempool->available_bursts(); }
+
+  /**
+   * @brief Gets the number of times the burst pool was found empty.
+   *
+   * @return The number of pool exhaustions.
+   */
+  uint64_t get_pool_exhausted_count() const { return m_rx_bursts_mempool->get_exhausted_count(); }
+
  protected:
   /**
    * @brief Allocates a new burst.
    *
-   * @return Shared pointer to the allocated burst parameters.
+   * @return Pointer to the allocated burst, or nullptr if the pool is exhausted.
    */
-  inline std::shared_ptr<RmaxBurst> allocate_burst() {
-    auto burst = m_rx_bursts_mempool->dequeue_burst();
-    return burst;
-  }
+  inline RmaxBurst* allocate_burst() { return m_rx_bursts_mempool->dequeue_burst(); }
 
   /**
    * @brief Gets or allocates the current burst.
    *
-   * @return Shared pointer to the current burst parameters.
+   * @return Pointer to the current burst.
    */
-  inline std::shared_ptr<RmaxBurst> get_or_allocate_current_burst() {
+  inline RmaxBurst* get_or_allocate_current_burst() {
     if (m_cur_out_burst == nullptr) {
       m_cur_out_burst = allocate_burst();
       if (m_cur_out_burst == nullptr) {
@@ -447,6 +572,22 @@ class RxBurstsManager {
    */
   inline void reset_current_burst() { m_cur_out_burst = nullptr; }
 
+  /**
+   * @brief Submits the next packet in one of the frame burst cut modes.
+   *
+   * @param packet_data Extended information about the packet.
+   * @return ReturnStatus indicating the success or failure of the operation.
+   */
+  ReturnStatus submit_next_frame_packet(const RmaxPacketData& packet_data);
+
+  /**
+   * @brief Closes the current frame burst and sends it to the output queue.
+   *
+   * @param complete Whether the burst ends on a frame boundary.
+   * @return ReturnStatus indicating the success or failure of the operation.
+   */
+  ReturnStatus enqueue_frame_burst(bool complete);
+
  protected:
   bool m_send_packet_ext_info = false;
   int m_port_id = 0;
@@ -458,11 +599,107 @@ class RxBurstsManager {
   size_t m_header_stride_size = 0;
   size_t m_payload_stride_size = 0;
   bool m_using_shared_out_queue = true;
-  std::unique_ptr<IAnoBurstsCollection> m_rx_bursts_mempool = nullptr;
+  std::unique_ptr<AnoBurstsMemoryPool> m_rx_bursts_mempool = nullptr;
   std::shared_ptr<IAnoBurstsCollection> m_rx_bursts_out_queue = nullptr;
-  std::shared_ptr<RmaxBurst> m_cur_out_burst = nullptr;
+  RmaxBurst* m_cur_out_burst = nullptr;
   AnoBurstExtendedInfo m_burst_info;
   std::unique_ptr<RmaxBurst::BurstHandler> m_burst_handler;
+
+  // Frame burst cut state
+  RxBurstCutMode m_burst_cut_mode = RxBurstCutMode::PACKETS;
+  uint32_t m_frame_packets = 0;
+  bool m_ext_seq_num = false;
+  bool m_have_last_packet = false;
+  uint32_t m_last_seq = 0;
+  uint32_t m_last_rtp_timestamp = 0;
+  uint32_t m_frame_position = 0;  // Packets of the current frame received or lost
+};
+
+/**
+ * @brief Manages TX bursts for advanced networking operations.
+ *
+ * The TxBurstsManager class maps advanced_network TX bursts onto memory slots of a
+ * Rivermax generic sender service. A burst acquires a slot in @ref get_tx_packet_burst,
+ * the application fills the packets in place and @ref send_tx_burst commits the slot
+ * to the hardware, which paces the packets according to the configured stream rate.
+ */
+class TxBurstsManager {
+ public:
+  /**
+   * @brief Per-burst TX information stored in the burst header custom data.
+   */
+  struct TxBurstInfo {
+    int slot_id;
+  };
+
+  /**
+   * @brief Constructor for the TxBurstsManager class.
+   *
+   * @param port_id ID of the port.
+   * @param queue_id ID of the queue.
+   * @param tx_service Shared pointer to the generic sender service.
+   */
+  TxBurstsManager(int port_id, int queue_id,
+                  std::shared_ptr<rmax_generic_sender::RmaxGenericSenderService> tx_service);
+
+  virtual ~TxBurstsManager() = default;
+
+  /**
+   * @brief Checks if a TX burst is available.
+   *
+   * @param burst The burst parameters, number of packets must be set.
+   * @return True if a TX burst is available, false otherwise.
+   */
+  bool is_tx_burst_available(BurstParams* burst);
+
+  /**
+   * @brief Assigns service memory to the packets of a TX burst.
+   *
+   * @param burst The burst parameters, number of packets must be set.
+   * @return Status indicating the success or failure of the operation.
+   */
+  Status get_tx_packet_burst(BurstParams* burst);
+
+  /**
+   * @brief Copies payload data into a packet of a TX burst.
+   *
+   * @param burst The burst parameters.
+   * @param idx The packet index.
+   * @param data The payload data.
+   * @param len The length of the payload data.
+   * @return Status indicating the success or failure of the operation.
+   */
+  Status set_udp_payload(BurstParams* burst, int idx, void* data, int len);
+
+  /**
+   * @brief Commits a TX burst to the hardware.
+   *
+   * @param burst The burst parameters.
+   * @return Status indicating the success or failure of the operation.
+   */
+  Status send_tx_burst(BurstParams* burst);
+
+  /**
+   * @brief Releases the service memory of a TX burst that was not sent.
+   *
+   * @param burst The burst parameters.
+   */
+  void free_tx_burst(BurstParams* burst);
+
+  /**
+   * @brief Gets the TX information of a burst.
+   *
+   * @param burst The burst parameters.
+   * @return A pointer to the TX information of the burst.
+   */
+  static inline TxBurstInfo* get_tx_burst_info(BurstParams* burst) {
+    return reinterpret_cast<TxBurstInfo*>(&(burst->hdr.custom_burst_data));
+  }
+
+ private:
+  int m_port_id = 0;
+  int m_queue_id = 0;
+  std::shared_ptr<rmax_generic_sender::RmaxGenericSenderService> m_tx_service;
 };
 
 };  // namespace holoscan::advanced_network
@@ -0,0 +1,325 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2023 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef BURST_QUEUES_H_
+#define BURST_QUEUES_H_
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <thread>
+
+#include "rmax_ano_data_types.h"
+
+namespace holoscan::advanced_network {
+
+/**
+ * @brief A non-blocking queue implementation.
+ *
+ * @tparam T Type of elements stored in the queue.
+ */
+template <typename T>
+class NonBlockingQueue : public QueueInterface<T> {
+  std::queue<T> queue_;
+  mutable std::mutex mutex_;
+
+ public:
+  /**
+   * @brief Enqueues an element into the queue.
+   *
+   * @param value The element to be enqueued.
+   * @return Always true, the queue is unbounded.
+   */
+  bool enqueue(const T& value) override {
+    std::lock_guard<std::mutex> lock(mutex_);
+    queue_.push(value);
+    return true;
+  }
+
+  /**
+   * @brief Tries to dequeue an element from the queue.
+   *
+   * @param value Reference to store the dequeued element.
+   * @return true if an element was dequeued, false otherwise.
+   */
+  bool try_dequeue(T& value) override {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (queue_.empty()) { return false; }
+    value = queue_.front();
+    queue_.pop();
+    return true;
+  }
+
+  /**
+   * @brief Tries to dequeue an element from the queue.
+   *
+   * @param value Reference to store the dequeued element.
+   * @param timeout Timeout for the dequeue operation (ignored).
+   * @return true if an element was dequeued, false otherwise.
+   */
+  bool try_dequeue(T& value, std::chrono::milliseconds timeout) override {
+    return try_dequeue(value);
+  }
+
+  /**
+   * @brief Gets the size of the queue.
+   *
+   * @return The number of elements in the queue.
+   */
+  size_t get_size() const override {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return queue_.size();
+  }
+
+  /**
+   * @brief Clears all elements from the queue.
+   */
+  void clear() override {
+    std::lock_guard<std::mutex> lock(mutex_);
+    while (!queue_.empty()) { queue_.pop(); }
+  }
+};
+
+/**
+ * @brief A blocking queue implementation.
+ *
+ * @tparam T Type of elements stored in the queue.
+ */
+template <typename T>
+class BlockingQueue : public QueueInterface<T> {
+  std::queue<T> queue_;
+  mutable std::mutex mutex_;
+  std::condition_variable cond_;
+
+ public:
+  /**
+   * @brief Enqueues an element into the queue.
+   *
+   * @param value The element to be enqueued.
+   * @return Always true, the queue is unbounded.
+   */
+  bool enqueue(const T& value) override {
+    std::lock_guard<std::mutex> lock(mutex_);
+    queue_.push(value);
+    cond_.notify_one();
+    return true;
+  }
+
+  /**
+   * @brief Tries to dequeue an element from the queue (blocks forever).
+   *
+   * @param value Reference to store the dequeued element.
+   * @return true if an element was dequeued, false otherwise.
+   */
+  bool try_dequeue(T& value) override {
+    std::unique_lock<std::mutex> lock(mutex_);
+    cond_.wait(lock, [this] { return !queue_.empty(); });
+    value = queue_.front();
+    queue_.pop();
+    return true;
+  }
+
+  /**
+   * @brief Tries to dequeue an element from the queue.
+   *
+   * @param value Reference to store the dequeued element.
+   * @param timeout Timeout for the dequeue operation.
+   * @return true if an element was dequeued, false otherwise.
+   */
+  bool try_dequeue(T& value, std::chrono::milliseconds timeout) override {
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (!cond_.wait_for(lock, timeout, [this] { return !queue_.empty(); })) { return false; }
+    value = queue_.front();
+    queue_.pop();
+    return true;
+  }
+
+  /**
+   * @brief Gets the size of the queue.
+   *
+   * @return The number of elements in the queue.
+   */
+  size_t get_size() const override {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return queue_.size();
+  }
+
+  /**
+   * @brief Clears all elements from the queue.
+   */
+  void clear() override {
+    std::lock_guard<std::mutex> lock(mutex_);
+    while (!queue_.empty()) { queue_.pop(); }
+  }
+};
+
+/**
+ * @brief A bounded lock-free queue implementation.
+ *
+ * Ring of cells with per-cell sequence numbers, where producers and consumers only
+ * contend on their own cache-line padded position counter. It is safe for any number
+ * of producers and consumers, which covers the SPSC output queues (IPO receiver thread
+ * to operator thread) and the MPSC burst pools (operator threads returning bursts to
+ * the receiver thread).
+ *
+ * @tparam T Type of elements stored in the queue.
+ */
+template <typename T>
+class LockFreeQueue : public QueueInterface<T> {
+ public:
+  static constexpr size_t CACHE_LINE_SIZE = 64;
+
+  /**
+   * @brief Constructs the queue.
+   *
+   * @param capacity Minimal capacity of the queue, rounded up to a power of two.
+   */
+  explicit LockFreeQueue(size_t capacity) {
+    size_t size = 2;
+    while (size < capacity) { size <<= 1; }
+    mask_ = size - 1;
+    cells_ = std::make_unique<Cell[]>(size);
+    for (size_t i = 0; i < size; i++) { cells_[i].sequence.store(i, std::memory_order_relaxed); }
+  }
+
+  /**
+   * @brief Enqueues an element into the queue.
+   *
+   * @param value The element to be enqueued.
+   * @return true if the element was enqueued, false if the queue is full.
+   */
+  bool enqueue(const T& value) override {
+    size_t pos = enqueue_pos_.value.load(std::memory_order_relaxed);
+    Cell* cell;
+    while (true) {
+      cell = &cells_[pos & mask_];
+      size_t seq = cell->sequence.load(std::memory_order_acquire);
+      intptr_t diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos);
+      if (diff == 0) {
+        if (enqueue_pos_.value.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+          break;
+        }
+      } else if (diff < 0) {
+        return false;
+      } else {
+        pos = enqueue_pos_.value.load(std::memory_order_relaxed);
+      }
+    }
+    cell->data = value;
+    cell->sequence.store(pos + 1, std::memory_order_release);
+    return true;
+  }
+
+  /**
+   * @brief Tries to dequeue an element from the queue.
+   *
+   * @param value Reference to store the dequeued element.
+   * @return true if an element was dequeued, false otherwise.
+   */
+  bool try_dequeue(T& value) override {
+    size_t pos = dequeue_pos_.value.load(std::memory_order_relaxed);
+    Cell* cell;
+    while (true) {
+      cell = &cells_[pos & mask_];
+      size_t seq = cell->sequence.load(std::memory_order_acquire);
+      intptr_t diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos + 1);
+      if (diff == 0) {
+        if (dequeue_pos_.value.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+          break;
+        }
+      } else if (diff < 0) {
+        return false;
+      } else {
+        pos = dequeue_pos_.value.load(std::memory_order_relaxed);
+      }
+    }
+    value = std::move(cell->data);
+    cell->data = T();
+    cell->sequence.store(pos + mask_ + 1, std::memory_order_release);
+    return true;
+  }
+
+  /**
+   * @brief Tries to dequeue an element from the queue, polling until the timeout expires.
+   *
+   * @param value Reference to store the dequeued element.
+   * @param timeout Timeout for the dequeue operation.
+   * @return true if an element was dequeued, false otherwise.
+   */
+  bool try_dequeue(T& value, std::chrono::milliseconds timeout) override {
+    if (try_dequeue(value)) { return true; }
+    if (timeout.count() <= 0) { return false; }
+
+    auto deadline = std::chrono::steady_clock::now() + timeout;
+    do {
+      std::this_thread::yield();
+      if (try_dequeue(value)) { return true; }
+    } while (std::chrono::steady_clock::now() < deadline);
+    return false;
+  }
+
+  /**
+   * @brief Gets the size of the queue.
+   *
+   * The value is exact only when there are no concurrent operations.
+   *
+   * @return The number of elements in the queue.
+   */
+  size_t get_size() const override {
+    size_t enq = enqueue_pos_.value.load(std::memory_order_acquire);
+    size_t deq = dequeue_pos_.value.load(std::memory_order_acquire);
+    return enq > deq ? enq - deq : 0;
+  }
+
+  /**
+   * @brief Clears all elements from the queue.
+   */
+  void clear() override {
+    T value;
+    while (try_dequeue(value)) {}
+  }
+
+  /**
+   * @brief Gets the capacity of the queue.
+   *
+   * @return The maximal number of elements in the queue.
+   */
+  size_t get_capacity() const { return mask_ + 1; }
+
+ private:
+  struct Cell {
+    std::atomic<size_t> sequence;
+    T data;
+  };
+
+  struct alignas(CACHE_LINE_SIZE) PaddedPosition {
+    std::atomic<size_t> value{0};
+  };
+
+  PaddedPosition enqueue_pos_;
+  PaddedPosition dequeue_pos_;
+  std::unique_ptr<Cell[]> cells_;
+  size_t mask_ = 0;
+};
+
+};  // namespace holoscan::advanced_network
+
+#endif /* BURST_QUEUES_H_ */
@@ -15,6 +15,8 @@
  * limitations under the License.
  */
 
+#include <algorithm>
+
 #include "rt_threads.h"
 #include "rmax_ipo_receiver_service.h"
 #include "rmax_mgr_impl/burst_manager.h"
@@ -182,40 +184,51 @@ bool RmaxConfigContainer::parse_configuration(const NetworkConfig& cfg) {
   return true;
 }
 
+/**
+ * @brief Sets the default application settings for a service.
+ *
+ * @param app_settings The application settings to be set.
+ */
+void IConfigManager::set_default_app_settings(AppSettings& app_settings) {
+  app_settings.destination_ip = DESTINATION_IP_DEFAULT;
+  app_settings.destination_port = DESTINATION_PORT_DEFAULT;
+  app_settings.num_of_threads = NUM_OF_THREADS_DEFAULT;
+  app_settings.num_of_total_streams = NUM_OF_TOTAL_STREAMS_DEFAULT;
+  app_settings.num_of_total_flows = NUM_OF_TOTAL_FLOWS_DEFAULT;
+  app_settings.internal_thread_core = CPU_NONE;
+  app_settings.app_threads_cores = std::vector<int>(app_settings.num_of_threads, CPU_NONE);
+  app_settings.rate = {0, 0};
+  app_settings.num_of_chunks = NUM_OF_CHUNKS_DEFAULT;
+  app_settings.num_of_packets_in_chunk = NUM_OF_PACKETS_IN_CHUNK_DEFAULT;
+  app_settings.packet_payload_size = PACKET_PAYLOAD_SIZE_DEFAULT;
+  app_settings.packet_app_header_size = PACKET_APP_HEADER_SIZE_DEFAULT;
+  app_settings.sleep_between_operations_us = SLEEP_BETWEEN_OPERATIONS_US_DEFAULT;
+  app_settings.sleep_between_operations = false;
+  app_settings.print_parameters = false;
+  app_settings.use_checksum_header = false;
+  app_settings.hw_queue_full_sleep_us = 0;
+  app_settings.gpu_id = INVALID_GPU_ID;
+  app_settings.allocator_type = AllocatorTypeUI::Auto;
+  app_settings.statistics_reader_core = INVALID_CORE_NUMBER;
+  app_settings.session_id_stats = UINT_MAX;
+}
+
 /**
  * @brief Sets the default configuration for an RX service.
  *
  * @param rx_service_cfg The RX service configuration to be set.
  */
 void RxConfigManager::set_default_config(ExtRmaxIPOReceiverConfig& rx_service_cfg) const {
-  rx_service_cfg.app_settings->destination_ip = DESTINATION_IP_DEFAULT;
-  rx_service_cfg.app_settings->destination_port = DESTINATION_PORT_DEFAULT;
-  rx_service_cfg.app_settings->num_of_threads = NUM_OF_THREADS_DEFAULT;
-  rx_service_cfg.app_settings->num_of_total_streams = NUM_OF_TOTAL_STREAMS_DEFAULT;
-  rx_service_cfg.app_settings->num_of_total_flows = NUM_OF_TOTAL_FLOWS_DEFAULT;
-  rx_service_cfg.app_settings->internal_thread_core = CPU_NONE;
-  rx_service_cfg.app_settings->app_threads_cores =
-      std::vector<int>(rx_service_cfg.app_settings->num_of_threads, CPU_NONE);
-  rx_service_cfg.app_settings->rate = {0, 0};
-  rx_service_cfg.app_settings->num_of_chunks = NUM_OF_CHUNKS_DEFAULT;
-  rx_service_cfg.app_settings->num_of_packets_in_chunk = NUM_OF_PACKETS_IN_CHUNK_DEFAULT;
-  rx_service_cfg.app_settings->packet_payload_size = PACKET_PAYLOAD_SIZE_DEFAULT;
-  rx_service_cfg.app_settings->packet_app_header_size = PACKET_APP_HEADER_SIZE_DEFAULT;
-  rx_service_cfg.app_settings->sleep_between_operations_us = SLEEP_BETWEEN_OPERATIONS_US_DEFAULT;
-  rx_service_cfg.app_settings->sleep_between_operations = false;
-  rx_service_cfg.app_settings->print_parameters = false;
-  rx_service_cfg.app_settings->use_checksum_header = false;
-  rx_service_cfg.app_settings->hw_queue_full_sleep_us = 0;
-  rx_service_cfg.app_settings->gpu_id = INVALID_GPU_ID;
-  rx_service_cfg.app_settings->allocator_type = AllocatorTypeUI::Auto;
-  rx_service_cfg.app_settings->statistics_reader_core = INVALID_CORE_NUMBER;
-  rx_service_cfg.app_settings->session_id_stats = UINT_MAX;
+  set_default_app_settings(*rx_service_cfg.app_settings);
   rx_service_cfg.is_extended_sequence_number = true;
   rx_service_cfg.max_path_differential_us = 0;
+  rx_service_cfg.path_stats = true;
   rx_service_cfg.register_memory = false;
   rx_service_cfg.max_chunk_size = 0;
   rx_service_cfg.rmax_apps_lib = nullptr;
   rx_service_cfg.rx_stats_period_report_ms = 1000;
+  rx_service_cfg.burst_cut_mode = RxBurstCutMode::PACKETS;
+  rx_service_cfg.frame_packets = 0;
 }
 
 /**
@@ -331,7 +344,11 @@ bool RxConfigManager::config_memory_allocator_from_dual_mrs(RmaxRxQueueConfig& r
                                                             const RxQueueConfig& q,
                                                             const MemoryRegionConfig& mr_header,
                                                             const MemoryRegionConfig& mr_payload) {
-  rmax_rx_config.split_boundary = mr_header.buf_size_;
+  // The header region must hold the split boundary, as with the DPDK manager
+  rmax_rx_config.split_boundary =
+      q.common_.split_boundary_ > 0
+          ? std::min<size_t>(q.common_.split_boundary_, mr_header.buf_size_)
+          : mr_header.buf_size_;
   rmax_rx_config.max_packet_size = mr_payload.buf_size_;
   rmax_rx_config.packets_buffers_size = mr_payload.num_bufs_;
 
@@ -586,8 +603,8 @@ void RxConfigManager::set_rx_service_common_app_settings(AppSettings& app_settin
  * @param app_settings_config The application settings configuration.
  * @param allocator_type The allocator type string.
  */
-void RxConfigManager::set_allocator_type(AppSettings& app_settings_config,
-                                         const std::string& allocator_type) {
+void IConfigManager::set_allocator_type(AppSettings& app_settings_config,
+                                        const std::string& allocator_type) {
   auto setAllocatorType = [&](const std::string& allocatorTypeStr, AllocatorTypeUI allocatorType) {
     if (allocator_type == allocatorTypeStr) { app_settings_config.allocator_type = allocatorType; }
   };
@@ -609,8 +626,8 @@ void RxConfigManager::set_allocator_type(AppSettings& app_settings_config,
  * @param cores The cores configuration string.
  * @return True if the cores are successfully parsed and set, false otherwise.
  */
-bool RxConfigManager::parse_and_set_cores(AppSettings& app_settings_config,
-                                          const std::string& cores) {
+bool IConfigManager::parse_and_set_cores(AppSettings& app_settings_config,
+                                         const std::string& cores) {
   std::istringstream iss(cores);
   std::string coreStr;
   bool to_reset_cores_vector = true;
@@ -648,6 +665,7 @@ void RxConfigManager::set_rx_service_ipo_receiver_settings(
     ExtRmaxIPOReceiverConfig& rx_service_cfg, const RmaxRxQueueConfig& rmax_rx_config) {
   rx_service_cfg.is_extended_sequence_number = rmax_rx_config.ext_seq_num;
   rx_service_cfg.max_path_differential_us = rmax_rx_config.max_path_differential_us;
+  rx_service_cfg.path_stats = rmax_rx_config.path_stats;
   if (rx_service_cfg.max_path_differential_us >= USECS_IN_SECOND) {
     HOLOSCAN_LOG_ERROR("Max path differential must be less than 1 second");
     rx_service_cfg.max_path_differential_us = USECS_IN_SECOND;
@@ -659,6 +677,8 @@ void RxConfigManager::set_rx_service_ipo_receiver_settings(
   rx_service_cfg.rmax_apps_lib = this->rmax_apps_lib_;
 
   rx_service_cfg.send_packet_ext_info = rmax_rx_config.send_packet_ext_info;
+  rx_service_cfg.burst_cut_mode = rmax_rx_config.burst_cut_mode;
+  rx_service_cfg.frame_packets = rmax_rx_config.frame_packets;
 }
 
 /**
@@ -701,8 +721,195 @@ bool TxConfigManager::append_candidate_for_tx_queue(uint16_t port_id, const TxQu
     return false;
   }
 
-  // TODO: Implement when TX is ready
-  return false;
+  // extra queue config_ contains RMAX configuration. If it is not set, return false
+  if (!q.common_.extra_queue_config_) return false;
+
+  auto* rmax_tx_config_ptr = dynamic_cast<RmaxTxQueueConfig*>(q.common_.extra_queue_config_);
+  if (!rmax_tx_config_ptr) {
+    HOLOSCAN_LOG_ERROR("Failed to cast extra queue config to RmaxTxQueueConfig");
+    return false;
+  }
+
+  RmaxTxQueueConfig rmax_tx_config(*rmax_tx_config_ptr);
+
+  if (!validate_tx_queue_config(rmax_tx_config)) { return false; }
+
+  if (!config_memory_allocator(rmax_tx_config, q)) { return false; }
+
+  rmax_tx_config.dump_parameters();
+
+  RmaxGenericSenderConfig tx_service_cfg;
+
+  if (!build_rmax_generic_sender_config(tx_service_cfg, rmax_tx_config, q)) { return false; }
+
+  return add_new_tx_service_config(tx_service_cfg, port_id, q.common_.id_);
+}
+
+/**
+ * @brief Validates the TX queue configuration.
+ *
+ * @param rmax_tx_config The Rmax TX queue configuration.
+ * @return True if the configuration is valid, false otherwise.
+ */
+bool TxConfigManager::validate_tx_queue_config(const RmaxTxQueueConfig& rmax_tx_config) {
+  if (rmax_tx_config.local_ip.empty()) {
+    HOLOSCAN_LOG_ERROR("Local IP address is not set for TX stream");
+    return false;
+  }
+
+  if (rmax_tx_config.destination_ip.empty()) {
+    HOLOSCAN_LOG_ERROR("Destination IP address is not set for TX stream");
+    return false;
+  }
+
+  if (rmax_tx_config.destination_port == 0) {
+    HOLOSCAN_LOG_ERROR("Destination port is not set for TX stream");
+    return false;
+  }
+
+  if (rmax_tx_config.max_chunk_size == 0 ||
+      rmax_tx_config.max_chunk_size > RmaxBurst::MAX_PKT_IN_BURST) {
+    HOLOSCAN_LOG_ERROR("Invalid batch size for TX stream: {} [1..{}]",
+                       rmax_tx_config.max_chunk_size,
+                       RmaxBurst::MAX_PKT_IN_BURST);
+    return false;
+  }
+
+  if (rmax_tx_config.rate_gbps < 0) {
+    HOLOSCAN_LOG_ERROR("Invalid rate for TX stream: {} Gbps", rmax_tx_config.rate_gbps);
+    return false;
+  }
+
+  return true;
+}
+
+/**
+ * @brief Configures the memory allocator for the RMAX TX queue.
+ *
+ * @param rmax_tx_config The RMAX TX queue configuration.
+ * @param q The TX queue configuration.
+ * @return true if the configuration is successful, false otherwise.
+ */
+bool TxConfigManager::config_memory_allocator(RmaxTxQueueConfig& rmax_tx_config,
+                                              const TxQueueConfig& q) {
+  uint16_t num_of_mrs = q.common_.mrs_.size();
+  if (num_of_mrs != 1 && num_of_mrs != 2) {
+    HOLOSCAN_LOG_ERROR("Incompatible number of memory regions for Rivermax TX queue: {} [1..{}]",
+                       num_of_mrs,
+                       MAX_RMAX_MEMORY_REGIONS);
+    return false;
+  }
+
+  const MemoryRegionConfig* mr_header = nullptr;
+  const MemoryRegionConfig* mr_payload = nullptr;
+  try {
+    mr_payload = &cfg_.mrs_.at(q.common_.mrs_[num_of_mrs - 1]);
+    if (num_of_mrs == 2) { mr_header = &cfg_.mrs_.at(q.common_.mrs_[0]); }
+  } catch (const std::out_of_range& e) {
+    HOLOSCAN_LOG_ERROR("Invalid memory region for Rivermax TX queue: {}", q.common_.name_);
+    return false;
+  }
+
+  if (mr_header && mr_header->kind_ == MemoryKind::DEVICE) {
+    HOLOSCAN_LOG_ERROR("Header memory region of Rivermax TX queue must reside in host memory");
+    return false;
+  }
+
+  rmax_tx_config.split_boundary = mr_header ? mr_header->buf_size_ : 0;
+  rmax_tx_config.max_packet_size = mr_payload->buf_size_;
+  rmax_tx_config.packets_buffers_size = mr_payload->num_bufs_;
+
+  if (mr_payload->kind_ == MemoryKind::DEVICE) {
+    if (!mr_header) {
+      HOLOSCAN_LOG_ERROR("GPU memory for Rivermax TX queue requires header-data split");
+      return false;
+    }
+    rmax_tx_config.gpu_device_id = mr_payload->affinity_;
+    rmax_tx_config.gpu_direct = true;
+  } else {
+    rmax_tx_config.gpu_device_id = -1;
+    rmax_tx_config.gpu_direct = false;
+  }
+
+  const MemoryRegionConfig& mr_cpu = mr_header ? *mr_header : *mr_payload;
+  if (mr_cpu.kind_ == MemoryKind::HOST || mr_cpu.kind_ == MemoryKind::HOST_PINNED) {
+    rmax_tx_config.allocator_type = "malloc";
+  } else if (mr_cpu.kind_ == MemoryKind::HUGE &&
+             rmax_tx_config.allocator_type.rfind("huge_page", 0) != 0) {
+    rmax_tx_config.allocator_type = "huge_page_default";
+  }
+
+  return true;
+}
+
+/**
+ * @brief Builds the Rmax generic sender configuration.
+ *
+ * @param tx_service_cfg The TX service configuration to be built.
+ * @param rmax_tx_config The Rmax TX queue configuration.
+ * @param q The TX queue configuration.
+ * @return True if the configuration is successful, false otherwise.
+ */
+bool TxConfigManager::build_rmax_generic_sender_config(RmaxGenericSenderConfig& tx_service_cfg,
+                                                       const RmaxTxQueueConfig& rmax_tx_config,
+                                                       const TxQueueConfig& q) {
+  tx_service_cfg.app_settings = std::make_shared<AppSettings>();
+  auto& app_settings_config = *(tx_service_cfg.app_settings);
+  set_default_app_settings(app_settings_config);
+
+  app_settings_config.local_ip = rmax_tx_config.local_ip;
+  app_settings_config.destination_ip = rmax_tx_config.destination_ip;
+  app_settings_config.destination_port = rmax_tx_config.destination_port;
+  app_settings_config.gpu_id =
+      rmax_tx_config.gpu_direct ? rmax_tx_config.gpu_device_id : INVALID_GPU_ID;
+  set_allocator_type(app_settings_config, rmax_tx_config.allocator_type);
+
+  if (cfg_.common_.master_core_ >= 0 &&
+      cfg_.common_.master_core_ < std::thread::hardware_concurrency()) {
+    app_settings_config.internal_thread_core = cfg_.common_.master_core_;
+  }
+  app_settings_config.print_parameters = rmax_tx_config.print_parameters;
+  app_settings_config.packet_payload_size = rmax_tx_config.max_packet_size;
+  app_settings_config.packet_app_header_size = rmax_tx_config.split_boundary;
+
+  if (!parse_and_set_cores(app_settings_config, q.common_.cpu_core_)) { return false; }
+
+  tx_service_cfg.register_memory = rmax_tx_config.memory_registration;
+  tx_service_cfg.max_chunk_size = rmax_tx_config.max_chunk_size;
+  tx_service_cfg.num_of_slots =
+      std::max<size_t>(2, rmax_tx_config.packets_buffers_size / rmax_tx_config.max_chunk_size);
+  tx_service_cfg.rate_bps = static_cast<uint64_t>(rmax_tx_config.rate_gbps * 1e9);
+  tx_service_cfg.max_burst_packets = rmax_tx_config.max_burst_packets;
+  tx_service_cfg.dscp = rmax_tx_config.dscp;
+  tx_service_cfg.rmax_apps_lib = this->rmax_apps_lib_;
+
+  return true;
+}
+
+/**
+ * @brief Adds a new TX service configuration to the configuration map.
+ *
+ * @param tx_service_cfg The TX service configuration.
+ * @param port_id The port ID.
+ * @param queue_id The queue ID.
+ * @return True if the configuration was added, false if it already exists.
+ */
+bool TxConfigManager::add_new_tx_service_config(const RmaxGenericSenderConfig& tx_service_cfg,
+                                                uint16_t port_id, uint16_t queue_id) {
+  uint32_t key = RmaxBurst::burst_tag_from_port_and_queue_id(port_id, queue_id);
+  if (tx_service_configs_.find(key) != tx_service_configs_.end()) {
+    HOLOSCAN_LOG_ERROR(
+        "Rivermax advanced_network TX settings for port {} and queue {} already exists",
+        port_id,
+        queue_id);
+    return false;
+  }
+  HOLOSCAN_LOG_INFO("Rivermax advanced_network TX settings for port {} and queue {} added",
+                    port_id,
+                    queue_id);
+
+  tx_service_configs_[key] = tx_service_cfg;
+  return true;
 }
 
 /**
@@ -745,6 +952,7 @@ Status RmaxConfigParser::parse_rx_queue_rivermax_config(const YAML::Node& q_item
 
   rmax_rx_config.ext_seq_num = rmax_rx_settings["ext_seq_num"].as<bool>(true);
   rmax_rx_config.max_path_differential_us = rmax_rx_settings["max_path_diff_us"].as<uint32_t>(0);
+  rmax_rx_config.path_stats = rmax_rx_settings["path_stats"].as<bool>(true);
   rmax_rx_config.allocator_type = rmax_rx_settings["allocator_type"].as<std::string>("auto");
   rmax_rx_config.memory_registration = rmax_rx_settings["memory_registration"].as<bool>(false);
   rmax_rx_config.sleep_between_operations_us =
@@ -755,6 +963,19 @@ Status RmaxConfigParser::parse_rx_queue_rivermax_config(const YAML::Node& q_item
   rmax_rx_config.max_chunk_size = q_item["batch_size"].as<size_t>(1024);
   rmax_rx_config.rx_stats_period_report_ms =
       rmax_rx_settings["rx_stats_period_report_ms"].as<uint32_t>(0);
+
+  const auto burst_cut = rmax_rx_settings["burst_cut"].as<std::string>("packets");
+  if (!rx_burst_cut_mode_from_string(burst_cut, rmax_rx_config.burst_cut_mode)) {
+    HOLOSCAN_LOG_ERROR("Invalid burst_cut {}, expected packets/rtp_marker/frame_packets",
+                       burst_cut);
+    return Status::INVALID_PARAMETER;
+  }
+  rmax_rx_config.frame_packets = rmax_rx_settings["frame_packets"].as<uint32_t>(0);
+  if (rmax_rx_config.burst_cut_mode == RxBurstCutMode::FRAME_PACKETS &&
+      rmax_rx_config.frame_packets == 0) {
+    HOLOSCAN_LOG_ERROR("frame_packets must be set with burst_cut frame_packets");
+    return Status::INVALID_PARAMETER;
+  }
   return Status::SUCCESS;
 }
 
@@ -767,6 +988,26 @@ Status RmaxConfigParser::parse_rx_queue_rivermax_config(const YAML::Node& q_item
  */
 Status RmaxConfigParser::parse_tx_queue_rivermax_config(const YAML::Node& q_item,
                                                         TxQueueConfig& q) {
+  const auto& rmax_tx_settings = q_item["rmax_tx_settings"];
+
+  if (!rmax_tx_settings) {
+    HOLOSCAN_LOG_ERROR("Rmax TX settings not found");
+    return Status::INVALID_PARAMETER;
+  }
+
+  q.common_.extra_queue_config_ = new RmaxTxQueueConfig();
+  auto& rmax_tx_config = *(reinterpret_cast<RmaxTxQueueConfig*>(q.common_.extra_queue_config_));
+
+  rmax_tx_config.local_ip = rmax_tx_settings["local_ip_address"].as<std::string>("");
+  rmax_tx_config.destination_ip = rmax_tx_settings["destination_ip_address"].as<std::string>("");
+  rmax_tx_config.destination_port = rmax_tx_settings["destination_port"].as<uint16_t>(0);
+  rmax_tx_config.rate_gbps = rmax_tx_settings["rate_gbps"].as<double>(0.0);
+  rmax_tx_config.max_burst_packets = rmax_tx_settings["max_burst_packets"].as<uint32_t>(0);
+  rmax_tx_config.dscp = rmax_tx_settings["dscp"].as<uint16_t>(0);
+  rmax_tx_config.allocator_type = rmax_tx_settings["allocator_type"].as<std::string>("auto");
+  rmax_tx_config.memory_registration = rmax_tx_settings["memory_registration"].as<bool>(true);
+  rmax_tx_config.print_parameters = rmax_tx_settings["verbose"].as<bool>(false);
+  rmax_tx_config.max_chunk_size = q_item["batch_size"].as<size_t>(1024);
   return Status::SUCCESS;
 }
 
@@ -794,9 +1035,36 @@ void RmaxRxQueueConfig::dump_parameters() const {
     HOLOSCAN_LOG_INFO("\t\text_seq_num: {}", ext_seq_num);
     HOLOSCAN_LOG_INFO("\t\tsleep_between_operations_us: {}", sleep_between_operations_us);
     HOLOSCAN_LOG_INFO("\t\tmax_path_differential_us: {}", max_path_differential_us);
+    HOLOSCAN_LOG_INFO("\t\tpath_stats: {}", path_stats);
     HOLOSCAN_LOG_INFO("\t\tnum_of_threads: {}", num_of_threads);
     HOLOSCAN_LOG_INFO("\t\tsend_packet_ext_info: {}", send_packet_ext_info);
     HOLOSCAN_LOG_INFO("\t\trx_stats_period_report_ms: {}", rx_stats_period_report_ms);
+    HOLOSCAN_LOG_INFO("\t\tburst_cut: {}", static_cast<int>(burst_cut_mode));
+    HOLOSCAN_LOG_INFO("\t\tframe_packets: {}", frame_packets);
+  }
+}
+
+void RmaxTxQueueConfig::dump_parameters() const {
+  if (this->print_parameters) {
+    HOLOSCAN_LOG_INFO("Rivermax TX Queue Config:");
+    HOLOSCAN_LOG_INFO("\tNetwork settings:");
+    HOLOSCAN_LOG_INFO("\t\tlocal_ip: {}", local_ip);
+    HOLOSCAN_LOG_INFO("\t\tdestination_ip: {}", destination_ip);
+    HOLOSCAN_LOG_INFO("\t\tdestination_port: {}", destination_port);
+    HOLOSCAN_LOG_INFO("\t\trate_gbps: {}", rate_gbps);
+    HOLOSCAN_LOG_INFO("\t\tmax_burst_packets: {}", max_burst_packets);
+    HOLOSCAN_LOG_INFO("\t\tdscp: {}", dscp);
+    HOLOSCAN_LOG_INFO("\tGPU settings:");
+    HOLOSCAN_LOG_INFO("\t\tGPU ID: {}", gpu_device_id);
+    HOLOSCAN_LOG_INFO("\t\tGPU Direct: {}", gpu_direct);
+    HOLOSCAN_LOG_INFO("\tMemory config settings:");
+    HOLOSCAN_LOG_INFO("\t\tallocator_type: {}", allocator_type);
+    HOLOSCAN_LOG_INFO("\t\tmemory_registration: {}", memory_registration);
+    HOLOSCAN_LOG_INFO("\tPacket settings:");
+    HOLOSCAN_LOG_INFO("\t\tbatch_size/max_chunk_size: {}", max_chunk_size);
+    HOLOSCAN_LOG_INFO("\t\tsplit_boundary/header_size: {}", split_boundary);
+    HOLOSCAN_LOG_INFO("\t\tmax_packet_size: {}", max_packet_size);
+    HOLOSCAN_LOG_INFO("\t\tpackets_buffers_size: {}", packets_buffers_size);
   }
 }
 
@@ -27,10 +27,12 @@
 #include "advanced_network/manager.h"
 #include "rmax_ano_data_types.h"
 #include "rmax_ipo_receiver_service.h"
+#include "rmax_generic_sender_service.h"
 
 namespace holoscan::advanced_network {
 
 using namespace ral::services::rmax_ipo_receiver;
+using namespace ral::services::rmax_generic_sender;
 
 /**
  * @brief Configuration structure for Rmax RX queue.
@@ -55,9 +57,12 @@ struct RmaxRxQueueConfig : public ManagerExtraQueueConfig {
   int sleep_between_operations_us;
   std::string allocator_type;
   bool ext_seq_num;
+  bool path_stats = true;
   bool memory_registration;
   bool send_packet_ext_info;
   uint32_t rx_stats_period_report_ms;
+  RxBurstCutMode burst_cut_mode = RxBurstCutMode::PACKETS;
+  uint32_t frame_packets = 0;
 
  public:
   RmaxRxQueueConfig() = default;
@@ -81,9 +86,12 @@ struct RmaxRxQueueConfig : public ManagerExtraQueueConfig {
         sleep_between_operations_us(other.sleep_between_operations_us),
         allocator_type(other.allocator_type),
         ext_seq_num(other.ext_seq_num),
+        path_stats(other.path_stats),
         memory_registration(other.memory_registration),
         send_packet_ext_info(other.send_packet_ext_info),
-        rx_stats_period_report_ms(other.rx_stats_period_report_ms) {}
+        rx_stats_period_report_ms(other.rx_stats_period_report_ms),
+        burst_cut_mode(other.burst_cut_mode),
+        frame_packets(other.frame_packets) {}
 
   RmaxRxQueueConfig& operator=(const RmaxRxQueueConfig& other) {
     if (this != &other) {
@@ -104,9 +112,12 @@ struct RmaxRxQueueConfig : public ManagerExtraQueueConfig {
       sleep_between_operations_us = other.sleep_between_operations_us;
       allocator_type = other.allocator_type;
       ext_seq_num = other.ext_seq_num;
+      path_stats = other.path_stats;
       memory_registration = other.memory_registration;
       send_packet_ext_info = other.send_packet_ext_info;
       rx_stats_period_report_ms = other.rx_stats_period_report_ms;
+      burst_cut_mode = other.burst_cut_mode;
+      frame_packets = other.frame_packets;
     }
     return *this;
   }
@@ -114,11 +125,45 @@ struct RmaxRxQueueConfig : public ManagerExtraQueueConfig {
   void dump_parameters() const;
 };
 
+/**
+ * @brief Configuration structure for Rmax TX queue.
+ *
+ * This structure holds the configuration settings for an Rmax TX queue sent with the
+ * Rivermax generic API, including packet size, chunk size, IP addresses, port and rate.
+ */
+struct RmaxTxQueueConfig : public ManagerExtraQueueConfig {
+  uint16_t max_packet_size = 0;
+  size_t max_chunk_size;
+  size_t packets_buffers_size;
+  bool gpu_direct;
+  int gpu_device_id;
+  uint16_t split_boundary;
+  std::string local_ip;
+  std::string destination_ip;
+  uint16_t destination_port;
+  bool print_parameters;
+  std::string allocator_type;
+  bool memory_registration;
+  double rate_gbps;
+  uint32_t max_burst_packets;
+  uint8_t dscp;
+
+ public:
+  RmaxTxQueueConfig() = default;
+  ~RmaxTxQueueConfig() = default;
+  RmaxTxQueueConfig(const RmaxTxQueueConfig& other) = default;
+  RmaxTxQueueConfig& operator=(const RmaxTxQueueConfig& other) = default;
+
+  void dump_parameters() const;
+};
+
 /**
  * @brief Extended configuration for Rmax IPO Receiver.
  */
 struct ExtRmaxIPOReceiverConfig : RmaxIPOReceiverConfig {
   bool send_packet_ext_info;
+  RxBurstCutMode burst_cut_mode;
+  uint32_t frame_packets;
 };
 
 /**
@@ -145,6 +190,32 @@ class IConfigManager {
    */
   virtual bool set_configuration(const NetworkConfig& cfg,
                                  std::shared_ptr<ral::lib::RmaxAppsLibFacade> rmax_apps_lib) = 0;
+
+ protected:
+  /**
+   * @brief Sets the allocator type for the application settings.
+   *
+   * @param app_settings_config The application settings configuration to set.
+   * @param allocator_type The allocator type to set.
+   */
+  static void set_allocator_type(AppSettings& app_settings_config,
+                                 const std::string& allocator_type);
+
+  /**
+   * @brief Parses and sets the cores for the application settings.
+   *
+   * @param app_settings_config The application settings configuration to set.
+   * @param cores The cores to parse and set.
+   * @return True if the cores were successfully parsed and set, false otherwise.
+   */
+  static bool parse_and_set_cores(AppSettings& app_settings_config, const std::string& cores);
+
+  /**
+   * @brief Sets the default application settings for a service.
+   *
+   * @param app_settings The application settings to set defaults for.
+   */
+  static void set_default_app_settings(AppSettings& app_settings);
 };
 
 /**
@@ -189,7 +260,7 @@ class IRxConfigManager : public IConfigManager {
  */
 class ITxConfigManager : public IConfigManager {
  public:
-  using ConstIterator = IConfigManager::ConstIterator<RmaxBaseServiceConfig>;
+  using ConstIterator = IConfigManager::ConstIterator<RmaxGenericSenderConfig>;
 
   /**
    * @brief Gets the beginning iterator for TX configurations.
@@ -391,23 +462,6 @@ class RxConfigManager : public IRxConfigManager {
   void set_rx_service_common_app_settings(AppSettings& app_settings_config,
                                           const RmaxRxQueueConfig& rmax_rx_config);
 
-  /**
-   * @brief Sets the allocator type for the application settings.
-   *
-   * @param app_settings_config The application settings configuration to set.
-   * @param allocator_type The allocator type to set.
-   */
-  void set_allocator_type(AppSettings& app_settings_config, const std::string& allocator_type);
-
-  /**
-   * @brief Parses and sets the cores for the application settings.
-   *
-   * @param app_settings_config The application settings configuration to set.
-   * @param cores The cores to parse and set.
-   * @return True if the cores were successfully parsed and set, false otherwise.
-   */
-  bool parse_and_set_cores(AppSettings& app_settings_config, const std::string& cores);
-
   /**
    * @brief Sets the IPO receiver settings for an RX service.
    *
@@ -442,7 +496,7 @@ class RxConfigManager : public IRxConfigManager {
  */
 class TxConfigManager : public ITxConfigManager {
  public:
-  using ConstIterator = IConfigManager::ConstIterator<RmaxBaseServiceConfig>;
+  using ConstIterator = IConfigManager::ConstIterator<RmaxGenericSenderConfig>;
 
   ConstIterator begin() const override { return tx_service_configs_.begin(); }
   ConstIterator end() const override { return tx_service_configs_.end(); }
@@ -473,7 +527,51 @@ class TxConfigManager : public ITxConfigManager {
   bool append_candidate_for_tx_queue(uint16_t port_id, const TxQueueConfig& q) override;
 
  private:
-  std::unordered_map<uint32_t, RmaxBaseServiceConfig> tx_service_configs_;
+  /**
+   * @brief Validates the TX queue configuration.
+   *
+   * @param rmax_tx_config The Rmax TX queue configuration to validate.
+   * @return True if the configuration is valid, false otherwise.
+   */
+  bool validate_tx_queue_config(const RmaxTxQueueConfig& rmax_tx_config);
+
+  /**
+   * @brief Configures the memory allocator for the RMAX TX queue.
+   *
+   * A single memory region is used for both headers and payload. Two memory regions
+   * enable header-data split, with the payload optionally residing in GPU memory.
+   *
+   * @param rmax_tx_config The RMAX TX queue configuration.
+   * @param q The TX queue configuration.
+   * @return true if the configuration is successful, false otherwise.
+   */
+  bool config_memory_allocator(RmaxTxQueueConfig& rmax_tx_config, const TxQueueConfig& q);
+
+  /**
+   * @brief Builds the Rmax generic sender configuration.
+   *
+   * @param tx_service_cfg The TX service configuration to build.
+   * @param rmax_tx_config The Rmax TX queue configuration.
+   * @param q The TX queue configuration.
+   * @return True if the configuration was successfully built, false otherwise.
+   */
+  bool build_rmax_generic_sender_config(RmaxGenericSenderConfig& tx_service_cfg,
+                                        const RmaxTxQueueConfig& rmax_tx_config,
+                                        const TxQueueConfig& q);
+
+  /**
+   * @brief Adds a new TX service configuration.
+   *
+   * @param tx_service_cfg The TX service configuration to add.
+   * @param port_id The port ID.
+   * @param queue_id The queue ID.
+   * @return True if the configuration was added, false if it already exists.
+   */
+  bool add_new_tx_service_config(const RmaxGenericSenderConfig& tx_service_cfg, uint16_t port_id,
+                                 uint16_t queue_id);
+
+ private:
+  std::unordered_map<uint32_t, RmaxGenericSenderConfig> tx_service_configs_;
   NetworkConfig cfg_;
   std::shared_ptr<ral::lib::RmaxAppsLibFacade> rmax_apps_lib_ = nullptr;
   bool is_configuration_set_ = false;
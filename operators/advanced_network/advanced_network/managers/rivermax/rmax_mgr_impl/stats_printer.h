@@ -23,7 +23,9 @@
 #include <vector>
 
 #include "advanced_network/manager.h"
+#include "rmax_mgr_impl/burst_manager.h"
 #include "rmax_ipo_receiver_service.h"
+#include "rmax_generic_sender_service.h"
 
 namespace holoscan::advanced_network {
 
@@ -98,6 +100,44 @@ class IpoRxStatsPrinter {
   }
 };
 
+class GenericTxStatsPrinter {
+ public:
+  /**
+   * @brief Prints the TX statistics of the Rmax manager.
+   */
+  static void print_total_stats(
+      std::stringstream& ss,
+      std::unordered_map<
+          uint32_t, std::shared_ptr<ral::services::rmax_generic_sender::RmaxGenericSenderService>>&
+          tx_services) {
+    if (tx_services.empty()) { return; }
+
+    ss << "TX Statistics\n";
+    ss << "-------------\n";
+    for (const auto& entry : tx_services) {
+      auto stats = entry.second->get_stream_statistics();
+      ss << "[port " << RmaxBurst::burst_port_id_from_burst_tag(entry.first) << " queue "
+         << RmaxBurst::burst_queue_id_from_burst_tag(entry.first) << "]"
+         << " Sent " << std::setw(7) << stats.committed_packets << " packets | ";
+
+      if (stats.committed_bytes >= IpoRxStatsPrinter::GIGABYTE) {
+        ss << std::fixed << std::setprecision(2)
+           << (stats.committed_bytes / IpoRxStatsPrinter::GIGABYTE) << " GB |";
+      } else if (stats.committed_bytes >= IpoRxStatsPrinter::MEGABYTE) {
+        ss << std::fixed << std::setprecision(2)
+           << (stats.committed_bytes / IpoRxStatsPrinter::MEGABYTE) << " MB |";
+      } else {
+        ss << stats.committed_bytes << " bytes |";
+      }
+
+      ss << " chunks: " << stats.committed_chunks << " |"
+         << " no free chunk: " << stats.no_free_chunk << " |"
+         << " HW queue full: " << stats.hw_queue_full << " |"
+         << " no free slot: " << stats.no_free_slot << "\n";
+    }
+  }
+};
+
 };  // namespace holoscan::advanced_network
 
 #endif  // STATS_PRINTER_H
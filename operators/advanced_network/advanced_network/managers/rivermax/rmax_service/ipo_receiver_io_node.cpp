@@ -49,14 +49,24 @@ static constexpr uint32_t SEQUENCE_NUMBER_MASK_32BIT = 0xFFFFFFFF;
 
 AppIPOReceiveStream::AppIPOReceiveStream(size_t id, const ipo_stream_settings_t& settings,
                                          bool extended_sequence_number,
-                                         const std::vector<IPOReceivePath>& paths)
+                                         const std::vector<IPOReceivePath>& paths,
+                                         bool path_stats)
     : IPOReceiveStream(id, settings, paths, extended_sequence_number),
       m_is_extended_sequence_number(extended_sequence_number),
       m_sequence_number_mask((extended_sequence_number) ? SEQUENCE_NUMBER_MASK_32BIT
-                                                        : SEQUENCE_NUMBER_MASK_16BIT) {
+                                                        : SEQUENCE_NUMBER_MASK_16BIT),
+      m_path_stats_enabled(path_stats) {
+  if (m_path_stats_enabled && paths.size() > MAX_PATHS_WITH_STATS) {
+    std::cerr << "Path statistics support up to " << MAX_PATHS_WITH_STATS
+              << " paths, disabled for stream " << id << std::endl;
+    m_path_stats_enabled = false;
+  }
   m_path_stats.resize(paths.size());
-  m_path_packets.resize(settings.num_of_packets_in_chunk, std::vector<uint8_t>(paths.size(), 0));
   m_path_stats_totals.resize(paths.size());
+  if (m_path_stats_enabled) {
+    m_path_masks.resize(settings.num_of_packets_in_chunk, 0);
+    m_all_paths_mask = static_cast<uint8_t>((1U << paths.size()) - 1);
+  }
 }
 
 ReturnStatus AppIPOReceiveStream::get_next_chunk(IPOReceiveChunk* chunk) {
@@ -105,6 +115,7 @@ void AppIPOReceiveStream::print_statistics(
   for (uint32_t s_index = 0; s_index < m_paths.size(); ++s_index) {
     if (s_index > 0) { ss << ", "; }
     ss << m_path_stats[s_index].rx_dropped + m_statistic.rx_dropped;
+    if (!m_path_stats_enabled) { break; }
   }
   ss << " |"
      << " consumed: " << m_statistic.consumed_packets << " |"
@@ -116,10 +127,11 @@ void AppIPOReceiveStream::print_statistics(
   for (uint32_t s_index = 0; s_index < m_paths.size(); ++s_index) {
     ss << " | " << m_paths[s_index].flow.get_destination_ip() << ":"
        << m_paths[s_index].flow.get_destination_port();
+    if (!m_path_stats_enabled) { continue; }
     if (m_statistic.rx_counter) {
-      uint32_t number =
-          static_cast<uint32_t>(floor(100 * static_cast<double>(m_path_stats[s_index].rx_count) /
-                                      static_cast<double>(m_statistic.rx_counter)));
+      const uint32_t rx_count = m_path_stats[s_index].rx_count + m_on_all_paths;
+      uint32_t number = static_cast<uint32_t>(floor(100 * static_cast<double>(rx_count) /
+                                                    static_cast<double>(m_statistic.rx_counter)));
       ss << " " << std::setw(3) << number << "%";
     } else {
       ss << "   0%";
@@ -138,17 +150,21 @@ void AppIPOReceiveStream::print_statistics(
 
 void AppIPOReceiveStream::reset_statistics() {
   for (auto& stat : m_path_stats) { stat.reset(); }
+  m_on_all_paths = 0;
   m_statistic.reset();
 }
 
 void AppIPOReceiveStream::reset_statistics_totals() {
   for (auto& stat : m_path_stats_totals) { stat.reset(); }
+  m_on_all_paths_totals = 0;
   m_statistic_totals.reset();
 }
 
 std::pair<IPORXStatistics, std::vector<IPOPathStatistics>> AppIPOReceiveStream::get_statistics()
     const {
-  return {m_statistic_totals, m_path_stats_totals};
+  auto path_stats = m_path_stats_totals;
+  for (auto& stat : path_stats) { stat.rx_count += m_on_all_paths_totals; }
+  return {m_statistic_totals, path_stats};
 }
 
 void AppIPOReceiveStream::handle_corrupted_packet(size_t index,
@@ -170,31 +186,39 @@ void AppIPOReceiveStream::handle_late_packet(size_t index, uint32_t sequence_num
 void AppIPOReceiveStream::handle_packet(size_t index, uint32_t sequence_number,
                                         const ReceivePacketInfo& packet_info) {
   IPOReceiveStream::handle_packet(index, sequence_number, packet_info);
+  if (!m_path_stats_enabled) { return; }
 
-  auto& by_paths = m_path_packets.at(sequence_number % get_sequence_number_wrap_around());
-
-  for (size_t i = 0; i < by_paths.size(); ++i) { by_paths[i] = (i == index) ? 1 : 0; }
+  m_path_masks.at(sequence_number % get_sequence_number_wrap_around()) =
+      static_cast<uint8_t>(1U << index);
 }
 
 void AppIPOReceiveStream::handle_redundant_packet(size_t index, uint32_t sequence_number,
                                                   const ReceivePacketInfo& packet_info) {
   IPOReceiveStream::handle_redundant_packet(index, sequence_number, packet_info);
+  if (!m_path_stats_enabled) { return; }
 
-  auto& by_paths = m_path_packets.at(sequence_number % get_sequence_number_wrap_around());
-
-  by_paths[index] = 1;
+  m_path_masks.at(sequence_number % get_sequence_number_wrap_around()) |=
+      static_cast<uint8_t>(1U << index);
 }
 
 void AppIPOReceiveStream::complete_packet(uint32_t sequence_number) {
   IPOReceiveStream::complete_packet(sequence_number);
 
-  auto& by_paths = m_path_packets.at(sequence_number % get_sequence_number_wrap_around());
-
-  for (size_t i = 0; i < by_paths.size(); ++i) {
-    m_path_stats[i].rx_count += by_paths[i];
-    m_path_stats[i].rx_dropped += 1 - by_paths[i];
-    m_path_stats_totals[i].rx_count += by_paths[i];
-    m_path_stats_totals[i].rx_dropped += 1 - by_paths[i];
+  if (m_path_stats_enabled) {
+    const uint8_t by_paths = m_path_masks.at(sequence_number % get_sequence_number_wrap_around());
+    if (by_paths == m_all_paths_mask) {
+      // Common case on healthy links, the per-path counters are only updated on losses
+      ++m_on_all_paths;
+      ++m_on_all_paths_totals;
+    } else {
+      for (size_t i = 0; i < m_path_stats.size(); ++i) {
+        const uint32_t received = (by_paths >> i) & 1;
+        m_path_stats[i].rx_count += received;
+        m_path_stats[i].rx_dropped += 1 - received;
+        m_path_stats_totals[i].rx_count += received;
+        m_path_stats_totals[i].rx_dropped += 1 - received;
+      }
+    }
   }
 
   // count dropped packets by sequence number
@@ -237,11 +261,13 @@ void AppIPOReceiveStream::update_consumed_packets_stats(size_t packets_consumed,
 
 IPOReceiverIONode::IPOReceiverIONode(const AppSettings& app_settings,
                                      uint64_t max_path_differential_us,
-                                     bool extended_sequence_number, size_t max_chunk_size,
+                                     bool extended_sequence_number, bool path_stats,
+                                     size_t max_chunk_size,
                                      const std::vector<std::string>& devices, size_t index,
                                      int cpu_core_affinity, IIPOChunkConsumer* chunk_consumer)
     : m_app_settings(app_settings),
       m_is_extended_sequence_number(extended_sequence_number),
+      m_path_stats(path_stats),
       m_devices(devices),
       m_index(index),
       m_print_parameters(app_settings.print_parameters),
@@ -297,7 +323,7 @@ void IPOReceiverIONode::initialize_streams(size_t start_id,
       paths.emplace_back(m_devices[i], flow_list[i]);
     }
     m_streams.emplace_back(new AppIPOReceiveStream(
-        id, m_stream_settings, m_is_extended_sequence_number, std::move(paths)));
+        id, m_stream_settings, m_is_extended_sequence_number, std::move(paths), m_path_stats));
     ++id;
   }
 }
@@ -91,14 +91,22 @@ struct IPOPathStatistics {
  */
 class AppIPOReceiveStream : public IPOReceiveStream {
  private:
+  static constexpr size_t MAX_PATHS_WITH_STATS = 8;
+
   const bool m_is_extended_sequence_number;
   const uint32_t m_sequence_number_mask;
+  bool m_path_stats_enabled;
 
   IPORXStatistics m_statistic;
   std::vector<IPOPathStatistics> m_path_stats;
   IPORXStatistics m_statistic_totals;
   std::vector<IPOPathStatistics> m_path_stats_totals;
-  std::vector<std::vector<uint8_t>> m_path_packets;
+  // One bit per path the packet arrived on, by sequence number slot
+  std::vector<uint8_t> m_path_masks;
+  uint8_t m_all_paths_mask = 0;
+  // Packets received on every path, only counted once instead of per path
+  uint32_t m_on_all_paths = 0;
+  uint32_t m_on_all_paths_totals = 0;
   bool m_initialized = false;
   uint32_t m_last_sequence_number = 0;
 
@@ -110,9 +118,11 @@ class AppIPOReceiveStream : public IPOReceiveStream {
    * @param [in] settings: Stream settings.
    * @param [in] extended_sequence_number: Parse extended sequence number.
    * @param [in] paths: List of redundant data receive paths.
+   * @param [in] path_stats: Count packets received and lost per path.
    */
   AppIPOReceiveStream(size_t id, const ipo_stream_settings_t& settings,
-                      bool extended_sequence_number, const std::vector<IPOReceivePath>& paths);
+                      bool extended_sequence_number, const std::vector<IPOReceivePath>& paths,
+                      bool path_stats = true);
   virtual ~AppIPOReceiveStream() = default;
 
   /**
@@ -257,6 +267,7 @@ class IPOReceiverIONode {
   static constexpr size_t DEFAULT_MAX_CHUNK_SIZE = 1024;
   const AppSettings m_app_settings;
   const bool m_is_extended_sequence_number;
+  const bool m_path_stats;
   const std::vector<std::string> m_devices;
   const size_t m_index;
   const bool m_print_parameters;
@@ -277,12 +288,13 @@ class IPOReceiverIONode {
    * @param [in] app_settings: Application settings.
    * @param [in] max_path_differential_us: Maximum Path Differential value.
    * @param [in] extended_sequence_number: Parse extended sequence number.
+   * @param [in] path_stats: Count packets received and lost per redundant path.
    * @param [in] devices: List of NICs to receive data.
    * @param [in] index: Receiver index.
    * @param [in] cpu_core_affinity: CPU core affinity the sender will run on.
    */
   IPOReceiverIONode(const AppSettings& app_settings, uint64_t max_path_differential_us,
-                    bool extended_sequence_number, size_t max_chunk_size,
+                    bool extended_sequence_number, bool path_stats, size_t max_chunk_size,
                     const std::vector<std::string>& devices, size_t index, int cpu_core_affinity,
                     IIPOChunkConsumer* chunk_consumer = nullptr);
 
@@ -64,6 +64,9 @@ std::shared_ptr<MemoryAllocator> MemoryAllocatorFactory::getAllocator(
   return allocator;
 }
 
+bool RmaxBaseService::s_rivermax_lib_initialized = false;
+std::mutex RmaxBaseService::s_rivermax_lib_mutex;
+
 RmaxBaseService::RmaxBaseService(const std::string& service_description)
     : m_obj_init_status(ReturnStatus::obj_init_failure),
       m_service_settings(nullptr),
@@ -188,6 +191,18 @@ ReturnStatus RmaxBaseService::initialize(const RmaxBaseServiceConfig& cfg) {
   return ReturnStatus::obj_init_success;
 }
 
+ReturnStatus RmaxBaseService::initialize_rivermax_library(int internal_thread_core) {
+  std::lock_guard<std::mutex> lock(s_rivermax_lib_mutex);
+
+  if (s_rivermax_lib_initialized) { return ReturnStatus::success; }
+
+  ReturnStatus ret = m_rmax_apps_lib->initialize_rivermax(internal_thread_core);
+
+  if (ret == ReturnStatus::success) { s_rivermax_lib_initialized = true; }
+
+  return ret;
+}
+
 ReturnStatus RmaxBaseService::set_rivermax_clock() {
   return ReturnStatus::success;
 }
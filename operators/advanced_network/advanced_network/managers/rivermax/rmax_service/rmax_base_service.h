@@ -18,6 +18,7 @@
 #ifndef RMAX_APPS_LIB_SERVICES_RMAX_BASE_SERVICE_H_
 #define RMAX_APPS_LIB_SERVICES_RMAX_BASE_SERVICE_H_
 
+#include <mutex>
 #include <string>
 #include <thread>
 
@@ -63,6 +64,10 @@ constexpr int INVALID_CORE_NUMBER = -1;
  * can override it's virtual methods.
  */
 class RmaxBaseService {
+ private:
+  static bool s_rivermax_lib_initialized;
+  static std::mutex s_rivermax_lib_mutex;
+
  protected:
   /* Indicator on whether the object created correctly */
   ReturnStatus m_obj_init_status;
@@ -159,6 +164,17 @@ class RmaxBaseService {
    * @return: Status of the operation.
    */
   virtual ReturnStatus initialize_rivermax_resources() = 0;
+  /**
+   * @brief: Initializes Rivermax library once per process.
+   *
+   * Services of different kinds (e.g. RX and TX) share the same Rivermax library instance,
+   * so only the first call initializes it; subsequent calls return success.
+   *
+   * @param [in] internal_thread_core: CPU core of Rivermax internal thread.
+   *
+   * @return: Status of the operation.
+   */
+  ReturnStatus initialize_rivermax_library(int internal_thread_core);
   /**
    * @brief: Cleans up Rivermax library resources.
    *
@@ -0,0 +1,383 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2023 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <cassert>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+#include <rivermax_api.h>
+
+#include "rt_threads.h"
+#include "rmax_generic_sender_service.h"
+#include "api/rmax_apps_lib_api.h"
+#include "rmax_base_service.h"
+
+using namespace ral::lib::core;
+using namespace ral::lib::services;
+using namespace ral::services::rmax_generic_sender;
+
+RmaxGenericSenderService::RmaxGenericSenderService(const RmaxGenericSenderConfig& cfg)
+    : RmaxBaseService(SERVICE_DESCRIPTION) {
+  memset(&m_remote_address, 0, sizeof(m_remote_address));
+  memset(&m_header_mem_region, 0, sizeof(m_header_mem_region));
+  memset(&m_payload_mem_region, 0, sizeof(m_payload_mem_region));
+  m_obj_init_status = initialize(cfg);
+}
+
+RmaxGenericSenderService::~RmaxGenericSenderService() {
+  if (m_stream_created) {
+    rmx_status status = rmx_output_gen_destroy_stream(m_stream_id);
+    if (status != RMX_OK) {
+      std::cerr << "Failed to destroy generic stream " << m_stream_id
+                << " with status: " << status << std::endl;
+    }
+    m_stream_created = false;
+  }
+  unregister_service_memory();
+}
+
+ReturnStatus RmaxGenericSenderService::parse_configuration(const RmaxBaseServiceConfig& cfg) {
+  const RmaxGenericSenderConfig& sender_service_cfg =
+      static_cast<const RmaxGenericSenderConfig&>(cfg);
+  m_service_settings = sender_service_cfg.app_settings;
+  m_register_memory = sender_service_cfg.register_memory;
+  m_max_chunk_size = sender_service_cfg.max_chunk_size;
+  m_num_of_slots = sender_service_cfg.num_of_slots;
+  m_rate_bps = sender_service_cfg.rate_bps;
+  m_max_burst_packets = sender_service_cfg.max_burst_packets;
+  m_dscp = sender_service_cfg.dscp;
+
+  if (m_max_chunk_size == 0) {
+    std::cerr << "Chunk size must be greater than zero" << std::endl;
+    return ReturnStatus::failure;
+  }
+  // Half of the slots may be in flight in the stream while the other half is being
+  // prepared by the caller.
+  if (m_num_of_slots < 2) { m_num_of_slots = 2; }
+  m_num_of_stream_chunks = m_num_of_slots / 2;
+
+  return ReturnStatus::success;
+}
+
+ReturnStatus RmaxGenericSenderService::initialize_connection_parameters() {
+  ReturnStatus rc = RmaxBaseService::initialize_connection_parameters();
+  if (rc != ReturnStatus::success) { return rc; }
+
+  m_remote_address.sin_family = AF_INET;
+  m_remote_address.sin_port = htons(m_service_settings->destination_port);
+  if (inet_pton(AF_INET,
+                m_service_settings->destination_ip.c_str(),
+                &m_remote_address.sin_addr) != 1) {
+    std::cerr << "Failed to parse destination network address: "
+              << m_service_settings->destination_ip << std::endl;
+    return ReturnStatus::failure;
+  }
+
+  rmx_status status = rmx_retrieve_device_iface_ipv4(&m_device_iface, &m_local_address.sin_addr);
+  if (status != RMX_OK) {
+    std::cerr << "Failed to get device: " << m_service_settings->local_ip
+              << " with status: " << status << std::endl;
+    return ReturnStatus::failure;
+  }
+
+  m_header_stride_size = m_service_settings->packet_app_header_size;
+  m_payload_stride_size = m_service_settings->packet_payload_size;
+
+  return ReturnStatus::success;
+}
+
+ReturnStatus RmaxGenericSenderService::initialize_rivermax_resources() {
+  rt_set_realtime_class();
+
+  return initialize_rivermax_library(m_service_settings->internal_thread_core);
+}
+
+ReturnStatus RmaxGenericSenderService::cleanup_rivermax_resources() {
+  return ReturnStatus::success;
+}
+
+ReturnStatus RmaxGenericSenderService::run(IRmaxServicesSynchronizer* sync_obj) {
+  if (m_obj_init_status != ReturnStatus::obj_init_success) { return m_obj_init_status; }
+
+  try {
+    ReturnStatus rc = allocate_service_memory();
+    if (rc != ReturnStatus::success) {
+      std::cerr << "Failed to allocate the memory required for the service" << std::endl;
+      return rc;
+    }
+
+    rc = create_stream();
+    if (rc != ReturnStatus::success) {
+      std::cerr << "Failed to create generic stream" << std::endl;
+      return rc;
+    }
+
+    if (sync_obj) { sync_obj->wait_for_start(); }
+  } catch (const std::exception& error) {
+    std::cerr << error.what() << std::endl;
+    return ReturnStatus::failure;
+  }
+
+  return ReturnStatus::success;
+}
+
+ReturnStatus RmaxGenericSenderService::create_stream() {
+  rmx_output_gen_stream_params stream_params;
+  rmx_output_gen_init(&stream_params);
+  rmx_output_gen_set_local_addr(&stream_params, reinterpret_cast<sockaddr*>(&m_local_address));
+  rmx_output_gen_set_remote_addr(&stream_params, reinterpret_cast<sockaddr*>(&m_remote_address));
+  rmx_output_gen_set_max_sub_blocks(&stream_params, is_hds_on() ? 2 : 1);
+  rmx_output_gen_set_packets_per_chunk(&stream_params, m_max_chunk_size);
+  rmx_output_gen_set_dscp(&stream_params, m_dscp);
+
+  if (m_rate_bps != 0) {
+    rmx_output_gen_rate rate;
+    rmx_output_gen_init_rate(&rate, m_rate_bps);
+    rmx_output_gen_set_rate_typical_packet_size(&rate,
+                                                m_header_stride_size + m_payload_stride_size);
+    if (m_max_burst_packets != 0) { rmx_output_gen_set_rate_max_burst(&rate, m_max_burst_packets); }
+    rmx_output_gen_set_rate(&stream_params, &rate);
+  }
+
+  rmx_status status = rmx_output_gen_create_stream(&stream_params, &m_stream_id);
+  if (status != RMX_OK) {
+    std::cerr << "Failed to create generic stream to " << m_service_settings->destination_ip
+              << ":" << m_service_settings->destination_port << " with status: " << status
+              << std::endl;
+    return ReturnStatus::failure;
+  }
+
+  rmx_output_gen_init_chunk_handle(&m_chunk_handle, m_stream_id);
+  m_stream_created = true;
+
+  std::cout << "Created generic stream " << m_stream_id << " from "
+            << m_service_settings->local_ip << " to " << m_service_settings->destination_ip << ":"
+            << m_service_settings->destination_port << " rate " << m_rate_bps << " bps"
+            << std::endl;
+
+  return ReturnStatus::success;
+}
+
+ReturnStatus RmaxGenericSenderService::allocate_service_memory() {
+  if (!m_header_allocator || !m_payload_allocator) {
+    std::cerr << "Memory allocators are not initialized" << std::endl;
+    return ReturnStatus::failure;
+  }
+
+  size_t hdr_mem_size =
+      m_header_allocator->align_length(m_num_of_slots * m_max_chunk_size * m_header_stride_size);
+  size_t pld_mem_size =
+      m_payload_allocator->align_length(m_num_of_slots * m_max_chunk_size * m_payload_stride_size);
+
+  if (hdr_mem_size) {
+    m_header_buffer = static_cast<byte_t*>(
+        m_header_allocator->allocate_aligned(hdr_mem_size, m_header_allocator->get_page_size()));
+  }
+  m_payload_buffer = static_cast<byte_t*>(
+      m_payload_allocator->allocate_aligned(pld_mem_size, m_payload_allocator->get_page_size()));
+
+  if (!m_payload_buffer || (hdr_mem_size && !m_header_buffer)) {
+    std::cerr << "Failed to allocate memory" << std::endl;
+    return ReturnStatus::failure;
+  }
+
+  std::cout << "Allocated " << hdr_mem_size << " bytes for header"
+            << " at address " << static_cast<void*>(m_header_buffer) << " and " << pld_mem_size
+            << " bytes for payload"
+            << " at address " << static_cast<void*>(m_payload_buffer) << std::endl;
+
+  m_header_mem_region.addr = m_header_buffer;
+  m_header_mem_region.length = hdr_mem_size;
+  m_header_mem_region.mkey = 0;
+  m_payload_mem_region.addr = m_payload_buffer;
+  m_payload_mem_region.length = pld_mem_size;
+  m_payload_mem_region.mkey = 0;
+
+  if (m_register_memory) {
+    rmx_mem_reg_params mem_registry;
+    if (hdr_mem_size) {
+      rmx_init_mem_registry(&mem_registry, &m_device_iface);
+      rmx_status status = rmx_register_memory(&m_header_mem_region, &mem_registry);
+      if (status != RMX_OK) {
+        std::cerr << "Failed to register header memory on device "
+                  << m_service_settings->local_ip << " with status: " << status << std::endl;
+        return ReturnStatus::failure;
+      }
+    }
+    rmx_init_mem_registry(&mem_registry, &m_device_iface);
+    rmx_status status = rmx_register_memory(&m_payload_mem_region, &mem_registry);
+    if (status != RMX_OK) {
+      std::cerr << "Failed to register payload memory on device " << m_service_settings->local_ip
+                << " with status: " << status << std::endl;
+      return ReturnStatus::failure;
+    }
+  }
+
+  m_slots.resize(m_num_of_slots);
+  for (size_t slot_idx = 0; slot_idx < m_num_of_slots; ++slot_idx) {
+    auto& slot = m_slots[slot_idx];
+    slot.state = SLOT_FREE;
+    slot.pld_ptrs.resize(m_max_chunk_size);
+    slot.pld_lens.resize(m_max_chunk_size, 0);
+    if (is_hds_on()) {
+      slot.hdr_ptrs.resize(m_max_chunk_size);
+      slot.hdr_lens.resize(m_max_chunk_size, 0);
+    }
+    for (size_t pkt_idx = 0; pkt_idx < m_max_chunk_size; ++pkt_idx) {
+      size_t offset = slot_idx * m_max_chunk_size + pkt_idx;
+      slot.pld_ptrs[pkt_idx] = m_payload_buffer + offset * m_payload_stride_size;
+      if (is_hds_on()) { slot.hdr_ptrs[pkt_idx] = m_header_buffer + offset * m_header_stride_size; }
+    }
+  }
+  m_sge.resize(is_hds_on() ? 2 : 1);
+
+  return ReturnStatus::success;
+}
+
+void RmaxGenericSenderService::unregister_service_memory() {
+  if (!m_register_memory) { return; }
+
+  if (m_header_buffer && m_header_mem_region.length) {
+    rmx_status status = rmx_deregister_memory(&m_header_mem_region, &m_device_iface);
+    if (status != RMX_OK) {
+      std::cerr << "Failed to deregister header memory on device " << m_service_settings->local_ip
+                << " with status: " << status << std::endl;
+    }
+  }
+  if (m_payload_buffer) {
+    rmx_status status = rmx_deregister_memory(&m_payload_mem_region, &m_device_iface);
+    if (status != RMX_OK) {
+      std::cerr << "Failed to deregister payload memory on device "
+                << m_service_settings->local_ip << " with status: " << status << std::endl;
+    }
+  }
+  m_header_buffer = nullptr;
+  m_payload_buffer = nullptr;
+}
+
+void RmaxGenericSenderService::update_completed_chunks() {
+  int64_t completed = m_committed_chunks - static_cast<int64_t>(m_num_of_stream_chunks) + 1;
+  if (completed > m_completed_chunks) { m_completed_chunks = completed; }
+}
+
+bool RmaxGenericSenderService::is_slot_available(size_t num_packets) {
+  if (!m_stream_created || num_packets > m_max_chunk_size) { return false; }
+
+  std::lock_guard<std::mutex> lock(m_mutex);
+  for (size_t i = 0; i < m_num_of_slots; ++i) {
+    const auto& slot = m_slots[(m_next_slot + i) % m_num_of_slots];
+    if (slot.state == SLOT_FREE || (slot.state >= 0 && slot.state < m_completed_chunks)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+int RmaxGenericSenderService::acquire_slot(size_t num_packets) {
+  if (!m_stream_created || num_packets > m_max_chunk_size) { return SLOT_NONE; }
+
+  std::lock_guard<std::mutex> lock(m_mutex);
+  for (size_t i = 0; i < m_num_of_slots; ++i) {
+    size_t slot_id = (m_next_slot + i) % m_num_of_slots;
+    auto& slot = m_slots[slot_id];
+    if (slot.state == SLOT_FREE || (slot.state >= 0 && slot.state < m_completed_chunks)) {
+      slot.state = SLOT_ACQUIRED;
+      m_next_slot = (slot_id + 1) % m_num_of_slots;
+      return static_cast<int>(slot_id);
+    }
+  }
+  m_stats.no_free_slot++;
+  return SLOT_NONE;
+}
+
+void RmaxGenericSenderService::release_slot(int slot_id) {
+  if (slot_id < 0 || static_cast<size_t>(slot_id) >= m_num_of_slots) { return; }
+
+  std::lock_guard<std::mutex> lock(m_mutex);
+  if (m_slots[slot_id].state == SLOT_ACQUIRED) { m_slots[slot_id].state = SLOT_FREE; }
+}
+
+ReturnStatus RmaxGenericSenderService::commit_slot(int slot_id, size_t num_packets,
+                                                   const uint32_t* hdr_lens,
+                                                   const uint32_t* pld_lens, uint64_t send_time) {
+  if (!m_stream_created) { return ReturnStatus::failure; }
+  if (slot_id < 0 || static_cast<size_t>(slot_id) >= m_num_of_slots ||
+      num_packets > m_max_chunk_size) {
+    std::cerr << "Invalid slot " << slot_id << " or number of packets " << num_packets
+              << std::endl;
+    return ReturnStatus::failure;
+  }
+
+  std::lock_guard<std::mutex> lock(m_mutex);
+  auto& slot = m_slots[slot_id];
+
+  rmx_status status = rmx_output_gen_get_next_chunk(&m_chunk_handle);
+  if (status == RMX_NO_FREE_CHUNK) {
+    m_stats.no_free_chunk++;
+    return ReturnStatus::no_free_chunks;
+  }
+  if (status != RMX_OK) {
+    std::cerr << "Failed to get next chunk of stream " << m_stream_id
+              << " with status: " << status << std::endl;
+    return ReturnStatus::failure;
+  }
+  update_completed_chunks();
+
+  uint64_t bytes = 0;
+  for (size_t pkt_idx = 0; pkt_idx < num_packets; ++pkt_idx) {
+    size_t sge_idx = 0;
+    if (is_hds_on()) {
+      m_sge[sge_idx].addr = slot.hdr_ptrs[pkt_idx];
+      m_sge[sge_idx].length = hdr_lens[pkt_idx];
+      m_sge[sge_idx].mkey = m_header_mem_region.mkey;
+      bytes += hdr_lens[pkt_idx];
+      sge_idx++;
+    }
+    m_sge[sge_idx].addr = slot.pld_ptrs[pkt_idx];
+    m_sge[sge_idx].length = pld_lens[pkt_idx];
+    m_sge[sge_idx].mkey = m_payload_mem_region.mkey;
+    bytes += pld_lens[pkt_idx];
+
+    status = rmx_output_gen_append_packet_to_chunk(&m_chunk_handle, m_sge.data(), m_sge.size());
+    if (status != RMX_OK) {
+      std::cerr << "Failed to append packet " << pkt_idx << " to chunk of stream " << m_stream_id
+                << " with status: " << status << std::endl;
+      rmx_output_gen_cancel_unsent_chunks(m_stream_id);
+      return ReturnStatus::failure;
+    }
+  }
+
+  do {
+    status = rmx_output_gen_commit_chunk(&m_chunk_handle, send_time);
+    if (status == RMX_HW_SEND_QUEUE_IS_FULL) { m_stats.hw_queue_full++; }
+  } while (status == RMX_HW_SEND_QUEUE_IS_FULL && SignalHandler::get_received_signal() < 0);
+
+  if (status != RMX_OK) {
+    if (status == RMX_SIGNAL) { return ReturnStatus::signal_received; }
+    std::cerr << "Failed to commit chunk of stream " << m_stream_id << " with status: " << status
+              << std::endl;
+    return ReturnStatus::failure;
+  }
+
+  slot.state = m_committed_chunks++;
+  m_stats.committed_chunks++;
+  m_stats.committed_packets += num_packets;
+  m_stats.committed_bytes += bytes;
+
+  return ReturnStatus::success;
+}
@@ -0,0 +1,248 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2023 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef RMAX_APPS_LIB_SERVICES_GENERIC_SENDER_SERVICE_H_
+#define RMAX_APPS_LIB_SERVICES_GENERIC_SENDER_SERVICE_H_
+
+#include <atomic>
+#include <string>
+#include <vector>
+#include <memory>
+#include <mutex>
+
+#include <rivermax_api.h>
+
+#include "api/rmax_apps_lib_api.h"
+#include "rmax_base_service.h"
+
+using namespace ral::lib::core;
+using namespace ral::lib::services;
+using namespace ral::services;
+
+namespace ral {
+namespace services {
+namespace rmax_generic_sender {
+struct RmaxGenericSenderConfig : RmaxBaseServiceConfig {
+  bool register_memory;
+  size_t max_chunk_size;
+  size_t num_of_slots;
+  uint64_t rate_bps;
+  uint32_t max_burst_packets;
+  uint8_t dscp;
+};
+
+/**
+ * @brief: Statistics of a single generic sender stream.
+ */
+struct GenericSenderStatistics {
+  uint64_t committed_chunks = 0;
+  uint64_t committed_packets = 0;
+  uint64_t committed_bytes = 0;
+  uint64_t no_free_chunk = 0;
+  uint64_t hw_queue_full = 0;
+  uint64_t no_free_slot = 0;
+};
+
+/**
+ * @brief: A slot of sender memory that can hold a single chunk of packets.
+ *
+ * Each slot is described by the packet buffer pointers of every segment. When header-data
+ * split is enabled the packet header lives in @ref hdr_ptrs (CPU memory) and the payload
+ * in @ref pld_ptrs (GPU or CPU memory), otherwise only @ref pld_ptrs is used.
+ */
+struct GenericSenderSlot {
+  std::vector<void*> hdr_ptrs;
+  std::vector<void*> pld_ptrs;
+  std::vector<uint32_t> hdr_lens;
+  std::vector<uint32_t> pld_lens;
+  /* Commit index of the chunk that used this slot, or one of SLOT_* states */
+  int64_t state;
+};
+
+/**
+ * Service constants.
+ */
+constexpr const char* SERVICE_DESCRIPTION = "NVIDIA Rivermax Generic Sender Service ";
+/**
+ * @brief: Generic Sender service.
+ *
+ * This service wraps Rivermax generic output stream API. Unlike the receiver services it
+ * does not own any thread: packets are prepared by the caller in pre-registered service
+ * memory slots and committed to the hardware from the caller's context. Pacing is done by
+ * the NIC according to the configured rate.
+ */
+class RmaxGenericSenderService : public RmaxBaseService {
+ public:
+  static constexpr int64_t SLOT_FREE = -1;
+  static constexpr int64_t SLOT_ACQUIRED = -2;
+  static constexpr int SLOT_NONE = -1;
+
+ private:
+  static constexpr size_t DEFAULT_NUM_OF_SLOTS = 64;
+
+  /* NIC device interface */
+  rmx_device_iface m_device_iface;
+  /* Remote (destination) address */
+  sockaddr_in m_remote_address;
+  /* Generic stream ID */
+  rmx_stream_id m_stream_id = 0;
+  /* Generic stream chunk handle */
+  rmx_output_gen_chunk_handle m_chunk_handle;
+  /* Memory region for header memory */
+  rmx_mem_region m_header_mem_region;
+  /* Memory region for payload memory */
+  rmx_mem_region m_payload_mem_region;
+  bool m_register_memory = true;
+  byte_t* m_header_buffer = nullptr;
+  byte_t* m_payload_buffer = nullptr;
+  size_t m_header_stride_size = 0;
+  size_t m_payload_stride_size = 0;
+  size_t m_max_chunk_size = 1024;
+  size_t m_num_of_slots = DEFAULT_NUM_OF_SLOTS;
+  size_t m_num_of_stream_chunks = DEFAULT_NUM_OF_SLOTS / 2;
+  uint64_t m_rate_bps = 0;
+  uint32_t m_max_burst_packets = 0;
+  uint8_t m_dscp = 0;
+  bool m_stream_created = false;
+  std::vector<GenericSenderSlot> m_slots;
+  size_t m_next_slot = 0;
+  /* Number of chunks that were committed to the stream */
+  int64_t m_committed_chunks = 0;
+  /* Number of committed chunks that are known to be sent by the hardware */
+  int64_t m_completed_chunks = 0;
+  std::vector<rmx_mem_region> m_sge;
+  GenericSenderStatistics m_stats;
+  std::mutex m_mutex;
+
+ public:
+  /**
+   * @brief: RmaxGenericSenderService class constructor.
+   *
+   * @param [in] cfg: service configuration
+   */
+  explicit RmaxGenericSenderService(const RmaxGenericSenderConfig& cfg);
+  virtual ~RmaxGenericSenderService();
+  /**
+   * @brief: Creates the generic output stream and its memory.
+   *
+   * The service doesn't run any threads, therefore this call returns once the stream is
+   * ready to accept chunks.
+   *
+   * @param [in] sync_obj: Optional start synchronization object.
+   *
+   * @return: Status of the operation.
+   */
+  ReturnStatus run(IRmaxServicesSynchronizer* sync_obj = nullptr) override;
+  bool is_alive() const { return m_stream_created; }
+  /**
+   * @brief: Returns whether header-data split is in use.
+   */
+  bool is_hds_on() const { return m_header_stride_size != 0; }
+  /**
+   * @brief: Returns whether payload memory resides on the GPU.
+   */
+  bool is_gpu_direct() const { return m_service_settings->gpu_id != INVALID_GPU_ID; }
+  size_t get_max_chunk_size() const { return m_max_chunk_size; }
+  size_t get_header_stride_size() const { return m_header_stride_size; }
+  size_t get_payload_stride_size() const { return m_payload_stride_size; }
+  /**
+   * @brief: Checks whether a free slot for @p num_packets packets is available.
+   *
+   * @param [in] num_packets: Number of packets the caller wants to send.
+   *
+   * @return: True if @ref acquire_slot will succeed.
+   */
+  bool is_slot_available(size_t num_packets);
+  /**
+   * @brief: Acquires a free memory slot.
+   *
+   * @param [in] num_packets: Number of packets the caller wants to send.
+   *
+   * @return: Slot index, or SLOT_NONE if no slot is available.
+   */
+  int acquire_slot(size_t num_packets);
+  /**
+   * @brief: Returns slot descriptor.
+   *
+   * @param [in] slot_id: Slot index returned by @ref acquire_slot.
+   *
+   * @return: Slot descriptor.
+   */
+  GenericSenderSlot& get_slot(int slot_id) { return m_slots[slot_id]; }
+  /**
+   * @brief: Releases a slot that was acquired but won't be committed.
+   *
+   * @param [in] slot_id: Slot index returned by @ref acquire_slot.
+   */
+  void release_slot(int slot_id);
+  /**
+   * @brief: Commits the packets of a slot to the generic stream.
+   *
+   * @param [in] slot_id: Slot index returned by @ref acquire_slot.
+   * @param [in] num_packets: Number of packets to commit.
+   * @param [in] hdr_lens: Header segment lengths, ignored when header-data split is off.
+   * @param [in] pld_lens: Payload segment lengths.
+   * @param [in] send_time: Time to send the first packet, 0 to send immediately.
+   *
+   * @return: Status of the operation, @ref ReturnStatus::no_free_chunks if the stream
+   *          has no free chunk or the hardware queue is full.
+   */
+  ReturnStatus commit_slot(int slot_id, size_t num_packets, const uint32_t* hdr_lens,
+                           const uint32_t* pld_lens, uint64_t send_time);
+  /**
+   * @brief: Returns stream statistics.
+   */
+  GenericSenderStatistics get_stream_statistics() const { return m_stats; }
+
+ private:
+  ReturnStatus parse_configuration(const RmaxBaseServiceConfig& cfg) final;
+  ReturnStatus initialize_connection_parameters() final;
+  ReturnStatus initialize_rivermax_resources() final;
+  ReturnStatus cleanup_rivermax_resources() final;
+  /**
+   * @brief: Creates Rivermax generic output stream.
+   *
+   * @return: Status of the operation.
+   */
+  ReturnStatus create_stream();
+  /**
+   * @brief: Allocates service memory and registers it if requested.
+   *
+   * The memory is split to @ref m_num_of_slots slots, each slot is big enough to hold
+   * @ref m_max_chunk_size packets.
+   *
+   * @return: Status of the operation.
+   */
+  ReturnStatus allocate_service_memory();
+  /**
+   * @brief Unregister previously registered memory.
+   */
+  void unregister_service_memory();
+  /**
+   * @brief: Updates the number of chunks that are known to be completed.
+   *
+   * A successful @ref rmx_output_gen_get_next_chunk for commit index N means the
+   * stream reclaimed the chunk committed at index N - @ref m_num_of_stream_chunks,
+   * so the memory referenced by it can be reused.
+   */
+  void update_completed_chunks();
+};
+
+}  // namespace rmax_generic_sender
+}  // namespace services
+}  // namespace ral
+#endif  // RMAX_APPS_LIB_SERVICES_GENERIC_SENDER_SERVICE_H_
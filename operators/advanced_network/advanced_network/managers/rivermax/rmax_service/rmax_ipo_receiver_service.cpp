@@ -33,9 +33,6 @@ using namespace ral::lib::services;
 using namespace ral::io_node;
 using namespace ral::services::rmax_ipo_receiver;
 
-bool RmaxIPOReceiverService::m_rivermax_lib_initialized = false;
-std::mutex RmaxIPOReceiverService::m_rivermax_lib_mutex;
-
 RmaxIPOReceiverService::RmaxIPOReceiverService(const RmaxIPOReceiverConfig& cfg)
     : RmaxBaseService(SERVICE_DESCRIPTION) {
   m_obj_init_status = initialize(cfg);
@@ -45,6 +42,7 @@ ReturnStatus RmaxIPOReceiverService::parse_configuration(const RmaxBaseServiceCo
   m_service_settings = ipo_service_cfg.app_settings;
   m_max_path_differential_us = ipo_service_cfg.max_path_differential_us;
   m_is_extended_sequence_number = ipo_service_cfg.is_extended_sequence_number;
+  m_path_stats = ipo_service_cfg.path_stats;
   m_register_memory = ipo_service_cfg.register_memory;
   m_max_chunk_size = ipo_service_cfg.max_chunk_size;
   m_rx_stats_period_report_ms = ipo_service_cfg.rx_stats_period_report_ms;
@@ -135,17 +133,9 @@ ReturnStatus RmaxIPOReceiverService::run(IRmaxServicesSynchronizer* sync_obj) {
 }
 
 ReturnStatus RmaxIPOReceiverService::initialize_rivermax_resources() {
-  std::lock_guard<std::mutex> lock(m_rivermax_lib_mutex);
-
-  if (RmaxIPOReceiverService::m_rivermax_lib_initialized) { return ReturnStatus::success; }
-
   rt_set_realtime_class();
 
-  ReturnStatus ret = m_rmax_apps_lib->initialize_rivermax(m_service_settings->internal_thread_core);
-
-  if (ret == ReturnStatus::success) { RmaxIPOReceiverService::m_rivermax_lib_initialized = true; }
-
-  return ret;
+  return initialize_rivermax_library(m_service_settings->internal_thread_core);
 }
 
 void RmaxIPOReceiverService::configure_network_flows() {
@@ -206,6 +196,7 @@ void RmaxIPOReceiverService::initialize_receive_io_nodes() {
         std::unique_ptr<IPOReceiverIONode>(new IPOReceiverIONode(*m_service_settings,
                                                                  m_max_path_differential_us,
                                                                  m_is_extended_sequence_number,
+                                                                 m_path_stats,
                                                                  m_max_chunk_size,
                                                                  m_service_settings->local_ips,
                                                                  rx_idx,
@@ -47,6 +47,7 @@ namespace rmax_ipo_receiver {
 struct RmaxIPOReceiverConfig : RmaxBaseServiceConfig {
   uint32_t max_path_differential_us;
   bool is_extended_sequence_number;
+  bool path_stats = true;
   bool register_memory;
   size_t max_chunk_size;
   uint32_t rx_stats_period_report_ms;
@@ -65,9 +66,6 @@ class RmaxIPOReceiverService : public RmaxBaseService {
   static constexpr uint32_t DEFAULT_NUM_OF_PACKETS_IN_CHUNK = 262144;
   static constexpr int USECS_IN_SECOND = 1000000;
 
-  static bool m_rivermax_lib_initialized;
-  static std::mutex m_rivermax_lib_mutex;
-
   /* Sender objects container */
   std::vector<std::unique_ptr<IPOReceiverIONode>> m_receivers;
   /* Stream per thread distribution */
@@ -84,6 +82,7 @@ class RmaxIPOReceiverService : public RmaxBaseService {
   // by SMPTE ST 2022-7:2019 "Seamless Protection Switching of RTP Datagrams".
   uint64_t m_max_path_differential_us = 50000;
   bool m_is_extended_sequence_number = false;
+  bool m_path_stats = true;
   bool m_register_memory = false;
   byte_t* m_header_buffer = nullptr;
   byte_t* m_payload_buffer = nullptr;
@@ -0,0 +1,284 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2023 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "advanced_network/metrics_server.h"
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <pthread.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <array>
+#include <cerrno>
+#include <cstring>
+#include <functional>
+#include <sstream>
+#include <tuple>
+#include "advanced_network/common.h"
+#include "holoscan/holoscan.hpp"
+
+namespace holoscan::advanced_network {
+
+namespace {
+
+/**
+ * @brief Write one metric family: its HELP and TYPE lines followed by its samples
+ */
+void write_family(std::ostringstream& out, const char* name, const char* type, const char* help,
+                  const std::function<void(const std::string&)>& samples) {
+  out << "# HELP " << name << " " << help << "\n";
+  out << "# TYPE " << name << " " << type << "\n";
+  samples(name);
+}
+
+std::string port_labels(uint16_t port) {
+  return "{port=\"" + std::to_string(port) + "\"}";
+}
+
+std::string queue_labels(const QueueStats& q) {
+  return "{port=\"" + std::to_string(q.port_id) + "\",queue=\"" + std::to_string(q.q_id) +
+         "\",dir=\"" + (q.dir == Direction::TX ? "tx" : "rx") + "\"}";
+}
+
+bool send_all(int fd, const std::string& data) {
+  size_t sent = 0;
+  while (sent < data.size()) {
+    const ssize_t ret = send(fd, data.data() + sent, data.size() - sent, MSG_NOSIGNAL);
+    if (ret < 0 && errno == EINTR) { continue; }
+    if (ret <= 0) { return false; }
+    sent += ret;
+  }
+  return true;
+}
+
+}  // namespace
+
+bool MetricsServer::start() {
+  listen_fd_ = socket(AF_INET, SOCK_STREAM, 0);
+  if (listen_fd_ < 0) {
+    HOLOSCAN_LOG_ERROR("Failed to create metrics server socket: {}", strerror(errno));
+    return false;
+  }
+
+  int reuse = 1;
+  setsockopt(listen_fd_, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+
+  struct sockaddr_in addr {};
+  addr.sin_family = AF_INET;
+  addr.sin_port = htons(cfg_.port_);
+  if (inet_pton(AF_INET, cfg_.address_.c_str(), &addr.sin_addr) != 1) {
+    HOLOSCAN_LOG_ERROR("Invalid metrics server address {}", cfg_.address_);
+    close(listen_fd_);
+    listen_fd_ = -1;
+    return false;
+  }
+
+  if (bind(listen_fd_, reinterpret_cast<struct sockaddr*>(&addr), sizeof(addr)) != 0 ||
+      listen(listen_fd_, 4) != 0) {
+    HOLOSCAN_LOG_ERROR("Failed to listen on {}:{} for metrics: {}", cfg_.address_, cfg_.port_,
+                       strerror(errno));
+    close(listen_fd_);
+    listen_fd_ = -1;
+    return false;
+  }
+
+  running_.store(true);
+  thread_ = std::thread(&MetricsServer::serve_loop, this);
+
+  if (cfg_.cpu_core_ >= 0) {
+    cpu_set_t cpuset;
+    CPU_ZERO(&cpuset);
+    CPU_SET(cfg_.cpu_core_, &cpuset);
+    if (pthread_setaffinity_np(thread_.native_handle(), sizeof(cpu_set_t), &cpuset) != 0) {
+      HOLOSCAN_LOG_WARN("Failed to pin metrics server to core {}", cfg_.cpu_core_);
+    }
+  }
+
+  HOLOSCAN_LOG_INFO("Serving metrics on http://{}:{}/metrics", cfg_.address_, cfg_.port_);
+  return true;
+}
+
+void MetricsServer::stop() {
+  if (!running_.exchange(false)) { return; }
+  thread_.join();
+  close(listen_fd_);
+  listen_fd_ = -1;
+}
+
+void MetricsServer::serve_loop() {
+  struct pollfd pfd = {listen_fd_, POLLIN, 0};
+  while (running_.load()) {
+    if (poll(&pfd, 1, ACCEPT_POLL_MS) <= 0) { continue; }
+
+    const int fd = accept(listen_fd_, nullptr, nullptr);
+    if (fd < 0) { continue; }
+    handle_client(fd);
+    close(fd);
+  }
+}
+
+void MetricsServer::handle_client(int fd) {
+  // Only the request line matters, read up to the end of the headers
+  std::string request;
+  char buf[1024];
+  struct pollfd pfd = {fd, POLLIN, 0};
+  while (request.find("\r\n\r\n") == std::string::npos && request.size() < MAX_REQUEST_SIZE) {
+    if (poll(&pfd, 1, CLIENT_TIMEOUT_MS) <= 0) { return; }
+    const ssize_t len = recv(fd, buf, sizeof(buf), 0);
+    if (len <= 0) { return; }
+    request.append(buf, len);
+  }
+
+  std::string status = "200 OK";
+  std::string body;
+  if (request.rfind("GET /metrics ", 0) == 0 || request.rfind("GET /metrics?", 0) == 0) {
+    ManagerStats stats;
+    if (get_stats(stats) == Status::SUCCESS) {
+      body = format_prometheus(stats);
+    } else {
+      status = "503 Service Unavailable";
+      body = "Statistics not supported by the manager\n";
+    }
+  } else if (request.rfind("GET ", 0) == 0) {
+    status = "404 Not Found";
+    body = "Metrics are served on /metrics\n";
+  } else {
+    status = "405 Method Not Allowed";
+  }
+
+  std::ostringstream response;
+  response << "HTTP/1.1 " << status << "\r\n"
+           << "Content-Type: text/plain; version=0.0.4; charset=utf-8\r\n"
+           << "Content-Length: " << body.size() << "\r\n"
+           << "Connection: close\r\n\r\n"
+           << body;
+  send_all(fd, response.str());
+}
+
+std::string MetricsServer::format_prometheus(const ManagerStats& stats) {
+  std::ostringstream out;
+
+  using PortField = uint64_t PortStats::*;
+  const std::array<std::tuple<const char*, const char*, PortField>, 7> port_counters = {{
+      {"advanced_network_port_rx_packets_total", "Packets received by the NIC",
+       &PortStats::rx_packets},
+      {"advanced_network_port_rx_bytes_total", "Bytes received by the NIC", &PortStats::rx_bytes},
+      {"advanced_network_port_rx_missed_total",
+       "Packets dropped by the NIC for lack of RX descriptors", &PortStats::rx_missed},
+      {"advanced_network_port_rx_errors_total", "Erroneous received packets",
+       &PortStats::rx_errors},
+      {"advanced_network_port_tx_packets_total", "Packets sent by the NIC",
+       &PortStats::tx_packets},
+      {"advanced_network_port_tx_bytes_total", "Bytes sent by the NIC", &PortStats::tx_bytes},
+      {"advanced_network_port_tx_errors_total", "Failed transmitted packets",
+       &PortStats::tx_errors},
+  }};
+  for (const auto& counter : port_counters) {
+    const PortField field = std::get<2>(counter);
+    write_family(out, std::get<0>(counter), "counter", std::get<1>(counter),
+                 [&](const std::string& metric) {
+      for (const auto& port : stats.ports) {
+        out << metric << port_labels(port.port_id) << " " << port.*field << "\n";
+      }
+    });
+  }
+
+  using QueueField = uint64_t QueueStats::*;
+  const std::array<std::tuple<const char*, const char*, QueueField>, 3> queue_counters = {{
+      {"advanced_network_queue_packets_total", "Packets of the queue", &QueueStats::packets},
+      {"advanced_network_queue_bytes_total", "Bytes of the queue", &QueueStats::bytes},
+      {"advanced_network_queue_drops_total", "Packets of the queue dropped",
+       &QueueStats::drops},
+  }};
+  for (const auto& counter : queue_counters) {
+    const QueueField field = std::get<2>(counter);
+    write_family(out, std::get<0>(counter), "counter", std::get<1>(counter),
+                 [&](const std::string& metric) {
+      for (const auto& q : stats.queues) {
+        out << metric << queue_labels(q) << " " << q.*field << "\n";
+      }
+    });
+  }
+
+  write_family(out, "advanced_network_queue_ring_occupancy", "gauge",
+               "Bursts waiting between the worker and the application",
+               [&](const std::string& metric) {
+                 for (const auto& q : stats.queues) {
+                   out << metric << queue_labels(q) << " " << q.ring_occupancy << "\n";
+                 }
+               });
+  write_family(out, "advanced_network_queue_ring_capacity", "gauge",
+               "Bursts the ring between the worker and the application can hold",
+               [&](const std::string& metric) {
+                 for (const auto& q : stats.queues) {
+                   out << metric << queue_labels(q) << " " << q.ring_capacity << "\n";
+                 }
+               });
+
+  write_family(out, "advanced_network_pool_free", "gauge", "Free buffers in the pool",
+               [&](const std::string& metric) {
+                 for (const auto& pool : stats.pools) {
+                   out << metric << "{pool=\"" << pool.name << "\"} " << pool.free << "\n";
+                 }
+               });
+  write_family(out, "advanced_network_pool_size", "gauge", "Buffers in the pool",
+               [&](const std::string& metric) {
+                 for (const auto& pool : stats.pools) {
+                   out << metric << "{pool=\"" << pool.name << "\"} " << pool.size << "\n";
+                 }
+               });
+  write_family(out, "advanced_network_pool_exhausted_total", "counter",
+               "Allocations that found the pool empty",
+               [&](const std::string& metric) {
+                 for (const auto& pool : stats.pools) {
+                   out << metric << "{pool=\"" << pool.name << "\"} " << pool.exhausted << "\n";
+                 }
+               });
+
+  write_family(out, "advanced_network_rx_dropped_total", "counter",
+               "Packets dropped by the manager when the application falls behind",
+               [&](const std::string& metric) {
+                 out << metric << " " << stats.rx_dropped << "\n";
+               });
+
+  write_family(
+      out, "advanced_network_rx_latency_nanoseconds", "summary",
+      "Burst latency by stage, see get_queue_latency_stats", [&](const std::string& metric) {
+        for (const auto& q_lat : stats.latency) {
+          const std::array<std::pair<const char*, const LatencySummary*>, 3> stages = {{
+              {"wire_to_dequeue", &q_lat.wire_to_dequeue},
+              {"ring_to_dequeue", &q_lat.ring_to_dequeue},
+              {"dequeue_to_free", &q_lat.dequeue_to_free},
+          }};
+          for (const auto& [stage, lat] : stages) {
+            if (lat->count == 0) { continue; }
+            const std::string labels = "port=\"" + std::to_string(q_lat.port_id) +
+                                       "\",queue=\"" + std::to_string(q_lat.q_id) +
+                                       "\",stage=\"" + stage + "\"";
+            out << metric << "{" << labels << ",quantile=\"0.5\"} " << lat->p50_ns << "\n";
+            out << metric << "{" << labels << ",quantile=\"0.99\"} " << lat->p99_ns << "\n";
+            out << metric << "{" << labels << ",quantile=\"0.999\"} " << lat->p999_ns << "\n";
+            out << metric << "_sum{" << labels << "} " << lat->mean_ns * lat->count << "\n";
+            out << metric << "_count{" << labels << "} " << lat->count << "\n";
+          }
+        }
+      });
+
+  return out.str();
+}
+
+};  // namespace holoscan::advanced_network
@@ -0,0 +1,61 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2023 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <string>
+#include <thread>
+#include "advanced_network/types.h"
+
+namespace holoscan::advanced_network {
+
+/**
+ * @brief Minimal HTTP server exposing get_stats in the Prometheus text format
+ *
+ * A single thread, optionally pinned to a core not used by the workers, answers GET /metrics
+ * one connection at a time. Every scrape takes a fresh snapshot of the manager statistics, so
+ * nothing is computed between scrapes.
+ */
+class MetricsServer {
+ public:
+  static constexpr int ACCEPT_POLL_MS = 200;     // Interval to check for shutdown
+  static constexpr int CLIENT_TIMEOUT_MS = 1000;  // Time allowed to send a request
+  static constexpr size_t MAX_REQUEST_SIZE = 4096;
+
+  explicit MetricsServer(const MetricsConfig& cfg) : cfg_(cfg) {}
+  ~MetricsServer() { stop(); }
+
+  bool start();
+  void stop();
+
+  /**
+   * @brief Format statistics in the Prometheus text exposition format
+   */
+  static std::string format_prometheus(const ManagerStats& stats);
+
+ private:
+  void serve_loop();
+  void handle_client(int fd);
+
+  MetricsConfig cfg_;
+  int listen_fd_ = -1;
+  std::atomic<bool> running_{false};
+  std::thread thread_;
+};
+
+};  // namespace holoscan::advanced_network
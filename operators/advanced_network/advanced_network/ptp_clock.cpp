@@ -0,0 +1,200 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "advanced_network/ptp_clock.h"
+#include "advanced_network/manager.h"
+#include <dirent.h>
+#include <fcntl.h>
+#include <time.h>
+#include <unistd.h>
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include "holoscan/holoscan.hpp"
+
+// Dynamic POSIX clock of a PHC file descriptor
+#define FD_TO_CLOCKID(fd) ((~static_cast<clockid_t>(fd) << 3) | 3)
+
+namespace holoscan::advanced_network {
+
+namespace {
+
+uint64_t read_clock_ns(clockid_t clk) {
+  struct timespec ts;
+  if (clock_gettime(clk, &ts) != 0) { return 0; }
+  return static_cast<uint64_t>(ts.tv_sec) * 1000000000ULL + ts.tv_nsec;
+}
+
+std::string first_ptp_entry(const std::string& dir) {
+  std::string entry_name;
+  if (DIR* d = opendir(dir.c_str())) {
+    while (struct dirent* entry = readdir(d)) {
+      if (strncmp(entry->d_name, "ptp", 3) == 0) {
+        entry_name = entry->d_name;
+        break;
+      }
+    }
+    closedir(d);
+  }
+  return entry_name;
+}
+
+}  // namespace
+
+std::string PtpClock::find_phc(const std::string& address) {
+  for (const auto& dir : {"/sys/class/net/" + address + "/device/ptp",
+                          "/sys/bus/pci/devices/" + normalize_pci_addr(address) + "/ptp"}) {
+    const auto entry = first_ptp_entry(dir);
+    if (!entry.empty()) { return "/dev/" + entry; }
+  }
+  return "";
+}
+
+bool PtpClock::start(const std::string& address) {
+  device_ = cfg_.device_.empty() ? find_phc(address) : cfg_.device_;
+  if (device_.empty()) {
+    HOLOSCAN_LOG_ERROR("No PTP hardware clock found for {}", address);
+    return false;
+  }
+
+  fd_ = open(device_.c_str(), O_RDONLY);
+  if (fd_ < 0) {
+    HOLOSCAN_LOG_ERROR("Failed to open PTP hardware clock {}: {}", device_, strerror(errno));
+    return false;
+  }
+
+  uint64_t ns = 0;
+  if (!now(ns)) {
+    HOLOSCAN_LOG_ERROR("Failed to read PTP hardware clock {}", device_);
+    return false;
+  }
+
+  if (!read_ticks_) {
+    HOLOSCAN_LOG_INFO("{}: PTP time from {}, NIC timestamps are not converted", address, device_);
+    return true;
+  }
+
+  // Two samples give the first rate of the device clock
+  static constexpr int FIRST_SYNC_INTERVAL_MS = 10;
+  if (!sync()) {
+    HOLOSCAN_LOG_ERROR("Failed to read the device clock of {}", address);
+    return false;
+  }
+  std::this_thread::sleep_for(std::chrono::milliseconds(FIRST_SYNC_INTERVAL_MS));
+  sync();
+
+  running_ = true;
+  thread_ = std::thread(&PtpClock::sync_loop, this);
+  HOLOSCAN_LOG_INFO("{}: PTP time from {}, {:.3f} ns per NIC tick, {} ns from CLOCK_REALTIME",
+                    address,
+                    device_,
+                    map_ns_per_tick_.load(),
+                    realtime_offset_ns());
+  return true;
+}
+
+void PtpClock::stop() {
+  if (running_.exchange(false)) {
+    cv_.notify_all();
+    thread_.join();
+  }
+  if (fd_ >= 0) {
+    close(fd_);
+    fd_ = -1;
+  }
+}
+
+bool PtpClock::now(uint64_t& ns) const {
+  if (fd_ < 0) { return false; }
+  ns = read_clock_ns(FD_TO_CLOCKID(fd_));
+  return ns != 0;
+}
+
+bool PtpClock::sync() {
+  uint64_t best_ticks = 0;
+  uint64_t best_ns = 0;
+  uint64_t best_window = UINT64_MAX;
+  int64_t realtime_offset = 0;
+
+  // The PHC read is bracketed by two device clock reads, the narrowest bracket is the most exact
+  for (int i = 0; i < SAMPLES_PER_SYNC; i++) {
+    uint64_t before, after;
+    if (!read_ticks_(before)) { return false; }
+    const uint64_t ns = read_clock_ns(FD_TO_CLOCKID(fd_));
+    const uint64_t realtime = read_clock_ns(CLOCK_REALTIME);
+    if (!read_ticks_(after) || ns == 0 || after < before) { return false; }
+
+    if (after - before < best_window) {
+      best_window = after - before;
+      best_ticks = before + (after - before) / 2;
+      best_ns = ns;
+      realtime_offset = static_cast<int64_t>(ns) - static_cast<int64_t>(realtime);
+    }
+  }
+
+  if (last_ticks_ != 0 && best_ticks > last_ticks_) {
+    const double ns_per_tick =
+        static_cast<double>(best_ns - last_ns_) / static_cast<double>(best_ticks - last_ticks_);
+    seq_.fetch_add(1, std::memory_order_acq_rel);
+    map_ticks_.store(best_ticks, std::memory_order_relaxed);
+    map_ns_.store(best_ns, std::memory_order_relaxed);
+    map_ns_per_tick_.store(ns_per_tick, std::memory_order_relaxed);
+    seq_.fetch_add(1, std::memory_order_release);
+  }
+
+  last_ticks_ = best_ticks;
+  last_ns_ = best_ns;
+  realtime_offset_ns_ = realtime_offset;
+  return true;
+}
+
+void PtpClock::sync_loop() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  while (running_) {
+    cv_.wait_for(lock, std::chrono::milliseconds(cfg_.sync_interval_ms_));
+    if (running_ && !sync()) { HOLOSCAN_LOG_WARN("Failed to sample the clock of {}", device_); }
+  }
+}
+
+PtpClock::Mapping PtpClock::load_mapping() const {
+  Mapping mapping;
+  uint32_t seq;
+  do {
+    seq = seq_.load(std::memory_order_acquire);
+    mapping.ticks = map_ticks_.load(std::memory_order_relaxed);
+    mapping.ns = map_ns_.load(std::memory_order_relaxed);
+    mapping.ns_per_tick = map_ns_per_tick_.load(std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_acquire);
+  } while ((seq & 1) != 0 || seq != seq_.load(std::memory_order_relaxed));
+  return mapping;
+}
+
+uint64_t PtpClock::ticks_to_ptp(uint64_t ticks) const {
+  const auto mapping = load_mapping();
+  if (mapping.ns_per_tick <= 0) { return 0; }
+  const double delta = static_cast<double>(static_cast<int64_t>(ticks - mapping.ticks));
+  return mapping.ns + static_cast<int64_t>(delta * mapping.ns_per_tick);
+}
+
+uint64_t PtpClock::ptp_to_ticks(uint64_t ns) const {
+  const auto mapping = load_mapping();
+  if (mapping.ns_per_tick <= 0) { return 0; }
+  const double delta = static_cast<double>(static_cast<int64_t>(ns - mapping.ns));
+  return mapping.ticks + static_cast<int64_t>(delta / mapping.ns_per_tick);
+}
+
+};  // namespace holoscan::advanced_network
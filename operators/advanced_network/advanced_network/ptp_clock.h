@@ -0,0 +1,115 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include "advanced_network/types.h"
+
+namespace holoscan::advanced_network {
+
+/**
+ * @brief PTP hardware clock (PHC) of a NIC, and the mapping of NIC timestamps to PTP time
+ *
+ * The PHC is the clock that ptp4l disciplines to the grandmaster, so its time is aligned across
+ * nodes. NIC timestamps are in device clock units: when the manager can read the device clock,
+ * a thread samples it against the PHC every sync interval. Each sample anchors a linear mapping
+ * whose rate is measured from the previous sample, which corrects the drift of the device clock
+ * against PTP time. Conversions are lock-free and can be called from any thread.
+ */
+class PtpClock {
+ public:
+  using TickReader = std::function<bool(uint64_t& ticks)>;
+
+  static constexpr int SAMPLES_PER_SYNC = 5;  // Tightest bracketed sample is kept
+
+  PtpClock(const PtpConfig& cfg, TickReader read_ticks)
+      : cfg_(cfg), read_ticks_(std::move(read_ticks)) {}
+  ~PtpClock() { stop(); }
+
+  /**
+   * @brief Open the PHC and take the first samples of the device clock
+   *
+   * @param address PCIe address or link name of the interface, to find its PHC
+   */
+  bool start(const std::string& address);
+  void stop();
+
+  /**
+   * @brief PHC device of an interface, /dev/ptpN, or an empty string if it has none
+   */
+  static std::string find_phc(const std::string& address);
+
+  /**
+   * @brief Current PTP time in nanoseconds
+   */
+  bool now(uint64_t& ns) const;
+
+  /**
+   * @brief Convert a NIC timestamp to PTP time, 0 until the device clock has been sampled twice
+   */
+  uint64_t ticks_to_ptp(uint64_t ticks) const;
+
+  /**
+   * @brief Convert a PTP time to NIC clock units, 0 until the device clock has been sampled twice
+   */
+  uint64_t ptp_to_ticks(uint64_t ns) const;
+
+  /**
+   * @brief PTP time minus CLOCK_REALTIME at the last sync, e.g. the TAI-UTC offset under ptp4l
+   */
+  int64_t realtime_offset_ns() const { return realtime_offset_ns_.load(); }
+
+  const std::string& device() const { return device_; }
+
+ private:
+  struct Mapping {
+    uint64_t ticks;
+    uint64_t ns;
+    double ns_per_tick;
+  };
+
+  bool sync();
+  void sync_loop();
+  Mapping load_mapping() const;
+
+  PtpConfig cfg_;
+  TickReader read_ticks_;
+  std::string device_;
+  int fd_ = -1;
+
+  // Seqlock over the mapping, odd while the sync thread updates it
+  std::atomic<uint32_t> seq_{0};
+  std::atomic<uint64_t> map_ticks_{0};
+  std::atomic<uint64_t> map_ns_{0};
+  std::atomic<double> map_ns_per_tick_{0};
+  std::atomic<int64_t> realtime_offset_ns_{0};
+  uint64_t last_ticks_ = 0;
+  uint64_t last_ns_ = 0;
+
+  std::atomic<bool> running_{false};
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  std::thread thread_;
+};
+
+};  // namespace holoscan::advanced_network
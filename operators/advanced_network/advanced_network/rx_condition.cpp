@@ -0,0 +1,91 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "advanced_network/rx_condition.h"
+#include <algorithm>
+#include "advanced_network/common.h"
+
+namespace holoscan::advanced_network {
+
+AdvNetworkRxCondition::~AdvNetworkRxCondition() {
+  // The callbacks hold this condition, they must be gone before it is
+  if (event_driven_) {
+    for (const int q : queues_) { set_rx_ready_callback(port_, q, nullptr); }
+  }
+}
+
+bool AdvNetworkRxCondition::watch(int port, const std::vector<int>& queues, int min_bursts) {
+  port_ = port;
+  queues_ = queues;
+  min_bursts_ = std::max(min_bursts, 1);
+  event_driven_ = !queues_.empty();
+
+  for (const int q : queues_) {
+    if (set_rx_ready_callback(port_, q, [this, q]() { on_rx_ready(q); }) != Status::SUCCESS) {
+      event_driven_ = false;
+      break;
+    }
+  }
+
+  if (!event_driven_) {
+    for (const int q : queues_) { set_rx_ready_callback(port_, q, nullptr); }
+    HOLOSCAN_LOG_WARN("{}: manager doesn't signal ready RX bursts on port {}, polling instead",
+                      name(),
+                      port_);
+    return false;
+  }
+
+  HOLOSCAN_LOG_INFO("{}: waiting for {} RX bursts on {} queues of port {}",
+                    name(),
+                    min_bursts_,
+                    queues_.size(),
+                    port_);
+  rearm();
+  return true;
+}
+
+void AdvNetworkRxCondition::rearm() {
+  if (!event_driven_) { return; }
+
+  event_state(AsynchronousEventState::EVENT_WAITING);
+  if (ready()) { event_state(AsynchronousEventState::EVENT_DONE); }
+}
+
+void AdvNetworkRxCondition::unwatch() {
+  if (event_driven_) {
+    for (const int q : queues_) { set_rx_ready_callback(port_, q, nullptr); }
+    event_driven_ = false;
+  }
+  event_state(AsynchronousEventState::EVENT_NEVER);
+}
+
+bool AdvNetworkRxCondition::ready() const {
+  for (const int q : queues_) {
+    if (get_rx_burst_count(port_, q) >= min_bursts_) { return true; }
+  }
+  return false;
+}
+
+void AdvNetworkRxCondition::on_rx_ready(int q) {
+  // Runs on the RX worker: a state check and a ring count, nothing that can block
+  if (event_state() == AsynchronousEventState::EVENT_WAITING &&
+      get_rx_burst_count(port_, q) >= min_bursts_) {
+    event_state(AsynchronousEventState::EVENT_DONE);
+  }
+}
+
+}  // namespace holoscan::advanced_network
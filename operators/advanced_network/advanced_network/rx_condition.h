@@ -0,0 +1,85 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <vector>
+#include "holoscan/holoscan.hpp"
+
+namespace holoscan::advanced_network {
+
+/**
+ * @brief Scheduling condition of an operator receiving from advanced_network queues
+ *
+ * Instead of ticking the operator continuously to poll get_rx_burst, the condition waits until
+ * the manager signals that at least min_bursts bursts are ready on one of the watched queues.
+ * The manager's RX workers wake the condition with set_rx_ready_callback, which lets the event
+ * based and multi-thread schedulers run other operators, or sleep, while no packets arrive.
+ *
+ * Usage, from an operator receiving on a port:
+ *  - create it in initialize() with make_condition and add it with add_arg before calling
+ *    Operator::initialize()
+ *  - call watch() once the port is known, e.g. in start()
+ *  - call rearm() at the end of each compute(), after draining the queues
+ *  - call unwatch() in stop()
+ *
+ * With a manager that doesn't signal ready bursts, the condition never waits and the operator
+ * polls as before.
+ */
+class AdvNetworkRxCondition : public holoscan::AsynchronousCondition {
+ public:
+  HOLOSCAN_CONDITION_FORWARD_ARGS_SUPER(AdvNetworkRxCondition, holoscan::AsynchronousCondition)
+
+  AdvNetworkRxCondition() = default;
+  ~AdvNetworkRxCondition() override;
+
+  /**
+   * @brief Start waiting for bursts on queues of a port
+   *
+   * @param port Port ID of interface
+   * @param queues Queue IDs to watch
+   * @param min_bursts Number of bursts ready on a queue before the operator runs
+   * @return true if the manager signals ready bursts, false if the operator keeps polling
+   */
+  bool watch(int port, const std::vector<int>& queues, int min_bursts = 1);
+
+  /**
+   * @brief Wait for the next bursts
+   *
+   * The queues are checked again after going back to waiting, so bursts enqueued while the
+   * operator was running don't wait for the next signal.
+   */
+  void rearm();
+
+  /**
+   * @brief Stop watching the queues, and never run the operator again
+   */
+  void unwatch();
+
+  bool event_driven() const { return event_driven_; }
+
+ private:
+  bool ready() const;
+  void on_rx_ready(int q);
+
+  int port_ = -1;
+  std::vector<int> queues_;
+  int min_bursts_ = 1;
+  bool event_driven_ = false;
+};
+
+}  // namespace holoscan::advanced_network
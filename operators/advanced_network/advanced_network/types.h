@@ -41,6 +41,7 @@ static inline constexpr uint32_t MAX_NUM_RX_QUEUES = 32;
 static inline constexpr uint32_t MAX_NUM_TX_QUEUES = 32;
 static inline constexpr uint32_t MAX_INTERFACES = 4;
 static inline constexpr int MAX_NUM_SEGS = 4;
+static inline constexpr int MAX_RX_FILTER_RULES = 8;
 
 
 
@@ -59,6 +60,50 @@ struct BurstHeaderParams {
   uint32_t max_pkt_size;
   uint32_t gpu_pkt0_idx;
   uintptr_t gpu_pkt0_addr;
+  uint64_t ptp_timestamp;  // PTP time of the first packet in ns, 0 if not available
+};
+
+/**
+ * @brief Frame carried by a frame-aligned RX burst
+ *
+ * Lost packets have no buffer, so when missing_pkts isn't 0 the payloads of the packets that
+ * follow a loss are not at their position in the frame.
+ */
+struct BurstFrameInfo {
+  void* payload_ptr;      // Payload of the first packet of the burst
+  size_t payload_stride;  // Distance between the payloads of consecutive packets
+  uint32_t num_pkts;      // Packets received in the burst
+  uint32_t missing_pkts;  // Packets of the frame lost, from gaps in the sequence numbers
+  bool contiguous;        // Payloads are all at payload_stride intervals from payload_ptr
+  bool complete;          // Burst ends on a frame boundary rather than on the burst capacity
+};
+
+/**
+ * @brief Destination of the packets of one flow demultiplexed by demux_rx_burst
+ *
+ * Packets of the flow are copied to slot (seq - first_seq) of buf, where the sequence number is
+ * read from seq_width_ bytes at seq_offset_ in the first segment of the packet. With seq_width_
+ * 0 the packets fill the slots in the order they are demultiplexed.
+ */
+struct FlowDemuxConfig {
+  uint16_t flow_id_;            // Flow ID returned by get_packet_flow_id
+  void* buf_;                   // GPU buffer of num_slots_ * slot_size_ bytes
+  uint32_t num_slots_;          // Packets in a frame of the flow
+  uint16_t slot_size_;          // Bytes copied from each packet and size of a slot
+  uint16_t payload_offset_;     // Offset of the copy in the last segment of the packet
+  uint16_t seq_offset_ = 0;     // Offset of the sequence number in the first segment
+  uint8_t seq_width_ = 0;       // Width of the sequence number in bytes: 0, 1, 2, 4 or 8
+  bool seq_big_endian_ = true;  // Sequence number is in network order
+};
+
+/**
+ * @brief Progress of the current frame of a demultiplexed flow
+ */
+struct FlowDemuxStatus {
+  uint64_t first_seq;    // Sequence number of the first slot
+  uint32_t num_pkts;     // Packets written to the frame
+  uint32_t num_dropped;  // Packets outside the frame
+  bool complete;         // Every slot of the frame was written
 };
 
 struct BurstHeader {
@@ -85,6 +130,14 @@ struct BurstParams {
   cudaEvent_t event;
 };
 
+/**
+ * @brief Callback returning an application TX buffer once the NIC is done with it
+ *
+ * Called with the buffer address and the argument passed with the buffer, from the thread that
+ * frees the packet, usually the TX worker of the queue.
+ */
+using TxBufferFreeCallback = void (*)(void* addr, void* arg);
+
 // Example IPV4 UDP packet using Linux headers
 struct UDPIPV4Pkt {
   struct ethhdr eth;
@@ -179,11 +232,15 @@ enum class ManagerType {
   DPDK,
   DOCA,
   RIVERMAX,
+  RDMA,
+  AF_XDP,
 };
 
 static constexpr const char* ANO_MGR_STR__DPDK = "dpdk";
 static constexpr const char* ANO_MGR_STR__GPUNETIO = "gpunetio";
 static constexpr const char* ANO_MGR_STR__RIVERMAX = "rivermax";
+static constexpr const char* ANO_MGR_STR__RDMA = "rdma";
+static constexpr const char* ANO_MGR_STR__AF_XDP = "af_xdp";
 static constexpr const char* ANO_MGR_STR__DEFAULT = "default";
 
 /**
@@ -196,11 +253,15 @@ inline ManagerType manager_type_from_string(const std::string& str) {
   if (str == ANO_MGR_STR__DPDK) return ManagerType::DPDK;
   if (str == ANO_MGR_STR__GPUNETIO) return ManagerType::DOCA;
   if (str == ANO_MGR_STR__RIVERMAX) return ManagerType::RIVERMAX;
+  if (str == ANO_MGR_STR__RDMA) return ManagerType::RDMA;
+  if (str == ANO_MGR_STR__AF_XDP) return ManagerType::AF_XDP;
   if (str == ANO_MGR_STR__DEFAULT) return ManagerType::DEFAULT;
   throw std::logic_error(std::string("Unknown manager type. Valid options: ") +
                         ANO_MGR_STR__DPDK + "/" +
                         ANO_MGR_STR__GPUNETIO + "/" +
                         ANO_MGR_STR__RIVERMAX + "/" +
+                        ANO_MGR_STR__RDMA + "/" +
+                        ANO_MGR_STR__AF_XDP + "/" +
                         ANO_MGR_STR__DEFAULT);
 }
 
@@ -218,6 +279,10 @@ inline std::string manager_type_to_string(ManagerType type) {
       return ANO_MGR_STR__GPUNETIO;
     case ManagerType::RIVERMAX:
       return ANO_MGR_STR__RIVERMAX;
+    case ManagerType::RDMA:
+      return ANO_MGR_STR__RDMA;
+    case ManagerType::AF_XDP:
+      return ANO_MGR_STR__AF_XDP;
     case ManagerType::DEFAULT:
       return ANO_MGR_STR__DEFAULT;
     default:
@@ -305,13 +370,26 @@ struct CommonQueueConfig {
   std::string name_;
   int id_;
   int batch_size_;
-  int split_boundary_;
+  int split_boundary_ = 0;
   std::string cpu_core_;
   std::vector<std::string> mrs_;
   std::vector<std::string> offloads_;
   ManagerExtraQueueConfig* extra_queue_config_;
 };
 
+/**
+ * @brief Memory region affinity value used for `affinity: auto`
+ *
+ * Resolved at initialization to the NUMA node (CPU memory) or the GPU (device memory) closest
+ * to the NIC whose queues use the region.
+ */
+static inline constexpr uint16_t MR_AFFINITY_AUTO = UINT16_MAX;
+
+/**
+ * @brief Queue CPU core value resolved at initialization to a core local to the NIC
+ */
+static inline constexpr const char* CPU_CORE_AUTO = "auto";
+
 struct MemoryRegionConfig {
   std::string name_;
   MemoryKind kind_;
@@ -322,15 +400,239 @@ struct MemoryRegionConfig {
   size_t ttl_size_;  // Populated by driver
   size_t num_bufs_;
   bool owned_;
+  bool prefault_ = false;  // Fault in all CPU pages at allocation
+};
+
+/**
+ * @brief Action taken by an RX worker when the application falls behind
+ *
+ * DROP_NEWEST:         Drop the packets being received until buffers are freed (default)
+ * DROP_OLDEST_IN_RING: Reclaim the oldest burst not yet picked up by the application
+ * BLOCK:               Wait for the application to free buffers, letting the NIC drop packets
+ * ABORT:               Terminate the process
+ */
+enum class RxOverloadPolicy { DROP_NEWEST, DROP_OLDEST_IN_RING, BLOCK, ABORT, INVALID };
+
+inline RxOverloadPolicy GetRxOverloadPolicyFromString(const std::string& policy_str) {
+  if (policy_str == "drop_newest") {
+    return RxOverloadPolicy::DROP_NEWEST;
+  } else if (policy_str == "drop_oldest_in_ring") {
+    return RxOverloadPolicy::DROP_OLDEST_IN_RING;
+  } else if (policy_str == "block") {
+    return RxOverloadPolicy::BLOCK;
+  } else if (policy_str == "abort") {
+    return RxOverloadPolicy::ABORT;
+  }
+
+  return RxOverloadPolicy::INVALID;
+}
+
+/**
+ * @brief How the GPUNetIO manager launches its GPU receive kernel
+ *
+ * PERSISTENT:     A single kernel keeps receiving on all queues until shutdown (default)
+ * NON_PERSISTENT: The RX worker launches the receive kernel once per batch
+ * CUDA_GRAPH:     The RX worker replays a CUDA graph of the receive kernel once per batch
+ */
+enum class RxKernelMode { PERSISTENT, NON_PERSISTENT, CUDA_GRAPH, INVALID };
+
+inline RxKernelMode GetRxKernelModeFromString(const std::string& mode_str) {
+  if (mode_str == "persistent") {
+    return RxKernelMode::PERSISTENT;
+  } else if (mode_str == "non_persistent") {
+    return RxKernelMode::NON_PERSISTENT;
+  } else if (mode_str == "cuda_graph") {
+    return RxKernelMode::CUDA_GRAPH;
+  }
+
+  return RxKernelMode::INVALID;
+}
+
+/**
+ * @brief Capture tap of an RX queue to a pcapng file. An empty file disables the tap.
+ */
+struct RxTapConfig {
+  std::string file_;              // pcapng file written by the tap
+  std::string cpu_core_;          // Core of the writer thread, not shared with RX/TX workers
+  uint32_t snap_len_ = 0;         // Bytes captured per packet, 0 for the whole packet
+  uint32_t buffer_pkts_ = 8192;   // Packets held by the tap before new ones are not captured
+};
+
+/**
+ * @brief Adaptive polling of an RX queue. When disabled the RX worker always busy polls.
+ *
+ * After idle_polls empty polls the worker backs off with a pause between polls, and after
+ * pause_polls more it sleeps on the RX interrupt of its queues. It goes back to busy polling
+ * on the first packet.
+ */
+struct RxAdaptivePollConfig {
+  bool enabled_ = false;
+  uint32_t idle_polls_ = 1024;    // Empty polls before pausing between polls
+  uint32_t pause_polls_ = 16384;  // Empty paused polls before sleeping on the RX interrupt
+  uint32_t max_sleep_ms_ = 100;   // Longest sleep before polling again
+};
+
+/**
+ * @brief Action of an RX filter rule on the packets it matches
+ *
+ * DROP:   The packet is left out of the burst
+ * ACCEPT: The packet is kept
+ * TAG:    The packet is kept and get_packet_flow_id returns the tag of the rule
+ */
+enum class RxFilterAction { DROP, ACCEPT, TAG, INVALID };
+
+inline RxFilterAction GetRxFilterActionFromString(const std::string& action_str) {
+  if (action_str == "drop") {
+    return RxFilterAction::DROP;
+  } else if (action_str == "accept") {
+    return RxFilterAction::ACCEPT;
+  } else if (action_str == "tag") {
+    return RxFilterAction::TAG;
+  }
+
+  return RxFilterAction::INVALID;
+}
+
+/**
+ * @brief Rule of the RX filter evaluated on the GPU by the receive kernel
+ *
+ * A packet matches when its big-endian field of size bytes at offset, masked with mask, equals
+ * value, or differs from it when negate is set. Packets too short for the field don't match.
+ * Rules are evaluated in order and the first match decides, packets matching none are kept.
+ */
+struct RxFilterRule {
+  std::string name_;
+  uint16_t offset_ = 0;
+  uint8_t size_ = 1;  // 1, 2 or 4 bytes
+  uint32_t mask_ = 0xFFFFFFFF;
+  uint32_t value_ = 0;
+  bool negate_ = false;
+  RxFilterAction action_ = RxFilterAction::DROP;
+  uint16_t tag_ = 0;
 };
 
 struct RxQueueConfig {
   CommonQueueConfig common_;
   uint64_t timeout_us_;
+  RxOverloadPolicy overload_policy_ = RxOverloadPolicy::DROP_NEWEST;
+  RxTapConfig tap_;
+  RxAdaptivePollConfig adaptive_poll_;
+  std::vector<RxFilterRule> filter_;
+};
+
+/**
+ * @brief How the GPUNetIO manager launches its GPU send kernel
+ *
+ * PER_QUEUE:  The TX worker launches one send kernel per burst and queue (default)
+ * BATCHED:    The TX worker launches one send kernel for the bursts of all its queues
+ * PERSISTENT: A single kernel sends the bursts posted by the TX worker to a GPU-visible ring
+ */
+enum class TxKernelMode { PER_QUEUE, BATCHED, PERSISTENT, INVALID };
+
+inline TxKernelMode GetTxKernelModeFromString(const std::string& mode_str) {
+  if (mode_str == "per_queue") {
+    return TxKernelMode::PER_QUEUE;
+  } else if (mode_str == "batched") {
+    return TxKernelMode::BATCHED;
+  } else if (mode_str == "persistent") {
+    return TxKernelMode::PERSISTENT;
+  }
+
+  return TxKernelMode::INVALID;
+}
+
+/**
+ * @brief Rate shaping of a TX queue. All-zero values disable shaping.
+ */
+struct TxRateLimitConfig {
+  double gbps_ = 0;           // Target rate on the wire in Gbps, 0 for no rate limit
+  uint32_t burst_bytes_ = 0;  // Bytes allowed back to back at line rate after idling
+  uint32_t ipg_ns_ = 0;       // Minimal time between the start of two packets
 };
 
 struct TxQueueConfig {
   CommonQueueConfig common_;
+  TxRateLimitConfig rate_limit_;
+};
+
+/**
+ * @brief Summary of a latency distribution in nanoseconds
+ *
+ */
+struct LatencySummary {
+  uint64_t count = 0;
+  uint64_t min_ns = 0;
+  uint64_t max_ns = 0;
+  uint64_t mean_ns = 0;
+  uint64_t p50_ns = 0;
+  uint64_t p99_ns = 0;
+  uint64_t p999_ns = 0;
+};
+
+/**
+ * @brief Latency statistics of a single RX queue
+ *
+ * wire_to_dequeue: NIC RX timestamp of the first packet in a burst until the burst is dequeued.
+ *                  Only populated when the NIC supports RX timestamps.
+ * ring_to_dequeue: Burst handed off by the RX worker until it's dequeued by the application
+ * dequeue_to_free: Burst dequeued by the application until it's freed
+ */
+struct QueueLatencyStats {
+  uint16_t port_id;
+  uint16_t q_id;
+  LatencySummary wire_to_dequeue;
+  LatencySummary ring_to_dequeue;
+  LatencySummary dequeue_to_free;
+};
+
+/**
+ * @brief Counters of a single port, as reported by the NIC
+ */
+struct PortStats {
+  uint16_t port_id = 0;
+  uint64_t rx_packets = 0;
+  uint64_t rx_bytes = 0;
+  uint64_t rx_missed = 0;  // Dropped by the NIC for lack of RX descriptors
+  uint64_t rx_errors = 0;
+  uint64_t tx_packets = 0;
+  uint64_t tx_bytes = 0;
+  uint64_t tx_errors = 0;
+};
+
+/**
+ * @brief Counters of a single queue. Counters a manager doesn't track are left at 0
+ */
+struct QueueStats {
+  uint16_t port_id = 0;
+  uint16_t q_id = 0;
+  Direction dir = Direction::RX;
+  uint64_t packets = 0;
+  uint64_t bytes = 0;
+  uint64_t drops = 0;           // Packets of the queue dropped by the NIC or the manager
+  uint32_t ring_occupancy = 0;  // Bursts waiting between the worker and the application
+  uint32_t ring_capacity = 0;
+};
+
+/**
+ * @brief Free buffers of a buffer or burst pool
+ */
+struct PoolStats {
+  std::string name;
+  uint32_t free = 0;
+  uint32_t size = 0;
+  uint64_t exhausted = 0;  // Allocations that found the pool empty, if the manager tracks them
+};
+
+/**
+ * @brief Snapshot of the statistics of the manager returned by get_stats
+ */
+struct ManagerStats {
+  uint64_t timestamp_ns = 0;  // Wall clock time of the snapshot
+  uint64_t rx_dropped = 0;    // Packets dropped by the manager when the application falls behind
+  std::vector<PortStats> ports;
+  std::vector<QueueStats> queues;
+  std::vector<PoolStats> pools;
+  std::vector<QueueLatencyStats> latency;  // RX queues with latency stats enabled
 };
 
 // struct FlowConfig {
@@ -368,26 +670,84 @@ struct CommonConfig {
 
 struct RxConfig {
   bool flow_isolation_;
+  bool latency_stats_ = false;
+  RxKernelMode kernel_mode_ = RxKernelMode::PERSISTENT;
   std::vector<RxQueueConfig> queues_;
   std::vector<FlowConfig> flows_;
 };
 
 struct TxConfig {
   bool accurate_send_ = false;
+  TxKernelMode kernel_mode_ = TxKernelMode::PER_QUEUE;
   std::vector<TxQueueConfig> queues_;
   std::vector<FlowConfig> flows_;
 };
 
+/**
+ * @brief Connection of an interface to its peer with the RDMA manager
+ *
+ * The server listens on port and the client connects to it at peer_address to exchange the
+ * queue pairs. TX queue N of each side then writes into RX queue N of the other side.
+ */
+struct RdmaConfig {
+  bool server_ = true;
+  std::string peer_address_;  // IP address of the server, used by the client
+  uint16_t port_ = 18515;     // TCP port of the connection setup
+  int gid_index_ = 3;         // GID table index of the RoCE v2 address of the NIC
+};
+
+/**
+ * @brief AF_XDP socket options of an interface with the AF_XDP manager
+ */
+struct AfXdpConfig {
+  bool zero_copy_ = true;       // Falls back to copy mode when the driver has no zero-copy
+  uint32_t busy_poll_us_ = 20;  // SO_BUSY_POLL time of the sockets, 0 disables busy polling
+};
+
+/**
+ * @brief PTP hardware clock of an interface, used to convert NIC timestamps to PTP time
+ */
+struct PtpConfig {
+  bool enabled_ = false;
+  std::string device_;                // PHC device, found from the interface address if empty
+  uint32_t sync_interval_ms_ = 1000;  // Interval between samples of the NIC clock and the PHC
+};
+
 struct InterfaceConfig {
   std::string name_;
   std::string address_;
   uint16_t port_id_;
   RxConfig rx_;
   TxConfig tx_;
+  RdmaConfig rdma_;
+  AfXdpConfig af_xdp_;
+  PtpConfig ptp_;
+};
+
+/**
+ * @brief HTTP endpoint serving get_stats in the Prometheus text format. Port 0 disables it.
+ */
+struct MetricsConfig {
+  uint16_t port_ = 0;
+  std::string address_ = "0.0.0.0";
+  int cpu_core_ = -1;  // Core of the server thread, -1 to leave it unpinned
+};
+
+/**
+ * @brief DPDK multi-process role. The primary owns the ports, pools, flows and RX/TX workers.
+ * Secondary processes attach to its rings and pools by name to receive and send bursts.
+ */
+enum class ProcessType { STANDALONE, PRIMARY, SECONDARY };
+
+struct MultiProcessConfig {
+  ProcessType type_ = ProcessType::STANDALONE;
+  std::string file_prefix_ = "holoscan_ano";  // Shared by the primary and its secondaries
 };
 
 struct NetworkConfig {
   CommonConfig common_;
+  MetricsConfig metrics_;
+  MultiProcessConfig multi_process_;
   std::unordered_map<std::string, MemoryRegionConfig> mrs_;
   std::vector<InterfaceConfig> ifs_;
   uint16_t debug_;
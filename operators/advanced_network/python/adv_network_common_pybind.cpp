@@ -16,12 +16,186 @@
  */
 
 #include "advanced_network/common.h"
+#include <cuda_runtime.h>
+#include <dlpack/dlpack.h>
 #include <pybind11/pybind11.h>
+#include <pybind11/stl.h>
+
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <vector>
 
 namespace py = pybind11;
 
 namespace holoscan::advanced_network {
 
+/**
+ * Validity flag shared by all views of a burst. Views are invalidated when the packets of the
+ * burst are freed through the Python bindings, so a stale view raises instead of exposing
+ * packet buffers that may already be reused by the NIC. All accesses happen with the GIL held.
+ */
+struct BurstViewState {
+  bool valid = true;
+};
+
+static std::unordered_map<BurstParams*, std::vector<std::weak_ptr<BurstViewState>>> burst_views;
+
+static void invalidate_burst_views(BurstParams* burst) {
+  auto it = burst_views.find(burst);
+  if (it == burst_views.end()) { return; }
+  for (auto& weak_state : it->second) {
+    if (auto state = weak_state.lock()) { state->valid = false; }
+  }
+  burst_views.erase(it);
+}
+
+/**
+ * Zero-copy 2D view of one segment of all packets in an RX burst.
+ *
+ * The view has a [num_pkts, length] uint8 shape, where rows are strided by the distance
+ * between consecutive packet buffers. This matches fixed-size packets with header-data split,
+ * where the payload segment of each packet lives in a contiguous GPU buffer. The view is
+ * exported through __cuda_array_interface__ (or __array_interface__ for host memory) and
+ * DLPack, and is only valid until the burst is freed with free_all_packets_and_burst_rx.
+ */
+class BurstSegmentView {
+ public:
+  BurstSegmentView(BurstParams* burst, int seg, int length) {
+    if (burst == nullptr) { throw std::invalid_argument("Burst is null"); }
+    if (seg < 0 || seg >= burst->hdr.hdr.num_segs) {
+      throw std::out_of_range("Invalid segment " + std::to_string(seg));
+    }
+
+    num_pkts_ = get_num_packets(burst);
+    if (num_pkts_ == 0) { return; }
+
+    auto base = reinterpret_cast<uintptr_t>(get_segment_packet_ptr(burst, seg, 0));
+    length_ = length >= 0 ? length : get_segment_packet_length(burst, seg, 0);
+    pitch_ = length_;
+    if (num_pkts_ > 1) {
+      pitch_ = static_cast<int64_t>(
+          reinterpret_cast<uintptr_t>(get_segment_packet_ptr(burst, seg, 1)) - base);
+    }
+    if (pitch_ < length_) {
+      throw std::runtime_error("Packets of segment " + std::to_string(seg) +
+                               " overlap or are not in increasing address order");
+    }
+    for (int64_t i = 2; i < num_pkts_; i++) {
+      if (reinterpret_cast<uintptr_t>(get_segment_packet_ptr(burst, seg, i)) !=
+          base + i * pitch_) {
+        throw std::runtime_error("Packets of segment " + std::to_string(seg) +
+                                 " are not evenly strided, use get_segment_packet_ptr instead");
+      }
+    }
+
+    data_ = base;
+    cudaPointerAttributes attr;
+    if (cudaPointerGetAttributes(&attr, reinterpret_cast<void*>(base)) == cudaSuccess &&
+        (attr.type == cudaMemoryTypeDevice || attr.type == cudaMemoryTypeManaged)) {
+      on_device_ = true;
+      device_id_ = attr.device;
+    } else {
+      cudaGetLastError();
+    }
+
+    burst_views[burst].push_back(state_);
+  }
+
+  bool valid() const { return state_->valid; }
+  bool on_device() const { return on_device_; }
+  py::tuple shape() const { return py::make_tuple(num_pkts_, length_); }
+  int64_t pitch() const { return pitch_; }
+
+  py::dict cuda_array_interface() const {
+    if (!on_device_) { throw py::attribute_error("Burst segment is not in device memory"); }
+    py::dict iface = array_interface_dict();
+    iface["stream"] = py::none();
+    return iface;
+  }
+
+  py::dict array_interface() const {
+    if (on_device_) { throw py::attribute_error("Burst segment is not in host memory"); }
+    return array_interface_dict();
+  }
+
+  py::tuple dlpack_device() const {
+    return on_device_ ? py::make_tuple(static_cast<int>(kDLCUDA), device_id_)
+                      : py::make_tuple(static_cast<int>(kDLCPU), 0);
+  }
+
+  py::capsule dlpack(py::object /* stream */) const {
+    check_valid();
+
+    // Packet data is written by the NIC before the burst is handed to the application, so
+    // there is no producer stream to synchronize with the consumer's stream.
+    auto ctx = new DLPackContext;
+    ctx->shape[0] = num_pkts_;
+    ctx->shape[1] = length_;
+    ctx->strides[0] = pitch_;
+    ctx->strides[1] = 1;
+
+    DLTensor& tensor = ctx->tensor.dl_tensor;
+    tensor.data = reinterpret_cast<void*>(data_);
+    tensor.device = on_device_ ? DLDevice{kDLCUDA, device_id_} : DLDevice{kDLCPU, 0};
+    tensor.ndim = 2;
+    tensor.dtype = DLDataType{kDLUInt, 8, 1};
+    tensor.shape = ctx->shape;
+    tensor.strides = ctx->strides;
+    tensor.byte_offset = 0;
+    ctx->tensor.manager_ctx = ctx;
+    ctx->tensor.deleter = [](DLManagedTensor* self) {
+      delete static_cast<DLPackContext*>(self->manager_ctx);
+    };
+
+    // Consumers rename the capsule to "used_dltensor" and take over the deleter
+    PyObject* capsule = PyCapsule_New(&ctx->tensor, "dltensor", [](PyObject* obj) {
+      if (PyCapsule_IsValid(obj, "dltensor")) {
+        auto tensor = static_cast<DLManagedTensor*>(PyCapsule_GetPointer(obj, "dltensor"));
+        tensor->deleter(tensor);
+      }
+    });
+    if (capsule == nullptr) {
+      delete ctx;
+      throw py::error_already_set();
+    }
+    return py::reinterpret_steal<py::capsule>(capsule);
+  }
+
+ private:
+  struct DLPackContext {
+    DLManagedTensor tensor;
+    int64_t shape[2];
+    int64_t strides[2];
+  };
+
+  void check_valid() const {
+    if (!state_->valid) {
+      throw std::runtime_error("Burst segment view used after its burst was freed");
+    }
+  }
+
+  py::dict array_interface_dict() const {
+    check_valid();
+    py::dict iface;
+    iface["shape"] = shape();
+    iface["typestr"] = "|u1";
+    iface["data"] = py::make_tuple(data_, false);
+    iface["strides"] = py::make_tuple(pitch_, 1);
+    iface["version"] = 3;
+    return iface;
+  }
+
+  std::shared_ptr<BurstViewState> state_ = std::make_shared<BurstViewState>();
+  uintptr_t data_ = 0;
+  int64_t num_pkts_ = 0;
+  int64_t length_ = 0;
+  int64_t pitch_ = 0;
+  bool on_device_ = false;
+  int device_id_ = 0;
+};
+
 PYBIND11_MODULE(_advanced_network_common, m) {
   m.doc() = "Advanced Network utility functions";
 
@@ -42,16 +216,25 @@ PYBIND11_MODULE(_advanced_network_common, m) {
         py::overload_cast<BurstParams*, int>(&get_packet_length),
         "Get length of the packet");
   m.def("free_all_segment_packets",
-        py::overload_cast<BurstParams*, int>(&free_all_segment_packets),
+        [](BurstParams* burst, int seg) {
+          invalidate_burst_views(burst);
+          free_all_segment_packets(burst, seg);
+        },
         "Free all packets in a burst for one segment");
   m.def("free_all_packets_and_burst_rx",
-        py::overload_cast<BurstParams*>(&free_all_packets_and_burst_rx),
+        [](BurstParams* burst) {
+          invalidate_burst_views(burst);
+          free_all_packets_and_burst_rx(burst);
+        },
         "Free all packets and burst structure for RX");
   m.def("free_all_packets_and_burst_tx",
         py::overload_cast<BurstParams*>(&free_all_packets_and_burst_tx),
         "Free all packets and burst structure for TX");
   m.def("free_segment_packets_and_burst",
-        py::overload_cast<BurstParams*, int>(&free_segment_packets_and_burst),
+        [](BurstParams* burst, int seg) {
+          invalidate_burst_views(burst);
+          free_segment_packets_and_burst(burst, seg);
+        },
         "Free all packets and burst structure for one packet segment");
   m.def("tx_burst_available",
         py::overload_cast<BurstParams*>(&is_tx_burst_available),
@@ -88,7 +271,10 @@ PYBIND11_MODULE(_advanced_network_common, m) {
         py::overload_cast<BurstParams*>(&free_tx_burst),
         "Free TX burst");
   m.def("free_rx_burst",
-        py::overload_cast<BurstParams*>(&free_rx_burst),
+        [](BurstParams* burst) {
+          invalidate_burst_views(burst);
+          free_rx_burst(burst);
+        },
         "Free RX burst");
   m.def("get_segment_packet_ptr",
         py::overload_cast<BurstParams*, int, int>(&get_segment_packet_ptr),
@@ -102,6 +288,32 @@ PYBIND11_MODULE(_advanced_network_common, m) {
       return py::make_tuple(status, py::cast(burst_ptr,
             py::return_value_policy::take_ownership));
       }, py::arg("port"), py::arg("q"));
+  m.def("get_ptp_time", [](int port) {
+      uint64_t time = 0;
+      Status status = get_ptp_time(port, &time);
+      return py::make_tuple(status, time);
+      }, py::arg("port"), "Get the PTP time of an interface in nanoseconds");
+  m.def("get_burst_ptp_timestamp",
+        [](BurstParams* burst) { return burst->hdr.hdr.ptp_timestamp; },
+        "Get the PTP time of the first packet of an RX burst, 0 if not available");
+  m.def("get_segment_packets_view",
+        [](BurstParams* burst, int seg, int length) {
+          return BurstSegmentView(burst, seg, length);
+        },
+        py::arg("burst"), py::arg("seg"), py::arg("length") = -1,
+        "Get a zero-copy [num_pkts, length] view of one segment of all packets in a burst. "
+        "length defaults to the segment length of the first packet. The view is invalid "
+        "once the burst is freed");
+
+  py::class_<BurstSegmentView>(m, "BurstSegmentView")
+      .def_property_readonly("__cuda_array_interface__", &BurstSegmentView::cuda_array_interface)
+      .def_property_readonly("__array_interface__", &BurstSegmentView::array_interface)
+      .def("__dlpack__", &BurstSegmentView::dlpack, py::arg("stream") = py::none())
+      .def("__dlpack_device__", &BurstSegmentView::dlpack_device)
+      .def_property_readonly("shape", &BurstSegmentView::shape)
+      .def_property_readonly("pitch", &BurstSegmentView::pitch)
+      .def_property_readonly("on_device", &BurstSegmentView::on_device)
+      .def_property_readonly("valid", &BurstSegmentView::valid);
 
   // py::class_<BurstHeaderParams>(m, "BurstHeaderParams").def(py::init<>())
   //     .def_readwrite("num_pkts",  &BurstHeaderParams::num_pkts)
@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: Copyright (c) 2022-2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-FileCopyrightText: Copyright (c) 2022-2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
  * SPDX-License-Identifier: Apache-2.0
  *
  * Licensed under the Apache License, Version 2.0 (the "License");
@@ -20,11 +20,17 @@
 #include <cuda.h>
 #include <cuda_runtime.h>
 
+#include <algorithm>
+#include <chrono>
+#include <mutex>
 #include <string>
+#include <thread>
 #include <utility>
 #include <vector>
 
 #include "gxf/multimedia/video.hpp"
+#include "gxf/std/tensor.hpp"
+#include "gxf/std/timestamp.hpp"
 #include "holoscan/core/condition.hpp"
 #include "holoscan/core/execution_context.hpp"
 #include "holoscan/core/gxf/entity.hpp"
@@ -35,6 +41,79 @@ namespace holoscan::ops {
 
 // used in more than one function
 constexpr uint32_t kNumBuffers = 2;
+// Frames allocated up front by the non-RDMA frame pool, more are added while all are in use
+constexpr uint32_t kNumPoolFrames = 4;
+// Overlay buffers of the low latency mode, so that a late overlay doesn't hold up the next one
+constexpr uint32_t kNumLowLatencyOverlayBuffers = 4;
+// Frames between two overlay latency summaries of the low latency mode
+constexpr uint64_t kOverlayReportFrames = 600;
+
+static int64_t SteadyNowNs() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+// HW frame of the double buffer of the capture channel at channel_index. The channels take
+// consecutive pairs of frames; the overlay, only available with a single channel, uses 2 and 3.
+static uint32_t HwFrame(size_t channel_index, uint32_t frame) {
+  return 2 * static_cast<uint32_t>(channel_index) + frame;
+}
+
+/**
+ * Frame buffers shared with downstream operators. A buffer goes back to the pool when the last
+ * message wrapping it is destroyed, and the buffers are freed once the pool and every frame
+ * emitted from it are gone.
+ */
+class AJAFramePool {
+ public:
+  AJAFramePool(size_t size, bool device) : size_(size), device_(device) {}
+
+  ~AJAFramePool() {
+    for (auto buf : buffers_) {
+      if (device_) {
+        cudaFree(buf);
+      } else {
+        cudaFreeHost(buf);
+      }
+    }
+  }
+
+  // A free buffer, or a new one if all of them are held downstream (then allocated is set).
+  void* acquire(bool* allocated) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    *allocated = false;
+    if (!free_.empty()) {
+      void* buf = free_.back();
+      free_.pop_back();
+      return buf;
+    }
+    void* buf = nullptr;
+    cudaError_t err = device_ ? cudaMalloc(&buf, size_)
+                              : cudaHostAlloc(&buf, size_, cudaHostAllocDefault);
+    if (err != cudaSuccess) { return nullptr; }
+    buffers_.push_back(buf);
+    *allocated = true;
+    return buf;
+  }
+
+  void release(void* buf) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    free_.push_back(buf);
+  }
+
+  size_t num_buffers() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return buffers_.size();
+  }
+
+ private:
+  size_t size_;
+  bool device_;
+  std::mutex mutex_;
+  std::vector<void*> buffers_;
+  std::vector<void*> free_;
+};
 
 AJASourceOp::AJASourceOp() {}
 
@@ -54,6 +133,9 @@ void AJASourceOp::setup(OperatorSpec& spec) {
   constexpr bool kDefaultEnableOverlay = false;
   constexpr bool kDefaultOverlayRDMA = false;
   constexpr NTV2Channel kDefaultOverlayChannel = NTV2_CHANNEL2;
+  constexpr bool kDefaultUpload = false;
+  constexpr bool kDefaultLowLatencyOverlay = false;
+  constexpr uint32_t kDefaultOverlaySlices = 4;
 
   spec.param(video_buffer_output_,
              "video_buffer_output",
@@ -63,6 +145,11 @@ void AJASourceOp::setup(OperatorSpec& spec) {
   spec.param(
       device_specifier_, "device", "Device", "Device specifier.", std::string(kDefaultDevice));
   spec.param(channel_, "channel", "Channel", "NTV2Channel to use.", kDefaultChannel);
+  spec.param(channels_,
+             "channels",
+             "Channels",
+             "NTV2Channels to capture in sync, in one message. Replaces channel when set.",
+             std::vector<NTV2Channel>{});
   spec.param(width_, "width", "Width", "Width of the stream.", kDefaultWidth);
   spec.param(height_, "height", "Height", "Height of the stream.", kDefaultHeight);
   spec.param(framerate_, "framerate", "Framerate", "Framerate of the stream.", kDefaultFramerate);
@@ -82,11 +169,27 @@ void AJASourceOp::setup(OperatorSpec& spec) {
              "OverlayBufferOutput",
              "Output for an empty overlay buffer.",
              &overlay_buffer_output);
+  spec.param(low_latency_overlay_,
+             "low_latency_overlay",
+             "LowLatencyOverlay",
+             "Poll for overlays several times per frame, so that they reach the mixer sooner.",
+             kDefaultLowLatencyOverlay);
+  spec.param(overlay_slices_,
+             "overlay_slices",
+             "OverlaySlices",
+             "Overlay polls per frame in low latency mode.",
+             kDefaultOverlaySlices);
   spec.param(overlay_buffer_input_,
              "overlay_buffer_input",
              "OverlayBufferInput",
              "Input for a filled overlay buffer.",
              &overlay_buffer_input);
+  spec.param(upload_,
+             "upload",
+             "Upload",
+             "Without RDMA, upload frames to device memory asynchronously.",
+             kDefaultUpload);
+  cuda_stream_handler_.define_params(spec);
 }
 
 AJAStatus AJASourceOp::DetermineVideoFormat() {
@@ -206,9 +309,37 @@ AJAStatus AJASourceOp::OpenDevice() {
     HOLOSCAN_LOG_ERROR("AJA device cannot capture video.");
     return AJA_STATUS_UNSUPPORTED;
   }
-  if (!NTV2_IS_VALID_CHANNEL(channel_)) {
-    HOLOSCAN_LOG_ERROR("Invalid AJA channel: {}", static_cast<int>(channel_.get()));
-    return AJA_STATUS_UNSUPPORTED;
+  for (auto channel : capture_channels_) {
+    if (!NTV2_IS_VALID_CHANNEL(channel)) {
+      HOLOSCAN_LOG_ERROR("Invalid AJA channel: {}", static_cast<int>(channel));
+      return AJA_STATUS_UNSUPPORTED;
+    }
+  }
+
+  // Check multi-channel capabilities.
+  if (capture_channels_.size() > 1) {
+    if (use_tsi_) {
+      HOLOSCAN_LOG_ERROR("Multi-channel capture does not support TSI formats");
+      return AJA_STATUS_UNSUPPORTED;
+    }
+    if (enable_overlay_) {
+      HOLOSCAN_LOG_ERROR("Multi-channel capture does not support the overlay");
+      return AJA_STATUS_UNSUPPORTED;
+    }
+    if (NTV2DeviceGetNumFrameStores(device_id_) < static_cast<int>(capture_channels_.size())) {
+      HOLOSCAN_LOG_ERROR("Insufficient number of frame stores for {} channels",
+                         capture_channels_.size());
+      return AJA_STATUS_UNSUPPORTED;
+    }
+    for (size_t i = 0; i < capture_channels_.size(); i++) {
+      for (size_t j = 0; j < i; j++) {
+        if (capture_channels_[i] == capture_channels_[j]) {
+          HOLOSCAN_LOG_ERROR("NTV2_CHANNEL{} is listed more than once",
+                             static_cast<int>(capture_channels_[i]) + 1);
+          return AJA_STATUS_UNSUPPORTED;
+        }
+      }
+    }
   }
 
   // Check overlay capabilities.
@@ -242,46 +373,39 @@ AJAStatus AJASourceOp::OpenDevice() {
   return AJA_STATUS_SUCCESS;
 }
 
-AJAStatus AJASourceOp::SetupVideo() {
-  constexpr size_t kWarmupFrames = 5;
-
+AJAStatus AJASourceOp::SetupCaptureChannel(NTV2Channel channel,
+                                            NTV2OutputXptID* input_output_xpt) {
   NTV2InputSourceKinds input_kind = is_kona_hdmi_ ? NTV2_INPUTSOURCES_HDMI : NTV2_INPUTSOURCES_SDI;
-  NTV2InputSource input_src = ::NTV2ChannelToInputSource(channel_, input_kind);
-  NTV2Channel tsi_channel = static_cast<NTV2Channel>(channel_ + 1);
-
-  if (!IsRGBFormat(pixel_format_)) {
-    HOLOSCAN_LOG_ERROR("YUV formats not yet supported");
-    return AJA_STATUS_UNSUPPORTED;
-  }
+  NTV2InputSource input_src = ::NTV2ChannelToInputSource(channel, input_kind);
+  NTV2Channel tsi_channel = static_cast<NTV2Channel>(channel + 1);
 
   // Detect if the source is YUV or RGB (i.e. if CSC is required or not).
   bool is_input_rgb(false);
   if (input_kind == NTV2_INPUTSOURCES_HDMI) {
     NTV2LHIHDMIColorSpace input_color;
-    device_.GetHDMIInputColor(input_color, channel_);
+    device_.GetHDMIInputColor(input_color, channel);
     is_input_rgb = (input_color == NTV2_LHIHDMIColorSpaceRGB);
   }
 
   // Setup the input routing.
-  device_.ClearRouting();
-  device_.EnableChannel(channel_);
+  device_.EnableChannel(channel);
   if (use_tsi_) {
-    device_.SetTsiFrameEnable(true, channel_);
+    device_.SetTsiFrameEnable(true, channel);
     device_.EnableChannel(tsi_channel);
   }
-  device_.SetMode(channel_, NTV2_MODE_CAPTURE);
+  device_.SetMode(channel, NTV2_MODE_CAPTURE);
   if (NTV2DeviceHasBiDirectionalSDI(device_id_) && NTV2_INPUT_SOURCE_IS_SDI(input_src)) {
-    device_.SetSDITransmitEnable(channel_, false);
+    device_.SetSDITransmitEnable(channel, false);
   }
-  device_.SetVideoFormat(video_format_, false, false, channel_);
-  device_.SetFrameBufferFormat(channel_, pixel_format_);
+  device_.SetVideoFormat(video_format_, false, false, channel);
+  device_.SetFrameBufferFormat(channel, pixel_format_);
   if (use_tsi_) { device_.SetFrameBufferFormat(tsi_channel, pixel_format_); }
-  device_.EnableInputInterrupt(channel_);
-  device_.SubscribeInputVerticalEvent(channel_);
+  device_.EnableInputInterrupt(channel);
+  device_.SubscribeInputVerticalEvent(channel);
 
-  NTV2OutputXptID input_output_xpt =
+  *input_output_xpt =
       GetInputSourceOutputXpt(input_src, /*DS2*/ false, is_input_rgb, /*Quadrant*/ 0);
-  NTV2InputXptID fb_input_xpt(GetFrameBufferInputXptFromChannel(channel_));
+  NTV2InputXptID fb_input_xpt(GetFrameBufferInputXptFromChannel(channel));
   if (use_tsi_) {
     if (!is_input_rgb) {
       if (NTV2DeviceGetNumCSCs(device_id_) < 4) {
@@ -311,17 +435,37 @@ AJAStatus AJASourceOp::SetupVideo() {
       device_.Connect(NTV2_Xpt425Mux2BInput, NTV2_XptHDMIIn1Q4RGB);
     }
   } else if (!is_input_rgb) {
-    if (NTV2DeviceGetNumCSCs(device_id_) <= static_cast<int>(channel_)) {
-      HOLOSCAN_LOG_ERROR("No CSC available for NTV2_CHANNEL{}", static_cast<int>(channel_) + 1);
+    if (NTV2DeviceGetNumCSCs(device_id_) <= static_cast<int>(channel)) {
+      HOLOSCAN_LOG_ERROR("No CSC available for NTV2_CHANNEL{}", static_cast<int>(channel) + 1);
       return AJA_STATUS_UNSUPPORTED;
     }
-    NTV2InputXptID csc_input = GetCSCInputXptFromChannel(channel_);
+    NTV2InputXptID csc_input = GetCSCInputXptFromChannel(channel);
     NTV2OutputXptID csc_output =
-        GetCSCOutputXptFromChannel(channel_, /*inIsKey*/ false, /*inIsRGB*/ true);
+        GetCSCOutputXptFromChannel(channel, /*inIsKey*/ false, /*inIsRGB*/ true);
     device_.Connect(fb_input_xpt, csc_output);
-    device_.Connect(csc_input, input_output_xpt);
+    device_.Connect(csc_input, *input_output_xpt);
   } else {
-    device_.Connect(fb_input_xpt, input_output_xpt);
+    device_.Connect(fb_input_xpt, *input_output_xpt);
+  }
+
+  return AJA_STATUS_SUCCESS;
+}
+
+AJAStatus AJASourceOp::SetupVideo() {
+  constexpr size_t kWarmupFrames = 5;
+
+  if (!IsRGBFormat(pixel_format_)) {
+    HOLOSCAN_LOG_ERROR("YUV formats not yet supported");
+    return AJA_STATUS_UNSUPPORTED;
+  }
+
+  device_.ClearRouting();
+  NTV2OutputXptID input_output_xpt = NTV2_XptBlack;
+  for (auto channel : capture_channels_) {
+    NTV2OutputXptID channel_output_xpt;
+    AJAStatus status = SetupCaptureChannel(channel, &channel_output_xpt);
+    if (AJA_FAILURE(status)) { return status; }
+    if (channel == capture_channels_.front()) { input_output_xpt = channel_output_xpt; }
   }
 
   if (enable_overlay_) {
@@ -357,8 +501,10 @@ AJAStatus AJASourceOp::SetupVideo() {
 
   // Wait for a number of frames to acquire video signal.
   current_hw_frame_ = 0;
-  device_.SetInputFrame(channel_, current_hw_frame_);
-  device_.WaitForInputVerticalInterrupt(channel_, kWarmupFrames);
+  for (size_t i = 0; i < capture_channels_.size(); i++) {
+    device_.SetInputFrame(capture_channels_[i], HwFrame(i, current_hw_frame_));
+  }
+  device_.WaitForInputVerticalInterrupt(capture_channels_.front(), kWarmupFrames);
 
   return AJA_STATUS_SUCCESS;
 }
@@ -380,7 +526,10 @@ bool AJASourceOp::AllocateBuffers(std::vector<void*>& buffers, size_t num_buffer
         return false;
       }
     } else {
-      buf = malloc(buffer_size);
+      // Pinned, so that frames can be DMA'd by the card and copied to the GPU asynchronously
+      if (cudaHostAlloc(&buf, buffer_size, cudaHostAllocDefault) != cudaSuccess) {
+        buf = nullptr;
+      }
     }
 
     if (!buf) {
@@ -406,21 +555,76 @@ void AJASourceOp::FreeBuffers(std::vector<void*>& buffers, bool rdma) {
         cudaFree(buf);
       }
     } else {
-      free(buf);
+      cudaFreeHost(buf);
     }
   }
   buffers.clear();
 }
 
+void* AJASourceOp::AcquireHostFrame(size_t size) {
+  bool allocated = false;
+  void* buf = frame_pool_->acquire(&allocated);
+  if (buf == nullptr) {
+    HOLOSCAN_LOG_ERROR("Failed to allocate a frame buffer");
+    return nullptr;
+  }
+  if (allocated) {
+    if (!device_.DMABufferLock(static_cast<const ULWord*>(buf), size, true, false)) {
+      HOLOSCAN_LOG_ERROR("Failed to map frame buffer for DMA");
+      return nullptr;
+    }
+    HOLOSCAN_LOG_DEBUG("AJA Source: frame pool grew to {} buffers", frame_pool_->num_buffers());
+  }
+  return buf;
+}
+
 AJAStatus AJASourceOp::SetupBuffers() {
   auto size = GetVideoWriteSize(video_format_, pixel_format_);
+  // RDMA and staging buffers hold the frames of all channels back to back
+  const size_t batch_size = size * capture_channels_.size();
 
-  if (!AllocateBuffers(buffers_, kNumBuffers, size, use_rdma_)) { return AJA_STATUS_INITIALIZE; }
+  if (use_rdma_) {
+    if (!AllocateBuffers(buffers_, kNumBuffers, batch_size, true)) {
+      return AJA_STATUS_INITIALIZE;
+    }
+  } else if (upload_) {
+    // Pinned staging buffers for the card, uploaded into frames of a device pool
+    if (!AllocateBuffers(buffers_, kNumBuffers, batch_size, false)) {
+      return AJA_STATUS_INITIALIZE;
+    }
+    upload_events_.resize(kNumBuffers);
+    for (auto& event : upload_events_) {
+      cudaEventCreateWithFlags(&event, cudaEventDisableTiming);
+    }
+    frame_pool_ = std::make_shared<AJAFramePool>(size, true);
+    std::vector<void*> frames;
+    for (size_t i = 0; i < kNumPoolFrames * capture_channels_.size(); i++) {
+      bool allocated = false;
+      frames.push_back(frame_pool_->acquire(&allocated));
+      if (frames.back() == nullptr) { return AJA_STATUS_INITIALIZE; }
+    }
+    for (auto frame : frames) { frame_pool_->release(frame); }
+  } else {
+    // The card writes straight into pinned frames of the pool
+    frame_pool_ = std::make_shared<AJAFramePool>(size, false);
+    std::vector<void*> frames;
+    for (size_t i = 0; i < kNumPoolFrames * capture_channels_.size(); i++) {
+      frames.push_back(AcquireHostFrame(size));
+      if (frames.back() == nullptr) { return AJA_STATUS_INITIALIZE; }
+    }
+    for (auto frame : frames) { frame_pool_->release(frame); }
+  }
 
   if (enable_overlay_) {
-    if (!AllocateBuffers(overlay_buffers_, kNumBuffers, size, overlay_rdma_)) {
+    // Registered for DMA once, then recycled through the overlay slots
+    const size_t num_overlay_buffers =
+        low_latency_overlay_ ? kNumLowLatencyOverlayBuffers : kNumBuffers;
+    if (!AllocateBuffers(overlay_buffers_, num_overlay_buffers, size, overlay_rdma_)) {
       return AJA_STATUS_INITIALIZE;
     }
+    overlay_slots_.clear();
+    for (auto buffer : overlay_buffers_) { overlay_slots_.push_back(OverlaySlot{buffer}); }
+    next_overlay_slot_ = 0;
   }
 
   return AJA_STATUS_SUCCESS;
@@ -428,6 +632,7 @@ AJAStatus AJASourceOp::SetupBuffers() {
 
 void AJASourceOp::initialize() {
   register_converter<NTV2Channel>();
+  register_converter<std::vector<NTV2Channel>>();
 
   // Pre-initialize the 'enable_overlay' parameter.
   auto enable_overlay_arg = std::find_if(args().rbegin(), args().rend(), [](const auto& arg) {
@@ -466,17 +671,33 @@ void AJASourceOp::start() {
   } else {
     framerate = framerate_;
   }
-  HOLOSCAN_LOG_INFO("AJA Source: Capturing {}x{}@{}Hz {}from NTV2_CHANNEL{}",
+  capture_channels_ = channels_.get();
+  if (capture_channels_.empty()) { capture_channels_.push_back(channel_); }
+  std::string channel_names;
+  for (auto channel : capture_channels_) {
+    channel_names += fmt::format("{}NTV2_CHANNEL{}",
+                                 channel_names.empty() ? "" : ", ",
+                                 static_cast<int>(channel) + 1);
+  }
+  HOLOSCAN_LOG_INFO("AJA Source: Capturing {}x{}@{}Hz {}from {}",
                     width_,
                     height_,
                     framerate,
                     (interlaced_ ? "(interlaced) " : ""),
-                    (channel_.get() + 1));
+                    channel_names);
   HOLOSCAN_LOG_INFO("AJA Source: RDMA is {}", use_rdma_ ? "enabled" : "disabled");
+  if (!use_rdma_) {
+    HOLOSCAN_LOG_INFO("AJA Source: Upload to device memory is {}",
+                      upload_ ? "enabled" : "disabled");
+  }
   if (enable_overlay_) {
     HOLOSCAN_LOG_INFO("AJA Source: Outputting overlay to NTV2_CHANNEL{}",
                       (overlay_channel_.get() + 1));
     HOLOSCAN_LOG_INFO("AJA Source: Overlay RDMA is {}", overlay_rdma_ ? "enabled" : "disabled");
+    if (low_latency_overlay_) {
+      HOLOSCAN_LOG_INFO("AJA Source: Low latency overlay, polled {} times per frame",
+                        overlay_slices_.get());
+    }
   } else {
     HOLOSCAN_LOG_INFO("AJA Source: Overlay output is disabled");
   }
@@ -498,6 +719,123 @@ void AJASourceOp::start() {
 
   status = SetupBuffers();
   if (AJA_FAILURE(status)) { throw std::runtime_error("Failed to setup AJA buffers."); }
+
+  if (low_latency_overlay_) {
+    if (!enable_overlay_ || capture_channels_.size() > 1) {
+      throw std::runtime_error("The low latency overlay needs enable_overlay and one channel.");
+    }
+    overlay_slice_ = std::chrono::nanoseconds(static_cast<int64_t>(
+        1e9 / (framerate * std::max<uint32_t>(overlay_slices_.get(), 1))));
+    vbi_count_valid_ = false;
+  }
+}
+
+void AJASourceOp::WriteOverlay(holoscan::gxf::Entity& message) {
+  nvidia::gxf::Handle<nvidia::gxf::VideoBuffer> overlay_buffer;
+  try {
+    overlay_buffer = holoscan::gxf::get_videobuffer(message);
+  } catch (const std::runtime_error& r_) {
+    HOLOSCAN_LOG_TRACE("Failed to read VideoBuffer with error: {}", std::string(r_.what()));
+    return;
+  }
+
+  // Overlays drawn into a buffer of ours carry the capture time of the frame they were made for
+  ULWord* ptr = reinterpret_cast<ULWord*>(overlay_buffer->pointer());
+  auto slot = std::find_if(overlay_slots_.begin(), overlay_slots_.end(), [ptr](const auto& s) {
+    return s.buffer == ptr;
+  });
+  int64_t capture_time = 0;
+  if (slot != overlay_slots_.end()) {
+    slot->in_flight = false;
+    if (slot->sequence < last_overlay_sequence_) {
+      // The overlay of a later frame is already on the card
+      overlay_stats_.late++;
+      return;
+    }
+    last_overlay_sequence_ = slot->sequence;
+    capture_time = slot->capture_time;
+  }
+
+  // Overlay uses HW frames 2 and 3.
+  current_overlay_hw_frame_ = ((current_overlay_hw_frame_ + 1) % 2) + 2;
+  device_.DMAWriteFrame(current_overlay_hw_frame_, ptr, overlay_buffer->size());
+  device_.SetOutputFrame(overlay_channel_, current_overlay_hw_frame_);
+  device_.SetMixerMode(0, NTV2MIXERMODE_MIX);
+  overlay_written_ = true;
+
+  if (capture_time != 0) {
+    // The output frame switches on the next VBI, at most a frame after the write
+    last_overlay_capture_time_ = capture_time;
+    last_overlay_write_time_ = SteadyNowNs();
+    const int64_t latency = last_overlay_write_time_ - capture_time;
+    overlay_stats_.written++;
+    overlay_stats_.latency_sum_ns += latency;
+    overlay_stats_.latency_max_ns = std::max(overlay_stats_.latency_max_ns, latency);
+    HOLOSCAN_LOG_DEBUG("AJA Source: overlay written {:.2f} ms after capture", latency * 1e-6);
+  }
+}
+
+void* AJASourceOp::AcquireOverlayBuffer(int64_t capture_time) {
+  // Slots are handed out in turn, so the next one is the oldest. It is skipped while its
+  // overlay is still being drawn, unless every slot is.
+  OverlaySlot* slot = nullptr;
+  for (size_t i = 0; i < overlay_slots_.size() && slot == nullptr; i++) {
+    auto& candidate = overlay_slots_[(next_overlay_slot_ + i) % overlay_slots_.size()];
+    if (!candidate.in_flight) {
+      slot = &candidate;
+      next_overlay_slot_ = (next_overlay_slot_ + i) % overlay_slots_.size();
+    }
+  }
+  if (slot == nullptr) {
+    slot = &overlay_slots_[next_overlay_slot_];
+    overlay_stats_.reclaimed++;
+  }
+  next_overlay_slot_ = (next_overlay_slot_ + 1) % overlay_slots_.size();
+
+  slot->in_flight = true;
+  slot->capture_time = capture_time;
+  slot->sequence = ++overlay_sequence_;
+  return slot->buffer;
+}
+
+bool AJASourceOp::WaitForFrameSlice() {
+  const NTV2Channel channel = capture_channels_.front();
+  ULWord count = 0;
+  device_.GetInputVerticalInterruptCount(count, channel);
+  if (!vbi_count_valid_) {
+    // The card switches to the next frame on the following VBI
+    device_.SetInputFrame(channel, HwFrame(0, (current_hw_frame_ + 1) % 2));
+    last_vbi_count_ = count;
+    vbi_count_valid_ = true;
+    return false;
+  }
+  if (count == last_vbi_count_) {
+    std::this_thread::sleep_for(overlay_slice_);
+    device_.GetInputVerticalInterruptCount(count, channel);
+    if (count == last_vbi_count_) { return false; }
+  }
+  last_vbi_count_ = count;
+
+  // Without a new overlay since the last VBI, the mixer keeps keying the previous one
+  if (!overlay_written_) { overlay_stats_.reused++; }
+  overlay_written_ = false;
+  if (++overlay_stats_.frames % kOverlayReportFrames == 0) { LogOverlayStats(); }
+  return true;
+}
+
+void AJASourceOp::LogOverlayStats() {
+  const auto& stats = overlay_stats_;
+  HOLOSCAN_LOG_INFO(
+      "AJA Source: {} frames, {} overlays written {:.2f} ms after capture on average ({:.2f} ms "
+      "max), previous overlay kept for {} frames, {} late overlays dropped, {} buffers "
+      "reclaimed",
+      stats.frames,
+      stats.written,
+      stats.written > 0 ? stats.latency_sum_ns * 1e-6 / stats.written : 0.0,
+      stats.latency_max_ns * 1e-6,
+      stats.reused,
+      stats.late,
+      stats.reclaimed);
 }
 
 void AJASourceOp::compute(InputContext& op_input, OutputContext& op_output,
@@ -513,34 +851,70 @@ void AJASourceOp::compute(InputContext& op_input, OutputContext& op_output,
     have_overlay_in = true;
   }
 
-  if (enable_overlay_ && have_overlay_in) {
-    nvidia::gxf::Handle<nvidia::gxf::VideoBuffer> overlay_buffer;
-    try {
-      overlay_buffer = holoscan::gxf::get_videobuffer(overlay_in_message);
-      // Overlay uses HW frames 2 and 3.
-      current_overlay_hw_frame_ = ((current_overlay_hw_frame_ + 1) % 2) + 2;
+  if (enable_overlay_ && have_overlay_in) { WriteOverlay(overlay_in_message); }
 
-      ULWord* ptr = reinterpret_cast<ULWord*>(overlay_buffer->pointer());
-      device_.DMAWriteFrame(current_overlay_hw_frame_, ptr, overlay_buffer->size());
-      device_.SetOutputFrame(overlay_channel_, current_overlay_hw_frame_);
-      device_.SetMixerMode(0, NTV2MIXERMODE_MIX);
-    } catch (const std::runtime_error& r_) {
-      HOLOSCAN_LOG_TRACE("Failed to read VideoBuffer with error: {}", std::string(r_.what()));
+  uint32_t next_hw_frame = (current_hw_frame_ + 1) % 2;
+  if (low_latency_overlay_) {
+    // Ticks every slice of a frame so that overlays are written as soon as they come in, and
+    // only captures once the input has moved on to the next frame
+    if (!WaitForFrameSlice()) { return; }
+  } else {
+    // Update the next input frame of every channel and wait until it starts. All channels flip
+    // on the VBI of the first one, so the frames of a message share the same vertical interval.
+    for (size_t i = 0; i < capture_channels_.size(); i++) {
+      device_.SetInputFrame(capture_channels_[i], HwFrame(i, next_hw_frame));
     }
+    device_.WaitForInputFieldID(NTV2_FIELD0, capture_channels_.front());
   }
+  const int64_t vbi_time = SteadyNowNs();
 
-  // Update the next input frame and wait until it starts.
-  uint32_t next_hw_frame = (current_hw_frame_ + 1) % 2;
-  device_.SetInputFrame(channel_, next_hw_frame);
-  device_.WaitForInputFieldID(NTV2_FIELD0, channel_);
-
-  // Read the last completed frame.
+  // Read the last completed frames: into the RDMA buffer, a pinned staging buffer to upload,
+  // or pinned frames of the pool.
   auto size = GetVideoWriteSize(video_format_, pixel_format_);
-  auto ptr = static_cast<ULWord*>(buffers_[current_buffer_]);
-  device_.DMAReadFrame(current_hw_frame_, ptr, size);
+  const bool upload = upload_ && !use_rdma_;
+  const size_t num_channels = capture_channels_.size();
+  std::vector<void*> frames(num_channels, nullptr);
+  // The upload out of this staging buffer, two frames ago, must be done before the DMA
+  if (upload) { cudaEventSynchronize(upload_events_[current_buffer_]); }
+  for (size_t i = 0; i < num_channels; i++) {
+    void* dst;
+    if (use_rdma_ || upload) {
+      dst = static_cast<uint8_t*>(buffers_[current_buffer_]) + i * size;
+    } else {
+      dst = AcquireHostFrame(size);
+      if (dst == nullptr) { throw std::runtime_error("Failed to acquire AJA frame buffer."); }
+    }
+    device_.DMAReadFrame(HwFrame(i, current_hw_frame_), static_cast<ULWord*>(dst), size);
+    frames[i] = dst;
+  }
+
+  if (upload) {
+    // The upload overlaps the wait for, and capture of, the next frame into the other
+    // staging buffer
+    const std::vector<holoscan::gxf::Entity> no_messages;
+    if (cuda_stream_handler_.from_messages(context.context(), no_messages) != GXF_SUCCESS) {
+      throw std::runtime_error("Failed to get the AJA upload CUDA stream");
+    }
+    cudaStream_t stream = cuda_stream_handler_.get_cuda_stream(context.context());
+    for (auto& frame : frames) {
+      void* staging = frame;
+      bool allocated = false;
+      frame = frame_pool_->acquire(&allocated);
+      if (frame == nullptr) { throw std::runtime_error("Failed to acquire AJA device frame."); }
+      cudaMemcpyAsync(frame, staging, size, cudaMemcpyHostToDevice, stream);
+    }
+    cudaEventRecord(upload_events_[current_buffer_], stream);
+    // Without a stream pool the copies run on the default stream, which the output doesn't
+    // carry, so the device frames are complete before they are emitted
+    if (stream == cudaStreamDefault) { cudaStreamSynchronize(stream); }
+  }
 
   // Set the frame to read for the next tick.
   current_hw_frame_ = next_hw_frame;
+  if (low_latency_overlay_) {
+    // Switch back to the frame just read on the next VBI
+    device_.SetInputFrame(capture_channels_.front(), HwFrame(0, (current_hw_frame_ + 1) % 2));
+  }
 
   // Common (output and overlay) buffer info
   nvidia::gxf::VideoTypeTraits<nvidia::gxf::VideoFormat::GXF_VIDEO_FORMAT_RGBA> video_type;
@@ -569,7 +943,7 @@ void AJASourceOp::compute(InputContext& op_input, OutputContext& op_output,
     auto overlay_storage_type = overlay_rdma_ ? nvidia::gxf::MemoryStorageType::kDevice
                                               : nvidia::gxf::MemoryStorageType::kHost;
     overlay_buffer.value()->wrapMemory(
-        info, size, overlay_storage_type, overlay_buffers_[current_buffer_], nullptr);
+        info, size, overlay_storage_type, AcquireOverlayBuffer(vbi_time), nullptr);
 
     auto overlay_result = gxf::Entity(std::move(overlay_output.value()));
     op_output.emit(overlay_result, "overlay_buffer_output");
@@ -582,15 +956,70 @@ void AJASourceOp::compute(InputContext& op_input, OutputContext& op_output,
     return;
   }
 
-  auto video_buffer = video_output.value().add<nvidia::gxf::VideoBuffer>();
-  if (!video_buffer) {
-    throw std::runtime_error("Failed to allocate video buffer; terminating.");
-    return;
+  auto storage_type = (use_rdma_ || upload) ? nvidia::gxf::MemoryStorageType::kDevice
+                                            : nvidia::gxf::MemoryStorageType::kHost;
+  for (size_t i = 0; i < num_channels; i++) {
+    // A single channel keeps the unnamed buffer, several are named after their channel
+    const std::string buffer_name =
+        fmt::format("NTV2_CHANNEL{}", static_cast<int>(capture_channels_[i]) + 1);
+    auto video_buffer = video_output.value().add<nvidia::gxf::VideoBuffer>(
+        num_channels == 1 ? nullptr : buffer_name.c_str());
+    if (!video_buffer) {
+      throw std::runtime_error("Failed to allocate video buffer; terminating.");
+      return;
+    }
+
+    if (use_rdma_) {
+      video_buffer.value()->wrapMemory(info, size, storage_type, frames[i], nullptr);
+    } else {
+      // The frame returns to the pool once the last message holding it is destroyed
+      auto pool = frame_pool_;
+      video_buffer.value()->wrapMemory(info, size, storage_type, frames[i], [pool](void* ptr) {
+        pool->release(ptr);
+        return nvidia::gxf::Success;
+      });
+    }
   }
 
-  auto storage_type =
-      use_rdma_ ? nvidia::gxf::MemoryStorageType::kDevice : nvidia::gxf::MemoryStorageType::kHost;
-  video_buffer.value()->wrapMemory(info, size, storage_type, buffers_[current_buffer_], nullptr);
+  if (num_channels > 1) {
+    if (use_rdma_) {
+      // The batched RDMA buffer, [channel, height, width, RGBA], for stages that take them all
+      auto frames_tensor = video_output.value().add<nvidia::gxf::Tensor>("frames");
+      if (!frames_tensor) {
+        throw std::runtime_error("Failed to allocate frames tensor; terminating.");
+      }
+      nvidia::gxf::Shape shape{static_cast<int32_t>(num_channels),
+                               static_cast<int32_t>(height_.get()),
+                               static_cast<int32_t>(width_.get()),
+                               4};
+      frames_tensor.value()->wrapMemory(shape,
+                                        nvidia::gxf::PrimitiveType::kUnsigned8,
+                                        1,
+                                        nvidia::gxf::ComputeTrivialStrides(shape, 1),
+                                        storage_type,
+                                        buffers_[current_buffer_],
+                                        nullptr);
+    }
+    // All frames of the message were captured at the VBI of the first channel
+    auto timestamp = video_output.value().add<nvidia::gxf::Timestamp>("timestamp");
+    if (!timestamp) { throw std::runtime_error("Failed to allocate timestamp; terminating."); }
+    timestamp.value()->acqtime = vbi_time;
+    timestamp.value()->pubtime = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                     std::chrono::steady_clock::now().time_since_epoch())
+                                     .count();
+  }
+  if (low_latency_overlay_ && last_overlay_capture_time_ != 0) {
+    // Capture and write times of the last overlay sent to the mixer, reported with every frame
+    auto overlay_timestamp = video_output.value().add<nvidia::gxf::Timestamp>("overlay");
+    if (!overlay_timestamp) {
+      throw std::runtime_error("Failed to allocate overlay timestamp; terminating.");
+    }
+    overlay_timestamp.value()->acqtime = last_overlay_capture_time_;
+    overlay_timestamp.value()->pubtime = last_overlay_write_time_;
+  }
+  if (upload && cuda_stream_handler_.to_message(video_output) != GXF_SUCCESS) {
+    throw std::runtime_error("Failed to add the CUDA stream to the AJA video output");
+  }
 
   auto result = gxf::Entity(std::move(video_output.value()));
   op_output.emit(result, "video_buffer_output");
@@ -600,13 +1029,22 @@ void AJASourceOp::compute(InputContext& op_input, OutputContext& op_output,
 }
 
 void AJASourceOp::stop() {
-  device_.UnsubscribeInputVerticalEvent(channel_);
+  for (auto channel : capture_channels_) { device_.UnsubscribeInputVerticalEvent(channel); }
   device_.DMABufferUnlockAll();
 
   if (enable_overlay_) { device_.SetMixerMode(0, NTV2MIXERMODE_FOREGROUND_OFF); }
+  if (low_latency_overlay_) { LogOverlayStats(); }
 
+  for (auto event : upload_events_) {
+    cudaEventSynchronize(event);
+    cudaEventDestroy(event);
+  }
+  upload_events_.clear();
   FreeBuffers(buffers_, use_rdma_);
+  overlay_slots_.clear();
   FreeBuffers(overlay_buffers_, overlay_rdma_);
+  // Frames still held downstream keep the pool alive until they are released
+  frame_pool_.reset();
 }
 
 bool AJASourceOp::GetNTV2VideoFormatTSI(NTV2VideoFormat* format) {
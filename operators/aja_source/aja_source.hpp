@@ -27,7 +27,10 @@
 #include <ajantv2/includes/ntv2devicescanner.h>
 #pragma GCC diagnostic pop
 #include <ajantv2/includes/ntv2enums.h>
+#include <cuda_runtime.h>
 
+#include <chrono>
+#include <memory>
 #include <string>
 #include <utility>
 #include <vector>
@@ -36,10 +39,13 @@
 #include "holoscan/core/io_spec.hpp"
 #include "holoscan/core/operator.hpp"
 #include "holoscan/core/operator_spec.hpp"
+#include "holoscan/utils/cuda_stream_handler.hpp"
 #include "./ntv2channel.hpp"
 
 namespace holoscan::ops {
 
+class AJAFramePool;
+
 /**
  * @brief Operator class to get the video stream from AJA capture card.
  *
@@ -54,8 +60,14 @@ namespace holoscan::ops {
  * ==Named Outputs==
  *
  * - **video_buffer_output** : `nvidia::gxf::VideoBuffer`
- *   - The output video frame from the AJA capture card. If `overlay_rdma` is true, this
- *     video buffer will be on the device, otherwise it will be in pinned host memory.
+ *   - The output video frame from the AJA capture card. If `rdma` or `upload` is true, this
+ *     video buffer will be on the device, otherwise it will be in pinned host memory. Without
+ *     RDMA, frames come from a pool and are only reused once every message holding them is
+ *     destroyed. Uploaded frames carry the CUDA stream of the upload. With several `channels`,
+ *     the message holds one video buffer per channel, named after it (e.g. "NTV2_CHANNEL2"),
+ *     and an `nvidia::gxf::Timestamp` whose `acqtime` is the VBI they were all captured at.
+ *     With RDMA, the frames are also wrapped as a `[channel, height, width, 4]` uint8 tensor
+ *     named "frames", over the single device allocation they were captured into.
  * - **overlay_buffer_output** : `nvidia::gxf::VideoBuffer` (optional)
  *   - This output port will only emit a video buffer when `enable_overlay` is true. If
  *     `overlay_rdma` is true, this video buffer will be on the device, otherwise it will be
@@ -67,6 +79,9 @@ namespace holoscan::ops {
  * - **channel**: The camera `NTV2Channel` to use for output (e.g., `NTV2Channel::NTV2_CHANNEL1`
  *   (`0`) or "NTV2_CHANNEL1" (in YAML) for the first channel). Optional (default:
  *   `NTV2Channel::NTV2_CHANNEL1` in C++ or `"NTV2_CHANNEL1"` in YAML).
+ * - **channels**: `NTV2Channel`s to capture together, replacing `channel` when not empty. All
+ *   channels are switched on the VBI of the first one, so their sources should be genlocked.
+ *   Not supported with the overlay or TSI formats. Optional (default: empty).
  * - **width**: Width of the video stream. Optional (default: `1920`).
  * - **height**: Height of the video stream. Optional (default: `1080`).
  * - **framerate**: Frame rate of the video stream. Optional (default: `60`).
@@ -78,6 +93,17 @@ namespace holoscan::ops {
  *   `NTV2Channel::NTV2_CHANNEL2` in C++ or `"NTV2_CHANNEL2"` in YAML).
  * - **overlay_rdma**: Boolean indicating whether RDMA is enabled for the overlay. Optional
  *   (default: `true`).
+ * - **upload**: Without RDMA, copy each frame from pinned host memory to device memory with
+ *   `cudaMemcpyAsync`, overlapped with the capture of the next frame. Optional (default: `false`).
+ * - **cuda_stream_pool**: `holoscan::CudaStreamPool` to allocate the upload stream from. Without
+ *   it, uploads run on the default stream and are synchronized before the frame is emitted.
+ *   Optional.
+ * - **low_latency_overlay**: With `enable_overlay` and a single channel, tick `overlay_slices`
+ *   times per frame and write each overlay to the card as soon as it arrives, instead of on the
+ *   next input VBI. Frames are captured on the first slice after their VBI. The capture and
+ *   write times of the last overlay are added to each video output as a `Timestamp` named
+ *   "overlay". Optional (default: `false`).
+ * - **overlay_slices**: Ticks per frame in low latency overlay mode. Optional (default: `4`).
  */
 class AJASourceOp : public holoscan::Operator {
  public:
@@ -96,17 +122,24 @@ class AJASourceOp : public holoscan::Operator {
  private:
   AJAStatus DetermineVideoFormat();
   AJAStatus OpenDevice();
+  AJAStatus SetupCaptureChannel(NTV2Channel channel, NTV2OutputXptID* input_output_xpt);
   AJAStatus SetupVideo();
   AJAStatus SetupBuffers();
   AJAStatus StartAutoCirculate();
   bool AllocateBuffers(std::vector<void*>& buffers, size_t num_buffers, size_t buffer_size,
                        bool rdma);
   void FreeBuffers(std::vector<void*>& buffers, bool rdma);
+  void* AcquireHostFrame(size_t size);
   bool GetNTV2VideoFormatTSI(NTV2VideoFormat* format);
+  void WriteOverlay(holoscan::gxf::Entity& message);
+  void* AcquireOverlayBuffer(int64_t capture_time);
+  bool WaitForFrameSlice();
+  void LogOverlayStats();
 
   Parameter<holoscan::IOSpec*> video_buffer_output_;
   Parameter<std::string> device_specifier_;
   Parameter<NTV2Channel> channel_;
+  Parameter<std::vector<NTV2Channel>> channels_;
   Parameter<uint32_t> width_;
   Parameter<uint32_t> height_;
   Parameter<uint32_t> framerate_;
@@ -117,6 +150,10 @@ class AJASourceOp : public holoscan::Operator {
   Parameter<bool> overlay_rdma_;
   Parameter<holoscan::IOSpec*> overlay_buffer_input_;
   Parameter<holoscan::IOSpec*> overlay_buffer_output_;
+  Parameter<bool> upload_;
+  Parameter<bool> low_latency_overlay_;
+  Parameter<uint32_t> overlay_slices_;
+  CudaStreamHandler cuda_stream_handler_;
 
   // internal state
   CNTV2Card device_;
@@ -125,13 +162,53 @@ class AJASourceOp : public holoscan::Operator {
   NTV2PixelFormat pixel_format_ = NTV2_FBF_ABGR;
   bool use_tsi_ = false;
   bool is_kona_hdmi_ = false;
+  // channels, or channel alone
+  std::vector<NTV2Channel> capture_channels_;
 
+  // RDMA or staging buffers, each holding one frame of every capture channel
   std::vector<void*> buffers_;
   std::vector<void*> overlay_buffers_;
   uint8_t current_buffer_ = 0;
   uint8_t current_hw_frame_ = 0;
   uint8_t current_overlay_hw_frame_ = 0;
 
+  // Overlay buffers handed downstream, with the capture time of the frame each was sent with
+  struct OverlaySlot {
+    void* buffer = nullptr;
+    bool in_flight = false;
+    int64_t capture_time = 0;
+    uint64_t sequence = 0;
+  };
+  std::vector<OverlaySlot> overlay_slots_;
+  size_t next_overlay_slot_ = 0;
+  uint64_t overlay_sequence_ = 0;
+  uint64_t last_overlay_sequence_ = 0;
+  int64_t last_overlay_capture_time_ = 0;
+  int64_t last_overlay_write_time_ = 0;
+
+  // Low latency overlay: input VBI count of the frame being captured, and whether an overlay
+  // was written since that VBI
+  std::chrono::nanoseconds overlay_slice_{0};
+  bool vbi_count_valid_ = false;
+  ULWord last_vbi_count_ = 0;
+  bool overlay_written_ = false;
+  struct OverlayStats {
+    uint64_t frames = 0;
+    uint64_t written = 0;
+    uint64_t reused = 0;
+    uint64_t late = 0;
+    uint64_t reclaimed = 0;
+    int64_t latency_sum_ns = 0;
+    int64_t latency_max_ns = 0;
+  };
+  OverlayStats overlay_stats_;
+
+  // Without RDMA: frames handed downstream, pinned host memory or, with upload, device memory.
+  // The pool outlives the operator until the last emitted frame is released.
+  std::shared_ptr<AJAFramePool> frame_pool_;
+  // With upload: end of the last upload out of each pinned staging buffer of buffers_
+  std::vector<cudaEvent_t> upload_events_;
+
   bool is_igpu_ = false;
 };
 
@@ -26,6 +26,7 @@
 #include <unordered_map>
 #include <utility>
 #include <variant>
+#include <vector>
 
 #include "../operator_util.hpp"
 #include "./aja_source_pydoc.hpp"
@@ -87,7 +88,9 @@ class PyAJASourceOp : public AJASourceOp {
       uint32_t width = 1920, uint32_t height = 1080, uint32_t framerate = 60,
       bool interlaced = false, bool rdma = false, bool enable_overlay = false,
       const std::variant<std::string, NTV2Channel>& overlay_channel = NTV2Channel::NTV2_CHANNEL2,
-      bool overlay_rdma = true, const std::string& name = "aja_source")
+      bool overlay_rdma = true, bool upload = false,
+      const std::vector<std::variant<std::string, NTV2Channel>>& channels = {},
+      const std::string& name = "aja_source")
       : AJASourceOp(ArgList{Arg{"device", device},
                             Arg{"width", width},
                             Arg{"height", height},
@@ -95,7 +98,8 @@ class PyAJASourceOp : public AJASourceOp {
                             Arg{"interlaced", interlaced},
                             Arg{"rdma", rdma},
                             Arg{"enable_overlay", enable_overlay},
-                            Arg{"overlay_rdma", overlay_rdma}}) {
+                            Arg{"overlay_rdma", overlay_rdma},
+                            Arg{"upload", upload}}) {
     add_positional_condition_and_resource_args(this, args);
     if (std::holds_alternative<std::string>(channel)) {
       this->add_arg(Arg("channel", ToNTV2Channel(std::get<std::string>(channel))));
@@ -107,6 +111,13 @@ class PyAJASourceOp : public AJASourceOp {
     } else {
       this->add_arg(Arg("overlay_channel", std::get<NTV2Channel>(overlay_channel)));
     }
+    std::vector<NTV2Channel> capture_channels;
+    for (const auto& c : channels) {
+      capture_channels.push_back(std::holds_alternative<std::string>(c)
+                                     ? ToNTV2Channel(std::get<std::string>(c))
+                                     : std::get<NTV2Channel>(c));
+    }
+    this->add_arg(Arg("channels", capture_channels));
     name_ = name;
     fragment_ = fragment;
     spec_ = std::make_shared<OperatorSpec>(fragment);
@@ -149,6 +160,8 @@ PYBIND11_MODULE(_aja_source, m) {
                     bool,
                     const std::variant<std::string, NTV2Channel>,
                     bool,
+                    bool,
+                    const std::vector<std::variant<std::string, NTV2Channel>>&,
                     const std::string&>(),
            "fragment"_a,
            "device"_a = "0"s,
@@ -161,6 +174,8 @@ PYBIND11_MODULE(_aja_source, m) {
            "enable_overlay"_a = false,
            "overlay_channel"_a = NTV2Channel::NTV2_CHANNEL2,
            "overlay_rdma"_a = true,
+           "upload"_a = false,
+           "channels"_a = std::vector<std::variant<std::string, NTV2Channel>>{},
            "name"_a = "aja_source"s,
            doc::AJASourceOp::doc_AJASourceOp);
 }  // PYBIND11_MODULE NOLINT
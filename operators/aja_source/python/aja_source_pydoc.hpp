@@ -39,8 +39,10 @@ Operator to get a video stream from an AJA capture card.
 **==Named Outputs==**
 
     video_buffer_output : nvidia::gxf::VideoBuffer
-        The output video frame from the AJA capture card. If ``overlay_rdma`` is ``True``, this
-        video buffer will be on the device, otherwise it will be in pinned host memory.
+        The output video frame from the AJA capture card. If ``rdma`` or ``upload`` is ``True``,
+        this video buffer will be on the device, otherwise it will be in pinned host memory.
+        With several ``channels``, the message holds one video buffer per channel, named after
+        it (e.g. ``"NTV2_CHANNEL2"``), and a timestamp of the VBI they were captured at.
     overlay_buffer_output : nvidia::gxf::VideoBuffer (optional)
         This output port will only emit a video buffer when ``enable_overlay`` is ``True``. If
         ``overlay_rdma`` is ``True``, this video buffer will be on the device, otherwise it will be
@@ -76,6 +78,14 @@ overlay_channel : holoscan.operators.NTV2Channel or int, optional
 overlay_rdma : bool, optional
     Boolean indicating whether RDMA is enabled for the overlay. Default value is ``False``
     (``"false"`` in YAML).
+upload : bool, optional
+    Without RDMA, copy each frame from pinned host memory to device memory asynchronously,
+    overlapped with the capture of the next frame. Pass a ``holoscan.resources.CudaStreamPool``
+    as a positional argument to run the uploads on a stream of their own. Default value is
+    ``False`` (``"false"`` in YAML).
+channels : list of str or holohub.aja_source.NTV2Channel, optional
+    Channels to capture together, in one message, replacing ``channel`` when not empty. The
+    sources should be genlocked. Not supported with the overlay. Default value is ``[]``.
 name : str, optional (constructor only)
     The name of the operator. Default value is ``"aja_source"``.
 )doc")
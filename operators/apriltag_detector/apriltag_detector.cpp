@@ -15,6 +15,13 @@
  * limitations under the License.
  */
 
+#include <algorithm>
+#include <any>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
 #include <gxf/std/tensor.hpp>
 #include <holoscan/holoscan.hpp>
 
@@ -40,61 +47,165 @@ namespace holoscan::ops {
     }                                                                                       \
   }
 
+/**
+ * CUDA runtime API error check helper
+ */
+#define CudaRuntimeCheck(FUNC)                                                               \
+  {                                                                                          \
+    const cudaError_t result = FUNC;                                                         \
+    if (result != cudaSuccess) {                                                             \
+      std::stringstream buf;                                                                 \
+      buf << "[" << __FILE__ << ":" << __LINE__ << "] CUDA runtime error " << result << " (" \
+          << cudaGetErrorName(result) << "): " << cudaGetErrorString(result);                \
+      throw std::runtime_error(buf.str().c_str());                                           \
+    }                                                                                        \
+  }
+
+namespace {
+
+// The ports depend on number_of_cameras, read from the arguments given before setup()
+int number_of_cameras_arg(const std::vector<holoscan::Arg>& args) {
+  for (const auto& arg : args) {
+    if (arg.name() != "number_of_cameras") { continue; }
+    const std::any& value = arg.value();
+    if (value.type() == typeid(YAML::Node)) { return std::any_cast<YAML::Node>(value).as<int>(); }
+    if (value.type() == typeid(int)) { return std::any_cast<int>(value); }
+  }
+  return 1;
+}
+
+}  // namespace
+
 void ApriltagDetectorOp::setup(holoscan::OperatorSpec& spec) {
-  spec.input<holoscan::gxf::Entity>("input");
-  spec.output<std::vector<float2>>("output");
+  const int number_of_cameras = number_of_cameras_arg(args());
+  input_names_.clear();
+  output_names_.clear();
+  if (number_of_cameras > 1) {
+    for (int i = 0; i < number_of_cameras; i++) {
+      input_names_.push_back("input_" + std::to_string(i));
+      output_names_.push_back("output_" + std::to_string(i));
+    }
+  } else {
+    input_names_.push_back("input");
+    output_names_.push_back("output");
+  }
+  for (const auto& name : input_names_) { spec.input<holoscan::gxf::Entity>(name); }
+  for (const auto& name : output_names_) { spec.output<std::vector<output_corners>>(name); }
 
   spec.param(width_, "width", "Width", "Width of the input image");
   spec.param(height_, "height", "Height", "Height of the input image");
-  spec.param(number_of_tags_, "number_of_tags", "Number of tags", "Number of tags to detect");
+  spec.param(number_of_tags_,
+             "number_of_tags",
+             "Number of tags",
+             "Maximum number of tags to detect in each image");
+  spec.param(number_of_cameras_,
+             "number_of_cameras",
+             "Number of cameras",
+             "Number of cameras detected in each tick, each on its own ports and CUDA stream",
+             1);
 
   cuda_stream_handler_.define_params(spec);
 }
 
 void ApriltagDetectorOp::start() {
-  int status = -1;
+  if (number_of_tags_ <= 0) { throw std::runtime_error("number_of_tags must be positive"); }
+  if (static_cast<size_t>(number_of_cameras_.get()) != input_names_.size() &&
+      number_of_cameras_ > 1) {
+    throw std::runtime_error("number_of_cameras must be given before the operator is set up");
+  }
+
+  CudaCheck(cuInit(0));
+  CudaCheck(cuDeviceGet(&cuda_device_, 0));
+  CudaCheck(cuDevicePrimaryCtxRetain(&cuda_context_, cuda_device_));
 
   const float tag_dim = 0.0f;
   const uint32_t tile_size = 4;
+  const bool several_cameras = input_names_.size() > 1;
 
-  status = nvCreateAprilTagsDetector(
-      &apriltag_handle_, width_, height_, tile_size, NVAT_TAG36H11, NULL, tag_dim);
-  if (status != 0) {
-    throw std::runtime_error("Failed to create the handle for AprilTag detector\n");
+  cameras_.resize(input_names_.size());
+  for (auto& camera : cameras_) {
+    const int status = nvCreateAprilTagsDetector(
+        &camera.handle, width_, height_, tile_size, NVAT_TAG36H11, NULL, tag_dim);
+    if (status != 0) {
+      throw std::runtime_error("Failed to create the handle for AprilTag detector\n");
+    }
+    CudaRuntimeCheck(cudaMallocHost(reinterpret_cast<void**>(&camera.tags),
+                                    number_of_tags_ * sizeof(cuAprilTagsID_t)));
+    camera.corners.reserve(number_of_tags_);
+    if (several_cameras) {
+      CudaRuntimeCheck(cudaStreamCreateWithFlags(&camera.stream, cudaStreamNonBlocking));
+    }
+  }
+
+  if (several_cameras) {
+    CudaRuntimeCheck(cudaEventCreateWithFlags(&input_ready_event_, cudaEventDisableTiming));
+    stop_workers_ = false;
+    generation_ = 0;
+    for (size_t i = 1; i < cameras_.size(); i++) {
+      cameras_[i].worker =
+          std::thread(&ApriltagDetectorOp::workerLoop, this, std::ref(cameras_[i]));
+    }
   }
-  CudaCheck(cuInit(0));
-  CUdevice cudaDevice;
-  CudaCheck(cuDeviceGet(&cuda_device_, 0));
-  CudaCheck(cuDevicePrimaryCtxRetain(&cuda_context_, cuda_device_));
 }
 
 void ApriltagDetectorOp::stop() {
-  int status = -1;
+  {
+    std::lock_guard<std::mutex> lock(worker_mutex_);
+    stop_workers_ = true;
+  }
+  worker_start_.notify_all();
+  for (auto& camera : cameras_) {
+    if (camera.worker.joinable()) { camera.worker.join(); }
+  }
 
-  status = cuAprilTagsDestroy(apriltag_handle_);
-  if (status != 0) {
-    throw std::runtime_error("Failed to destroy the handle for AprilTag detector\n");
+  const bool several_cameras = cameras_.size() > 1;
+  for (auto& camera : cameras_) {
+    if (camera.handle && cuAprilTagsDestroy(camera.handle) != 0) {
+      throw std::runtime_error("Failed to destroy the handle for AprilTag detector\n");
+    }
+    if (camera.tags) { CudaRuntimeCheck(cudaFreeHost(camera.tags)); }
+    // with a single camera the stream is the one of the messages
+    if (several_cameras && camera.stream) { CudaRuntimeCheck(cudaStreamDestroy(camera.stream)); }
+  }
+  cameras_.clear();
+  if (input_ready_event_) {
+    CudaRuntimeCheck(cudaEventDestroy(input_ready_event_));
+    input_ready_event_ = nullptr;
   }
 
   CudaCheck(cuDevicePrimaryCtxRelease(cuda_device_));
   cuda_context_ = nullptr;
 }
 
-void ApriltagDetectorOp::compute(holoscan::InputContext& input, holoscan::OutputContext& output,
-                                 holoscan::ExecutionContext& context) {
-  auto maybe_entity = input.receive<holoscan::gxf::Entity>("input");
-  if (!maybe_entity) { throw std::runtime_error("Failed to receive input"); }
+void ApriltagDetectorOp::workerLoop(Camera& camera) {
+  // cuAprilTags uses the primary context, which is not current on new threads
+  try {
+    CudaCheck(cuCtxSetCurrent(cuda_context_));
+  } catch (...) { camera.error = std::current_exception(); }
 
-  auto& entity = maybe_entity.value();
-
-  // get the CUDA stream from the input message
-  gxf_result_t stream_handler_result = cuda_stream_handler_.from_message(context.context(), entity);
-  if (stream_handler_result != GXF_SUCCESS) {
-    throw std::runtime_error("Failed to get the CUDA stream from incoming messages");
+  uint64_t generation = 0;
+  while (true) {
+    {
+      std::unique_lock<std::mutex> lock(worker_mutex_);
+      worker_start_.wait(lock, [&] { return stop_workers_ || generation_ != generation; });
+      if (stop_workers_) { return; }
+      generation = generation_;
+    }
+    if (!camera.error) {
+      try {
+        detect(camera);
+      } catch (...) { camera.error = std::current_exception(); }
+    }
+    {
+      std::lock_guard<std::mutex> lock(worker_mutex_);
+      --pending_;
+    }
+    worker_done_.notify_one();
   }
+}
 
-  const auto input_tensor = entity.get<holoscan::Tensor>();
-  if (!input_tensor) { throw std::runtime_error("Tensor not found in message"); }
+void ApriltagDetectorOp::detect(Camera& camera) {
+  const auto& input_tensor = camera.image;
 
   DLDevice input_device = input_tensor->device();
 
@@ -123,26 +234,80 @@ void ApriltagDetectorOp::compute(holoscan::InputContext& input, holoscan::Output
     throw std::runtime_error(
         fmt::format("Unexpected component count {}, expected '3'", components));
   }
-  std::vector<cuAprilTagsID_t> tags(number_of_tags_);
-  uint32_t num_tags;
+  uint32_t num_tags = 0;
   cuAprilTagsImageInput_t input_image = {
       reinterpret_cast<uchar3*>(input_tensor->data()), width * sizeof(uchar3), width, height};
 
+  // the results are returned to the pinned buffer once the detection on the stream is done
+  const int status = cuAprilTagsDetect(
+      camera.handle, &input_image, camera.tags, &num_tags, number_of_tags_, camera.stream);
+  if (status != 0) { throw std::runtime_error("AprilTag detection failed"); }
+
+  camera.corners.resize(std::min<uint32_t>(num_tags, number_of_tags_));
+  for (size_t i = 0; i < camera.corners.size(); i++) {
+    camera.corners[i].id = camera.tags[i].id;
+    for (int corner = 0; corner < 4; corner++) {
+      camera.corners[i].corners[corner] = camera.tags[i].corners[corner];
+    }
+  }
+  camera.image.reset();
+}
+
+void ApriltagDetectorOp::compute(holoscan::InputContext& input, holoscan::OutputContext& output,
+                                 holoscan::ExecutionContext& context) {
+  std::vector<holoscan::gxf::Entity> entities;
+  entities.reserve(cameras_.size());
+  for (size_t i = 0; i < cameras_.size(); i++) {
+    auto maybe_entity = input.receive<holoscan::gxf::Entity>(input_names_[i].c_str());
+    if (!maybe_entity) { throw std::runtime_error("Failed to receive input"); }
+    entities.push_back(maybe_entity.value());
+
+    cameras_[i].image = entities.back().get<holoscan::Tensor>();
+    if (!cameras_[i].image) { throw std::runtime_error("Tensor not found in message"); }
+  }
+
+  // get the CUDA stream from the input messages, the other streams are synchronized to it
+  std::vector<nvidia::gxf::Entity> messages(entities.begin(), entities.end());
+  gxf_result_t stream_handler_result =
+      cuda_stream_handler_.from_messages(context.context(), messages);
+  if (stream_handler_result != GXF_SUCCESS) {
+    throw std::runtime_error("Failed to get the CUDA stream from incoming messages");
+  }
   cudaStream_t cuda_stream = cuda_stream_handler_.get_cuda_stream(context.context());
-  cuAprilTagsDetect(
-      apriltag_handle_, &input_image, tags.data(), &num_tags, number_of_tags_, cuda_stream);
-
-  std::vector<output_corners> output_vec(number_of_tags_);
-  if (num_tags == number_of_tags_) {
-    for (uint8_t i = 0; i < number_of_tags_; i++) {
-      output_vec[i].id = tags[i].id;
-      output_vec[i].corners[0] = tags[i].corners[0];
-      output_vec[i].corners[1] = tags[i].corners[1];
-      output_vec[i].corners[2] = tags[i].corners[2];
-      output_vec[i].corners[3] = tags[i].corners[3];
+
+  if (cameras_.size() == 1) {
+    cameras_[0].stream = cuda_stream;
+    detect(cameras_[0]);
+  } else {
+    CudaRuntimeCheck(cudaEventRecord(input_ready_event_, cuda_stream));
+    for (auto& camera : cameras_) {
+      CudaRuntimeCheck(cudaStreamWaitEvent(camera.stream, input_ready_event_, 0));
+    }
+
+    {
+      std::lock_guard<std::mutex> lock(worker_mutex_);
+      pending_ = cameras_.size() - 1;
+      ++generation_;
+    }
+    worker_start_.notify_all();
+    try {
+      detect(cameras_[0]);
+    } catch (...) { cameras_[0].error = std::current_exception(); }
+    {
+      std::unique_lock<std::mutex> lock(worker_mutex_);
+      worker_done_.wait(lock, [&] { return pending_ == 0; });
     }
+    for (auto& camera : cameras_) {
+      if (camera.error) {
+        camera.image.reset();
+        std::rethrow_exception(std::exchange(camera.error, nullptr));
+      }
+    }
+  }
+
+  for (size_t i = 0; i < cameras_.size(); i++) {
+    output.emit(cameras_[i].corners, output_names_[i].c_str());
   }
-  output.emit(output_vec, "output");
 }
 
 }  // namespace holoscan::ops
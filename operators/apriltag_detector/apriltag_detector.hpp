@@ -18,18 +18,33 @@
 #ifndef SRC_HOLOLINK_OPERATORS_APRILTAG_DETECTOR_APRILTAG_DETECTOR
 #define SRC_HOLOLINK_OPERATORS_APRILTAG_DETECTOR_APRILTAG_DETECTOR
 
+#include <condition_variable>
+#include <cstdint>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
 #include <holoscan/core/operator.hpp>
 #include <holoscan/core/parameter.hpp>
 #include <holoscan/utils/cuda_stream_handler.hpp>
 
 #include "cuAprilTags.h"
 #include "cuda.h"
+#include "cuda_runtime.h"
 
 namespace holoscan::ops {
 
-// The ApriltagDetectorOp operator detects number_of_tags_ of
-// NVAT_TAG36H11 family only in an RGB image of resolution
-// width_xheight_.
+// The ApriltagDetectorOp operator detects up to number_of_tags_ tags
+// of NVAT_TAG36H11 family only in an RGB image of resolution
+// width_xheight_, and emits as many as were found.
+//
+// With number_of_cameras_ > 1 the images of all cameras are received
+// on "input_<i>" and their tags emitted on "output_<i>" in one tick.
+// Each camera has its own detector and CUDA stream, and all but the
+// first are detected on worker threads so they run concurrently.
 
 class ApriltagDetectorOp : public holoscan::Operator {
  public:
@@ -52,8 +67,38 @@ class ApriltagDetectorOp : public holoscan::Operator {
   // number_of_tags_ will let the operator know, how many
   // apriltags the user is expecting.
   holoscan::Parameter<int> number_of_tags_;
+  holoscan::Parameter<int> number_of_cameras_;
+
+  struct Camera {
+    cuAprilTagsHandle handle = nullptr;
+    // own stream with several cameras, the one of the message otherwise
+    cudaStream_t stream = nullptr;
+    // pinned detection results, number_of_tags_ entries
+    cuAprilTagsID_t* tags = nullptr;
+    // detections of the last frame, reserved for number_of_tags_
+    std::vector<output_corners> corners;
+    std::shared_ptr<holoscan::Tensor> image;
+    std::exception_ptr error;
+    std::thread worker;
+  };
+
+  void detect(Camera& camera);
+  void workerLoop(Camera& camera);
+
+  std::vector<Camera> cameras_;
+  std::vector<std::string> input_names_;
+  std::vector<std::string> output_names_;
+
+  // input images are ready on the camera streams once they reached this event
+  cudaEvent_t input_ready_event_ = nullptr;
 
-  cuAprilTagsHandle apriltag_handle_;
+  // worker handshake: each tick bumps generation_, workers decrement pending_ when done
+  std::mutex worker_mutex_;
+  std::condition_variable worker_start_;
+  std::condition_variable worker_done_;
+  uint64_t generation_ = 0;
+  size_t pending_ = 0;
+  bool stop_workers_ = false;
 
   CUcontext cuda_context_ = nullptr;
   CUdevice cuda_device_ = 0;
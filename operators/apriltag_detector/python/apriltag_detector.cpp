@@ -54,10 +54,12 @@ class PyApriltagDetectorOp : public ApriltagDetectorOp {
 
   // Define a constructor that fully initializes the object.
   PyApriltagDetectorOp(holoscan::Fragment* fragment, int width, int height, int number_of_tags,
-                       const std::string& name = "apriltag_detector")
-      : ApriltagDetectorOp(holoscan::ArgList{holoscan::Arg{"width", width},
-                                             holoscan::Arg{"height", height},
-                                             holoscan::Arg{"number_of_tags", number_of_tags}}) {
+                       int number_of_cameras = 1, const std::string& name = "apriltag_detector")
+      : ApriltagDetectorOp(
+            holoscan::ArgList{holoscan::Arg{"width", width},
+                              holoscan::Arg{"height", height},
+                              holoscan::Arg{"number_of_tags", number_of_tags},
+                              holoscan::Arg{"number_of_cameras", number_of_cameras}}) {
     name_ = name;
     fragment_ = fragment;
     spec_ = std::make_shared<holoscan::OperatorSpec>(fragment);
@@ -92,11 +94,12 @@ PYBIND11_MODULE(_apriltag_detector, m) {
                        PyApriltagDetectorOp,
                        holoscan::Operator,
                        std::shared_ptr<ApriltagDetectorOp>>(m, "ApriltagDetectorOp")
-                .def(py::init<holoscan::Fragment*, int, int, int, const std::string&>(),
+                .def(py::init<holoscan::Fragment*, int, int, int, int, const std::string&>(),
                      "fragment"_a,
                      "width"_a,
                      "height"_a,
                      "number_of_tags"_a,
+                     "number_of_cameras"_a = 1,
                      "name"_a = "apriltag_detector"s)
                 .def("setup", &ApriltagDetectorOp::setup, "spec"_a);
 
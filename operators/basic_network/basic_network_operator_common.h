@@ -16,6 +16,9 @@
 
 #pragma once
 
+#include <cstdint>
+#include <vector>
+
 enum class L4Proto {
   TCP,
   UDP
@@ -27,4 +30,7 @@ struct NetworkOpBurstParams {
   uint8_t *data;
   uint32_t len;
   uint32_t num_pkts;
+  uint32_t stride = 0;             // Bytes between packets in data, 0 if packed back to back
+  std::vector<uint32_t> pkt_lens;  // Length of each packet when stride is set
+  bool pooled = false;             // data belongs to a buffer pool and must not be deleted
 };
@@ -14,13 +14,113 @@
  * limitations under the License.
  */
 
+#include <cuda_runtime.h>
+#include <linux/bpf.h>
+#include <linux/filter.h>
+#include <pthread.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
 #include <memory>
+#include <stdexcept>
 #include <string>
+#include <utility>
 
 #include "basic_network_operator_rx.h"
+#include "basic_network_uring.h"
 
 namespace holoscan::ops {
 
+RxBufferPool::RxBufferPool(uint32_t num_bufs, size_t buf_size, bool pinned) : pinned_(pinned) {
+  for (uint32_t i = 0; i < num_bufs; i++) {
+    uint8_t* buf = nullptr;
+    if (pinned_) {
+      if (cudaHostAlloc(reinterpret_cast<void**>(&buf), buf_size, cudaHostAllocDefault) !=
+          cudaSuccess) {
+        HOLOSCAN_LOG_CRITICAL("Failed to allocate {} bytes of pinned RX buffer", buf_size);
+        throw std::runtime_error("Failed to allocate RX buffer pool");
+      }
+    } else {
+      buf = new uint8_t[buf_size];
+    }
+    bufs_.push_back(buf);
+  }
+  free_ = bufs_;
+}
+
+RxBufferPool::~RxBufferPool() {
+  for (auto buf : bufs_) {
+    if (pinned_) {
+      cudaFreeHost(buf);
+    } else {
+      delete[] buf;
+    }
+  }
+}
+
+uint8_t* RxBufferPool::get() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (free_.empty()) { return nullptr; }
+  auto buf = free_.back();
+  free_.pop_back();
+  return buf;
+}
+
+void RxBufferPool::put(uint8_t* buf) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  free_.push_back(buf);
+}
+
+RxBurstQueue::RxBurstQueue(size_t capacity) {
+  size_t size = 2;
+  while (size < capacity) { size <<= 1; }
+  slots_ = std::make_unique<Slot[]>(size);
+  for (size_t i = 0; i < size; i++) { slots_[i].seq.store(i, std::memory_order_relaxed); }
+  mask_ = size - 1;
+}
+
+bool RxBurstQueue::push(std::shared_ptr<NetworkOpBurstParams> burst) {
+  size_t pos = tail_.load(std::memory_order_relaxed);
+  Slot* slot;
+  for (;;) {
+    slot = &slots_[pos & mask_];
+    const auto diff = static_cast<intptr_t>(slot->seq.load(std::memory_order_acquire)) -
+                      static_cast<intptr_t>(pos);
+    if (diff == 0) {
+      if (tail_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) { break; }
+    } else if (diff < 0) {
+      return false;
+    } else {
+      pos = tail_.load(std::memory_order_relaxed);
+    }
+  }
+  slot->burst = std::move(burst);
+  slot->seq.store(pos + 1, std::memory_order_release);
+  return true;
+}
+
+std::shared_ptr<NetworkOpBurstParams> RxBurstQueue::pop() {
+  size_t pos = head_.load(std::memory_order_relaxed);
+  Slot* slot;
+  for (;;) {
+    slot = &slots_[pos & mask_];
+    const auto diff = static_cast<intptr_t>(slot->seq.load(std::memory_order_acquire)) -
+                      static_cast<intptr_t>(pos + 1);
+    if (diff == 0) {
+      if (head_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) { break; }
+    } else if (diff < 0) {
+      return nullptr;
+    } else {
+      pos = head_.load(std::memory_order_relaxed);
+    }
+  }
+  auto burst = std::move(slot->burst);
+  slot->seq.store(pos + mask_ + 1, std::memory_order_release);
+  return burst;
+}
+
 void BasicNetworkOpRx::setup(OperatorSpec& spec) {
   spec.output<std::shared_ptr<NetworkOpBurstParams>>("burst_out");
 
@@ -31,10 +131,62 @@ void BasicNetworkOpRx::setup(OperatorSpec& spec) {
   spec.param<uint32_t>(batch_size_, "batch_size", "Batch size", "Number of packets in batch");
   spec.param<uint16_t>(
       max_payload_size_, "max_payload_size", "Max payload size", "Largest payload size");
+  spec.param<bool>(batched_recv_,
+                   "batched_recv",
+                   "Batched receive",
+                   "Receive UDP batches with recvmmsg into a pool of reusable buffers",
+                   false);
+  spec.param<uint32_t>(num_buffers_,
+                       "num_buffers",
+                       "Number of buffers",
+                       "Batch buffers in the pool, bounding the batches in flight downstream",
+                       8);
+  spec.param<bool>(pinned_buffers_,
+                   "pinned_buffers",
+                   "Pinned buffers",
+                   "Allocate the batch buffers in CUDA pinned host memory",
+                   false);
+  spec.param<std::string>(io_engine_,
+                          "io_engine",
+                          "I/O engine",
+                          "Socket I/O engine: socket (syscalls from compute) or uring (io_uring)",
+                          std::string("socket"));
+  spec.param<uint32_t>(num_workers_,
+                       "num_workers",
+                       "Number of workers",
+                       "UDP sockets sharing the port with SO_REUSEPORT, each drained by a thread",
+                       1);
+  spec.param<std::vector<int32_t>>(worker_cpus_,
+                                   "worker_cpus",
+                                   "Worker CPUs",
+                                   "CPU core to pin each worker thread to, unpinned if empty",
+                                   std::vector<int32_t>{});
+  spec.param<std::string>(steering_,
+                          "steering",
+                          "Steering",
+                          "Worker selection: none (kernel hash), hash (RX flow hash), cpu or ebpf",
+                          std::string("none"));
+  spec.param<std::string>(steering_prog_,
+                          "steering_prog",
+                          "Steering program",
+                          "Path of a pinned SK_REUSEPORT eBPF program for ebpf steering",
+                          std::string(""));
+  spec.param<uint32_t>(queue_size_,
+                       "queue_size",
+                       "Queue size",
+                       "Batches the workers can queue ahead of compute()",
+                       64);
 }
 
 BasicNetworkOpRx::~BasicNetworkOpRx() {
+  stop();
   HOLOSCAN_LOG_INFO("{} packets left in buffer for RX operator", pkts_in_batch_);
+  if (uring_drops_ > 0) {
+    HOLOSCAN_LOG_WARN("{} packets dropped with no free RX buffer", uring_drops_);
+  }
+  if (worker_drops_ > 0) {
+    HOLOSCAN_LOG_WARN("{} packets dropped on a full worker output queue", worker_drops_.load());
+  }
 }
 
 void BasicNetworkOpRx::initialize() {
@@ -58,6 +210,13 @@ void BasicNetworkOpRx::initialize() {
       HOLOSCAN_LOG_CRITICAL("Failed to create UDP socket");
       throw;
     }
+
+    int opt = 1;
+    if (num_workers_.get() > 1 &&
+        setsockopt(sockfd_, SOL_SOCKET, SO_REUSEPORT, &opt, sizeof(opt))) {
+      HOLOSCAN_LOG_CRITICAL("Failed to set SO_REUSEPORT");
+      throw std::runtime_error("Failed to set SO_REUSEPORT");
+    }
   } else {
     l4_proto_ = L4Proto::TCP;
 
@@ -87,11 +246,356 @@ void BasicNetworkOpRx::initialize() {
   } else {
     HOLOSCAN_LOG_INFO("Network RX operator bound to {}:{}", ip_addr_.get(), port_.get());
   }
+
+  if (batched_recv_.get()) {
+    if (l4_proto_ != L4Proto::UDP) {
+      HOLOSCAN_LOG_CRITICAL("batched_recv is only supported with UDP");
+      throw std::runtime_error("batched_recv requires UDP");
+    }
+
+    const auto batch_size = batch_size_.get();
+    pool_ = std::make_shared<RxBufferPool>(num_buffers_.get(),
+                                           static_cast<size_t>(max_payload_size_.get()) *
+                                               batch_size,
+                                           pinned_buffers_.get());
+    msgs_.resize(batch_size);
+    iovecs_.resize(batch_size);
+    pkt_lens_.resize(batch_size);
+    for (uint32_t i = 0; i < batch_size; i++) {
+      memset(&msgs_[i], 0, sizeof(msgs_[i]));
+      iovecs_[i].iov_len = max_payload_size_.get();
+      msgs_[i].msg_hdr.msg_iov = &iovecs_[i];
+      msgs_[i].msg_hdr.msg_iovlen = 1;
+    }
+    HOLOSCAN_LOG_INFO("Network RX operator receiving batches of {} packets into {} buffers",
+                      batch_size, num_buffers_.get());
+  }
+
+  if (num_workers_.get() == 0) {
+    HOLOSCAN_LOG_CRITICAL("num_workers must be at least 1");
+    throw std::runtime_error("Invalid num_workers");
+  }
+
+  if (num_workers_.get() > 1) {
+    if (l4_proto_ != L4Proto::UDP || io_engine_.get() != "socket") {
+      HOLOSCAN_LOG_CRITICAL("num_workers > 1 is only supported with UDP and the socket engine");
+      throw std::runtime_error("num_workers > 1 requires UDP and io_engine socket");
+    }
+
+    // Sockets join the reuseport group in bind order, which is the index steering returns
+    worker_fds_.push_back(sockfd_);
+    for (uint32_t i = 1; i < num_workers_.get(); i++) {
+      int fd = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+      int opt = 1;
+      if (fd < 0 || setsockopt(fd, SOL_SOCKET, SO_REUSEPORT, &opt, sizeof(opt)) ||
+          bind(fd, reinterpret_cast<const struct sockaddr*>(&server_addr_),
+               sizeof(server_addr_)) < 0) {
+        HOLOSCAN_LOG_CRITICAL("Failed to bind worker socket {} to {}:{}", i, ip_addr_.get(),
+                              port_.get());
+        throw std::runtime_error("Failed to bind worker socket");
+      }
+      worker_fds_.push_back(fd);
+    }
+
+    // Workers wake up periodically to notice stop()
+    struct timeval tv = {0, 100000};
+    for (auto fd : worker_fds_) { setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv)); }
+
+    attach_steering();
+    out_queue_ = std::make_unique<RxBurstQueue>(queue_size_.get());
+    HOLOSCAN_LOG_INFO("Network RX operator fanning {}:{} out to {} workers with {} steering",
+                      ip_addr_.get(), port_.get(), num_workers_.get(), steering_.get());
+  }
+
+  if (io_engine_.get() == "uring") {
+    // Enough registered buffers for two batches, within the kernel limit of a buffer ring
+    const uint32_t num_bufs = std::clamp<uint32_t>(2 * batch_size_.get(), 64, 32768);
+    engine_ = std::make_unique<UringEngine>();
+    if (!engine_->init(256, num_bufs, max_payload_size_.get())) {
+      HOLOSCAN_LOG_CRITICAL("Failed to create the io_uring engine");
+      throw std::runtime_error("Failed to create the io_uring engine");
+    }
+
+    if (l4_proto_ == L4Proto::UDP) {
+      engine_->recv_multishot(sockfd_);
+    } else {
+      HOLOSCAN_LOG_INFO("Waiting for incoming TCP connection on {}:{}", ip_addr_.get(),
+                        port_.get());
+      engine_->accept(sockfd_);
+    }
+    engine_->submit();
+  } else if (io_engine_.get() != "socket") {
+    HOLOSCAN_LOG_CRITICAL("Invalid io_engine {}, expected socket or uring", io_engine_.get());
+    throw std::runtime_error("Invalid io_engine");
+  }
+}
+
+void BasicNetworkOpRx::attach_steering() {
+  const auto& steering = steering_.get();
+  if (steering == "none") { return; }
+
+  // The program is attached to one socket but applies to the whole reuseport group
+  if (steering == "hash" || steering == "cpu") {
+    const uint32_t ancillary = steering == "hash" ? SKF_AD_RXHASH : SKF_AD_CPU;
+    struct sock_filter code[] = {
+        {BPF_LD | BPF_W | BPF_ABS, 0, 0, static_cast<uint32_t>(SKF_AD_OFF) + ancillary},
+        {BPF_ALU | BPF_MOD | BPF_K, 0, 0, num_workers_.get()},
+        {BPF_RET | BPF_A, 0, 0, 0},
+    };
+    struct sock_fprog prog = {sizeof(code) / sizeof(code[0]), code};
+    if (setsockopt(sockfd_, SOL_SOCKET, SO_ATTACH_REUSEPORT_CBPF, &prog, sizeof(prog))) {
+      HOLOSCAN_LOG_CRITICAL("Failed to attach the {} steering program: {}", steering, errno);
+      throw std::runtime_error("Failed to attach the steering program");
+    }
+    return;
+  }
+
+  if (steering == "ebpf") {
+    union bpf_attr attr;
+    memset(&attr, 0, sizeof(attr));
+    attr.pathname = reinterpret_cast<uint64_t>(steering_prog_.get().c_str());
+    const int prog_fd = syscall(__NR_bpf, BPF_OBJ_GET, &attr, sizeof(attr));
+    if (prog_fd < 0 ||
+        setsockopt(sockfd_, SOL_SOCKET, SO_ATTACH_REUSEPORT_EBPF, &prog_fd, sizeof(prog_fd))) {
+      HOLOSCAN_LOG_CRITICAL("Failed to attach the eBPF steering program {}: {}",
+                            steering_prog_.get(), errno);
+      throw std::runtime_error("Failed to attach the steering program");
+    }
+    close(prog_fd);
+    return;
+  }
+
+  HOLOSCAN_LOG_CRITICAL("Invalid steering {}, expected none, hash, cpu or ebpf", steering);
+  throw std::runtime_error("Invalid steering");
+}
+
+void BasicNetworkOpRx::start() {
+  if (worker_fds_.empty()) { return; }
+
+  stop_workers_ = false;
+  for (uint32_t i = 0; i < worker_fds_.size(); i++) {
+    workers_.emplace_back(&BasicNetworkOpRx::worker_loop, this, i);
+  }
+}
+
+void BasicNetworkOpRx::stop() {
+  stop_workers_ = true;
+  for (auto& worker : workers_) {
+    if (worker.joinable()) { worker.join(); }
+  }
+  workers_.clear();
+}
+
+void BasicNetworkOpRx::worker_loop(uint32_t idx) {
+  const auto& cpus = worker_cpus_.get();
+  if (idx < cpus.size() && cpus[idx] >= 0) {
+    cpu_set_t cpuset;
+    CPU_ZERO(&cpuset);
+    CPU_SET(cpus[idx], &cpuset);
+    if (pthread_setaffinity_np(pthread_self(), sizeof(cpuset), &cpuset) != 0) {
+      HOLOSCAN_LOG_ERROR("Failed to pin RX worker {} to CPU {}", idx, cpus[idx]);
+    }
+  }
+
+  const int fd = worker_fds_[idx];
+  const uint32_t batch_size = batch_size_.get();
+  const uint32_t stride = max_payload_size_.get();
+  const bool pooled = batched_recv_.get();
+  std::vector<struct mmsghdr> msgs(batch_size);
+  std::vector<struct iovec> iovecs(batch_size);
+  std::vector<uint32_t> lens(batch_size);
+  for (uint32_t i = 0; i < batch_size; i++) {
+    memset(&msgs[i], 0, sizeof(msgs[i]));
+    iovecs[i].iov_len = stride;
+    msgs[i].msg_hdr.msg_iov = &iovecs[i];
+    msgs[i].msg_hdr.msg_iovlen = 1;
+  }
+
+  uint8_t* buf = nullptr;
+  uint32_t pkts = 0;
+  uint32_t bytes = 0;
+  while (!stop_workers_.load(std::memory_order_relaxed)) {
+    if (buf == nullptr) {
+      buf = pooled ? pool_->get() : new uint8_t[static_cast<size_t>(stride) * batch_size];
+      if (buf == nullptr) {
+        // Every pool buffer is held downstream, leave the packets in the socket
+        std::this_thread::sleep_for(std::chrono::microseconds(100));
+        continue;
+      }
+      for (uint32_t i = 0; i < batch_size; i++) { iovecs[i].iov_base = buf + i * stride; }
+    }
+
+    // Blocks until at least one datagram arrives or the receive timeout expires
+    const int n = recvmmsg(fd, &msgs[pkts], batch_size - pkts, MSG_WAITFORONE, nullptr);
+    if (n <= 0) { continue; }
+
+    for (int i = 0; i < n; i++) {
+      const uint32_t len = msgs[pkts + i].msg_len;
+      // Without the pool, packets are packed back to back like the single socket path
+      if (!pooled) { memmove(buf + bytes, buf + (pkts + i) * stride, len); }
+      lens[pkts + i] = len;
+      bytes += len;
+    }
+    pkts += n;
+    if (pkts < batch_size) { continue; }
+
+    auto msg = make_burst(buf, bytes, pkts, lens.data());
+    if (!out_queue_->push(msg)) {
+      worker_drops_.fetch_add(pkts, std::memory_order_relaxed);
+      if (!pooled) { delete[] buf; }
+    }
+    buf = nullptr;
+    pkts = 0;
+    bytes = 0;
+  }
+
+  if (buf != nullptr) {
+    if (pooled) {
+      pool_->put(buf);
+    } else {
+      delete[] buf;
+    }
+  }
+}
+
+std::shared_ptr<NetworkOpBurstParams> BasicNetworkOpRx::make_burst(
+    uint8_t* buf, uint32_t len, uint32_t num_pkts, const uint32_t* pkt_lens) const {
+  if (!batched_recv_.get()) { return std::make_shared<NetworkOpBurstParams>(buf, len, num_pkts); }
+
+  // The buffer goes back to the pool when the last downstream reference drops. The pool is
+  // kept alive by its bursts in case they outlive the operator.
+  auto msg = std::shared_ptr<NetworkOpBurstParams>(new NetworkOpBurstParams(buf, len, num_pkts),
+                                                   [pool = pool_](NetworkOpBurstParams* burst) {
+                                                     pool->put(burst->data);
+                                                     delete burst;
+                                                   });
+  msg->stride = max_payload_size_.get();
+  msg->pkt_lens.assign(pkt_lens, pkt_lens + num_pkts);
+  msg->pooled = true;
+  return msg;
+}
+
+void BasicNetworkOpRx::emit_batch(OutputContext& op_output) {
+  auto msg = make_burst(pkt_buf, byte_cnt_, pkts_in_batch_, pkt_lens_.data());
+
+  pkt_buf = nullptr;
+  byte_cnt_ = 0;
+  pkts_in_batch_ = 0;
+
+  op_output.emit(msg, "burst_out");
+}
+
+void BasicNetworkOpRx::receive_packet(const uint8_t* data, uint32_t len,
+                                      OutputContext& op_output) {
+  const uint32_t max_payload = max_payload_size_.get();
+
+  if (pkt_buf == nullptr) {
+    if (!batched_recv_.get()) {
+      pkt_buf = new uint8_t[max_payload * batch_size_.get()];
+    } else if ((pkt_buf = pool_->get()) == nullptr) {
+      // The packet is already out of the socket, so it cannot wait for a buffer
+      uring_drops_++;
+      return;
+    }
+  }
+
+  // Packed back to back by default, one max_payload_size slot per packet with batched_recv
+  const uint32_t n = std::min(len, max_payload);
+  const uint32_t offset = batched_recv_.get() ? pkts_in_batch_ * max_payload : byte_cnt_;
+  memcpy(pkt_buf + offset, data, n);
+  if (batched_recv_.get()) { pkt_lens_[pkts_in_batch_] = n; }
+  byte_cnt_ += n;
+  pkts_in_batch_++;
+
+  if (pkts_in_batch_ == batch_size_.get()) { emit_batch(op_output); }
+}
+
+void BasicNetworkOpRx::compute_uring(OutputContext& op_output) {
+  bool queued = false;
+
+  engine_->reap([&](const UringEngine::Completion& c) {
+    if (c.op == UringEngine::Op::ACCEPT) {
+      if (c.res < 0) {
+        HOLOSCAN_LOG_ERROR("Failed to accept incoming TCP connection: {}", -c.res);
+        queued |= engine_->accept(sockfd_);
+        return;
+      }
+      tcp_sock_ = c.res;
+      connected_ = true;
+      HOLOSCAN_LOG_INFO("Successfully attached to incoming connection");
+      queued |= engine_->recv_multishot(tcp_sock_);
+      return;
+    }
+
+    if (c.op != UringEngine::Op::RECV) { return; }
+
+    if (c.res == 0 && l4_proto_ == L4Proto::TCP) {
+      HOLOSCAN_LOG_INFO("TCP connection closed, waiting for a new one");
+      close(tcp_sock_);
+      connected_ = false;
+      queued |= engine_->accept(sockfd_);
+      return;
+    }
+
+    if (c.res > 0) {
+      receive_packet(c.data, c.res, op_output);
+    } else if (c.res < 0 && c.res != -ENOBUFS) {
+      HOLOSCAN_LOG_ERROR("Error while receiving packet: {}", -c.res);
+    }
+
+    // The kernel ends a multishot recv on errors or when it runs out of buffers
+    if (!c.more) {
+      queued |= engine_->recv_multishot(l4_proto_ == L4Proto::UDP ? sockfd_ : tcp_sock_);
+    }
+  });
+
+  if (queued) { engine_->submit(); }
+}
+
+void BasicNetworkOpRx::compute_batched(OutputContext& op_output) {
+  const auto batch_size = batch_size_.get();
+  const auto stride = max_payload_size_.get();
+
+  if (pkt_buf == nullptr) {
+    if ((pkt_buf = pool_->get()) == nullptr) {
+      // Every buffer is still held downstream, leave the packets in the socket
+      HOLOSCAN_LOG_DEBUG("No free RX buffer, downstream is holding all {} buffers",
+                         num_buffers_.get());
+      return;
+    }
+    for (uint32_t i = 0; i < batch_size; i++) { iovecs_[i].iov_base = pkt_buf + i * stride; }
+  }
+
+  // A single syscall gathers every datagram queued on the socket, up to the end of the batch
+  const int n = recvmmsg(
+      sockfd_, &msgs_[pkts_in_batch_], batch_size - pkts_in_batch_, MSG_DONTWAIT, nullptr);
+  if (n <= 0) { return; }
+
+  for (int i = 0; i < n; i++) {
+    pkt_lens_[pkts_in_batch_ + i] = msgs_[pkts_in_batch_ + i].msg_len;
+    byte_cnt_ += msgs_[pkts_in_batch_ + i].msg_len;
+  }
+  pkts_in_batch_ += n;
+  if (pkts_in_batch_ < batch_size) { return; }
+
+  emit_batch(op_output);
 }
 
 void BasicNetworkOpRx::compute([[maybe_unused]] InputContext&, OutputContext& op_output,
                                [[maybe_unused]] ExecutionContext&) {
   HOLOSCAN_LOG_DEBUG("BasicNetworkOpRx::compute");
+  if (out_queue_) {
+    // One batch per call, the workers keep receiving in the meantime
+    auto msg = out_queue_->pop();
+    if (msg) { op_output.emit(msg, "burst_out"); }
+    return;
+  }
+
+  if (engine_) {
+    compute_uring(op_output);
+    return;
+  }
+
   sockaddr_in addr;
   socklen_t from_len;
   from_len = sizeof(addr);
@@ -108,6 +612,11 @@ void BasicNetworkOpRx::compute([[maybe_unused]] InputContext&, OutputContext& op
     connected_ = true;
   }
 
+  if (batched_recv_.get()) {
+    compute_batched(op_output);
+    return;
+  }
+
   if (byte_cnt_ == 0) { pkt_buf = new uint8_t[max_payload_size_.get() * batch_size_.get()]; }
 
   while (pkts_in_batch_ < batch_size_.get()) {
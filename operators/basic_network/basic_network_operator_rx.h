@@ -19,12 +19,67 @@
 #include <arpa/inet.h>
 #include <netinet/in.h>
 #include <sys/socket.h>
+#include <atomic>
+#include <memory>
+#include <mutex>
 #include <string>
+#include <thread>
+#include <vector>
 #include "basic_network_operator_common.h"
 #include "holoscan/holoscan.hpp"
 
 namespace holoscan::ops {
 
+class UringEngine;
+
+/**
+ * @brief Fixed set of batch buffers reused by the RX operator
+ *
+ * Buffers are handed out for a batch and given back when the last shared_ptr to the burst
+ * holding them drops, possibly from another operator's thread.
+ */
+class RxBufferPool {
+ public:
+  RxBufferPool(uint32_t num_bufs, size_t buf_size, bool pinned);
+  ~RxBufferPool();
+
+  uint8_t* get();
+  void put(uint8_t* buf);
+
+ private:
+  std::mutex mutex_;
+  std::vector<uint8_t*> bufs_;
+  std::vector<uint8_t*> free_;
+  bool pinned_;
+};
+
+/**
+ * @brief Bounded lock-free queue of bursts from the RX workers to compute()
+ *
+ * Multi-producer multi-consumer ring where each slot carries a sequence number telling
+ * producers and consumers whose turn it is, so neither side takes a lock.
+ */
+class RxBurstQueue {
+ public:
+  explicit RxBurstQueue(size_t capacity);
+
+  // false if the queue is full
+  bool push(std::shared_ptr<NetworkOpBurstParams> burst);
+  // nullptr if the queue is empty
+  std::shared_ptr<NetworkOpBurstParams> pop();
+
+ private:
+  struct Slot {
+    std::atomic<size_t> seq;
+    std::shared_ptr<NetworkOpBurstParams> burst;
+  };
+
+  std::unique_ptr<Slot[]> slots_;
+  size_t mask_;
+  alignas(64) std::atomic<size_t> head_{0};
+  alignas(64) std::atomic<size_t> tail_{0};
+};
+
 class BasicNetworkOpRx : public Operator {
  public:
   HOLOSCAN_OPERATOR_FORWARD_ARGS(BasicNetworkOpRx);
@@ -33,14 +88,34 @@ class BasicNetworkOpRx : public Operator {
   ~BasicNetworkOpRx();
   void initialize() override;
   void setup(OperatorSpec& spec) override;
+  void start() override;
+  void stop() override;
   void compute(InputContext&, OutputContext& op_output, ExecutionContext&) override;
 
  private:
+  std::shared_ptr<NetworkOpBurstParams> make_burst(uint8_t* buf, uint32_t len, uint32_t num_pkts,
+                                                   const uint32_t* pkt_lens) const;
+  void attach_steering();
+  void worker_loop(uint32_t idx);
+  void compute_batched(OutputContext& op_output);
+  void compute_uring(OutputContext& op_output);
+  void receive_packet(const uint8_t* data, uint32_t len, OutputContext& op_output);
+  void emit_batch(OutputContext& op_output);
+
   Parameter<std::string> ip_addr_;
   Parameter<uint16_t> port_;
   Parameter<std::string> l4_proto_p_;
   Parameter<uint32_t> batch_size_;
   Parameter<uint16_t> max_payload_size_;
+  Parameter<bool> batched_recv_;
+  Parameter<uint32_t> num_buffers_;
+  Parameter<bool> pinned_buffers_;
+  Parameter<std::string> io_engine_;
+  Parameter<uint32_t> num_workers_;
+  Parameter<std::vector<int32_t>> worker_cpus_;
+  Parameter<std::string> steering_;
+  Parameter<std::string> steering_prog_;
+  Parameter<uint32_t> queue_size_;
 
   int sockfd_;
   int tcp_sock_;
@@ -50,6 +125,23 @@ class BasicNetworkOpRx : public Operator {
   uint8_t* pkt_buf = nullptr;
   uint32_t pkts_in_batch_ = 0;
   bool connected_ = false;
+
+  // Batched receive state, one mmsghdr and iovec per packet of the batch
+  std::shared_ptr<RxBufferPool> pool_;
+  std::vector<struct mmsghdr> msgs_;
+  std::vector<struct iovec> iovecs_;
+  std::vector<uint32_t> pkt_lens_;
+
+  // io_uring engine state
+  std::unique_ptr<UringEngine> engine_;
+  uint64_t uring_drops_ = 0;  // Packets received while every pool buffer was held downstream
+
+  // SO_REUSEPORT fan-out state, one socket and thread per worker. sockfd_ is worker 0's socket.
+  std::vector<int> worker_fds_;
+  std::vector<std::thread> workers_;
+  std::unique_ptr<RxBurstQueue> out_queue_;
+  std::atomic<bool> stop_workers_{false};
+  std::atomic<uint64_t> worker_drops_{0};  // Packets of batches dropped on a full output queue
 };
 
 };  // namespace holoscan::ops
@@ -14,13 +14,29 @@
  * limitations under the License.
  */
 
+#include <netinet/udp.h>
 #include <unistd.h>
 #include <algorithm>
+#include <cerrno>
+#include <stdexcept>
 #include <string>
 #include "basic_network_operator_tx.h"
+#include "basic_network_uring.h"
+
+#ifndef UDP_SEGMENT
+#define UDP_SEGMENT 103
+#endif
 
 namespace holoscan::ops {
 
+namespace {
+// Kernel limits of a single UDP_SEGMENT send
+constexpr size_t GSO_MAX_SEGMENTS = 64;
+constexpr size_t GSO_MAX_BYTES = 65507;
+// Largest number of messages the kernel accepts in one sendmmsg call
+constexpr size_t MMSG_MAX_MSGS = 1024;
+}  // namespace
+
 void BasicNetworkOpTx::setup(OperatorSpec& spec) {
   spec.input<std::shared_ptr<NetworkOpBurstParams>>("burst_in");
 
@@ -40,6 +56,39 @@ void BasicNetworkOpTx::setup(OperatorSpec& spec) {
                        "Re-connect() interval",
                        "Interval to retry connecting to server in seconds",
                        1);
+  spec.param<bool>(batched_send_,
+                   "batched_send",
+                   "Batched send",
+                   "Send UDP bursts with sendmmsg, or UDP_SEGMENT when packets are equal-sized",
+                   false);
+  spec.param<bool>(gso_,
+                   "gso",
+                   "UDP GSO",
+                   "Let the kernel segment bursts of equal-sized packets in batched_send mode",
+                   true);
+  spec.param<std::string>(io_engine_,
+                          "io_engine",
+                          "I/O engine",
+                          "Socket I/O engine: socket (syscalls from compute) or uring (io_uring)",
+                          std::string("socket"));
+}
+
+BasicNetworkOpTx::~BasicNetworkOpTx() {
+  // Wait for the kernel to be done with the bursts still being sent
+  while (engine_ && !inflight_.empty()) {
+    engine_->wait();
+    reap_uring();
+  }
+
+  if (batched_send_.get() || engine_) {
+    HOLOSCAN_LOG_INFO(
+        "Network TX operator sent {} packets, {} bytes in {} syscalls ({} GSO), {} errors",
+        total_stats_.packets,
+        total_stats_.bytes,
+        total_stats_.syscalls,
+        total_stats_.gso_sends,
+        total_stats_.errors);
+  }
 }
 void BasicNetworkOpTx::initialize() {
   HOLOSCAN_LOG_INFO("BasicNetworkOpTx::initialize()");
@@ -75,6 +124,241 @@ void BasicNetworkOpTx::initialize() {
     ts_.tv_sec = 0;
     ts_.tv_nsec = ipg_.get();
   }
+
+  if (batched_send_.get()) {
+    if (l4_proto_ != L4Proto::UDP) {
+      HOLOSCAN_LOG_CRITICAL("batched_send is only supported with UDP");
+      throw std::runtime_error("batched_send requires UDP");
+    }
+    if (ipg_.get() > 0) {
+      HOLOSCAN_LOG_WARN("min_ipg_ns is ignored with batched_send, bursts are sent at once");
+    }
+  }
+
+  if (io_engine_.get() == "uring") {
+    engine_ = std::make_unique<UringEngine>();
+    if (!engine_->init(1024)) {
+      HOLOSCAN_LOG_CRITICAL("Failed to create the io_uring engine");
+      throw std::runtime_error("Failed to create the io_uring engine");
+    }
+    if (ipg_.get() > 0) {
+      HOLOSCAN_LOG_WARN("min_ipg_ns is ignored with the uring engine, bursts are sent at once");
+    }
+  } else if (io_engine_.get() != "socket") {
+    HOLOSCAN_LOG_CRITICAL("Invalid io_engine {}, expected socket or uring", io_engine_.get());
+    throw std::runtime_error("Invalid io_engine");
+  }
+}
+
+bool BasicNetworkOpTx::send_gso(size_t first, size_t count, uint16_t gso_size,
+                                TxBatchStats& stats) {
+  iovecs_.resize(count);
+  size_t bytes = 0;
+  for (size_t i = 0; i < count; i++) {
+    iovecs_[i].iov_base = pkts_[first + i].first;
+    iovecs_[i].iov_len = pkts_[first + i].second;
+    bytes += pkts_[first + i].second;
+  }
+
+  char control[CMSG_SPACE(sizeof(uint16_t))] = {};
+  struct msghdr mh = {};
+  mh.msg_iov = iovecs_.data();
+  mh.msg_iovlen = count;
+  mh.msg_control = control;
+  mh.msg_controllen = sizeof(control);
+
+  struct cmsghdr* cm = CMSG_FIRSTHDR(&mh);
+  cm->cmsg_level = IPPROTO_UDP;
+  cm->cmsg_type = UDP_SEGMENT;
+  cm->cmsg_len = CMSG_LEN(sizeof(uint16_t));
+  *reinterpret_cast<uint16_t*>(CMSG_DATA(cm)) = gso_size;
+
+  stats.syscalls++;
+  if (sendmsg(sockfd_, &mh, 0) < 0) {
+    // Kernels or devices without UDP GSO reject the control message
+    if (errno == EINVAL || errno == EIO || errno == ENOPROTOOPT) {
+      HOLOSCAN_LOG_WARN("UDP GSO not supported ({}), falling back to sendmmsg", errno);
+      gso_supported_ = false;
+      return false;
+    }
+    HOLOSCAN_LOG_ERROR("Error while sending UDP GSO burst: {}", errno);
+    stats.errors += count;
+    return true;
+  }
+
+  stats.gso_sends++;
+  stats.packets += count;
+  stats.bytes += bytes;
+  return true;
+}
+
+void BasicNetworkOpTx::send_mmsg(size_t first, size_t count, TxBatchStats& stats) {
+  msgs_.resize(count);
+  iovecs_.resize(count);
+  for (size_t i = 0; i < count; i++) {
+    iovecs_[i].iov_base = pkts_[first + i].first;
+    iovecs_[i].iov_len = pkts_[first + i].second;
+    memset(&msgs_[i], 0, sizeof(msgs_[i]));
+    msgs_[i].msg_hdr.msg_iov = &iovecs_[i];
+    msgs_[i].msg_hdr.msg_iovlen = 1;
+  }
+
+  size_t done = 0;
+  while (done < count) {
+    stats.syscalls++;
+    const int sent = sendmmsg(sockfd_, &msgs_[done], count - done, 0);
+    if (sent < 0) {
+      if (errno == EINTR) { continue; }
+      // Skip the datagram the kernel refused and go on with the rest of the burst
+      HOLOSCAN_LOG_ERROR("Error while sending UDP packet: {}", errno);
+      stats.errors++;
+      done++;
+      continue;
+    }
+    for (int i = 0; i < sent; i++) { stats.bytes += msgs_[done + i].msg_len; }
+    stats.packets += sent;
+    done += sent;
+  }
+}
+
+void BasicNetworkOpTx::collect_packets(const NetworkOpBurstParams& msg) {
+  // Packets are either strided with their own lengths, or packed and cut at max_payload_size
+  pkts_.clear();
+  if (msg.stride > 0) {
+    for (uint32_t i = 0; i < msg.num_pkts; i++) {
+      pkts_.emplace_back(msg.data + static_cast<size_t>(i) * msg.stride, msg.pkt_lens[i]);
+    }
+  } else {
+    for (uint32_t off = 0; off < msg.len; off += max_payload_size_.get()) {
+      pkts_.emplace_back(msg.data + off,
+                         std::min(msg.len - off, static_cast<uint32_t>(max_payload_size_.get())));
+    }
+  }
+}
+
+void BasicNetworkOpTx::send_batched(const NetworkOpBurstParams& msg) {
+  collect_packets(msg);
+  if (pkts_.empty()) { return; }
+
+  // GSO cuts the payload every gso_size bytes, so only the last packet may be shorter
+  const uint32_t gso_size = pkts_[0].second;
+  bool equal_sized = gso_size > 0;
+  for (size_t i = 1; i < pkts_.size() && equal_sized; i++) {
+    equal_sized = pkts_[i].second == gso_size ||
+                  (i == pkts_.size() - 1 && pkts_[i].second < gso_size);
+  }
+
+  TxBatchStats stats;
+  size_t first = 0;
+  const size_t per_send = equal_sized ? std::min(GSO_MAX_SEGMENTS, GSO_MAX_BYTES / gso_size) : 0;
+  if (gso_.get() && gso_supported_ && per_send > 1 && pkts_.size() > 1) {
+    while (first < pkts_.size()) {
+      const size_t count = std::min(per_send, pkts_.size() - first);
+      if (!send_gso(first, count, gso_size, stats)) { break; }
+      first += count;
+    }
+  }
+
+  while (first < pkts_.size()) {
+    const size_t count = std::min(MMSG_MAX_MSGS, pkts_.size() - first);
+    send_mmsg(first, count, stats);
+    first += count;
+  }
+
+  HOLOSCAN_LOG_DEBUG("TX burst: {} packets, {} bytes, {} syscalls ({} GSO), {} errors",
+                     stats.packets,
+                     stats.bytes,
+                     stats.syscalls,
+                     stats.gso_sends,
+                     stats.errors);
+  total_stats_ += stats;
+}
+
+void BasicNetworkOpTx::reap_uring() {
+  engine_->reap([&](const UringEngine::Completion& c) {
+    if (c.op == UringEngine::Op::CONNECT) {
+      connecting_ = false;
+      if (c.res < 0) {
+        HOLOSCAN_LOG_INFO("Failed to connect to server at {}:{}: {}", ip_addr_.get(), port_.get(),
+                          -c.res);
+        return;
+      }
+      connected_ = true;
+      HOLOSCAN_LOG_INFO("Successfully connected to server at {}:{}", ip_addr_.get(), port_.get());
+      return;
+    }
+
+    if (c.op != UringEngine::Op::SEND) { return; }
+
+    auto it = inflight_.find(c.tag);
+    if (it == inflight_.end()) { return; }
+    if (c.res < 0) {
+      HOLOSCAN_LOG_ERROR("Error while sending packet: {}", -c.res);
+      total_stats_.errors++;
+    } else {
+      total_stats_.packets++;
+      total_stats_.bytes += c.res;
+    }
+
+    if (--it->second.pending_sends == 0) {
+      if (!it->second.msg->pooled) { delete[] it->second.msg->data; }
+      inflight_.erase(it);
+    }
+  });
+
+  // TCP bursts go out one at a time, in order
+  if (l4_proto_ == L4Proto::TCP && inflight_.empty() && !tcp_backlog_.empty()) {
+    auto msg = tcp_backlog_.front();
+    tcp_backlog_.pop_front();
+    submit_uring_burst(msg);
+  }
+}
+
+void BasicNetworkOpTx::submit_uring_burst(std::shared_ptr<NetworkOpBurstParams> msg) {
+  collect_packets(*msg);
+  if (pkts_.empty()) {
+    if (!msg->pooled) { delete[] msg->data; }
+    return;
+  }
+
+  const uint32_t tag = next_tag_++;
+  inflight_[tag] = InflightBurst{msg, pkts_.size()};
+  for (const auto& [data, len] : pkts_) {
+    // Make room in the submission queue by waiting for earlier sends to complete
+    while (!engine_->send(sockfd_, data, len, tag)) {
+      engine_->wait();
+      reap_uring();
+    }
+  }
+  engine_->submit();
+  total_stats_.syscalls++;
+}
+
+void BasicNetworkOpTx::compute_uring(std::shared_ptr<NetworkOpBurstParams> msg) {
+  reap_uring();
+
+  if (!connected_) {
+    const auto now = std::chrono::steady_clock::now();
+    const auto retry = std::chrono::seconds(std::max(retry_connect_.get(), 0));
+    const bool attempted = last_connect_ != std::chrono::steady_clock::time_point{};
+    const bool may_retry = !attempted || retry_connect_.get() != -1;
+    if (!connecting_ && may_retry && now - last_connect_ >= retry) {
+      engine_->connect(sockfd_, &server_addr_);
+      engine_->submit();
+      connecting_ = true;
+      last_connect_ = now;
+    }
+
+    // As with the socket engine, bursts arriving before the connection is up are not sent
+    if (!msg->pooled) { delete[] msg->data; }
+    return;
+  }
+
+  if (l4_proto_ == L4Proto::TCP && (!inflight_.empty() || !tcp_backlog_.empty())) {
+    tcp_backlog_.push_back(msg);
+    return;
+  }
+  submit_uring_burst(msg);
 }
 
 void BasicNetworkOpTx::compute(InputContext& op_input, [[maybe_unused]] OutputContext& op_output,
@@ -83,6 +367,12 @@ void BasicNetworkOpTx::compute(InputContext& op_input, [[maybe_unused]] OutputCo
   auto msg = op_input.receive<std::shared_ptr<NetworkOpBurstParams>>("burst_in").value();
   int sent;
 
+  if (engine_) {
+    compute_uring(msg);
+    HOLOSCAN_LOG_DEBUG("BasicNetworkOpTx::compute done");
+    return;
+  }
+
   if (!connected_) {
     auto ret = connect(sockfd_, (struct sockaddr*)&server_addr_, sizeof(server_addr_));
     if (ret < 0) {
@@ -104,6 +394,12 @@ void BasicNetworkOpTx::compute(InputContext& op_input, [[maybe_unused]] OutputCo
     HOLOSCAN_LOG_INFO("Successfully connected to server at {}:{}", ip_addr_.get(), port_.get());
   }
 
+  if (batched_send_.get()) {
+    send_batched(*msg);
+    if (!msg->pooled) { delete[] msg->data; }
+    HOLOSCAN_LOG_DEBUG("BasicNetworkOpTx::compute done");
+    return;
+  }
 
   while (msg->len > 0) {
     auto pkt_size = std::min(msg->len, static_cast<uint32_t>(max_payload_size_.get()));
@@ -139,7 +435,7 @@ void BasicNetworkOpTx::compute(InputContext& op_input, [[maybe_unused]] OutputCo
 
   byte_cnt_ = 0;
 
-  delete[] msg->data;
+  if (!msg->pooled) { delete[] msg->data; }
 
   HOLOSCAN_LOG_DEBUG("BasicNetworkOpTx::compute done");
 }
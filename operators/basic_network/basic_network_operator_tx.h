@@ -19,29 +19,68 @@
 #include <arpa/inet.h>
 #include <netinet/in.h>
 #include <sys/socket.h>
+#include <chrono>
+#include <deque>
+#include <memory>
 #include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 #include "basic_network_operator_common.h"
 #include "holoscan/holoscan.hpp"
 
 namespace holoscan::ops {
 
+class UringEngine;
+
+/**
+ * @brief Counters of the batched transmit path, per burst and since startup
+ */
+struct TxBatchStats {
+  uint64_t packets = 0;
+  uint64_t bytes = 0;
+  uint64_t syscalls = 0;
+  uint64_t gso_sends = 0;  // sendmsg calls segmented by the kernel with UDP_SEGMENT
+  uint64_t errors = 0;
+
+  TxBatchStats& operator+=(const TxBatchStats& other) {
+    packets += other.packets;
+    bytes += other.bytes;
+    syscalls += other.syscalls;
+    gso_sends += other.gso_sends;
+    errors += other.errors;
+    return *this;
+  }
+};
+
 class BasicNetworkOpTx : public Operator {
  public:
   HOLOSCAN_OPERATOR_FORWARD_ARGS(BasicNetworkOpTx);
 
   BasicNetworkOpTx() = default;
-  ~BasicNetworkOpTx() = default;
+  ~BasicNetworkOpTx();
   void initialize() override;
   void setup(OperatorSpec& spec) override;
   void compute(InputContext&, OutputContext& op_output, ExecutionContext&) override;
 
  private:
+  void collect_packets(const NetworkOpBurstParams& msg);
+  void send_batched(const NetworkOpBurstParams& msg);
+  void compute_uring(std::shared_ptr<NetworkOpBurstParams> msg);
+  void reap_uring();
+  void submit_uring_burst(std::shared_ptr<NetworkOpBurstParams> msg);
+  bool send_gso(size_t first, size_t count, uint16_t gso_size, TxBatchStats& stats);
+  void send_mmsg(size_t first, size_t count, TxBatchStats& stats);
+
   Parameter<std::string> ip_addr_;
   Parameter<uint16_t> port_;
   Parameter<int32_t> retry_connect_;
   Parameter<std::string> l4_proto_p_;
   Parameter<uint16_t> max_payload_size_;
   Parameter<uint32_t> ipg_;
+  Parameter<bool> batched_send_;
+  Parameter<bool> gso_;
+  Parameter<std::string> io_engine_;
 
   int sockfd_;
   L4Proto l4_proto_;
@@ -50,6 +89,26 @@ class BasicNetworkOpTx : public Operator {
   uint32_t pkts_sent_ = 0;
   struct timespec ts_;
   bool connected_ = false;
+
+  // Batched transmit state: the packets of the current burst and their send descriptors
+  std::vector<std::pair<uint8_t*, uint32_t>> pkts_;
+  std::vector<struct mmsghdr> msgs_;
+  std::vector<struct iovec> iovecs_;
+  bool gso_supported_ = true;
+  TxBatchStats total_stats_;
+
+  // io_uring engine state. Bursts stay alive until all their sends complete, and TCP bursts
+  // are sent one at a time to keep the stream in order.
+  struct InflightBurst {
+    std::shared_ptr<NetworkOpBurstParams> msg;
+    size_t pending_sends;
+  };
+  std::unique_ptr<UringEngine> engine_;
+  std::unordered_map<uint32_t, InflightBurst> inflight_;
+  std::deque<std::shared_ptr<NetworkOpBurstParams>> tcp_backlog_;
+  uint32_t next_tag_ = 0;
+  bool connecting_ = false;
+  std::chrono::steady_clock::time_point last_connect_{};
 };
 
 };  // namespace holoscan::ops
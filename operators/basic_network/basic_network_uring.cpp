@@ -0,0 +1,223 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2023 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "basic_network_uring.h"
+
+#include <vector>
+#include "holoscan/holoscan.hpp"
+
+#ifdef BASIC_NETWORK_IO_URING
+#include <liburing.h>
+#endif
+
+namespace holoscan::ops {
+
+#ifdef BASIC_NETWORK_IO_URING
+
+namespace {
+constexpr uint16_t RECV_BUF_GROUP = 0;
+
+uint64_t encode(UringEngine::Op op, uint32_t tag) {
+  return (static_cast<uint64_t>(op) << 32) | tag;
+}
+}  // namespace
+
+struct UringEngine::Impl {
+  struct io_uring ring;
+  bool ring_ready = false;
+  struct io_uring_buf_ring* buf_ring = nullptr;
+  uint32_t num_bufs = 0;
+  uint32_t buf_size = 0;
+  std::vector<uint8_t> bufs;
+
+  struct io_uring_sqe* get_sqe() { return io_uring_get_sqe(&ring); }
+
+  void recycle(uint16_t bid) {
+    io_uring_buf_ring_add(buf_ring,
+                          bufs.data() + static_cast<size_t>(bid) * buf_size,
+                          buf_size,
+                          bid,
+                          io_uring_buf_ring_mask(num_bufs),
+                          0);
+    io_uring_buf_ring_advance(buf_ring, 1);
+  }
+};
+
+bool UringEngine::supported() {
+  return true;
+}
+
+UringEngine::UringEngine() : impl_(std::make_unique<Impl>()) {}
+
+UringEngine::~UringEngine() {
+  if (impl_->buf_ring != nullptr) {
+    io_uring_free_buf_ring(&impl_->ring, impl_->buf_ring, impl_->num_bufs, RECV_BUF_GROUP);
+  }
+  if (impl_->ring_ready) { io_uring_queue_exit(&impl_->ring); }
+}
+
+bool UringEngine::init(unsigned entries, uint32_t num_bufs, uint32_t buf_size) {
+  int ret = io_uring_queue_init(entries, &impl_->ring, 0);
+  if (ret < 0) {
+    HOLOSCAN_LOG_ERROR("Failed to create io_uring: {}", -ret);
+    return false;
+  }
+  impl_->ring_ready = true;
+
+  if (num_bufs == 0) { return true; }
+
+  // The buffer ring size must be a power of 2
+  uint32_t ring_size = 1;
+  while (ring_size < num_bufs) { ring_size <<= 1; }
+  impl_->num_bufs = ring_size;
+  impl_->buf_size = buf_size;
+  impl_->bufs.resize(static_cast<size_t>(ring_size) * buf_size);
+
+  impl_->buf_ring = io_uring_setup_buf_ring(&impl_->ring, ring_size, RECV_BUF_GROUP, 0, &ret);
+  if (impl_->buf_ring == nullptr) {
+    HOLOSCAN_LOG_ERROR("Failed to register io_uring receive buffers: {}", -ret);
+    return false;
+  }
+  for (uint32_t bid = 0; bid < ring_size; bid++) {
+    io_uring_buf_ring_add(impl_->buf_ring,
+                          impl_->bufs.data() + static_cast<size_t>(bid) * buf_size,
+                          buf_size,
+                          bid,
+                          io_uring_buf_ring_mask(ring_size),
+                          bid);
+  }
+  io_uring_buf_ring_advance(impl_->buf_ring, ring_size);
+  return true;
+}
+
+bool UringEngine::accept(int fd) {
+  auto sqe = impl_->get_sqe();
+  if (sqe == nullptr) { return false; }
+  io_uring_prep_accept(sqe, fd, nullptr, nullptr, 0);
+  io_uring_sqe_set_data64(sqe, encode(Op::ACCEPT, 0));
+  return true;
+}
+
+bool UringEngine::connect(int fd, const struct sockaddr_in* addr) {
+  auto sqe = impl_->get_sqe();
+  if (sqe == nullptr) { return false; }
+  io_uring_prep_connect(
+      sqe, fd, reinterpret_cast<const struct sockaddr*>(addr), sizeof(struct sockaddr_in));
+  io_uring_sqe_set_data64(sqe, encode(Op::CONNECT, 0));
+  return true;
+}
+
+bool UringEngine::recv_multishot(int fd) {
+  auto sqe = impl_->get_sqe();
+  if (sqe == nullptr) { return false; }
+  io_uring_prep_recv_multishot(sqe, fd, nullptr, 0, 0);
+  sqe->flags |= IOSQE_BUFFER_SELECT;
+  sqe->buf_group = RECV_BUF_GROUP;
+  io_uring_sqe_set_data64(sqe, encode(Op::RECV, 0));
+  return true;
+}
+
+bool UringEngine::send(int fd, const uint8_t* data, uint32_t len, uint32_t tag) {
+  auto sqe = impl_->get_sqe();
+  if (sqe == nullptr) { return false; }
+  io_uring_prep_send(sqe, fd, data, len, 0);
+  io_uring_sqe_set_data64(sqe, encode(Op::SEND, tag));
+  return true;
+}
+
+int UringEngine::submit() {
+  return io_uring_submit(&impl_->ring);
+}
+
+size_t UringEngine::reap(const std::function<void(const Completion&)>& fn) {
+  struct io_uring_cqe* cqe;
+  unsigned head;
+  size_t count = 0;
+
+  io_uring_for_each_cqe(&impl_->ring, head, cqe) {
+    const uint64_t data = io_uring_cqe_get_data64(cqe);
+    Completion c;
+    c.op = static_cast<Op>(data >> 32);
+    c.res = cqe->res;
+    c.tag = static_cast<uint32_t>(data);
+    c.data = nullptr;
+    c.more = (cqe->flags & IORING_CQE_F_MORE) != 0;
+
+    const bool has_buf = (cqe->flags & IORING_CQE_F_BUFFER) != 0;
+    const uint16_t bid = cqe->flags >> IORING_CQE_BUFFER_SHIFT;
+    if (has_buf) { c.data = impl_->bufs.data() + static_cast<size_t>(bid) * impl_->buf_size; }
+
+    fn(c);
+
+    if (has_buf) { impl_->recycle(bid); }
+    count++;
+  }
+  io_uring_cq_advance(&impl_->ring, count);
+  return count;
+}
+
+void UringEngine::wait() {
+  struct io_uring_cqe* cqe;
+  io_uring_submit_and_wait(&impl_->ring, 1);
+  io_uring_peek_cqe(&impl_->ring, &cqe);
+}
+
+#else  // BASIC_NETWORK_IO_URING
+
+struct UringEngine::Impl {};
+
+bool UringEngine::supported() {
+  return false;
+}
+
+UringEngine::UringEngine() = default;
+UringEngine::~UringEngine() = default;
+
+bool UringEngine::init(unsigned, uint32_t, uint32_t) {
+  HOLOSCAN_LOG_ERROR("The basic network operators were built without liburing");
+  return false;
+}
+
+bool UringEngine::accept(int) {
+  return false;
+}
+
+bool UringEngine::connect(int, const struct sockaddr_in*) {
+  return false;
+}
+
+bool UringEngine::recv_multishot(int) {
+  return false;
+}
+
+bool UringEngine::send(int, const uint8_t*, uint32_t, uint32_t) {
+  return false;
+}
+
+int UringEngine::submit() {
+  return 0;
+}
+
+size_t UringEngine::reap(const std::function<void(const Completion&)>&) {
+  return 0;
+}
+
+void UringEngine::wait() {}
+
+#endif  // BASIC_NETWORK_IO_URING
+
+};  // namespace holoscan::ops
@@ -0,0 +1,95 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2023 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <netinet/in.h>
+#include <cstdint>
+#include <functional>
+#include <memory>
+
+namespace holoscan::ops {
+
+/**
+ * @brief io_uring engine shared by the basic network operators
+ *
+ * Socket operations are queued and their completions reaped from compute() without blocking,
+ * so the scheduler thread never waits in the kernel. Received data lands in a ring of buffers
+ * registered with the kernel and is handed out by multishot recv, one buffer per completion.
+ * The engine is only functional when the operators are built with liburing.
+ */
+class UringEngine {
+ public:
+  enum class Op : uint8_t { ACCEPT, CONNECT, RECV, SEND };
+
+  struct Completion {
+    Op op;
+    int res;              // Result of the operation, negative errno on failure
+    uint32_t tag;         // Tag given when queuing the operation
+    const uint8_t* data;  // Received data for RECV, valid during the callback only
+    bool more;            // A multishot operation stays armed
+  };
+
+  /**
+   * @brief Whether the operators were built with io_uring support
+   */
+  static bool supported();
+
+  UringEngine();
+  ~UringEngine();
+
+  /**
+   * @brief Create the ring, and register num_bufs receive buffers of buf_size if num_bufs > 0
+   *
+   * @param entries Submission queue depth
+   * @param num_bufs Receive buffers, rounded up to a power of 2
+   * @param buf_size Size of each receive buffer
+   * @return true on success
+   */
+  bool init(unsigned entries, uint32_t num_bufs = 0, uint32_t buf_size = 0);
+
+  // Queue an operation, false if the submission queue is full
+  bool accept(int fd);
+  bool connect(int fd, const struct sockaddr_in* addr);
+  bool recv_multishot(int fd);
+  bool send(int fd, const uint8_t* data, uint32_t len, uint32_t tag);
+
+  /**
+   * @brief Submit the queued operations to the kernel
+   */
+  int submit();
+
+  /**
+   * @brief Call fn for every available completion without waiting
+   *
+   * RECV buffers are given back to the kernel after fn returns.
+   *
+   * @return Number of completions handled
+   */
+  size_t reap(const std::function<void(const Completion&)>& fn);
+
+  /**
+   * @brief Wait for one completion, used to get room in the submission queue
+   */
+  void wait();
+
+ private:
+  struct Impl;
+  std::unique_ptr<Impl> impl_;
+};
+
+};  // namespace holoscan::ops
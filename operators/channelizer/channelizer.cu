@@ -0,0 +1,224 @@
+// SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// SPDX-License-Identifier: Apache-2.0
+#include "channelizer.hpp"
+
+#include <cmath>
+#include <stdexcept>
+
+using in_t = std::tuple<tensor_t<complex, 2>, cudaStream_t>;
+using out_t = std::tuple<tensor_t<complex, 2>, cudaStream_t>;
+
+namespace holoscan::ops {
+
+namespace {
+
+#define CUFFT_TRY(stmt)                                                        \
+    {                                                                          \
+        cufftResult cufft_status = stmt;                                       \
+        if (cufft_status != CUFFT_SUCCESS) {                                   \
+            HOLOSCAN_LOG_ERROR("cuFFT call {} failed with {}", #stmt,          \
+                static_cast<int>(cufft_status));                               \
+            throw std::runtime_error("cuFFT call failed");                     \
+        }                                                                      \
+    }
+
+/**
+ * Polyphase branches of output sample n: v[n][r] = sum_p h[p M + r] x[n M - p M - r], with the
+ * input preceded by the history of the previous one. An inverse M point FFT across r then gives
+ * channel k, centered at k / M of the sample rate, for every n. One thread per (n, r), so
+ * consecutive threads read consecutive taps and samples.
+ */
+__global__ void polyphase_kernel(const complex* in, const complex* history, const float* filter,
+        complex* branches, index_t num_outputs, int num_channels, int taps_per_channel) {
+    const index_t idx = static_cast<index_t>(blockIdx.x) * blockDim.x + threadIdx.x;
+    if (idx >= num_outputs * num_channels) {
+        return;
+    }
+    const index_t n = idx / num_channels;
+    const int r = idx % num_channels;
+    const index_t history_len = static_cast<index_t>(num_channels) * taps_per_channel - 1;
+    float re = 0.0f;
+    float im = 0.0f;
+    for (int p = 0; p < taps_per_channel; p++) {
+        const int tap = p * num_channels + r;
+        // Position in the history followed by the input
+        const index_t pos = history_len + n * num_channels - tap;
+        const complex x = pos < history_len ? history[pos] : in[pos - history_len];
+        re += filter[tap] * x.real();
+        im += filter[tap] * x.imag();
+    }
+    branches[idx] = complex(re, im);
+}
+
+}  // namespace
+
+void Channelizer::setup(OperatorSpec& spec) {
+    spec.input<in_t>("in");
+    spec.output<out_t>("out");
+    spec.param(burst_size,
+        "burst_size",
+        "Burst size",
+        "Number of samples of each channel in a burst");
+    spec.param(num_bursts,
+        "num_bursts",
+        "Number of bursts",
+        "Number of bursts of each channel per input");
+    spec.param(num_channels,
+        "num_channels",
+        "Number of channels",
+        "Number of channels to split the input into, also its decimation factor");
+    spec.param(first_channel,
+        "first_channel",
+        "First channel",
+        "Channel number of channel 0 in the emitted metadata",
+        static_cast<uint16_t>(0));
+    spec.param(device,
+        "device",
+        "CUDA device",
+        "CUDA device the operator runs on",
+        0);
+    spec.param(taps_per_channel,
+        "taps_per_channel",
+        "Taps per channel",
+        "Taps of each polyphase branch, the prototype filter has num_channels times as many",
+        8);
+    spec.param(filter_taps,
+        "filter_taps",
+        "Filter taps",
+        "Prototype low-pass filter, num_channels * taps_per_channel taps. A Kaiser windowed "
+        "sinc cut off at half the channel bandwidth if empty",
+        std::vector<float>{});
+    spec.param(kaiser_beta,
+        "kaiser_beta",
+        "Kaiser beta",
+        "Beta of the Kaiser window of the default prototype filter",
+        8.0f);
+}
+
+Channelizer::~Channelizer() {
+    if (plan != 0) {
+        cufftDestroy(plan);
+    }
+}
+
+std::vector<float> Channelizer::prototype_filter() const {
+    const int num_taps = num_channels.get() * taps_per_channel.get();
+    if (!filter_taps.get().empty()) {
+        if (static_cast<int>(filter_taps.get().size()) != num_taps) {
+            HOLOSCAN_LOG_CRITICAL("filter_taps has {} taps, expected num_channels * "
+                "taps_per_channel = {}", filter_taps.get().size(), num_taps);
+            throw std::runtime_error("Invalid filter_taps");
+        }
+        return filter_taps.get();
+    }
+
+    // sinc(t / M) cuts off at fs / (2 M), the edge of each channel
+    std::vector<float> taps(num_taps);
+    const double center = (num_taps - 1) / 2.0;
+    const double beta = kaiser_beta.get();
+    double sum = 0.0;
+    for (int i = 0; i < num_taps; i++) {
+        const double t = (i - center) / num_channels.get();
+        const double sinc = t == 0.0 ? 1.0 : std::sin(M_PI * t) / (M_PI * t);
+        const double ratio = 2.0 * (i - center) / (num_taps - 1);
+        const double kaiser =
+            std::cyl_bessel_i(0.0, beta * std::sqrt(1.0 - ratio * ratio)) /
+            std::cyl_bessel_i(0.0, beta);
+        taps[i] = static_cast<float>(sinc * kaiser);
+        sum += taps[i];
+    }
+    // Unity gain in the passband, a tone keeps its amplitude in its channel
+    for (auto& tap : taps) {
+        tap = static_cast<float>(tap / sum);
+    }
+    return taps;
+}
+
+void Channelizer::initialize() {
+    holoscan::Operator::initialize();
+    cudaSetDevice(device.get());
+
+    const int m = num_channels.get();
+    const int p = taps_per_channel.get();
+    if (m < 2 || p < 1) {
+        throw std::runtime_error("Channelizer needs num_channels >= 2 and taps_per_channel >= 1");
+    }
+    samples_per_channel = static_cast<index_t>(num_bursts.get()) * burst_size.get();
+    input_samples = samples_per_channel * m;
+    const index_t history_len = static_cast<index_t>(m) * p - 1;
+    if (input_samples < history_len) {
+        throw std::runtime_error("Channelizer inputs must be at least as long as the filter");
+    }
+
+    make_tensor(outputs, {m, num_bursts.get(), burst_size.get()}, MATX_DEVICE_MEMORY);
+    make_tensor(branches, {input_samples}, MATX_DEVICE_MEMORY);
+    make_tensor(history, {history_len}, MATX_DEVICE_MEMORY);
+    cudaMemset(history.Data(), 0, history.Bytes());
+
+    const std::vector<float> taps = prototype_filter();
+    make_tensor(filter, {static_cast<index_t>(taps.size())}, MATX_DEVICE_MEMORY);
+    cudaMemcpy(filter.Data(), taps.data(), taps.size() * sizeof(float), cudaMemcpyHostToDevice);
+
+    // One M point transform per output sample, reading its branches and writing sample n of
+    // every channel, so that the output is channel after channel
+    int n = m;
+    int embed = m;
+    CUFFT_TRY(cufftPlanMany(&plan, 1, &n, &embed, 1, m, &embed,
+        static_cast<int>(samples_per_channel), 1, CUFFT_C2C,
+        static_cast<int>(samples_per_channel)));
+}
+
+Channelizer::ChannelMetadata Channelizer::channel_metadata(MetadataDictionary& meta) const {
+    const int m = num_channels.get();
+    const double sample_rate = meta.get<double>("sample_rate_hz", 0.0);
+    const double rf_ref_freq = meta.get<double>("rf_ref_freq_hz", 0.0);
+    ChannelMetadata channels(m);
+    for (int k = 0; k < m; k++) {
+        auto channel_meta = std::make_shared<MetadataDictionary>(meta);
+        channel_meta->set("channel_number", static_cast<uint16_t>(first_channel.get() + k));
+        if (sample_rate > 0.0) {
+            // Channels above M / 2 are the negative frequencies, as in an FFT
+            const int offset = k < (m + 1) / 2 ? k : k - m;
+            channel_meta->set("sample_rate_hz", sample_rate / m);
+            channel_meta->set("bandwidth_hz", sample_rate / m);
+            channel_meta->set("rf_ref_freq_hz", rf_ref_freq + offset * sample_rate / m);
+        }
+        channels[k] = channel_meta;
+    }
+    return channels;
+}
+
+void Channelizer::compute(InputContext& op_input, OutputContext& op_output, ExecutionContext&) {
+    cudaSetDevice(device.get());
+    auto input = op_input.receive<in_t>("in").value();
+    auto& in = std::get<0>(input);
+    cudaStream_t stream = std::get<1>(input);
+    if (!in.IsContiguous() || in.TotalSize() != input_samples) {
+        HOLOSCAN_LOG_CRITICAL("Channelizer inputs must be {} contiguous samples, got {}",
+            input_samples, in.TotalSize());
+        throw std::runtime_error("Unsupported input layout");
+    }
+
+    const int m = num_channels.get();
+    const unsigned threads = 256;
+    const unsigned blocks = (input_samples + threads - 1) / threads;
+    polyphase_kernel<<<blocks, threads, 0, stream>>>(in.Data(), history.Data(), filter.Data(),
+        branches.Data(), samples_per_channel, m, taps_per_channel.get());
+    // The branch sums of the next input start with the end of this one
+    cudaMemcpyAsync(history.Data(), in.Data() + input_samples - history.Size(0),
+        history.Bytes(), cudaMemcpyDeviceToDevice, stream);
+
+    CUFFT_TRY(cufftSetStream(plan, stream));
+    CUFFT_TRY(cufftExecC2C(plan, reinterpret_cast<cufftComplex*>(branches.Data()),
+        reinterpret_cast<cufftComplex*>(outputs.Data()), CUFFT_INVERSE));
+
+    auto meta = metadata();
+    auto channels = channel_metadata(*meta);
+    meta->set(kBatchedChannelsKey, num_channels.get());
+    meta->set(kChannelMetadataKey, channels);
+    op_output.emit(out_t {outputs.View({m * num_bursts.get(), burst_size.get()}), stream},
+        "out");
+}
+
+}  // namespace holoscan::ops
@@ -0,0 +1,69 @@
+// SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// SPDX-License-Identifier: Apache-2.0
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include <cufft.h>
+#include <matx.h>
+#include "holoscan/holoscan.hpp"
+
+using namespace matx;
+
+using complex = cuda::std::complex<float>;
+
+namespace holoscan::ops {
+/**
+ * @brief Critically sampled polyphase filter bank channelizer
+ *
+ * Splits a wideband stream into num_channels channels of equal bandwidth, each decimated by
+ * num_channels. The polyphase branches of the prototype filter are applied in one kernel, and a
+ * single batched cuFFT across the branches forms every channel at once, writing them channel
+ * after channel. Emits the num_channels * num_bursts bursts of burst_size samples as a batched
+ * message, the layout FFT transforms with one batched plan.
+ */
+class Channelizer : public Operator {
+ public:
+    HOLOSCAN_OPERATOR_FORWARD_ARGS(Channelizer)
+
+    Channelizer() = default;
+    ~Channelizer();
+
+    void initialize() override;
+    void setup(OperatorSpec& spec) override;
+    void compute(InputContext& input, OutputContext& output, ExecutionContext& context) override;
+
+    /// Metadata key set on batched messages, holding the number of channels in the batch.
+    static constexpr const char* kBatchedChannelsKey = "batched_channels";
+    /// Metadata key set on batched messages, holding one dictionary per channel.
+    static constexpr const char* kChannelMetadataKey = "channel_metadata";
+    using ChannelMetadata = std::vector<std::shared_ptr<MetadataDictionary>>;
+
+ private:
+    std::vector<float> prototype_filter() const;
+    ChannelMetadata channel_metadata(MetadataDictionary& meta) const;
+
+    // [channels, bursts, samples] output, filled by the transform
+    tensor_t<complex, 3> outputs;
+    // Polyphase branch outputs, num_channels per output sample
+    tensor_t<complex, 1> branches;
+    // Prototype filter, and the last taps - 1 input samples for the next input
+    tensor_t<float, 1> filter;
+    tensor_t<complex, 1> history;
+    cufftHandle plan = 0;
+    // Output samples per channel and input samples per compute()
+    index_t samples_per_channel = 0;
+    index_t input_samples = 0;
+    Parameter<int> burst_size;
+    Parameter<int> num_bursts;
+    Parameter<uint16_t> num_channels;
+    Parameter<uint16_t> first_channel;
+    Parameter<int32_t> device;
+    Parameter<int> taps_per_channel;
+    Parameter<std::vector<float>> filter_taps;
+    Parameter<float> kaiser_beta;
+};
+
+}  // namespace holoscan::ops
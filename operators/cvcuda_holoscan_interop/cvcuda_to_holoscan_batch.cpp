@@ -0,0 +1,94 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "cvcuda_to_holoscan_batch.hpp"
+
+#include <string>
+#include <vector>
+
+#include <fmt/format.h>
+#include <nvcv/Tensor.hpp>
+#include <nvcv/TensorData.hpp>
+
+#include "cvcuda_utils.hpp"
+#include "gxf_utils.hpp"
+#include "holoscan/holoscan.hpp"
+
+namespace holoscan::ops {
+
+void CvCudaToHoloscanBatch::setup(OperatorSpec& spec) {
+  spec.input<nvcv::Tensor>("input");
+  spec.output<holoscan::TensorMap>("output");
+
+  spec.param(out_tensor_names_,
+             "out_tensor_names",
+             "Output tensor names",
+             "Names of the output tensors, one per batch item.",
+             {});
+}
+
+void CvCudaToHoloscanBatch::compute(InputContext& op_input, OutputContext& op_output,
+                                    ExecutionContext& context) {
+  auto cv_in_tensor = op_input.receive<nvcv::Tensor>("input").value();
+
+  validate_cvcuda_tensor(cv_in_tensor);
+
+  auto shape = cv_in_tensor.shape();
+  if (shape.size() != 4) { throw std::runtime_error("expected 4D tensor (NHWC format)"); }
+  const int n = shape[0];
+  const int h = shape[1];
+  const int w = shape[2];
+  const int c = shape[3];
+  const auto& out_tensor_names = out_tensor_names_.get();
+  if (static_cast<int>(out_tensor_names.size()) != n) {
+    throw std::runtime_error(fmt::format(
+        "expected {} output tensor names, got {}", n, out_tensor_names.size()));
+  }
+
+  auto in_strided_data = cv_in_tensor.exportData<nvcv::TensorDataStridedCuda>();
+  if (!in_strided_data) { throw std::runtime_error("expected a strided CUDA tensor"); }
+
+  auto element_type = nvcvdatatype_to_gxfprimitivetype(cv_in_tensor.dtype());
+  int element_size = nvidia::gxf::PrimitiveTypeSize(element_type);
+
+  // note: omit singleton channel size as in CvCudaToHoloscan
+  auto out_shape = c == 1 ? nvidia::gxf::Shape{h, w} : nvidia::gxf::Shape{h, w, c};
+  auto strides = nvidia::gxf::ComputeTrivialStrides(out_shape, element_size);
+  strides[0] = in_strided_data->stride(1);
+  strides[1] = in_strided_data->stride(2);
+  if (c != 1) { strides[2] = in_strided_data->stride(3); }
+
+  // Every output tensor points into the batch and keeps the CVCUDA tensor alive
+  auto out_message = nvidia::gxf::Entity::New(context.context());
+  for (int item = 0; item < n; item++) {
+    auto gxf_tensor = out_message.value().add<nvidia::gxf::Tensor>(out_tensor_names[item].c_str());
+    gxf_tensor.value()->wrapMemory(out_shape,
+                                   element_type,
+                                   element_size,
+                                   strides,
+                                   nvidia::gxf::MemoryStorageType::kDevice,
+                                   in_strided_data->basePtr() + item * in_strided_data->stride(0),
+                                   [cv_in_tensor](void*) mutable {
+                                     cv_in_tensor.reset();  // decrement ref count
+                                     return nvidia::gxf::Success;
+                                   });
+  }
+
+  op_output.emit(out_message.value(), "output");
+}
+
+}  // namespace holoscan::ops
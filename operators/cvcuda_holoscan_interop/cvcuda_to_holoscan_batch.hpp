@@ -0,0 +1,53 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef HOLOSCAN_OPERATORS_CVCUDA_TO_HOLOSCAN_BATCH
+#define HOLOSCAN_OPERATORS_CVCUDA_TO_HOLOSCAN_BATCH
+
+#include <string>
+#include <vector>
+
+#include <holoscan/holoscan.hpp>
+
+namespace holoscan::ops {
+
+/**
+ * @brief This operator scatters an N-batched CVCUDA tensor in NHWC format back into one Holoscan
+ * tensor per batch item. The Holoscan tensors point into the CVCUDA tensor memory, which is kept
+ * alive until all of them are released. Singleton channel dimensions are dropped as in
+ * `CvCudaToHoloscan`.
+ *
+ * Input is a CVCUDA tensor as `nvcv::Tensor`, and output is a `holoscan::TensorMap` with the
+ * tensor of batch item `n` named `out_tensor_names[n]`.
+ *
+ */
+class CvCudaToHoloscanBatch : public Operator {
+ public:
+  HOLOSCAN_OPERATOR_FORWARD_ARGS(CvCudaToHoloscanBatch);
+  CvCudaToHoloscanBatch() = default;
+
+  void setup(OperatorSpec& spec) override;
+  void compute(InputContext& op_input, OutputContext& op_output,
+               ExecutionContext& context) override;
+
+ private:
+  Parameter<std::vector<std::string>> out_tensor_names_;
+};
+
+}  // namespace holoscan::ops
+
+#endif /* HOLOSCAN_OPERATORS_CVCUDA_TO_HOLOSCAN_BATCH */
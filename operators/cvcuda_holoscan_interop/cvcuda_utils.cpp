@@ -359,11 +359,13 @@ nvcv::DataType dldatatype_to_nvcvdatatype(DLDataType dtype, int num_channels) {
 }
 
 nvcv::TensorDataStridedCuda::Buffer nhwc_buffer_from_holoscan_tensor(
-    std::shared_ptr<holoscan::Tensor> tensor, std::shared_ptr<void*>& holoscan_tensor_data) {
+    std::shared_ptr<holoscan::Tensor> tensor, std::shared_ptr<void*>& holoscan_tensor_data,
+    cudaStream_t stream) {
   auto ndim = tensor->ndim();
 
   nvcv::TensorDataStridedCuda::Buffer in_buffer;
   auto in_strides = tensor->strides();
+  auto in_shape = tensor->shape();
   if (ndim == 4) {
     // assume tensor has NHWC layout
     // copy strides from in_tensor->strides()
@@ -371,13 +373,13 @@ nvcv::TensorDataStridedCuda::Buffer nhwc_buffer_from_holoscan_tensor(
   } else if (ndim == 3) {
     // assume tensor has HWC layout
     // stride for batch dimension
-    in_buffer.strides[0] = in_strides[0] * tensor->shape()[0];
+    in_buffer.strides[0] = in_strides[0] * in_shape[0];
     // remaining strides match in_tensor->strides()
     for (auto d = 0; d < ndim; d++) { in_buffer.strides[d + 1] = in_strides[d]; }
   } else if (ndim == 2) {
     // assume tensor has HW layout
     // stride for batch dimension
-    in_buffer.strides[0] = in_strides[0] * tensor->shape()[0];
+    in_buffer.strides[0] = in_strides[0] * in_shape[0];
     // remaining strides match in_tensor->strides()
     for (auto d = 0; d < ndim; d++) { in_buffer.strides[d + 1] = in_strides[d]; }
     in_buffer.strides[3] = in_buffer.strides[2];
@@ -386,15 +388,50 @@ nvcv::TensorDataStridedCuda::Buffer nhwc_buffer_from_holoscan_tensor(
         "expected a tensor with (height, width) or (height, width, channels) or "
         "(batch, height, width, channels) dimensions");
   }
-  // cudaMalloc(&in_buffer.basePtr, tensor->nbytes());
-  // We are making a copy here from the holoscan tensor data to CVCUDA tensor's buffer
-  // This is not optimal and could be avoided by just using the tensor->data() pointer directly in
-  // the CVCUDA tensor buffer's basePtr. However, this is creating issues with further processing of
-  // the CVCUDA tensor.
-  holoscan_tensor_data = get_custom_shared_ptr(tensor->nbytes());
-  // *holoscan_tensor_data = static_cast<void*>(tensor->data());
+
+  // CV-CUDA can wrap the Holoscan memory directly as long as the base pointer and all strides are
+  // multiples of the element size and the channels are packed.
+  const DLDataType dtype = tensor->dtype();
+  const int64_t element_size = (dtype.bits * dtype.lanes + 7) / 8;
+  auto* data = static_cast<NVCVByte*>(tensor->data());
+  bool wrappable = reinterpret_cast<uintptr_t>(data) % element_size == 0;
+  for (auto d = 0; d < 4; d++) {
+    wrappable = wrappable && in_buffer.strides[d] % element_size == 0;
+  }
+  if (ndim > 2) { wrappable = wrappable && in_buffer.strides[3] == element_size; }
+  if (wrappable) {
+    holoscan_tensor_data.reset();
+    in_buffer.basePtr = data;
+    return in_buffer;
+  }
+
+  // Otherwise make a packed copy on the given stream. This still requires the pixels of a row to
+  // be contiguous.
+  const int64_t batch = ndim == 4 ? in_shape[0] : 1;
+  const int64_t height = ndim == 4 ? in_shape[1] : in_shape[0];
+  const int64_t width = ndim == 4 ? in_shape[2] : in_shape[1];
+  const int64_t channels = ndim > 2 ? in_shape[ndim - 1] : 1;
+  const int64_t row_bytes = width * channels * element_size;
+  if ((ndim > 2 && in_buffer.strides[3] != element_size) ||
+      in_buffer.strides[2] != channels * element_size) {
+    throw std::runtime_error("expected the pixels of each tensor row to be contiguous");
+  }
+  holoscan_tensor_data = get_custom_shared_ptr(batch * height * row_bytes);
   in_buffer.basePtr = static_cast<NVCVByte*>(*holoscan_tensor_data);
-  cudaMemcpy(in_buffer.basePtr, tensor->data(), tensor->nbytes(), cudaMemcpyDeviceToDevice);
+  for (int64_t n = 0; n < batch; n++) {
+    cudaMemcpy2DAsync(in_buffer.basePtr + n * height * row_bytes,
+                      row_bytes,
+                      data + n * in_buffer.strides[0],
+                      in_buffer.strides[1],
+                      row_bytes,
+                      height,
+                      cudaMemcpyDeviceToDevice,
+                      stream);
+  }
+  in_buffer.strides[3] = element_size;
+  in_buffer.strides[2] = channels * element_size;
+  in_buffer.strides[1] = row_bytes;
+  in_buffer.strides[0] = height * row_bytes;
   return in_buffer;
 }
 
@@ -18,6 +18,7 @@
 #ifndef HOLOHUB_OPERATORS_CVCUDA_HOLOSCAN_INTEROP_CVCUDA_UTILS_HPP
 #define HOLOHUB_OPERATORS_CVCUDA_HOLOSCAN_INTEROP_CVCUDA_UTILS_HPP
 
+#include <cuda_runtime.h>
 #include <dlpack/dlpack.h>
 
 #include <memory>
@@ -39,8 +40,21 @@ namespace holoscan {
  */
 nvcv::DataType dldatatype_to_nvcvdatatype(DLDataType dtype, int num_channels = 0);
 
+/**
+ * @brief Describe a Holoscan tensor of up to four dimensions as an NHWC CV-CUDA strided buffer
+ *
+ * The buffer points at the Holoscan tensor memory whenever CV-CUDA can wrap it as is. Only when
+ * the base pointer or strides are not aligned to the element size is a packed copy made, with
+ * cudaMemcpy2DAsync on `stream`.
+ *
+ * @param tensor The Holoscan tensor on the device.
+ * @param holoscan_tensor_data Set to the packed copy when one is made, reset otherwise.
+ * @param stream CUDA stream for the copy.
+ * @return The NHWC buffer.
+ */
 nvcv::TensorDataStridedCuda::Buffer nhwc_buffer_from_holoscan_tensor(
-    std::shared_ptr<holoscan::Tensor> tensor, std::shared_ptr<void*>& holoscan_tensor_data);
+    std::shared_ptr<holoscan::Tensor> tensor, std::shared_ptr<void*>& holoscan_tensor_data,
+    cudaStream_t stream = 0);
 
 void validate_cvcuda_tensor(nvcv::Tensor tensor);
 
@@ -161,14 +161,19 @@ std::pair<nvidia::gxf::Entity, std::shared_ptr<void*>> create_out_message_with_t
   auto in_strided_data = reference_nhwc_tensor.exportData<nvcv::TensorDataStridedCuda>();
 
   int element_size = nvidia::gxf::PrimitiveTypeSize(element_type);
-  size_t nbytes = shape.size() * element_size;
 
   std::shared_ptr<void*> pointer;
 
   switch (storage_type) {
     case nvidia::gxf::MemoryStorageType::kDevice: {
-      pointer = get_custom_shared_ptr(nbytes, storage_type);
-      *pointer = static_cast<void*>(in_strided_data->basePtr());
+      // The memory stays owned by the CVCUDA tensor (which may itself wrap a Holoscan tensor), so
+      // the pointer keeps a reference to it instead of freeing the memory.
+      pointer = std::shared_ptr<void*>(
+          new void*(static_cast<void*>(in_strided_data->basePtr())),
+          [reference_nhwc_tensor](void** pointer) mutable {
+            delete pointer;
+            reference_nhwc_tensor.reset();
+          });
     } break;
     case nvidia::gxf::MemoryStorageType::kHost:
     case nvidia::gxf::MemoryStorageType::kSystem:
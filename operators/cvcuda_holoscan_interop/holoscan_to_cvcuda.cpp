@@ -24,8 +24,27 @@
 
 namespace holoscan::ops {
 
+namespace {
+
+// Wrap the tensor data, keeping the Holoscan tensor (or its packed copy) alive with the CVCUDA
+// tensor
+nvcv::Tensor wrap_tensor_data(const nvcv::TensorDataStridedCuda& data,
+                              std::shared_ptr<holoscan::Tensor> in_tensor,
+                              std::shared_ptr<void*> holoscan_tensor_data) {
+  return nvcv::TensorWrapData(
+      data,
+      [in_tensor = std::move(in_tensor),
+       holoscan_tensor_data = std::move(holoscan_tensor_data)](const nvcv::TensorData&) mutable {
+        in_tensor.reset();
+        holoscan_tensor_data.reset();
+      });
+}
+
+}  // namespace
+
 nvcv::Tensor HoloscanToCvCuda::to_cvcuda_NHWC_tensor(std::shared_ptr<holoscan::Tensor> in_tensor,
-                                                     std::shared_ptr<void*>& holoscan_tensor_data) {
+                                                     std::shared_ptr<void*>& holoscan_tensor_data,
+                                                     cudaStream_t stream) {
   // The output tensor will always be created in NHWC format even if no batch dimension existed
   // on the GXF tensor.
   int ndim = in_tensor->ndim();
@@ -53,7 +72,8 @@ nvcv::Tensor HoloscanToCvCuda::to_cvcuda_NHWC_tensor(std::shared_ptr<holoscan::T
   }
 
   // buffer with strides defined for NHWC format
-  auto in_buffer = holoscan::nhwc_buffer_from_holoscan_tensor(in_tensor, holoscan_tensor_data);
+  auto in_buffer =
+      holoscan::nhwc_buffer_from_holoscan_tensor(in_tensor, holoscan_tensor_data, stream);
   nvcv::TensorShape cv_tensor_shape{{batch_size, image_height, image_width, num_channels},
                                     NVCV_TENSOR_NHWC};
   nvcv::DataType cv_dtype = dldatatype_to_nvcvdatatype(in_tensor->dtype());
@@ -63,8 +83,7 @@ nvcv::Tensor HoloscanToCvCuda::to_cvcuda_NHWC_tensor(std::shared_ptr<holoscan::T
 
   // TensorWrapData allows for interoperation of external tensor representations with CVCUDA
   // Tensor.
-  nvcv::Tensor cv_in_tensor = nvcv::TensorWrapData(in_data);
-  return cv_in_tensor;
+  return wrap_tensor_data(in_data, in_tensor, holoscan_tensor_data);
 }
 
 void HoloscanToCvCuda::setup(OperatorSpec& spec) {
@@ -72,16 +91,19 @@ void HoloscanToCvCuda::setup(OperatorSpec& spec) {
   // future
   spec.input<gxf::Entity>("input");
   spec.output<nvcv::Tensor>("output");
+
+  cuda_stream_handler_.define_params(spec);
 }
 
 void HoloscanToCvCuda::compute(InputContext& op_input, OutputContext& op_output,
-                               ExecutionContext&) {
+                               ExecutionContext& context) {
   auto maybe_input_message = op_input.receive<gxf::Entity>("input");
   if (!maybe_input_message.has_value()) {
     HOLOSCAN_LOG_ERROR("Failed to receive input message gxf::Entity");
     return;
   }
-  auto holoscan_tensor = maybe_input_message.value().get<holoscan::Tensor>();
+  auto& in_message = maybe_input_message.value();
+  auto holoscan_tensor = in_message.get<holoscan::Tensor>();
   if (!holoscan_tensor) {
     HOLOSCAN_LOG_ERROR("Failed to receive holoscan::Tensor from input message gxf::Entity");
     return;
@@ -89,7 +111,36 @@ void HoloscanToCvCuda::compute(InputContext& op_input, OutputContext& op_output,
 
   validate_holoscan_tensor(holoscan_tensor);
 
-  const auto& cv_tensor = to_cvcuda_NHWC_tensor(holoscan_tensor, holoscan_tensor_data_);
+  // Buffers from a block memory pool come back at the same address, so the tensor data
+  // descriptor of a wrapped buffer is reused instead of being rebuilt every frame.
+  const DLDataType dtype = holoscan_tensor->dtype();
+  DescriptorKey key{holoscan_tensor->data(),
+                    holoscan_tensor->shape(),
+                    holoscan_tensor->strides(),
+                    dtype.code,
+                    dtype.bits,
+                    dtype.lanes};
+  auto descriptor = descriptors_.find(key);
+  if (descriptor != descriptors_.end()) {
+    holoscan_tensor_data_.reset();
+    op_output.emit(wrap_tensor_data(descriptor->second, holoscan_tensor, nullptr), "output");
+    return;
+  }
+
+  if (cuda_stream_handler_.from_message(context.context(), in_message) != GXF_SUCCESS) {
+    throw std::runtime_error("Failed to get the CUDA stream from incoming messages");
+  }
+  const cudaStream_t cuda_stream = cuda_stream_handler_.get_cuda_stream(context.context());
+
+  auto cv_tensor = to_cvcuda_NHWC_tensor(holoscan_tensor, holoscan_tensor_data_, cuda_stream);
+  if (holoscan_tensor_data_) {
+    // nvcv::Tensor carries no stream, so the packed copy has to be complete before emitting
+    cudaStreamSynchronize(cuda_stream);
+  } else {
+    if (descriptors_.size() >= kMaxCachedDescriptors) { descriptors_.clear(); }
+    descriptors_.emplace(std::move(key),
+                         *cv_tensor.exportData<nvcv::TensorDataStridedCuda>());
+  }
 
   op_output.emit(cv_tensor, "output");
 }
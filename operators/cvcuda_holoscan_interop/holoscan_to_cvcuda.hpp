@@ -18,10 +18,15 @@
 #ifndef HOLOSCAN_OPERATORS_HOLOSCAN_TO_CVCUDA
 #define HOLOSCAN_OPERATORS_HOLOSCAN_TO_CVCUDA
 
+#include <map>
 #include <memory>
+#include <tuple>
+#include <vector>
 
 #include <holoscan/holoscan.hpp>
+#include <holoscan/utils/cuda_stream_handler.hpp>
 #include <nvcv/Tensor.hpp>
+#include <nvcv/TensorData.hpp>
 
 namespace holoscan::ops {
 
@@ -32,6 +37,10 @@ namespace holoscan::ops {
  * Input is a Holoscan tensor as `holoscan::Tensor`, and output is a CVCUDA tensor as
  * `nvcv::Tensor`.
  *
+ * The CVCUDA tensor wraps the Holoscan tensor memory without a copy and keeps the Holoscan tensor
+ * alive until the CVCUDA tensor is destroyed. A packed copy, made on the operator's CUDA stream,
+ * is only needed when the tensor layout cannot be wrapped by CVCUDA.
+ *
  */
 class HoloscanToCvCuda : public Operator {
  public:
@@ -46,15 +55,26 @@ class HoloscanToCvCuda : public Operator {
    * there is no batch dimension, the output tensor will be created in NHWC format.
    *
    * @param in_tensor the input Holoscan tensor
-   * @param holoscan_tensor_data the pointer to the Holoscan tensor data. This pointer has a custom
-   * deleter so that the memory is deallocated when the pointer goes out of scope.
+   * @param holoscan_tensor_data set to the packed copy of the Holoscan tensor data if one had to
+   * be made, otherwise reset. This pointer has a custom deleter so that the memory is deallocated
+   * when the pointer goes out of scope.
+   * @param stream the CUDA stream used for the packed copy
    * @return the output CVCUDA tensor
    */
   static nvcv::Tensor to_cvcuda_NHWC_tensor(std::shared_ptr<holoscan::Tensor> in_tensor,
-                                            std::shared_ptr<void*>& holoscan_tensor_data);
+                                            std::shared_ptr<void*>& holoscan_tensor_data,
+                                            cudaStream_t stream = 0);
 
  private:
+  // Tensor data descriptors of recently wrapped buffers, keyed by data pointer, shape, strides,
+  // dtype code, bits and lanes
+  using DescriptorKey =
+      std::tuple<void*, std::vector<int64_t>, std::vector<int64_t>, uint8_t, uint8_t, uint16_t>;
+  static constexpr size_t kMaxCachedDescriptors = 16;
+
   std::shared_ptr<void*> holoscan_tensor_data_;
+  std::map<DescriptorKey, nvcv::TensorDataStridedCuda> descriptors_;
+  CudaStreamHandler cuda_stream_handler_;
 };
 
 }  // namespace holoscan::ops
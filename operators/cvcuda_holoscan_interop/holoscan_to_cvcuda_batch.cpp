@@ -0,0 +1,136 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "holoscan_to_cvcuda_batch.hpp"
+
+#include <memory>
+#include <vector>
+
+#include <nvcv/Tensor.hpp>
+#include <nvcv/TensorData.hpp>
+
+#include "cvcuda_utils.hpp"
+#include "gxf_utils.hpp"
+#include "holoscan/holoscan.hpp"
+
+namespace holoscan::ops {
+
+void HoloscanToCvCudaBatch::setup(OperatorSpec& spec) {
+  spec.param(receivers_, "receivers", "Input Receivers", "List of input receivers.", {});
+  spec.output<nvcv::Tensor>("output");
+
+  spec.param(allocator_, "allocator", "Allocator", "Allocator for the batched CVCUDA tensor.");
+
+  cuda_stream_handler_.define_params(spec);
+}
+
+void HoloscanToCvCudaBatch::compute(InputContext& op_input, OutputContext& op_output,
+                                    ExecutionContext& context) {
+  auto in_messages = op_input.receive<std::vector<gxf::Entity>>("receivers").value();
+  if (in_messages.empty()) { throw std::runtime_error("No input messages received"); }
+
+  std::vector<std::shared_ptr<holoscan::Tensor>> in_tensors;
+  for (auto& in_message : in_messages) {
+    auto in_tensor = in_message.get<holoscan::Tensor>();
+    if (!in_tensor) {
+      throw std::runtime_error("Failed to receive holoscan::Tensor from input message");
+    }
+    validate_holoscan_tensor(in_tensor);
+    if (!in_tensors.empty() && (in_tensor->shape() != in_tensors[0]->shape() ||
+                                in_tensor->dtype().code != in_tensors[0]->dtype().code ||
+                                in_tensor->dtype().bits != in_tensors[0]->dtype().bits ||
+                                in_tensor->dtype().lanes != in_tensors[0]->dtype().lanes)) {
+      throw std::runtime_error("expected all input tensors to have the same shape and data type");
+    }
+    in_tensors.push_back(in_tensor);
+  }
+
+  if (cuda_stream_handler_.from_messages(context.context(), in_messages) != GXF_SUCCESS) {
+    throw std::runtime_error("Failed to get the CUDA stream from incoming messages");
+  }
+  const cudaStream_t cuda_stream = cuda_stream_handler_.get_cuda_stream(context.context());
+
+  // Every input contributes its own batch (one image unless it is already NHWC)
+  const auto in_shape = in_tensors[0]->shape();
+  const int ndim = in_tensors[0]->ndim();
+  if (ndim < 2) {
+    throw std::runtime_error(
+        "expected tensors with (height, width) or (height, width, channels) or "
+        "(batch, height, width, channels) dimensions");
+  }
+  const int64_t in_batch_size = ndim == 4 ? in_shape[0] : 1;
+  const int64_t image_height = ndim == 4 ? in_shape[1] : in_shape[0];
+  const int64_t image_width = ndim == 4 ? in_shape[2] : in_shape[1];
+  const int64_t num_channels = ndim > 2 ? in_shape[ndim - 1] : 1;
+  const int64_t batch_size = in_batch_size * static_cast<int64_t>(in_tensors.size());
+
+  const DLDataType dtype = in_tensors[0]->dtype();
+  const int64_t element_size = (dtype.bits * dtype.lanes + 7) / 8;
+  const int64_t row_bytes = image_width * num_channels * element_size;
+  const int64_t image_bytes = image_height * row_bytes;
+
+  auto allocator =
+      nvidia::gxf::Handle<nvidia::gxf::Allocator>::Create(context.context(), allocator_->gxf_cid());
+  auto maybe_batch = allocator.value()->allocate(batch_size * image_bytes,
+                                                 nvidia::gxf::MemoryStorageType::kDevice);
+  if (!maybe_batch) { throw std::runtime_error("Failed to allocate the batched tensor"); }
+  auto* batch_data = reinterpret_cast<NVCVByte*>(maybe_batch.value());
+
+  // gather the images into the batch, holding on to any packed copies until the stream is done
+  std::vector<std::shared_ptr<void*>> holoscan_tensor_data(in_tensors.size());
+  int64_t item = 0;
+  for (size_t i = 0; i < in_tensors.size(); i++) {
+    auto in_buffer =
+        nhwc_buffer_from_holoscan_tensor(in_tensors[i], holoscan_tensor_data[i], cuda_stream);
+    if (in_buffer.strides[2] != num_channels * element_size) {
+      throw std::runtime_error("expected the pixels of each tensor row to be contiguous");
+    }
+    for (int64_t n = 0; n < in_batch_size; n++, item++) {
+      cudaMemcpy2DAsync(batch_data + item * image_bytes,
+                        row_bytes,
+                        in_buffer.basePtr + n * in_buffer.strides[0],
+                        in_buffer.strides[1],
+                        row_bytes,
+                        image_height,
+                        cudaMemcpyDeviceToDevice,
+                        cuda_stream);
+    }
+  }
+  // nvcv::Tensor carries no stream, so the batch has to be complete before emitting
+  cudaStreamSynchronize(cuda_stream);
+
+  nvcv::TensorDataStridedCuda::Buffer out_buffer;
+  out_buffer.strides[0] = image_bytes;
+  out_buffer.strides[1] = row_bytes;
+  out_buffer.strides[2] = num_channels * element_size;
+  out_buffer.strides[3] = element_size;
+  out_buffer.basePtr = batch_data;
+  nvcv::TensorShape cv_tensor_shape{{batch_size, image_height, image_width, num_channels},
+                                    NVCV_TENSOR_NHWC};
+  nvcv::TensorDataStridedCuda out_data(
+      cv_tensor_shape, dldatatype_to_nvcvdatatype(dtype), out_buffer);
+
+  // the batch memory goes back to the allocator together with the CVCUDA tensor
+  auto cv_out_tensor = nvcv::TensorWrapData(
+      out_data, [allocator = allocator.value(), batch_data](const nvcv::TensorData&) {
+        allocator->free(reinterpret_cast<nvidia::byte*>(batch_data));
+      });
+
+  op_output.emit(cv_out_tensor, "output");
+}
+
+}  // namespace holoscan::ops
@@ -0,0 +1,58 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef HOLOSCAN_OPERATORS_HOLOSCAN_TO_CVCUDA_BATCH
+#define HOLOSCAN_OPERATORS_HOLOSCAN_TO_CVCUDA_BATCH
+
+#include <vector>
+
+#include <holoscan/holoscan.hpp>
+#include <holoscan/utils/cuda_stream_handler.hpp>
+#include <nvcv/Tensor.hpp>
+
+namespace holoscan::ops {
+
+/**
+ * @brief This operator gathers one Holoscan tensor from each of its receivers into a single
+ * N-batched CVCUDA tensor in NHWC format, so that a single CVCUDA operator call processes all
+ * streams. All input tensors need the same shape and data type and must be on the device memory.
+ *
+ * Inputs are `gxf::Entity` messages with a Holoscan tensor each, connected to the `receivers`
+ * port, and output is a CVCUDA tensor as `nvcv::Tensor` with the batch in receiver order.
+ *
+ * The batch is copied on the operator's CUDA stream into memory from `allocator`, and the copies
+ * are complete when the tensor is emitted.
+ *
+ */
+class HoloscanToCvCudaBatch : public Operator {
+ public:
+  HOLOSCAN_OPERATOR_FORWARD_ARGS(HoloscanToCvCudaBatch);
+  HoloscanToCvCudaBatch() = default;
+
+  void setup(OperatorSpec& spec) override;
+  void compute(InputContext& op_input, OutputContext& op_output,
+               ExecutionContext& context) override;
+
+ private:
+  Parameter<std::vector<IOSpec*>> receivers_;
+  Parameter<std::shared_ptr<Allocator>> allocator_;
+  CudaStreamHandler cuda_stream_handler_;
+};
+
+}  // namespace holoscan::ops
+
+#endif /* HOLOSCAN_OPERATORS_HOLOSCAN_TO_CVCUDA_BATCH */
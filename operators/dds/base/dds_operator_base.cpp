@@ -32,6 +32,11 @@ void DDSOperatorBase::setup(OperatorSpec& spec) {
 }
 
 void DDSOperatorBase::initialize() {
+  if (wait_for_data_) {
+    // Schedule the operator only when an attached reader has data
+    data_available_ = fragment()->make_condition<AsynchronousCondition>(name() + "_data");
+    add_arg(data_available_);
+  }
   Operator::initialize();
 
   // Find (or create) the QoSProvider.
@@ -59,4 +64,47 @@ void DDSOperatorBase::initialize() {
   }
 }
 
+void DDSOperatorBase::start() {
+  if (!wait_for_data_) { return; }
+  data_pending_ = false;
+  data_available_->event_state(AsynchronousEventState::EVENT_WAITING);
+  stopping_ = false;
+  wait_thread_ = std::thread(&DDSOperatorBase::wait_data, this);
+}
+
+void DDSOperatorBase::stop() {
+  if (!wait_for_data_) { return; }
+  stopping_ = true;
+  data_cv_.notify_all();
+  data_available_->event_state(AsynchronousEventState::EVENT_NEVER);
+  if (wait_thread_.joinable()) { wait_thread_.join(); }
+}
+
+void DDSOperatorBase::wait_data() {
+  while (!stopping_) {
+    // The data available status stays triggered until the samples are read, so the WaitSet is
+    // only waited on again once compute() read them
+    {
+      std::unique_lock<std::mutex> lock(data_mutex_);
+      data_cv_.wait(lock, [this] { return !data_pending_ || stopping_; });
+      if (stopping_) { break; }
+    }
+    const dds::core::cond::WaitSet::ConditionSeq active_conditions =
+        waitset_.wait(dds::core::Duration::from_millisecs(100));
+    if (active_conditions.empty()) { continue; }
+    std::lock_guard<std::mutex> lock(data_mutex_);
+    data_pending_ = true;
+    if (!stopping_) { data_available_->event_state(AsynchronousEventState::EVENT_DONE); }
+  }
+}
+
+void DDSOperatorBase::data_taken() {
+  {
+    std::lock_guard<std::mutex> lock(data_mutex_);
+    data_pending_ = false;
+    if (!stopping_) { data_available_->event_state(AsynchronousEventState::EVENT_WAITING); }
+  }
+  data_cv_.notify_one();
+}
+
 }  // namespace holoscan::ops
@@ -19,11 +19,26 @@
 
 #include <holoscan/holoscan.hpp>
 #include <dds/core/ddscore.hpp>
+#include <dds/sub/ddssub.hpp>
+
+#include <atomic>
+#include <condition_variable>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
 
 namespace holoscan::ops {
 
 /**
  * @brief Base class for a DDS operator.
+ *
+ * A subscriber sets `wait_for_data_` before calling DDSOperatorBase::initialize() and attaches
+ * its readers with attach_reader() to be scheduled only when one of them has data available,
+ * instead of polling them on every tick. A thread waits on a WaitSet of the readers' status
+ * conditions and the subscriber calls data_taken() once it read the samples of a tick.
  */
 class DDSOperatorBase : public Operator {
  public:
@@ -33,12 +48,30 @@ class DDSOperatorBase : public Operator {
 
   void setup(OperatorSpec& spec) override;
   void initialize() override;
+  void start() override;
+  void stop() override;
 
  protected:
+  /// @brief Schedules the operator when `reader` has data available, with wait_for_data_ set
+  template <typename T>
+  void attach_reader(const dds::sub::DataReader<T>& reader) {
+    dds::core::cond::StatusCondition condition(reader);
+    condition.enabled_statuses(dds::core::status::StatusMask::data_available());
+    waitset_ += condition;
+  }
+
+  /// @brief Waits for new data again, to be called by compute() after reading the readers
+  void data_taken();
+
   dds::core::QosProvider qos_provider_ = dds::core::null;
   dds::domain::DomainParticipant participant_ = dds::core::null;
 
+  // Set by subscribers before initialize() to be scheduled on data of their attached readers
+  bool wait_for_data_ = false;
+
  private:
+  void wait_data();
+
   Parameter<std::string> qos_provider_param_;
   Parameter<std::string> participant_qos_param_;
   Parameter<uint32_t> domain_id_param_;
@@ -60,6 +93,15 @@ class DDSOperatorBase : public Operator {
     dds::domain::DomainParticipant participant_;
   };
 
+  dds::core::cond::WaitSet waitset_;
+  std::shared_ptr<AsynchronousCondition> data_available_;
+  // Set from the wake up of the WaitSet until data_taken(), while the status stays triggered
+  bool data_pending_ = false;
+  std::mutex data_mutex_;
+  std::condition_variable data_cv_;
+  std::atomic<bool> stopping_ = false;
+  std::thread wait_thread_;
+
   static std::map<std::string, dds::core::QosProvider> qos_providers_;
   static std::vector<DomainParticipantEntry> participants_;
 };
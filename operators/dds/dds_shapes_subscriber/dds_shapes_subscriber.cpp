@@ -17,73 +17,247 @@
 
 #include "dds_shapes_subscriber.hpp"
 
+#include <cuda_runtime.h>
+
+#include <algorithm>
+#include <utility>
+
 namespace holoscan::ops {
 
+namespace {
+
+// Floats of the geometry of a shape, per shape type
+constexpr std::array<size_t, 3> kShapeFloats{
+    4,    // square: 2 corners of a Holoviz rectangle
+    4,    // circle: 1 Holoviz oval, center and size
+    12};  // triangle: 3 Holoviz lines of 2 points
+
+const std::array<const char*, 3> kShapeNames{"square", "circle", "triangle"};
+
+const std::array<const char*, 8> kColorNames{
+    "PURPLE", "BLUE", "RED", "GREEN", "YELLOW", "CYAN", "MAGENTA", "ORANGE"};
+
+const std::array<std::vector<float>, 9> kColors{{{0.5f, 0.0f, 1.0f, 1.0f},
+                                                 {0.0f, 0.0f, 1.0f, 1.0f},
+                                                 {1.0f, 0.0f, 0.0f, 1.0f},
+                                                 {0.0f, 1.0f, 0.0f, 1.0f},
+                                                 {1.0f, 1.0f, 0.0f, 1.0f},
+                                                 {0.0f, 1.0f, 1.0f, 1.0f},
+                                                 {1.0f, 0.0f, 1.0f, 1.0f},
+                                                 {1.0f, 0.5f, 0.0f, 1.0f},
+                                                 {0.0f, 0.0f, 0.0f, 1.0f}}};
+
+}  // namespace
+
 void DDSShapesSubscriberOp::setup(OperatorSpec& spec) {
   DDSOperatorBase::setup(spec);
 
-  spec.output<std::vector<Shape>>("output");
+  spec.output<gxf::Entity>("outputs");
+  spec.output<std::vector<HolovizOp::InputSpec>>("output_specs");
 
   spec.param(reader_qos_, "reader_qos", "Reader QoS", "Data Reader QoS Profile", std::string());
+  spec.param(wait_for_data_param_, "wait_for_data", "Wait For Data",
+             "Schedule the operator only when shapes are received, instead of on every tick",
+             true);
+  spec.param(max_shapes_, "max_shapes", "Max Shapes",
+             "Maximum number of shapes output per tick", 4096u);
+  spec.param(num_buffers_, "num_buffers", "Number of Buffers",
+             "Number of pinned geometry buffers, for the outputs in flight", 4u);
+  spec.param(line_width_, "line_width", "Line Width", "Line width of the shapes", 5.0f);
 }
 
 void DDSShapesSubscriberOp::initialize() {
+  // The base class adds the data condition before its parameters are set
+  auto wait_arg = std::find_if(args().rbegin(), args().rend(), [](const auto& arg) {
+    return (arg.name() == "wait_for_data");
+  });
+  if (wait_arg != args().rend()) {
+    auto& param_wrap = spec()->params()["wait_for_data"];
+    ArgumentSetter::set_param(param_wrap, (*wait_arg));
+  }
+  if (!wait_for_data_param_.has_value()) { wait_for_data_param_.set_default_value(); }
+  wait_for_data_ = wait_for_data_param_.get();
+
   DDSOperatorBase::initialize();
 
   // Create the subscriber
   dds::sub::Subscriber subscriber(participant_);
 
-  // Create the shape topics
-  dds::topic::Topic<ShapeTypeExtended> square_topic(participant_, "Square");
-  dds::topic::Topic<ShapeTypeExtended> circle_topic(participant_, "Circle");
-  dds::topic::Topic<ShapeTypeExtended> triangle_topic(participant_, "Triangle");
-
-  // Create the readers
+  // Create the shape topics and readers
   auto qos = qos_provider_.datareader_qos(reader_qos_.get());
-  square_reader_ = dds::sub::DataReader<ShapeTypeExtended>(subscriber, square_topic, qos);
-  circle_reader_ = dds::sub::DataReader<ShapeTypeExtended>(subscriber, circle_topic, qos);
-  triangle_reader_ = dds::sub::DataReader<ShapeTypeExtended>(subscriber, triangle_topic, qos);
+  const std::array<const char*, NUM_SHAPE_TYPES> topics{"Square", "Circle", "Triangle"};
+  for (size_t type = 0; type < NUM_SHAPE_TYPES; ++type) {
+    dds::topic::Topic<ShapeTypeExtended> topic(participant_, topics[type]);
+    readers_[type] = dds::sub::DataReader<ShapeTypeExtended>(subscriber, topic, qos);
+    if (wait_for_data_) { attach_reader(readers_[type]); }
+  }
+}
+
+void DDSShapesSubscriberOp::start() {
+  if (max_shapes_.get() == 0) { throw std::runtime_error("max_shapes must not be 0"); }
+  if (num_buffers_.get() < 2) { throw std::runtime_error("num_buffers must be at least 2"); }
+  buffers_.resize(num_buffers_.get());
+  for (auto& buffer : buffers_) {
+    const size_t size = max_shapes_.get() * kShapeFloats[TRIANGLE] * sizeof(float);
+    if (cudaHostAlloc(&buffer.data, size, cudaHostAllocMapped) != cudaSuccess) {
+      throw std::runtime_error("Failed to allocate a pinned shape geometry buffer");
+    }
+  }
+  next_buffer_ = 0;
+  DDSOperatorBase::start();
+}
+
+void DDSShapesSubscriberOp::stop() {
+  DDSOperatorBase::stop();
+  for (auto& buffer : buffers_) {
+    if (*buffer.users != 0) {
+      HOLOSCAN_LOG_WARN("A shape geometry buffer is freed while still in use");
+    }
+    cudaFreeHost(buffer.data);
+  }
+  buffers_.clear();
+}
+
+dds::sub::LoanedSamples<ShapeTypeExtended> DDSShapesSubscriberOp::read_shapes(
+    dds::sub::DataReader<ShapeTypeExtended>& reader, size_t max_samples,
+    std::array<size_t, kNumColors>& counts) {
+  // The latest sample of each alive instance (with a history of depth 1), loaned from the
+  // reader cache, so that the shapes which were not updated since the last tick are still drawn
+  dds::sub::LoanedSamples<ShapeTypeExtended> samples =
+      reader.select()
+          .max_samples(static_cast<int32_t>(max_samples))
+          .state(dds::sub::status::DataState(dds::sub::status::SampleState::any(),
+                                             dds::sub::status::ViewState::any(),
+                                             dds::sub::status::InstanceState::alive()))
+          .read();
+  for (const auto& sample : samples) {
+    if (sample.info().valid()) { ++counts[color_index(sample.data().color())]; }
+  }
+  return samples;
+}
+
+void DDSShapesSubscriberOp::write_shapes(
+    const dds::sub::LoanedSamples<ShapeTypeExtended>& samples, ShapeType type,
+    std::array<size_t, kNumColors> offsets, float* data) {
+  for (const auto& sample : samples) {
+    if (!sample.info().valid()) { continue; }
+    const auto& shape = sample.data();
+    const float x = shape.x() / publisher_width_;
+    const float y = shape.y() / publisher_height_;
+    const float w = shape.shapesize() / publisher_width_;
+    const float h = shape.shapesize() / publisher_height_;
+    size_t& offset = offsets[color_index(shape.color())];
+    float* out = data + offset;
+    offset += kShapeFloats[type];
+    if (type == SQUARE) {
+      const float square[] = {x - w / 2, y - h / 2, x + w / 2, y + h / 2};
+      std::copy(std::begin(square), std::end(square), out);
+    } else if (type == CIRCLE) {
+      const float circle[] = {x, y, w, h};
+      std::copy(std::begin(circle), std::end(circle), out);
+    } else {
+      const float left[] = {x - w / 2, y + h / 2};
+      const float right[] = {x + w / 2, y + h / 2};
+      const float top[] = {x, y - h / 2};
+      for (const float* point : {left, right, right, top, top, left}) {
+        *out++ = point[0];
+        *out++ = point[1];
+      }
+    }
+  }
 }
 
 void DDSShapesSubscriberOp::compute(InputContext& op_input,
                                     OutputContext& op_output,
                                     ExecutionContext& context) {
-  std::vector<Shape> shapes;
+  // Find a buffer which is not referenced by outputs in flight anymore
+  GeometryBuffer* buffer = nullptr;
+  for (size_t i = 0; i < buffers_.size() && !buffer; ++i) {
+    const size_t index = (next_buffer_ + i) % buffers_.size();
+    if (*buffers_[index].users == 0) {
+      buffer = &buffers_[index];
+      next_buffer_ = (index + 1) % buffers_.size();
+    }
+  }
+  if (!buffer) {
+    HOLOSCAN_LOG_WARN("All the shape geometry buffers are in use, increase num_buffers");
+    if (wait_for_data_) { data_taken(); }
+    return;
+  }
 
-  // Read the shapes from the readers and add them to the output.
-  add_shapes_to_output(shapes, square_reader_, Shape::Type::SQUARE);
-  add_shapes_to_output(shapes, circle_reader_, Shape::Type::CIRCLE);
-  add_shapes_to_output(shapes, triangle_reader_, Shape::Type::TRIANGLE);
+  // Read all the readers first to lay the shapes out per type and color
+  std::array<std::array<size_t, kNumColors>, NUM_SHAPE_TYPES> counts{};
+  std::vector<dds::sub::LoanedSamples<ShapeTypeExtended>> samples;
+  size_t num_shapes = 0;
+  for (size_t type = 0; type < NUM_SHAPE_TYPES; ++type) {
+    samples.push_back(read_shapes(readers_[type], max_shapes_.get() - num_shapes, counts[type]));
+    for (size_t count : counts[type]) { num_shapes += count; }
+    if (num_shapes >= max_shapes_.get()) { break; }
+  }
+  if (wait_for_data_) { data_taken(); }
 
-  op_output.emit(shapes, "output");
-}
+  std::array<std::array<size_t, kNumColors>, NUM_SHAPE_TYPES> offsets{};
+  size_t offset = 0;
+  for (size_t type = 0; type < NUM_SHAPE_TYPES; ++type) {
+    for (size_t color = 0; color < kNumColors; ++color) {
+      offsets[type][color] = offset;
+      offset += counts[type][color] * kShapeFloats[type];
+    }
+  }
+  for (size_t type = 0; type < samples.size(); ++type) {
+    write_shapes(samples[type], static_cast<ShapeType>(type), offsets[type], buffer->data);
+  }
 
-void DDSShapesSubscriberOp::add_shapes_to_output(std::vector<Shape>& shapes,
-                                                 dds::sub::DataReader<ShapeTypeExtended>& reader,
-                                                 Shape::Type shape_type) {
-  dds::sub::LoanedSamples<ShapeTypeExtended> read_shapes = reader.take();
-  for (const auto& shape : read_shapes) {
-    if (shape.info().valid()) {
-      shapes.push_back(Shape(shape_type,
-                             shape.data().color(),
-                             shape.data().x() / publisher_width_,
-                             shape.data().y() / publisher_height_,
-                             shape.data().shapesize() / publisher_width_,
-                             shape.data().shapesize() / publisher_height_));
+  // One tensor and input spec per shape type and color, wrapping the buffer
+  auto entity = gxf::Entity::New(&context);
+  auto specs = std::vector<HolovizOp::InputSpec>();
+  for (size_t type = 0; type < NUM_SHAPE_TYPES; ++type) {
+    for (size_t color = 0; color < kNumColors; ++color) {
+      const size_t count = counts[type][color];
+      if (count == 0) { continue; }
+      const std::string name = fmt::format("{}_{}", kShapeNames[type], color);
+      // ovals are rows of 4 values, the other primitives rows of 2D points
+      const int32_t columns = type == CIRCLE ? 4 : 2;
+      const nvidia::gxf::Shape shape(
+          {static_cast<int32_t>(count * kShapeFloats[type] / columns), columns});
+      auto tensor = static_cast<nvidia::gxf::Entity&>(entity).add<nvidia::gxf::Tensor>(
+          name.c_str());
+      if (!tensor) { throw std::runtime_error("Failed to add a shape tensor"); }
+      ++*buffer->users;
+      auto users = buffer->users;
+      auto result = tensor.value()->wrapMemory(
+          shape,
+          nvidia::gxf::PrimitiveType::kFloat32,
+          sizeof(float),
+          nvidia::gxf::ComputeTrivialStrides(shape, sizeof(float)),
+          nvidia::gxf::MemoryStorageType::kHost,
+          buffer->data + offsets[type][color],
+          [users](void*) {
+            --*users;
+            return nvidia::gxf::Success;
+          });
+      if (!result) {
+        --*buffer->users;
+        throw std::runtime_error("Failed to wrap a shape geometry buffer");
+      }
+
+      auto& spec = specs.emplace_back(name,
+                                      type == SQUARE   ? HolovizOp::InputType::RECTANGLES
+                                      : type == CIRCLE ? HolovizOp::InputType::OVALS
+                                                       : HolovizOp::InputType::LINES);
+      spec.color_ = kColors[color];
+      spec.priority_ = static_cast<int32_t>(specs.size());
+      spec.line_width_ = line_width_.get();
     }
   }
+
+  op_output.emit(entity, "outputs");
+  op_output.emit(specs, "output_specs");
 }
 
-std::vector<float> DDSShapesSubscriberOp::Shape::str_to_color(const std::string& color) {
-  if (color == "PURPLE")  return std::vector<float>({0.5f, 0.0f, 1.0f, 1.0f});
-  if (color == "BLUE")    return std::vector<float>({0.0f, 0.0f, 1.0f, 1.0f});
-  if (color == "RED")     return std::vector<float>({1.0f, 0.0f, 0.0f, 1.0f});
-  if (color == "GREEN")   return std::vector<float>({0.0f, 1.0f, 0.0f, 1.0f});
-  if (color == "YELLOW")  return std::vector<float>({1.0f, 1.0f, 0.0f, 1.0f});
-  if (color == "CYAN")    return std::vector<float>({0.0f, 1.0f, 1.0f, 1.0f});
-  if (color == "MAGENTA") return std::vector<float>({1.0f, 0.0f, 1.0f, 1.0f});
-  if (color == "ORANGE")  return std::vector<float>({1.0f, 0.5f, 0.0f, 1.0f});
-  else                    return std::vector<float>({0.0f, 0.0f, 0.0f, 1.0f});
+size_t DDSShapesSubscriberOp::color_index(const std::string& color) {
+  const auto it = std::find(kColorNames.begin(), kColorNames.end(), color);
+  return it - kColorNames.begin();
 }
 
 }  // namespace holoscan::ops
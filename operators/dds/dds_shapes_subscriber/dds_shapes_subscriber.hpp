@@ -19,15 +19,26 @@
 
 #include <dds/sub/ddssub.hpp>
 
+#include <array>
+#include <atomic>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <holoscan/operators/holoviz/holoviz.hpp>
+
 #include "dds_operator_base.hpp"
 #include "ShapeType.hpp"
 
 namespace holoscan::ops {
 
 /**
- * @brief Operator class to subscribe to DDS shapes as published by the RTI Connext Shapes demo.
+ * @brief Operator class to subscribe to the shapes of the RTI Connext Shapes Demo.
  *
- * Note that this does not currently support fill types or rotation.
+ * With `wait_for_data`, the operator is scheduled only when a reader has data available. Each
+ * tick reads the latest sample of every alive instance in one loan per reader and writes the
+ * geometry of the shapes directly into a pinned, mapped buffer, one Holoviz primitive tensor per
+ * shape type and color, so the output entity and input specs are consumed by Holoviz as is.
  */
 class DDSShapesSubscriberOp : public DDSOperatorBase {
  public:
@@ -37,58 +48,60 @@ class DDSShapesSubscriberOp : public DDSOperatorBase {
 
   void setup(OperatorSpec& spec) override;
   void initialize() override;
+  void start() override;
   void compute(InputContext& op_input, OutputContext& op_output,
                ExecutionContext& context) override;
+  void stop() override;
+
+ private:
+  enum ShapeType { SQUARE, CIRCLE, TRIANGLE, NUM_SHAPE_TYPES };
+
+  // Named colors of the Shapes Demo, the last one for unknown names
+  static constexpr size_t kNumColors = 9;
+
+  // Pinned, mapped host buffer of the geometry of one tick
+  struct GeometryBuffer {
+    float* data = nullptr;
+    // Output tensors wrapping the buffer which are still alive
+    std::shared_ptr<std::atomic<int>> users = std::make_shared<std::atomic<int>>(0);
+  };
 
   /**
-   * @brief Class used by the operator's output to describe a shape.
+   * @brief Reads the latest valid samples of a reader, counts them per color in `counts`,
+   * returns them
    */
-  class Shape {
-   public:
-    enum Type {
-      SQUARE,
-      CIRCLE,
-      TRIANGLE
-    };
-
-    Shape() = default;
-    Shape(Type type, const std::string& color, float x, float y, float width, float height)
-      : type_(type), color_(str_to_color(color)), x_(x), y_(y), width_(width), height_(height) {}
-
-    Type type_;
-    std::vector<float> color_;
-    float x_;
-    float y_;
-    float width_;
-    float height_;
-
-   private:
-    /**
-     * @brief Converts a color name to its numerical values.
-     */
-    static std::vector<float> str_to_color(const std::string& color);
-  };
+  dds::sub::LoanedSamples<ShapeTypeExtended> read_shapes(
+      dds::sub::DataReader<ShapeTypeExtended>& reader, size_t max_samples,
+      std::array<size_t, kNumColors>& counts);
+
+  /**
+   * @brief Writes the geometry of the shapes of a type at the offset of their color in `data`
+   */
+  void write_shapes(const dds::sub::LoanedSamples<ShapeTypeExtended>& samples, ShapeType type,
+                    std::array<size_t, kNumColors> offsets, float* data);
+
+  /**
+   * @brief Index of a named color of the Shapes Demo.
+   */
+  static size_t color_index(const std::string& color);
 
- private:
   Parameter<std::string> reader_qos_;
+  Parameter<bool> wait_for_data_param_;
+  Parameter<uint32_t> max_shapes_;
+  Parameter<uint32_t> num_buffers_;
+  Parameter<float> line_width_;
 
   // Shape readers.
-  dds::sub::DataReader<ShapeTypeExtended> square_reader_ = dds::core::null;
-  dds::sub::DataReader<ShapeTypeExtended> circle_reader_ = dds::core::null;
-  dds::sub::DataReader<ShapeTypeExtended> triangle_reader_ = dds::core::null;
+  std::array<dds::sub::DataReader<ShapeTypeExtended>, NUM_SHAPE_TYPES> readers_{
+      dds::core::null, dds::core::null, dds::core::null};
+
+  std::vector<GeometryBuffer> buffers_;
+  size_t next_buffer_ = 0;
 
   // Constants to scale the shapes relative to what the RTI Connext
   // shapes application uses for its window size.
   const float publisher_width_ = 235.0f;
   const float publisher_height_ = 265.0f;
-
-  /**
-   * @brief Takes shape samples from a reader and generates/appends the corresponding
-   * Shape objects for the operator's output.
-   */
-  void add_shapes_to_output(std::vector<Shape>& shapes,
-                            dds::sub::DataReader<ShapeTypeExtended>& reader,
-                            Shape::Type shape_type);
 };
 
 }  // namespace holoscan::ops
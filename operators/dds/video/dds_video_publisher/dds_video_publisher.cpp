@@ -19,8 +19,37 @@
 
 #include <dds/topic/find.hpp>
 
+#include <cuda_runtime.h>
+
+#include <cstring>
+#include <string>
+
 namespace holoscan::ops {
 
+namespace {
+
+// Access units of more frames than this since the last keyframe are not kept for replay
+constexpr size_t kMaxGroupOfPictures = 300;
+
+// Whether the Annex B access unit holds an IDR (H.264) or IRAP (HEVC) picture
+bool is_keyframe(const uint8_t* data, size_t size, VideoCodec codec) {
+  for (size_t i = 0; i + 3 < size; ++i) {
+    // 00 00 01 start codes, also the tail of 00 00 00 01 ones
+    if (data[i] != 0 || data[i + 1] != 0 || data[i + 2] != 1) { continue; }
+    const uint8_t header = data[i + 3];
+    if (codec == VideoCodec::VIDEO_CODEC_H264) {
+      if ((header & 0x1f) == 5) { return true; }
+    } else {
+      const int type = (header >> 1) & 0x3f;
+      if (type >= 16 && type <= 21) { return true; }
+    }
+    i += 2;
+  }
+  return false;
+}
+
+}  // namespace
+
 void DDSVideoPublisherOp::setup(OperatorSpec& spec) {
   DDSOperatorBase::setup(spec);
 
@@ -28,6 +57,15 @@ void DDSVideoPublisherOp::setup(OperatorSpec& spec) {
 
   spec.param(writer_qos_, "writer_qos", "Writer QoS", "Data Writer QoS Profile", std::string());
   spec.param(stream_id_, "stream_id", "Stream ID", "Stream ID for the DDS Video Stream", 0u);
+  spec.param(zero_copy_, "zero_copy", "Zero Copy",
+             "Publish VideoFrameZeroCopy samples loaned from shared memory, for subscribers on "
+             "the same host", false);
+  spec.param(encoded_, "encoded", "Encoded",
+             "Publish the access units of an encoded bitstream tensor as EncodedVideoFrame "
+             "samples, answering the keyframe requests of subscribers", false);
+  spec.param(codec_, "codec", "Codec", "Codec of the encoded bitstream, h264 or hevc",
+             std::string("h264"));
+  cuda_stream_handler_.define_params(spec);
 }
 
 void DDSVideoPublisherOp::initialize() {
@@ -36,6 +74,54 @@ void DDSVideoPublisherOp::initialize() {
   // Create the publisher
   dds::pub::Publisher publisher(participant_);
 
+  if (zero_copy_.get() && encoded_.get()) {
+    throw std::runtime_error("zero_copy and encoded are exclusive");
+  }
+
+  if (encoded_.get()) {
+    if (codec_.get() == "h264") {
+      codec_value_ = VideoCodec::VIDEO_CODEC_H264;
+    } else if (codec_.get() == "hevc") {
+      codec_value_ = VideoCodec::VIDEO_CODEC_HEVC;
+    } else {
+      throw std::runtime_error("Unsupported codec '" + codec_.get() + "', use h264 or hevc");
+    }
+
+    // Create the EncodedVideoFrame topic and writer
+    auto topic = dds::topic::find<dds::topic::Topic<EncodedVideoFrame>>(
+        participant_, ENCODED_VIDEO_FRAME_TOPIC);
+    if (topic == dds::core::null) {
+      topic = dds::topic::Topic<EncodedVideoFrame>(participant_, ENCODED_VIDEO_FRAME_TOPIC);
+    }
+    encoded_writer_ = dds::pub::DataWriter<EncodedVideoFrame>(
+        publisher, topic, qos_provider_.datawriter_qos(writer_qos_.get()));
+
+    // Read the keyframe requests of the subscribers of this stream
+    auto request_topic = dds::topic::find<dds::topic::Topic<KeyframeRequest>>(
+        participant_, KEYFRAME_REQUEST_TOPIC);
+    if (request_topic == dds::core::null) {
+      request_topic = dds::topic::Topic<KeyframeRequest>(participant_, KEYFRAME_REQUEST_TOPIC);
+    }
+    const dds::topic::Filter filter("stream_id = %0", {std::to_string(stream_id_.get())});
+    dds::topic::ContentFilteredTopic<KeyframeRequest> filtered_topic(request_topic,
+        "FilteredKeyframeRequest" + std::to_string(stream_id_.get()), filter);
+    keyframe_request_reader_ = dds::sub::DataReader<KeyframeRequest>(
+        dds::sub::Subscriber(participant_), filtered_topic);
+    return;
+  }
+
+  if (zero_copy_.get()) {
+    // Create the VideoFrameZeroCopy topic and writer
+    auto topic = dds::topic::find<dds::topic::Topic<VideoFrameZeroCopy>>(
+        participant_, VIDEO_FRAME_ZERO_COPY_TOPIC);
+    if (topic == dds::core::null) {
+      topic = dds::topic::Topic<VideoFrameZeroCopy>(participant_, VIDEO_FRAME_ZERO_COPY_TOPIC);
+    }
+    zero_copy_writer_ = dds::pub::DataWriter<VideoFrameZeroCopy>(
+        publisher, topic, qos_provider_.datawriter_qos(writer_qos_.get()));
+    return;
+  }
+
   // Create the VideoFrame topic
   auto topic = dds::topic::find<dds::topic::Topic<VideoFrame>>(participant_, VIDEO_FRAME_TOPIC);
   if (topic == dds::core::null) {
@@ -55,6 +141,18 @@ void DDSVideoPublisherOp::compute(InputContext& op_input,
     throw std::runtime_error("No input available");
   }
 
+  if (encoded_.get()) {
+    const auto& bitstream = static_cast<nvidia::gxf::Entity>(input).get<nvidia::gxf::Tensor>();
+    if (!bitstream) {
+      throw std::runtime_error("No bitstream tensor attached to input");
+    }
+    if (cuda_stream_handler_.from_message(context.context(), input) != GXF_SUCCESS) {
+      throw std::runtime_error("Failed to get the CUDA stream from the input");
+    }
+    write_encoded(*bitstream.value(), cuda_stream_handler_.get_cuda_stream(context.context()));
+    return;
+  }
+
   const auto& buffer = static_cast<nvidia::gxf::Entity>(input).get<nvidia::gxf::VideoBuffer>();
   if (!buffer) {
     throw std::runtime_error("No video buffer attached to input");
@@ -65,17 +163,126 @@ void DDSVideoPublisherOp::compute(InputContext& op_input,
     throw std::runtime_error("Invalid buffer format; Only RGBA is supported");
   }
 
-  // Create the VideoFrame sample from the input buffer
-  std::vector<uint8_t> data(buffer.value()->size());
+  if (cuda_stream_handler_.from_message(context.context(), input) != GXF_SUCCESS) {
+    throw std::runtime_error("Failed to get the CUDA stream from the input");
+  }
+  cudaStream_t stream = cuda_stream_handler_.get_cuda_stream(context.context());
+
+  if (zero_copy_.get()) {
+    write_zero_copy(*buffer.value(), stream);
+    return;
+  }
+
+  // Fill the VideoFrame sample from the input buffer
+  frame_.stream_id(stream_id_.get());
+  frame_.frame_num(frame_num_++);
+  frame_.width(info.width);
+  frame_.height(info.height);
+  auto& data = frame_.data();
+  data.resize(buffer.value()->size());
   if (buffer.value()->storage_type() == nvidia::gxf::MemoryStorageType::kHost) {
     memcpy(data.data(), buffer.value()->pointer(), data.size());
   } else {
-    cudaMemcpy(data.data(), buffer.value()->pointer(), data.size(), cudaMemcpyDeviceToHost);
+    cudaMemcpyAsync(data.data(), buffer.value()->pointer(), data.size(), cudaMemcpyDeviceToHost,
+                    stream);
+    cudaStreamSynchronize(stream);
   }
-  VideoFrame frame(stream_id_.get(), frame_num_++, info.width, info.height, data);
 
   // Write the VideoFrame to the writer
-  writer_.write(frame);
+  writer_.write(frame_);
+}
+
+void DDSVideoPublisherOp::write_zero_copy(const nvidia::gxf::VideoBuffer& buffer,
+                                          cudaStream_t stream) {
+  const size_t size = buffer.size();
+  if (size > VIDEO_FRAME_ZERO_COPY_DATA_MAX) {
+    throw std::runtime_error("Video buffer is too large for a VideoFrameZeroCopy sample");
+  }
+
+  // The writer owns the loaned sample again once it is written, or discarded on error
+  VideoFrameZeroCopy* sample = zero_copy_writer_.extensions().get_loan();
+  try {
+    sample->stream_id(stream_id_.get());
+    sample->frame_num(frame_num_++);
+    sample->width(buffer.video_frame_info().width);
+    sample->height(buffer.video_frame_info().height);
+    sample->size(size);
+    uint8_t* data = sample->data().data();
+    if (buffer.storage_type() == nvidia::gxf::MemoryStorageType::kHost) {
+      memcpy(data, buffer.pointer(), size);
+    } else {
+      // Samples come from a fixed pool, so each is registered once and the copy is a single
+      // DMA into shared memory. Unregistered samples still work, staged by the driver.
+      if (registered_samples_.insert(data).second &&
+          cudaHostRegister(data, VIDEO_FRAME_ZERO_COPY_DATA_MAX, cudaHostRegisterDefault) !=
+              cudaSuccess) {
+        HOLOSCAN_LOG_WARN("Failed to register a loaned VideoFrameZeroCopy sample with CUDA");
+        cudaGetLastError();
+        registered_samples_.erase(data);
+      }
+      if (cudaMemcpyAsync(data, buffer.pointer(), size, cudaMemcpyDeviceToHost, stream) !=
+              cudaSuccess ||
+          cudaStreamSynchronize(stream) != cudaSuccess) {
+        throw std::runtime_error("Failed to copy the video buffer to the loaned sample");
+      }
+    }
+  } catch (...) {
+    zero_copy_writer_.extensions().discard_loan(*sample);
+    throw;
+  }
+
+  zero_copy_writer_.write(*sample);
+}
+
+void DDSVideoPublisherOp::write_encoded(const nvidia::gxf::Tensor& bitstream,
+                                        cudaStream_t stream) {
+  EncodedVideoFrame frame;
+  frame.stream_id(stream_id_.get());
+  frame.frame_num(frame_num_++);
+  frame.codec(codec_value_);
+  auto& data = frame.data();
+  data.resize(bitstream.size());
+  if (bitstream.storage_type() == nvidia::gxf::MemoryStorageType::kDevice) {
+    if (cudaMemcpyAsync(data.data(), bitstream.pointer(), data.size(), cudaMemcpyDeviceToHost,
+                        stream) != cudaSuccess ||
+        cudaStreamSynchronize(stream) != cudaSuccess) {
+      throw std::runtime_error("Failed to copy the bitstream to the host");
+    }
+  } else {
+    memcpy(data.data(), bitstream.pointer(), data.size());
+  }
+  frame.keyframe(is_keyframe(data.data(), data.size(), codec_value_));
+
+  // Keep the access units a subscriber needs to start decoding now
+  if (frame.keyframe()) {
+    group_of_pictures_.clear();
+  } else if (group_of_pictures_.size() >= kMaxGroupOfPictures) {
+    // Too long to replay, the subscribers wait for the next keyframe
+    group_of_pictures_.clear();
+  }
+  if (frame.keyframe() || !group_of_pictures_.empty()) { group_of_pictures_.push_back(frame); }
+
+  bool requested = false;
+  for (const auto& request : keyframe_request_reader_.take()) {
+    requested = requested || request.info().valid();
+  }
+  if (requested && !group_of_pictures_.empty()) {
+    ++keyframe_requests_;
+    // Subscribers that decoded them already skip the repeated frame numbers
+    for (const auto& kept : group_of_pictures_) { encoded_writer_.write(kept); }
+    return;
+  }
+  encoded_writer_.write(frame);
+}
+
+void DDSVideoPublisherOp::stop() {
+  if (keyframe_requests_ > 0) {
+    HOLOSCAN_LOG_INFO("DDS video publisher answered {} keyframe requests", keyframe_requests_);
+  }
+  keyframe_requests_ = 0;
+  group_of_pictures_.clear();
+  for (void* sample : registered_samples_) { cudaHostUnregister(sample); }
+  registered_samples_.clear();
 }
 
 }  // namespace holoscan::ops
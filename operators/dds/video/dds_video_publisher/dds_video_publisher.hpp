@@ -18,6 +18,12 @@
 #pragma once
 
 #include <dds/pub/ddspub.hpp>
+#include <dds/sub/ddssub.hpp>
+
+#include <unordered_set>
+#include <vector>
+
+#include <holoscan/utils/cuda_stream_handler.hpp>
 
 #include "dds_operator_base.hpp"
 #include "VideoFrame.hpp"
@@ -26,6 +32,17 @@ namespace holoscan::ops {
 
 /**
  * @brief Operator class to publish a video stream to DDS.
+ *
+ * With `zero_copy`, frames are published as VideoFrameZeroCopy samples loaned from the shared
+ * memory pool of the writer. Device frames are copied with `cudaMemcpyAsync` straight into the
+ * loaned sample, which is registered as pinned memory the first time it is loaned, and
+ * subscribers on the same host read it without serialization.
+ *
+ * With `encoded`, the input is the bitstream tensor of a video encoder, e.g.
+ * VideoEncoderResponseOp, and each access unit is published as an EncodedVideoFrame. The access
+ * units since the last keyframe are kept, and written again when a subscriber sends a
+ * KeyframeRequest after joining or losing frames, so that it decodes from that keyframe on
+ * without waiting for the next one.
  */
 class DDSVideoPublisherOp : public DDSOperatorBase {
  public:
@@ -37,12 +54,33 @@ class DDSVideoPublisherOp : public DDSOperatorBase {
   void initialize() override;
   void compute(InputContext& op_input, OutputContext& op_output,
                ExecutionContext& context) override;
+  void stop() override;
 
  private:
+  void write_zero_copy(const nvidia::gxf::VideoBuffer& buffer, cudaStream_t stream);
+  void write_encoded(const nvidia::gxf::Tensor& bitstream, cudaStream_t stream);
+
   Parameter<std::string> writer_qos_;
   Parameter<uint32_t> stream_id_;
+  Parameter<bool> zero_copy_;
+  Parameter<bool> encoded_;
+  Parameter<std::string> codec_;
+  CudaStreamHandler cuda_stream_handler_;
 
   dds::pub::DataWriter<VideoFrame> writer_ = dds::core::null;
+  dds::pub::DataWriter<VideoFrameZeroCopy> zero_copy_writer_ = dds::core::null;
+  dds::pub::DataWriter<EncodedVideoFrame> encoded_writer_ = dds::core::null;
+  dds::sub::DataReader<KeyframeRequest> keyframe_request_reader_ = dds::core::null;
+
+  // Reused for every frame, so that only the serialization by the writer copies the data
+  VideoFrame frame_;
+  // Loaned samples registered with CUDA as pinned memory
+  std::unordered_set<void*> registered_samples_;
+
+  // With encoded: the access units since the last keyframe, empty until the first one
+  VideoCodec codec_value_ = VideoCodec::VIDEO_CODEC_H264;
+  std::vector<EncodedVideoFrame> group_of_pictures_;
+  uint64_t keyframe_requests_ = 0;
 
   uint32_t frame_num_ = 0;
 };
@@ -61,12 +61,18 @@ class PyDDSVideoPublisherOp : public DDSVideoPublisherOp {
                         uint32_t domain_id = 0,
                         const std::string& writer_qos = "",
                         uint32_t stream_id = 0,
+                        bool zero_copy = false,
+                        bool encoded = false,
+                        const std::string& codec = "h264",
                         const std::string& name = "dds_video_publisher")
       : DDSVideoPublisherOp(ArgList{Arg{"qos_provider", qos_provider},
                                     Arg{"participant_qos", participant_qos},
                                     Arg{"domain_id", domain_id},
                                     Arg{"writer_qos", writer_qos},
-                                    Arg{"stream_id", stream_id}}) {
+                                    Arg{"stream_id", stream_id},
+                                    Arg{"zero_copy", zero_copy},
+                                    Arg{"encoded", encoded},
+                                    Arg{"codec", codec}}) {
     add_positional_condition_and_resource_args(this, args);
     name_ = name;
     fragment_ = fragment;
@@ -106,6 +112,9 @@ PYBIND11_MODULE(_dds_video_publisher, m) {
                     uint32_t,
                     const std::string&,
                     uint32_t,
+                    bool,
+                    bool,
+                    const std::string&,
                     const std::string&>(),
            "fragment"_a,
            "qos_provider"_a = ""s,
@@ -113,6 +122,9 @@ PYBIND11_MODULE(_dds_video_publisher, m) {
            "domain_id"_a = 0,
            "writer_qos"_a = ""s,
            "stream_id"_a = 0,
+           "zero_copy"_a = false,
+           "encoded"_a = false,
+           "codec"_a = "h264"s,
            "name"_a = "dds_video_publisher"s,
            doc::DDSVideoPublisherOp::doc_DDSVideoPublisherOp)
       .def("initialize", &DDSVideoPublisherOp::initialize, doc::DDSVideoPublisherOp::doc_initialize)
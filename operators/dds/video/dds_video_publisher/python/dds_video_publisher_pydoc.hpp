@@ -43,6 +43,14 @@ writer_qos: str, optional
     QoS profile for the data writer
 stream_id : int, optional
     Stream ID of the video stream.
+zero_copy : bool, optional
+    Use the VideoFrameZeroCopy topic, transferred with zero copy over shared memory to
+    subscribers on the same host.
+encoded : bool, optional
+    Publish the access units of the encoded bitstream tensor received as input, e.g. from a
+    video encoder, to the EncodedVideoFrame topic, answering keyframe requests of subscribers.
+codec : str, optional
+    Codec of the encoded bitstream, ``"h264"`` or ``"hevc"``.
 name : str, optional
     The name of the operator.
 )doc")
@@ -19,16 +19,47 @@
 
 #include "dds/topic/find.hpp"
 
+#include <cuda_runtime.h>
+
+#include <cstring>
+#include <utility>
+#include <vector>
+
 namespace holoscan::ops {
 
+namespace {
+
+// Queued access units beyond which the decoder restarts from a keyframe
+constexpr size_t kMaxQueuedAccessUnits = 120;
+// Interval at which keyframe requests are repeated while waiting for a keyframe
+constexpr auto kKeyframeRequestInterval = std::chrono::milliseconds(500);
+
+template <typename T>
+auto latest_valid(const dds::sub::LoanedSamples<T>& samples) {
+  auto latest = samples.end();
+  for (auto it = samples.begin(); it != samples.end(); ++it) {
+    if (it->info().valid()) { latest = it; }
+  }
+  return latest;
+}
+
+}  // namespace
+
 void DDSVideoSubscriberOp::setup(OperatorSpec& spec) {
   DDSOperatorBase::setup(spec);
 
   spec.output<gxf::Entity>("output");
 
-  spec.param(allocator_, "allocator", "Allocator", "Allocator for output buffers.");
+  spec.param(allocator_, "allocator", "Allocator", "Allocator for output device buffers.");
   spec.param(reader_qos_, "reader_qos", "Reader QoS", "Data Reader QoS Profile", std::string());
   spec.param(stream_id_, "stream_id", "Stream ID for the video stream");
+  spec.param(zero_copy_, "zero_copy", "Zero Copy",
+             "Read VideoFrameZeroCopy samples in place from shared memory, as published by a "
+             "zero copy publisher on the same host", false);
+  spec.param(encoded_, "encoded", "Encoded",
+             "Read EncodedVideoFrame samples and emit their access units as host bitstream "
+             "tensors, requesting keyframes from the publisher", false);
+  cuda_stream_handler_.define_params(spec);
 }
 
 void DDSVideoSubscriberOp::initialize() {
@@ -37,23 +68,61 @@ void DDSVideoSubscriberOp::initialize() {
   // Create the subscriber
   dds::sub::Subscriber subscriber(participant_);
 
-  // Create the VideoFrame topic
-  auto topic = dds::topic::find<dds::topic::Topic<VideoFrame>>(participant_, VIDEO_FRAME_TOPIC);
-  if (topic == dds::core::null) {
-    topic = dds::topic::Topic<VideoFrame>(participant_, VIDEO_FRAME_TOPIC);
+  const dds::topic::Filter filter("stream_id = %0", {std::to_string(stream_id_.get())});
+  if (zero_copy_.get() && encoded_.get()) {
+    throw std::runtime_error("zero_copy and encoded are exclusive");
   }
+  if (encoded_.get()) {
+    // Create the EncodedVideoFrame topic, filtered for the requested stream id, and reader
+    auto topic = dds::topic::find<dds::topic::Topic<EncodedVideoFrame>>(
+        participant_, ENCODED_VIDEO_FRAME_TOPIC);
+    if (topic == dds::core::null) {
+      topic = dds::topic::Topic<EncodedVideoFrame>(participant_, ENCODED_VIDEO_FRAME_TOPIC);
+    }
+    dds::topic::ContentFilteredTopic<EncodedVideoFrame> filtered_topic(topic,
+        "FilteredEncodedVideoFrame", filter);
+    encoded_reader_ = dds::sub::DataReader<EncodedVideoFrame>(subscriber, filtered_topic,
+        qos_provider_.datareader_qos(reader_qos_.get()));
+    status_condition_ = dds::core::cond::StatusCondition(encoded_reader_);
 
-  // Create the filtered topic for the requested stream id.
-  dds::topic::ContentFilteredTopic<VideoFrame> filtered_topic(topic,
-      "FilteredVideoFrame",
-      dds::topic::Filter("stream_id = %0", {std::to_string(stream_id_.get())}));
+    // Create the writer of keyframe requests to the publisher
+    auto request_topic = dds::topic::find<dds::topic::Topic<KeyframeRequest>>(
+        participant_, KEYFRAME_REQUEST_TOPIC);
+    if (request_topic == dds::core::null) {
+      request_topic = dds::topic::Topic<KeyframeRequest>(participant_, KEYFRAME_REQUEST_TOPIC);
+    }
+    keyframe_request_writer_ = dds::pub::DataWriter<KeyframeRequest>(
+        dds::pub::Publisher(participant_), request_topic);
+  } else if (zero_copy_.get()) {
+    // Create the VideoFrameZeroCopy topic, filtered for the requested stream id, and reader
+    auto topic = dds::topic::find<dds::topic::Topic<VideoFrameZeroCopy>>(
+        participant_, VIDEO_FRAME_ZERO_COPY_TOPIC);
+    if (topic == dds::core::null) {
+      topic = dds::topic::Topic<VideoFrameZeroCopy>(participant_, VIDEO_FRAME_ZERO_COPY_TOPIC);
+    }
+    dds::topic::ContentFilteredTopic<VideoFrameZeroCopy> filtered_topic(topic,
+        "FilteredVideoFrameZeroCopy", filter);
+    zero_copy_reader_ = dds::sub::DataReader<VideoFrameZeroCopy>(subscriber, filtered_topic,
+        qos_provider_.datareader_qos(reader_qos_.get()));
+    status_condition_ = dds::core::cond::StatusCondition(zero_copy_reader_);
+  } else {
+    // Create the VideoFrame topic
+    auto topic = dds::topic::find<dds::topic::Topic<VideoFrame>>(participant_, VIDEO_FRAME_TOPIC);
+    if (topic == dds::core::null) {
+      topic = dds::topic::Topic<VideoFrame>(participant_, VIDEO_FRAME_TOPIC);
+    }
+
+    // Create the filtered topic for the requested stream id.
+    dds::topic::ContentFilteredTopic<VideoFrame> filtered_topic(topic,
+        "FilteredVideoFrame", filter);
 
-  // Create the reader for the VideoFrame
-  reader_ = dds::sub::DataReader<VideoFrame>(subscriber, filtered_topic,
-                                             qos_provider_.datareader_qos(reader_qos_.get()));
+    // Create the reader for the VideoFrame
+    reader_ = dds::sub::DataReader<VideoFrame>(subscriber, filtered_topic,
+                                               qos_provider_.datareader_qos(reader_qos_.get()));
 
-  // Obtain the reader's status condition
-  status_condition_ = dds::core::cond::StatusCondition(reader_);
+    // Obtain the reader's status condition
+    status_condition_ = dds::core::cond::StatusCondition(reader_);
+  }
 
   // Enable the 'data available' status
   status_condition_.enabled_statuses(dds::core::status::StatusMask::data_available());
@@ -62,9 +131,194 @@ void DDSVideoSubscriberOp::initialize() {
   waitset_ += status_condition_;
 }
 
+void DDSVideoSubscriberOp::start() {
+  for (auto& slot : slots_) {
+    if (cudaEventCreateWithFlags(&slot.uploaded, cudaEventDisableTiming) != cudaSuccess) {
+      throw std::runtime_error("Failed to create a CUDA event");
+    }
+  }
+  stopping_ = false;
+  waiting_for_keyframe_ = true;
+  last_keyframe_request_ = std::chrono::steady_clock::time_point();
+  receive_thread_ = std::thread(&DDSVideoSubscriberOp::receive_frames, this);
+}
+
+void DDSVideoSubscriberOp::receive_frames() {
+  while (!stopping_) {
+    // Wait for a new frame
+    dds::core::cond::WaitSet::ConditionSeq active_conditions =
+        waitset_.wait(dds::core::Duration::from_millisecs(100));
+    try {
+      take_frames(active_conditions);
+      // Requests are lost until the publisher is discovered, they are repeated meanwhile
+      if (encoded_.get() && waiting_for_keyframe_ &&
+          std::chrono::steady_clock::now() - last_keyframe_request_ > kKeyframeRequestInterval) {
+        request_keyframe();
+      }
+    } catch (const std::exception& e) {
+      HOLOSCAN_LOG_ERROR("Failed to receive DDS video frames: {}", e.what());
+    }
+  }
+}
+
+void DDSVideoSubscriberOp::take_frames(
+    const dds::core::cond::WaitSet::ConditionSeq& active_conditions) {
+  for (const auto& cond : active_conditions) {
+    if (cond != status_condition_) { continue; }
+    if (encoded_.get()) {
+      // Every access unit is needed by the decoder
+      dds::sub::LoanedSamples<EncodedVideoFrame> frames = encoded_reader_.take();
+      for (const auto& frame : frames) {
+        if (frame.info().valid()) { queue_access_unit(frame.data()); }
+      }
+      continue;
+    }
+    // Of the samples taken together, only the latest valid one would be emitted
+    if (zero_copy_.get()) {
+      dds::sub::LoanedSamples<VideoFrameZeroCopy> frames = zero_copy_reader_.take();
+      auto latest = latest_valid(frames);
+      if (latest == frames.end()) { continue; }
+      // Copy out of the shared memory sample, which stays valid only if the publisher has
+      // not reused it meanwhile
+      FrameSlot& slot = acquire_write_slot(latest->data().size());
+      memcpy(slot.data, latest->data().data().data(), slot.size);
+      if (!zero_copy_reader_.extensions().is_data_consistent(*latest)) { continue; }
+      slot.width = latest->data().width();
+      slot.height = latest->data().height();
+      publish_write_slot();
+    } else {
+      dds::sub::LoanedSamples<VideoFrame> frames = reader_.take();
+      auto latest = latest_valid(frames);
+      if (latest == frames.end()) { continue; }
+      FrameSlot& slot = acquire_write_slot(latest->data().data().size());
+      memcpy(slot.data, latest->data().data().data(), slot.size);
+      slot.width = latest->data().width();
+      slot.height = latest->data().height();
+      publish_write_slot();
+    }
+  }
+}
+
+DDSVideoSubscriberOp::FrameSlot& DDSVideoSubscriberOp::acquire_write_slot(size_t size) {
+  // Only this thread moves the write slot, so it is read without the lock
+  FrameSlot& slot = slots_[write_slot_];
+  cudaEventSynchronize(slot.uploaded);
+  if (slot.capacity < size) {
+    cudaFreeHost(slot.data);
+    slot.data = nullptr;
+    slot.capacity = 0;
+    if (cudaHostAlloc(&slot.data, size, cudaHostAllocDefault) != cudaSuccess) {
+      throw std::runtime_error("Failed to allocate a pinned DDS video frame buffer");
+    }
+    slot.capacity = size;
+  }
+  slot.size = size;
+  return slot;
+}
+
+void DDSVideoSubscriberOp::publish_write_slot() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::swap(write_slot_, ready_slot_);
+    if (fresh_) { ++dropped_frames_; }
+    fresh_ = true;
+  }
+  frame_ready_.notify_one();
+}
+
+void DDSVideoSubscriberOp::queue_access_unit(const EncodedVideoFrame& frame) {
+  const uint32_t frame_num = frame.frame_num();
+  // Access units written again for another subscriber that joined
+  if (!waiting_for_keyframe_ && frame_num <= last_frame_num_) { return; }
+  const bool continues = !waiting_for_keyframe_ && frame_num == last_frame_num_ + 1;
+  if (!continues && !frame.keyframe()) {
+    if (!waiting_for_keyframe_) {
+      HOLOSCAN_LOG_WARN("DDS video subscriber lost frames {} to {}, requesting a keyframe",
+                        last_frame_num_ + 1, frame_num - 1);
+      waiting_for_keyframe_ = true;
+      request_keyframe();
+    }
+    return;
+  }
+  waiting_for_keyframe_ = false;
+  last_frame_num_ = frame_num;
+
+  bool overflow = false;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (access_units_.size() >= kMaxQueuedAccessUnits) {
+      // The pipeline does not keep up, restart from the next keyframe
+      dropped_frames_ += access_units_.size();
+      access_units_.clear();
+      overflow = true;
+    } else {
+      access_units_.emplace_back(frame.data().begin(), frame.data().end());
+    }
+  }
+  if (overflow) {
+    waiting_for_keyframe_ = true;
+    request_keyframe();
+    return;
+  }
+  frame_ready_.notify_one();
+}
+
+void DDSVideoSubscriberOp::request_keyframe() {
+  last_keyframe_request_ = std::chrono::steady_clock::now();
+  KeyframeRequest request;
+  request.stream_id(stream_id_.get());
+  keyframe_request_writer_.write(request);
+}
+
+void DDSVideoSubscriberOp::emit_access_unit(OutputContext& op_output,
+                                            ExecutionContext& context) {
+  std::vector<uint8_t> access_unit;
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    frame_ready_.wait(lock, [this] { return !access_units_.empty() || stopping_; });
+    if (access_units_.empty()) { return; }
+    access_unit = std::move(access_units_.front());
+    access_units_.pop_front();
+  }
+
+  auto allocator = nvidia::gxf::Handle<nvidia::gxf::Allocator>::Create(
+      context.context(), allocator_->gxf_cid());
+
+  auto output = nvidia::gxf::Entity::New(context.context());
+  if (!output) {
+    throw std::runtime_error("Failed to allocate message for output");
+  }
+  auto bitstream = output.value().add<nvidia::gxf::Tensor>();
+  if (!bitstream ||
+      !bitstream.value()->reshape<uint8_t>(
+          nvidia::gxf::Shape{static_cast<int32_t>(access_unit.size())},
+          nvidia::gxf::MemoryStorageType::kHost, allocator.value())) {
+    throw std::runtime_error("Failed to allocate the bitstream tensor");
+  }
+  memcpy(bitstream.value()->pointer(), access_unit.data(), access_unit.size());
+
+  auto result = gxf::Entity(std::move(output.value()));
+  op_output.emit(result, "output");
+}
+
 void DDSVideoSubscriberOp::compute(InputContext& op_input,
                                    OutputContext& op_output,
                                    ExecutionContext& context) {
+  if (encoded_.get()) {
+    emit_access_unit(op_output, context);
+    return;
+  }
+
+  // Wait for a new frame, skipping the ones replaced before they could be emitted
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    frame_ready_.wait(lock, [this] { return fresh_ || stopping_; });
+    if (!fresh_) { return; }
+    std::swap(read_slot_, ready_slot_);
+    fresh_ = false;
+  }
+  FrameSlot& slot = slots_[read_slot_];
+
   auto allocator = nvidia::gxf::Handle<nvidia::gxf::Allocator>::Create(
       context.context(), allocator_->gxf_cid());
 
@@ -77,30 +331,29 @@ void DDSVideoSubscriberOp::compute(InputContext& op_input,
   if (!video_buffer) {
     throw std::runtime_error("Failed to allocate video buffer");
   }
+  video_buffer.value()->resize<nvidia::gxf::VideoFormat::GXF_VIDEO_FORMAT_RGBA>(
+      slot.width, slot.height, nvidia::gxf::SurfaceLayout::GXF_SURFACE_LAYOUT_PITCH_LINEAR,
+      nvidia::gxf::MemoryStorageType::kDevice, allocator.value());
+  const auto& plane = video_buffer.value()->video_frame_info().color_planes[0];
+  const size_t row_size = static_cast<size_t>(slot.width) * 4;
+  if (slot.size < row_size * slot.height) {
+    throw std::runtime_error("Received DDS video frame is smaller than its dimensions");
+  }
 
-  bool output_written = false;
-  while (!output_written) {
-    // Wait for a new frame
-    dds::core::cond::WaitSet::ConditionSeq active_conditions =
-        waitset_.wait(dds::core::Duration::from_secs(1));
-    for (const auto& cond : active_conditions) {
-      if (cond == status_condition_) {
-        // Take the available frame
-        dds::sub::LoanedSamples<VideoFrame> frames = reader_.take();
-        for (const auto& frame : frames) {
-          if (frame.info().valid()) {
-            // Copy the frame to the output buffer
-            video_buffer.value()->resize<nvidia::gxf::VideoFormat::GXF_VIDEO_FORMAT_RGBA>(
-                frame.data().width(), frame.data().height(),
-                nvidia::gxf::SurfaceLayout::GXF_SURFACE_LAYOUT_PITCH_LINEAR,
-                nvidia::gxf::MemoryStorageType::kHost, allocator.value());
-            memcpy(video_buffer.value()->pointer(), frame.data().data().data(),
-                   frame.data().data().size());
-            output_written = true;
-          }
-        }
-      }
-    }
+  // Upload the frame, releasing the slot to the receive thread once the copy is done
+  const std::vector<holoscan::gxf::Entity> no_messages;
+  if (cuda_stream_handler_.from_messages(context.context(), no_messages) != GXF_SUCCESS) {
+    throw std::runtime_error("Failed to get the CUDA stream for the upload");
+  }
+  cudaStream_t stream = cuda_stream_handler_.get_cuda_stream(context.context());
+  cudaMemcpy2DAsync(video_buffer.value()->pointer(), plane.stride, slot.data, row_size,
+                    row_size, slot.height, cudaMemcpyHostToDevice, stream);
+  cudaEventRecord(slot.uploaded, stream);
+  // The default stream isn't attached to the video buffer message, so the copy must be done
+  // before the buffer is emitted
+  if (stream == cudaStreamDefault) { cudaStreamSynchronize(stream); }
+  if (cuda_stream_handler_.to_message(output) != GXF_SUCCESS) {
+    throw std::runtime_error("Failed to add the CUDA stream to the output message");
   }
 
   // Output the buffer
@@ -108,4 +361,32 @@ void DDSVideoSubscriberOp::compute(InputContext& op_input,
   op_output.emit(result, "output");
 }
 
+void DDSVideoSubscriberOp::stop() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stopping_ = true;
+  }
+  frame_ready_.notify_all();
+  if (receive_thread_.joinable()) { receive_thread_.join(); }
+
+  for (auto& slot : slots_) {
+    if (slot.uploaded) {
+      cudaEventSynchronize(slot.uploaded);
+      cudaEventDestroy(slot.uploaded);
+      slot.uploaded = nullptr;
+    }
+    cudaFreeHost(slot.data);
+    slot = FrameSlot();
+  }
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    fresh_ = false;
+    access_units_.clear();
+    if (dropped_frames_ > 0) {
+      HOLOSCAN_LOG_INFO("DDS video subscriber skipped {} frames", dropped_frames_);
+    }
+    dropped_frames_ = 0;
+  }
+}
+
 }  // namespace holoscan::ops
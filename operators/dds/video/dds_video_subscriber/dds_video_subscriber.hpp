@@ -17,8 +17,20 @@
 
 #pragma once
 
+#include <dds/pub/ddspub.hpp>
 #include <dds/sub/ddssub.hpp>
 
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <holoscan/utils/cuda_stream_handler.hpp>
+
 #include "dds_operator_base.hpp"
 #include "VideoFrame.hpp"
 
@@ -27,6 +39,19 @@ namespace holoscan::ops {
 /**
  * @brief Operator class to subscribe to a DDS video stream.
  */
+/**
+ * @brief Operator class to subscribe to a video stream from DDS.
+ *
+ * Frames are taken by a receive thread into a ring of pinned host buffers, and each tick
+ * uploads the latest one with `cudaMemcpyAsync` into a device video buffer from `allocator`.
+ * Frames received while the pipeline is busy replace the pending one, so a burst of samples
+ * never queues up behind the display rate.
+ *
+ * With `encoded`, the EncodedVideoFrame access units are emitted in order as host bitstream
+ * tensors for a video decoder, e.g. VideoDecoderRequestOp, since each one depends on the
+ * previous ones. Until a keyframe arrives, and after a frame is lost, a KeyframeRequest is sent
+ * to the publisher and the access units are skipped.
+ */
 class DDSVideoSubscriberOp : public DDSOperatorBase {
  public:
   HOLOSCAN_OPERATOR_FORWARD_ARGS_SUPER(DDSVideoSubscriberOp, DDSOperatorBase)
@@ -35,17 +60,67 @@ class DDSVideoSubscriberOp : public DDSOperatorBase {
 
   void setup(OperatorSpec& spec) override;
   void initialize() override;
+  void start() override;
   void compute(InputContext& op_input, OutputContext& op_output,
                ExecutionContext& context) override;
+  void stop() override;
 
  private:
+  // Pinned host buffer holding one received frame
+  struct FrameSlot {
+    uint8_t* data = nullptr;
+    size_t capacity = 0;
+    size_t size = 0;
+    uint32_t width = 0;
+    uint32_t height = 0;
+    // End of the last upload out of data
+    cudaEvent_t uploaded = nullptr;
+  };
+
+  void receive_frames();
+  void take_frames(const dds::core::cond::WaitSet::ConditionSeq& active_conditions);
+  // Returns the slot to copy the next received frame to, once its last upload is done
+  FrameSlot& acquire_write_slot(size_t size);
+  // Hands the write slot over as the latest frame
+  void publish_write_slot();
+  // With encoded: queues the access unit if the decoder can decode it
+  void queue_access_unit(const EncodedVideoFrame& frame);
+  void request_keyframe();
+  void emit_access_unit(OutputContext& op_output, ExecutionContext& context);
+
   Parameter<std::shared_ptr<Allocator>> allocator_;
   Parameter<std::string> reader_qos_;
   Parameter<uint32_t> stream_id_;
+  Parameter<bool> zero_copy_;
+  Parameter<bool> encoded_;
 
   dds::sub::DataReader<VideoFrame> reader_ = dds::core::null;
+  dds::sub::DataReader<VideoFrameZeroCopy> zero_copy_reader_ = dds::core::null;
+  dds::sub::DataReader<EncodedVideoFrame> encoded_reader_ = dds::core::null;
+  dds::pub::DataWriter<KeyframeRequest> keyframe_request_writer_ = dds::core::null;
   dds::core::cond::StatusCondition status_condition_ = dds::core::null;
   dds::core::cond::WaitSet waitset_;
+  CudaStreamHandler cuda_stream_handler_;
+
+  // Triple buffering between the receive thread (write slot) and compute (read slot), the
+  // ready slot holding the latest frame not yet uploaded when fresh_ is set
+  std::array<FrameSlot, 3> slots_;
+  size_t write_slot_ = 0;
+  size_t ready_slot_ = 1;
+  size_t read_slot_ = 2;
+  bool fresh_ = false;
+  uint64_t dropped_frames_ = 0;
+  std::mutex mutex_;
+  std::condition_variable frame_ready_;
+
+  // With encoded: the access units not emitted yet, and the decoding state of the receive thread
+  std::deque<std::vector<uint8_t>> access_units_;
+  bool waiting_for_keyframe_ = true;
+  uint32_t last_frame_num_ = 0;
+  std::chrono::steady_clock::time_point last_keyframe_request_;
+
+  std::atomic<bool> stopping_ = false;
+  std::thread receive_thread_;
 };
 
 }  // namespace holoscan::ops
@@ -62,13 +62,17 @@ class PyDDSVideoSubscriberOp : public DDSVideoSubscriberOp {
                          uint32_t domain_id = 0,
                          const std::string& reader_qos = "",
                          uint32_t stream_id = 0,
+                         bool zero_copy = false,
+                         bool encoded = false,
                          const std::string& name = "dds_video_subscriber")
       : DDSVideoSubscriberOp(ArgList{Arg{"allocator", allocator},
                                      Arg{"qos_provider", qos_provider},
                                      Arg{"participant_qos", participant_qos},
                                      Arg{"domain_id", domain_id},
                                      Arg{"reader_qos", reader_qos},
-                                     Arg{"stream_id", stream_id}}) {
+                                     Arg{"stream_id", stream_id},
+                                     Arg{"zero_copy", zero_copy},
+                                     Arg{"encoded", encoded}}) {
     add_positional_condition_and_resource_args(this, args);
     name_ = name;
     fragment_ = fragment;
@@ -109,6 +113,8 @@ PYBIND11_MODULE(_dds_video_subscriber, m) {
                     uint32_t,
                     const std::string&,
                     uint32_t,
+                    bool,
+                    bool,
                     const std::string&>(),
            "fragment"_a,
            "allocator"_a,
@@ -117,6 +123,8 @@ PYBIND11_MODULE(_dds_video_subscriber, m) {
            "domain_id"_a = 0,
            "reader_qos"_a = ""s,
            "stream_id"_a = 0,
+           "zero_copy"_a = false,
+           "encoded"_a = false,
            "name"_a = "dds_video_subscriber"s,
            doc::DDSVideoSubscriberOp::doc_DDSVideoSubscriberOp)
       .def("initialize", &DDSVideoSubscriberOp::initialize,
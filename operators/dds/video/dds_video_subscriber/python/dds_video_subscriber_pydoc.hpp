@@ -45,6 +45,12 @@ reader_qos: str, optional
     QoS profile for the data reader
 stream_id : int, optional
     Stream ID of the video stream.
+zero_copy : bool, optional
+    Use the VideoFrameZeroCopy topic, transferred with zero copy over shared memory to
+    subscribers on the same host.
+encoded : bool, optional
+    Read the EncodedVideoFrame topic and emit each access unit as a host bitstream tensor for
+    a video decoder, requesting keyframes from the publisher when needed.
 name : str, optional
     The name of the operator.
 )doc")
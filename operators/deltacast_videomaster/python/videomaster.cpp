@@ -57,7 +57,7 @@ class PyVideoMasterSourceOp : public VideoMasterSourceOp {
                         uint32_t board = 0, uint32_t input = 0, uint32_t width = 1920,
                         uint32_t height = 1080, bool progressive = true,
                         uint32_t framerate = 60, std::shared_ptr<Allocator> pool = nullptr,
-                        const std::string& name = "videomaster_source")
+                        uint32_t slots = 4, const std::string& name = "videomaster_source")
       : VideoMasterSourceOp(ArgList{
             Arg{"rdma", rdma},
             Arg{"board", board},
@@ -66,7 +66,8 @@ class PyVideoMasterSourceOp : public VideoMasterSourceOp {
             Arg{"height", height},
             Arg{"progressive", progressive},
             Arg{"framerate", framerate},
-            Arg{"pool", pool}}) {
+            Arg{"pool", pool},
+            Arg{"slots", slots}}) {
     add_positional_condition_and_resource_args(this, args);
     name_ = name;
     fragment_ = fragment;
@@ -85,7 +86,9 @@ class PyVideoMasterTransmitterOp : public VideoMasterTransmitterOp {
                              uint32_t board = 0, uint32_t output = 0, uint32_t width = 1920,
                              uint32_t height = 1080, bool progressive = true,
                              uint32_t framerate = 60, std::shared_ptr<Allocator> pool = nullptr,
-                             bool enable_overlay = false,
+                             bool enable_overlay = false, uint32_t slots = 4,
+                             const std::string& video_tensor = "",
+                             const std::string& overlay_tensor = "",
                              const std::string& name = "videomaster_transmitter")
       : VideoMasterTransmitterOp(ArgList{Arg{"rdma", rdma},
                                          Arg{"board", board},
@@ -95,7 +98,10 @@ class PyVideoMasterTransmitterOp : public VideoMasterTransmitterOp {
                                          Arg{"progressive", progressive},
                                          Arg{"framerate", framerate},
                                          Arg{"pool", pool},
-                                         Arg{"enable_overlay", enable_overlay}}) {
+                                         Arg{"enable_overlay", enable_overlay},
+                                         Arg{"slots", slots},
+                                         Arg{"video_tensor", video_tensor},
+                                         Arg{"overlay_tensor", overlay_tensor}}) {
     add_positional_condition_and_resource_args(this, args);
     name_ = name;
     fragment_ = fragment;
@@ -128,6 +134,7 @@ PYBIND11_MODULE(_videomaster, m) {
                     bool,
                     uint32_t,
                     std::shared_ptr<Allocator>,
+                    uint32_t,
                     const std::string&>(),
            "fragment"_a,
            "rdma"_a = false,
@@ -138,6 +145,7 @@ PYBIND11_MODULE(_videomaster, m) {
            "progressive"_a = true,
            "framerate"_a = "60"s,
            "pool"_a,
+           "slots"_a = 4,
            "name"_a = "videomaster_source"s,
            doc::VideoMasterSourceOp::doc_VideoMasterSourceOp_python)
       .def_property_readonly("gxf_typename",
@@ -162,6 +170,9 @@ PYBIND11_MODULE(_videomaster, m) {
                     uint32_t,
                     std::shared_ptr<Allocator>,
                     bool,
+                    uint32_t,
+                    const std::string&,
+                    const std::string&,
                     const std::string&>(),
            "fragment"_a,
            "rdma"_a = false,
@@ -173,6 +184,9 @@ PYBIND11_MODULE(_videomaster, m) {
            "framerate"_a = "60"s,
            "pool"_a,
            "enable_overlay"_a = false,
+           "slots"_a = 4,
+           "video_tensor"_a = ""s,
+           "overlay_tensor"_a = ""s,
            "name"_a = "videomaster_transmitter"s,
            doc::VideoMasterTransmitterOp::doc_VideoMasterTransmitterOp)
       .def_property_readonly("gxf_typename",
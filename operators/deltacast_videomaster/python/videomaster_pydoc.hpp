@@ -53,6 +53,9 @@ PYDOC(VideoMasterSourceOp_python, R"doc(
         Frame rate of the video stream. Default value is ``60``.
     pool : Allocator of type UnboundedAllocator
         The pool to use for memory allocation.
+    slots : int, optional
+        Number of slots the board captures into. A slot is held until the frame emitted from it
+        is released. Default value is ``4``.
     name : str, optional
         The name of the operator.
     )doc")
@@ -115,6 +118,14 @@ PYDOC(VideoMasterTransmitterOp_python, R"doc(
         The pool to use for memory allocation.
     enable_overlay : bool, optional
         Boolean indicating whether a overlay processing is done by the board or not. Default value is ``False``.
+    slots : int, optional
+        Number of slots queued to the board. Default value is ``4``.
+    video_tensor : str, optional
+        Name of the RGB or RGBA device tensor or video buffer to send, resized to the output
+        format. The first one of the message if empty. Default value is ``""``.
+    overlay_tensor : str, optional
+        Name of an RGBA device tensor or video buffer of the same message, alpha blended over the
+        video on the GPU. None if empty, unused with ``enable_overlay``. Default value is ``""``.
     name : str, optional
         The name of the operator.
  )doc")
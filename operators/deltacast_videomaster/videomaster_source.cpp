@@ -41,6 +41,7 @@ void VideoMasterSourceOp::setup(OperatorSpec& spec) {
              "Progressiveness of the video frames to send.",
              true);
   spec.param(_framerate, "framerate", "Framerate", "Framerate of the signal to generate.", 60u);
+  spec.param(_nb_slots, "slots", "Slots", "Number of slots the board captures into.", 4u);
 }
 
 }  // namespace holoscan::ops
@@ -53,6 +53,7 @@ class VideoMasterSourceOp : public holoscan::ops::GXFOperator {
   Parameter<uint32_t> _height;
   Parameter<bool> _progressive;
   Parameter<uint32_t> _framerate;
+  Parameter<uint32_t> _nb_slots;
 };
 
 }  // namespace holoscan::ops
@@ -39,6 +39,7 @@ void VideoMasterTransmitterOp::setup(OperatorSpec& spec) {
              "Progressiveness of the video frames to send.",
              true);
   spec.param(_framerate, "framerate", "Framerate", "Framerate of the signal to generate.", 60u);
+  spec.param(_nb_slots, "slots", "Slots", "Number of slots queued to the board.", 4u);
   spec.param(_source, "source", "Source", "Source data.", &source);
   spec.param(_pool, "pool", "Pool", "Pool to allocate the buffers.");
   spec.param(_overlay,
@@ -46,6 +47,16 @@ void VideoMasterTransmitterOp::setup(OperatorSpec& spec) {
              "EnableOverlay",
              "Specifies whether the input buffers should be treated as overlay data.",
              false);
+  spec.param(_video_tensor,
+             "video_tensor",
+             "VideoTensor",
+             "Name of the RGB or RGBA tensor or video buffer to send, the first one if empty.",
+             std::string(""));
+  spec.param(_overlay_tensor,
+             "overlay_tensor",
+             "OverlayTensor",
+             "Name of an RGBA tensor or video buffer alpha blended over the video, none if empty.",
+             std::string(""));
 }
 
 }  // namespace holoscan::ops
@@ -52,7 +52,10 @@ class VideoMasterTransmitterOp : public holoscan::ops::GXFOperator {
   Parameter<uint32_t> _height;
   Parameter<bool> _progressive;
   Parameter<uint32_t> _framerate;
+  Parameter<uint32_t> _nb_slots;
   Parameter<bool> _overlay;
+  Parameter<std::string> _video_tensor;
+  Parameter<std::string> _overlay_tensor;
   Parameter<std::shared_ptr<Allocator>> _pool;
 };
 
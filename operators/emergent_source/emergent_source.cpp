@@ -31,6 +31,11 @@ void EmergentSourceOp::setup(OperatorSpec& spec) {
   constexpr bool kDefaultRDMA = false;
   constexpr uint32_t kDefaultExposure = 3072;
   constexpr uint32_t kDefaultGain = 4095;
+  constexpr char kDefaultDebayer[] = "none";
+  constexpr bool kDefaultGenerateAlpha = false;
+  constexpr uint32_t kDefaultBatchSize = 1;
+  constexpr uint32_t kDefaultNumCameras = 1;
+  constexpr char kDefaultSync[] = "none";
 
   spec.param(signal_, "signal", "Output", "Output channel", &signal);
   spec.param(width_, "width", "Width", "Width of the stream.", kDefaultWidth);
@@ -39,6 +44,42 @@ void EmergentSourceOp::setup(OperatorSpec& spec) {
   spec.param(use_rdma_, "rdma", "RDMA", "Enable RDMA.", kDefaultRDMA);
   spec.param(exposure_, "exposure", "Exposure", "Exposure time", kDefaultExposure);
   spec.param(gain_, "gain", "Gain", "Analog Gain", kDefaultWidth);
+  spec.param(debayer_,
+             "debayer",
+             "Debayer",
+             "Demosaic on the GPU: none, bilinear or edge_aware.",
+             std::string(kDefaultDebayer));
+  spec.param(generate_alpha_,
+             "generate_alpha",
+             "Generate Alpha",
+             "Output RGBA instead of RGB when debayering.",
+             kDefaultGenerateAlpha);
+  spec.param(batch_size_,
+             "batch_size",
+             "Batch Size",
+             "Number of frames gathered into each published tensor, 1 to publish every frame.",
+             kDefaultBatchSize);
+  spec.param(pool_, "pool", "Pool", "Allocator of the debayered and batched frames.");
+  spec.param(cuda_stream_pool_,
+             "cuda_stream_pool",
+             "CudaStreamPool",
+             "Instance of gxf::CudaStreamPool to allocate the debayer stream.");
+  spec.param(num_cameras_,
+             "num_cameras",
+             "Number of Cameras",
+             "Number of cameras captured together, one frame of each per message.",
+             kDefaultNumCameras);
+  spec.param(serials_,
+             "serials",
+             "Serials",
+             "Serial numbers of the cameras to open, in output order. The first EVT cameras if "
+             "empty.",
+             std::vector<std::string>{});
+  spec.param(sync_,
+             "sync",
+             "Sync",
+             "Camera synchronization: none, ptp or trigger.",
+             std::string(kDefaultSync));
 }
 
 void EmergentSourceOp::initialize() {
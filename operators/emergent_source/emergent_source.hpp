@@ -18,7 +18,13 @@
 #ifndef HOLOSCAN_OPERATORS_EMERGENT_SOURCE_HPP
 #define HOLOSCAN_OPERATORS_EMERGENT_SOURCE_HPP
 
+#include <memory>
+#include <string>
+#include <vector>
+
 #include "holoscan/core/gxf/gxf_operator.hpp"
+#include "holoscan/core/resources/gxf/allocator.hpp"
+#include "holoscan/core/resources/gxf/cuda_stream_pool.hpp"
 
 namespace holoscan::ops {
 
@@ -27,6 +33,11 @@ namespace holoscan::ops {
  * camera using MLNX ConnectX SmartNIC.
  *
  * This wraps a GXF Codelet(`nvidia::holoscan::EmergentSource`).
+ *
+ * By default the raw Bayer frames are emitted. `debayer` ("bilinear" or "edge_aware")
+ * demosaics them on the GPU into RGB(A) video buffers, and a `batch_size` K above 1 gathers K
+ * frames into one `[K, height, width, channels]` tensor named "frames". Both allocate from
+ * `pool`.
  */
 class EmergentSourceOp : public holoscan::ops::GXFOperator {
  public:
@@ -48,6 +59,14 @@ class EmergentSourceOp : public holoscan::ops::GXFOperator {
   Parameter<bool> use_rdma_;
   Parameter<uint32_t> exposure_;
   Parameter<uint32_t> gain_;
+  Parameter<std::string> debayer_;
+  Parameter<bool> generate_alpha_;
+  Parameter<uint32_t> batch_size_;
+  Parameter<std::shared_ptr<Allocator>> pool_;
+  Parameter<std::shared_ptr<CudaStreamPool>> cuda_stream_pool_;
+  Parameter<uint32_t> num_cameras_;
+  Parameter<std::vector<std::string>> serials_;
+  Parameter<std::string> sync_;
 };
 
 }  // namespace holoscan::ops
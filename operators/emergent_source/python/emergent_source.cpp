@@ -24,6 +24,7 @@
 #include <cstdint>
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "../../operator_util.hpp"
 #include <holoscan/core/fragment.hpp>
@@ -60,14 +61,28 @@ class PyEmergentSourceOp : public EmergentSourceOp {
                      // defaults here should match constexpr values in EmergentSourceOp::Setup
                      uint32_t width = 4200, uint32_t height = 2160, uint32_t framerate = 240,
                      bool rdma = false, uint32_t exposure = 3072, uint32_t gain = 4095,
+                     const std::string& debayer = "none"s, bool generate_alpha = false,
+                     uint32_t batch_size = 1, std::shared_ptr<Allocator> pool = nullptr,
+                     std::shared_ptr<holoscan::CudaStreamPool> cuda_stream_pool = nullptr,
+                     uint32_t num_cameras = 1,
+                     const std::vector<std::string>& serials = std::vector<std::string>{},
+                     const std::string& sync = "none"s,
          const std::string& name = "emergent_source")
       : EmergentSourceOp(ArgList{Arg{"width", width},
                                  Arg{"height", height},
                                  Arg{"framerate", framerate},
                                  Arg{"rdma", rdma},
          Arg{"exposure", exposure},
-         Arg{"gain", gain}}) {
+         Arg{"gain", gain},
+                                 Arg{"debayer", debayer},
+                                 Arg{"generate_alpha", generate_alpha},
+                                 Arg{"batch_size", batch_size},
+                                 Arg{"num_cameras", num_cameras},
+                                 Arg{"serials", serials},
+                                 Arg{"sync", sync}}) {
     add_positional_condition_and_resource_args(this, args);
+    if (pool) { this->add_arg(Arg{"pool", pool}); }
+    if (cuda_stream_pool) { this->add_arg(Arg{"cuda_stream_pool", cuda_stream_pool}); }
     name_ = name;
     fragment_ = fragment;
     spec_ = std::make_shared<OperatorSpec>(fragment);
@@ -102,6 +117,14 @@ PYBIND11_MODULE(_emergent_source, m) {
                     bool,
         uint32_t,
         uint32_t,
+                    const std::string&,
+                    bool,
+                    uint32_t,
+                    std::shared_ptr<Allocator>,
+                    std::shared_ptr<holoscan::CudaStreamPool>,
+                    uint32_t,
+                    const std::vector<std::string>&,
+                    const std::string&,
                     const std::string&>(),
            "fragment"_a,
            // defaults values here should match constexpr values in C++ EmergentSourceOp::Setup
@@ -111,6 +134,14 @@ PYBIND11_MODULE(_emergent_source, m) {
            "rdma"_a = false,
      "exposure"_a = 3072,
      "gain"_a = 4095,
+           "debayer"_a = "none"s,
+           "generate_alpha"_a = false,
+           "batch_size"_a = 1,
+           "pool"_a = py::none(),
+           "cuda_stream_pool"_a = py::none(),
+           "num_cameras"_a = 1,
+           "serials"_a = std::vector<std::string>{},
+           "sync"_a = "none"s,
            "name"_a = "emergent_source"s,
            doc::EmergentSourceOp::doc_EmergentSourceOp_python)
       .def_property_readonly(
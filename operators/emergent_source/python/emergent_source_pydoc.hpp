@@ -47,6 +47,33 @@ framerate : int, optional
     Frame rate of the video stream.
 rdma : bool, optional
     Boolean indicating whether RDMA is enabled.
+exposure : int, optional
+    Exposure time.
+gain : int, optional
+    Analog gain.
+debayer : str, optional
+    Demosaic the frames on the GPU: ``"none"`` to emit the raw Bayer frames, ``"bilinear"`` or
+    ``"edge_aware"``. Default value is ``"none"``.
+generate_alpha : bool, optional
+    Output RGBA instead of RGB when debayering. Default value is ``False``.
+batch_size : int, optional
+    Number of consecutive frames gathered into each emitted ``[batch_size, height, width,
+    channels]`` tensor named ``"frames"``, ``1`` to emit every frame. Default value is ``1``.
+pool : holoscan.resources.Allocator, optional
+    Allocator of the debayered and batched frames, required by ``debayer`` and ``batch_size``.
+cuda_stream_pool : holoscan.resources.CudaStreamPool, optional
+    Pool to allocate the CUDA stream the frames are processed on.
+num_cameras : int, optional
+    Number of cameras captured together. Above ``1``, a frame of each camera is gathered into
+    one ``[num_cameras, height, width, channels]`` tensor named ``"frames"`` per message, which
+    requires ``pool``. Default value is ``1``.
+serials : list of str, optional
+    Serial numbers of the cameras to open, in the order of the output views. Overrides
+    ``num_cameras``. Default value is ``[]``, the first EVT cameras found.
+sync : str, optional
+    Camera synchronization: ``"none"``, ``"ptp"`` to start the cameras at the same PTP time and
+    group frames by frame time, or ``"trigger"`` to capture a frame per pulse of the hardware
+    trigger input. Default value is ``"none"``.
 name : str, optional
     The name of the operator.
 )doc")
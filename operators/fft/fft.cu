@@ -3,11 +3,97 @@
 // SPDX-License-Identifier: Apache-2.0
 #include "fft.hpp"
 
-using in_t = std::tuple<tensor_t<complex, 2>, cudaStream_t>;
-using out_t = std::tuple<tensor_t<complex, 2>, cudaStream_t>;
+#include <any>
+#include <cmath>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+#include <cuda_bf16.h>
+#include <cuda_fp16.h>
+
+template <typename T>
+using stream_tensor_t = std::tuple<tensor_t<T, 2>, cudaStream_t>;
+using in_t = stream_tensor_t<complex>;
+using out_t = stream_tensor_t<complex>;
 
 namespace holoscan::ops {
 
+namespace {
+
+#define CUFFT_TRY(stmt)                                                        \
+    {                                                                          \
+        cufftResult cufft_status = stmt;                                       \
+        if (cufft_status != CUFFT_SUCCESS) {                                   \
+            HOLOSCAN_LOG_ERROR("cuFFT call {} failed with {}", #stmt,          \
+                static_cast<int>(cufft_status));                               \
+            throw std::runtime_error("cuFFT call failed");                     \
+        }                                                                      \
+    }
+
+cudaDataType precision_type(const std::string& precision) {
+    if (precision == "fp32") {
+        return CUDA_C_32F;
+    }
+    if (precision == "fp16") {
+        return CUDA_C_16F;
+    }
+    if (precision == "bf16") {
+        return CUDA_C_16BF;
+    }
+    HOLOSCAN_LOG_CRITICAL("Unknown precision {}, expected fp32, fp16 or bf16", precision);
+    throw std::runtime_error("Unknown precision");
+}
+
+// Coefficients a_k of the cosine-sum window w[n] = sum_k (-1)^k a_k cos(2 pi k n / N), in
+// its periodic form, which is the one for spectral analysis
+std::vector<double> window_coefficients(const std::string& window) {
+    if (window == "none") {
+        return {1.0};
+    }
+    if (window == "hann") {
+        return {0.5, 0.5};
+    }
+    if (window == "hamming") {
+        return {0.54, 0.46};
+    }
+    if (window == "blackman") {
+        return {0.42, 0.5, 0.08};
+    }
+    if (window == "blackman_harris") {
+        return {0.35875, 0.48829, 0.14128, 0.01168};
+    }
+    HOLOSCAN_LOG_CRITICAL("Unknown window {}, expected none, hann, hamming, blackman or "
+        "blackman_harris", window);
+    throw std::runtime_error("Unknown window");
+}
+
+__device__ inline void store_sample(complex& dst, float2 v) {
+    dst = complex(v.x, v.y);
+}
+
+__device__ inline void store_sample(complex_fp16& dst, float2 v) {
+    reinterpret_cast<__half2&>(dst) = __float22half2_rn(v);
+}
+
+__device__ inline void store_sample(complex_bf16& dst, float2 v) {
+    reinterpret_cast<__nv_bfloat162&>(dst) = __float22bfloat162_rn(v);
+}
+
+template <typename TIn, typename TOut>
+__global__ void shift_rows(const TIn* in, TOut* out, const complex* factors,
+        size_t num_samples, uint32_t row_len) {
+    const size_t idx = static_cast<size_t>(blockIdx.x) * blockDim.x + threadIdx.x;
+    if (idx >= num_samples) {
+        return;
+    }
+    const float2 x = load_sample(in[idx]);
+    const complex f = factors[idx % row_len];
+    store_sample(out[idx], make_float2(x.x * f.real() - x.y * f.imag(),
+                                       x.x * f.imag() + x.y * f.real()));
+}
+
+}  // namespace
+
 void FFT::setup(OperatorSpec& spec) {
     spec.input<in_t>("in");
     spec.output<out_t>("out");
@@ -23,6 +109,16 @@ void FFT::setup(OperatorSpec& spec) {
         "num_channels",
         "Number of channels",
         "Number of channels to allocate memory for");
+    spec.param(first_channel,
+        "first_channel",
+        "First channel",
+        "Channel number of channel 0 of this operator's buffers",
+        static_cast<uint16_t>(0));
+    spec.param(device,
+        "device",
+        "CUDA device",
+        "CUDA device the operator runs on",
+        0);
     spec.param(spectrum_type,
         "spectrum_type",
         "Spectrum type",
@@ -75,54 +171,326 @@ void FFT::setup(OperatorSpec& spec) {
         "window_time_delta",
         "Window time delta",
         "VITA 49.2 window time delta to pass along in metadata");
+    spec.param(workspace,
+        "workspace",
+        "Workspace",
+        "Optional MatxWorkspacePool holding the output buffer and FFT plans");
+    spec.param(batch_channels,
+        "batch_channels",
+        "Batch channels",
+        "Accumulate all channels and transform them with a single batched FFT",
+        false);
+    spec.param(precision,
+        "precision",
+        "Precision",
+        "Precision of the transform and its output: fp32, fp16 or bf16. Sizes that are "
+        "not a power of 2 are transformed in fp32",
+        std::string("fp32"));
+    spec.param(window,
+        "window",
+        "Window",
+        "Window applied to each burst before the transform: none, hann, hamming, blackman or "
+        "blackman_harris",
+        std::string("none"));
+}
+
+template <typename F>
+void FFT::with_outputs(F&& f) {
+    switch (transform_type) {
+        case CUDA_C_16F:
+            f(outputs_fp16);
+            break;
+        case CUDA_C_16BF:
+            f(outputs_bf16);
+            break;
+        default:
+            f(outputs);
+            break;
+    }
+}
+
+FFT::~FFT() {
+    if (!pooled() && channel_plan != 0) {
+        cufftDestroy(channel_plan);
+    }
+    if (!pooled() && batch_plan != 0) {
+        cufftDestroy(batch_plan);
+    }
+    for (auto event : channel_events) {
+        cudaEventDestroy(event);
+    }
 }
 
 void FFT::initialize() {
     holoscan::Operator::initialize();
-    make_tensor(outputs,
-                {num_channels.get(), num_bursts.get(), burst_size.get()},
-                MATX_DEVICE_MEMORY);
-}
+    cudaSetDevice(device.get());
 
-void FFT::compute(InputContext& op_input, OutputContext& op_output, ExecutionContext& context) {
-    auto input = op_input.receive<in_t>("in").value();
-    auto meta = metadata();
-    auto channel_num = meta->get<uint16_t>("channel_number", 0);
-    auto out = slice<2>(outputs, {static_cast<index_t>(channel_num), 0, 0},
-            {matxDropDim, matxEnd, matxEnd});
+    // cuFFT only has half precision transforms for power of 2 sizes
+    const int n = burst_size.get();
+    transform_type = precision_type(precision.get());
+    if (transform_type != CUDA_C_32F && (n & (n - 1)) != 0) {
+        HOLOSCAN_LOG_WARN("cuFFT has no {} transform of {} points, transforming in fp32",
+            precision.get(), n);
+        transform_type = CUDA_C_32F;
+    }
+    // |X[k]| reaches N max|x[n]|, past the fp16 range for full scale inputs, so fp16
+    // transforms are scaled by 1 / sqrt(N). bf16 has the range of fp32.
+    output_scale = transform_type == CUDA_C_16F ? 1.0f / std::sqrt(static_cast<float>(n)) : 1.0f;
 
-    (out = fftshift1D(fft(std::get<0>(input)))).run(std::get<1>(input));
+    // With a workspace the buffer and plans are only reserved here, and handed out in start()
+    if (pooled()) {
+        with_outputs([&](auto& buffer) {
+            using T = typename std::decay_t<decltype(buffer)>::value_type;
+            workspace.get()->reserve<T>(workspace_key(),
+                {num_channels.get(), num_bursts.get(), burst_size.get()});
+        });
+        workspace.get()->reserve_fft(burst_size.get(), num_bursts.get(), transform_type);
+        // Pre-batched inputs need the batch plan too, so it is created up front as well
+        if (num_channels.get() > 1) {
+            workspace.get()->reserve_fft(burst_size.get(), num_bursts.get() * num_channels.get(),
+                transform_type);
+        }
+    } else {
+        with_outputs([&](auto& buffer) {
+            make_tensor(buffer,
+                        {num_channels.get(), num_bursts.get(), burst_size.get()},
+                        MATX_DEVICE_MEMORY);
+        });
+    }
+
+    // out[k] = X[(k + s) mod N] with s = ceil(N / 2) is the FFT of x[n] * e^(-2 pi i n s / N),
+    // so the shift, the window and the output scale are applied while copying the input into
+    // the output buffer
+    const int s = (n + 1) / 2;
+    const std::vector<double> coefficients = window_coefficients(window.get());
+    const bool windowed = coefficients.size() > 1;
+    make_tensor(shift_factors, {n}, MATX_MANAGED_MEMORY);
+    if (windowed) {
+        make_tensor(window_table, {n}, MATX_MANAGED_MEMORY);
+    }
+    double window_sum = 0.0;
+    for (int i = 0; i < n; i++) {
+        double w = 0.0;
+        for (size_t k = 0; k < coefficients.size(); k++) {
+            w += (k % 2 ? -1.0 : 1.0) * coefficients[k] * std::cos(2.0 * M_PI * k * i / n);
+        }
+        window_sum += w;
+        if (windowed) {
+            window_table(i) = static_cast<float>(w);
+        }
+        const double phase = -2.0 * M_PI * ((static_cast<int64_t>(i) * s) % n) / n;
+        shift_factors(i) = complex(std::cos(phase), std::sin(phase)) *
+            static_cast<float>(w * output_scale);
+    }
+    shift_factors.PrefetchDevice(0);
+    if (windowed) {
+        window_table.PrefetchDevice(0);
+    }
+    // A tone comes out of the window scaled by its coherent gain, which the PSD operators
+    // divide back out along with the output scale
+    window_gain = static_cast<float>(window_sum / n);
+
+    // Plans are created once instead of going through the MatX plan cache on every call
+    if (!pooled()) {
+        channel_plan = make_plan(num_bursts.get());
+        if (batch_channels.get()) {
+            batch_plan = make_plan(num_bursts.get() * num_channels.get());
+        }
+    }
+    if (batch_channels.get()) {
+        channel_events.resize(num_channels.get());
+        for (auto& event : channel_events) {
+            cudaEventCreateWithFlags(&event, cudaEventDisableTiming);
+        }
+        channel_ready.assign(num_channels.get(), false);
+        channel_metadata.resize(num_channels.get());
+    }
 
     if (spectrum_type.has_value())
-        meta->set("spectrum_type", spectrum_type.get());
+        vita_metadata.set("spectrum_type", spectrum_type.get());
     if (averaging_type.has_value())
-        meta->set("averaging_type", averaging_type.get());
+        vita_metadata.set("averaging_type", averaging_type.get());
     if (window_time.has_value())
-        meta->set("window_time_delta_interpretation", window_time.get());
+        vita_metadata.set("window_time_delta_interpretation", window_time.get());
     if (window_type.has_value())
-        meta->set("window_type", window_type.get());
+        vita_metadata.set("window_type", window_type.get());
     if (transform_points.has_value())
-        meta->set("num_transform_points", transform_points.get());
+        vita_metadata.set("num_transform_points", transform_points.get());
     if (window_points.has_value())
-        meta->set("num_window_points", window_points.get());
+        vita_metadata.set("num_window_points", window_points.get());
     if (resolution.has_value())
-        meta->set("resolution", resolution.get());
+        vita_metadata.set("resolution", resolution.get());
     if (span.has_value())
-        meta->set("span", span.get());
+        vita_metadata.set("span", span.get());
     if (weighting_factor.has_value())
-        meta->set("weighting_factor", weighting_factor.get());
+        vita_metadata.set("weighting_factor", weighting_factor.get());
     if (f1_index.has_value())
-        meta->set("f1_index", f1_index.get());
+        vita_metadata.set("f1_index", f1_index.get());
     if (f2_index.has_value())
-        meta->set("f2_index", f2_index.get());
+        vita_metadata.set("f2_index", f2_index.get());
     if (window_time_delta.has_value())
-        meta->set("window_time_delta", window_time_delta.get());
+        vita_metadata.set("window_time_delta", window_time_delta.get());
+}
+
+void FFT::start() {
+    cudaSetDevice(device.get());
+    if (!pooled()) {
+        return;
+    }
+    with_outputs([&](auto& buffer) {
+        using T = typename std::decay_t<decltype(buffer)>::value_type;
+        // operator= between tensors is a lazy MatX assignment, Shallow() rebinds
+        buffer.Shallow(workspace.get()->tensor<T>(workspace_key(),
+            {num_channels.get(), num_bursts.get(), burst_size.get()}));
+    });
+    channel_plan = make_plan(num_bursts.get());
+    if (num_channels.get() > 1) {
+        batch_plan = make_plan(num_bursts.get() * num_channels.get());
+    }
+}
+
+cufftHandle FFT::make_plan(index_t batch) {
+    if (pooled()) {
+        return workspace.get()->fft_plan(burst_size.get(), batch, transform_type);
+    }
+    cufftHandle plan;
+    if (transform_type == CUDA_C_32F) {
+        CUFFT_TRY(cufftPlan1d(&plan, burst_size.get(), CUFFT_C2C, batch));
+    } else {
+        long long n = burst_size.get();
+        size_t bytes = 0;
+        CUFFT_TRY(cufftCreate(&plan));
+        CUFFT_TRY(cufftXtMakePlanMany(plan, 1, &n, nullptr, 1, n, transform_type,
+            nullptr, 1, n, transform_type, batch, &bytes, transform_type));
+    }
+    return plan;
+}
+
+template <typename TIn, typename TOut>
+void FFT::shift_into(const TIn* in, TOut* out, index_t num_rows, cudaStream_t stream) {
+    const size_t num_samples = static_cast<size_t>(num_rows) * burst_size.get();
+    const unsigned threads = 256;
+    const unsigned blocks = (num_samples + threads - 1) / threads;
+    shift_rows<<<blocks, threads, 0, stream>>>(
+        in, out, shift_factors.Data(), num_samples, burst_size.get());
+}
+
+void FFT::exec(cufftHandle plan, void* data, cudaStream_t stream) {
+    // cufftXtExec runs plans of any precision, half ones included
+    CUFFT_TRY(cufftSetStream(plan, stream));
+    CUFFT_TRY(cufftXtExec(plan, data, data, CUFFT_FORWARD));
+}
+
+template <typename TIn, typename TOut>
+void FFT::transform(const tensor_t<TIn, 2>& in, cudaStream_t stream, tensor_t<TOut, 3>& buffer,
+        OutputContext& op_output) {
+    auto meta = metadata();
+    const index_t channel_rows = num_bursts.get();
+    const index_t batch_rows = channel_rows * num_channels.get();
+    meta->set(kFftScaleKey, output_scale * window_gain);
+
+    // A pre-batched input holds the bursts of every channel, one after the other
+    if (in.IsContiguous() && in.Size(0) == batch_rows && num_channels.get() > 1) {
+        shift_into(in.Data(), buffer.Data(), batch_rows, stream);
+        if (batch_plan == 0) {
+            batch_plan = make_plan(batch_rows);
+        }
+        exec(batch_plan, buffer.Data(), stream);
+
+        meta->update(vita_metadata);
+        meta->set(kBatchedChannelsKey, num_channels.get());
+        // e.g. the per-channel metadata of a channelizer
+        if (meta->has_key(kChannelMetadataKey)) {
+            for (auto& channel_meta : meta->get<ChannelMetadata>(kChannelMetadataKey)) {
+                if (channel_meta) {
+                    channel_meta->update(vita_metadata);
+                }
+            }
+        }
+        op_output.emit(stream_tensor_t<TOut> {buffer.View({batch_rows, burst_size.get()}), stream},
+            "out");
+        return;
+    }
+
+    const int channel_num = meta->get<uint16_t>("channel_number", 0) - first_channel.get();
+    if (channel_num < 0 || channel_num >= num_channels.get()) {
+        HOLOSCAN_LOG_CRITICAL("Channel {} is outside of channels {} to {}",
+            channel_num + first_channel.get(), first_channel.get(),
+            first_channel.get() + num_channels.get() - 1);
+        throw std::runtime_error("Invalid channel_number");
+    }
+    auto out = slice<2>(buffer, {static_cast<index_t>(channel_num), 0, 0},
+            {matxDropDim, matxEnd, matxEnd});
+
+    if (!in.IsContiguous() || in.Size(0) != channel_rows) {
+        // Fall back to MatX for layouts the plans were not created for
+        if constexpr (std::is_same_v<TIn, complex> && std::is_same_v<TOut, complex>) {
+            if (window.get() == "none") {
+                (out = fftshift1D(fft(in))).run(stream);
+            } else {
+                (out = fftshift1D(fft(in * clone<2>(window_table, {in.Size(0), matxKeepDim}))))
+                    .run(stream);
+            }
+        } else {
+            HOLOSCAN_LOG_CRITICAL("Reduced precision transforms need contiguous inputs of {} "
+                "bursts", channel_rows);
+            throw std::runtime_error("Unsupported input layout");
+        }
+    } else if (batch_channels.get()) {
+        // Shift this channel into the batch now, transform once all channels are in
+        shift_into(in.Data(), out.Data(), channel_rows, stream);
+        cudaEventRecord(channel_events[channel_num], stream);
+        if (channel_ready[channel_num]) {
+            HOLOSCAN_LOG_WARN("Channel {} received twice before the batch completed, "
+                "dropping the previous burst", channel_num);
+        } else {
+            channel_ready[channel_num] = true;
+            channels_ready++;
+        }
+        channel_metadata[channel_num] = std::make_shared<MetadataDictionary>(*meta);
+        channel_metadata[channel_num]->update(vita_metadata);
+        if (channels_ready < num_channels.get()) {
+            return;
+        }
+
+        for (auto event : channel_events) {
+            cudaStreamWaitEvent(stream, event, 0);
+        }
+        exec(batch_plan, buffer.Data(), stream);
+
+        meta->update(vita_metadata);
+        meta->set(kBatchedChannelsKey, num_channels.get());
+        meta->set(kChannelMetadataKey, channel_metadata);
+        channel_ready.assign(num_channels.get(), false);
+        channels_ready = 0;
+        channel_metadata = ChannelMetadata(num_channels.get());
+        op_output.emit(stream_tensor_t<TOut> {buffer.View({batch_rows, burst_size.get()}), stream},
+            "out");
+        return;
+    } else {
+        shift_into(in.Data(), out.Data(), channel_rows, stream);
+        exec(channel_plan, out.Data(), stream);
+    }
+
+    meta->update(vita_metadata);
 
     op_output.emit(
-        out_t {
+        stream_tensor_t<TOut> {
             out,
-            std::get<1>(input)
+            stream
         },
         "out");
 }
+void FFT::compute(InputContext& op_input, OutputContext& op_output, ExecutionContext&) {
+    cudaSetDevice(device.get());
+    // Inputs of any precision are widened to fp32 by the shift, then stored in the
+    // precision of the transform
+    auto message = op_input.receive<std::any>("in").value();
+    visit_stream_tensor<complex, complex_fp16, complex_bf16>(message, [&](auto& input) {
+        with_outputs([&](auto& buffer) {
+            transform(std::get<0>(input), std::get<1>(input), buffer, op_output);
+        });
+    });
+}
+
 }  // namespace holoscan::ops
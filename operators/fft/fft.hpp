@@ -4,29 +4,87 @@
 #pragma once
 
 #include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+#include <cufft.h>
+#include <cufftXt.h>
 #include <matx.h>
 #include "holoscan/holoscan.hpp"
+#include "../matx_sample_types.hpp"
+#include "matx_workspace.hpp"
 
 using namespace matx;
 
-using complex = cuda::std::complex<float>;
-
 namespace holoscan::ops {
 class FFT : public Operator {
  public:
      HOLOSCAN_OPERATOR_FORWARD_ARGS(FFT)
 
      FFT() = default;
+     ~FFT();
 
      void initialize() override;
      void setup(OperatorSpec& spec) override;
+     void start() override;
      void compute(InputContext& input, OutputContext& output, ExecutionContext& context) override;
 
+     /// Metadata key set on batched messages, holding the number of channels in the batch.
+     static constexpr const char* kBatchedChannelsKey = "batched_channels";
+     /// Metadata key set on batched messages, holding one dictionary per channel.
+     static constexpr const char* kChannelMetadataKey = "channel_metadata";
+     /// Metadata key holding the factor the transform output was scaled by, the coherent gain
+     /// of the window included.
+     static constexpr const char* kFftScaleKey = "fft_scale";
+     using ChannelMetadata = std::vector<std::shared_ptr<MetadataDictionary>>;
+
  private:
+     template <typename TIn, typename TOut>
+     void transform(const tensor_t<TIn, 2>& in, cudaStream_t stream, tensor_t<TOut, 3>& buffer,
+             OutputContext& op_output);
+     // Calls f with the output buffer of the transform precision
+     template <typename F>
+     void with_outputs(F&& f);
+     template <typename TIn, typename TOut>
+     void shift_into(const TIn* in, TOut* out, index_t num_rows, cudaStream_t stream);
+     void exec(cufftHandle plan, void* data, cudaStream_t stream);
+     cufftHandle make_plan(index_t batch);
+     bool pooled() const { return workspace.has_value() && workspace.get() != nullptr; }
+     std::string workspace_key() const { return name() + "/outputs"; }
+
+     // Only the buffer of transform_type is allocated
      tensor_t<complex, 3> outputs;
+     tensor_t<complex_fp16, 3> outputs_fp16;
+     tensor_t<complex_bf16, 3> outputs_bf16;
+     cudaDataType transform_type = CUDA_C_32F;
+     float output_scale = 1.0f;
+     // Coherent gain of the window, mean of its coefficients
+     float window_gain = 1.0f;
+     // fftshift as a frequency shift of the input: one w[n] e^(-2 pi i n s / N) factor per
+     // sample, the window folded in
+     tensor_t<complex, 1> shift_factors;
+     // The window alone, for the MatX fallback of non-contiguous inputs
+     tensor_t<float, 1> window_table;
+     // Explicit cuFFT plans over one channel and over all channels, owned by the workspace
+     // when there is one
+     cufftHandle channel_plan = 0;
+     cufftHandle batch_plan = 0;
+     // VITA 49 keys, built once and applied to each emitted message
+     MetadataDictionary vita_metadata;
+     // Accumulation state of batch_channels mode
+     std::vector<cudaEvent_t> channel_events;
+     std::vector<bool> channel_ready;
+     ChannelMetadata channel_metadata;
+     uint16_t channels_ready = 0;
+     Parameter<std::shared_ptr<MatxWorkspacePool>> workspace;
+     Parameter<bool> batch_channels;
+     Parameter<std::string> precision;
+     Parameter<std::string> window;
      Parameter<int> burst_size;
      Parameter<int> num_bursts;
      Parameter<uint16_t> num_channels;
+     Parameter<uint16_t> first_channel;
+     Parameter<int32_t> device;
      Parameter<uint8_t> spectrum_type;
      Parameter<uint8_t> averaging_type;
      Parameter<uint8_t> window_time;
@@ -0,0 +1,79 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "frame_checksum.cuh"
+
+#include <algorithm>
+
+namespace holoscan::ops::frame_checksum {
+
+namespace {
+
+constexpr uint32_t kChecksumThreads = 256;
+constexpr uint64_t kMaxChecksumBlocks = 4096;
+
+// splitmix64 finalizer
+__device__ inline uint64_t mix(uint64_t value) {
+  value ^= value >> 30;
+  value *= 0xbf58476d1ce4e5b9ULL;
+  value ^= value >> 27;
+  value *= 0x94d049bb133111ebULL;
+  return value ^ (value >> 31);
+}
+
+__global__ void checksum_kernel(Region region, uint32_t seed, unsigned long long* checksum) {
+  const uint64_t words_per_row = (region.row_bytes + 3) / 4;
+  const uint64_t words = words_per_row * region.rows;
+  const bool aligned = reinterpret_cast<uintptr_t>(region.data) % 4 == 0 && region.pitch % 4 == 0;
+
+  unsigned long long sum = 0;
+  for (uint64_t index = static_cast<uint64_t>(blockIdx.x) * blockDim.x + threadIdx.x;
+       index < words;
+       index += static_cast<uint64_t>(gridDim.x) * blockDim.x) {
+    const uint64_t row = index / words_per_row;
+    const uint64_t offset = (index - row * words_per_row) * 4;
+    const uint8_t* bytes = region.data + row * region.pitch + offset;
+    uint32_t word = 0;
+    if (aligned && offset + 4 <= region.row_bytes) {
+      word = *reinterpret_cast<const uint32_t*>(bytes);
+    } else {
+      // last bytes of a row, zero padded
+      for (uint64_t byte = 0; byte < 4 && offset + byte < region.row_bytes; ++byte) {
+        word |= static_cast<uint32_t>(bytes[byte]) << (8 * byte);
+      }
+    }
+    sum += mix(((static_cast<uint64_t>(word) << 32) | seed) ^ mix(index));
+  }
+
+  // one atomic per warp
+  for (int delta = 16; delta > 0; delta /= 2) { sum += __shfl_down_sync(0xffffffff, sum, delta); }
+  if (threadIdx.x % 32 == 0) { atomicAdd(checksum, sum); }
+}
+
+}  // namespace
+
+void cuda_checksum(const Region& region, uint32_t seed, unsigned long long* checksum,
+                   cudaStream_t cuda_stream) {
+  const uint64_t words = (region.row_bytes + 3) / 4 * region.rows;
+  if (words == 0) { return; }
+  const uint64_t blocks =
+      std::min((words + kChecksumThreads - 1) / kChecksumThreads, kMaxChecksumBlocks);
+  checksum_kernel<<<blocks, kChecksumThreads, 0, cuda_stream>>>(region, seed, checksum);
+  CUDA_TRY(cudaPeekAtLastError());
+}
+
+}  // namespace holoscan::ops::frame_checksum
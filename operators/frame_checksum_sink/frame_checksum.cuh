@@ -0,0 +1,62 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef HOLOSCAN_OPERATORS_FRAME_CHECKSUM_SINK_FRAME_CHECKSUM_CUH
+#define HOLOSCAN_OPERATORS_FRAME_CHECKSUM_SINK_FRAME_CHECKSUM_CUH
+
+#include <cuda_runtime.h>
+
+#include <cstdint>
+#include <stdexcept>
+
+#include <holoscan/logger/logger.hpp>
+
+#define CUDA_TRY(stmt)                                                                        \
+  {                                                                                           \
+    cudaError_t cuda_status = stmt;                                                           \
+    if (cudaSuccess != cuda_status) {                                                         \
+      HOLOSCAN_LOG_ERROR("CUDA runtime call {} in line {} of file {} failed with '{}' ({}).", \
+                         #stmt,                                                               \
+                         __LINE__,                                                            \
+                         __FILE__,                                                            \
+                         cudaGetErrorString(cuda_status),                                     \
+                         static_cast<int>(cuda_status));                                      \
+      throw std::runtime_error("CUDA runtime call failed");                                   \
+    }                                                                                         \
+  }
+
+namespace holoscan::ops::frame_checksum {
+
+/// `rows` rows of `row_bytes` bytes, `pitch` bytes apart, in device memory
+struct Region {
+  const uint8_t* data;
+  uint64_t rows;
+  uint64_t row_bytes;
+  uint64_t pitch;
+};
+
+/**
+ * Add the checksum of the region to `checksum`. Each 32 bit word is hashed with its position and
+ * `seed`, the ordinal of the region in the frame, and the hashes are summed, so the result does
+ * not depend on the order the threads run in. Row padding is not part of the checksum.
+ */
+void cuda_checksum(const Region& region, uint32_t seed, unsigned long long* checksum,
+                   cudaStream_t cuda_stream);
+
+}  // namespace holoscan::ops::frame_checksum
+
+#endif /* HOLOSCAN_OPERATORS_FRAME_CHECKSUM_SINK_FRAME_CHECKSUM_CUH */
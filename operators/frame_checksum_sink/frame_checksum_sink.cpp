@@ -0,0 +1,247 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "frame_checksum_sink.hpp"
+
+#include <algorithm>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+
+#include <holoscan/core/execution_context.hpp>
+
+#include <gxf/multimedia/video.hpp>
+#include <gxf/std/tensor.hpp>
+
+#include "frame_checksum.cuh"
+
+namespace holoscan::ops {
+
+void FrameChecksumSinkOp::setup(OperatorSpec& spec) {
+  spec.input<gxf::Entity>("in");
+
+  spec.param(golden_file_,
+             "golden_file",
+             "Golden File",
+             "File of the expected checksum of each frame, no comparison if empty.",
+             std::string(""));
+  spec.param(checksum_file_,
+             "checksum_file",
+             "Checksum File",
+             "File to write the checksum of each frame to, none if empty.",
+             std::string(""));
+  spec.param(warmup_frames_,
+             "warmup_frames",
+             "Warmup Frames",
+             "Frames left out of the throughput and latency.",
+             static_cast<uint64_t>(0));
+
+  cuda_stream_handler_.define_params(spec);
+}
+
+void FrameChecksumSinkOp::start() {
+  golden_.clear();
+  if (!golden_file_.get().empty()) {
+    std::ifstream golden(golden_file_.get());
+    if (!golden) {
+      throw std::runtime_error(fmt::format("Failed to open {}.", golden_file_.get()));
+    }
+    std::string line;
+    while (std::getline(golden, line)) {
+      if (line.empty() || line[0] == '#') { continue; }
+      golden_.push_back(std::stoull(line, nullptr, 16));
+    }
+  }
+  for (auto& slot : slots_) {
+    CUDA_TRY(cudaMalloc(&slot.device_checksum, sizeof(unsigned long long)));
+    CUDA_TRY(cudaMallocHost(&slot.host_checksum, sizeof(unsigned long long)));
+    CUDA_TRY(cudaEventCreateWithFlags(&slot.read_back, cudaEventDisableTiming));
+  }
+  checksums_.clear();
+  latencies_ms_.clear();
+  mismatches_ = 0;
+}
+
+void FrameChecksumSinkOp::stop() {
+  collect(true);
+  report();
+  compare();
+  if (!checksum_file_.get().empty()) {
+    std::ofstream file(checksum_file_.get(), std::ios::trunc);
+    if (!file) {
+      HOLOSCAN_LOG_ERROR("Failed to open {}", checksum_file_.get());
+    } else {
+      for (const uint64_t checksum : checksums_) { file << fmt::format("{:016x}\n", checksum); }
+    }
+  }
+  for (auto& slot : slots_) {
+    if (slot.read_back) { CUDA_TRY(cudaEventDestroy(slot.read_back)); }
+    if (slot.host_checksum) { CUDA_TRY(cudaFreeHost(slot.host_checksum)); }
+    if (slot.device_checksum) { CUDA_TRY(cudaFree(slot.device_checksum)); }
+    slot = Slot();
+  }
+}
+
+void FrameChecksumSinkOp::compute(InputContext& op_input, OutputContext&,
+                                  ExecutionContext& context) {
+  const auto arrival = std::chrono::steady_clock::now();
+  auto maybe_entity = op_input.receive<gxf::Entity>("in");
+  if (!maybe_entity) { throw std::runtime_error("Failed to receive input"); }
+  auto& entity = static_cast<nvidia::gxf::Entity&>(maybe_entity.value());
+
+  if (cuda_stream_handler_.from_message(context.context(), entity) != GXF_SUCCESS) {
+    throw std::runtime_error("Failed to get the CUDA stream from incoming messages");
+  }
+  const cudaStream_t cuda_stream = cuda_stream_handler_.get_cuda_stream(context.context());
+
+  collect(false);
+  Slot& slot = slots_[next_slot_];
+  // all the read backs are in flight, every frame is checked so wait for them
+  if (slot.pending) { collect(true); }
+
+  CUDA_TRY(cudaMemsetAsync(slot.device_checksum, 0, sizeof(unsigned long long), cuda_stream));
+  uint32_t regions = 0;
+  const auto tensors = entity.findAll<nvidia::gxf::Tensor>();
+  if (tensors) {
+    for (const auto& maybe_tensor : tensors.value()) {
+      if (!maybe_tensor) { continue; }
+      const auto& tensor = maybe_tensor.value();
+      if (tensor->storage_type() != nvidia::gxf::MemoryStorageType::kDevice) {
+        throw std::runtime_error(fmt::format("Tensor '{}' must be in device memory.",
+                                             tensor.name()));
+      }
+      const auto contiguous = tensor->isContiguous();
+      if (!contiguous || !contiguous.value()) {
+        throw std::runtime_error(fmt::format("Tensor '{}' must be contiguous.", tensor.name()));
+      }
+      frame_checksum::cuda_checksum(
+          {static_cast<const uint8_t*>(tensor->pointer()), 1, tensor->size(), tensor->size()},
+          regions++,
+          slot.device_checksum,
+          cuda_stream);
+    }
+  }
+  const auto video_buffers = entity.findAll<nvidia::gxf::VideoBuffer>();
+  if (video_buffers) {
+    for (const auto& maybe_video_buffer : video_buffers.value()) {
+      if (!maybe_video_buffer) { continue; }
+      const auto& video_buffer = maybe_video_buffer.value();
+      if (video_buffer->storage_type() != nvidia::gxf::MemoryStorageType::kDevice) {
+        throw std::runtime_error("VideoBuffer must be in device memory.");
+      }
+      const auto* data = static_cast<const uint8_t*>(video_buffer->pointer());
+      for (const auto& plane : video_buffer->video_frame_info().color_planes) {
+        frame_checksum::cuda_checksum({data + plane.offset,
+                                       plane.height,
+                                       static_cast<uint64_t>(plane.width) * plane.bytes_per_pixel,
+                                       plane.stride},
+                                      regions++,
+                                      slot.device_checksum,
+                                      cuda_stream);
+      }
+    }
+  }
+  if (regions == 0) { throw std::runtime_error("Neither Tensor nor VideoBuffer found in message"); }
+
+  CUDA_TRY(cudaMemcpyAsync(slot.host_checksum,
+                           slot.device_checksum,
+                           sizeof(unsigned long long),
+                           cudaMemcpyDeviceToHost,
+                           cuda_stream));
+  CUDA_TRY(cudaLaunchHostFunc(cuda_stream, mark_completion, &slot));
+  CUDA_TRY(cudaEventRecord(slot.read_back, cuda_stream));
+  slot.arrival = arrival;
+  slot.pending = true;
+  next_slot_ = (next_slot_ + 1) % kSlots;
+}
+
+void CUDART_CB FrameChecksumSinkOp::mark_completion(void* slot) {
+  static_cast<Slot*>(slot)->completion = std::chrono::steady_clock::now();
+}
+
+void FrameChecksumSinkOp::collect(bool wait) {
+  // read backs complete in order
+  while (slots_[oldest_slot_].pending) {
+    Slot& slot = slots_[oldest_slot_];
+    if (wait) {
+      CUDA_TRY(cudaEventSynchronize(slot.read_back));
+    } else {
+      const cudaError_t status = cudaEventQuery(slot.read_back);
+      if (status == cudaErrorNotReady) { return; }
+      CUDA_TRY(status);
+    }
+    slot.pending = false;
+    oldest_slot_ = (oldest_slot_ + 1) % kSlots;
+
+    checksums_.push_back(*slot.host_checksum);
+    if (checksums_.size() <= warmup_frames_.get()) { continue; }
+    if (latencies_ms_.empty()) { first_completion_ = slot.completion; }
+    last_completion_ = slot.completion;
+    latencies_ms_.push_back(
+        std::chrono::duration<double, std::milli>(slot.completion - slot.arrival).count());
+  }
+}
+
+void FrameChecksumSinkOp::compare() {
+  if (golden_file_.get().empty()) { return; }
+  const size_t checked = std::min(golden_.size(), checksums_.size());
+  for (size_t frame = 0; frame < checked; ++frame) {
+    if (checksums_[frame] == golden_[frame]) { continue; }
+    if (mismatches_++ == 0) {
+      HOLOSCAN_LOG_ERROR("Frame {} has checksum {:016x}, expected {:016x}",
+                         frame,
+                         checksums_[frame],
+                         golden_[frame]);
+    }
+  }
+  if (mismatches_) {
+    HOLOSCAN_LOG_ERROR("{} of {} frames differ from {}", mismatches_, checked, golden_file_.get());
+  } else {
+    HOLOSCAN_LOG_INFO("{} frames match {}", checked, golden_file_.get());
+  }
+  if (checksums_.size() != golden_.size()) {
+    HOLOSCAN_LOG_WARN("{} frames were received, {} has {}",
+                      checksums_.size(),
+                      golden_file_.get(),
+                      golden_.size());
+  }
+}
+
+void FrameChecksumSinkOp::report() {
+  if (latencies_ms_.empty()) {
+    HOLOSCAN_LOG_WARN("No frame was received after the {} warmup frames", warmup_frames_.get());
+    return;
+  }
+  const double seconds =
+      std::chrono::duration<double>(last_completion_ - first_completion_).count();
+  std::vector<double> sorted = latencies_ms_;
+  std::sort(sorted.begin(), sorted.end());
+  auto percentile = [&sorted](double fraction) {
+    return sorted[static_cast<size_t>(fraction * (sorted.size() - 1) + 0.5)];
+  };
+  HOLOSCAN_LOG_INFO(
+      "{} frames, {:.1f} frames/s, arrival to GPU completion latency (ms): p50 {:.3f}, "
+      "p90 {:.3f}, p99 {:.3f}, max {:.3f}",
+      sorted.size(),
+      seconds > 0. ? (sorted.size() - 1) / seconds : 0.,
+      percentile(0.5),
+      percentile(0.9),
+      percentile(0.99),
+      sorted.back());
+}
+
+}  // namespace holoscan::ops
@@ -0,0 +1,118 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef HOLOSCAN_OPERATORS_FRAME_CHECKSUM_SINK_FRAME_CHECKSUM_SINK_HPP
+#define HOLOSCAN_OPERATORS_FRAME_CHECKSUM_SINK_FRAME_CHECKSUM_SINK_HPP
+
+#include <cuda_runtime.h>
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "holoscan/holoscan.hpp"
+#include "holoscan/utils/cuda_stream_handler.hpp"
+
+namespace holoscan::ops {
+
+/**
+ * @brief Headless sink computing a checksum of every frame on the GPU, for benchmarking
+ * pipelines at their maximum rate while checking their output.
+ *
+ * The checksum covers every tensor and video buffer of the message, in device memory, and only
+ * its 8 bytes are read back, asynchronously. The time from the arrival of each frame to the
+ * completion of its GPU work is recorded, and the throughput and latency percentiles are logged
+ * when the application stops. The checksums can be written to a file, and compared to the ones
+ * of a golden file written by a previous run.
+ *
+ * ==Named Inputs==
+ *
+ * - **in** : `nvidia::gxf::Entity` containing `nvidia::gxf::Tensor`s or
+ *   `nvidia::gxf::VideoBuffer`s
+ *   - Contiguous tensors and video buffers on the device. The padding of video buffer rows is
+ *     not part of the checksum.
+ *
+ * ==Parameters==
+ *
+ * - **golden_file**: File of expected checksums, one hexadecimal checksum per line and frame.
+ *   Optional (default: "", no comparison).
+ * - **checksum_file**: File to write the checksum of each frame to, in the golden file format.
+ *   Optional (default: "").
+ * - **warmup_frames**: Frames left out of the throughput and latency, still checksummed.
+ *   Optional (default: 0).
+ * - **cuda_stream_pool**: `holoscan::CudaStreamPool` instance to allocate CUDA streams.
+ *   Optional (default: `nullptr`).
+ */
+class FrameChecksumSinkOp : public holoscan::Operator {
+ public:
+  HOLOSCAN_OPERATOR_FORWARD_ARGS(FrameChecksumSinkOp)
+
+  FrameChecksumSinkOp() = default;
+
+  void setup(OperatorSpec& spec) override;
+  void start() override;
+  void stop() override;
+  void compute(InputContext& op_input, OutputContext& op_output,
+               ExecutionContext& context) override;
+
+  /// Checksums of the frames received so far that are complete
+  const std::vector<uint64_t>& checksums() const { return checksums_; }
+  /// Frames whose checksum differs from the golden one, set by stop()
+  uint64_t mismatches() const { return mismatches_; }
+
+ private:
+  // Frames checksummed and not read back yet
+  static constexpr size_t kSlots = 8;
+  struct Slot {
+    unsigned long long* device_checksum = nullptr;
+    unsigned long long* host_checksum = nullptr;
+    cudaEvent_t read_back = nullptr;
+    std::chrono::steady_clock::time_point arrival;
+    std::chrono::steady_clock::time_point completion;  // set by a host function on the stream
+    bool pending = false;
+  };
+
+  static void CUDART_CB mark_completion(void* slot);
+
+  /// Record the frames read back, waiting for all of them if `wait`
+  void collect(bool wait);
+  void compare();
+  void report();
+
+  Parameter<std::string> golden_file_;
+  Parameter<std::string> checksum_file_;
+  Parameter<uint64_t> warmup_frames_;
+
+  CudaStreamHandler cuda_stream_handler_;
+
+  std::array<Slot, kSlots> slots_;
+  size_t next_slot_ = 0;
+  size_t oldest_slot_ = 0;
+
+  std::vector<uint64_t> golden_;
+  std::vector<uint64_t> checksums_;
+  std::vector<double> latencies_ms_;
+  std::chrono::steady_clock::time_point first_completion_;
+  std::chrono::steady_clock::time_point last_completion_;
+  uint64_t mismatches_ = 0;
+};
+
+}  // namespace holoscan::ops
+
+#endif /* HOLOSCAN_OPERATORS_FRAME_CHECKSUM_SINK_FRAME_CHECKSUM_SINK_HPP */
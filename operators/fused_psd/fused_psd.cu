@@ -0,0 +1,151 @@
+// SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// SPDX-License-Identifier: Apache-2.0
+#include "fused_psd.hpp"
+
+#include <any>
+#include <stdexcept>
+#include <cuda_bf16.h>
+#include <cuda_fp16.h>
+
+template <typename T>
+using stream_tensor_t = std::tuple<tensor_t<T, 2>, cudaStream_t>;
+using in_t = stream_tensor_t<complex>;
+using out_t = std::tuple<tensor_t<int8_t, 1>, cudaStream_t>;
+
+namespace holoscan::ops {
+
+namespace {
+
+// 32 consecutive bins per warp for coalesced reads, 8 rows of bursts reduced in shared memory
+constexpr int kTileBins = 32;
+constexpr int kTileBursts = 8;
+
+/**
+ * One thread block reduces kTileBins bins of one channel over all of its bursts. Each row of
+ * threads sums every kTileBursts-th burst, then the rows are summed in shared memory. Samples
+ * of any precision are accumulated in fp32.
+ */
+template <typename T>
+__global__ void fused_psd_kernel(const T* in, int8_t* out, index_t num_bursts,
+        index_t burst_size, float scale) {
+    __shared__ float partial[kTileBursts][kTileBins];
+
+    const index_t bin = static_cast<index_t>(blockIdx.x) * kTileBins + threadIdx.x;
+    const index_t channel = blockIdx.y;
+    const T* channel_in = in + channel * num_bursts * burst_size;
+
+    float acc = 0.0f;
+    if (bin < burst_size) {
+        for (index_t burst = threadIdx.y; burst < num_bursts; burst += kTileBursts) {
+            const float2 v = load_sample(channel_in[burst * burst_size + bin]);
+            acc += v.x * v.x + v.y * v.y;
+        }
+    }
+    partial[threadIdx.y][threadIdx.x] = acc;
+    __syncthreads();
+
+    if (threadIdx.y != 0 || bin >= burst_size) {
+        return;
+    }
+    float sum = 0.0f;
+    for (int row = 0; row < kTileBursts; row++) {
+        sum += partial[row][threadIdx.x];
+    }
+    const float db = fminf(fmaxf(10.0f * log10f(sum * scale), -128.0f), 127.0f);
+    out[channel * burst_size + bin] = static_cast<int8_t>(db);
+}
+
+}  // namespace
+
+void FusedPSD::setup(OperatorSpec& spec) {
+    spec.input<in_t>("in");
+    spec.output<out_t>("out");
+    spec.param(burst_size,
+        "burst_size",
+        "Burst size",
+        "Number of samples in each burst");
+    spec.param(num_averages,
+        "num_averages",
+        "Number of averages",
+        "Number of bursts to average and pass along in metadata");
+    spec.param(num_channels,
+        "num_channels",
+        "Number of channels",
+        "Number of channels to allocate memory for");
+    spec.param(first_channel,
+        "first_channel",
+        "First channel",
+        "Channel number of channel 0 of this operator's buffers",
+        static_cast<uint16_t>(0));
+    spec.param(device,
+        "device",
+        "CUDA device",
+        "CUDA device the operator runs on",
+        0);
+}
+
+void FusedPSD::initialize() {
+    holoscan::Operator::initialize();
+    cudaSetDevice(device.get());
+    make_tensor(outputs, {num_channels.get(), burst_size.get()}, MATX_DEVICE_MEMORY);
+}
+
+template <typename T>
+void FusedPSD::launch(const T* in, int8_t* out, index_t num_channels, index_t num_bursts,
+        float fft_scale, cudaStream_t stream) {
+    // Same scaling as HighRatePSD (1 / N^2, and the FFT scale undone) and LowRatePSD
+    // (1 / num_averages)
+    const float scale = 1.0 / (pow(burst_size.get() * fft_scale, 2) * num_averages.get());
+    dim3 block(kTileBins, kTileBursts);
+    dim3 grid((burst_size.get() + kTileBins - 1) / kTileBins, num_channels);
+    fused_psd_kernel<<<grid, block, 0, stream>>>(in, out, num_bursts, burst_size.get(), scale);
+}
+
+template <typename T>
+void FusedPSD::psd(const tensor_t<T, 2>& in, cudaStream_t stream, OutputContext& op_output) {
+    auto meta = metadata();
+    meta->set("num_averages", num_averages.get());
+    const float fft_scale = meta->get<float>("fft_scale", 1.0f);
+
+    // Batched FFT output: the bursts of every channel, one after the other
+    if (meta->has_key("batched_channels")) {
+        const index_t num_bursts = in.Size(0) / num_channels.get();
+        launch(in.Data(), outputs.Data(), num_channels.get(), num_bursts, fft_scale, stream);
+
+        using ChannelMetadata = std::vector<std::shared_ptr<MetadataDictionary>>;
+        if (meta->has_key("channel_metadata")) {
+            for (auto& channel_meta : meta->get<ChannelMetadata>("channel_metadata")) {
+                if (channel_meta) {
+                    channel_meta->set("num_averages", num_averages.get());
+                }
+            }
+        }
+
+        auto flat = outputs.View({num_channels.get() * burst_size.get()});
+        op_output.emit(out_t {flat, stream}, "out");
+        return;
+    }
+
+    const int channel_num = meta->get<uint16_t>("channel_number", 0) - first_channel.get();
+    if (channel_num < 0 || channel_num >= num_channels.get()) {
+        HOLOSCAN_LOG_CRITICAL("Channel {} is outside of channels {} to {}",
+            channel_num + first_channel.get(), first_channel.get(),
+            first_channel.get() + num_channels.get() - 1);
+        throw std::runtime_error("Invalid channel_number");
+    }
+    auto out = slice<1>(outputs, {static_cast<index_t>(channel_num), 0},
+            {matxDropDim, matxEnd});
+    launch(in.Data(), out.Data(), 1, in.Size(0), fft_scale, stream);
+
+    op_output.emit(out_t {out, stream}, "out");
+}
+
+void FusedPSD::compute(InputContext& op_input, OutputContext& op_output, ExecutionContext&) {
+    cudaSetDevice(device.get());
+    auto message = op_input.receive<std::any>("in").value();
+    visit_stream_tensor<complex, complex_fp16, complex_bf16>(message, [&](auto& input) {
+        psd(std::get<0>(input), std::get<1>(input), op_output);
+    });
+}
+}  // namespace holoscan::ops
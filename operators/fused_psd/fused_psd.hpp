@@ -0,0 +1,48 @@
+// SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// SPDX-License-Identifier: Apache-2.0
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include <matx.h>
+#include "holoscan/holoscan.hpp"
+#include "../matx_sample_types.hpp"
+
+using namespace matx;
+
+namespace holoscan::ops {
+/**
+ * @brief Averaged 8-bit PSD computed straight from FFT output
+ *
+ * Equivalent to HighRatePSD followed by LowRatePSD, but the magnitude squared, scaling,
+ * average over bursts, 10 * log10() and int8 clamp happen in one tiled reduction kernel,
+ * without the [channels, bursts, burst_size] float intermediate.
+ */
+class FusedPSD : public Operator {
+ public:
+    HOLOSCAN_OPERATOR_FORWARD_ARGS(FusedPSD)
+
+    FusedPSD() = default;
+
+    void initialize() override;
+    void setup(OperatorSpec& spec) override;
+    void compute(InputContext& input, OutputContext& output, ExecutionContext& context) override;
+
+ private:
+    template <typename T>
+    void psd(const tensor_t<T, 2>& in, cudaStream_t stream, OutputContext& op_output);
+    template <typename T>
+    void launch(const T* in, int8_t* out, index_t num_channels, index_t num_bursts,
+            float fft_scale, cudaStream_t stream);
+
+    tensor_t<int8_t, 2> outputs;
+    Parameter<int> burst_size;
+    Parameter<uint16_t> num_channels;
+    Parameter<uint16_t> first_channel;
+    Parameter<int32_t> device;
+    Parameter<uint32_t> num_averages;
+};
+
+}  // namespace holoscan::ops
@@ -20,12 +20,28 @@
 
 namespace holoscan::ops {
 
+// The writer thread parks on the request queue for at most this time before checking the timeout
+static constexpr std::chrono::milliseconds kRequestWait{100};
+
+static grpc_compression_algorithm to_compression_algorithm(const std::string& compression) {
+  if (compression == "none") { return GRPC_COMPRESS_NONE; }
+  if (compression == "deflate") { return GRPC_COMPRESS_DEFLATE; }
+  if (compression == "gzip") { return GRPC_COMPRESS_GZIP; }
+  throw std::runtime_error{fmt::format("Unsupported compression '{}'", compression)};
+}
+
 EntityClient::EntityClient(
     const std::string& server_address, const uint32_t rpc_timeout,
     std::shared_ptr<ConditionVariableQueue<std::shared_ptr<EntityRequest>>> request_queue,
     std::shared_ptr<AsynchronousConditionQueue<std::shared_ptr<nvidia::gxf::Entity>>>
-        response_queue)
-    : rpc_timeout_(rpc_timeout), request_queue_(request_queue), response_queue_(response_queue) {
+        response_queue,
+    const EntityStreamOptions& options)
+    : rpc_timeout_(rpc_timeout),
+      options_(options),
+      request_queue_(request_queue),
+      response_queue_(response_queue) {
+  // validate before connecting
+  to_compression_algorithm(options_.compression);
   channel_ = grpc::CreateChannel(server_address, grpc::InsecureChannelCredentials());
   if (auto status = channel_->GetState(true);
       status == GRPC_CHANNEL_TRANSIENT_FAILURE || status == GRPC_CHANNEL_SHUTDOWN) {
@@ -38,6 +54,13 @@ void EntityClient::EntityStream(on_new_response_available_callback response_cb,
                                 on_rpc_completed_callback rpc_completed_cb) {
   EntityStreamInternal rpc_call(this, response_cb, rpc_completed_cb, rpc_timeout_);
   auto status = rpc_call.Await();
+  const QueueMetrics metrics = request_queue_->metrics();
+  HOLOSCAN_LOG_INFO(
+      "grpc client: request queue capacity {}, high watermark {}, pushed {}, dropped {}",
+      metrics.capacity,
+      metrics.high_watermark,
+      metrics.pushed,
+      metrics.dropped);
   if (status.ok()) {
     HOLOSCAN_LOG_INFO("grpc client: EntityStream rpc succeeded.");
   } else {
@@ -54,6 +77,7 @@ EntityClient::EntityStreamInternal::EntityStreamInternal(
       rpc_completed_cb_(rpc_completed_cb),
       rpc_timeout_(rpc_timeout) {
   last_network_activity_ = std::chrono::time_point<std::chrono::system_clock>::min();
+  context_.set_compression_algorithm(to_compression_algorithm(client_->options_.compression));
   client_->stub_->async()->EntityStream(&context_, this);
   context_.set_deadline(std::chrono::system_clock::now() + std::chrono::seconds(rpc_timeout_));
   StartCall();
@@ -77,6 +101,7 @@ void EntityClient::EntityStreamInternal::OnWriteDone(bool ok) {
       StartWritesDone();
     }
   }
+  request_.reset();
   write_mutex_.unlock();
 }
 
@@ -109,11 +134,25 @@ void EntityClient::EntityStreamInternal::Read() {
 }
 
 void EntityClient::EntityStreamInternal::Write() {
-  if (!client_->request_queue_->empty()) {
+  std::shared_ptr<EntityRequest> request;
+  if (client_->request_queue_->pop(request, kRequestWait)) {
     write_mutex_.lock();
-    std::shared_ptr<EntityRequest> request;
-    request = client_->request_queue_->pop();
-    StartWrite(&*request);
+    request_ = std::move(request);
+
+    const EntityStreamOptions& options = client_->options_;
+    grpc::WriteOptions write_options;
+    if (request_->ByteSizeLong() < options.compression_threshold) {
+      write_options.set_no_compression();
+    }
+    // buffer the write while more requests are queued and within the latency bound, the last
+    // request of the sequence flushes them together
+    const auto now = std::chrono::steady_clock::now();
+    if (!batching_) { batch_start_ = now; }
+    batching_ = (options.batch_latency > 0) && !client_->request_queue_->empty() &&
+                (now - batch_start_ < std::chrono::milliseconds(options.batch_latency));
+    if (batching_) { write_options.set_buffer_hint(); }
+
+    StartWrite(request_.get(), write_options);
     HOLOSCAN_LOG_DEBUG("grpc client: Sending request to server");
   }
 }
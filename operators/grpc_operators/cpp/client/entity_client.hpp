@@ -19,6 +19,7 @@
 #define CLIENT_ENTITY_CLIENT_HPP
 
 #include <chrono>
+#include <string>
 #include <thread>
 
 #include <grpcpp/grpcpp.h>
@@ -58,6 +59,20 @@ using on_new_response_available_callback =
  */
 using on_rpc_completed_callback = std::function<void()>;
 
+/**
+ * @struct EntityStreamOptions
+ * @brief Transfer options for the requests of the entity stream.
+ */
+struct EntityStreamOptions {
+  /// gRPC message compression of requests: "none", "deflate" or "gzip"
+  std::string compression = "none";
+  /// requests with a serialized size below this number of bytes are sent uncompressed
+  uint32_t compression_threshold = 0;
+  /// time in milliseconds queued requests may be buffered to coalesce them into fewer transport
+  /// writes, 0 writes each request immediately
+  uint32_t batch_latency = 0;
+};
+
 /**
  * @class EntityClient
  * @brief A client class for handling gRPC communication with an entity server.
@@ -70,6 +85,9 @@ using on_rpc_completed_callback = std::function<void()>;
  * completion of itself, a `rpc_timeout` parameter is used to close the connection if no data is
  * transmitted or received for the specified time.
  *
+ * Requests are compressed and coalesced as configured by EntityStreamOptions. Wire compatibility
+ * is kept: compression is negotiated by gRPC and coalesced requests are still separate messages.
+ *
  * @note On a slow network, adjust the `rpc_timeout` value accordingly.
  */
 
@@ -79,7 +97,8 @@ class EntityClient {
       const std::string& server_address, const uint32_t rpc_timeout,
       std::shared_ptr<ConditionVariableQueue<std::shared_ptr<EntityRequest>>> request_queue,
       std::shared_ptr<AsynchronousConditionQueue<std::shared_ptr<nvidia::gxf::Entity>>>
-          response_queue);
+          response_queue,
+      const EntityStreamOptions& options = {});
 
   void EntityStream(on_new_response_available_callback response_cb,
                     on_rpc_completed_callback rpc_completed_cb);
@@ -115,12 +134,18 @@ class EntityClient {
     Status status_;
 
     std::mutex write_mutex_;
+    // the request being written, kept alive until the write is done
+    std::shared_ptr<EntityRequest> request_;
+    // start of the current sequence of buffered writes
+    std::chrono::time_point<std::chrono::steady_clock> batch_start_;
+    bool batching_ = false;
     std::thread writer_thread_;
     int rpc_timeout_;
     std::chrono::time_point<std::chrono::system_clock> last_network_activity_;
   };
 
   uint32_t rpc_timeout_;
+  EntityStreamOptions options_;
   std::shared_ptr<ConditionVariableQueue<std::shared_ptr<EntityRequest>>> request_queue_;
   std::shared_ptr<AsynchronousConditionQueue<std::shared_ptr<nvidia::gxf::Entity>>> response_queue_;
 
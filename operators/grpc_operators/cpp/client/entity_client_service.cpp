@@ -24,19 +24,21 @@ EntityClientService::EntityClientService(
     std::shared_ptr<ConditionVariableQueue<std::shared_ptr<EntityRequest>>> request_queue,
     std::shared_ptr<AsynchronousConditionQueue<std::shared_ptr<nvidia::gxf::Entity>>>
         response_queue,
-    std::shared_ptr<GrpcClientRequestOp> grpc_request_operator)
+    std::shared_ptr<GrpcClientRequestOp> grpc_request_operator,
+    const EntityStreamOptions& options)
     : server_address_(server_address),
       rpc_timeout_(rpc_timeout),
       interrupt_(interrupt),
       request_queue_(request_queue),
       response_queue_(response_queue),
-      grpc_request_operator_(grpc_request_operator) {}
+      grpc_request_operator_(grpc_request_operator),
+      options_(options) {}
 
 void EntityClientService::start_entity_stream() {
   try {
     HOLOSCAN_LOG_DEBUG("grpc: Starting streaming client");
     entity_client_ = std::make_shared<EntityClient>(
-        server_address_, rpc_timeout_, request_queue_, response_queue_);
+        server_address_, rpc_timeout_, request_queue_, response_queue_, options_);
     streaming_thread_ = std::thread(&EntityClientService::start_entity_stream_internal, this);
     HOLOSCAN_LOG_DEBUG("grpc: Entity client service configured: {}", server_address_);
   } catch (const std::exception& e) {
@@ -49,7 +49,8 @@ class EntityClientService {
       std::shared_ptr<ConditionVariableQueue<std::shared_ptr<EntityRequest>>> request_queue,
       std::shared_ptr<AsynchronousConditionQueue<std::shared_ptr<nvidia::gxf::Entity>>>
           response_queue,
-      std::shared_ptr<GrpcClientRequestOp> grpc_request_operator);
+      std::shared_ptr<GrpcClientRequestOp> grpc_request_operator,
+      const EntityStreamOptions& options = {});
 
   /**
    * @brief Starts the entity stream RPC operation.
@@ -89,6 +90,7 @@ class EntityClientService {
   std::shared_ptr<ConditionVariableQueue<std::shared_ptr<EntityRequest>>> request_queue_;
   std::shared_ptr<AsynchronousConditionQueue<std::shared_ptr<nvidia::gxf::Entity>>> response_queue_;
   std::shared_ptr<GrpcClientRequestOp> grpc_request_operator_;
+  const EntityStreamOptions options_;
 
   std::shared_ptr<EntityClient> entity_client_;
   std::thread streaming_thread_;
@@ -19,10 +19,11 @@
 #define COMMON_ASYNCHRONOUS_CONDITION_QUEUE_HPP
 
 #include <memory>
-#include <queue>
 
 #include <holoscan/holoscan.hpp>
 
+#include "bounded_queue.hpp"
+
 namespace holoscan::ops {
 
 using namespace holoscan;
@@ -32,7 +33,9 @@ using namespace holoscan;
  * @brief This class is a Holoscan Resource that is responsible for storing a queue of data
  * entities.
  *
- * The AsynchronousCondition is used to notify when data is available.
+ * The AsynchronousCondition is used to notify when data is available. The queue is a
+ * BoundedQueue, by default full queues drop the oldest entity so that the consumer always gets
+ * the latest data.
  */
 
 template <typename DataT>
@@ -42,27 +45,34 @@ class AsynchronousConditionQueue : public Resource {
 
   explicit AsynchronousConditionQueue(
       std::shared_ptr<AsynchronousCondition> request_available_condition)
-      : data_available_condition_(request_available_condition), queue_() {}
+      : data_available_condition_(request_available_condition),
+        queue_(kDefaultCapacity, QueueOverflowPolicy::kDropOldest) {}
+  AsynchronousConditionQueue(std::shared_ptr<AsynchronousCondition> request_available_condition,
+                             size_t capacity, QueueOverflowPolicy policy)
+      : data_available_condition_(request_available_condition), queue_(capacity, policy) {}
 
   void push(DataT entity) {
-    queue_.push(entity);
+    queue_.push(std::move(entity));
     if (data_available_condition_->event_state() == AsynchronousEventState::EVENT_WAITING) {
       data_available_condition_->event_state(AsynchronousEventState::EVENT_DONE);
     }
   }
 
   DataT pop() {
-    if (empty()) { return nullptr; }
-    auto item = queue_.front();
-    queue_.pop();
+    DataT item;
+    if (!queue_.try_pop(item)) { return nullptr; }
     return item;
   }
 
   bool empty() { return queue_.empty(); }
 
+  QueueMetrics metrics() const { return queue_.metrics(); }
+
  private:
+  static constexpr size_t kDefaultCapacity = 128;
+
   std::shared_ptr<AsynchronousCondition> data_available_condition_;
-  std::queue<DataT> queue_;
+  BoundedQueue<DataT> queue_;
 };
 
 }  // namespace holoscan::ops
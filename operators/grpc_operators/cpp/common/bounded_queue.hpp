@@ -0,0 +1,276 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2024 NVIDIA CORPORATION & AFFILIATES. All rights
+ * reserved. SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef COMMON_BOUNDED_QUEUE_HPP
+#define COMMON_BOUNDED_QUEUE_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+
+namespace holoscan::ops {
+
+/**
+ * @brief Behavior of a full BoundedQueue when a value is pushed.
+ */
+enum class QueueOverflowPolicy {
+  kBlock,       ///< wait until a value is popped
+  kDropOldest,  ///< drop the oldest queued value to make room
+  kDropNewest,  ///< drop the value pushed
+};
+
+/**
+ * @brief Occupancy and traffic counters of a BoundedQueue.
+ */
+struct QueueMetrics {
+  size_t capacity = 0;
+  size_t size = 0;
+  /// largest size reached
+  size_t high_watermark = 0;
+  uint64_t pushed = 0;
+  uint64_t popped = 0;
+  /// values dropped by the overflow policy
+  uint64_t dropped = 0;
+};
+
+/**
+ * @class BoundedQueue
+ * @brief A bounded multi-producer multi-consumer ring of values.
+ *
+ * Pushing and popping are lock-free, each cell carries a sequence number telling producers and
+ * consumers whether it is free or filled. Blocking operations spin for a short while and then
+ * park on a condition variable, which is only notified when a thread is parked.
+ */
+template <typename T>
+class BoundedQueue {
+ public:
+  /**
+   * @param capacity Number of values the queue holds, rounded up to a power of two.
+   * @param policy Behavior when pushing to a full queue.
+   */
+  explicit BoundedQueue(size_t capacity, QueueOverflowPolicy policy = QueueOverflowPolicy::kBlock)
+      : policy_(policy) {
+    size_t size = 2;
+    while (size < capacity) { size <<= 1; }
+    mask_ = size - 1;
+    cells_ = std::make_unique<Cell[]>(size);
+    for (size_t i = 0; i < size; ++i) { cells_[i].sequence.store(i, std::memory_order_relaxed); }
+  }
+
+  BoundedQueue(const BoundedQueue&) = delete;
+  BoundedQueue& operator=(const BoundedQueue&) = delete;
+
+  /**
+   * @brief Pushes a value, following the overflow policy when the queue is full.
+   *
+   * @return false if the value was dropped
+   */
+  bool push(T value) {
+    switch (policy_) {
+      case QueueOverflowPolicy::kBlock:
+        while (!enqueue(value)) {
+          wait(not_full_, [this] { return size() <= mask_; }, nullptr);
+        }
+        break;
+      case QueueOverflowPolicy::kDropOldest:
+        while (!enqueue(value)) {
+          T oldest;
+          if (dequeue(oldest)) { dropped_.fetch_add(1, std::memory_order_relaxed); }
+        }
+        break;
+      case QueueOverflowPolicy::kDropNewest:
+        if (!enqueue(value)) {
+          dropped_.fetch_add(1, std::memory_order_relaxed);
+          return false;
+        }
+        break;
+    }
+    pushed_.fetch_add(1, std::memory_order_relaxed);
+    const size_t current = size();
+    size_t high_watermark = high_watermark_.load(std::memory_order_relaxed);
+    while (current > high_watermark &&
+           !high_watermark_.compare_exchange_weak(high_watermark, current)) {}
+    notify(not_empty_);
+    return true;
+  }
+
+  /**
+   * @brief Pops the oldest value, if any.
+   *
+   * @return false if the queue is empty
+   */
+  bool try_pop(T& value) {
+    if (!dequeue(value)) { return false; }
+    popped_.fetch_add(1, std::memory_order_relaxed);
+    notify(not_full_);
+    return true;
+  }
+
+  /**
+   * @brief Pops the oldest value, waiting for one to be pushed.
+   */
+  T pop() {
+    T value;
+    while (!try_pop(value)) { wait(not_empty_, [this] { return !empty(); }, nullptr); }
+    return value;
+  }
+
+  /**
+   * @brief Pops the oldest value, waiting at most `timeout` for one to be pushed.
+   *
+   * @return false if the queue stayed empty
+   */
+  bool pop(T& value, std::chrono::milliseconds timeout) {
+    const auto deadline = std::chrono::steady_clock::now() + timeout;
+    while (!try_pop(value)) {
+      if (!wait(not_empty_, [this] { return !empty(); }, &deadline)) { return false; }
+    }
+    return true;
+  }
+
+  bool empty() const { return size() == 0; }
+
+  size_t size() const {
+    const size_t dequeue_pos = dequeue_pos_.load(std::memory_order_acquire);
+    const size_t enqueue_pos = enqueue_pos_.load(std::memory_order_acquire);
+    return enqueue_pos > dequeue_pos ? std::min(enqueue_pos - dequeue_pos, mask_ + 1) : 0;
+  }
+
+  QueueMetrics metrics() const {
+    QueueMetrics metrics;
+    metrics.capacity = mask_ + 1;
+    metrics.size = size();
+    metrics.high_watermark = high_watermark_.load(std::memory_order_relaxed);
+    metrics.pushed = pushed_.load(std::memory_order_relaxed);
+    metrics.popped = popped_.load(std::memory_order_relaxed);
+    metrics.dropped = dropped_.load(std::memory_order_relaxed);
+    return metrics;
+  }
+
+ private:
+  /// busy iterations before a waiting thread parks
+  static constexpr int kSpinCount = 100;
+
+  struct Cell {
+    std::atomic<size_t> sequence;
+    T value;
+  };
+
+  // the value is moved out of only when a cell is claimed
+  bool enqueue(T& value) {
+    size_t pos = enqueue_pos_.load(std::memory_order_relaxed);
+    Cell* cell;
+    while (true) {
+      cell = &cells_[pos & mask_];
+      const size_t sequence = cell->sequence.load(std::memory_order_acquire);
+      const intptr_t difference = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(pos);
+      if (difference == 0) {
+        if (enqueue_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+          break;
+        }
+      } else if (difference < 0) {
+        return false;
+      } else {
+        pos = enqueue_pos_.load(std::memory_order_relaxed);
+      }
+    }
+    cell->value = std::move(value);
+    cell->sequence.store(pos + 1, std::memory_order_release);
+    return true;
+  }
+
+  bool dequeue(T& value) {
+    size_t pos = dequeue_pos_.load(std::memory_order_relaxed);
+    Cell* cell;
+    while (true) {
+      cell = &cells_[pos & mask_];
+      const size_t sequence = cell->sequence.load(std::memory_order_acquire);
+      const intptr_t difference =
+          static_cast<intptr_t>(sequence) - static_cast<intptr_t>(pos + 1);
+      if (difference == 0) {
+        if (dequeue_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+          break;
+        }
+      } else if (difference < 0) {
+        return false;
+      } else {
+        pos = dequeue_pos_.load(std::memory_order_relaxed);
+      }
+    }
+    value = std::move(cell->value);
+    // release what the cell references, e.g. the last reference to an entity
+    cell->value = T();
+    cell->sequence.store(pos + mask_ + 1, std::memory_order_release);
+    return true;
+  }
+
+  // Spins, then parks until ready() or the deadline, if any. Returns false on timeout.
+  template <typename Predicate>
+  bool wait(std::condition_variable& condition, Predicate ready,
+            const std::chrono::steady_clock::time_point* deadline) {
+    for (int i = 0; i < kSpinCount; ++i) {
+      if (ready()) { return true; }
+      std::this_thread::yield();
+    }
+    std::unique_lock<std::mutex> lock(park_mutex_);
+    waiters_.fetch_add(1);
+    bool result = true;
+    if (deadline) {
+      result = condition.wait_until(lock, *deadline, ready);
+    } else {
+      condition.wait(lock, ready);
+    }
+    waiters_.fetch_sub(1);
+    return result;
+  }
+
+  void notify(std::condition_variable& condition) {
+    // pairs with the increment of waiters_ before the parked thread checks its predicate
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (waiters_.load() != 0) {
+      std::lock_guard<std::mutex> lock(park_mutex_);
+      condition.notify_all();
+    }
+  }
+
+  const QueueOverflowPolicy policy_;
+  std::unique_ptr<Cell[]> cells_;
+  size_t mask_ = 0;
+
+  alignas(64) std::atomic<size_t> enqueue_pos_{0};
+  alignas(64) std::atomic<size_t> dequeue_pos_{0};
+
+  std::mutex park_mutex_;
+  std::condition_variable not_empty_;
+  std::condition_variable not_full_;
+  std::atomic<uint32_t> waiters_{0};
+
+  std::atomic<size_t> high_watermark_{0};
+  std::atomic<uint64_t> pushed_{0};
+  std::atomic<uint64_t> popped_{0};
+  std::atomic<uint64_t> dropped_{0};
+};
+
+}  // namespace holoscan::ops
+
+#endif /* COMMON_BOUNDED_QUEUE_HPP */
@@ -18,10 +18,12 @@
 #ifndef COMMON_CONDITIONAL_VARIABLE_QUEUE_HPP
 #define COMMON_CONDITIONAL_VARIABLE_QUEUE_HPP
 
+#include <chrono>
 #include <queue>
 
 #include <holoscan/holoscan.hpp>
 
+#include "bounded_queue.hpp"
 #include "holoscan.pb.h"
 
 using holoscan::entity::EntityResponse;
@@ -30,41 +32,46 @@ namespace holoscan::ops {
 
 using namespace holoscan;
 
+/// default capacity of the gRPC queues
+constexpr size_t kDefaultQueueCapacity = 128;
+
 /*
  * @class ConditionVariableQueue
  * @brief This class is a Holoscan Resource that is responsible for storing a queue of data entities.
  *
- * A mutex and a condition variable are used to control access to the queue.
+ * The queue is a BoundedQueue, pop() waits for data. When the queue is full, push() blocks, drops
+ * the oldest or drops the new entity, as selected by the overflow policy. For live video,
+ * dropping a stale frame keeps the latency bounded when the remote endpoint can't keep up.
  */
 template <typename DataT>
 class ConditionVariableQueue : public Resource {
  public:
   HOLOSCAN_RESOURCE_FORWARD_ARGS_SUPER(ConditionVariableQueue, Resource)
-  ConditionVariableQueue() : queue_() {}
-  explicit ConditionVariableQueue(std::queue<DataT>& queue) : queue_(queue) {}
-
-  void push(DataT value) {
-    std::lock_guard<std::mutex> lock(response_available_mutex_);
-    queue_.push(value);
-    data_available_condition_.notify_one();
+  ConditionVariableQueue() : queue_(kDefaultQueueCapacity) {}
+  ConditionVariableQueue(size_t capacity, QueueOverflowPolicy policy) : queue_(capacity, policy) {}
+  explicit ConditionVariableQueue(std::queue<DataT>& queue) : queue_(kDefaultQueueCapacity) {
+    for (; !queue.empty(); queue.pop()) { queue_.push(queue.front()); }
   }
 
-  DataT pop() {
-    std::unique_lock<std::mutex> lock(response_available_mutex_);
-    data_available_condition_.wait(lock, [this]() { return !queue_.empty(); });
-    auto item = queue_.front();
-    queue_.pop();
-    return item;
-  }
+  /// @return false if the value was dropped by the overflow policy
+  bool push(DataT value) { return queue_.push(std::move(value)); }
+
+  DataT pop() { return queue_.pop(); }
 
-  bool empty() {
-    return queue_.empty();
+  /// @return false if no data became available within the timeout
+  bool pop(DataT& value, std::chrono::milliseconds timeout) { return queue_.pop(value, timeout); }
+
+  bool empty() { return queue_.empty(); }
+
+  /// Drops every queued value
+  void clear() {
+    for (DataT value; queue_.try_pop(value);) {}
   }
 
+  QueueMetrics metrics() const { return queue_.metrics(); }
+
  private:
-  std::queue<DataT> queue_;
-  std::condition_variable data_available_condition_;
-  std::mutex response_available_mutex_;
+  BoundedQueue<DataT> queue_;
 };
 
 }  // namespace holoscan::ops
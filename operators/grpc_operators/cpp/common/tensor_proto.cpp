@@ -17,6 +17,9 @@
 
 #include "tensor_proto.hpp"
 
+#include <cstring>
+#include <string>
+
 namespace holoscan::ops {
 
 #ifndef CUDA_TRY
@@ -80,6 +83,9 @@ void TensorProto::gxf_tensor_to_proto(
         throw std::runtime_error("Unsupported primitive type");
     }
   }
+
+  // the device to host copies write to the message, wait for them before it is serialized
+  CUDA_TRY(cudaStreamSynchronize(cuda_stream));
 }
 
 template <typename T>
@@ -89,10 +95,12 @@ void TensorProto::copy_data_to_proto(const nvidia::gxf::Handle<nvidia::gxf::Tens
   if ((*tensor).storage_type() == nvidia::gxf::MemoryStorageType::kDevice) {
     void* in_data_ptr = (*tensor).pointer();
     size_t data_size = (*tensor).bytes_size();
-    std::vector<T> in_data(data_size);
-    CUDA_TRY(cudaMemcpyAsync(
-        in_data.data(), in_data_ptr, data_size, cudaMemcpyDeviceToHost, cuda_stream));
-    tensor_proto.set_data(in_data.data(), data_size);
+    // copy straight into the buffer owned by the message, a protobuf bytes field can't alias
+    // external memory
+    std::string* data = tensor_proto.mutable_data();
+    data->resize(data_size);
+    CUDA_TRY(
+        cudaMemcpyAsync(data->data(), in_data_ptr, data_size, cudaMemcpyDeviceToHost, cuda_stream));
     tensor_proto.set_memory_storage_type(holoscan::entity::Tensor::kDevice);
   } else {
     tensor_proto.set_data((*tensor).pointer(), (*tensor).size());
@@ -156,7 +164,7 @@ void TensorProto::copy_data_to_tensor(const ::holoscan::entity::Tensor& tensor_p
                              cudaMemcpyHostToDevice,
                              cuda_stream));
   } else {
-    std::copy(tensor_proto.data().begin(), tensor_proto.data().end(), (*tensor).pointer());
+    std::memcpy((*tensor).pointer(), tensor_proto.data().data(), tensor_proto.data().size());
   }
 }
 
@@ -35,22 +35,61 @@ std::shared_ptr<ApplicationFactory> ApplicationFactory::get_instance() {
 }
 
 void ApplicationFactory::register_application(const std::string& service_name,
-                                              create_application_instance_func func) {
+                                              create_application_instance_func func,
+                                              uint32_t pool_size) {
+  std::lock_guard<std::mutex> lock(mutex_);
   if (application_registry_.find(service_name) != application_registry_.end()) {
     HOLOSCAN_LOG_WARN("Overwriting existing application registry: {}", service_name);
   }
   application_registry_[service_name] = func;
+
+  auto& pool = application_pools_[service_name];
+  for (auto& pooled : pool) { stop_application_instance(pooled.application); }
+  pool.clear();
+  if (pool_size == 0) {
+    application_pools_.erase(service_name);
+    return;
+  }
+
+  // Start the instances now so the first RPCs don't wait for the engines and memory pools. The
+  // request operator keeps ticking with empty queues while an instance is idle.
+  HOLOSCAN_LOG_INFO("Creating {} pooled application instances for {}", pool_size, service_name);
+  pool.resize(pool_size);
+  for (auto& pooled : pool) {
+    std::queue<std::shared_ptr<nvidia::gxf::Entity>> incoming_request_queue;
+    std::queue<std::shared_ptr<EntityResponse>> outgoing_response_queue;
+    pooled.application = func(incoming_request_queue, outgoing_response_queue);
+    pooled.application.instance->start_streaming();
+  }
 }
 
 std::shared_ptr<HoloscanGrpcApplication> ApplicationFactory::create_application_instance(
     const std::string& service_name,
     std::queue<std::shared_ptr<nvidia::gxf::Entity>>& incoming_request_queue,
     std::queue<std::shared_ptr<EntityResponse>>& outgoing_response_queue) {
+  std::lock_guard<std::mutex> lock(mutex_);
   if (application_registry_.find(service_name) == application_registry_.end()) {
     HOLOSCAN_LOG_ERROR("Application not found in registry: {}", service_name);
     return nullptr;
   }
 
+  auto pool = application_pools_.find(service_name);
+  if (pool != application_pools_.end()) {
+    for (size_t index = 0; index < pool->second.size(); ++index) {
+      auto& pooled = pool->second[index];
+      if (pooled.in_use) { continue; }
+      // Drop what the previous RPC left in flight
+      pooled.application.instance->get_request_queue()->clear();
+      pooled.application.instance->get_response_queue()->clear();
+      pooled.in_use = true;
+      HOLOSCAN_LOG_INFO("Using pooled application instance {} for {}", index, service_name);
+      return pooled.application.instance;
+    }
+    HOLOSCAN_LOG_WARN("All {} application instances are busy: {}", pool->second.size(),
+                      service_name);
+    return nullptr;
+  }
+
   if (application_instances_.find(service_name) != application_instances_.end()) {
     HOLOSCAN_LOG_WARN("Another application instance is running: {}", service_name);
     return nullptr;
@@ -66,15 +105,44 @@ std::shared_ptr<HoloscanGrpcApplication> ApplicationFactory::create_application_
 
 void ApplicationFactory::destroy_application_instance(
     std::shared_ptr<HoloscanGrpcApplication> application_instance) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  for (auto& [service_name, pool] : application_pools_) {
+    for (size_t index = 0; index < pool.size(); ++index) {
+      if (pool[index].application.instance == application_instance) {
+        pool[index].in_use = false;
+        HOLOSCAN_LOG_INFO("Application instance {} returned to the pool of {}", index,
+                          service_name);
+        return;
+      }
+    }
+  }
+
   for (auto& [service_name, instance] : application_instances_) {
     if (instance.instance == application_instance) {
-      instance.instance->stop_streaming();
-      instance.future.wait_for(std::chrono::seconds(1));
-      if (instance.tracker != nullptr) { instance.tracker->print(); }
+      stop_application_instance(instance);
       application_instances_.erase(service_name);
       HOLOSCAN_LOG_INFO("Application instance deleted for {}", service_name);
       return;
     }
   }
 }
+
+void ApplicationFactory::destroy_all_application_instances() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  for (auto& [service_name, pool] : application_pools_) {
+    for (auto& pooled : pool) { stop_application_instance(pooled.application); }
+    pool.clear();
+  }
+  for (auto& [service_name, instance] : application_instances_) {
+    stop_application_instance(instance);
+  }
+  application_instances_.clear();
+}
+
+void ApplicationFactory::stop_application_instance(ApplicationInstance& instance) {
+  if (instance.instance == nullptr) { return; }
+  instance.instance->stop_streaming();
+  instance.future.wait_for(std::chrono::seconds(1));
+  if (instance.tracker != nullptr) { instance.tracker->print(); }
+}
 }  // namespace holoscan::ops
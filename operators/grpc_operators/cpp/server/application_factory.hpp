@@ -19,8 +19,12 @@
 #define SERVER_APPLICATION_FACTORY_HPP
 
 #include <functional>
+#include <map>
 #include <memory>
+#include <mutex>
 #include <queue>
+#include <string>
+#include <vector>
 
 #include <gxf/core/entity.hpp>
 #include <holoscan/holoscan.hpp>
@@ -93,18 +97,30 @@ class ApplicationFactory {
   /**
    * @brief Register an application creation function with a service name.
    *
+   * Without a pool, an application instance is created for each RPC and only one RPC is served at
+   * a time. With a pool, `pool_size` instances are created and started right away, so that their
+   * engines are loaded and their memory pools allocated before the first RPC. Each RPC is then
+   * served by an idle instance of the pool, up to `pool_size` concurrent RPCs, and the instance is
+   * returned to the pool when the RPC completes.
+   *
    * @param service_name The name of the service.
    * @param func The function to create an application instance.
+   * @param pool_size The number of pre-warmed application instances, 0 to create one per RPC.
    */
-  void register_application(const std::string& service_name, create_application_instance_func func);
+  void register_application(const std::string& service_name, create_application_instance_func func,
+                            uint32_t pool_size = 0);
 
   /**
    * @brief Create an instance of HoloscanGrpcApplication.
    *
+   * When the service has a pool, an idle instance of the pool is handed out instead, with its
+   * queues emptied of anything left by the previous RPC.
+   *
    * @param service_name The name of the service.
    * @param incoming_request_queue A queue for incoming requests.
    * @param outgoing_response_queue A queue for outgoing responses.
-   * @return A shared pointer to the created HoloscanGrpcApplication instance.
+   * @return A shared pointer to the created HoloscanGrpcApplication instance, or nullptr if the
+   * service is unknown or all its instances are busy.
    */
   std::shared_ptr<HoloscanGrpcApplication> create_application_instance(
       const std::string& service_name,
@@ -119,6 +135,11 @@ class ApplicationFactory {
    */
   void destroy_application_instance(std::shared_ptr<HoloscanGrpcApplication> application_instance);
 
+  /**
+   * @brief Stop and destroy all application instances, including the idle pooled ones.
+   */
+  void destroy_all_application_instances();
+
  private:
   /**
    * @class ApplicationFactoryDeleter
@@ -132,11 +153,24 @@ class ApplicationFactory {
     void operator()(ApplicationFactory* factory) { delete factory; }
   };
 
+  /**
+   * @struct PooledApplicationInstance
+   * @brief A pre-warmed application instance and whether an RPC is using it.
+   */
+  struct PooledApplicationInstance {
+    ApplicationInstance application;
+    bool in_use = false;
+  };
+
   ApplicationFactory();
   ~ApplicationFactory();
 
+  void stop_application_instance(ApplicationInstance& instance);
+
+  std::mutex mutex_;
   std::map<std::string, create_application_instance_func> application_registry_;
   std::map<std::string, ApplicationInstance> application_instances_;
+  std::map<std::string, std::vector<PooledApplicationInstance>> application_pools_;
 };
 }  // namespace holoscan::ops
 #endif /* SERVER_APPLICATION_FACTORY_HPP */
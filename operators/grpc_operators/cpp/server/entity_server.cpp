@@ -19,6 +19,11 @@
 
 namespace holoscan::ops {
 
+/// Period of the latency reports of a running session
+constexpr std::chrono::seconds kLatencyReportPeriod(10);
+/// Requests waiting for a response beyond this are forgotten, e.g. when the pipeline drops frames
+constexpr size_t kMaxPendingRequests = kDefaultQueueCapacity;
+
 HoloscanEntityServiceImpl::HoloscanEntityServiceImpl(
     on_new_entity_stream_rpc new_entity_stream_rpc,
     on_entity_stream_rpc_complete entity_stream_rpc_complete)
@@ -35,16 +40,28 @@ grpc::ServerBidiReactor<EntityRequest, EntityResponse>* HoloscanEntityServiceImp
   return new EntityStreamInternal(
       this,
       new_entity_stream_rpc_("EntityStream", incoming_request_queue, outgoing_response_queue),
-      entity_stream_rpc_complete_);
+      entity_stream_rpc_complete_,
+      context->peer());
 }
 
 HoloscanEntityServiceImpl::EntityStreamInternal::EntityStreamInternal(
     HoloscanEntityServiceImpl* server, std::shared_ptr<HoloscanGrpcApplication> app,
-    on_entity_stream_rpc_complete entity_stream_rpc_complete)
-    : server_(server), app_(app), entity_stream_rpc_complete_(entity_stream_rpc_complete) {
+    on_entity_stream_rpc_complete entity_stream_rpc_complete, const std::string& peer)
+    : server_(server),
+      app_(app),
+      entity_stream_rpc_complete_(entity_stream_rpc_complete),
+      peer_(peer) {
   if (app == nullptr) {
-    Finish(grpc::Status(grpc::StatusCode::RESOURCE_EXHAUSTED, "Resource occupied"));
+    HOLOSCAN_LOG_WARN("grpc server: no application instance available, rejecting the RPC ({} "
+                      "active sessions)",
+                      server_->active_sessions_.load());
+    Finish(grpc::Status(grpc::StatusCode::RESOURCE_EXHAUSTED, "All sessions are in use"));
   } else {
+    session_id_ = server_->next_session_id_++;
+    session_start_ = std::chrono::steady_clock::now();
+    last_latency_report_ = session_start_;
+    HOLOSCAN_LOG_INFO("grpc server: session {} started, {} active sessions", session_id_,
+                      ++server_->active_sessions_);
     last_network_activity_ = std::chrono::time_point<std::chrono::system_clock>::min();
     writer_thread_ = std::thread(&EntityStreamInternal::processOutgoingQueue, this);
     Write();
@@ -66,6 +83,7 @@ void HoloscanEntityServiceImpl::EntityStreamInternal::OnWriteDone(bool ok) {
 void HoloscanEntityServiceImpl::EntityStreamInternal::OnReadDone(bool ok) {
   last_network_activity_ = std::chrono::high_resolution_clock::now();
   if (ok) {
+    record_request();
     app_->enqueue_request(request_);
     HOLOSCAN_LOG_DEBUG("grpc server: Request received and queued for processing");
     Read();
@@ -76,6 +94,13 @@ void HoloscanEntityServiceImpl::EntityStreamInternal::OnReadDone(bool ok) {
 
 void HoloscanEntityServiceImpl::EntityStreamInternal::OnDone() {
   HOLOSCAN_LOG_DEBUG("grpc server: server streaming complete");
+  if (app_ != nullptr) {
+    {
+      std::lock_guard<std::mutex> lock(latency_mutex_);
+      log_latency("completed", 0);
+    }
+    --server_->active_sessions_;
+  }
   entity_stream_rpc_complete_(app_);
   delete this;
 }
@@ -90,6 +115,7 @@ void HoloscanEntityServiceImpl::EntityStreamInternal::Write() {
     write_mutex_.lock();
     std::shared_ptr<EntityResponse> response;
     response = app_->dequeue_response();
+    record_response();
     StartWrite(&*response);
     HOLOSCAN_LOG_DEBUG("grpc server: Sending response to client");
   }
@@ -103,7 +129,62 @@ void HoloscanEntityServiceImpl::EntityStreamInternal::processOutgoingQueue() {
       break;
     }
     Write();
+
+    std::lock_guard<std::mutex> lock(latency_mutex_);
+    if (std::chrono::steady_clock::now() - last_latency_report_ >= kLatencyReportPeriod) {
+      log_latency("running", reported_latencies_);
+      reported_latencies_ = latencies_ms_.size();
+      last_latency_report_ = std::chrono::steady_clock::now();
+    }
+  }
+}
+
+void HoloscanEntityServiceImpl::EntityStreamInternal::record_request() {
+  std::lock_guard<std::mutex> lock(latency_mutex_);
+  ++requests_;
+  if (pending_requests_.size() == kMaxPendingRequests) { pending_requests_.pop_front(); }
+  pending_requests_.push_back(std::chrono::steady_clock::now());
+}
+
+void HoloscanEntityServiceImpl::EntityStreamInternal::record_response() {
+  std::lock_guard<std::mutex> lock(latency_mutex_);
+  if (pending_requests_.empty()) { return; }
+  const std::chrono::duration<float, std::milli> latency =
+      std::chrono::steady_clock::now() - pending_requests_.front();
+  pending_requests_.pop_front();
+  latencies_ms_.push_back(latency.count());
+}
+
+void HoloscanEntityServiceImpl::EntityStreamInternal::log_latency(const char* label,
+                                                                  size_t first) {
+  const std::chrono::duration<float> elapsed = std::chrono::steady_clock::now() - session_start_;
+  if (first >= latencies_ms_.size()) {
+    HOLOSCAN_LOG_INFO("grpc server: session {} ({}) {} after {:.1f}s: {} requests, no responses",
+                      session_id_, peer_, label, elapsed.count(), requests_);
+    return;
   }
+
+  std::vector<float> latencies(latencies_ms_.begin() + first, latencies_ms_.end());
+  std::sort(latencies.begin(), latencies.end());
+  auto percentile = [&latencies](float p) {
+    return latencies[static_cast<size_t>(p * (latencies.size() - 1))];
+  };
+  float sum = 0.f;
+  for (float latency : latencies) { sum += latency; }
+  HOLOSCAN_LOG_INFO(
+      "grpc server: session {} ({}) {} after {:.1f}s: {} requests, {} responses, latency (ms) "
+      "min {:.2f}, avg {:.2f}, p50 {:.2f}, p99 {:.2f}, max {:.2f}",
+      session_id_,
+      peer_,
+      label,
+      elapsed.count(),
+      requests_,
+      latencies_ms_.size(),
+      latencies.front(),
+      sum / latencies.size(),
+      percentile(0.5f),
+      percentile(0.99f),
+      latencies.back());
 }
 
 bool HoloscanEntityServiceImpl::EntityStreamInternal::processing_timed_out() {
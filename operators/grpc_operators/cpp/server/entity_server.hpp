@@ -23,9 +23,13 @@
 #include <grpc/grpc.h>
 #include <grpcpp/grpcpp.h>
 #include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <deque>
 #include <functional>
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "holoscan.grpc.pb.h"
 #include "holoscan.pb.h"
@@ -69,6 +73,12 @@ using on_entity_stream_rpc_complete = std::function<void(std::shared_ptr<Holosca
  * @class HoloscanEntityServiceImpl
  * @brief Implementation of the gRPC Entity Service for Holoscan.
  *
+ * Each RPC is a session served by the application instance returned by `new_entity_stream_rpc`.
+ * When no instance is available, the RPC is rejected with `RESOURCE_EXHAUSTED`. The latency of
+ * each session, from a request being received to its response being sent, is logged
+ * periodically and when the session completes. Responses are assumed to be returned in the order
+ * of the requests.
+ *
  * @param new_entity_stream_rpc Callback function to create a new instance of a Holoscan
  * application.
  * @param entity_stream_rpc_complete Callback function to handle the completion of an entity stream
@@ -96,7 +106,8 @@ class HoloscanEntityServiceImpl final : public Entity::CallbackService {
    public:
     EntityStreamInternal(HoloscanEntityServiceImpl* server,
                          std::shared_ptr<HoloscanGrpcApplication> app,
-                         on_entity_stream_rpc_complete entity_stream_rpc_complete);
+                         on_entity_stream_rpc_complete entity_stream_rpc_complete,
+                         const std::string& peer);
 
     ~EntityStreamInternal();
 
@@ -110,6 +121,11 @@ class HoloscanEntityServiceImpl final : public Entity::CallbackService {
     void processOutgoingQueue();
     bool processing_timed_out();
 
+    void record_request();
+    void record_response();
+    // expects latency_mutex_ to be held
+    void log_latency(const char* label, size_t first);
+
     std::shared_ptr<HoloscanGrpcApplication> app_;
     on_entity_stream_rpc_complete entity_stream_rpc_complete_;
     HoloscanEntityServiceImpl* server_;
@@ -117,6 +133,17 @@ class HoloscanEntityServiceImpl final : public Entity::CallbackService {
     std::chrono::time_point<std::chrono::system_clock> last_network_activity_;
     bool is_read_done_ = false;
 
+    // per-session latency metrics
+    uint64_t session_id_ = 0;
+    std::string peer_;
+    std::chrono::steady_clock::time_point session_start_;
+    std::chrono::steady_clock::time_point last_latency_report_;
+    std::mutex latency_mutex_;
+    std::deque<std::chrono::steady_clock::time_point> pending_requests_;
+    std::vector<float> latencies_ms_;
+    size_t reported_latencies_ = 0;
+    uint64_t requests_ = 0;
+
     // std::mutex read_mutex_;
     std::mutex write_mutex_;
     std::thread writer_thread_;
@@ -124,6 +151,8 @@ class HoloscanEntityServiceImpl final : public Entity::CallbackService {
 
   on_new_entity_stream_rpc new_entity_stream_rpc_;
   on_entity_stream_rpc_complete entity_stream_rpc_complete_;
+  std::atomic<uint64_t> next_session_id_{1};
+  std::atomic<uint32_t> active_sessions_{0};
 };
 
 }  // namespace holoscan::ops
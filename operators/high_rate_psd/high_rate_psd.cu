@@ -3,11 +3,46 @@
 // SPDX-License-Identifier: Apache-2.0
 #include "high_rate_psd.hpp"
 
-using in_t = std::tuple<tensor_t<complex, 2>, cudaStream_t>;
-using out_t = std::tuple<tensor_t<float, 2>, cudaStream_t>;
+#include <any>
+#include <stdexcept>
+#include <type_traits>
+#include <cuda_bf16.h>
+#include <cuda_fp16.h>
+
+template <typename T>
+using stream_tensor_t = std::tuple<tensor_t<T, 2>, cudaStream_t>;
+using in_t = stream_tensor_t<complex>;
+using out_t = stream_tensor_t<float>;
 
 namespace holoscan::ops {
 
+namespace {
+
+__device__ inline void store_power(float& dst, float v) {
+    dst = v;
+}
+
+__device__ inline void store_power(matxFp16& dst, float v) {
+    reinterpret_cast<__half&>(dst) = __float2half_rn(v);
+}
+
+__device__ inline void store_power(matxBf16& dst, float v) {
+    reinterpret_cast<__nv_bfloat16&>(dst) = __float2bfloat16_rn(v);
+}
+
+// |x|^2 * scale, computed in fp32 whatever the input and output are stored in
+template <typename TIn, typename TOut>
+__global__ void power_kernel(const TIn* in, TOut* out, float scale, size_t num_samples) {
+    const size_t idx = static_cast<size_t>(blockIdx.x) * blockDim.x + threadIdx.x;
+    if (idx >= num_samples) {
+        return;
+    }
+    const float2 x = load_sample(in[idx]);
+    store_power(out[idx], (x.x * x.x + x.y * x.y) * scale);
+}
+
+}  // namespace
+
 void HighRatePSD::setup(OperatorSpec& spec) {
     spec.input<in_t>("in");
     spec.output<out_t>("out");
@@ -23,29 +58,132 @@ void HighRatePSD::setup(OperatorSpec& spec) {
         "num_channels",
         "Number of channels",
         "Number of channels to allocate memory for");
+    spec.param(first_channel,
+        "first_channel",
+        "First channel",
+        "Channel number of channel 0 of this operator's buffers",
+        static_cast<uint16_t>(0));
+    spec.param(device,
+        "device",
+        "CUDA device",
+        "CUDA device the operator runs on",
+        0);
+    spec.param(workspace,
+        "workspace",
+        "Workspace",
+        "Optional MatxWorkspacePool holding the output buffer");
+    spec.param(precision,
+        "precision",
+        "Precision",
+        "Precision of the emitted PSD: fp32, fp16 or bf16",
+        std::string("fp32"));
+}
+
+template <typename F>
+void HighRatePSD::with_outputs(F&& f) {
+    if (output_precision == "fp16") {
+        f(outputs_fp16);
+    } else if (output_precision == "bf16") {
+        f(outputs_bf16);
+    } else {
+        f(outputs);
+    }
 }
 
 void HighRatePSD::initialize() {
     holoscan::Operator::initialize();
-    make_tensor(outputs,
-                {num_channels.get(), num_bursts.get(), burst_size.get()},
-                MATX_DEVICE_MEMORY);
+    cudaSetDevice(device.get());
+    output_precision = precision.get();
+    if (output_precision != "fp32" && output_precision != "fp16" && output_precision != "bf16") {
+        HOLOSCAN_LOG_CRITICAL("Unknown precision {}, expected fp32, fp16 or bf16",
+            output_precision);
+        throw std::runtime_error("Unknown precision");
+    }
+    if (pooled()) {
+        with_outputs([&](auto& buffer) {
+            using T = typename std::decay_t<decltype(buffer)>::value_type;
+            workspace.get()->reserve<T>(name() + "/outputs",
+                {num_channels.get(), num_bursts.get(), burst_size.get()});
+        });
+    } else {
+        with_outputs([&](auto& buffer) {
+            make_tensor(buffer,
+                        {num_channels.get(), num_bursts.get(), burst_size.get()},
+                        MATX_DEVICE_MEMORY);
+        });
+    }
     scale_factor = 1.0 / pow(burst_size.get(), 2);
+    // A noise floor scaled by 1 / N^2 is below the fp16 normal range, so fp16 PSDs are
+    // emitted N times larger. bf16 has the range of fp32.
+    output_scale = output_precision == "fp16" ? static_cast<float>(burst_size.get()) : 1.0f;
 }
 
-void HighRatePSD::compute(InputContext& op_input, OutputContext& op_output, ExecutionContext&) {
-    auto input = op_input.receive<in_t>("in").value();
+void HighRatePSD::start() {
+    cudaSetDevice(device.get());
+    if (pooled()) {
+        with_outputs([&](auto& buffer) {
+            using T = typename std::decay_t<decltype(buffer)>::value_type;
+            buffer.Shallow(workspace.get()->tensor<T>(name() + "/outputs",
+                {num_channels.get(), num_bursts.get(), burst_size.get()}));
+        });
+    }
+}
+
+template <typename TIn, typename TOut>
+void HighRatePSD::power(const tensor_t<TIn, 2>& in, cudaStream_t stream,
+        tensor_t<TOut, 3>& buffer, OutputContext& op_output) {
     auto meta = metadata();
-    auto channel_num = meta->get<uint16_t>("channel_number", 0);
-    auto out = slice<2>(outputs, {static_cast<index_t>(channel_num), 0, 0},
-            {matxDropDim, matxEnd, matxEnd});
+    // Undo the scale the FFT was computed with, and apply the one of the output
+    const double fft_scale = meta->get<float>("fft_scale", 1.0f);
+    const double scale = scale_factor * output_scale / (fft_scale * fft_scale);
+    meta->set(kPsdScaleKey, output_scale);
+
+    tensor_t<TOut, 2> out;
+    // Batched FFT output: the bursts of every channel, one after the other
+    if (meta->has_key("batched_channels")) {
+        out.Shallow(buffer.View({num_channels.get() * num_bursts.get(), burst_size.get()}));
+    } else {
+        const int channel_num = meta->get<uint16_t>("channel_number", 0) - first_channel.get();
+        if (channel_num < 0 || channel_num >= num_channels.get()) {
+            HOLOSCAN_LOG_CRITICAL("Channel {} is outside of channels {} to {}",
+                channel_num + first_channel.get(), first_channel.get(),
+                first_channel.get() + num_channels.get() - 1);
+            throw std::runtime_error("Invalid channel_number");
+        }
+        out.Shallow(slice<2>(buffer, {static_cast<index_t>(channel_num), 0, 0},
+                {matxDropDim, matxEnd, matxEnd}));
+    }
+
+    if constexpr (std::is_same_v<TIn, complex> && std::is_same_v<TOut, float>) {
+        (out = abs2(in) * scale).run(stream);
+    } else {
+        if (!in.IsContiguous() || in.TotalSize() != out.TotalSize()) {
+            HOLOSCAN_LOG_CRITICAL("Reduced precision PSDs need contiguous inputs of {} samples",
+                out.TotalSize());
+            throw std::runtime_error("Unsupported input layout");
+        }
+        const size_t num_samples = out.TotalSize();
+        const unsigned threads = 256;
+        const unsigned blocks = (num_samples + threads - 1) / threads;
+        power_kernel<<<blocks, threads, 0, stream>>>(
+            in.Data(), out.Data(), static_cast<float>(scale), num_samples);
+    }
 
-    (out = abs2(std::get<0>(input)) * scale_factor).run(std::get<1>(input));
     op_output.emit(
-        out_t {
+        stream_tensor_t<TOut> {
             out,
-            std::get<1>(input)
+            stream
         },
         "out");
 }
+
+void HighRatePSD::compute(InputContext& op_input, OutputContext& op_output, ExecutionContext&) {
+    cudaSetDevice(device.get());
+    auto message = op_input.receive<std::any>("in").value();
+    visit_stream_tensor<complex, complex_fp16, complex_bf16>(message, [&](auto& input) {
+        with_outputs([&](auto& buffer) {
+            power(std::get<0>(input), std::get<1>(input), buffer, op_output);
+        });
+    });
+}
 }  // namespace holoscan::ops
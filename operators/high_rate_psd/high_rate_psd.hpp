@@ -4,13 +4,14 @@
 #pragma once
 
 #include <cmath>
+#include <string>
 #include <matx.h>
 #include "holoscan/holoscan.hpp"
+#include "../matx_sample_types.hpp"
+#include "matx_workspace.hpp"
 
 using namespace matx;
 
-using complex = cuda::std::complex<float>;
-
 namespace holoscan::ops {
 class HighRatePSD : public Operator {
  public:
@@ -20,13 +21,34 @@ class HighRatePSD : public Operator {
 
   void initialize() override;
   void setup(OperatorSpec& spec) override;
+  void start() override;
   void compute(InputContext& input, OutputContext& output, ExecutionContext& context) override;
 
+  /// Metadata key holding the factor the emitted PSD is scaled by.
+  static constexpr const char* kPsdScaleKey = "psd_scale";
+
  private:
+  bool pooled() const { return workspace.has_value() && workspace.get() != nullptr; }
+  template <typename TIn, typename TOut>
+  void power(const tensor_t<TIn, 2>& in, cudaStream_t stream, tensor_t<TOut, 3>& buffer,
+             OutputContext& op_output);
+  // Calls f with the output buffer of the output precision
+  template <typename F>
+  void with_outputs(F&& f);
+
+  // Only the buffer of the output precision is allocated
   tensor_t<float, 3> outputs;
+  tensor_t<matxFp16, 3> outputs_fp16;
+  tensor_t<matxBf16, 3> outputs_bf16;
+  std::string output_precision;
+  float output_scale = 1.0f;
+  Parameter<std::shared_ptr<MatxWorkspacePool>> workspace;
   Parameter<uint16_t> num_channels;
+  Parameter<uint16_t> first_channel;
+  Parameter<int32_t> device;
   Parameter<int> burst_size;
   Parameter<int> num_bursts;
+  Parameter<std::string> precision;
   double scale_factor;
 };
 
@@ -0,0 +1,94 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "latency_probe.cuh"
+
+namespace holoscan::ops::latency_probe {
+
+namespace {
+
+constexpr uint32_t kSampleThreads = 128;
+
+__device__ inline float luma_at(const uint8_t* pixel, uint32_t channels) {
+  if (channels < 3) { return pixel[0]; }
+  return 0.299f * pixel[0] + 0.587f * pixel[1] + 0.114f * pixel[2];
+}
+
+__global__ void draw_pattern_kernel(uint8_t* image, uint32_t width, uint32_t height,
+                                    uint32_t channels, uint32_t x, uint32_t y, uint32_t cell_size,
+                                    uint64_t cells) {
+  const uint32_t column = blockIdx.x * blockDim.x + threadIdx.x;
+  const uint32_t row = blockIdx.y * blockDim.y + threadIdx.y;
+  if (column >= kCells * cell_size || row >= cell_size) { return; }
+  if (x + column >= width || y + row >= height) { return; }
+
+  const uint32_t cell = column / cell_size;
+  const uint8_t value = ((cells >> (kCells - 1 - cell)) & 1) ? 255 : 0;
+  uint8_t* pixel = image + (static_cast<size_t>(y + row) * width + x + column) * channels;
+  for (uint32_t channel = 0; channel < channels; ++channel) {
+    // keep the alpha channel opaque
+    pixel[channel] = channel == 3 ? 255 : value;
+  }
+}
+
+// One block per cell
+__global__ void sample_cells_kernel(const uint8_t* image, uint32_t width, uint32_t height,
+                                    uint32_t channels, CellCenters centers, int32_t radius,
+                                    float* luma) {
+  __shared__ float sums[kSampleThreads];
+  const float2 center = centers.centers[blockIdx.x];
+  const int32_t side = 2 * radius + 1;
+  const int32_t center_x = __float2int_rn(center.x);
+  const int32_t center_y = __float2int_rn(center.y);
+
+  float sum = 0.f;
+  for (int32_t index = threadIdx.x; index < side * side; index += blockDim.x) {
+    const int32_t px = min(max(center_x + index % side - radius, 0), int32_t(width) - 1);
+    const int32_t py = min(max(center_y + index / side - radius, 0), int32_t(height) - 1);
+    sum += luma_at(image + (static_cast<size_t>(py) * width + px) * channels, channels);
+  }
+  sums[threadIdx.x] = sum;
+  __syncthreads();
+  for (uint32_t stride = blockDim.x / 2; stride > 0; stride /= 2) {
+    if (threadIdx.x < stride) { sums[threadIdx.x] += sums[threadIdx.x + stride]; }
+    __syncthreads();
+  }
+  if (threadIdx.x == 0) { luma[blockIdx.x] = sums[0] / (side * side); }
+}
+
+}  // namespace
+
+void cuda_draw_pattern(uint8_t* image, uint32_t width, uint32_t height, uint32_t channels,
+                       uint32_t x, uint32_t y, uint32_t cell_size, uint64_t cells,
+                       cudaStream_t cuda_stream) {
+  const dim3 block(32, 8);
+  const dim3 grid((kCells * cell_size + block.x - 1) / block.x,
+                  (cell_size + block.y - 1) / block.y);
+  draw_pattern_kernel<<<grid, block, 0, cuda_stream>>>(
+      image, width, height, channels, x, y, cell_size, cells);
+  CUDA_TRY(cudaPeekAtLastError());
+}
+
+void cuda_sample_cells(const uint8_t* image, uint32_t width, uint32_t height, uint32_t channels,
+                       const CellCenters& centers, int32_t radius, float* luma,
+                       cudaStream_t cuda_stream) {
+  sample_cells_kernel<<<kCells, kSampleThreads, 0, cuda_stream>>>(
+      image, width, height, channels, centers, radius, luma);
+  CUDA_TRY(cudaPeekAtLastError());
+}
+
+}  // namespace holoscan::ops::latency_probe
@@ -0,0 +1,63 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef HOLOSCAN_OPERATORS_LATENCY_PROBE_LATENCY_PROBE_CUH
+#define HOLOSCAN_OPERATORS_LATENCY_PROBE_LATENCY_PROBE_CUH
+
+#include <cuda_runtime.h>
+
+#include <cstdint>
+#include <stdexcept>
+
+#include <holoscan/logger/logger.hpp>
+
+#include "latency_probe_pattern.hpp"
+
+#define CUDA_TRY(stmt)                                                                        \
+  {                                                                                           \
+    cudaError_t cuda_status = stmt;                                                           \
+    if (cudaSuccess != cuda_status) {                                                         \
+      HOLOSCAN_LOG_ERROR("CUDA runtime call {} in line {} of file {} failed with '{}' ({}).", \
+                         #stmt,                                                               \
+                         __LINE__,                                                            \
+                         __FILE__,                                                            \
+                         cudaGetErrorString(cuda_status),                                     \
+                         static_cast<int>(cuda_status));                                      \
+      throw std::runtime_error("CUDA runtime call failed");                                   \
+    }                                                                                         \
+  }
+
+namespace holoscan::ops::latency_probe {
+
+/// Center of each cell of the pattern in the captured image, in pixels
+struct CellCenters {
+  float2 centers[kCells];
+};
+
+/// Paint the cells, `cell_size` pixels square, from (x, y) into the uint8 HWC image
+void cuda_draw_pattern(uint8_t* image, uint32_t width, uint32_t height, uint32_t channels,
+                       uint32_t x, uint32_t y, uint32_t cell_size, uint64_t cells,
+                       cudaStream_t cuda_stream);
+
+/// Mean luma of the (2 * radius + 1)^2 pixels around each cell center of the uint8 HWC image
+void cuda_sample_cells(const uint8_t* image, uint32_t width, uint32_t height, uint32_t channels,
+                       const CellCenters& centers, int32_t radius, float* luma,
+                       cudaStream_t cuda_stream);
+
+}  // namespace holoscan::ops::latency_probe
+
+#endif /* HOLOSCAN_OPERATORS_LATENCY_PROBE_LATENCY_PROBE_CUH */
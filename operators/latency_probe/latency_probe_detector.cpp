@@ -0,0 +1,314 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "latency_probe_detector.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+#include <holoscan/core/execution_context.hpp>
+
+#include <gxf/std/tensor.hpp>
+
+#include "latency_probe.cuh"
+#include "latency_probe_utils.hpp"
+
+namespace holoscan::ops {
+
+namespace {
+
+/// Latencies above this are misread timestamps
+constexpr uint32_t kMaxLatencyUs = 10'000'000;
+
+/// @return the homography mapping the `from` quadrilateral to the `to` one, row-major
+std::array<double, 9> homography(const std::array<float2, 4>& from,
+                                 const std::array<float2, 4>& to) {
+  // 8 equations u = (h0 x + h1 y + h2) / (h6 x + h7 y + 1), v = (h3 x + h4 y + h5) / (...)
+  double system[8][9];
+  for (int corner = 0; corner < 4; ++corner) {
+    const double x = from[corner].x, y = from[corner].y;
+    const double u = to[corner].x, v = to[corner].y;
+    const double rows[2][9] = {{x, y, 1, 0, 0, 0, -u * x, -u * y, u},
+                               {0, 0, 0, x, y, 1, -v * x, -v * y, v}};
+    std::copy(rows[0], rows[0] + 9, system[2 * corner]);
+    std::copy(rows[1], rows[1] + 9, system[2 * corner + 1]);
+  }
+  // Gaussian elimination with partial pivoting
+  for (int column = 0; column < 8; ++column) {
+    int pivot = column;
+    for (int row = column + 1; row < 8; ++row) {
+      if (std::abs(system[row][column]) > std::abs(system[pivot][column])) { pivot = row; }
+    }
+    if (std::abs(system[pivot][column]) < 1e-12) {
+      throw std::runtime_error("The display corners must form a quadrilateral.");
+    }
+    std::swap(system[column], system[pivot]);
+    for (int row = 0; row < 8; ++row) {
+      if (row == column) { continue; }
+      const double factor = system[row][column] / system[column][column];
+      for (int index = column; index < 9; ++index) {
+        system[row][index] -= factor * system[column][index];
+      }
+    }
+  }
+  std::array<double, 9> matrix;
+  for (int row = 0; row < 8; ++row) { matrix[row] = system[row][8] / system[row][row]; }
+  matrix[8] = 1.;
+  return matrix;
+}
+
+}  // namespace
+
+void LatencyProbeDetectorOp::setup(OperatorSpec& spec) {
+  spec.input<gxf::Entity>("in");
+  spec.output<gxf::Entity>("out");
+
+  spec.param(tensor_name_,
+             "tensor_name",
+             "Tensor Name",
+             "Name of the frame tensor, the first tensor if empty.",
+             std::string(""));
+  spec.param(display_corners_,
+             "display_corners",
+             "Display Corners",
+             "Top left, top right, bottom right and bottom left corners of the display in the "
+             "captured frame, the whole frame if empty.",
+             std::vector<float>());
+  spec.param(display_size_,
+             "display_size",
+             "Display Size",
+             "Width and height of the displayed frames, the captured frame size if empty.",
+             std::vector<uint32_t>());
+  spec.param(pattern_x_, "pattern_x", "Pattern X", "Column of the pattern.", 16U);
+  spec.param(pattern_y_, "pattern_y", "Pattern Y", "Row of the pattern.", 16U);
+  spec.param(cell_size_, "cell_size", "Cell Size", "Size of the pattern cells in pixels.", 16U);
+  spec.param(sample_radius_,
+             "sample_radius",
+             "Sample Radius",
+             "Radius in pixels of the patch sampled at the center of each cell.",
+             2);
+  spec.param(report_period_,
+             "report_period",
+             "Report Period",
+             "Period in seconds of the latency logs.",
+             10.f);
+  spec.param(latency_file_,
+             "latency_file",
+             "Latency File",
+             "CSV file to write each measured latency to, none if empty.",
+             std::string(""));
+
+  cuda_stream_handler_.define_params(spec);
+}
+
+void LatencyProbeDetectorOp::start() {
+  if (!display_corners_.get().empty() && display_corners_.get().size() != 8) {
+    throw std::runtime_error("display_corners must have 8 coordinates.");
+  }
+  if (!display_size_.get().empty() && display_size_.get().size() != 2) {
+    throw std::runtime_error("display_size must have a width and a height.");
+  }
+  for (auto& slot : slots_) {
+    CUDA_TRY(cudaMalloc(&slot.device_luma, latency_probe::kCells * sizeof(float)));
+    CUDA_TRY(cudaMallocHost(&slot.host_luma, latency_probe::kCells * sizeof(float)));
+    CUDA_TRY(cudaEventCreateWithFlags(&slot.read_back, cudaEventDisableTiming));
+  }
+  if (!latency_file_.get().empty()) {
+    latency_file_stream_.open(latency_file_.get(), std::ios::trunc);
+    if (!latency_file_stream_) {
+      throw std::runtime_error(fmt::format("Failed to open {}.", latency_file_.get()));
+    }
+    latency_file_stream_ << "capture_timestamp_us,latency_us\n";
+  }
+  last_report_ = std::chrono::steady_clock::now();
+}
+
+void LatencyProbeDetectorOp::stop() {
+  collect(true);
+  report();
+  if (count_) {
+    HOLOSCAN_LOG_INFO(
+        "Glass-to-glass latency: {} frames, avg {:.3f} ms, min {:.3f} ms, max {:.3f} ms, "
+        "{} frames not sampled",
+        count_,
+        sum_us_ / 1000. / count_,
+        min_us_ / 1000.,
+        max_us_ / 1000.,
+        skipped_frames_);
+  } else {
+    HOLOSCAN_LOG_WARN("No latency probe pattern was detected");
+  }
+  for (auto& slot : slots_) {
+    if (slot.read_back) { CUDA_TRY(cudaEventDestroy(slot.read_back)); }
+    if (slot.host_luma) { CUDA_TRY(cudaFreeHost(slot.host_luma)); }
+    if (slot.device_luma) { CUDA_TRY(cudaFree(slot.device_luma)); }
+    slot = Slot();
+  }
+  latency_file_stream_.close();
+}
+
+void LatencyProbeDetectorOp::compute(InputContext& op_input, OutputContext& op_output,
+                                     ExecutionContext& context) {
+  // Time of the capture, as close as possible to the source
+  const uint32_t capture_timestamp = latency_probe::timestamp_now();
+  auto in_message = op_input.receive<gxf::Entity>("in").value();
+
+  gxf_result_t stream_handler_result =
+      cuda_stream_handler_.from_message(context.context(), in_message);
+  if (stream_handler_result != GXF_SUCCESS) {
+    throw std::runtime_error("Failed to get the CUDA stream from incoming messages");
+  }
+
+  collect(false);
+
+  Slot& slot = slots_[next_slot_];
+  if (slot.pending) {
+    // all the read backs are in flight, the GPU is far behind
+    ++skipped_frames_;
+  } else {
+    auto frame = latency_probe::get_frame(in_message, tensor_name_.get());
+    const uint32_t height = frame->shape()[0];
+    const uint32_t width = frame->shape()[1];
+    if (width != frame_width_ || height != frame_height_) { update_cell_centers(width, height); }
+
+    latency_probe::CellCenters centers;
+    for (uint32_t cell = 0; cell < latency_probe::kCells; ++cell) {
+      centers.centers[cell] = make_float2(cell_centers_[2 * cell], cell_centers_[2 * cell + 1]);
+    }
+    const cudaStream_t cuda_stream = cuda_stream_handler_.get_cuda_stream(context.context());
+    latency_probe::cuda_sample_cells(static_cast<const uint8_t*>(frame->data()),
+                                     width,
+                                     height,
+                                     frame->shape()[2],
+                                     centers,
+                                     sample_radius_.get(),
+                                     slot.device_luma,
+                                     cuda_stream);
+    CUDA_TRY(cudaMemcpyAsync(slot.host_luma,
+                             slot.device_luma,
+                             latency_probe::kCells * sizeof(float),
+                             cudaMemcpyDeviceToHost,
+                             cuda_stream));
+    CUDA_TRY(cudaEventRecord(slot.read_back, cuda_stream));
+    slot.capture_timestamp = capture_timestamp;
+    slot.pending = true;
+    next_slot_ = (next_slot_ + 1) % kSlots;
+  }
+
+  nvidia::gxf::Expected<nvidia::gxf::Entity> out_message(in_message);
+  stream_handler_result = cuda_stream_handler_.to_message(out_message);
+  if (stream_handler_result != GXF_SUCCESS) {
+    throw std::runtime_error("Failed to add the CUDA stream to the outgoing messages");
+  }
+  op_output.emit(in_message, "out");
+
+  const std::chrono::duration<float> elapsed = std::chrono::steady_clock::now() - last_report_;
+  if (elapsed.count() >= report_period_.get()) { report(); }
+}
+
+void LatencyProbeDetectorOp::collect(bool wait) {
+  // read backs complete in order
+  while (slots_[oldest_slot_].pending) {
+    Slot& slot = slots_[oldest_slot_];
+    if (wait) {
+      CUDA_TRY(cudaEventSynchronize(slot.read_back));
+    } else {
+      const cudaError_t status = cudaEventQuery(slot.read_back);
+      if (status == cudaErrorNotReady) { return; }
+      CUDA_TRY(status);
+    }
+    slot.pending = false;
+    oldest_slot_ = (oldest_slot_ + 1) % kSlots;
+
+    const auto timestamp = latency_probe::decode(slot.host_luma);
+    // the camera may capture the same displayed frame several times, the first one counts
+    if (!timestamp || *timestamp == last_timestamp_) { continue; }
+    last_timestamp_ = *timestamp;
+    // modulo 2^32
+    const uint32_t latency_us = slot.capture_timestamp - *timestamp;
+    if (latency_us > kMaxLatencyUs) { continue; }
+    record(latency_us);
+    if (latency_file_stream_.is_open()) {
+      latency_file_stream_ << slot.capture_timestamp << "," << latency_us << "\n";
+    }
+  }
+}
+
+void LatencyProbeDetectorOp::record(uint32_t latency_us) {
+  window_latencies_.push_back(latency_us);
+  ++count_;
+  sum_us_ += latency_us;
+  min_us_ = std::min(min_us_, latency_us);
+  max_us_ = std::max(max_us_, latency_us);
+}
+
+void LatencyProbeDetectorOp::report() {
+  last_report_ = std::chrono::steady_clock::now();
+  if (window_latencies_.empty()) { return; }
+  std::sort(window_latencies_.begin(), window_latencies_.end());
+  auto percentile = [this](double fraction) {
+    const size_t index = static_cast<size_t>(fraction * (window_latencies_.size() - 1) + 0.5);
+    return window_latencies_[index] / 1000.;
+  };
+  HOLOSCAN_LOG_INFO(
+      "Glass-to-glass latency (ms) over {} frames: p50 {:.3f}, p90 {:.3f}, p99 {:.3f}, "
+      "max {:.3f}",
+      window_latencies_.size(),
+      percentile(0.5),
+      percentile(0.9),
+      percentile(0.99),
+      window_latencies_.back() / 1000.);
+  window_latencies_.clear();
+}
+
+void LatencyProbeDetectorOp::update_cell_centers(uint32_t width, uint32_t height) {
+  frame_width_ = width;
+  frame_height_ = height;
+  const float display_width = display_size_.get().empty() ? width : display_size_.get()[0];
+  const float display_height = display_size_.get().empty() ? height : display_size_.get()[1];
+
+  std::array<float2, 4> to{make_float2(0.f, 0.f),
+                           make_float2(width - 1.f, 0.f),
+                           make_float2(width - 1.f, height - 1.f),
+                           make_float2(0.f, height - 1.f)};
+  if (!display_corners_.get().empty()) {
+    const auto& corners = display_corners_.get();
+    for (int corner = 0; corner < 4; ++corner) {
+      to[corner] = make_float2(corners[2 * corner], corners[2 * corner + 1]);
+    }
+  }
+  const auto matrix = homography({make_float2(0.f, 0.f),
+                                  make_float2(display_width - 1.f, 0.f),
+                                  make_float2(display_width - 1.f, display_height - 1.f),
+                                  make_float2(0.f, display_height - 1.f)},
+                                 to);
+
+  cell_centers_.resize(2 * latency_probe::kCells);
+  const double cell_size = cell_size_.get();
+  for (uint32_t cell = 0; cell < latency_probe::kCells; ++cell) {
+    const double x = pattern_x_.get() + (cell + 0.5) * cell_size;
+    const double y = pattern_y_.get() + 0.5 * cell_size;
+    const double w = matrix[6] * x + matrix[7] * y + matrix[8];
+    cell_centers_[2 * cell] = (matrix[0] * x + matrix[1] * y + matrix[2]) / w;
+    cell_centers_[2 * cell + 1] = (matrix[3] * x + matrix[4] * y + matrix[5]) / w;
+  }
+}
+
+}  // namespace holoscan::ops
@@ -0,0 +1,136 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef HOLOSCAN_OPERATORS_LATENCY_PROBE_LATENCY_PROBE_DETECTOR_HPP
+#define HOLOSCAN_OPERATORS_LATENCY_PROBE_LATENCY_PROBE_DETECTOR_HPP
+
+#include <cuda_runtime.h>
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "holoscan/holoscan.hpp"
+#include "holoscan/utils/cuda_stream_handler.hpp"
+
+namespace holoscan::ops {
+
+/**
+ * @brief Reads the pattern painted by LatencyProbeEmitterOp in captured frames and measures the
+ * glass-to-glass latency, from the painting of the pattern to the capture of its first photons.
+ *
+ * The mean luma of each cell of the pattern is sampled on the GPU and read back asynchronously,
+ * so that the pipeline never waits for the detection. The message is forwarded, the operator is
+ * meant to be inserted right after the capture source. The percentiles of the latency are logged
+ * every `report_period`.
+ *
+ * The cells are located from the position of the display in the captured frame, e.g. the
+ * corners found by the `laser_detection_latency` calibration applications. Without it, the
+ * captured frame is assumed to be the displayed one, scaled, as with a capture card looping back
+ * the display output.
+ *
+ * ==Named Inputs==
+ *
+ * - **in** : `nvidia::gxf::Entity` containing a `nvidia::gxf::Tensor`
+ *   - uint8 HWC captured frame on the device, with 1, 3 or 4 channels.
+ *
+ * ==Named Outputs==
+ *
+ * - **out** : `nvidia::gxf::Entity`
+ *   - The input message.
+ *
+ * ==Parameters==
+ *
+ * - **tensor_name**: Name of the frame tensor. Optional (default: "", the first tensor).
+ * - **display_corners**: Top left, top right, bottom right and bottom left corners of the
+ *   display in the captured frame, as 8 pixel coordinates. Optional (default: the whole frame).
+ * - **display_size**: Width and height of the frames painted by LatencyProbeEmitterOp, which
+ *   fill the display. Optional (default: the size of the captured frame).
+ * - **pattern_x**, **pattern_y**, **cell_size**: Position and cell size of the pattern, as set
+ *   for LatencyProbeEmitterOp. Optional (default: 16).
+ * - **sample_radius**: The luma of a cell is the mean of the (2 * radius + 1)^2 pixels around
+ *   its center. Optional (default: 2).
+ * - **report_period**: Period in seconds of the latency logs. Optional (default: 10).
+ * - **latency_file**: CSV file to write each measured latency to. Optional (default: "").
+ * - **cuda_stream_pool**: `holoscan::CudaStreamPool` instance to allocate CUDA streams.
+ *   Optional (default: `nullptr`).
+ */
+class LatencyProbeDetectorOp : public holoscan::Operator {
+ public:
+  HOLOSCAN_OPERATOR_FORWARD_ARGS(LatencyProbeDetectorOp)
+
+  LatencyProbeDetectorOp() = default;
+
+  void setup(OperatorSpec& spec) override;
+  void start() override;
+  void stop() override;
+  void compute(InputContext& op_input, OutputContext& op_output,
+               ExecutionContext& context) override;
+
+ private:
+  // Frames sampled and not read back yet
+  static constexpr size_t kSlots = 4;
+  struct Slot {
+    float* device_luma = nullptr;
+    float* host_luma = nullptr;
+    cudaEvent_t read_back = nullptr;
+    uint32_t capture_timestamp = 0;
+    bool pending = false;
+  };
+
+  /// Decode the frames read back, waiting for them if `wait`
+  void collect(bool wait);
+  void record(uint32_t latency_us);
+  void report();
+  void update_cell_centers(uint32_t width, uint32_t height);
+
+  Parameter<std::string> tensor_name_;
+  Parameter<std::vector<float>> display_corners_;
+  Parameter<std::vector<uint32_t>> display_size_;
+  Parameter<uint32_t> pattern_x_;
+  Parameter<uint32_t> pattern_y_;
+  Parameter<uint32_t> cell_size_;
+  Parameter<int32_t> sample_radius_;
+  Parameter<float> report_period_;
+  Parameter<std::string> latency_file_;
+
+  CudaStreamHandler cuda_stream_handler_;
+
+  std::array<Slot, kSlots> slots_;
+  size_t next_slot_ = 0;
+  size_t oldest_slot_ = 0;
+  std::vector<float> cell_centers_;
+  uint32_t frame_width_ = 0;
+  uint32_t frame_height_ = 0;
+
+  uint32_t last_timestamp_ = 0;
+  std::vector<uint32_t> window_latencies_;
+  uint64_t count_ = 0;
+  uint64_t skipped_frames_ = 0;
+  uint64_t sum_us_ = 0;
+  uint32_t min_us_ = UINT32_MAX;
+  uint32_t max_us_ = 0;
+  std::chrono::steady_clock::time_point last_report_;
+  std::ofstream latency_file_stream_;
+};
+
+}  // namespace holoscan::ops
+
+#endif /* HOLOSCAN_OPERATORS_LATENCY_PROBE_LATENCY_PROBE_DETECTOR_HPP */
@@ -0,0 +1,79 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "latency_probe_emitter.hpp"
+
+#include <stdexcept>
+#include <string>
+
+#include <holoscan/core/execution_context.hpp>
+
+#include <gxf/std/tensor.hpp>
+
+#include "latency_probe.cuh"
+#include "latency_probe_utils.hpp"
+
+namespace holoscan::ops {
+
+void LatencyProbeEmitterOp::setup(OperatorSpec& spec) {
+  spec.input<gxf::Entity>("in");
+  spec.output<gxf::Entity>("out");
+
+  spec.param(tensor_name_,
+             "tensor_name",
+             "Tensor Name",
+             "Name of the frame tensor, the first tensor if empty.",
+             std::string(""));
+  spec.param(pattern_x_, "pattern_x", "Pattern X", "Column of the pattern.", 16U);
+  spec.param(pattern_y_, "pattern_y", "Pattern Y", "Row of the pattern.", 16U);
+  spec.param(cell_size_, "cell_size", "Cell Size", "Size of the pattern cells in pixels.", 16U);
+
+  cuda_stream_handler_.define_params(spec);
+}
+
+void LatencyProbeEmitterOp::compute(InputContext& op_input, OutputContext& op_output,
+                                    ExecutionContext& context) {
+  auto in_message = op_input.receive<gxf::Entity>("in").value();
+
+  gxf_result_t stream_handler_result =
+      cuda_stream_handler_.from_message(context.context(), in_message);
+  if (stream_handler_result != GXF_SUCCESS) {
+    throw std::runtime_error("Failed to get the CUDA stream from incoming messages");
+  }
+
+  auto frame = latency_probe::get_frame(in_message, tensor_name_.get());
+  const cudaStream_t cuda_stream = cuda_stream_handler_.get_cuda_stream(context.context());
+  // Time of the painting, the frame is displayed once the upstream work on the stream is done
+  latency_probe::cuda_draw_pattern(static_cast<uint8_t*>(frame->data()),
+                                   frame->shape()[1],
+                                   frame->shape()[0],
+                                   frame->shape()[2],
+                                   pattern_x_.get(),
+                                   pattern_y_.get(),
+                                   cell_size_.get(),
+                                   latency_probe::encode(latency_probe::timestamp_now()),
+                                   cuda_stream);
+
+  nvidia::gxf::Expected<nvidia::gxf::Entity> out_message(in_message);
+  stream_handler_result = cuda_stream_handler_.to_message(out_message);
+  if (stream_handler_result != GXF_SUCCESS) {
+    throw std::runtime_error("Failed to add the CUDA stream to the outgoing messages");
+  }
+  op_output.emit(in_message, "out");
+}
+
+}  // namespace holoscan::ops
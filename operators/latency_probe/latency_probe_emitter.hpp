@@ -0,0 +1,76 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef HOLOSCAN_OPERATORS_LATENCY_PROBE_LATENCY_PROBE_EMITTER_HPP
+#define HOLOSCAN_OPERATORS_LATENCY_PROBE_LATENCY_PROBE_EMITTER_HPP
+
+#include <string>
+
+#include "holoscan/holoscan.hpp"
+#include "holoscan/utils/cuda_stream_handler.hpp"
+
+namespace holoscan::ops {
+
+/**
+ * @brief Paints a fiducial pattern encoding the current time into the frames going to display,
+ * to be read back by LatencyProbeDetectorOp from a camera looking at the display.
+ *
+ * The pattern is painted in place and the input message is forwarded, so that the operator can
+ * be inserted right before the visualizer at no copy cost.
+ *
+ * ==Named Inputs==
+ *
+ * - **in** : `nvidia::gxf::Entity` containing a `nvidia::gxf::Tensor`
+ *   - uint8 HWC frame on the device, with 1, 3 or 4 channels.
+ *
+ * ==Named Outputs==
+ *
+ * - **out** : `nvidia::gxf::Entity`
+ *   - The input message, with the pattern painted into the frame.
+ *
+ * ==Parameters==
+ *
+ * - **tensor_name**: Name of the frame tensor. Optional (default: "", the first tensor).
+ * - **pattern_x**: Column of the top left corner of the pattern. Optional (default: 16).
+ * - **pattern_y**: Row of the top left corner of the pattern. Optional (default: 16).
+ * - **cell_size**: Width and height of each of the 42 cells of the pattern, in pixels.
+ *   Optional (default: 16).
+ * - **cuda_stream_pool**: `holoscan::CudaStreamPool` instance to allocate CUDA streams.
+ *   Optional (default: `nullptr`).
+ */
+class LatencyProbeEmitterOp : public holoscan::Operator {
+ public:
+  HOLOSCAN_OPERATOR_FORWARD_ARGS(LatencyProbeEmitterOp)
+
+  LatencyProbeEmitterOp() = default;
+
+  void setup(OperatorSpec& spec) override;
+  void compute(InputContext& op_input, OutputContext& op_output,
+               ExecutionContext& context) override;
+
+ private:
+  Parameter<std::string> tensor_name_;
+  Parameter<uint32_t> pattern_x_;
+  Parameter<uint32_t> pattern_y_;
+  Parameter<uint32_t> cell_size_;
+
+  CudaStreamHandler cuda_stream_handler_;
+};
+
+}  // namespace holoscan::ops
+
+#endif /* HOLOSCAN_OPERATORS_LATENCY_PROBE_LATENCY_PROBE_EMITTER_HPP */
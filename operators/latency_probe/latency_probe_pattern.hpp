@@ -0,0 +1,80 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef HOLOSCAN_OPERATORS_LATENCY_PROBE_LATENCY_PROBE_PATTERN_HPP
+#define HOLOSCAN_OPERATORS_LATENCY_PROBE_LATENCY_PROBE_PATTERN_HPP
+
+#include <chrono>
+#include <cstdint>
+#include <optional>
+
+namespace holoscan::ops::latency_probe {
+
+/**
+ * The fiducial pattern is a row of square cells: a white and a black reference cell, which give
+ * the detector its threshold, then 32 bits of timestamp and an 8 bit CRC, most significant bit
+ * first, white for a one.
+ */
+constexpr uint32_t kReferenceCells = 2;
+constexpr uint32_t kTimestampBits = 32;
+constexpr uint32_t kCrcBits = 8;
+constexpr uint32_t kCells = kReferenceCells + kTimestampBits + kCrcBits;
+
+/// Timestamp encoded in the pattern: steady clock in microseconds, modulo 2^32 (about 71 minutes)
+inline uint32_t timestamp_now() {
+  return static_cast<uint32_t>(std::chrono::duration_cast<std::chrono::microseconds>(
+                                   std::chrono::steady_clock::now().time_since_epoch())
+                                   .count());
+}
+
+/// CRC-8 (polynomial 0x07) of the timestamp bytes, rejecting torn or misread patterns
+inline uint8_t crc8(uint32_t value) {
+  uint8_t crc = 0;
+  for (int byte = 3; byte >= 0; --byte) {
+    crc ^= static_cast<uint8_t>(value >> (8 * byte));
+    for (int bit = 0; bit < 8; ++bit) { crc = (crc & 0x80) ? (crc << 1) ^ 0x07 : crc << 1; }
+  }
+  return crc;
+}
+
+/// @return the value of each cell, bit `kCells - 1 - cell` for the cell at index `cell`
+inline uint64_t encode(uint32_t timestamp) {
+  uint64_t cells = uint64_t(1) << (kCells - 1);  // white, then black reference cell
+  cells |= uint64_t(timestamp) << kCrcBits;
+  cells |= crc8(timestamp);
+  return cells;
+}
+
+/// @return the timestamp read from the mean luma of each cell, nullopt if the CRC doesn't match
+inline std::optional<uint32_t> decode(const float* luma) {
+  const float white = luma[0];
+  const float black = luma[1];
+  // not enough contrast for the pattern to be in view
+  if (white - black < 32.f) { return std::nullopt; }
+  const float threshold = (white + black) / 2.f;
+  uint64_t value = 0;
+  for (uint32_t cell = kReferenceCells; cell < kCells; ++cell) {
+    value = (value << 1) | (luma[cell] > threshold ? 1 : 0);
+  }
+  const uint32_t timestamp = static_cast<uint32_t>(value >> kCrcBits);
+  if (crc8(timestamp) != static_cast<uint8_t>(value & 0xFF)) { return std::nullopt; }
+  return timestamp;
+}
+
+}  // namespace holoscan::ops::latency_probe
+
+#endif /* HOLOSCAN_OPERATORS_LATENCY_PROBE_LATENCY_PROBE_PATTERN_HPP */
@@ -0,0 +1,47 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef HOLOSCAN_OPERATORS_LATENCY_PROBE_LATENCY_PROBE_UTILS_HPP
+#define HOLOSCAN_OPERATORS_LATENCY_PROBE_LATENCY_PROBE_UTILS_HPP
+
+#include <memory>
+#include <stdexcept>
+#include <string>
+
+#include "holoscan/holoscan.hpp"
+
+namespace holoscan::ops::latency_probe {
+
+/// @return the uint8 HWC frame tensor of the message, on the device
+inline std::shared_ptr<Tensor> get_frame(const gxf::Entity& message,
+                                         const std::string& tensor_name) {
+  auto tensor = message.get<Tensor>(tensor_name.empty() ? nullptr : tensor_name.c_str());
+  if (!tensor) { throw std::runtime_error(fmt::format("Tensor '{}' not found.", tensor_name)); }
+  const DLDataType dtype = tensor->dtype();
+  if (tensor->ndim() != 3 || dtype.code != kDLUInt || dtype.bits != 8 ||
+      (tensor->shape()[2] != 1 && tensor->shape()[2] != 3 && tensor->shape()[2] != 4)) {
+    throw std::runtime_error("The frame must be a uint8 HWC tensor with 1, 3 or 4 channels.");
+  }
+  if (tensor->device().device_type != kDLCUDA) {
+    throw std::runtime_error("The frame must be in device memory.");
+  }
+  return tensor;
+}
+
+}  // namespace holoscan::ops::latency_probe
+
+#endif /* HOLOSCAN_OPERATORS_LATENCY_PROBE_LATENCY_PROBE_UTILS_HPP */
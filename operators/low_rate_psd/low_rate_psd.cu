@@ -3,11 +3,117 @@
 // SPDX-License-Identifier: Apache-2.0
 #include "low_rate_psd.hpp"
 
-using in_t = std::tuple<tensor_t<float, 2>, cudaStream_t>;
-using out_t = tensor_t<int8_t, 1>;
+#include <algorithm>
+#include <any>
+#include <stdexcept>
+#include <type_traits>
+#include <cuda_bf16.h>
+#include <cuda_fp16.h>
+
+template <typename T>
+using stream_tensor_t = std::tuple<tensor_t<T, 2>, cudaStream_t>;
+using in_t = stream_tensor_t<float>;
+using out_t = std::tuple<tensor_t<int8_t, 1>, cudaStream_t>;
 
 namespace holoscan::ops {
 
+namespace {
+
+__device__ inline float load_power(const float& v) {
+    return v;
+}
+
+__device__ inline float load_power(const matxFp16& v) {
+    return __half2float(reinterpret_cast<const __half&>(v));
+}
+
+__device__ inline float load_power(const matxBf16& v) {
+    return __bfloat162float(reinterpret_cast<const __nv_bfloat16&>(v));
+}
+
+/**
+ * Average of each bin over the bursts of a channel, accumulated in fp32, to clamped 8-bit
+ * dB. One thread per bin, so each burst is read with coalesced loads.
+ */
+template <typename T>
+__global__ void average_db_kernel(const T* in, int8_t* out, index_t num_bursts,
+        index_t burst_size, float scale) {
+    const index_t bin = static_cast<index_t>(blockIdx.x) * blockDim.x + threadIdx.x;
+    const index_t channel = blockIdx.y;
+    if (bin >= burst_size) {
+        return;
+    }
+    const T* channel_in = in + channel * num_bursts * burst_size + bin;
+    float acc = 0.0f;
+    for (index_t burst = 0; burst < num_bursts; burst++) {
+        acc += load_power(channel_in[burst * burst_size]);
+    }
+    const float db = fminf(fmaxf(10.0f * log10f(acc * scale), -128.0f), 127.0f);
+    out[channel * burst_size + bin] = static_cast<int8_t>(db);
+}
+
+__device__ inline int8_t to_db(float power) {
+    return static_cast<int8_t>(fminf(fmaxf(10.0f * log10f(power), -128.0f), 127.0f));
+}
+
+/**
+ * Exponential moving average of each bin, updated with every burst of the tick in order. A
+ * reset starts the average from the first burst. Writes the 8-bit dB of the average if out is
+ * set. One thread per bin and channel.
+ */
+template <typename T>
+__global__ void exponential_average_kernel(const T* in, float* averages, int8_t* out,
+        index_t num_bursts, index_t burst_size, float alpha, bool reset, float scale) {
+    const index_t bin = static_cast<index_t>(blockIdx.x) * blockDim.x + threadIdx.x;
+    const index_t channel = blockIdx.y;
+    if (bin >= burst_size) {
+        return;
+    }
+    const T* channel_in = in + channel * num_bursts * burst_size + bin;
+    const index_t idx = channel * burst_size + bin;
+    float acc = reset ? load_power(channel_in[0]) : averages[idx];
+    for (index_t burst = reset ? 1 : 0; burst < num_bursts; burst++) {
+        acc += alpha * (load_power(channel_in[burst * burst_size]) - acc);
+    }
+    averages[idx] = acc;
+    if (out != nullptr) {
+        out[idx] = to_db(acc * scale);
+    }
+}
+
+/**
+ * Sliding window sum of each bin over the last window_len bursts. The window of a channel is a
+ * ring of bursts starting at ring_pos, the burst leaving it is subtracted from the sum. The sum
+ * is kept in fp64 so that the additions and subtractions don't drift. Writes the 8-bit dB of
+ * sum * scale if out is set. One thread per bin and channel.
+ */
+template <typename T>
+__global__ void sliding_average_kernel(const T* in, float* window, double* sums, int8_t* out,
+        index_t num_bursts, index_t burst_size, index_t window_len, index_t ring_pos,
+        float scale) {
+    const index_t bin = static_cast<index_t>(blockIdx.x) * blockDim.x + threadIdx.x;
+    const index_t channel = blockIdx.y;
+    if (bin >= burst_size) {
+        return;
+    }
+    const T* channel_in = in + channel * num_bursts * burst_size + bin;
+    float* channel_window = window + channel * window_len * burst_size + bin;
+    const index_t idx = channel * burst_size + bin;
+    double sum = sums[idx];
+    for (index_t burst = 0; burst < num_bursts; burst++) {
+        float* slot = channel_window + ((ring_pos + burst) % window_len) * burst_size;
+        const float power = load_power(channel_in[burst * burst_size]);
+        sum += static_cast<double>(power) - *slot;
+        *slot = power;
+    }
+    sums[idx] = sum;
+    if (out != nullptr) {
+        out[idx] = to_db(static_cast<float>(sum) * scale);
+    }
+}
+
+}  // namespace
+
 void LowRatePSD::setup(OperatorSpec& spec) {
     spec.input<in_t>("in");
     spec.output<out_t>("out");
@@ -23,32 +129,230 @@ void LowRatePSD::setup(OperatorSpec& spec) {
         "num_channels",
         "Number of channels",
         "Number of channels to allocate memory for");
+    spec.param(first_channel,
+        "first_channel",
+        "First channel",
+        "Channel number of channel 0 of this operator's buffers",
+        static_cast<uint16_t>(0));
+    spec.param(device,
+        "device",
+        "CUDA device",
+        "CUDA device the operator runs on",
+        0);
+    spec.param(workspace,
+        "workspace",
+        "Workspace",
+        "Optional MatxWorkspacePool holding the output buffer");
+    spec.param(averaging_mode,
+        "averaging_mode",
+        "Averaging mode",
+        "block averages the bursts of each input, exponential and sliding keep a running "
+        "average across inputs",
+        std::string("block"));
+    spec.param(alpha,
+        "alpha",
+        "Alpha",
+        "Weight of each new burst in the exponential average, 1 / num_averages if 0",
+        0.0f);
+    spec.param(decimation,
+        "decimation",
+        "Decimation",
+        "Number of inputs of a channel per emitted PSD, with a running average",
+        static_cast<uint32_t>(1));
 }
 
 void LowRatePSD::initialize() {
     holoscan::Operator::initialize();
-    make_tensor(outputs, {num_channels.get(), burst_size.get()}, MATX_DEVICE_MEMORY);
+    cudaSetDevice(device.get());
+    if (pooled()) {
+        workspace.get()->reserve<int8_t>(name() + "/outputs",
+            {num_channels.get(), burst_size.get()});
+    } else {
+        make_tensor(outputs, {num_channels.get(), burst_size.get()}, MATX_DEVICE_MEMORY);
+    }
     make_tensor(maxima, {burst_size.get()}, MATX_DEVICE_MEMORY);
     make_tensor(minima, {burst_size.get()}, MATX_DEVICE_MEMORY);
     (maxima = 127.0).run();
     (minima = -128.0).run();
+
+    if (averaging_mode.get() == "exponential") {
+        mode = Mode::Exponential;
+        make_tensor(averages, {num_channels.get(), burst_size.get()}, MATX_DEVICE_MEMORY);
+    } else if (averaging_mode.get() == "sliding") {
+        mode = Mode::Sliding;
+        // The ring starts zeroed, so the bursts leaving a partial window subtract nothing
+        make_tensor(window,
+            {num_channels.get(), static_cast<index_t>(num_averages.get()), burst_size.get()},
+            MATX_DEVICE_MEMORY);
+        make_tensor(window_sums, {num_channels.get(), burst_size.get()}, MATX_DEVICE_MEMORY);
+        cudaMemset(window.Data(), 0, window.Bytes());
+        cudaMemset(window_sums.Data(), 0, window_sums.Bytes());
+    } else if (averaging_mode.get() != "block") {
+        HOLOSCAN_LOG_CRITICAL("Unknown averaging_mode {}, expected block, exponential or "
+            "sliding", averaging_mode.get());
+        throw std::runtime_error("Unknown averaging_mode");
+    }
+    if (decimation.get() == 0) {
+        throw std::runtime_error("decimation must be at least 1");
+    }
+    channel_states.assign(num_channels.get(), ChannelState{});
+}
+
+void LowRatePSD::start() {
+    cudaSetDevice(device.get());
+    if (pooled()) {
+        // operator= between tensors is a lazy MatX assignment, Shallow() rebinds
+        outputs.Shallow(workspace.get()->tensor<int8_t>(name() + "/outputs",
+            {num_channels.get(), burst_size.get()}));
+    }
 }
 
 void LowRatePSD::compute(InputContext& op_input, OutputContext& op_output, ExecutionContext&) {
-    auto input = op_input.receive<in_t>("in").value();
+    cudaSetDevice(device.get());
+    auto message = op_input.receive<std::any>("in").value();
+    visit_stream_tensor<float, matxFp16, matxBf16>(message, [&](auto& input) {
+        if (mode == Mode::Block) {
+            average(std::get<0>(input), std::get<1>(input), op_output);
+        } else {
+            running_average(std::get<0>(input), std::get<1>(input), op_output);
+        }
+    });
+}
+
+template <typename T>
+void LowRatePSD::running_average(const tensor_t<T, 2>& input, cudaStream_t stream,
+        OutputContext& op_output) {
     auto meta = metadata();
-    auto channel_num = meta->get<uint16_t>("channel_number", 0);
-    auto out = slice<1>(outputs, {static_cast<index_t>(channel_num), 0},
-            {matxDropDim, matxEnd});
+    const float psd_scale = meta->get<float>("psd_scale", 1.0f);
+    const bool batched = meta->has_key("batched_channels");
+    const index_t channels = batched ? num_channels.get() : 1;
+    const index_t num_bursts = input.Size(0) / channels;
+    if (!input.IsContiguous()) {
+        HOLOSCAN_LOG_CRITICAL("Running averages need contiguous PSDs");
+        throw std::runtime_error("Unsupported input layout");
+    }
+
+    // Channels of a batch move in lockstep, the first one's state stands for them all
+    index_t channel = 0;
+    if (!batched) {
+        const int channel_num = meta->get<uint16_t>("channel_number", 0) - first_channel.get();
+        if (channel_num < 0 || channel_num >= num_channels.get()) {
+            HOLOSCAN_LOG_CRITICAL("Channel {} is outside of channels {} to {}",
+                channel_num + first_channel.get(), first_channel.get(),
+                first_channel.get() + num_channels.get() - 1);
+            throw std::runtime_error("Invalid channel_number");
+        }
+        channel = channel_num;
+    }
+    auto& state = channel_states[channel];
+    const bool emit = ++state.inputs % decimation.get() == 0;
+    int8_t* out = emit ? outputs.Data() + channel * burst_size.get() : nullptr;
+
+    const unsigned threads = 256;
+    dim3 grid((burst_size.get() + threads - 1) / threads, channels);
+    if (mode == Mode::Exponential) {
+        const float weight = alpha.get() > 0.0f ? alpha.get() : 1.0f / num_averages.get();
+        exponential_average_kernel<<<grid, threads, 0, stream>>>(input.Data(),
+            averages.Data() + channel * burst_size.get(), out, num_bursts, burst_size.get(),
+            weight, state.bursts == 0, 1.0f / psd_scale);
+    } else {
+        const index_t window_len = num_averages.get();
+        const uint64_t filled = std::min<uint64_t>(state.bursts + num_bursts, window_len);
+        sliding_average_kernel<<<grid, threads, 0, stream>>>(input.Data(),
+            window.Data() + channel * window_len * burst_size.get(),
+            window_sums.Data() + channel * burst_size.get(), out, num_bursts, burst_size.get(),
+            window_len, state.bursts % window_len, 1.0f / (filled * psd_scale));
+    }
+    state.bursts += num_bursts;
+    if (!emit) {
+        return;
+    }
+
+    tensor_t<int8_t, 1> emitted;
+    if (batched) {
+        emitted.Shallow(outputs.View({num_channels.get() * burst_size.get()}));
+    } else {
+        emitted.Shallow(slice<1>(outputs, {channel, 0}, {matxDropDim, matxEnd}));
+    }
+    meta->set("num_averages", num_averages.get());
+    using ChannelMetadata = std::vector<std::shared_ptr<MetadataDictionary>>;
+    if (batched && meta->has_key("channel_metadata")) {
+        for (auto& channel_meta : meta->get<ChannelMetadata>("channel_metadata")) {
+            if (channel_meta) {
+                channel_meta->set("num_averages", num_averages.get());
+            }
+        }
+    }
+    op_output.emit(out_t {emitted, stream}, "out");
+}
+
+template <typename T>
+void LowRatePSD::average(const tensor_t<T, 2>& input, cudaStream_t stream,
+        OutputContext& op_output) {
+    auto meta = metadata();
+    // Reduced precision PSDs may be emitted scaled, see HighRatePSD
+    const float psd_scale = meta->get<float>("psd_scale", 1.0f);
+    const float scale = 1.0f / (static_cast<float>(num_averages.get()) * psd_scale);
+    const bool batched = meta->has_key("batched_channels");
+    const index_t channels = batched ? num_channels.get() : 1;
+    const index_t num_bursts = input.Size(0) / channels;
+
+    tensor_t<int8_t, 1> out;
+    if (batched) {
+        out.Shallow(outputs.View({num_channels.get() * burst_size.get()}));
+    } else {
+        const int channel_num = meta->get<uint16_t>("channel_number", 0) - first_channel.get();
+        if (channel_num < 0 || channel_num >= num_channels.get()) {
+            HOLOSCAN_LOG_CRITICAL("Channel {} is outside of channels {} to {}",
+                channel_num + first_channel.get(), first_channel.get(),
+                first_channel.get() + num_channels.get() - 1);
+            throw std::runtime_error("Invalid channel_number");
+        }
+        out.Shallow(slice<1>(outputs, {static_cast<index_t>(channel_num), 0},
+                {matxDropDim, matxEnd}));
+    }
 
-    (out = as_int8(
-        min(max(
-            10.0 * log10(
-                sum(std::get<0>(input), {0}) * (1.0 / (float)num_averages.get())),
-            minima), maxima))).run(std::get<1>(input));
+    if constexpr (std::is_same_v<T, float>) {
+        if (!batched) {
+            (out = as_int8(
+                min(max(
+                    10.0 * log10(
+                        sum(input, {0}) * scale),
+                    minima), maxima))).run(stream);
+        } else {
+            // Batched input: average each channel's bursts
+            auto in = input.View({channels, num_bursts, burst_size.get()});
+            for (index_t c = 0; c < channels; c++) {
+                auto channel_in = slice<2>(in, {c, 0, 0}, {matxDropDim, matxEnd, matxEnd});
+                auto channel_out = slice<1>(outputs, {c, 0}, {matxDropDim, matxEnd});
+                (channel_out = as_int8(
+                    min(max(
+                        10.0 * log10(
+                            sum(channel_in, {0}) * scale),
+                        minima), maxima))).run(stream);
+            }
+        }
+    } else {
+        if (!input.IsContiguous()) {
+            HOLOSCAN_LOG_CRITICAL("Reduced precision PSDs must be contiguous");
+            throw std::runtime_error("Unsupported input layout");
+        }
+        const unsigned threads = 256;
+        dim3 grid((burst_size.get() + threads - 1) / threads, channels);
+        average_db_kernel<<<grid, threads, 0, stream>>>(
+            input.Data(), out.Data(), num_bursts, burst_size.get(), scale);
+    }
 
     meta->set("num_averages", num_averages.get());
+    using ChannelMetadata = std::vector<std::shared_ptr<MetadataDictionary>>;
+    if (batched && meta->has_key("channel_metadata")) {
+        for (auto& channel_meta : meta->get<ChannelMetadata>("channel_metadata")) {
+            if (channel_meta) {
+                channel_meta->set("num_averages", num_averages.get());
+            }
+        }
+    }
 
-    op_output.emit(out_t {out}, "out");
+    op_output.emit(out_t {out, stream}, "out");
 }
 }  // namespace holoscan::ops
@@ -4,8 +4,13 @@
 #pragma once
 
 #include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
 #include <matx.h>
 #include "holoscan/holoscan.hpp"
+#include "../matx_sample_types.hpp"
+#include "matx_workspace.hpp"
 
 using namespace matx;
 
@@ -18,16 +23,44 @@ class LowRatePSD : public Operator {
 
   void initialize() override;
   void setup(OperatorSpec& spec) override;
+  void start() override;
   void compute(InputContext& input, OutputContext& output, ExecutionContext& context) override;
 
  private:
+  bool pooled() const { return workspace.has_value() && workspace.get() != nullptr; }
+  template <typename T>
+  void average(const tensor_t<T, 2>& in, cudaStream_t stream, OutputContext& op_output);
+  template <typename T>
+  void running_average(const tensor_t<T, 2>& in, cudaStream_t stream,
+      OutputContext& op_output);
+
+  enum class Mode { Block, Exponential, Sliding };
+  // Progress of the running average of a channel
+  struct ChannelState {
+    uint64_t bursts = 0;
+    uint64_t inputs = 0;
+  };
+
   tensor_t<int8_t, 2> outputs;
+  Mode mode = Mode::Block;
+  // Running average state, one row per channel: the exponential averages, or the window ring
+  // of each channel with the sum of its bursts
+  tensor_t<float, 2> averages;
+  tensor_t<float, 3> window;
+  tensor_t<double, 2> window_sums;
+  std::vector<ChannelState> channel_states;
+  Parameter<std::shared_ptr<MatxWorkspacePool>> workspace;
   tensor_t<double, 1> maxima;
   tensor_t<double, 1> minima;
   Parameter<int> burst_size;
   Parameter<int> num_bursts;
   Parameter<uint16_t> num_channels;
+  Parameter<uint16_t> first_channel;
+  Parameter<int32_t> device;
   Parameter<uint32_t> num_averages;
+  Parameter<std::string> averaging_mode;
+  Parameter<float> alpha;
+  Parameter<uint32_t> decimation;
 };
 
 }  // namespace holoscan::ops
@@ -17,6 +17,12 @@
 
 #include "lstm_tensor_rt_inference.hpp"
 
+#include <yaml-cpp/yaml.h>
+
+#include <any>
+#include <string>
+#include <vector>
+
 #include "holoscan/core/gxf/entity.hpp"
 #include "holoscan/core/operator_spec.hpp"
 
@@ -25,10 +31,44 @@
 
 namespace holoscan::ops {
 
+namespace {
+
+// The ports depend on num_streams, read from the arguments given before setup()
+int32_t num_streams_arg(const std::vector<Arg>& args) {
+  for (const auto& arg : args) {
+    if (arg.name() != "num_streams") { continue; }
+    const std::any& value = arg.value();
+    if (value.type() == typeid(YAML::Node)) {
+      return std::any_cast<YAML::Node>(value).as<int32_t>();
+    }
+    if (value.type() == typeid(int32_t)) { return std::any_cast<int32_t>(value); }
+    if (value.type() == typeid(int64_t)) {
+      return static_cast<int32_t>(std::any_cast<int64_t>(value));
+    }
+  }
+  return 1;
+}
+
+}  // namespace
+
 void LSTMTensorRTInferenceOp::setup(OperatorSpec& spec) {
   auto& in_tensor = spec.input<gxf::Entity>("source_video");
   auto& out_tensor = spec.output<gxf::Entity>("tensor");
 
+  // With several streams, "source_video_<i>" and "tensor_<i>" are the ports of stream i
+  std::vector<IOSpec*> stream_inputs;
+  std::vector<IOSpec*> stream_outputs;
+  const int32_t num_streams = num_streams_arg(args());
+  for (int32_t stream = 0; num_streams > 1 && stream < num_streams; ++stream) {
+    const std::string suffix = "_" + std::to_string(stream);
+    stream_inputs.push_back(&spec.input<gxf::Entity>("source_video" + suffix));
+    stream_outputs.push_back(&spec.output<gxf::Entity>("tensor" + suffix));
+  }
+  if (num_streams > 1) {
+    // Only the stream ports carry messages
+    in_tensor.condition(ConditionType::kNone);
+  }
+
   spec.param(
       model_file_path_, "model_file_path", "Model File Path", "Path to ONNX model to be loaded.");
   spec.param(engine_cache_dir_,
@@ -118,8 +158,55 @@ void LSTMTensorRTInferenceOp::setup(OperatorSpec& spec) {
              "Relaxed Dimension Check",
              "Ignore dimensions of 1 for input tensor dimension check.",
              true);
+  spec.param(swap_state_buffers_,
+             "swap_state_buffers",
+             "Swap State Buffers",
+             "Alternate two buffers per state tensor, read and written by the model, instead of "
+             "copying the output states to the input states. The output state tensors are then "
+             "not published.",
+             false);
+  spec.param(use_cuda_graph_,
+             "use_cuda_graph",
+             "Use CUDA Graph",
+             "Capture the inference in a CUDA graph per set of tensor addresses and replay it "
+             "while the input shapes do not change.",
+             false);
+  spec.param(use_timing_cache_,
+             "use_timing_cache",
+             "Use Timing Cache",
+             "Load and save a TensorRT timing cache in the engine cache directory, so that engine "
+             "builds reuse the tactic timings.",
+             true);
+  spec.param(background_engine_build_,
+             "background_engine_build",
+             "Background Engine Build",
+             "When the engine has to be built, start with the previous engine or one built "
+             "without optimization, and swap in the optimized engine once it is built on a "
+             "background thread.",
+             false);
+
+  spec.param(num_streams_,
+             "num_streams",
+             "Number of Streams",
+             "Number of streams batched through the engine, each with its own recurrent states.",
+             1);
+  spec.param(max_batch_wait_ms_,
+             "max_batch_wait_ms",
+             "Max Batch Wait",
+             "With several streams, milliseconds to wait for the frames of all streams before "
+             "running a partial batch.",
+             5l);
+  spec.param(stream_tx_,
+             "stream_tx",
+             "Stream TX",
+             "With several streams, transmitters to publish the output tensors of each stream.",
+             stream_outputs);
 
-  spec.param(rx_, "rx", "RX", "List of receivers to take input tensors", {&in_tensor});
+  spec.param(rx_,
+             "rx",
+             "RX",
+             "List of receivers to take input tensors",
+             num_streams > 1 ? stream_inputs : std::vector<IOSpec*>{&in_tensor});
   spec.param(tx_, "tx", "TX", "Transmitter to publish output tensors", &out_tensor);
 
   // TODO (gbae): spec object holds an information about errors
@@ -30,6 +30,9 @@ namespace holoscan::ops {
  * @brief Operator class to perform the inference of the LSTM model.
  *
  * This wraps a GXF Codelet(`nvidia::holoscan::lstm_tensor_rt_inference::TensorRtInference`).
+ *
+ * With `num_streams` above 1, the operator batches the streams through one engine: stream i is
+ * received on `source_video_<i>` and its outputs are emitted on `tensor_<i>`.
  */
 class LSTMTensorRTInferenceOp : public holoscan::ops::GXFOperator {
  public:
@@ -63,6 +66,13 @@ class LSTMTensorRTInferenceOp : public holoscan::ops::GXFOperator {
   Parameter<bool> enable_fp16_;
   Parameter<bool> relaxed_dimension_check_;
   Parameter<bool> verbose_;
+  Parameter<bool> swap_state_buffers_;
+  Parameter<bool> use_cuda_graph_;
+  Parameter<bool> use_timing_cache_;
+  Parameter<bool> background_engine_build_;
+  Parameter<int32_t> num_streams_;
+  Parameter<int64_t> max_batch_wait_ms_;
+  Parameter<std::vector<IOSpec*>> stream_tx_;
 
   Parameter<std::vector<IOSpec*>> rx_;
   Parameter<IOSpec*> tx_;
@@ -70,7 +70,10 @@ class PyLSTMTensorRTInferenceOp : public LSTMTensorRTInferenceOp {
       const std::vector<std::string>& output_state_tensor_names = std::vector<std::string>{},
       bool force_engine_update = false, bool enable_fp16_ = false, bool verbose = false,
       bool relaxed_dimension_check = true, int64_t max_workspace_size = 67108864l,
-      int32_t max_batch_size = 1, const std::string& name = "lstm_tensor_rt_inference")
+      int32_t max_batch_size = 1, bool swap_state_buffers = false, bool use_cuda_graph = false,
+      bool use_timing_cache = true, bool background_engine_build = false,
+      int32_t num_streams = 1, int64_t max_batch_wait_ms = 5l,
+      const std::string& name = "lstm_tensor_rt_inference")
       : LSTMTensorRTInferenceOp(ArgList{Arg{"input_tensor_names", input_tensor_names},
                                         Arg{"output_tensor_names", output_tensor_names},
                                         Arg{"input_binding_names", input_binding_names},
@@ -87,7 +90,13 @@ class PyLSTMTensorRTInferenceOp : public LSTMTensorRTInferenceOp {
                                         Arg{"verbose", verbose},
                                         Arg{"relaxed_dimension_check", relaxed_dimension_check},
                                         Arg{"max_workspace_size", max_workspace_size},
-                                        Arg{"max_batch_size", max_batch_size}}) {
+                                        Arg{"max_batch_size", max_batch_size},
+                                        Arg{"swap_state_buffers", swap_state_buffers},
+                                        Arg{"use_cuda_graph", use_cuda_graph},
+                                        Arg{"use_timing_cache", use_timing_cache},
+                                        Arg{"background_engine_build", background_engine_build},
+                                        Arg{"num_streams", num_streams},
+                                        Arg{"max_batch_wait_ms", max_batch_wait_ms}}) {
     if (dla_core.has_value()) { add_arg(Arg{"dla_core", dla_core.value()}); }
     add_positional_condition_and_resource_args(this, args);
     name_ = name;
@@ -139,6 +148,12 @@ PYBIND11_MODULE(_lstm_tensor_rt_inference, m) {
                     bool,
                     int64_t,
                     int32_t,
+                    bool,
+                    bool,
+                    bool,
+                    bool,
+                    int32_t,
+                    int64_t,
                     const std::string&>(),
            "fragment"_a,
            "input_tensor_names"_a,
@@ -159,6 +174,12 @@ PYBIND11_MODULE(_lstm_tensor_rt_inference, m) {
            "relaxed_dimension_check"_a = true,
            "max_workspace_size"_a = 67108864l,
            "max_batch_size"_a = 1,
+           "swap_state_buffers"_a = false,
+           "use_cuda_graph"_a = false,
+           "use_timing_cache"_a = true,
+           "background_engine_build"_a = false,
+           "num_streams"_a = 1,
+           "max_batch_wait_ms"_a = 5l,
            "name"_a = "lstm_tensor_rt_inference"s,
            doc::LSTMTensorRTInferenceOp::doc_LSTMTensorRTInferenceOp_python)
       .def_property_readonly("gxf_typename",
@@ -76,6 +76,24 @@ max_workspace_size : int, optional
 max_batch_size : int, optional
     Maximum possible batch size in case the first dimension is dynamic and used
     as batch size.
+swap_state_buffers : bool, optional
+    Alternate two buffers per state tensor, read and written by the model, instead of copying
+    the output states to the input states. The output state tensors are then not emitted.
+use_cuda_graph : bool, optional
+    Capture the inference in a CUDA graph per set of tensor addresses and replay it while the
+    input shapes do not change.
+use_timing_cache : bool, optional
+    Load and save a TensorRT timing cache in the engine cache directory, so that engine builds
+    reuse the tactic timings.
+background_engine_build : bool, optional
+    When the engine has to be built, start with the previous engine or one built without
+    optimization, and swap in the optimized engine once it is built on a background thread.
+num_streams : int, optional
+    Number of streams batched through the engine, each with its own recurrent states. Stream
+    ``i`` is received on port ``source_video_<i>`` and emitted on port ``tensor_<i>``.
+max_batch_wait_ms : int, optional
+    With several streams, milliseconds to wait for the frames of all streams before running a
+    partial batch.
 name : str, optional
     The name of the operator.
 )doc")
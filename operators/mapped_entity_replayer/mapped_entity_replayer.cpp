@@ -0,0 +1,392 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "mapped_entity_replayer.hpp"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace holoscan::ops {
+
+namespace {
+
+// Serialized structures of the GXF entity recording format, see
+// utilities/convert_video_to_gxf_entities.py
+#pragma pack(push, 1)
+struct EntityHeader {
+  uint64_t serialized_size;
+  uint32_t checksum;
+  uint64_t sequence_number;
+  uint32_t flags;
+  uint64_t component_count;
+  uint64_t reserved;
+};
+
+struct ComponentHeader {
+  uint64_t serialized_size;
+  uint64_t tid_hash1;
+  uint64_t tid_hash2;
+  uint64_t name_size;
+};
+
+struct TensorHeader {
+  int32_t storage_type;
+  int32_t element_type;
+  uint64_t bytes_per_element;
+  uint32_t rank;
+  int32_t dims[nvidia::gxf::Shape::kMaxRank];
+  uint64_t strides[nvidia::gxf::Shape::kMaxRank];
+};
+#pragma pack(pop)
+
+// Type ID of nvidia::gxf::Tensor
+constexpr uint64_t kTensorTidHash1 = 3996102265592038524ULL;
+constexpr uint64_t kTensorTidHash2 = 11968035723744066232ULL;
+
+// A tensor of a frame, pointing into the mapped file
+struct MappedTensor {
+  std::string name;
+  const TensorHeader* header;
+  const uint8_t* data;
+  size_t size;
+};
+
+std::vector<MappedTensor> parse_entity(const uint8_t* entity, size_t entity_size) {
+  auto check = [&](size_t offset, size_t size) {
+    if (offset + size > entity_size) {
+      throw std::runtime_error("The recorded entity is truncated");
+    }
+  };
+  check(0, sizeof(EntityHeader));
+  EntityHeader header;
+  std::memcpy(&header, entity, sizeof(header));
+
+  std::vector<MappedTensor> tensors;
+  size_t offset = sizeof(EntityHeader);
+  for (uint64_t i = 0; i < header.component_count; ++i) {
+    check(offset, sizeof(ComponentHeader));
+    ComponentHeader component;
+    std::memcpy(&component, entity + offset, sizeof(component));
+    offset += sizeof(ComponentHeader);
+    check(offset, component.name_size);
+    std::string name(reinterpret_cast<const char*>(entity + offset), component.name_size);
+    offset += component.name_size;
+
+    if (component.tid_hash1 != kTensorTidHash1 || component.tid_hash2 != kTensorTidHash2) {
+      // other components are skipped, which needs their size
+      if (component.serialized_size == 0) {
+        throw std::runtime_error(
+            fmt::format("Component '{}' of unknown type and size in the recording", name));
+      }
+      offset += component.serialized_size;
+      continue;
+    }
+
+    check(offset, sizeof(TensorHeader));
+    const auto* tensor = reinterpret_cast<const TensorHeader*>(entity + offset);
+    offset += sizeof(TensorHeader);
+    if (tensor->rank > nvidia::gxf::Shape::kMaxRank) {
+      throw std::runtime_error(fmt::format("Tensor '{}' has an invalid rank", name));
+    }
+    const size_t size = tensor->rank > 0
+                            ? static_cast<size_t>(tensor->dims[0]) * tensor->strides[0]
+                            : tensor->bytes_per_element;
+    check(offset, size);
+    tensors.push_back(MappedTensor{std::move(name), tensor, entity + offset, size});
+    offset += size;
+  }
+  return tensors;
+}
+
+}  // namespace
+
+void MappedEntityReplayerOp::initialize() {
+  // the operator stops when the recording or count ends
+  stop_condition_ = fragment()->make_condition<BooleanCondition>(name() + "_stop_condition");
+  add_arg(stop_condition_);
+
+  Operator::initialize();
+}
+
+void MappedEntityReplayerOp::setup(OperatorSpec& spec) {
+  spec.output<gxf::Entity>("output");
+
+  spec.param(directory_, "directory", "Directory", "Directory of the recording.");
+  spec.param(basename_,
+             "basename",
+             "Basename",
+             "Base name of the .gxf_entities and .gxf_index files of the recording.");
+  spec.param(frame_rate_,
+             "frame_rate",
+             "Frame rate",
+             "Frame rate of the playback, 0 for the recorded timestamps.",
+             0.f);
+  spec.param(realtime_,
+             "realtime",
+             "Realtime",
+             "Play back at the frame rate, or as fast as possible.",
+             true);
+  spec.param(repeat_, "repeat", "Repeat", "Loop at the end of the recording.", false);
+  spec.param(count_,
+             "count",
+             "Count",
+             "Number of frames emitted before stopping, 0 for no limit.",
+             static_cast<uint64_t>(0));
+  spec.param(start_frame_,
+             "start_frame",
+             "Start frame",
+             "Index of the first frame emitted.",
+             static_cast<uint64_t>(0));
+  spec.param(read_ahead_,
+             "read_ahead",
+             "Read ahead",
+             "Number of upcoming frames whose pages are requested from the kernel.",
+             4U);
+  spec.param(num_staging_buffers_,
+             "num_staging_buffers",
+             "Staging buffers",
+             "Number of pinned buffers the frames are uploaded from.",
+             2U);
+  spec.param(allocator_, "allocator", "Allocator", "Allocator of the device tensors.");
+
+  cuda_stream_handler_.define_params(spec);
+}
+
+MappedEntityReplayerOp::MappedFile MappedEntityReplayerOp::map_file(const std::string& path) {
+  MappedFile file;
+  file.fd = open(path.c_str(), O_RDONLY);
+  if (file.fd < 0) {
+    throw std::runtime_error(fmt::format("Failed to open {}: {}", path, std::strerror(errno)));
+  }
+  struct stat st;
+  if (fstat(file.fd, &st) != 0 || st.st_size == 0) {
+    close(file.fd);
+    throw std::runtime_error(fmt::format("Failed to get the size of {}", path));
+  }
+  file.size = static_cast<size_t>(st.st_size);
+  void* data = mmap(nullptr, file.size, PROT_READ, MAP_SHARED, file.fd, 0);
+  if (data == MAP_FAILED) {
+    close(file.fd);
+    throw std::runtime_error(fmt::format("Failed to map {}: {}", path, std::strerror(errno)));
+  }
+  file.data = static_cast<const uint8_t*>(data);
+  return file;
+}
+
+void MappedEntityReplayerOp::unmap_file(MappedFile& file) {
+  if (file.data) { munmap(const_cast<uint8_t*>(file.data), file.size); }
+  if (file.fd >= 0) { close(file.fd); }
+  file = MappedFile{};
+}
+
+void MappedEntityReplayerOp::start() {
+  const std::string path = directory_.get() + "/" + basename_.get();
+
+  // the index is small, copied once, the entities stay mapped
+  MappedFile index = map_file(path + ".gxf_index");
+  if (index.size % sizeof(IndexEntry) != 0) {
+    unmap_file(index);
+    throw std::runtime_error(fmt::format("Invalid index file {}.gxf_index", path));
+  }
+  index_.resize(index.size / sizeof(IndexEntry));
+  std::memcpy(index_.data(), index.data, index.size);
+  unmap_file(index);
+
+  entities_ = map_file(path + ".gxf_entities");
+  for (const auto& entry : index_) {
+    if (entry.data_offset + entry.data_size > entities_.size) {
+      throw std::runtime_error(fmt::format("The index of {} exceeds the entities file", path));
+    }
+  }
+  // frames are read in order, the kernel can read ahead and drop them early
+  madvise(const_cast<uint8_t*>(entities_.data), entities_.size, MADV_SEQUENTIAL);
+
+  if (start_frame_.get() >= index_.size()) {
+    throw std::runtime_error(fmt::format(
+        "Start frame {} is past the {} frames of {}", start_frame_.get(), index_.size(), path));
+  }
+  next_frame_ = start_frame_.get();
+  read_ahead_frame_ = next_frame_;
+  emitted_frames_ = 0;
+  clock_started_ = false;
+
+  staging_.resize(std::max(num_staging_buffers_.get(), 1U));
+  for (auto& buffer : staging_) {
+    if (cudaEventCreateWithFlags(&buffer.uploaded, cudaEventDisableTiming) != cudaSuccess) {
+      throw std::runtime_error("Failed to create the staging buffer event");
+    }
+  }
+  next_staging_ = 0;
+
+  HOLOSCAN_LOG_INFO("Replaying {} frames of {} from memory mapped files", index_.size(), path);
+}
+
+void MappedEntityReplayerOp::stop() {
+  for (auto& buffer : staging_) {
+    if (buffer.uploaded) {
+      cudaEventSynchronize(buffer.uploaded);
+      cudaEventDestroy(buffer.uploaded);
+    }
+    if (buffer.data) { cudaFreeHost(buffer.data); }
+  }
+  staging_.clear();
+  unmap_file(entities_);
+  index_.clear();
+}
+
+void MappedEntityReplayerOp::seek(uint64_t frame) {
+  next_frame_ = frame;
+  seeked_ = true;
+}
+
+void MappedEntityReplayerOp::read_ahead(uint64_t frame) {
+  // request the pages of the frames up to frame + read_ahead which were not requested yet
+  const uint64_t last = std::min<uint64_t>(frame + 1 + read_ahead_.get(), index_.size());
+  const uint64_t first = std::clamp(read_ahead_frame_, frame + 1, last);
+  if (first < last) {
+    const size_t page_size = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    const size_t begin = index_[first].data_offset / page_size * page_size;
+    const size_t end = index_[last - 1].data_offset + index_[last - 1].data_size;
+    madvise(const_cast<uint8_t*>(entities_.data) + begin, end - begin, MADV_WILLNEED);
+  }
+  read_ahead_frame_ = last;
+}
+
+void MappedEntityReplayerOp::wait_until(uint64_t frame) {
+  if (!realtime_.get()) { return; }
+  if (!clock_started_) {
+    clock_started_ = true;
+    clock_frame_ = frame;
+    clock_start_ = std::chrono::steady_clock::now();
+    return;
+  }
+  std::chrono::nanoseconds offset;
+  if (frame_rate_.get() > 0.f) {
+    offset = std::chrono::nanoseconds(
+        static_cast<int64_t>((frame - clock_frame_) * 1e9 / frame_rate_.get()));
+  } else {
+    offset = std::chrono::nanoseconds(index_[frame].log_time - index_[clock_frame_].log_time);
+  }
+  std::this_thread::sleep_until(clock_start_ + offset);
+}
+
+void MappedEntityReplayerOp::compute(InputContext&, OutputContext& op_output,
+                                     ExecutionContext& context) {
+  if (seeked_.exchange(false)) {
+    clock_started_ = false;
+    read_ahead_frame_ = next_frame_;
+  }
+  uint64_t requested_frame = next_frame_;
+  uint64_t frame = requested_frame;
+  if (frame >= index_.size()) {
+    if (!repeat_.get()) {
+      stop_condition_->disable_tick();
+      return;
+    }
+    frame = 0;
+    clock_started_ = false;
+    read_ahead_frame_ = 0;
+  }
+
+  const IndexEntry& entry = index_[frame];
+  const auto tensors = parse_entity(entities_.data + entry.data_offset, entry.data_size);
+  read_ahead(frame);
+
+  // the staging buffer is reused once its previous upload is done
+  StagingBuffer& staging = staging_[next_staging_];
+  next_staging_ = (next_staging_ + 1) % staging_.size();
+  size_t staging_size = 0;
+  for (const auto& tensor : tensors) { staging_size += tensor.size; }
+  if (cudaEventSynchronize(staging.uploaded) != cudaSuccess) {
+    throw std::runtime_error("Failed to wait for the staging buffer");
+  }
+  if (staging.size < staging_size) {
+    if (staging.data) { cudaFreeHost(staging.data); }
+    staging.data = nullptr;
+    staging.size = 0;
+    if (cudaMallocHost(&staging.data, staging_size) != cudaSuccess) {
+      throw std::runtime_error("Failed to allocate the staging buffer");
+    }
+    staging.size = staging_size;
+  }
+
+  auto allocator = nvidia::gxf::Handle<nvidia::gxf::Allocator>::Create(
+      fragment()->executor().context(), allocator_->gxf_cid());
+  std::vector<nvidia::gxf::TensorDescription> descriptions;
+  for (const auto& tensor : tensors) {
+    const uint32_t rank = tensor.header->rank;
+    std::array<int32_t, nvidia::gxf::Shape::kMaxRank> dims{};
+    std::copy(tensor.header->dims, tensor.header->dims + rank, dims.begin());
+    nvidia::gxf::Tensor::stride_array_t strides{};
+    std::copy(tensor.header->strides, tensor.header->strides + rank, strides.begin());
+    descriptions.push_back(
+        {tensor.name,
+         nvidia::gxf::MemoryStorageType::kDevice,
+         nvidia::gxf::Shape(dims, rank),
+         static_cast<nvidia::gxf::PrimitiveType>(tensor.header->element_type),
+         tensor.header->bytes_per_element,
+         strides});
+  }
+  auto out_message = CreateTensorMap(context.context(), allocator.value(), descriptions, false);
+  if (!out_message) { throw std::runtime_error("Failed to allocate the replayed frame"); }
+
+  const cudaStream_t stream = cuda_stream_handler_.get_cuda_stream(context.context());
+  uint8_t* staged = static_cast<uint8_t*>(staging.data);
+  for (const auto& tensor : tensors) {
+    auto out_tensor = out_message.value().get<nvidia::gxf::Tensor>(tensor.name.c_str());
+    if (!out_tensor || !out_tensor.value()->pointer()) {
+      throw std::runtime_error(fmt::format("Failed to allocate tensor '{}'", tensor.name));
+    }
+    // page faults of frames not read ahead yet are taken here, not by the copy engine
+    std::memcpy(staged, tensor.data, tensor.size);
+    if (cudaMemcpyAsync(out_tensor.value()->pointer(),
+                        staged,
+                        tensor.size,
+                        cudaMemcpyHostToDevice,
+                        stream) != cudaSuccess) {
+      throw std::runtime_error(fmt::format("Failed to upload tensor '{}'", tensor.name));
+    }
+    staged += tensor.size;
+  }
+  cudaEventRecord(staging.uploaded, stream);
+
+  if (cuda_stream_handler_.to_message(out_message) != GXF_SUCCESS) {
+    throw std::runtime_error("Failed to add the CUDA stream to the outgoing messages");
+  }
+
+  wait_until(frame);
+  // unless seek() was called meanwhile
+  next_frame_.compare_exchange_strong(requested_frame, frame + 1);
+  auto result = gxf::Entity(std::move(out_message.value()));
+  op_output.emit(result, "output");
+
+  ++emitted_frames_;
+  if (count_.get() > 0 && emitted_frames_ >= count_.get()) { stop_condition_->disable_tick(); }
+}
+
+}  // namespace holoscan::ops
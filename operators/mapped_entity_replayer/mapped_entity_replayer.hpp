@@ -0,0 +1,130 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef OPERATORS_MAPPED_ENTITY_REPLAYER_MAPPED_ENTITY_REPLAYER
+#define OPERATORS_MAPPED_ENTITY_REPLAYER_MAPPED_ENTITY_REPLAYER
+
+#include <cuda_runtime.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <holoscan/core/resources/gxf/allocator.hpp>
+#include <holoscan/holoscan.hpp>
+#include <holoscan/utils/cuda_stream_handler.hpp>
+
+namespace holoscan::ops {
+
+/**
+ * @brief Replays a GXF entity recording from memory mapped files
+ *
+ * Reads the `<basename>.gxf_entities` and `<basename>.gxf_index` pair written by the
+ * VideoStreamRecorderOp or `utilities/convert_video_to_gxf_entities.py`, as the
+ * VideoStreamReplayerOp, without buffered file reads nor entity deserialization: both files are
+ * mapped, the pages of the next `read_ahead` frames are requested from the kernel with
+ * `madvise(MADV_WILLNEED)` while the current frame is uploaded, and the tensors of each frame are
+ * copied from the mapping to a ring of pinned staging buffers, then to device tensors with
+ * `cudaMemcpyAsync`. The index gives the offset of every frame, `seek()` and `start_frame` are
+ * frame accurate.
+ */
+class MappedEntityReplayerOp : public Operator {
+ public:
+  HOLOSCAN_OPERATOR_FORWARD_ARGS(MappedEntityReplayerOp);
+
+  void initialize() override;
+  void setup(OperatorSpec& spec) override;
+  void start() override;
+  void compute(InputContext&, OutputContext& op_output, ExecutionContext&) override;
+  void stop() override;
+
+  /**
+   * @brief Sets the next frame emitted
+   *
+   * May be called from another thread while the operator runs.
+   *
+   * @param frame index of the frame in the recording
+   */
+  void seek(uint64_t frame);
+
+  /// @brief Number of frames in the recording, once started
+  uint64_t num_frames() const { return index_.size(); }
+
+ private:
+  // struct EntityIndex of the .gxf_index file
+  struct IndexEntry {
+    uint64_t log_time;
+    uint64_t data_size;
+    uint64_t data_offset;
+  };
+
+  struct MappedFile {
+    int fd = -1;
+    const uint8_t* data = nullptr;
+    size_t size = 0;
+  };
+
+  struct StagingBuffer {
+    void* data = nullptr;
+    size_t size = 0;
+    // Recorded after the upload from the buffer
+    cudaEvent_t uploaded = nullptr;
+  };
+
+  static MappedFile map_file(const std::string& path);
+  static void unmap_file(MappedFile& file);
+  void read_ahead(uint64_t frame);
+  void wait_until(uint64_t frame);
+
+  Parameter<std::string> directory_;
+  Parameter<std::string> basename_;
+  Parameter<float> frame_rate_;
+  Parameter<bool> realtime_;
+  Parameter<bool> repeat_;
+  Parameter<uint64_t> count_;
+  Parameter<uint64_t> start_frame_;
+  Parameter<uint32_t> read_ahead_;
+  Parameter<uint32_t> num_staging_buffers_;
+  Parameter<std::shared_ptr<Allocator>> allocator_;
+
+  std::shared_ptr<BooleanCondition> stop_condition_;
+
+  MappedFile entities_;
+  std::vector<IndexEntry> index_;
+  std::atomic<uint64_t> next_frame_{0};
+  std::atomic<bool> seeked_{false};
+  uint64_t emitted_frames_ = 0;
+  // Frame up to which read ahead was requested
+  uint64_t read_ahead_frame_ = 0;
+
+  std::vector<StagingBuffer> staging_;
+  size_t next_staging_ = 0;
+
+  // Playback clock, restarted at seeks and loops
+  bool clock_started_ = false;
+  uint64_t clock_frame_ = 0;
+  std::chrono::steady_clock::time_point clock_start_;
+
+  CudaStreamHandler cuda_stream_handler_;
+};
+
+}  // namespace holoscan::ops
+
+#endif /* OPERATORS_MAPPED_ENTITY_REPLAYER_MAPPED_ENTITY_REPLAYER */
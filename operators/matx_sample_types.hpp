@@ -0,0 +1,60 @@
+// SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// SPDX-License-Identifier: Apache-2.0
+#pragma once
+
+#include <any>
+#include <stdexcept>
+#include <tuple>
+#include <matx.h>
+#include "holoscan/holoscan.hpp"
+
+#ifdef __CUDACC__
+#include <cuda_bf16.h>
+#include <cuda_fp16.h>
+#endif
+
+// Sample types of the tensors exchanged by the FFT and PSD operators
+using complex = cuda::std::complex<float>;
+using complex_fp16 = matx::matxFp16Complex;
+using complex_bf16 = matx::matxBf16Complex;
+
+namespace holoscan::ops {
+
+/**
+ * @brief Calls f with the (tensor, stream) message received from an input port
+ *
+ * The message holds a tensor of any of the sample types `T`. It's an error for it to hold
+ * anything else.
+ */
+template <typename... T, typename F>
+void visit_stream_tensor(std::any& message, F&& f) {
+    const bool visited = ([&] {
+        auto input = std::any_cast<std::tuple<matx::tensor_t<T, 2>, cudaStream_t>>(&message);
+        if (input != nullptr) {
+            f(*input);
+        }
+        return input != nullptr;
+    }() || ...);
+    if (!visited) {
+        HOLOSCAN_LOG_CRITICAL("Unsupported input type {}", message.type().name());
+        throw std::runtime_error("Unsupported input type");
+    }
+}
+
+#ifdef __CUDACC__
+// Complex samples are loaded as fp32 whatever they are stored in
+__device__ inline float2 load_sample(const complex& v) {
+    return make_float2(v.real(), v.imag());
+}
+
+__device__ inline float2 load_sample(const complex_fp16& v) {
+    return __half22float2(reinterpret_cast<const __half2&>(v));
+}
+
+__device__ inline float2 load_sample(const complex_bf16& v) {
+    return __bfloat1622float2(reinterpret_cast<const __nv_bfloat162&>(v));
+}
+#endif
+
+}  // namespace holoscan::ops
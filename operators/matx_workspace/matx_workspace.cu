@@ -0,0 +1,151 @@
+// SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// SPDX-License-Identifier: Apache-2.0
+#include "matx_workspace.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace holoscan {
+
+#define CUFFT_TRY(stmt)                                                        \
+    {                                                                          \
+        cufftResult cufft_status = stmt;                                       \
+        if (cufft_status != CUFFT_SUCCESS) {                                   \
+            HOLOSCAN_LOG_ERROR("cuFFT call {} failed with {}", #stmt,          \
+                static_cast<int>(cufft_status));                               \
+            throw std::runtime_error("cuFFT call failed");                     \
+        }                                                                      \
+    }
+
+void MatxWorkspacePool::setup(ComponentSpec& spec) {
+    spec.param(share_fft_work_area,
+        "share_fft_work_area",
+        "Share FFT work area",
+        "Point every FFT plan of the pool at one work area, sized for the largest plan",
+        true);
+}
+
+MatxWorkspacePool::~MatxWorkspacePool() {
+    for (auto& [shape, plan] : plans) {
+        cufftDestroy(plan);
+    }
+    for (auto& [key, region] : regions) {
+        if (region.data != nullptr) {
+            cudaFree(region.data);
+        }
+    }
+    if (work_area != nullptr) {
+        cudaFree(work_area);
+    }
+}
+
+void MatxWorkspacePool::reserve(const std::string& key, size_t bytes) {
+    std::lock_guard<std::mutex> lock(mutex);
+    auto& region = regions[key];
+    if (region.data != nullptr && bytes > region.bytes) {
+        HOLOSCAN_LOG_CRITICAL("Workspace buffer {} was reserved for {} bytes after being "
+            "allocated with {} bytes", key, bytes, region.bytes);
+        throw std::runtime_error("Workspace buffer reserved after allocation");
+    }
+    region.bytes = std::max(region.bytes, bytes);
+}
+
+void* MatxWorkspacePool::buffer(const std::string& key, size_t bytes) {
+    std::lock_guard<std::mutex> lock(mutex);
+    auto& region = regions[key];
+    if (region.data == nullptr) {
+        region.bytes = std::max(region.bytes, bytes);
+        if (cudaMalloc(&region.data, region.bytes) != cudaSuccess) {
+            HOLOSCAN_LOG_CRITICAL("Failed to allocate {} bytes for workspace buffer {}",
+                region.bytes, key);
+            throw std::runtime_error("Failed to allocate workspace buffer");
+        }
+        HOLOSCAN_LOG_INFO("Workspace {}: allocated {} bytes for {}", name(), region.bytes, key);
+    } else if (bytes > region.bytes) {
+        HOLOSCAN_LOG_CRITICAL("Workspace buffer {} holds {} bytes, {} were requested",
+            key, region.bytes, bytes);
+        throw std::runtime_error("Workspace buffer too small");
+    }
+    return region.data;
+}
+
+void MatxWorkspacePool::reserve_fft(int n, int batch, cudaDataType type) {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (!share_fft_work_area.get()) {
+        return;
+    }
+    // There is no estimate for half precision plans: the single precision one bounds them
+    (void)type;
+    size_t bytes = 0;
+    CUFFT_TRY(cufftEstimate1d(n, CUFFT_C2C, batch, &bytes));
+    work_area_reserved = std::max(work_area_reserved, bytes);
+}
+
+cufftHandle MatxWorkspacePool::fft_plan(int n, int batch, cudaDataType type) {
+    std::lock_guard<std::mutex> lock(mutex);
+    auto it = plans.find({n, batch, type});
+    if (it != plans.end()) {
+        return it->second;
+    }
+
+    const bool shared = share_fft_work_area.get();
+    cufftHandle plan;
+    CUFFT_TRY(cufftCreate(&plan));
+    if (shared) {
+        CUFFT_TRY(cufftSetAutoAllocation(plan, 0));
+    }
+    size_t bytes = 0;
+    if (type == CUDA_C_32F) {
+        CUFFT_TRY(cufftMakePlan1d(plan, n, CUFFT_C2C, batch, &bytes));
+    } else {
+        long long size = n;
+        CUFFT_TRY(cufftXtMakePlanMany(plan, 1, &size, nullptr, 1, size, type,
+            nullptr, 1, size, type, batch, &bytes, type));
+    }
+    plans[{n, batch, type}] = plan;
+
+    if (shared) {
+        if (bytes > work_area_bytes) {
+            grow_work_area(std::max(bytes, work_area_reserved));
+        } else {
+            CUFFT_TRY(cufftSetWorkArea(plan, work_area));
+        }
+    }
+    HOLOSCAN_LOG_INFO("Workspace {}: created {}-point {} FFT plan with a batch of {}",
+        name(), n, type == CUDA_C_32F ? "fp32" : (type == CUDA_C_16F ? "fp16" : "bf16"), batch);
+    return plan;
+}
+
+void MatxWorkspacePool::grow_work_area(size_t bytes) {
+    if (work_area != nullptr) {
+        // Only hit by plans that were not reserved, or whose estimate was too low
+        HOLOSCAN_LOG_WARN("Workspace {}: growing the FFT work area from {} to {} bytes",
+            name(), work_area_bytes, bytes);
+        cudaDeviceSynchronize();
+        cudaFree(work_area);
+        work_area = nullptr;
+        work_area_bytes = 0;
+    }
+    if (cudaMalloc(&work_area, bytes) != cudaSuccess) {
+        HOLOSCAN_LOG_CRITICAL("Failed to allocate a {} byte FFT work area", bytes);
+        throw std::runtime_error("Failed to allocate FFT work area");
+    }
+    work_area_bytes = bytes;
+    for (auto& [shape, plan] : plans) {
+        CUFFT_TRY(cufftSetWorkArea(plan, work_area));
+    }
+}
+
+size_t MatxWorkspacePool::allocated_bytes() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    size_t bytes = work_area_bytes;
+    for (auto& [key, region] : regions) {
+        if (region.data != nullptr) {
+            bytes += region.bytes;
+        }
+    }
+    return bytes;
+}
+
+}  // namespace holoscan
@@ -0,0 +1,110 @@
+// SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// SPDX-License-Identifier: Apache-2.0
+#pragma once
+
+#include <cstddef>
+#include <map>
+#include <mutex>
+#include <string>
+#include <tuple>
+#include <cufft.h>
+#include <cufftXt.h>
+#include <matx.h>
+#include "holoscan/holoscan.hpp"
+
+namespace holoscan {
+/**
+ * @brief Device workspace and cuFFT plans shared by the MatX-based operators of a fragment
+ *
+ * Operators reserve named buffers and FFT plans in initialize() and fetch them in start(),
+ * once every operator has made its reservations. A buffer is allocated once, at the largest
+ * size reserved under its key, so stages that never hold it at the same time can share the
+ * memory by reserving the same key. The pool does not order the stages: operators sharing a
+ * key must run on one stream, or otherwise be done with the buffer before the next one
+ * writes it.
+ *
+ * FFT plans are created in start() instead of on the first frame, and with
+ * share_fft_work_area all of them point at a single cuFFT work area, sized for the
+ * largest plan.
+ */
+class MatxWorkspacePool : public holoscan::Resource {
+ public:
+  HOLOSCAN_RESOURCE_FORWARD_ARGS(MatxWorkspacePool)
+
+  MatxWorkspacePool() = default;
+  ~MatxWorkspacePool();
+
+  void setup(ComponentSpec& spec) override;
+
+  /**
+   * @brief Reserve bytes of device memory under key
+   */
+  void reserve(const std::string& key, size_t bytes);
+
+  template <typename T, int RANK>
+  void reserve(const std::string& key, const matx::index_t (&shape)[RANK]) {
+    reserve(key, num_elements(shape) * sizeof(T));
+  }
+
+  /**
+   * @brief Device buffer of key, allocated on first use at the largest reserved size
+   *
+   * Throws when bytes exceeds the size of an already allocated buffer.
+   */
+  void* buffer(const std::string& key, size_t bytes);
+
+  /**
+   * @brief Non-owning tensor of the given shape over the buffer of key
+   */
+  template <typename T, int RANK>
+  matx::tensor_t<T, RANK> tensor(const std::string& key, const matx::index_t (&shape)[RANK]) {
+    auto data = static_cast<T*>(buffer(key, num_elements(shape) * sizeof(T)));
+    return matx::make_tensor<T>(data, shape);
+  }
+
+  /**
+   * @brief Reserve a batched 1D C2C plan, so the shared work area is sized before start()
+   */
+  void reserve_fft(int n, int batch, cudaDataType type = CUDA_C_32F);
+
+  /**
+   * @brief Batched 1D C2C plan, created on first use and owned by the pool
+   *
+   * CUDA_C_16F and CUDA_C_16BF plans go through cufftXtMakePlanMany and are executed with
+   * cufftXtExec. cuFFT only creates them for power of 2 sizes.
+   */
+  cufftHandle fft_plan(int n, int batch, cudaDataType type = CUDA_C_32F);
+
+  /**
+   * @brief Device memory held by the pool, buffers and work area
+   */
+  size_t allocated_bytes() const;
+
+ private:
+  template <int RANK>
+  static size_t num_elements(const matx::index_t (&shape)[RANK]) {
+    size_t n = 1;
+    for (auto s : shape) {
+      n *= static_cast<size_t>(s);
+    }
+    return n;
+  }
+
+  struct Region {
+    size_t bytes = 0;
+    void* data = nullptr;
+  };
+
+  void grow_work_area(size_t bytes);
+
+  Parameter<bool> share_fft_work_area;
+  mutable std::mutex mutex;
+  std::map<std::string, Region> regions;
+  std::map<std::tuple<int, int, cudaDataType>, cufftHandle> plans;
+  size_t work_area_reserved = 0;
+  size_t work_area_bytes = 0;
+  void* work_area = nullptr;
+};
+
+}  // namespace holoscan
@@ -0,0 +1,335 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "multi_format_converter.hpp"
+
+#include <gxf/multimedia/video.hpp>
+
+#include <algorithm>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "multi_format_converter_kernels.hpp"
+
+namespace holoscan::ops {
+
+static void check_channel_order(const std::vector<int>& order, size_t channels, int max_index,
+                                const char* name) {
+  if (order.size() != channels) {
+    throw std::runtime_error(fmt::format("{} must have {} entries", name, channels));
+  }
+  for (int index : order) {
+    if (index < 0 || index > max_index) {
+      throw std::runtime_error(fmt::format("{} index {} is out of range", name, index));
+    }
+  }
+}
+
+void MultiFormatConverterOp::initialize() {
+  // Disabled outputs get the ConditionType::kNone condition so that their default condition
+  // (DownstreamMessageAffordableCondition) is not added during Operator::initialize().
+  const std::vector<std::tuple<Parameter<bool>*, std::string, std::string>> outputs{
+      {&enable_tensor_output_, "enable_tensor_output", "tensor"},
+      {&enable_rgb_output_, "enable_rgb_output", "rgb"},
+      {&enable_rgba_output_, "enable_rgba_output", "rgba"}};
+  for (const auto& [enable, param_name, output] : outputs) {
+    auto enable_arg = std::find_if(args().rbegin(), args().rend(), [&](const auto& arg) {
+      return (arg.name() == param_name);
+    });
+    if (enable_arg != args().rend()) {
+      auto& param_wrap = spec()->params()[param_name];
+      ArgumentSetter::set_param(param_wrap, (*enable_arg));
+    }
+    if (!enable->has_value()) { enable->set_default_value(); }
+    if (!enable->get()) { spec()->outputs()[output]->condition(ConditionType::kNone); }
+  }
+
+  Operator::initialize();
+}
+
+void MultiFormatConverterOp::setup(OperatorSpec& spec) {
+  spec.param(out_tensor_name_,
+             "out_tensor_name",
+             "OutputTensorName",
+             "Name of the tensor output tensor.",
+             std::string(""));
+  spec.param(resize_width_,
+             "resize_width",
+             "ResizeWidth",
+             "Width of the tensor output, 0 for the source width.",
+             0);
+  spec.param(resize_height_,
+             "resize_height",
+             "ResizeHeight",
+             "Height of the tensor output, 0 for the source height.",
+             0);
+  spec.param(scale_min_,
+             "scale_min",
+             "Scale min",
+             "Value of the tensor output for a source value of 0.",
+             0.f);
+  spec.param(scale_max_,
+             "scale_max",
+             "Scale max",
+             "Value of the tensor output for a source value of 255.",
+             1.f);
+  spec.param(out_channel_order_,
+             "out_channel_order",
+             "OutputChannelOrder",
+             "Source channels (0 to 2) of the RGB channels of the tensor output.",
+             std::vector<int>{0, 1, 2});
+  spec.param(enable_tensor_output_,
+             "enable_tensor_output",
+             "EnableTensorOutput",
+             "Emit the float32 tensor output.",
+             true);
+  spec.param(enable_rgb_output_,
+             "enable_rgb_output",
+             "EnableRGBOutput",
+             "Emit the RGB888 output at the source resolution.",
+             false);
+  spec.param(rgb_tensor_name_,
+             "rgb_tensor_name",
+             "RGBTensorName",
+             "Name of the rgb output tensor.",
+             std::string(""));
+  spec.param(rgb_channel_order_,
+             "rgb_channel_order",
+             "RGBChannelOrder",
+             "Source channels (0 to 3) of the RGB channels of the rgb output.",
+             std::vector<int>{0, 1, 2});
+  spec.param(enable_rgba_output_,
+             "enable_rgba_output",
+             "EnableRGBAOutput",
+             "Emit the RGBA8888 output at the source resolution.",
+             false);
+  spec.param(rgba_tensor_name_,
+             "rgba_tensor_name",
+             "RGBATensorName",
+             "Name of the rgba output tensor.",
+             std::string(""));
+  spec.param(rgba_channel_order_,
+             "rgba_channel_order",
+             "RGBAChannelOrder",
+             "Source channels (0 to 3) of the RGBA channels of the rgba output.",
+             std::vector<int>{0, 1, 2, 3});
+  spec.param(alpha_value_,
+             "alpha_value",
+             "AlphaValue",
+             "Value of the source alpha channel (3) read by the rgb and rgba outputs.",
+             static_cast<uint8_t>(255));
+  spec.param(pool_, "pool", "Pool", "Pool allocating all the outputs.");
+
+  spec.input<holoscan::gxf::Entity>("source_video");
+  spec.output<holoscan::gxf::Entity>("tensor");
+  spec.output<holoscan::gxf::Entity>("rgb");
+  spec.output<holoscan::gxf::Entity>("rgba");
+
+  cuda_stream_handler_.define_params(spec);
+}
+
+void MultiFormatConverterOp::start() {
+  if (!enable_tensor_output_.get() && !enable_rgb_output_.get() && !enable_rgba_output_.get()) {
+    throw std::runtime_error("At least one output must be enabled");
+  }
+  if (resize_width_.get() < 0 || resize_height_.get() < 0) {
+    throw std::runtime_error("The resize width and height must not be negative");
+  }
+  check_channel_order(out_channel_order_.get(), 3, 2, "out_channel_order");
+  check_channel_order(rgb_channel_order_.get(), 3, 3, "rgb_channel_order");
+  check_channel_order(rgba_channel_order_.get(), 4, 3, "rgba_channel_order");
+}
+
+void MultiFormatConverterOp::stop() {
+  device_scratch_.freeBuffer();
+}
+
+nvidia::gxf::Expected<nvidia::gxf::Entity> MultiFormatConverterOp::create_output(
+    ExecutionContext& context, const nvidia::gxf::Handle<nvidia::gxf::Allocator>& allocator,
+    const std::string& name, const nvidia::gxf::Shape& shape,
+    nvidia::gxf::PrimitiveType element_type, void** pointer) {
+  auto out_message = CreateTensorMap(
+      context.context(),
+      allocator,
+      {{name,
+        nvidia::gxf::MemoryStorageType::kDevice,
+        shape,
+        element_type,
+        0,
+        nvidia::gxf::ComputeTrivialStrides(shape, nvidia::gxf::PrimitiveTypeSize(element_type))}},
+      false);
+  if (!out_message) { throw std::runtime_error("Failed to create the output message"); }
+  const auto tensor = out_message.value().get<nvidia::gxf::Tensor>();
+  if (!tensor || !tensor.value()->pointer()) {
+    throw std::runtime_error(fmt::format("Failed to allocate the {} output", name));
+  }
+  *pointer = tensor.value()->pointer();
+  return out_message;
+}
+
+void MultiFormatConverterOp::compute(InputContext& op_input, OutputContext& op_output,
+                                     ExecutionContext& context) {
+  auto maybe_entity = op_input.receive<holoscan::gxf::Entity>("source_video");
+  if (!maybe_entity) { throw std::runtime_error("Failed to receive input"); }
+
+  auto& entity = static_cast<nvidia::gxf::Entity&>(maybe_entity.value());
+
+  // get the CUDA stream from the input message
+  gxf_result_t stream_handler_result = cuda_stream_handler_.from_message(context.context(), entity);
+  if (stream_handler_result != GXF_SUCCESS) {
+    throw std::runtime_error("Failed to get the CUDA stream from incoming messages");
+  }
+  const cudaStream_t stream = cuda_stream_handler_.get_cuda_stream(context.context());
+
+  int width = 0;
+  int height = 0;
+  int channels = 0;
+  int pitch = 0;
+  const uint8_t* in_pointer = nullptr;
+  nvidia::gxf::MemoryStorageType storage_type = nvidia::gxf::MemoryStorageType::kDevice;
+
+  const auto maybe_video_buffer = entity.get<nvidia::gxf::VideoBuffer>();
+  if (maybe_video_buffer) {
+    const auto video_buffer = maybe_video_buffer.value();
+    const auto& info = video_buffer->video_frame_info();
+    if (info.color_format == nvidia::gxf::VideoFormat::GXF_VIDEO_FORMAT_RGBA) {
+      channels = 4;
+    } else if (info.color_format == nvidia::gxf::VideoFormat::GXF_VIDEO_FORMAT_RGB) {
+      channels = 3;
+    } else {
+      throw std::runtime_error("Input VideoBuffer must be of format RGBA or RGB");
+    }
+    width = static_cast<int>(info.width);
+    height = static_cast<int>(info.height);
+    pitch = static_cast<int>(info.color_planes[0].stride);
+    storage_type = video_buffer->storage_type();
+    in_pointer = video_buffer->pointer();
+  } else {
+    const auto maybe_tensor = entity.get<nvidia::gxf::Tensor>();
+    if (!maybe_tensor) {
+      throw std::runtime_error("Neither VideoBuffer not Tensor found in message");
+    }
+    const auto tensor = maybe_tensor.value();
+    if ((tensor->rank() != 3) ||
+        (tensor->shape().dimension(2) != 3 && tensor->shape().dimension(2) != 4) ||
+        (tensor->element_type() != nvidia::gxf::PrimitiveType::kUnsigned8)) {
+      throw std::runtime_error("Tensor must be of rank 3 and have 3 or 4 uint8 components");
+    }
+    width = tensor->shape().dimension(1);
+    height = tensor->shape().dimension(0);
+    channels = tensor->shape().dimension(2);
+    pitch = static_cast<int>(tensor->stride(0));
+    storage_type = tensor->storage_type();
+    in_pointer = tensor->pointer();
+  }
+
+  // get handle to underlying nvidia::gxf::Allocator from std::shared_ptr<holoscan::Allocator>
+  auto allocator = nvidia::gxf::Handle<nvidia::gxf::Allocator>::Create(
+      fragment()->executor().context(), pool_->gxf_cid());
+
+  // the kernel reads device memory, host inputs are copied to a buffer kept from frame to frame
+  if (storage_type != nvidia::gxf::MemoryStorageType::kDevice) {
+    const size_t row_size = static_cast<size_t>(width) * channels;
+    const size_t size = row_size * height;
+    if (device_scratch_.size() < size) {
+      cudaStreamSynchronize(stream);
+      device_scratch_.freeBuffer();
+      if (!device_scratch_.resize(
+              allocator.value(), size, nvidia::gxf::MemoryStorageType::kDevice)) {
+        throw std::runtime_error("Failed to allocate the input copy");
+      }
+    }
+    if (cudaMemcpy2DAsync(device_scratch_.pointer(),
+                          row_size,
+                          in_pointer,
+                          pitch,
+                          row_size,
+                          height,
+                          cudaMemcpyHostToDevice,
+                          stream) != cudaSuccess) {
+      throw std::runtime_error("Failed to copy the input to the device");
+    }
+    in_pointer = device_scratch_.pointer();
+    pitch = static_cast<int>(row_size);
+  }
+
+  MultiFormatOutputs outputs{};
+  std::vector<std::pair<nvidia::gxf::Expected<nvidia::gxf::Entity>, const char*>> out_messages;
+
+  if (enable_tensor_output_.get()) {
+    outputs.tensor_width = resize_width_.get() ? resize_width_.get() : width;
+    outputs.tensor_height = resize_height_.get() ? resize_height_.get() : height;
+    for (int c = 0; c < 3; ++c) { outputs.tensor_order[c] = out_channel_order_.get()[c]; }
+    outputs.scale = (scale_max_.get() - scale_min_.get()) / 255.f;
+    outputs.scale_offset = scale_min_.get();
+    void* pointer = nullptr;
+    auto message = create_output(context,
+                                 allocator.value(),
+                                 out_tensor_name_.get(),
+                                 nvidia::gxf::Shape{outputs.tensor_height, outputs.tensor_width, 3},
+                                 nvidia::gxf::PrimitiveType::kFloat32,
+                                 &pointer);
+    outputs.tensor = static_cast<float*>(pointer);
+    out_messages.emplace_back(std::move(message), "tensor");
+  }
+  if (enable_rgb_output_.get()) {
+    for (int c = 0; c < 3; ++c) { outputs.rgb_order[c] = rgb_channel_order_.get()[c]; }
+    void* pointer = nullptr;
+    auto message = create_output(context,
+                                 allocator.value(),
+                                 rgb_tensor_name_.get(),
+                                 nvidia::gxf::Shape{height, width, 3},
+                                 nvidia::gxf::PrimitiveType::kUnsigned8,
+                                 &pointer);
+    outputs.rgb = static_cast<uint8_t*>(pointer);
+    out_messages.emplace_back(std::move(message), "rgb");
+  }
+  if (enable_rgba_output_.get()) {
+    for (int c = 0; c < 4; ++c) { outputs.rgba_order[c] = rgba_channel_order_.get()[c]; }
+    void* pointer = nullptr;
+    auto message = create_output(context,
+                                 allocator.value(),
+                                 rgba_tensor_name_.get(),
+                                 nvidia::gxf::Shape{height, width, 4},
+                                 nvidia::gxf::PrimitiveType::kUnsigned8,
+                                 &pointer);
+    outputs.rgba = static_cast<uint8_t*>(pointer);
+    out_messages.emplace_back(std::move(message), "rgba");
+  }
+  outputs.alpha = alpha_value_.get();
+
+  const cudaError_t cuda_status =
+      convert_multi_format(in_pointer, pitch, channels, width, height, outputs, stream);
+  if (cuda_status != cudaSuccess) {
+    throw std::runtime_error(
+        fmt::format("Format conversion failed with error {}", cudaGetErrorString(cuda_status)));
+  }
+
+  for (auto& [message, port] : out_messages) {
+    // pass the CUDA stream to the output message
+    stream_handler_result = cuda_stream_handler_.to_message(message);
+    if (stream_handler_result != GXF_SUCCESS) {
+      throw std::runtime_error("Failed to add the CUDA stream to the outgoing messages");
+    }
+    auto result = gxf::Entity(std::move(message.value()));
+    op_output.emit(result, port);
+  }
+}
+
+}  // namespace holoscan::ops
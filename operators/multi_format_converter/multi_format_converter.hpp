@@ -0,0 +1,82 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef OPERATORS_MULTI_FORMAT_CONVERTER_MULTI_FORMAT_CONVERTER
+#define OPERATORS_MULTI_FORMAT_CONVERTER_MULTI_FORMAT_CONVERTER
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <gxf/std/memory_buffer.hpp>
+
+#include <holoscan/core/resources/gxf/allocator.hpp>
+#include <holoscan/holoscan.hpp>
+#include <holoscan/utils/cuda_stream_handler.hpp>
+
+namespace holoscan::ops {
+
+/**
+ * @brief Converts an RGB or RGBA uint8 frame to several formats with a single kernel
+ *
+ * Replaces a chain of FormatConverterOp reading the same source: the `tensor` output is the
+ * scaled, resized and reordered float32 frame an inference operator consumes, `rgb` the RGB888
+ * frame a recorder consumes and `rgba` the RGBA8888 frame a visualizer consumes. All the
+ * outputs are allocated from `pool` and written on the same CUDA stream.
+ */
+class MultiFormatConverterOp : public Operator {
+ public:
+  HOLOSCAN_OPERATOR_FORWARD_ARGS(MultiFormatConverterOp);
+
+  void initialize() override;
+  void setup(OperatorSpec& spec) override;
+  void start() override;
+  void compute(InputContext&, OutputContext& op_output, ExecutionContext&) override;
+  void stop() override;
+
+ private:
+  nvidia::gxf::Expected<nvidia::gxf::Entity> create_output(
+      ExecutionContext& context, const nvidia::gxf::Handle<nvidia::gxf::Allocator>& allocator,
+      const std::string& name, const nvidia::gxf::Shape& shape,
+      nvidia::gxf::PrimitiveType element_type, void** pointer);
+
+  Parameter<std::string> out_tensor_name_;
+  Parameter<int32_t> resize_width_;
+  Parameter<int32_t> resize_height_;
+  Parameter<float> scale_min_;
+  Parameter<float> scale_max_;
+  Parameter<std::vector<int>> out_channel_order_;
+  Parameter<bool> enable_tensor_output_;
+  Parameter<bool> enable_rgb_output_;
+  Parameter<std::string> rgb_tensor_name_;
+  Parameter<std::vector<int>> rgb_channel_order_;
+  Parameter<bool> enable_rgba_output_;
+  Parameter<std::string> rgba_tensor_name_;
+  Parameter<std::vector<int>> rgba_channel_order_;
+  Parameter<uint8_t> alpha_value_;
+  Parameter<std::shared_ptr<Allocator>> pool_;
+
+  // Device copy of host memory inputs
+  nvidia::gxf::MemoryBuffer device_scratch_;
+
+  CudaStreamHandler cuda_stream_handler_;
+};
+
+}  // namespace holoscan::ops
+
+#endif /* OPERATORS_MULTI_FORMAT_CONVERTER_MULTI_FORMAT_CONVERTER */
@@ -0,0 +1,141 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "multi_format_converter_kernels.hpp"
+
+namespace holoscan::ops {
+
+namespace {
+
+constexpr unsigned kBlockWidth = 32;
+constexpr unsigned kBlockHeight = 8;
+
+__device__ inline uchar4 load_pixel(const uint8_t* src, int src_pitch, int src_channels, int x,
+                                    int y, uint8_t alpha) {
+  const uint8_t* in = src + static_cast<size_t>(y) * src_pitch + x * src_channels;
+  return make_uchar4(in[0], in[1], in[2], alpha);
+}
+
+__device__ inline uint8_t component(const uchar4& p, int index) {
+  switch (index) {
+    case 0:
+      return p.x;
+    case 1:
+      return p.y;
+    case 2:
+      return p.z;
+    default:
+      return p.w;
+  }
+}
+
+__device__ inline float component(const float4& p, int index) {
+  switch (index) {
+    case 0:
+      return p.x;
+    case 1:
+      return p.y;
+    case 2:
+      return p.z;
+    default:
+      return p.w;
+  }
+}
+
+// Half pixel centers, as the NPP linear resize
+__device__ inline float4 sample_bilinear(const uint8_t* src, int src_pitch, int src_channels,
+                                         int width, int height, float sx, float sy) {
+  sx = fminf(fmaxf(sx, 0.f), static_cast<float>(width - 1));
+  sy = fminf(fmaxf(sy, 0.f), static_cast<float>(height - 1));
+  const int x0 = static_cast<int>(sx);
+  const int y0 = static_cast<int>(sy);
+  const int x1 = min(x0 + 1, width - 1);
+  const int y1 = min(y0 + 1, height - 1);
+  const float fx = sx - x0;
+  const float fy = sy - y0;
+
+  const uchar4 p00 = load_pixel(src, src_pitch, src_channels, x0, y0, 0);
+  const uchar4 p01 = load_pixel(src, src_pitch, src_channels, x1, y0, 0);
+  const uchar4 p10 = load_pixel(src, src_pitch, src_channels, x0, y1, 0);
+  const uchar4 p11 = load_pixel(src, src_pitch, src_channels, x1, y1, 0);
+  const float w00 = (1.f - fx) * (1.f - fy);
+  const float w01 = fx * (1.f - fy);
+  const float w10 = (1.f - fx) * fy;
+  const float w11 = fx * fy;
+  return make_float4(w00 * p00.x + w01 * p01.x + w10 * p10.x + w11 * p11.x,
+                     w00 * p00.y + w01 * p01.y + w10 * p10.y + w11 * p11.y,
+                     w00 * p00.z + w01 * p01.z + w10 * p10.z + w11 * p11.z,
+                     0.f);
+}
+
+// One thread per pixel of the largest of the source and tensor sizes
+__global__ void multi_format_kernel(const uint8_t* src, int src_pitch, int src_channels,
+                                    int width, int height, MultiFormatOutputs out) {
+  const int x = blockIdx.x * blockDim.x + threadIdx.x;
+  const int y = blockIdx.y * blockDim.y + threadIdx.y;
+
+  const bool same_size = out.tensor_width == width && out.tensor_height == height;
+  if (x < width && y < height && (out.rgb || out.rgba || (out.tensor && same_size))) {
+    const uchar4 p = load_pixel(src, src_pitch, src_channels, x, y, out.alpha);
+    const size_t index = static_cast<size_t>(y) * width + x;
+    if (out.rgb) {
+      uint8_t* dst = out.rgb + index * 3;
+      for (int c = 0; c < 3; ++c) { dst[c] = component(p, out.rgb_order[c]); }
+    }
+    if (out.rgba) {
+      uint8_t* dst = out.rgba + index * 4;
+      for (int c = 0; c < 4; ++c) { dst[c] = component(p, out.rgba_order[c]); }
+    }
+    if (out.tensor && same_size) {
+      float* dst = out.tensor + index * 3;
+      for (int c = 0; c < 3; ++c) {
+        dst[c] = out.scale_offset + out.scale * component(p, out.tensor_order[c]);
+      }
+    }
+  }
+
+  if (out.tensor && !same_size && x < out.tensor_width && y < out.tensor_height) {
+    const float sx = (x + 0.5f) * width / out.tensor_width - 0.5f;
+    const float sy = (y + 0.5f) * height / out.tensor_height - 0.5f;
+    const float4 p = sample_bilinear(src, src_pitch, src_channels, width, height, sx, sy);
+    float* dst = out.tensor + (static_cast<size_t>(y) * out.tensor_width + x) * 3;
+    for (int c = 0; c < 3; ++c) {
+      dst[c] = out.scale_offset + out.scale * component(p, out.tensor_order[c]);
+    }
+  }
+}
+
+}  // namespace
+
+cudaError_t convert_multi_format(const uint8_t* src, int src_pitch, int src_channels, int width,
+                                 int height, const MultiFormatOutputs& outputs,
+                                 cudaStream_t stream) {
+  int grid_width = width;
+  int grid_height = height;
+  if (outputs.tensor) {
+    grid_width = max(grid_width, outputs.tensor_width);
+    grid_height = max(grid_height, outputs.tensor_height);
+  }
+  const dim3 block(kBlockWidth, kBlockHeight);
+  const dim3 grid((grid_width + kBlockWidth - 1) / kBlockWidth,
+                  (grid_height + kBlockHeight - 1) / kBlockHeight);
+  multi_format_kernel<<<grid, block, 0, stream>>>(
+      src, src_pitch, src_channels, width, height, outputs);
+  return cudaGetLastError();
+}
+
+}  // namespace holoscan::ops
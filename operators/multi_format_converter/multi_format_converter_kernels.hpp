@@ -0,0 +1,67 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef OPERATORS_MULTI_FORMAT_CONVERTER_MULTI_FORMAT_CONVERTER_KERNELS
+#define OPERATORS_MULTI_FORMAT_CONVERTER_MULTI_FORMAT_CONVERTER_KERNELS
+
+#include <cstdint>
+
+#include <cuda_runtime.h>
+
+namespace holoscan::ops {
+
+/**
+ * @brief Outputs written by convert_multi_format(), a null pointer disabling an output
+ *
+ * The channel orders index the R, G, B and A components of the source pixel, the A component
+ * being `alpha` for all outputs.
+ */
+struct MultiFormatOutputs {
+  // float32 HWC, 3 channels, of size tensor_width x tensor_height
+  float* tensor;
+  int tensor_width;
+  int tensor_height;
+  int tensor_order[3];
+  // tensor = scale_offset + value * scale
+  float scale;
+  float scale_offset;
+
+  // uint8 HWC, 3 channels, at the source resolution
+  uint8_t* rgb;
+  int rgb_order[3];
+
+  // uint8 HWC, 4 channels, at the source resolution
+  uint8_t* rgba;
+  int rgba_order[4];
+  uint8_t alpha;
+};
+
+/**
+ * @brief Converts an RGB or RGBA uint8 image to all the outputs of `outputs` in one pass
+ *
+ * The tensor output is resized with bilinear interpolation when its size differs from the
+ * source one.
+ *
+ * @return the launch error, if any
+ */
+cudaError_t convert_multi_format(const uint8_t* src, int src_pitch, int src_channels, int width,
+                                 int height, const MultiFormatOutputs& outputs,
+                                 cudaStream_t stream);
+
+}  // namespace holoscan::ops
+
+#endif /* OPERATORS_MULTI_FORMAT_CONVERTER_MULTI_FORMAT_CONVERTER_KERNELS */
@@ -20,34 +20,45 @@
 #include <npp.h>
 #include <gxf/multimedia/video.hpp>
 
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include "npp_filter_kernels.hpp"
+
 struct NppStreamContext_ : public NppStreamContext {};
 
 namespace holoscan::ops {
 
-/**
- * @brief Given a mask size adjust the ROI avoiding out of bounds memory accesses.
- *
- * @param mask_size mask size
- * @param size ROI size
- * @return adjusted ROI
- */
-static NppiSize adjust_roi(uint32_t mask_size, const NppiSize& size) {
-  return NppiSize{size.width - (int(mask_size) - 1), size.height - (int(mask_size) - 1)};
+static NppiMaskSize gauss_mask_size(uint32_t mask_size) {
+  switch (mask_size) {
+    case 3:
+      return NPP_MASK_SIZE_3_X_3;
+    case 5:
+      return NPP_MASK_SIZE_5_X_5;
+    case 7:
+      return NPP_MASK_SIZE_7_X_7;
+    case 9:
+      return NPP_MASK_SIZE_9_X_9;
+    case 11:
+      return NPP_MASK_SIZE_11_X_11;
+    case 13:
+      return NPP_MASK_SIZE_13_X_13;
+    default:
+      throw std::runtime_error("Unsupported mask size");
+  }
+}
+
+static bool is_sobel(const std::string& filter) {
+  return filter == "SobelHoriz" || filter == "SobelVert" || filter == "SobelMagnitude";
 }
 
 /**
- * @brief Given a mask size adjust the ROI avoiding out of bounds memory accesses.
- *
- * @param mask_size mask size
- * @param color_plane color plane information
- * @param address color plane information
- * @return adjusted address
+ * @brief Address of the first pixel of a region of an RGBA image
  */
-static void* adjust_roi_address(uint32_t mask_size, const nvidia::gxf::ColorPlane& color_plane,
-                                void* address) {
-  return reinterpret_cast<void*>(reinterpret_cast<uintptr_t>(address) +
-                                 (mask_size / 2) * color_plane.stride +
-                                 (mask_size / 2) * color_plane.bytes_per_pixel);
+template <typename T>
+static T* region_address(T* image, int pitch, const NppFilterOp::Region& region) {
+  return image + static_cast<size_t>(region.y) * pitch + 4 * region.x;
 }
 
 void NppFilterOp::initialize() {
@@ -65,11 +76,23 @@ void NppFilterOp::setup(OperatorSpec& spec) {
              "Filter",
              "Name of the filter to apply (supported Gauss, SobelHoriz, SobelVert).",
              std::string(""));
+  spec.param(filters_,
+             "filters",
+             "Filters",
+             "Filters applied in order, replacing filter when not empty (supported Gauss, "
+             "SobelHoriz, SobelVert, SobelMagnitude).",
+             std::vector<std::string>());
   spec.param(mask_size_,
              "mask_size",
              "MaskSize",
              "Filter mask size (supported values 3, 5, 7, 9, 11, 13).",
              3u);
+  spec.param(roi_,
+             "roi",
+             "ROI",
+             "Region filtered, as x, y, width and height, outside of which the input is copied "
+             "to the output. Empty for the whole frame.",
+             std::vector<int32_t>());
   spec.param(allocator_, "allocator", "Allocator", "Allocator to allocate output tensor.");
 
   spec.input<holoscan::gxf::Entity>("input");
@@ -78,6 +101,123 @@ void NppFilterOp::setup(OperatorSpec& spec) {
   cuda_stream_handler_.define_params(spec);
 }
 
+void NppFilterOp::start() {
+  std::vector<std::string> filters = filters_.get();
+  if (filters.empty()) { filters.push_back(filter_.get()); }
+
+  // A 3x3 Gauss filter followed by a Sobel filter runs as one fused kernel
+  stages_.clear();
+  for (size_t i = 0; i < filters.size(); ++i) {
+    const std::string& filter = filters[i];
+    if (filter == "Gauss") {
+      gauss_mask_size(mask_size_.get());
+      if (mask_size_.get() == 3 && i + 1 < filters.size() && is_sobel(filters[i + 1])) {
+        const std::string& sobel = filters[++i];
+        stages_.push_back(sobel == "SobelHoriz"  ? Stage::kGaussSobelHoriz
+                          : sobel == "SobelVert" ? Stage::kGaussSobelVert
+                                                 : Stage::kGaussSobelMagnitude);
+      } else {
+        stages_.push_back(Stage::kGauss);
+      }
+    } else if (filter == "SobelHoriz") {
+      stages_.push_back(Stage::kSobelHoriz);
+    } else if (filter == "SobelVert") {
+      stages_.push_back(Stage::kSobelVert);
+    } else if (filter == "SobelMagnitude") {
+      stages_.push_back(Stage::kSobelMagnitude);
+    } else {
+      throw std::runtime_error(fmt::format("Unknown filter {}.", filter));
+    }
+  }
+
+  if (!roi_.get().empty() && roi_.get().size() != 4) {
+    throw std::runtime_error("The ROI must be given as x, y, width and height");
+  }
+
+  if (cudaEventCreateWithFlags(&scratch_event_, cudaEventDisableTiming) != cudaSuccess) {
+    throw std::runtime_error("Failed to create the scratch buffer event");
+  }
+}
+
+void NppFilterOp::stop() {
+  if (scratch_event_) {
+    cudaEventSynchronize(scratch_event_);
+    cudaEventDestroy(scratch_event_);
+    scratch_event_ = nullptr;
+  }
+  for (auto& scratch : scratch_) { scratch.freeBuffer(); }
+}
+
+uint32_t NppFilterOp::stage_radius(Stage stage) const {
+  switch (stage) {
+    case Stage::kGauss:
+      return mask_size_.get() / 2;
+    case Stage::kGaussSobelHoriz:
+    case Stage::kGaussSobelVert:
+    case Stage::kGaussSobelMagnitude:
+      return 2;
+    default:
+      return 1;
+  }
+}
+
+void NppFilterOp::run_stage(Stage stage, const uint8_t* src, int src_pitch, uint8_t* dst,
+                            int dst_pitch, const Region& region) {
+  const NppiSize size{region.width, region.height};
+  const Npp8u* src_roi = region_address(src, src_pitch, region);
+  Npp8u* dst_roi = region_address(dst, dst_pitch, region);
+  NppStatus status = NPP_SUCCESS;
+  cudaError_t cuda_status = cudaSuccess;
+  switch (stage) {
+    case Stage::kGauss:
+      status = nppiFilterGauss_8u_C4R_Ctx(src_roi,
+                                          src_pitch,
+                                          dst_roi,
+                                          dst_pitch,
+                                          size,
+                                          gauss_mask_size(mask_size_.get()),
+                                          *npp_stream_ctx_.get());
+      break;
+    case Stage::kSobelHoriz:
+      status = nppiFilterSobelHoriz_8u_C4R_Ctx(
+          src_roi, src_pitch, dst_roi, dst_pitch, size, *npp_stream_ctx_.get());
+      break;
+    case Stage::kSobelVert:
+      status = nppiFilterSobelVert_8u_C4R_Ctx(
+          src_roi, src_pitch, dst_roi, dst_pitch, size, *npp_stream_ctx_.get());
+      break;
+    default: {
+      const bool gauss = stage != Stage::kSobelMagnitude;
+      const SobelMode mode =
+          (stage == Stage::kGaussSobelHoriz)  ? SobelMode::kHoriz
+          : (stage == Stage::kGaussSobelVert) ? SobelMode::kVert
+                                              : SobelMode::kMagnitude;
+      cuda_status = sobel_rgba(src,
+                               src_pitch,
+                               dst,
+                               dst_pitch,
+                               region.x,
+                               region.y,
+                               region.width,
+                               region.height,
+                               mode,
+                               gauss,
+                               npp_stream_ctx_->hStream);
+      break;
+    }
+  }
+  if (status != NPP_SUCCESS) {
+    throw std::runtime_error(fmt::format("Filter stage {} failed with error {}",
+                                         static_cast<int>(stage),
+                                         static_cast<int>(status)));
+  }
+  if (cuda_status != cudaSuccess) {
+    throw std::runtime_error(fmt::format("Filter stage {} failed with error {}",
+                                         static_cast<int>(stage),
+                                         cudaGetErrorString(cuda_status)));
+  }
+}
+
 void NppFilterOp::compute(InputContext& op_input, OutputContext& op_output,
                           ExecutionContext& context) {
   auto maybe_entity = op_input.receive<holoscan::gxf::Entity>("input");
@@ -212,79 +352,87 @@ void NppFilterOp::compute(InputContext& op_input, OutputContext& op_output,
     out_pointer = tensor.value()->pointer();
   }
 
-  const NppiSize src_size = {static_cast<int>(in_video_buffer_info.width),
-                             static_cast<int>(in_video_buffer_info.height)};
-  NppStatus status = NPP_ERROR;
-  // Execute the filter.
+  // Execute the filters.
   // Note: these filters execute neighborhood operations. Therefore the ROI (region of interest),
   // needs to be adjusted to avoid accessing pixels outside of the image. This will result in a
   // black border on the output image. See
   // https://docs.nvidia.com/cuda/archive/11.1.0/npp/nppi_conventions_lb.html#sampling_beyond_image_boundaries
-  // for more information
-  if (filter_.get() == "Gauss") {
-    NppiMaskSize nppi_mask_size_enum;
-    switch (mask_size_) {
-      case 3:
-        nppi_mask_size_enum = NPP_MASK_SIZE_3_X_3;
-        break;
-      case 5:
-        nppi_mask_size_enum = NPP_MASK_SIZE_5_X_5;
-        break;
-      case 7:
-        nppi_mask_size_enum = NPP_MASK_SIZE_7_X_7;
-        break;
-      case 9:
-        nppi_mask_size_enum = NPP_MASK_SIZE_9_X_9;
-        break;
-      case 11:
-        nppi_mask_size_enum = NPP_MASK_SIZE_11_X_11;
-        break;
-      case 13:
-        nppi_mask_size_enum = NPP_MASK_SIZE_13_X_13;
-        break;
-      default:
-        throw std::runtime_error("Unsupported mask size");
+  // for more information.
+  // Each stage filters the region the next one reads, the region of the next one grown by the
+  // radius of its mask. The last region is the ROI, less the radius of all the masks at the
+  // image borders.
+  const int width = static_cast<int>(in_video_buffer_info.width);
+  const int height = static_cast<int>(in_video_buffer_info.height);
+  Region roi{0, 0, width, height};
+  if (!roi_.get().empty()) {
+    const auto& r = roi_.get();
+    roi = Region{r[0], r[1], r[2], r[3]};
+  }
+  int border = 0;
+  for (auto stage : stages_) { border += stage_radius(stage); }
+  std::vector<Region> regions(stages_.size());
+  {
+    const int x0 = std::max(roi.x, border);
+    const int y0 = std::max(roi.y, border);
+    const int x1 = std::min(roi.x + roi.width, width - border);
+    const int y1 = std::min(roi.y + roi.height, height - border);
+    regions.back() = Region{x0, y0, std::max(x1 - x0, 0), std::max(y1 - y0, 0)};
+  }
+  if (regions.back().width == 0 || regions.back().height == 0) {
+    throw std::runtime_error("The ROI does not contain any pixel the filters can compute");
+  }
+  for (size_t i = regions.size() - 1; i > 0; --i) {
+    const int radius = static_cast<int>(stage_radius(stages_[i]));
+    const Region& next = regions[i];
+    regions[i - 1] = Region{
+        next.x - radius, next.y - radius, next.width + 2 * radius, next.height + 2 * radius};
+  }
+
+  const cudaStream_t stream = npp_stream_ctx_->hStream;
+  const int in_pitch = static_cast<int>(in_video_buffer_info.color_planes[0].stride);
+  const int out_pitch = static_cast<int>(out_video_buffer_info.color_planes[0].stride);
+  if (!roi_.get().empty()) {
+    if (cudaMemcpy2DAsync(out_pointer,
+                          out_pitch,
+                          in_pointer,
+                          in_pitch,
+                          static_cast<size_t>(width) * 4,
+                          height,
+                          cudaMemcpyDeviceToDevice,
+                          stream) != cudaSuccess) {
+      throw std::runtime_error("Failed to copy the input outside of the ROI");
     }
+  }
 
-    status = nppiFilterGauss_8u_C4R_Ctx(
-        static_cast<const Npp8u*>(
-            adjust_roi_address(mask_size_, in_video_buffer_info.color_planes[0], in_pointer)),
-        in_video_buffer_info.color_planes[0].stride,
-        static_cast<Npp8u*>(
-            adjust_roi_address(mask_size_, out_video_buffer_info.color_planes[0], out_pointer)),
-        out_video_buffer_info.color_planes[0].stride,
-        adjust_roi(mask_size_, src_size),
-        nppi_mask_size_enum,
-        *npp_stream_ctx_.get());
-  } else if (filter_.get() == "SobelHoriz") {
-    const uint32_t mask_size = 3;
-    status = nppiFilterSobelHoriz_8u_C4R_Ctx(
-        static_cast<const Npp8u*>(
-            adjust_roi_address(mask_size, in_video_buffer_info.color_planes[0], in_pointer)),
-        in_video_buffer_info.color_planes[0].stride,
-        static_cast<Npp8u*>(
-            adjust_roi_address(mask_size, out_video_buffer_info.color_planes[0], out_pointer)),
-        out_video_buffer_info.color_planes[0].stride,
-        adjust_roi(mask_size, src_size),
-        *npp_stream_ctx_.get());
-  } else if (filter_.get() == "SobelVert") {
-    const uint32_t mask_size = 3;
-    status = nppiFilterSobelVert_8u_C4R_Ctx(
-        static_cast<const Npp8u*>(
-            adjust_roi_address(mask_size, in_video_buffer_info.color_planes[0], in_pointer)),
-        in_video_buffer_info.color_planes[0].stride,
-        static_cast<Npp8u*>(
-            adjust_roi_address(mask_size, out_video_buffer_info.color_planes[0], out_pointer)),
-        out_video_buffer_info.color_planes[0].stride,
-        adjust_roi(mask_size, src_size),
-        *npp_stream_ctx_.get());
-  } else {
-    throw std::runtime_error(fmt::format("Unknown filter {}.", filter_.get()));
+  // Intermediate stages ping-pong between two scratch buffers, kept from frame to frame. The
+  // previous frame may have used them on another stream.
+  const int scratch_pitch = width * 4;
+  if (stages_.size() > 1) {
+    const size_t scratch_size = static_cast<size_t>(scratch_pitch) * height;
+    for (size_t i = 0; i < std::min<size_t>(stages_.size() - 1, 2); ++i) {
+      if (scratch_[i].size() >= scratch_size) { continue; }
+      cudaEventSynchronize(scratch_event_);
+      scratch_[i].freeBuffer();
+      if (!scratch_[i].resize(allocator.value(),
+                              scratch_size,
+                              nvidia::gxf::MemoryStorageType::kDevice)) {
+        throw std::runtime_error("Failed to allocate the filter scratch buffers");
+      }
+    }
+    cudaStreamWaitEvent(stream, scratch_event_, 0);
   }
-  if (status != NPP_SUCCESS) {
-    throw std::runtime_error(
-        fmt::format("Filter {} failed with error {}", filter_.get(), static_cast<int>(status)));
+
+  const uint8_t* src = static_cast<const uint8_t*>(in_pointer);
+  int src_pitch = in_pitch;
+  for (size_t i = 0; i < stages_.size(); ++i) {
+    const bool last = i + 1 == stages_.size();
+    uint8_t* dst = last ? static_cast<uint8_t*>(out_pointer) : scratch_[i % 2].pointer();
+    const int dst_pitch = last ? out_pitch : scratch_pitch;
+    run_stage(stages_[i], src, src_pitch, dst, dst_pitch, regions[i]);
+    src = dst;
+    src_pitch = dst_pitch;
   }
+  if (stages_.size() > 1) { cudaEventRecord(scratch_event_, stream); }
 
   // pass the CUDA stream to the output message
   stream_handler_result = cuda_stream_handler_.to_message(out_message);
@@ -18,7 +18,14 @@
 #ifndef OPERATORS_NPP_FILTER_NPP_FILTER
 #define OPERATORS_NPP_FILTER_NPP_FILTER
 
+#include <cuda_runtime.h>
+
+#include <array>
 #include <memory>
+#include <string>
+#include <vector>
+
+#include <gxf/std/memory_buffer.hpp>
 
 #include <holoscan/core/resources/gxf/allocator.hpp>
 #include <holoscan/holoscan.hpp>
@@ -34,13 +41,45 @@ class NppFilterOp : public Operator {
 
   void initialize() override;
   void setup(OperatorSpec& spec) override;
+  void start() override;
   void compute(InputContext&, OutputContext& op_output, ExecutionContext&) override;
+  void stop() override;
+
+  struct Region {
+    int x;
+    int y;
+    int width;
+    int height;
+  };
 
  private:
+  enum class Stage {
+    kGauss,
+    kSobelHoriz,
+    kSobelVert,
+    kSobelMagnitude,
+    // 3x3 Gauss and Sobel filters, fused
+    kGaussSobelHoriz,
+    kGaussSobelVert,
+    kGaussSobelMagnitude,
+  };
+
+  // Pixels read around each output pixel
+  uint32_t stage_radius(Stage stage) const;
+  void run_stage(Stage stage, const uint8_t* src, int src_pitch, uint8_t* dst, int dst_pitch,
+                 const Region& region);
+
   Parameter<std::string> filter_;
+  Parameter<std::vector<std::string>> filters_;
   Parameter<uint32_t> mask_size_;
+  Parameter<std::vector<int32_t>> roi_;
   Parameter<std::shared_ptr<Allocator>> allocator_;
 
+  std::vector<Stage> stages_;
+  std::array<nvidia::gxf::MemoryBuffer, 2> scratch_;
+  // Recorded after the last use of the scratch buffers
+  cudaEvent_t scratch_event_ = nullptr;
+
   std::shared_ptr<NppStreamContext_> npp_stream_ctx_;
 
   CudaStreamHandler cuda_stream_handler_;
@@ -0,0 +1,132 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "npp_filter_kernels.hpp"
+
+namespace holoscan::ops {
+
+namespace {
+
+constexpr int kBlockWidth = 32;
+constexpr int kBlockHeight = 8;
+// Sobel input of a block, with a 1 pixel apron
+constexpr int kTileWidth = kBlockWidth + 2;
+constexpr int kTileHeight = kBlockHeight + 2;
+
+__device__ inline int4 to_int4(uchar4 v) {
+  return make_int4(v.x, v.y, v.z, v.w);
+}
+
+__device__ inline int4 operator+(int4 a, int4 b) {
+  return make_int4(a.x + b.x, a.y + b.y, a.z + b.z, a.w + b.w);
+}
+
+__device__ inline int4 operator-(int4 a, int4 b) {
+  return make_int4(a.x - b.x, a.y - b.y, a.z - b.z, a.w - b.w);
+}
+
+__device__ inline int4 operator*(int s, int4 a) {
+  return make_int4(s * a.x, s * a.y, s * a.z, s * a.w);
+}
+
+__device__ inline uint8_t saturate(int v) {
+  return static_cast<uint8_t>(min(max(v, 0), 255));
+}
+
+__device__ inline uint8_t magnitude(int h, int v) {
+  return static_cast<uint8_t>(fminf(sqrtf(static_cast<float>(h * h + v * v)) + 0.5f, 255.f));
+}
+
+__device__ inline uchar4 load(const uint8_t* image, int pitch, int x, int y) {
+  return *reinterpret_cast<const uchar4*>(image + static_cast<size_t>(y) * pitch + 4 * x);
+}
+
+// 1 2 1 / 2 4 2 / 1 2 1, divided by 16 with rounding
+__device__ uchar4 gauss3(const uint8_t* src, int pitch, int x, int y) {
+  int4 sum = make_int4(8, 8, 8, 8);
+  for (int dy = -1; dy <= 1; ++dy) {
+    for (int dx = -1; dx <= 1; ++dx) {
+      const int weight = (2 - abs(dx)) * (2 - abs(dy));
+      sum = sum + weight * to_int4(load(src, pitch, x + dx, y + dy));
+    }
+  }
+  return make_uchar4(sum.x >> 4, sum.y >> 4, sum.z >> 4, sum.w >> 4);
+}
+
+// Each block first stages its Sobel input in shared memory, read from src or filtered with
+// the Gauss mask, then filters it
+__global__ void sobel_kernel(const uint8_t* src, int src_pitch, uint8_t* dst, int dst_pitch,
+                             int x0, int y0, int width, int height, SobelMode mode, bool gauss) {
+  __shared__ uchar4 tile[kTileHeight][kTileWidth];
+
+  const int bx = x0 + blockIdx.x * kBlockWidth;
+  const int by = y0 + blockIdx.y * kBlockHeight;
+  const int tid = threadIdx.y * kBlockWidth + threadIdx.x;
+  for (int i = tid; i < kTileWidth * kTileHeight; i += kBlockWidth * kBlockHeight) {
+    // Clamped to the apron of the region, which is inside the image
+    const int tx = min(bx - 1 + i % kTileWidth, x0 + width);
+    const int ty = min(by - 1 + i / kTileWidth, y0 + height);
+    tile[i / kTileWidth][i % kTileWidth] =
+        gauss ? gauss3(src, src_pitch, tx, ty) : load(src, src_pitch, tx, ty);
+  }
+  __syncthreads();
+
+  const int x = bx + threadIdx.x;
+  const int y = by + threadIdx.y;
+  if (x >= x0 + width || y >= y0 + height) { return; }
+
+  const int cx = threadIdx.x + 1;
+  const int cy = threadIdx.y + 1;
+  auto at = [&](int dx, int dy) { return to_int4(tile[cy + dy][cx + dx]); };
+  // Masks of nppiFilterSobelHoriz and nppiFilterSobelVert
+  const int4 horiz =
+      (at(-1, 1) + 2 * at(0, 1) + at(1, 1)) - (at(-1, -1) + 2 * at(0, -1) + at(1, -1));
+  const int4 vert =
+      (at(-1, -1) + 2 * at(-1, 0) + at(-1, 1)) - (at(1, -1) + 2 * at(1, 0) + at(1, 1));
+
+  uchar4 out;
+  switch (mode) {
+    case SobelMode::kHoriz:
+      out = make_uchar4(saturate(horiz.x), saturate(horiz.y), saturate(horiz.z), saturate(horiz.w));
+      break;
+    case SobelMode::kVert:
+      out = make_uchar4(saturate(vert.x), saturate(vert.y), saturate(vert.z), saturate(vert.w));
+      break;
+    default:
+      out = make_uchar4(magnitude(horiz.x, vert.x),
+                        magnitude(horiz.y, vert.y),
+                        magnitude(horiz.z, vert.z),
+                        magnitude(horiz.w, vert.w));
+      break;
+  }
+  *reinterpret_cast<uchar4*>(dst + static_cast<size_t>(y) * dst_pitch + 4 * x) = out;
+}
+
+}  // namespace
+
+cudaError_t sobel_rgba(const uint8_t* src, int src_pitch, uint8_t* dst, int dst_pitch, int x,
+                       int y, int width, int height, SobelMode mode, bool gauss,
+                       cudaStream_t stream) {
+  if (width <= 0 || height <= 0) { return cudaSuccess; }
+  const dim3 block(kBlockWidth, kBlockHeight);
+  const dim3 grid((width + kBlockWidth - 1) / kBlockWidth,
+                  (height + kBlockHeight - 1) / kBlockHeight);
+  sobel_kernel<<<grid, block, 0, stream>>>(
+      src, src_pitch, dst, dst_pitch, x, y, width, height, mode, gauss);
+  return cudaGetLastError();
+}
+
+}  // namespace holoscan::ops
@@ -0,0 +1,45 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef OPERATORS_NPP_FILTER_NPP_FILTER_KERNELS
+#define OPERATORS_NPP_FILTER_NPP_FILTER_KERNELS
+
+#include <cstdint>
+
+#include <cuda_runtime.h>
+
+namespace holoscan::ops {
+
+enum class SobelMode { kHoriz, kVert, kMagnitude };
+
+/**
+ * @brief 3x3 Sobel filter of an RGBA image, optionally after a 3x3 Gauss filter, in one pass
+ *
+ * The region at (x, y) of size width x height is written to dst, src and dst pointing at the
+ * first pixel of their images. Neighbors are read from src, so the region must be inside the
+ * image by 1 pixel, 2 with gauss. The masks, rounding and saturation are those of the NPP
+ * filters, the gauss result is rounded to 8 bits before the Sobel filter as with two NPP
+ * passes. The magnitude is sqrt(horiz^2 + vert^2). All four channels are filtered.
+ *
+ * @return the launch error, if any
+ */
+cudaError_t sobel_rgba(const uint8_t* src, int src_pitch, uint8_t* dst, int dst_pitch, int x,
+                       int y, int width, int height, SobelMode mode, bool gauss,
+                       cudaStream_t stream);
+
+}  // namespace holoscan::ops
+
+#endif /* OPERATORS_NPP_FILTER_NPP_FILTER_KERNELS */
@@ -17,6 +17,8 @@
 
 #include "openigtlink_rx.hpp"
 
+#include <utility>
+
 #include "igtlImageMessage.h"
 
 #ifndef CUDA_TRY
@@ -37,6 +39,46 @@
 
 namespace holoscan::ops {
 
+namespace {
+
+// Lets the receive thread notice stop() while no message arrives, and a peer that stalls in
+// the middle of a message close the connection
+constexpr int kReceiveTimeoutMs = 1000;
+constexpr int kConnectionWaitMs = 100;
+
+bool to_primitive_type(int scalar_type, nvidia::gxf::PrimitiveType* dtype) {
+  switch (scalar_type) {
+    case igtl::ImageMessage::TYPE_INT8:
+      *dtype = nvidia::gxf::PrimitiveType::kInt8;
+      return true;
+    case igtl::ImageMessage::TYPE_UINT8:
+      *dtype = nvidia::gxf::PrimitiveType::kUnsigned8;
+      return true;
+    case igtl::ImageMessage::TYPE_INT16:
+      *dtype = nvidia::gxf::PrimitiveType::kInt16;
+      return true;
+    case igtl::ImageMessage::TYPE_UINT16:
+      *dtype = nvidia::gxf::PrimitiveType::kUnsigned16;
+      return true;
+    case igtl::ImageMessage::TYPE_INT32:
+      *dtype = nvidia::gxf::PrimitiveType::kInt32;
+      return true;
+    case igtl::ImageMessage::TYPE_UINT32:
+      *dtype = nvidia::gxf::PrimitiveType::kUnsigned32;
+      return true;
+    case igtl::ImageMessage::TYPE_FLOAT32:
+      *dtype = nvidia::gxf::PrimitiveType::kFloat32;
+      return true;
+    case igtl::ImageMessage::TYPE_FLOAT64:
+      *dtype = nvidia::gxf::PrimitiveType::kFloat64;
+      return true;
+    default:
+      return false;
+  }
+}
+
+}  // namespace
+
 void OpenIGTLinkRxOp::setup(OperatorSpec& spec) {
   auto& out_tensor = spec.output<gxf::Entity>("out_tensor");
 
@@ -63,30 +105,221 @@ void OpenIGTLinkRxOp::setup(OperatorSpec& spec) {
     "Flip width and height (necessary for receiving from 3D Slicer).",
     true);
   spec.param(allocator_, "allocator", "Allocator", "Output Allocator");
+  spec.param(
+    num_buffers_,
+    "num_buffers",
+    "NumBuffers",
+    "Number of pinned host buffers images are received into before they are uploaded.",
+    4u);
+  cuda_stream_handler_.define_params(spec);
+}
+
+void OpenIGTLinkRxOp::initialize() {
+  // Schedule the operator only when an image is queued
+  image_available_ = fragment()->make_condition<AsynchronousCondition>(name() + "_image");
+  add_arg(image_available_);
+  Operator::initialize();
 }
 
 void OpenIGTLinkRxOp::start() {
-  // Create client socket
+  if (num_buffers_.get() < 2) { throw std::runtime_error("num_buffers must be at least 2."); }
+  buffers_.resize(num_buffers_.get());
+  for (size_t i = 0; i < buffers_.size(); ++i) {
+    if (CUDA_TRY(cudaEventCreateWithFlags(&buffers_[i].uploaded, cudaEventDisableTiming)) !=
+        cudaSuccess) {
+      throw std::runtime_error("Failed to create CUDA event.");
+    }
+    free_buffers_.push_back(i);
+  }
+
+  // Create server socket
   server_socket_ = igtl::ServerSocket::New();
   HOLOSCAN_LOG_INFO("Creating OpenIGTLink server socket...");
   int r = server_socket_->CreateServer(port_.get());
   if (r < 0) {
     throw std::runtime_error("Cannot create server socket.");
   }
-  socket_ = server_socket_->WaitForConnection(1000);
   HOLOSCAN_LOG_INFO("Creating server socket successful");
   // Create timer
   time_stamp_ = igtl::TimeStamp::New();
+
+  image_available_->event_state(AsynchronousEventState::EVENT_WAITING);
+  stopping_ = false;
+  receive_thread_ = std::thread(&OpenIGTLinkRxOp::receive_messages, this);
 }
 
 void OpenIGTLinkRxOp::stop() {
+  stopping_ = true;
+  image_available_->event_state(AsynchronousEventState::EVENT_NEVER);
+  if (receive_thread_.joinable()) { receive_thread_.join(); }
+
   // Close connection
-  socket_->CloseSocket();
+  if (socket_.IsNotNull()) { socket_->CloseSocket(); }
   server_socket_->CloseSocket();
+
+  for (auto& buffer : buffers_) {
+    CUDA_TRY(cudaEventSynchronize(buffer.uploaded));
+    CUDA_TRY(cudaEventDestroy(buffer.uploaded));
+    CUDA_TRY(cudaFreeHost(buffer.data));
+  }
+  buffers_.clear();
+  free_buffers_.clear();
+  images_.clear();
+  if (dropped_images_ > 0) {
+    HOLOSCAN_LOG_INFO("OpenIGTLink receiver dropped {} images", dropped_images_);
+  }
+  dropped_images_ = 0;
+}
+
+void OpenIGTLinkRxOp::receive_messages() {
+  while (!stopping_) {
+    if (socket_.IsNull()) {
+      socket_ = server_socket_->WaitForConnection(kConnectionWaitMs);
+      if (socket_.IsNull()) { continue; }
+      socket_->SetReceiveTimeout(kReceiveTimeoutMs);
+      HOLOSCAN_LOG_INFO("OpenIGTLink client connected");
+    }
+    bool connected = false;
+    try {
+      connected = receive_message();
+    } catch (const std::exception& e) {
+      HOLOSCAN_LOG_ERROR("OpenIGTLink receive failed: {}", e.what());
+    }
+    if (!connected) {
+      // Wait for the peer to reconnect
+      HOLOSCAN_LOG_INFO("OpenIGTLink client disconnected");
+      socket_->CloseSocket();
+      socket_ = nullptr;
+    }
+  }
+}
+
+bool OpenIGTLinkRxOp::receive_message() {
+  igtl::MessageHeader::Pointer header = igtl::MessageHeader::New();
+  header->InitPack();
+  bool timeout = false;
+  igtlUint64 r = socket_->Receive(header->GetPackPointer(), header->GetPackSize(), timeout);
+  if (r == 0) {
+    // Idle until the timeout, or closed by the peer
+    return timeout;
+  }
+  if (r != header->GetPackSize()) {
+    throw std::runtime_error("Packet size zero.");
+  }
+
+  // Deserialize the header
+  header->Unpack();
+  if (header->GetHeaderVersion() != IGTL_HEADER_VERSION_2) {
+    throw std::runtime_error("Version of the client and server doesn't match.");
+  }
+
+  // Get time stamp
+  igtlUint32 sec;
+  igtlUint32 nanosec;
+  header->GetTimeStamp(time_stamp_);
+  time_stamp_->GetTimeStamp(&sec, &nanosec);
+
+  if (strcmp(header->GetDeviceType(), "IMAGE") != 0) {
+    // OBS: Could be GetDeviceName()
+    HOLOSCAN_LOG_INFO("Skipping : {}", header->GetDeviceType());
+    socket_->Skip(header->GetBodySizeToRead(), 0);
+    return true;
+  }
+
+  // Receive image data
+  igtl::ImageMessage::Pointer image_msg = igtl::ImageMessage::New();
+  image_msg->SetMessageHeader(header);
+  image_msg->AllocatePack();
+
+  r = socket_->Receive(image_msg->GetPackBodyPointer(), image_msg->GetPackBodySize(), timeout);
+  if (r != image_msg->GetPackBodySize()) {
+    throw std::runtime_error("Failed to receive image message body.");
+  }
+  int c = image_msg->Unpack(1);
+  if (!(c & igtl::MessageHeader::UNPACK_BODY)) {
+    throw std::runtime_error("Unpacking body failed");
+  }
+  int size[3];
+  image_msg->GetDimensions(size);
+  const int num_components = image_msg->GetNumComponents();
+
+  // Holoscan data type from IGT scalar type
+  Image image;
+  if (!to_primitive_type(image_msg->GetScalarType(), &image.dtype)) {
+    HOLOSCAN_LOG_ERROR("Skipping image of unsupported data type {}", image_msg->GetScalarType());
+    return true;
+  }
+  // Shape
+  if (flip_width_height_) {
+    image.shape = {size[1], size[0], num_components};
+  } else {
+    image.shape = {size[0], size[1], num_components};
+  }
+  // Size
+  image.bytes_size = static_cast<size_t>(size[0]) * size[1] * num_components *
+                     nvidia::gxf::PrimitiveTypeSize(image.dtype);
+
+  // Copy the image out of the message, so that compute only has to upload it
+  image.buffer = acquire_buffer(image.bytes_size);
+  memcpy(buffers_[image.buffer].data, image_msg->GetScalarPointer(), image.bytes_size);
+  queue_image(image);
+  return true;
+}
+
+size_t OpenIGTLinkRxOp::acquire_buffer(size_t size) {
+  size_t index;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (free_buffers_.empty()) {
+      // compute holds at most one buffer, so with num_buffers >= 2 an image is queued
+      index = images_.front().buffer;
+      images_.pop_front();
+      ++dropped_images_;
+    } else {
+      index = free_buffers_.front();
+      free_buffers_.pop_front();
+    }
+  }
+
+  Buffer& buffer = buffers_[index];
+  // The buffer may be the source of an upload that is still in flight
+  CUDA_TRY(cudaEventSynchronize(buffer.uploaded));
+  if (buffer.capacity < size) {
+    CUDA_TRY(cudaFreeHost(buffer.data));
+    buffer.data = nullptr;
+    buffer.capacity = 0;
+    if (CUDA_TRY(cudaHostAlloc(&buffer.data, size, cudaHostAllocDefault)) != cudaSuccess) {
+      std::lock_guard<std::mutex> lock(mutex_);
+      free_buffers_.push_back(index);
+      throw std::runtime_error("Failed to allocate pinned image buffer.");
+    }
+    buffer.capacity = size;
+  }
+  return index;
+}
+
+void OpenIGTLinkRxOp::queue_image(const Image& image) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  images_.push_back(image);
+  if (image_available_->event_state() == AsynchronousEventState::EVENT_WAITING) {
+    image_available_->event_state(AsynchronousEventState::EVENT_DONE);
+  }
 }
 
 void OpenIGTLinkRxOp::compute(InputContext& op_input, OutputContext& op_output,
               ExecutionContext& context) {
+  Image image;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (images_.empty()) {
+      image_available_->event_state(AsynchronousEventState::EVENT_WAITING);
+      return;
+    }
+    image = images_.front();
+    images_.pop_front();
+  }
+  Buffer& buffer = buffers_[image.buffer];
+
   auto entity = nvidia::gxf::Entity::New(context.context());
   if (!entity) {
     throw std::runtime_error("Failed to allocate message for output tensor.");
@@ -102,108 +335,37 @@ void OpenIGTLinkRxOp::compute(InputContext& op_input, OutputContext& op_output,
     throw std::runtime_error("Failed to allocate output tensor.");
   }
 
-  if (socket_.IsNotNull()) {
-    igtl::MessageHeader::Pointer header;
-    while (1) {
-      header = igtl::MessageHeader::New();
-      header->InitPack();
-      bool timeout = false;
-      igtlUint64 r = socket_->Receive(header->GetPackPointer(), header->GetPackSize(), timeout);
-      if (r == 0) {
-        throw std::runtime_error("Failed to receive message.");
-      }
-      if (r != header->GetPackSize()) {
-        throw std::runtime_error("Packet size zero.");
-      }
-
-      // Deserialize the header
-      header->Unpack();
-      if (header->GetHeaderVersion() != IGTL_HEADER_VERSION_2) {
-        throw std::runtime_error("Version of the client and server doesn't match.");
-      }
-
-      // Get time stamp
-      igtlUint32 sec;
-      igtlUint32 nanosec;
-      header->GetTimeStamp(time_stamp_);
-      time_stamp_->GetTimeStamp(&sec, &nanosec);
-
-      if (strcmp(header->GetDeviceType(), "IMAGE") == 0) {
-        // OBS: Could be GetDeviceName()
-        break;
-      } else {
-        HOLOSCAN_LOG_INFO("Skipping : {}", header->GetDeviceType());
-        socket_->Skip(header->GetBodySizeToRead(), 0);
-      }
-    }
-
-    igtl::ImageMessage::Pointer image_msg;
-    int scalar_type;
-    int size[3];
-    int num_components;
-
-    // Receive image data
-    image_msg = igtl::ImageMessage::New();
-    image_msg->SetMessageHeader(header);
-    image_msg->AllocatePack();
-
-    bool timeout = false;
-    socket_->Receive(image_msg->GetPackBodyPointer(), image_msg->GetPackBodySize(), timeout);
-    int c = image_msg->Unpack(1);
+  const uint64_t bytes_per_element = nvidia::gxf::PrimitiveTypeSize(image.dtype);
+  auto strides = nvidia::gxf::ComputeTrivialStrides(image.shape, bytes_per_element);
+  auto reshape_result = tensor.value()->reshapeCustom(
+      image.shape, image.dtype, bytes_per_element, strides,
+      nvidia::gxf::MemoryStorageType::kDevice, allocator.value());
+  if (!reshape_result) {
+    throw std::runtime_error("Failed to generate tensor.");
+  }
 
-    if (c & igtl::MessageHeader::UNPACK_BODY) {
-      scalar_type = image_msg->GetScalarType();
-      image_msg->GetDimensions(size);
-      num_components = image_msg->GetNumComponents();
-    } else {
-      throw std::runtime_error("Unpacking body failed");
-    }
+  // Upload the image, handing the buffer back to the receive thread, which waits for the
+  // copy to finish before reusing it
+  const std::vector<holoscan::gxf::Entity> no_messages;
+  if (cuda_stream_handler_.from_messages(context.context(), no_messages) != GXF_SUCCESS) {
+    throw std::runtime_error("Failed to get the CUDA stream for the upload.");
+  }
+  cudaStream_t stream = cuda_stream_handler_.get_cuda_stream(context.context());
+  CUDA_TRY(cudaMemcpyAsync(tensor.value()->pointer(), buffer.data, image.bytes_size,
+                           cudaMemcpyHostToDevice, stream));
+  CUDA_TRY(cudaEventRecord(buffer.uploaded, stream));
+  // Downstream operators can't sync on the default stream from the message, so the image
+  // tensor is only emitted once the upload is done
+  if (stream == cudaStreamDefault) { CUDA_TRY(cudaStreamSynchronize(stream)); }
+  if (cuda_stream_handler_.to_message(entity) != GXF_SUCCESS) {
+    throw std::runtime_error("Failed to add the CUDA stream to the output message.");
+  }
 
-    // Holoscan data type from IGT scalar type
-    nvidia::gxf::PrimitiveType dtype;
-    if (scalar_type == igtl::ImageMessage::TYPE_INT8) {
-      dtype = nvidia::gxf::PrimitiveType::kInt8;
-    } else if (scalar_type == igtl::ImageMessage::TYPE_UINT8) {
-      dtype = nvidia::gxf::PrimitiveType::kUnsigned8;
-    } else if (scalar_type == igtl::ImageMessage::TYPE_INT16) {
-      dtype = nvidia::gxf::PrimitiveType::kInt16;
-    } else if (scalar_type == igtl::ImageMessage::TYPE_UINT16) {
-      dtype = nvidia::gxf::PrimitiveType::kUnsigned16;
-    } else if (scalar_type == igtl::ImageMessage::TYPE_INT32) {
-      dtype = nvidia::gxf::PrimitiveType::kInt32;
-    } else if (scalar_type == igtl::ImageMessage::TYPE_UINT32) {
-      dtype = nvidia::gxf::PrimitiveType::kUnsigned32;
-    } else if (scalar_type == igtl::ImageMessage::TYPE_FLOAT32) {
-      dtype = nvidia::gxf::PrimitiveType::kFloat32;
-    } else if (scalar_type == igtl::ImageMessage::TYPE_FLOAT64) {
-      dtype = nvidia::gxf::PrimitiveType::kFloat64;
-    } else {
-      throw std::runtime_error("Unsupported data type.");
-    }
-    // Shape
-    nvidia::gxf::Shape shape;
-    if (flip_width_height_) {
-      shape = {size[1], size[0], num_components};
-    } else {
-      shape = {size[0], size[1], num_components};
-    }
-    // Size
-    const uint64_t bytes_per_element = nvidia::gxf::PrimitiveTypeSize(dtype);
-    auto strides = nvidia::gxf::ComputeTrivialStrides(shape, bytes_per_element);
-    int bytes_size = size[0] * size[1] * num_components * bytes_per_element;
-    // Allocate tensor
-    auto reshape_result = tensor.value()->reshapeCustom(
-        shape, dtype, bytes_per_element, strides, nvidia::gxf::MemoryStorageType::kDevice,
-        allocator.value());
-    if (!reshape_result) {
-      throw std::runtime_error("Failed to generate tensor.");
-    }
-    // Copy data from OpenIGTLink message to tensor
-    CUDA_TRY(cudaMemcpy(
-      (void*)tensor.value()->pointer(),
-      image_msg->GetScalarPointer(),
-      bytes_size,
-      cudaMemcpyHostToDevice));
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    free_buffers_.push_back(image.buffer);
+    image_available_->event_state(images_.empty() ? AsynchronousEventState::EVENT_WAITING
+                                                  : AsynchronousEventState::EVENT_DONE);
   }
 
   // Emit output message
@@ -18,7 +18,16 @@
 #ifndef HOLOSCAN_OPERATORS_OPENIGTLINK_RX_HPP
 #define HOLOSCAN_OPERATORS_OPENIGTLINK_RX_HPP
 
+#include <atomic>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
 #include <holoscan/holoscan.hpp>
+#include <holoscan/utils/cuda_stream_handler.hpp>
 
 #include "igtlMessageHeader.h"
 #include "igtlServerSocket.h"
@@ -26,26 +35,71 @@
 
 namespace holoscan::ops {
 
+/**
+ * @brief Operator class to receive images using the OpenIGTLink protocol.
+ *
+ * Messages are received and decoded on a dedicated thread, into a pool of `num_buffers`
+ * pinned host buffers. Each tick drains one decoded image, uploads it with `cudaMemcpyAsync`
+ * into a device tensor from `allocator`, and emits it; the operator is only scheduled when an
+ * image is queued. When the pool is exhausted, the oldest queued image is dropped, so a slow
+ * pipeline does not stall the connection and a slow peer does not stall the pipeline.
+ */
 class OpenIGTLinkRxOp : public Operator {
  public:
   HOLOSCAN_OPERATOR_FORWARD_ARGS(OpenIGTLinkRxOp)
 
+  void initialize() override;
   void start() override;
   void stop() override;
   void setup(OperatorSpec& spec) override;
   void compute(InputContext& input, OutputContext& output, ExecutionContext& context) override;
 
  private:
+  // Pinned host buffer holding one decoded image
+  struct Buffer {
+    void* data = nullptr;
+    size_t capacity = 0;
+    // End of the last upload out of data
+    cudaEvent_t uploaded = nullptr;
+  };
+
+  struct Image {
+    size_t buffer;
+    nvidia::gxf::PrimitiveType dtype;
+    nvidia::gxf::Shape shape;
+    size_t bytes_size;
+  };
+
+  void receive_messages();
+  // Receives the next message, queueing it if it is an image. False if the connection is lost.
+  bool receive_message();
+  // Returns a free buffer of at least size bytes, dropping the oldest image if none is free
+  size_t acquire_buffer(size_t size);
+  void queue_image(const Image& image);
+
   Parameter<holoscan::IOSpec*> out_;
   Parameter<std::shared_ptr<Allocator>> allocator_;
   Parameter<std::string> out_tensor_name_;
   Parameter<int> port_;
   Parameter<bool> flip_width_height_;
+  Parameter<uint32_t> num_buffers_;
+  CudaStreamHandler cuda_stream_handler_;
+  std::shared_ptr<AsynchronousCondition> image_available_;
+
   igtl::ServerSocket::Pointer server_socket_;
   igtl::Socket::Pointer socket_;
-  igtl::MessageHeader::Pointer header_;
   std::map<std::string, std::string> input_;
   igtl::TimeStamp::Pointer time_stamp_;
+
+  // Owned by the receive thread while free or being filled, and by compute while uploaded
+  std::vector<Buffer> buffers_;
+  std::deque<size_t> free_buffers_;
+  std::deque<Image> images_;
+  uint64_t dropped_images_ = 0;
+  std::mutex mutex_;
+
+  std::atomic<bool> stopping_ = false;
+  std::thread receive_thread_;
 };
 
 }  // namespace holoscan::ops
@@ -17,11 +17,17 @@
 
 #include "openigtlink_tx.hpp"
 
+#include <algorithm>
+#include <utility>
+
 #include "holoscan/operators/holoviz/buffer_info.hpp"
 #include "gxf/multimedia/video.hpp"
 
 #include "igtl_util.h"
 
+#include "openigtlink_tx_downscale.hpp"
+#include "openigtlink_tx_tiles.hpp"
+
 #ifndef CUDA_TRY
 #define CUDA_TRY(stmt)                                                                     \
   ({                                                                                       \
@@ -74,6 +80,39 @@ void OpenIGTLinkTxOp::setup(OperatorSpec& spec) {
     "InputNames",
     "Names of input messages.",
     std::vector<std::string>{});
+  spec.param(
+    crop_,
+    "crop",
+    "Crop",
+    "Region [x, y, width, height] of the images to send, all of them if empty.",
+    std::vector<int32_t>{});
+  spec.param(
+    downscale_,
+    "downscale",
+    "Downscale",
+    "Integer factor the (cropped) images are downscaled by on the GPU before they are sent.",
+    1u);
+  spec.param(
+    asynchronous_send_,
+    "asynchronous_send",
+    "AsynchronousSend",
+    "Send on a dedicated thread, replacing a frame still pending by the next one.",
+    false);
+  spec.param(
+    tile_size_,
+    "tile_size",
+    "TileSize",
+    "Send only the tiles of tile_size x tile_size pixels changed since the previous frame, as "
+    "sub-volume image messages. 0 sends full images.",
+    0u);
+  spec.param(
+    keyframe_interval_,
+    "keyframe_interval",
+    "KeyframeInterval",
+    "With tile_size, frames between full images, so that receivers joining or missing a frame "
+    "catch up.",
+    30u);
+  cuda_stream_handler_.define_params(spec);
 }
 
 void OpenIGTLinkTxOp::start() {
@@ -87,13 +126,87 @@ void OpenIGTLinkTxOp::start() {
   HOLOSCAN_LOG_INFO("Connection successful");
   // Create timer
   time_stamp_ = igtl::TimeStamp::New();
+
+  if (!crop_.get().empty() && crop_.get().size() != 4) {
+    throw std::runtime_error("crop must be empty or [x, y, width, height].");
+  }
+  if (downscale_.get() < 1) { throw std::runtime_error("downscale must be at least 1."); }
+  if (tile_size_.get() > 0 && keyframe_interval_.get() < 1) {
+    throw std::runtime_error("keyframe_interval must be at least 1.");
+  }
+
+  if (asynchronous_send_.get()) {
+    stopping_ = false;
+    send_thread_ = std::thread(&OpenIGTLinkTxOp::send_messages, this);
+  }
 }
 
 void OpenIGTLinkTxOp::stop() {
+  if (send_thread_.joinable()) {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      stopping_ = true;
+    }
+    frame_pending_.notify_all();
+    send_thread_.join();
+    pending_.clear();
+    resync_ = false;
+    if (dropped_frames_ > 0) {
+      HOLOSCAN_LOG_INFO("OpenIGTLink transmitter replaced {} pending frames", dropped_frames_);
+    }
+    dropped_frames_ = 0;
+  }
+
   // Close connection
   client_socket_->CloseSocket();
+
+  CUDA_TRY(cudaFree(input_scratch_));
+  input_scratch_ = nullptr;
+  input_scratch_size_ = 0;
+  CUDA_TRY(cudaFree(output_scratch_));
+  output_scratch_ = nullptr;
+  output_scratch_size_ = 0;
+  for (auto& [name, state] : tile_states_) {
+    CUDA_TRY(cudaFree(state.previous));
+    CUDA_TRY(cudaFree(state.changed));
+  }
+  tile_states_.clear();
 }
 
+void OpenIGTLinkTxOp::send_messages() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  while (true) {
+    frame_pending_.wait(lock, [this] { return stopping_ || !pending_.empty(); });
+    if (stopping_) { break; }
+    std::vector<igtl::ImageMessage::Pointer> messages;
+    messages.swap(pending_);
+    lock.unlock();
+    for (auto& image_msg : messages) {
+      image_msg->Pack();
+      if (client_socket_->Send(image_msg->GetPackPointer(), image_msg->GetPackSize()) == 0) {
+        HOLOSCAN_LOG_ERROR("Failed to send OpenIGTLink image message.");
+      }
+    }
+    lock.lock();
+  }
+}
+
+namespace {
+
+// Grows the device buffer to at least size bytes
+void reserve_scratch(void** buffer, size_t* capacity, size_t size) {
+  if (*capacity >= size) { return; }
+  CUDA_TRY(cudaFree(*buffer));
+  *buffer = nullptr;
+  *capacity = 0;
+  if (CUDA_TRY(cudaMalloc(buffer, size)) != cudaSuccess) {
+    throw std::runtime_error("Failed to allocate OpenIGTLink scratch buffer.");
+  }
+  *capacity = size;
+}
+
+}  // namespace
+
 void OpenIGTLinkTxOp::compute(InputContext& op_input, OutputContext& op_output,
               ExecutionContext& context) {
   std::vector<gxf::Entity> messages_h =
@@ -107,6 +220,25 @@ void OpenIGTLinkTxOp::compute(InputContext& op_input, OutputContext& op_output,
     messages.push_back(message);
   }
 
+  // Copies and downscaling run on the stream of the inputs
+  if (cuda_stream_handler_.from_messages(context.context(), messages) != GXF_SUCCESS) {
+    throw std::runtime_error("Failed to get the CUDA stream from incoming messages");
+  }
+  cudaStream_t stream = cuda_stream_handler_.get_cuda_stream(context.context());
+
+  if (tile_size_.get() > 0 && asynchronous_send_.get()) {
+    // The receivers missed the tiles of a replaced frame, start over from a full image
+    bool resync = false;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      std::swap(resync, resync_);
+    }
+    if (resync) {
+      for (auto& [name, state] : tile_states_) { state.frames_since_keyframe = 0; }
+    }
+  }
+
+  std::vector<igtl::ImageMessage::Pointer> image_msgs;
   for (int i=0; i < input_names_.get().size(); ++i) {
     // Loop over input messages
     auto message = messages.begin();
@@ -138,75 +270,9 @@ void OpenIGTLinkTxOp::compute(InputContext& op_input, OutputContext& op_output,
       }
 
       // If the buffer is empty, skip processing it
-      if (buffer_info.bytes_size == 0) { continue; }
-
-      // Get time stamp
-      time_stamp_->GetTime();
-      // Image properties
-      int size[] = {
-        static_cast<int>(buffer_info.width),
-        static_cast<int>(buffer_info.height),
-        1
-      };
-      float spacing[]  = {1.0, 1.0, 1.0};
-      int endian = igtl::ImageMessage::ENDIAN_BIG;
-      if (igtl_is_little_endian()) {
-        endian = igtl::ImageMessage::ENDIAN_LITTLE;
-      }
-      // IGT scalar type from Holoscan data type
-      int scalar_type;
-      if (buffer_info.element_type == nvidia::gxf::PrimitiveType::kInt8) {
-        scalar_type = igtl::ImageMessage::TYPE_INT8;
-      } else if (buffer_info.element_type == nvidia::gxf::PrimitiveType::kUnsigned8) {
-        scalar_type = igtl::ImageMessage::TYPE_UINT8;
-      } else if (buffer_info.element_type == nvidia::gxf::PrimitiveType::kInt16) {
-        scalar_type = igtl::ImageMessage::TYPE_INT16;
-      } else if (buffer_info.element_type == nvidia::gxf::PrimitiveType::kUnsigned16) {
-        scalar_type = igtl::ImageMessage::TYPE_UINT16;
-      } else if (buffer_info.element_type == nvidia::gxf::PrimitiveType::kInt32) {
-        scalar_type = igtl::ImageMessage::TYPE_INT32;
-      } else if (buffer_info.element_type == nvidia::gxf::PrimitiveType::kUnsigned32) {
-        scalar_type = igtl::ImageMessage::TYPE_UINT32;
-      } else if (buffer_info.element_type == nvidia::gxf::PrimitiveType::kFloat32) {
-        scalar_type = igtl::ImageMessage::TYPE_FLOAT32;
-      } else if (buffer_info.element_type == nvidia::gxf::PrimitiveType::kFloat64) {
-        scalar_type = igtl::ImageMessage::TYPE_FLOAT64;
-      } else {
-        throw std::runtime_error("Unsupported scalar type.");
-      }
-      // Create OpenIGTLink image message
-      igtl::ImageMessage::Pointer image_msg = igtl::ImageMessage::New();
-      image_msg->SetDimensions(size);
-      image_msg->SetSpacing(spacing);
-      image_msg->SetScalarType(scalar_type);
-      image_msg->SetEndian(endian);
-      image_msg->SetDeviceName(device_name_.get());
-      image_msg->SetTimeStamp(time_stamp_);
-      image_msg->SetNumComponents(buffer_info.components);
-      image_msg->AllocateScalars();
-      // Copy image data to message
-      if (buffer_info.storage_type == nvidia::gxf::MemoryStorageType::kDevice) {
-        // Copy device to host
-        CUDA_TRY(cudaMemcpy(
-          image_msg->GetScalarPointer(),
-          static_cast<const void*>(buffer_info.buffer_ptr),
-          buffer_info.bytes_size,
-          cudaMemcpyDeviceToHost));
-      } else {
-        // Copy host to host
-        std::memcpy(
-          image_msg->GetScalarPointer(),
-          static_cast<const void*>(buffer_info.buffer_ptr),
-          image_msg->GetImageSize());
-      }
-      // Set orientation matrix to identity
-      igtl::Matrix4x4 matrix;
-      identity_matrix(matrix);
-      image_msg->SetMatrix(matrix);
-      // Send message
-      image_msg->Pack();
-      client_socket_->Send(image_msg->GetPackPointer(), image_msg->GetPackSize());
+      if (buffer_info.bytes_size == 0) { break; }
 
+      create_image_messages(name, buffer_info, stream, image_msgs);
       break;
     }
 
@@ -215,6 +281,229 @@ void OpenIGTLinkTxOp::compute(InputContext& op_input, OutputContext& op_output,
         fmt::format("Tensor named `{}` not found in input messages.", name));
     }
   }
+
+  if (asynchronous_send_.get()) {
+    // Hand the frame to the sender, replacing the previous one if it is still pending
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (!pending_.empty()) {
+        ++dropped_frames_;
+        resync_ = tile_size_.get() > 0;
+      }
+      pending_ = std::move(image_msgs);
+    }
+    frame_pending_.notify_one();
+    return;
+  }
+
+  for (auto& image_msg : image_msgs) {
+    // Send message
+    image_msg->Pack();
+    client_socket_->Send(image_msg->GetPackPointer(), image_msg->GetPackSize());
+  }
+}
+
+void OpenIGTLinkTxOp::create_image_messages(const std::string& name,
+                                             const BufferInfo& buffer_info, cudaStream_t stream,
+                                             std::vector<igtl::ImageMessage::Pointer>& image_msgs) {
+  // Get time stamp
+  time_stamp_->GetTime();
+
+  // Region to send
+  int x = 0;
+  int y = 0;
+  int width = static_cast<int>(buffer_info.width);
+  int height = static_cast<int>(buffer_info.height);
+  const auto& crop = crop_.get();
+  if (!crop.empty()) {
+    x = std::clamp(crop[0], 0, width);
+    y = std::clamp(crop[1], 0, height);
+    width = std::min(crop[2], width - x);
+    height = std::min(crop[3], height - y);
+  }
+  const int factor = static_cast<int>(downscale_.get());
+  const int out_width = width / factor;
+  const int out_height = height / factor;
+  if (out_width <= 0 || out_height <= 0) {
+    throw std::runtime_error("Cropped and downscaled image is empty.");
+  }
+
+  // IGT scalar type from Holoscan data type
+  int scalar_type;
+  if (buffer_info.element_type == nvidia::gxf::PrimitiveType::kInt8) {
+    scalar_type = igtl::ImageMessage::TYPE_INT8;
+  } else if (buffer_info.element_type == nvidia::gxf::PrimitiveType::kUnsigned8) {
+    scalar_type = igtl::ImageMessage::TYPE_UINT8;
+  } else if (buffer_info.element_type == nvidia::gxf::PrimitiveType::kInt16) {
+    scalar_type = igtl::ImageMessage::TYPE_INT16;
+  } else if (buffer_info.element_type == nvidia::gxf::PrimitiveType::kUnsigned16) {
+    scalar_type = igtl::ImageMessage::TYPE_UINT16;
+  } else if (buffer_info.element_type == nvidia::gxf::PrimitiveType::kInt32) {
+    scalar_type = igtl::ImageMessage::TYPE_INT32;
+  } else if (buffer_info.element_type == nvidia::gxf::PrimitiveType::kUnsigned32) {
+    scalar_type = igtl::ImageMessage::TYPE_UINT32;
+  } else if (buffer_info.element_type == nvidia::gxf::PrimitiveType::kFloat32) {
+    scalar_type = igtl::ImageMessage::TYPE_FLOAT32;
+  } else if (buffer_info.element_type == nvidia::gxf::PrimitiveType::kFloat64) {
+    scalar_type = igtl::ImageMessage::TYPE_FLOAT64;
+  } else {
+    throw std::runtime_error("Unsupported scalar type.");
+  }
+
+  const size_t pixel_size =
+      nvidia::gxf::PrimitiveTypeSize(buffer_info.element_type) * buffer_info.components;
+  const size_t pitch = buffer_info.stride[0];
+  const void* src = buffer_info.buffer_ptr + y * pitch + x * pixel_size;
+  const size_t out_row_size = out_width * pixel_size;
+  const bool tiles = tile_size_.get() > 0;
+  if (factor == 1 && !tiles) {
+    // Copy the region, device or host to host
+    igtl::ImageMessage::Pointer image_msg =
+        new_image_message(out_width, out_height, scalar_type, buffer_info.components);
+    image_msg->AllocateScalars();
+    CUDA_TRY(cudaMemcpy2DAsync(image_msg->GetScalarPointer(), out_row_size, src, pitch,
+                               out_row_size, out_height, cudaMemcpyDefault, stream));
+    CUDA_TRY(cudaStreamSynchronize(stream));
+    image_msgs.push_back(image_msg);
+    return;
+  }
+
+  // Downscale and compare tiles on the device, uploading host images first
+  size_t src_pitch = pitch;
+  if (buffer_info.storage_type != nvidia::gxf::MemoryStorageType::kDevice) {
+    src_pitch = width * pixel_size;
+    reserve_scratch(&input_scratch_, &input_scratch_size_, src_pitch * height);
+    CUDA_TRY(cudaMemcpy2DAsync(input_scratch_, src_pitch, src, pitch, src_pitch, height,
+                               cudaMemcpyHostToDevice, stream));
+    src = input_scratch_;
+  }
+  if (factor > 1) {
+    reserve_scratch(&output_scratch_, &output_scratch_size_, out_row_size * out_height);
+    if (CUDA_TRY(downscale_image(src, src_pitch, scalar_type, buffer_info.components, factor,
+                                 output_scratch_, out_width, out_height, stream)) !=
+        cudaSuccess) {
+      throw std::runtime_error("Failed to downscale the image.");
+    }
+    src = output_scratch_;
+    src_pitch = out_row_size;
+  }
+  if (tiles) {
+    append_changed_tiles(name, src, src_pitch, out_width, out_height, scalar_type,
+                         buffer_info.components, pixel_size, stream, image_msgs);
+    return;
+  }
+  igtl::ImageMessage::Pointer image_msg =
+      new_image_message(out_width, out_height, scalar_type, buffer_info.components);
+  image_msg->AllocateScalars();
+  CUDA_TRY(cudaMemcpyAsync(image_msg->GetScalarPointer(), src, out_row_size * out_height,
+                           cudaMemcpyDeviceToHost, stream));
+  CUDA_TRY(cudaStreamSynchronize(stream));
+  image_msgs.push_back(image_msg);
+}
+
+igtl::ImageMessage::Pointer OpenIGTLinkTxOp::new_image_message(int width, int height,
+                                                               int scalar_type, int components) {
+  // Image properties
+  int size[] = {width, height, 1};
+  float spacing[]  = {1.0, 1.0, 1.0};
+  int endian = igtl::ImageMessage::ENDIAN_BIG;
+  if (igtl_is_little_endian()) {
+    endian = igtl::ImageMessage::ENDIAN_LITTLE;
+  }
+  // Create OpenIGTLink image message
+  igtl::ImageMessage::Pointer image_msg = igtl::ImageMessage::New();
+  image_msg->SetDimensions(size);
+  image_msg->SetSpacing(spacing);
+  image_msg->SetScalarType(scalar_type);
+  image_msg->SetEndian(endian);
+  image_msg->SetDeviceName(device_name_.get());
+  image_msg->SetTimeStamp(time_stamp_);
+  image_msg->SetNumComponents(components);
+
+  // Set orientation matrix to identity
+  igtl::Matrix4x4 matrix;
+  identity_matrix(matrix);
+  image_msg->SetMatrix(matrix);
+  return image_msg;
+}
+
+void OpenIGTLinkTxOp::append_changed_tiles(const std::string& name, const void* image,
+                                           size_t pitch, int width, int height, int scalar_type,
+                                           int components, size_t pixel_size,
+                                           cudaStream_t stream,
+                                           std::vector<igtl::ImageMessage::Pointer>& image_msgs) {
+  const int tile_size = static_cast<int>(tile_size_.get());
+  const int tiles_x = (width + tile_size - 1) / tile_size;
+  const int tiles_y = (height + tile_size - 1) / tile_size;
+  const size_t row_size = width * pixel_size;
+
+  TileState& state = tile_states_[name];
+  if (state.width != width || state.height != height || state.pixel_size != pixel_size) {
+    // A new image layout starts with a keyframe
+    CUDA_TRY(cudaFree(state.previous));
+    CUDA_TRY(cudaFree(state.changed));
+    state = TileState{};
+    if (CUDA_TRY(cudaMalloc(&state.previous, row_size * height)) != cudaSuccess ||
+        CUDA_TRY(cudaMalloc(reinterpret_cast<void**>(&state.changed), tiles_x * tiles_y)) !=
+            cudaSuccess) {
+      throw std::runtime_error("Failed to allocate the OpenIGTLink tile buffers.");
+    }
+    state.changed_host.resize(tiles_x * tiles_y);
+    state.width = width;
+    state.height = height;
+    state.pixel_size = pixel_size;
+  }
+  const bool keyframe = state.frames_since_keyframe == 0;
+  state.frames_since_keyframe = (state.frames_since_keyframe + 1) % keyframe_interval_.get();
+
+  if (CUDA_TRY(diff_tiles(image, pitch, state.previous, row_size, height,
+                          static_cast<int>(pixel_size), tile_size, state.changed, stream)) !=
+      cudaSuccess) {
+    throw std::runtime_error("Failed to compare the image tiles.");
+  }
+
+  if (keyframe) {
+    igtl::ImageMessage::Pointer image_msg =
+        new_image_message(width, height, scalar_type, components);
+    image_msg->AllocateScalars();
+    CUDA_TRY(cudaMemcpy2DAsync(image_msg->GetScalarPointer(), row_size, image, pitch, row_size,
+                               height, cudaMemcpyDeviceToHost, stream));
+    CUDA_TRY(cudaStreamSynchronize(stream));
+    image_msgs.push_back(image_msg);
+    return;
+  }
+
+  CUDA_TRY(cudaMemcpyAsync(state.changed_host.data(), state.changed, state.changed_host.size(),
+                           cudaMemcpyDeviceToHost, stream));
+  CUDA_TRY(cudaStreamSynchronize(stream));
+
+  // One sub-volume per run of changed tiles in a tile row
+  const size_t first_msg = image_msgs.size();
+  for (int tile_y = 0; tile_y < tiles_y; ++tile_y) {
+    for (int tile_x = 0; tile_x < tiles_x; ++tile_x) {
+      if (!state.changed_host[tile_y * tiles_x + tile_x]) { continue; }
+      int run_end = tile_x + 1;
+      while (run_end < tiles_x && state.changed_host[tile_y * tiles_x + run_end]) { ++run_end; }
+      const int x = tile_x * tile_size;
+      const int y = tile_y * tile_size;
+      int sub_size[] = {std::min(run_end * tile_size, width) - x,
+                        std::min(tile_size, height - y), 1};
+      int sub_index[] = {x, y, 0};
+
+      igtl::ImageMessage::Pointer image_msg =
+          new_image_message(width, height, scalar_type, components);
+      image_msg->SetSubVolume(sub_size, sub_index);
+      image_msg->AllocateScalars();
+      const size_t sub_row_size = sub_size[0] * pixel_size;
+      CUDA_TRY(cudaMemcpy2DAsync(image_msg->GetScalarPointer(), sub_row_size,
+                                 static_cast<const uint8_t*>(image) + y * pitch + x * pixel_size,
+                                 pitch, sub_row_size, sub_size[1], cudaMemcpyDeviceToHost,
+                                 stream));
+      image_msgs.push_back(image_msg);
+      tile_x = run_end;
+    }
+  }
+  if (image_msgs.size() > first_msg) { CUDA_TRY(cudaStreamSynchronize(stream)); }
 }
 
 }  // namespace holoscan::ops
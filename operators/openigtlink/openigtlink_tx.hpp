@@ -18,7 +18,17 @@
 #ifndef HOLOSCAN_OPERATORS_OPENIGTLINK_TX_HPP
 #define HOLOSCAN_OPERATORS_OPENIGTLINK_TX_HPP
 
+#include <condition_variable>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
 #include <holoscan/holoscan.hpp>
+#include <holoscan/operators/holoviz/buffer_info.hpp>
+#include <holoscan/utils/cuda_stream_handler.hpp>
 
 #include "igtlClientSocket.h"
 #include "igtlImageMessage.h"
@@ -27,6 +37,18 @@
 
 namespace holoscan::ops {
 
+/**
+ * @brief Operator class to send images using the OpenIGTLink protocol.
+ *
+ * Device images can be cropped to `crop` and downscaled by `downscale` on the GPU before they
+ * are copied to the host, so that only the preview resolution crosses the link. With
+ * `asynchronous_send`, messages are sent on a dedicated thread from a one-deep slot: a frame
+ * that is still pending when the next one arrives is replaced by it.
+ *
+ * With `tile_size`, slowly changing images such as label maps are compared to the previous frame
+ * on the GPU, and only their changed tiles are sent, as sub-volume image messages of the full
+ * image. A full image is sent every `keyframe_interval` frames, and after a frame was replaced.
+ */
 class OpenIGTLinkTxOp : public Operator {
  public:
   HOLOSCAN_OPERATOR_FORWARD_ARGS(OpenIGTLinkTxOp)
@@ -37,14 +59,64 @@ class OpenIGTLinkTxOp : public Operator {
   void compute(InputContext& input, OutputContext& output, ExecutionContext& context) override;
 
  private:
+  // Builds the image messages of the (cropped and downscaled) buffer of input name: the full
+  // image, or with tile_size the sub-volumes of its changed tiles
+  void create_image_messages(const std::string& name, const BufferInfo& buffer_info,
+                             cudaStream_t stream,
+                             std::vector<igtl::ImageMessage::Pointer>& image_msgs);
+  igtl::ImageMessage::Pointer new_image_message(int width, int height, int scalar_type,
+                                                int components);
+  // Appends the messages of the changed tiles of the device image, rows pitch bytes apart, or
+  // of the full image for a keyframe
+  void append_changed_tiles(const std::string& name, const void* image, size_t pitch,
+                            int width, int height,
+                            int scalar_type, int components, size_t pixel_size,
+                            cudaStream_t stream,
+                            std::vector<igtl::ImageMessage::Pointer>& image_msgs);
+  void send_messages();
+
   Parameter<std::vector<holoscan::IOSpec*>> receivers_;
   Parameter<std::vector<std::string>> input_names_;
   Parameter<std::string> device_name_;
   Parameter<std::string> host_name_;
   Parameter<int> port_;
+  Parameter<std::vector<int32_t>> crop_;
+  Parameter<uint32_t> downscale_;
+  Parameter<bool> asynchronous_send_;
+  Parameter<uint32_t> tile_size_;
+  Parameter<uint32_t> keyframe_interval_;
+  CudaStreamHandler cuda_stream_handler_;
   igtl::ClientSocket::Pointer client_socket_;
   std::map<std::string, std::string> input_;
   igtl::TimeStamp::Pointer time_stamp_;
+
+  // Device buffers of the input region and of the downscaled image, grown on demand
+  void* input_scratch_ = nullptr;
+  size_t input_scratch_size_ = 0;
+  void* output_scratch_ = nullptr;
+  size_t output_scratch_size_ = 0;
+
+  // With tile_size: the last image sent of each input and its changed tiles
+  struct TileState {
+    void* previous = nullptr;
+    uint8_t* changed = nullptr;
+    std::vector<uint8_t> changed_host;
+    int width = 0;
+    int height = 0;
+    size_t pixel_size = 0;
+    uint32_t frames_since_keyframe = 0;
+  };
+  std::map<std::string, TileState> tile_states_;
+
+  // With asynchronous_send: the messages of the latest frame not yet picked by the sender
+  std::vector<igtl::ImageMessage::Pointer> pending_;
+  bool stopping_ = false;
+  uint64_t dropped_frames_ = 0;
+  // Set when a frame of changed tiles was replaced, the next frame is a keyframe
+  bool resync_ = false;
+  std::mutex mutex_;
+  std::condition_variable frame_pending_;
+  std::thread send_thread_;
 };
 
 }  // namespace holoscan::ops
@@ -0,0 +1,93 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "openigtlink_tx_downscale.hpp"
+
+#include <cstdint>
+#include <limits>
+
+#include "igtlImageMessage.h"
+
+namespace holoscan::ops {
+
+namespace {
+
+constexpr unsigned kBlockWidth = 32;
+constexpr unsigned kBlockHeight = 8;
+
+// One thread per output pixel
+template <typename T>
+__global__ void downscale_kernel(const uint8_t* src, size_t src_pitch, int components,
+                                 int factor, T* dst, int width, int height) {
+  const int x = blockIdx.x * blockDim.x + threadIdx.x;
+  const int y = blockIdx.y * blockDim.y + threadIdx.y;
+  if (x >= width || y >= height) { return; }
+
+  const float scale = 1.f / static_cast<float>(factor * factor);
+  T* out = dst + (static_cast<size_t>(y) * width + x) * components;
+  for (int c = 0; c < components; ++c) {
+    float sum = 0.f;
+    for (int dy = 0; dy < factor; ++dy) {
+      const T* row = reinterpret_cast<const T*>(src + (static_cast<size_t>(y) * factor + dy) *
+                                                          src_pitch);
+      for (int dx = 0; dx < factor; ++dx) { sum += row[(x * factor + dx) * components + c]; }
+    }
+    float value = sum * scale;
+    if (std::numeric_limits<T>::is_integer) { value += value < 0.f ? -0.5f : 0.5f; }
+    out[c] = static_cast<T>(value);
+  }
+}
+
+template <typename T>
+cudaError_t launch(const void* src, size_t src_pitch, int components, int factor, void* dst,
+                   int width, int height, cudaStream_t stream) {
+  const dim3 block(kBlockWidth, kBlockHeight);
+  const dim3 grid((width + kBlockWidth - 1) / kBlockWidth,
+                  (height + kBlockHeight - 1) / kBlockHeight);
+  downscale_kernel<T><<<grid, block, 0, stream>>>(static_cast<const uint8_t*>(src), src_pitch,
+                                                   components, factor, static_cast<T*>(dst),
+                                                   width, height);
+  return cudaGetLastError();
+}
+
+}  // namespace
+
+cudaError_t downscale_image(const void* src, size_t src_pitch, int scalar_type, int components,
+                            int factor, void* dst, int width, int height, cudaStream_t stream) {
+  switch (scalar_type) {
+    case igtl::ImageMessage::TYPE_INT8:
+      return launch<int8_t>(src, src_pitch, components, factor, dst, width, height, stream);
+    case igtl::ImageMessage::TYPE_UINT8:
+      return launch<uint8_t>(src, src_pitch, components, factor, dst, width, height, stream);
+    case igtl::ImageMessage::TYPE_INT16:
+      return launch<int16_t>(src, src_pitch, components, factor, dst, width, height, stream);
+    case igtl::ImageMessage::TYPE_UINT16:
+      return launch<uint16_t>(src, src_pitch, components, factor, dst, width, height, stream);
+    case igtl::ImageMessage::TYPE_INT32:
+      return launch<int32_t>(src, src_pitch, components, factor, dst, width, height, stream);
+    case igtl::ImageMessage::TYPE_UINT32:
+      return launch<uint32_t>(src, src_pitch, components, factor, dst, width, height, stream);
+    case igtl::ImageMessage::TYPE_FLOAT32:
+      return launch<float>(src, src_pitch, components, factor, dst, width, height, stream);
+    case igtl::ImageMessage::TYPE_FLOAT64:
+      return launch<double>(src, src_pitch, components, factor, dst, width, height, stream);
+    default:
+      return cudaErrorInvalidValue;
+  }
+}
+
+}  // namespace holoscan::ops
@@ -0,0 +1,36 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef HOLOSCAN_OPERATORS_OPENIGTLINK_TX_DOWNSCALE_HPP
+#define HOLOSCAN_OPERATORS_OPENIGTLINK_TX_DOWNSCALE_HPP
+
+#include <cuda_runtime.h>
+
+#include <cstddef>
+
+namespace holoscan::ops {
+
+// Averages blocks of factor x factor pixels of the device image src (rows src_pitch bytes
+// apart, interleaved components) into the packed device image dst of width x height pixels.
+// scalar_type is the igtl::ImageMessage scalar type of the elements. The kernel is launched
+// on stream; the launch error, if any, is returned.
+cudaError_t downscale_image(const void* src, size_t src_pitch, int scalar_type, int components,
+                            int factor, void* dst, int width, int height, cudaStream_t stream);
+
+}  // namespace holoscan::ops
+
+#endif /* HOLOSCAN_OPERATORS_OPENIGTLINK_TX_DOWNSCALE_HPP */
@@ -0,0 +1,67 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "openigtlink_tx_tiles.hpp"
+
+namespace holoscan::ops {
+
+namespace {
+
+constexpr unsigned kBlockSize = 256;
+
+// One block per tile, the threads stride over the bytes of the tile rows
+__global__ void diff_tiles_kernel(const uint8_t* src, size_t src_pitch, uint8_t* previous,
+                                  size_t row_size, int height, size_t tile_row_size,
+                                  int tile_size, uint8_t* changed) {
+  const size_t x0 = blockIdx.x * tile_row_size;
+  const int y0 = blockIdx.y * tile_size;
+  const size_t width = min(tile_row_size, row_size - x0);
+  const int rows = min(tile_size, height - y0);
+
+  int differs = 0;
+  for (size_t i = threadIdx.x; i < width * rows; i += blockDim.x) {
+    const size_t y = y0 + i / width;
+    const size_t x = x0 + i % width;
+    const uint8_t value = src[y * src_pitch + x];
+    uint8_t& last = previous[y * row_size + x];
+    differs |= value != last;
+    last = value;
+  }
+  differs = __syncthreads_or(differs);
+  if (threadIdx.x == 0) { changed[blockIdx.y * gridDim.x + blockIdx.x] = differs ? 1 : 0; }
+}
+
+}  // namespace
+
+cudaError_t diff_tiles(const void* src, size_t src_pitch, void* previous, size_t row_size,
+                       int height, int pixel_size, int tile_size, uint8_t* changed,
+                       cudaStream_t stream) {
+  const size_t tile_row_size = static_cast<size_t>(tile_size) * pixel_size;
+  const dim3 grid((row_size + tile_row_size - 1) / tile_row_size,
+                  (height + tile_size - 1) / tile_size);
+  diff_tiles_kernel<<<grid, kBlockSize, 0, stream>>>(static_cast<const uint8_t*>(src),
+                                                      src_pitch,
+                                                      static_cast<uint8_t*>(previous),
+                                                      row_size,
+                                                      height,
+                                                      tile_row_size,
+                                                      tile_size,
+                                                      changed);
+  return cudaGetLastError();
+}
+
+}  // namespace holoscan::ops
@@ -0,0 +1,39 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef HOLOSCAN_OPERATORS_OPENIGTLINK_TX_TILES_HPP
+#define HOLOSCAN_OPERATORS_OPENIGTLINK_TX_TILES_HPP
+
+#include <cuda_runtime.h>
+
+#include <cstddef>
+#include <cstdint>
+
+namespace holoscan::ops {
+
+// Compares the tiles of tile_size x tile_size pixels of the device image src (rows src_pitch
+// bytes apart, row_size bytes of pixel_size bytes each, height rows) to the packed device
+// image previous, sets changed[tile_y * tiles_x + tile_x] to 1 for the tiles that differ and
+// to 0 else, and copies src to previous. The kernel is launched on stream; the launch error, if
+// any, is returned.
+cudaError_t diff_tiles(const void* src, size_t src_pitch, void* previous, size_t row_size,
+                       int height, int pixel_size, int tile_size, uint8_t* changed,
+                       cudaStream_t stream);
+
+}  // namespace holoscan::ops
+
+#endif /* HOLOSCAN_OPERATORS_OPENIGTLINK_TX_TILES_HPP */
@@ -51,6 +51,9 @@ out_tensor_name : str, optional
     Name of output tensor.
 flip_width_height : bool, optional
     Flip width and height (necessary for receiving from 3D Slicer).
+num_buffers : int, optional
+    Number of pinned host buffers images are received into before they are uploaded. When
+    all are in use, the oldest queued image is dropped.
 
 name : str, optional
     The name of the operator.
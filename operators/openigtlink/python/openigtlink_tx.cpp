@@ -51,11 +51,19 @@ class PyOpenIGTLinkTxOp : public OpenIGTLinkTxOp {
                     const std::string& host_name = std::string(""), int port = 0,
                     const std::string& device_name = std::string("Holoscan"),
                     const std::vector<std::string>& input_names = std::vector<std::string>{},
+                    const std::vector<int32_t>& crop = std::vector<int32_t>{},
+                    uint32_t downscale = 1, bool asynchronous_send = false,
+                    uint32_t tile_size = 0, uint32_t keyframe_interval = 30,
                     const std::string& name = "openigtlink_tx")
       : OpenIGTLinkTxOp(ArgList{Arg{"host_name", host_name},
                                 Arg{"port", port},
                                 Arg{"device_name", device_name},
-                                Arg{"input_names", input_names}}) {
+                                Arg{"input_names", input_names},
+                                Arg{"crop", crop},
+                                Arg{"downscale", downscale},
+                                Arg{"asynchronous_send", asynchronous_send},
+                                Arg{"tile_size", tile_size},
+                                Arg{"keyframe_interval", keyframe_interval}}) {
     if (receivers.size() > 0) { this->add_arg(Arg{"receivers", receivers}); }
     add_positional_condition_and_resource_args(this, args);
     name_ = name;
@@ -91,6 +99,11 @@ PYBIND11_MODULE(_openigtlink_tx, m) {
                     int,
                     const std::string&,
                     const std::vector<std::string>&,
+                    const std::vector<int32_t>&,
+                    uint32_t,
+                    bool,
+                    uint32_t,
+                    uint32_t,
                     const std::string&>(),
            "fragment"_a,
            "receivers"_a = std::vector<holoscan::IOSpec*>(),
@@ -98,6 +111,11 @@ PYBIND11_MODULE(_openigtlink_tx, m) {
            "port"_a = 1,
            "device_name"_a = "Holoscan"s,
            "input_names"_a = std::vector<std::string>{},
+           "crop"_a = std::vector<int32_t>{},
+           "downscale"_a = 1,
+           "asynchronous_send"_a = false,
+           "tile_size"_a = 0,
+           "keyframe_interval"_a = 30,
            "name"_a = "openigtlink_tx"s,
            doc::OpenIGTLinkTxOp::doc_OpenIGTLinkTxOp_python)
       .def("setup", &OpenIGTLinkTxOp::setup, "spec"_a, doc::OpenIGTLinkTxOp::doc_setup);
@@ -51,6 +51,17 @@ host_name : str, optional.
     Host name.
 port : integer, optional
     Port number of server.
+crop : list of int, optional
+    Region [x, y, width, height] of the images to send, all of them if empty.
+downscale : integer, optional
+    Integer factor the (cropped) images are downscaled by on the GPU before they are sent.
+asynchronous_send : bool, optional
+    Send on a dedicated thread, replacing a frame still pending by the next one.
+tile_size : integer, optional
+    Send only the tiles of tile_size x tile_size pixels changed since the previous frame, as
+    sub-volume image messages. 0 sends full images.
+keyframe_interval : integer, optional
+    With tile_size, frames between full images.
 
 name : str, optional
     The name of the operator.
@@ -17,6 +17,8 @@
 
 #include "format_converter.hpp"
 
+#include <algorithm>
+#include <cstring>
 #include <string>
 #include <utility>
 #include <vector>
@@ -214,6 +216,25 @@ void FormatConverterOp::start() {
     default:
       throw std::runtime_error(fmt::format("Unsupported resize mode: {}\n", resize_mode_.get()));
   }
+
+  if (data_format_.get() == "hwc") {
+    data_format_value_ = format_converter::kHWC;
+  } else if (data_format_.get() == "nchw") {
+    data_format_value_ = format_converter::kNCHW;
+  } else {
+    throw std::runtime_error(fmt::format("Unsupported data format: {}\n", data_format_.get()));
+  }
+
+  if (normalize_means_.get().size() != normalize_stds_.get().size()) {
+    throw std::runtime_error("normalize_means and normalize_stds must have the same size.\n");
+  }
+  for (float value : normalize_stds_.get()) {
+    if (value == 0.f) { throw std::runtime_error("normalize_stds must not contain zeros.\n"); }
+  }
+
+  if (CUDA_TRY(cudaEventCreateWithFlags(&upload_event_, cudaEventDisableTiming)) != cudaSuccess) {
+    throw std::runtime_error("Failed to create the upload event");
+  }
 }
 
 void FormatConverterOp::stop() {
@@ -223,6 +244,86 @@ void FormatConverterOp::stop() {
   resize_buffer_.reset();
   channel_buffer_.reset();
   device_scratch_buffer_.reset();
+
+  if (upload_event_) {
+    CUDA_TRY(cudaEventSynchronize(upload_event_));
+    CUDA_TRY(cudaEventDestroy(upload_event_));
+    upload_event_ = nullptr;
+  }
+  upload_source_ = gxf::Entity();
+  if (host_staging_buffer_) {
+    CUDA_TRY(cudaFreeHost(host_staging_buffer_));
+    host_staging_buffer_ = nullptr;
+    host_staging_size_ = 0;
+  }
+}
+
+bool FormatConverterOp::canUseFusedKernel(const int16_t in_channels, const bool resize) const {
+  if (in_primitive_type_ != nvidia::gxf::PrimitiveType::kUnsigned8 ||
+      (in_channels != 3 && in_channels != 4)) {
+    return false;
+  }
+  if (resize && resize_mode_.get() != NPPI_INTER_LINEAR) { return false; }
+  switch (format_conversion_type_) {
+    case FormatConversionType::kNone:
+      return out_primitive_type_ == nvidia::gxf::PrimitiveType::kUnsigned8;
+    case FormatConversionType::kUnsigned8ToFloat32:
+    case FormatConversionType::kRGB888ToRGBA8888:
+    case FormatConversionType::kRGBA8888ToRGB888:
+    case FormatConversionType::kRGBA8888ToFloat32:
+      return true;
+    default:
+      return false;
+  }
+}
+
+void* FormatConverterOp::uploadToDevice(const gxf::Entity& message, const void* data,
+                                        const size_t size,
+                                        const nvidia::gxf::MemoryStorageType storage_type,
+                                        nvidia::gxf::Handle<nvidia::gxf::Allocator> pool,
+                                        cudaStream_t stream) {
+  if (size > device_scratch_buffer_->size()) {
+    // the previous frame may still be read from the buffer being replaced
+    CUDA_TRY(cudaStreamSynchronize(stream));
+    device_scratch_buffer_->resize(pool, size, nvidia::gxf::MemoryStorageType::kDevice);
+    if (!device_scratch_buffer_->pointer()) {
+      throw std::runtime_error(
+          fmt::format("Failed to allocate device scratch buffer ({} bytes)", size));
+    }
+  }
+
+  // The source of the previous upload can only be reused or released once it is done
+  CUDA_TRY(cudaEventSynchronize(upload_event_));
+  upload_source_ = gxf::Entity();
+
+  const void* src = data;
+  if (storage_type == nvidia::gxf::MemoryStorageType::kSystem) {
+    if (size > host_staging_size_) {
+      if (host_staging_buffer_) { CUDA_TRY(cudaFreeHost(host_staging_buffer_)); }
+      host_staging_size_ = 0;
+      if (CUDA_TRY(cudaMallocHost(&host_staging_buffer_, size)) != cudaSuccess) {
+        host_staging_buffer_ = nullptr;
+        throw std::runtime_error(
+            fmt::format("Failed to allocate pinned staging buffer ({} bytes)", size));
+      }
+      host_staging_size_ = size;
+    }
+    std::memcpy(host_staging_buffer_, data, size);
+    src = host_staging_buffer_;
+  } else {
+    // pinned memory is copied from directly, hold the message until the copy is done
+    upload_source_ = message;
+  }
+
+  if (CUDA_TRY(cudaMemcpyAsync(device_scratch_buffer_->pointer(),
+                               src,
+                               size,
+                               cudaMemcpyHostToDevice,
+                               stream)) != cudaSuccess) {
+    throw std::runtime_error("Failed to upload the input to the device.");
+  }
+  CUDA_TRY(cudaEventRecord(upload_event_, stream));
+  return device_scratch_buffer_->pointer();
 }
 
 void FormatConverterOp::compute(InputContext& op_input, OutputContext& op_output,
@@ -248,6 +349,7 @@ void FormatConverterOp::compute(InputContext& op_input, OutputContext& op_output
   int32_t columns = 0;
   int16_t in_channels = 0;
   int16_t out_channels = 0;
+  size_t in_size = 0;
 
   const std::vector<int32_t> out_img_size = output_img_size_;
   const std::vector<int32_t> src_img_roi = src_roi_rect_;
@@ -320,28 +422,9 @@ void FormatConverterOp::compute(InputContext& op_input, OutputContext& op_output
     out_shape = nvidia::gxf::Shape{
         static_cast<int32_t>(buffer_info.height), static_cast<int32_t>(buffer_info.width), 4};
     in_tensor_data = frame->pointer();
+    in_size = frame->size();
     rows = buffer_info.height;
     columns = buffer_info.width;
-
-    // If the buffer is in host memory, copy it to a device (GPU) buffer
-    // as needed for the NPP resize/convert operations.
-    if (in_memory_storage_type == nvidia::gxf::MemoryStorageType::kHost) {
-      size_t buffer_size = rows * columns * in_channels;
-      if (buffer_size > device_scratch_buffer_->size()) {
-        device_scratch_buffer_->resize(
-            pool.value(), buffer_size, nvidia::gxf::MemoryStorageType::kDevice);
-        if (!device_scratch_buffer_->pointer()) {
-          throw std::runtime_error(
-              fmt::format("Failed to allocate device scratch buffer ({} bytes)", buffer_size));
-        }
-      }
-      CUDA_TRY(cudaMemcpy(device_scratch_buffer_->pointer(),
-                          frame->pointer(),
-                          buffer_size,
-                          cudaMemcpyHostToDevice));
-      in_tensor_data = device_scratch_buffer_->pointer();
-      in_memory_storage_type = nvidia::gxf::MemoryStorageType::kDevice;
-    }
   } else {
     const auto maybe_tensor = in_message.get<Tensor>(in_tensor_name_.get().c_str());
     if (!maybe_tensor) {
@@ -361,6 +444,7 @@ void FormatConverterOp::compute(InputContext& op_input, OutputContext& op_output
 #endif
     out_shape = in_tensor_gxf.shape();
     in_tensor_data = in_tensor_gxf.pointer();
+    in_size = in_tensor_gxf.size();
     if (in_tensor_data == nullptr) {
       // This should never happen, but just in case...
       HOLOSCAN_LOG_ERROR("Unable to get tensor data pointer. nullptr returned.");
@@ -373,6 +457,19 @@ void FormatConverterOp::compute(InputContext& op_input, OutputContext& op_output
     out_channels = in_channels;
   }
 
+  // If the input is in host memory, copy it to a device (GPU) buffer as needed for the
+  // resize/convert operations.
+  if (in_memory_storage_type == nvidia::gxf::MemoryStorageType::kHost ||
+      in_memory_storage_type == nvidia::gxf::MemoryStorageType::kSystem) {
+    in_tensor_data = uploadToDevice(in_message,
+                                    in_tensor_data,
+                                    in_size,
+                                    in_memory_storage_type,
+                                    pool.value(),
+                                    npp_stream_ctx_.hStream);
+    in_memory_storage_type = nvidia::gxf::MemoryStorageType::kDevice;
+  }
+
   if (in_memory_storage_type != nvidia::gxf::MemoryStorageType::kDevice) {
     throw std::runtime_error(fmt::format(
         "Tensor('{}') or VideoBuffer is not allocated on device.\n", in_tensor_name_.get()));
@@ -408,15 +505,28 @@ void FormatConverterOp::compute(InputContext& op_input, OutputContext& op_output
                     in_channels));
   }
 
-  // Resize the input image before converting data type
-  if (out_img_size[0] > 0 && out_img_size[1] > 0) {
-    auto resize_result = resizeImage(
-        in_tensor_data, rows, columns, in_channels, in_primitive_type, out_img_size, src_img_roi);
-    if (!resize_result) { throw std::runtime_error("Failed to resize image.\n"); }
+  const bool resize = out_img_size[0] > 0 && out_img_size[1] > 0;
+  const bool fused = use_fused_kernel_.get() && canUseFusedKernel(in_channels, resize);
+  if (!fused &&
+      (data_format_value_ != format_converter::kHWC || !normalize_means_.get().empty())) {
+    throw std::runtime_error(
+        "normalize_means and the nchw data_format are only supported by the fused kernel: uint8 "
+        "RGB or RGBA input, no resize or resize_mode 2 (NPPI_INTER_LINEAR).\n");
+  }
+  const int32_t src_rows = rows;
+  const int32_t src_columns = columns;
+
+  // Resize the input image before converting data type, the fused kernel does both at once
+  if (resize) {
+    if (!fused) {
+      auto resize_result = resizeImage(
+          in_tensor_data, rows, columns, in_channels, in_primitive_type, out_img_size, src_img_roi);
+      if (!resize_result) { throw std::runtime_error("Failed to resize image.\n"); }
+      in_tensor_data = resize_result.value();
+    }
 
     // Update the tensor pointer and shape
     out_shape = nvidia::gxf::Shape{out_img_size[1], out_img_size[0], in_channels};
-    in_tensor_data = resize_result.value();
     rows = out_img_size[1];
     columns = out_img_size[0];
   }
@@ -442,6 +552,11 @@ void FormatConverterOp::compute(InputContext& op_input, OutputContext& op_output
     default:
       break;
   }
+  if (fused) {
+    out_shape = data_format_value_ == format_converter::kNCHW
+                    ? nvidia::gxf::Shape{out_channels, rows, columns}
+                    : nvidia::gxf::Shape{rows, columns, out_channels};
+  }
 
   // Check that if the format requires a specific number of channels they are consistent.
   // Some formats (e.g. float32) are agnostic to channel count, while others (e.g. RGB888) have a
@@ -468,8 +583,19 @@ void FormatConverterOp::compute(InputContext& op_input, OutputContext& op_output
   const auto out_tensor = out_message.value().get<nvidia::gxf::Tensor>();
   if (!out_tensor) { std::runtime_error("failed to create out_tensor"); }
 
-  // Set tensor to constant using NPP
-  if (in_channels == 2 || in_channels == 3 || in_channels == 4) {
+  if (fused) {
+    const std::vector<int32_t> full_roi{0, 0, src_columns, src_rows};
+    convertFused(in_tensor_data,
+                 out_tensor.value()->pointer(),
+                 src_rows,
+                 src_columns,
+                 in_channels,
+                 rows,
+                 columns,
+                 out_channels,
+                 resize ? src_img_roi : full_roi);
+  } else if (in_channels == 2 || in_channels == 3 || in_channels == 4) {
+    // Set tensor to constant using NPP
     // gxf_result_t convert_result = convertTensorFormat(
     convertTensorFormat(
         in_tensor_data, out_tensor.value()->pointer(), rows, columns, in_channels, out_channels);
@@ -569,6 +695,65 @@ nvidia::gxf::Expected<void*> FormatConverterOp::resizeImage(
   return nvidia::gxf::ExpectedOrCode(GXF_SUCCESS, converted_tensor_ptr);
 }
 
+void FormatConverterOp::convertFused(const void* in_tensor_data, void* out_tensor_data,
+                                     const int32_t src_rows, const int32_t src_columns,
+                                     const int16_t in_channels, const int32_t rows,
+                                     const int32_t columns, const int16_t out_channels,
+                                     const std::vector<int32_t>& src_roi_rect) {
+  format_converter::FusedConvertParams params{};
+  params.src_width = src_columns;
+  params.src_height = src_rows;
+  params.src_channels = in_channels;
+  // clip the ROI to the image as NPP does
+  params.roi_x = std::clamp(src_roi_rect[0], 0, src_columns);
+  params.roi_y = std::clamp(src_roi_rect[1], 0, src_rows);
+  params.roi_width = std::min(src_roi_rect[2], src_columns - params.roi_x);
+  params.roi_height = std::min(src_roi_rect[3], src_rows - params.roi_y);
+  if (params.roi_width <= 0 || params.roi_height <= 0) {
+    throw std::runtime_error("The source ROI does not overlap the input image.");
+  }
+  params.dst_width = columns;
+  params.dst_height = rows;
+  params.dst_channels = out_channels;
+  params.data_format = data_format_value_;
+
+  // channels past the input ones (e.g. 3 for RGB888 to RGBA8888) are filled with alpha_value
+  const auto& out_channel_order = out_channel_order_.get();
+  if (!out_channel_order.empty() && out_channel_order.size() != static_cast<size_t>(out_channels)) {
+    throw std::runtime_error(fmt::format("Invalid channel order for {}", out_dtype_str_.get()));
+  }
+  for (size_t i = 0; i < 4; i++) {
+    params.channel_order[i] = i < out_channel_order.size() ? out_channel_order[i] : i;
+  }
+  params.alpha_value = alpha_value_.get();
+
+  // [0, 255] is mapped to [scale_min, scale_max] as nppiScale does, then normalized
+  const auto& means = normalize_means_.get();
+  const auto& stds = normalize_stds_.get();
+  if (!means.empty() && means.size() != static_cast<size_t>(out_channels)) {
+    throw std::runtime_error(fmt::format(
+        "normalize_means has {} values for {} output channels", means.size(), out_channels));
+  }
+  const float scale = (scale_max_.get() - scale_min_.get()) / 255.f;
+  for (int i = 0; i < out_channels; i++) {
+    params.scale[i] = scale;
+    params.offset[i] = scale_min_.get();
+    if (!means.empty()) {
+      params.scale[i] /= stds[i];
+      params.offset[i] = (params.offset[i] - means[i]) / stds[i];
+    }
+  }
+
+  const bool float_output = out_primitive_type_ == nvidia::gxf::PrimitiveType::kFloat32;
+  if (CUDA_TRY(format_converter::cuda_fused_convert(static_cast<const uint8_t*>(in_tensor_data),
+                                                    out_tensor_data,
+                                                    float_output,
+                                                    params,
+                                                    npp_stream_ctx_.hStream)) != cudaSuccess) {
+    throw std::runtime_error("Failed to launch the format conversion kernel.");
+  }
+}
+
 // gxf_result_t FormatConverterOp::convertTensorFormat(const void* in_tensor_data, void*
 // out_tensor_data,
 void FormatConverterOp::convertTensorFormat(const void* in_tensor_data, void* out_tensor_data,
@@ -935,6 +1120,26 @@ void FormatConverterOp::setup(OperatorSpec& spec) {
              "Output channel order",
              "Host memory integer array describing how channel values are permutated.",
              std::vector<int>{});
+  spec.param(normalize_means_,
+             "normalize_means",
+             "NormalizationMeans",
+             "Means subtracted from the scaled output channels. Needs the fused kernel.",
+             std::vector<float>{});
+  spec.param(normalize_stds_,
+             "normalize_stds",
+             "NormalizationSTDs",
+             "Standard deviations the output channels are divided by after subtracting the means.",
+             std::vector<float>{});
+  spec.param(data_format_,
+             "data_format",
+             "DataFormat",
+             "Data format of the output, 'hwc' or 'nchw'. 'nchw' needs the fused kernel.",
+             std::string("hwc"));
+  spec.param(use_fused_kernel_,
+             "use_fused_kernel",
+             "UseFusedKernel",
+             "Process supported conversions with a single kernel instead of NPP.",
+             true);
 
   spec.param(allocator_, "allocator", "Allocator", "Output Allocator");
 
@@ -0,0 +1,100 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "format_converter.cuh"
+
+namespace holoscan::ops::orsi {
+namespace format_converter {
+
+namespace {
+
+constexpr unsigned kBlockWidth = 32;
+constexpr unsigned kBlockHeight = 8;
+
+__forceinline__ __device__ void store(float* dst, float value, float scale, float offset) {
+  *dst = value * scale + offset;
+}
+
+__forceinline__ __device__ void store(uint8_t* dst, float value, float, float) {
+  *dst = static_cast<uint8_t>(fminf(fmaxf(value + 0.5f, 0.f), 255.f));
+}
+
+// One thread per destination pixel
+template <typename T>
+__global__ void fused_convert_kernel(const uint8_t* src, T* dst, FusedConvertParams p) {
+  const int x = blockIdx.x * blockDim.x + threadIdx.x;
+  const int y = blockIdx.y * blockDim.y + threadIdx.y;
+  if (x >= p.dst_width || y >= p.dst_height) { return; }
+
+  // Map the destination pixel center into the ROI and clamp to its border pixels, an unscaled
+  // ROI lands exactly on the source pixels
+  const float fx = fminf(
+      fmaxf((x + 0.5f) * p.roi_width / p.dst_width - 0.5f, 0.f), p.roi_width - 1.f);
+  const float fy = fminf(
+      fmaxf((y + 0.5f) * p.roi_height / p.dst_height - 0.5f, 0.f), p.roi_height - 1.f);
+  const int x0 = static_cast<int>(fx);
+  const int y0 = static_cast<int>(fy);
+  const int x1 = min(x0 + 1, p.roi_width - 1);
+  const int y1 = min(y0 + 1, p.roi_height - 1);
+  const float wx = fx - x0;
+  const float wy = fy - y0;
+
+  const int pitch = p.src_width * p.src_channels;
+  const uint8_t* row0 = src + (p.roi_y + y0) * pitch + p.roi_x * p.src_channels;
+  const uint8_t* row1 = src + (p.roi_y + y1) * pitch + p.roi_x * p.src_channels;
+  const int c0 = x0 * p.src_channels;
+  const int c1 = x1 * p.src_channels;
+
+  float in[4];
+#pragma unroll
+  for (int c = 0; c < 4; ++c) {
+    if (c < p.src_channels) {
+      const float top = row0[c0 + c] + wx * (row0[c1 + c] - row0[c0 + c]);
+      const float bottom = row1[c0 + c] + wx * (row1[c1 + c] - row1[c0 + c]);
+      in[c] = top + wy * (bottom - top);
+    }
+  }
+
+  const size_t plane = static_cast<size_t>(p.dst_width) * p.dst_height;
+  const size_t pixel = static_cast<size_t>(y) * p.dst_width + x;
+#pragma unroll
+  for (int c = 0; c < 4; ++c) {
+    if (c < p.dst_channels) {
+      const int from = p.channel_order[c];
+      const float value = from < p.src_channels ? in[from] : p.alpha_value;
+      const size_t index = p.data_format == kNCHW ? c * plane + pixel : pixel * p.dst_channels + c;
+      store(dst + index, value, p.scale[c], p.offset[c]);
+    }
+  }
+}
+
+}  // namespace
+
+cudaError_t cuda_fused_convert(const uint8_t* src, void* dst, bool float_output,
+                               const FusedConvertParams& params, cudaStream_t stream) {
+  const dim3 block(kBlockWidth, kBlockHeight);
+  const dim3 grid((params.dst_width + kBlockWidth - 1) / kBlockWidth,
+                  (params.dst_height + kBlockHeight - 1) / kBlockHeight);
+  if (float_output) {
+    fused_convert_kernel<<<grid, block, 0, stream>>>(src, static_cast<float*>(dst), params);
+  } else {
+    fused_convert_kernel<<<grid, block, 0, stream>>>(src, static_cast<uint8_t*>(dst), params);
+  }
+  return cudaGetLastError();
+}
+
+}  // namespace format_converter
+}  // namespace holoscan::ops::orsi
@@ -0,0 +1,58 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <driver_types.h>
+#include <cstdint>
+
+namespace holoscan::ops::orsi {
+namespace format_converter {
+
+enum DataFormat {
+  kHWC,
+  kNCHW,
+};
+
+struct FusedConvertParams {
+  // Tightly packed uint8 source with 3 or 4 channels
+  int32_t src_width;
+  int32_t src_height;
+  int32_t src_channels;
+  // Source region which is resized to the destination size
+  int32_t roi_x;
+  int32_t roi_y;
+  int32_t roi_width;
+  int32_t roi_height;
+  int32_t dst_width;
+  int32_t dst_height;
+  int32_t dst_channels;
+  // Source channel of each destination channel, values >= src_channels select alpha_value
+  int32_t channel_order[4];
+  float alpha_value;
+  // Float output of channel c is value * scale[c] + offset[c], uint8 output is the value itself
+  float scale[4];
+  float offset[4];
+  enum DataFormat data_format;
+};
+
+// Crop, bilinear resize, channel swizzle, scale/normalize and layout change of a uint8 image in
+// a single pass on stream. dst is uint8 if float_output is false. Returns the launch error.
+cudaError_t cuda_fused_convert(const uint8_t* src, void* dst, bool float_output,
+                               const FusedConvertParams& params, cudaStream_t stream);
+
+}  // namespace format_converter
+}  // namespace holoscan::ops::orsi
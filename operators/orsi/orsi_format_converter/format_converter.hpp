@@ -17,14 +17,17 @@
 
 #pragma once
 
+#include <cuda_runtime.h>
 #include <npp.h>
 
 #include <memory>
 #include <string>
 #include <vector>
 
+#include "holoscan/core/gxf/entity.hpp"
 #include "holoscan/core/gxf/gxf_operator.hpp"
 #include "holoscan/utils/cuda_stream_handler.hpp"
+#include "format_converter.cuh"
 
 namespace holoscan::ops::orsi {
 
@@ -46,6 +49,13 @@ enum class FormatConversionType {
 
 /**
  * @brief Operator class to convert the data format of the input data.
+ *
+ * Host inputs are uploaded with `cudaMemcpyAsync` on the CUDA stream of the operator, pageable
+ * memory through a pinned staging buffer. A uint8 RGB or RGBA input converted to uint8 or float32
+ * without resizing or with a bilinear (`resize_mode` 2) resize is processed by a single kernel
+ * doing the crop, resize, channel reorder, scaling, normalization and layout change, unless
+ * `use_fused_kernel` is false. The other conversions use NPP and support neither
+ * `normalize_means`/`normalize_stds` nor the "nchw" `data_format`.
  */
 class FormatConverterOp : public holoscan::Operator {
  public:
@@ -61,6 +71,11 @@ class FormatConverterOp : public holoscan::Operator {
                ExecutionContext& context) override;
   void stop() override;
 
+  bool canUseFusedKernel(const int16_t in_channels, const bool resize) const;
+  void* uploadToDevice(const gxf::Entity& message, const void* data, const size_t size,
+                       const nvidia::gxf::MemoryStorageType storage_type,
+                       nvidia::gxf::Handle<nvidia::gxf::Allocator> pool, cudaStream_t stream);
+
   nvidia::gxf::Expected<void*> resizeImage(const void* in_tensor_data, const int32_t rows,
                                            const int32_t columns, const int16_t channels,
                                            const nvidia::gxf::PrimitiveType primitive_type,
@@ -69,6 +84,10 @@ class FormatConverterOp : public holoscan::Operator {
   void convertTensorFormat(const void* in_tensor_data, void* out_tensor_data, const int32_t rows,
                            const int32_t columns, const int16_t in_channels,
                            const int16_t out_channels);
+  void convertFused(const void* in_tensor_data, void* out_tensor_data, const int32_t src_rows,
+                    const int32_t src_columns, const int16_t in_channels, const int32_t rows,
+                    const int32_t columns, const int16_t out_channels,
+                    const std::vector<int32_t>& src_roi_rect);
 
  private:
   Parameter<holoscan::IOSpec*> in_;
@@ -83,6 +102,10 @@ class FormatConverterOp : public holoscan::Operator {
   Parameter<std::vector<int32_t>> src_roi_rect_;
   Parameter<std::vector<int32_t>> output_img_size_;
   Parameter<std::vector<int>> out_channel_order_;
+  Parameter<std::vector<float>> normalize_means_;
+  Parameter<std::vector<float>> normalize_stds_;
+  Parameter<std::string> data_format_;
+  Parameter<bool> use_fused_kernel_;
 
   std::unique_ptr<nvidia::gxf::MemoryBuffer> resize_buffer_;
   std::unique_ptr<nvidia::gxf::MemoryBuffer> channel_buffer_;
@@ -100,6 +123,15 @@ class FormatConverterOp : public holoscan::Operator {
   nvidia::gxf::PrimitiveType out_primitive_type_ = nvidia::gxf::PrimitiveType::kCustom;
   FormatConversionType format_conversion_type_ = FormatConversionType::kUnknown;
 
+  format_converter::DataFormat data_format_value_ = format_converter::kHWC;
+
+  // Host input upload: pinned staging of pageable memory, completion of the last upload, and the
+  // input message kept alive until then when its pinned memory is copied from directly
+  void* host_staging_buffer_ = nullptr;
+  size_t host_staging_size_ = 0;
+  cudaEvent_t upload_event_ = nullptr;
+  holoscan::gxf::Entity upload_source_;
+
   NppStreamContext npp_stream_ctx_{};
   CudaStreamHandler cuda_stream_handler_;
 };
@@ -72,6 +72,9 @@ class PyOrsiFormatConverterOp : public orsi::FormatConverterOp {
                           const std::vector<int> out_channel_order = std::vector<int>{},
                           const std::vector<int> src_roi_rect = std::vector<int>{},
                           const std::vector<int> output_img_size = std::vector<int>{},
+                          const std::vector<float> normalize_means = std::vector<float>{},
+                          const std::vector<float> normalize_stds = std::vector<float>{},
+                          const std::string& data_format = "hwc", bool use_fused_kernel = true,
                           std::shared_ptr<holoscan::CudaStreamPool> cuda_stream_pool = nullptr,
                           const std::string& name = "format_converter")
       : orsi::FormatConverterOp(ArgList{Arg{"in_tensor_name", in_tensor_name},
@@ -85,6 +88,10 @@ class PyOrsiFormatConverterOp : public orsi::FormatConverterOp {
                                         Arg{"out_channel_order", out_channel_order},
                                         Arg{"src_roi_rect", src_roi_rect},
                                         Arg{"output_img_size", output_img_size},
+                                        Arg{"normalize_means", normalize_means},
+                                        Arg{"normalize_stds", normalize_stds},
+                                        Arg{"data_format", data_format},
+                                        Arg{"use_fused_kernel", use_fused_kernel},
                                         Arg{"allocator", allocator}}) {
     if (cuda_stream_pool) { this->add_arg(Arg{"cuda_stream_pool", cuda_stream_pool}); }
     add_positional_condition_and_resource_args(this, args);
@@ -135,6 +142,10 @@ PYBIND11_MODULE(_orsi_format_converter, m) {
                     const std::vector<int>,
                     const std::vector<int>,
                     const std::vector<int>,
+                    const std::vector<float>,
+                    const std::vector<float>,
+                    const std::string&,
+                    bool,
                     std::shared_ptr<holoscan::CudaStreamPool>,
                     const std::string&>(),
            "fragment"_a,
@@ -152,6 +163,10 @@ PYBIND11_MODULE(_orsi_format_converter, m) {
            "out_channel_order"_a = std::vector<int>{},
            "src_roi_rect"_a = std::vector<int>{},
            "output_img_size"_a = std::vector<int>{},
+           "normalize_means"_a = std::vector<float>{},
+           "normalize_stds"_a = std::vector<float>{},
+           "data_format"_a = "hwc"s,
+           "use_fused_kernel"_a = true,
            "cuda_stream_pool"_a = py::none(),
            "name"_a = "format_converter"s,
            doc::OrsiFormatConverterOp::doc_OrsiFormatConverterOp_python)
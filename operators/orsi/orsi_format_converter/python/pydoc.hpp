@@ -64,6 +64,15 @@ src_roi_rec : sequence of int
     Sequence of integers describing region of interest to crop.
 output_img_size : sequence of int
     Sequence of integers describing size of output image after resizing.
+normalize_means : sequence of float, optional
+    Means subtracted from each output channel after scaling. Needs the fused kernel.
+normalize_stds : sequence of float, optional
+    Standard deviations each output channel is divided by after subtracting the means.
+data_format : str, optional
+    Layout of the output, "hwc" (default) or "nchw". "nchw" needs the fused kernel.
+use_fused_kernel : bool, optional
+    Crop, resize, reorder, scale and normalize uint8 RGB or RGBA inputs in a single kernel when
+    there is no resize or `resize_mode` is 2 (NPPI_INTER_LINEAR). Other conversions use NPP.
 cuda_stream_pool : holoscan.resources.CudaStreamPool, optional
     CudaStreamPool instance to allocate CUDA streams.
 name : str, optional
@@ -43,6 +43,17 @@ network_output_type : str, optional
     Network output type (e.g. 'softmax').
 data_format : str, optional
     Data format of network output.
+out_tensor_name : str, optional
+    Name of the output tensor.
+output_roi_rect : sequence of int, optional
+    Region [x, y, width, height] of the output the network output is resampled to.
+output_img_size : sequence of int, optional
+    Size [width, height] of the output when `output_roi_rect` is set.
+output_format : str, optional
+    "class" (default) for a uint8 class index per pixel or "rgba" for the color of the class.
+color_lut : sequence of sequence of float, optional
+    RGBA colors in [0, 1] of the classes for the "rgba" output format, at most 32. Classes
+    without a color are transparent.
 cuda_stream_pool : holoscan.resources.CudaStreamPool, optional
     CudaStreamPool instance to allocate CUDA streams.
 
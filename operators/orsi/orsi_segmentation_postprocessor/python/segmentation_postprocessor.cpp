@@ -65,7 +65,8 @@ class PyOrsiSegmentationPostprocessorOp : public orsi::SegmentationPostprocessor
       const std::string& in_tensor_name = "", const std::string& network_output_type = "softmax"s,
       const std::string& data_format = "hwc"s, const std::string& out_tensor_name = ""s,
       const std::vector<int32_t> output_roi_rect = {},
-      const std::vector<int32_t> output_img_size = {},
+      const std::vector<int32_t> output_img_size = {}, const std::string& output_format = "class"s,
+      const std::vector<std::vector<float>> color_lut = {},
       std::shared_ptr<holoscan::CudaStreamPool> cuda_stream_pool = nullptr,
       const std::string& name = "segmentation_postprocessor"s)
       : orsi::SegmentationPostprocessorOp(ArgList{Arg{"in_tensor_name", in_tensor_name},
@@ -73,6 +74,8 @@ class PyOrsiSegmentationPostprocessorOp : public orsi::SegmentationPostprocessor
                                                   Arg{"data_format", data_format},
                                                   Arg{"out_tensor_name", out_tensor_name},
                                                   Arg{"output_roi_rect", output_roi_rect},
+                                                  Arg{"output_format", output_format},
+                                                  Arg{"color_lut", color_lut},
                                                   Arg{"output_img_size", output_img_size},
                                                   Arg{"allocator", allocator}}) {
     if (cuda_stream_pool) { this->add_arg(Arg{"cuda_stream_pool", cuda_stream_pool}); }
@@ -119,6 +122,8 @@ PYBIND11_MODULE(_orsi_segmentation_postprocessor, m) {
                     const std::string&,
                     const std::vector<int32_t>,
                     const std::vector<int32_t>,
+                    const std::string&,
+                    const std::vector<std::vector<float>>,
                     std::shared_ptr<holoscan::CudaStreamPool>,
                     const std::string&>(),
            "fragment"_a,
@@ -129,6 +134,8 @@ PYBIND11_MODULE(_orsi_segmentation_postprocessor, m) {
            "out_tensor_name"_a = ""s,
            "output_roi_rect"_a = std::vector<int32_t>{},
            "output_img_size"_a = std::vector<int32_t>{},
+           "output_format"_a = "class"s,
+           "color_lut"_a = std::vector<std::vector<float>>{},
            "cuda_stream_pool"_a = py::none(),
            "name"_a = "segmentation_postprocessor"s,
            doc::OrsiSegmentationPostprocessorOp::doc_OrsiSegmentationPostprocessorOp_python)
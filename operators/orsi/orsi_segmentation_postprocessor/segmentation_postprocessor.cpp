@@ -17,11 +17,11 @@
 
 #include "segmentation_postprocessor.hpp"
 
+#include <algorithm>
 #include <limits>
 #include <string>
 #include <utility>
-
-#include <npp.h>
+#include <vector>
 
 #include "gxf/std/tensor.hpp"
 
@@ -35,13 +35,14 @@
 #include "holoscan/core/resources/gxf/allocator.hpp"
 #include "holoscan/core/resources/gxf/cuda_stream_pool.hpp"
 
-using holoscan::ops::segmentation_postprocessor::cuda_postprocess;
 using holoscan::ops::segmentation_postprocessor::DataFormat;
 using holoscan::ops::segmentation_postprocessor::NetworkOutputType;
 using holoscan::ops::segmentation_postprocessor::output_type_t;
 using holoscan::ops::segmentation_postprocessor::Shape;
 
-using holoscan::ops::orsi::segmentation_postprocessor::cuda_resize;
+using holoscan::ops::orsi::segmentation_postprocessor::cuda_postprocess;
+using holoscan::ops::orsi::segmentation_postprocessor::InputType;
+using holoscan::ops::orsi::segmentation_postprocessor::kMaxLutColors;
 
 namespace holoscan::ops::orsi {
 
@@ -83,6 +84,16 @@ void SegmentationPostprocessorOp::setup(OperatorSpec& spec) {
              "output_img_size",
              "Output image size after resize",
              "Output image size [ width, height ] after resize");
+  spec.param(output_format_,
+             "output_format",
+             "OutputFormat",
+             "Output format, 'class' for a uint8 class index or 'rgba' for the class color.",
+             std::string("class"));
+  spec.param(color_lut_,
+             "color_lut",
+             "ColorLookupTable",
+             "RGBA colors in [0, 1] of the classes for the 'rgba' output format.",
+             std::vector<std::vector<float>>{});
 
   cuda_stream_handler_.define_params(spec);
 
@@ -152,7 +163,13 @@ void SegmentationPostprocessorOp::compute(InputContext& op_input, OutputContext&
         "Input channel count larger than allowed: {} > {}", shape.channels, kMaxChannelCount));
   }
 
-  nvidia::gxf::Shape scratch_buffer_process_size{shape.height, shape.width, 1};
+  InputType input_type = InputType::kFloat32;
+  const DLDataType dtype = in_tensor->dtype();
+  if (dtype.code == kDLFloat && dtype.bits == 16) {
+    input_type = InputType::kFloat16;
+  } else if (dtype.code != kDLFloat || dtype.bits != 32) {
+    throw std::runtime_error("Unsupported input tensor data type, expected float32 or float16");
+  }
 
   // Create a new message (nvidia::gxf::Entity)
   auto out_message = nvidia::gxf::Entity::New(context.context());
@@ -161,36 +178,28 @@ void SegmentationPostprocessorOp::compute(InputContext& op_input, OutputContext&
   auto out_tensor = out_message.value().add<nvidia::gxf::Tensor>(out_tensor_name.c_str());
   if (!out_tensor) { throw std::runtime_error("Failed to allocate output tensor"); }
 
-  const bool roi_enabled = output_roi_.width > 0 && output_roi_.height > 0;
-  // Allocate and convert output buffer on the device.
-  nvidia::gxf::Shape output_shape{shape.height, shape.width, 1};
-  nvidia::gxf::Shape scratch_buffer_process_shape{shape.height, shape.width, 1};
-  nvidia::gxf::Shape scratch_buffer_resize_shape{output_roi_.width, output_roi_.height, 1};
+  // Without ROI the output has the network resolution
+  params_.input_shape = shape;
+  if (output_roi_.width > 0 && output_roi_.height > 0) {
+    params_.roi_x = output_roi_.x;
+    params_.roi_y = output_roi_.y;
+    params_.roi_width = output_roi_.width;
+    params_.roi_height = output_roi_.height;
+    params_.output_width = output_size_.width;
+    params_.output_height = output_size_.height;
+  } else {
+    params_.roi_x = 0;
+    params_.roi_y = 0;
+    params_.roi_width = params_.output_width = shape.width;
+    params_.roi_height = params_.output_height = shape.height;
+  }
+  const int32_t out_channels = output_format_value_ == OutputFormat::kRGBA ? 4 : 1;
+  const nvidia::gxf::Shape output_shape{params_.output_height, params_.output_width, out_channels};
 
   auto frag = fragment();
   // get Handle to underlying nvidia::gxf::Allocator from std::shared_ptr<holoscan::Allocator>
   auto allocator = nvidia::gxf::Handle<nvidia::gxf::Allocator>::Create(frag->executor().context(),
                                                                        allocator_->gxf_cid());
-  if (roi_enabled) {
-    // set new output shape
-    output_shape = nvidia::gxf::Shape{output_size_.height, output_size_.width, 1};
-    // resize scratch buffer
-    if (scratch_buffer_process_->size() == 0) {
-      const uint64_t buffer_size = scratch_buffer_process_shape.dimension(0) *
-                                   scratch_buffer_process_shape.dimension(1) *
-                                   scratch_buffer_process_shape.dimension(2);
-      scratch_buffer_process_->resize(
-          allocator.value(), buffer_size, nvidia::gxf::MemoryStorageType::kDevice);
-    }
-
-    if (scratch_buffer_resize_->size() == 0) {
-      const uint64_t buffer_size = scratch_buffer_resize_shape.dimension(0) *
-                                   scratch_buffer_resize_shape.dimension(1) *
-                                   scratch_buffer_resize_shape.dimension(2);
-      scratch_buffer_resize_->resize(
-          allocator.value(), buffer_size, nvidia::gxf::MemoryStorageType::kDevice);
-    }
-  }
 
   // reshape out tensor buffer
   out_tensor.value()->reshape<uint8_t>(
@@ -201,66 +210,17 @@ void SegmentationPostprocessorOp::compute(InputContext& op_input, OutputContext&
   nvidia::gxf::Expected<uint8_t*> out_tensor_data = out_tensor.value()->data<uint8_t>();
   if (!out_tensor_data) { throw std::runtime_error("Failed to get out tensor data!"); }
 
-  // choose output buffer for post processing. By default use out tensor buffer
-  // When ROI enabled use scratch buffer
-  uint8_t* post_process_output_buffer = out_tensor_data.value();
-  if (roi_enabled) { post_process_output_buffer = scratch_buffer_process_->pointer(); }
-
-  const float* in_tensor_data = static_cast<float*>(in_tensor->data());
-
   cuda_postprocess(network_output_type_value_,
                    data_format_value_,
-                   shape,
-                   in_tensor_data,
-                   post_process_output_buffer,
+                   input_type,
+                   in_tensor->data(),
+                   out_tensor_data.value(),
+                   params_,
                    cuda_stream_handler_.get_cuda_stream(context.context()));
-
-  if (roi_enabled) {
-    // ------------------------------------------------------------------------
-    //
-    //  Step 1: resize to original ROI region dimensions
-    //
-    const NppiSize src_size = {static_cast<int>(scratch_buffer_process_shape.dimension(0)),
-                               static_cast<int>(scratch_buffer_process_shape.dimension(1))};
-    const NppiRect src_roi = {0,
-                              0,
-                              static_cast<int>(scratch_buffer_process_shape.dimension(0)),
-                              static_cast<int>(scratch_buffer_process_shape.dimension(1))};
-    const NppiSize dst_size = {static_cast<int>(output_roi_.width),
-                               static_cast<int>(output_roi_.height)};
-    const NppiRect dst_roi = {
-        0, 0, static_cast<int>(output_roi_.width), static_cast<int>(output_roi_.height)};
-
-    const uint8_t* src_buffer = scratch_buffer_process_->pointer();
-    uint8_t* dst_buffer = scratch_buffer_resize_->pointer();
-
-    NppStatus status = nppiResize_8u_C1R(src_buffer,
-                                         src_size.width,
-                                         src_size,
-                                         src_roi,
-                                         dst_buffer,
-                                         dst_size.width,
-                                         dst_size,
-                                         dst_roi,
-                                         NPPI_INTER_CUBIC);
-
-    if (status != NPP_SUCCESS) {
-      throw std::runtime_error("Failed to insert post processed buffer into output buffer");
-    }
-
-    // ------------------------------------------------------------------------
-    //
-    //  Step 2: Insert into output buffer
-    //
-
-    const auto converted_tensor_ptr = scratch_buffer_resize_->pointer();
-    out_tensor_data = out_tensor.value()->data<uint8_t>();
-    cuda_resize({output_roi_.height, output_roi_.width, 1},
-                {output_shape.dimension(1), output_shape.dimension(1), output_shape.dimension(2)},
-                converted_tensor_ptr,
-                out_tensor_data.value(),
-                output_roi_.x,
-                output_roi_.y);
+  const cudaError_t cuda_status = cudaGetLastError();
+  if (cuda_status != cudaSuccess) {
+    throw std::runtime_error(fmt::format("Failed to launch the postprocessing kernel: {}",
+                                         cudaGetErrorString(cuda_status)));
   }
 
   // pass the CUDA stream to the output message
@@ -317,13 +277,34 @@ void SegmentationPostprocessorOp::start() {
   output_size_.width = out_img_size[0];
   output_size_.height = out_img_size[1];
 
-  scratch_buffer_process_ = std::make_unique<nvidia::gxf::MemoryBuffer>();
-  scratch_buffer_resize_ = std::make_unique<nvidia::gxf::MemoryBuffer>();
-}
+  const std::string output_format = output_format_.get();
+  if (output_format == "class") {
+    output_format_value_ = OutputFormat::kClass;
+  } else if (output_format == "rgba") {
+    output_format_value_ = OutputFormat::kRGBA;
+  } else {
+    throw std::runtime_error(fmt::format("Unsupported output format {}", output_format));
+  }
 
-void SegmentationPostprocessorOp::stop() {
-  scratch_buffer_process_.reset();
-  scratch_buffer_resize_.reset();
+  const auto& color_lut = color_lut_.get();
+  if (color_lut.size() > kMaxLutColors) {
+    throw std::runtime_error(
+        fmt::format("Too many colors in color_lut: {} > {}", color_lut.size(), kMaxLutColors));
+  }
+  params_.output_format = output_format_value_;
+  params_.lut_size = color_lut.size();
+  for (size_t i = 0; i < color_lut.size(); i++) {
+    if (color_lut[i].size() != 4) {
+      throw std::runtime_error(
+          fmt::format("Color {} of color_lut has {} components, expected RGBA",
+                      i,
+                      color_lut[i].size()));
+    }
+    for (size_t c = 0; c < 4; c++) {
+      params_.lut[i][c] =
+          static_cast<uint8_t>(std::clamp(color_lut[i][c], 0.f, 1.f) * 255.f + 0.5f);
+    }
+  }
 }
 
 }  // namespace holoscan::ops::orsi
@@ -15,14 +15,37 @@
  * limitations under the License.
  */
 
+#include <cuda_fp16.h>
+
 #include "segmentation_postprocessor.cuh"
 
 namespace holoscan::ops::orsi {
 namespace segmentation_postprocessor {
 
+__forceinline__ __device__ uint32_t hwc_to_index(Shape shape, uint32_t y, uint32_t x, uint32_t c) {
+  return (y * shape.width + x) * shape.channels + c;
+}
+
+__forceinline__ __device__ uint32_t nchw_to_index(Shape shape, uint32_t y, uint32_t x, uint32_t c) {
+  return (c * shape.height + y) * shape.width + x;
+}
+
+template <enum DataFormat data_format>
+__forceinline__ __device__ uint32_t data_format_to_index(Shape shape, uint32_t y, uint32_t x,
+                                                         uint32_t c) {
+  if constexpr (data_format == DataFormat::kNCHW) {
+    return nchw_to_index(shape, y, x, c);
+  } else {
+    return hwc_to_index(shape, y, x, c);
+  }
+}
+
+__forceinline__ __device__ float to_float(float value) {
+  return value;
+}
 
-__forceinline__ __device__ uint32_t hw1_to_index(Shape shape, uint32_t y, uint32_t x) {
-  return y * shape.width + x;
+__forceinline__ __device__ float to_float(__half value) {
+  return __half2float(value);
 }
 
 uint16_t ceil_div(uint16_t numerator, uint16_t denominator) {
@@ -30,24 +53,114 @@ uint16_t ceil_div(uint16_t numerator, uint16_t denominator) {
   return accumulator / denominator;
 }
 
+template <enum NetworkOutputType network_output_type, enum DataFormat data_format, typename T>
+__global__ void postprocessing_kernel(const T* input, uint8_t* output, PostprocessParams p) {
+  const int32_t x = blockIdx.x * blockDim.x + threadIdx.x;
+  const int32_t y = blockIdx.y * blockDim.y + threadIdx.y;
+
+  if ((x >= p.output_width) || (y >= p.output_height)) { return; }
+
+  uint8_t label = 0;
+  const int32_t roi_x = x - p.roi_x;
+  const int32_t roi_y = y - p.roi_y;
+  if (roi_x >= 0 && roi_y >= 0 && roi_x < p.roi_width && roi_y < p.roi_height) {
+    const Shape& shape = p.input_shape;
+    // map the output pixel center into the network output, clamped to its border pixels
+    const float fx = fminf(
+        fmaxf((roi_x + 0.5f) * shape.width / p.roi_width - 0.5f, 0.f), shape.width - 1.f);
+    const float fy = fminf(
+        fmaxf((roi_y + 0.5f) * shape.height / p.roi_height - 0.5f, 0.f), shape.height - 1.f);
+    const uint32_t x0 = static_cast<uint32_t>(fx);
+    const uint32_t y0 = static_cast<uint32_t>(fy);
+    const uint32_t x1 = min(x0 + 1, static_cast<uint32_t>(shape.width - 1));
+    const uint32_t y1 = min(y0 + 1, static_cast<uint32_t>(shape.height - 1));
+    const float wx = fx - x0;
+    const float wy = fy - y0;
+
+    // scores are interpolated before the reduction, which gives smooth class borders
+    auto sample = [&](uint32_t c) {
+      const float v00 = to_float(input[data_format_to_index<data_format>(shape, y0, x0, c)]);
+      const float v01 = to_float(input[data_format_to_index<data_format>(shape, y0, x1, c)]);
+      const float v10 = to_float(input[data_format_to_index<data_format>(shape, y1, x0, c)]);
+      const float v11 = to_float(input[data_format_to_index<data_format>(shape, y1, x1, c)]);
+      const float top = v00 + wx * (v01 - v00);
+      const float bottom = v10 + wx * (v11 - v10);
+      return top + wy * (bottom - top);
+    };
 
-__global__ void resizing_kernel(Shape input_shape, Shape output_shape, const uint8_t* input,
-                              uint8_t* output, int32_t offset_x, int32_t offset_y) {
-  const uint32_t x = blockIdx.x * blockDim.x + threadIdx.x;
-  const uint32_t y = blockIdx.y * blockDim.y + threadIdx.y;
+    if constexpr (network_output_type == NetworkOutputType::kSigmoid) {
+      label = sample(0) >= 0.5f ? 1 : 0;
+    } else {
+      float max_value = sample(0);
+      for (uint32_t c = 1; c < static_cast<uint32_t>(shape.channels); c++) {
+        const float value = sample(c);
+        if (value > max_value) {
+          max_value = value;
+          label = c;
+        }
+      }
+    }
+  }
 
-  if ((x >= input_shape.width) || (y >= input_shape.height)) { return; }
+  const uint32_t index = y * p.output_width + x;
+  if (p.output_format == OutputFormat::kRGBA) {
+    uchar4 color{0, 0, 0, 0};
+    if (label < p.lut_size) {
+      color = make_uchar4(p.lut[label][0], p.lut[label][1], p.lut[label][2], p.lut[label][3]);
+    }
+    reinterpret_cast<uchar4*>(output)[index] = color;
+  } else {
+    output[index] = label;
+  }
+}
+
+template <enum NetworkOutputType network_output_type, enum DataFormat data_format>
+void launch(InputType input_type, const void* input, uint8_t* output,
+            const PostprocessParams& params, dim3 grid, dim3 block, cudaStream_t stream) {
+  if (input_type == InputType::kFloat16) {
+    postprocessing_kernel<network_output_type, data_format><<<grid, block, 0, stream>>>(
+        static_cast<const __half*>(input), output, params);
+  } else {
+    postprocessing_kernel<network_output_type, data_format><<<grid, block, 0, stream>>>(
+        static_cast<const float*>(input), output, params);
+  }
+}
 
-  output[hw1_to_index(output_shape, y + offset_y, x  + offset_x)] =
-                                                          input[hw1_to_index(input_shape, y, x)];
+template <enum NetworkOutputType network_output_type>
+void launch(DataFormat data_format, InputType input_type, const void* input, uint8_t* output,
+            const PostprocessParams& params, dim3 grid, dim3 block, cudaStream_t stream) {
+  switch (data_format) {
+    case DataFormat::kNCHW:
+      launch<network_output_type, DataFormat::kNCHW>(
+          input_type, input, output, params, grid, block, stream);
+      break;
+    case DataFormat::kHWC:
+      launch<network_output_type, DataFormat::kHWC>(
+          input_type, input, output, params, grid, block, stream);
+      break;
+    case DataFormat::kNHWC:
+      launch<network_output_type, DataFormat::kNHWC>(
+          input_type, input, output, params, grid, block, stream);
+      break;
+  }
 }
 
-void cuda_resize(Shape input_shape, Shape output_shape, const uint8_t* input, uint8_t* output,
-                                                           int32_t offset_x, int32_t offset_y) {
-  dim3 block(32, 32, 1);
-  dim3 grid(ceil_div(input_shape.width, block.x), ceil_div(input_shape.height, block.y), 1);
+void cuda_postprocess(NetworkOutputType network_output_type, DataFormat data_format,
+                      InputType input_type, const void* input, uint8_t* output,
+                      const PostprocessParams& params, cudaStream_t stream) {
+  dim3 block(32, 8, 1);
+  dim3 grid(ceil_div(params.output_width, block.x), ceil_div(params.output_height, block.y), 1);
 
-  resizing_kernel<<<grid, block>>>(input_shape, output_shape, input, output, offset_x, offset_y);
+  switch (network_output_type) {
+    case NetworkOutputType::kSigmoid:
+      launch<NetworkOutputType::kSigmoid>(
+          data_format, input_type, input, output, params, grid, block, stream);
+      break;
+    case NetworkOutputType::kSoftmax:
+      launch<NetworkOutputType::kSoftmax>(
+          data_format, input_type, input, output, params, grid, block, stream);
+      break;
+  }
 }
 
 }  // namespace segmentation_postprocessor
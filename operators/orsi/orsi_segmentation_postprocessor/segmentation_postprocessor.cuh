@@ -22,12 +22,43 @@
 namespace holoscan::ops::orsi {
 namespace segmentation_postprocessor {
 
+using holoscan::ops::segmentation_postprocessor::DataFormat;
+using holoscan::ops::segmentation_postprocessor::NetworkOutputType;
 using holoscan::ops::segmentation_postprocessor::Shape;
 
+enum class InputType { kFloat32, kFloat16 };
 
-// TODO: to verify if this function is actually needed. Ideally replace with NPP implementation.
-void cuda_resize(Shape input_shape, Shape output_shape, const uint8_t* input, uint8_t* output,
-                 int32_t offset_x, int32_t offset_y);
+enum class OutputFormat {
+  // one uint8 class index per pixel
+  kClass,
+  // uint8 RGBA color of the class from the LUT per pixel
+  kRGBA,
+};
+
+static constexpr uint32_t kMaxLutColors = 32;
+
+struct PostprocessParams {
+  // network output
+  Shape input_shape;
+  // region of the output the network output is resampled to, pixels outside are class 0 or
+  // transparent
+  int32_t roi_x;
+  int32_t roi_y;
+  int32_t roi_width;
+  int32_t roi_height;
+  int32_t output_width;
+  int32_t output_height;
+  OutputFormat output_format;
+  // RGBA colors of the classes, classes past lut_size are transparent
+  uint32_t lut_size;
+  uint8_t lut[kMaxLutColors][4];
+};
+
+// Bilinear resampling of the network output into the output ROI, class reduction (argmax for
+// softmax, >= 0.5 for sigmoid) and optional color mapping in a single pass on stream
+void cuda_postprocess(NetworkOutputType network_output_type, DataFormat data_format,
+                      InputType input_type, const void* input, uint8_t* output,
+                      const PostprocessParams& params, cudaStream_t stream);
 
 }  // namespace segmentation_postprocessor
 }  // namespace holoscan::ops::orsi
@@ -20,6 +20,7 @@
 #include <memory>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include "holoscan/core/operator.hpp"
 #include "holoscan/utils/cuda_stream_handler.hpp"
@@ -28,6 +29,7 @@
 
 using holoscan::ops::segmentation_postprocessor::DataFormat;
 using holoscan::ops::segmentation_postprocessor::NetworkOutputType;
+using holoscan::ops::orsi::segmentation_postprocessor::OutputFormat;
 
 namespace holoscan::ops::orsi {
 
@@ -39,6 +41,14 @@ struct Size {
   int32_t width, height;
 };
 
+/**
+ * @brief Reduces the scores of a segmentation network (float32 or float16) to classes.
+ *
+ * The scores are resampled bilinearly to `output_roi_rect` of an `output_img_size` image, or
+ * kept at the network resolution without ROI, and reduced in one kernel. The output holds one
+ * uint8 class per pixel (`output_format` "class") or the RGBA color of the class taken from
+ * `color_lut` (`output_format` "rgba"). Pixels outside the ROI are class 0 or transparent.
+ */
 class SegmentationPostprocessorOp : public Operator {
  public:
   HOLOSCAN_OPERATOR_FORWARD_ARGS(SegmentationPostprocessorOp)
@@ -50,11 +60,11 @@ class SegmentationPostprocessorOp : public Operator {
   void start() override;
   void compute(InputContext& op_input, OutputContext& op_output,
                ExecutionContext& context) override;
-  void stop() override;
 
  private:
   NetworkOutputType network_output_type_value_;
   DataFormat data_format_value_;
+  OutputFormat output_format_value_;
 
   Parameter<holoscan::IOSpec*> in_;
   Parameter<holoscan::IOSpec*> out_;
@@ -68,16 +78,12 @@ class SegmentationPostprocessorOp : public Operator {
 
   Parameter<std::vector<int32_t>> output_roi_rect_;
   Parameter<std::vector<int32_t>> output_img_size_;
+  Parameter<std::string> output_format_;
+  Parameter<std::vector<std::vector<float>>> color_lut_;
 
   CudaStreamHandler cuda_stream_handler_;
 
-  nvidia::gxf::Expected<void*> resizeImage(const void* in_tensor_data, const int32_t rows,
-                                           const int32_t columns, const int16_t channels,
-                                           const nvidia::gxf::PrimitiveType primitive_type,
-                                           const int32_t resize_width, const int32_t resize_height);
-
-  std::unique_ptr<nvidia::gxf::MemoryBuffer> scratch_buffer_process_;
-  std::unique_ptr<nvidia::gxf::MemoryBuffer> scratch_buffer_resize_;
+  segmentation_postprocessor::PostprocessParams params_{};
 
   Rect output_roi_;
   Size output_size_;
@@ -158,11 +158,32 @@ void OrsiVis::resizeVideoBufferResources(int width, int height, int channels) {
   // CUDA GL Interop not support with 3 channel formats, e.g. GL_RGB
   use_cuda_opengl_interop_ = video_frame_channels_ != 3;
 
-  // Allocate host memory and OpenGL buffers, textures for video frame and inference results
+  // Allocate OpenGL buffers, textures for video frame and inference results
   // ----------------------------------------------------------------------------------
 
   const size_t buffer_size = video_frame_width_ * video_frame_height_ * video_frame_channels_;
-  video_frame_buffer_host_.resize(buffer_size, 0);
+  if (cuda_video_frame_pbo_resource_) {
+    CUDA_TRY(cudaGraphicsUnregisterResource(cuda_video_frame_pbo_resource_));
+    cuda_video_frame_pbo_resource_ = nullptr;
+  }
+  if (video_frame_pbo_) {
+    glDeleteBuffers(1, &video_frame_pbo_);
+    video_frame_pbo_ = 0;
+  }
+  if (!use_cuda_opengl_interop_) {
+    // 3 channel frames are copied on the device to a pixel unpack buffer, the texture is
+    // updated from there by OpenGL without a round trip through host memory
+    glGenBuffers(1, &video_frame_pbo_);
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, video_frame_pbo_);
+    glBufferData(GL_PIXEL_UNPACK_BUFFER, buffer_size, nullptr, GL_STREAM_DRAW);
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+    cudaError_t cuda_status = CUDA_TRY(cudaGraphicsGLRegisterBuffer(
+        &cuda_video_frame_pbo_resource_, video_frame_pbo_, cudaGraphicsMapFlagsWriteDiscard));
+    if (cuda_status) {
+      HOLOSCAN_LOG_ERROR("Failed to register video frame buffer for CUDA / OpenGL Interop");
+      throw std::runtime_error("Failed to register video frame buffer for CUDA / OpenGL Interop");
+    }
+  }
 
   glActiveTexture(GL_TEXTURE0);
   glGenTextures(1, &video_frame_tex_);
@@ -246,6 +267,15 @@ void OrsiVis::stop() {
   // ----------------------------------------------------------------------------------
   video_frame_vis_.stop();
   vtk_view_.stop();
+
+  if (cuda_video_frame_pbo_resource_) {
+    CUDA_TRY(cudaGraphicsUnregisterResource(cuda_video_frame_pbo_resource_));
+    cuda_video_frame_pbo_resource_ = nullptr;
+  }
+  if (video_frame_pbo_) {
+    glDeleteBuffers(1, &video_frame_pbo_);
+    video_frame_pbo_ = 0;
+  }
 }
 
 void OrsiVis::compute(
@@ -342,15 +372,29 @@ void OrsiVis::compute(
           throw std::runtime_error("Failed to unmap video frame texture via CUDA / OpenGL interop");
         }
       } else {
-        cuda_status = CUDA_TRY(cudaMemcpy(
-            video_frame_buffer_host_.data(), in_tensor_ptr, buffer_size, cudaMemcpyDeviceToHost));
+        cuda_status = CUDA_TRY(cudaGraphicsMapResources(1, &cuda_video_frame_pbo_resource_, 0));
+        if (cuda_status) {
+          HOLOSCAN_LOG_ERROR("Failed to map video frame buffer via CUDA / OpenGL interop");
+          throw std::runtime_error("Failed to map video frame buffer via CUDA / OpenGL interop");
+        }
+        void* pbo_ptr = nullptr;
+        size_t pbo_size = 0;
+        cuda_status = CUDA_TRY(cudaGraphicsResourceGetMappedPointer(
+            &pbo_ptr, &pbo_size, cuda_video_frame_pbo_resource_));
+        if (!cuda_status) {
+          cuda_status = CUDA_TRY(
+              cudaMemcpy(pbo_ptr, in_tensor_ptr, buffer_size, cudaMemcpyDeviceToDevice));
+        }
+        CUDA_TRY(cudaGraphicsUnmapResources(1, &cuda_video_frame_pbo_resource_, 0));
         if (cuda_status) {
-          HOLOSCAN_LOG_ERROR("Failed to copy video frame texture from Device to Host");
-          throw std::runtime_error("Failed to copy video frame texture from Device to Host");
+          HOLOSCAN_LOG_ERROR("Failed to copy video frame to OpenGL buffer");
+          throw std::runtime_error("Failed to copy video frame to OpenGL buffer");
         }
-        // update data
+        // update data from the pixel unpack buffer
         glActiveTexture(GL_TEXTURE0);
         glBindTexture(GL_TEXTURE_2D, video_frame_tex_);
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, video_frame_pbo_);
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
         GLenum format = (video_frame_channels_ == 4) ? GL_RGBA : GL_RGB;
         glTexSubImage2D(GL_TEXTURE_2D,
                         0,
@@ -360,7 +404,9 @@ void OrsiVis::compute(
                         video_frame_height_,
                         format,
                         GL_UNSIGNED_BYTE,
-                        video_frame_buffer_host_.data());
+                        nullptr);
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
       }
     }  // if (in_tensor_ptr && buffer_size > 0)
   }
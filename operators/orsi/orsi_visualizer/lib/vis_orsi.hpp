@@ -93,7 +93,9 @@ class OrsiVis : public holoscan::orsi::vis::VisIntf {
 
   GLuint video_frame_tex_ = 0;
   cudaGraphicsResource* cuda_video_frame_tex_resource_ = nullptr;
-  std::vector<unsigned char> video_frame_buffer_host_;
+  // pixel unpack buffer staging 3 channel video frames on the device
+  GLuint video_frame_pbo_ = 0;
+  cudaGraphicsResource* cuda_video_frame_pbo_resource_ = nullptr;
 
   // Segmentation Mask  related members
   // --------------------------------------------------------------------
@@ -18,15 +18,60 @@
 #include "prohawkop.hpp"
 #include "opencv2/imgproc.hpp"
 
+#include <stdexcept>
+#include <string>
+
 namespace holoscan::ops {
 
+namespace {
+
+void cuda_check(cudaError_t err, const char* what) {
+  if (err != cudaSuccess) {
+    throw std::runtime_error(std::string("ProhawkOp: ") + what + " failed: " +
+                             cudaGetErrorString(err));
+  }
+}
+
+}  // namespace
+
 void ProhawkOp::setup(OperatorSpec& spec) {
   spec.input<gxf::Entity>("input");
   spec.output<gxf::Entity>("output1");
 
+  spec.param(pipelined_,
+             "pipelined",
+             "Pipelined",
+             "Overlap the download of frame N+1 with the restoration of frame N using pinned "
+             "double-buffers. Adds one frame of latency.",
+             false);
+
   printf("Starting Prohawk Restoration...\n");
 }
 
+void ProhawkOp::start() {
+  if (!pipelined_.get()) { return; }
+  cuda_check(cudaStreamCreateWithFlags(&stream_, cudaStreamNonBlocking), "cudaStreamCreate");
+  for (auto& slot : slots_) {
+    cuda_check(cudaEventCreateWithFlags(&slot.downloaded, cudaEventDisableTiming),
+               "cudaEventCreate");
+  }
+}
+
+void ProhawkOp::stop() {
+  // A frame still waiting for restoration is dropped
+  pending_.reset();
+  if (stream_) { cudaStreamSynchronize(stream_); }
+  for (auto& slot : slots_) {
+    if (slot.data) { cudaFreeHost(slot.data); }
+    if (slot.downloaded) { cudaEventDestroy(slot.downloaded); }
+    slot = HostSlot{};
+  }
+  if (stream_) {
+    cudaStreamDestroy(stream_);
+    stream_ = nullptr;
+  }
+}
+
 void ProhawkOp::compute(InputContext& op_input, OutputContext& op_output, ExecutionContext&) {
   auto value1 = op_input.receive<gxf::Entity>("input").value();
 
@@ -35,9 +80,59 @@ void ProhawkOp::compute(InputContext& op_input, OutputContext& op_output, Execut
   auto rows = image_shape[0];
   auto cols = image_shape[1];
   size_t data_size = tensor->nbytes();
-  std::vector<uint8_t> in_data(data_size);
-  cudaMemcpy(in_data.data(), tensor->data(), data_size, cudaMemcpyDeviceToHost);
 
+  if (!pipelined_.get()) {
+    std::vector<uint8_t> in_data(data_size);
+    cudaMemcpy(in_data.data(), tensor->data(), data_size, cudaMemcpyDeviceToHost);
+    restore_frame(in_data.data(), rows, cols);
+    if (filter1 != 100) {
+      cudaMemcpy(tensor->data(), in_data.data(), data_size, cudaMemcpyHostToDevice);
+    }
+    op_output.emit(value1, "output1");
+    show_frame(rows, cols);
+    return;
+  }
+
+  // Start downloading this frame, then restore the previous one while the copy is in flight
+  HostSlot& slot = slots_[slot_index_];
+  if (slot.size < data_size) {
+    // The stream was synchronized at the end of the last compute, so the old buffer is idle
+    if (slot.data) { cuda_check(cudaFreeHost(slot.data), "cudaFreeHost"); }
+    cuda_check(cudaMallocHost(reinterpret_cast<void**>(&slot.data), data_size),
+               "cudaMallocHost");
+    slot.size = data_size;
+  }
+  cuda_check(
+      cudaMemcpyAsync(slot.data, tensor->data(), data_size, cudaMemcpyDeviceToHost, stream_),
+      "cudaMemcpyAsync");
+  cuda_check(cudaEventRecord(slot.downloaded, stream_), "cudaEventRecord");
+
+  if (pending_) {
+    HostSlot& prev = slots_[slot_index_ ^ 1];
+    cuda_check(cudaEventSynchronize(prev.downloaded), "cudaEventSynchronize");
+    restore_frame(prev.data, pending_rows_, pending_cols_);
+    if (filter1 != 100) {
+      cuda_check(cudaMemcpyAsync(pending_tensor_->data(),
+                                 prev.data,
+                                 pending_tensor_->nbytes(),
+                                 cudaMemcpyHostToDevice,
+                                 stream_),
+                 "cudaMemcpyAsync");
+    }
+    // Only the upload has to complete before the restored frame leaves the operator
+    show_frame(pending_rows_, pending_cols_);
+    cuda_check(cudaStreamSynchronize(stream_), "cudaStreamSynchronize");
+    op_output.emit(pending_.value(), "output1");
+  }
+
+  pending_ = value1;
+  pending_tensor_ = tensor;
+  pending_rows_ = rows;
+  pending_cols_ = cols;
+  slot_index_ ^= 1;
+}
+
+void ProhawkOp::configure_filter() {
   switch (filter1) {
     case 0:
       p->defRadiusX = 60;
@@ -144,6 +239,10 @@ void ProhawkOp::compute(InputContext& op_input, OutputContext& op_output, Execut
 
       if (filter1 == 100) { selectedFilter = "Restoration Disabled"; }
   }
+}
+
+void ProhawkOp::restore_frame(uint8_t* frame, int rows, int cols) {
+  configure_filter();
 
   p->width = cols;
   p->height = rows;
@@ -152,19 +251,15 @@ void ProhawkOp::compute(InputContext& op_input, OutputContext& op_output, Execut
   p->dstBits = p->srcBits;
   p->dstColor = p->srcColor;
 
-  cv::Mat sbsmat;
-  cv::Mat rgb_image;
-  cv::Mat bgr_image;
-  cv::Mat dst;
-
-  cv::Mat input_image(rows, cols, CV_8UC3, in_data.data(), cv::Mat::AUTO_STEP);
-  cv::cvtColor(input_image, bgr_image, cv::COLOR_RGB2BGR);
-  cv::Mat output_image = cv::Mat(bgr_image.size(), bgr_image.type());
+  // The restored RGB image is written back into frame, ready for upload
+  cv::Mat frame_image(rows, cols, CV_8UC3, frame, cv::Mat::AUTO_STEP);
+  cv::cvtColor(frame_image, bgr_image_, cv::COLOR_RGB2BGR);
+  output_image_.create(bgr_image_.size(), bgr_image_.type());
 
-  p->srcBuffer = bgr_image.data;
-  p->srcStride = static_cast<int>(bgr_image.step);
-  p->dstBuffer = output_image.data;
-  p->dstStride = static_cast<int>(output_image.step);
+  p->srcBuffer = bgr_image_.data;
+  p->srcStride = static_cast<int>(bgr_image_.step);
+  p->dstBuffer = output_image_.data;
+  p->dstStride = static_cast<int>(output_image_.step);
 
   if (prohawkStartFlag == false) { printf("Starting Prohawk Vision Holoscan Operator...\n"); }
   if (filter1 != 100) de.setFrame(p);
@@ -173,19 +268,16 @@ void ProhawkOp::compute(InputContext& op_input, OutputContext& op_output, Execut
     prohawkStartFlag = true;
   }
 
-  cv::cvtColor(output_image, rgb_image, cv::COLOR_BGR2RGB);
-  if (filter1 != 100) {
-    cudaMemcpy(tensor->data(), rgb_image.data, data_size, cudaMemcpyHostToDevice);
-  }
-
-  op_output.emit(value1, "output1");
-  // op_output.emit(value1, "output2");
+  if (filter1 != 100) { cv::cvtColor(output_image_, frame_image, cv::COLOR_BGR2RGB); }
+}
 
+void ProhawkOp::show_frame(int rows, int cols) {
+  cv::Mat sbsmat;
   if (filter1 != 100) {
-    cv::hconcat(bgr_image, output_image, sbsmat);
+    cv::hconcat(bgr_image_, output_image_, sbsmat);
 
   } else {
-    cv::hconcat(bgr_image, bgr_image, sbsmat);
+    cv::hconcat(bgr_image_, bgr_image_, sbsmat);
   }
 
   if (sbsview == false) {
@@ -18,6 +18,11 @@
 #ifndef HOLOSCAN_OPERATORS_PROHAWKOP_HPP
 #define HOLOSCAN_OPERATORS_PROHAWKOP_HPP
 
+#include <cuda_runtime.h>
+
+#include <array>
+#include <optional>
+
 #include <holoscan/holoscan.hpp>
 #include "PTGDE/CPTGDE.h"
 #include "opencv2/opencv.hpp"
@@ -39,8 +44,38 @@ class ProhawkOp : public Operator {
   std::string selectedFilter;
   bool sbsview = false;
   void setup(OperatorSpec& spec) override;
+  void start() override;
+  void stop() override;
 
   void compute(InputContext& op_input, OutputContext&, ExecutionContext&) override;
+
+ private:
+  // Pinned staging buffer for one frame in flight
+  struct HostSlot {
+    uint8_t* data = nullptr;
+    size_t size = 0;
+    cudaEvent_t downloaded = nullptr;
+  };
+
+  void configure_filter();
+  // Restores the packed RGB frame in place
+  void restore_frame(uint8_t* frame, int rows, int cols);
+  void show_frame(int rows, int cols);
+
+  Parameter<bool> pipelined_;
+
+  cudaStream_t stream_ = nullptr;
+  std::array<HostSlot, 2> slots_;
+  int slot_index_ = 0;
+
+  // Frame downloaded on the previous compute, restored and emitted on the next one
+  std::optional<gxf::Entity> pending_;
+  std::shared_ptr<Tensor> pending_tensor_;
+  int pending_rows_ = 0;
+  int pending_cols_ = 0;
+
+  cv::Mat bgr_image_;
+  cv::Mat output_image_;
 };
 
 }  // namespace holoscan::ops
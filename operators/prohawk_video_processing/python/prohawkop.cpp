@@ -44,9 +44,9 @@ class PyProhawkOp : public ProhawkOp {
  public:
   using ProhawkOp::ProhawkOp;
 
-  explicit PyProhawkOp(Fragment* fragment, const py::args& args,
+  explicit PyProhawkOp(Fragment* fragment, const py::args& args, bool pipelined = false,
                        const std::string& name = "prohawk_video_processing")
-      : ProhawkOp() {
+      : ProhawkOp(ArgList{Arg{"pipelined", pipelined}}) {
     add_positional_condition_and_resource_args(this, args);
     name_ = name;
     fragment_ = fragment;
@@ -74,8 +74,9 @@ PYBIND11_MODULE(_prohawk_video_processing, m) {
 
   py::class_<ProhawkOp, PyProhawkOp, Operator, std::shared_ptr<ProhawkOp>>(
       m, "ProhawkOp", doc::ProhawkOp::doc_ProhawkOp)
-      .def(py::init<Fragment*, const py::args&, const std::string&>(),
+      .def(py::init<Fragment*, const py::args&, bool, const std::string&>(),
            "fragment"_a,
+           "pipelined"_a = false,
            "name"_a = "prohawk_video_processing"s,
            doc::ProhawkOp::doc_ProhawkOp_python)
       .def("initialize", &ProhawkOp::initialize, doc::ProhawkOp::doc_initialize)
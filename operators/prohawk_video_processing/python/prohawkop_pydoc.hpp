@@ -33,6 +33,16 @@ Operator class to use ProHawk filters.
 // PyProhawkOp Constructor
 PYDOC(ProhawkOp_python, R"doc(
 Operator class to use ProHawk filters.
+
+Parameters
+----------
+fragment : holoscan.core.Fragment
+    The fragment that the operator belongs to.
+pipelined : bool, optional
+    Overlap the download of the next frame with the restoration of the current one using
+    pinned double-buffers. Adds one frame of latency.
+name : str, optional
+    The name of the operator.
 )doc")
 
 PYDOC(initialize, R"doc(
@@ -22,6 +22,9 @@
 
 #include <cuda_gl_interop.h>
 
+#include <tuple>
+#include <utility>
+
 #define CUDA_TRY(stmt)                                                                        \
   ({                                                                                          \
     cudaError_t _holoscan_cuda_err = stmt;                                                    \
@@ -39,6 +42,21 @@
 OpenGLRenderer::OpenGLRenderer(QtHoloscanSharedData* shared_data) : shared_data_(shared_data) {}
 
 OpenGLRenderer::~OpenGLRenderer() {
+  if (program_) {
+    // Called on the render thread with the context current
+    std::lock_guard lock(shared_data_->mutex_);
+    freePixelBuffers();
+    for (auto& pixel_buffer : shared_data_->pixel_buffers_) {
+      if (pixel_buffer.cuda_event_) {
+        CUDA_TRY(cudaEventDestroy(pixel_buffer.cuda_event_));
+        pixel_buffer.cuda_event_ = nullptr;
+      }
+    }
+    // A new renderer allocates the ring again
+    if (texture_width_) { shared_data_->layout_changed_ = true; }
+    if (gl_texture_) { glDeleteTextures(1, &gl_texture_); }
+    if (cuda_stream_) { CUDA_TRY(cudaStreamDestroy(cuda_stream_)); }
+  }
   delete program_;
 }
 
@@ -123,6 +141,28 @@ static GLenum getTextureFormat(nvidia::gxf::VideoFormat video_format) {
 /**
  * @brief Get the bytes per texel for a given texture format
  */
+// Format and type of the pixel data in the pixel buffers
+static std::pair<GLenum, GLenum> getUploadFormat(GLenum texture_format) {
+  switch (texture_format) {
+    case GL_RGBA8:
+      return {GL_RGBA, GL_UNSIGNED_BYTE};
+    case GL_BGRA:
+      return {GL_BGRA, GL_UNSIGNED_BYTE};
+    case GL_ABGR_EXT:
+      return {GL_ABGR_EXT, GL_UNSIGNED_BYTE};
+    case GL_LUMINANCE:
+      return {GL_LUMINANCE, GL_UNSIGNED_BYTE};
+    case GL_LUMINANCE16:
+      return {GL_LUMINANCE, GL_UNSIGNED_SHORT};
+    case GL_LUMINANCE32UI_EXT:
+      return {GL_LUMINANCE_INTEGER_EXT, GL_UNSIGNED_INT};
+    case GL_LUMINANCE32F_ARB:
+      return {GL_LUMINANCE, GL_FLOAT};
+    default:
+      throw std::runtime_error(fmt::format("Unhandled texture format {}", int64_t(texture_format)));
+  }
+}
+
 static uint32_t getBytesPerTexel(GLenum texture_format) {
   switch (texture_format) {
     case GL_RGBA8:
@@ -141,78 +181,193 @@ static uint32_t getBytesPerTexel(GLenum texture_format) {
   }
 }
 
-void OpenGLRenderer::paint() {
-  // Play nice with the RHI. Not strictly needed when the scenegraph uses
-  // OpenGL directly.
-  window_->beginExternalCommands();
-  QQuickOpenGLUtils::resetOpenGLState();
+void OpenGLRenderer::allocatePixelBuffers() {
+  freePixelBuffers();
+
+  const auto& video_buffer_info = shared_data_->video_buffer_info_;
+  const GLenum new_texture_format = getTextureFormat(video_buffer_info.color_format);
+  if ((texture_format_ != new_texture_format) || (texture_width_ != video_buffer_info.width) ||
+      (texture_height_ != video_buffer_info.height)) {
+    texture_format_ = new_texture_format;
+    texture_width_ = video_buffer_info.width;
+    texture_height_ = video_buffer_info.height;
+    std::tie(upload_format_, upload_type_) = getUploadFormat(texture_format_);
+    // Create the texture.
+    if (gl_texture_) {
+      glDeleteTextures(1, &gl_texture_);
+      gl_texture_ = 0;
+    }
+    glGenTextures(1, &gl_texture_);
+    glBindTexture(GL_TEXTURE_2D, gl_texture_);
+    glTexStorage2D(GL_TEXTURE_2D, 1, texture_format_, texture_width_, texture_height_);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glBindTexture(GL_TEXTURE_2D, 0);
+  }
+
+  // Tightly packed rows
+  shared_data_->pitch_ = texture_width_ * getBytesPerTexel(texture_format_);
+  const GLsizeiptr size = GLsizeiptr(shared_data_->pitch_) * texture_height_;
+
+  std::array<cudaGraphicsResource_t, QtHoloscanSharedData::kNumPixelBuffers> cuda_resources;
+  for (uint32_t index = 0; index < QtHoloscanSharedData::kNumPixelBuffers; ++index) {
+    auto& pixel_buffer_object = pixel_buffer_objects_[index];
+    glGenBuffers(1, &pixel_buffer_object.buffer);
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, pixel_buffer_object.buffer);
+    glBufferData(GL_PIXEL_UNPACK_BUFFER, size, nullptr, GL_STREAM_DRAW);
+    CUDA_TRY(cudaGraphicsGLRegisterBuffer(&pixel_buffer_object.cuda_resource,
+                                          pixel_buffer_object.buffer,
+                                          cudaGraphicsRegisterFlagsWriteDiscard));
+    cuda_resources[index] = pixel_buffer_object.cuda_resource;
+
+    auto& pixel_buffer = shared_data_->pixel_buffers_[index];
+    if (!pixel_buffer.cuda_event_) {
+      CUDA_TRY(cudaEventCreateWithFlags(&pixel_buffer.cuda_event_, cudaEventDisableTiming));
+    }
+  }
+  glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+
+  // The whole ring starts mapped for CUDA
+  CUDA_TRY(cudaGraphicsMapResources(cuda_resources.size(), cuda_resources.data(), cuda_stream_));
+  for (uint32_t index = 0; index < QtHoloscanSharedData::kNumPixelBuffers; ++index) {
+    auto& pixel_buffer = shared_data_->pixel_buffers_[index];
+    size_t mapped_size = 0;
+    CUDA_TRY(cudaGraphicsResourceGetMappedPointer(
+        &pixel_buffer.pointer_, &mapped_size, cuda_resources[index]));
+    CUDA_TRY(cudaEventRecord(pixel_buffer.cuda_event_, cuda_stream_));
+    pixel_buffer.state_ = QtHoloscanSharedData::PixelBuffer::State::Writable;
+  }
+}
+
+void OpenGLRenderer::freePixelBuffers() {
+  using State = QtHoloscanSharedData::PixelBuffer::State;
+  for (uint32_t index = 0; index < QtHoloscanSharedData::kNumPixelBuffers; ++index) {
+    auto& pixel_buffer = shared_data_->pixel_buffers_[index];
+    auto& pixel_buffer_object = pixel_buffer_objects_[index];
+    if (pixel_buffer_object.fence) {
+      glDeleteSync(pixel_buffer_object.fence);
+      pixel_buffer_object.fence = nullptr;
+    }
+    if (pixel_buffer_object.cuda_resource) {
+      if (pixel_buffer.state_ != State::Uploading) {
+        // Any copy into the buffer has to be done before it is released
+        CUDA_TRY(cudaStreamWaitEvent(cuda_stream_, pixel_buffer.cuda_event_));
+        CUDA_TRY(cudaGraphicsUnmapResources(1, &pixel_buffer_object.cuda_resource, cuda_stream_));
+      }
+      CUDA_TRY(cudaGraphicsUnregisterResource(pixel_buffer_object.cuda_resource));
+      pixel_buffer_object.cuda_resource = nullptr;
+    }
+    if (pixel_buffer_object.buffer) {
+      glDeleteBuffers(1, &pixel_buffer_object.buffer);
+      pixel_buffer_object.buffer = 0;
+    }
+    pixel_buffer.pointer_ = nullptr;
+    pixel_buffer.state_ = State::Unallocated;
+  }
+}
 
-  {
+void OpenGLRenderer::uploadFrame() {
+  using State = QtHoloscanSharedData::PixelBuffer::State;
+  auto& pixel_buffers = shared_data_->pixel_buffers_;
+
+  // The producer only requests a new layout while it holds no pixel buffer, and claims none
+  // until the ring is reallocated
+  if (shared_data_->layout_changed_) {
     std::lock_guard lock(shared_data_->mutex_);
+    allocatePixelBuffers();
+    shared_data_->layout_changed_ = false;
+  }
 
-    if (shared_data_->state_ == QtHoloscanSharedData::State::Ready) {
-      // Update the texture using the given buffer.
-      const uint32_t new_width = shared_data_->video_buffer_info_.width;
-      const uint32_t new_height = shared_data_->video_buffer_info_.height;
-      const GLenum new_texture_format =
-          getTextureFormat(shared_data_->video_buffer_info_.color_format);
-      if ((texture_format_ != new_texture_format) || (texture_width_ != new_width) ||
-          (texture_height_ != new_height)) {
-        texture_format_ = new_texture_format;
-        texture_width_ = new_width;
-        texture_height_ = new_height;
-        // Create the texture.
-        if (gl_texture_) {
-          glDeleteTextures(1, &gl_texture_);
-          gl_texture_ = 0;
-        }
-        glGenTextures(1, &gl_texture_);
-        glBindTexture(GL_TEXTURE_2D, gl_texture_);
-        glTexStorage2D(GL_TEXTURE_2D, 1, texture_format_, texture_width_, texture_height_);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-        glBindTexture(GL_TEXTURE_2D, 0);
-
-        if (cuda_resource_) {
-          CUDA_TRY(cudaGraphicsUnregisterResource(cuda_resource_));
-          cuda_resource_ = nullptr;
-        }
-        CUDA_TRY(cudaGraphicsGLRegisterImage(
-            &cuda_resource_, gl_texture_, GL_TEXTURE_2D, cudaGraphicsMapFlagsWriteDiscard));
+  // Pixel buffers OpenGL is done reading go back to CUDA, the producer never touches them
+  // while they are uploading
+  std::array<cudaGraphicsResource_t, QtHoloscanSharedData::kNumPixelBuffers> released;
+  std::array<uint32_t, QtHoloscanSharedData::kNumPixelBuffers> released_indices;
+  uint32_t released_count = 0;
+  for (uint32_t index = 0; index < pixel_buffers.size(); ++index) {
+    auto& pixel_buffer_object = pixel_buffer_objects_[index];
+    if (pixel_buffers[index].state_ == State::Uploading &&
+        glClientWaitSync(pixel_buffer_object.fence, 0, 0) != GL_TIMEOUT_EXPIRED) {
+      glDeleteSync(pixel_buffer_object.fence);
+      pixel_buffer_object.fence = nullptr;
+      released[released_count] = pixel_buffer_object.cuda_resource;
+      released_indices[released_count++] = index;
+    }
+  }
+
+  // Only the newest frame is shown, the producer may replace a ready frame meanwhile so the
+  // buffer is claimed before it is used
+  int newest = -1;
+  while (true) {
+    newest = -1;
+    for (uint32_t index = 0; index < pixel_buffers.size(); ++index) {
+      if (pixel_buffers[index].state_ == State::Ready &&
+          (newest < 0 || pixel_buffers[index].frame_ > pixel_buffers[newest].frame_)) {
+        newest = index;
       }
+    }
+    if (newest < 0) { break; }
+    State expected = State::Ready;
+    if (pixel_buffers[newest].state_.compare_exchange_strong(expected, State::Uploading)) {
+      break;
+    }
+  }
+  for (auto& pixel_buffer : pixel_buffers) {
+    // Older frames are dropped, their buffer is still mapped
+    State expected = State::Ready;
+    if (pixel_buffer.state_.compare_exchange_strong(expected, State::Writable)) {
+      ++shared_data_->frames_replaced_;
+    }
+  }
+
+  if (newest >= 0) {
+    auto& pixel_buffer = pixel_buffers[newest];
+    auto& pixel_buffer_object = pixel_buffer_objects_[newest];
+    // Unmapping after the producer's copy hands the buffer over to OpenGL
+    CUDA_TRY(cudaStreamWaitEvent(cuda_stream_, pixel_buffer.cuda_event_));
+    CUDA_TRY(cudaGraphicsUnmapResources(1, &pixel_buffer_object.cuda_resource, cuda_stream_));
 
-      // Map the OpenGL texture to be used by CUDA, this automatically synchronizes with OpenGL
-      // rendering
-      CUDA_TRY(cudaGraphicsMapResources(1, &cuda_resource_, cuda_stream_));
-      cudaArray* cuda_ptr = nullptr;
-      CUDA_TRY(cudaGraphicsSubResourceGetMappedArray(&cuda_ptr, cuda_resource_, 0, 0));
-
-      // Synchronize with the event provided by the operator
-      CUDA_TRY(cudaStreamWaitEvent(cuda_stream_, shared_data_->cuda_event_));
-
-      // Copy the new data to the mapped texture
-      CUDA_TRY(cudaMemcpy2DToArrayAsync(cuda_ptr,
-                                        0,
-                                        0,
-                                        shared_data_->pointer_,
-                                        shared_data_->video_buffer_info_.color_planes[0].stride,
-                                        texture_width_ * getBytesPerTexel(texture_format_),
-                                        texture_height_,
-                                        cudaMemcpyDeviceToDevice,
-                                        cuda_stream_));
-
-      // Record the event so that the operator can synchronize with the CUDA mem copy
-      CUDA_TRY(cudaEventRecord(shared_data_->cuda_event_, cuda_stream_));
-
-      // Unmap the OpenGL texture, this automatically synchronizes with OpenGL rendering
-      CUDA_TRY(cudaGraphicsUnmapResources(1, &cuda_resource_, cuda_stream_));
-
-      shared_data_->state_ = QtHoloscanSharedData::State::Processed;
-      shared_data_->condition_variable_.notify_one();
+    // The copy from the pixel buffer to the texture is queued on the GPU, the fence tells
+    // when the buffer can be written again
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, pixel_buffer_object.buffer);
+    glBindTexture(GL_TEXTURE_2D, gl_texture_);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    glTexSubImage2D(GL_TEXTURE_2D,
+                    0,
+                    0,
+                    0,
+                    texture_width_,
+                    texture_height_,
+                    upload_format_,
+                    upload_type_,
+                    nullptr);
+    glBindTexture(GL_TEXTURE_2D, 0);
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+    pixel_buffer_object.fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    ++shared_data_->frames_shown_;
+  }
+
+  if (released_count) {
+    CUDA_TRY(cudaGraphicsMapResources(released_count, released.data(), cuda_stream_));
+    for (uint32_t released_index = 0; released_index < released_count; ++released_index) {
+      auto& pixel_buffer = pixel_buffers[released_indices[released_index]];
+      size_t mapped_size = 0;
+      CUDA_TRY(cudaGraphicsResourceGetMappedPointer(
+          &pixel_buffer.pointer_, &mapped_size, released[released_index]));
+      CUDA_TRY(cudaEventRecord(pixel_buffer.cuda_event_, cuda_stream_));
+      pixel_buffer.state_ = State::Writable;
     }
   }
+}
+
+void OpenGLRenderer::paint() {
+  // Play nice with the RHI. Not strictly needed when the scenegraph uses
+  // OpenGL directly.
+  window_->beginExternalCommands();
+  QQuickOpenGLUtils::resetOpenGLState();
+
+  uploadFrame();
 
   if (gl_texture_) {
     program_->bind();
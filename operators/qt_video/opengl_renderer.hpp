@@ -20,6 +20,9 @@
 
 #include "shared_data.hpp"
 
+#include <array>
+#include <memory>
+
 #include <QOpenGLBuffer>
 #include <QOpenGLContext>
 #include <QOpenGLExtraFunctions>
@@ -68,6 +71,14 @@ class OpenGLRenderer : public QObject, protected QOpenGLExtraFunctions {
   void paint();
 
  private:
+  /**
+   * @brief Recreate the texture and the pixel buffer ring for the layout of the shared data
+   */
+  void allocatePixelBuffers();
+  void freePixelBuffers();
+  /// Upload the newest frame copied by the producer to the texture and recycle pixel buffers
+  void uploadFrame();
+
   QRectF geometry_;
 
   // OpenGL state
@@ -80,12 +91,21 @@ class OpenGLRenderer : public QObject, protected QOpenGLExtraFunctions {
   uint32_t texture_width_ = 0;
   uint32_t texture_height_ = 0;
   GLenum texture_format_ = GL_NONE;
+  GLenum upload_format_ = GL_NONE;
+  GLenum upload_type_ = GL_NONE;
+
+  struct PixelBufferObject {
+    GLuint buffer = 0;
+    cudaGraphicsResource_t cuda_resource = nullptr;
+    // Inserted after the upload reading the buffer
+    GLsync fence = nullptr;
+  };
+  std::array<PixelBufferObject, QtHoloscanSharedData::kNumPixelBuffers> pixel_buffer_objects_;
 
   QtHoloscanSharedData* const shared_data_;
 
   // CUDA state
   cudaStream_t cuda_stream_ = nullptr;
-  cudaGraphicsResource_t cuda_resource_ = nullptr;
 };
 
 #endif /* OPERATORS_QT_VIDEO_OPENGL_RENDERER */
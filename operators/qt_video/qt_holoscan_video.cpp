@@ -22,6 +22,8 @@
 #include <QtQuick/qquickwindow.h>
 #include <QtCore/QRunnable>
 
+#include <cuda_runtime.h>
+
 QtHoloscanVideo::QtHoloscanVideo() : renderer_(nullptr) {
   connect(this, &QQuickItem::windowChanged, this, &QtHoloscanVideo::handleWindowChanged);
 
@@ -32,38 +34,100 @@ QtHoloscanVideo::QtHoloscanVideo() : renderer_(nullptr) {
 
 void QtHoloscanVideo::processBuffer(void* pointer,
                                     const nvidia::gxf::VideoBufferInfo& video_buffer_info,
-                                    cudaEvent_t cuda_event) {
-  // signal that there is a new video buffer
-  {
+                                    cudaStream_t cuda_stream) {
+  using State = QtHoloscanSharedData::PixelBuffer::State;
+
+  // only written here, the renderer reads it while reallocating the ring
+  auto& current_info = shared_data_->video_buffer_info_;
+  if ((current_info.width != video_buffer_info.width) ||
+      (current_info.height != video_buffer_info.height) ||
+      (current_info.color_format != video_buffer_info.color_format)) {
     std::lock_guard lock(shared_data_->mutex_);
-
     // set the implicit size of the item so it automatically resize in the UI is the user did
     // not set an explicit size
-    if (shared_data_->video_buffer_info_.width != video_buffer_info.width) {
+    if (current_info.width != video_buffer_info.width) {
       setImplicitWidth(video_buffer_info.width);
     }
-    if (shared_data_->video_buffer_info_.width != video_buffer_info.height) {
+    if (current_info.height != video_buffer_info.height) {
       setImplicitHeight(video_buffer_info.height);
     }
 
-    // update the shared data and mark it ready for the renderer to use
-    shared_data_->pointer_ = pointer;
-    shared_data_->video_buffer_info_ = video_buffer_info;
-    shared_data_->cuda_event_ = cuda_event;
-    shared_data_->state_ = QtHoloscanSharedData::State::Ready;
+    // the renderer reallocates the pixel buffers on the next frame
+    current_info = video_buffer_info;
+    shared_data_->layout_changed_ = true;
   }
-  shared_data_->condition_variable_.notify_one();
 
-  // force redraw
+  // the renderer recycles the pixel buffers when drawing
   emit bufferChanged();
 
-  // wait for the renderer
-  {
-    std::unique_lock lock(shared_data_->mutex_);
-    shared_data_->condition_variable_.wait_until(
-        lock, std::chrono::steady_clock::now() + std::chrono::seconds(5),
-        [this] { return shared_data_->state_ == QtHoloscanSharedData::State::Processed; });
+  // never wait for the renderer: take a free pixel buffer, else replace the oldest frame not
+  // shown yet, else drop this one
+  QtHoloscanSharedData::PixelBuffer* pixel_buffer = nullptr;
+  if (!shared_data_->layout_changed_) {
+    for (auto& candidate : shared_data_->pixel_buffers_) {
+      State expected = State::Writable;
+      if (candidate.state_.compare_exchange_strong(expected, State::Writing)) {
+        pixel_buffer = &candidate;
+        break;
+      }
+    }
+    while (!pixel_buffer) {
+      QtHoloscanSharedData::PixelBuffer* oldest = nullptr;
+      for (auto& candidate : shared_data_->pixel_buffers_) {
+        if ((candidate.state_ == State::Ready) && (!oldest || candidate.frame_ < oldest->frame_)) {
+          oldest = &candidate;
+        }
+      }
+      if (!oldest) { break; }
+      State expected = State::Ready;
+      // the renderer may have taken it meanwhile, look again
+      if (oldest->state_.compare_exchange_strong(expected, State::Writing)) {
+        pixel_buffer = oldest;
+        ++shared_data_->frames_replaced_;
+      }
+    }
+  }
+  if (!pixel_buffer) {
+    ++shared_data_->frames_dropped_;
+    return;
   }
+  void* const destination = pixel_buffer->pointer_;
+  const uint32_t pitch = shared_data_->pitch_;
+  const cudaEvent_t cuda_event = pixel_buffer->cuda_event_;
+
+  // the copy waits for the buffer to be mapped, and the renderer for the copy
+  cudaStreamWaitEvent(cuda_stream, cuda_event);
+  const cudaError_t result = cudaMemcpy2DAsync(destination,
+                                               pitch,
+                                               pointer,
+                                               video_buffer_info.color_planes[0].stride,
+                                               pitch,
+                                               video_buffer_info.height,
+                                               cudaMemcpyDeviceToDevice,
+                                               cuda_stream);
+  cudaEventRecord(cuda_event, cuda_stream);
+
+  // the ring is freed if the renderer goes away meanwhile, then the state is not Writing anymore
+  State expected = State::Writing;
+  if (result != cudaSuccess) {
+    HOLOSCAN_LOG_ERROR("Failed to copy the frame to the pixel buffer: {}",
+                       cudaGetErrorString(result));
+    pixel_buffer->state_.compare_exchange_strong(expected, State::Writable);
+    return;
+  }
+  pixel_buffer->frame_ = ++shared_data_->frame_count_;
+  if (!pixel_buffer->state_.compare_exchange_strong(expected, State::Ready)) { return; }
+  ++shared_data_->frames_copied_;
+
+  // force redraw
+  emit bufferChanged();
+}
+
+QtHoloscanVideo::FrameStatistics QtHoloscanVideo::frameStatistics() const {
+  return FrameStatistics{shared_data_->frames_copied_,
+                         shared_data_->frames_shown_,
+                         shared_data_->frames_replaced_,
+                         shared_data_->frames_dropped_};
 }
 
 void QtHoloscanVideo::forceRedraw() {
@@ -28,6 +28,7 @@
 
 // forward declarations
 class OpenGLRenderer;
+typedef struct CUstream_st* cudaStream_t;
 
 /**
  * @brief This class is a QQuickItem which displays the video frames received by QtVideoOp.
@@ -43,13 +44,26 @@ class QtHoloscanVideo : public QQuickItem {
   /**
    * @brief Process a video buffer
    *
+   * Queues the copy of the buffer into a free pixel buffer of the renderer on `cuda_stream`,
+   * without waiting for the renderer. If the renderer is behind, the oldest frame not shown
+   * yet is replaced; if every pixel buffer is being uploaded or the ring is being reallocated
+   * for a new layout, the frame is dropped.
+   *
    * @param pointer pointer to CUDA memory
    * @param video_buffer_info video buffer information
-   * @param cuda_event CUDA event to use for synchronization (wait before using memory, record after
-   * using memory)
+   * @param cuda_stream CUDA stream the buffer is ready on, the copy is queued on it
    */
   void processBuffer(void* pointer, const nvidia::gxf::VideoBufferInfo& video_buffer_info,
-                     cudaEvent_t cuda_event);
+                     cudaStream_t cuda_stream);
+
+  /// Counters of the frames handed over to the renderer
+  struct FrameStatistics {
+    uint64_t copied;    ///< copied into a pixel buffer
+    uint64_t shown;     ///< uploaded to the texture by the renderer
+    uint64_t replaced;  ///< replaced by a newer frame before they were shown
+    uint64_t dropped;   ///< not copied, no pixel buffer was free
+  };
+  FrameStatistics frameStatistics() const;
 
  public slots:
   void sync();
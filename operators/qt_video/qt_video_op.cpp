@@ -79,15 +79,14 @@ void QtVideoOp::setup(holoscan::OperatorSpec& spec) {
   cuda_stream_handler_.define_params(spec);
 }
 
-void QtVideoOp::start() {
-  CUDA_TRY(cudaEventCreate(&cuda_event_, cudaEventDisableTiming));
-}
-
 void QtVideoOp::stop() {
-  if (cuda_event_) {
-    CUDA_TRY(cudaEventDestroy(cuda_event_));
-    cuda_event_ = nullptr;
-  }
+  if (!qt_holoscan_video_.get()) { return; }
+  const auto statistics = qt_holoscan_video_->frameStatistics();
+  HOLOSCAN_LOG_INFO("QtVideoOp frames: {} copied, {} shown, {} replaced, {} dropped",
+                    statistics.copied,
+                    statistics.shown,
+                    statistics.replaced,
+                    statistics.dropped);
 }
 
 void QtVideoOp::compute(holoscan::InputContext& op_input, holoscan::OutputContext& op_output,
@@ -103,9 +102,6 @@ void QtVideoOp::compute(holoscan::InputContext& op_input, holoscan::OutputContex
     throw std::runtime_error("Failed to get the CUDA stream from incoming messages");
   }
 
-  // record a CUDA event, the render later will synchronize the rendering using that event
-  CUDA_TRY(cudaEventRecord(cuda_event_, cuda_stream_handler_.get_cuda_stream(context.context())));
-
   // Get the input data, both VideoBuffer and Tensor is supported. We collect the buffer info
   // in the `video_buffer_info` structure
   nvidia::gxf::VideoBufferInfo video_buffer_info{};
@@ -178,12 +174,10 @@ void QtVideoOp::compute(holoscan::InputContext& op_input, holoscan::OutputContex
     pointer = tensor->pointer();
   }
 
-  // Now send the buffer to the QtQuick QtHoloscanVideo element to be displayed
-  qt_holoscan_video_->processBuffer(pointer, video_buffer_info, cuda_event_);
-
-  // Synchronize with the event recorded by the renderer
-  CUDA_TRY(
-      cudaStreamWaitEvent(cuda_stream_handler_.get_cuda_stream(context.context()), cuda_event_));
+  // Now send the buffer to the QtQuick QtHoloscanVideo element to be displayed, it is copied
+  // on our stream into a pixel buffer of the renderer
+  qt_holoscan_video_->processBuffer(
+      pointer, video_buffer_info, cuda_stream_handler_.get_cuda_stream(context.context()));
 
   // Add the CUDA stream we used to the event to allow synchrinization when freeing the memory
   const auto maybe_stream_id = entity.add<nvidia::gxf::CudaStreamId>();
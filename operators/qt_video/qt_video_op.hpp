@@ -27,7 +27,6 @@
 
 // forward declarations
 class QtHoloscanVideo;
-typedef struct CUevent_st* cudaEvent_t;
 
 namespace holoscan::ops {
 
@@ -48,9 +47,8 @@ class QtVideoOp : public holoscan::Operator {
   QtVideoOp();
 
   void initialize() override;
-  void start() override;
-  void stop() override;
   void setup(holoscan::OperatorSpec& spec) override;
+  void stop() override;
   void compute(holoscan::InputContext& op_input, holoscan::OutputContext& op_output,
                holoscan::ExecutionContext& context) override;
 
@@ -58,7 +56,6 @@ class QtVideoOp : public holoscan::Operator {
   holoscan::Parameter<QtHoloscanVideo*> qt_holoscan_video_;
 
   CudaStreamHandler cuda_stream_handler_;
-  cudaEvent_t cuda_event_ = nullptr;
 };
 
 }  // namespace holoscan::ops
@@ -20,7 +20,9 @@
 
 #include "qt_video_op.hpp"
 
-#include <condition_variable>
+#include <array>
+#include <atomic>
+#include <cstdint>
 #include <mutex>
 
 // forward declarations
@@ -30,15 +32,50 @@ struct VideoBufferInfo;
 }
 
 typedef struct QtHoloscanSharedData_t {
+  // Only guards the (re)allocation and the release of the ring by the renderer, the frames are
+  // handed over through the atomic states of the pixel buffers
   std::mutex mutex_;
-  std::condition_variable condition_variable_;
 
-  void *pointer_ = nullptr;
+  // Ring of OpenGL pixel buffer objects the frames are copied into, registered with CUDA once
+  // per layout. The producer copies into a buffer the renderer has mapped, the renderer unmaps
+  // it and uploads it to the texture, then maps it again once the fence after the upload is
+  // signaled. The latest frame wins: the producer overwrites the oldest ready frame rather than
+  // waiting for the renderer, which only uploads the newest one.
+  static constexpr uint32_t kNumPixelBuffers = 3;
+
+  struct PixelBuffer {
+    enum class State {
+      Unallocated,  // no pixel buffer object for the current layout
+      Writable,     // mapped for CUDA, free for the next frame
+      Writing,      // the producer is queuing the copy of a frame
+      Ready,        // the copy is queued, cuda_event_ is recorded after it
+      Uploading,    // unmapped, read by OpenGL until the renderer's fence is signaled
+    };
+    // Transitions are claimed with a compare and exchange: Writable or Ready to Writing by the
+    // producer, Ready to Uploading or Writable by the renderer
+    std::atomic<State> state_{State::Unallocated};
+    // CUDA pointer to the mapped buffer
+    void* pointer_ = nullptr;
+    // Recorded by the renderer after mapping, and by the producer after copying
+    cudaEvent_t cuda_event_ = nullptr;
+    // Sequence number of the frame copied into the buffer
+    uint64_t frame_ = 0;
+  };
+  std::array<PixelBuffer, kNumPixelBuffers> pixel_buffers_;
+
+  // Layout of the frames, the pixel buffers are reallocated by the renderer when it changes
   nvidia::gxf::VideoBufferInfo video_buffer_info_{};
-  cudaEvent_t cuda_event_ = nullptr;
+  std::atomic<bool> layout_changed_{false};
+  // Row pitch of the pixel buffers in bytes
+  uint32_t pitch_ = 0;
+  uint64_t frame_count_ = 0;
 
-  enum class State { Unknown, Ready, Processed };
-  State state_ = State::Unknown;
+  // Frames copied, shown, replaced by a newer frame before they were shown, and dropped by the
+  // producer because no pixel buffer was free or the ring was being reallocated
+  std::atomic<uint64_t> frames_copied_{0};
+  std::atomic<uint64_t> frames_shown_{0};
+  std::atomic<uint64_t> frames_replaced_{0};
+  std::atomic<uint64_t> frames_dropped_{0};
 } QtHoloscanSharedData;
 
 #endif /* OPERATORS_QT_VIDEO_SHARED_DATA */
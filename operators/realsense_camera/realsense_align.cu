@@ -0,0 +1,109 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2024-2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "realsense_align.cuh"
+
+namespace holoscan::ops::realsense {
+
+namespace {
+
+// Positive floats compare like their bits, this is "no depth yet"
+constexpr uint32_t kNoDepth = 0xFFFFFFFFU;
+
+__device__ float3 deproject(const Intrinsics& intrinsics, float x, float y, float z) {
+  return make_float3(
+      (x - intrinsics.ppx) / intrinsics.fx * z, (y - intrinsics.ppy) / intrinsics.fy * z, z);
+}
+
+__device__ float2 project(const Intrinsics& intrinsics, float3 point) {
+  return make_float2(point.x / point.z * intrinsics.fx + intrinsics.ppx,
+                     point.y / point.z * intrinsics.fy + intrinsics.ppy);
+}
+
+__device__ float3 transform(const AlignParams& params, float3 point) {
+  const float* r = params.rotation;
+  return make_float3(r[0] * point.x + r[3] * point.y + r[6] * point.z + params.translation[0],
+                     r[1] * point.x + r[4] * point.y + r[7] * point.z + params.translation[1],
+                     r[2] * point.x + r[5] * point.y + r[8] * point.z + params.translation[2]);
+}
+
+__global__ void splat_kernel(const uint16_t* depth, size_t depth_pitch, AlignParams params,
+                             uint8_t* aligned, size_t aligned_pitch) {
+  const uint32_t u = blockIdx.x * blockDim.x + threadIdx.x;
+  const uint32_t v = blockIdx.y * blockDim.y + threadIdx.y;
+  if (u >= params.depth.width || v >= params.depth.height) { return; }
+
+  const uint16_t raw = reinterpret_cast<const uint16_t*>(
+      reinterpret_cast<const uint8_t*>(depth) + v * depth_pitch)[u];
+  if (raw == 0) { return; }
+  const float z = raw * params.depth_scale;
+
+  // the top left and bottom right corners of the depth pixel in the color image
+  const float2 p0 =
+      project(params.color, transform(params, deproject(params.depth, u - 0.5f, v - 0.5f, z)));
+  const float2 p1 =
+      project(params.color, transform(params, deproject(params.depth, u + 0.5f, v + 0.5f, z)));
+  const int x0 = max(static_cast<int>(p0.x + 0.5f), 0);
+  const int y0 = max(static_cast<int>(p0.y + 0.5f), 0);
+  const int x1 = min(static_cast<int>(p1.x + 0.5f), static_cast<int>(params.color.width) - 1);
+  const int y1 = min(static_cast<int>(p1.y + 0.5f), static_cast<int>(params.color.height) - 1);
+
+  const uint32_t bits = __float_as_uint(z);
+  for (int y = y0; y <= y1; y++) {
+    auto* row = reinterpret_cast<uint32_t*>(aligned + y * aligned_pitch);
+    for (int x = x0; x <= x1; x++) { atomicMin(row + x, bits); }
+  }
+}
+
+__global__ void finalize_kernel(uint8_t* aligned, size_t aligned_pitch, uint32_t width,
+                                uint32_t height) {
+  const uint32_t x = blockIdx.x * blockDim.x + threadIdx.x;
+  const uint32_t y = blockIdx.y * blockDim.y + threadIdx.y;
+  if (x >= width || y >= height) { return; }
+
+  auto* pixel = reinterpret_cast<uint32_t*>(aligned + y * aligned_pitch) + x;
+  if (*pixel == kNoDepth) { *pixel = 0U; }
+}
+
+}  // namespace
+
+cudaError_t cuda_align_depth_to_color(const uint16_t* depth, size_t depth_pitch,
+                                      const AlignParams& params, float* aligned,
+                                      size_t aligned_pitch, cudaStream_t cuda_stream) {
+  auto* aligned_bytes = reinterpret_cast<uint8_t*>(aligned);
+  cudaError_t status = cudaMemset2DAsync(aligned_bytes,
+                                         aligned_pitch,
+                                         0xFF,
+                                         params.color.width * sizeof(float),
+                                         params.color.height,
+                                         cuda_stream);
+  if (status != cudaSuccess) { return status; }
+
+  const dim3 block(32, 8);
+  const dim3 depth_grid((params.depth.width + block.x - 1) / block.x,
+                        (params.depth.height + block.y - 1) / block.y);
+  splat_kernel<<<depth_grid, block, 0, cuda_stream>>>(
+      depth, depth_pitch, params, aligned_bytes, aligned_pitch);
+
+  const dim3 color_grid((params.color.width + block.x - 1) / block.x,
+                        (params.color.height + block.y - 1) / block.y);
+  finalize_kernel<<<color_grid, block, 0, cuda_stream>>>(
+      aligned_bytes, aligned_pitch, params.color.width, params.color.height);
+  return cudaGetLastError();
+}
+
+}  // namespace holoscan::ops::realsense
@@ -0,0 +1,60 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2024-2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef HOLOSCAN_OPERATORS_REALSENSE_CAMERA_ALIGN
+#define HOLOSCAN_OPERATORS_REALSENSE_CAMERA_ALIGN
+
+#include <cuda_runtime.h>
+
+#include <cstddef>
+#include <cstdint>
+
+namespace holoscan::ops::realsense {
+
+/// Pinhole model of a camera stream, distortion is not applied
+struct Intrinsics {
+  uint32_t width;
+  uint32_t height;
+  float fx;
+  float fy;
+  float ppx;
+  float ppy;
+};
+
+/// Depth-to-color alignment parameters, from the device calibration
+struct AlignParams {
+  Intrinsics depth;
+  Intrinsics color;
+  /// Column-major rotation and translation in meters from depth to color
+  float rotation[9];
+  float translation[3];
+  /// Meters per depth unit
+  float depth_scale;
+};
+
+/// Align the Z16 depth image to the color image and convert it to meters.
+///
+/// Each depth pixel is splatted over the color pixels its footprint projects to, keeping the
+/// nearest depth where several land on the same color pixel. Color pixels without depth are 0.
+/// `aligned` is a float image of the color size; its pitch is in bytes like `depth_pitch`.
+cudaError_t cuda_align_depth_to_color(const uint16_t* depth, size_t depth_pitch,
+                                      const AlignParams& params, float* aligned,
+                                      size_t aligned_pitch, cudaStream_t cuda_stream);
+
+}  // namespace holoscan::ops::realsense
+
+#endif  // HOLOSCAN_OPERATORS_REALSENSE_CAMERA_ALIGN
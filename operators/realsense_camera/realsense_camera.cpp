@@ -17,6 +17,9 @@
 
 #include "realsense_camera.hpp"
 
+#include <chrono>
+#include <cstring>
+
 #include "cuda_runtime.h"
 #include "gxf/multimedia/camera.hpp"
 #include "gxf/multimedia/video.hpp"
@@ -24,6 +27,40 @@
 
 namespace holoscan::ops {
 
+namespace {
+
+constexpr uint32_t kWidth = 1280;
+constexpr uint32_t kHeight = 720;
+constexpr uint32_t kFramerate = 30;
+constexpr uint32_t kColorBytesPerPixel = 4;
+
+/// Same as the wait of rs2::pipeline::wait_for_frames()
+constexpr auto kFramesetTimeout = std::chrono::milliseconds(5000);
+
+realsense::Intrinsics to_intrinsics(const rs2_intrinsics& intrinsics) {
+  return {static_cast<uint32_t>(intrinsics.width),
+          static_cast<uint32_t>(intrinsics.height),
+          intrinsics.fx,
+          intrinsics.fy,
+          intrinsics.ppx,
+          intrinsics.ppy};
+}
+
+// Copy the rows of a frame into a packed buffer
+void copy_frame(const rs2::video_frame& frame, uint8_t* dst) {
+  const size_t row_bytes = frame.get_width() * frame.get_bytes_per_pixel();
+  const auto* src = static_cast<const uint8_t*>(frame.get_data());
+  if (frame.get_stride_in_bytes() == static_cast<int>(row_bytes)) {
+    std::memcpy(dst, src, row_bytes * frame.get_height());
+    return;
+  }
+  for (int y = 0; y < frame.get_height(); y++) {
+    std::memcpy(dst + y * row_bytes, src + y * frame.get_stride_in_bytes(), row_bytes);
+  }
+}
+
+}  // namespace
+
 void RealsenseCameraOp::setup(OperatorSpec& spec) {
   spec.output<holoscan::gxf::Entity>("color_buffer");
   spec.output<holoscan::gxf::Entity>("depth_buffer");
@@ -32,17 +69,102 @@ void RealsenseCameraOp::setup(OperatorSpec& spec) {
   spec.output<nvidia::gxf::CameraModel>("depth_camera_model").condition(ConditionType::kNone);
 
   spec.param(allocator_, "allocator", "Allocator", "Allocator to allocate output tensor.");
+
+  cuda_stream_handler_.define_params(spec);
 }
 
 void RealsenseCameraOp::start() {
+  for (auto& slot : slots_) {
+    if (cudaMallocHost(&slot.color, kWidth * kHeight * kColorBytesPerPixel) != cudaSuccess ||
+        cudaMallocHost(&slot.depth, kWidth * kHeight * sizeof(uint16_t)) != cudaSuccess ||
+        cudaEventCreateWithFlags(&slot.uploaded, cudaEventDisableTiming) != cudaSuccess) {
+      throw std::runtime_error("Failed to allocate the RealSense frame buffers");
+    }
+    slot.state = SlotState::kFree;
+  }
+  if (cudaMalloc(&device_depth_, kWidth * kHeight * sizeof(uint16_t)) != cudaSuccess) {
+    throw std::runtime_error("Failed to allocate the RealSense depth buffer");
+  }
+  dropped_framesets_ = 0;
+
   rs2::config config;
-  config.enable_stream(RS2_STREAM_COLOR, 1280, 720, RS2_FORMAT_RGBA8, 30);
-  config.enable_stream(RS2_STREAM_DEPTH, 1280, 720, RS2_FORMAT_Z16, 30);
-  profile_ = pipeline_.start(config);
+  config.enable_stream(RS2_STREAM_COLOR, kWidth, kHeight, RS2_FORMAT_RGBA8, kFramerate);
+  config.enable_stream(RS2_STREAM_DEPTH, kWidth, kHeight, RS2_FORMAT_Z16, kFramerate);
+  // With a callback, the pipeline delivers the synchronized framesets on its own thread
+  profile_ = pipeline_.start(config, [this](const rs2::frame& frame) {
+    if (auto frameset = frame.as<rs2::frameset>()) { on_frameset(frameset); }
+  });
+
+  auto color_profile = profile_.get_stream(RS2_STREAM_COLOR).as<rs2::video_stream_profile>();
+  auto depth_profile = profile_.get_stream(RS2_STREAM_DEPTH).as<rs2::video_stream_profile>();
+  const rs2_extrinsics extrinsics = depth_profile.get_extrinsics_to(color_profile);
+  align_params_.depth = to_intrinsics(depth_profile.get_intrinsics());
+  align_params_.color = to_intrinsics(color_profile.get_intrinsics());
+  std::memcpy(align_params_.rotation, extrinsics.rotation, sizeof(align_params_.rotation));
+  std::memcpy(
+      align_params_.translation, extrinsics.translation, sizeof(align_params_.translation));
+  align_params_.depth_scale = profile_.get_device().first<rs2::depth_sensor>().get_depth_scale();
 }
 
 void RealsenseCameraOp::stop() {
   pipeline_.stop();
+
+  for (auto& slot : slots_) {
+    if (slot.uploaded) { cudaEventSynchronize(slot.uploaded); }
+  }
+  for (auto& slot : slots_) {
+    if (slot.uploaded) { cudaEventDestroy(slot.uploaded); }
+    if (slot.depth) { cudaFreeHost(slot.depth); }
+    if (slot.color) { cudaFreeHost(slot.color); }
+    slot = FrameSlot();
+  }
+  if (device_depth_) {
+    cudaFree(device_depth_);
+    device_depth_ = nullptr;
+  }
+  if (dropped_framesets_ > 0) {
+    HOLOSCAN_LOG_INFO("RealSense: {} framesets replaced by newer ones", dropped_framesets_);
+  }
+}
+
+void RealsenseCameraOp::on_frameset(const rs2::frameset& frameset) {
+  rs2::video_frame color_frame = frameset.get_color_frame();
+  rs2::depth_frame depth_frame = frameset.get_depth_frame();
+  if (!color_frame || !depth_frame) { return; }
+
+  std::unique_lock<std::mutex> lock(mutex_);
+  // a free slot, or else the frameset still waiting, which this newer one replaces
+  FrameSlot* slot = nullptr;
+  for (auto& candidate : slots_) {
+    if (candidate.state == SlotState::kFree) {
+      slot = &candidate;
+      break;
+    }
+  }
+  for (auto& candidate : slots_) {
+    if (slot) { break; }
+    if (candidate.state == SlotState::kReady) {
+      slot = &candidate;
+      dropped_framesets_++;
+    }
+  }
+  if (!slot) { return; }
+  slot->state = SlotState::kWriting;
+  lock.unlock();
+
+  copy_frame(color_frame, slot->color);
+  copy_frame(depth_frame, reinterpret_cast<uint8_t*>(slot->depth));
+
+  lock.lock();
+  for (auto& other : slots_) {
+    if (other.state == SlotState::kReady) {
+      other.state = SlotState::kFree;
+      dropped_framesets_++;
+    }
+  }
+  slot->state = SlotState::kReady;
+  lock.unlock();
+  frameset_ready_.notify_one();
 }
 
 void RealsenseCameraOp::compute(InputContext& op_input, OutputContext& op_output,
@@ -50,12 +172,40 @@ void RealsenseCameraOp::compute(InputContext& op_input, OutputContext& op_output
   auto allocator = nvidia::gxf::Handle<nvidia::gxf::Allocator>::Create(
       fragment()->executor().context(), allocator_->gxf_cid());
 
+  // The uploads and the depth alignment are queued on this stream and emitted with the frames
+  if (cuda_stream_handler_.from_messages(context.context(), {}) != GXF_SUCCESS) {
+    throw std::runtime_error("Failed to get the CUDA stream");
+  }
+  const cudaStream_t cuda_stream = cuda_stream_handler_.get_cuda_stream(context.context());
+
   // Wait for the next set of camera frames.
-  rs2::frameset frameset =
-      pipeline_.wait_for_frames().apply_filter(align_).apply_filter(units_transform_);
-  rs2::video_frame color_frame = frameset.get_color_frame();
-  rs2::video_frame depth_frame =
-      frameset.first(RS2_STREAM_DEPTH, RS2_FORMAT_DISTANCE).as<rs2::video_frame>();
+  FrameSlot* slot = nullptr;
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    // the buffers of finished uploads can be written again
+    for (auto& candidate : slots_) {
+      if (candidate.state == SlotState::kUploading &&
+          cudaEventQuery(candidate.uploaded) == cudaSuccess) {
+        candidate.state = SlotState::kFree;
+      }
+    }
+    auto ready = [this, &slot] {
+      for (auto& candidate : slots_) {
+        if (candidate.state == SlotState::kReady) {
+          slot = &candidate;
+          return true;
+        }
+      }
+      return false;
+    };
+    if (!frameset_ready_.wait_for(lock, kFramesetTimeout, ready)) {
+      throw std::runtime_error("Frames didn't arrive within 5000 ms");
+    }
+    slot->state = SlotState::kUploading;
+  }
+
+  const realsense::Intrinsics& color = align_params_.color;
+  const realsense::Intrinsics& depth = align_params_.depth;
 
   // Emit the color buffer.
   auto color_buffer_message = gxf::Entity::New(&context);
@@ -64,71 +214,81 @@ void RealsenseCameraOp::compute(InputContext& op_input, OutputContext& op_output
           .add<nvidia::gxf::VideoBuffer>()
           .value();
   color_buffer->resize<nvidia::gxf::VideoFormat::GXF_VIDEO_FORMAT_RGBA>(
-      color_frame.get_width(),
-      color_frame.get_height(),
+      color.width,
+      color.height,
       nvidia::gxf::SurfaceLayout::GXF_SURFACE_LAYOUT_PITCH_LINEAR,
       nvidia::gxf::MemoryStorageType::kDevice,
       allocator.value());
   nvidia::gxf::VideoBufferInfo color_buffer_info = color_buffer->video_frame_info();
-  assert(color_buffer_info.color_planes[0].stride == color_frame.get_stride_in_bytes());
-  assert(color_buffer_info.color_planes[0].bytes_per_pixel == color_frame.get_bytes_per_pixel());
-  cudaError_t cuda_error = cudaMemcpy(color_buffer->pointer(),
-                                      color_frame.get_data(),
-                                      color_frame.get_data_size(),
-                                      cudaMemcpyHostToDevice);
+  cudaError_t cuda_error = cudaMemcpy2DAsync(color_buffer->pointer(),
+                                             color_buffer_info.color_planes[0].stride,
+                                             slot->color,
+                                             color.width * kColorBytesPerPixel,
+                                             color.width * kColorBytesPerPixel,
+                                             color.height,
+                                             cudaMemcpyHostToDevice,
+                                             cuda_stream);
   if (cuda_error != cudaSuccess) {
-    throw std::runtime_error("cudaMemcpy() failed for color_frame");
+    throw std::runtime_error("cudaMemcpy2DAsync() failed for color_frame");
   }
-  op_output.emit(color_buffer_message, "color_buffer");
-
-  // Emit the color camera model.
-  // TODO: Add distortion models.
-  rs2_intrinsics color_intrinsics =
-      color_frame.get_profile().as<rs2::video_stream_profile>().get_intrinsics();
-  const nvidia::gxf::CameraModel color_camera_model{
-      .dimensions = {static_cast<uint32_t>(color_intrinsics.width),
-                     static_cast<uint32_t>(color_intrinsics.height)},
-      .focal_length = {color_intrinsics.fx, color_intrinsics.fy},
-      .principal_point = {color_intrinsics.ppx, color_intrinsics.ppy},
-      .distortion_type = nvidia::gxf::DistortionType::Perspective,
-  };
-  op_output.emit(color_camera_model, "color_camera_model");
 
-  // Emit the depth buffer.
+  // Align the depth buffer to the color image, in meters.
   auto depth_buffer_message = gxf::Entity::New(&context);
   nvidia::gxf::Handle<nvidia::gxf::VideoBuffer> depth_buffer =
       static_cast<nvidia::gxf::Entity>(depth_buffer_message)
           .add<nvidia::gxf::VideoBuffer>()
           .value();
   depth_buffer->resize<nvidia::gxf::VideoFormat::GXF_VIDEO_FORMAT_GRAY32F>(
-      depth_frame.get_width(),
-      depth_frame.get_height(),
+      color.width,
+      color.height,
       nvidia::gxf::SurfaceLayout::GXF_SURFACE_LAYOUT_PITCH_LINEAR,
       nvidia::gxf::MemoryStorageType::kDevice,
       allocator.value());
   nvidia::gxf::VideoBufferInfo depth_buffer_info = depth_buffer->video_frame_info();
-  assert(depth_buffer_info.color_planes[0].stride == depth_frame.get_stride_in_bytes());
-  assert(depth_buffer_info.color_planes[0].bytes_per_pixel == depth_frame.get_bytes_per_pixel());
-  cuda_error = cudaMemcpy(depth_buffer->pointer(),
-                          depth_frame.get_data(),
-                          depth_frame.get_data_size(),
-                          cudaMemcpyHostToDevice);
+  cuda_error = cudaMemcpyAsync(device_depth_,
+                               slot->depth,
+                               depth.width * depth.height * sizeof(uint16_t),
+                               cudaMemcpyHostToDevice,
+                               cuda_stream);
   if (cuda_error != cudaSuccess) {
-    throw std::runtime_error("cudaMemcpy() failed for depth_frame");
+    throw std::runtime_error("cudaMemcpyAsync() failed for depth_frame");
   }
-  op_output.emit(depth_buffer_message, "depth_buffer");
+  // the slot is free again once both uploads are done
+  cudaEventRecord(slot->uploaded, cuda_stream);
+  cuda_error =
+      realsense::cuda_align_depth_to_color(device_depth_,
+                                           depth.width * sizeof(uint16_t),
+                                           align_params_,
+                                           reinterpret_cast<float*>(depth_buffer->pointer()),
+                                           depth_buffer_info.color_planes[0].stride,
+                                           cuda_stream);
+  if (cuda_error != cudaSuccess) {
+    throw std::runtime_error("Failed to align the depth to the color image");
+  }
+
+  nvidia::gxf::Expected<nvidia::gxf::Entity> color_out_message(color_buffer_message);
+  nvidia::gxf::Expected<nvidia::gxf::Entity> depth_out_message(depth_buffer_message);
+  if (cuda_stream_handler_.to_message(color_out_message) != GXF_SUCCESS ||
+      cuda_stream_handler_.to_message(depth_out_message) != GXF_SUCCESS) {
+    throw std::runtime_error("Failed to add the CUDA stream to the output messages");
+  }
+  op_output.emit(color_buffer_message, "color_buffer");
 
-  // Emit the depth camera model.
+  // Emit the color camera model.
   // TODO: Add distortion models.
-  rs2_intrinsics depth_intrinsics =
-      depth_frame.get_profile().as<rs2::video_stream_profile>().get_intrinsics();
-  const nvidia::gxf::CameraModel depth_camera_model{
-      .dimensions = {static_cast<uint32_t>(depth_intrinsics.width),
-                     static_cast<uint32_t>(depth_intrinsics.height)},
-      .focal_length = {depth_intrinsics.fx, depth_intrinsics.fy},
-      .principal_point = {depth_intrinsics.ppx, depth_intrinsics.ppy},
+  const nvidia::gxf::CameraModel color_camera_model{
+      .dimensions = {color.width, color.height},
+      .focal_length = {color.fx, color.fy},
+      .principal_point = {color.ppx, color.ppy},
       .distortion_type = nvidia::gxf::DistortionType::Perspective,
   };
+  op_output.emit(color_camera_model, "color_camera_model");
+
+  op_output.emit(depth_buffer_message, "depth_buffer");
+
+  // Emit the depth camera model, which is the color one since the depth is aligned to it.
+  // TODO: Add distortion models.
+  const nvidia::gxf::CameraModel depth_camera_model = color_camera_model;
   op_output.emit(depth_camera_model, "depth_camera_model");
 }
 
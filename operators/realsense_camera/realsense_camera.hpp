@@ -18,14 +18,26 @@
 #ifndef HOLOSCAN_OPERATORS_REALSENSE_CAMERA
 #define HOLOSCAN_OPERATORS_REALSENSE_CAMERA
 
+#include <array>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+
 #include "holoscan/core/operator.hpp"
 #include "holoscan/holoscan.hpp"
+#include "holoscan/utils/cuda_stream_handler.hpp"
 #include "librealsense2/rs.hpp"
+#include "realsense_align.cuh"
 
 namespace holoscan::ops {
 
 /**
  * @brief Captures frames from an Intel RealSense camera.
+ *
+ * Framesets are received on the librealsense callback thread into pinned host buffers, and the
+ * operator uploads the newest one asynchronously on its CUDA stream. A frameset still waiting
+ * when a newer one arrives is dropped. The depth is aligned to the color image and converted to
+ * meters on the GPU, from the device intrinsics and extrinsics.
  */
 class RealsenseCameraOp : public Operator {
  public:
@@ -42,12 +54,32 @@ class RealsenseCameraOp : public Operator {
                ExecutionContext& context) override;
 
  private:
+  // One slot is uploading, one waits for the operator and one is written by the callback
+  static constexpr size_t kSlots = 3;
+  enum class SlotState { kFree, kWriting, kReady, kUploading };
+  struct FrameSlot {
+    uint8_t* color = nullptr;
+    uint16_t* depth = nullptr;
+    cudaEvent_t uploaded = nullptr;
+    SlotState state = SlotState::kFree;
+  };
+
+  /// Copy a frameset into a slot, on the librealsense callback thread
+  void on_frameset(const rs2::frameset& frameset);
+
   Parameter<std::shared_ptr<Allocator>> allocator_;
+  CudaStreamHandler cuda_stream_handler_;
 
-  rs2::align align_{RS2_STREAM_COLOR};
   rs2::pipeline pipeline_;
   rs2::pipeline_profile profile_;
-  rs2::units_transform units_transform_;
+
+  realsense::AlignParams align_params_{};
+  uint16_t* device_depth_ = nullptr;
+
+  std::mutex mutex_;
+  std::condition_variable frameset_ready_;
+  std::array<FrameSlot, kSlots> slots_;
+  uint64_t dropped_framesets_ = 0;
 };
 
 }  // namespace holoscan::ops
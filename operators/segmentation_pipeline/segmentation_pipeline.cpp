@@ -0,0 +1,392 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "segmentation_pipeline.hpp"
+
+#include <gxf/multimedia/video.hpp>
+
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace holoscan::ops {
+
+namespace {
+
+// Height, width and channels of a binding of layout `layout` with an optional batch of 1
+bool binding_size(const nvinfer1::Dims& dims, const std::string& layout, int* height, int* width,
+                  int* channels) {
+  int first = 0;
+  if (dims.nbDims == 4) {
+    if (dims.d[0] != 1 && dims.d[0] != -1) { return false; }
+    first = 1;
+  } else if (dims.nbDims != 3) {
+    return false;
+  }
+  const bool planar = layout == "nchw";
+  *channels = planar ? dims.d[first] : dims.d[first + 2];
+  *height = planar ? dims.d[first + 1] : dims.d[first];
+  *width = planar ? dims.d[first + 2] : dims.d[first + 1];
+  return *channels > 0 && *height > 0 && *width > 0;
+}
+
+}  // namespace
+
+void SegmentationPipelineOp::setup(OperatorSpec& spec) {
+  spec.param(model_path_, "model_path", "ModelPath", "Path of the ONNX model.");
+  spec.param(engine_cache_dir_,
+             "engine_cache_dir",
+             "EngineCacheDir",
+             "Directory of the TensorRT engines built from the model.");
+  spec.param(enable_fp16_, "enable_fp16", "EnableFP16", "Build the engine with FP16.", false);
+  spec.param(force_engine_update_,
+             "force_engine_update",
+             "ForceEngineUpdate",
+             "Build the engine even if it is cached.",
+             false);
+  spec.param(input_layout_,
+             "input_layout",
+             "InputLayout",
+             "Layout of the input binding, nhwc or nchw.",
+             std::string("nhwc"));
+  spec.param(output_layout_,
+             "output_layout",
+             "OutputLayout",
+             "Layout of the output binding, nhwc or nchw.",
+             std::string("nchw"));
+  spec.param(scale_min_,
+             "scale_min",
+             "Scale min",
+             "Value of the input binding for a source value of 0.",
+             0.f);
+  spec.param(scale_max_,
+             "scale_max",
+             "Scale max",
+             "Value of the input binding for a source value of 255.",
+             1.f);
+  spec.param(threshold_,
+             "threshold",
+             "Threshold",
+             "Score above which a pixel is of class 1 when the network has one output channel.",
+             0.5f);
+  spec.param(color_lut_,
+             "color_lut",
+             "ColorLUT",
+             "RGBA colors (0 to 1) of the classes. When set, the output is the RGBA8888 color of "
+             "the class of each pixel instead of the uint8 class.",
+             std::vector<std::vector<float>>{});
+  spec.param(out_tensor_name_,
+             "out_tensor_name",
+             "OutputTensorName",
+             "Name of the output tensor.",
+             std::string("out_tensor"));
+  spec.param(use_cuda_graph_,
+             "use_cuda_graph",
+             "UseCudaGraph",
+             "Capture the preprocessing, the inference and the postprocessing in a CUDA graph.",
+             true);
+  spec.param(allocator_, "allocator", "Allocator", "Allocator of the output tensor.");
+
+  spec.input<holoscan::gxf::Entity>("source_video");
+  spec.output<holoscan::gxf::Entity>("out_tensor");
+
+  cuda_stream_handler_.define_params(spec);
+}
+
+void SegmentationPipelineOp::load_engine() {
+  const std::vector<char> plan = trt_engine::load_or_build_engine(logger_,
+                                                                 engine_cache_dir_.get(),
+                                                                 model_path_.get(),
+                                                                 1,
+                                                                 enable_fp16_.get(),
+                                                                 force_engine_update_.get());
+
+  runtime_.reset(nvinfer1::createInferRuntime(logger_));
+  engine_.reset(runtime_->deserializeCudaEngine(plan.data(), plan.size()));
+  if (!engine_) {
+    throw std::runtime_error(fmt::format("Failed to load the engine of {}", model_path_.get()));
+  }
+  execution_context_.reset(engine_->createExecutionContext());
+  if (!execution_context_) { throw std::runtime_error("Failed to create the execution context"); }
+}
+
+void SegmentationPipelineOp::start() {
+  for (const auto* layout : {&input_layout_.get(), &output_layout_.get()}) {
+    if (*layout != "nhwc" && *layout != "nchw") {
+      throw std::runtime_error(fmt::format("Unsupported layout {}", *layout));
+    }
+  }
+  for (const auto& color : color_lut_.get()) {
+    if (color.size() != 4) { throw std::runtime_error("The color_lut colors must be RGBA"); }
+  }
+
+  load_engine();
+
+  const char* input_name = nullptr;
+  const char* output_name = nullptr;
+  for (int i = 0; i < engine_->getNbIOTensors(); ++i) {
+    const char* name = engine_->getIOTensorName(i);
+    if (engine_->getTensorIOMode(name) == nvinfer1::TensorIOMode::kINPUT) {
+      if (input_name) { throw std::runtime_error("The network must have a single input"); }
+      input_name = name;
+    } else {
+      if (output_name) { throw std::runtime_error("The network must have a single output"); }
+      output_name = name;
+    }
+  }
+  if (!input_name || !output_name) {
+    throw std::runtime_error("The network must have an input and an output");
+  }
+  if (engine_->getTensorDataType(input_name) != nvinfer1::DataType::kFLOAT ||
+      engine_->getTensorDataType(output_name) != nvinfer1::DataType::kFLOAT) {
+    throw std::runtime_error("The network input and output must be float32");
+  }
+
+  nvinfer1::Dims input_dims = engine_->getTensorShape(input_name);
+  int input_channels = 0;
+  if (!binding_size(
+          input_dims, input_layout_.get(), &input_height_, &input_width_, &input_channels) ||
+      input_channels != 3) {
+    throw std::runtime_error(fmt::format(
+        "The network input {} must be an {} RGB image", input_name, input_layout_.get()));
+  }
+  if (input_dims.d[0] == -1) {
+    input_dims.d[0] = 1;
+    execution_context_->setInputShape(input_name, input_dims);
+  }
+  const nvinfer1::Dims output_dims = execution_context_->getTensorShape(output_name);
+  if (!binding_size(output_dims,
+                    output_layout_.get(),
+                    &output_height_,
+                    &output_width_,
+                    &output_channels_)) {
+    throw std::runtime_error(fmt::format(
+        "The network output {} must be an {} score map", output_name, output_layout_.get()));
+  }
+
+  const size_t input_size = static_cast<size_t>(input_width_) * input_height_ * 3;
+  const size_t output_size = static_cast<size_t>(output_width_) * output_height_ * output_channels_;
+  if (cudaMalloc(&input_binding_, input_size * sizeof(float)) != cudaSuccess ||
+      cudaMalloc(&output_binding_, output_size * sizeof(float)) != cudaSuccess) {
+    throw std::runtime_error("Failed to allocate the network bindings");
+  }
+  execution_context_->setTensorAddress(input_name, input_binding_);
+  execution_context_->setTensorAddress(output_name, output_binding_);
+
+  if (!color_lut_.get().empty()) {
+    std::vector<uchar4> lut;
+    for (const auto& color : color_lut_.get()) {
+      auto to_u8 = [](float value) {
+        return static_cast<unsigned char>(std::clamp(value, 0.f, 1.f) * 255.f + 0.5f);
+      };
+      lut.push_back(
+          make_uchar4(to_u8(color[0]), to_u8(color[1]), to_u8(color[2]), to_u8(color[3])));
+    }
+    if (cudaMalloc(&device_lut_, lut.size() * sizeof(uchar4)) != cudaSuccess ||
+        cudaMemcpy(device_lut_, lut.data(), lut.size() * sizeof(uchar4), cudaMemcpyHostToDevice) !=
+            cudaSuccess) {
+      throw std::runtime_error("Failed to upload the color_lut");
+    }
+  }
+
+  warmed_up_ = false;
+  graph_failed_ = false;
+}
+
+void SegmentationPipelineOp::destroy_graph() {
+  if (graph_exec_) { cudaGraphExecDestroy(graph_exec_); }
+  if (graph_) { cudaGraphDestroy(graph_); }
+  graph_exec_ = nullptr;
+  graph_ = nullptr;
+  preprocess_node_ = nullptr;
+  postprocess_node_ = nullptr;
+}
+
+void SegmentationPipelineOp::stop() {
+  cudaDeviceSynchronize();
+  destroy_graph();
+  execution_context_.reset();
+  engine_.reset();
+  runtime_.reset();
+  cudaFree(input_binding_);
+  cudaFree(output_binding_);
+  cudaFree(device_lut_);
+  input_binding_ = nullptr;
+  output_binding_ = nullptr;
+  device_lut_ = nullptr;
+}
+
+void SegmentationPipelineOp::run(const SegmentationPreprocessArgs& preprocess_args,
+                                 const SegmentationPostprocessArgs& postprocess_args,
+                                 cudaStream_t stream) {
+  cudaError_t cuda_status = segmentation_preprocess(preprocess_args, stream);
+  if (cuda_status != cudaSuccess) {
+    throw std::runtime_error(
+        fmt::format("Preprocessing failed with error {}", cudaGetErrorString(cuda_status)));
+  }
+  if (!execution_context_->enqueueV3(stream)) {
+    throw std::runtime_error("Failed to enqueue the inference");
+  }
+  cuda_status = segmentation_postprocess(postprocess_args, stream);
+  if (cuda_status != cudaSuccess) {
+    throw std::runtime_error(
+        fmt::format("Postprocessing failed with error {}", cudaGetErrorString(cuda_status)));
+  }
+}
+
+bool SegmentationPipelineOp::capture(const SegmentationPreprocessArgs& preprocess_args,
+                                     const SegmentationPostprocessArgs& postprocess_args,
+                                     cudaStream_t stream) {
+  if (cudaStreamBeginCapture(stream, cudaStreamCaptureModeThreadLocal) != cudaSuccess) {
+    return false;
+  }
+  bool launched = segmentation_preprocess(preprocess_args, stream) == cudaSuccess &&
+                  execution_context_->enqueueV3(stream) &&
+                  segmentation_postprocess(postprocess_args, stream) == cudaSuccess;
+  // the capture must be ended even when a launch failed
+  launched = cudaStreamEndCapture(stream, &graph_) == cudaSuccess && launched;
+  if (!launched || cudaGraphInstantiate(&graph_exec_, graph_, 0) != cudaSuccess ||
+      !find_segmentation_nodes(graph_, &preprocess_node_, &postprocess_node_)) {
+    cudaGetLastError();
+    destroy_graph();
+    return false;
+  }
+  return true;
+}
+
+void SegmentationPipelineOp::compute(InputContext& op_input, OutputContext& op_output,
+                                     ExecutionContext& context) {
+  auto maybe_entity = op_input.receive<holoscan::gxf::Entity>("source_video");
+  if (!maybe_entity) { throw std::runtime_error("Failed to receive input"); }
+
+  auto& entity = static_cast<nvidia::gxf::Entity&>(maybe_entity.value());
+
+  // get the CUDA stream from the input message
+  gxf_result_t stream_handler_result = cuda_stream_handler_.from_message(context.context(), entity);
+  if (stream_handler_result != GXF_SUCCESS) {
+    throw std::runtime_error("Failed to get the CUDA stream from incoming messages");
+  }
+  const cudaStream_t stream = cuda_stream_handler_.get_cuda_stream(context.context());
+
+  SegmentationPreprocessArgs preprocess_args{};
+  nvidia::gxf::MemoryStorageType storage_type = nvidia::gxf::MemoryStorageType::kDevice;
+
+  const auto maybe_video_buffer = entity.get<nvidia::gxf::VideoBuffer>();
+  if (maybe_video_buffer) {
+    const auto video_buffer = maybe_video_buffer.value();
+    const auto& info = video_buffer->video_frame_info();
+    if (info.color_format == nvidia::gxf::VideoFormat::GXF_VIDEO_FORMAT_RGBA) {
+      preprocess_args.src_channels = 4;
+    } else if (info.color_format == nvidia::gxf::VideoFormat::GXF_VIDEO_FORMAT_RGB) {
+      preprocess_args.src_channels = 3;
+    } else {
+      throw std::runtime_error("Input VideoBuffer must be of format RGBA or RGB");
+    }
+    preprocess_args.src_width = static_cast<int>(info.width);
+    preprocess_args.src_height = static_cast<int>(info.height);
+    preprocess_args.src_pitch = static_cast<int>(info.color_planes[0].stride);
+    preprocess_args.src = video_buffer->pointer();
+    storage_type = video_buffer->storage_type();
+  } else {
+    const auto maybe_tensor = entity.get<nvidia::gxf::Tensor>();
+    if (!maybe_tensor) {
+      throw std::runtime_error("Neither VideoBuffer not Tensor found in message");
+    }
+    const auto tensor = maybe_tensor.value();
+    if ((tensor->rank() != 3) ||
+        (tensor->shape().dimension(2) != 3 && tensor->shape().dimension(2) != 4) ||
+        (tensor->element_type() != nvidia::gxf::PrimitiveType::kUnsigned8)) {
+      throw std::runtime_error("Tensor must be of rank 3 and have 3 or 4 uint8 components");
+    }
+    preprocess_args.src_width = tensor->shape().dimension(1);
+    preprocess_args.src_height = tensor->shape().dimension(0);
+    preprocess_args.src_channels = tensor->shape().dimension(2);
+    preprocess_args.src_pitch = static_cast<int>(tensor->stride(0));
+    preprocess_args.src = tensor->pointer();
+    storage_type = tensor->storage_type();
+  }
+  if (storage_type != nvidia::gxf::MemoryStorageType::kDevice) {
+    throw std::runtime_error("The input must be in device memory");
+  }
+  preprocess_args.dst = input_binding_;
+  preprocess_args.dst_width = input_width_;
+  preprocess_args.dst_height = input_height_;
+  preprocess_args.dst_planar = input_layout_.get() == "nchw";
+  preprocess_args.scale = (scale_max_.get() - scale_min_.get()) / 255.f;
+  preprocess_args.offset = scale_min_.get();
+
+  // the classes, or their colors, at the resolution of the network output
+  const int out_channels = device_lut_ ? 4 : 1;
+  const nvidia::gxf::Shape shape{output_height_, output_width_, out_channels};
+  auto allocator = nvidia::gxf::Handle<nvidia::gxf::Allocator>::Create(
+      fragment()->executor().context(), allocator_->gxf_cid());
+  auto out_message = CreateTensorMap(
+      context.context(),
+      allocator.value(),
+      {{out_tensor_name_.get(),
+        nvidia::gxf::MemoryStorageType::kDevice,
+        shape,
+        nvidia::gxf::PrimitiveType::kUnsigned8,
+        0,
+        nvidia::gxf::ComputeTrivialStrides(shape, sizeof(uint8_t))}},
+      false);
+  if (!out_message) { throw std::runtime_error("Failed to create the output message"); }
+  const auto out_tensor = out_message.value().get<nvidia::gxf::Tensor>();
+  if (!out_tensor || !out_tensor.value()->pointer()) {
+    throw std::runtime_error("Failed to allocate the output tensor");
+  }
+
+  SegmentationPostprocessArgs postprocess_args{};
+  postprocess_args.src = output_binding_;
+  postprocess_args.width = output_width_;
+  postprocess_args.height = output_height_;
+  postprocess_args.channels = output_channels_;
+  postprocess_args.src_planar = output_layout_.get() == "nchw";
+  postprocess_args.threshold = threshold_.get();
+  postprocess_args.lut = device_lut_;
+  postprocess_args.lut_size = static_cast<int>(color_lut_.get().size());
+  postprocess_args.dst = out_tensor.value()->pointer();
+
+  if (!graph_exec_ && use_cuda_graph_.get() && warmed_up_ && !graph_failed_ &&
+      !capture(preprocess_args, postprocess_args, stream)) {
+    HOLOSCAN_LOG_WARN("Failed to capture the segmentation pipeline, launching it directly");
+    graph_failed_ = true;
+  }
+
+  if (graph_exec_) {
+    cudaError_t cuda_status = update_segmentation_nodes(
+        graph_exec_, preprocess_node_, preprocess_args, postprocess_node_, postprocess_args);
+    if (cuda_status == cudaSuccess) { cuda_status = cudaGraphLaunch(graph_exec_, stream); }
+    if (cuda_status != cudaSuccess) {
+      throw std::runtime_error(fmt::format("Failed to launch the segmentation graph with error {}",
+                                           cudaGetErrorString(cuda_status)));
+    }
+  } else {
+    run(preprocess_args, postprocess_args, stream);
+    warmed_up_ = true;
+  }
+
+  // pass the CUDA stream to the output message
+  stream_handler_result = cuda_stream_handler_.to_message(out_message);
+  if (stream_handler_result != GXF_SUCCESS) {
+    throw std::runtime_error("Failed to add the CUDA stream to the outgoing messages");
+  }
+  auto result = gxf::Entity(std::move(out_message.value()));
+  op_output.emit(result, "out_tensor");
+}
+
+}  // namespace holoscan::ops
@@ -0,0 +1,113 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef OPERATORS_SEGMENTATION_PIPELINE_SEGMENTATION_PIPELINE
+#define OPERATORS_SEGMENTATION_PIPELINE_SEGMENTATION_PIPELINE
+
+#include <NvInfer.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <holoscan/core/resources/gxf/allocator.hpp>
+#include <holoscan/holoscan.hpp>
+#include <holoscan/utils/cuda_stream_handler.hpp>
+
+#include "../tensorrt_engine_util.hpp"
+#include "segmentation_pipeline_kernels.hpp"
+
+namespace holoscan::ops {
+
+/**
+ * @brief Runs the preprocessing, the TensorRT inference and the postprocessing of a
+ * segmentation network on one CUDA stream
+ *
+ * Replaces the FormatConverterOp, InferenceOp and SegmentationPostprocessorOp chain: the source
+ * frame is resized and scaled directly into the input binding of the engine, and the output
+ * binding reduced to a class per pixel by a second kernel, without intermediate messages and
+ * allocations. After a first frame, the two kernels and the inference are captured in a CUDA
+ * graph, which is replayed for the following frames with the source and the output pointers
+ * updated.
+ *
+ * The engine is built from the ONNX model on the first run and cached in `engine_cache_dir`.
+ * The network has one float32 RGB input and one float32 output of one score per class, with an
+ * optional batch dimension of 1.
+ */
+class SegmentationPipelineOp : public Operator {
+ public:
+  HOLOSCAN_OPERATOR_FORWARD_ARGS(SegmentationPipelineOp);
+
+  void setup(OperatorSpec& spec) override;
+  void start() override;
+  void compute(InputContext&, OutputContext& op_output, ExecutionContext&) override;
+  void stop() override;
+
+ private:
+  template <typename T>
+  using NvInferHandle = trt_engine::NvInferHandle<T>;
+
+  void load_engine();
+  void run(const SegmentationPreprocessArgs& preprocess_args,
+           const SegmentationPostprocessArgs& postprocess_args, cudaStream_t stream);
+  bool capture(const SegmentationPreprocessArgs& preprocess_args,
+               const SegmentationPostprocessArgs& postprocess_args, cudaStream_t stream);
+  void destroy_graph();
+
+  Parameter<std::string> model_path_;
+  Parameter<std::string> engine_cache_dir_;
+  Parameter<bool> enable_fp16_;
+  Parameter<bool> force_engine_update_;
+  Parameter<std::string> input_layout_;
+  Parameter<std::string> output_layout_;
+  Parameter<float> scale_min_;
+  Parameter<float> scale_max_;
+  Parameter<float> threshold_;
+  Parameter<std::vector<std::vector<float>>> color_lut_;
+  Parameter<std::string> out_tensor_name_;
+  Parameter<bool> use_cuda_graph_;
+  Parameter<std::shared_ptr<Allocator>> allocator_;
+
+  trt_engine::Logger logger_;
+  NvInferHandle<nvinfer1::IRuntime> runtime_;
+  NvInferHandle<nvinfer1::ICudaEngine> engine_;
+  NvInferHandle<nvinfer1::IExecutionContext> execution_context_;
+
+  // Network bindings, kept from frame to frame so that the captured graph stays valid
+  float* input_binding_ = nullptr;
+  float* output_binding_ = nullptr;
+  int input_width_ = 0;
+  int input_height_ = 0;
+  int output_width_ = 0;
+  int output_height_ = 0;
+  int output_channels_ = 0;
+  uchar4* device_lut_ = nullptr;
+
+  // TensorRT needs one enqueue outside of a capture
+  bool warmed_up_ = false;
+  bool graph_failed_ = false;
+  cudaGraphExec_t graph_exec_ = nullptr;
+  cudaGraphNode_t preprocess_node_ = nullptr;
+  cudaGraphNode_t postprocess_node_ = nullptr;
+  cudaGraph_t graph_ = nullptr;
+
+  CudaStreamHandler cuda_stream_handler_;
+};
+
+}  // namespace holoscan::ops
+
+#endif /* OPERATORS_SEGMENTATION_PIPELINE_SEGMENTATION_PIPELINE */
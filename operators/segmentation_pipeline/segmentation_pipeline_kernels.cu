@@ -0,0 +1,160 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "segmentation_pipeline_kernels.hpp"
+
+#include <vector>
+
+namespace holoscan::ops {
+
+namespace {
+
+constexpr unsigned kBlockWidth = 32;
+constexpr unsigned kBlockHeight = 8;
+
+dim3 grid_for(int width, int height) {
+  return dim3((width + kBlockWidth - 1) / kBlockWidth, (height + kBlockHeight - 1) / kBlockHeight);
+}
+
+// One thread per pixel of the network input, with half pixel centers as the NPP linear resize
+__global__ void preprocess_kernel(SegmentationPreprocessArgs args) {
+  const int x = blockIdx.x * blockDim.x + threadIdx.x;
+  const int y = blockIdx.y * blockDim.y + threadIdx.y;
+  if (x >= args.dst_width || y >= args.dst_height) { return; }
+
+  const float sx = fminf(fmaxf((x + 0.5f) * args.src_width / args.dst_width - 0.5f, 0.f),
+                         static_cast<float>(args.src_width - 1));
+  const float sy = fminf(fmaxf((y + 0.5f) * args.src_height / args.dst_height - 0.5f, 0.f),
+                         static_cast<float>(args.src_height - 1));
+  const int x0 = static_cast<int>(sx);
+  const int y0 = static_cast<int>(sy);
+  const int x1 = min(x0 + 1, args.src_width - 1);
+  const int y1 = min(y0 + 1, args.src_height - 1);
+  const float fx = sx - x0;
+  const float fy = sy - y0;
+
+  const uint8_t* row0 = args.src + static_cast<size_t>(y0) * args.src_pitch;
+  const uint8_t* row1 = args.src + static_cast<size_t>(y1) * args.src_pitch;
+  const int c0 = x0 * args.src_channels;
+  const int c1 = x1 * args.src_channels;
+  const size_t plane = static_cast<size_t>(args.dst_width) * args.dst_height;
+  const size_t pixel = static_cast<size_t>(y) * args.dst_width + x;
+  for (int c = 0; c < 3; ++c) {
+    const float top = row0[c0 + c] + fx * (row0[c1 + c] - row0[c0 + c]);
+    const float bottom = row1[c0 + c] + fx * (row1[c1 + c] - row1[c0 + c]);
+    const float value = (top + fy * (bottom - top)) * args.scale + args.offset;
+    args.dst[args.dst_planar ? c * plane + pixel : pixel * 3 + c] = value;
+  }
+}
+
+// One thread per pixel of the network output
+__global__ void postprocess_kernel(SegmentationPostprocessArgs args) {
+  const int x = blockIdx.x * blockDim.x + threadIdx.x;
+  const int y = blockIdx.y * blockDim.y + threadIdx.y;
+  if (x >= args.width || y >= args.height) { return; }
+
+  const size_t plane = static_cast<size_t>(args.width) * args.height;
+  const size_t pixel = static_cast<size_t>(y) * args.width + x;
+  int label = 0;
+  if (args.channels == 1) {
+    label = args.src[pixel] > args.threshold ? 1 : 0;
+  } else {
+    float best = args.src[args.src_planar ? pixel : pixel * args.channels];
+    for (int c = 1; c < args.channels; ++c) {
+      const float score =
+          args.src[args.src_planar ? c * plane + pixel : pixel * args.channels + c];
+      if (score > best) {
+        best = score;
+        label = c;
+      }
+    }
+  }
+
+  if (args.lut) {
+    const uchar4 color = args.lut[min(label, args.lut_size - 1)];
+    reinterpret_cast<uchar4*>(args.dst)[pixel] = color;
+  } else {
+    args.dst[pixel] = static_cast<uint8_t>(label);
+  }
+}
+
+cudaError_t update_node(cudaGraphExec_t exec, cudaGraphNode_t node, void* args) {
+  cudaKernelNodeParams params;
+  cudaError_t status = cudaGraphKernelNodeGetParams(node, &params);
+  if (status != cudaSuccess) { return status; }
+  void* kernel_params[] = {args};
+  params.kernelParams = kernel_params;
+  params.extra = nullptr;
+  return cudaGraphExecKernelNodeSetParams(exec, node, &params);
+}
+
+}  // namespace
+
+cudaError_t segmentation_preprocess(const SegmentationPreprocessArgs& args, cudaStream_t stream) {
+  preprocess_kernel<<<grid_for(args.dst_width, args.dst_height),
+                      dim3(kBlockWidth, kBlockHeight),
+                      0,
+                      stream>>>(args);
+  return cudaGetLastError();
+}
+
+cudaError_t segmentation_postprocess(const SegmentationPostprocessArgs& args,
+                                     cudaStream_t stream) {
+  postprocess_kernel<<<grid_for(args.width, args.height),
+                       dim3(kBlockWidth, kBlockHeight),
+                       0,
+                       stream>>>(args);
+  return cudaGetLastError();
+}
+
+bool find_segmentation_nodes(cudaGraph_t graph, cudaGraphNode_t* preprocess,
+                             cudaGraphNode_t* postprocess) {
+  size_t num_nodes = 0;
+  if (cudaGraphGetNodes(graph, nullptr, &num_nodes) != cudaSuccess) { return false; }
+  std::vector<cudaGraphNode_t> nodes(num_nodes);
+  if (cudaGraphGetNodes(graph, nodes.data(), &num_nodes) != cudaSuccess) { return false; }
+
+  *preprocess = nullptr;
+  *postprocess = nullptr;
+  for (cudaGraphNode_t node : nodes) {
+    cudaGraphNodeType type;
+    if (cudaGraphNodeGetType(node, &type) != cudaSuccess || type != cudaGraphNodeTypeKernel) {
+      continue;
+    }
+    cudaKernelNodeParams params;
+    if (cudaGraphKernelNodeGetParams(node, &params) != cudaSuccess) { continue; }
+    if (params.func == reinterpret_cast<void*>(preprocess_kernel)) {
+      *preprocess = node;
+    } else if (params.func == reinterpret_cast<void*>(postprocess_kernel)) {
+      *postprocess = node;
+    }
+  }
+  return *preprocess && *postprocess;
+}
+
+cudaError_t update_segmentation_nodes(cudaGraphExec_t exec, cudaGraphNode_t preprocess,
+                                      const SegmentationPreprocessArgs& preprocess_args,
+                                      cudaGraphNode_t postprocess,
+                                      const SegmentationPostprocessArgs& postprocess_args) {
+  SegmentationPreprocessArgs pre = preprocess_args;
+  SegmentationPostprocessArgs post = postprocess_args;
+  cudaError_t status = update_node(exec, preprocess, &pre);
+  if (status != cudaSuccess) { return status; }
+  return update_node(exec, postprocess, &post);
+}
+
+}  // namespace holoscan::ops
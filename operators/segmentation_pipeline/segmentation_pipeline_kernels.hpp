@@ -0,0 +1,97 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef OPERATORS_SEGMENTATION_PIPELINE_SEGMENTATION_PIPELINE_KERNELS
+#define OPERATORS_SEGMENTATION_PIPELINE_SEGMENTATION_PIPELINE_KERNELS
+
+#include <cstdint>
+
+#include <cuda_runtime.h>
+
+namespace holoscan::ops {
+
+/**
+ * @brief Arguments of the preprocessing kernel
+ *
+ * Resizes an RGB or RGBA uint8 image with bilinear interpolation, drops the alpha channel and
+ * writes value * scale + offset in the float32 input binding of the network.
+ */
+struct SegmentationPreprocessArgs {
+  const uint8_t* src;
+  int src_pitch;
+  int src_channels;
+  int src_width;
+  int src_height;
+  float* dst;
+  int dst_width;
+  int dst_height;
+  // NCHW instead of NHWC
+  bool dst_planar;
+  float scale;
+  float offset;
+};
+
+/**
+ * @brief Arguments of the postprocessing kernel
+ *
+ * Writes the class of each pixel of the float32 output binding of the network, with
+ * `channels` scores per pixel: the channel with the highest score, or with one channel, 1 when
+ * the score is above `threshold`. With a `lut` of `lut_size` RGBA colors the output is the color
+ * of the class, else its index.
+ */
+struct SegmentationPostprocessArgs {
+  const float* src;
+  int width;
+  int height;
+  int channels;
+  // NCHW instead of NHWC
+  bool src_planar;
+  float threshold;
+  const uchar4* lut;
+  int lut_size;
+  uint8_t* dst;
+};
+
+/// @brief Launches the preprocessing kernel, returns the launch error, if any
+cudaError_t segmentation_preprocess(const SegmentationPreprocessArgs& args, cudaStream_t stream);
+
+/// @brief Launches the postprocessing kernel, returns the launch error, if any
+cudaError_t segmentation_postprocess(const SegmentationPostprocessArgs& args,
+                                     cudaStream_t stream);
+
+/**
+ * @brief Kernel nodes of a captured segmentation_preprocess() and segmentation_postprocess()
+ *
+ * @return false when the graph does not have one node of each kernel
+ */
+bool find_segmentation_nodes(cudaGraph_t graph, cudaGraphNode_t* preprocess,
+                             cudaGraphNode_t* postprocess);
+
+/**
+ * @brief Updates the arguments of the kernel nodes of an instantiated graph
+ *
+ * The launch configuration of the nodes is kept, only the pointers and the source size may
+ * change.
+ */
+cudaError_t update_segmentation_nodes(cudaGraphExec_t exec, cudaGraphNode_t preprocess,
+                                      const SegmentationPreprocessArgs& preprocess_args,
+                                      cudaGraphNode_t postprocess,
+                                      const SegmentationPostprocessArgs& postprocess_args);
+
+}  // namespace holoscan::ops
+
+#endif /* OPERATORS_SEGMENTATION_PIPELINE_SEGMENTATION_PIPELINE_KERNELS */
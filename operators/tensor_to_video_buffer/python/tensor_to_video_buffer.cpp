@@ -61,10 +61,19 @@ class PyTensorToVideoBufferOp : public TensorToVideoBufferOp {
   PyTensorToVideoBufferOp(Fragment* fragment, const py::args& args,
                           const std::string& video_format,
                           const std::string& in_tensor_name = std::string(),
+                          bool convert = false, const std::string& color_space = "bt601"s,
+                          uint32_t pitch_alignment = 256,
+                          std::shared_ptr<Allocator> allocator = nullptr,
+                          std::shared_ptr<holoscan::CudaStreamPool> cuda_stream_pool = nullptr,
                           const std::string& name = "tensor_to_video_buffer")
-      : TensorToVideoBufferOp(
-            ArgList{Arg{"in_tensor_name", in_tensor_name}, Arg{"video_format", video_format}}) {
+      : TensorToVideoBufferOp(ArgList{Arg{"in_tensor_name", in_tensor_name},
+                                      Arg{"video_format", video_format},
+                                      Arg{"convert", convert},
+                                      Arg{"color_space", color_space},
+                                      Arg{"pitch_alignment", pitch_alignment}}) {
     add_positional_condition_and_resource_args(this, args);
+    if (allocator) { this->add_arg(Arg{"allocator", allocator}); }
+    if (cuda_stream_pool) { this->add_arg(Arg{"cuda_stream_pool", cuda_stream_pool}); }
     name_ = name;
     fragment_ = fragment;
     spec_ = std::make_shared<OperatorSpec>(fragment);
@@ -87,10 +96,20 @@ PYBIND11_MODULE(_tensor_to_video_buffer, m) {
                     const py::args&,
                     const std::string&,
                     const std::string&,
+                    bool,
+                    const std::string&,
+                    uint32_t,
+                    std::shared_ptr<Allocator>,
+                    std::shared_ptr<holoscan::CudaStreamPool>,
                     const std::string&>(),
            "fragment"_a,
            "video_format"_a,
            "in_tensor_name"_a = std::string(),
+           "convert"_a = false,
+           "color_space"_a = "bt601"s,
+           "pitch_alignment"_a = 256,
+           "allocator"_a = py::none(),
+           "cuda_stream_pool"_a = py::none(),
            "name"_a = "tensor_to_video_buffer"s,
            doc::TensorToVideoBufferOp::doc_TensorToVideoBufferOp);
 }  // PYBIND11_MODULE NOLINT
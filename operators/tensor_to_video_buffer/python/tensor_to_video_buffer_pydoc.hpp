@@ -44,8 +44,21 @@ fragment : Fragment
     The fragment that the operator belongs to.
 in_tensor_name: str
     Input tensor name.
-video_format_: str
-    Video format.
+video_format: str
+    Video format: ``"rgb"`` or ``"yuv420"`` when wrapping, ``"yuv420"``, ``"nv12"`` or ``"p010"``
+    when converting.
+convert : bool, optional
+    Convert an RGB or RGBA tensor to ``video_format`` on the GPU instead of wrapping it.
+    Default value is ``False``.
+color_space : str, optional
+    Color matrix of the conversion, ``"bt601"`` or ``"bt709"``. Default value is ``"bt601"``.
+pitch_alignment : int, optional
+    Alignment in bytes of the plane pitches of converted video buffers. Default value is
+    ``256``.
+allocator : holoscan.resources.Allocator, optional
+    Allocator of the converted video buffers, required with ``convert``.
+cuda_stream_pool : holoscan.resources.CudaStreamPool, optional
+    Pool to allocate the conversion stream from when the input has none.
 name : str, optional
     The name of the operator.
 
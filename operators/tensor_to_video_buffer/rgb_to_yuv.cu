@@ -0,0 +1,124 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "rgb_to_yuv.cuh"
+
+namespace holoscan::ops {
+
+namespace {
+
+constexpr unsigned kBlockWidth = 32;
+constexpr unsigned kBlockHeight = 8;
+
+// Video range coefficients for 8-bit samples, scaled by 4 for 10-bit ones
+struct Coefficients {
+  float3 y, u, v;
+};
+
+__constant__ Coefficients kCoefficients[2] = {
+    // BT.601
+    {{0.257f, 0.504f, 0.098f}, {-0.148f, -0.291f, 0.439f}, {0.439f, -0.368f, -0.071f}},
+    // BT.709
+    {{0.183f, 0.614f, 0.062f}, {-0.101f, -0.339f, 0.439f}, {0.439f, -0.399f, -0.040f}},
+};
+
+__device__ inline float dot(const float3& c, const float3& rgb) {
+  return c.x * rgb.x + c.y * rgb.y + c.z * rgb.z;
+}
+
+template <typename T>
+__device__ inline T to_sample(float value);
+
+template <>
+__device__ inline uint8_t to_sample<uint8_t>(float value) {
+  return static_cast<uint8_t>(fminf(fmaxf(value + 0.5f, 0.f), 255.f));
+}
+
+// P010 keeps the 10-bit sample in the upper bits
+template <>
+__device__ inline uint16_t to_sample<uint16_t>(float value) {
+  return static_cast<uint16_t>(fminf(fmaxf(4.f * value + 0.5f, 0.f), 1023.f)) << 6;
+}
+
+template <typename T>
+__device__ inline T* row(void* plane, int pitch, int y) {
+  return reinterpret_cast<T*>(static_cast<uint8_t*>(plane) + static_cast<size_t>(y) * pitch);
+}
+
+// One thread per 2x2 block, which shares one chroma sample
+template <typename T, bool kPlanar>
+__global__ void rgb_to_yuv420_kernel(const uint8_t* src, int src_pitch, int channels, int width,
+                                     int height, int matrix, YuvPlanes dst) {
+  const int cx = blockIdx.x * blockDim.x + threadIdx.x;
+  const int cy = blockIdx.y * blockDim.y + threadIdx.y;
+  if (2 * cx >= width || 2 * cy >= height) { return; }
+
+  const Coefficients& c = kCoefficients[matrix];
+  float3 sum = make_float3(0.f, 0.f, 0.f);
+  for (int dy = 0; dy < 2; ++dy) {
+    const int y = 2 * cy + dy;
+    const uint8_t* in = src + static_cast<size_t>(y) * src_pitch + 2 * cx * channels;
+    T* out_y = row<T>(dst.y, dst.y_pitch, y) + 2 * cx;
+    for (int dx = 0; dx < 2; ++dx) {
+      const float3 rgb = make_float3(in[dx * channels], in[dx * channels + 1],
+                                     in[dx * channels + 2]);
+      out_y[dx] = to_sample<T>(16.f + dot(c.y, rgb));
+      sum.x += rgb.x;
+      sum.y += rgb.y;
+      sum.z += rgb.z;
+    }
+  }
+  const float3 rgb = make_float3(0.25f * sum.x, 0.25f * sum.y, 0.25f * sum.z);
+  const T u = to_sample<T>(128.f + dot(c.u, rgb));
+  const T v = to_sample<T>(128.f + dot(c.v, rgb));
+  if (kPlanar) {
+    row<T>(dst.u, dst.uv_pitch, cy)[cx] = u;
+    row<T>(dst.v, dst.uv_pitch, cy)[cx] = v;
+  } else {
+    T* out_uv = row<T>(dst.u, dst.uv_pitch, cy) + 2 * cx;
+    out_uv[0] = u;
+    out_uv[1] = v;
+  }
+}
+
+}  // namespace
+
+cudaError_t rgb_to_yuv420(const uint8_t* src, int src_pitch, int channels, int width, int height,
+                          YuvLayout layout, YuvMatrix matrix, const YuvPlanes& dst,
+                          cudaStream_t cuda_stream) {
+  const dim3 block(kBlockWidth, kBlockHeight);
+  const dim3 grid((width / 2 + kBlockWidth - 1) / kBlockWidth,
+                  (height / 2 + kBlockHeight - 1) / kBlockHeight);
+  const int matrix_index = matrix == YuvMatrix::kBT709 ? 1 : 0;
+  switch (layout) {
+    case YuvLayout::kI420:
+      rgb_to_yuv420_kernel<uint8_t, true><<<grid, block, 0, cuda_stream>>>(
+          src, src_pitch, channels, width, height, matrix_index, dst);
+      break;
+    case YuvLayout::kNV12:
+      rgb_to_yuv420_kernel<uint8_t, false><<<grid, block, 0, cuda_stream>>>(
+          src, src_pitch, channels, width, height, matrix_index, dst);
+      break;
+    case YuvLayout::kP010:
+      rgb_to_yuv420_kernel<uint16_t, false><<<grid, block, 0, cuda_stream>>>(
+          src, src_pitch, channels, width, height, matrix_index, dst);
+      break;
+  }
+  return cudaGetLastError();
+}
+
+}  // namespace holoscan::ops
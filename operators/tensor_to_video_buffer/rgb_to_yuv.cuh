@@ -0,0 +1,56 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef HOLOSCAN_OPERATORS_TENSOR_TO_VIDEO_BUFFER_RGB_TO_YUV
+#define HOLOSCAN_OPERATORS_TENSOR_TO_VIDEO_BUFFER_RGB_TO_YUV
+
+#include <cuda_runtime.h>
+
+#include <cstdint>
+
+namespace holoscan::ops {
+
+enum class YuvLayout {
+  kI420,  // 8-bit Y, U and V planes
+  kNV12,  // 8-bit Y plane and interleaved UV plane
+  kP010,  // as NV12 with 16-bit samples, 10 bits in the most significant bits
+};
+
+enum class YuvMatrix { kBT601, kBT709 };
+
+/// Destination planes, in device memory; v is only used by kI420
+struct YuvPlanes {
+  void* y;
+  void* u;
+  void* v;
+  int y_pitch;
+  int uv_pitch;
+};
+
+/**
+ * @brief Convert a packed 8-bit RGB or RGBA (channels 3 or 4) image to video range YUV 4:2:0,
+ * chroma averaged over each 2x2 block, in one pass over the source.
+ *
+ * width and height have to be even. Returns the launch error, if any.
+ */
+cudaError_t rgb_to_yuv420(const uint8_t* src, int src_pitch, int channels, int width, int height,
+                          YuvLayout layout, YuvMatrix matrix, const YuvPlanes& dst,
+                          cudaStream_t cuda_stream);
+
+}  // namespace holoscan::ops
+
+#endif  // HOLOSCAN_OPERATORS_TENSOR_TO_VIDEO_BUFFER_RGB_TO_YUV
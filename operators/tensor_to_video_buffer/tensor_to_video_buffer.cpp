@@ -15,7 +15,9 @@
  * limitations under the License.
  */
 
+#include <string>
 #include <utility>
+#include <vector>
 
 // If GXF has gxf/std/dlpack_utils.hpp it has DLPack support
 #if __has_include("gxf/std/dlpack_utils.hpp")
@@ -46,6 +48,38 @@ static nvidia::gxf::VideoFormat toVideoFormat(const std::string& str) {
   }
 }
 
+static uint32_t alignUp(uint32_t value, uint32_t alignment) {
+  return (value + alignment - 1) / alignment * alignment;
+}
+
+// Planes of a 4:2:0 frame, back to back in one allocation
+static std::vector<nvidia::gxf::ColorPlane> yuv420Planes(YuvLayout layout, uint32_t width,
+                                                         uint32_t height, uint32_t alignment,
+                                                         uint64_t* size) {
+  std::vector<nvidia::gxf::ColorPlane> planes;
+  *size = 0;
+  auto add_plane = [&](const char* name, uint8_t bytes_per_pixel, uint32_t plane_width,
+                       uint32_t plane_height) {
+    nvidia::gxf::ColorPlane plane(name, bytes_per_pixel, alignUp(plane_width * bytes_per_pixel,
+                                                                 alignment));
+    plane.width = plane_width;
+    plane.height = plane_height;
+    plane.offset = *size;
+    plane.size = static_cast<uint64_t>(plane.stride) * plane_height;
+    *size += plane.size;
+    planes.push_back(plane);
+  };
+  const uint8_t bytes_per_sample = layout == YuvLayout::kP010 ? 2 : 1;
+  add_plane("Y", bytes_per_sample, width, height);
+  if (layout == YuvLayout::kI420) {
+    add_plane("U", 1, width / 2, height / 2);
+    add_plane("V", 1, width / 2, height / 2);
+  } else {
+    add_plane("UV", 2 * bytes_per_sample, width / 2, height / 2);
+  }
+  return planes;
+}
+
 void TensorToVideoBufferOp::setup(OperatorSpec& spec) {
   auto& input = spec.input<gxf::Entity>("in_tensor");
   auto& output = spec.output<gxf::Entity>("out_video_buffer");
@@ -58,10 +92,61 @@ void TensorToVideoBufferOp::setup(OperatorSpec& spec) {
              std::string(""));
   spec.param(video_format_, "video_format", "VideoFormat", "Video format", std::string(""));
   spec.param(data_out_, "data_out", "DataOut", "Data in GXF format", &output);
+  spec.param(convert_,
+             "convert",
+             "Convert",
+             "Convert an RGB or RGBA tensor to video_format instead of wrapping it.",
+             false);
+  spec.param(color_space_,
+             "color_space",
+             "ColorSpace",
+             "Color matrix of the conversion, bt601 or bt709.",
+             std::string("bt601"));
+  spec.param(pitch_alignment_,
+             "pitch_alignment",
+             "PitchAlignment",
+             "Alignment in bytes of the plane pitches of converted video buffers.",
+             256u);
+  spec.param(allocator_, "allocator", "Allocator", "Allocator of the converted video buffers.");
+
+  cuda_stream_handler_.define_params(spec);
 }
 
 void TensorToVideoBufferOp::start() {
-  video_format_type_ = toVideoFormat(video_format_);
+  if (!convert_) {
+    video_format_type_ = toVideoFormat(video_format_);
+    return;
+  }
+
+  if (!allocator_.has_value()) {
+    throw std::runtime_error("An allocator is required to convert to a video format");
+  }
+  if (pitch_alignment_.get() == 0) { throw std::runtime_error("Invalid pitch alignment 0"); }
+  const std::string& color_space = color_space_.get();
+  if (color_space == "bt601") {
+    yuv_matrix_ = YuvMatrix::kBT601;
+  } else if (color_space == "bt709") {
+    yuv_matrix_ = YuvMatrix::kBT709;
+  } else {
+    throw std::runtime_error(fmt::format("Unsupported color space '{}'", color_space));
+  }
+  const bool bt709 = yuv_matrix_ == YuvMatrix::kBT709;
+  const std::string& video_format = video_format_.get();
+  if (video_format == "yuv420") {
+    yuv_layout_ = YuvLayout::kI420;
+    video_format_type_ = bt709 ? nvidia::gxf::VideoFormat::GXF_VIDEO_FORMAT_YUV420_709
+                               : nvidia::gxf::VideoFormat::GXF_VIDEO_FORMAT_YUV420;
+  } else if (video_format == "nv12") {
+    yuv_layout_ = YuvLayout::kNV12;
+    video_format_type_ = bt709 ? nvidia::gxf::VideoFormat::GXF_VIDEO_FORMAT_NV12_709
+                               : nvidia::gxf::VideoFormat::GXF_VIDEO_FORMAT_NV12;
+  } else if (video_format == "p010") {
+    // GXF has no 10-bit 4:2:0 format, the planes describe it
+    yuv_layout_ = YuvLayout::kP010;
+    video_format_type_ = nvidia::gxf::VideoFormat::GXF_VIDEO_FORMAT_CUSTOM;
+  } else {
+    throw std::runtime_error(fmt::format("Unsupported conversion to '{}'", video_format));
+  }
 }
 
 void TensorToVideoBufferOp::compute(InputContext& op_input, OutputContext& op_output,
@@ -110,6 +195,71 @@ void TensorToVideoBufferOp::compute(InputContext& op_input, OutputContext& op_ou
         fmt::format("Tensor '{}' or VideoBuffer is not allocated on device", in_tensor_name));
   }
 
+  if (convert_) {
+    if (in_primitive_type != nvidia::gxf::PrimitiveType::kUnsigned8 ||
+        (in_channels != 3 && in_channels != 4)) {
+      throw std::runtime_error("Only supports 3 or 4 channel 8-bit input tensors for conversion");
+    }
+    if ((width_ % 2) || (height_ % 2)) {
+      throw std::runtime_error(
+          fmt::format("Conversion requires an even size, got {}x{}", width_, height_));
+    }
+
+    // Convert on the stream of the input
+    if (cuda_stream_handler_.from_message(context.context(), in_message) != GXF_SUCCESS) {
+      throw std::runtime_error("Failed to get the CUDA stream from incoming messages");
+    }
+    const cudaStream_t cuda_stream = cuda_stream_handler_.get_cuda_stream(context.context());
+
+    auto out_message = nvidia::gxf::Entity::New(context.context());
+    if (!out_message) { throw std::runtime_error("Failed to allocate message; terminating."); }
+    auto buffer = out_message.value().add<nvidia::gxf::VideoBuffer>();
+    if (!buffer) { throw std::runtime_error("Failed to allocate video buffer; terminating."); }
+
+    uint64_t size = 0;
+    auto color_planes = yuv420Planes(yuv_layout_, width_, height_, pitch_alignment_, &size);
+    nvidia::gxf::VideoBufferInfo info{width_,
+                                      height_,
+                                      video_format_type_,
+                                      color_planes,
+                                      nvidia::gxf::SurfaceLayout::GXF_SURFACE_LAYOUT_PITCH_LINEAR};
+    auto allocator = nvidia::gxf::Handle<nvidia::gxf::Allocator>::Create(
+        fragment()->executor().context(), allocator_.get()->gxf_cid());
+    if (!buffer.value()->resizeCustom(
+            info, size, nvidia::gxf::MemoryStorageType::kDevice, allocator.value())) {
+      throw std::runtime_error("Failed to allocate the converted video buffer");
+    }
+
+    uint8_t* out_pointer = buffer.value()->pointer();
+    YuvPlanes planes{out_pointer + color_planes[0].offset,
+                     out_pointer + color_planes[1].offset,
+                     color_planes.size() > 2 ? out_pointer + color_planes[2].offset : nullptr,
+                     color_planes[0].stride,
+                     color_planes[1].stride};
+    const cudaError_t result = rgb_to_yuv420(static_cast<const uint8_t*>(in_tensor_data),
+                                             in_tensor->stride(0),
+                                             in_channels,
+                                             width_,
+                                             height_,
+                                             yuv_layout_,
+                                             yuv_matrix_,
+                                             planes,
+                                             cuda_stream);
+    if (result != cudaSuccess) {
+      throw std::runtime_error(
+          fmt::format("Failed to convert to '{}': {}", video_format_.get(),
+                      cudaGetErrorString(result)));
+    }
+
+    // Downstream operators synchronize with the conversion through the stream
+    if (cuda_stream_handler_.to_message(out_message) != GXF_SUCCESS) {
+      throw std::runtime_error("Failed to add the CUDA stream to the outgoing messages");
+    }
+    auto result_message = gxf::Entity(std::move(out_message.value()));
+    op_output.emit(result_message);
+    return;
+  }
+
   // Process image only if the input image is 3 channel image
   if (in_primitive_type != nvidia::gxf::PrimitiveType::kUnsigned8 || in_channels != 3) {
     throw std::runtime_error("Only supports 3 channel input tensor");
@@ -19,17 +19,28 @@
 #ifndef HOLOSCAN_OPERATORS_TENSOR_TO_VIDEO_BUFFER
 #define HOLOSCAN_OPERATORS_TENSOR_TO_VIDEO_BUFFER
 
+#include <memory>
 #include <string>
 
 #include "gxf/multimedia/video.hpp"
 
 #include "holoscan/core/operator.hpp"
+#include "holoscan/core/resources/gxf/allocator.hpp"
+#include "holoscan/utils/cuda_stream_handler.hpp"
+
+#include "rgb_to_yuv.cuh"
+
 namespace holoscan::ops {
 
 /**
  * @brief Operator class to convert Tensor to VideoBuffer.
  *
  * This operator takes Tensor as input and outputs GXF VideoBuffer created from it.
+ *
+ * By default the tensor memory is wrapped as is. With `convert`, an RGB or RGBA tensor is
+ * converted on the GPU to the YUV 4:2:0 `video_format` ("yuv420", "nv12" or "p010") into a
+ * multi-planar video buffer allocated from `allocator`, each plane pitch aligned to
+ * `pitch_alignment` bytes.
  */
 class TensorToVideoBufferOp: public Operator {
  public:
@@ -47,8 +58,16 @@ class TensorToVideoBufferOp: public Operator {
   Parameter<holoscan::IOSpec*> data_out_;
   Parameter<std::string> in_tensor_name_;
   Parameter<std::string> video_format_;
+  Parameter<bool> convert_;
+  Parameter<std::string> color_space_;
+  Parameter<uint32_t> pitch_alignment_;
+  Parameter<std::shared_ptr<Allocator>> allocator_;
 
   nvidia::gxf::VideoFormat video_format_type_;
+  YuvLayout yuv_layout_ = YuvLayout::kI420;
+  YuvMatrix yuv_matrix_ = YuvMatrix::kBT601;
+
+  CudaStreamHandler cuda_stream_handler_;
 };
 
 }  // namespace holoscan::ops
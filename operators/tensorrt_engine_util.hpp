@@ -0,0 +1,190 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef HOLOHUB_OPERATORS_TENSORRT_ENGINE_UTIL_HPP
+#define HOLOHUB_OPERATORS_TENSORRT_ENGINE_UTIL_HPP
+
+#include <NvInfer.h>
+#include <NvOnnxParser.h>
+#include <cuda_runtime.h>
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <holoscan/logger/logger.hpp>
+
+#if NV_TENSORRT_MAJOR < 8 || (NV_TENSORRT_MAJOR == 8 && NV_TENSORRT_MINOR < 5)
+#error "The TensorRT engine helpers require TensorRT 8.5 or later"
+#endif
+
+namespace holoscan::ops::trt_engine {
+
+// Logger for TensorRT to redirect logging into the Holoscan log
+class Logger : public nvinfer1::ILogger {
+ public:
+  void log(Severity severity, const char* msg) noexcept override {
+    switch (severity) {
+      case Severity::kINTERNAL_ERROR:
+      case Severity::kERROR:
+        HOLOSCAN_LOG_ERROR("TRT: {}", msg);
+        break;
+      case Severity::kWARNING:
+        HOLOSCAN_LOG_WARN("TRT: {}", msg);
+        break;
+      case Severity::kINFO:
+        HOLOSCAN_LOG_DEBUG("TRT: {}", msg);
+        break;
+      default:
+        HOLOSCAN_LOG_TRACE("TRT: {}", msg);
+        break;
+    }
+  }
+};
+
+template <typename T>
+struct DeleteFunctor {
+  inline void operator()(void* ptr) { delete reinterpret_cast<T*>(ptr); }
+};
+template <typename T>
+using NvInferHandle = std::unique_ptr<T, DeleteFunctor<T>>;
+
+/**
+ * @brief Path of the cached engine of an ONNX model
+ *
+ * An engine is specific to the model, the batch size, the device, the TensorRT version and the
+ * precision. The batch size is only part of the name when it is above 1.
+ */
+inline std::string engine_file_path(const std::string& cache_dir, const std::string& model_path,
+                                    int batch_size, bool enable_fp16) {
+  int device = 0;
+  cudaDeviceProp device_prop{};
+  if (cudaGetDevice(&device) != cudaSuccess ||
+      cudaGetDeviceProperties(&device_prop, device) != cudaSuccess) {
+    throw std::runtime_error("Failed to get the CUDA device properties");
+  }
+  std::string device_name = device_prop.name;
+  std::replace(device_name.begin(), device_name.end(), ' ', '-');
+  return fmt::format("{}/{}{}.{}_c{}{}_n{}.trt.{}.{}.{}.engine",
+                     cache_dir,
+                     std::filesystem::path(model_path).stem().string(),
+                     batch_size > 1 ? fmt::format("_b{}", batch_size) : std::string(),
+                     device_name,
+                     device_prop.major,
+                     device_prop.minor,
+                     device_prop.multiProcessorCount,
+                     NV_TENSORRT_MAJOR,
+                     NV_TENSORRT_MINOR,
+                     enable_fp16 ? "fp16" : "fp32");
+}
+
+/**
+ * @brief Builds the serialized engine of an ONNX model
+ *
+ * A dynamic batch dimension is optimized for `batch_size`, from 1 to `batch_size`; the other
+ * dimensions of the inputs must be static.
+ */
+inline std::vector<char> build_engine(nvinfer1::ILogger& logger, const std::string& model_path,
+                                      int batch_size, bool enable_fp16) {
+  HOLOSCAN_LOG_INFO("Building the TensorRT engine of {} for a batch of {}, this may take a while",
+                    model_path,
+                    batch_size);
+  NvInferHandle<nvinfer1::IBuilder> builder(nvinfer1::createInferBuilder(logger));
+  NvInferHandle<nvinfer1::IBuilderConfig> config(builder->createBuilderConfig());
+  if (enable_fp16) { config->setFlag(nvinfer1::BuilderFlag::kFP16); }
+
+#if NV_TENSORRT_MAJOR < 10
+  const auto explicit_batch =
+      1U << static_cast<uint32_t>(nvinfer1::NetworkDefinitionCreationFlag::kEXPLICIT_BATCH);
+#else
+  const auto explicit_batch = 1U;
+#endif
+  NvInferHandle<nvinfer1::INetworkDefinition> network(builder->createNetworkV2(explicit_batch));
+  NvInferHandle<nvonnxparser::IParser> parser(nvonnxparser::createParser(*network, logger));
+  if (!parser->parseFromFile(model_path.c_str(),
+                             static_cast<int>(nvinfer1::ILogger::Severity::kWARNING))) {
+    throw std::runtime_error(fmt::format("Failed to parse the ONNX model {}", model_path));
+  }
+
+  nvinfer1::IOptimizationProfile* profile = builder->createOptimizationProfile();
+  for (int i = 0; i < network->getNbInputs(); ++i) {
+    auto* input = network->getInput(i);
+    nvinfer1::Dims dims = input->getDimensions();
+    if (dims.nbDims > 0 && dims.d[0] == -1) {
+      dims.d[0] = 1;
+      profile->setDimensions(input->getName(), nvinfer1::OptProfileSelector::kMIN, dims);
+      dims.d[0] = batch_size;
+      profile->setDimensions(input->getName(), nvinfer1::OptProfileSelector::kOPT, dims);
+      profile->setDimensions(input->getName(), nvinfer1::OptProfileSelector::kMAX, dims);
+    }
+  }
+  config->addOptimizationProfile(profile);
+
+  NvInferHandle<nvinfer1::IHostMemory> plan(builder->buildSerializedNetwork(*network, *config));
+  if (!plan || plan->size() == 0) {
+    throw std::runtime_error(fmt::format("Failed to build the engine of {}", model_path));
+  }
+  const char* data = static_cast<const char*>(plan->data());
+  return std::vector<char>(data, data + plan->size());
+}
+
+/**
+ * @brief Reads the cached engine of an ONNX model, building and caching it when it is missing
+ *
+ * @param logger Logger of the builder.
+ * @param cache_dir Directory of the cached engines, created if needed.
+ * @param model_path Path of the ONNX model.
+ * @param batch_size Batch size the engine is built for.
+ * @param enable_fp16 Build the engine with FP16.
+ * @param force_update Build the engine even if it is cached.
+ * @return The serialized engine.
+ */
+inline std::vector<char> load_or_build_engine(nvinfer1::ILogger& logger,
+                                              const std::string& cache_dir,
+                                              const std::string& model_path, int batch_size,
+                                              bool enable_fp16, bool force_update = false) {
+  const std::string path = engine_file_path(cache_dir, model_path, batch_size, enable_fp16);
+  std::vector<char> plan;
+  if (!force_update) {
+    std::ifstream file(path, std::ios::binary);
+    if (file) {
+      plan.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    }
+  }
+  if (!plan.empty()) {
+    HOLOSCAN_LOG_INFO("Loading the TensorRT engine {}", path);
+    return plan;
+  }
+
+  plan = build_engine(logger, model_path, batch_size, enable_fp16);
+  // A cache write failure is not fatal, the engine is rebuilt on the next run
+  std::error_code error;
+  std::filesystem::create_directories(cache_dir, error);
+  std::ofstream file(path, std::ios::binary);
+  if (!file.write(plan.data(), plan.size())) {
+    HOLOSCAN_LOG_WARN("Failed to write the engine file {}", path);
+  }
+  return plan;
+}
+
+}  // namespace holoscan::ops::trt_engine
+
+#endif /* HOLOHUB_OPERATORS_TENSORRT_ENGINE_UTIL_HPP */
@@ -76,10 +76,13 @@ class PyToolTrackingPostprocessorOp : public ToolTrackingPostprocessorOp {
       float min_prob = 0.5f,
       std::vector<std::vector<float>> overlay_img_colors = VIZ_TOOL_DEFAULT_COLORS,
       std::shared_ptr<holoscan::CudaStreamPool> cuda_stream_pool = nullptr,
+      const std::string& mask_format = "float32", bool mask_half_resolution = false,
       const std::string& name = "tool_tracking_postprocessor")
       : ToolTrackingPostprocessorOp(ArgList{Arg{"device_allocator", device_allocator},
                                             Arg{"min_prob", min_prob},
-                                            Arg{"overlay_img_colors", overlay_img_colors}}) {
+                                            Arg{"overlay_img_colors", overlay_img_colors},
+                                            Arg{"mask_format", mask_format},
+                                            Arg{"mask_half_resolution", mask_half_resolution}}) {
     if (cuda_stream_pool) { this->add_arg(Arg{"cuda_stream_pool", cuda_stream_pool}); }
     add_positional_condition_and_resource_args(this, args);
     name_ = name;
@@ -118,12 +121,16 @@ PYBIND11_MODULE(_tool_tracking_postprocessor, m) {
                     float,
                     std::vector<std::vector<float>>,
                     std::shared_ptr<holoscan::CudaStreamPool>,
+                    const std::string&,
+                    bool,
                     const std::string&>(),
            "fragment"_a,
            "device_allocator"_a,
            "min_prob"_a = 0.5f,
            "overlay_img_colors"_a = VIZ_TOOL_DEFAULT_COLORS,
            "cuda_stream_pool"_a = py::none(),
+           "mask_format"_a = "float32"s,
+           "mask_half_resolution"_a = false,
            "name"_a = "tool_tracking_postprocessor"s,
            doc::ToolTrackingPostprocessorOp::doc_ToolTrackingPostprocessorOp_python);
 }  // PYBIND11_MODULE NOLINT
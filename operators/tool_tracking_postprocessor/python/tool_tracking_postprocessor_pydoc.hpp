@@ -56,6 +56,13 @@ overlay_img_colors : sequence of sequence of float, optional
 cuda_stream_pool : ``holoscan.resources.CudaStreamPool``, optional
     `holoscan.resources.CudaStreamPool` instance to allocate CUDA streams.
     Default value is ``None``.
+mask_format : str, optional
+    Format of the "mask" output, ``"float32"`` (RGBA float), ``"rgba8"`` (RGBA uint8 with
+    straight alpha) or ``"rgba8_premultiplied"`` (RGBA uint8 with the colors premultiplied by
+    the alpha). Default value is ``"float32"``.
+mask_half_resolution : bool, optional
+    Output the "mask" at half the width and height of the binary masks, to be upsampled by
+    Holoviz. Default value is ``False``.
 name : str, optional
     The name of the operator.
 )doc")
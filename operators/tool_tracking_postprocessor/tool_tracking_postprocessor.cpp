@@ -61,6 +61,18 @@ void ToolTrackingPostprocessorOp::setup(OperatorSpec& spec) {
              "Color of the image overlays, a list of RGB values with components between 0 and 1",
              DEFAULT_COLORS);
 
+  spec.param(mask_format_,
+             "mask_format",
+             "Mask Format",
+             "Format of the colored mask: 'float32' (RGBA float), 'rgba8' (straight alpha) or "
+             "'rgba8_premultiplied'.",
+             std::string("float32"));
+  spec.param(mask_half_resolution_,
+             "mask_half_resolution",
+             "Mask Half Resolution",
+             "Output the colored mask at half the resolution of the binary masks.",
+             false);
+
   spec.param(device_allocator_, "device_allocator", "Allocator", "Output Allocator");
 
   cuda_stream_handler_.define_params(spec);
@@ -97,6 +109,19 @@ void ToolTrackingPostprocessorOp::compute(InputContext& op_input, OutputContext&
   if (!maybe_tensor) { throw std::runtime_error("Tensor 'binary_masks' not found in message."); }
   auto binary_masks_tensor = maybe_tensor;
 
+  // the masks may be float32, float16 or uint8
+  const DLDataType mask_dtype = binary_masks_tensor->dtype();
+  MaskType mask_type;
+  if (mask_dtype.code == kDLFloat && mask_dtype.bits == 32) {
+    mask_type = MaskType::FLOAT32;
+  } else if (mask_dtype.code == kDLFloat && mask_dtype.bits == 16) {
+    mask_type = MaskType::FLOAT16;
+  } else if (mask_dtype.code == kDLUInt && mask_dtype.bits == 8) {
+    mask_type = MaskType::UINT8;
+  } else {
+    throw std::runtime_error("Tensor 'binary_masks' must be float32, float16 or uint8.");
+  }
+
   // get Handle to underlying nvidia::gxf::Allocator from std::shared_ptr<holoscan::Allocator>
   auto device_allocator = nvidia::gxf::Handle<nvidia::gxf::Allocator>::Create(
       context.context(), device_allocator_.get()->gxf_cid());
@@ -121,11 +146,31 @@ void ToolTrackingPostprocessorOp::compute(InputContext& op_input, OutputContext&
   auto out_mask_tensor = out_message.value().add<nvidia::gxf::Tensor>("mask");
   if (!out_mask_tensor) { throw std::runtime_error("Failed to allocate output tensor 'mask'"); }
 
-  const nvidia::gxf::Shape mask_shape{static_cast<int>(binary_masks_tensor->shape()[2]),
-                                      static_cast<int>(binary_masks_tensor->shape()[3]),
+  MaskFormat mask_format;
+  if (mask_format_.get() == "float32") {
+    mask_format = MaskFormat::FLOAT32;
+  } else if (mask_format_.get() == "rgba8") {
+    mask_format = MaskFormat::RGBA8;
+  } else if (mask_format_.get() == "rgba8_premultiplied") {
+    mask_format = MaskFormat::RGBA8_PREMULTIPLIED;
+  } else {
+    throw std::runtime_error(fmt::format("Unsupported mask format '{}'.", mask_format_.get()));
+  }
+
+  // Holoviz scales the mask layer to the size of the view
+  const uint32_t height = binary_masks_tensor->shape()[2];
+  const uint32_t width = binary_masks_tensor->shape()[3];
+  const uint32_t mask_scale = mask_half_resolution_.get() ? 2 : 1;
+  const nvidia::gxf::Shape mask_shape{static_cast<int>((height + mask_scale - 1) / mask_scale),
+                                      static_cast<int>((width + mask_scale - 1) / mask_scale),
                                       4};
-  out_mask_tensor.value()->reshape<float>(
-      mask_shape, nvidia::gxf::MemoryStorageType::kDevice, device_allocator.value());
+  if (mask_format == MaskFormat::FLOAT32) {
+    out_mask_tensor.value()->reshape<float>(
+        mask_shape, nvidia::gxf::MemoryStorageType::kDevice, device_allocator.value());
+  } else {
+    out_mask_tensor.value()->reshape<uint8_t>(
+        mask_shape, nvidia::gxf::MemoryStorageType::kDevice, device_allocator.value());
+  }
   if (!out_mask_tensor.value()->pointer()) {
     throw std::runtime_error("Failed to allocate output tensor buffer for tensor 'mask'.");
   }
@@ -166,11 +211,14 @@ void ToolTrackingPostprocessorOp::compute(InputContext& op_input, OutputContext&
                    reinterpret_cast<const float*>(probs_tensor->data()),
                    reinterpret_cast<const float2*>(scaled_coords_tensor->data()),
                    reinterpret_cast<float3*>(out_coords_tensor.value()->pointer()),
-                   mask_shape.dimension(0),
-                   mask_shape.dimension(1),
+                   width,
+                   height,
                    reinterpret_cast<const float3*>(dev_colors_),
-                   reinterpret_cast<const float*>(binary_masks_tensor->data()),
-                   reinterpret_cast<float4*>(out_mask_tensor.value()->pointer()),
+                   binary_masks_tensor->data(),
+                   mask_type,
+                   mask_scale,
+                   mask_format,
+                   out_mask_tensor.value()->pointer(),
                    cuda_stream);
 
   // pass the CUDA stream to the output message
@@ -15,6 +15,8 @@
  * limitations under the License.
  */
 
+#include <cuda_fp16.h>
+
 #include <algorithm>
 
 #include "tool_tracking_postprocessor.cuh"
@@ -25,73 +27,171 @@ static __device__ __host__ uint32_t ceil_div(uint32_t numerator, uint32_t denomi
   return (numerator + denominator - 1) / denominator;
 }
 
-__global__ void filter_binary_mask_kernel(uint32_t width, uint32_t height, uint32_t index,
-                                          const float3* colors, const float* binary_mask,
-                                          float4* colored_mask) {
+template <typename T>
+static __device__ float mask_value(T value);
+
+template <>
+__device__ float mask_value(float value) {
+  return value;
+}
+
+template <>
+__device__ float mask_value(__half value) {
+  return __half2float(value);
+}
+
+template <>
+__device__ float mask_value(uint8_t value) {
+  return value * (1.f / 255.f);
+}
+
+static __device__ uint8_t to_unorm8(float value) {
+  return static_cast<uint8_t>(min(max(value, 0.f), 1.f) * 255.f + 0.5f);
+}
+
+// One thread per output pixel, blending the masks of all tools above min_prob in registers. With
+// a mask_scale of 2, the masks are averaged over the 2x2 pixels of the output pixel. The tools
+// and their colors are staged in shared memory by each block, the first block also writes the
+// filtered coordinates.
+template <typename T>
+__global__ void postprocess_kernel(uint32_t count, float min_prob, const float* probs,
+                                   const float2* scaled_coords, float3* filtered_scaled_coords,
+                                   uint32_t width, uint32_t height, const float3* colors,
+                                   const T* binary_mask, uint32_t mask_scale, MaskFormat format,
+                                   void* colored_mask) {
+  extern __shared__ float4 tools[];  // color and, in w, whether the tool is shown
+  const uint32_t thread = threadIdx.y * blockDim.x + threadIdx.x;
+  const bool first_block = (blockIdx.x == 0) && (blockIdx.y == 0);
+  // the third component of the coordinate is the size of the crosses and the text
+  constexpr float ITEM_SIZE = 0.05f;
+
+  for (uint32_t index = thread; index < count; index += blockDim.x * blockDim.y) {
+    // check if the probability meets the minimum probability
+    const bool shown = probs[index] > min_prob;
+    tools[index] = make_float4(colors[index].x, colors[index].y, colors[index].z, shown);
+    if (first_block) {
+      // tools below the minimum probability are moved outside of the screen
+      filtered_scaled_coords[index] =
+          shown ? make_float3(scaled_coords[index].x, scaled_coords[index].y, ITEM_SIZE)
+                : make_float3(-1.f, -1.f, ITEM_SIZE);
+    }
+  }
+  __syncthreads();
+
   const uint32_t x = blockIdx.x * blockDim.x + threadIdx.x;
   const uint32_t y = blockIdx.y * blockDim.y + threadIdx.y;
+  const uint32_t mask_width = ceil_div(width, mask_scale);
+  const uint32_t mask_height = ceil_div(height, mask_scale);
 
-  if ((x >= width) || (y >= height)) { return; }
-
-  float value = binary_mask[((index * height) + y) * width + x];
+  if ((x >= mask_width) || (y >= mask_height)) { return; }
 
   const float minV = 0.3f;
   const float maxV = 0.99f;
   const float range = maxV - minV;
-  value = min(max(value, minV), maxV);
-  value -= minV;
-  value /= range;
-  value *= 0.7f;
-
-  const float4 dst = colored_mask[y * width + x];
-  colored_mask[y * width + x] = make_float4((1.0f - value) * dst.x + colors[index].x * value,
-                                            (1.0f - value) * dst.y + colors[index].y * value,
-                                            (1.0f - value) * dst.z + colors[index].z * value,
-                                            (1.0f - value) * dst.w + 1.f * value);
-}
+  float4 dst = make_float4(0.f, 0.f, 0.f, 0.f);
+  for (uint32_t index = 0; index < count; ++index) {
+    const float4 tool = tools[index];
+    // add the binary mask to the result only if probability is met
+    if (tool.w == 0.f) { continue; }
 
-__global__ void filter_coordinates_kernel(uint32_t count, float min_prob, const float* probs,
-                                          const float2* scaled_coords,
-                                          float3* filtered_scaled_coords, uint32_t width,
-                                          uint32_t height, const float3* colors,
-                                          const float* binary_mask, float4* colored_mask) {
-  const uint32_t index = blockIdx.x * blockDim.x + threadIdx.x;
-  // the third component of the coordinate is the size of the crosses and the text
-  constexpr float ITEM_SIZE = 0.05f;
+    float value = 0.f;
+    for (uint32_t dy = 0; dy < mask_scale; ++dy) {
+      const uint32_t src_y = min(y * mask_scale + dy, height - 1);
+      for (uint32_t dx = 0; dx < mask_scale; ++dx) {
+        const uint32_t src_x = min(x * mask_scale + dx, width - 1);
+        value += mask_value(binary_mask[((index * height) + src_y) * width + src_x]);
+      }
+    }
+    value /= mask_scale * mask_scale;
+    value = min(max(value, minV), maxV);
+    value -= minV;
+    value /= range;
+    value *= 0.7f;
+
+    dst = make_float4((1.0f - value) * dst.x + tool.x * value,
+                      (1.0f - value) * dst.y + tool.y * value,
+                      (1.0f - value) * dst.z + tool.z * value,
+                      (1.0f - value) * dst.w + 1.f * value);
+  }
 
-  // check if the probability meets the minimum probability
-  if (probs[index] > min_prob) {
-    filtered_scaled_coords[index] =
-        make_float3(scaled_coords[index].x, scaled_coords[index].y, ITEM_SIZE);
-    // add the binary mask to the result only if probabiliy is met
-    const dim3 block(32, 32, 1);
-    const dim3 grid(ceil_div(width, block.x), ceil_div(height, block.y), 1);
-    filter_binary_mask_kernel<<<grid, block>>>(
-        width, height, index, colors, binary_mask, colored_mask);
-  } else {
-    // move outside of the screen
-    filtered_scaled_coords[index] = make_float3(-1.f, -1.f, ITEM_SIZE);
+  // the blended colors are premultiplied by the alpha
+  const uint32_t offset = y * mask_width + x;
+  switch (format) {
+    case MaskFormat::FLOAT32:
+      static_cast<float4*>(colored_mask)[offset] = dst;
+      break;
+    case MaskFormat::RGBA8: {
+      const float scale = dst.w > 0.f ? 1.f / dst.w : 0.f;
+      static_cast<uchar4*>(colored_mask)[offset] = make_uchar4(to_unorm8(dst.x * scale),
+                                                               to_unorm8(dst.y * scale),
+                                                               to_unorm8(dst.z * scale),
+                                                               to_unorm8(dst.w));
+      break;
+    }
+    case MaskFormat::RGBA8_PREMULTIPLIED:
+      static_cast<uchar4*>(colored_mask)[offset] =
+          make_uchar4(to_unorm8(dst.x), to_unorm8(dst.y), to_unorm8(dst.z), to_unorm8(dst.w));
+      break;
   }
 }
+
 void cuda_postprocess(uint32_t count, float min_prob, const float* probs,
                       const float2* scaled_coords, float3* filtered_scaled_coords, uint32_t width,
-                      uint32_t height, const float3* colors, const float* binary_mask,
-                      float4* colored_mask, cudaStream_t cuda_stream) {
-  // initialize the output mask to zero
-  CUDA_TRY(cudaMemsetAsync(colored_mask, 0, width * height * sizeof(float4), cuda_stream));
-
-  const dim3 block(count, 1, 1);
-  const dim3 grid(1, 1, 1);
-  filter_coordinates_kernel<<<grid, block, 0, cuda_stream>>>(count,
-                                                             min_prob,
-                                                             probs,
-                                                             scaled_coords,
-                                                             filtered_scaled_coords,
-                                                             width,
-                                                             height,
-                                                             colors,
-                                                             binary_mask,
-                                                             colored_mask);
+                      uint32_t height, const float3* colors, const void* binary_mask,
+                      MaskType mask_type, uint32_t mask_scale, MaskFormat mask_format,
+                      void* colored_mask, cudaStream_t cuda_stream) {
+  const dim3 block(32, 8, 1);
+  const dim3 grid(ceil_div(ceil_div(width, mask_scale), block.x),
+                  ceil_div(ceil_div(height, mask_scale), block.y),
+                  1);
+  const size_t shared_size = count * sizeof(float4);
+  switch (mask_type) {
+    case MaskType::FLOAT32:
+      postprocess_kernel<<<grid, block, shared_size, cuda_stream>>>(
+          count,
+          min_prob,
+          probs,
+          scaled_coords,
+          filtered_scaled_coords,
+          width,
+          height,
+          colors,
+          static_cast<const float*>(binary_mask),
+          mask_scale,
+          mask_format,
+          colored_mask);
+      break;
+    case MaskType::FLOAT16:
+      postprocess_kernel<<<grid, block, shared_size, cuda_stream>>>(
+          count,
+          min_prob,
+          probs,
+          scaled_coords,
+          filtered_scaled_coords,
+          width,
+          height,
+          colors,
+          static_cast<const __half*>(binary_mask),
+          mask_scale,
+          mask_format,
+          colored_mask);
+      break;
+    case MaskType::UINT8:
+      postprocess_kernel<<<grid, block, shared_size, cuda_stream>>>(
+          count,
+          min_prob,
+          probs,
+          scaled_coords,
+          filtered_scaled_coords,
+          width,
+          height,
+          colors,
+          static_cast<const uint8_t*>(binary_mask),
+          mask_scale,
+          mask_format,
+          colored_mask);
+      break;
+  }
   CUDA_TRY(cudaPeekAtLastError());
 }
 
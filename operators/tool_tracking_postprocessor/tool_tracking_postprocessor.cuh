@@ -39,9 +39,18 @@
 
 namespace holoscan::ops {
 
+/// Element type of the binary masks, uint8 masks are scaled from [0, 255] to [0, 1]
+enum class MaskType { FLOAT32, FLOAT16, UINT8 };
+
+/// Format of the colored mask: float4, RGBA8 with straight alpha, or RGBA8 with the colors
+/// premultiplied by the alpha (as the blended float4 values)
+enum class MaskFormat { FLOAT32, RGBA8, RGBA8_PREMULTIPLIED };
+
+/// The colored mask is ceil(width / mask_scale) x ceil(height / mask_scale), mask_scale is 1 or 2
 void cuda_postprocess(uint32_t count, float min_prob, const float* probs,
                       const float2* scaled_coords, float3* filtered_scaled_coords, uint32_t width,
-                      uint32_t height, const float3* colors, const float* binary_mask,
-                      float4* colored_mask, cudaStream_t cuda_stream);
+                      uint32_t height, const float3* colors, const void* binary_mask,
+                      MaskType mask_type, uint32_t mask_scale, MaskFormat mask_format,
+                      void* colored_mask, cudaStream_t cuda_stream);
 
 }  // namespace holoscan::ops
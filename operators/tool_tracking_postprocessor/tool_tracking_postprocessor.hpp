@@ -35,7 +35,8 @@ namespace holoscan::ops {
  * - **in** : `nvidia::gxf::Entity` containing multiple `nvidia::gxf::Tensor`
  *   - Must contain input tensors named "probs", "scaled_coords" and "binary_masks" that
  *     correspond to the output of the LSTMTensorRTInfereceOp as used in the endoscopy
- *     tool tracking example applications.
+ *     tool tracking example applications. "binary_masks" may be float32, float16 or uint8
+ *     (scaled from [0, 255]).
  *
  * ==Named Outputs==
  *
@@ -51,6 +52,12 @@ namespace holoscan::ops {
  * - **overlay_img_colors**: A `vector<vector<float>>` where each inner vector is a set of three
  *   floats corresponding to normalized RGB values in range [0, 1.0].
  *   Optional (default: a 12-class qualitative color scheme).
+ * - **mask_format**: Format of the "mask" output, "float32" (RGBA float), "rgba8" (RGBA uint8
+ *   with straight alpha) or "rgba8_premultiplied" (RGBA uint8 with the colors premultiplied by
+ *   the alpha, as the float values). The uint8 formats are 4x smaller. Optional (default:
+ *   "float32").
+ * - **mask_half_resolution**: Output the "mask" at half the width and height of the binary
+ *   masks, averaging them over 2x2 pixels, to be upsampled by Holoviz. Optional (default: false).
  * - **cuda_stream_pool**: `holoscan::CudaStreamPool` instance to allocate CUDA streams.
  *   Optional (default: `nullptr`).
  */
@@ -71,6 +78,8 @@ class ToolTrackingPostprocessorOp : public holoscan::Operator {
 
   Parameter<float> min_prob_;
   Parameter<std::vector<std::vector<float>>> overlay_img_colors_;
+  Parameter<std::string> mask_format_;
+  Parameter<bool> mask_half_resolution_;
 
   Parameter<std::shared_ptr<Allocator>> device_allocator_;
 
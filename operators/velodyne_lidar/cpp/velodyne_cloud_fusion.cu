@@ -0,0 +1,114 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights
+ * reserved. SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velodyne_cloud_fusion.hpp"
+
+#include <algorithm>
+
+#include <holoscan/holoscan.hpp>
+
+#define CUDA_TRY(stmt)                                                                  \
+  {                                                                                     \
+    cudaError_t cuda_status = stmt;                                                     \
+    if (cudaSuccess != cuda_status) {                                                   \
+      HOLOSCAN_LOG_ERROR("Runtime call {} in line {} of file {} failed with '{}' ({})", \
+                         #stmt,                                                         \
+                         __LINE__,                                                      \
+                         __FILE__,                                                      \
+                         cudaGetErrorString(cuda_status),                               \
+                         static_cast<int>(cuda_status));                                \
+      throw std::runtime_error("Velodyne cloud fusion CUDA call failed");               \
+    }                                                                                   \
+  }
+
+namespace data_collection {
+namespace sensors {
+
+namespace {
+
+constexpr int kThreadsPerBlock = 256;
+
+/// @brief Transform every point of every sensor into the merged vehicle-frame cloud.
+__global__ void MergeClouds(const FusionSensorCloud* d_clouds, uint32_t num_clouds,
+                            uint32_t num_points, float3 v, float3 w, PointXYZ* d_out) {
+  const uint32_t idx = blockIdx.x * blockDim.x + threadIdx.x;
+  if (idx >= num_points) { return; }
+
+  // A handful of sensors, a linear search beats anything smarter
+  uint32_t s = 0;
+  while (s + 1 < num_clouds && idx >= d_clouds[s + 1].first_point) { s++; }
+  const FusionSensorCloud& cloud = d_clouds[s];
+  const uint32_t i = idx - cloud.first_point;
+
+  const PointXYZ p = cloud.d_points[i];
+  if (p.x == 0.0f && p.y == 0.0f && p.z == 0.0f) {
+    d_out[idx] = p;
+    return;
+  }
+
+  const float* r = cloud.rotation;
+  const float3 q = {r[0] * p.x + r[1] * p.y + r[2] * p.z + cloud.translation[0],
+                    r[3] * p.x + r[4] * p.y + r[5] * p.z + cloud.translation[1],
+                    r[6] * p.x + r[7] * p.y + r[8] * p.z + cloud.translation[2]};
+  const float dt = cloud.time_offset + i * cloud.time_step;
+  d_out[idx] = {q.x + dt * (v.x + w.y * q.z - w.z * q.y),
+                q.y + dt * (v.y + w.z * q.x - w.x * q.z),
+                q.z + dt * (v.z + w.x * q.y - w.y * q.x)};
+}
+
+}  // namespace
+
+VelodyneCloudFusion::VelodyneCloudFusion(size_t max_sensors) : max_sensors_(max_sensors) {
+  CUDA_TRY(cudaHostAlloc(reinterpret_cast<void**>(&h_clouds_),
+                         max_sensors_ * sizeof(FusionSensorCloud),
+                         cudaHostAllocDefault));
+  CUDA_TRY(
+      cudaMalloc(reinterpret_cast<void**>(&d_clouds_), max_sensors_ * sizeof(FusionSensorCloud)));
+}
+
+VelodyneCloudFusion::~VelodyneCloudFusion() {
+  cudaFree(d_clouds_);
+  cudaFreeHost(h_clouds_);
+}
+
+void VelodyneCloudFusion::Merge(const std::vector<FusionSensorCloud>& clouds,
+                                const float linear_velocity[3], const float angular_velocity[3],
+                                PointXYZ* d_out, cudaStream_t stream) {
+  if (clouds.empty()) { return; }
+  if (clouds.size() > max_sensors_) {
+    HOLOSCAN_LOG_ERROR("Got {} clouds, fusion was set up for {}", clouds.size(), max_sensors_);
+    throw std::runtime_error("Too many clouds to merge");
+  }
+
+  std::copy(clouds.begin(), clouds.end(), h_clouds_);
+  CUDA_TRY(cudaMemcpyAsync(d_clouds_,
+                           h_clouds_,
+                           clouds.size() * sizeof(FusionSensorCloud),
+                           cudaMemcpyHostToDevice,
+                           stream));
+
+  const uint32_t num_points = clouds.back().first_point + clouds.back().num_points;
+  if (num_points == 0) { return; }
+  const float3 v = {linear_velocity[0], linear_velocity[1], linear_velocity[2]};
+  const float3 w = {angular_velocity[0], angular_velocity[1], angular_velocity[2]};
+  MergeClouds<<<(num_points + kThreadsPerBlock - 1) / kThreadsPerBlock, kThreadsPerBlock, 0,
+                stream>>>(d_clouds_, clouds.size(), num_points, v, w, d_out);
+  CUDA_TRY(cudaGetLastError());
+}
+
+}  // namespace sensors
+}  // namespace data_collection
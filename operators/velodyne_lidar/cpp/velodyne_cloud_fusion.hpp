@@ -0,0 +1,78 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights
+ * reserved. SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef VELODYNE_CLOUD_FUSION_HPP
+#define VELODYNE_CLOUD_FUSION_HPP
+
+#include <cuda_runtime.h>
+#include <stdint.h>
+
+#include <vector>
+
+#include "velodyne_convert_xyz.hpp"
+
+namespace data_collection {
+namespace sensors {
+
+/// @brief Cloud of one sensor merged by VelodyneCloudFusion.
+struct FusionSensorCloud {
+  /// Points of the sensor in its own frame. GPU data.
+  const PointXYZ* d_points;
+  /// Number of points, and index of the first one in the merged cloud.
+  uint32_t num_points;
+  uint32_t first_point;
+  /// Sensor to vehicle transform: row-major rotation, then translation.
+  float rotation[9];
+  float translation[3];
+  /// Seconds from the reference time to the first point, and between consecutive points.
+  float time_offset;
+  float time_step;
+};
+
+/// @brief Merges the clouds of several sensors into one vehicle-frame cloud on the GPU.
+///
+/// One thread per merged point applies the extrinsic transform of its sensor, then moves the
+/// point to the reference time with a constant velocity motion model, first order in the
+/// rotation: q + dt (v + w x q), dt being the time of the point from the reference time.
+/// Points with no return, at the origin of their sensor, are kept at the vehicle origin so
+/// that a range crop still removes them.
+class VelodyneCloudFusion {
+ public:
+  /// @param max_sensors Largest number of sensors merged at once.
+  explicit VelodyneCloudFusion(size_t max_sensors);
+  ~VelodyneCloudFusion();
+
+  /// @brief Merge the clouds into d_out, which holds the sum of their points, in one launch.
+  /// @param linear_velocity Vehicle velocity in m/s, in the vehicle frame.
+  /// @param angular_velocity Vehicle angular velocity in rad/s, in the vehicle frame.
+  ///
+  /// Returns without waiting for the merge. The sensor descriptions are staged in pinned
+  /// memory, the previous merge on the stream must be done before the next call.
+  void Merge(const std::vector<FusionSensorCloud>& clouds, const float linear_velocity[3],
+             const float angular_velocity[3], PointXYZ* d_out, cudaStream_t stream);
+
+ private:
+  size_t max_sensors_;
+  // Sensor descriptions of the current merge, GPU data mirrored from pinned host memory.
+  FusionSensorCloud* h_clouds_ = nullptr;
+  FusionSensorCloud* d_clouds_ = nullptr;
+};
+
+}  // namespace sensors
+}  // namespace data_collection
+
+#endif  // VELODYNE_CLOUD_FUSION_HPP
@@ -0,0 +1,68 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights
+ * reserved. SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef VELODYNE_CLOUD_TENSOR_HPP
+#define VELODYNE_CLOUD_TENSOR_HPP
+
+#include <memory>
+
+#include <holoscan/holoscan.hpp>
+
+namespace holoscan::ops {
+
+// Wrap a buffer in a tensor, release is called when the last reference drops
+template <typename ReleaseFn>
+std::shared_ptr<holoscan::Tensor> wrap_tensor_memory(void* buffer, nvidia::gxf::Shape shape,
+                                                     nvidia::gxf::PrimitiveType primitive_type,
+                                                     nvidia::gxf::MemoryStorageType storage,
+                                                     ReleaseFn release) {
+  auto gxf_tensor = std::make_shared<nvidia::gxf::Tensor>();
+  gxf_tensor->wrapMemory(
+      shape,
+      primitive_type,
+      nvidia::gxf::PrimitiveTypeSize(primitive_type),
+      nvidia::gxf::ComputeTrivialStrides(shape, nvidia::gxf::PrimitiveTypeSize(primitive_type)),
+      storage,
+      buffer,
+      [release, buffer](void*) mutable {
+        release(buffer);
+        return nvidia::gxf::Success;
+      });
+  auto maybe_dl_ctx = gxf_tensor->toDLManagedTensorContext();
+  if (!maybe_dl_ctx) {
+    HOLOSCAN_LOG_ERROR(
+        "failed to get std::shared_ptr<DLManagedTensorContext> from nvidia::gxf::Tensor");
+  }
+  return std::make_shared<Tensor>(maybe_dl_ctx.value());
+}
+
+// Wrap a device cloud of float triplets, release is called when the last reference drops
+template <typename ReleaseFn>
+std::shared_ptr<holoscan::Tensor> wrap_device_cloud(float* buffer, nvidia::gxf::Shape shape,
+                                                    ReleaseFn release) {
+  return wrap_tensor_memory(buffer,
+                            shape,
+                            nvidia::gxf::PrimitiveType::kFloat32,
+                            nvidia::gxf::MemoryStorageType::kDevice,
+                            [release](void* buffer) mutable {
+                              release(reinterpret_cast<float*>(buffer));
+                            });
+}
+
+}  // namespace holoscan::ops
+
+#endif  // VELODYNE_CLOUD_TENSOR_HPP
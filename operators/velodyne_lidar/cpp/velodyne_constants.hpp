@@ -46,11 +46,90 @@ constexpr float kVLP16PitchDegrees[kVLP16LineCount] = {
     15.00,
 };
 
+/// @brief VLP-32C and HDL-32E lidars have 32 emitters, fired once per data block
+const uint8_t kVLP32LineCount = 32;
+
+// VLP-32C elevation degree angles by laser index
+constexpr float kVLP32CPitchDegrees[kVLP32LineCount] = {
+    -25.000,
+    -1.000,
+    -1.667,
+    -15.639,
+    -11.310,
+    0.000,
+    -0.667,
+    -8.843,
+    -7.254,
+    0.333,
+    -0.333,
+    -6.148,
+    -5.333,
+    1.333,
+    0.667,
+    -4.000,
+    -4.667,
+    1.667,
+    1.000,
+    -3.667,
+    -3.333,
+    3.333,
+    2.333,
+    -2.667,
+    -3.000,
+    7.000,
+    4.667,
+    -2.333,
+    -2.000,
+    15.000,
+    10.333,
+    -1.333,
+};
+
+// HDL-32E elevation degree angles by laser index
+constexpr float kHDL32EPitchDegrees[kVLP32LineCount] = {
+    -30.67,
+    -9.33,
+    -29.33,
+    -8.00,
+    -28.00,
+    -6.67,
+    -26.67,
+    -5.33,
+    -25.33,
+    -4.00,
+    -24.00,
+    -2.67,
+    -22.67,
+    -1.33,
+    -21.33,
+    0.00,
+    -20.00,
+    1.33,
+    -18.67,
+    2.67,
+    -17.33,
+    4.00,
+    -16.00,
+    5.33,
+    -14.67,
+    6.67,
+    -13.33,
+    8.00,
+    -12.00,
+    9.33,
+    -10.67,
+    10.67,
+};
+
+/// @brief Largest emitter count of the supported sensors (VLS-128)
+const uint8_t kVelodyneMaxLineCount = 128;
+
 // Velodyne device types
 enum __attribute__((__packed__)) VelodyneModel {
   VLP16 = 0x22,
   HDL32 = 0x21,
   VLP32C = 0x28,
+  VLS128 = 0xA1,
 };
 
 // Velodyne packet structure for 16 and 32 line Lidars
@@ -80,6 +159,11 @@ struct RawVelodyneRecord {
   uint8_t intensity_;
 };
 
+// Block headers of sensors with more than 32 lasers select the bank of 32 lasers of the block.
+// Read as little endian: bank 0 is 0xEEFF, bank 1 0xDDFF, bank 2 0xCCFF and bank 3 0xBBFF.
+const uint16_t kVelodyneBank0Header = 0xEEFF;
+const uint16_t kVelodyneBankHeaderStep = 0x1100;
+
 struct RawVelodyneBlock {
   // Special Velodyne magic number FFEE
   uint16_t header_;
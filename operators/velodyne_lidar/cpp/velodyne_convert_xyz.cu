@@ -26,9 +26,9 @@
 
 #include <holoscan/holoscan.hpp>
 
-// Trigonometry tables for spherical -> Cartesian conversion.
-__constant__ double d_vlp16_sin_pitch[data_collection::sensors::kVLP16LineCount];
-__constant__ double d_vlp16_cos_pitch[data_collection::sensors::kVLP16LineCount];
+// Trigonometry tables for spherical -> Cartesian conversion, by laser index.
+__constant__ float d_sin_elevation[data_collection::sensors::kVelodyneMaxLineCount];
+__constant__ float d_cos_elevation[data_collection::sensors::kVelodyneMaxLineCount];
 
 #define CUDA_TRY(stmt)                                                                  \
   {                                                                                     \
@@ -52,16 +52,51 @@ __device__ uint16_t ConvertLittleEndianToBigEndian(uint16_t small_endian) {
   return (bits[1] << 8) + bits[0];
 }
 
-/// @brief  Convert a raw Velodyne VLP-16 packet to a list of XYZ points.
-/// @param d_packet The 1206-byte packet in device memory to convert.
-/// @param d_xyz_list The device memory destination for 384 XYZ points.
+/// @brief Compile-time packet geometry of a Velodyne sensor.
+///
+/// Each 32-record block holds kVelodyneRecords * Banks / LineCount firing sequences. Sensors
+/// with more than 32 lasers have Banks > 1, and the block header selects the bank of 32 lasers
+/// of the block. With DualReturnPairs, dual-return packets carry the last and the strongest
+/// returns of an azimuth in consecutive blocks.
+template <uint32_t LineCount, uint32_t Banks, bool DualReturnPairs>
+struct VelodyneSensorTraits {
+  static constexpr uint32_t kLineCount = LineCount;
+  static constexpr uint32_t kBanks = Banks;
+  static constexpr bool kDualReturnPairs = DualReturnPairs;
+  static_assert(kLineCount <= kVelodyneMaxLineCount, "Elevation tables are too small");
+
+  // Laser fired for a record of a block, following the sensor firing order.
+  __device__ static uint32_t LaserIndex(uint16_t block_header, uint32_t record) {
+    if constexpr (kBanks == 1) {
+      return record % kLineCount;
+    } else {
+      const uint32_t bank = (kVelodyneBank0Header - block_header) / kVelodyneBankHeaderStep;
+      return (bank % kBanks) * kVelodyneRecords + record;
+    }
+  }
+};
+
+using VLP16Traits = VelodyneSensorTraits<16, 1, true>;
+using VLP32Traits = VelodyneSensorTraits<32, 1, true>;
+using HDL64Traits = VelodyneSensorTraits<64, 2, false>;
+using VLS128Traits = VelodyneSensorTraits<128, 4, false>;
+
+/// @brief  Convert raw Velodyne packets to lists of XYZ points.
+/// @param d_packets The 1206-byte packets in device memory to convert, one per thread block.
+/// @param d_xyz_ring The device memory ring of 384 XYZ point lists.
+/// @param ring_packets Number of point lists in the ring.
+/// @param first_slot Ring slot of the first packet's points.
 /// @param d_cos_rot_table Precomputed values for cosines of azimuth angles.
 /// @param d_sin_rot_table Precomputed values for sines of azimuth angles.
+/// @param selection Returns to keep from dual-return packets.
 /// @note The VLP-16 firing sequence does not follow the physical order of lasers,
 ///       but instead "jumps around". See the Velodyne VLP-16 User Manual for details.
-__global__ void ConvertRawPacketToXYZ(data_collection::sensors::RawVelodynePacket* d_packet,
-                                      Blocks* d_xyz_list, double* d_cos_rot_table,
-                                      double* d_sin_rot_table) {
+template <typename Traits>
+__global__ void ConvertRawPacketsToXYZ(const data_collection::sensors::RawVelodynePacket* d_packets,
+                                       Blocks* d_xyz_ring, size_t ring_packets, size_t first_slot,
+                                       const float* __restrict__ d_cos_rot_table,
+                                       const float* __restrict__ d_sin_rot_table,
+                                       VelodyneReturnSelection selection) {
   // x: 0 -- 31, y: 0 -- 11
   // i: 0 -- 31, j: 0 -- 11
   int i = threadIdx.x;
@@ -70,45 +105,48 @@ __global__ void ConvertRawPacketToXYZ(data_collection::sensors::RawVelodynePacke
   // out of size
   if (i >= kVelodyneRecords || j >= kVelodyneBlocks) { return; }
 
+  const RawVelodynePacket* d_packet = &d_packets[blockIdx.x];
+  const RawVelodyneBlock& block = d_packet->blocks_[j];
+  PointXYZ& point = d_xyz_ring[(first_slot + blockIdx.x) % ring_packets].blocks_[j].lines_[i];
+
+  // Even blocks of a dual-return packet hold the last return, odd blocks the strongest one
+  if (Traits::kDualReturnPairs && selection != VelodyneReturnSelection::kAll &&
+      d_packet->status_type_ == DUAL) {
+    const bool last_return = (j % 2) == 0;
+    if (last_return != (selection == VelodyneReturnSelection::kLast)) {
+      point = {0.0f, 0.0f, 0.0f};
+      return;
+    }
+  }
+
   // Convert from the default Velodyne little endian format to the default
   // IGX big endian format.
   uint16_t azimuth =
-      ConvertLittleEndianToBigEndian(d_packet->blocks_[j].azimuth_hundredths_degrees_);
+      ConvertLittleEndianToBigEndian(block.azimuth_hundredths_degrees_) % kVelodyneMaxAzimuth;
   float range_meters =
-      ConvertLittleEndianToBigEndian(d_packet->blocks_[j].records_[i].distance_two_millimeters_) *
+      ConvertLittleEndianToBigEndian(block.records_[i].distance_two_millimeters_) *
       kRawVelodyneDefaultDistanceAccuracy * kMillimetersToMeters;
+  const uint32_t laser = Traits::LaserIndex(ConvertLittleEndianToBigEndian(block.header_), i);
 
   // Use pre-computed lookup tables to translate from spherical coordinates
   // to Cartesian coordinates.
-  d_xyz_list->blocks_[j].lines_[i].x =
-      range_meters * d_vlp16_cos_pitch[i] * d_sin_rot_table[azimuth];
-  d_xyz_list->blocks_[j].lines_[i].y =
-      range_meters * d_vlp16_cos_pitch[i] * d_cos_rot_table[azimuth];
-  d_xyz_list->blocks_[j].lines_[i].z = range_meters * d_vlp16_sin_pitch[i];
+  point.x = range_meters * d_cos_elevation[laser] * d_sin_rot_table[azimuth];
+  point.y = range_meters * d_cos_elevation[laser] * d_cos_rot_table[azimuth];
+  point.z = range_meters * d_sin_elevation[laser];
 }
 
 /// @brief Pre-compute sine and cosine values for rapid lookup.
 void VelodyneConvertXYZHelper::InitSinAndCosTable() {
   HOLOSCAN_LOG_DEBUG("Initializing sin and cos tables in GPU.");
-  auto sin_rot_table = std::vector<double>(kVelodyneMaxAzimuth);
-  auto cos_rot_table = std::vector<double>(kVelodyneMaxAzimuth);
+  auto sin_rot_table = std::vector<float>(kVelodyneMaxAzimuth);
+  auto cos_rot_table = std::vector<float>(kVelodyneMaxAzimuth);
 
   for (int i = 0; i < kVelodyneMaxAzimuth; i++) {
     sin_rot_table[i] = sin(RawVelodyneAngleToRadians(i));
     cos_rot_table[i] = cos(RawVelodyneAngleToRadians(i));
   }
 
-  auto vlp16_sin_pitch_table = std::vector<double>(kVLP16LineCount);
-  auto vlp16_cos_pitch_table = std::vector<double>(kVLP16LineCount);
-
-  for (int i = 0; i < kVLP16LineCount; i++) {
-    vlp16_sin_pitch_table[i] =
-        sin(data_collection::sensors::kVLP16PitchDegrees[i] * kDegreesToRadians);
-    vlp16_cos_pitch_table[i] =
-        cos(data_collection::sensors::kVLP16PitchDegrees[i] * kDegreesToRadians);
-  }
-
-  auto size_of_rot_table_bytes = sin_rot_table.size() * sizeof(double);
+  auto size_of_rot_table_bytes = sin_rot_table.size() * sizeof(float);
   CUDA_TRY(cudaMalloc((void**)&d_sin_rot_table_, size_of_rot_table_bytes));
   CUDA_TRY(cudaMemcpy(
       d_sin_rot_table_, sin_rot_table.data(), size_of_rot_table_bytes, cudaMemcpyHostToDevice));
@@ -117,43 +155,153 @@ void VelodyneConvertXYZHelper::InitSinAndCosTable() {
   CUDA_TRY(cudaMemcpy(
       d_cos_rot_table_, cos_rot_table.data(), size_of_rot_table_bytes, cudaMemcpyHostToDevice));
 
-  auto size_of_pitch_table = vlp16_sin_pitch_table.size() * sizeof(double);
-  CUDA_TRY(
-      cudaMemcpyToSymbol(d_vlp16_sin_pitch, vlp16_sin_pitch_table.data(), size_of_pitch_table));
-  CUDA_TRY(
-      cudaMemcpyToSymbol(d_vlp16_cos_pitch, vlp16_cos_pitch_table.data(), size_of_pitch_table));
+  UploadElevationTable();
 
-  CUDA_TRY(cudaMalloc(reinterpret_cast<void**>(&d_packet_), sizeof(RawVelodynePacket)));
+  CUDA_TRY(cudaEventCreateWithFlags(&upload_done_, cudaEventDisableTiming));
+  ReservePackets(1);
 
   HOLOSCAN_LOG_DEBUG("Finished initializing sin and cos tables.\n");
 }
 
+void VelodyneConvertXYZHelper::SetSensorModel(VelodyneSensorModel model,
+                                              const std::vector<float>& elevation_degrees,
+                                              VelodyneReturnSelection selection) {
+  size_t line_count = kVLP16LineCount;
+  std::vector<float> builtin;
+  switch (model) {
+    case VelodyneSensorModel::kVLP16:
+      builtin.assign(std::begin(kVLP16PitchDegrees), std::end(kVLP16PitchDegrees));
+      break;
+    case VelodyneSensorModel::kVLP32C:
+      line_count = kVLP32LineCount;
+      builtin.assign(std::begin(kVLP32CPitchDegrees), std::end(kVLP32CPitchDegrees));
+      break;
+    case VelodyneSensorModel::kHDL32E:
+      line_count = kVLP32LineCount;
+      builtin.assign(std::begin(kHDL32EPitchDegrees), std::end(kHDL32EPitchDegrees));
+      break;
+    case VelodyneSensorModel::kHDL64:
+      line_count = HDL64Traits::kLineCount;
+      break;
+    case VelodyneSensorModel::kVLS128:
+      line_count = VLS128Traits::kLineCount;
+      break;
+  }
+
+  const auto& elevations = elevation_degrees.empty() ? builtin : elevation_degrees;
+  if (elevations.size() != line_count) {
+    HOLOSCAN_LOG_ERROR("Expected {} laser elevations for the sensor model, got {}",
+                       line_count,
+                       elevations.size());
+    throw std::runtime_error("Invalid Velodyne elevation table");
+  }
+
+  model_ = model;
+  return_selection_ = selection;
+  elevation_degrees_ = elevations;
+  if (initialized_) { UploadElevationTable(); }
+}
+
+void VelodyneConvertXYZHelper::UploadElevationTable() {
+  auto sin_pitch_table = std::vector<float>(kVelodyneMaxLineCount, 0.0f);
+  auto cos_pitch_table = std::vector<float>(kVelodyneMaxLineCount, 0.0f);
+
+  for (size_t i = 0; i < elevation_degrees_.size(); i++) {
+    sin_pitch_table[i] = sin(elevation_degrees_[i] * kDegreesToRadians);
+    cos_pitch_table[i] = cos(elevation_degrees_[i] * kDegreesToRadians);
+  }
+
+  auto size_of_pitch_table = sin_pitch_table.size() * sizeof(float);
+  CUDA_TRY(cudaMemcpyToSymbol(d_sin_elevation, sin_pitch_table.data(), size_of_pitch_table));
+  CUDA_TRY(cudaMemcpyToSymbol(d_cos_elevation, cos_pitch_table.data(), size_of_pitch_table));
+}
+
+void VelodyneConvertXYZHelper::ReservePackets(size_t num_packets) {
+  if (num_packets <= packets_capacity_) { return; }
+
+  // The previous upload may still be reading the buffers
+  CUDA_TRY(cudaEventSynchronize(upload_done_));
+  cudaFree(d_packets_);
+  cudaFreeHost(h_packets_);
+
+  const size_t size = num_packets * sizeof(RawVelodynePacket);
+  CUDA_TRY(cudaMalloc(reinterpret_cast<void**>(&d_packets_), size));
+  CUDA_TRY(cudaHostAlloc(reinterpret_cast<void**>(&h_packets_), size, cudaHostAllocDefault));
+  packets_capacity_ = num_packets;
+}
+
 void VelodyneConvertXYZHelper::ConvertRawPacketToDeviceXYZ(
     const data_collection::sensors::RawVelodynePacket* packet, PointXYZ* gpu_xyz_destination) {
+  ConvertRawPacketsToDeviceXYZ(&packet, 1, gpu_xyz_destination, 1, 0, 0);
+}
+
+void VelodyneConvertXYZHelper::ConvertRawPacketsToDeviceXYZ(
+    const data_collection::sensors::RawVelodynePacket* const* packets, size_t num_packets,
+    PointXYZ* gpu_xyz_ring, size_t ring_packets, size_t first_slot, cudaStream_t stream) {
   if (!initialized_) {
     initialized_ = true;
     InitSinAndCosTable();
   }
+  if (num_packets == 0) { return; }
 
-  size_t packet_size = sizeof(RawVelodynePacket);
-  CUDA_TRY(cudaMemcpy(d_packet_, packet, packet_size, cudaMemcpyHostToDevice));
+  ReservePackets(num_packets);
 
-  // Defines compute resource's size.
-  dim3 block(kVelodyneRecords, kVelodyneBlocks);
-  dim3 grid(1, 1);
+  // Gather the packets once the previous upload has consumed the staging buffer
+  CUDA_TRY(cudaEventSynchronize(upload_done_));
+  for (size_t k = 0; k < num_packets; k++) { h_packets_[k] = *packets[k]; }
+
+  CUDA_TRY(cudaMemcpyAsync(d_packets_,
+                           h_packets_,
+                           num_packets * sizeof(RawVelodynePacket),
+                           cudaMemcpyHostToDevice,
+                           stream));
+  CUDA_TRY(cudaEventRecord(upload_done_, stream));
+
+  switch (model_) {
+    case VelodyneSensorModel::kVLP16:
+      LaunchConversion<VLP16Traits>(num_packets, gpu_xyz_ring, ring_packets, first_slot, stream);
+      break;
+    case VelodyneSensorModel::kVLP32C:
+    case VelodyneSensorModel::kHDL32E:
+      LaunchConversion<VLP32Traits>(num_packets, gpu_xyz_ring, ring_packets, first_slot, stream);
+      break;
+    case VelodyneSensorModel::kHDL64:
+      LaunchConversion<HDL64Traits>(num_packets, gpu_xyz_ring, ring_packets, first_slot, stream);
+      break;
+    case VelodyneSensorModel::kVLS128:
+      LaunchConversion<VLS128Traits>(num_packets, gpu_xyz_ring, ring_packets, first_slot, stream);
+      break;
+  }
+  CUDA_TRY(cudaGetLastError());
+}
 
-  ConvertRawPacketToXYZ<<<grid, block>>>(d_packet_,
-                                         reinterpret_cast<Blocks*>(gpu_xyz_destination),
-                                         d_cos_rot_table_,
-                                         d_sin_rot_table_);
+template <typename Traits>
+void VelodyneConvertXYZHelper::LaunchConversion(size_t num_packets, PointXYZ* gpu_xyz_ring,
+                                                size_t ring_packets, size_t first_slot,
+                                                cudaStream_t stream) {
+  // Defines compute resource's size: one block of 32x12 threads per packet.
+  dim3 block(kVelodyneRecords, kVelodyneBlocks);
+  dim3 grid(num_packets, 1);
 
-  return;
+  ConvertRawPacketsToXYZ<Traits>
+      <<<grid, block, 0, stream>>>(d_packets_,
+                                   reinterpret_cast<Blocks*>(gpu_xyz_ring),
+                                   ring_packets,
+                                   first_slot,
+                                   d_cos_rot_table_,
+                                   d_sin_rot_table_,
+                                   return_selection_);
 }
 
 VelodyneConvertXYZHelper::~VelodyneConvertXYZHelper() {
+  if (upload_done_ != nullptr) {
+    cudaEventSynchronize(upload_done_);
+    cudaEventDestroy(upload_done_);
+  }
   cudaFree(d_sin_rot_table_);
   cudaFree(d_cos_rot_table_);
-  cudaFree(d_packet_);
+  cudaFree(d_packets_);
+  cudaFreeHost(h_packets_);
 }
 
 }  // namespace sensors
@@ -24,6 +24,7 @@
 #include <math.h>
 #include <stdint.h>
 #include <iostream>
+#include <iterator>
 #include <vector>
 
 #include "velodyne_constants.hpp"
@@ -50,11 +51,29 @@ struct Blocks {
   Lines blocks_[kVelodyneBlocks];
 };
 
-/// @brief Helper class to convert VLP-16 packets to a list of XYZ points in device memory.
+/// @brief Velodyne sensor models the conversion kernels are instantiated for.
+enum class VelodyneSensorModel {
+  kVLP16,
+  kVLP32C,
+  kHDL32E,
+  kHDL64,
+  kVLS128,
+};
+
+/// @brief Returns kept from packets sent in dual-return mode.
+enum class VelodyneReturnSelection {
+  kAll,
+  kLast,
+  kStrongest,
+};
+
+/// @brief Helper class to convert Velodyne packets to a list of XYZ points in device memory.
 ///
 /// This class is used to convert raw Velodyne packets to a list of XYZ points via GPU.
 /// It maintains an internal table of sin and cos values for yaw and pitch angles
-/// to reuse across packet transformations.
+/// to reuse across packet transformations. Tables are single precision, and the packet
+/// geometry of each sensor model is a compile-time trait of the conversion kernel.
+/// Every supported model sends 1206-byte packets of 12 blocks of 32 records.
 /// Code is adapted from the NVIDIA Isaac DeepMap SDK.
 ///
 /// @see https://developer.nvidia.com/isaac
@@ -63,6 +82,16 @@ class VelodyneConvertXYZHelper {
   // Destructor of class. Mainly free the memory space.
   ~VelodyneConvertXYZHelper();
 
+  /// @brief Select the sensor model of the packets to convert. Defaults to the VLP-16.
+  /// @param model Sensor model.
+  /// @param elevation_degrees Elevation of each laser in degrees, by laser index. Empty to use
+  ///        the built-in table, which HDL-64 and VLS-128 lack since their angles come from the
+  ///        calibration of each unit.
+  /// @param selection Returns to keep from dual-return packets of 16 and 32 line sensors.
+  ///        Points of dropped returns are set to the origin.
+  void SetSensorModel(VelodyneSensorModel model, const std::vector<float>& elevation_degrees,
+                      VelodyneReturnSelection selection);
+
   /// @brief Convert a raw Velodyne VLP-16 packet to a list of XYZ points.
   /// @param packet The 1206-byte packet in host memory to convert.
   /// @param gpu_xyz_destination The device memory destination for 384 XYZ points.
@@ -81,18 +110,57 @@ class VelodyneConvertXYZHelper {
   void ConvertRawPacketToDeviceXYZ(const data_collection::sensors::RawVelodynePacket* packet,
                                    PointXYZ* gpu_xyz_intensity_destination);
 
+  /// @brief Convert a burst of raw Velodyne VLP-16 packets into a device ring of packet clouds.
+  /// @param packets Host pointers to the 1206-byte packets to convert.
+  /// @param num_packets Number of packets in `packets`.
+  /// @param gpu_xyz_ring The device ring of 384-point packet clouds.
+  /// @param ring_packets Number of packet clouds in the ring.
+  /// @param first_slot Ring slot receiving the first packet, later packets wrap around.
+  /// @param stream CUDA stream to run the copy and the conversion on.
+  ///
+  /// Packets are gathered into a pinned staging buffer and uploaded with a single asynchronous
+  /// copy, then converted by one kernel launch with one thread block per packet. The call
+  /// returns without waiting for the conversion; the staging buffer is only reused once the
+  /// previous upload on the stream is done.
+  void ConvertRawPacketsToDeviceXYZ(
+      const data_collection::sensors::RawVelodynePacket* const* packets, size_t num_packets,
+      PointXYZ* gpu_xyz_ring, size_t ring_packets, size_t first_slot, cudaStream_t stream);
+
  private:
   // Initialize all yaw table and pitch table, and copy them into Gpu
   // constants. This function will be called when first time call
   // RawVelodynePacketToXYZIntensityGpu.
   void InitSinAndCosTable();
 
+  // Copy the sin and cos of the elevation table into Gpu constants.
+  void UploadElevationTable();
+
+  // Grow the staging and device packet buffers to hold at least num_packets packets.
+  void ReservePackets(size_t num_packets);
+
+  // Launch the conversion kernel instantiated for the sensor traits.
+  template <typename Traits>
+  void LaunchConversion(size_t num_packets, PointXYZ* gpu_xyz_ring, size_t ring_packets,
+                        size_t first_slot, cudaStream_t stream);
+
+  VelodyneSensorModel model_ = VelodyneSensorModel::kVLP16;
+  VelodyneReturnSelection return_selection_ = VelodyneReturnSelection::kAll;
+  // Elevation of each laser in degrees. Host data.
+  std::vector<float> elevation_degrees_{std::begin(kVLP16PitchDegrees),
+                                        std::end(kVLP16PitchDegrees)};
+
   // sin yaw. Cross 360 degrees. GPU data. resolution 0.01 degrees.
-  double* d_sin_rot_table_;
+  float* d_sin_rot_table_ = nullptr;
   // cos yaw. Cross 360 degrees. GPU data. resolution 0.01 degrees.
-  double* d_cos_rot_table_;
+  float* d_cos_rot_table_ = nullptr;
   // Raw Velodyne packets. GPU data.
-  RawVelodynePacket* d_packet_;
+  RawVelodynePacket* d_packets_ = nullptr;
+  // Raw Velodyne packets gathered for upload. Pinned host data.
+  RawVelodynePacket* h_packets_ = nullptr;
+  // Number of packets d_packets_ and h_packets_ can hold.
+  size_t packets_capacity_ = 0;
+  // Recorded after each upload, h_packets_ may be overwritten once it completes.
+  cudaEvent_t upload_done_ = nullptr;
   // If this flag is false. When calling RawVelodynePacketToXYZIntensityGpu will
   // tries to init all tables.
   bool initialized_ = false;
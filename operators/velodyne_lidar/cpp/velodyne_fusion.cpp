@@ -0,0 +1,261 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights
+ * reserved. SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velodyne_fusion.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#include "velodyne_cloud_tensor.hpp"
+
+#define CUDA_TRY(stmt)                                                                  \
+  {                                                                                     \
+    cudaError_t cuda_status = stmt;                                                     \
+    if (cudaSuccess != cuda_status) {                                                   \
+      HOLOSCAN_LOG_ERROR("Runtime call {} in line {} of file {} failed with '{}' ({})", \
+                         #stmt,                                                         \
+                         __LINE__,                                                      \
+                         __FILE__,                                                      \
+                         cudaGetErrorString(cuda_status),                               \
+                         static_cast<int>(cuda_status));                                \
+      throw std::runtime_error("Velodyne fusion CUDA call failed");                     \
+    }                                                                                   \
+  }
+
+namespace holoscan::ops {
+
+namespace {
+
+constexpr int64_t kMicrosecondsPerHour = 3600LL * 1000 * 1000;
+
+// Seconds from b to a, packet timestamps wrap around every hour
+float hour_time_diff(uint32_t a, uint32_t b) {
+  int64_t diff = static_cast<int64_t>(a) - static_cast<int64_t>(b);
+  if (diff > kMicrosecondsPerHour / 2) {
+    diff -= kMicrosecondsPerHour;
+  } else if (diff < -kMicrosecondsPerHour / 2) {
+    diff += kMicrosecondsPerHour;
+  }
+  return static_cast<float>(diff * 1e-6);
+}
+
+// Row-major rotation Rz(yaw) Ry(pitch) Rx(roll) followed by the translation
+std::array<float, 12> extrinsic_transform(const std::vector<float>& pose) {
+  const float cr = std::cos(pose[3]), sr = std::sin(pose[3]);
+  const float cp = std::cos(pose[4]), sp = std::sin(pose[4]);
+  const float cy = std::cos(pose[5]), sy = std::sin(pose[5]);
+  return {cy * cp, cy * sp * sr - sy * cr, cy * sp * cr + sy * sr,
+          sy * cp, sy * sp * sr + cy * cr, sy * sp * cr - cy * sr,
+          -sp,     cp * sr,                cp * cr,
+          pose[0], pose[1],                pose[2]};
+}
+
+}  // namespace
+
+void VelodyneFusionOp::setup(OperatorSpec& spec) {
+  // One sweep per sensor, in the order of the extrinsics.
+  spec.input<std::vector<holoscan::TensorMap>>("clouds_in", IOSpec::kAnySize);
+  // Optional vehicle velocity, the last one received is used for motion compensation.
+  spec.input<VelodyneOdometry>("odometry_in").condition(ConditionType::kNone);
+  // The merged point cloud tensor.
+  spec.output<holoscan::TensorMap>("cloud_out");
+
+  spec.param<std::vector<std::vector<float>>>(
+      extrinsics_,
+      "extrinsics",
+      "Extrinsics",
+      "Pose of each sensor in the vehicle frame: x, y, z in meters, roll, pitch, yaw in radians");
+  spec.param<size_t>(max_points_,
+                     "max_points",
+                     "Maximum points",
+                     "Largest merged cloud, the points of later sensors beyond it are dropped",
+                     1 << 20);
+  spec.param<float>(max_time_offset_,
+                    "max_time_offset",
+                    "Maximum time offset",
+                    "Leave out sweeps ending this many seconds before the newest, 0 to keep all",
+                    0.05f);
+  spec.param<bool>(deskew_,
+                   "deskew",
+                   "Deskew",
+                   "Spread the point times of a sweep between its first and last packet",
+                   true);
+  spec.param<float>(min_range_,
+                    "min_range",
+                    "Minimum range",
+                    "Drop merged points closer than this to the vehicle origin, 0 to keep them",
+                    0.0f);
+  spec.param<float>(max_range_,
+                    "max_range",
+                    "Maximum range",
+                    "Drop merged points farther than this in meters, 0 for no limit",
+                    0.0f);
+  spec.param<float>(voxel_size_,
+                    "voxel_size",
+                    "Voxel size",
+                    "Downsample the merged cloud to one point per voxel of this edge, 0 to skip",
+                    0.0f);
+}
+
+VelodyneFusionOp::~VelodyneFusionOp() {
+  if (stream_ != nullptr) {
+    cudaStreamSynchronize(stream_);
+    cudaStreamDestroy(stream_);
+  }
+}
+
+void VelodyneFusionOp::initialize() {
+  holoscan::Operator::initialize();
+
+  for (const auto& pose : extrinsics_.get()) {
+    if (pose.size() != 6) {
+      HOLOSCAN_LOG_ERROR("Expected x, y, z, roll, pitch, yaw extrinsics, got {} values",
+                         pose.size());
+      throw std::runtime_error("Invalid extrinsics");
+    }
+    transforms_.push_back(extrinsic_transform(pose));
+  }
+  if (transforms_.empty()) { throw std::runtime_error("No sensor extrinsics"); }
+
+  CUDA_TRY(cudaStreamCreateWithFlags(&stream_, cudaStreamNonBlocking));
+  fusion_ = std::make_unique<data_collection::sensors::VelodyneCloudFusion>(transforms_.size());
+  if (min_range_.get() > 0 || max_range_.get() > 0 || voxel_size_.get() > 0) {
+    filter_ = std::make_unique<data_collection::sensors::VelodyneSweepFilter>(
+        max_points_.get(), min_range_.get(), max_range_.get(), voxel_size_.get());
+  }
+}
+
+size_t VelodyneFusionOp::collect_clouds(const std::vector<holoscan::TensorMap>& clouds) {
+  // Sweeps are aligned on the end of the newest one
+  struct SweepTimes {
+    bool valid = false;
+    uint32_t start_us = 0;
+    uint32_t end_us = 0;
+  };
+  std::vector<SweepTimes> times(clouds.size());
+  const SweepTimes* newest = nullptr;
+  for (size_t s = 0; s < clouds.size(); s++) {
+    auto time_tensor = clouds[s].find("sweep_time_us");
+    if (time_tensor == clouds[s].end()) { continue; }
+    const auto* sweep_times = static_cast<const uint32_t*>(time_tensor->second->data());
+    times[s] = {true, sweep_times[0], sweep_times[1]};
+    if (newest == nullptr || hour_time_diff(times[s].end_us, newest->end_us) > 0) {
+      newest = &times[s];
+    }
+  }
+
+  sensor_clouds_.clear();
+  size_t num_points = 0;
+  for (size_t s = 0; s < clouds.size(); s++) {
+    auto xyz = clouds[s].find("xyz");
+    if (xyz == clouds[s].end()) {
+      HOLOSCAN_LOG_ERROR("Cloud of sensor {} has no xyz tensor", s);
+      continue;
+    }
+    const size_t sensor_points = xyz->second->shape()[0];
+
+    data_collection::sensors::FusionSensorCloud cloud{};
+    if (times[s].valid) {
+      const float end_offset = hour_time_diff(times[s].end_us, newest->end_us);
+      if (max_time_offset_.get() > 0 && -end_offset > max_time_offset_.get()) {
+        if (dropped_sweeps_++ % 100 == 0) {
+          HOLOSCAN_LOG_WARN("Sweep of sensor {} is {} s behind the newest, leaving it out",
+                            s, -end_offset);
+        }
+        continue;
+      }
+      const float duration = hour_time_diff(times[s].end_us, times[s].start_us);
+      if (deskew_.get() && sensor_points > 1) {
+        cloud.time_offset = end_offset - duration;
+        cloud.time_step = duration / (sensor_points - 1);
+      } else {
+        cloud.time_offset = end_offset - duration / 2;
+      }
+    }
+
+    if (num_points + sensor_points > max_points_.get()) {
+      HOLOSCAN_LOG_WARN("Merged cloud exceeds {} points, truncating", max_points_.get());
+      if (num_points == max_points_.get()) { break; }
+    }
+    cloud.d_points = static_cast<const data_collection::sensors::PointXYZ*>(xyz->second->data());
+    cloud.num_points = std::min(sensor_points, max_points_.get() - num_points);
+    cloud.first_point = num_points;
+    std::memcpy(cloud.rotation, transforms_[s].data(), sizeof(cloud.rotation));
+    std::memcpy(cloud.translation, transforms_[s].data() + 9, sizeof(cloud.translation));
+    sensor_clouds_.push_back(cloud);
+    num_points += cloud.num_points;
+  }
+  return num_points;
+}
+
+void VelodyneFusionOp::compute(holoscan::InputContext& op_input,
+                               holoscan::OutputContext& op_output,
+                               holoscan::ExecutionContext&) {
+  auto clouds = op_input.receive<std::vector<holoscan::TensorMap>>("clouds_in").value();
+  if (clouds.size() != transforms_.size()) {
+    HOLOSCAN_LOG_ERROR("Received {} clouds for {} sensor extrinsics",
+                       clouds.size(),
+                       transforms_.size());
+    throw std::runtime_error("Cloud count does not match the extrinsics");
+  }
+  if (auto odometry = op_input.receive<VelodyneOdometry>("odometry_in")) {
+    odometry_ = odometry.value();
+    has_odometry_ = true;
+  }
+
+  const size_t num_points = collect_clouds(clouds);
+  if (num_points == 0) { return; }
+
+  // Without odometry the sweeps are only transformed, not moved in time
+  const VelodyneOdometry motion = has_odometry_ ? odometry_ : VelodyneOdometry{};
+  using data_collection::sensors::PointXYZ;
+  PointXYZ* merged;
+  CUDA_TRY(cudaMallocAsync(
+      reinterpret_cast<void**>(&merged), num_points * sizeof(PointXYZ), stream_));
+  fusion_->Merge(sensor_clouds_,
+                 motion.linear_velocity.data(),
+                 motion.angular_velocity.data(),
+                 merged,
+                 stream_);
+
+  PointXYZ* cloud = merged;
+  size_t cloud_points = num_points;
+  if (filter_) {
+    CUDA_TRY(
+        cudaMallocAsync(reinterpret_cast<void**>(&cloud), num_points * sizeof(PointXYZ), stream_));
+    cloud_points = filter_->Apply(merged, num_points, cloud, stream_);
+    CUDA_TRY(cudaFreeAsync(merged, stream_));
+  }
+
+  // The stream is synchronized before the cloud is emitted, later frees need no ordering
+  CUDA_TRY(cudaStreamSynchronize(stream_));
+  auto release = [](float* buffer) { CUDA_TRY(cudaFreeAsync(buffer, 0)); };
+  if (cloud_points == 0) {
+    release(reinterpret_cast<float*>(cloud));
+    return;
+  }
+
+  TensorMap out_message;
+  out_message.insert({"xyz",
+                      wrap_device_cloud(reinterpret_cast<float*>(cloud),
+                                        {static_cast<int>(cloud_points), 3},
+                                        release)});
+  op_output.emit(out_message);
+}
+
+}  // namespace holoscan::ops
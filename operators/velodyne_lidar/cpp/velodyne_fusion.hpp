@@ -0,0 +1,93 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights
+ * reserved. SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef HOLOSCAN_OPERATORS_VELODYNE_FUSION_HPP
+#define HOLOSCAN_OPERATORS_VELODYNE_FUSION_HPP
+
+#include <array>
+#include <memory>
+#include <vector>
+
+#include <holoscan/holoscan.hpp>
+
+#include "velodyne_cloud_fusion.hpp"
+#include "velodyne_sweep_filter.hpp"
+
+namespace holoscan::ops {
+
+/// Velocity of the vehicle in its own frame, received by VelodyneFusionOp for motion
+/// compensation.
+struct VelodyneOdometry {
+  /// Linear velocity in m/s.
+  std::array<float, 3> linear_velocity{};
+  /// Angular velocity in rad/s.
+  std::array<float, 3> angular_velocity{};
+};
+
+/**
+ * @brief Operator class to fuse the sweeps of several Velodyne lidars into one point cloud.
+ *
+ * Receives one sweep per sensor from VelodyneLidarOp operators in "sweep" output mode, one
+ * connection per sensor on "clouds_in" in the order of `extrinsics`, and emits a single cloud
+ * in the vehicle frame per set of sweeps. Every sensor is transformed by its extrinsic in one
+ * kernel launch, and the merged cloud is optionally range-cropped and voxel-downsampled.
+ *
+ * When the sensors emit their sweep times (`emit_sweep_times`), sweeps are aligned on the
+ * newest one: sweeps more than `max_time_offset` older are left out, and with odometry on
+ * "odometry_in" every point is moved to the reference time with a constant velocity model.
+ * With `deskew`, the times of the points of a sweep are spread between its first and last
+ * packets, which needs the point order of unfiltered sweeps.
+ */
+class VelodyneFusionOp : public Operator {
+ public:
+  HOLOSCAN_OPERATOR_FORWARD_ARGS(VelodyneFusionOp);
+
+  VelodyneFusionOp() = default;
+  ~VelodyneFusionOp();
+
+  void initialize() override;
+  void setup(OperatorSpec& spec) override;
+  void compute(holoscan::InputContext& op_input, holoscan::OutputContext& op_output,
+               holoscan::ExecutionContext&) override;
+
+ private:
+  // Merged points of the current sweeps, with the sensor descriptions in the merge order
+  size_t collect_clouds(const std::vector<holoscan::TensorMap>& clouds);
+
+  Parameter<std::vector<std::vector<float>>> extrinsics_;
+  Parameter<size_t> max_points_;
+  Parameter<float> max_time_offset_;
+  Parameter<bool> deskew_;
+  Parameter<float> min_range_;
+  Parameter<float> max_range_;
+  Parameter<float> voxel_size_;
+
+  // Sensor to vehicle rotation and translation of each sensor
+  std::vector<std::array<float, 12>> transforms_;
+  std::vector<data_collection::sensors::FusionSensorCloud> sensor_clouds_;
+  std::unique_ptr<data_collection::sensors::VelodyneCloudFusion> fusion_;
+  std::unique_ptr<data_collection::sensors::VelodyneSweepFilter> filter_;
+  VelodyneOdometry odometry_;
+  bool has_odometry_ = false;
+  uint64_t dropped_sweeps_ = 0;
+
+  cudaStream_t stream_ = nullptr;
+};
+
+}  // namespace holoscan::ops
+
+#endif /* HOLOSCAN_OPERATORS_VELODYNE_FUSION_HPP */
@@ -17,10 +17,14 @@
 
 #include "velodyne_lidar.hpp"
 
+#include <cstring>
+#include <map>
+
 #include <holoscan/holoscan.hpp>
 
 #include <basic_network_operator_common.h>
 
+#include "velodyne_cloud_tensor.hpp"
 #include "velodyne_constants.hpp"
 #include "velodyne_convert_xyz.hpp"
 
@@ -40,14 +44,69 @@
 
 namespace holoscan::ops {
 
+namespace {
+
+// Azimuth of the first block of a packet, in hundredths of degrees
+uint16_t packet_azimuth(const data_collection::sensors::RawVelodynePacket* packet) {
+  const auto bytes =
+      reinterpret_cast<const uint8_t*>(&packet->blocks_[0].azimuth_hundredths_degrees_);
+  return static_cast<uint16_t>(bytes[0] | (bytes[1] << 8));
+}
+
+// Timestamp of a packet, in microseconds past the hour
+uint32_t packet_time_us(const data_collection::sensors::RawVelodynePacket* packet) {
+  uint32_t time_us;
+  memcpy(&time_us, &packet->timestamp_microseconds_on_hour_, sizeof(time_us));
+  return time_us;
+}
+
+}  // namespace
+
 nvidia::gxf::Shape VelodyneLidarOp::output_cloud_shape() {
   return {static_cast<int>(VLP16_PACKET_CLOUD_SIZE * packet_buffer_size_.get()),
           CLOUD_DIMENSION};
 }
 
+VelodyneLidarOp::~VelodyneLidarOp() {
+  if (stream_ != nullptr) {
+    cudaStreamSynchronize(stream_);
+    cudaStreamDestroy(stream_);
+  }
+  cudaFree(sweep_buffer_);
+}
+
 void VelodyneLidarOp::initialize() {
   holoscan::Operator::initialize();
 
+  CUDA_TRY(cudaStreamCreateWithFlags(&stream_, cudaStreamNonBlocking));
+
+  using data_collection::sensors::VelodyneReturnSelection;
+  using data_collection::sensors::VelodyneSensorModel;
+  static const std::map<std::string, VelodyneSensorModel> kSensorModels = {
+      {"VLP-16", VelodyneSensorModel::kVLP16},
+      {"VLP-32C", VelodyneSensorModel::kVLP32C},
+      {"HDL-32E", VelodyneSensorModel::kHDL32E},
+      {"HDL-64", VelodyneSensorModel::kHDL64},
+      {"VLS-128", VelodyneSensorModel::kVLS128},
+  };
+  static const std::map<std::string, VelodyneReturnSelection> kReturnSelections = {
+      {"all", VelodyneReturnSelection::kAll},
+      {"last", VelodyneReturnSelection::kLast},
+      {"strongest", VelodyneReturnSelection::kStrongest},
+  };
+  auto model = kSensorModels.find(sensor_model_.get());
+  if (model == kSensorModels.end()) {
+    HOLOSCAN_LOG_ERROR("Unsupported sensor_model {}", sensor_model_.get());
+    throw std::runtime_error("Unsupported sensor_model");
+  }
+  auto selection = kReturnSelections.find(return_selection_.get());
+  if (selection == kReturnSelections.end()) {
+    HOLOSCAN_LOG_ERROR("Invalid return_selection {}, expected all, last or strongest",
+                       return_selection_.get());
+    throw std::runtime_error("Invalid return_selection");
+  }
+  velodyne_helper_.SetSensorModel(model->second, elevation_degrees_.get(), selection->second);
+
   // Reserve and initialize space for the cloud tensor on the device
   float* device_xyz_intensity_buffer_;
   auto cloud_shape = output_cloud_shape();
@@ -55,52 +114,177 @@ void VelodyneLidarOp::initialize() {
   CUDA_TRY(cudaMemset(device_xyz_intensity_buffer_, 0, cloud_shape.size() * sizeof(float)));
 
   // Construct Tensor from allocated device memory
-  auto primitive_type = nvidia::gxf::PrimitiveType::kFloat32;
-  auto gxf_cloud_tensor = std::make_shared<nvidia::gxf::Tensor>();
-  gxf_cloud_tensor->wrapMemory(cloud_shape,
-                               primitive_type,
-                               nvidia::gxf::PrimitiveTypeSize(primitive_type),
-                               nvidia::gxf::ComputeTrivialStrides(
-                                   cloud_shape, nvidia::gxf::PrimitiveTypeSize(primitive_type)),
-                               nvidia::gxf::MemoryStorageType::kDevice,
-                               reinterpret_cast<void*>(device_xyz_intensity_buffer_),
-                               [orig_pointer = device_xyz_intensity_buffer_](void*) mutable {
-                                 CUDA_TRY(cudaFree(orig_pointer));
-                                 return nvidia::gxf::Success;
-                               });
-  auto maybe_dl_ctx = gxf_cloud_tensor->toDLManagedTensorContext();
-  if (!maybe_dl_ctx) {
-    HOLOSCAN_LOG_ERROR(
-        "failed to get std::shared_ptr<DLManagedTensorContext> from nvidia::gxf::Tensor");
+  cloud_tensor_ = wrap_device_cloud(
+      device_xyz_intensity_buffer_, cloud_shape, [](float* buffer) { CUDA_TRY(cudaFree(buffer)); });
+
+  if (output_mode_.get() == "sweep") {
+    sweep_mode_ = true;
+    const size_t sweep_points = sweep_buffer_size_.get() * VLP16_PACKET_CLOUD_SIZE;
+    CUDA_TRY(cudaMalloc(&sweep_buffer_, sweep_points * sizeof(PointXYZ)));
+    if (min_range_.get() > 0 || max_range_.get() > 0 || voxel_size_.get() > 0) {
+      sweep_filter_ = std::make_unique<data_collection::sensors::VelodyneSweepFilter>(
+          sweep_points, min_range_.get(), max_range_.get(), voxel_size_.get());
+    }
+  } else if (output_mode_.get() != "ring") {
+    HOLOSCAN_LOG_ERROR("Invalid output_mode {}, expected ring or sweep", output_mode_.get());
+    throw std::runtime_error("Invalid output_mode");
   }
-  cloud_tensor_ = std::make_shared<Tensor>(maybe_dl_ctx.value());
+}
+
+void VelodyneLidarOp::append_to_sweep(size_t begin, size_t end) {
+  if (begin == end) { return; }
+  if (sweep_packets_ == 0) { sweep_start_us_ = packet_time_us(packets_[begin]); }
+  sweep_end_us_ = packet_time_us(packets_[end - 1]);
+  velodyne_helper_.ConvertRawPacketsToDeviceXYZ(packets_.data() + begin,
+                                                end - begin,
+                                                sweep_buffer_,
+                                                sweep_buffer_size_.get(),
+                                                sweep_packets_,
+                                                stream_);
+  sweep_packets_ += end - begin;
+}
+
+std::shared_ptr<holoscan::Tensor> VelodyneLidarOp::finish_sweep() {
+  const size_t num_points = sweep_packets_ * VLP16_PACKET_CLOUD_SIZE;
+  sweep_packets_ = 0;
+  finished_sweep_times_us_ = {sweep_start_us_, sweep_end_us_};
+  if (num_points == 0) { return nullptr; }
+
+  // Each sweep gets its own buffer since downstream may still hold the previous one
+  PointXYZ* cloud;
+  CUDA_TRY(
+      cudaMallocAsync(reinterpret_cast<void**>(&cloud), num_points * sizeof(PointXYZ), stream_));
+  size_t cloud_points = num_points;
+  if (sweep_filter_) {
+    cloud_points = sweep_filter_->Apply(sweep_buffer_, num_points, cloud, stream_);
+  } else {
+    CUDA_TRY(cudaMemcpyAsync(
+        cloud, sweep_buffer_, num_points * sizeof(PointXYZ), cudaMemcpyDeviceToDevice, stream_));
+  }
+
+  // The stream is synchronized before the cloud is emitted, later frees need no ordering
+  auto release = [](float* buffer) { CUDA_TRY(cudaFreeAsync(buffer, 0)); };
+  if (cloud_points == 0) {
+    CUDA_TRY(cudaStreamSynchronize(stream_));
+    release(reinterpret_cast<float*>(cloud));
+    return nullptr;
+  }
+  return wrap_device_cloud(reinterpret_cast<float*>(cloud),
+                           {static_cast<int>(cloud_points), CLOUD_DIMENSION},
+                           release);
+}
+
+void VelodyneLidarOp::compute_sweep(holoscan::OutputContext& op_output) {
+  std::shared_ptr<holoscan::Tensor> sweep;
+  size_t begin = 0;
+
+  for (size_t k = 0; k < packets_.size(); k++) {
+    // A large backwards jump of the azimuth marks the start of a revolution
+    const uint16_t azimuth = packet_azimuth(packets_[k]);
+    const bool wrapped = azimuth + data_collection::sensors::kVelodyneMaxAzimuth / 2 <
+                         last_azimuth_;
+    last_azimuth_ = azimuth;
+
+    if (!sweep_synced_) {
+      if (wrapped) {
+        sweep_synced_ = true;
+        begin = k;
+      }
+      continue;
+    }
+
+    const bool full = sweep_packets_ + (k - begin) == sweep_buffer_size_.get();
+    if (full) {
+      HOLOSCAN_LOG_WARN("Sweep exceeds {} packets, emitting a partial revolution",
+                        sweep_buffer_size_.get());
+    }
+    if (wrapped || full) {
+      append_to_sweep(begin, k);
+      begin = k;
+      // Sweeps completed earlier in the same burst are superseded by this one
+      sweep = finish_sweep();
+    }
+  }
+  if (sweep_synced_) { append_to_sweep(begin, packets_.size()); }
+
+  if (!sweep) { return; }
+
+  CUDA_TRY(cudaStreamSynchronize(stream_));
+  TensorMap out_message;
+  out_message.insert({"xyz", sweep});
+  if (emit_sweep_times_.get()) {
+    auto times = new uint32_t[2]{finished_sweep_times_us_[0], finished_sweep_times_us_[1]};
+    out_message.insert({"sweep_time_us",
+                        wrap_tensor_memory(times,
+                                           {2},
+                                           nvidia::gxf::PrimitiveType::kUnsigned32,
+                                           nvidia::gxf::MemoryStorageType::kSystem,
+                                           [](void* buffer) {
+                                             delete[] static_cast<uint32_t*>(buffer);
+                                           })});
+  }
+  op_output.emit(out_message);
 }
 
 void VelodyneLidarOp::compute(holoscan::InputContext& op_input, holoscan::OutputContext& op_output,
                               holoscan::ExecutionContext& context) {
-  // Advance our cloud ring buffer by one packet's cloud size on each tick, regardless of whether
-  // the packet can be parsed.
-  packet_buffer_index_ = (packet_buffer_index_ + 1) % packet_buffer_size_;
-
   auto data = op_input.receive<std::shared_ptr<NetworkOpBurstParams>>("burst_in");
-  HOLOSCAN_LOG_DEBUG("First packet byte: " + std::to_string((*data)->data[0]) +
-                     ", Last packet byte: " + std::to_string((*data)->data[(*data)->len - 1]) +
-                     ", Length: " + std::to_string((*data)->len) +
-                     ", Num packets: " + std::to_string((*data)->num_pkts));
+  const auto& burst = *data;
+  HOLOSCAN_LOG_DEBUG("First packet byte: " + std::to_string(burst->data[0]) +
+                     ", Last packet byte: " + std::to_string(burst->data[burst->len - 1]) +
+                     ", Length: " + std::to_string(burst->len) +
+                     ", Num packets: " + std::to_string(burst->num_pkts));
+
+  // Collect the VLP-16 packets of the burst. Strided bursts carry per-packet lengths and
+  // packets of another size are skipped, packed bursts must only hold VLP-16 packets.
+  packets_.clear();
+  if (burst->stride > 0) {
+    for (uint32_t i = 0; i < burst->num_pkts; i++) {
+      const uint32_t len = burst->pkt_lens.empty() ? burst->stride : burst->pkt_lens[i];
+      if (len != VLP16_PACKET_SIZE) { continue; }
+      packets_.push_back(reinterpret_cast<const data_collection::sensors::RawVelodynePacket*>(
+          burst->data + static_cast<size_t>(i) * burst->stride));
+    }
+  } else if (burst->len == static_cast<size_t>(burst->num_pkts) * VLP16_PACKET_SIZE) {
+    for (uint32_t i = 0; i < burst->num_pkts; i++) {
+      packets_.push_back(reinterpret_cast<const data_collection::sensors::RawVelodynePacket*>(
+          burst->data + static_cast<size_t>(i) * VLP16_PACKET_SIZE));
+    }
+  }
 
-  if ((*data)->len != VLP16_PACKET_SIZE) {
+  if (packets_.size() < burst->num_pkts) {
     HOLOSCAN_LOG_ERROR(
         "Received data length does not match expected VLP16 packet size. Expected: " +
-        std::to_string(VLP16_PACKET_SIZE) + ", Received: " + std::to_string((*data)->len));
+        std::to_string(VLP16_PACKET_SIZE) + " per packet, Received: " +
+        std::to_string(burst->len) + " bytes in " + std::to_string(burst->num_pkts) +
+        " packets");
+    if (packets_.empty()) { return; }
+  }
+
+  if (sweep_mode_) {
+    compute_sweep(op_output);
     return;
   }
 
-  velodyne_helper_.ConvertRawPacketToDeviceXYZ(
-      reinterpret_cast<data_collection::sensors::RawVelodynePacket*>((*data)->data),
-      reinterpret_cast<data_collection::sensors::PointXYZ*>(
-          reinterpret_cast<float*>(cloud_tensor_->data()) +
-          (packet_buffer_index_ * VLP16_PACKET_CLOUD_SIZE * CLOUD_DIMENSION)));
-  HOLOSCAN_LOG_DEBUG("Done processing Velodyne packet.");
+  // Only the newest packet_buffer_size packets of a large burst survive in the ring
+  const size_t ring_packets = packet_buffer_size_.get();
+  const size_t skipped = packets_.size() > ring_packets ? packets_.size() - ring_packets : 0;
+  const size_t first_slot = (packet_buffer_index_ + 1 + skipped) % ring_packets;
+
+  velodyne_helper_.ConvertRawPacketsToDeviceXYZ(
+      packets_.data() + skipped,
+      packets_.size() - skipped,
+      reinterpret_cast<data_collection::sensors::PointXYZ*>(cloud_tensor_->data()),
+      ring_packets,
+      first_slot,
+      stream_);
+
+  // Advance our cloud ring buffer by one packet's cloud size per converted packet
+  packet_buffer_index_ = (packet_buffer_index_ + packets_.size()) % ring_packets;
+
+  // Downstream operators read the cloud on their own streams
+  CUDA_TRY(cudaStreamSynchronize(stream_));
+  HOLOSCAN_LOG_DEBUG("Done processing {} Velodyne packets.", packets_.size());
 
   TensorMap out_message;
   out_message.insert({"xyz", cloud_tensor_});
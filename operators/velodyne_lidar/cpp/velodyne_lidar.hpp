@@ -18,6 +18,7 @@
 #ifndef HOLOSCAN_OPERATORS_VELODYNE_LIDAR_HPP
 #define HOLOSCAN_OPERATORS_VELODYNE_LIDAR_HPP
 
+#include <array>
 #include <memory>
 #include <string>
 #include <vector>
@@ -26,6 +27,7 @@
 
 #include <basic_network_operator_common.h>
 #include "velodyne_convert_xyz.hpp"
+#include "velodyne_sweep_filter.hpp"
 
 namespace holoscan::ops {
 
@@ -36,13 +38,21 @@ namespace holoscan::ops {
  * processes them into a point cloud of fixed size in Cartesian space.
  *
  * The operator performs the following steps:
- * 1. Interpret a fixed-size UDP packet as a Velodyne VLP-16 lidar packet,
+ * 1. Interpret each fixed-size UDP packet of a burst as a Velodyne VLP-16 lidar packet,
  *    which contains 12 data blocks (azimuths) and 32 spherical data points per block.
+ *    Bursts may hold several packets, packed back to back or strided, and are converted with
+ *    a single upload and kernel launch.
  * 2. Transform the spherical data points into Cartesian coordinates (x, y, z)
  *    and add them to the output point cloud tensor, overwriting a previous cloud segment.
  * 3. Output the point cloud tensor and update the tensor insertion pointer to prepare
  *    for the next incoming packet.
  *
+ * In "sweep" output mode, packets are instead accumulated until the azimuth wraps around and
+ * exactly one cloud per revolution is emitted, optionally range-cropped and voxel-downsampled
+ * on the GPU first. With emit_sweep_times, the message also holds a "sweep_time_us" host
+ * tensor with the timestamps of the first and last packet of the sweep, as used by
+ * VelodyneFusionOp.
+ *
  * We recommend relying on HoloHub networking operators to receive Velodyne VLP-16 lidar packets
  * over UDP/IP and forward them to this operator.
  *
@@ -68,6 +78,7 @@ class VelodyneLidarOp : public Operator {
   HOLOSCAN_OPERATOR_FORWARD_ARGS(VelodyneLidarOp);
 
   VelodyneLidarOp() = default;
+  ~VelodyneLidarOp();
 
   void initialize() override;
   void setup(OperatorSpec& spec) override {
@@ -84,6 +95,52 @@ class VelodyneLidarOp : public Operator {
                        "Packet buffer size",
                        "Ring buffer size for incoming packets",
                        80);
+
+    spec.param<std::string>(sensor_model_,
+                            "sensor_model",
+                            "Sensor model",
+                            "Velodyne model: VLP-16, VLP-32C, HDL-32E, HDL-64 or VLS-128",
+                            std::string("VLP-16"));
+    spec.param<std::vector<float>>(elevation_degrees_,
+                                   "elevation_degrees",
+                                   "Elevation degrees",
+                                   "Elevation of each laser by index, required for HDL-64/VLS-128",
+                                   std::vector<float>{});
+    spec.param<std::string>(return_selection_,
+                            "return_selection",
+                            "Return selection",
+                            "Returns kept in dual-return mode: all, last or strongest",
+                            std::string("all"));
+    spec.param<std::string>(output_mode_,
+                            "output_mode",
+                            "Output mode",
+                            "ring: emit the ring on every packet, sweep: emit each revolution",
+                            std::string("ring"));
+    spec.param<size_t>(sweep_buffer_size_,
+                       "sweep_buffer_size",
+                       "Sweep buffer size",
+                       "Largest revolution in packets in sweep mode",
+                       256);
+    spec.param<float>(min_range_,
+                      "min_range",
+                      "Minimum range",
+                      "Drop sweep points closer than this in meters, 0 to keep them",
+                      0.0f);
+    spec.param<float>(max_range_,
+                      "max_range",
+                      "Maximum range",
+                      "Drop sweep points farther than this in meters, 0 for no limit",
+                      0.0f);
+    spec.param<float>(voxel_size_,
+                      "voxel_size",
+                      "Voxel size",
+                      "Downsample sweeps to one point per voxel of this edge in meters, 0 to skip",
+                      0.0f);
+    spec.param<bool>(emit_sweep_times_,
+                     "emit_sweep_times",
+                     "Emit sweep times",
+                     "Add the first and last packet timestamps of each sweep to its message",
+                     false);
   };
 
   void compute(holoscan::InputContext& op_input, holoscan::OutputContext& op_output,
@@ -96,9 +153,29 @@ class VelodyneLidarOp : public Operator {
   // user parameter at the time the operator is initialized.
   nvidia::gxf::Shape output_cloud_shape();
 
+  // @brief Accumulates the packets of the current burst into sweeps, emitting the last one
+  // completed.
+  void compute_sweep(holoscan::OutputContext& op_output);
+
+  // @brief Converts packets [begin, end) of the current burst into the sweep buffer.
+  void append_to_sweep(size_t begin, size_t end);
+
+  // @brief Filters the sweep buffer into a new cloud tensor and starts a new sweep.
+  // Returns nullptr if no point is left.
+  std::shared_ptr<holoscan::Tensor> finish_sweep();
+
  private:
   // Size of the point cloud tensor buffer in terms of discrete packets.
   Parameter<size_t> packet_buffer_size_;
+  Parameter<std::string> sensor_model_;
+  Parameter<std::vector<float>> elevation_degrees_;
+  Parameter<std::string> return_selection_;
+  Parameter<std::string> output_mode_;
+  Parameter<size_t> sweep_buffer_size_;
+  Parameter<float> min_range_;
+  Parameter<float> max_range_;
+  Parameter<float> voxel_size_;
+  Parameter<bool> emit_sweep_times_;
 
   // Helper class to convert Velodyne packets to Cartesian data points
   data_collection::sensors::VelodyneConvertXYZHelper velodyne_helper_;
@@ -114,6 +191,26 @@ class VelodyneLidarOp : public Operator {
   // An increasing index to keep track of the number of packets processed.
   // Used to determine where points from the next packet should be inserted into the cloud buffer.
   size_t packet_buffer_index_ = 0;
+
+  // Stream for the packet uploads and conversions of this operator.
+  cudaStream_t stream_ = nullptr;
+
+  // Host pointers to the valid VLP-16 packets of the current burst.
+  std::vector<const data_collection::sensors::RawVelodynePacket*> packets_;
+
+  // Sweep mode state. The sweep buffer holds up to sweep_buffer_size_ packet clouds.
+  bool sweep_mode_ = false;
+  PointXYZ* sweep_buffer_ = nullptr;
+  size_t sweep_packets_ = 0;
+  // Packets before the first wrap-around are dropped so that every sweep is a full revolution
+  bool sweep_synced_ = false;
+  uint16_t last_azimuth_ = 0;
+  // Packet timestamps of the sweep being accumulated and of the last one finished, in
+  // microseconds past the hour
+  uint32_t sweep_start_us_ = 0;
+  uint32_t sweep_end_us_ = 0;
+  std::array<uint32_t, 2> finished_sweep_times_us_{};
+  std::unique_ptr<data_collection::sensors::VelodyneSweepFilter> sweep_filter_;
 };
 
 }  // namespace holoscan::ops
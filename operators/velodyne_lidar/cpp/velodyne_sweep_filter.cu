@@ -0,0 +1,181 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2024 NVIDIA CORPORATION & AFFILIATES. All rights
+ * reserved. SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velodyne_sweep_filter.hpp"
+
+#include <holoscan/holoscan.hpp>
+
+#define CUDA_TRY(stmt)                                                                  \
+  {                                                                                     \
+    cudaError_t cuda_status = stmt;                                                     \
+    if (cudaSuccess != cuda_status) {                                                   \
+      HOLOSCAN_LOG_ERROR("Runtime call {} in line {} of file {} failed with '{}' ({})", \
+                         #stmt,                                                         \
+                         __LINE__,                                                      \
+                         __FILE__,                                                      \
+                         cudaGetErrorString(cuda_status),                               \
+                         static_cast<int>(cuda_status));                                \
+      throw std::runtime_error("Velodyne sweep filter CUDA call failed");               \
+    }                                                                                   \
+  }
+
+namespace data_collection {
+namespace sensors {
+
+namespace {
+
+constexpr unsigned long long kEmptyVoxel = ~0ULL;
+constexpr int kThreadsPerBlock = 256;
+
+// Voxel coordinates are packed on 21 bits each, i.e. +-1M voxels around the sensor.
+__device__ unsigned long long PackVoxel(const PointXYZ& p, float inv_voxel_size) {
+  const auto pack = [](float v) {
+    return static_cast<unsigned long long>(static_cast<int>(floorf(v)) + (1 << 20)) & 0x1FFFFF;
+  };
+  return (pack(p.x * inv_voxel_size) << 42) | (pack(p.y * inv_voxel_size) << 21) |
+         pack(p.z * inv_voxel_size);
+}
+
+__device__ uint32_t HashVoxel(unsigned long long key) {
+  key ^= key >> 33;
+  key *= 0xff51afd7ed558ccdULL;
+  key ^= key >> 33;
+  return static_cast<uint32_t>(key);
+}
+
+/// @brief Keep the points within [min_range, max_range] of the sensor, compacted into d_out.
+__global__ void CropRange(const PointXYZ* d_in, uint32_t num_points, float min_range2,
+                          float max_range2, PointXYZ* d_out, uint32_t* d_num_out) {
+  const uint32_t idx = blockIdx.x * blockDim.x + threadIdx.x;
+  if (idx >= num_points) { return; }
+
+  const PointXYZ p = d_in[idx];
+  const float range2 = p.x * p.x + p.y * p.y + p.z * p.z;
+  if (range2 < min_range2 || range2 > max_range2) { return; }
+  d_out[atomicAdd(d_num_out, 1)] = p;
+}
+
+/// @brief Accumulate each point into the hash table slot of its voxel.
+__global__ void InsertVoxels(const PointXYZ* d_in, const uint32_t* d_num_points,
+                             float inv_voxel_size, unsigned long long* d_keys, float3* d_sums,
+                             uint32_t* d_counts, uint32_t table_mask) {
+  const uint32_t idx = blockIdx.x * blockDim.x + threadIdx.x;
+  if (idx >= *d_num_points) { return; }
+
+  const PointXYZ p = d_in[idx];
+  const unsigned long long key = PackVoxel(p, inv_voxel_size);
+  uint32_t slot = HashVoxel(key) & table_mask;
+  for (;;) {
+    const unsigned long long prev = atomicCAS(&d_keys[slot], kEmptyVoxel, key);
+    if (prev == kEmptyVoxel || prev == key) { break; }
+    slot = (slot + 1) & table_mask;
+  }
+  atomicAdd(&d_sums[slot].x, p.x);
+  atomicAdd(&d_sums[slot].y, p.y);
+  atomicAdd(&d_sums[slot].z, p.z);
+  atomicAdd(&d_counts[slot], 1);
+}
+
+/// @brief Write the centroid of every occupied voxel, compacted into d_out.
+__global__ void EmitVoxels(const float3* d_sums, const uint32_t* d_counts, uint32_t table_size,
+                           PointXYZ* d_out, uint32_t* d_num_out) {
+  const uint32_t slot = blockIdx.x * blockDim.x + threadIdx.x;
+  if (slot >= table_size || d_counts[slot] == 0) { return; }
+
+  const float inv_count = 1.0f / d_counts[slot];
+  const float3 sum = d_sums[slot];
+  d_out[atomicAdd(d_num_out, 1)] = {sum.x * inv_count, sum.y * inv_count, sum.z * inv_count};
+}
+
+uint32_t NumBlocks(size_t num_threads) {
+  return static_cast<uint32_t>((num_threads + kThreadsPerBlock - 1) / kThreadsPerBlock);
+}
+
+}  // namespace
+
+VelodyneSweepFilter::VelodyneSweepFilter(size_t max_points, float min_range, float max_range,
+                                         float voxel_size)
+    : max_points_(max_points),
+      min_range_(min_range),
+      max_range_(max_range),
+      voxel_size_(voxel_size) {
+  CUDA_TRY(cudaMalloc(reinterpret_cast<void**>(&d_num_points_), sizeof(uint32_t)));
+  CUDA_TRY(cudaHostAlloc(
+      reinterpret_cast<void**>(&h_num_points_), sizeof(uint32_t), cudaHostAllocDefault));
+
+  if (voxel_size_ <= 0) { return; }
+
+  // Half-empty table keeps the linear probes short
+  table_size_ = 1;
+  while (table_size_ < 2 * max_points_) { table_size_ <<= 1; }
+  CUDA_TRY(cudaMalloc(reinterpret_cast<void**>(&d_cropped_), max_points_ * sizeof(PointXYZ)));
+  CUDA_TRY(cudaMalloc(reinterpret_cast<void**>(&d_keys_), table_size_ * sizeof(*d_keys_)));
+  CUDA_TRY(cudaMalloc(reinterpret_cast<void**>(&d_sums_), table_size_ * sizeof(*d_sums_)));
+  CUDA_TRY(cudaMalloc(reinterpret_cast<void**>(&d_counts_), table_size_ * sizeof(*d_counts_)));
+}
+
+VelodyneSweepFilter::~VelodyneSweepFilter() {
+  cudaFree(d_cropped_);
+  cudaFree(d_keys_);
+  cudaFree(d_sums_);
+  cudaFree(d_counts_);
+  cudaFree(d_num_points_);
+  cudaFreeHost(h_num_points_);
+}
+
+size_t VelodyneSweepFilter::Apply(const PointXYZ* d_in, size_t num_points, PointXYZ* d_out,
+                                  cudaStream_t stream) {
+  if (num_points == 0) { return 0; }
+  if (num_points > max_points_) {
+    HOLOSCAN_LOG_ERROR("Sweep of {} points exceeds the filter capacity of {}, truncating",
+                       num_points,
+                       max_points_);
+    num_points = max_points_;
+  }
+
+  const float max_range = max_range_ > 0 ? max_range_ : INFINITY;
+  PointXYZ* d_cropped = voxel_size_ > 0 ? d_cropped_ : d_out;
+  CUDA_TRY(cudaMemsetAsync(d_num_points_, 0, sizeof(uint32_t), stream));
+  CropRange<<<NumBlocks(num_points), kThreadsPerBlock, 0, stream>>>(d_in,
+                                                                     num_points,
+                                                                     min_range_ * min_range_,
+                                                                     max_range * max_range,
+                                                                     d_cropped,
+                                                                     d_num_points_);
+
+  if (voxel_size_ > 0) {
+    CUDA_TRY(cudaMemsetAsync(d_keys_, 0xFF, table_size_ * sizeof(*d_keys_), stream));
+    CUDA_TRY(cudaMemsetAsync(d_sums_, 0, table_size_ * sizeof(*d_sums_), stream));
+    CUDA_TRY(cudaMemsetAsync(d_counts_, 0, table_size_ * sizeof(*d_counts_), stream));
+    InsertVoxels<<<NumBlocks(num_points), kThreadsPerBlock, 0, stream>>>(
+        d_cropped_, d_num_points_, 1.0f / voxel_size_, d_keys_, d_sums_, d_counts_,
+        table_size_ - 1);
+
+    CUDA_TRY(cudaMemsetAsync(d_num_points_, 0, sizeof(uint32_t), stream));
+    EmitVoxels<<<NumBlocks(table_size_), kThreadsPerBlock, 0, stream>>>(
+        d_sums_, d_counts_, table_size_, d_out, d_num_points_);
+  }
+  CUDA_TRY(cudaGetLastError());
+
+  CUDA_TRY(cudaMemcpyAsync(
+      h_num_points_, d_num_points_, sizeof(uint32_t), cudaMemcpyDeviceToHost, stream));
+  CUDA_TRY(cudaStreamSynchronize(stream));
+  return *h_num_points_;
+}
+
+}  // namespace sensors
+}  // namespace data_collection
@@ -0,0 +1,69 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2024 NVIDIA CORPORATION & AFFILIATES. All rights
+ * reserved. SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef VELODYNE_SWEEP_FILTER_HPP
+#define VELODYNE_SWEEP_FILTER_HPP
+
+#include <cuda_runtime.h>
+#include <stdint.h>
+
+#include "velodyne_convert_xyz.hpp"
+
+namespace data_collection {
+namespace sensors {
+
+/// @brief GPU reduction of a full lidar sweep before it is emitted.
+///
+/// Points are first cropped to a range band around the sensor, then optionally reduced to one
+/// point per voxel (the centroid of the points falling in it). Voxels are found with an
+/// open-addressing hash table in device memory, so the cost is linear in the sweep size.
+/// Output point order is not preserved.
+class VelodyneSweepFilter {
+ public:
+  /// @param max_points Largest sweep the filter will be applied to.
+  /// @param min_range Points closer than this many meters are dropped, 0 to keep them.
+  /// @param max_range Points farther than this many meters are dropped, 0 for no limit.
+  /// @param voxel_size Voxel edge in meters, 0 to skip downsampling.
+  VelodyneSweepFilter(size_t max_points, float min_range, float max_range, float voxel_size);
+  ~VelodyneSweepFilter();
+
+  /// @brief Filter num_points points from d_in into d_out, which can hold num_points points.
+  /// @return Number of points written to d_out. Waits for the stream to get it.
+  size_t Apply(const PointXYZ* d_in, size_t num_points, PointXYZ* d_out, cudaStream_t stream);
+
+ private:
+  size_t max_points_;
+  float min_range_;
+  float max_range_;
+  float voxel_size_;
+
+  // Cropped points, only used when downsampling. GPU data.
+  PointXYZ* d_cropped_ = nullptr;
+  // Voxel hash table: packed voxel coordinates, coordinate sums and point counts. GPU data.
+  unsigned long long* d_keys_ = nullptr;
+  float3* d_sums_ = nullptr;
+  uint32_t* d_counts_ = nullptr;
+  size_t table_size_ = 0;
+  // Points kept by the current stage. GPU data, mirrored to pinned host memory.
+  uint32_t* d_num_points_ = nullptr;
+  uint32_t* h_num_points_ = nullptr;
+};
+
+}  // namespace sensors
+}  // namespace data_collection
+
+#endif  // VELODYNE_SWEEP_FILTER_HPP
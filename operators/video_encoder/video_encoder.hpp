@@ -19,6 +19,7 @@
 #define HOLOSCAN_OPERATORS_VIDEO_ENCODER_VIDEO_ENCODER
 
 #include "video_encoder_request/video_encoder_request.hpp"
+#include "video_encoder_session_pool/video_encoder_session_pool.hpp"
 
 
 #endif  // HOLOSCAN_OPERATORS_VIDEO_ENCODER_VIDEO_ENCODER
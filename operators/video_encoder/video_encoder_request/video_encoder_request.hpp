@@ -21,6 +21,7 @@
 #include <memory>
 #include <string>
 
+#include "holoscan/core/arg.hpp"
 #include "holoscan/operators/gxf_codelet/gxf_codelet.hpp"
 #include "video_encoder_custom_params.hpp"
 
@@ -34,6 +35,20 @@ class VideoEncoderRequestOp : public ::holoscan::ops::GXFCodeletOp {
                                       std::forward<ArgsT>(args)...) {}
   VideoEncoderRequestOp() : ::holoscan::ops::GXFCodeletOp("nvidia::gxf::VideoEncoderRequest") {}
 
+  /**
+   * @brief Low latency parameters of a stream, to pass after its configuration
+   *
+   * Baseline profile, which has no B-frames, so that every frame is output as soon as it is
+   * encoded, constant bitrate, for frames of even size, and an I frame every iframe_interval
+   * frames for receivers joining or recovering from losses.
+   */
+  static ArgList low_latency_args(int32_t iframe_interval = 30) {
+    return ArgList{Arg("config", nvidia::gxf::EncoderConfig::kCustom),
+                   Arg("profile", 0),
+                   Arg("rate_control_mode", 1),
+                   Arg("iframe_interval", iframe_interval)};
+  }
+
   void setup(holoscan::OperatorSpec& spec) override {
     using namespace holoscan;
     // Ensure the parent class setup() is called before any additional setup code.
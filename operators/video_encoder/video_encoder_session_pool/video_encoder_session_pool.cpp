@@ -0,0 +1,193 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "video_encoder_session_pool.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+
+#include "holoscan/core/execution_context.hpp"
+#include "holoscan/core/gxf/entity.hpp"
+#include "holoscan/core/io_context.hpp"
+#include "holoscan/core/operator_spec.hpp"
+
+namespace holoscan::ops {
+
+void VideoEncoderSessionPool::setup(ComponentSpec& spec) {
+  spec.param(max_sessions_,
+             "max_sessions",
+             "MaxSessions",
+             "Maximum number of streams encoded at the same time, 0 for no limit.",
+             0u);
+  spec.param(max_frames_in_flight_,
+             "max_frames_in_flight",
+             "MaxFramesInFlight",
+             "Maximum number of frames queued on the encoder of a stream, newer frames are "
+             "dropped, 0 for no limit.",
+             0u);
+}
+
+void VideoEncoderSessionPool::open_stream(const std::string& name) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (streams_.count(name) != 0) {
+    throw std::runtime_error(fmt::format("Encoder stream '{}' is already open", name));
+  }
+  if (max_sessions_.get() != 0 && streams_.size() >= max_sessions_.get()) {
+    throw std::runtime_error(fmt::format(
+        "Cannot open encoder stream '{}', all {} sessions are in use", name, max_sessions_.get()));
+  }
+  streams_.emplace(name, Stream());
+}
+
+void VideoEncoderSessionPool::close_stream(const std::string& name) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  streams_.erase(name);
+}
+
+VideoEncoderSessionPool::Stream* VideoEncoderSessionPool::find_stream(const std::string& name) {
+  auto it = streams_.find(name);
+  if (it == streams_.end()) {
+    HOLOSCAN_LOG_ERROR("Encoder stream '{}' is not open", name);
+    return nullptr;
+  }
+  return &it->second;
+}
+
+bool VideoEncoderSessionPool::submit(const std::string& name) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  Stream* s = find_stream(name);
+  if (!s) { return false; }
+  if (max_frames_in_flight_.get() != 0 && s->in_flight.size() >= max_frames_in_flight_.get()) {
+    s->statistics.frames_dropped++;
+    return false;
+  }
+  s->in_flight.push_back(Clock::now());
+  VideoEncoderStreamStatistics& stats = s->statistics;
+  stats.frames_submitted++;
+  stats.queue_depth = static_cast<uint32_t>(s->in_flight.size());
+  stats.max_queue_depth = std::max(stats.max_queue_depth, stats.queue_depth);
+  return true;
+}
+
+void VideoEncoderSessionPool::complete(const std::string& name) {
+  const auto now = Clock::now();
+  std::lock_guard<std::mutex> lock(mutex_);
+  Stream* s = find_stream(name);
+  if (!s) { return; }
+  if (s->in_flight.empty()) {
+    HOLOSCAN_LOG_WARN("Encoder stream '{}' output a frame that was not submitted", name);
+    return;
+  }
+  const double latency_ms =
+      std::chrono::duration<double, std::milli>(now - s->in_flight.front()).count();
+  s->in_flight.pop_front();
+
+  VideoEncoderStreamStatistics& stats = s->statistics;
+  stats.frames_encoded++;
+  stats.queue_depth = static_cast<uint32_t>(s->in_flight.size());
+  stats.last_latency_ms = latency_ms;
+  stats.mean_latency_ms += (latency_ms - stats.mean_latency_ms) / stats.frames_encoded;
+  stats.max_latency_ms = std::max(stats.max_latency_ms, latency_ms);
+}
+
+VideoEncoderStreamStatistics VideoEncoderSessionPool::statistics(const std::string& name) const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto it = streams_.find(name);
+  if (it == streams_.end()) { return VideoEncoderStreamStatistics(); }
+  return it->second.statistics;
+}
+
+std::vector<std::string> VideoEncoderSessionPool::streams() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  std::vector<std::string> names;
+  for (const auto& [name, s] : streams_) { names.push_back(name); }
+  return names;
+}
+
+void VideoEncoderStreamOp::setup(OperatorSpec& spec) {
+  spec.input<gxf::Entity>("input");
+  spec.output<gxf::Entity>("output");
+
+  spec.param(pool_, "pool", "Pool", "Encoder session pool the stream is opened on.");
+  spec.param(stream_, "stream", "Stream", "Name of the encoded stream.", std::string(""));
+  spec.param(stage_,
+             "stage",
+             "Stage",
+             "submit, before the encoder request, or complete, after the encoder response.",
+             std::string("submit"));
+  spec.param(report_interval_,
+             "report_interval",
+             "ReportInterval",
+             "Encoded frames between two logs of the stream statistics, 0 to log on stop only.",
+             static_cast<uint64_t>(0));
+}
+
+void VideoEncoderStreamOp::initialize() {
+  Operator::initialize();
+
+  const std::string& stage = stage_.get();
+  if (stage == "submit") {
+    submit_ = true;
+  } else if (stage == "complete") {
+    submit_ = false;
+  } else {
+    throw std::runtime_error(fmt::format("Unsupported encoder stream stage '{}'", stage));
+  }
+  if (stream_.get().empty()) { throw std::runtime_error("An encoder stream name is required"); }
+  if (submit_) { pool_.get()->open_stream(stream_.get()); }
+}
+
+void VideoEncoderStreamOp::compute(InputContext& op_input, OutputContext& op_output,
+                                   ExecutionContext& context) {
+  auto message = op_input.receive<gxf::Entity>("input");
+  if (!message) { throw std::runtime_error("Failed to receive input message"); }
+
+  auto& pool = pool_.get();
+  if (submit_) {
+    if (!pool->submit(stream_.get())) { return; }
+  } else {
+    pool->complete(stream_.get());
+    const uint64_t interval = report_interval_.get();
+    if (interval != 0 && pool->statistics(stream_.get()).frames_encoded % interval == 0) {
+      log_statistics();
+    }
+  }
+  op_output.emit(message.value(), "output");
+}
+
+void VideoEncoderStreamOp::stop() {
+  if (submit_) { return; }
+  log_statistics();
+  pool_.get()->close_stream(stream_.get());
+}
+
+void VideoEncoderStreamOp::log_statistics() const {
+  const auto stats = pool_.get()->statistics(stream_.get());
+  HOLOSCAN_LOG_INFO(
+      "Encoder stream '{}': {} submitted, {} encoded, {} dropped, queue depth {} (max {}), "
+      "latency {:.2f} ms (mean {:.2f}, max {:.2f})",
+      stream_.get(),
+      stats.frames_submitted,
+      stats.frames_encoded,
+      stats.frames_dropped,
+      stats.queue_depth,
+      stats.max_queue_depth,
+      stats.last_latency_ms,
+      stats.mean_latency_ms,
+      stats.max_latency_ms);
+}
+
+}  // namespace holoscan::ops
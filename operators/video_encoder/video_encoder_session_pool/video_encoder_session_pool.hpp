@@ -0,0 +1,160 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef HOLOSCAN_OPERATORS_VIDEO_ENCODER_SESSION_POOL_VIDEO_ENCODER_SESSION_POOL
+#define HOLOSCAN_OPERATORS_VIDEO_ENCODER_SESSION_POOL_VIDEO_ENCODER_SESSION_POOL
+
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "holoscan/core/operator.hpp"
+#include "holoscan/core/resource.hpp"
+
+namespace holoscan::ops {
+
+/**
+ * @brief Counters of one encoded stream, latencies are from submit to bitstream output
+ */
+struct VideoEncoderStreamStatistics {
+  uint64_t frames_submitted = 0;
+  uint64_t frames_encoded = 0;
+  // Frames not submitted because max_frames_in_flight were already queued
+  uint64_t frames_dropped = 0;
+  // Frames submitted and not encoded yet
+  uint32_t queue_depth = 0;
+  uint32_t max_queue_depth = 0;
+  double last_latency_ms = 0.0;
+  double mean_latency_ms = 0.0;
+  double max_latency_ms = 0.0;
+};
+
+/**
+ * @brief Encoder sessions of a fragment and the frames each of them has in flight
+ *
+ * Every encoded stream runs its own VideoEncoderContext, which holds one hardware encoder
+ * session. A stream is opened on the pool when its "submit" VideoEncoderStreamOp is initialized,
+ * so that opening more than max_sessions of them fails the initialization of the application
+ * instead of the encoder. The "complete" operator closes the stream on stop, which gives its
+ * session back to the pool.
+ *
+ * The VideoEncoderStreamOp instances of a stream, before the VideoEncoderRequestOp and after
+ * the VideoEncoderResponseOp, record the frames submitted and encoded. The encoder emits frames
+ * in submission order, so that the oldest submitted frame is the one each bitstream belongs to.
+ */
+class VideoEncoderSessionPool : public holoscan::Resource {
+ public:
+  HOLOSCAN_RESOURCE_FORWARD_ARGS(VideoEncoderSessionPool)
+
+  VideoEncoderSessionPool() = default;
+
+  void setup(ComponentSpec& spec) override;
+
+  /**
+   * @brief Open the stream of name, throws when it is open or all sessions are in use
+   */
+  void open_stream(const std::string& name);
+
+  void close_stream(const std::string& name);
+
+  /**
+   * @brief Record a frame submitted to the encoder of name
+   *
+   * Returns false, and counts the frame as dropped, when max_frames_in_flight frames are
+   * already queued on the stream.
+   */
+  bool submit(const std::string& name);
+
+  /**
+   * @brief Record the output of the oldest frame submitted to the encoder of name
+   */
+  void complete(const std::string& name);
+
+  VideoEncoderStreamStatistics statistics(const std::string& name) const;
+
+  std::vector<std::string> streams() const;
+
+ private:
+  using Clock = std::chrono::steady_clock;
+
+  struct Stream {
+    std::deque<Clock::time_point> in_flight;
+    VideoEncoderStreamStatistics statistics;
+  };
+
+  Stream* find_stream(const std::string& name);
+
+  Parameter<uint32_t> max_sessions_;
+  Parameter<uint32_t> max_frames_in_flight_;
+
+  mutable std::mutex mutex_;
+  std::map<std::string, Stream> streams_;
+};
+
+/**
+ * @brief Pass-through operator recording the frames of one stream of a VideoEncoderSessionPool
+ *
+ * ==Named Inputs==
+ *
+ * - **input** : `nvidia::gxf::Entity`
+ *   - Frame to encode with the "submit" stage, bitstream with the "complete" stage.
+ *
+ * ==Named Outputs==
+ *
+ * - **output** : `nvidia::gxf::Entity`
+ *   - The input message. Frames dropped by the pool are not emitted.
+ *
+ * ==Parameters==
+ *
+ * - **pool**: `VideoEncoderSessionPool` the stream is opened on.
+ * - **stream**: Name of the stream, opened on the pool by the "submit" stage.
+ * - **stage**: "submit", before the VideoEncoderRequestOp, or "complete", after the
+ *   VideoEncoderResponseOp.
+ * - **report_interval**: With the "complete" stage, log the statistics of the stream every
+ *   report_interval encoded frames, 0 only logs them on stop, where the stream is closed.
+ *   Optional (default: `0`).
+ */
+class VideoEncoderStreamOp : public holoscan::Operator {
+ public:
+  HOLOSCAN_OPERATOR_FORWARD_ARGS(VideoEncoderStreamOp)
+
+  VideoEncoderStreamOp() = default;
+
+  void setup(OperatorSpec& spec) override;
+  void initialize() override;
+  void compute(InputContext& op_input, OutputContext& op_output,
+               ExecutionContext& context) override;
+  void stop() override;
+
+ private:
+  void log_statistics() const;
+
+  Parameter<std::shared_ptr<VideoEncoderSessionPool>> pool_;
+  Parameter<std::string> stream_;
+  Parameter<std::string> stage_;
+  Parameter<uint64_t> report_interval_;
+
+  bool submit_ = true;
+};
+
+}  // namespace holoscan::ops
+
+#endif /* HOLOSCAN_OPERATORS_VIDEO_ENCODER_SESSION_POOL_VIDEO_ENCODER_SESSION_POOL */
@@ -1,6 +1,8 @@
 // SPDX-FileCopyrightText: 2025 Valley Tech Systems, Inc.
 //
 // SPDX-License-Identifier: Apache-2.0
+use std::net::{SocketAddr, ToSocketAddrs};
+use std::os::unix::io::AsRawFd;
 use vita49::{prelude::*, Spectrum, WindowTimeDelta};
 
 #[cxx::bridge]
@@ -9,7 +11,6 @@ mod ffi {
         stream_id: u32,
         integer_timestamp: u32,
         fractional_timestamp: u64,
-        spectral_data: Vec<u8>,
     }
 
     pub struct SpectralContextPacket {
@@ -46,19 +47,43 @@ mod ffi {
 
     extern "Rust" {
         type UdpSocket;
+        type PacketBatch;
         fn new_packet_sender(
             dest_host: String,
             dest_port: u16,
             manufacturer_oui: u32,
             device_code: u32,
         ) -> PacketSender;
-        fn send_data_packet(self: &mut PacketSender, data: &SpectralDataPacket);
+        fn send_data_packet(self: &mut PacketSender, data: &SpectralDataPacket, payload: &[u8]);
         fn send_context_packet(self: &mut PacketSender, data: &SpectralContextPacket);
         fn is_time_for_context(self: &PacketSender) -> bool;
+
+        fn new_packet_batch() -> Box<PacketBatch>;
+        fn queue_data_packet(
+            self: &mut PacketSender,
+            batch: &mut PacketBatch,
+            data: &SpectralDataPacket,
+            payload: &[u8],
+        );
+        fn queue_context_packet(
+            self: &mut PacketSender,
+            batch: &mut PacketBatch,
+            data: &SpectralContextPacket,
+        );
+        fn flush(self: &mut PacketBatch);
     }
 }
 
-pub struct UdpSocket(std::net::UdpSocket);
+pub struct UdpSocket {
+    socket: std::net::UdpSocket,
+    dest: SocketAddr,
+}
+
+/// Packets of any number of senders, sent with one sendmmsg() call on flush
+pub struct PacketBatch {
+    socket: std::net::UdpSocket,
+    packets: Vec<(Vec<u8>, SocketAddr)>,
+}
 
 use ffi::*;
 
@@ -69,7 +94,11 @@ pub fn new_packet_sender(
     device_code: u32,
 ) -> PacketSender {
     let destination = format!("{}:{}", &dest_host, dest_port);
-    let socket = Box::new(UdpSocket(std::net::UdpSocket::bind("0.0.0.0:0").unwrap()));
+    let dest = destination.to_socket_addrs().unwrap().next().unwrap();
+    let socket = Box::new(UdpSocket {
+        socket: std::net::UdpSocket::bind("0.0.0.0:0").unwrap(),
+        dest,
+    });
     PacketSender {
         packet_count: 0,
         context_packet_count: 0,
@@ -81,7 +110,7 @@ pub fn new_packet_sender(
 }
 
 impl crate::ffi::PacketSender {
-    pub fn send_data_packet(&mut self, data: &SpectralDataPacket) {
+    fn data_packet_bytes(&mut self, data: &SpectralDataPacket, payload: &[u8]) -> Vec<u8> {
         let mut vrt_packet = Vrt::new_signal_data_packet();
         vrt_packet.set_stream_id(Some(data.stream_id));
         vrt_packet
@@ -90,19 +119,31 @@ impl crate::ffi::PacketSender {
         vrt_packet
             .set_fractional_timestamp(Some(data.fractional_timestamp), Tsf::RealTimePs)
             .unwrap();
-        vrt_packet.set_signal_payload(&data.spectral_data).unwrap();
+        vrt_packet.set_signal_payload(payload).unwrap();
         vrt_packet
             .header_mut()
             .set_packet_count((self.packet_count % 16) as u8);
         vrt_packet.update_packet_size();
-        self.socket
-            .0
-            .send_to(&vrt_packet.to_bytes().unwrap(), &self.destination)
-            .unwrap();
         self.packet_count += 1;
+        vrt_packet.to_bytes().unwrap()
     }
 
-    pub fn send_context_packet(&mut self, data: &SpectralContextPacket) {
+    pub fn send_data_packet(&mut self, data: &SpectralDataPacket, payload: &[u8]) {
+        let bytes = self.data_packet_bytes(data, payload);
+        self.socket.socket.send_to(&bytes, self.socket.dest).unwrap();
+    }
+
+    pub fn queue_data_packet(
+        &mut self,
+        batch: &mut PacketBatch,
+        data: &SpectralDataPacket,
+        payload: &[u8],
+    ) {
+        let bytes = self.data_packet_bytes(data, payload);
+        batch.packets.push((bytes, self.socket.dest));
+    }
+
+    fn context_packet_bytes(&mut self, data: &SpectralContextPacket) -> Vec<u8> {
         let mut vrt_packet = Vrt::new_context_packet();
         vrt_packet.set_stream_id(Some(data.stream_id));
         vrt_packet
@@ -137,14 +178,102 @@ impl crate::ffi::PacketSender {
         context.set_bandwidth_hz(Some(data.bandwidth_hz));
 
         vrt_packet.update_packet_size();
-        self.socket
-            .0
-            .send_to(&vrt_packet.to_bytes().unwrap(), &self.destination)
-            .unwrap();
         self.context_packet_count += 1;
+        vrt_packet.to_bytes().unwrap()
+    }
+
+    pub fn send_context_packet(&mut self, data: &SpectralContextPacket) {
+        let bytes = self.context_packet_bytes(data);
+        self.socket.socket.send_to(&bytes, self.socket.dest).unwrap();
+    }
+
+    pub fn queue_context_packet(&mut self, batch: &mut PacketBatch, data: &SpectralContextPacket) {
+        let bytes = self.context_packet_bytes(data);
+        batch.packets.push((bytes, self.socket.dest));
     }
 
     pub fn is_time_for_context(&self) -> bool {
         self.packet_count % 10 == 0
     }
 }
+
+pub fn new_packet_batch() -> Box<PacketBatch> {
+    Box::new(PacketBatch {
+        socket: std::net::UdpSocket::bind("0.0.0.0:0").unwrap(),
+        packets: Vec::new(),
+    })
+}
+
+fn to_sockaddr(addr: &SocketAddr) -> (libc::sockaddr_storage, libc::socklen_t) {
+    // SAFETY: sockaddr_storage is plain data and large enough for both address families
+    let mut storage: libc::sockaddr_storage = unsafe { std::mem::zeroed() };
+    let len = match addr {
+        SocketAddr::V4(v4) => {
+            let sin = unsafe { &mut *(&mut storage as *mut _ as *mut libc::sockaddr_in) };
+            sin.sin_family = libc::AF_INET as libc::sa_family_t;
+            sin.sin_port = v4.port().to_be();
+            sin.sin_addr.s_addr = u32::from_ne_bytes(v4.ip().octets());
+            std::mem::size_of::<libc::sockaddr_in>()
+        }
+        SocketAddr::V6(v6) => {
+            let sin6 = unsafe { &mut *(&mut storage as *mut _ as *mut libc::sockaddr_in6) };
+            sin6.sin6_family = libc::AF_INET6 as libc::sa_family_t;
+            sin6.sin6_port = v6.port().to_be();
+            sin6.sin6_addr.s6_addr = v6.ip().octets();
+            sin6.sin6_flowinfo = v6.flowinfo();
+            sin6.sin6_scope_id = v6.scope_id();
+            std::mem::size_of::<libc::sockaddr_in6>()
+        }
+    };
+    (storage, len as libc::socklen_t)
+}
+
+impl PacketBatch {
+    pub fn flush(&mut self) {
+        if self.packets.is_empty() {
+            return;
+        }
+
+        let mut addrs: Vec<_> = self.packets.iter().map(|(_, dest)| to_sockaddr(dest)).collect();
+        let mut iovs: Vec<libc::iovec> = self
+            .packets
+            .iter()
+            .map(|(bytes, _)| libc::iovec {
+                iov_base: bytes.as_ptr() as *mut libc::c_void,
+                iov_len: bytes.len(),
+            })
+            .collect();
+        let mut msgs: Vec<libc::mmsghdr> = iovs
+            .iter_mut()
+            .zip(addrs.iter_mut())
+            .map(|(iov, (addr, addr_len))| {
+                // SAFETY: an all-zero msghdr is valid, the pointers outlive the sendmmsg() calls
+                let mut msg: libc::mmsghdr = unsafe { std::mem::zeroed() };
+                msg.msg_hdr.msg_name = addr as *mut _ as *mut libc::c_void;
+                msg.msg_hdr.msg_namelen = *addr_len;
+                msg.msg_hdr.msg_iov = iov as *mut libc::iovec;
+                msg.msg_hdr.msg_iovlen = 1;
+                msg
+            })
+            .collect();
+
+        let fd = self.socket.as_raw_fd();
+        let mut sent = 0;
+        while sent < msgs.len() {
+            let remaining = &mut msgs[sent..];
+            // SAFETY: every message points into addrs, iovs and self.packets, alive until return
+            let ret = unsafe {
+                libc::sendmmsg(fd, remaining.as_mut_ptr(), remaining.len() as libc::c_uint, 0)
+            };
+            if ret < 0 {
+                let err = std::io::Error::last_os_error();
+                if err.kind() == std::io::ErrorKind::Interrupted {
+                    continue;
+                }
+                panic!("sendmmsg failed: {}", err);
+            }
+            sent += ret as usize;
+        }
+        self.packets.clear();
+    }
+}
@@ -4,9 +4,11 @@
  */
 #include "vita49_psd_packetizer.hpp"
 
+using in_t = std::tuple<tensor_t<int8_t, 1>, cudaStream_t>;
+
 namespace holoscan::ops {
 void V49PsdPacketizer::setup(OperatorSpec& spec) {
-    spec.input<tensor_t<int8_t, 1>>("in");
+    spec.input<in_t>("in");
     spec.param(burst_size,
         "burst_size",
         "Burst size",
@@ -31,14 +33,30 @@ void V49PsdPacketizer::setup(OperatorSpec& spec) {
         "num_channels",
         "Number of channels",
         "Number of channels to support");
+    spec.param(first_channel,
+        "first_channel",
+        "First channel",
+        "Channel number of the first channel to support",
+        static_cast<uint16_t>(0));
+    spec.param(device,
+        "device",
+        "CUDA device",
+        "CUDA device of the incoming PSDs",
+        0);
     spec.param(print_every_n_packets,
         "print_every_n_packets",
         "Print the time it takes to send N packets",
         "Print the time it takes to send N packets (0: no print, defaults to 10 * num_channels)");
+    spec.param(num_inflight_buffers,
+        "num_inflight_buffers",
+        "Number of in-flight buffers",
+        "Number of pinned staging buffers with device-to-host copies in flight",
+        8u);
 }
 
 void V49PsdPacketizer::initialize() {
     holoscan::Operator::initialize();
+    cudaSetDevice(device.get());
     uint32_t moui = 0;
     uint32_t dcode = 0;
     if (manufacturer_oui.has_value()) {
@@ -52,17 +70,25 @@ void V49PsdPacketizer::initialize() {
         packet_senders.push_back(std::make_shared<PacketSender>(
             new_packet_sender(
                 dest_host.get().c_str(),
-                base_dest_port + i,
+                base_dest_port + first_channel.get() + i,
                 moui,
                 dcode)));
-        rust::Vec<uint8_t> out;
-        out.reserve(burst_size.get());
-        // Need to add elements here otherwised reserved data
-        // is deallocated when being added to wrapper vector.
-        for (int i = 0; i < burst_size.get(); i++) {
-            out.push_back(0);
+    }
+    packet_batch = new_packet_batch();
+
+    if (num_inflight_buffers.get() == 0) {
+        HOLOSCAN_LOG_CRITICAL("num_inflight_buffers must be at least 1");
+        throw std::runtime_error("Invalid num_inflight_buffers");
+    }
+    const size_t buffer_size = static_cast<size_t>(num_channels.get()) * burst_size.get();
+    inflight.resize(num_inflight_buffers.get());
+    for (auto& slot : inflight) {
+        if (cudaMallocHost(&slot.host, buffer_size) != cudaSuccess ||
+                cudaEventCreateWithFlags(&slot.copied, cudaEventDisableTiming) != cudaSuccess) {
+            HOLOSCAN_LOG_CRITICAL("Failed to allocate {} byte pinned staging buffer", buffer_size);
+            throw std::runtime_error("Failed to allocate staging buffer");
         }
-        output_data.push_back(out);
+        slot.sends.reserve(num_channels.get());
     }
 
     if (!print_every_n_packets.has_value()) {
@@ -72,16 +98,99 @@ void V49PsdPacketizer::initialize() {
     start = std::chrono::steady_clock::now();
 }
 
+V49PsdPacketizer::~V49PsdPacketizer() {
+    for (auto& slot : inflight) {
+        if (slot.copied != nullptr) {
+            cudaEventSynchronize(slot.copied);
+            cudaEventDestroy(slot.copied);
+        }
+        if (slot.host != nullptr) {
+            cudaFreeHost(slot.host);
+        }
+    }
+}
+
+void V49PsdPacketizer::stop() {
+    send_completed(inflight_count);
+}
+
 void V49PsdPacketizer::compute(InputContext& op_input, OutputContext& _out, ExecutionContext&) {
-    auto psd_data = op_input.receive<tensor_t<int8_t, 1>>("in").value();
+    cudaSetDevice(device.get());
+    auto input = op_input.receive<in_t>("in").value();
+    auto& psd_data = std::get<0>(input);
     auto meta = metadata();
-    if (!meta->has_key("channel_number")) {
-        HOLOSCAN_LOG_CRITICAL("error - input metadata does not have channel_number set!");
-        throw;
+
+    // Make room for this call's copy, only waiting if every staging buffer is in flight
+    send_completed(inflight_count == inflight.size() ? 1 : 0);
+    auto& slot = inflight[(inflight_head + inflight_count) % inflight.size()];
+    slot.sends.clear();
+
+    size_t bytes = burst_size.get() * sizeof(int8_t);
+    if (meta->has_key("batched_channels")) {
+        // Batched input: one PSD per channel, each with the metadata of its channel
+        using ChannelMetadata = std::vector<std::shared_ptr<MetadataDictionary>>;
+        auto channel_metadata = meta->get<ChannelMetadata>("channel_metadata", ChannelMetadata{});
+        for (uint16_t channel_num = 0; channel_num < num_channels.get(); channel_num++) {
+            MetadataDictionary* channel_meta = meta.get();
+            if (channel_num < channel_metadata.size() && channel_metadata[channel_num]) {
+                channel_meta = channel_metadata[channel_num].get();
+            }
+            queue_channel(slot, channel_num, *channel_meta,
+                static_cast<size_t>(channel_num) * burst_size.get());
+        }
+        bytes *= num_channels.get();
+    } else {
+        if (!meta->has_key("channel_number")) {
+            HOLOSCAN_LOG_CRITICAL("error - input metadata does not have channel_number set!");
+            throw;
+        }
+        const int channel_num = meta->get<uint16_t>("channel_number") - first_channel.get();
+        if (channel_num < 0) {
+            HOLOSCAN_LOG_CRITICAL("Channel {} is below the first channel {}",
+                channel_num + first_channel.get(), first_channel.get());
+            throw std::runtime_error("Invalid channel_number");
+        }
+        queue_channel(slot, channel_num, *meta, 0);
     }
 
-    auto channel_num = meta->get<uint16_t>("channel_number", 0);
-    auto packet_sender = packet_senders.at(channel_num);
+    cudaMemcpyAsync(slot.host, psd_data.Data(), bytes, cudaMemcpyDeviceToHost,
+        std::get<1>(input));
+    cudaEventRecord(slot.copied, std::get<1>(input));
+    inflight_count++;
+
+    send_completed(0);
+}
+
+void V49PsdPacketizer::send_completed(size_t min_slots) {
+    bool queued = false;
+    while (inflight_count > 0) {
+        auto& slot = inflight[inflight_head];
+        if (min_slots > 0) {
+            cudaEventSynchronize(slot.copied);
+            min_slots--;
+        } else if (cudaEventQuery(slot.copied) != cudaSuccess) {
+            break;
+        }
+        send_slot(slot);
+        queued = true;
+        inflight_head = (inflight_head + 1) % inflight.size();
+        inflight_count--;
+    }
+
+    // Every packet of the completed copies goes out in one sendmmsg() call
+    if (queued) {
+        (*packet_batch)->flush();
+    }
+}
+
+void V49PsdPacketizer::queue_channel(InflightPsd& slot, uint16_t channel_num,
+        MetadataDictionary& meta_dict, size_t offset) {
+    auto meta = &meta_dict;
+    if (channel_num >= packet_senders.size()) {
+        HOLOSCAN_LOG_CRITICAL("Channel {} is out of range (num_channels: {})",
+            channel_num, packet_senders.size());
+        throw std::runtime_error("Invalid channel_number");
+    }
 
     uint32_t stream_id = 0;
     uint32_t integer_timestamp = 0;
@@ -93,79 +202,86 @@ void V49PsdPacketizer::compute(InputContext& op_input, OutputContext& _out, Exec
     if (meta->has_key("fractional_timestamp"))
         fractional_timestamp = meta->get<uint64_t>("fractional_timestamp");
 
-    if (packet_sender->is_time_for_context() || meta->get<bool>("change_indicator", false)) {
-        SpectralContextPacket packet;
-        packet.stream_id = stream_id;
-        packet.integer_timestamp = integer_timestamp;
-        packet.fractional_timestamp = fractional_timestamp;
-        if (meta->has_key("spectrum_type"))
-            packet.spectrum_type = meta->get<uint8_t>("spectrum_type");
-        if (meta->has_key("averaging_type"))
-            packet.averaging_type = meta->get<uint8_t>("averaging_type");
-        if (meta->has_key("window_time_delta_interpretation")) {
-            packet.window_time_delta_interpretation
-                = meta->get<uint8_t>("window_time_delta_interpretation");
-        }
-        if (meta->has_key("window_type"))
-            packet.window_type = meta->get<uint8_t>("window_type");
-        if (meta->has_key("num_transform_points"))
-            packet.num_transform_points = meta->get<uint32_t>("num_transform_points");
-        if (meta->has_key("num_window_points"))
-            packet.num_window_points = meta->get<uint32_t>("num_window_points");
-        if (meta->has_key("resolution"))
-            packet.resolution_hz = meta->get<uint64_t>("resolution");
-        if (meta->has_key("span"))
-            packet.span_hz = meta->get<uint64_t>("span");
-        if (meta->has_key("num_averages"))
-            packet.num_averages = meta->get<uint32_t>("num_averages");
-        if (meta->has_key("weighting_factor"))
-            packet.weighting_factor = meta->get<float>("weighting_factor");
-        if (meta->has_key("f1_index"))
-            packet.f1_index = meta->get<int32_t>("f1_index");
-        if (meta->has_key("f2_index"))
-            packet.f2_index = meta->get<int32_t>("f2_index");
-        if (meta->has_key("window_time_delta"))
-            packet.window_time_delta = meta->get<uint32_t>("window_time_delta");
-        if (meta->has_key("rf_ref_freq_hz"))
-            packet.rf_ref_freq_hz = meta->get<double>("rf_ref_freq_hz");
-        if (meta->has_key("sample_rate_hz"))
-            packet.sample_rate_sps = meta->get<double>("sample_rate_hz");
-        if (meta->has_key("bandwidth_hz"))
-            packet.bandwidth_hz = meta->get<double>("bandwidth_hz");
-
-        packet.change_indicator = meta->get<bool>("change_indicator", false);
-
-        HOLOSCAN_LOG_DEBUG("Sending context packet (channel {}) to {}/udp",
-                          channel_num, packet_sender->destination.c_str());
-        packet_sender->send_context_packet(packet);
-    }
-
-    rust::Vec<uint8_t> out = output_data.at(channel_num);
-    cudaMemcpy(
-        out.data(),
-        psd_data.Data(),
-        burst_size.get() * sizeof(int8_t),
-        cudaMemcpyDeviceToHost);
+    ChannelSend send{};
+    send.channel_num = channel_num;
+    send.offset = offset;
+    send.data.stream_id = stream_id;
+    send.data.integer_timestamp = integer_timestamp;
+    send.data.fractional_timestamp = fractional_timestamp;
+    send.change_indicator = meta->get<bool>("change_indicator", false);
 
-    SpectralDataPacket packet;
+    auto& packet = send.context;
     packet.stream_id = stream_id;
     packet.integer_timestamp = integer_timestamp;
     packet.fractional_timestamp = fractional_timestamp;
-    packet.spectral_data = out;
+    if (meta->has_key("spectrum_type"))
+        packet.spectrum_type = meta->get<uint8_t>("spectrum_type");
+    if (meta->has_key("averaging_type"))
+        packet.averaging_type = meta->get<uint8_t>("averaging_type");
+    if (meta->has_key("window_time_delta_interpretation")) {
+        packet.window_time_delta_interpretation
+            = meta->get<uint8_t>("window_time_delta_interpretation");
+    }
+    if (meta->has_key("window_type"))
+        packet.window_type = meta->get<uint8_t>("window_type");
+    if (meta->has_key("num_transform_points"))
+        packet.num_transform_points = meta->get<uint32_t>("num_transform_points");
+    if (meta->has_key("num_window_points"))
+        packet.num_window_points = meta->get<uint32_t>("num_window_points");
+    if (meta->has_key("resolution"))
+        packet.resolution_hz = meta->get<uint64_t>("resolution");
+    if (meta->has_key("span"))
+        packet.span_hz = meta->get<uint64_t>("span");
+    if (meta->has_key("num_averages"))
+        packet.num_averages = meta->get<uint32_t>("num_averages");
+    if (meta->has_key("weighting_factor"))
+        packet.weighting_factor = meta->get<float>("weighting_factor");
+    if (meta->has_key("f1_index"))
+        packet.f1_index = meta->get<int32_t>("f1_index");
+    if (meta->has_key("f2_index"))
+        packet.f2_index = meta->get<int32_t>("f2_index");
+    if (meta->has_key("window_time_delta"))
+        packet.window_time_delta = meta->get<uint32_t>("window_time_delta");
+    if (meta->has_key("rf_ref_freq_hz"))
+        packet.rf_ref_freq_hz = meta->get<double>("rf_ref_freq_hz");
+    if (meta->has_key("sample_rate_hz"))
+        packet.sample_rate_sps = meta->get<double>("sample_rate_hz");
+    if (meta->has_key("bandwidth_hz"))
+        packet.bandwidth_hz = meta->get<double>("bandwidth_hz");
 
-    HOLOSCAN_LOG_DEBUG("Sending {} bytes of spectral data (channel {}) to {}/udp",
-        packet.spectral_data.size(),
-        channel_num,
-        packet_sender->destination.c_str());
+    packet.change_indicator = send.change_indicator;
 
-    packet_sender->send_data_packet(packet);
+    slot.sends.push_back(send);
+}
 
-    if (print_every_n_packets.get() != 0 && ++packet_send_counter >= print_every_n_packets.get()) {
-        auto end = std::chrono::steady_clock::now();
-        std::chrono::duration<double> time_diff = end - start;
-        HOLOSCAN_LOG_INFO("Sent {} packets in {} seconds", packet_send_counter, time_diff.count());
-        packet_send_counter = 0;
-        start = std::chrono::steady_clock::now();
+void V49PsdPacketizer::send_slot(const InflightPsd& slot) {
+    for (const auto& send : slot.sends) {
+        auto packet_sender = packet_senders.at(send.channel_num);
+
+        if (packet_sender->is_time_for_context() || send.change_indicator) {
+            HOLOSCAN_LOG_DEBUG("Sending context packet (channel {}) to {}/udp",
+                              send.channel_num, packet_sender->destination.c_str());
+            packet_sender->queue_context_packet(**packet_batch, send.context);
+        }
+
+        HOLOSCAN_LOG_DEBUG("Sending {} bytes of spectral data (channel {}) to {}/udp",
+            burst_size.get(),
+            send.channel_num,
+            packet_sender->destination.c_str());
+
+        packet_sender->queue_data_packet(**packet_batch, send.data,
+            rust::Slice<const uint8_t>(
+                reinterpret_cast<const uint8_t*>(slot.host + send.offset), burst_size.get()));
+
+        if (print_every_n_packets.get() != 0 &&
+                ++packet_send_counter >= print_every_n_packets.get()) {
+            auto end = std::chrono::steady_clock::now();
+            std::chrono::duration<double> time_diff = end - start;
+            HOLOSCAN_LOG_INFO("Sent {} packets in {} seconds",
+                packet_send_counter, time_diff.count());
+            packet_send_counter = 0;
+            start = std::chrono::steady_clock::now();
+        }
     }
 }
 }  // namespace holoscan::ops
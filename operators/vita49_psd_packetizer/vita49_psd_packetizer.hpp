@@ -4,6 +4,8 @@
  */
 #pragma once
 
+#include <optional>
+#include <vector>
 #include <matx.h>
 #include "holoscan/holoscan.hpp"
 #include "packet_sender.h"
@@ -12,6 +14,7 @@
 struct SpectralDataPacket;
 struct SpectralContextPacket;
 struct PacketSender;
+struct PacketBatch;
 
 using namespace matx;
 
@@ -20,21 +23,51 @@ class V49PsdPacketizer : public Operator {
  public:
     HOLOSCAN_OPERATOR_FORWARD_ARGS(V49PsdPacketizer)
 
+    ~V49PsdPacketizer();
+
     void initialize() override;
     void setup(OperatorSpec& spec) override;
     void compute(InputContext& input, OutputContext& output, ExecutionContext& context) override;
+    void stop() override;
 
  private:
+    // Header and context fields of one channel's packets, taken from its metadata
+    struct ChannelSend {
+        uint16_t channel_num;
+        size_t offset;  // Offset of the PSD in the staging buffer
+        SpectralDataPacket data;
+        SpectralContextPacket context;
+        bool change_indicator;
+    };
+
+    // Pinned staging buffer with the PSDs of one compute() call, sent once the copy is done
+    struct InflightPsd {
+        int8_t* host = nullptr;
+        cudaEvent_t copied = nullptr;
+        std::vector<ChannelSend> sends;
+    };
+
+    void queue_channel(InflightPsd& slot, uint16_t channel_num, MetadataDictionary& meta,
+            size_t offset);
+    void send_completed(size_t min_slots);
+    void send_slot(const InflightPsd& slot);
+
     Parameter<int> burst_size;
     Parameter<std::string> dest_host;
     Parameter<unsigned short> base_dest_port;
     Parameter<uint32_t> manufacturer_oui;
     Parameter<uint32_t> device_code;
     Parameter<uint16_t> num_channels;
+    Parameter<uint16_t> first_channel;
+    Parameter<int32_t> device;
     Parameter<int> print_every_n_packets;
+    Parameter<uint32_t> num_inflight_buffers;
 
     std::vector<std::shared_ptr<PacketSender>> packet_senders;
-    std::vector<rust::Vec<uint8_t>> output_data;
+    std::optional<rust::Box<PacketBatch>> packet_batch;
+    std::vector<InflightPsd> inflight;
+    size_t inflight_head = 0;
+    size_t inflight_count = 0;
 
     int packet_send_counter = 0;
     std::chrono::steady_clock::time_point start;
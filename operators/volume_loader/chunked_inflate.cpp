@@ -0,0 +1,575 @@
+/* SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "chunked_inflate.hpp"
+
+#include <cuda_runtime.h>
+#include <sys/stat.h>
+#include <zlib.h>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <thread>
+#include <utility>
+
+#ifdef VOLUME_LOADER_NVCOMP
+#include <nvcomp/deflate.h>
+#endif
+
+#include "volume.hpp"
+#include "volume_stream.hpp"
+
+namespace holoscan::ops {
+
+namespace {
+
+uint16_t read_le16(const uint8_t* data) {
+  return static_cast<uint16_t>(data[0] | (data[1] << 8));
+}
+
+uint32_t read_le32(const uint8_t* data) {
+  return static_cast<uint32_t>(read_le16(data)) |
+         (static_cast<uint32_t>(read_le16(data + 2)) << 16);
+}
+
+/// Inflate a raw deflate chunk which has to fill dst exactly
+bool inflate_raw(const uint8_t* src, size_t src_size, uint8_t* dst, size_t dst_size) {
+  z_stream strm{};
+  if (inflateInit2(&strm, -MAX_WBITS) != Z_OK) { return false; }
+  strm.next_in = const_cast<Bytef*>(src);
+  strm.avail_in = src_size;
+  strm.next_out = dst;
+  strm.avail_out = dst_size;
+  const int result = inflate(&strm, Z_FINISH);
+  const bool success = (result == Z_STREAM_END) && (strm.avail_out == 0);
+  inflateEnd(&strm);
+  return success;
+}
+
+/// Modification time in nanoseconds and size of a file
+bool file_version(const std::string& file_name, uint64_t& size, uint64_t& time) {
+  struct stat file_stat;
+  if (stat(file_name.c_str(), &file_stat) != 0) { return false; }
+  size = file_stat.st_size;
+  time = static_cast<uint64_t>(file_stat.st_mtim.tv_sec) * 1000000000ull +
+         file_stat.st_mtim.tv_nsec;
+  return true;
+}
+
+/// Consecutive chunks inflated by one worker as a unit
+struct InflateTask {
+  size_t first_chunk;
+  size_t end_chunk;
+  uint64_t begin;
+  uint64_t end;
+};
+
+// Uncompressed size of a task, small chunks such as the 64 KB BGZF blocks are grouped to keep
+// the uploads large
+constexpr uint64_t kTaskSize = 8 * 1024 * 1024;
+
+/// Per worker pinned buffers for device tensors, each is reused once its upload is done
+class UploadBuffers {
+ public:
+  ~UploadBuffers() {
+    if (stream_) { cudaStreamSynchronize(stream_); }
+    for (auto event : events_) {
+      if (event) { cudaEventDestroy(event); }
+    }
+    for (auto buffer : buffers_) {
+      if (buffer) { cudaFreeHost(buffer); }
+    }
+    if (stream_) { cudaStreamDestroy(stream_); }
+  }
+
+  bool init(size_t size) {
+    if (cudaStreamCreateWithFlags(&stream_, cudaStreamNonBlocking) != cudaSuccess) {
+      return false;
+    }
+    for (size_t index = 0; index < buffers_.size(); ++index) {
+      if ((cudaMallocHost(&buffers_[index], size) != cudaSuccess) ||
+          (cudaEventCreateWithFlags(&events_[index], cudaEventDisableTiming) != cudaSuccess)) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  uint8_t* next() {
+    current_ = (current_ + 1) % buffers_.size();
+    if (cudaEventSynchronize(events_[current_]) != cudaSuccess) { return nullptr; }
+    return buffers_[current_];
+  }
+
+  bool upload(uint8_t* dst, const uint8_t* src, size_t size) {
+    return (cudaMemcpyAsync(dst, src, size, cudaMemcpyHostToDevice, stream_) == cudaSuccess) &&
+           (cudaEventRecord(events_[current_], stream_) == cudaSuccess);
+  }
+
+  bool finish() { return !stream_ || (cudaStreamSynchronize(stream_) == cudaSuccess); }
+
+ private:
+  cudaStream_t stream_ = nullptr;
+  std::array<uint8_t*, 2> buffers_{};
+  std::array<cudaEvent_t, 2> events_{};
+  size_t current_ = 0;
+};
+
+bool inflate_chunks_parallel(const uint8_t* data, const std::vector<DeflateChunk>& chunks,
+                             size_t skip, Volume& volume) {
+  uint8_t* const tensor_data = volume.tensor_->pointer();
+  const uint64_t size = volume.tensor_->size();
+  const bool device = volume.storage_type_ == nvidia::gxf::MemoryStorageType::kDevice;
+
+  // group the chunks overlapping the volume data
+  std::vector<InflateTask> tasks;
+  uint64_t max_task_size = 0;
+  for (size_t index = 0; index < chunks.size();) {
+    InflateTask task{index, index, chunks[index].uncompressed_offset,
+                     chunks[index].uncompressed_offset};
+    while ((task.end_chunk < chunks.size()) && (task.end - task.begin < kTaskSize)) {
+      task.end += chunks[task.end_chunk].uncompressed_size;
+      ++task.end_chunk;
+    }
+    index = task.end_chunk;
+    if ((task.end > skip) && (task.begin < skip + size)) {
+      tasks.push_back(task);
+      max_task_size = std::max(max_task_size, task.end - task.begin);
+    }
+  }
+  if (tasks.empty() || (tasks.front().begin > skip) || (tasks.back().end < skip + size)) {
+    holoscan::log_error("Compressed data does not cover the volume");
+    return false;
+  }
+
+  std::atomic<size_t> next_task{0};
+  std::atomic<bool> failed{false};
+  auto worker = [&]() {
+    UploadBuffers upload_buffers;
+    std::vector<uint8_t> host_buffer;
+    if (device) {
+      if (!upload_buffers.init(max_task_size)) {
+        failed = true;
+        return;
+      }
+    }
+    for (size_t index = next_task++; (index < tasks.size()) && !failed; index = next_task++) {
+      const InflateTask& task = tasks[index];
+      // range of the task in the tensor
+      const uint64_t begin = std::max<uint64_t>(task.begin, skip);
+      const uint64_t end = std::min<uint64_t>(task.end, skip + size);
+
+      // host tensors are written in place unless the task is cut by the volume bounds
+      uint8_t* buffer;
+      if (device) {
+        buffer = upload_buffers.next();
+      } else if ((begin == task.begin) && (end == task.end)) {
+        buffer = tensor_data + (task.begin - skip);
+      } else {
+        host_buffer.resize(max_task_size);
+        buffer = host_buffer.data();
+      }
+      if (!buffer) {
+        failed = true;
+        break;
+      }
+
+      for (size_t chunk_index = task.first_chunk; chunk_index < task.end_chunk; ++chunk_index) {
+        const DeflateChunk& chunk = chunks[chunk_index];
+        if (!inflate_raw(data + chunk.compressed_offset,
+                         chunk.compressed_size,
+                         buffer + (chunk.uncompressed_offset - task.begin),
+                         chunk.uncompressed_size)) {
+          failed = true;
+          break;
+        }
+      }
+      if (failed) { break; }
+
+      const uint8_t* src = buffer + (begin - task.begin);
+      uint8_t* dst = tensor_data + (begin - skip);
+      if (device) {
+        if (!upload_buffers.upload(dst, src, end - begin)) { failed = true; }
+      } else if (src != dst) {
+        memcpy(dst, src, end - begin);
+      }
+    }
+    if (!upload_buffers.finish()) { failed = true; }
+  };
+
+  const size_t thread_count =
+      std::min<size_t>(std::max(1u, std::thread::hardware_concurrency()), tasks.size());
+  std::vector<std::thread> threads;
+  for (size_t index = 1; index < thread_count; ++index) { threads.emplace_back(worker); }
+  worker();
+  for (auto& thread : threads) { thread.join(); }
+
+  if (failed) {
+    holoscan::log_error("Failed to inflate the volume data");
+    return false;
+  }
+  return true;
+}
+
+#ifdef VOLUME_LOADER_NVCOMP
+/// Device memory released when going out of scope
+struct DeviceBuffer {
+  ~DeviceBuffer() {
+    if (pointer) { cudaFree(pointer); }
+  }
+  bool allocate(size_t size) { return cudaMalloc(&pointer, size) == cudaSuccess; }
+  void* pointer = nullptr;
+};
+
+// Compressed bytes uploaded and inflated at once
+constexpr uint64_t kBatchSize = 256 * 1024 * 1024;
+
+/// Inflate chunks covering exactly the device tensor with nvCOMP
+bool inflate_chunks_gpu(const uint8_t* data, const std::vector<DeflateChunk>& chunks,
+                        Volume& volume) {
+  uint8_t* const tensor_data = volume.tensor_->pointer();
+
+  // split in batches of contiguous compressed data
+  std::vector<std::pair<size_t, size_t>> batches;
+  uint64_t max_batch_size = 0;
+  size_t max_batch_chunks = 0;
+  uint64_t max_chunk_size = 0;
+  for (size_t index = 0; index < chunks.size();) {
+    size_t end = index;
+    const uint64_t begin_offset = chunks[index].compressed_offset;
+    uint64_t end_offset = begin_offset;
+    while ((end < chunks.size()) && ((end == index) || (end_offset - begin_offset < kBatchSize))) {
+      end_offset = chunks[end].compressed_offset + chunks[end].compressed_size;
+      max_chunk_size = std::max(max_chunk_size, chunks[end].uncompressed_size);
+      ++end;
+    }
+    batches.emplace_back(index, end);
+    max_batch_size = std::max(max_batch_size, end_offset - begin_offset);
+    max_batch_chunks = std::max(max_batch_chunks, end - index);
+    index = end;
+  }
+
+  size_t temp_size = 0;
+  if (nvcompBatchedDeflateDecompressGetTempSize(max_batch_chunks, max_chunk_size, &temp_size) !=
+      nvcompSuccess) {
+    return false;
+  }
+
+  // the per chunk arrays: compressed pointers, uncompressed pointers, compressed sizes,
+  // uncompressed sizes, actual uncompressed sizes and statuses
+  const size_t table_size = max_batch_chunks * (2 * sizeof(void*) + 3 * sizeof(size_t) +
+                                                sizeof(nvcompStatus_t));
+  DeviceBuffer compressed, temp, table;
+  if (!compressed.allocate(max_batch_size) || !temp.allocate(std::max<size_t>(temp_size, 1)) ||
+      !table.allocate(table_size)) {
+    return false;
+  }
+  const void** compressed_ptrs = static_cast<const void**>(table.pointer);
+  void** uncompressed_ptrs = const_cast<void**>(compressed_ptrs + max_batch_chunks);
+  size_t* compressed_sizes = reinterpret_cast<size_t*>(uncompressed_ptrs + max_batch_chunks);
+  size_t* uncompressed_sizes = compressed_sizes + max_batch_chunks;
+  size_t* actual_sizes = uncompressed_sizes + max_batch_chunks;
+  nvcompStatus_t* statuses = reinterpret_cast<nvcompStatus_t*>(actual_sizes + max_batch_chunks);
+
+  std::vector<uint8_t> host_table(table_size);
+  const void** host_compressed_ptrs = reinterpret_cast<const void**>(host_table.data());
+  void** host_uncompressed_ptrs = const_cast<void**>(host_compressed_ptrs + max_batch_chunks);
+  size_t* host_compressed_sizes =
+      reinterpret_cast<size_t*>(host_uncompressed_ptrs + max_batch_chunks);
+  size_t* host_uncompressed_sizes = host_compressed_sizes + max_batch_chunks;
+  std::vector<nvcompStatus_t> host_statuses(max_batch_chunks);
+
+  uint8_t* const compressed_data = static_cast<uint8_t*>(compressed.pointer);
+  for (const auto& [first, end] : batches) {
+    const size_t count = end - first;
+    const uint64_t base = chunks[first].compressed_offset;
+    const uint64_t batch_size = chunks[end - 1].compressed_offset +
+                                chunks[end - 1].compressed_size - base;
+    for (size_t index = 0; index < count; ++index) {
+      const DeflateChunk& chunk = chunks[first + index];
+      host_compressed_ptrs[index] = compressed_data + (chunk.compressed_offset - base);
+      host_uncompressed_ptrs[index] = tensor_data + chunk.uncompressed_offset;
+      host_compressed_sizes[index] = chunk.compressed_size;
+      host_uncompressed_sizes[index] = chunk.uncompressed_size;
+    }
+    // the three tables are uploaded at their offsets for max_batch_chunks entries
+    if ((cudaMemcpy(compressed_data, data + base, batch_size, cudaMemcpyHostToDevice) !=
+         cudaSuccess) ||
+        (cudaMemcpy(table.pointer,
+                    host_table.data(),
+                    max_batch_chunks * (2 * sizeof(void*) + 2 * sizeof(size_t)),
+                    cudaMemcpyHostToDevice) != cudaSuccess)) {
+      return false;
+    }
+    if (nvcompBatchedDeflateDecompressAsync(compressed_ptrs,
+                                            compressed_sizes,
+                                            uncompressed_sizes,
+                                            actual_sizes,
+                                            count,
+                                            temp.pointer,
+                                            temp_size,
+                                            uncompressed_ptrs,
+                                            statuses,
+                                            0) != nvcompSuccess) {
+      return false;
+    }
+    if (cudaMemcpy(host_statuses.data(),
+                   statuses,
+                   count * sizeof(nvcompStatus_t),
+                   cudaMemcpyDeviceToHost) != cudaSuccess) {
+      return false;
+    }
+    for (size_t index = 0; index < count; ++index) {
+      if (host_statuses[index] != nvcompSuccess) { return false; }
+    }
+  }
+  return true;
+}
+#endif
+
+/// Header of a chunk cache, followed by the chunks and the compressed size of each
+struct ChunkCacheHeader {
+  std::array<char, 8> magic;
+  uint64_t version;
+  uint64_t source_size;
+  uint64_t source_time;
+  uint64_t skip;
+  uint64_t size;
+  uint64_t chunk_size;
+  uint64_t chunk_count;
+};
+
+constexpr std::array<char, 8> kChunkCacheMagic{'H', 'V', 'L', 'C', 'H', 'U', 'N', 'K'};
+constexpr uint64_t kChunkCacheVersion = 1;
+
+std::vector<uint8_t> deflate_chunk(std::vector<uint8_t> chunk) {
+  z_stream strm{};
+  if (deflateInit2(&strm, Z_BEST_SPEED, Z_DEFLATED, -MAX_WBITS, 8, Z_DEFAULT_STRATEGY) != Z_OK) {
+    return {};
+  }
+  std::vector<uint8_t> result(deflateBound(&strm, chunk.size()));
+  strm.next_in = chunk.data();
+  strm.avail_in = chunk.size();
+  strm.next_out = result.data();
+  strm.avail_out = result.size();
+  const int status = deflate(&strm, Z_FINISH);
+  deflateEnd(&strm);
+  if (status != Z_STREAM_END) { return {}; }
+  result.resize(result.size() - strm.avail_out);
+  return result;
+}
+
+}  // namespace
+
+bool find_bgzf_chunks(const uint8_t* data, size_t size, std::vector<DeflateChunk>& chunks) {
+  chunks.clear();
+  uint64_t offset = 0;
+  uint64_t uncompressed_offset = 0;
+  while (offset < size) {
+    const uint8_t* header = data + offset;
+    const size_t available = size - offset;
+    // gzip member with extra field
+    if ((available < 18) || (header[0] != 31) || (header[1] != 139) || (header[2] != 8) ||
+        !(header[3] & 4)) {
+      return false;
+    }
+    const size_t extra_end = 12 + read_le16(header + 10);
+    if (extra_end > available) { return false; }
+
+    // the 'BC' subfield holds the member size minus one
+    size_t block_size = 0;
+    for (size_t field = 12; field + 4 <= extra_end;) {
+      const size_t field_size = read_le16(header + field + 2);
+      if ((header[field] == 'B') && (header[field + 1] == 'C') && (field_size == 2) &&
+          (field + 6 <= extra_end)) {
+        block_size = read_le16(header + field + 4) + 1;
+      }
+      field += 4 + field_size;
+    }
+    if ((block_size < extra_end + 8) || (block_size > available)) { return false; }
+
+    // the member ends with the CRC and the uncompressed size
+    const uint32_t uncompressed_size = read_le32(header + block_size - 4);
+    if (uncompressed_size != 0) {
+      chunks.push_back({offset + extra_end,
+                        block_size - extra_end - 8,
+                        uncompressed_offset,
+                        uncompressed_size});
+    }
+    uncompressed_offset += uncompressed_size;
+    offset += block_size;
+  }
+  return !chunks.empty();
+}
+
+bool inflate_chunks(const uint8_t* data, const std::vector<DeflateChunk>& chunks, size_t skip,
+                    Volume& volume) {
+#ifdef VOLUME_LOADER_NVCOMP
+  // nvCOMP writes whole chunks, use it when they exactly cover the device tensor
+  if ((volume.storage_type_ == nvidia::gxf::MemoryStorageType::kDevice) && (skip == 0) &&
+      !chunks.empty() &&
+      (chunks.back().uncompressed_offset + chunks.back().uncompressed_size ==
+       volume.tensor_->size())) {
+    if (inflate_chunks_gpu(data, chunks, volume)) { return true; }
+    holoscan::log_warn("nvCOMP failed to inflate the volume data, falling back to the CPU");
+  }
+#endif
+  return inflate_chunks_parallel(data, chunks, skip, volume);
+}
+
+std::string ChunkCache::cache_name(const std::string& file_name) {
+  return file_name + ".chunks";
+}
+
+bool ChunkCache::open(const std::string& file_name, size_t skip, size_t size, MappedFile& cache,
+                      std::vector<DeflateChunk>& chunks) {
+  const std::string name = cache_name(file_name);
+  uint64_t source_size, source_time, cache_size, cache_time;
+  if (!file_version(file_name, source_size, source_time) ||
+      !file_version(name, cache_size, cache_time) || (cache_size < sizeof(ChunkCacheHeader))) {
+    return false;
+  }
+  if (!cache.open(name)) { return false; }
+
+  ChunkCacheHeader header;
+  memcpy(&header, cache.data(), sizeof(header));
+  if ((header.magic != kChunkCacheMagic) || (header.version != kChunkCacheVersion) ||
+      (header.source_size != source_size) || (header.source_time != source_time) ||
+      (header.skip != skip) || (header.size != size) || (header.chunk_size == 0) ||
+      (header.chunk_count != (size + header.chunk_size - 1) / header.chunk_size) ||
+      (header.chunk_count > (cache.size() - sizeof(header)) / sizeof(uint64_t))) {
+    holoscan::log_info("Ignoring outdated chunk cache {}", name);
+    return false;
+  }
+
+  const size_t index_offset = cache.size() - header.chunk_count * sizeof(uint64_t);
+  chunks.resize(header.chunk_count);
+  uint64_t compressed_offset = sizeof(header);
+  for (uint64_t index = 0; index < header.chunk_count; ++index) {
+    uint64_t compressed_size;
+    memcpy(&compressed_size,
+           cache.data() + index_offset + index * sizeof(uint64_t),
+           sizeof(compressed_size));
+    const uint64_t uncompressed_offset = index * header.chunk_size;
+    chunks[index] = {compressed_offset,
+                     compressed_size,
+                     uncompressed_offset,
+                     std::min<uint64_t>(header.chunk_size, size - uncompressed_offset)};
+    compressed_offset += compressed_size;
+  }
+  if (compressed_offset != index_offset) {
+    holoscan::log_warn("Ignoring corrupt chunk cache {}", name);
+    return false;
+  }
+  return true;
+}
+
+ChunkCache::~ChunkCache() {
+  if (!temp_name_.empty()) {
+    // not closed, wait for the workers and remove the incomplete cache
+    error_ = true;
+    for (auto& pending : pending_) { pending.wait(); }
+    file_.close();
+    std::remove(temp_name_.c_str());
+  }
+}
+
+bool ChunkCache::create(const std::string& file_name, size_t skip, size_t size) {
+  cache_name_ = cache_name(file_name);
+  if (!file_version(file_name, source_size_, source_time_)) { return false; }
+  skip_ = skip;
+  size_ = size;
+
+  // written to a temporary file first, so an interrupted load leaves no invalid cache
+  temp_name_ = cache_name_ + ".tmp";
+  file_.open(temp_name_, std::ios::out | std::ios::binary | std::ios::trunc);
+  if (!file_.is_open()) {
+    holoscan::log_warn("Could not create the chunk cache {}", temp_name_);
+    temp_name_.clear();
+    return false;
+  }
+  const ChunkCacheHeader header{};
+  file_.write(reinterpret_cast<const char*>(&header), sizeof(header));
+  chunk_.reserve(kChunkSize);
+  return true;
+}
+
+void ChunkCache::append(const uint8_t* data, size_t size) {
+  while ((size > 0) && !error_) {
+    const size_t chunk_size = std::min(size, kChunkSize - chunk_.size());
+    chunk_.insert(chunk_.end(), data, data + chunk_size);
+    data += chunk_size;
+    size -= chunk_size;
+    appended_ += chunk_size;
+    if (chunk_.size() == kChunkSize) {
+      pending_.push_back(std::async(std::launch::async, deflate_chunk, std::move(chunk_)));
+      chunk_ = std::vector<uint8_t>();
+      chunk_.reserve(kChunkSize);
+      // bound the memory held by chunks in flight
+      write_pending(std::max(1u, std::thread::hardware_concurrency()));
+    }
+  }
+}
+
+bool ChunkCache::write_pending(size_t max_pending) {
+  while (pending_.size() > max_pending) {
+    std::vector<uint8_t> compressed = pending_.front().get();
+    pending_.pop_front();
+    if (compressed.empty()) { error_ = true; }
+    if (error_) { continue; }
+    file_.write(reinterpret_cast<const char*>(compressed.data()), compressed.size());
+    compressed_sizes_.push_back(compressed.size());
+  }
+  return !error_ && file_.good();
+}
+
+bool ChunkCache::close() {
+  if (temp_name_.empty()) { return false; }
+  if (!chunk_.empty()) {
+    pending_.push_back(std::async(std::launch::async, deflate_chunk, std::move(chunk_)));
+  }
+  if (!write_pending(0) || (appended_ != size_)) {
+    holoscan::log_warn("Failed to write the chunk cache {}", cache_name_);
+    return false;
+  }
+
+  file_.write(reinterpret_cast<const char*>(compressed_sizes_.data()),
+              compressed_sizes_.size() * sizeof(uint64_t));
+  const ChunkCacheHeader header{kChunkCacheMagic,
+                                kChunkCacheVersion,
+                                source_size_,
+                                source_time_,
+                                skip_,
+                                size_,
+                                kChunkSize,
+                                compressed_sizes_.size()};
+  file_.seekp(0);
+  file_.write(reinterpret_cast<const char*>(&header), sizeof(header));
+  file_.close();
+  if (!file_.good() || (std::rename(temp_name_.c_str(), cache_name_.c_str()) != 0)) {
+    holoscan::log_warn("Failed to write the chunk cache {}", cache_name_);
+    return false;
+  }
+  temp_name_.clear();
+  holoscan::log_info("Wrote chunk cache {}", cache_name_);
+  return true;
+}
+
+}  // namespace holoscan::ops
@@ -0,0 +1,120 @@
+/* SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef VOLUME_LOADER_CHUNKED_INFLATE
+#define VOLUME_LOADER_CHUNKED_INFLATE
+
+#include <cstdint>
+#include <deque>
+#include <fstream>
+#include <future>
+#include <string>
+#include <vector>
+
+namespace holoscan::ops {
+
+class MappedFile;
+class Volume;
+
+/// Independently compressed raw deflate chunk of a stream
+struct DeflateChunk {
+  uint64_t compressed_offset;
+  uint64_t compressed_size;
+  uint64_t uncompressed_offset;
+  uint64_t uncompressed_size;
+};
+
+/**
+ * Find the members of a BGZF file (gzip with independently compressed blocks, as written by
+ * bgzip). The block sizes are in the gzip headers, so no decompression is needed.
+ *
+ * @param data [in] compressed data
+ * @param size [in] size of the compressed data
+ * @param chunks [out] deflate chunks of the blocks, offsets relative to data
+ *
+ * @returns false if the data is not BGZF
+ */
+bool find_bgzf_chunks(const uint8_t* data, size_t size, std::vector<DeflateChunk>& chunks);
+
+/**
+ * Inflate independent deflate chunks to the tensor of the volume in parallel, with nvCOMP on the
+ * GPU for device tensors when the operator is built with it, else with one thread per core.
+ *
+ * @param data [in] compressed data the chunk offsets are relative to
+ * @param chunks [in] chunks, in order and contiguous in uncompressed space
+ * @param skip [in] uncompressed bytes preceding the volume data
+ * @param volume [in] volume with allocated tensor
+ */
+bool inflate_chunks(const uint8_t* data, const std::vector<DeflateChunk>& chunks, size_t skip,
+                    Volume& volume);
+
+/**
+ * Chunk cache of a compressed data file: the volume data recompressed in independent chunks, so
+ * that the next loads inflate in parallel. The cache is next to the data file and only valid for
+ * the size and modification time of the data file it was written from.
+ */
+class ChunkCache {
+ public:
+  /// Name of the cache of a data file
+  static std::string cache_name(const std::string& file_name);
+
+  /**
+   * Map the cache of a data file.
+   *
+   * @param file_name [in] compressed data file
+   * @param skip [in] uncompressed bytes preceding the volume data
+   * @param size [in] size of the volume data
+   * @param cache [out] mapped cache
+   * @param chunks [out] chunks of the cache, offsets relative to cache.data()
+   *
+   * @returns false if there is no valid cache
+   */
+  static bool open(const std::string& file_name, size_t skip, size_t size, MappedFile& cache,
+                   std::vector<DeflateChunk>& chunks);
+
+  ~ChunkCache();
+
+  /// Start writing the cache of a data file
+  bool create(const std::string& file_name, size_t skip, size_t size);
+
+  /// Append volume data, chunks are compressed on worker threads
+  void append(const uint8_t* data, size_t size);
+
+  /// Write the remaining chunks and the index, returns false if the cache is incomplete
+  bool close();
+
+ private:
+  bool write_pending(size_t max_pending);
+
+  static constexpr size_t kChunkSize = 4 * 1024 * 1024;
+
+  std::string cache_name_;
+  std::string temp_name_;
+  std::ofstream file_;
+  uint64_t source_size_ = 0;
+  uint64_t source_time_ = 0;
+  uint64_t skip_ = 0;
+  uint64_t size_ = 0;
+  uint64_t appended_ = 0;
+  std::vector<uint8_t> chunk_;
+  std::deque<std::future<std::vector<uint8_t>>> pending_;
+  std::vector<uint64_t> compressed_sizes_;
+  bool error_ = false;
+};
+
+}  // namespace holoscan::ops
+
+#endif /* VOLUME_LOADER_CHUNKED_INFLATE */
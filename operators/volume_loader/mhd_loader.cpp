@@ -20,9 +20,8 @@
 #include <array>
 #include <filesystem>
 
-#include <zlib.h>
-
 #include "volume.hpp"
+#include "volume_stream.hpp"
 
 namespace holoscan::ops {
 
@@ -122,82 +121,18 @@ bool load_mhd(const std::string& file_name, Volume& volume) {
     }
   }
 
-  const size_t data_size =
-      dims[0] * dims[1] * dims[2] * nvidia::gxf::PrimitiveTypeSize(primitive_type);
-  std::unique_ptr<uint8_t> data(new uint8_t[data_size]);
-
-  std::ifstream file;
-
-  file.open(data_file_name, std::ios::in | std::ios::binary | std::ios::ate);
-  if (!file.is_open()) {
-    holoscan::log_error("MHD could not open {}", data_file_name);
-    return false;
-  }
-  const std::streampos file_size = file.tellg();
-  file.seekg(0, std::ios_base::beg);
-
-  if (compressed) {
-    // need to uncompress, first read to 'compressed_data' vector and then uncompress to 'data'
-    std::vector<uint8_t> compressed_data(file_size);
-
-    // read
-    file.read(reinterpret_cast<char*>(compressed_data.data()), compressed_data.size());
-
-    // uncompress
-    z_stream strm{};
-    int result = inflateInit2(&strm, 32 + MAX_WBITS);
-    if (result != Z_OK) {
-      holoscan::log_error("MHD failed to uncompress {}, inflateInit2 failed with error code {}",
-                          data_file_name,
-                          result);
-      return false;
-    }
-
-    strm.next_in = compressed_data.data();
-    strm.avail_in = compressed_data.size();
-    strm.next_out = data.get();
-    strm.avail_out = data_size;
-
-    result = inflate(&strm, Z_FINISH);
-    inflateEnd(&strm);
-    if (result != Z_STREAM_END) {
-      holoscan::log_error(
-          "MHD failed to uncompress {}, inflate failed with error code {}", data_file_name, result);
-      return false;
-    }
-  } else {
-    file.read(reinterpret_cast<char*>(data.get()), data_size);
-  }
-
   // allocate the tensor
-  if (!volume.tensor_->reshapeCustom(nvidia::gxf::Shape(dims),
-                                     primitive_type,
-                                     nvidia::gxf::PrimitiveTypeSize(primitive_type),
-                                     nvidia::gxf::Unexpected{GXF_UNINITIALIZED_VALUE},
-                                     volume.storage_type_,
-                                     volume.allocator_)) {
+  if (!volume.Allocate(nvidia::gxf::Shape(dims), primitive_type)) {
     holoscan::log_error("MHD failed to reshape tensor");
     return false;
   }
 
-  // copy the data
-  switch (volume.storage_type_) {
-    case nvidia::gxf::MemoryStorageType::kDevice:
-      if (cudaMemcpy(volume.tensor_->pointer(),
-                     reinterpret_cast<const void*>(data.get()),
-                     data_size,
-                     cudaMemcpyHostToDevice) != cudaSuccess) {
-        holoscan::log_error("MHD failed to copy to GPU memory");
-        return false;
-      }
-      break;
-    case nvidia::gxf::MemoryStorageType::kHost:
-    case nvidia::gxf::MemoryStorageType::kSystem:
-      memcpy(volume.tensor_->pointer(), data.get(), data_size);
-      break;
-    default:
-      holoscan::log_error("MHD unhandled storage type {}", int(volume.storage_type_));
-      return false;
+  // stream the data to the tensor
+  const bool loaded = compressed ? load_compressed_data(data_file_name, 0, volume)
+                                 : load_raw_data(data_file_name, 0, volume);
+  if (!loaded) {
+    holoscan::log_error("MHD failed to load data {}", data_file_name);
+    return false;
   }
 
   return true;
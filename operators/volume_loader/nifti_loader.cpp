@@ -22,6 +22,7 @@
 #include <nifti2_io.h>
 
 #include "volume.hpp"
+#include "volume_stream.hpp"
 
 namespace holoscan::ops {
 
@@ -39,8 +40,9 @@ bool is_nifty(const std::string& file_name) {
 bool load_nifty(const std::string& file_name, Volume& volume) {
   std::filesystem::path path(file_name);
 
+  // read the header only, the data is streamed to the tensor below
   std::unique_ptr<nifti_image> image;
-  image.reset(nifti_image_read(file_name.c_str(), true));
+  image.reset(nifti_image_read(file_name.c_str(), false));
   if (!image) { return false; }
 
   if ((image->ndim != 3) && (image->ndim != 4)) {
@@ -150,16 +152,30 @@ bool load_nifty(const std::string& file_name, Volume& volume) {
   dims.push_back(image->ny);
   dims.push_back(image->nx);
 
-  if (!volume.tensor_->reshapeCustom(nvidia::gxf::Shape(dims),
-                                     primitive_type,
-                                     nvidia::gxf::PrimitiveTypeSize(primitive_type),
-                                     nvidia::gxf::Unexpected{GXF_UNINITIALIZED_VALUE},
-                                     volume.storage_type_,
-                                     volume.allocator_)) {
+  if (!volume.Allocate(nvidia::gxf::Shape(dims), primitive_type)) {
     holoscan::log_error("NIFTI failed to reshape tensor");
     return false;
   }
 
+  // load the data, with the NIfTI library if it has to be byte swapped
+  if ((image->nbyper == 1) || (image->byteorder == nifti_short_order())) {
+    const std::string data_file_name = image->iname;
+    const bool loaded =
+        nifti_is_gzfile(image->iname)
+            ? load_compressed_data(data_file_name, 0, volume, image->iname_offset)
+            : load_raw_data(data_file_name, image->iname_offset, volume);
+    if (!loaded) {
+      holoscan::log_error("NIFTI failed to load data {}", data_file_name);
+      return false;
+    }
+    return true;
+  }
+
+  if (nifti_image_load(image.get()) != 0) {
+    holoscan::log_error("NIFTI failed to load data {}", file_name);
+    return false;
+  }
+
   // copy the data
   switch (volume.storage_type_) {
     case nvidia::gxf::MemoryStorageType::kDevice:
@@ -22,9 +22,8 @@
 #include <filesystem>
 #include <string>
 
-#include <zlib.h>
-
 #include "volume.hpp"
+#include "volume_stream.hpp"
 
 namespace holoscan::ops {
 
@@ -83,47 +82,6 @@ bool is_nrrd(const std::string& file_name) {
   return false;
 }
 
-bool load_nrrd_data(bool compressed, std::ifstream& file, const size_t data_size,
-                    const std::unique_ptr<uint8_t>& data) {
-  if (compressed) {
-    // need to uncompress, first read to 'compressed_data' vector and then uncompress to 'data'
-    const std::streampos data_start = file.tellg();
-    file.seekg(0, std::ios_base::end);
-    const std::streampos file_size = file.tellg() - data_start;
-    file.seekg(data_start);
-    std::vector<uint8_t> compressed_data(file_size);
-
-    // read
-    file.read(reinterpret_cast<char*>(compressed_data.data()), compressed_data.size());
-
-    // uncompress
-    z_stream strm{};
-    int result = inflateInit2(&strm, 32 + MAX_WBITS);
-    if (result != Z_OK) {
-      holoscan::log_error("NRRD failed to uncompress, inflateInit2 failed with error code {}",
-                          result);
-      return false;
-    }
-
-    strm.next_in = compressed_data.data();
-    strm.avail_in = compressed_data.size();
-    strm.next_out = data.get();
-    strm.avail_out = data_size;
-
-    result = inflate(&strm, Z_FINISH);
-    inflateEnd(&strm);
-    if (result != Z_STREAM_END) {
-      holoscan::log_error("NRRD failed to uncompress, inflate failed with error code {}", result);
-      return false;
-    }
-
-  } else {
-    file.read(reinterpret_cast<char*>(data.get()), data_size);
-  }
-
-  return true;
-}
-
 bool parse_headers(const std::string& file_name, const std::string& key, const std::string& value,
                    bool& compressed, std::array<int32_t, 3>& dims, Volume& volume,
                    nvidia::gxf::PrimitiveType& primitive_type, std::string& data_file_name) {
@@ -262,53 +220,27 @@ bool load_nrrd(const std::string& file_name, Volume& volume) {
     }
   }
 
-  const size_t data_size =
-      dims[0] * dims[1] * dims[2] * nvidia::gxf::PrimitiveTypeSize(primitive_type);
-  std::unique_ptr<uint8_t> data(new uint8_t[data_size]);
-
-  if (data_file_name.empty()) {
-    // seek to start of data
-    file.seekg(byte_skip, std::ios_base::beg);
-  } else {
-    // if there is a separate data file, open that
-    file.open(data_file_name, std::ios::in);
-  }
-
-  if (!load_nrrd_data(compressed, file, data_size, data)) {
-    holoscan::log_error("NRRD failed to load data {}",
-                        data_file_name.empty() ? file_name : data_file_name);
-    return false;
-  }
-
   // allocate the tensor
-  if (!volume.tensor_->reshapeCustom(nvidia::gxf::Shape(dims),
-                                     primitive_type,
-                                     nvidia::gxf::PrimitiveTypeSize(primitive_type),
-                                     nvidia::gxf::Unexpected{GXF_UNINITIALIZED_VALUE},
-                                     volume.storage_type_,
-                                     volume.allocator_)) {
+  if (!volume.Allocate(nvidia::gxf::Shape(dims), primitive_type)) {
     holoscan::log_error("NRRD failed to reshape tensor");
     return false;
   }
 
-  // copy the data
-  switch (volume.storage_type_) {
-    case nvidia::gxf::MemoryStorageType::kDevice:
-      if (cudaMemcpy(volume.tensor_->pointer(),
-                     reinterpret_cast<const void*>(data.get()),
-                     data_size,
-                     cudaMemcpyHostToDevice) != cudaSuccess) {
-        holoscan::log_error("NRRD failed to copy to GPU memory");
-        return false;
-      }
-      break;
-    case nvidia::gxf::MemoryStorageType::kHost:
-    case nvidia::gxf::MemoryStorageType::kSystem:
-      memcpy(volume.tensor_->pointer(), data.get(), data_size);
-      break;
-    default:
-      holoscan::log_error("NRRD unhandled storage type {}", int(volume.storage_type_));
-      return false;
+  // the data follows the header or is in a separate data file
+  file.close();
+  size_t data_offset = byte_skip;
+  if (!data_file_name.empty()) {
+    data_offset = 0;
+  } else {
+    data_file_name = file_name;
+  }
+
+  // stream the data to the tensor
+  const bool loaded = compressed ? load_compressed_data(data_file_name, data_offset, volume)
+                                 : load_raw_data(data_file_name, data_offset, volume);
+  if (!loaded) {
+    holoscan::log_error("NRRD failed to load data {}", data_file_name);
+    return false;
   }
 
   return true;
@@ -26,6 +26,7 @@
 #include <cstdint>
 #include <memory>
 #include <string>
+#include <vector>
 
 #include <holoscan/core/fragment.hpp>
 #include <holoscan/core/operator.hpp>
@@ -60,8 +61,20 @@ class PyVolumeLoaderOp : public VolumeLoaderOp {
   // Define a constructor that fully initializes the object.
   PyVolumeLoaderOp(Fragment* fragment, const py::args& args,
                    const std::shared_ptr<Allocator>& allocator, const std::string& file_name,
+                   bool chunk_cache = false, const std::string& storage_type = "device",
+                   const std::vector<std::string>& file_names = std::vector<std::string>{},
+                   const std::string& file_pattern = "", uint32_t prefetch_frames = 4,
+                   float frame_duration = 0.f, bool loop = true,
                    const std::string& name = "volume_loader")
-      : VolumeLoaderOp(ArgList{Arg{"allocator", allocator}, Arg{"file_name", file_name}}) {
+      : VolumeLoaderOp(ArgList{Arg{"allocator", allocator},
+                               Arg{"file_name", file_name},
+                               Arg{"chunk_cache", chunk_cache},
+                               Arg{"storage_type", storage_type},
+                               Arg{"file_names", file_names},
+                               Arg{"file_pattern", file_pattern},
+                               Arg{"prefetch_frames", prefetch_frames},
+                               Arg{"frame_duration", frame_duration},
+                               Arg{"loop", loop}}) {
     add_positional_condition_and_resource_args(this, args);
     name_ = name;
     fragment_ = fragment;
@@ -93,10 +106,24 @@ PYBIND11_MODULE(_volume_loader, m) {
                     const py::args&,
                     const std::shared_ptr<Allocator>&,
                     const std::string&,
+                    bool,
+                    const std::string&,
+                    const std::vector<std::string>&,
+                    const std::string&,
+                    uint32_t,
+                    float,
+                    bool,
                     const std::string&>(),
            "fragment"_a,
            "allocator"_a,
            "file_name"_a = "",
+           "chunk_cache"_a = false,
+           "storage_type"_a = "device"s,
+           "file_names"_a = std::vector<std::string>{},
+           "file_pattern"_a = ""s,
+           "prefetch_frames"_a = 4u,
+           "frame_duration"_a = 0.f,
+           "loop"_a = true,
            "name"_a = "volume_loader"s,
            doc::VolumeLoaderOp::doc_VolumeLoaderOp_python)
       .def("setup", &VolumeLoaderOp::setup, "spec"_a, doc::VolumeLoaderOp::doc_setup);
@@ -47,6 +47,27 @@ allocator: ``holoscan.resources.Allocator``
     Allocator used to allocate the volume data
 file_name : str, optional
     Volume data file name
+chunk_cache : bool, optional
+    Write a chunk cache (``<data file>.chunks``) next to compressed data files and use it on the
+    next loads to inflate them in parallel. Default value is ``False``.
+storage_type : str, optional
+    Memory the volume is loaded to, ``"device"``, pinned ``"host"`` or pageable ``"system"``
+    memory. Volumes larger than device memory are loaded to system memory and bricked by the
+    volume renderer. Default value is ``"device"``.
+file_names : list of str, optional
+    Volume files of a sequence. When set, or when `file_pattern` is set, the operator plays the
+    sequence back instead of loading a single file: volumes are prefetched on a background
+    thread and emitted every `frame_duration`.
+file_pattern : str, optional
+    Glob pattern of the volume files of a sequence, played back in sorted order.
+prefetch_frames : int, optional
+    Number of sequence volumes loaded ahead into reused tensors. Sequences with at most that
+    many volumes stay resident. Default value is ``4``.
+frame_duration : float, optional
+    Time in seconds each sequence volume is shown. If 0, the frame duration of the volume files
+    is used, else one second. Default value is ``0``.
+loop : bool, optional
+    Restart the sequence after the last volume. Default value is ``True``.
 name : str, optional
     The name of the operator.
 )doc")
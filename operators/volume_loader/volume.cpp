@@ -16,6 +16,10 @@
 
 #include "volume.hpp"
 
+#include "mhd_loader.hpp"
+#include "nifti_loader.hpp"
+#include "nrrd_loader.hpp"
+
 namespace holoscan::ops {
 
 bool Volume::SetOrientation(const std::string& orientation) {
@@ -59,4 +63,40 @@ bool Volume::SetOrientation(const std::string& orientation) {
   return true;
 }
 
+bool Volume::Allocate(const nvidia::gxf::Shape& shape, nvidia::gxf::PrimitiveType primitive_type) {
+  if (tensor_->pointer() && (tensor_->shape() == shape) &&
+      (tensor_->element_type() == primitive_type) && (tensor_->storage_type() == storage_type_)) {
+    return true;
+  }
+  return bool(tensor_->reshapeCustom(shape,
+                                     primitive_type,
+                                     nvidia::gxf::PrimitiveTypeSize(primitive_type),
+                                     nvidia::gxf::Unexpected{GXF_UNINITIALIZED_VALUE},
+                                     storage_type_,
+                                     allocator_));
+}
+
+bool load_volume(const std::string& file_name, Volume& volume) {
+  if (is_nifty(file_name)) {
+    if (!load_nifty(file_name, volume)) {
+      holoscan::log_error("Failed to load nifty file {}", file_name);
+      return false;
+    }
+  } else if (is_mhd(file_name)) {
+    if (!load_mhd(file_name, volume)) {
+      holoscan::log_error("Failed to load mhd file {}", file_name);
+      return false;
+    }
+  } else if (is_nrrd(file_name)) {
+    if (!load_nrrd(file_name, volume)) {
+      holoscan::log_error("Failed to load nrrd file {}", file_name);
+      return false;
+    }
+  } else {
+    holoscan::log_error("File is not a supported volume format {}", file_name);
+    return false;
+  }
+  return true;
+}
+
 }  // namespace holoscan::ops
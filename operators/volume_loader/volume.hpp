@@ -46,6 +46,15 @@ class Volume {
    */
   bool SetOrientation(const std::string& orientation);
 
+  /**
+   * Allocate the tensor with the given shape and element type. The memory of the tensor is kept if
+   * it already has that layout, so that tensors reused for several volumes are not reallocated.
+   *
+   * @param shape [in] tensor shape
+   * @param primitive_type [in] element type
+   */
+  bool Allocate(const nvidia::gxf::Shape& shape, nvidia::gxf::PrimitiveType primitive_type);
+
   /// spacing between elements in millimeter
   std::array<float, 3> spacing_{1.f, 1.f, 1.f};
   /// axis permutation
@@ -53,15 +62,26 @@ class Volume {
   /// axis flip
   std::array<bool, 3> flip_axes_{false, false, false};
   /// frame duration
-  std::chrono::duration<float> frame_duration_;
+  std::chrono::duration<float> frame_duration_{0.f};
   /// space origin
   std::array<double, 3> space_origin_{0.0, 0.0, 0.0};
 
+  /// write and use chunk caches of compressed data files to inflate them in parallel
+  bool chunk_cache_ = false;
+
   nvidia::gxf::MemoryStorageType storage_type_ = nvidia::gxf::MemoryStorageType::kDevice;
   nvidia::gxf::Handle<nvidia::gxf::Allocator> allocator_;
   nvidia::gxf::Handle<nvidia::gxf::Tensor> tensor_;
 };
 
+/**
+ * Load a volume from a file of any of the supported formats.
+ *
+ * @param file_name [in] volume file
+ * @param volume [in] volume to load to
+ */
+bool load_volume(const std::string& file_name, Volume& volume);
+
 }  // namespace holoscan::ops
 
 #endif /* VOLUME_LOADER_VOLUME */
@@ -16,30 +16,95 @@
  */
 #include "volume_loader.hpp"
 
-#include "mhd_loader.hpp"
-#include "nifti_loader.hpp"
-#include "nrrd_loader.hpp"
+#include <glob.h>
+
+#include <algorithm>
+
 #include "volume.hpp"
+#include "volume_sequence.hpp"
 
 namespace holoscan::ops {
 
+namespace {
+
+// How often a sequence checks whether the next volume is due
+constexpr std::chrono::milliseconds kSequencePollPeriod(2);
+
+nvidia::gxf::MemoryStorageType to_storage_type(const std::string& storage_type) {
+  if (storage_type == "device") { return nvidia::gxf::MemoryStorageType::kDevice; }
+  if (storage_type == "host") { return nvidia::gxf::MemoryStorageType::kHost; }
+  if (storage_type == "system") { return nvidia::gxf::MemoryStorageType::kSystem; }
+  throw std::runtime_error("VolumeLoaderOp: unknown storage type '" + storage_type +
+                           "', expected 'device', 'host' or 'system'");
+}
+
+}  // namespace
+
 void VolumeLoaderOp::initialize() {
+  // in sequence mode, poll for due volumes instead of running continuously
+  if (sequence_mode_) {
+    add_arg(fragment()->make_condition<PeriodicCondition>(name() + "_sequence_period",
+                                                          kSequencePollPeriod));
+  }
+
   // call base class
   Operator::initialize();
 }
 
 void VolumeLoaderOp::setup(OperatorSpec& spec) {
-  // only add the file_name input port if no file name had been set as parameter
+  // only add the file_name input port if no file name had been set as parameter and this is not
+  // a sequence
   bool has_file_name_set = false;
   for (auto&& arg : args()) {
     if (arg.name() == "file_name") {
       has_file_name_set = arg.has_value() && !std::any_cast<std::string>(arg.value()).empty();
+    } else if (arg.name() == "file_names") {
+      sequence_mode_ = arg.has_value() &&
+                       !std::any_cast<std::vector<std::string>>(arg.value()).empty();
+    } else if (arg.name() == "file_pattern") {
+      sequence_mode_ = arg.has_value() && !std::any_cast<std::string>(arg.value()).empty();
     }
   }
-  if (!has_file_name_set) { spec.input<std::string>("file_name"); }
+  if (!has_file_name_set && !sequence_mode_) { spec.input<std::string>("file_name"); }
 
   spec.param(file_name_, "file_name", "FileName", "Volume data file name", {});
   spec.param(allocator_, "allocator", "Allocator", "Allocator used to allocate the volume data");
+  spec.param(chunk_cache_,
+             "chunk_cache",
+             "ChunkCache",
+             "Write a chunk cache next to compressed data files and use it on the next loads to "
+             "inflate them in parallel",
+             false);
+  spec.param(storage_type_,
+             "storage_type",
+             "StorageType",
+             "Memory the volume is loaded to, 'device', pinned 'host' or pageable 'system' memory. "
+             "Volumes larger than device memory are loaded to system memory and bricked by the "
+             "volume renderer.",
+             std::string("device"));
+  spec.param(file_names_,
+             "file_names",
+             "FileNames",
+             "Volume files of a sequence, played back in order",
+             std::vector<std::string>{});
+  spec.param(file_pattern_,
+             "file_pattern",
+             "FilePattern",
+             "Glob pattern of the volume files of a sequence, played back in sorted order",
+             std::string{});
+  spec.param(prefetch_frames_,
+             "prefetch_frames",
+             "PrefetchFrames",
+             "Number of sequence volumes loaded ahead on a background thread. Sequences with at "
+             "most that many volumes stay resident.",
+             4u);
+  spec.param(frame_duration_,
+             "frame_duration",
+             "FrameDuration",
+             "Time in seconds each sequence volume is shown. If 0, the frame duration of the "
+             "volume files is used, else one second.",
+             0.f);
+  spec.param(loop_, "loop", "Loop", "Restart the sequence after the last volume", true);
 
   spec.output<holoscan::gxf::Entity>("volume");
   spec.output<std::array<float, 3>>("spacing").condition(ConditionType::kNone);
@@ -51,10 +116,78 @@ void VolumeLoaderOp::setup(OperatorSpec& spec) {
       .condition(ConditionType::kNone);
 }
 
+std::vector<std::string> VolumeLoaderOp::sequence_file_names() {
+  std::vector<std::string> file_names = file_names_.get();
+  if (file_names.empty() && !file_pattern_.get().empty()) {
+    glob_t result{};
+    if (glob(file_pattern_.get().c_str(), 0, nullptr, &result) == 0) {
+      for (size_t index = 0; index < result.gl_pathc; ++index) {
+        file_names.emplace_back(result.gl_pathv[index]);
+      }
+    }
+    globfree(&result);
+    std::sort(file_names.begin(), file_names.end());
+  }
+  return file_names;
+}
+
+void VolumeLoaderOp::start() {
+  if (!sequence_mode_) { return; }
+  if (!allocator_.get()) { throw std::runtime_error("No allocator set."); }
+
+  auto file_names = sequence_file_names();
+  if (file_names.empty()) {
+    throw std::runtime_error("VolumeLoaderOp: no volume files found for the sequence");
+  }
+  if (prefetch_frames_.get() == 0) { throw std::runtime_error("prefetch_frames must not be 0"); }
+
+  void* context = fragment()->executor().context();
+  Volume prototype;
+  prototype.allocator_ =
+      nvidia::gxf::Handle<nvidia::gxf::Allocator>::Create(context, allocator_.get()->gxf_cid())
+          .value();
+  prototype.chunk_cache_ = chunk_cache_.get();
+  prototype.storage_type_ = to_storage_type(storage_type_.get());
+  holoscan::log_info("VolumeLoaderOp: playing a sequence of {} volumes", file_names.size());
+  sequence_ = std::make_shared<VolumeSequence>(
+      std::move(file_names), prefetch_frames_.get(), loop_.get(), context, prototype);
+  sequence_->start();
+  next_frame_time_ = std::chrono::steady_clock::now();
+}
+
+void VolumeLoaderOp::stop() {
+  // volumes still held downstream keep the sequence alive until they are released
+  sequence_.reset();
+}
+
 void VolumeLoaderOp::compute(InputContext& input, OutputContext& output,
                              ExecutionContext& context) {
   if (!allocator_.get()) { throw std::runtime_error("No allocator set."); }
 
+  if (sequence_) {
+    const auto now = std::chrono::steady_clock::now();
+    if (now < next_frame_time_) { return; }
+
+    auto entity = gxf::Entity::New(&context);
+    const Volume* volume = sequence_->next(entity);
+    // not loaded yet, the volume is shown as soon as it is
+    if (!volume) { return; }
+
+    std::chrono::duration<float> frame_duration(frame_duration_.get());
+    if (frame_duration.count() <= 0.f) { frame_duration = volume->frame_duration_; }
+    if (frame_duration.count() <= 0.f) { frame_duration = std::chrono::duration<float>(1.f); }
+    // keep the frame rate unless the volume was late by more than a frame
+    next_frame_time_ +=
+        std::chrono::duration_cast<std::chrono::steady_clock::duration>(frame_duration);
+    if (next_frame_time_ < now) {
+      next_frame_time_ =
+          now + std::chrono::duration_cast<std::chrono::steady_clock::duration>(frame_duration);
+    }
+
+    emit(output, entity, *volume);
+    return;
+  }
+
   std::string file_name = file_name_.get();
 
   // if no file name had been set by a parameter use the file name received at the input
@@ -71,6 +204,8 @@ void VolumeLoaderOp::compute(InputContext& input, OutputContext& output,
   auto entity = gxf::Entity::New(&context);
 
   Volume volume;
+  volume.chunk_cache_ = chunk_cache_.get();
+  volume.storage_type_ = to_storage_type(storage_type_.get());
 
   // get Handle to underlying nvidia::gxf::Allocator from std::shared_ptr<holoscan::Allocator>
   volume.allocator_ = nvidia::gxf::Handle<nvidia::gxf::Allocator>::Create(
@@ -80,22 +215,13 @@ void VolumeLoaderOp::compute(InputContext& input, OutputContext& output,
   volume.tensor_ =
       static_cast<nvidia::gxf::Entity&>(entity).add<nvidia::gxf::Tensor>("volume").value();
 
-  if (is_nifty(file_name)) {
-    if (!load_nifty(file_name, volume)) {
-      holoscan::log_error("Failed to load nifty file {}", file_name);
-    }
-  } else if (is_mhd(file_name)) {
-    if (!load_mhd(file_name, volume)) {
-      holoscan::log_error("Failed to load mhd file {}", file_name);
-    }
-  } else if (is_nrrd(file_name)) {
-    if (!load_nrrd(file_name, volume)) {
-      holoscan::log_error("Failed to load nrrd file {}", file_name);
-    }
-  } else {
-    holoscan::log_error("File is not a supported volume format {}", file_name);
-  }
+  // errors are logged by the loader
+  load_volume(file_name, volume);
+
+  emit(output, entity, volume);
+}
 
+void VolumeLoaderOp::emit(OutputContext& output, gxf::Entity& entity, const Volume& volume) {
   output.emit(entity, "volume");
   output.emit(volume.spacing_, "spacing");
   output.emit(volume.permute_axis_, "permute_axis");
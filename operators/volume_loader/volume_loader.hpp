@@ -20,19 +20,44 @@
 
 #include <holoscan/holoscan.hpp>
 
+#include <chrono>
+#include <memory>
+#include <string>
+#include <vector>
+
 namespace holoscan::ops {
 
+class Volume;
+class VolumeSequence;
+
 class VolumeLoaderOp : public Operator {
  public:
   HOLOSCAN_OPERATOR_FORWARD_ARGS(VolumeLoaderOp);
 
   void initialize() override;
   void setup(OperatorSpec& spec) override;
+  void start() override;
+  void stop() override;
   void compute(InputContext&, OutputContext& op_output, ExecutionContext&) override;
 
  private:
+  void emit(OutputContext& output, gxf::Entity& entity, const Volume& volume);
+  std::vector<std::string> sequence_file_names();
+
   Parameter<std::string> file_name_;
   Parameter<std::shared_ptr<Allocator>> allocator_;
+  Parameter<bool> chunk_cache_;
+  Parameter<std::string> storage_type_;
+  Parameter<std::vector<std::string>> file_names_;
+  Parameter<std::string> file_pattern_;
+  Parameter<uint32_t> prefetch_frames_;
+  Parameter<float> frame_duration_;
+  Parameter<bool> loop_;
+
+  // sequence mode, with file_names or file_pattern
+  bool sequence_mode_ = false;
+  std::shared_ptr<VolumeSequence> sequence_;
+  std::chrono::steady_clock::time_point next_frame_time_;
 };
 
 }  // namespace holoscan::ops
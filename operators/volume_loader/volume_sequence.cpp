@@ -0,0 +1,134 @@
+/* SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "volume_sequence.hpp"
+
+#include <algorithm>
+#include <utility>
+
+namespace holoscan::ops {
+
+VolumeSequence::VolumeSequence(std::vector<std::string> file_names, size_t ring_size, bool loop,
+                               void* context, const Volume& prototype)
+    : file_names_(std::move(file_names)),
+      loop_(loop),
+      resident_(file_names_.size() <= ring_size),
+      slots_(std::min(ring_size, file_names_.size())) {
+  for (auto& slot : slots_) {
+    auto entity = nvidia::gxf::Entity::New(context);
+    if (!entity) { throw std::runtime_error("Failed to create the volume sequence entity"); }
+    slot.entity = std::move(entity.value());
+    slot.volume.storage_type_ = prototype.storage_type_;
+    slot.volume.allocator_ = prototype.allocator_;
+    slot.volume.chunk_cache_ = prototype.chunk_cache_;
+    slot.volume.tensor_ = slot.entity.add<nvidia::gxf::Tensor>("volume").value();
+  }
+}
+
+VolumeSequence::~VolumeSequence() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stop_ = true;
+  }
+  condition_.notify_all();
+  if (thread_.joinable()) { thread_.join(); }
+}
+
+void VolumeSequence::start() {
+  thread_ = std::thread([this] { run(); });
+}
+
+void VolumeSequence::run() {
+  for (size_t index = 0; loop_ || (index < file_names_.size()); ++index) {
+    // resident sequences are loaded once
+    if (resident_ && (index == file_names_.size())) { return; }
+
+    Slot& slot = slots_[index % slots_.size()];
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      condition_.wait(lock, [this, &slot] { return stop_ || (slot.state == State::Free); });
+      if (stop_) { return; }
+      slot.state = State::Loading;
+    }
+
+    // the metadata is reset, the tensor memory is reused
+    Volume& volume = slot.volume;
+    const Volume defaults;
+    volume.spacing_ = defaults.spacing_;
+    volume.permute_axis_ = defaults.permute_axis_;
+    volume.flip_axes_ = defaults.flip_axes_;
+    volume.frame_duration_ = defaults.frame_duration_;
+    volume.space_origin_ = defaults.space_origin_;
+    const std::string& file_name = file_names_[index % file_names_.size()];
+    const bool loaded = load_volume(file_name, volume);
+
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      slot.loaded = loaded;
+      slot.state = State::Ready;
+    }
+    condition_.notify_all();
+  }
+}
+
+const Volume* VolumeSequence::next(nvidia::gxf::Entity& entity) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  // volumes which failed to load are skipped, at most once around the ring per call
+  for (size_t tries = 0; (tries < slots_.size()) && (loop_ || (next_index_ < file_names_.size()));
+       ++tries) {
+    const size_t slot_index = next_index_ % slots_.size();
+    Slot& slot = slots_[slot_index];
+    if (slot.state != State::Ready) { return nullptr; }
+    ++next_index_;
+
+    if (!slot.loaded) {
+      // already logged by the loader, skip the volume
+      if (!resident_) { slot.state = State::Free; }
+      condition_.notify_all();
+      continue;
+    }
+
+    const auto& tensor = slot.volume.tensor_;
+    auto output = entity.add<nvidia::gxf::Tensor>("volume");
+    if (!output) { throw std::runtime_error("Failed to add the volume tensor"); }
+    // the slot is handed back once the message is destroyed, keep the ring alive until then
+    auto self = shared_from_this();
+    output.value()->wrapMemory(tensor->shape(),
+                               tensor->element_type(),
+                               tensor->bytes_per_element(),
+                               nvidia::gxf::ComputeTrivialStrides(tensor->shape(),
+                                                                  tensor->bytes_per_element()),
+                               tensor->storage_type(),
+                               tensor->pointer(),
+                               [self, slot_index](void*) {
+                                 self->release(slot_index);
+                                 return nvidia::gxf::Success;
+                               });
+    slot.state = State::Emitted;
+    return &slot.volume;
+  }
+  return nullptr;
+}
+
+void VolumeSequence::release(size_t slot_index) {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    slots_[slot_index].state = resident_ ? State::Ready : State::Free;
+  }
+  condition_.notify_all();
+}
+
+}  // namespace holoscan::ops
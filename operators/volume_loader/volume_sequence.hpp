@@ -0,0 +1,92 @@
+/* SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef VOLUME_LOADER_VOLUME_SEQUENCE
+#define VOLUME_LOADER_VOLUME_SEQUENCE
+
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "volume.hpp"
+
+namespace holoscan::ops {
+
+/**
+ * Prefetches the volumes of a sequence on a background thread into a ring of tensors, which are
+ * allocated once and reused. Sequences that fit into the ring are loaded once and stay resident.
+ */
+class VolumeSequence : public std::enable_shared_from_this<VolumeSequence> {
+ public:
+  /**
+   * Create the ring, loading starts with start().
+   *
+   * @param file_names [in] volume files of the sequence
+   * @param ring_size [in] number of volumes loaded ahead
+   * @param loop [in] restart with the first volume after the last one
+   * @param context [in] GXF context to create the tensors in
+   * @param prototype [in] volume with the storage type, allocator and loader options to use
+   */
+  VolumeSequence(std::vector<std::string> file_names, size_t ring_size, bool loop, void* context,
+                 const Volume& prototype);
+  ~VolumeSequence();
+
+  void start();
+
+  /**
+   * Get the next volume of the sequence if it is loaded, and add it to a message.
+   *
+   * @param entity [in] message to add the "volume" tensor to, the tensor is handed back to the
+   * ring once the last copy of the message is destroyed
+   *
+   * @returns the volume, which must not be modified, or nullptr if the next volume is not loaded
+   * yet or the sequence is over
+   */
+  const Volume* next(nvidia::gxf::Entity& entity);
+
+ private:
+  enum class State { Free, Loading, Ready, Emitted };
+
+  struct Slot {
+    nvidia::gxf::Entity entity;
+    Volume volume;
+    State state = State::Free;
+    bool loaded = false;
+  };
+
+  void run();
+  void release(size_t slot_index);
+
+  const std::vector<std::string> file_names_;
+  const bool loop_;
+  // the whole sequence fits into the ring
+  const bool resident_;
+  std::vector<Slot> slots_;
+
+  std::mutex mutex_;
+  std::condition_variable condition_;
+  bool stop_ = false;
+  // number of volumes handed out
+  size_t next_index_ = 0;
+  std::thread thread_;
+};
+
+}  // namespace holoscan::ops
+
+#endif /* VOLUME_LOADER_VOLUME_SEQUENCE */
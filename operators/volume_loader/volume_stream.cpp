@@ -0,0 +1,339 @@
+/* SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "volume_stream.hpp"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <zlib.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <vector>
+
+#ifdef VOLUME_LOADER_CUFILE
+#include <cufile.h>
+#endif
+
+#include "chunked_inflate.hpp"
+#include "volume.hpp"
+
+namespace holoscan::ops {
+
+MappedFile::~MappedFile() {
+  if (data_) { munmap(data_, size_); }
+  if (fd_ != -1) { close(fd_); }
+}
+
+bool MappedFile::open(const std::string& file_name) {
+  fd_ = ::open(file_name.c_str(), O_RDONLY);
+  if (fd_ == -1) {
+    holoscan::log_error("Could not open {}: {}", file_name, strerror(errno));
+    return false;
+  }
+  struct stat file_stat;
+  if (fstat(fd_, &file_stat) != 0) {
+    holoscan::log_error("Could not get the size of {}: {}", file_name, strerror(errno));
+    return false;
+  }
+  size_ = file_stat.st_size;
+  if (size_ == 0) { return true; }
+
+  void* data = mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd_, 0);
+  if (data == MAP_FAILED) {
+    holoscan::log_error("Could not map {}: {}", file_name, strerror(errno));
+    size_ = 0;
+    return false;
+  }
+  data_ = static_cast<uint8_t*>(data);
+  madvise(data_, size_, MADV_SEQUENTIAL);
+  return true;
+}
+
+VolumeStream::VolumeStream(Volume& volume)
+    : tensor_data_(volume.tensor_->pointer()),
+      size_(volume.tensor_->size()),
+      device_(volume.storage_type_ == nvidia::gxf::MemoryStorageType::kDevice) {
+  if (!device_) { return; }
+
+  if (cudaStreamCreateWithFlags(&stream_, cudaStreamNonBlocking) != cudaSuccess) {
+    holoscan::log_error("Failed to create the upload stream");
+    error_ = true;
+    return;
+  }
+  for (size_t index = 0; index < kStagingBufferCount; ++index) {
+    if ((cudaMallocHost(&staging_buffers_[index], kStagingBufferSize) != cudaSuccess) ||
+        (cudaEventCreateWithFlags(&events_[index], cudaEventDisableTiming) != cudaSuccess)) {
+      holoscan::log_error("Failed to allocate the staging buffers");
+      error_ = true;
+      return;
+    }
+  }
+}
+
+VolumeStream::~VolumeStream() {
+  // the uploads read the staging buffers until they complete
+  if (stream_) { cudaStreamSynchronize(stream_); }
+  for (auto event : events_) {
+    if (event) { cudaEventDestroy(event); }
+  }
+  for (auto buffer : staging_buffers_) {
+    if (buffer) { cudaFreeHost(buffer); }
+  }
+  if (stream_) { cudaStreamDestroy(stream_); }
+}
+
+uint8_t* VolumeStream::acquire(size_t& capacity) {
+  capacity = 0;
+  if (error_ || (remaining() == 0)) { return nullptr; }
+
+  if (!device_) {
+    capacity = remaining();
+    return tensor_data_ + offset_;
+  }
+
+  if (staged_ == 0) {
+    // the buffer is reused once its last upload is done
+    if (cudaEventSynchronize(events_[current_buffer_]) != cudaSuccess) {
+      holoscan::log_error("Failed to upload the volume");
+      error_ = true;
+      return nullptr;
+    }
+  }
+  capacity = std::min(kStagingBufferSize - staged_, remaining() - staged_);
+  return staging_buffers_[current_buffer_] + staged_;
+}
+
+bool VolumeStream::commit(size_t size) {
+  if (error_) { return false; }
+  if (!device_) {
+    offset_ += size;
+    return true;
+  }
+
+  staged_ += size;
+  if ((staged_ == kStagingBufferSize) || (offset_ + staged_ == size_)) { return flush(); }
+  return true;
+}
+
+bool VolumeStream::flush() {
+  if (staged_ == 0) { return true; }
+  if ((cudaMemcpyAsync(tensor_data_ + offset_,
+                       staging_buffers_[current_buffer_],
+                       staged_,
+                       cudaMemcpyHostToDevice,
+                       stream_) != cudaSuccess) ||
+      (cudaEventRecord(events_[current_buffer_], stream_) != cudaSuccess)) {
+    holoscan::log_error("Failed to upload the volume");
+    error_ = true;
+    return false;
+  }
+  offset_ += staged_;
+  staged_ = 0;
+  current_buffer_ = (current_buffer_ + 1) % kStagingBufferCount;
+  return true;
+}
+
+bool VolumeStream::write(const uint8_t* data, size_t size) {
+  while (size > 0) {
+    size_t capacity;
+    uint8_t* dst = acquire(capacity);
+    if (!dst) { return false; }
+    const size_t chunk = std::min(capacity, size);
+    memcpy(dst, data, chunk);
+    if (!commit(chunk)) { return false; }
+    data += chunk;
+    size -= chunk;
+  }
+  return true;
+}
+
+bool VolumeStream::finish() {
+  if (!error_ && !flush()) { return false; }
+  if (stream_ && (cudaStreamSynchronize(stream_) != cudaSuccess)) {
+    holoscan::log_error("Failed to upload the volume");
+    error_ = true;
+  }
+  if (!error_ && (remaining() != 0)) {
+    holoscan::log_error("Volume data is {} bytes short", remaining());
+    return false;
+  }
+  return !error_;
+}
+
+#ifdef VOLUME_LOADER_CUFILE
+namespace {
+
+/// Read with GPUDirect Storage, returns false if it is not available for the file
+bool load_raw_data_direct(const std::string& file_name, size_t offset, Volume& volume) {
+  CUfileError_t status = cuFileDriverOpen();
+  if (status.err != CU_FILE_SUCCESS) { return false; }
+
+  const int fd = open(file_name.c_str(), O_RDONLY | O_DIRECT);
+  if (fd == -1) { return false; }
+
+  CUfileDescr_t descr{};
+  descr.handle.fd = fd;
+  descr.type = CU_FILE_HANDLE_TYPE_OPAQUE_FD;
+  CUfileHandle_t handle;
+  status = cuFileHandleRegister(&handle, &descr);
+  if (status.err != CU_FILE_SUCCESS) {
+    close(fd);
+    return false;
+  }
+
+  void* data = volume.tensor_->pointer();
+  const size_t size = volume.tensor_->size();
+  size_t read = 0;
+  while (read < size) {
+    const ssize_t result = cuFileRead(handle, data, size - read, offset + read, read);
+    if (result <= 0) { break; }
+    read += result;
+  }
+  cuFileHandleDeregister(handle);
+  close(fd);
+
+  if (read != size) {
+    holoscan::log_warn("GPUDirect Storage read of {} failed, falling back", file_name);
+    return false;
+  }
+  return true;
+}
+
+}  // namespace
+#endif
+
+bool load_raw_data(const std::string& file_name, size_t offset, Volume& volume) {
+#ifdef VOLUME_LOADER_CUFILE
+  if ((volume.storage_type_ == nvidia::gxf::MemoryStorageType::kDevice) &&
+      load_raw_data_direct(file_name, offset, volume)) {
+    return true;
+  }
+#endif
+
+  MappedFile file;
+  if (!file.open(file_name)) { return false; }
+  const size_t size = volume.tensor_->size();
+  if ((offset > file.size()) || (file.size() - offset < size)) {
+    holoscan::log_error(
+        "{} holds {} bytes of data, expected {}", file_name, file.size() - offset, size);
+    return false;
+  }
+
+  VolumeStream stream(volume);
+  return stream.write(file.data() + offset, size) && stream.finish();
+}
+
+bool load_compressed_data(const std::string& file_name, size_t offset, Volume& volume,
+                          size_t skip) {
+  const size_t size = volume.tensor_->size();
+  if (volume.chunk_cache_) {
+    MappedFile cache;
+    std::vector<DeflateChunk> chunks;
+    if (ChunkCache::open(file_name, skip, size, cache, chunks)) {
+      return inflate_chunks(cache.data(), chunks, 0, volume);
+    }
+  }
+
+  MappedFile file;
+  if (!file.open(file_name)) { return false; }
+  if (offset > file.size()) {
+    holoscan::log_error("{} has no data", file_name);
+    return false;
+  }
+
+  std::vector<DeflateChunk> chunks;
+  if (find_bgzf_chunks(file.data() + offset, file.size() - offset, chunks)) {
+    return inflate_chunks(file.data() + offset, chunks, skip, volume);
+  }
+
+  // a single deflate stream, inflated sequentially
+  std::unique_ptr<ChunkCache> cache;
+  if (volume.chunk_cache_) {
+    cache = std::make_unique<ChunkCache>();
+    if (!cache->create(file_name, skip, size)) { cache.reset(); }
+  }
+
+  z_stream strm{};
+  int result = inflateInit2(&strm, 32 + MAX_WBITS);
+  if (result != Z_OK) {
+    holoscan::log_error(
+        "Failed to uncompress {}, inflateInit2 failed with error code {}", file_name, result);
+    return false;
+  }
+
+  // zlib counts in uInt, feed the input in pieces it can hold
+  constexpr size_t kMaxChunk = std::numeric_limits<uInt>::max();
+  const uint8_t* input = file.data() + offset;
+  size_t input_size = file.size() - offset;
+
+  // the bytes preceding the volume data are inflated to a scratch buffer
+  std::vector<uint8_t> skip_buffer(std::min<size_t>(skip, 64 * 1024));
+  size_t skipped = 0;
+
+  VolumeStream stream(volume);
+  result = Z_OK;
+  while (result == Z_OK) {
+    size_t capacity;
+    uint8_t* dst;
+    const bool skipping = skipped < skip;
+    if (skipping) {
+      dst = skip_buffer.data();
+      capacity = std::min(skip_buffer.size(), skip - skipped);
+    } else {
+      dst = stream.acquire(capacity);
+      if (!dst) { break; }
+    }
+    strm.next_out = dst;
+    strm.avail_out = std::min(capacity, kMaxChunk);
+    const size_t available = strm.avail_out;
+
+    if (strm.avail_in == 0) {
+      strm.next_in = const_cast<Bytef*>(input);
+      strm.avail_in = std::min(input_size, kMaxChunk);
+      input += strm.avail_in;
+      input_size -= strm.avail_in;
+    }
+    result = inflate(&strm, Z_NO_FLUSH);
+    if ((result == Z_BUF_ERROR) && (strm.avail_in == 0) && (input_size != 0)) { result = Z_OK; }
+    const size_t produced = available - strm.avail_out;
+    if (skipping) {
+      skipped += produced;
+      continue;
+    }
+    if (cache) { cache->append(dst, produced); }
+    if (!stream.commit(produced)) { break; }
+  }
+  inflateEnd(&strm);
+
+  if ((result != Z_STREAM_END) && (result != Z_OK)) {
+    holoscan::log_error(
+        "Failed to uncompress {}, inflate failed with error code {}", file_name, result);
+    return false;
+  }
+  if (!stream.finish()) { return false; }
+  // not being able to write the cache is not an error, the next load is sequential again
+  if (cache) { cache->close(); }
+  return true;
+}
+
+}  // namespace holoscan::ops
@@ -0,0 +1,143 @@
+/* SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef VOLUME_LOADER_VOLUME_STREAM
+#define VOLUME_LOADER_VOLUME_STREAM
+
+#include <cuda_runtime.h>
+
+#include <array>
+#include <cstdint>
+#include <string>
+
+namespace holoscan::ops {
+
+class Volume;
+
+/// Read-only memory mapping of a whole file
+class MappedFile {
+ public:
+  MappedFile() = default;
+  ~MappedFile();
+  MappedFile(const MappedFile&) = delete;
+  MappedFile& operator=(const MappedFile&) = delete;
+
+  /**
+   * Map a file, the kernel is advised that it will be read sequentially.
+   *
+   * @param file_name [in] file to map
+   *
+   * @returns false if the file could not be opened or mapped
+   */
+  bool open(const std::string& file_name);
+
+  const uint8_t* data() const { return data_; }
+  size_t size() const { return size_; }
+
+ private:
+  int fd_ = -1;
+  uint8_t* data_ = nullptr;
+  size_t size_ = 0;
+};
+
+/**
+ * Writes the data of a volume sequentially to its tensor, which has to be allocated. Host tensors
+ * are written in place. Device tensors are written through a ring of pinned staging buffers, each
+ * one is uploaded with cudaMemcpyAsync while the next one is filled.
+ */
+class VolumeStream {
+ public:
+  explicit VolumeStream(Volume& volume);
+  ~VolumeStream();
+  VolumeStream(const VolumeStream&) = delete;
+  VolumeStream& operator=(const VolumeStream&) = delete;
+
+  /**
+   * Get the memory to write the next bytes of the tensor to.
+   *
+   * @param capacity [out] number of bytes which can be written
+   *
+   * @returns a host pointer, nullptr on error or when the tensor is complete
+   */
+  uint8_t* acquire(size_t& capacity);
+
+  /**
+   * Hand over the bytes written to the memory returned by the last acquire().
+   *
+   * @param size [in] number of bytes written, at most the capacity returned by acquire()
+   */
+  bool commit(size_t size);
+
+  /// Copy size bytes to the tensor
+  bool write(const uint8_t* data, size_t size);
+
+  /// Wait for the uploads, returns false if the tensor is not complete or an upload failed
+  bool finish();
+
+  /// Bytes of the tensor which are not written yet
+  size_t remaining() const { return size_ - offset_; }
+
+ private:
+  bool flush();
+
+  static constexpr size_t kStagingBufferCount = 4;
+  static constexpr size_t kStagingBufferSize = 16 * 1024 * 1024;
+
+  uint8_t* tensor_data_ = nullptr;
+  size_t size_ = 0;
+  // bytes committed
+  size_t offset_ = 0;
+  bool device_ = false;
+
+  cudaStream_t stream_ = nullptr;
+  std::array<uint8_t*, kStagingBufferCount> staging_buffers_{};
+  // end of the last upload out of each staging buffer
+  std::array<cudaEvent_t, kStagingBufferCount> events_{};
+  size_t current_buffer_ = 0;
+  // bytes committed to the current staging buffer
+  size_t staged_ = 0;
+  bool error_ = false;
+};
+
+/**
+ * Load the uncompressed data of a volume from a file to the allocated tensor. Device tensors are
+ * read with GPUDirect Storage when the operator is built with cuFile and the file system supports
+ * it, else the file is memory mapped and uploaded through pinned staging buffers.
+ *
+ * @param file_name [in] file to read
+ * @param offset [in] offset of the data in the file
+ * @param volume [in] volume with allocated tensor
+ */
+bool load_raw_data(const std::string& file_name, size_t offset, Volume& volume);
+
+/**
+ * Load the gzip or zlib compressed data of a volume from a file to the allocated tensor. The file
+ * is memory mapped. BGZF files and chunk caches (see Volume::chunk_cache_) are inflated in
+ * parallel, see inflate_chunks(). Other streams are inflated straight into the tensor or, for
+ * device tensors, into the staging buffers of a VolumeStream, and the chunk cache is written
+ * if enabled.
+ *
+ * @param file_name [in] file to read
+ * @param offset [in] offset of the compressed data in the file
+ * @param volume [in] volume with allocated tensor
+ * @param skip [in] uncompressed bytes preceding the volume data
+ */
+bool load_compressed_data(const std::string& file_name, size_t offset, Volume& volume,
+                          size_t skip = 0);
+
+}  // namespace holoscan::ops
+
+#endif /* VOLUME_LOADER_VOLUME_STREAM */
@@ -0,0 +1,358 @@
+/* SPDX-FileCopyrightText: Copyright (c) 2023-2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "bricked_volume.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+#include <holoscan/logger/logger.hpp>
+
+namespace {
+
+/// pinned buffers bricks are gathered into, uploads of one overlap the gather into the next
+constexpr size_t kStagingBuffers = 4;
+
+/// key of the empty bricks in the cache, or'ed with the factor
+constexpr uint64_t kEmptyBrickKey = ~uint64_t(0) << 8;
+
+void check(cudaError_t result, const char* what) {
+  if (result != cudaSuccess) {
+    throw std::runtime_error(std::string("BrickedVolume: ") + what + " failed with " +
+                             cudaGetErrorString(result));
+  }
+}
+
+uint32_t div_up(uint32_t value, uint32_t divisor) {
+  return (value + divisor - 1) / divisor;
+}
+
+/// call function with a value of the C++ type of the element type
+template <typename F>
+void dispatch(nvidia::gxf::PrimitiveType type, F&& function) {
+  switch (type) {
+    case nvidia::gxf::PrimitiveType::kInt8:
+      function(int8_t{});
+      break;
+    case nvidia::gxf::PrimitiveType::kUnsigned8:
+      function(uint8_t{});
+      break;
+    case nvidia::gxf::PrimitiveType::kInt16:
+      function(int16_t{});
+      break;
+    case nvidia::gxf::PrimitiveType::kUnsigned16:
+      function(uint16_t{});
+      break;
+    case nvidia::gxf::PrimitiveType::kInt32:
+      function(int32_t{});
+      break;
+    case nvidia::gxf::PrimitiveType::kUnsigned32:
+      function(uint32_t{});
+      break;
+    case nvidia::gxf::PrimitiveType::kFloat32:
+      function(float{});
+      break;
+    default:
+      throw std::runtime_error("BrickedVolume: unhandled element type " +
+                               std::to_string(int(type)));
+  }
+}
+
+}  // namespace
+
+BrickedVolume::BrickedVolume(const nvidia::gxf::Entity& entity,
+                             const nvidia::gxf::Handle<nvidia::gxf::Tensor>& tensor,
+                             size_t cache_size)
+    : entity_(entity),
+      type_(tensor->element_type()),
+      bytes_per_element_(tensor->bytes_per_element()),
+      data_(static_cast<const uint8_t*>(tensor->pointer())),
+      cache_size_(cache_size) {
+  const nvidia::gxf::Shape shape = tensor->shape();
+  if (shape.rank() != 3) { throw std::runtime_error("BrickedVolume: the volume must be 3D"); }
+  dims_ = {static_cast<uint32_t>(shape.dimension(2)),
+           static_cast<uint32_t>(shape.dimension(1)),
+           static_cast<uint32_t>(shape.dimension(0))};
+  row_pitch_ = tensor->stride(1);
+  slice_pitch_ = tensor->stride(0);
+  for (int i = 0; i < 3; ++i) { bricks_[i] = div_up(dims_[i], kBrickSize); }
+
+  const size_t brick_count = size_t(bricks_[0]) * bricks_[1] * bricks_[2];
+  brick_min_.resize(brick_count);
+  brick_max_.resize(brick_count);
+  dispatch(type_, [this](auto zero) { scan<decltype(zero)>(); });
+  volume_min_ = *std::min_element(brick_min_.begin(), brick_min_.end());
+
+  staging_.resize(kStagingBuffers);
+  const size_t brick_size = size_t(kBrickSize) * kBrickSize * kBrickSize * bytes_per_element_;
+  for (auto& staging : staging_) {
+    check(cudaMallocHost(&staging.data, brick_size), "cudaMallocHost");
+    check(cudaEventCreateWithFlags(&staging.event, cudaEventDisableTiming), "cudaEventCreate");
+  }
+
+  holoscan::log_info("BrickedVolume: {}x{}x{} volume divided into {} bricks",
+                     dims_[0],
+                     dims_[1],
+                     dims_[2],
+                     brick_count);
+}
+
+BrickedVolume::~BrickedVolume() {
+  for (auto& staging : staging_) {
+    if (staging.event) {
+      cudaEventSynchronize(staging.event);
+      cudaEventDestroy(staging.event);
+    }
+    if (staging.data) { cudaFreeHost(staging.data); }
+  }
+  for (auto& entry : cache_) { cudaFree(entry.second.memory); }
+}
+
+std::array<uint32_t, 3> BrickedVolume::brick_origin(size_t index) const {
+  return {static_cast<uint32_t>(index % bricks_[0]) * kBrickSize,
+          static_cast<uint32_t>((index / bricks_[0]) % bricks_[1]) * kBrickSize,
+          static_cast<uint32_t>(index / (size_t(bricks_[0]) * bricks_[1])) * kBrickSize};
+}
+
+std::array<uint32_t, 3> BrickedVolume::brick_extent(const std::array<uint32_t, 3>& origin) const {
+  return {std::min(kBrickSize, dims_[0] - origin[0]),
+          std::min(kBrickSize, dims_[1] - origin[1]),
+          std::min(kBrickSize, dims_[2] - origin[2])};
+}
+
+const void* BrickedVolume::row(uint32_t x, uint32_t y, uint32_t z) const {
+  return data_ + z * slice_pitch_ + y * row_pitch_ + x * bytes_per_element_;
+}
+
+template <typename T>
+void BrickedVolume::scan() {
+  // bricks are scanned in parallel, the volume may be too large for a single thread to be fast
+  std::atomic<size_t> next_brick{0};
+  auto worker = [this, &next_brick] {
+    for (size_t index = next_brick++; index < brick_min_.size(); index = next_brick++) {
+      const auto origin = brick_origin(index);
+      const auto extent = brick_extent(origin);
+      T min_value = std::numeric_limits<T>::max();
+      T max_value = std::numeric_limits<T>::lowest();
+      for (uint32_t z = 0; z < extent[2]; ++z) {
+        for (uint32_t y = 0; y < extent[1]; ++y) {
+          const T* values = static_cast<const T*>(row(origin[0], origin[1] + y, origin[2] + z));
+          for (uint32_t x = 0; x < extent[0]; ++x) {
+            min_value = std::min(min_value, values[x]);
+            max_value = std::max(max_value, values[x]);
+          }
+        }
+      }
+      brick_min_[index] = static_cast<float>(min_value);
+      brick_max_[index] = static_cast<float>(max_value);
+    }
+  };
+
+  std::vector<std::thread> threads(std::max(1u, std::thread::hardware_concurrency()));
+  for (auto& thread : threads) { thread = std::thread(worker); }
+  for (auto& thread : threads) { thread.join(); }
+}
+
+template <typename T>
+void BrickedVolume::gather(const std::array<uint32_t, 3>& origin,
+                           const std::array<uint32_t, 3>& dims, uint32_t factor,
+                           void* dst) const {
+  T* out = static_cast<T*>(dst);
+  for (uint32_t z = 0; z < dims[2]; ++z) {
+    for (uint32_t y = 0; y < dims[1]; ++y) {
+      const T* values =
+          static_cast<const T*>(row(origin[0], origin[1] + y * factor, origin[2] + z * factor));
+      if (factor == 1) {
+        std::memcpy(out, values, dims[0] * sizeof(T));
+      } else {
+        for (uint32_t x = 0; x < dims[0]; ++x) { out[x] = values[x * factor]; }
+      }
+      out += dims[0];
+    }
+  }
+}
+
+template <typename T>
+void BrickedVolume::fill(size_t count, void* dst) const {
+  std::fill_n(static_cast<T*>(dst), count, static_cast<T>(volume_min_));
+}
+
+VolumeBox BrickedVolume::occupied_box(float threshold) const {
+  std::array<uint32_t, 3> first{bricks_[0], bricks_[1], bricks_[2]};
+  std::array<uint32_t, 3> last{0, 0, 0};
+  bool occupied = false;
+  for (size_t index = 0; index < brick_max_.size(); ++index) {
+    if (brick_max_[index] <= threshold) { continue; }
+    const auto origin = brick_origin(index);
+    for (int i = 0; i < 3; ++i) {
+      first[i] = std::min(first[i], origin[i] / kBrickSize);
+      last[i] = std::max(last[i], origin[i] / kBrickSize);
+    }
+    occupied = true;
+  }
+  // keep a single brick of an empty volume
+  if (!occupied) { first = last = {0, 0, 0}; }
+
+  VolumeBox box;
+  for (int i = 0; i < 3; ++i) {
+    box.begin[i] = first[i] * kBrickSize;
+    box.end[i] = std::min(dims_[i], (last[i] + 1) * kBrickSize);
+  }
+  return box;
+}
+
+VolumeBox BrickedVolume::brick_box(const std::array<float, 3>& begin,
+                                   const std::array<float, 3>& end) const {
+  VolumeBox box;
+  for (int i = 0; i < 3; ++i) {
+    const float lower = std::clamp(begin[i], 0.f, 1.f) * dims_[i];
+    const float upper = std::clamp(end[i], 0.f, 1.f) * dims_[i];
+    box.begin[i] = std::min(static_cast<uint32_t>(lower) / kBrickSize, bricks_[i] - 1) * kBrickSize;
+    box.end[i] = std::min(
+        dims_[i], div_up(static_cast<uint32_t>(std::ceil(upper)), kBrickSize) * kBrickSize);
+    if (box.end[i] <= box.begin[i]) { box.end[i] = std::min(dims_[i], box.begin[i] + kBrickSize); }
+  }
+  return box;
+}
+
+std::array<uint32_t, 3> BrickedVolume::downsampled_dims(const VolumeBox& box, uint32_t factor) {
+  return {div_up(box.end[0] - box.begin[0], factor),
+          div_up(box.end[1] - box.begin[1], factor),
+          div_up(box.end[2] - box.begin[2], factor)};
+}
+
+void BrickedVolume::assemble(const VolumeBox& box, uint32_t factor,
+                             const std::optional<float>& threshold, void* dst,
+                             cudaStream_t stream) {
+  const auto dims = downsampled_dims(box, factor);
+
+  for (uint32_t z = box.begin[2] / kBrickSize; z < div_up(box.end[2], kBrickSize); ++z) {
+    for (uint32_t y = box.begin[1] / kBrickSize; y < div_up(box.end[1], kBrickSize); ++y) {
+      for (uint32_t x = box.begin[0] / kBrickSize; x < div_up(box.end[0], kBrickSize); ++x) {
+        const size_t index = (size_t(z) * bricks_[1] + y) * bricks_[0] + x;
+        const auto origin = brick_origin(index);
+        const auto extent = brick_extent(origin);
+
+        const bool empty = threshold.has_value() && (brick_max_[index] <= threshold.value());
+        const CachedBrick& brick =
+            empty ? empty_brick(factor, stream) : cached_brick(index, factor, stream);
+
+        cudaMemcpy3DParms copy_params = {0};
+        copy_params.srcPtr = make_cudaPitchedPtr(
+            brick.memory, brick.dims[0] * bytes_per_element_, brick.dims[0], brick.dims[1]);
+        copy_params.dstPtr =
+            make_cudaPitchedPtr(dst, dims[0] * bytes_per_element_, dims[0], dims[1]);
+        copy_params.dstPos = make_cudaPos(
+            (origin[0] - box.begin[0]) / factor * bytes_per_element_,
+            (origin[1] - box.begin[1]) / factor,
+            (origin[2] - box.begin[2]) / factor);
+        copy_params.extent = make_cudaExtent(div_up(extent[0], factor) * bytes_per_element_,
+                                             div_up(extent[1], factor),
+                                             div_up(extent[2], factor));
+        copy_params.kind = cudaMemcpyDeviceToDevice;
+        check(cudaMemcpy3DAsync(&copy_params, stream), "cudaMemcpy3DAsync");
+      }
+    }
+  }
+}
+
+const BrickedVolume::CachedBrick& BrickedVolume::cached_brick(size_t index, uint32_t factor,
+                                                              cudaStream_t stream) {
+  const uint64_t key = (uint64_t(index) << 8) | factor;
+  auto it = cache_.find(key);
+  if (it != cache_.end()) {
+    lru_.splice(lru_.begin(), lru_, it->second.lru);
+    return it->second;
+  }
+
+  const auto origin = brick_origin(index);
+  const auto extent = brick_extent(origin);
+  CachedBrick& brick = insert(
+      key,
+      {div_up(extent[0], factor), div_up(extent[1], factor), div_up(extent[2], factor)},
+      stream);
+
+  StagingBuffer& staging = next_staging_buffer();
+  dispatch(type_, [&](auto zero) {
+    gather<decltype(zero)>(origin, brick.dims, factor, staging.data);
+  });
+  check(cudaMemcpyAsync(brick.memory, staging.data, brick.size, cudaMemcpyHostToDevice, stream),
+        "cudaMemcpyAsync");
+  check(cudaEventRecord(staging.event, stream), "cudaEventRecord");
+  return brick;
+}
+
+const BrickedVolume::CachedBrick& BrickedVolume::empty_brick(uint32_t factor,
+                                                             cudaStream_t stream) {
+  const uint64_t key = kEmptyBrickKey | factor;
+  auto it = cache_.find(key);
+  if (it != cache_.end()) {
+    lru_.splice(lru_.begin(), lru_, it->second.lru);
+    return it->second;
+  }
+
+  const uint32_t size = kBrickSize / factor;
+  CachedBrick& brick = insert(key, {size, size, size}, stream);
+
+  StagingBuffer& staging = next_staging_buffer();
+  dispatch(type_, [&](auto zero) {
+    fill<decltype(zero)>(size_t(size) * size * size, staging.data);
+  });
+  check(cudaMemcpyAsync(brick.memory, staging.data, brick.size, cudaMemcpyHostToDevice, stream),
+        "cudaMemcpyAsync");
+  check(cudaEventRecord(staging.event, stream), "cudaEventRecord");
+  return brick;
+}
+
+BrickedVolume::CachedBrick& BrickedVolume::insert(uint64_t key,
+                                                  const std::array<uint32_t, 3>& dims,
+                                                  cudaStream_t stream) {
+  CachedBrick brick;
+  brick.dims = dims;
+  brick.size = size_t(dims[0]) * dims[1] * dims[2] * bytes_per_element_;
+
+  // evicted bricks may still be the source of queued copies
+  if ((cached_size_ + brick.size > cache_size_) && !lru_.empty()) {
+    check(cudaStreamSynchronize(stream), "cudaStreamSynchronize");
+  }
+  while ((cached_size_ + brick.size > cache_size_) && !lru_.empty()) {
+    auto evicted = cache_.find(lru_.back());
+    cached_size_ -= evicted->second.size;
+    check(cudaFree(evicted->second.memory), "cudaFree");
+    cache_.erase(evicted);
+    lru_.pop_back();
+  }
+
+  check(cudaMalloc(&brick.memory, brick.size), "cudaMalloc");
+  cached_size_ += brick.size;
+  lru_.push_front(key);
+  brick.lru = lru_.begin();
+  return cache_.emplace(key, brick).first->second;
+}
+
+BrickedVolume::StagingBuffer& BrickedVolume::next_staging_buffer() {
+  StagingBuffer& staging = staging_[next_staging_];
+  next_staging_ = (next_staging_ + 1) % staging_.size();
+  // wait for the upload of the previous brick gathered into the buffer
+  check(cudaEventSynchronize(staging.event), "cudaEventSynchronize");
+  return staging;
+}
@@ -0,0 +1,157 @@
+/* SPDX-FileCopyrightText: Copyright (c) 2023-2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef OPERATORS_VOLUME_RENDERER_BRICKED_VOLUME
+#define OPERATORS_VOLUME_RENDERER_BRICKED_VOLUME
+
+#include <cuda_runtime.h>
+
+#include <gxf/core/entity.hpp>
+#include <gxf/std/tensor.hpp>
+
+#include <array>
+#include <cstdint>
+#include <list>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+
+/// Box of volume elements per axis x, y, z, begin is inclusive and end exclusive
+struct VolumeBox {
+  std::array<uint32_t, 3> begin{0, 0, 0};
+  std::array<uint32_t, 3> end{0, 0, 0};
+
+  bool operator==(const VolumeBox& other) const {
+    return (begin == other.begin) && (end == other.end);
+  }
+  bool operator!=(const VolumeBox& other) const { return !(*this == other); }
+};
+
+/**
+ * A volume in host memory divided into bricks, of which a box is made resident in device memory.
+ *
+ * The minimum and maximum of each brick are computed once, bricks with all elements at or below
+ * a threshold are empty and never uploaded. Other bricks are uploaded when a box needs them,
+ * downsampled if requested, and stay in a LRU cache of device memory. Moving or resizing the box
+ * therefore only uploads the bricks which entered it.
+ */
+class BrickedVolume {
+ public:
+  /// brick edge length in elements
+  static constexpr uint32_t kBrickSize = 64;
+
+  /**
+   * @param entity message holding the tensor, kept to keep the tensor memory valid
+   * @param tensor 3D volume in host or system memory
+   * @param cache_size device memory of the brick cache in bytes
+   */
+  BrickedVolume(const nvidia::gxf::Entity& entity,
+                const nvidia::gxf::Handle<nvidia::gxf::Tensor>& tensor, size_t cache_size);
+  BrickedVolume(const BrickedVolume&) = delete;
+  BrickedVolume& operator=(const BrickedVolume&) = delete;
+  ~BrickedVolume();
+
+  /// @returns the element count in each direction
+  const std::array<uint32_t, 3>& dims() const { return dims_; }
+  /// @returns the size of an element in bytes
+  size_t bytes_per_element() const { return bytes_per_element_; }
+
+  /**
+   * @param threshold bricks with all elements at or below are empty
+   * @returns the smallest brick aligned box containing all bricks which are not empty
+   */
+  VolumeBox occupied_box(float threshold) const;
+
+  /**
+   * @param begin, end region in normalized volume coordinates
+   * @returns the smallest brick aligned box containing the region
+   */
+  VolumeBox brick_box(const std::array<float, 3>& begin, const std::array<float, 3>& end) const;
+
+  /// @returns the element count of a box downsampled by factor
+  static std::array<uint32_t, 3> downsampled_dims(const VolumeBox& box, uint32_t factor);
+
+  /**
+   * Write the elements of a box, downsampled by factor, tightly packed to device memory. Empty
+   * bricks are filled with the minimum value of the volume.
+   *
+   * @param box brick aligned box
+   * @param factor downsampling factor, a power of two up to kBrickSize
+   * @param threshold optional, bricks with all elements at or below are empty
+   * @param dst device memory of downsampled_dims(box, factor) elements
+   * @param stream CUDA stream the copies are queued to
+   */
+  void assemble(const VolumeBox& box, uint32_t factor, const std::optional<float>& threshold,
+                void* dst, cudaStream_t stream);
+
+ private:
+  struct CachedBrick {
+    void* memory = nullptr;
+    size_t size = 0;
+    std::array<uint32_t, 3> dims{0, 0, 0};
+    std::list<uint64_t>::iterator lru;
+  };
+
+  struct StagingBuffer {
+    void* data = nullptr;
+    cudaEvent_t event = nullptr;
+  };
+
+  std::array<uint32_t, 3> brick_origin(size_t index) const;
+  std::array<uint32_t, 3> brick_extent(const std::array<uint32_t, 3>& origin) const;
+  const void* row(uint32_t x, uint32_t y, uint32_t z) const;
+
+  /// @returns the device copy of a brick at factor, uploaded if not cached
+  const CachedBrick& cached_brick(size_t index, uint32_t factor, cudaStream_t stream);
+  /// @returns a device brick at factor filled with the minimum value
+  const CachedBrick& empty_brick(uint32_t factor, cudaStream_t stream);
+  /// allocate a cache entry, evicting the least recently used bricks to stay within the budget
+  CachedBrick& insert(uint64_t key, const std::array<uint32_t, 3>& dims, cudaStream_t stream);
+  StagingBuffer& next_staging_buffer();
+
+  template <typename T>
+  void scan();
+  template <typename T>
+  void gather(const std::array<uint32_t, 3>& origin, const std::array<uint32_t, 3>& dims,
+              uint32_t factor, void* dst) const;
+  template <typename T>
+  void fill(size_t count, void* dst) const;
+
+  nvidia::gxf::Entity entity_;
+  nvidia::gxf::PrimitiveType type_;
+  size_t bytes_per_element_ = 0;
+  const uint8_t* data_ = nullptr;
+  size_t row_pitch_ = 0;
+  size_t slice_pitch_ = 0;
+  std::array<uint32_t, 3> dims_{0, 0, 0};
+  std::array<uint32_t, 3> bricks_{0, 0, 0};
+
+  /// value range of each brick
+  std::vector<float> brick_min_;
+  std::vector<float> brick_max_;
+  float volume_min_ = 0.f;
+
+  size_t cache_size_ = 0;
+  size_t cached_size_ = 0;
+  std::unordered_map<uint64_t, CachedBrick> cache_;
+  /// cache keys, most recently used first
+  std::list<uint64_t> lru_;
+
+  std::vector<StagingBuffer> staging_;
+  size_t next_staging_ = 0;
+};
+
+#endif /* OPERATORS_VOLUME_RENDERER_BRICKED_VOLUME */
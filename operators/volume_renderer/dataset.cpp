@@ -16,6 +16,7 @@
 
 #include "dataset.hpp"
 
+#include <algorithm>
 #include <filesystem>
 #include <fstream>
 
@@ -49,40 +50,85 @@ class DataArray {
 
   /// Memory blob
   std::shared_ptr<clara::viz::CudaMemoryBlob> blob_;
-};
 
-void Dataset::SetVolume(Types type, const std::array<float, 3>& spacing,
-                        const std::array<uint32_t, 3>& permute_axis,
-                        const std::array<bool, 3>& flip_axes,
-                        const std::vector<clara::viz::Vector2f>& element_range,
-                        const nvidia::gxf::Handle<nvidia::gxf::Tensor>& tensor) {
-  DataArray data_array;
+  /// @returns true if the other array has the same element type, size, spacing, axes and range
+  bool HasSameLayout(const DataArray& other) const {
+    for (int i = 0; i < 3; ++i) {
+      if ((dims_(i) != other.dims_(i)) || (spacing_(i) != other.spacing_(i))) { return false; }
+    }
+    if ((type_ != other.type_) || (permute_axis_ != other.permute_axis_) ||
+        (flip_axes_ != other.flip_axes_) ||
+        (element_range_.size() != other.element_range_.size())) {
+      return false;
+    }
+    for (size_t i = 0; i < element_range_.size(); ++i) {
+      if ((element_range_[i](0) != other.element_range_[i](0)) ||
+          (element_range_[i](1) != other.element_range_[i](1))) {
+        return false;
+      }
+    }
+    return true;
+  }
+};
 
-  switch (tensor->element_type()) {
+/// @returns false if the tensor element type is not supported
+static bool to_element_type(nvidia::gxf::PrimitiveType primitive_type,
+                            clara::viz::DataElementType& element_type) {
+  switch (primitive_type) {
     case nvidia::gxf::PrimitiveType::kInt8:
-      data_array.type_ = clara::viz::DataElementType::INT8;
+      element_type = clara::viz::DataElementType::INT8;
       break;
     case nvidia::gxf::PrimitiveType::kUnsigned8:
-      data_array.type_ = clara::viz::DataElementType::UINT8;
+      element_type = clara::viz::DataElementType::UINT8;
       break;
     case nvidia::gxf::PrimitiveType::kInt16:
-      data_array.type_ = clara::viz::DataElementType::INT16;
+      element_type = clara::viz::DataElementType::INT16;
       break;
     case nvidia::gxf::PrimitiveType::kUnsigned16:
-      data_array.type_ = clara::viz::DataElementType::UINT16;
+      element_type = clara::viz::DataElementType::UINT16;
       break;
     case nvidia::gxf::PrimitiveType::kInt32:
-      data_array.type_ = clara::viz::DataElementType::INT32;
+      element_type = clara::viz::DataElementType::INT32;
       break;
     case nvidia::gxf::PrimitiveType::kUnsigned32:
-      data_array.type_ = clara::viz::DataElementType::UINT32;
+      element_type = clara::viz::DataElementType::UINT32;
       break;
     case nvidia::gxf::PrimitiveType::kFloat32:
-      data_array.type_ = clara::viz::DataElementType::FLOAT;
+      element_type = clara::viz::DataElementType::FLOAT;
       break;
     default:
-      holoscan::log_error("Unhandled element type'{}'.", int(tensor->element_type()));
-      return;
+      return false;
+  }
+  return true;
+}
+
+/// @returns false if the tensor storage type is not supported
+static bool to_copy_kind(nvidia::gxf::MemoryStorageType storage_type, cudaMemcpyKind& kind) {
+  switch (storage_type) {
+    case nvidia::gxf::MemoryStorageType::kDevice:
+      kind = cudaMemcpyKind::cudaMemcpyDeviceToDevice;
+      break;
+    case nvidia::gxf::MemoryStorageType::kHost:
+    case nvidia::gxf::MemoryStorageType::kSystem:
+      kind = cudaMemcpyKind::cudaMemcpyHostToDevice;
+      break;
+    default:
+      return false;
+  }
+  return true;
+}
+
+bool Dataset::SetVolume(Types type, const std::array<float, 3>& spacing,
+                        const std::array<uint32_t, 3>& permute_axis,
+                        const std::array<bool, 3>& flip_axes,
+                        const std::vector<clara::viz::Vector2f>& element_range,
+                        const nvidia::gxf::Entity& entity,
+                        const nvidia::gxf::Handle<nvidia::gxf::Tensor>& tensor) {
+  DataArray data_array;
+
+  if (!to_element_type(tensor->element_type(), data_array.type_)) {
+    holoscan::log_error("Unhandled element type'{}'.", int(tensor->element_type()));
+    return false;
   }
 
   nvidia::gxf::Shape shape = tensor->shape();
@@ -97,9 +143,41 @@ void Dataset::SetVolume(Types type, const std::array<float, 3>& spacing,
   int32_t frames = 1;
   if (shape.rank() == 4) { frames = shape.dimension(0); }
 
-  // copy the data
+  std::vector<std::shared_ptr<DataArray>>* arrays;
+  switch (type) {
+    case Types::Density:
+      arrays = &density_;
+      break;
+    case Types::Segmentation:
+      arrays = &segmentation_;
+      break;
+    default:
+      throw std::runtime_error("Unhandled type");
+  }
+
   const size_t volume_size =
       tensor->bytes_per_element() * data_array.dims_(0) * data_array.dims_(1) * data_array.dims_(2);
+
+  // single volumes in host memory exceeding the budget are bricked, UpdateResidency() copies the
+  // resident bricks
+  Resident& resident = resident_[static_cast<int>(type)];
+  resident = Resident();
+  if ((budget_ != 0) && (frames == 1) && (volume_size > budget_) &&
+      ((tensor->storage_type() == nvidia::gxf::MemoryStorageType::kHost) ||
+       (tensor->storage_type() == nvidia::gxf::MemoryStorageType::kSystem))) {
+    resident.volume = std::make_shared<BrickedVolume>(entity, tensor, cache_size_);
+    resident.spacing = data_array.spacing_;
+    arrays->clear();
+    arrays->push_back(std::make_shared<DataArray>(data_array));
+    return true;
+  }
+
+  // a new volume replaces the previous one, e.g. the next volume of a sequence
+  const bool layout_changed = (arrays->size() != static_cast<size_t>(frames)) ||
+                              !(*arrays)[0]->HasSameLayout(data_array);
+  arrays->clear();
+
+  // copy the data
   uintptr_t volume_data = reinterpret_cast<uintptr_t>(tensor->pointer());
   for (uint32_t frame = 0; frame < frames; ++frame) {
     DataArray::Handle cur_data_array(new DataArray);
@@ -127,41 +205,123 @@ void Dataset::SetVolume(Types type, const std::array<float, 3>& spacing,
       copy_params.extent.height = data_array.dims_(1);
       copy_params.extent.depth = data_array.dims_(2);
 
-      switch (tensor->storage_type()) {
-        case nvidia::gxf::MemoryStorageType::kDevice:
-          copy_params.kind = cudaMemcpyKind::cudaMemcpyDeviceToDevice;
-          break;
-        case nvidia::gxf::MemoryStorageType::kHost:
-        case nvidia::gxf::MemoryStorageType::kSystem:
-          copy_params.kind = cudaMemcpyKind::cudaMemcpyHostToDevice;
-          break;
-        default:
-          holoscan::log_error("NIFTI unhandled storage type {}", int(tensor->storage_type()));
-          return;
+      if (!to_copy_kind(tensor->storage_type(), copy_params.kind)) {
+        holoscan::log_error("NIFTI unhandled storage type {}", int(tensor->storage_type()));
+        return true;
       }
 
       if (cudaMemcpy3D(&copy_params) != cudaSuccess) {
         holoscan::log_error("Failed to copy to GPU memory");
-        return;
+        return true;
       }
     }
 
-    switch (type) {
-      case Types::Density:
-        density_.push_back(cur_data_array);
-        break;
-      case Types::Segmentation:
-        segmentation_.push_back(cur_data_array);
-        break;
-      default:
-        throw std::runtime_error("Unhandled type");
-    }
+    arrays->push_back(cur_data_array);
 
     volume_data += tensor->stride(0);
   }
+  return layout_changed;
+}
+
+bool Dataset::PatchVolume(Types type, const VolumeBox& region,
+                          const nvidia::gxf::Handle<nvidia::gxf::Tensor>& tensor) {
+  const std::vector<std::shared_ptr<DataArray>>& arrays =
+      (type == Types::Density) ? density_ : segmentation_;
+  // animated and bricked volumes are set completely
+  if ((arrays.size() != 1) || resident_[static_cast<int>(type)].volume) { return false; }
+  const DataArray& data_array = *arrays[0];
+
+  const nvidia::gxf::Shape shape = tensor->shape();
+  clara::viz::DataElementType element_type;
+  if ((shape.rank() != 3) || !to_element_type(tensor->element_type(), element_type) ||
+      (element_type != data_array.type_)) {
+    return false;
+  }
+
+  std::array<uint32_t, 3> size;
+  std::array<uint32_t, 3> tensor_dims;
+  for (int i = 0; i < 3; ++i) {
+    if ((region.begin[i] >= region.end[i]) || (region.end[i] > data_array.dims_(i))) {
+      return false;
+    }
+    size[i] = region.end[i] - region.begin[i];
+    tensor_dims[i] = shape.dimension(2 - i);
+  }
+
+  // the tensor is either the complete volume or the region only
+  std::array<uint32_t, 3> source_offset{0, 0, 0};
+  if (tensor_dims == std::array<uint32_t, 3>{data_array.dims_(0),
+                                            data_array.dims_(1),
+                                            data_array.dims_(2)}) {
+    source_offset = region.begin;
+  } else if (tensor_dims != size) {
+    return false;
+  }
+
+  const size_t element_size = tensor->bytes_per_element();
+  Patch patch;
+  patch.type = type;
+  patch.region = region;
+  patch.blob = std::make_shared<clara::viz::CudaMemoryBlob>(
+      std::make_unique<clara::viz::CudaMemory>(element_size * size[0] * size[1] * size[2]));
+
+  {
+    std::unique_ptr<clara::viz::IBlob::AccessGuard> access_patch = patch.blob->Access();
+    std::unique_ptr<clara::viz::IBlob::AccessGuard> access_gpu = data_array.blob_->Access();
+
+    // copy the region to the patch, then update the complete volume from it
+    cudaMemcpy3DParms copy_params = {0};
+    copy_params.srcPtr = make_cudaPitchedPtr(const_cast<void*>(tensor->pointer()),
+                                             tensor->stride(1),
+                                             tensor_dims[0] * element_size,
+                                             tensor_dims[1]);
+    copy_params.srcPos =
+        make_cudaPos(source_offset[0] * element_size, source_offset[1], source_offset[2]);
+    copy_params.dstPtr =
+        make_cudaPitchedPtr(access_patch->GetData(), size[0] * element_size, size[0], size[1]);
+    copy_params.extent = make_cudaExtent(size[0] * element_size, size[1], size[2]);
+    if (!to_copy_kind(tensor->storage_type(), copy_params.kind)) { return false; }
+    if (cudaMemcpy3D(&copy_params) != cudaSuccess) {
+      holoscan::log_error("Failed to copy the volume region to GPU memory");
+      return false;
+    }
+
+    copy_params.srcPtr = copy_params.dstPtr;
+    copy_params.srcPos = make_cudaPos(0, 0, 0);
+    copy_params.dstPtr = make_cudaPitchedPtr(access_gpu->GetData(),
+                                             data_array.dims_(0) * element_size,
+                                             data_array.dims_(0),
+                                             data_array.dims_(1));
+    copy_params.dstPos = make_cudaPos(region.begin[0] * element_size, region.begin[1],
+                                      region.begin[2]);
+    copy_params.kind = cudaMemcpyKind::cudaMemcpyDeviceToDevice;
+    if (cudaMemcpy3D(&copy_params) != cudaSuccess) {
+      holoscan::log_error("Failed to update the volume region in GPU memory");
+      return false;
+    }
+  }
+
+  patches_.push_back(patch);
+  return true;
+}
+
+void Dataset::SetPatches(clara::viz::DataInterface& data_interface) {
+  for (const Patch& patch : patches_) {
+    clara::viz::DataInterface::AccessGuard access(data_interface);
+    access->array_id.Set((patch.type == Types::Density) ? "density" : "segmentation");
+    access->level.Set(0);
+    access->offset.Set({0, patch.region.begin[0], patch.region.begin[1], patch.region.begin[2]});
+    access->size.Set({1,
+                      patch.region.end[0] - patch.region.begin[0],
+                      patch.region.end[1] - patch.region.begin[1],
+                      patch.region.end[2] - patch.region.begin[2]});
+    access->blob = patch.blob;
+  }
+  patches_.clear();
 }
 
 void Dataset::ResetVolume(Types type) {
+  resident_[static_cast<int>(type)] = Resident();
   switch (type) {
     case Types::Density:
       density_.clear();
@@ -174,9 +334,144 @@ void Dataset::ResetVolume(Types type) {
   }
 }
 
+void Dataset::SetResidency(size_t budget, size_t cache_size,
+                           const std::optional<float>& empty_threshold) {
+  budget_ = budget;
+  cache_size_ = cache_size;
+  empty_threshold_ = empty_threshold;
+}
+
+bool Dataset::IsBricked() const {
+  return resident_[0].volume || resident_[1].volume;
+}
+
+bool Dataset::UpdateResidency(const std::vector<clara::viz::Vector2f>& limits) {
+  if (!IsBricked()) { return false; }
+
+  // the visible region, limited to the bricks of the density which are not empty
+  std::array<float, 3> begin{0.f, 0.f, 0.f};
+  std::array<float, 3> end{1.f, 1.f, 1.f};
+  for (int i = 0; (i < 3) && (i + 1 < static_cast<int>(limits.size())); ++i) {
+    begin[i] = limits[i + 1](0);
+    end[i] = limits[i + 1](1);
+  }
+  const Resident& density = resident_[static_cast<int>(Types::Density)];
+  if (density.volume && empty_threshold_.has_value()) {
+    const VolumeBox occupied = density.volume->occupied_box(empty_threshold_.value());
+    for (int i = 0; i < 3; ++i) {
+      begin[i] = std::max(begin[i], float(occupied.begin[i]) / density.volume->dims()[i]);
+      end[i] = std::min(end[i], float(occupied.end[i]) / density.volume->dims()[i]);
+    }
+  }
+
+  std::array<VolumeBox, 2> boxes;
+  for (size_t type = 0; type < resident_.size(); ++type) {
+    if (resident_[type].volume) { boxes[type] = resident_[type].volume->brick_box(begin, end); }
+  }
+
+  // downsample until the resident volumes fit the budget
+  uint32_t factor = 1;
+  auto resident_size = [&] {
+    size_t size = 0;
+    for (size_t type = 0; type < resident_.size(); ++type) {
+      if (!resident_[type].volume) { continue; }
+      const auto dims = BrickedVolume::downsampled_dims(boxes[type], factor);
+      size += size_t(dims[0]) * dims[1] * dims[2] * resident_[type].volume->bytes_per_element();
+    }
+    return size;
+  };
+  while ((factor < BrickedVolume::kBrickSize) && (resident_size() > budget_)) { factor *= 2; }
+
+  bool changed = false;
+  for (size_t type = 0; type < resident_.size(); ++type) {
+    const Resident& resident = resident_[type];
+    if (resident.volume && ((resident.box != boxes[type]) || (resident.factor != factor))) {
+      changed = true;
+    }
+  }
+  if (!changed) { return false; }
+
+  if (factor != resident_[0].factor) {
+    holoscan::log_info("Dataset: bricked volume resident at 1/{} resolution", factor);
+  }
+
+  for (size_t type = 0; type < resident_.size(); ++type) {
+    Resident& resident = resident_[type];
+    if (!resident.volume) { continue; }
+    resident.box = boxes[type];
+    resident.factor = factor;
+
+    const std::shared_ptr<DataArray>& data_array = (type == 0) ? density_[0] : segmentation_[0];
+    const auto dims = BrickedVolume::downsampled_dims(resident.box, factor);
+    data_array->dims_ = clara::viz::Vector3ui(dims[0], dims[1], dims[2]);
+    data_array->spacing_ = clara::viz::Vector3f(resident.spacing(0) * factor,
+                                                resident.spacing(1) * factor,
+                                                resident.spacing(2) * factor);
+    // a new blob, the renderer may still use the previous one
+    data_array->blob_ = std::make_shared<clara::viz::CudaMemoryBlob>(
+        std::make_unique<clara::viz::CudaMemory>(size_t(dims[0]) * dims[1] * dims[2] *
+                                                 resident.volume->bytes_per_element()));
+
+    std::unique_ptr<clara::viz::IBlob::AccessGuard> access_gpu = data_array->blob_->Access();
+    resident.volume->assemble(resident.box,
+                              factor,
+                              (type == 0) ? empty_threshold_ : std::optional<float>(),
+                              access_gpu->GetData(),
+                              0);
+    if (cudaStreamSynchronize(0) != cudaSuccess) {
+      holoscan::log_error("Failed to copy the resident bricks to GPU memory");
+    }
+  }
+  return true;
+}
+
+std::vector<clara::viz::Vector2f> Dataset::GetResidentLimits(
+    const std::vector<clara::viz::Vector2f>& limits) const {
+  const Resident& resident = resident_[0].volume ? resident_[0] : resident_[1];
+  if (!resident.volume) { return limits; }
+
+  std::vector<clara::viz::Vector2f> resident_limits = limits;
+  const auto dims = BrickedVolume::downsampled_dims(resident.box, resident.factor);
+  for (int i = 0; (i < 3) && (i + 1 < static_cast<int>(limits.size())); ++i) {
+    const float size = resident.volume->dims()[i];
+    // downsampling rounds up, the resident part may extend past the box
+    const float begin = resident.box.begin[i] / size;
+    const float extent = (dims[i] * resident.factor) / size;
+    for (int limit = 0; limit < 2; ++limit) {
+      resident_limits[i + 1](limit) =
+          std::clamp((limits[i + 1](limit) - begin) / extent, 0.f, 1.f);
+    }
+  }
+  return resident_limits;
+}
+
+std::array<float, 3> Dataset::GetResidentOffset() const {
+  const int type = resident_[0].volume ? 0 : 1;
+  const Resident& resident = resident_[type];
+  if (!resident.volume) { return {0.f, 0.f, 0.f}; }
+
+  const DataArray& data_array = (type == 0) ? *density_[0] : *segmentation_[0];
+  const auto dims = BrickedVolume::downsampled_dims(resident.box, resident.factor);
+  std::array<float, 3> data_offset;
+  for (int i = 0; i < 3; ++i) {
+    const float center = resident.box.begin[i] + 0.5f * dims[i] * resident.factor;
+    data_offset[i] = (center - 0.5f * resident.volume->dims()[i]) * resident.spacing(i);
+  }
+
+  std::array<float, 3> offset;
+  for (int i = 0; i < 3; ++i) {
+    offset[i] = data_offset[data_array.permute_axis_[i]];
+    if (data_array.flip_axes_[i]) { offset[i] = -offset[i]; }
+  }
+  return offset;
+}
+
 void Dataset::Configure(clara::viz::DataConfigInterface& data_config_interface) {
   clara::viz::DataConfigInterface::AccessGuard access(data_config_interface);
 
+  // the arrays of a previous configuration are replaced
+  access->arrays.clear();
+
   // enable the streaming if there if more than one frame
   access->streaming = (density_.size() > 1);
 
@@ -230,6 +525,8 @@ void Dataset::Configure(clara::viz::DataConfigInterface& data_config_interface)
 }
 
 void Dataset::Set(clara::viz::DataInterface& data_interface, uint32_t frame_index) {
+  // the complete volumes include the patched regions
+  patches_.clear();
   {
     clara::viz::DataInterface::AccessGuard access(data_interface);
     if (!density_.empty()) {
@@ -21,22 +21,30 @@
 // ClaraViz is defining RuntimeError which collides with Holoscan
 #undef RuntimeError
 
+#include <gxf/core/entity.hpp>
 #include <gxf/std/tensor.hpp>
 #if !__has_include("gxf/std/dlpack_utils.hpp")
   // Holoscan 1.0 used GXF without DLPack so gxf_tensor.hpp was needed to add it
   #include <holoscan/core/gxf/gxf_tensor.hpp>
 #endif
 
+#include <array>
 #include <chrono>
 #include <memory>
+#include <optional>
 #include <string>
 #include <vector>
 
+#include "bricked_volume.hpp"
+
 class DataArray;
 
 /**
  * Defines a volume dataset, includes a density volume and optional a segmentation volume. Also
  * supports volume sequences.
+ *
+ * Volumes in host memory which exceed the device memory budget are bricked, see BrickedVolume.
+ * Only the bricks within the crop limits are resident, downsampled until they fit the budget.
  */
 class Dataset {
  public:
@@ -55,13 +63,41 @@ class Dataset {
    * @param element_range optional range of the values contained in the volume, if the vector is empty
    * then the range is calculated form the data. For example a full range of a uint8 data type is
    * defined by {0.f, 255.f}.
+   * @param entity message holding the tensor, kept while a bricked volume is resident
    * @param tensor volume data
+   *
+   * @returns true if the layout (element type, size, spacing, axes, range or frame count) differs
+   * from the volume replaced, then the dataset has to be configured again. Always true for
+   * bricked volumes, UpdateResidency() has to be called before configuring.
    */
-  void SetVolume(Types type, const std::array<float, 3>& spacing,
+  bool SetVolume(Types type, const std::array<float, 3>& spacing,
                  const std::array<uint32_t, 3>& permute_axis, const std::array<bool, 3>& flip_axes,
                  const std::vector<clara::viz::Vector2f>& element_range,
+                 const nvidia::gxf::Entity& entity,
                  const nvidia::gxf::Handle<nvidia::gxf::Tensor>& tensor);
 
+  /**
+   * Update a region of a volume set before. The region is copied to the volume and queued for
+   * SetPatches(), the rest of the volume is not copied again.
+   *
+   * @param type volume type
+   * @param region elements to update
+   * @param tensor either a volume with the size of the volume set before, or with the size of the
+   * region, of the same element type
+   *
+   * @returns false if the volume can't be patched, e.g. if it's animated, bricked or the tensor
+   * doesn't match, then it has to be set with SetVolume()
+   */
+  bool PatchVolume(Types type, const VolumeBox& region,
+                   const nvidia::gxf::Handle<nvidia::gxf::Tensor>& tensor);
+
+  /**
+   * Send the regions patched since the last call of Set() or SetPatches() to ClaraViz.
+   *
+   * @param data_interface ClaraViz data interface
+   */
+  void SetPatches(clara::viz::DataInterface& data_interface);
+
   /**
    * Reset a volume of the dataset.
    *
@@ -69,6 +105,47 @@ class Dataset {
    */
   void ResetVolume(Types type);
 
+  /**
+   * Set the device memory limits of volumes set afterwards.
+   *
+   * @param budget device memory of the resident volumes in bytes, single frame volumes in host
+   * memory which are larger are bricked. If 0 volumes are always copied completely.
+   * @param cache_size device memory of the brick cache of each bricked volume in bytes
+   * @param empty_threshold optional, density bricks with all elements at or below are skipped
+   */
+  void SetResidency(size_t budget, size_t cache_size, const std::optional<float>& empty_threshold);
+
+  /**
+   * @returns true if a volume is bricked
+   */
+  bool IsBricked() const;
+
+  /**
+   * Make the bricks of the bricked volumes within the crop limits resident, downsampled by the
+   * smallest power of two which fits the budget.
+   *
+   * @param limits crop limits relative to the complete volume, as passed to the ClaraViz data crop
+   * interface
+   *
+   * @returns true if the resident bricks or their resolution changed, then the dataset has to be
+   * configured and set again
+   */
+  bool UpdateResidency(const std::vector<clara::viz::Vector2f>& limits);
+
+  /**
+   * @param limits crop limits relative to the complete volume
+   *
+   * @returns the crop limits relative to the resident part of the volume
+   */
+  std::vector<clara::viz::Vector2f> GetResidentLimits(
+      const std::vector<clara::viz::Vector2f>& limits) const;
+
+  /**
+   * @returns the offset in millimeters of the resident part of the volume from the center of the
+   * complete volume, after axis permutation and flip
+   */
+  std::array<float, 3> GetResidentOffset() const;
+
   /**
    * Sent the dataset configuration to the ClaraViz data configuration interface.
    *
@@ -100,6 +177,27 @@ class Dataset {
  private:
   std::vector<std::shared_ptr<DataArray>> density_;
   std::vector<std::shared_ptr<DataArray>> segmentation_;
+
+  /// bricked volume and its resident box, indexed by type
+  struct Resident {
+    std::shared_ptr<BrickedVolume> volume;
+    VolumeBox box;
+    uint32_t factor = 0;
+    clara::viz::Vector3f spacing{1.f, 1.f, 1.f};
+  };
+  std::array<Resident, 2> resident_;
+
+  /// regions updated by PatchVolume() which are not sent to ClaraViz yet
+  struct Patch {
+    Types type;
+    VolumeBox region;
+    std::shared_ptr<clara::viz::IBlob> blob;
+  };
+  std::vector<Patch> patches_;
+  size_t budget_ = 0;
+  size_t cache_size_ = 0;
+  std::optional<float> empty_threshold_;
+
   std::chrono::duration<float> frame_duration_ = std::chrono::duration<float>(1);
 };
 
@@ -62,15 +62,33 @@ class PyVolumeRendererOp : public VolumeRendererOp {
                      uint32_t alloc_height, std::optional<float> density_min,
                      std::optional<float> density_max,
                      const std::shared_ptr<holoscan::CudaStreamPool>& cuda_stream_pool,
+                     float frame_time_target = 0.f, float min_quality = 0.25f,
+                     uint32_t device_memory_budget = 0, uint32_t brick_cache_size = 1024,
+                     std::optional<float> empty_space_threshold = std::nullopt,
+                     bool temporal_accumulation = false, uint32_t max_accumulated_frames = 32,
+                     float motion_history_weight = 0.8f, uint32_t cuda_device = 0,
+                     const std::string& stereo_mode = "",
                      const std::string& name = "volume_renderer")
       : VolumeRendererOp(ArgList{Arg{"config_file", config_file},
                                  Arg{"write_config_file", write_config_file},
                                  Arg{"allocator", allocator},
                                  Arg{"alloc_width", alloc_width},
-                                 Arg{"alloc_height", alloc_height}}) {
+                                 Arg{"alloc_height", alloc_height},
+                                 Arg{"frame_time_target", frame_time_target},
+                                 Arg{"min_quality", min_quality},
+                                 Arg{"device_memory_budget", device_memory_budget},
+                                 Arg{"brick_cache_size", brick_cache_size},
+                                 Arg{"temporal_accumulation", temporal_accumulation},
+                                 Arg{"max_accumulated_frames", max_accumulated_frames},
+                                 Arg{"motion_history_weight", motion_history_weight},
+                                 Arg{"cuda_device", cuda_device},
+                                 Arg{"stereo_mode", stereo_mode}}) {
     if (cuda_stream_pool) { this->add_arg(Arg{"cuda_stream_pool", cuda_stream_pool}); }
     if (density_min.has_value()) { this->add_arg(Arg{"density_min", density_min.value()}); }
     if (density_max.has_value()) { this->add_arg(Arg{"density_max", density_max.value()}); }
+    if (empty_space_threshold.has_value()) {
+      this->add_arg(Arg{"empty_space_threshold", empty_space_threshold.value()});
+    }
     name_ = name;
     fragment_ = fragment;
     spec_ = std::make_shared<OperatorSpec>(fragment);
@@ -107,6 +125,16 @@ PYBIND11_MODULE(_volume_renderer, m) {
                     std::optional<float>,
                     std::optional<float>,
                     const std::shared_ptr<holoscan::CudaStreamPool>&,
+                    float,
+                    float,
+                    uint32_t,
+                    uint32_t,
+                    std::optional<float>,
+                    bool,
+                    uint32_t,
+                    float,
+                    uint32_t,
+                    const std::string&,
                     const std::string&>(),
            "fragment"_a,
            "config_file"_a = "",
@@ -117,6 +145,16 @@ PYBIND11_MODULE(_volume_renderer, m) {
            "density_min"_a = py::none(),
            "density_max"_a = py::none(),
            "cuda_stream_pool"_a = py::none(),
+           "frame_time_target"_a = 0.f,
+           "min_quality"_a = 0.25f,
+           "device_memory_budget"_a = 0u,
+           "brick_cache_size"_a = 1024u,
+           "empty_space_threshold"_a = py::none(),
+           "temporal_accumulation"_a = false,
+           "max_accumulated_frames"_a = 32u,
+           "motion_history_weight"_a = 0.8f,
+           "cuda_device"_a = 0u,
+           "stereo_mode"_a = "",
            "name"_a = "volume_renderer"s,
            doc::VolumeRendererOp::doc_VolumeRendererOp_python)
       .def("setup", &VolumeRendererOp::setup, "spec"_a, doc::VolumeRendererOp::doc_setup);
@@ -63,6 +63,40 @@ density_max : float, optional
     Maximum density volume element value. If not set this is calculated from the volume data. In
     practice CT volumes have a minimum value of -1024 which corresponds to the lower value of the
     Hounsfield scale range usually used.
+cuda_stream_pool : ``holoscan.resources.CudaStreamPool``, optional
+    `holoscan.resources.CudaStreamPool` instance to allocate CUDA streams.
+frame_time_target : float, optional
+    Render time budget in milliseconds, e.g. 11 for 90 Hz. If not 0, render resolution, ray step
+    size and iterations are adapted each frame to the measured render time, and refined
+    progressively to full quality while the view is static. Default value is ``0``.
+min_quality : float, optional
+    Lowest quality in (0, 1] the render settings are reduced to to meet the frame time target.
+    Default value is ``0.25``.
+device_memory_budget : int, optional
+    Device memory in MiB for the volumes. If not 0, volumes in host memory which are larger are
+    bricked: only the bricks within the crop box are resident, downsampled until they fit.
+    Default value is ``0``.
+brick_cache_size : int, optional
+    Device memory in MiB of the cache of uploaded bricks of each bricked volume. Default value is
+    ``1024``.
+empty_space_threshold : float, optional
+    Density bricks with all elements at or below this value are empty, they are neither uploaded
+    nor made resident. If not set no bricks are skipped.
+temporal_accumulation : bool, optional
+    Blend each frame with the previous ones: while the view is static, frames converge to their
+    mean, while the camera moves, the history is reprojected along the motion. Default value is
+    ``False``.
+max_accumulated_frames : int, optional
+    Number of frames a static view converges over. Default value is ``32``.
+motion_history_weight : float, optional
+    Weight in [0, 1) of the reprojected history while the camera moves. Default value is ``0.8``.
+cuda_device : int, optional
+    CUDA device ordinal the renderer runs on, it holds its own copy of the volumes. Default value
+    is ``0``.
+stereo_mode : str, optional
+    Overrides the stereo mode of the configuration: ``"OFF"``, ``"LEFT"``, ``"RIGHT"`` or
+    ``"TOP_BOTTOM"``. ``"LEFT"`` or ``"RIGHT"`` render a single eye of the stereo camera. Default
+    value is ``""``, the configuration is used.
 name : str, optional
     The name of the operator.
 )doc")
@@ -0,0 +1,150 @@
+/* SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "temporal_accumulation.hpp"
+
+namespace {
+
+__device__ float linear_depth(float depth, float near_z, float far_z) {
+  return (near_z * far_z) / (far_z - depth * (far_z - near_z));
+}
+
+__device__ float4 load_color(const uint8_t* color, size_t color_pitch, int x, int y) {
+  const uchar4 c = reinterpret_cast<const uchar4*>(color + y * color_pitch)[x];
+  return make_float4(c.x, c.y, c.z, c.w);
+}
+
+__device__ float4 bilinear(const float4* history, int width, int height, float u, float v) {
+  const float x = fminf(fmaxf(u - 0.5f, 0.f), width - 1.f);
+  const float y = fminf(fmaxf(v - 0.5f, 0.f), height - 1.f);
+  const int x0 = static_cast<int>(x);
+  const int y0 = static_cast<int>(y);
+  const int x1 = min(x0 + 1, width - 1);
+  const int y1 = min(y0 + 1, height - 1);
+  const float fx = x - x0;
+  const float fy = y - y0;
+  const float4 a = history[y0 * width + x0];
+  const float4 b = history[y0 * width + x1];
+  const float4 c = history[y1 * width + x0];
+  const float4 d = history[y1 * width + x1];
+  auto mix = [](float4 p, float4 q, float t) {
+    return make_float4(p.x + (q.x - p.x) * t,
+                       p.y + (q.y - p.y) * t,
+                       p.z + (q.z - p.z) * t,
+                       p.w + (q.w - p.w) * t);
+  };
+  return mix(mix(a, b, fx), mix(c, d, fx), fy);
+}
+
+__global__ void blendKernel(AccumulationView view, float history_weight, const uint8_t* color,
+                            size_t color_pitch, const float* depth, size_t depth_pitch,
+                            const float4* history_in, float4* history_out, int width,
+                            int height) {
+  const int px = blockIdx.x * blockDim.x + threadIdx.x;
+  const int py = blockIdx.y * blockDim.y + threadIdx.y;
+  if ((px >= width) || (py >= height)) return;
+
+  const float4 current = load_color(color, color_pitch, px, py);
+  float weight = history_weight;
+  float4 history = make_float4(0.f, 0.f, 0.f, 0.f);
+
+  if ((weight > 0.f) && !depth) {
+    history = history_in[py * width + px];
+  } else if (weight > 0.f) {
+    // the point seen through the pixel, in the camera space of the history
+    const float* t = view.tangents;
+    const float tx = t[0] + (px + 0.5f) / width * (t[1] - t[0]);
+    const float ty = t[2] + (py + 0.5f) / height * (t[3] - t[2]);
+    const float d = reinterpret_cast<const float*>(
+        reinterpret_cast<const uint8_t*>(depth) + py * depth_pitch)[px];
+    const float z = linear_depth(d, view.near_z, view.far_z);
+    const float x = tx * z;
+    const float y = ty * z;
+    const float* m = view.frame_to_history;
+    const float hx = m[0] * x + m[1] * y - m[2] * z + m[3];
+    const float hy = m[4] * x + m[5] * y - m[6] * z + m[7];
+    const float hz = m[8] * x + m[9] * y - m[10] * z + m[11];
+    const float u = (hx / -hz - t[0]) / (t[1] - t[0]) * width;
+    const float v = (hy / -hz - t[2]) / (t[3] - t[2]) * height;
+
+    if ((hz >= 0.f) || (u < 0.f) || (u >= width) || (v < 0.f) || (v >= height)) {
+      // disoccluded, the frame starts a new history
+      weight = 0.f;
+    } else {
+      history = bilinear(history_in, width, height, u, v);
+      // clamp to the colors around the pixel, this rejects the history of disoccluded and
+      // changed regions which reproject onto the view
+      float4 lo = current;
+      float4 hi = current;
+      for (int dy = -1; dy <= 1; ++dy) {
+        for (int dx = -1; dx <= 1; ++dx) {
+          const float4 c = load_color(color,
+                                      color_pitch,
+                                      min(max(px + dx, 0), width - 1),
+                                      min(max(py + dy, 0), height - 1));
+          lo = make_float4(fminf(lo.x, c.x), fminf(lo.y, c.y), fminf(lo.z, c.z), fminf(lo.w, c.w));
+          hi = make_float4(fmaxf(hi.x, c.x), fmaxf(hi.y, c.y), fmaxf(hi.z, c.z), fmaxf(hi.w, c.w));
+        }
+      }
+      history = make_float4(fminf(fmaxf(history.x, lo.x), hi.x),
+                            fminf(fmaxf(history.y, lo.y), hi.y),
+                            fminf(fmaxf(history.z, lo.z), hi.z),
+                            fminf(fmaxf(history.w, lo.w), hi.w));
+    }
+  }
+
+  history_out[py * width + px] = make_float4(current.x + (history.x - current.x) * weight,
+                                             current.y + (history.y - current.y) * weight,
+                                             current.z + (history.z - current.z) * weight,
+                                             current.w + (history.w - current.w) * weight);
+}
+
+__global__ void resolveKernel(const float4* history, uint8_t* color, size_t color_pitch,
+                              int width, int height) {
+  const int px = blockIdx.x * blockDim.x + threadIdx.x;
+  const int py = blockIdx.y * blockDim.y + threadIdx.y;
+  if ((px >= width) || (py >= height)) return;
+
+  const float4 h = history[py * width + px];
+  reinterpret_cast<uchar4*>(color + py * color_pitch)[px] =
+      make_uchar4(static_cast<uint8_t>(fminf(h.x + 0.5f, 255.f)),
+                  static_cast<uint8_t>(fminf(h.y + 0.5f, 255.f)),
+                  static_cast<uint8_t>(fminf(h.z + 0.5f, 255.f)),
+                  static_cast<uint8_t>(fminf(h.w + 0.5f, 255.f)));
+}
+
+}  // namespace
+
+void accumulateFrame(cudaStream_t stream, const AccumulationView& view, float history_weight,
+                     uint8_t* color, size_t color_pitch, const float* depth, size_t depth_pitch,
+                     const float4* history_in, float4* history_out, int width, int height) {
+  int tx = 8;
+  int ty = 8;
+  dim3 blocks(width / tx + 1, height / ty + 1);
+  dim3 threads(tx, ty);
+  // the neighborhood of each pixel is read while blending, the frame is written once done
+  blendKernel<<<blocks, threads, 0, stream>>>(view,
+                                              history_weight,
+                                              color,
+                                              color_pitch,
+                                              depth,
+                                              depth_pitch,
+                                              history_in,
+                                              history_out,
+                                              width,
+                                              height);
+  resolveKernel<<<blocks, threads, 0, stream>>>(history_out, color, color_pitch, width, height);
+}
@@ -0,0 +1,52 @@
+/* SPDX-FileCopyrightText: Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef OPERATORS_VOLUME_RENDERER_TEMPORAL_ACCUMULATION
+#define OPERATORS_VOLUME_RENDERER_TEMPORAL_ACCUMULATION
+
+#include <cuda_runtime.h>
+
+#include <cstddef>
+#include <cstdint>
+
+/// Camera of the frame blended with the history, in ClaraViz camera space: x right, y down,
+/// looking down -z
+struct AccumulationView {
+  /// row major 3x4 transform from the camera space of the frame to the one of the history
+  float frame_to_history[12];
+  /// tangents of the field of view angles {left, right, top, bottom}, shared by both frames
+  float tangents[4];
+  /// depth range of the non-linear depth buffer
+  float near_z;
+  float far_z;
+};
+
+/**
+ * Blends the rendered frame with the history of the previous frames and writes the result to
+ * color and history_out. With a depth buffer the history is reprojected to the frame along the
+ * camera motion and clamped to the colors around each pixel, history reprojected from outside of
+ * the view is discarded. Without, the history is taken at the same pixel.
+ *
+ * @param history_weight weight of the history, 0 discards it
+ * @param color RGBA8 frame, replaced by the blended frame
+ * @param depth float depth of the frame in [0, 1], may be null
+ * @param history_in, history_out float RGBA history, width * height elements, must not alias
+ */
+void accumulateFrame(cudaStream_t stream, const AccumulationView& view, float history_weight,
+                     uint8_t* color, size_t color_pitch, const float* depth, size_t depth_pitch,
+                     const float4* history_in, float4* history_out, int width, int height);
+
+#endif /* OPERATORS_VOLUME_RENDERER_TEMPORAL_ACCUMULATION */
@@ -23,6 +23,7 @@
 #include <gxf/cuda/cuda_event.hpp>
 #include <gxf/multimedia/camera.hpp>
 #include <gxf/multimedia/video.hpp>
+#include <gxf/std/timestamp.hpp>
 
 #include <holoscan/utils/cuda_stream_handler.hpp>
 
@@ -41,12 +42,33 @@
 #include <claraviz/interface/ViewInterface.h>
 
 #include "dataset.hpp"
+#include "temporal_accumulation.hpp"
 #include "video_buffer_blob.hpp"
 
+#include <algorithm>
+#include <array>
 #include <chrono>
+#include <cmath>
 #include <memory>
+#include <optional>
 #include <vector>
 
+/// warp settings used while foveated rendering is switched on by an eye gaze
+static constexpr float kFoveatedWarpFullResolutionSize = .4f;
+static constexpr float kFoveatedWarpResolutionScale = .28f;
+
+/// frames without view changes after which the quality is refined regardless of the budget
+static constexpr uint32_t kStaticFramesBeforeRefinement = 3;
+
+static bool pose_changed(const clara::viz::Matrix4x4& a, const clara::viz::Matrix4x4& b) {
+  for (uint32_t row = 0; row < 4; ++row) {
+    for (uint32_t col = 0; col < 4; ++col) {
+      if (std::abs(a(row, col) - b(row, col)) > 1e-4f) { return true; }
+    }
+  }
+  return false;
+}
+
 static clara::viz::Matrix4x4 to_matrix(const nvidia::gxf::Pose3D& pose) {
   return clara::viz::Matrix4x4(
       {{{{pose.rotation[0], pose.rotation[1], pose.rotation[2], pose.translation[0]}},
@@ -63,6 +85,21 @@ static clara::viz::Matrix4x4 to_matrix(const std::array<float, 16>& array) {
   return mat;
 }
 
+static clara::viz::Matrix4x4 identity_matrix() {
+  return to_matrix(std::array<float, 16>{
+      1.f, 0.f, 0.f, 0.f, 0.f, 1.f, 0.f, 0.f, 0.f, 0.f, 1.f, 0.f, 0.f, 0.f, 0.f, 1.f});
+}
+
+/// @returns matrix translated by offset, applied before the matrix
+static clara::viz::Matrix4x4 translate(const clara::viz::Matrix4x4& matrix,
+                                       const std::array<float, 3>& offset) {
+  clara::viz::Matrix4x4 result = matrix;
+  for (uint32_t row = 0; row < 3; ++row) {
+    for (uint32_t col = 0; col < 3; ++col) { result(row, 3) += matrix(row, col) * offset[col]; }
+  }
+  return result;
+}
+
 static clara::viz::Vector2f to_tangent_x(const nvidia::gxf::CameraModel& camera_model) {
   return clara::viz::Vector2f(
       -camera_model.principal_point.x / camera_model.focal_length.x,
@@ -75,6 +112,39 @@ static clara::viz::Vector2f to_tangent_y(const nvidia::gxf::CameraModel& camera_
       -(camera_model.dimensions.y - camera_model.principal_point.y) / camera_model.focal_length.y);
 }
 
+// There are some unknown discrepancies between the direction ClaraViz expects and the direction
+// OpenXR provides, needed to negate x to make it work correctly.
+static clara::viz::Vector3f to_gaze_direction(const nvidia::gxf::Pose3D& gaze_pose) {
+  return clara::viz::Vector3f{
+      -gaze_pose.rotation.at(6), gaze_pose.rotation.at(7), gaze_pose.rotation.at(8)};
+}
+
+// Normalized image coordinates of a ClaraViz gaze direction, (0, 0) is the top left corner
+static std::array<float, 2> to_foveation_center(const clara::viz::Vector3f& direction,
+                                                const clara::viz::Vector2f& tangent_x,
+                                                const clara::viz::Vector2f& tangent_y) {
+  if (direction(2) <= 0.f) { return {0.5f, 0.5f}; }
+  const float x = -direction(0) / direction(2);
+  const float y = direction(1) / direction(2);
+  return {std::clamp((x - tangent_x(0)) / (tangent_x(1) - tangent_x(0)), 0.f, 1.f),
+          std::clamp((tangent_y(0) - y) / (tangent_y(0) - tangent_y(1)), 0.f, 1.f)};
+}
+
+// Selects a CUDA device for a scope, worker threads are shared with operators on other devices
+class ScopedCudaDevice {
+ public:
+  explicit ScopedCudaDevice(uint32_t device) {
+    cudaGetDevice(&previous_);
+    if (cudaSetDevice(device) != cudaSuccess) {
+      throw std::runtime_error(fmt::format("Failed to select CUDA device {}", device));
+    }
+  }
+  ~ScopedCudaDevice() { cudaSetDevice(previous_); }
+
+ private:
+  int previous_ = 0;
+};
+
 static void normalize(clara::viz::Vector3f& v) {
   float norm = std::sqrt(v(0) * v(0) + v(1) * v(1) + v(2) * v(2));
   if (norm <= 0.f) {
@@ -225,7 +295,36 @@ class ImageService : public clara::viz::MessageReceiver, public clara::viz::Mess
 
 class VolumeRendererOp::Impl {
  public:
-  bool receive_volume(InputContext& input, Dataset::Types type);
+  ~Impl() {
+    for (void* history : history_) {
+      if (history) { cudaFree(history); }
+    }
+  }
+
+  /// how a received volume changed the dataset
+  enum class VolumeUpdate {
+    kNone,       ///< no volume received
+    kUnchanged,  ///< the volume received last was received again
+    kPatched,    ///< a region of the volume was updated
+    kSet,        ///< the volume was replaced
+  };
+  VolumeUpdate receive_volume(InputContext& input, Dataset::Types type, bool& layout_changed);
+
+  /// read the render settings the adaptive quality is relative to
+  void capture_quality_defaults();
+  /// scale resolution, step sizes and iterations of the render settings by the quality
+  void apply_quality(float quality);
+  /// adapt the quality of the next frame to the render time of the last one
+  void update_quality(float render_time_ms, bool view_changed);
+  /// blend the rendered frame with the history of the previous frames, in place
+  void accumulate(cudaStream_t stream, nvidia::gxf::VideoBuffer& color_buffer,
+                  nvidia::gxf::VideoBuffer* depth_buffer, bool scene_changed, bool camera_moved);
+  /// make the visible part of bricked volumes resident, returns true if the data changed
+  bool update_residency();
+  /// set volume transform and crop limits, relative to the resident part of bricked volumes
+  void apply_volume_transform();
+  void apply_crop_limits();
+  void apply_stereo_mode();
 
   Parameter<std::vector<IOSpec*>> settings_;
   Parameter<std::vector<IOSpec*>> merge_settings_;
@@ -236,9 +335,23 @@ class VolumeRendererOp::Impl {
   Parameter<uint32_t> alloc_height_;
   Parameter<float> density_min_;
   Parameter<float> density_max_;
+  Parameter<float> frame_time_target_;
+  Parameter<float> min_quality_;
+  Parameter<uint32_t> device_memory_budget_;
+  Parameter<uint32_t> brick_cache_size_;
+  Parameter<float> empty_space_threshold_;
+  Parameter<bool> temporal_accumulation_;
+  Parameter<uint32_t> max_accumulated_frames_;
+  Parameter<float> motion_history_weight_;
+  Parameter<uint32_t> cuda_device_;
+  Parameter<std::string> stereo_mode_;
 
   CudaStreamHandler cuda_stream_handler_;
   std::vector<clara::viz::Vector2f> limits_;
+  /// crop limits relative to the complete volume, empty if not cropped
+  std::vector<clara::viz::Vector2f> crop_limits_;
+  /// volume transform as received
+  clara::viz::Matrix4x4 volume_matrix_ = identity_matrix();
   // The extrinsic camera matrix as set by the configuration file
   nvidia::gxf::Pose3D config_pose_;
   // The inverse of the initial camera matrix
@@ -270,6 +383,15 @@ class VolumeRendererOp::Impl {
   std::unique_ptr<clara::viz::JsonInterface> json_interface_;
 
   Dataset dataset_;
+  /// identifies the volume received last of each type, a volume received again is skipped
+  struct VolumeSource {
+    const void* pointer = nullptr;
+    std::optional<int64_t> version;
+    std::array<float, 3> spacing{1.f, 1.f, 1.f};
+    std::array<uint32_t, 3> permute_axis{0, 1, 2};
+    std::array<bool, 3> flip_axes{false, false, false};
+  };
+  std::array<VolumeSource, 2> sources_;
   uint32_t current_dataset_frame_ = 0;
   std::chrono::steady_clock::time_point last_dataset_frame_start_;
   /// If 0 then foveated rendering if off, else it's a counter initialized when a valid gaze
@@ -281,9 +403,171 @@ class VolumeRendererOp::Impl {
   bool default_enable_foveation_ = false;
   float default_warp_full_resolution_size_ = 1.f;
   float default_warp_resolution_scale_ = 1.f;
+  /// gaze direction and camera tangents of each eye, for the foveation metrics
+  std::array<clara::viz::Vector3f, 2> gaze_direction_{clara::viz::Vector3f{0.f, 0.f, 1.f},
+                                                      clara::viz::Vector3f{0.f, 0.f, 1.f}};
+  std::array<clara::viz::Vector2f, 2> tangent_x_{clara::viz::Vector2f(-1.f, 1.f),
+                                                 clara::viz::Vector2f(-1.f, 1.f)};
+  std::array<clara::viz::Vector2f, 2> tangent_y_{clara::viz::Vector2f(1.f, -1.f),
+                                                 clara::viz::Vector2f(1.f, -1.f)};
+
+  /// adaptive quality in [min_quality, 1], render settings of quality 1
+  float quality_ = 1.f;
+  uint32_t static_frames_ = 0;
+  float render_time_ms_ = 0.f;
+  clara::viz::Matrix4x4 last_pose_;
+  clara::viz::Matrix4x4 last_left_eye_pose_;
+  clara::viz::Matrix4x4 last_right_eye_pose_;
+  bool default_enable_warp_ = false;
+  float default_step_size_ = 1.f;
+  float default_shadow_step_size_ = 1.f;
+  uint32_t default_max_iterations_ = 1;
+
+  /// temporal accumulation, float RGBA history of the blended frames, double buffered
+  std::array<void*, 2> history_{nullptr, nullptr};
+  size_t history_size_ = 0;
+  uint32_t history_index_ = 0;
+  uint32_t history_width_ = 0;
+  uint32_t history_height_ = 0;
+  /// frames blended into the history, 0 if there is none
+  uint32_t accumulated_frames_ = 0;
+  /// camera pose of the history
+  clara::viz::Matrix4x4 history_pose_;
+  /// stereo cameras are not reprojected, their history is discarded when they move
+  bool stereo_ = false;
+  /// depth buffer rendered for the reprojection when none is provided
+  std::optional<holoscan::gxf::Entity> accumulation_depth_message_;
+  nvidia::gxf::Handle<nvidia::gxf::VideoBuffer> accumulation_depth_buffer_;
 };
 
-bool VolumeRendererOp::Impl::receive_volume(InputContext& input, Dataset::Types type) {
+void VolumeRendererOp::Impl::capture_quality_defaults() {
+  clara::viz::RenderSettingsInterface::AccessGuard access(render_settings_interface_);
+  default_enable_warp_ = access->enable_warp;
+  default_step_size_ = access->step_size.Get();
+  default_shadow_step_size_ = access->shadow_step_size.Get();
+  default_max_iterations_ = access->max_iterations.Get();
+}
+
+void VolumeRendererOp::Impl::apply_quality(float quality) {
+  // resolution and ray step size scale down to half, the iterations with the quality
+  const float factor = 0.5f + 0.5f * quality;
+  const bool foveated = eye_gaze_counter_ != 0;
+
+  clara::viz::RenderSettingsInterface::AccessGuard access(render_settings_interface_);
+  access->step_size.Set(default_step_size_ / factor);
+  access->shadow_step_size.Set(default_shadow_step_size_ / factor);
+  const float iterations = static_cast<float>(default_max_iterations_) * quality;
+  access->max_iterations.Set(std::max(1u, static_cast<uint32_t>(std::lround(iterations))));
+  // the render resolution is reduced with the warped rendering ClaraViz uses for foveation
+  access->enable_warp = default_enable_warp_ || (quality < 1.f);
+  access->warp_resolution_scale.Set(
+      (foveated ? kFoveatedWarpResolutionScale : default_warp_resolution_scale_) * factor);
+  access->warp_full_resolution_size.Set(
+      (foveated ? kFoveatedWarpFullResolutionSize : default_warp_full_resolution_size_) * factor);
+}
+
+void VolumeRendererOp::Impl::update_quality(float render_time_ms, bool view_changed) {
+  const float target = frame_time_target_.get();
+  const float min_quality = std::clamp(min_quality_.get(), 0.f, 1.f);
+
+  static_frames_ = view_changed ? 0 : static_frames_ + 1;
+  if (static_frames_ >= kStaticFramesBeforeRefinement) {
+    // a static view is refined progressively to full quality, a missed deadline is not visible
+    quality_ = std::min(1.f, quality_ + 0.1f);
+  } else if (render_time_ms > target) {
+    // over budget, reduce proportionally, at most by half per frame
+    quality_ *= std::clamp(0.95f * target / render_time_ms, 0.5f, 0.95f);
+  } else if (render_time_ms < 0.8f * target) {
+    // well within budget, increase slowly
+    quality_ += 0.02f;
+  }
+  quality_ = std::clamp(quality_, min_quality, 1.f);
+}
+
+void VolumeRendererOp::Impl::accumulate(cudaStream_t stream,
+                                        nvidia::gxf::VideoBuffer& color_buffer,
+                                        nvidia::gxf::VideoBuffer* depth_buffer, bool scene_changed,
+                                        bool camera_moved) {
+  const auto& info = color_buffer.video_frame_info();
+  if ((info.width != history_width_) || (info.height != history_height_)) {
+    const size_t size = size_t(info.width) * info.height * sizeof(float4);
+    if (size > history_size_) {
+      for (void*& history : history_) {
+        if (history) { cudaFree(history); }
+        history = nullptr;
+        if (cudaMalloc(&history, size) != cudaSuccess) {
+          throw std::runtime_error("Failed to allocate the temporal accumulation history");
+        }
+      }
+      history_size_ = size;
+    }
+    history_width_ = info.width;
+    history_height_ = info.height;
+    scene_changed = true;
+  }
+
+  AccumulationView view{};
+  {
+    std::string camera_name;
+    {
+      clara::viz::ViewInterface::AccessGuardConst access(&view_interface_);
+      camera_name = access->GetView()->camera_name;
+    }
+    clara::viz::CameraInterface::AccessGuardConst access(&camera_interface_);
+    auto camera = access->GetCamera(camera_name);
+    const clara::viz::Vector2f depth_range = camera->depth_range.Get();
+    view.near_z = depth_range(0);
+    view.far_z = depth_range(1);
+    const float tan_y = std::tan(camera->field_of_view.Get() * (3.1416f / 180.f) * 0.5f);
+    const float tan_x = tan_y * static_cast<float>(info.width) / static_cast<float>(info.height);
+    view.tangents[0] = -tan_x;
+    view.tangents[1] = tan_x;
+    view.tangents[2] = -tan_y;
+    view.tangents[3] = tan_y;
+  }
+  const clara::viz::Matrix4x4 frame_to_history = history_pose_.Inverse() * last_pose_;
+  for (int row = 0; row < 3; ++row) {
+    for (int col = 0; col < 4; ++col) {
+      view.frame_to_history[row * 4 + col] = frame_to_history(row, col);
+    }
+  }
+
+  // a static view converges to the mean of up to max_accumulated_frames frames, a moving one
+  // keeps an exponential history, changes of the scene and stereo motion discard it
+  const bool reproject = camera_moved && !stereo_ && depth_buffer;
+  float history_weight = 0.f;
+  if (scene_changed || (camera_moved && !reproject) || (accumulated_frames_ == 0)) {
+    accumulated_frames_ = 1;
+  } else if (camera_moved) {
+    history_weight = std::clamp(motion_history_weight_.get(), 0.f, 1.f);
+    accumulated_frames_ = 1;
+  } else {
+    accumulated_frames_ =
+        std::min(accumulated_frames_ + 1, std::max(max_accumulated_frames_.get(), 1u));
+    history_weight = 1.f - 1.f / static_cast<float>(accumulated_frames_);
+  }
+
+  const uint32_t next = history_index_ ^ 1;
+  accumulateFrame(stream,
+                  view,
+                  history_weight,
+                  reinterpret_cast<uint8_t*>(color_buffer.pointer()),
+                  info.color_planes[0].stride,
+                  reproject ? reinterpret_cast<const float*>(depth_buffer->pointer()) : nullptr,
+                  reproject ? depth_buffer->video_frame_info().color_planes[0].stride : 0,
+                  reinterpret_cast<const float4*>(history_[history_index_]),
+                  reinterpret_cast<float4*>(history_[next]),
+                  info.width,
+                  info.height);
+  if (cudaGetLastError() != cudaSuccess) {
+    throw std::runtime_error("Failed to launch the temporal accumulation");
+  }
+  history_index_ = next;
+  history_pose_ = last_pose_;
+}
+
+VolumeRendererOp::Impl::VolumeUpdate VolumeRendererOp::Impl::receive_volume(
+    InputContext& input, Dataset::Types type, bool& layout_changed) {
   std::string name(type == Dataset::Types::Density ? "density" : "mask");
 
   auto volume = input.receive<holoscan::gxf::Entity>((name + "_volume").c_str());
@@ -291,10 +575,13 @@ bool VolumeRendererOp::Impl::receive_volume(InputContext& input, Dataset::Types
   auto permute_axis_input =
       input.receive<std::array<uint32_t, 3>>((name + "_permute_axis").c_str());
   auto flip_axes_input = input.receive<std::array<bool, 3>>((name + "_flip_axes").c_str());
+  auto region_input =
+      input.receive<std::array<nvidia::gxf::Vector2u, 3>>((name + "_region").c_str());
 
   if (volume) {
+    const nvidia::gxf::Entity entity = static_cast<nvidia::gxf::Entity>(volume.value());
     nvidia::gxf::Handle<nvidia::gxf::Tensor> volume_tensor =
-        static_cast<nvidia::gxf::Entity>(volume.value()).get<nvidia::gxf::Tensor>("volume").value();
+        entity.get<nvidia::gxf::Tensor>("volume").value();
 
     std::array<float, 3> spacing{1.f, 1.f, 1.f};
     std::array<uint32_t, 3> permute_axis{0, 1, 2};
@@ -304,6 +591,37 @@ bool VolumeRendererOp::Impl::receive_volume(InputContext& input, Dataset::Types
     if (permute_axis_input) { permute_axis = *permute_axis_input; }
     if (flip_axes_input) { flip_axes = *flip_axes_input; }
 
+    VolumeSource source;
+    source.pointer = volume_tensor->pointer();
+    auto timestamp = entity.get<nvidia::gxf::Timestamp>();
+    if (timestamp) { source.version = timestamp.value()->acqtime; }
+    source.spacing = spacing;
+    source.permute_axis = permute_axis;
+    source.flip_axes = flip_axes;
+
+    VolumeSource& previous = sources_[static_cast<int>(type)];
+    const bool same_geometry = (source.spacing == previous.spacing) &&
+                               (source.permute_axis == previous.permute_axis) &&
+                               (source.flip_axes == previous.flip_axes);
+
+    if (region_input) {
+      // an edited region, e.g. of an interactive segmentation
+      VolumeBox region;
+      for (int i = 0; i < 3; ++i) {
+        region.begin[i] = (*region_input)[i].x;
+        region.end[i] = (*region_input)[i].y;
+      }
+      if (same_geometry && dataset_.PatchVolume(type, region, volume_tensor)) {
+        previous = source;
+        return VolumeUpdate::kPatched;
+      }
+    } else if (same_geometry && source.version.has_value() &&
+               (source.pointer == previous.pointer) && (source.version == previous.version)) {
+      // only unchanged memory of a versioned volume can be skipped, pools reuse memory
+      return VolumeUpdate::kUnchanged;
+    }
+    previous = source;
+
     std::vector<clara::viz::Vector2f> element_range;
 
     // set the element range if this is a density volume
@@ -321,16 +639,55 @@ bool VolumeRendererOp::Impl::receive_volume(InputContext& input, Dataset::Types
       if (has_range) { element_range.push_back(range); }
     }
 
-    dataset_.SetVolume(type, spacing, permute_axis, flip_axes, element_range, volume_tensor);
+    if (dataset_.SetVolume(type,
+                           spacing,
+                           permute_axis,
+                           flip_axes,
+                           element_range,
+                           entity,
+                           volume_tensor)) {
+      layout_changed = true;
+    }
 
-    return true;
+    return VolumeUpdate::kSet;
   }
 
-  return false;
+  return VolumeUpdate::kNone;
+}
+
+bool VolumeRendererOp::Impl::update_residency() {
+  if (!dataset_.IsBricked()) { return false; }
+
+  std::vector<clara::viz::Vector2f> limits = crop_limits_.empty() ? limits_ : crop_limits_;
+  if (limits.empty()) { limits.assign(4, clara::viz::Vector2f(0.f, 1.f)); }
+  return dataset_.UpdateResidency(limits);
+}
+
+void VolumeRendererOp::Impl::apply_volume_transform() {
+  clara::viz::DataTransformInterface::AccessGuard access(data_transform_interface_);
+  access->matrix = translate(volume_matrix_, dataset_.GetResidentOffset());
+}
+
+void VolumeRendererOp::Impl::apply_crop_limits() {
+  const std::vector<clara::viz::Vector2f>& limits = crop_limits_.empty() ? limits_ : crop_limits_;
+  clara::viz::DataCropInterface::AccessGuard access(data_crop_interface_);
+  access->limits.Set(dataset_.GetResidentLimits(limits));
+}
+
+void VolumeRendererOp::Impl::apply_stereo_mode() {
+  if (stereo_mode_.get().empty()) { return; }
+  // overrides the stereo mode of the configuration, also when merged settings restore it
+  nlohmann::json settings;
+  settings["Views"] = nlohmann::json::array({{{"stereoMode", stereo_mode_.get()}}});
+  json_interface_->MergeSettings(settings);
 }
 
 void VolumeRendererOp::initialize() {
-  const std::vector<uint32_t> cuda_device_ordinals{0};
+  // the renderer is created on the device given by the parameters
+  Operator::initialize();
+
+  const std::vector<uint32_t> cuda_device_ordinals{impl_->cuda_device_.get()};
+  ScopedCudaDevice cuda_device(impl_->cuda_device_.get());
 
   clara::viz::LogLevel log_level;
   switch (holoscan::log_level()) {
@@ -414,12 +771,17 @@ void VolumeRendererOp::initialize() {
                                                   &impl_->transfer_function_interface_,
                                                   &impl_->view_interface_);
   impl_->json_interface_->InitSettings();
-
-  // call base class
-  Operator::initialize();
 }
 
 void VolumeRendererOp::start() {
+  ScopedCudaDevice cuda_device(impl_->cuda_device_.get());
+  impl_->dataset_.SetResidency(
+      size_t(impl_->device_memory_budget_.get()) * 1024 * 1024,
+      size_t(impl_->brick_cache_size_.get()) * 1024 * 1024,
+      impl_->empty_space_threshold_.has_value()
+          ? std::optional<float>(impl_->empty_space_threshold_.get())
+          : std::optional<float>());
+
   if (!impl_->config_file_.get().empty()) {
     // setup renderer by reading settings from the configuration file
     std::ifstream input_file_stream(impl_->config_file_.get());
@@ -439,6 +801,7 @@ void VolumeRendererOp::start() {
           dataset_settings.value("frameDuration", 1.f)));
     }
   }
+  impl_->apply_stereo_mode();
 }
 
 void VolumeRendererOp::setup(OperatorSpec& spec) {
@@ -494,6 +857,64 @@ void VolumeRendererOp::setup(OperatorSpec& spec) {
              "Maximum density volume element value. If not set this is calculated from the volume "
              "data. In practice CT volumes have a maximum value of 3071 which corresponds to the "
              "upper value of the Hounsfield scale range usually used.");
+  spec.param(impl_->frame_time_target_,
+             "frame_time_target",
+             "Frame time target",
+             "Render time budget in milliseconds, e.g. 11 for 90 Hz. If not 0, render resolution, "
+             "ray step size and iterations are adapted each frame to the measured render time, "
+             "and refined progressively to full quality while the view is static.",
+             0.f);
+  spec.param(impl_->min_quality_,
+             "min_quality",
+             "Minimum quality",
+             "Lowest quality in (0, 1] the render settings are reduced to to meet the frame time "
+             "target.",
+             0.25f);
+  spec.param(impl_->device_memory_budget_,
+             "device_memory_budget",
+             "Device memory budget",
+             "Device memory in MiB for the volumes. If not 0, volumes in host memory which are "
+             "larger are bricked, only the bricks within the crop box are resident, downsampled "
+             "until they fit.",
+             0u);
+  spec.param(impl_->brick_cache_size_,
+             "brick_cache_size",
+             "Brick cache size",
+             "Device memory in MiB of the cache of uploaded bricks of each bricked volume.",
+             1024u);
+  spec.param(impl_->empty_space_threshold_,
+             "empty_space_threshold",
+             "Empty space threshold",
+             "Density bricks with all elements at or below this value are empty, they are neither "
+             "uploaded nor made resident. If not set no bricks are skipped.");
+  spec.param(impl_->temporal_accumulation_,
+             "temporal_accumulation",
+             "Temporal accumulation",
+             "Blend each frame with the previous ones: while the view is static, frames converge "
+             "to their mean, while the camera moves, the history is reprojected along the motion.",
+             false);
+  spec.param(impl_->max_accumulated_frames_,
+             "max_accumulated_frames",
+             "Maximum accumulated frames",
+             "Number of frames a static view converges over.",
+             32u);
+  spec.param(impl_->motion_history_weight_,
+             "motion_history_weight",
+             "Motion history weight",
+             "Weight in [0, 1) of the reprojected history while the camera moves.",
+             0.8f);
+  spec.param(impl_->cuda_device_,
+             "cuda_device",
+             "CUDA device",
+             "CUDA device ordinal the renderer runs on, it holds its own copy of the volumes.",
+             0u);
+  spec.param(impl_->stereo_mode_,
+             "stereo_mode",
+             "Stereo mode",
+             "Overrides the stereo mode of the configuration: OFF, LEFT, RIGHT or TOP_BOTTOM. "
+             "LEFT or RIGHT render a single eye of the stereo camera, e.g. one eye per GPU. If "
+             "empty the configuration is used.",
+             std::string(""));
 
   spec.input<nvidia::gxf::Pose3D>("volume_pose").condition(ConditionType::kNone);
   spec.input<std::array<nvidia::gxf::Vector2f, 3>>("crop_box").condition(ConditionType::kNone);
@@ -505,6 +926,8 @@ void VolumeRendererOp::setup(OperatorSpec& spec) {
   spec.input<nvidia::gxf::CameraModel>("right_camera_model").condition(ConditionType::kNone);
 
   spec.input<nvidia::gxf::Pose3D>("eye_gaze_pose").condition(ConditionType::kNone);
+  spec.input<nvidia::gxf::Pose3D>("left_eye_gaze_pose").condition(ConditionType::kNone);
+  spec.input<nvidia::gxf::Pose3D>("right_eye_gaze_pose").condition(ConditionType::kNone);
 
   spec.input<std::any>("camera_pose").condition(ConditionType::kNone);
 
@@ -515,30 +938,49 @@ void VolumeRendererOp::setup(OperatorSpec& spec) {
   spec.input<std::array<float, 3>>("density_spacing").condition(ConditionType::kNone);
   spec.input<std::array<uint32_t, 3>>("density_permute_axis").condition(ConditionType::kNone);
   spec.input<std::array<bool, 3>>("density_flip_axes").condition(ConditionType::kNone);
+  spec.input<std::array<nvidia::gxf::Vector2u, 3>>("density_region")
+      .condition(ConditionType::kNone);
 
   spec.input<holoscan::gxf::Entity>("mask_volume").condition(ConditionType::kNone);
   spec.input<std::array<float, 3>>("mask_spacing").condition(ConditionType::kNone);
   spec.input<std::array<uint32_t, 3>>("mask_permute_axis").condition(ConditionType::kNone);
   spec.input<std::array<bool, 3>>("mask_flip_axes").condition(ConditionType::kNone);
+  spec.input<std::array<nvidia::gxf::Vector2u, 3>>("mask_region").condition(ConditionType::kNone);
 
   spec.output<holoscan::gxf::Entity>("color_buffer_out");
   spec.output<holoscan::gxf::Entity>("depth_buffer_out").condition(ConditionType::kNone);
+  spec.output<std::array<float, 3>>("render_metrics").condition(ConditionType::kNone);
+  spec.output<std::array<float, 6>>("foveation_metrics").condition(ConditionType::kNone);
 
   impl_->cuda_stream_handler_.defineParams(spec);
 }
 
 void VolumeRendererOp::compute(InputContext& input, OutputContext& output,
                                ExecutionContext& context) {
+  ScopedCudaDevice cuda_device(impl_->cuda_device_.get());
+
   // get the density volumes
-  bool new_volume = impl_->receive_volume(input, Dataset::Types::Density);
-  if (!impl_->receive_volume(input, Dataset::Types::Segmentation)) {
+  bool layout_changed = false;
+  const Impl::VolumeUpdate density_update =
+      impl_->receive_volume(input, Dataset::Types::Density, layout_changed);
+  const Impl::VolumeUpdate mask_update =
+      impl_->receive_volume(input, Dataset::Types::Segmentation, layout_changed);
+  if ((density_update == Impl::VolumeUpdate::kSet) &&
+      (mask_update == Impl::VolumeUpdate::kNone)) {
     // there are datasets without segmentation volume, if we receive a density volume
     // only, reset the segmentation volume
     impl_->dataset_.ResetVolume(Dataset::Types::Segmentation);
-  } else {
-    new_volume = true;
+    impl_->sources_[static_cast<int>(Dataset::Types::Segmentation)] = Impl::VolumeSource();
   }
-  if (new_volume) {
+  const bool new_volume = (density_update == Impl::VolumeUpdate::kSet) ||
+                          (mask_update == Impl::VolumeUpdate::kSet);
+  const bool patched_volume = (density_update == Impl::VolumeUpdate::kPatched) ||
+                              (mask_update == Impl::VolumeUpdate::kPatched);
+  if (new_volume && !layout_changed) {
+    // the next volume of a sequence, only the data changed, keep the configuration and view
+    impl_->dataset_.Set(*impl_->data_interface_.get());
+  } else if (new_volume) {
+    impl_->update_residency();
     impl_->dataset_.Configure(impl_->data_config_interface_);
     impl_->dataset_.Set(*impl_->data_interface_.get());
 
@@ -557,7 +999,8 @@ void VolumeRendererOp::compute(InputContext& input, OutputContext& output,
       output_file_stream << settings;
     }
 
-    {
+    // the crop limits of bricked volumes are relative to the resident part, keep the first ones
+    if (!impl_->dataset_.IsBricked() || impl_->limits_.empty()) {
       clara::viz::DataCropInterface::AccessGuardConst access(&impl_->data_crop_interface_);
       impl_->limits_ = access->limits.Get();
       if (impl_->limits_.empty()) {
@@ -567,12 +1010,18 @@ void VolumeRendererOp::compute(InputContext& input, OutputContext& output,
                           clara::viz::Vector2f(0.f, 1.f)};
       }
     }
+    if (impl_->dataset_.IsBricked()) {
+      impl_->apply_volume_transform();
+      impl_->apply_crop_limits();
+    }
     {
       clara::viz::RenderSettingsInterface::AccessGuard access(impl_->render_settings_interface_);
       impl_->default_enable_foveation_ = access->enable_foveation;
       impl_->default_warp_resolution_scale_ = access->warp_resolution_scale.Get();
       impl_->default_warp_full_resolution_size_ = access->warp_full_resolution_size.Get();
     }
+    impl_->capture_quality_defaults();
+    impl_->quality_ = 1.f;
 
     // get the initial camera pose
     {
@@ -589,6 +1038,9 @@ void VolumeRendererOp::compute(InputContext& input, OutputContext& output,
     }
   }
 
+  // edited regions are sent alone, the rest of the volumes stays resident
+  impl_->dataset_.SetPatches(*impl_->data_interface_.get());
+
   std::vector<nvidia::gxf::Entity> messages;
 
   // get the input buffers
@@ -626,6 +1078,30 @@ void VolumeRendererOp::compute(InputContext& input, OutputContext& output,
     auto entity = static_cast<nvidia::gxf::Entity&>(depth_message.value());
     depth_buffer = entity.get<nvidia::gxf::VideoBuffer>().value();
     messages.push_back(entity);
+  } else if (impl_->temporal_accumulation_.get()) {
+    // the reprojection of the history needs the depth of the frame
+    const auto& info = color_buffer->video_frame_info();
+    auto& depth = impl_->accumulation_depth_buffer_;
+    if (!impl_->accumulation_depth_message_) {
+      impl_->accumulation_depth_message_ = holoscan::gxf::Entity::New(&context);
+      depth = static_cast<nvidia::gxf::Entity&>(impl_->accumulation_depth_message_.value())
+                  .add<nvidia::gxf::VideoBuffer>()
+                  .value();
+    }
+    if ((depth->video_frame_info().width != info.width) ||
+        (depth->video_frame_info().height != info.height)) {
+      auto allocator = nvidia::gxf::Handle<nvidia::gxf::Allocator>::Create(
+          context.context(), impl_->allocator_->gxf_cid());
+      depth->resize<nvidia::gxf::VideoFormat::GXF_VIDEO_FORMAT_GRAY32F>(
+          info.width,
+          info.height,
+          nvidia::gxf::SurfaceLayout::GXF_SURFACE_LAYOUT_BLOCK_LINEAR,
+          nvidia::gxf::MemoryStorageType::kDevice,
+          allocator.value());
+      if (!depth->pointer()) {
+        throw std::runtime_error("Failed to allocate the accumulation depth buffer.");
+      }
+    }
   }
 
   // get the CUDA stream
@@ -635,17 +1111,29 @@ void VolumeRendererOp::compute(InputContext& input, OutputContext& output,
   }
   const cudaStream_t cuda_stream = impl_->cuda_stream_handler_.getCudaStream(context.context());
 
+  const bool adaptive_quality = impl_->frame_time_target_.get() > 0.f;
+  bool view_changed = new_volume;
+  // only set by the camera pose of the mono camera, which temporal accumulation reprojects
+  bool camera_moved = false;
+
   // apply new JSON settings
   auto settings = input.receive<std::vector<nlohmann::json>>("settings");
+  auto merge_settings = input.receive<std::vector<nlohmann::json>>("merge_settings");
+  if (settings || merge_settings) {
+    view_changed = true;
+    // the settings are relative to full quality
+    if (adaptive_quality) { impl_->apply_quality(1.f); }
+  }
   if (settings) {
     for (const auto& setting : settings.value()) { impl_->json_interface_->SetSettings(setting); }
   }
-  auto merge_settings = input.receive<std::vector<nlohmann::json>>("merge_settings");
   if (merge_settings) {
     for (const auto& setting : merge_settings.value()) {
       impl_->json_interface_->MergeSettings(setting);
     }
   }
+  if (settings || merge_settings) { impl_->apply_stereo_mode(); }
+  if ((settings || merge_settings) && adaptive_quality) { impl_->capture_quality_defaults(); }
 
   // update cameras
   {
@@ -659,45 +1147,67 @@ void VolumeRendererOp::compute(InputContext& input, OutputContext& output,
     auto camera = access->GetCamera(camera_name);
 
     auto left_pose = input.receive<nvidia::gxf::Pose3D>("left_camera_pose");
-    if (left_pose) { camera->left_eye_pose = to_matrix(*left_pose); }
+    if (left_pose) {
+      impl_->stereo_ = true;
+      camera->left_eye_pose = to_matrix(*left_pose);
+      if (pose_changed(camera->left_eye_pose, impl_->last_left_eye_pose_)) { view_changed = true; }
+      impl_->last_left_eye_pose_ = camera->left_eye_pose;
+    }
     auto left_model = input.receive<nvidia::gxf::CameraModel>("left_camera_model");
     if (left_model) {
       camera->left_tangent_x = to_tangent_x(*left_model);
       camera->left_tangent_y = to_tangent_y(*left_model);
+      impl_->tangent_x_[0] = to_tangent_x(*left_model);
+      impl_->tangent_y_[0] = to_tangent_y(*left_model);
     }
 
     auto right_pose = input.receive<nvidia::gxf::Pose3D>("right_camera_pose");
-    if (right_pose) { camera->right_eye_pose = to_matrix(*right_pose); }
+    if (right_pose) {
+      camera->right_eye_pose = to_matrix(*right_pose);
+      if (pose_changed(camera->right_eye_pose, impl_->last_right_eye_pose_)) {
+        view_changed = true;
+      }
+      impl_->last_right_eye_pose_ = camera->right_eye_pose;
+    }
     auto right_model = input.receive<nvidia::gxf::CameraModel>("right_camera_model");
     if (right_model) {
       camera->right_tangent_x = to_tangent_x(*right_model);
       camera->right_tangent_y = to_tangent_y(*right_model);
+      impl_->tangent_x_[1] = to_tangent_x(*right_model);
+      impl_->tangent_y_[1] = to_tangent_y(*right_model);
     }
 
     auto eye_gaze_pose = input.receive<nvidia::gxf::Pose3D>("eye_gaze_pose");
-    if (eye_gaze_pose) {
+    auto left_eye_gaze_pose = input.receive<nvidia::gxf::Pose3D>("left_eye_gaze_pose");
+    auto right_eye_gaze_pose = input.receive<nvidia::gxf::Pose3D>("right_eye_gaze_pose");
+    const bool eye_gaze_pose_pair = left_eye_gaze_pose && right_eye_gaze_pose;
+    if (eye_gaze_pose || eye_gaze_pose_pair) {
       if (!impl_->eye_gaze_counter_) {
         // switch on
         clara::viz::RenderSettingsInterface::AccessGuard access(impl_->render_settings_interface_);
         access->enable_foveation = true;
-        access->warp_full_resolution_size.Set(.4f);
-        access->warp_resolution_scale.Set(.28f);
+        access->warp_full_resolution_size.Set(kFoveatedWarpFullResolutionSize);
+        access->warp_resolution_scale.Set(kFoveatedWarpResolutionScale);
       }
       // initialize the counter when we have a valid gaze pose, after this number of frames
       // without a valid gaze pose ar received foveated rendering is disabled.
       constexpr uint32_t EYE_GAZE_SWITCH_OFF_FRAMES = 10;
       impl_->eye_gaze_counter_ = EYE_GAZE_SWITCH_OFF_FRAMES;
 
-      // there are some unknown discrepancies between the direction ClaraViz expects and the
-      // direction OpenXR provides, needed to negate x to make it work correctly.
-      clara::viz::Vector3f direction{-eye_gaze_pose->rotation.at(6),
-                                     eye_gaze_pose->rotation.at(7),
-                                     eye_gaze_pose->rotation.at(8)};
+      // the gaze of each eye centers the foveation on the fixation point in each view, the
+      // combined gaze is used for both eyes else
+      if (eye_gaze_pose_pair) {
+        impl_->gaze_direction_[0] = to_gaze_direction(*left_eye_gaze_pose);
+        impl_->gaze_direction_[1] = to_gaze_direction(*right_eye_gaze_pose);
+      } else {
+        impl_->gaze_direction_[0] = to_gaze_direction(*eye_gaze_pose);
+        impl_->gaze_direction_[1] = impl_->gaze_direction_[0];
+      }
 
-      camera->left_gaze_direction.Set(direction);
-      camera->right_gaze_direction.Set(direction);
+      camera->left_gaze_direction.Set(impl_->gaze_direction_[0]);
+      camera->right_gaze_direction.Set(impl_->gaze_direction_[1]);
     }
-    if (impl_->eye_gaze_counter_ && !bool(eye_gaze_pose)) {
+    if (impl_->eye_gaze_counter_ && !bool(eye_gaze_pose) && !eye_gaze_pose_pair) {
       // count down
       --impl_->eye_gaze_counter_;
       if (!impl_->eye_gaze_counter_) {
@@ -705,6 +1215,7 @@ void VolumeRendererOp::compute(InputContext& input, OutputContext& output,
         clara::viz::Vector3f direction{0.f, 0.f, 1.f};
         camera->left_gaze_direction.Set(direction);
         camera->right_gaze_direction.Set(direction);
+        impl_->gaze_direction_ = {direction, direction};
 
         clara::viz::RenderSettingsInterface::AccessGuard access(impl_->render_settings_interface_);
         access->enable_foveation = impl_->default_enable_foveation_;
@@ -752,6 +1263,8 @@ void VolumeRendererOp::compute(InputContext& input, OutputContext& output,
     // write the final pose to the camera
     camera->enable_pose = true;
     camera->pose = pose;
+    if (pose_changed(pose, impl_->last_pose_)) { camera_moved = true; }
+    impl_->last_pose_ = pose;
 
     auto depth_range = input.receive<nvidia::gxf::Vector2f>("depth_range");
     if (depth_range) {
@@ -764,13 +1277,15 @@ void VolumeRendererOp::compute(InputContext& input, OutputContext& output,
   // set volume transform matrix
   auto volume_pose = input.receive<nvidia::gxf::Pose3D>("volume_pose");
   if (volume_pose) {
-    clara::viz::DataTransformInterface::AccessGuard access(impl_->data_transform_interface_);
-    access->matrix = to_matrix(volume_pose.value());
+    view_changed = true;
+    impl_->volume_matrix_ = to_matrix(volume_pose.value());
+    impl_->apply_volume_transform();
   }
 
   // set volume cropping limits
   auto crop_limits = input.receive<std::array<nvidia::gxf::Vector2f, 3>>("crop_box");
   if (crop_limits) {
+    view_changed = true;
     std::array<nvidia::gxf::Vector2f, 3>& crop = crop_limits.value();
     std::vector<clara::viz::Vector2f> limits = impl_->limits_;
     for (int i = 1; i < 4; i++) {
@@ -789,8 +1304,14 @@ void VolumeRendererOp::compute(InputContext& input, OutputContext& output,
       }
     }
 
-    clara::viz::DataCropInterface::AccessGuard access(impl_->data_crop_interface_);
-    access->limits.Set(limits);
+    impl_->crop_limits_ = limits;
+    // bricks entering the crop box are uploaded, the resolution rises as the box shrinks
+    if (impl_->update_residency()) {
+      impl_->dataset_.Configure(impl_->data_config_interface_);
+      impl_->dataset_.Set(*impl_->data_interface_.get());
+      impl_->apply_volume_transform();
+    }
+    impl_->apply_crop_limits();
   }
 
   // update the dataset frame number for animated datasets
@@ -812,15 +1333,23 @@ void VolumeRendererOp::compute(InputContext& input, OutputContext& output,
           std::chrono::duration_cast<std::chrono::milliseconds>(impl_->dataset_.GetFrameDuration());
     }
     if (dataset_frame_changed) {
+      view_changed = true;
       // switch to the new dataset
       impl_->dataset_.Set(*impl_->data_interface_.get(), impl_->current_dataset_frame_);
     }
   }
 
+  if (adaptive_quality) { impl_->apply_quality(impl_->quality_); }
+
   // render
+  const auto render_start = std::chrono::steady_clock::now();
   const std::shared_ptr<VideoBufferBlob> color_buffer_blob(new VideoBufferBlob(color_buffer));
   std::shared_ptr<VideoBufferBlob> depth_buffer_blob;
-  if (depth_buffer) { depth_buffer_blob = std::make_shared<VideoBufferBlob>(depth_buffer); }
+  if (depth_buffer) {
+    depth_buffer_blob = std::make_shared<VideoBufferBlob>(depth_buffer);
+  } else if (impl_->accumulation_depth_message_) {
+    depth_buffer_blob = std::make_shared<VideoBufferBlob>(impl_->accumulation_depth_buffer_);
+  }
   impl_->image_service_->Render(color_buffer->video_frame_info().width,
                                 color_buffer->video_frame_info().height,
                                 color_buffer_blob,
@@ -829,6 +1358,45 @@ void VolumeRendererOp::compute(InputContext& input, OutputContext& output,
   // then wait for the message with the encoded data
   const auto image = impl_->image_service_->WaitForRenderedImage();
 
+  impl_->render_time_ms_ =
+      std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - render_start)
+          .count();
+  if (adaptive_quality) {
+    impl_->update_quality(impl_->render_time_ms_, view_changed || camera_moved);
+  }
+
+  if (impl_->temporal_accumulation_.get()) {
+    color_buffer_blob->AccessConst(cuda_stream);
+    if (depth_buffer_blob) { depth_buffer_blob->AccessConst(cuda_stream); }
+    impl_->accumulate(cuda_stream,
+                      *color_buffer,
+                      depth_buffer_blob ? (depth_buffer ? depth_buffer.get()
+                                                        : impl_->accumulation_depth_buffer_.get())
+                                        : nullptr,
+                      view_changed || patched_volume,
+                      camera_moved);
+  }
+  output.emit(
+      std::array<float, 3>{
+          impl_->render_time_ms_, impl_->frame_time_target_.get(), impl_->quality_},
+      "render_metrics");
+  if (impl_->eye_gaze_counter_) {
+    std::array<float, 6> foveation_metrics;
+    for (uint32_t eye = 0; eye < 2; ++eye) {
+      const auto center = to_foveation_center(
+          impl_->gaze_direction_[eye], impl_->tangent_x_[eye], impl_->tangent_y_[eye]);
+      foveation_metrics[eye * 2] = center[0];
+      foveation_metrics[eye * 2 + 1] = center[1];
+    }
+    {
+      clara::viz::RenderSettingsInterface::AccessGuardConst access(
+          &impl_->render_settings_interface_);
+      foveation_metrics[4] = access->warp_full_resolution_size.Get();
+      foveation_metrics[5] = access->warp_resolution_scale.Get();
+    }
+    output.emit(foveation_metrics, "foveation_metrics");
+  }
+
   // Add both a CUDA event and the CUDA stream to the outgoing message,
   // some operators expect an event and some a stream to synchronize with
 
@@ -852,7 +1420,8 @@ void VolumeRendererOp::compute(InputContext& input, OutputContext& output,
     output.emit(color_message.value(), "color_buffer_out");
   }
 
-  if (depth_buffer_blob) {
+  // the depth buffer rendered for the accumulation only is kept
+  if (depth_buffer) {
     depth_buffer_blob->AccessConst(cuda_stream);
 
     nvidia::gxf::Expected<nvidia::gxf::Entity> message(depth_message.value());
@@ -25,13 +25,17 @@
 
 #include <cuda.h>
 
-#include <vtkCamera.h>
-#include <vtkImageActor.h>
-#include <vtkImageData.h>
 #include <vtkNew.h>
+#include <vtkOpenGLRenderWindow.h>
+#include <vtkOpenGLTexture.h>
+#include <vtkPixelBufferObject.h>
 #include <vtkRenderWindow.h>
 #include <vtkRenderer.h>
 #include <vtkTextActor.h>
+#include <vtkTextureObject.h>
+#include <vtk_glew.h>
+
+#include <cuda_gl_interop.h>
 
 #define CUDA_TRY(stmt)                                                                   \
   ({                                                                                     \
@@ -63,42 +67,24 @@ static void render_text_at_location(std::string text, float x, float y, vtkRende
   renderer->AddActor(textActor);
 }
 
-/**
- * @brief Reposition the camera to fit the image in the renderer.
- *
- * @param renderer The renderer to reposition the camera in.
- * @param imageData The image data to fit in the renderer.
- */
-static void reposition_camera(vtkRenderer* renderer, vtkImageData* imageData) {
-  // Set up the background camera to fill the renderer with the image.
-  double origin[3];
-  double spacing[3];
-  int extent[6];
-  imageData->GetOrigin(origin);
-  imageData->GetSpacing(spacing);
-  imageData->GetExtent(extent);
-
-  vtkCamera* camera = renderer->GetActiveCamera();
-  camera->ParallelProjectionOn();
-
-  // Center the image in the renderer.
-  double xc = origin[0] + 0.5 * (extent[0] + extent[1]) * spacing[0];
-  double yc = origin[1] + 0.5 * (extent[2] + extent[3]) * spacing[1];
-  double yd = (extent[3] - extent[2] + 1) * spacing[1];
-  double d = camera->GetDistance();
-  camera->SetParallelScale(0.5 * yd);
-  camera->SetFocalPoint(xc, yc, 0.0);
-  camera->SetPosition(xc, yc, d);
-}
-
 namespace holoscan::ops {
 
 // VTK members
 struct VtkRendererOp::Internals {
-  vtkNew<vtkImageActor> image_actor;
+  ~Internals() {
+    if (video_buffer_resource) { CUDA_TRY(cudaGraphicsUnregisterResource(video_buffer_resource)); }
+  }
+
   vtkNew<vtkRenderer> background_renderer;
   vtkNew<vtkRenderer> foreground_renderer;
   vtkNew<vtkRenderWindow> renderer_window;
+
+  // The video is copied on the device to a pixel buffer registered with CUDA, uploaded from
+  // there to the texture object and drawn as the background of the background renderer.
+  vtkNew<vtkPixelBufferObject> video_buffer;
+  vtkNew<vtkTextureObject> video_texture_object;
+  vtkNew<vtkOpenGLTexture> video_texture;
+  cudaGraphicsResource* video_buffer_resource = nullptr;
 };
 
 void VtkRendererOp::setup(OperatorSpec& spec) {
@@ -126,7 +112,27 @@ void VtkRendererOp::start() {
   this->internals->background_renderer->SetLayer(0);
   this->internals->background_renderer->InteractiveOff();
   this->internals->renderer_window->AddRenderer(this->internals->background_renderer);
-  this->internals->background_renderer->AddActor(this->internals->image_actor);
+}
+
+void VtkRendererOp::initialize_video_texture(int width, int height, int channels) {
+  auto* window = vtkOpenGLRenderWindow::SafeDownCast(this->internals->renderer_window);
+  if (!window) { throw std::runtime_error("videostream input : OpenGL render window required"); }
+  window->Initialize();
+  window->MakeCurrent();
+
+  this->internals->video_buffer->SetContext(window);
+  this->internals->video_buffer->Allocate(
+      VTK_UNSIGNED_CHAR, width * height, channels, vtkPixelBufferObject::UNPACKED_BUFFER);
+  if (CUDA_TRY(cudaGraphicsGLRegisterBuffer(&this->internals->video_buffer_resource,
+                                            this->internals->video_buffer->GetHandle(),
+                                            cudaGraphicsMapFlagsWriteDiscard)) != cudaSuccess) {
+    throw std::runtime_error("videostream input : Failed to register the video pixel buffer");
+  }
+
+  this->internals->video_texture_object->SetContext(window);
+  this->internals->video_texture->SetTextureObject(this->internals->video_texture_object);
+  this->internals->background_renderer->SetBackgroundTexture(this->internals->video_texture);
+  this->internals->background_renderer->TexturedBackgroundOn();
 }
 
 void VtkRendererOp::compute(InputContext& op_input, OutputContext&, ExecutionContext& context) {
@@ -189,25 +195,28 @@ void VtkRendererOp::compute(InputContext& op_input, OutputContext&, ExecutionCon
                       3));
     }
 
-    vtkNew<vtkImageData> imageData;
-    imageData->SetDimensions(x, y, 1);
-    imageData->AllocateScalars(VTK_UNSIGNED_CHAR, z);
-
-    // Copy the data from the tensor to the image data.
-    CUDA_TRY(cudaMemcpy(static_cast<char*>(imageData->GetScalarPointer()),
-                        videostream_tensor->data(),
-                        videostream_tensor->nbytes(),
-                        cudaMemcpyDeviceToHost));
-
-    this->internals->image_actor->SetInputData(imageData);
-
-    // Render first to find the extent of the image.
-    this->internals->renderer_window->Render();
+    if (!this->internals->video_buffer_resource) { initialize_video_texture(x, y, z); }
+
+    // Copy the data from the tensor to the pixel buffer, without a round trip through host memory
+    // for device tensors.
+    CUDA_TRY(cudaGraphicsMapResources(1, &this->internals->video_buffer_resource, 0));
+    void* video_buffer = nullptr;
+    size_t video_buffer_size = 0;
+    if (CUDA_TRY(cudaGraphicsResourceGetMappedPointer(
+            &video_buffer, &video_buffer_size, this->internals->video_buffer_resource)) ==
+        cudaSuccess) {
+      CUDA_TRY(cudaMemcpy(video_buffer,
+                          videostream_tensor->data(),
+                          videostream_tensor->nbytes(),
+                          cudaMemcpyDefault));
+    }
+    CUDA_TRY(cudaGraphicsUnmapResources(1, &this->internals->video_buffer_resource, 0));
 
-    // Adjust camera so that it can render see the whole extent of the image.
-    reposition_camera(this->internals->background_renderer, imageData);
+    // Update the background texture from the pixel buffer.
+    vtkOpenGLRenderWindow::SafeDownCast(this->internals->renderer_window)->MakeCurrent();
+    this->internals->video_texture_object->Create2D(
+        x, y, z, this->internals->video_buffer, false);
 
-    // Final render with the camera at the proper position.
     this->internals->renderer_window->Render();
   }
 }
@@ -43,6 +43,9 @@ class VtkRendererOp : public holoscan::Operator {
   Parameter<uint32_t> height;
   Parameter<uint32_t> width;
 
+  // Allocates the video pixel buffer and background texture on the first frame
+  void initialize_video_texture(int width, int height, int channels);
+
   struct Internals;
   std::shared_ptr<Internals> internals;
 };
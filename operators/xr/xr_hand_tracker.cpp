@@ -18,6 +18,7 @@
 #include "xr_hand_tracker.hpp"
 
 #include <atomic>
+#include <cmath>
 #include <ctime>
 #include <limits>
 #include <memory>
@@ -27,6 +28,16 @@
 
 namespace holoscan {
 
+namespace {
+
+// Smoothing factor of an exponential filter with cutoff frequency `cutoff` for a step `dt`
+float smoothing_factor(float dt, float cutoff) {
+  const float tau = 1.0f / (2.0f * static_cast<float>(M_PI) * cutoff);
+  return 1.0f / (1.0f + tau / dt);
+}
+
+}  // namespace
+
 XrHandTracker::XrHandTracker(std::shared_ptr<holoscan::XrSession> xr_session, xr::HandEXT hand)
     : IXrPlugin(xr_session), hand_(hand) {}
 
@@ -41,7 +52,14 @@ void XrHandTracker::on_session_created() {
       xr_session_->get().createHandTrackerEXT(create_info, xr_session_->dispatch());
 }
 
-std::optional<std::vector<xr::HandJointLocationEXT>> XrHandTracker::locate_hand_joints() {
+void XrHandTracker::set_filter(const FilterSettings& settings) {
+  std::lock_guard<std::mutex> lock(filter_mutex_);
+  filter_settings_ = settings;
+  filter_state_.clear();
+}
+
+std::optional<std::vector<xr::HandJointLocationEXT>> XrHandTracker::locate_hand_joints(
+    std::optional<xr::Time> time) {
   auto hand_tracker_handle = hand_tracker_handle_.load(std::memory_order_relaxed);
   if (!hand_tracker_handle) {
     return {};
@@ -50,19 +68,20 @@ std::optional<std::vector<xr::HandJointLocationEXT>> XrHandTracker::locate_hand_
   auto xr_instance = xr_session_->instance();
   auto dispatch = xr_session_->dispatch();
 
-  timespec now_time;
-  if (clock_gettime(CLOCK_MONOTONIC, &now_time) == -1) {
-    HOLOSCAN_LOG_ERROR("clock_gettime return an error");
-    return {};
+  if (!time) {
+    timespec now_time;
+    if (clock_gettime(CLOCK_MONOTONIC, &now_time) == -1) {
+      HOLOSCAN_LOG_ERROR("clock_gettime return an error");
+      return {};
+    }
+    time = xr_instance.convertTimespecTimeToTimeKHR(&now_time, dispatch);
   }
 
-  const auto now_xr_time = xr_instance.convertTimespecTimeToTimeKHR(&now_time, dispatch);
-
   // Not using OpenXR-HPP here since the C++ structs do not set jointCount properly resulting in
   // validation error.
   XrHandJointsLocateInfoEXT locate_info{XR_TYPE_HAND_JOINTS_LOCATE_INFO_EXT};
   locate_info.baseSpace = xr_session_->reference_space().get();
-  locate_info.time = now_xr_time.get();
+  locate_info.time = time->get();
 
   XrHandJointLocationsEXT joint_locations{XR_TYPE_HAND_JOINT_LOCATIONS_EXT};
   joint_locations.jointCount = XR_HAND_JOINT_COUNT_EXT;
@@ -79,10 +98,77 @@ std::optional<std::vector<xr::HandJointLocationEXT>> XrHandTracker::locate_hand_
   }
 
   if (!joint_locations.isActive) {
+    std::lock_guard<std::mutex> lock(filter_mutex_);
+    // restart the filter when the hand is tracked again
+    filter_state_.clear();
     return {};
   }
 
+  filter_joints(joint_data, time->get());
   return joint_data;
 }
 
+void XrHandTracker::filter_joints(std::vector<xr::HandJointLocationEXT>& joints, XrTime time) {
+  std::lock_guard<std::mutex> lock(filter_mutex_);
+  if (!filter_settings_.enabled) {
+    return;
+  }
+
+  const float dt = (time - filter_time_) * 1e-9f;
+  if (filter_state_.size() != joints.size() || dt <= 0.0f) {
+    filter_state_.resize(joints.size());
+    for (size_t i = 0; i < joints.size(); ++i) {
+      const auto& pose = joints[i].pose;
+      filter_state_[i] = {{pose.position.x, pose.position.y, pose.position.z},
+                          {0.f, 0.f, 0.f},
+                          {pose.orientation.x, pose.orientation.y, pose.orientation.z,
+                           pose.orientation.w}};
+    }
+    filter_time_ = time;
+    return;
+  }
+  filter_time_ = time;
+
+  const float derivative_alpha = smoothing_factor(dt, filter_settings_.derivative_cutoff);
+  for (size_t i = 0; i < joints.size(); ++i) {
+    auto& pose = joints[i].pose;
+    if (!(joints[i].locationFlags & XR_SPACE_LOCATION_POSITION_VALID_BIT)) {
+      continue;
+    }
+    JointFilterState& state = filter_state_[i];
+
+    // filtered speed drives the cutoff of the position filter
+    const float position[3] = {pose.position.x, pose.position.y, pose.position.z};
+    float speed = 0.f;
+    for (int k = 0; k < 3; ++k) {
+      const float velocity = (position[k] - state.position[k]) / dt;
+      state.velocity[k] += derivative_alpha * (velocity - state.velocity[k]);
+      speed += state.velocity[k] * state.velocity[k];
+    }
+    const float cutoff = filter_settings_.min_cutoff + filter_settings_.beta * std::sqrt(speed);
+    const float alpha = smoothing_factor(dt, cutoff);
+    for (int k = 0; k < 3; ++k) { state.position[k] += alpha * (position[k] - state.position[k]); }
+    pose.position = {state.position[0], state.position[1], state.position[2]};
+
+    if (!(joints[i].locationFlags & XR_SPACE_LOCATION_ORIENTATION_VALID_BIT)) {
+      continue;
+    }
+    // normalized lerp on the shortest arc with the same smoothing factor
+    float orientation[4] = {
+        pose.orientation.x, pose.orientation.y, pose.orientation.z, pose.orientation.w};
+    float dot = 0.f;
+    for (int k = 0; k < 4; ++k) { dot += orientation[k] * state.orientation[k]; }
+    const float sign = dot < 0.f ? -1.f : 1.f;
+    float norm = 0.f;
+    for (int k = 0; k < 4; ++k) {
+      state.orientation[k] += alpha * (sign * orientation[k] - state.orientation[k]);
+      norm += state.orientation[k] * state.orientation[k];
+    }
+    norm = std::sqrt(norm);
+    for (int k = 0; k < 4; ++k) { state.orientation[k] /= norm; }
+    pose.orientation = {
+        state.orientation[0], state.orientation[1], state.orientation[2], state.orientation[3]};
+  }
+}
+
 }  // namespace holoscan
@@ -18,9 +18,12 @@
 #ifndef XR_HAND_TRACKER_HPP
 #define XR_HAND_TRACKER_HPP
 
+#include <array>
 #include <atomic>
 #include <chrono>
 #include <memory>
+#include <mutex>
+#include <optional>
 #include <set>
 #include <string>
 #include <vector>
@@ -51,12 +54,39 @@ class XrHandTracker : public holoscan::Resource, public IXrPlugin {
   [[nodiscard]] std::vector<std::string_view> get_required_instance_extensions() override;
   void on_session_created() noexcept(false) override;
 
-  [[nodiscard]] std::optional<std::vector<xr::HandJointLocationEXT>> locate_hand_joints() noexcept(
-      false);
+  // One-Euro filter settings, see https://gery.casiez.net/1euro/. The cutoff frequency of the
+  // low-pass filter is `min_cutoff + beta * speed` (Hz, m/s), so slow motion is smoothed and fast
+  // motion follows with little lag.
+  struct FilterSettings {
+    bool enabled = false;
+    float min_cutoff = 1.0f;
+    float beta = 5.0f;
+    float derivative_cutoff = 1.0f;
+  };
+
+  void set_filter(const FilterSettings& settings);
+
+  // Locates the hand joints at `time`, typically the predicted display time of the frame so the
+  // runtime extrapolates the joints to when they are seen. Uses the current time without a value.
+  [[nodiscard]] std::optional<std::vector<xr::HandJointLocationEXT>> locate_hand_joints(
+      std::optional<xr::Time> time = {}) noexcept(false);
 
  private:
+  void filter_joints(std::vector<xr::HandJointLocationEXT>& joints, XrTime time);
+
   xr::HandEXT hand_;
   std::atomic<xr::HandTrackerEXT> hand_tracker_handle_;
+
+  // One-Euro filter state of each joint
+  struct JointFilterState {
+    std::array<float, 3> position;
+    std::array<float, 3> velocity;
+    std::array<float, 4> orientation;
+  };
+  std::mutex filter_mutex_;
+  FilterSettings filter_settings_;
+  std::vector<JointFilterState> filter_state_;
+  XrTime filter_time_ = 0;
 };
 
 }  // namespace holoscan
@@ -186,17 +186,19 @@ XrSwapchainCuda::XrSwapchainCuda(XrSession& session, Format format, uint32_t wid
     vk::raii::CommandBuffer& command_buffer = images_[i].command_buffer;
     command_buffer.begin({.flags = vk::CommandBufferUsageFlagBits::eSimultaneousUse});
     vk::ImageSubresourceRange imageSubresourceRange({image_aspect(format), 0, 1, 0, 1});
+    // The copy overwrites the whole image, transitioning from the undefined layout discards the
+    // previous content instead of preserving (and for depth, decompressing) it.
     vk::ImageMemoryBarrier transfer_layout_barrier({
         .srcAccessMask = vk::AccessFlagBits::eNone,
         .dstAccessMask = vk::AccessFlagBits::eTransferWrite,
-        .oldLayout = original_image_layout(format),
+        .oldLayout = vk::ImageLayout::eUndefined,
         .newLayout = vk::ImageLayout::eTransferDstOptimal,
         .srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
         .dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
         .image = *images_[i].vk_image,
         .subresourceRange = imageSubresourceRange,
     });
-    command_buffer.pipelineBarrier(vk::PipelineStageFlagBits::eBottomOfPipe,
+    command_buffer.pipelineBarrier(vk::PipelineStageFlagBits::eTopOfPipe,
                                    vk::PipelineStageFlagBits::eTransfer,
                                    {},
                                    nullptr,
@@ -228,7 +230,7 @@ XrSwapchainCuda::XrSwapchainCuda(XrSession& session, Format format, uint32_t wid
         .subresourceRange = imageSubresourceRange,
     });
     command_buffer.pipelineBarrier(vk::PipelineStageFlagBits::eTransfer,
-                                   vk::PipelineStageFlagBits::eTopOfPipe,
+                                   vk::PipelineStageFlagBits::eBottomOfPipe,
                                    {},
                                    nullptr,
                                    nullptr,
@@ -281,9 +283,12 @@ void XrSwapchainCuda::release(cudaStream_t cuda_stream) {
     throw std::runtime_error("cudaSignalExternalSemaphoresAsync failed");
   }
 
+  // Only the copy waits for the render, earlier work on the queue can proceed.
+  const vk::PipelineStageFlags wait_stage = vk::PipelineStageFlagBits::eTransfer;
   vk::SubmitInfo submitInfo = {
       .waitSemaphoreCount = 1,
       .pWaitSemaphores = &*image.render_done_vk_semaphore,
+      .pWaitDstStageMask = &wait_stage,
       .commandBufferCount = 1,
       .pCommandBuffers = &*image.command_buffer,
   };
@@ -38,6 +38,10 @@
 namespace holoscan {
 
 // Manages an OpenXR swapchain that can be written to using CUDA.
+//
+// The swapchain images are allocated by the OpenXR runtime, which provides no handle to export
+// their memory, so CUDA can't import the images themselves. Applications write to an exported
+// transfer buffer per image instead, copied to the image on the Vulkan queue on release().
 class XrSwapchainCuda {
  public:
   enum class Format {
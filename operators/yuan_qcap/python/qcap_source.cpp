@@ -61,7 +61,9 @@ class PyQCAPSourceOp : public QCAPSourceOp {
                  uint32_t width = 3840, uint32_t height = 2160, uint32_t framerate = 60,
                  bool rdma = true, const std::string& pixel_format = "bgr24"s,
                  const std::string& input_type = "auto"s, uint32_t mst_mode = 0,
-                 uint32_t sdi12g_mode = 0, const std::string& name = "qcap_source")
+                 uint32_t sdi12g_mode = 0, const std::string& output_pixel_format = "rgb24"s,
+                 std::shared_ptr<holoscan::CudaStreamPool> cuda_stream_pool = nullptr,
+                 const std::string& name = "qcap_source")
       : QCAPSourceOp(ArgList{Arg{"device", device},
                              Arg{"channel", channel},
                              Arg{"width", width},
@@ -71,8 +73,10 @@ class PyQCAPSourceOp : public QCAPSourceOp {
                              Arg{"pixel_format", pixel_format},
                              Arg{"input_type", input_type},
                              Arg{"mst_mode", mst_mode},
-                             Arg{"sdi12g_mode", sdi12g_mode}}) {
+                             Arg{"sdi12g_mode", sdi12g_mode},
+                             Arg{"output_pixel_format", output_pixel_format}}) {
     add_positional_condition_and_resource_args(this, args);
+    if (cuda_stream_pool) { this->add_arg(Arg{"cuda_stream_pool", cuda_stream_pool}); }
     name_ = name;
     fragment_ = fragment;
     spec_ = std::make_shared<OperatorSpec>(fragment);
@@ -112,6 +116,8 @@ PYBIND11_MODULE(_qcap_source, m) {
                     const std::string&,
                     uint32_t,
                     uint32_t,
+                    const std::string&,
+                    std::shared_ptr<holoscan::CudaStreamPool>,
                     const std::string&>(),
            "fragment"_a,
            "device"_a = "SC0710 PCI"s,
@@ -124,6 +130,8 @@ PYBIND11_MODULE(_qcap_source, m) {
            "input_type"_a = "auto"s,
            "mst_mode"_a = 0,
            "sdi12g_mode"_a = 0,
+           "output_pixel_format"_a = "rgb24"s,
+           "cuda_stream_pool"_a = py::none(),
            "name"_a = "qcap_source"s,
            doc::QCAPSourceOp::doc_QCAPSourceOp_python)
       .def_property_readonly(
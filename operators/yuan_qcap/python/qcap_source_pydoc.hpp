@@ -54,6 +54,11 @@ mst_mode : int, optional
     The mst mode of the video stream.
 sdi2g_mode : int, optional
     The SDI 12G mode of the video stream.
+output_pixel_format : str, optional
+    The pixel format of the emitted frames, converted on the GPU: ``"rgb24"`` or ``"rgba32"``.
+cuda_stream_pool : holoscan.resources.CudaStreamPool, optional
+    Pool to allocate the color conversion stream from; the stream is added to the output
+    message. Without it, the conversion runs on the default stream.
 name : str, optional
     The name of the operator.
 )doc")
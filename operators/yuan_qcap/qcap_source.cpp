@@ -32,6 +32,7 @@ void QCAPSourceOp::setup(OperatorSpec& spec) {
   constexpr uint32_t kDefaultFramerate = 60;
   constexpr bool kDefaultRDMA = false;
   constexpr char kDefaultPixelFormat[] = "bgr24";
+  constexpr char kDefaultOutputPixelFormat[] = "rgb24";
   constexpr char kDefaultInputType[] = "auto";
   constexpr uint32_t kDefaultMSTMode = 0;
   constexpr uint32_t kDefaultSDI12GMode = 0;
@@ -53,9 +54,18 @@ void QCAPSourceOp::setup(OperatorSpec& spec) {
              "PixelFormat",
              "Pixel Format.",
              std::string(kDefaultPixelFormat));
+  spec.param(output_pixel_format_,
+             "output_pixel_format",
+             "OutputPixelFormat",
+             "Output Pixel Format, rgb24 or rgba32.",
+             std::string(kDefaultOutputPixelFormat));
   spec.param(input_type_, "input_type", "InputType", "Input Type.", std::string(kDefaultInputType));
   spec.param(mst_mode_, "mst_mode", "MSTMode", "MST Mode.", kDefaultMSTMode);
   spec.param(mst_mode_, "sdi12g_mode", "SDI12GMode", "SDI 12G Mode.", kDefaultSDI12GMode);
+  spec.param(cuda_stream_pool_,
+             "cuda_stream_pool",
+             "CudaStreamPool",
+             "Instance of gxf::CudaStreamPool to allocate the color conversion stream.");
 }
 
 void QCAPSourceOp::initialize() {
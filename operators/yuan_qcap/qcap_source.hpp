@@ -18,7 +18,9 @@
 #define HOLOSCAN_OPERATORS_QCAP_SOURCE_QCAP_SOURCE_HPP
 
 #include "holoscan/core/gxf/gxf_operator.hpp"
+#include "holoscan/core/resources/gxf/cuda_stream_pool.hpp"
 
+#include <memory>
 #include <string>
 #include <utility>
 #include <vector>
@@ -51,9 +53,11 @@ class QCAPSourceOp : public holoscan::ops::GXFOperator {
   Parameter<uint32_t> framerate_;
   Parameter<bool> use_rdma_;
   Parameter<std::string> pixel_format_;
+  Parameter<std::string> output_pixel_format_;
   Parameter<std::string> input_type_;
   Parameter<uint32_t> mst_mode_;
   Parameter<uint32_t> sdi12g_mode_;
+  Parameter<std::shared_ptr<CudaStreamPool>> cuda_stream_pool_;
 };
 
 }  // namespace holoscan::ops